@@ -9,6 +9,8 @@ set(CMAKE_REQUIRED_DEFINITIONS -D_GNU_SOURCE)
 check_symbol_exists(ppoll poll.h HAVE_PPOLL)
 set(CMAKE_REQUIRED_DEFINITIONS)
 check_symbol_exists(sigaction signal.h HAVE_SIGACTION)
+check_symbol_exists(epoll_create1 "sys/epoll.h" HAVE_EPOLL)
+check_symbol_exists(signalfd "sys/signalfd.h" HAVE_SIGNALFD)
 check_cxx_symbol_exists(accept4 "sys/socket.h" HAVE_ACCEPT4)
 
 check_include_file(termios.h HAVE_TERMIOS_H)
@@ -17,8 +19,13 @@ check_include_files("sys/types.h;sys/event.h" HAVE_SYS_EVENT_H)
 
 check_cxx_symbol_exists(process_vm_readv "sys/uio.h" HAVE_PROCESS_VM_READV)
 check_cxx_symbol_exists(__NR_process_vm_readv "sys/syscall.h" HAVE_NR_PROCESS_VM_READV)
+check_cxx_symbol_exists(process_vm_writev "sys/uio.h" HAVE_PROCESS_VM_WRITEV)
+check_cxx_symbol_exists(__NR_process_vm_writev "sys/syscall.h" HAVE_NR_PROCESS_VM_WRITEV)
 
 check_library_exists(compression compression_encode_buffer "" HAVE_LIBCOMPRESSION)
+if(LLVM_ENABLE_ZLIB)
+  check_library_exists(z compress2 "" HAVE_LIBZ)
+endif()
 
 # These checks exist in LLVM's configuration, so I want to match the LLVM names
 # so that the check isn't duplicated, but we translate them into the LLDB names
@@ -92,6 +92,17 @@ public:
 
   void SetCallback(SBBreakpointHitCallback callback, void *baton);
 
+  /// Make a native callback available as \a callback_name to
+  /// SetRegisteredCallback(), usually from the lldb::PluginInitialize() of
+  /// a plugin loaded with "plugin load". Registering a null callback removes
+  /// the name. Returns false if the name is empty.
+  static bool RegisterCallback(const char *callback_name,
+                               SBBreakpointHitCallback callback, void *baton);
+
+  /// Call the native callback registered as \a callback_name when the
+  /// breakpoint is hit.
+  SBError SetRegisteredCallback(const char *callback_name);
+
   void SetScriptCallbackFunction(const char *callback_function_name);
 
   void SetCommandLineCommands(SBStringList &commands);
@@ -83,6 +83,8 @@ public:
 
   void SetCallback(SBBreakpointHitCallback callback, void *baton);
 
+  SBError SetRegisteredCallback(const char *callback_name);
+
   void SetScriptCallbackFunction(const char *callback_function_name);
 
   void SetCommandLineCommands(SBStringList &commands);
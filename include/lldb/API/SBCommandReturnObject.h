@@ -73,6 +73,11 @@ public:
 
   void SetImmediateErrorFile(FILE *fh, bool transfer_ownership);
 
+  /// Hand the output of commands to \a callback while they run, a bounded
+  /// amount at a time, instead of keeping it for GetOutput().
+  void SetImmediateOutputCallback(lldb::LogOutputCallback callback,
+                                  void *baton);
+
   void PutCString(const char *string, int len = -1);
 
   size_t Printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
@@ -129,6 +129,10 @@ public:
 
   uint32_t GetNumTargets();
 
+  /// Report the memory held by the string pool, by each module of the
+  /// targets of this debugger and by the targets themselves, in bytes.
+  lldb::SBStructuredData GetMemoryUsage();
+
   lldb::SBTarget GetSelectedTarget();
 
   void SetSelectedTarget(SBTarget &target);
@@ -60,6 +60,7 @@ protected:
   friend class SBCommunication;
   friend class SBData;
   friend class SBDebugger;
+  friend class SBFrame;
   friend class SBHostOS;
   friend class SBModule;
   friend class SBPlatform;
@@ -104,6 +104,16 @@ public:
   // Sets whether we will JIT an expression if it cannot be interpreted
   void SetAllowJIT(bool allow);
 
+  // Sets whether to collect the time each phase of evaluating expressions
+  // with these options takes
+  void SetCollectStatistics(bool collect);
+
+  bool GetCollectStatistics() const;
+
+  // Gets the time in seconds each phase took, summed over the expressions
+  // evaluated with these options since statistics were turned on
+  lldb::SBStructuredData GetStatistics() const;
+
 protected:
   lldb_private::EvaluateExpressionOptions *get() const;
 
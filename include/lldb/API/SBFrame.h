@@ -151,6 +151,20 @@ public:
 
   lldb::SBValue FindRegister(const char *name);
 
+  /// Read the first \a count arguments of the function this frame is
+  /// stopped at the entry of, taking each to be an integer or a pointer.
+  /// Nothing is looked up in the debug info, so this is meant for breakpoint
+  /// callbacks that trace many calls.
+  ///
+  /// \return
+  ///     One 64 bit value per argument in host byte order, or no data if the
+  ///     ABI doesn't support this, in which case \a error says why.
+  lldb::SBData GetIntegerArgumentValues(uint32_t count, lldb::SBError &error);
+
+  /// Read the value an integer or pointer returning function returned, with
+  /// this frame stopped right after the return.
+  uint64_t GetIntegerReturnValue(lldb::SBError &error);
+
   /// The version that doesn't supply a 'use_dynamic' value will use the
   /// target's default.
   lldb::SBValue FindVariable(const char *var_name);
@@ -170,6 +184,25 @@ public:
   /// target's default.
   lldb::SBValue GetValueForVariablePath(const char *var_path);
 
+  /// Get the values of many variable expression paths at once.
+  ///
+  /// This is equivalent to calling GetValueForVariablePath() for every path,
+  /// but the target and process locks are only taken once, and the value
+  /// and summary of each value are computed before returning, so reading
+  /// them back from the returned values is cheap.
+  ///
+  /// \return
+  ///   A list with one value per path, in the same order as \a var_paths.
+  ///   A path that can't be evaluated gets a value whose GetError() says
+  ///   why. The list is empty if the frame is invalid or its process is
+  ///   running.
+  lldb::SBValueList GetValuesForVariablePaths(const SBStringList &var_paths,
+                                             DynamicValueType use_dynamic);
+
+  /// The version that doesn't supply a 'use_dynamic' value will use the
+  /// target's default.
+  lldb::SBValueList GetValuesForVariablePaths(const SBStringList &var_paths);
+
   /// Find variables, register sets, registers, or persistent variables using
   /// the frame as the scope.
   ///
@@ -191,6 +191,24 @@ public:
 
   lldb::addr_t ReadPointerFromMemory(addr_t addr, lldb::SBError &error);
 
+  /// Read several ranges of memory with as few requests to the target as
+  /// possible.
+  ///
+  /// \param[in] array
+  ///   The ranges to read, as pairs of a start address and a byte size.
+  ///
+  /// \param[in] array_len
+  ///   The number of elements in \a array, twice the number of ranges.
+  ///
+  /// \param[out] error
+  ///   Set to an error if any of the ranges could not be read completely.
+  ///
+  /// \return
+  ///   The memory of all ranges one after another. Bytes that could not be
+  ///   read are zero.
+  lldb::SBData ReadMemoryRanges(uint64_t *array, size_t array_len,
+                                lldb::SBError &error);
+
   // Events
   static lldb::StateType GetStateFromEvent(const lldb::SBEvent &event);
 
@@ -505,6 +505,28 @@ public:
   SBSymbolContext ResolveSymbolContextForAddress(const SBAddress &addr,
                                                  uint32_t resolve_scope);
 
+  /// Resolve the symbol contexts of many load addresses at once.
+  ///
+  /// This is equivalent to calling ResolveLoadAddress() and then
+  /// ResolveSymbolContextForAddress() for every address, but the addresses
+  /// are grouped by module and each module is resolved concurrently.
+  ///
+  /// \param[in] array
+  ///   The load addresses to symbolicate.
+  ///
+  /// \param[in] array_len
+  ///   The number of elements in \a array.
+  ///
+  /// \param[in] resolve_scope
+  ///   A mask of lldb::SymbolContextItem values to resolve.
+  ///
+  /// \return
+  ///   A list with one symbol context per address, in the same order as
+  ///   \a array. Addresses that don't resolve get an empty context.
+  lldb::SBSymbolContextList SymbolicateAddresses(uint64_t *array,
+                                                 size_t array_len,
+                                                 uint32_t resolve_scope);
+
   /// Read target memory. If a target process is running then memory
   /// is read from here. Otherwise the memory is read from the object
   /// files. For a target whose bytes are sized as a multiple of host
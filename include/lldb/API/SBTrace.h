@@ -49,6 +49,20 @@ public:
   size_t GetTraceData(SBError &error, void *buf, size_t size, size_t offset = 0,
                       lldb::tid_t thread_id = LLDB_INVALID_THREAD_ID);
 
+  /// Write all the trace data to a file.
+  ///
+  /// The data is read from the process a piece at a time, so this works for
+  /// traces too big to hold in a single buffer. The other parameters are
+  /// the same as for GetTraceData().
+  ///
+  /// \param[in] path
+  ///     The file to write to. It is created or truncated.
+  ///
+  /// \return
+  ///     The number of bytes written to the file.
+  size_t SaveTraceData(SBError &error, const char *path,
+                       lldb::tid_t thread_id = LLDB_INVALID_THREAD_ID);
+
   /// Obtain any meta data as raw bytes for the tracing instance.
   /// The input parameter definition is similar to the previous
   /// function.
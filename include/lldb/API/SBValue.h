@@ -116,6 +116,24 @@ public:
 
   lldb::SBValue GetChildAtIndex(uint32_t idx);
 
+  /// Get the children in the range [start, start + count).
+  ///
+  /// This is much more efficient than calling GetChildAtIndex() for each
+  /// index of a window into a large container: the number of children is
+  /// only computed up to the end of the window, and synthetic children
+  /// providers may read all the requested children at once.
+  ///
+  /// \param[in] start
+  ///     The index of the first child to return.
+  ///
+  /// \param[in] count
+  ///     The maximum number of children to return.
+  ///
+  /// \return
+  ///     The children in the range, which can hold fewer than \a count
+  ///     values if the range goes past the last child.
+  lldb::SBValueList GetChildrenInRange(uint32_t start, uint32_t count);
+
   lldb::SBValue CreateChildAtOffset(const char *name, uint32_t offset,
                                     lldb::SBType type);
 
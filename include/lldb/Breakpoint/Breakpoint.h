@@ -621,6 +621,9 @@ protected:
 
   bool IgnoreCountShouldStop();
 
+  // Tell each resolved location its site's conditions may have changed.
+  void UpdateSiteConditions();
+
   void IncrementHitCount() { m_hit_count++; }
 
   void DecrementHitCount() {
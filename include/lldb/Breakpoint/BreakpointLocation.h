@@ -133,6 +133,10 @@ public:
 
   bool ConditionSaysStop(ExecutionContext &exe_ctx, Status &error);
 
+  /// Let the process know that whether a hit of this location's site stops
+  /// may have changed, because of a new condition or ignore count.
+  void UpdateSiteConditions();
+
   /// Set the valid thread to be checked when the breakpoint is hit.
   ///
   /// \param[in] thread_id
@@ -27,6 +27,7 @@
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/FileSpec.h"
 #include "lldb/Utility/Status.h"
+#include "lldb/Utility/StructuredData.h"
 #include "lldb/Utility/UserID.h"
 #include "lldb/lldb-defines.h"
 #include "lldb/lldb-enumerations.h"
@@ -51,6 +52,7 @@ class raw_ostream;
 
 namespace lldb_private {
 class Address;
+class CircularLogStream;
 class CommandInterpreter;
 class Process;
 class Stream;
@@ -168,6 +170,15 @@ public:
 
   PlatformList &GetPlatformList() { return m_platform_list; }
 
+  /// The memory held by the modules of the targets of this debugger, each
+  /// module counted once, by the targets themselves and by the ConstString
+  /// pool, in bytes, as used by SBDebugger::GetMemoryUsage().
+  StructuredData::DictionarySP ReportMemoryUsage();
+
+  /// Free the caches of the modules and processes of this debugger and of
+  /// the data formatters, which are filled again when needed.
+  void ReleaseCaches();
+
   void DispatchInputInterrupt();
 
   void DispatchInputEndOfFile();
@@ -208,10 +219,20 @@ public:
 
   void SetCloseInputOnEOF(bool b);
 
+  /// Enable logging \a categories of \a channel to \a log_file, or to the
+  /// output if it's empty. With LLDB_LOG_OPTION_ASYNC, the messages are
+  /// written from a background thread, with up to \a buffer_size bytes
+  /// waiting. With LLDB_LOG_OPTION_CIRCULAR, the last \a buffer_size bytes
+  /// are kept in memory for DumpLog() instead. A \a buffer_size of 0 picks a
+  /// default.
   bool EnableLog(llvm::StringRef channel,
                  llvm::ArrayRef<const char *> categories,
                  llvm::StringRef log_file, uint32_t log_options,
-                 llvm::raw_ostream &error_stream);
+                 llvm::raw_ostream &error_stream, size_t buffer_size = 0);
+
+  /// Write what the circular log of \a channel holds to \a output_stream.
+  bool DumpLog(llvm::StringRef channel, llvm::raw_ostream &output_stream,
+               llvm::raw_ostream &error_stream);
 
   void SetLoggingCallback(lldb::LogOutputCallback log_callback, void *baton);
 
@@ -398,6 +419,7 @@ protected:
 
   IOHandlerStack m_input_reader_stack;
   llvm::StringMap<std::weak_ptr<llvm::raw_ostream>> m_log_streams;
+  llvm::StringMap<std::weak_ptr<CircularLogStream>> m_circular_log_streams;
   std::shared_ptr<llvm::raw_ostream> m_log_callback_stream_sp;
   ConstString m_instance_name;
   static LoadPluginCallbackType g_load_plugin_callback;
@@ -439,6 +439,9 @@ public:
                                 uint32_t num_mixed_context_lines,
                                 uint32_t options, Stream &strm);
 
+  /// Decode the instructions in \a range. Large ranges in a module are
+  /// split at symbol boundaries, and the pieces are decoded and symbolicated
+  /// on the task pool, each by its own instance of this plugin.
   size_t ParseInstructions(const ExecutionContext *exe_ctx,
                            const AddressRange &range, Stream *error_strm_ptr,
                            bool prefer_file_cache);
@@ -538,8 +541,16 @@ protected:
   InstructionList m_instruction_list;
   lldb::addr_t m_base_addr;
   std::string m_flavor;
+  /// The disassemblers that decoded pieces of a range in parallel. Their
+  /// instructions were moved into m_instruction_list but still refer to
+  /// them.
+  std::vector<lldb::DisassemblerSP> m_piece_disassemblers;
 
 private:
+  size_t ParseInstructionsInParallel(const ExecutionContext &exe_ctx,
+                                     const std::vector<AddressRange> &pieces,
+                                     bool prefer_file_cache);
+
   // For Disassembler only
   DISALLOW_COPY_AND_ASSIGN(Disassembler);
 };
@@ -105,14 +105,38 @@ public:
     lldb::addr_t m_dynamic;
   };
 
-  LoadedModuleInfoList() : m_list(), m_link_map(LLDB_INVALID_ADDRESS) {}
+  LoadedModuleInfoList()
+      : m_list(), m_link_map(LLDB_INVALID_ADDRESS),
+        m_generation(LLDB_INVALID_INDEX32),
+        m_base_generation(LLDB_INVALID_INDEX32) {}
 
   void add(const LoadedModuleInfo &mod) { m_list.push_back(mod); }
 
-  void clear() { m_list.clear(); }
+  void clear() {
+    m_list.clear();
+    m_added.clear();
+    m_removed.clear();
+    m_generation = LLDB_INVALID_INDEX32;
+    m_base_generation = LLDB_INVALID_INDEX32;
+  }
+
+  /// Returns true if m_added and m_removed describe how this list differs
+  /// from the list with generation \a generation.
+  bool IsDeltaFrom(uint32_t generation) const {
+    return m_base_generation != LLDB_INVALID_INDEX32 &&
+           m_base_generation == generation;
+  }
 
   std::vector<LoadedModuleInfo> m_list;
   lldb::addr_t m_link_map;
+  /// The generation the remote stub gave this list, or LLDB_INVALID_INDEX32
+  /// if it doesn't number its lists.
+  uint32_t m_generation;
+  /// The generation of the list that m_added and m_removed are relative to,
+  /// or LLDB_INVALID_INDEX32 if only m_list is valid.
+  uint32_t m_base_generation;
+  std::vector<LoadedModuleInfo> m_added;
+  std::vector<LoadedModuleInfo> m_removed;
 };
 } // namespace lldb_private
 
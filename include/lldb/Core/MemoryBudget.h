@@ -0,0 +1,79 @@
+//===-- MemoryBudget.h ------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_MemoryBudget_h_
+#define liblldb_MemoryBudget_h_
+
+#include <atomic>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace lldb_private {
+
+/// Data of a module that can be freed and built again when it is used next,
+/// like the name index of its debug info. Subclasses add themselves to the
+/// MemoryBudget once they are ready to be evicted, and must remove themselves
+/// before their data is destroyed.
+class EvictableCache {
+public:
+  virtual ~EvictableCache() = default;
+
+  /// The memory held by the data while it is resident, in bytes.
+  size_t GetResidentSize() const { return m_resident_size; }
+
+protected:
+  /// Free the data unless it is in use right now. This must not block, it
+  /// is called while another cache is being built. Returns true if the data
+  /// was freed.
+  virtual bool TryEvict() = 0;
+
+  /// Record that the data was used, which makes it the last to be evicted.
+  void MarkUsed();
+
+  /// Record that the data was built and holds \a size bytes, and evict the
+  /// other caches used least recently if the total is now over the budget.
+  void MarkResident(size_t size);
+
+private:
+  friend class MemoryBudget;
+
+  std::atomic<uint64_t> m_last_use{0};
+  std::atomic<size_t> m_resident_size{0};
+};
+
+/// Keeps the total size of the resident EvictableCaches within the
+/// "symbols.memory-budget" setting by evicting the ones used least recently.
+class MemoryBudget {
+public:
+  static MemoryBudget &Instance();
+
+  void Add(EvictableCache &cache);
+
+  void Remove(EvictableCache &cache);
+
+  /// Evict caches other than \a keep, least recently used first, until the
+  /// total size is within the budget or nothing else can be evicted.
+  void Enforce(EvictableCache *keep);
+
+private:
+  friend class EvictableCache;
+
+  MemoryBudget() = default;
+
+  std::mutex m_mutex;
+  std::vector<EvictableCache *> m_caches;
+  /// Incremented on every use of a cache, so the caches can be ordered by
+  /// their last use without taking a lock when they are used.
+  std::atomic<uint64_t> m_use_clock{0};
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_MemoryBudget_h_
@@ -19,22 +19,28 @@
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/FileSpec.h"
 #include "lldb/Utility/Status.h"
+#include "lldb/Utility/StructuredData.h"
+#include "lldb/Utility/Timer.h"
 #include "lldb/Utility/UUID.h"
 #include "lldb/lldb-defines.h"
 #include "lldb/lldb-enumerations.h"
 #include "lldb/lldb-forward.h"
 #include "lldb/lldb-types.h"
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Chrono.h"
 
 #include <atomic>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <stddef.h>
 #include <stdint.h>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace lldb_private {
@@ -85,6 +91,10 @@ public:
 
   static std::recursive_mutex &GetAllocationModuleCollectionMutex();
 
+  /// Return a number that changes every time any module has its symbol file
+  /// replaced, so caches of lookup results can tell they are out of date.
+  static uint32_t GetSymbolFileGeneration();
+
   /// Construct with file specification and architecture.
   ///
   /// Clients that wish to share modules with other targets should use
@@ -577,6 +587,45 @@ public:
 
   lldb::CompUnitSP GetCompileUnitAtIndex(size_t idx);
 
+  /// Find the compile units that use a file named \a basename, either as
+  /// their primary file or as one of their support files.
+  ///
+  /// The first call parses the support files of all compile units and
+  /// builds an index from file basenames to compile units, so resolving
+  /// many file and line breakpoints doesn't have to visit every compile unit
+  /// for each of them. Basenames are compared case sensitively.
+  ///
+  /// \param[in] basename
+  ///     The file name to look for, without any directory.
+  ///
+  /// \param[out] cu_indexes
+  ///     The indexes of the matching compile units, suitable for
+  ///     GetCompileUnitAtIndex(), in increasing order.
+  void FindCompileUnitsUsingFile(ConstString basename,
+                                 std::vector<uint32_t> &cu_indexes);
+
+  /// Get the instructions in \a range from this module's instruction cache.
+  ///
+  /// The instructions are decoded from the object file the first time a
+  /// range is asked for, and shared with every later caller that asks for
+  /// the same range, architecture, disassembler plug-in and flavor.  Since
+  /// they always come from the file, they never contain breakpoint traps.
+  ///
+  /// \param[in] range
+  ///     The range to disassemble, which must lie entirely within the file
+  ///     contents of one of this module's sections.
+  ///
+  /// \return
+  ///     The disassembler holding the instructions, or an empty shared
+  ///     pointer if \a range isn't backed by an object file on disk (for
+  ///     instance JIT'ed code), in which case the caller needs to read the
+  ///     instructions from memory itself.
+  lldb::DisassemblerSP GetCachedDisassembly(const ArchSpec &arch,
+                                            const char *plugin_name,
+                                            const char *flavor,
+                                            const ExecutionContext &exe_ctx,
+                                            const AddressRange &range);
+
   ConstString GetObjectName() const;
 
   uint64_t GetObjectOffset() const { return m_object_offset; }
@@ -658,6 +707,16 @@ public:
 
   Symtab *GetSymtab();
 
+  /// The time spent parsing the symbol table of this module.
+  StatsDuration &GetSymtabParseTime() { return m_symtab_parse_time; }
+
+  /// The memory held by the symbol table, debug info, debug info index and
+  /// type systems of this module, in bytes. Nothing is parsed to find out.
+  StructuredData::DictionarySP ReportMemoryUsage();
+
+  /// Free the caches of this module that are filled again when needed.
+  void ReleaseCaches();
+
   /// Get a reference to the UUID value contained in this object.
   ///
   /// If the executable image file doesn't not have a UUID value built into
@@ -1025,6 +1084,23 @@ protected:
                                      /// is used by the ObjectFile and and
                                      /// ObjectFile instances for the debug info
 
+  typedef llvm::DenseMap<const char *, std::vector<uint32_t>>
+      FileBasenameToCompUnitsMap;
+  llvm::Optional<FileBasenameToCompUnitsMap>
+      m_file_basename_index; ///< Compile units using each file basename, see
+                             /// FindCompileUnitsUsingFile()
+
+  typedef std::map<std::tuple<lldb::addr_t, lldb::addr_t, std::string>,
+                   lldb::DisassemblerSP>
+      DisassemblyCache;
+  DisassemblyCache m_disassembly_cache; ///< Instructions keyed by file
+                                        /// address, size and disassembler
+                                        /// configuration, see
+                                        /// GetCachedDisassembly()
+  std::mutex m_disassembly_cache_mutex;
+
+  StatsDuration m_symtab_parse_time;
+
   std::atomic<bool> m_did_load_objfile{false};
   std::atomic<bool> m_did_load_symfile{false};
   std::atomic<bool> m_did_set_uuid{false};
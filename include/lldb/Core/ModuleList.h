@@ -19,10 +19,12 @@
 #include "lldb/lldb-forward.h"
 #include "lldb/lldb-types.h"
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseSet.h"
 
 #include <functional>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -51,11 +53,15 @@ public:
 
   bool GetUseDWARFImporter() const;
   FileSpec GetClangModulesCachePath() const;
+  FileSpec GetSymtabCachePath() const;
+  FileSpec GetSwiftModuleValidationCachePath() const;
   bool SetClangModulesCachePath(llvm::StringRef path);
   SwiftModuleLoadingMode GetSwiftModuleLoadingMode() const;
   bool SetSwiftModuleLoadingMode(SwiftModuleLoadingMode);
   bool GetEnableExternalLookup() const;
   bool SetEnableExternalLookup(bool new_value);
+  bool GetKeepOrphanedModules() const;
+  uint64_t GetMemoryBudget() const;
 }; 
 
 /// \class ModuleList ModuleList.h "lldb/Core/ModuleList.h"
@@ -462,6 +468,29 @@ public:
                                           lldb::SymbolContextItem resolve_scope,
                                           SymbolContext &sc) const;
 
+  /// Resolve the symbol contexts for many section offset addresses at once.
+  ///
+  /// The addresses are grouped by module and visited in section and offset
+  /// order so the symbol file and line table lookups stay local. Modules
+  /// are resolved concurrently.
+  ///
+  /// \param[in] so_addrs
+  ///     The addresses to resolve. Addresses that aren't section offset
+  ///     addresses within a module can't be resolved.
+  ///
+  /// \param[in] resolve_scope
+  ///     The symbol context items to resolve for each address.
+  ///
+  /// \param[out] sc_list
+  ///     Filled with one symbol context per entry in \a so_addrs, in the
+  ///     same order. Addresses that can't be resolved get an empty context.
+  ///
+  /// \return
+  ///     The number of addresses for which anything was resolved.
+  size_t ResolveSymbolContextsForAddresses(
+      llvm::ArrayRef<Address> so_addrs, lldb::SymbolContextItem resolve_scope,
+      std::vector<SymbolContext> &sc_list) const;
+
   /// \copydoc Module::ResolveSymbolContextForFilePath (const char
   /// *,uint32_t,bool,uint32_t,SymbolContextList&)
   uint32_t ResolveSymbolContextForFilePath(
@@ -495,6 +524,13 @@ public:
                                 bool *did_create_ptr,
                                 bool always_create = false);
 
+  /// Open the object files in \a module_specs and parse their sections
+  /// concurrently, adding the modules to the shared module list. Later
+  /// GetSharedModule calls for the same files then find them there, so a
+  /// caller about to load many modules one at a time can call this first.
+  /// Files that don't exist or are already in the list are skipped.
+  static void PreloadSharedModules(llvm::ArrayRef<ModuleSpec> module_specs);
+
   static bool RemoveSharedModule(lldb::ModuleSP &module_sp);
 
   static size_t FindSharedModules(const ModuleSpec &module_spec,
@@ -523,9 +559,36 @@ protected:
 
   void ClearImpl(bool use_notifier = true);
 
+  /// An immutable copy of the module collection. Lookups iterate over a
+  /// snapshot instead of holding m_modules_mutex while they search the
+  /// modules, so they neither block each other nor wait for threads that
+  /// modify the list.
+  typedef std::shared_ptr<const collection> CollectionSnapshot;
+
+  /// Return the snapshot of the current contents of the list.
+  CollectionSnapshot GetSnapshot() const;
+
+  /// Publish a new snapshot after m_modules changed. The caller must hold
+  /// m_modules_mutex.
+  void UpdateSnapshot();
+
   // Member variables.
   collection m_modules; ///< The collection of modules.
   mutable std::recursive_mutex m_modules_mutex;
+  /// The published copy of m_modules. Replaced under m_modules_mutex and
+  /// only accessed with std::atomic_load and std::atomic_store.
+  CollectionSnapshot m_snapshot;
+
+  /// Type names that FindTypes() found in none of the modules, and whether
+  /// they were looked up fully qualified. They only stay valid while the list
+  /// has the same snapshot and no module has had its symbol file replaced.
+  struct MissingTypes {
+    std::weak_ptr<const collection> snapshot;
+    uint32_t symbol_file_generation = 0;
+    llvm::DenseSet<std::pair<const char *, bool>> names;
+  };
+  mutable std::mutex m_missing_types_mutex;
+  mutable MissingTypes m_missing_types;
 
   Notifier *m_notifier;
 
@@ -34,6 +34,18 @@ public:
 
   static void Terminate();
 
+  // LLVM targets
+  /// Registering every LLVM target, MC layer and disassembler takes a
+  /// noticeable part of startup, and many sessions never need them. The
+  /// initializer instead registers \a callback to do it, and it runs the
+  /// first time InitializeLLVMTargets() is called.
+  static void SetLLVMTargetsCallback(void (*callback)());
+
+  /// Make sure the LLVM targets are registered. Call this before looking
+  /// anything up in the llvm::TargetRegistry. Does nothing if no callback
+  /// was set, in which case the tool registers the targets itself.
+  static void InitializeLLVMTargets();
+
   // ABI
   static bool RegisterPlugin(ConstString name, const char *description,
                              ABICreateInstance create_callback);
@@ -143,6 +143,11 @@ public:
   // Get the total number of entries in this map.
   size_t GetSize() const { return m_map.size(); }
 
+  // The memory held by this map, not counting the strings.
+  size_t MemorySize() const {
+    return sizeof(*this) + m_map.capacity() * sizeof(Entry);
+  }
+
   // Returns true if this map is empty.
   bool IsEmpty() const { return m_map.empty(); }
 
@@ -9,12 +9,14 @@
 #ifndef liblldb_UserSettingsController_h_
 #define liblldb_UserSettingsController_h_
 
+#include "lldb/Interpreter/OptionValue.h"
 #include "lldb/Utility/Status.h"
 #include "lldb/lldb-forward.h"
 #include "lldb/lldb-private-enumerations.h"
 
 #include "llvm/ADT/StringRef.h"
 
+#include <atomic>
 #include <vector>
 
 #include <stddef.h>
@@ -86,6 +88,31 @@ protected:
   lldb::OptionValuePropertiesSP m_collection_sp;
 };
 
+/// A setting read on a hot path, looked up once and then reused until any
+/// option value changes. Holds values of up to 32 bits, such as booleans,
+/// enumerations and counts, which are stored along with the change
+/// generation they were read in, so a read is a single atomic load.
+template <typename T> class CachedPropertyValue {
+  static_assert(sizeof(T) <= sizeof(uint32_t),
+                "cached property values must fit in 32 bits");
+
+public:
+  template <typename Lookup> T Get(Lookup lookup) const {
+    const uint64_t generation = OptionValue::GetChangeGeneration();
+    const uint64_t cached = m_cached.load(std::memory_order_relaxed);
+    if ((cached >> 32) == generation)
+      return static_cast<T>(static_cast<uint32_t>(cached));
+
+    T value = lookup();
+    m_cached.store((generation << 32) | static_cast<uint32_t>(value),
+                   std::memory_order_relaxed);
+    return value;
+  }
+
+private:
+  mutable std::atomic<uint64_t> m_cached{0};
+};
+
 } // namespace lldb_private
 
 #endif // liblldb_UserSettingsController_h_
@@ -463,6 +463,14 @@ public:
 
   virtual lldb::ValueObjectSP GetChildAtIndex(size_t idx, bool can_create);
 
+  /// Return the children in [start, start + count), stopping at the last
+  /// child. Unlike calling GetChildAtIndex() in a loop, this lets synthetic
+  /// children providers read the whole window at once, and only counts the
+  /// children up to the end of the window.
+  std::vector<lldb::ValueObjectSP> GetChildrenInRange(size_t start,
+                                                      size_t count,
+                                                      bool can_create);
+
   // this will always create the children if necessary
   lldb::ValueObjectSP GetChildAtIndexPath(llvm::ArrayRef<size_t> idxs,
                                           size_t *index_of_error = nullptr);
@@ -962,6 +970,10 @@ protected:
   // Should only be called by ValueObject::GetNumChildren()
   virtual size_t CalculateNumChildren(uint32_t max = UINT32_MAX) = 0;
 
+  // Should only be called by ValueObject::GetChildrenInRange(). A hint that
+  // the children in [start, start + count) are about to be requested.
+  virtual void PrefetchChildren(size_t start, size_t count) {}
+
   void SetNumChildren(size_t num_children);
 
   void SetValueDidChange(bool value_changed);
@@ -138,6 +138,8 @@ public:
 protected:
   bool UpdateValue() override;
 
+  void PrefetchChildren(size_t start, size_t count) override;
+
   LazyBool CanUpdateWithInvalidExecutionContext() override {
     return eLazyBoolYes;
   }
@@ -10,11 +10,12 @@
 #ifndef lldb_FormatCache_h_
 #define lldb_FormatCache_h_
 
+#include <atomic>
 #include <map>
-#include <mutex>
 
 #include "lldb/Utility/ConstString.h"
 #include "lldb/lldb-public.h"
+#include "llvm/Support/RWMutex.h"
 
 namespace lldb_private {
 class FormatCache {
@@ -65,13 +66,34 @@ private:
     void SetValidator(lldb::TypeValidatorImplSP);
   };
   typedef std::map<ConstString, Entry> CacheMap;
-  CacheMap m_map;
-  std::recursive_mutex m_mutex;
 
-  uint64_t m_cache_hits;
-  uint64_t m_cache_misses;
+  /// The entries are spread over several shards by type name, so that
+  /// concurrent lookups of different types don't contend on a single lock,
+  /// and lookups of the same type only take a reader lock.
+  struct Shard {
+    CacheMap m_map;
+    llvm::sys::RWMutex m_mutex;
+    /// The generation of the cache the entries in m_map belong to. A shard
+    /// left behind by Clear() is treated as empty, and emptied by the next
+    /// writer.
+    uint32_t m_generation = 0;
+  };
+  static constexpr size_t g_num_shards = 16;
+  Shard m_shards[g_num_shards];
+  std::atomic<uint32_t> m_generation;
+
+  std::atomic<uint64_t> m_cache_hits;
+  std::atomic<uint64_t> m_cache_misses;
+
+  Shard &GetShard(ConstString type);
+
+  /// Look up the entry for \a type, returning false if there is none in the
+  /// current generation.
+  bool GetEntry(ConstString type, Entry &entry);
 
-  Entry &GetEntry(ConstString type);
+  /// Return the entry for \a type, creating it if needed. The shard's writer
+  /// lock must be held.
+  Entry &GetEntryForUpdate(Shard &shard, ConstString type);
 
 public:
   FormatCache();
@@ -96,6 +118,8 @@ public:
   void SetValidator(ConstString type,
                     lldb::TypeValidatorImplSP &synthetic_sp);
 
+  /// Invalidate all entries. This doesn't walk or lock the shards; the stale
+  /// entries are dropped lazily.
   void Clear();
 
   uint64_t GetCacheHits() { return m_cache_hits; }
@@ -90,7 +90,7 @@ class FormattersMatchData {
 public:
   FormattersMatchData(ValueObject &, lldb::DynamicValueType);
 
-  FormattersMatchVector GetMatchesVector();
+  const FormattersMatchVector &GetMatchesVector();
 
   ConstString GetTypeForCache();
 
@@ -26,6 +26,7 @@
 #include "lldb/Symbol/CompilerType.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/StringLexer.h"
+#include "llvm/ADT/DenseMap.h"
 
 namespace lldb_private {
 
@@ -222,7 +223,11 @@ public:
                                             static_cast<KeyType *>(nullptr));
   }
 
-  void Clear() { m_format_map.Clear(); }
+  void Clear() {
+    std::lock_guard<std::recursive_mutex> guard(m_format_map.mutex());
+    m_regex_matches.clear();
+    m_format_map.Clear();
+  }
 
   void ForEach(ForEachCallback callback) { m_format_map.ForEach(callback); }
 
@@ -232,10 +237,18 @@ protected:
   BackEndType m_format_map;
   std::string m_name;
 
+  /// The results of matching type names against the regular expressions of
+  /// this container, keyed by ConstString. A null value records that no
+  /// expression matched. Guarded by the mutex of m_format_map, and cleared
+  /// whenever an expression is added or removed.
+  llvm::DenseMap<const char *, MapValueType> m_regex_matches;
+
   DISALLOW_COPY_AND_ASSIGN(FormattersContainer);
 
   void Add_Impl(MapKeyType type, const MapValueType &entry,
                 RegularExpression *dummy) {
+    std::lock_guard<std::recursive_mutex> guard(m_format_map.mutex());
+    m_regex_matches.clear();
     m_format_map.Add(std::move(type), entry);
   }
 
@@ -255,6 +268,7 @@ protected:
       const RegularExpression &regex = pos->first;
       if (type.GetStringRef() == regex.GetText()) {
         m_format_map.map().erase(pos);
+        m_regex_matches.clear();
         if (m_format_map.listener)
           m_format_map.listener->Changed();
         return true;
@@ -295,11 +309,22 @@ protected:
                 RegularExpression *dummy) {
     llvm::StringRef key_str = key.GetStringRef();
     std::lock_guard<std::recursive_mutex> guard(m_format_map.mutex());
+    // The same few type names are looked up over and over while rendering
+    // variables, so only run the expressions once per name.
+    auto cached = m_regex_matches.find(key.GetCString());
+    if (cached != m_regex_matches.end()) {
+      if (!cached->second)
+        return false;
+      value = cached->second;
+      return true;
+    }
+    MapValueType &match = m_regex_matches[key.GetCString()];
     MapIterator pos, end = m_format_map.map().end();
     for (pos = m_format_map.map().begin(); pos != end; pos++) {
       const RegularExpression &regex = pos->first;
       if (regex.Execute(key_str)) {
-        value = pos->second;
+        match = pos->second;
+        value = match;
         return true;
       }
     }
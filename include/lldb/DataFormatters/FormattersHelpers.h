@@ -58,6 +58,26 @@ lldb::addr_t GetArrayAddressOrPointerValue(ValueObject &valobj);
 
 time_t GetOSXEpoch();
 
+/// Reads the elements of an array in large blocks that the process memory
+/// cache keeps, so that making a ValueObject for each element doesn't cost
+/// a read from the process every time.
+class ArrayElementPrefetcher {
+public:
+  void Reset(lldb::addr_t start, size_t count, uint64_t element_size);
+
+  /// Make sure the element at \a idx is in the memory cache.
+  void Prefetch(Process &process, size_t idx);
+
+private:
+  lldb::addr_t m_start = LLDB_INVALID_ADDRESS;
+  size_t m_count = 0;
+  uint64_t m_element_size = 0;
+  /// The elements [m_first, m_end) were read during stop m_stop_id.
+  uint32_t m_stop_id = 0;
+  size_t m_first = 0;
+  size_t m_end = 0;
+};
+
 struct InferiorSizedWord {
 
   InferiorSizedWord(const InferiorSizedWord &word) : ptr_size(word.ptr_size) {
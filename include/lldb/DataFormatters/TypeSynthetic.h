@@ -47,6 +47,11 @@ public:
 
   virtual lldb::ValueObjectSP GetChildAtIndex(size_t idx) = 0;
 
+  // A hint that GetChildAtIndex() is about to be called for every index in
+  // [start, start + count), so that front ends backed by contiguous storage
+  // can read the whole window with a single memory read.
+  virtual void PrefetchChildren(size_t start, size_t count) {}
+
   virtual size_t GetIndexOfChildWithName(ConstString name) = 0;
 
   // this function is assumed to always succeed and it if fails, the front-end
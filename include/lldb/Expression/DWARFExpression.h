@@ -11,10 +11,12 @@
 
 #include "lldb/Core/Address.h"
 #include "lldb/Core/Disassembler.h"
+#include "lldb/Utility/AgentExpression.h"
 #include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Scalar.h"
 #include "lldb/Utility/Status.h"
 #include "lldb/lldb-private.h"
+#include "llvm/ADT/STLExtras.h"
 #include <functional>
 
 class DWARFUnit;
@@ -229,6 +231,47 @@ public:
                        const Value *object_address_ptr, Value &result,
                        Status *error_ptr);
 
+  /// Translate the location this expression has at \a pc into agent
+  /// expression bytecode, so a remote stub can fetch the value without us.
+  ///
+  /// The bytecode leaves the \a byte_size bytes at the location on the
+  /// stack, zero extended to 64 bits.
+  ///
+  /// \param[in] target
+  ///     The target used to resolve DW_OP_addr. Can be NULL, in which case
+  ///     locations with addresses can't be compiled.
+  ///
+  /// \param[in] loclist_base_file_addr
+  ///     The file address of the function that owns the location list, if
+  ///     this is one.
+  ///
+  /// \param[in] pc_file_addr
+  ///     The file address the location is needed at.
+  ///
+  /// \param[in] frame_base
+  ///     The frame base of the enclosing function, for DW_OP_fbreg. Can be
+  ///     NULL.
+  ///
+  /// \param[in] map_register
+  ///     Translates a register of the given kind into the number the stub
+  ///     knows it by.
+  ///
+  /// \param[in] push_cfa
+  ///     Appends code that pushes the canonical frame address at \a pc, for
+  ///     DW_OP_call_frame_cfa.
+  ///
+  /// \return
+  ///     False if the location uses something the bytecode can't express,
+  ///     in which case \a expr is left in an unspecified state.
+  bool CompileToAgentExpression(
+      Target *target, lldb::addr_t loclist_base_file_addr,
+      lldb::addr_t pc_file_addr, const DWARFExpression *frame_base,
+      uint32_t byte_size,
+      llvm::function_ref<bool(lldb::RegisterKind, uint32_t, uint32_t &)>
+          map_register,
+      llvm::function_ref<bool(AgentExpression &)> push_cfa,
+      AgentExpression &expr) const;
+
   bool GetExpressionData(DataExtractor &data) const {
     data = m_data;
     return data.GetByteSize() > 0;
@@ -270,7 +313,23 @@ private:
                     lldb::DescriptionLevel level, ABI *abi) const;
 
   bool GetLocation(lldb::addr_t base_addr, lldb::addr_t pc,
-                   lldb::offset_t &offset, lldb::offset_t &len);
+                   lldb::offset_t &offset, lldb::offset_t &len) const;
+
+  /// What the code CompileLocationToAgentExpression() generates describes.
+  enum AgentLocationKind {
+    eAgentLocationMemory,   ///< The address of the object is on the stack.
+    eAgentLocationRegister, ///< The object is in a register, nothing pushed.
+    eAgentLocationValue     ///< The value of the object is on the stack.
+  };
+
+  bool CompileLocationToAgentExpression(
+      Target *target, lldb::addr_t loclist_base_file_addr,
+      lldb::addr_t pc_file_addr, const DWARFExpression *frame_base,
+      llvm::function_ref<bool(lldb::RegisterKind, uint32_t, uint32_t &)>
+          map_register,
+      llvm::function_ref<bool(AgentExpression &)> push_cfa,
+      AgentExpression &expr, AgentLocationKind &kind,
+      uint32_t &remote_regnum) const;
 
   static bool AddressRangeForLocationListEntry(
       const DWARFUnit *dwarf_cu, const DataExtractor &debug_loc_data,
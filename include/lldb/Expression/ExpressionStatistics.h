@@ -0,0 +1,80 @@
+//===-- ExpressionStatistics.h ----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_ExpressionStatistics_h_
+#define liblldb_ExpressionStatistics_h_
+
+#include "lldb/Utility/StructuredData.h"
+#include "lldb/Utility/Timer.h"
+#include "llvm/ADT/Optional.h"
+
+namespace lldb_private {
+
+class Stream;
+
+/// The time an expression spent in each phase of its evaluation. Set it on
+/// the EvaluateExpressionOptions of an expression to collect them, as
+/// "expression --statistics" does.
+///
+/// A phase a language doesn't have stays at zero. Clang does its semantic
+/// analysis and IR generation as part of parsing, so for C-family languages
+/// they are counted as parse time.
+class ExpressionStatistics {
+public:
+  enum Phase {
+    eParse,
+    eSema,
+    eSIL,
+    eIRGen,
+    eJIT,
+    eMaterialize,
+    eRun,
+    eDematerialize,
+    /// From the start of UserExpression::Evaluate to the result, which
+    /// includes the time spent between the phases above.
+    eTotal,
+    kNumPhases
+  };
+
+  static const char *GetPhaseName(Phase phase);
+
+  StatsDuration &GetDuration(Phase phase) { return m_durations[phase]; }
+
+  /// The time spent in \a phase, in seconds.
+  double Get(Phase phase) const { return m_durations[phase].get(); }
+
+  /// Print one line per phase, with its time in milliseconds.
+  void Dump(Stream &s) const;
+
+  /// The time of each phase in seconds, keyed by the phase names.
+  StructuredData::DictionarySP GetAsStructuredData() const;
+
+private:
+  StatsDuration m_durations[kNumPhases];
+};
+
+/// Adds the time between its construction and its destruction to a phase of
+/// \a stats, if there are statistics to collect.
+class ExpressionPhaseTimer {
+public:
+  ExpressionPhaseTimer(ExpressionStatistics *stats,
+                       ExpressionStatistics::Phase phase) {
+    if (stats)
+      m_elapsed.emplace(stats->GetDuration(phase));
+  }
+
+  /// Stop timing before the end of the scope.
+  void Stop() { m_elapsed.reset(); }
+
+private:
+  llvm::Optional<ElapsedTime> m_elapsed;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_ExpressionStatistics_h_
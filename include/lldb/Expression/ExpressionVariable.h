@@ -9,6 +9,7 @@
 #ifndef liblldb_ExpressionVariable_h_
 #define liblldb_ExpressionVariable_h_
 
+#include <list>
 #include <memory>
 #include <vector>
 
@@ -122,6 +123,8 @@ public:
 /// This class stores variables internally, acting as the permanent store.
 class ExpressionVariableList {
 public:
+  virtual ~ExpressionVariableList() = default;
+
   /// Implementation of methods in ExpressionVariableListBase
   size_t GetSize() { return m_variables.size(); }
 
@@ -132,12 +135,12 @@ public:
     return var_sp;
   }
 
-  size_t AddVariable(const lldb::ExpressionVariableSP &var_sp) {
+  virtual size_t AddVariable(const lldb::ExpressionVariableSP &var_sp) {
     m_variables.push_back(var_sp);
     return m_variables.size() - 1;
   }
 
-  lldb::ExpressionVariableSP
+  virtual lldb::ExpressionVariableSP
   AddNewlyConstructedVariable(ExpressionVariable *var) {
     lldb::ExpressionVariableSP var_sp(var);
     m_variables.push_back(var_sp);
@@ -161,7 +164,7 @@ public:
   /// \return
   ///     The variable requested, or nullptr if that variable is not in the
   ///     list.
-  lldb::ExpressionVariableSP GetVariable(ConstString name) {
+  virtual lldb::ExpressionVariableSP GetVariable(ConstString name) {
     lldb::ExpressionVariableSP var_sp;
     for (size_t index = 0, size = GetSize(); index < size; ++index) {
       var_sp = GetVariableAtIndex(index);
@@ -172,7 +175,7 @@ public:
     return var_sp;
   }
 
-  lldb::ExpressionVariableSP GetVariable(llvm::StringRef name) {
+  virtual lldb::ExpressionVariableSP GetVariable(llvm::StringRef name) {
     if (name.empty())
       return nullptr;
 
@@ -185,7 +188,7 @@ public:
     return nullptr;
   }
 
-  void RemoveVariable(lldb::ExpressionVariableSP var_sp) {
+  virtual void RemoveVariable(lldb::ExpressionVariableSP var_sp) {
     for (std::vector<lldb::ExpressionVariableSP>::iterator
              vi = m_variables.begin(),
              ve = m_variables.end();
@@ -197,12 +200,16 @@ public:
     }
   }
 
-  void Clear() { m_variables.clear(); }
+  virtual void Clear() { m_variables.clear(); }
 
 private:
   std::vector<lldb::ExpressionVariableSP> m_variables;
 };
 
+/// The persistent variables of expressions, looked up by name through an
+/// index. The anonymous result variables ($0, $R0, ...) are limited to the
+/// number in the target.max-expression-results setting: past that, the ones
+/// used least recently are removed.
 class PersistentExpressionState : public ExpressionVariableList {
 public:
   // See TypeSystem.h for how to add subclasses to this.
@@ -214,6 +221,23 @@ public:
 
   virtual ~PersistentExpressionState();
 
+  size_t AddVariable(const lldb::ExpressionVariableSP &var_sp) override;
+
+  lldb::ExpressionVariableSP
+  AddNewlyConstructedVariable(ExpressionVariable *var) override;
+
+  lldb::ExpressionVariableSP GetVariable(ConstString name) override;
+
+  lldb::ExpressionVariableSP GetVariable(llvm::StringRef name) override;
+
+  void RemoveVariable(lldb::ExpressionVariableSP var_sp) override;
+
+  void Clear() override;
+
+  /// Return how many result variables were removed to stay within the
+  /// limit, which shifts the indexes of the variables after them.
+  size_t GetNumEvictedVariables() const { return m_num_evicted; }
+
   virtual lldb::ExpressionVariableSP
   CreatePersistentVariable(const lldb::ValueObjectSP &valobj_sp) = 0;
 
@@ -233,6 +257,12 @@ public:
   virtual void
   RemovePersistentVariable(lldb::ExpressionVariableSP variable) = 0;
 
+  /// Remove a result variable that was used least recently, and anything
+  /// else that was kept for it.
+  virtual void EvictResultVariable(lldb::ExpressionVariableSP variable) {
+    RemovePersistentVariable(variable);
+  }
+
   virtual llvm::Optional<CompilerType>
   GetCompilerTypeFromPersistentDecl(ConstString type_name) = 0;
 
@@ -242,9 +272,48 @@ public:
 
   void RegisterSymbol(ConstString name, lldb::addr_t address);
 
+  /// Return the key under which an expression \a expr with \a prefix and
+  /// \a options, parsed in \a exe_ctx, can be cached, or an empty string if
+  /// it can't be. Two expressions with the same key must compile to the same
+  /// code.
+  virtual std::string
+  GetUserExpressionCacheKey(ExecutionContext &exe_ctx, llvm::StringRef expr,
+                            llvm::StringRef prefix,
+                            const EvaluateExpressionOptions &options) {
+    return {};
+  }
+
+  /// Return the expression that was cached under \a key, or null.
+  virtual lldb::UserExpressionSP GetCachedUserExpression(llvm::StringRef key) {
+    return {};
+  }
+
+  /// Remember the successfully parsed \a user_expression_sp under \a key.
+  virtual void CacheUserExpression(llvm::StringRef key,
+                                   lldb::UserExpressionSP user_expression_sp) {}
+
 private:
+  /// Return true if \a name is one made up for a result, like "$0".
+  bool IsResultVariableName(ConstString name) const;
+
+  /// Record that \a var_sp was added, and evict the result variables used
+  /// least recently if there are too many.
+  void DidAddVariable(const lldb::ExpressionVariableSP &var_sp);
+
   LLVMCastKind m_kind;
 
+  /// The variables by name. If several have the same name, this is the one
+  /// that was added first, which a scan of the list would find.
+  llvm::DenseMap<const char *, lldb::ExpressionVariableSP> m_variables_by_name;
+
+  typedef std::list<lldb::ExpressionVariableSP> ResultList;
+  /// The result variables, most recently used first.
+  ResultList m_results;
+  llvm::DenseMap<ExpressionVariable *, ResultList::iterator> m_result_positions;
+  /// The most result variables to keep, or 0 for no limit.
+  size_t m_max_results = 0;
+  size_t m_num_evicted = 0;
+
   typedef std::set<lldb::IRExecutionUnitSP> ExecutionUnitSet;
   ExecutionUnitSet
       m_execution_units; ///< The execution units that contain valuable symbols.
@@ -68,6 +68,9 @@ public:
   void ReadPointerFromMemory(lldb::addr_t *address,
                              lldb::addr_t process_address, Status &error);
   bool GetAllocSize(lldb::addr_t address, size_t &size);
+  /// Return the policy of the allocation containing \a address, or
+  /// eAllocationPolicyInvalid if there is none.
+  AllocationPolicy GetAllocationPolicy(lldb::addr_t address);
   void GetMemoryData(DataExtractor &extractor, lldb::addr_t process_address,
                      size_t size, Status &error);
 
@@ -27,12 +27,24 @@
 
 #cmakedefine01 HAVE_SIGACTION
 
+#cmakedefine01 HAVE_EPOLL
+
+#cmakedefine01 HAVE_SIGNALFD
+
 #cmakedefine01 HAVE_PROCESS_VM_READV
 
 #cmakedefine01 HAVE_NR_PROCESS_VM_READV
 
+#cmakedefine01 HAVE_PROCESS_VM_WRITEV
+
+#cmakedefine01 HAVE_NR_PROCESS_VM_WRITEV
+
 #ifndef HAVE_LIBCOMPRESSION
 #cmakedefine HAVE_LIBCOMPRESSION
 #endif
 
+#ifndef HAVE_LIBZ
+#cmakedefine HAVE_LIBZ
+#endif
+
 #endif // #ifndef LLDB_HOST_CONFIG_H
@@ -14,16 +14,21 @@
 #include "llvm/ADT/DenseMap.h"
 #include <csignal>
 
-#if !HAVE_PPOLL && !HAVE_SYS_EVENT_H && !defined(__ANDROID__)
+#if HAVE_EPOLL && HAVE_SIGNALFD && !defined(__ANDROID__)
+#define MAINLOOP_USE_EPOLL 1
+#endif
+
+#if !HAVE_PPOLL && !HAVE_SYS_EVENT_H && !MAINLOOP_USE_EPOLL &&                 \
+    !defined(__ANDROID__)
 #define SIGNAL_POLLING_UNSUPPORTED 1
 #endif
 
 namespace lldb_private {
 
 // Implementation of the MainLoopBase class. It can monitor file descriptors
-// for readability using ppoll, kqueue, poll or WSAPoll. On Windows it only
-// supports polling sockets, and will not work on generic file handles or
-// pipes. On systems without kqueue or ppoll handling singnals is not
+// for readability using epoll, ppoll, kqueue, poll or WSAPoll. On Windows it
+// only supports polling sockets, and will not work on generic file handles or
+// pipes. On systems without kqueue, epoll or ppoll handling singnals is not
 // supported. In addition to the common base, this class provides the ability
 // to invoke a given handler when a signal is received.
 //
@@ -102,6 +107,15 @@ private:
   llvm::DenseMap<int, SignalInfo> m_signals;
 #if HAVE_SYS_EVENT_H
   int m_kqueue;
+#elif MAINLOOP_USE_EPOLL
+  // The epoll set is kept up to date as objects are (un)registered, so a
+  // poll does not depend on the number of monitored descriptors. Monitored
+  // signals are blocked and read from m_signal_fd, which is itself part of
+  // the epoll set.
+  void UpdateSignalFD();
+
+  int m_epoll;
+  int m_signal_fd = -1;
 #endif
   bool m_terminate_request : 1;
 };
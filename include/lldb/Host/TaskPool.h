@@ -10,6 +10,7 @@
 #define utility_TaskPool_h_
 
 #include "llvm/ADT/STLExtras.h"
+#include <chrono>
 #include <functional>
 #include <future>
 #include <list>
@@ -23,9 +24,10 @@ namespace lldb_private {
 // thread created the first time the task pool is used. The TaskPool provide no
 // guarantee about the order the task will be run and about what tasks will run
 // in parallel. None of the task added to the task pool should block on
-// something (mutex, future, condition variable) what will be set only by the
+// something (mutex, condition variable) what will be set only by the
 // completion of an other task on the task pool as they may run on the same
-// thread sequentally.
+// thread sequentally. A task can wait for tasks it added itself with Wait(),
+// RunTasks() or TaskMapOverInt(), which run pending tasks while waiting.
 class TaskPool {
 public:
   // Add a new task to the task pool and return a std::future belonging to the
@@ -35,6 +37,13 @@ public:
   static std::future<typename std::result_of<F(Args...)>::type>
   AddTask(F &&f, Args &&... args);
 
+  // Like AddTask, but the task only runs when a worker has no other tasks
+  // left, and threads waiting in Wait() never pick it up. This is meant for
+  // speculative work that nobody is waiting for yet.
+  template <typename F, typename... Args>
+  static std::future<typename std::result_of<F(Args...)>::type>
+  AddLowPriorityTask(F &&f, Args &&... args);
+
   // Run all of the specified tasks on the task pool and wait until all of them
   // are finished before returning. This method is intended to be used for
   // small number tasks where listing them as function arguments is acceptable.
@@ -42,12 +51,20 @@ public:
   // then call wait() on each returned future.
   template <typename... T> static void RunTasks(T &&... tasks);
 
+  // Wait until the task belonging to \a future has finished. Instead of
+  // blocking, the calling thread runs other pending tasks of the pool in the
+  // meantime, so it is safe to call this from inside a task.
+  template <typename R> static void Wait(std::future<R> &future);
+
 private:
   TaskPool() = delete;
 
   template <typename... T> struct RunTaskImpl;
 
-  static void AddTaskImpl(std::function<void()> &&task_fn);
+  static void AddTaskImpl(std::function<void()> &&task_fn,
+                          bool low_priority = false);
+
+  static bool RunPendingTask();
 };
 
 template <typename F, typename... Args>
@@ -62,16 +79,40 @@ TaskPool::AddTask(F &&f, Args &&... args) {
   return task_sp->get_future();
 }
 
+template <typename F, typename... Args>
+std::future<typename std::result_of<F(Args...)>::type>
+TaskPool::AddLowPriorityTask(F &&f, Args &&... args) {
+  auto task_sp = std::make_shared<
+      std::packaged_task<typename std::result_of<F(Args...)>::type()>>(
+      std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+
+  AddTaskImpl([task_sp]() { (*task_sp)(); }, /*low_priority=*/true);
+
+  return task_sp->get_future();
+}
+
 template <typename... T> void TaskPool::RunTasks(T &&... tasks) {
   RunTaskImpl<T...>::Run(std::forward<T>(tasks)...);
 }
 
+template <typename R> void TaskPool::Wait(std::future<R> &future) {
+  while (future.wait_for(std::chrono::seconds(0)) !=
+         std::future_status::ready) {
+    // If there is nothing left to run, the task we are waiting for is running
+    // on another thread and we can block.
+    if (!RunPendingTask()) {
+      future.wait();
+      return;
+    }
+  }
+}
+
 template <typename Head, typename... Tail>
 struct TaskPool::RunTaskImpl<Head, Tail...> {
   static void Run(Head &&h, Tail &&... t) {
     auto f = AddTask(std::forward<Head>(h));
     RunTaskImpl<Tail...>::Run(std::forward<Tail>(t)...);
-    f.wait();
+    Wait(f);
   }
 };
 
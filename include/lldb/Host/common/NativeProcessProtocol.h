@@ -14,6 +14,7 @@
 #include "NativeWatchpointList.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/MainLoop.h"
+#include "lldb/Utility/AgentExpression.h"
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/Status.h"
 #include "lldb/Utility/TraceOptions.h"
@@ -24,6 +25,8 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include <chrono>
+#include <deque>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -40,6 +43,14 @@ struct SVR4LibraryInfo {
   lldb::addr_t next;
 };
 
+/// One range of a NativeProcessProtocol::ReadMemoryRanges() request.
+struct MemoryReadRange {
+  lldb::addr_t addr;
+  void *buf;
+  size_t size;
+  size_t bytes_read;
+};
+
 // NativeProcessProtocol
 class NativeProcessProtocol {
 public:
@@ -69,6 +80,22 @@ public:
 
   virtual Status Kill() = 0;
 
+  /// Switch between all-stop and non-stop mode.
+  ///
+  /// In non-stop mode a thread that stops for a breakpoint, watchpoint,
+  /// signal, etc. is reported on its own through
+  /// NativeDelegate::ThreadStopped and the other threads keep running.
+  /// Resume actions only affect stopped threads, and an action with state
+  /// eStateStopped requests that a running thread stops.
+  ///
+  /// \return
+  ///     Returns an error object if the process cannot use the mode.
+  virtual Status SetNonStopMode(bool non_stop) {
+    if (non_stop)
+      return Status("non-stop mode is not supported");
+    return Status();
+  }
+
   // Tells a process not to stop the inferior on given signals and just
   // reinject them back.
   virtual Status IgnoreSignals(llvm::ArrayRef<int> signals);
@@ -84,6 +111,23 @@ public:
   Status ReadMemoryWithoutTrap(lldb::addr_t addr, void *buf, size_t size,
                                size_t &bytes_read);
 
+  /// Whether ReadMemory() may be called concurrently from threads other than
+  /// the one driving this process. This is false by default, as debugger
+  /// APIs like ptrace only work from the thread that attached.
+  virtual bool CanReadMemoryConcurrently() const { return false; }
+
+  /// Read several ranges of memory at once.
+  ///
+  /// The bytes_read member of every range is set to the number of bytes
+  /// read into its buffer. A range that can't be read doesn't keep the
+  /// others from being read. The default implementation calls ReadMemory()
+  /// for each range, subclasses can do it with fewer system calls.
+  virtual void ReadMemoryRanges(llvm::MutableArrayRef<MemoryReadRange> ranges);
+
+  /// Same as ReadMemoryRanges(), but with software breakpoint opcodes replaced
+  /// by the original memory contents.
+  void ReadMemoryRangesWithoutTrap(llvm::MutableArrayRef<MemoryReadRange> ranges);
+
   /// Reads a null terminated string from memory.
   ///
   /// Reads up to \p max_size bytes of memory until it finds a '\0'.
@@ -137,6 +181,13 @@ public:
 
   virtual Status RemoveBreakpoint(lldb::addr_t addr, bool hardware = false);
 
+  /// Make the software breakpoint at \a addr only stop the process when one
+  /// of \a conditions evaluates to non-zero. Replaces any conditions set
+  /// before; an empty list makes the breakpoint unconditional again.
+  Status
+  SetSoftwareBreakpointConditions(lldb::addr_t addr,
+                                  std::vector<AgentExpression> conditions);
+
   // Hardware Breakpoint functions
   virtual const HardwareBreakpointMap &GetHardwareBreakpointMap() const;
 
@@ -215,6 +266,15 @@ public:
                                      lldb::StateType state) = 0;
 
     virtual void DidExec(NativeProcessProtocol *process) = 0;
+
+    /// Called in non-stop mode when \a thread stopped while the process
+    /// itself keeps running.
+    virtual void ThreadStopped(NativeProcessProtocol *process,
+                               NativeThreadProtocol &thread) = 0;
+
+    /// Called when tracepoint hits are waiting to be taken with
+    /// TakeTracepointHits.
+    virtual void TracepointHitsRecorded(NativeProcessProtocol *process) {}
   };
 
   /// Register a native delegate.
@@ -393,13 +453,71 @@ public:
     return Status("Not implemented");
   }
 
+  /// Save a copy of the stopped process that RestoreSnapshot can go back
+  /// to later.
+  ///
+  /// \return
+  ///     The ID of the snapshot.
+  virtual llvm::Expected<lldb::user_id_t> SaveSnapshot() {
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "Not implemented");
+  }
+
+  /// Replace the stopped process with a copy of snapshot \a snapshot_id.
+  /// The snapshot itself is kept, so it can be restored again. The process
+  /// and its threads get new IDs.
+  virtual Status RestoreSnapshot(lldb::user_id_t snapshot_id) {
+    return Status("Not implemented");
+  }
+
+  virtual Status DeleteSnapshot(lldb::user_id_t snapshot_id) {
+    return Status("Not implemented");
+  }
+
+  struct TracepointHit {
+    lldb::tid_t tid;
+    lldb::addr_t pc;
+    /// Nanoseconds since an arbitrary point, on a clock that never goes
+    /// backwards.
+    uint64_t timestamp;
+    /// The values of the registers the tracepoint records, in order.
+    /// Registers that can't be read are recorded as 0.
+    llvm::SmallVector<uint64_t, 6> registers;
+  };
+
+  /// Record the hits of the software breakpoint at \a addr, setting one if
+  /// there is none, along with the values of \a registers, which are
+  /// register numbers of the register context. A tracepoint only stops the
+  /// process when a breakpoint at the same address does; otherwise the
+  /// thread is resumed right away. Setting a tracepoint again replaces its
+  /// registers.
+  virtual Status SetTracepoint(lldb::addr_t addr,
+                               std::vector<uint32_t> registers) {
+    return Status("Not implemented");
+  }
+
+  virtual Status RemoveTracepoint(lldb::addr_t addr) {
+    return Status("Not implemented");
+  }
+
+  /// Take the tracepoint hits recorded since the last call, oldest first.
+  /// At most k_max_tracepoint_hits are kept, the older ones are dropped;
+  /// \a num_dropped is set to how many were.
+  std::vector<TracepointHit> TakeTracepointHits(size_t &num_dropped);
+
 protected:
   struct SoftwareBreakpoint {
     uint32_t ref_count;
     llvm::SmallVector<uint8_t, 4> saved_opcodes;
     llvm::ArrayRef<uint8_t> breakpoint_opcodes;
+    std::vector<AgentExpression> conditions;
+    /// Whether a tracepoint holds one of the references.
+    bool is_tracepoint = false;
+    std::vector<uint32_t> trace_registers;
   };
 
+  static const size_t k_max_tracepoint_hits = 1 << 16;
+
   std::unordered_map<lldb::addr_t, SoftwareBreakpoint> m_software_breakpoints;
   lldb::pid_t m_pid;
 
@@ -423,6 +541,10 @@ protected:
   // stopping it.
   llvm::DenseSet<int> m_signals_to_ignore;
 
+  std::deque<TracepointHit> m_tracepoint_hits;
+  size_t m_num_dropped_tracepoint_hits = 0;
+  std::chrono::steady_clock::time_point m_last_tracepoint_hits_notification;
+
   // lldb_private::Host calls should be used to launch a process for debugging,
   // and then the process should be attached to. When attaching to a process
   // lldb_private::Host calls should be used to locate the process to attach
@@ -460,16 +582,40 @@ protected:
   // resets it to point to the breakpoint itself.
   void FixupBreakpointPCAsNeeded(NativeThreadProtocol &thread);
 
+  /// Evaluate the conditions of the software breakpoint at \a addr for
+  /// \a thread. Returns true if the hit has to be reported: when there are
+  /// no conditions, when one of them is true, or when one can't be
+  /// evaluated.
+  bool SoftwareBreakpointConditionsSayStop(NativeThreadProtocol &thread,
+                                           lldb::addr_t addr);
+
+  /// Implementations of SetTracepoint and RemoveTracepoint for processes
+  /// that can hide software breakpoints from their hits.
+  Status SetSoftwareTracepoint(lldb::addr_t addr,
+                               std::vector<uint32_t> registers);
+  Status RemoveSoftwareTracepoint(lldb::addr_t addr);
+
+  /// Record a hit of \a thread if there is a tracepoint at \a addr, and
+  /// tell the delegates once enough hits are waiting or enough time has
+  /// passed since they were last told. Returns true if the hit only has to
+  /// be recorded, and the thread can go on without reporting it.
+  bool RecordTracepointHit(NativeThreadProtocol &thread, lldb::addr_t addr);
+
   /// Notify the delegate that an exec occurred.
   ///
   /// Provide a mechanism for a delegate to clear out any exec-
   /// sensitive data.
   void NotifyDidExec();
 
+  /// Notify the delegate that a single thread stopped in non-stop mode.
+  void NotifyThreadStopped(NativeThreadProtocol &thread);
+
   NativeThreadProtocol *GetThreadByIDUnlocked(lldb::tid_t tid);
 
 private:
   void SynchronouslyNotifyProcessStateChanged(lldb::StateType state);
+  void RemoveTrapsFromBuffer(lldb::addr_t addr,
+                             llvm::MutableArrayRef<uint8_t> data);
   llvm::Expected<SoftwareBreakpoint>
   EnableSoftwareBreakpoint(lldb::addr_t addr, uint32_t size_hint);
 };
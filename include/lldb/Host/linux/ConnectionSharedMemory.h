@@ -0,0 +1,95 @@
+//===-- ConnectionSharedMemory.h --------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_Host_linux_ConnectionSharedMemory_h_
+#define liblldb_Host_linux_ConnectionSharedMemory_h_
+
+#include <memory>
+#include <mutex>
+
+#include "lldb/Utility/Connection.h"
+
+namespace lldb_private {
+
+class Status;
+
+/// A connection between two processes on the same host that moves its data
+/// through two single producer, single consumer ring buffers in shared
+/// memory, one for each direction.
+///
+/// The rings are lock-free, so the data itself never goes through the
+/// kernel. A second connection, usually one end of a socketpair, serves as
+/// the doorbell: a byte is written to it only when the other end is waiting
+/// for data, and it is what GetReadObject() returns for main loops to wait
+/// on. It also tells when the other end has gone away.
+class ConnectionSharedMemory : public Connection {
+public:
+  /// Create the memory the two ends of a connection share, with its rings
+  /// set up. The other end gets a copy of \a shm_fd, usually inherited.
+  static Status CreateSharedMemory(int &shm_fd);
+
+  /// \param[in] doorbell
+  ///     A connection to the other end, used to wake it up.
+  ///
+  /// \param[in] shm_fd
+  ///     The memory from CreateSharedMemory(). The connection takes
+  ///     ownership of it.
+  ///
+  /// \param[in] creator
+  ///     True for the end that called CreateSharedMemory(). The two ends
+  ///     must pass different values.
+  ConnectionSharedMemory(std::unique_ptr<Connection> doorbell, int shm_fd,
+                         bool creator);
+
+  ~ConnectionSharedMemory() override;
+
+  bool IsConnected() const override;
+
+  lldb::ConnectionStatus Connect(llvm::StringRef url,
+                                 Status *error_ptr) override;
+
+  lldb::ConnectionStatus Disconnect(Status *error_ptr) override;
+
+  size_t Read(void *dst, size_t dst_len, const Timeout<std::micro> &timeout,
+              lldb::ConnectionStatus &status, Status *error_ptr) override;
+
+  size_t Write(const void *src, size_t src_len, lldb::ConnectionStatus &status,
+               Status *error_ptr) override;
+
+  std::string GetURI() override;
+
+  bool InterruptRead() override;
+
+  lldb::IOObjectSP GetReadObject() override;
+
+private:
+  struct Ring;
+  struct Header;
+
+  size_t ReadFromRing(void *dst, size_t dst_len);
+
+  size_t WriteToRing(const void *src, size_t src_len);
+
+  bool PeerHungUp();
+
+  std::unique_ptr<Connection> m_doorbell;
+  Header *m_header = nullptr;
+  size_t m_mapping_size = 0;
+  Ring *m_read_ring = nullptr;
+  uint8_t *m_read_data = nullptr;
+  Ring *m_write_ring = nullptr;
+  uint8_t *m_write_data = nullptr;
+  std::mutex m_read_mutex;
+  std::mutex m_write_mutex;
+
+  DISALLOW_COPY_AND_ASSIGN(ConnectionSharedMemory);
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_Host_linux_ConnectionSharedMemory_h_
@@ -179,7 +179,6 @@ public:
     void DoCompletion(SearchFilter *filter) override;
 
   private:
-    RegularExpression m_regex;
     typedef std::set<ConstString> collection;
     collection m_match_set;
 
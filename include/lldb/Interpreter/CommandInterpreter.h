@@ -23,6 +23,7 @@
 #include "lldb/Utility/StringList.h"
 #include "lldb/lldb-forward.h"
 #include "lldb/lldb-private.h"
+#include "llvm/ADT/StringMap.h"
 #include <mutex>
 
 namespace lldb_private {
@@ -247,7 +248,10 @@ public:
 
   bool RemoveUser(llvm::StringRef alias_name);
 
-  void RemoveAllUser() { m_user_dict.clear(); }
+  void RemoveAllUser() {
+    m_user_dict.clear();
+    m_command_object_cache.clear();
+  }
 
   const CommandAlias *GetAlias(llvm::StringRef alias_name) const;
 
@@ -521,6 +525,10 @@ private:
   CommandObject *ResolveCommandImpl(std::string &command_line,
                                     CommandReturnObject &result);
 
+  // The uncached lookup behind GetCommandObject.
+  CommandObject *FindCommandObject(llvm::StringRef cmd, StringList *matches,
+                                   StringList *descriptions) const;
+
   void FindCommandsForApropos(llvm::StringRef word, StringList &commands_found,
                               StringList &commands_help,
                               CommandObject::CommandMap &command_map);
@@ -560,6 +568,11 @@ private:
   CommandObject::CommandMap
       m_alias_dict; // Stores user aliases/abbreviations for commands
   CommandObject::CommandMap m_user_dict; // Stores user-defined commands
+  /// The commands GetCommandObject() found, with the full name each one was
+  /// found under, by the possibly abbreviated name that was looked up.
+  /// Cleared whenever a command, alias or user command is added or removed.
+  mutable llvm::StringMap<std::pair<CommandObject *, std::string>>
+      m_command_object_cache;
   CommandHistory m_command_history;
   std::string m_repeat_command; // Stores the command that will be executed for
                                 // an empty command string.
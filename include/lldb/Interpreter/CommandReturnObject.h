@@ -45,7 +45,7 @@ public:
   Stream &GetOutputStream() {
     // Make sure we at least have our normal string stream output stream
     lldb::StreamSP stream_sp(m_out_stream.GetStreamAtIndex(eStreamStringIndex));
-    if (!stream_sp) {
+    if (!stream_sp && !(m_immediate_only && GetImmediateOutputStream())) {
       stream_sp.reset(new StreamString());
       m_out_stream.SetStreamAtIndex(eStreamStringIndex, stream_sp);
     }
@@ -55,7 +55,7 @@ public:
   Stream &GetErrorStream() {
     // Make sure we at least have our normal string stream output stream
     lldb::StreamSP stream_sp(m_err_stream.GetStreamAtIndex(eStreamStringIndex));
-    if (!stream_sp) {
+    if (!stream_sp && !(m_immediate_only && GetImmediateErrorStream())) {
       stream_sp.reset(new StreamString());
       m_err_stream.SetStreamAtIndex(eStreamStringIndex, stream_sp);
     }
@@ -88,6 +88,16 @@ public:
     return m_err_stream.GetStreamAtIndex(eImmediateStreamIndex);
   }
 
+  /// Only write the output and errors to the immediate streams, where there
+  /// are some, instead of also keeping them for GetOutputData() and
+  /// GetErrorData(). Commands that print a lot, like "image dump symtab",
+  /// then don't hold all of it in memory.
+  void SetImmediateOnly(bool immediate_only) {
+    m_immediate_only = immediate_only;
+  }
+
+  bool GetImmediateOnly() const { return m_immediate_only; }
+
   void Clear();
 
   void AppendMessage(llvm::StringRef in_string);
@@ -162,6 +172,7 @@ private:
   bool m_did_change_process_state;
   bool m_interactive; // If true, then the input handle from the debugger will
                       // be hooked up
+  bool m_immediate_only = false;
   bool m_abnormal_stop_was_expected; // This is to support
                                      // eHandleCommandFlagStopOnCrash vrs.
                                      // attach.
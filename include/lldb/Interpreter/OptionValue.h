@@ -316,11 +316,19 @@ public:
   }
 
   void NotifyValueChanged() {
+    BumpChangeGeneration();
     if (m_callback)
       m_callback(m_baton, this);
   }
 
+  /// Goes up whenever an option value changes, so values read from the
+  /// settings can be cached until this moves on.
+  static uint32_t GetChangeGeneration();
+
 protected:
+  /// Called after a value has changed, see GetChangeGeneration().
+  static void BumpChangeGeneration();
+
   lldb::OptionValueWP m_parent_wp;
   OptionValueChangedCallback m_callback;
   void *m_baton;
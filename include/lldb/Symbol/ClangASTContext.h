@@ -60,6 +60,8 @@ public:
 
   void Finalize() override;
 
+  size_t GetMemoryUsage() override;
+
   // PluginInterface functions
   ConstString GetPluginName() override;
 
@@ -462,6 +464,16 @@ public:
       llvm::DenseMap<const clang::CXXRecordDecl *, clang::CharUnits>
           &vbase_offsets);
 
+  static void FindExternalVisibleDeclsByName(
+      void *baton, const clang::DeclContext *decl_ctx,
+      clang::DeclarationName name,
+      llvm::SmallVectorImpl<clang::NamedDecl *> *results);
+
+  /// Add the methods of \a record_decl that were left to be created when
+  /// they are looked up by name. Code that walks all the methods of a class,
+  /// or copies it into another AST, calls this first.
+  static void CompleteDeferredMethods(const clang::CXXRecordDecl *record_decl);
+
   // CompilerDecl override functions
   ConstString DeclGetName(void *opaque_decl) override;
 
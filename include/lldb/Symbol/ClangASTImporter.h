@@ -141,6 +141,13 @@ public:
 
   bool CompleteTagDeclWithOrigin(clang::TagDecl *decl, clang::TagDecl *origin);
 
+  /// Remember that \a definition completes \a forward_decl, a declaration
+  /// that is only forward declared in its own AST.  Later completions of
+  /// decls originating from \a forward_decl use \a definition directly
+  /// instead of searching all modules for it again.
+  void RememberCompleteDefinition(const clang::TagDecl *forward_decl,
+                                  clang::TagDecl *definition);
+
   bool CompleteObjCInterfaceDecl(clang::ObjCInterfaceDecl *interface_decl);
 
   bool CompleteAndFetchChildren(clang::QualType type);
@@ -396,6 +403,13 @@ private:
       RecordDeclToLayoutMap;
 
   RecordDeclToLayoutMap m_record_decl_to_layout_map;
+
+  typedef llvm::DenseMap<const clang::TagDecl *, clang::TagDecl *>
+      CompleteDefinitionMap;
+
+  /// Forward declarations in module ASTs mapped to the definition that was
+  /// found for them in another module.
+  CompleteDefinitionMap m_complete_definitions;
 };
 
 } // namespace lldb_private
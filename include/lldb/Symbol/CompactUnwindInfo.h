@@ -14,6 +14,7 @@
 #include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/lldb-private.h"
+#include "llvm/ADT/ArrayRef.h"
 #include <mutex>
 #include <vector>
 
@@ -41,6 +42,13 @@ public:
 
   bool GetUnwindPlan(Target &target, Address addr, UnwindPlan &unwind_plan);
 
+  // Get the UnwindPlans for many addresses at once, e.g. the pcs of all the
+  // threads being backtraced.  \a unwind_plans gets one entry per address,
+  // empty where there is no compact unwind.  The addresses are visited in
+  // file address order so each second level page is decoded only once.
+  void GetUnwindPlans(Target &target, llvm::ArrayRef<Address> addrs,
+                      std::vector<lldb::UnwindPlanSP> &unwind_plans);
+
   bool IsValid(const lldb::ProcessSP &process_sp);
 
 private:
@@ -104,24 +112,30 @@ private:
           personality_array_offset(0), personality_array_count(0) {}
   };
 
+  // A second level page decoded into the start offset (relative to the
+  // object file's base address) and the compact encoding of each function
+  // it covers.  Encodings of compressed pages are already resolved through
+  // the common and page-specific encoding arrays.
+  struct SecondLevelPage {
+    uint32_t kind = 0; // UNWIND_SECOND_LEVEL_REGULAR or
+                       // UNWIND_SECOND_LEVEL_COMPRESSED
+    std::vector<uint32_t> function_offsets;
+    std::vector<uint32_t> encodings;
+  };
+
+  typedef std::shared_ptr<SecondLevelPage> SecondLevelPageSP;
+
+  enum { kSecondLevelPageCacheSize = 8 };
+
   void ScanIndex(const lldb::ProcessSP &process_sp);
 
+  // Return the decoded second level page for \a index, from the cache of
+  // recently used pages if possible.
+  SecondLevelPageSP GetSecondLevelPage(const UnwindIndex &index);
+
   bool GetCompactUnwindInfoForFunction(Target &target, Address address,
                                        FunctionInfo &unwind_info);
 
-  lldb::offset_t
-  BinarySearchRegularSecondPage(uint32_t entry_page_offset,
-                                uint32_t entry_count, uint32_t function_offset,
-                                uint32_t *entry_func_start_offset,
-                                uint32_t *entry_func_end_offset);
-
-  uint32_t BinarySearchCompressedSecondPage(uint32_t entry_page_offset,
-                                            uint32_t entry_count,
-                                            uint32_t function_offset_to_find,
-                                            uint32_t function_offset_base,
-                                            uint32_t *entry_func_start_offset,
-                                            uint32_t *entry_func_end_offset);
-
   uint32_t GetLSDAForFunctionOffset(uint32_t lsda_offset, uint32_t lsda_count,
                                     uint32_t function_offset);
 
@@ -160,6 +174,11 @@ private:
                                    // data
 
   UnwindHeader m_unwind_header;
+
+  // The most recently used decoded second level pages, keyed by their
+  // section offset, most recent first.
+  std::vector<std::pair<uint32_t, SecondLevelPageSP>> m_page_cache;
+  std::mutex m_page_cache_mutex;
 };
 
 } // namespace lldb_private
@@ -34,7 +34,12 @@ class DWARFCallFrameInfo {
 public:
   enum Type { EH, DWARF };
 
-  DWARFCallFrameInfo(ObjectFile &objfile, lldb::SectionSP &section, Type type);
+  // \a eh_frame_hdr is the optional .eh_frame_hdr section describing an EH
+  // \a section.  When it carries a binary search table, FDEs for a given
+  // address are located through that table instead of by scanning the whole
+  // section.
+  DWARFCallFrameInfo(ObjectFile &objfile, lldb::SectionSP &section, Type type,
+                     lldb::SectionSP eh_frame_hdr = lldb::SectionSP());
 
   ~DWARFCallFrameInfo() = default;
 
@@ -75,6 +80,14 @@ public:
   void ForEachFDEEntries(
       const std::function<bool(lldb::addr_t, uint32_t, dw_offset_t)> &callback);
 
+  // Returns true if FDEs can be looked up through the .eh_frame_hdr binary
+  // search table without building the full FDE index.
+  bool HasLookupTable();
+
+  // Scan the section and build the FDE index now, e.g. from a background
+  // thread, so that the first caller that needs it doesn't pay for the scan.
+  void BuildFDEIndex() { GetFDEIndex(); }
+
 private:
   enum { CFI_AUG_MAX_SIZE = 8, CFI_HEADER_SIZE = 8 };
   enum CFIVersion {
@@ -126,6 +139,24 @@ private:
 
   void GetFDEIndex();
 
+  // Parse the .eh_frame_hdr header and locate its binary search table.
+  void GetLookupTable();
+
+  // Decode entry \a idx of the .eh_frame_hdr binary search table into the
+  // function's start address and the section offset of its FDE.
+  bool GetLookupTableEntry(uint32_t idx, lldb::addr_t &initial_location,
+                           dw_offset_t &fde_offset);
+
+  // Find the FDE containing, or failing that the first FDE following, the
+  // start of \a range using the .eh_frame_hdr binary search table.
+  llvm::Optional<FDEEntryMap::Entry>
+  GetFirstFDEEntryInRangeFromLookupTable(const AddressRange &range);
+
+  // Decode the address range covered by the FDE at \a fde_offset.
+  llvm::Optional<FDEEntryMap::Entry> ParseFDEEntry(dw_offset_t fde_offset);
+
+  bool ShouldClearAddressZerothBit();
+
   bool FDEToUnwindPlan(uint32_t offset, Address startaddr,
                        UnwindPlan &unwind_plan);
 
@@ -146,9 +177,20 @@ private:
   lldb::SectionSP m_section_sp;
   Flags m_flags = 0;
   cie_map_t m_cie_map;
+  std::mutex m_cie_map_mutex;
 
   DataExtractor m_cfi_data;
   bool m_cfi_data_initialized = false; // only copy the section into the DE once
+  std::mutex m_cfi_data_mutex;
+
+  lldb::SectionSP m_eh_frame_hdr_sp;
+  DataExtractor m_eh_frame_hdr_data;
+  lldb::offset_t m_lookup_table_offset = 0;
+  uint32_t m_lookup_table_count = 0;
+  uint8_t m_lookup_table_encoding = DW_EH_PE_omit;
+  uint8_t m_lookup_table_entry_size = 0;
+  bool m_lookup_table_initialized = false; // only parse the header once
+  std::mutex m_lookup_table_mutex;
 
   FDEEntryMap m_fde_index;
   bool m_fde_index_initialized = false; // only scan the section for FDEs once
@@ -99,6 +99,9 @@ public:
 private:
   lldb::UnwindAssemblySP GetUnwindAssemblyProfiler(Target &target);
 
+  lldb::UnwindPlanSP ComputeUnwindPlanAtNonCallSite(Target &target,
+                                                    Thread &thread);
+
   // Do a simplistic comparison for the register restore rule for getting the
   // caller's pc value on two UnwindPlans -- returns LazyBoolYes if they have
   // the same unwind rule for the pc, LazyBoolNo if they do not have the same
@@ -127,6 +130,11 @@ private:
   lldb::UnwindPlanSP m_unwind_plan_arch_default_sp;
   lldb::UnwindPlanSP m_unwind_plan_arch_default_at_func_entry_sp;
 
+  // The plan GetUnwindPlanAtNonCallSite picked. All of its candidates are
+  // cached above, so the choice doesn't change once made and every thread
+  // stopped in this function can reuse it.
+  lldb::UnwindPlanSP m_unwind_plan_non_call_site_sp;
+
   // Fetching the UnwindPlans can be expensive - if we've already attempted to
   // get one & failed, don't try again.
   bool m_tried_unwind_plan_assembly : 1, m_tried_unwind_plan_eh_frame : 1,
@@ -136,7 +144,8 @@ private:
       m_tried_unwind_plan_compact_unwind : 1,
       m_tried_unwind_plan_arm_unwind : 1, m_tried_unwind_plan_symbol_file : 1,
       m_tried_unwind_fast : 1, m_tried_unwind_arch_default : 1,
-      m_tried_unwind_arch_default_at_func_entry : 1;
+      m_tried_unwind_arch_default_at_func_entry : 1,
+      m_tried_unwind_plan_non_call_site : 1;
 
   Address m_first_non_prologue_insn;
 
@@ -14,6 +14,7 @@
 #include "lldb/Symbol/LineEntry.h"
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/lldb-private.h"
+#include <mutex>
 #include <vector>
 
 namespace lldb_private {
@@ -78,6 +79,15 @@ public:
   // Insert a sequence of entries into this line table.
   void InsertSequence(LineSequence *sequence);
 
+  /// Encode the line entries into a compact, block compressed form.
+  ///
+  /// Entries are delta encoded in blocks of a fixed number of rows, and the
+  /// start address of each block is kept in a separate array that lookups
+  /// binary search before decoding a single block. This is called once the
+  /// line table is complete; inserting more entries afterwards decodes the
+  /// whole table again.
+  void Compact();
+
   /// Dump all line entries in this line table to the stream \a s.
   ///
   /// \param[in] s
@@ -311,6 +321,16 @@ protected:
     Entry *a_entry;
   };
 
+  /// The header of a block of compressed line entries.
+  struct EncodedBlock {
+    /// The file address of the first entry in the block.
+    lldb::addr_t file_addr;
+    /// The source line of the first entry in the block.
+    uint32_t line;
+    /// The offset of the block's entries in m_encoded_entries.
+    uint32_t data_offset;
+  };
+
   // Types
   typedef std::vector<lldb_private::Section *>
       section_collection; ///< The collection type for the sections.
@@ -322,6 +342,40 @@ protected:
   entry_collection
       m_entries; ///< The collection of line entries in this line table.
 
+  /// Number of entries encoded per block when the table is compacted.
+  static constexpr uint32_t kEntriesPerBlock = 64;
+
+  /// The compacted line entries, see Compact(). When these are used
+  /// \a m_entries is empty.
+  /// @{
+  std::vector<EncodedBlock> m_encoded_blocks;
+  std::vector<uint8_t> m_encoded_entries;
+  uint32_t m_num_encoded_entries = 0;
+  /// @}
+
+  /// The most recently decoded block, so walking the table in order only
+  /// decodes each block once.
+  /// @{
+  mutable std::mutex m_decoded_block_mutex;
+  mutable uint32_t m_decoded_block_idx = UINT32_MAX;
+  mutable entry_collection m_decoded_block;
+  /// @}
+
+  bool IsCompacted() const { return !m_encoded_blocks.empty(); }
+
+  /// Decode a compacted table back into \a m_entries.
+  void Expand();
+
+  /// Decode the block at \a block_idx into \a entries.
+  void DecodeBlock(uint32_t block_idx, entry_collection &entries) const;
+
+  /// Get a copy of the entry at \a idx, which must be less than GetSize().
+  Entry GetEntry(uint32_t idx) const;
+
+  /// Get the index of the first entry whose address is not less than \a
+  /// file_addr, or GetSize() if there is none.
+  uint32_t LowerBoundByAddress(lldb::addr_t file_addr) const;
+
   // Helper class
   class LineSequenceImpl : public LineSequence {
   public:
@@ -347,6 +347,21 @@ public:
   ///     symbols.
   virtual bool IsStripped() = 0;
 
+  /// Detect if the symbol table of this object file is complete on its own.
+  ///
+  /// Object files that rely on a separate debug info file for their full
+  /// symbol table need the symbol file to be located before GetSymtab()
+  /// returns the final table. Those that don't can answer symbol queries
+  /// without locating or parsing any debug info.
+  ///
+  /// \return
+  ///     Return \b true if GetSymtab() doesn't depend on sections that a
+  ///     separate debug info file may contribute.
+  virtual bool HasCompleteSymtab() { return false; }
+
+  /// Returns true if GetSymtab() has already parsed the symbol table.
+  bool HasParsedSymtab() const { return m_symtab_up != nullptr; }
+
   /// Frees the symbol table.
   ///
   /// This function should only be used when an object file is
@@ -124,6 +124,8 @@ public:
 
   ~SwiftASTContext();
 
+  size_t GetMemoryUsage() override;
+
   // PluginInterface functions
   ConstString GetPluginName() override;
 
@@ -245,9 +247,20 @@ public:
   bool RegisterSectionModules(Module &module,
                               std::vector<std::string> &module_names);
 
+  /// Load each of \a module_names to report the ones that fail to load. This
+  /// is skipped if an earlier session already loaded the same modules without
+  /// errors, see modulelist.swift-module-validation-cache-path.
   void ValidateSectionModules(Module &module, // this is used to print errors
                               const std::vector<std::string> &module_names);
 
+  /// Compute the key under which the result of ValidateSectionModules is
+  /// cached. It covers the module binary, the compiler version and all the
+  /// settings that affect how \a module_names are loaded. Returns an empty
+  /// string if \a module has no UUID.
+  std::string
+  GetSectionModulesValidationKey(Module &module,
+                                 const std::vector<std::string> &module_names);
+
   // Swift modules that are backed by dylibs (libFoo.dylib) rather than
   // frameworks don't actually record the library dependencies in the module.
   // This will hand load any libraries that are on the IRGen LinkLibraries list
@@ -732,10 +745,23 @@ public:
                                 lldb::StackFrameWP &stack_frame_wp,
                                 swift::SourceFile &source_file, Status &error);
 
-  static bool PerformAutoImport(SwiftASTContext &swift_ast_context,
-                                SymbolContext &sc,
-                                lldb::StackFrameWP &stack_frame_wp,
-                                swift::SourceFile *source_file, Status &error);
+  /// Import the Swift standard library and the modules imported by the
+  /// compile unit of \a sc. If \a deferred_imports is not null, only the
+  /// standard library is imported and the compile unit's modules are added
+  /// to \a deferred_imports instead, see LoadDeferredImport.
+  static bool
+  PerformAutoImport(SwiftASTContext &swift_ast_context, SymbolContext &sc,
+                    lldb::StackFrameWP &stack_frame_wp,
+                    swift::SourceFile *source_file, Status &error,
+                    std::vector<SourceModule> *deferred_imports = nullptr);
+
+  /// Load a module that PerformAutoImport deferred. Unlike the modules
+  /// PerformAutoImport loads, it is not added to the imports of any source
+  /// file, so that it can be loaded while an expression is type checked.
+  static swift::ModuleDecl *
+  LoadDeferredImport(SwiftASTContext &swift_ast_context,
+                     const SourceModule &module,
+                     lldb::StackFrameWP &stack_frame_wp, Status &error);
 
 protected:
   /// This map uses the string value of ConstStrings as the key, and the TypeBase
@@ -801,6 +827,9 @@ protected:
       nullptr;
   swift::ClangImporter *m_clang_importer = nullptr;
   SwiftModuleMap m_swift_module_cache;
+  /// Guards m_swift_module_cache, which modules can be added to from
+  /// several threads.
+  std::mutex m_swift_module_cache_mutex;
   SwiftTypeFromMangledNameMap m_mangled_name_to_type_map;
   SwiftMangledNameFromTypeMap m_type_to_mangled_name_map;
   uint32_t m_pointer_byte_size = 0;
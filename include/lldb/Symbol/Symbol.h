@@ -14,6 +14,8 @@
 #include "lldb/Symbol/SymbolContextScope.h"
 #include "lldb/Utility/UserID.h"
 #include "lldb/lldb-private.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 
 namespace lldb_private {
 
@@ -224,6 +226,22 @@ public:
 
   bool ContainsFileAddress(lldb::addr_t file_addr) const;
 
+  /// Write this symbol to the binary stream \a s. Names are added to \a
+  /// strtab, which has to be encoded separately. Sections are referred to by
+  /// their number in \a section_ids, zero meaning no section.
+  ///
+  /// \return
+  ///     \b false if the section of this symbol has no number.
+  bool Encode(Stream &s, ConstStringTable &strtab,
+              const llvm::DenseMap<const Section *, uint32_t> &section_ids)
+      const;
+
+  /// Replace this symbol with the data written by Encode(). The section
+  /// numbered \b N is \a sections[N - 1].
+  bool Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
+              const ConstStringTable &strtab,
+              llvm::ArrayRef<lldb::SectionSP> sections);
+
 protected:
   // This is the internal guts of ResolveReExportedSymbol, it assumes
   // reexport_name is not null, and that module_spec is valid.  We track the
@@ -297,6 +297,28 @@ public:
 
   virtual void Dump(Stream &s);
 
+  /// \{
+  /// Statistics for "statistics dump".
+  ///
+  /// The size of the debug info this symbol file reads, in bytes.
+  virtual uint64_t GetDebugInfoSize() { return 0; }
+
+  /// The time spent indexing the debug info, in seconds.
+  virtual double GetDebugInfoIndexTime() { return 0; }
+
+  /// The number of types whose definitions have been completed.
+  virtual uint64_t GetNumTypesCompleted() { return 0; }
+
+  /// The memory held by the debug info parsed so far, in bytes.
+  virtual uint64_t GetDebugInfoMemoryUsage() { return 0; }
+
+  /// The memory held by the index of the debug info, in bytes.
+  virtual uint64_t GetDebugInfoIndexMemoryUsage() { return 0; }
+  /// \}
+
+  /// Free the caches that are filled again when needed.
+  virtual void ReleaseCaches() {}
+
 protected:
   class SourceRange {
   public:
@@ -13,9 +13,16 @@
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/lldb-private.h"
+#include "llvm/ADT/ArrayRef.h"
+#include <memory>
 #include <mutex>
+#include <set>
 #include <vector>
 
+namespace llvm {
+class LockFileManager;
+} // namespace llvm
+
 namespace lldb_private {
 
 class Symtab {
@@ -39,6 +46,9 @@ public:
   Symbol *Resize(size_t count);
   uint32_t AddSymbol(const Symbol &symbol);
   size_t GetNumSymbols() const;
+  /// The memory held by the symbols and the lookup tables, not counting the
+  /// names, which are in the ConstString pool.
+  size_t MemorySize() const;
   void
   Dump(Stream *s, Target *target, SortOrder sort_type,
        Mangled::NamePreference name_preference = Mangled::ePreferDemangled);
@@ -116,8 +126,32 @@ public:
   Symbol *FindSymbolContainingFileAddress(lldb::addr_t file_addr);
   void ForEachSymbolContainingFileAddress(
       lldb::addr_t file_addr, std::function<bool(Symbol *)> const &callback);
+
+  /// Find the symbol containing each address in \a file_addrs, as
+  /// FindSymbolContainingFileAddress() would, for symbolicating many
+  /// addresses at once. The addresses are sorted and merged against the
+  /// address index in a single pass when that is cheaper than searching for
+  /// each of them.
+  ///
+  /// \param[out] symbols
+  ///     Gets one entry per address in \a file_addrs, nullptr for addresses
+  ///     no symbol contains.
+  void FindSymbolsContainingFileAddresses(llvm::ArrayRef<lldb::addr_t> file_addrs,
+                                          std::vector<Symbol *> &symbols);
   size_t FindFunctionSymbols(ConstString name, uint32_t name_type_mask,
                              SymbolContextList &sc_list);
+
+  /// Append the names of functions that start with \a prefix to \a names,
+  /// in sorted order and each name once, stopping after \a max_matches
+  /// names. The names are those the functions are displayed with, i.e.
+  /// demangled if possible. The first call sorts the names of all functions
+  /// in the table, after that each call only touches the matching names.
+  ///
+  /// \return
+  ///     The number of names appended to \a names.
+  size_t FindFunctionNamesWithPrefix(llvm::StringRef prefix,
+                                     size_t max_matches,
+                                     std::vector<ConstString> &names);
   void CalculateSymbolSizes();
 
   void SortSymbolIndexesByValue(std::vector<uint32_t> &indexes,
@@ -133,6 +167,43 @@ public:
     }
   }
 
+  /// Write the symbols and the name and address indexes of this table to
+  /// the binary stream \a s, computing the indexes first if needed. Names
+  /// are added to \a strtab, which has to be encoded separately.
+  ///
+  /// \return
+  ///     \b false if the table refers to sections that cannot be found
+  ///     again when the object file is parsed anew.
+  bool Encode(Stream &s, ConstStringTable &strtab);
+
+  /// Replace the contents of this table with the data written by Encode().
+  bool Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
+              const ConstStringTable &strtab);
+
+  /// Replace the contents of this table with the copy cached for its module
+  /// in the symbols.symtab-cache-path directory, if there is a valid one.
+  ///
+  /// \return
+  ///     \b true if the table was loaded from the cache.
+  bool LoadFromCache();
+
+  /// Like LoadFromCache(), but if another debugger on this machine is
+  /// building the cached copy of this table right now, wait for it to be
+  /// written first.
+  ///
+  /// \param[out] cache_lock
+  ///     If the table has to be built, this may receive a lock that makes
+  ///     other debuggers wait for this one. Hold on to it until SaveToCache()
+  ///     has been called.
+  ///
+  /// \return
+  ///     \b true if the table was loaded from the cache.
+  bool LoadFromCacheOrLock(std::unique_ptr<llvm::LockFileManager> &cache_lock);
+
+  /// Write this table to the symbols.symtab-cache-path directory, if one is
+  /// set, so LoadFromCache() can restore it in later sessions.
+  void SaveToCache();
+
   void AppendSymbolNamesToMap(const IndexCollection &indexes,
                               bool add_demangled, bool add_mangled,
                               NameToIndexMap &name_to_index_map) const;
@@ -148,13 +219,43 @@ protected:
   void InitNameIndexes();
   void InitAddressIndexes();
 
+  /// Build the search structures for m_file_addr_to_index, which has to be
+  /// sorted and have its sizes filled in.
+  void InitAddressSearchIndex();
+
+  void ClearAddressSearchIndex();
+
+  /// \return
+  ///     The number of entries in m_file_addr_to_index whose range starts at
+  ///     or before \a file_addr.
+  uint32_t GetNumAddressEntriesStartingAtOrBefore(lldb::addr_t file_addr) const;
+
+  /// Find the symbol containing \a file_addr given the result of
+  /// GetNumAddressEntriesStartingAtOrBefore() for it.
+  Symbol *FindSymbolContainingFileAddress(lldb::addr_t file_addr,
+                                          uint32_t num_entries_before);
+  FileSpec GetCacheFile();
+
   ObjectFile *m_objfile;
   collection m_symbols;
   FileRangeToIndexMap m_file_addr_to_index;
+  /// The base addresses of m_file_addr_to_index in Eytzinger (breadth first,
+  /// 1-based) order, so searching it touches few cache lines and needs no
+  /// unpredictable branches, and the position in m_file_addr_to_index of
+  /// each of them.
+  std::vector<lldb::addr_t> m_file_addr_eytzinger;
+  std::vector<uint32_t> m_file_addr_eytzinger_rank;
+  /// The largest range end of the entries of m_file_addr_to_index up to and
+  /// including each index. No entry before an index whose value is at or
+  /// below an address can contain that address.
+  std::vector<lldb::addr_t> m_file_addr_max_end;
   UniqueCStringMap<uint32_t> m_name_to_index;
   UniqueCStringMap<uint32_t> m_basename_to_index;
   UniqueCStringMap<uint32_t> m_method_to_index;
   UniqueCStringMap<uint32_t> m_selector_to_index;
+  /// The unique display names of all functions, sorted by their strings.
+  /// Built by the first FindFunctionNamesWithPrefix() call.
+  std::vector<ConstString> m_sorted_function_names;
   mutable std::recursive_mutex
       m_mutex; // Provide thread safety for this symbol table
   bool m_file_addr_to_index_computed : 1, m_name_indexes_computed : 1;
@@ -193,10 +294,28 @@ private:
   void SymbolIndicesToSymbolContextList(std::vector<uint32_t> &symbol_indexes,
                                         SymbolContextList &sc_list);
 
-  void RegisterMangledNameEntry(
-      uint32_t value, std::set<const char *> &class_contexts,
-      std::vector<std::pair<NameToIndexMap::Entry, const char *>> &backlog,
-      RichManglingContext &rmc);
+  /// The names of a range of symbols, collected by IndexSymbolNames().
+  struct NameIndexSet {
+    NameToIndexMap name_to_index;
+    NameToIndexMap basename_to_index;
+    NameToIndexMap method_to_index;
+    NameToIndexMap selector_to_index;
+    /// The "const char *" in "class_contexts" and backlog::value_type::second
+    /// must come from a ConstString::GetCString().
+    std::set<const char *> class_contexts;
+    std::vector<std::pair<NameToIndexMap::Entry, const char *>> backlog;
+  };
+
+  /// Demangle the symbols in [begin, end) and add their names to \a set.
+  /// This only touches the given symbols, so it can run in parallel for
+  /// disjoint ranges.
+  void IndexSymbolNames(uint32_t begin, uint32_t end, NameIndexSet &set);
+
+  static void AppendNameToIndexMap(const NameToIndexMap &source,
+                                   NameToIndexMap &dest);
+
+  void RegisterMangledNameEntry(uint32_t value, NameIndexSet &set,
+                                RichManglingContext &rmc);
 
   void RegisterBacklogEntry(const NameToIndexMap::Entry &entry,
                             const char *decl_context,
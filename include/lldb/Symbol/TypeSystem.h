@@ -94,6 +94,9 @@ public:
 
   LLVMCastKind getKind() const { return m_kind; }
 
+  /// The name of the kind of this type system, for reports.
+  const char *GetKindName() const;
+
   static lldb::TypeSystemSP CreateInstance(lldb::LanguageType language,
                                            Module *module);
 
@@ -108,6 +111,9 @@ public:
   // removing all the TypeSystems from the TypeSystemMap.
   virtual void Finalize() {}
 
+  /// The memory held by this type system, in bytes.
+  virtual size_t GetMemoryUsage() { return 0; }
+
   virtual DWARFASTParser *GetDWARFParser() { return nullptr; }
   virtual PDBASTParser *GetPDBParser() { return nullptr; }
 
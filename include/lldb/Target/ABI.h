@@ -64,6 +64,26 @@ public:
 
   virtual bool GetArgumentValues(Thread &thread, ValueList &values) const = 0;
 
+  /// Read the first args.size() arguments of the function \a reg_ctx is
+  /// stopped at the entry of, taking each to be an integer or a pointer
+  /// passed in a general purpose register or a stack slot. No types are
+  /// looked at and no values are created, so this is cheap enough to call on
+  /// every hit of a breakpoint that traces function entries. An argument
+  /// narrower than its register or slot comes back with whatever the upper
+  /// bits hold.
+  ///
+  /// \return
+  ///     False if the ABI doesn't support this or the registers or stack
+  ///     couldn't be read.
+  virtual bool
+  GetIntegerArgumentValues(RegisterContext &reg_ctx,
+                           llvm::MutableArrayRef<uint64_t> args) const;
+
+  /// Read the value an integer or pointer returning function returned, with
+  /// \a reg_ctx stopped right after the return.
+  virtual bool GetIntegerReturnValue(RegisterContext &reg_ctx,
+                                     uint64_t &value) const;
+
   lldb::ValueObjectSP GetReturnValueObject(Thread &thread, CompilerType &type,
                                            bool persistent = true) const;
 
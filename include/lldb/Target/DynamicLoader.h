@@ -18,6 +18,8 @@
 #include "lldb/lldb-private-enumerations.h"
 #include "lldb/lldb-types.h"
 
+#include "llvm/ADT/ArrayRef.h"
+
 #include <stddef.h>
 #include <stdint.h>
 namespace lldb_private {
@@ -268,6 +270,12 @@ protected:
   /// accordingly and returns the target executable module.
   lldb::ModuleSP GetTargetExecutable();
 
+  /// Open the modules in \p module_specs concurrently before they are
+  /// created one at a time, so they are found in the shared module list.
+  /// Only specs the target would resolve to the same local file are opened:
+  /// those with a UUID, or all of them when the platform is the host.
+  void PreloadModules(llvm::ArrayRef<ModuleSpec> module_specs);
+
   /// Updates the load address of every allocatable section in \p module.
   ///
   /// \param module The module to traverse.
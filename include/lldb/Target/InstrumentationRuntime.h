@@ -10,13 +10,16 @@
 #define liblldb_InstrumentationRuntime_h_
 
 #include <map>
+#include <memory>
 #include <vector>
 
 #include "lldb/Core/PluginInterface.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/StructuredData.h"
 #include "lldb/lldb-forward.h"
 #include "lldb/lldb-private.h"
 #include "lldb/lldb-types.h"
+#include "llvm/Support/Error.h"
 
 namespace lldb_private {
 
@@ -40,6 +43,10 @@ class InstrumentationRuntime
   /// instrumentation runtime.
   bool m_is_active;
 
+  /// The function that collects a report, once it has been installed in the
+  /// process.
+  std::unique_ptr<UtilityFunction> m_report_function_up;
+
 protected:
   InstrumentationRuntime(const lldb::ProcessSP &process_sp)
       : m_process_wp(), m_runtime_module(), m_breakpoint_id(0),
@@ -48,6 +55,8 @@ protected:
       m_process_wp = process_sp;
   }
 
+  ~InstrumentationRuntime() override;
+
   lldb::ProcessSP GetProcessSP() { return m_process_wp.lock(); }
 
   lldb::ModuleSP GetRuntimeModuleSP() { return m_runtime_module; }
@@ -74,6 +83,16 @@ protected:
   /// is guaranteed to be loaded.
   virtual void Activate() = 0;
 
+  /// Collect a report by calling \p function_name, a function defined in
+  /// \p code as taking a pointer to \p num_slots 64-bit values, zeroed,
+  /// for it to fill in. The function is compiled and installed in the process
+  /// the first time it is needed, and its results are read back in a single
+  /// memory read.
+  llvm::Expected<DataExtractor> CallReportFunction(ExecutionContext &exe_ctx,
+                                                   const char *code,
+                                                   const char *function_name,
+                                                   size_t num_slots);
+
 public:
   static void ModulesDidLoad(lldb_private::ModuleList &module_list,
                              Process *process,
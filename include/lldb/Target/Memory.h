@@ -11,6 +11,8 @@
 
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/lldb-private.h"
+#include <atomic>
+#include <list>
 #include <map>
 #include <mutex>
 #include <vector>
@@ -33,6 +35,15 @@ public:
 
   uint32_t GetMemoryCacheLineSize() const { return m_L2_cache_line_byte_size; }
 
+  /// The number of reads the cache could answer on its own.
+  uint64_t GetNumHits() const { return m_num_hits; }
+
+  /// The number of reads that had to read memory from the process.
+  uint64_t GetNumMisses() const { return m_num_misses; }
+
+  /// The memory held by the cached data, in bytes.
+  size_t GetMemoryUsage() const;
+
   void AddInvalidRange(lldb::addr_t base_addr, lldb::addr_t byte_size);
 
   bool RemoveInvalidRange(lldb::addr_t base_addr, lldb::addr_t byte_size);
@@ -45,18 +56,52 @@ public:
 
 protected:
   typedef std::map<lldb::addr_t, lldb::DataBufferSP> BlockMap;
+  typedef std::list<lldb::addr_t> LRUList;
+  struct L2CacheLine {
+    lldb::DataBufferSP data;
+    LRUList::iterator lru_pos; // Position of this line in m_L2_lru
+  };
+  typedef std::map<lldb::addr_t, L2CacheLine> L2CacheMap;
   typedef RangeArray<lldb::addr_t, lldb::addr_t, 4> InvalidRanges;
   typedef Range<lldb::addr_t, lldb::addr_t> AddrRange;
+
+  /// Read the L2 cache line at \a line_addr from the process, and if the
+  /// misses so far look like a sequential or strided walk, prefetch the lines
+  /// after it in the same read. Returns false if nothing could be read.
+  bool FillL2Cache(lldb::addr_t line_addr, size_t min_byte_size,
+                   Status &error);
+
+  void AddL2CacheLine(lldb::addr_t line_addr, lldb::DataBufferSP data_sp);
+
+  void RemoveL2CacheLine(L2CacheMap::iterator pos);
+
+  void UpdateSettings();
+
   // Classes that inherit from MemoryCache can see and modify these
-  std::recursive_mutex m_mutex;
+  mutable std::recursive_mutex m_mutex;
   BlockMap m_L1_cache; // A first level memory cache whose chunk sizes vary that
                        // will be used only if the memory read fits entirely in
                        // a chunk
-  BlockMap m_L2_cache; // A memory cache of fixed size chinks
-                       // (m_L2_cache_line_byte_size bytes in size each)
+  L2CacheMap m_L2_cache; // A memory cache of fixed size chinks
+                         // (m_L2_cache_line_byte_size bytes in size each)
+  LRUList m_L2_lru;      // L2 cache line addresses, most recently used first
   InvalidRanges m_invalid_ranges;
   Process &m_process;
   uint32_t m_L2_cache_line_byte_size;
+  uint32_t m_L2_max_prefetch_lines;
+  size_t m_L2_max_lines;
+
+  // Access pattern detection for L2 cache misses. A stream is a series of
+  // misses that each land less than m_L2_stride bytes past the end of the
+  // previous fill. m_L2_prefetch_count is the number of strides read ahead,
+  // which doubles with every miss that continues the stream.
+  lldb::addr_t m_L2_last_miss_addr;
+  lldb::addr_t m_L2_fill_end_addr;
+  lldb::addr_t m_L2_stride;
+  uint32_t m_L2_prefetch_count;
+
+  std::atomic<uint64_t> m_num_hits{0};
+  std::atomic<uint64_t> m_num_misses{0};
 
 private:
   DISALLOW_COPY_AND_ASSIGN(MemoryCache);
@@ -71,7 +116,10 @@ public:
 
   ~AllocatedBlock();
 
-  lldb::addr_t ReserveBlock(uint32_t size);
+  /// Reserve \a size bytes in this block. If \a is_zeroed is given, it is
+  /// set to true when none of the returned memory was reserved before, so it
+  /// still holds the zeros the pages were allocated with.
+  lldb::addr_t ReserveBlock(uint32_t size, bool *is_zeroed = nullptr);
 
   bool FreeBlock(lldb::addr_t addr);
 
@@ -103,6 +151,9 @@ protected:
   RangeVector<lldb::addr_t, uint32_t> m_free_blocks;
   // A sorted list of reserved address.
   RangeVector<lldb::addr_t, uint32_t> m_reserved_blocks;
+  // Memory at and above this address has never been reserved. Blocks are
+  // reserved first fit, so everything below it has been handed out before.
+  lldb::addr_t m_unused_addr;
 };
 
 // A class that can track allocated memory and give out allocated memory
@@ -117,8 +168,12 @@ public:
 
   void Clear();
 
+  /// Hand out \a byte_size bytes from the pages allocated so far, allocating
+  /// more pages in the process only if none of them have enough room. If
+  /// \a is_zeroed is given, it is set to true when the memory is known to
+  /// be still zero filled.
   lldb::addr_t AllocateMemory(size_t byte_size, uint32_t permissions,
-                              Status &error);
+                              Status &error, bool *is_zeroed = nullptr);
 
   bool DeallocateMemory(lldb::addr_t ptr);
 
@@ -26,6 +26,7 @@
 #include "lldb/Utility/UserIDResolver.h"
 #include "lldb/lldb-private-forward.h"
 #include "lldb/lldb-public.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/Support/VersionTuple.h"
 
 namespace lldb_private {
@@ -318,6 +319,13 @@ public:
   virtual bool GetModuleSpec(const FileSpec &module_file_spec,
                              const ArchSpec &arch, ModuleSpec &module_spec);
 
+  /// Download the modules in \p module_specs that aren't in the local module
+  /// cache yet, several at a time, so the GetSharedModule() calls that follow
+  /// find them there. Does nothing for the host platform or when the module
+  /// cache is disabled.
+  void PrefetchSharedModules(Process *process,
+                             llvm::ArrayRef<ModuleSpec> module_specs);
+
   virtual Status ConnectRemote(Args &args);
 
   virtual Status DisconnectRemote();
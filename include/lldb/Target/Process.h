@@ -13,11 +13,13 @@
 
 #include <limits.h>
 
+#include <atomic>
 #include <chrono>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
@@ -68,6 +70,8 @@ public:
 
   bool GetDisableMemoryCache() const;
   uint64_t GetMemoryCacheLineSize() const;
+  uint64_t GetMemoryCachePrefetchLines() const;
+  uint64_t GetMemoryCacheSize() const;
   Args GetExtraStartupCommands() const;
   void SetExtraStartupCommands(const Args &args);
   FileSpec GetPythonOSPluginPath() const;
@@ -83,6 +87,10 @@ public:
   bool GetWarningsOptimization() const;
   bool GetStopOnExec() const;
   std::chrono::seconds GetUtilityExpressionTimeout() const;
+  uint64_t GetStackPrefetchSize() const;
+  bool GetParallelUnwind() const;
+  bool GetReadOnlyMemoryFromFiles() const;
+  bool GetPrefetchFrameVariables() const;
 
 protected:
   static void OptionValueChangedCallback(void *baton,
@@ -386,6 +394,7 @@ public:
   enum Warnings { eWarningsOptimization = 1, eWarningsSwiftImport };
 
   typedef Range<lldb::addr_t, lldb::addr_t> LoadRange;
+  typedef Range<lldb::addr_t, size_t> MemoryRange;
   // We use a read/write lock to allow on or more clients to access the process
   // state while the process is stopped (reader). We lock the write lock to
   // control access to the process while it is running (readers, or clients
@@ -1309,6 +1318,18 @@ public:
     return StructuredData::ObjectSP();
   }
 
+  /// Statistics about the packets exchanged with the debug server, keyed by
+  /// the kind of packet, or null if the plug-in doesn't keep any.
+  virtual lldb_private::StructuredData::DictionarySP GetPacketStatistics() {
+    return StructuredData::DictionarySP();
+  }
+
+  const MemoryCache &GetMemoryCache() const { return m_memory_cache; }
+
+  /// Drop the memory read from the process so far, it is read again when
+  /// needed.
+  void ReleaseCaches() { m_memory_cache.Clear(); }
+
   /// Print a user-visible warning about a module being built with
   /// optimization
   ///
@@ -1404,6 +1425,16 @@ public:
   //      true if the user should be warned about detaching from this process.
   virtual bool WarnBeforeDetach() const { return true; }
 
+  /// Check whether this process is running, as opposed to a snapshot of
+  /// one like a core file.
+  ///
+  /// Post-mortem processes can't hit breakpoints, so the plug-ins that only
+  /// work by stopping the process don't need to be set up for them.
+  ///
+  /// \return
+  ///     true if this process can be resumed and stopped.
+  virtual bool IsLiveDebugSession() const { return true; }
+
   /// Actually do the reading of memory from a process.
   ///
   /// Subclasses must override this function and can return fewer bytes than
@@ -1433,6 +1464,34 @@ public:
   virtual size_t DoReadMemory(lldb::addr_t vm_addr, void *buf, size_t size,
                               Status &error) = 0;
 
+  /// Actually do the reading of several ranges of memory from a process.
+  ///
+  /// The default implementation reads each range with DoReadMemory.
+  /// Subclasses can override this function if they can read several ranges
+  /// with a single request to the target. See ReadMemoryRanges for the
+  /// arguments and return value.
+  virtual std::vector<size_t>
+  DoReadMemoryRanges(llvm::ArrayRef<MemoryRange> ranges, uint8_t *buf);
+
+  /// Search for \a pattern in the memory from \a low up to \a high without
+  /// reading the memory into the debugger.
+  ///
+  /// Subclasses can override this function if the target can search its
+  /// memory itself. See FindInMemory for the arguments.
+  ///
+  /// \param[out] found_addr
+  ///     The address of the first match, or LLDB_INVALID_ADDRESS if there is
+  ///     none.
+  ///
+  /// \return
+  ///     True if the target did the search, false if FindInMemory should
+  ///     read the memory and search it in the debugger.
+  virtual bool DoFindInMemory(lldb::addr_t low, lldb::addr_t high,
+                              llvm::ArrayRef<uint8_t> pattern,
+                              lldb::addr_t &found_addr) {
+    return false;
+  }
+
   /// Read of memory from a process.
   ///
   /// This function will read memory from the current process's address space
@@ -1496,9 +1555,80 @@ public:
   ///     size, then this function will get called again with \a
   ///     vm_addr, \a buf, and \a size updated appropriately. Zero is
   ///     returned in the case of an error.
+  ///
+  /// Reads that fall within a single read-only section of a module loaded
+  /// from a file are served from the object file, with no request to the
+  /// process, unless the "read-only-memory-from-files" setting is off.
   size_t ReadMemoryFromInferior(lldb::addr_t vm_addr, void *buf, size_t size,
                                 Status &error);
 
+  /// Get a read-only view of process memory without copying it.
+  ///
+  /// Processes whose memory is backed by a file that lldb has mapped, like
+  /// core files, can hand out the mapped bytes directly, so large values
+  /// don't need to be copied out of the file before they can be inspected.
+  ///
+  /// \param[in] vm_addr
+  ///     A virtual load address that indicates where the view starts.
+  ///
+  /// \param[in] size
+  ///     The number of bytes the view needs to cover.
+  ///
+  /// \param[out] data
+  ///     On success, refers to exactly \a size bytes of memory starting at
+  ///     \a vm_addr. The bytes must not be modified.
+  ///
+  /// \return
+  ///     True if the whole range is available as a view, false if the
+  ///     caller needs to read it with ReadMemory() instead.
+  virtual bool GetMemoryView(lldb::addr_t vm_addr, size_t size,
+                             DataExtractor &data) {
+    return false;
+  }
+
+  /// Read several ranges of memory from a process at once.
+  ///
+  /// Many small reads at addresses that are known up front, e.g. by data
+  /// formatters, cost one round trip each to a remote target. This function
+  /// reads them with as few requests as the process plug-in allows. Like
+  /// ReadMemoryFromInferior it bypasses caching, and it removes any traps
+  /// that may have been inserted into the memory.
+  ///
+  /// \param[in] ranges
+  ///     The virtual load address ranges to read.
+  ///
+  /// \param[out] buf
+  ///     A byte buffer that is at least as long as all \a ranges together.
+  ///     The memory of each range is stored right after that of the
+  ///     previous range.
+  ///
+  /// \return
+  ///     The number of bytes that were read for each range. This is less
+  ///     than the size of the range if only part or none of it could be
+  ///     read.
+  std::vector<size_t> ReadMemoryRanges(llvm::ArrayRef<MemoryRange> ranges,
+                                       uint8_t *buf);
+
+  /// Find the first occurrence of a byte pattern in memory.
+  ///
+  /// Memory that can't be read is skipped. Memory is searched with the
+  /// breakpoint opcodes removed, like ReadMemory returns it.
+  ///
+  /// \param[in] low
+  ///     The address to start searching at.
+  ///
+  /// \param[in] high
+  ///     The address the search ends at. Matches have to end before it.
+  ///
+  /// \param[in] pattern
+  ///     The bytes to search for.
+  ///
+  /// \return
+  ///     The address the first match starts at, or LLDB_INVALID_ADDRESS if
+  ///     there is none.
+  lldb::addr_t FindInMemory(lldb::addr_t low, lldb::addr_t high,
+                            llvm::ArrayRef<uint8_t> pattern);
+
   /// Read a NULL terminated string from memory
   ///
   /// This function will read a cache page at a time until a NULL string
@@ -1837,6 +1967,23 @@ public:
   virtual bool GetLoadAddressPermissions(lldb::addr_t load_addr,
                                          uint32_t &permissions);
 
+  /// Get the disassembly of an address range that a thread plan is stepping
+  /// through.
+  ///
+  /// Stepping plans disassemble their range to find the next branch. Code
+  /// backed by an object file on disk is shared through its module's
+  /// instruction cache, see Module::GetCachedDisassembly(). Anything else is
+  /// kept until modules are loaded or memory is written, so that stepping
+  /// repeatedly through the same code disassembles it only once.
+  ///
+  /// \param[in] range
+  ///     The address range to disassemble.
+  ///
+  /// \return
+  ///     The disassembler holding the instructions of \a range, or an empty
+  ///     shared pointer if it couldn't be disassembled.
+  lldb::DisassemblerSP GetStepRangeDisassembly(const AddressRange &range);
+
   /// Determines whether executing JIT-compiled code in this process is
   /// possible.
   ///
@@ -2020,6 +2167,55 @@ public:
     return error;
   }
 
+  /// Enable a group of breakpoint sites. Process plug-ins that can hand
+  /// several sites to their debug stub at once should override this; the
+  /// default implementation calls EnableBreakpointSite() for each site.
+  ///
+  /// \param[in] bp_sites
+  ///     The sites to enable.
+  ///
+  /// \return
+  ///     One Status per site, in the same order as \a bp_sites.
+  virtual std::vector<Status>
+  EnableBreakpointSites(llvm::ArrayRef<BreakpointSite *> bp_sites);
+
+  /// Disable a group of breakpoint sites. This is the counterpart of
+  /// EnableBreakpointSites(), the default implementation calls
+  /// DisableBreakpointSite() for each site.
+  virtual std::vector<Status>
+  DisableBreakpointSites(llvm::ArrayRef<BreakpointSite *> bp_sites);
+
+  /// Called when something that decides whether a hit of \a bp_site stops
+  /// the process has changed, like the condition of one of its owners.
+  /// Process plug-ins that hand breakpoint conditions to their debug stub
+  /// refresh them here.
+  virtual void BreakpointSiteConditionsChanged(BreakpointSite *bp_site) {}
+
+  /// Whether a thread resumed while sitting on \a bp_site is stepped past it
+  /// by the process plug-in or its debug stub. If so, Thread doesn't push a
+  /// ThreadPlanStepOverBreakpoint for it.
+  virtual bool StepsOverBreakpointSiteOnResume(BreakpointSite *bp_site) {
+    return false;
+  }
+
+  /// While an object of this class is alive, breakpoint sites created and
+  /// removed in the process are not enabled or disabled right away. They are
+  /// handed to EnableBreakpointSites() and DisableBreakpointSites() together
+  /// when the outermost batch goes out of scope, so that resolving a
+  /// breakpoint to many locations doesn't take one round trip per location.
+  /// Batches may be nested, and a null process is ignored.
+  class BreakpointSiteBatch {
+  public:
+    BreakpointSiteBatch(const lldb::ProcessSP &process_sp);
+
+    ~BreakpointSiteBatch();
+
+  private:
+    lldb::ProcessSP m_process_sp;
+
+    DISALLOW_COPY_AND_ASSIGN(BreakpointSiteBatch);
+  };
+
   // This is implemented completely using the lldb::Process API. Subclasses
   // don't need to implement this function unless the standard flow of read
   // existing opcode, write breakpoint opcode, verify breakpoint opcode doesn't
@@ -2074,6 +2270,35 @@ public:
 
   ThreadList::ThreadIterable Threads() { return m_thread_list.Threads(); }
 
+  /// Get ready to show the backtraces of several threads.
+  ///
+  /// The top of every thread's stack is read into the memory cache in a
+  /// single batch, and if the "parallel-unwind" setting is on, the frames of
+  /// the threads are then computed concurrently.
+  ///
+  /// \param[in] threads
+  ///     The threads whose backtraces are about to be shown.
+  ///
+  /// \param[in] num_frames
+  ///     The number of frames that will be shown per thread, UINT32_MAX for
+  ///     all of them.
+  void PrefetchStackFrames(llvm::ArrayRef<lldb::ThreadSP> threads,
+                           uint32_t num_frames);
+
+  /// Start resolving the variables of the selected frame in the background,
+  /// if the "prefetch-frame-variables" setting is on.
+  ///
+  /// This is done on public stops, which are usually followed by a request
+  /// for exactly those variables. The value objects end up in the frame's
+  /// cache, from where they are handed out. Each step holds the target's API
+  /// mutex, so the prefetch takes turns with the clients of the API instead
+  /// of racing them.
+  void StartFrameVariablePrefetch();
+
+  /// Stop the frame variable prefetch, waiting for the step it is in the
+  /// middle of. This is done before the process resumes.
+  void CancelFrameVariablePrefetch();
+
   uint32_t GetNextThreadIndexID(uint64_t thread_id);
 
   lldb::ThreadSP CreateOSPluginThread(lldb::tid_t tid, lldb::addr_t context);
@@ -2700,6 +2925,15 @@ protected:
   BreakpointSiteList m_breakpoint_site_list; ///< This is the list of breakpoint
                                              ///locations we intend to insert in
                                              ///the target.
+  std::mutex m_pending_bp_sites_mutex;
+  uint32_t m_bp_site_batch_depth = 0; ///< Number of live BreakpointSiteBatch
+                                      ///objects.
+  std::vector<lldb::BreakpointSiteSP>
+      m_pending_enable_bp_sites; ///< Sites waiting for the end of the batch
+                                 ///to be enabled.
+  std::vector<lldb::BreakpointSiteSP>
+      m_pending_disable_bp_sites; ///< Sites waiting for the end of the batch
+                                  ///to be disabled.
   lldb::DynamicLoaderUP m_dyld_up;
   lldb::JITLoaderListUP m_jit_loaders_up;
   lldb::DynamicCheckerFunctionsUP m_dynamic_checkers_up; ///< The functions used
@@ -2724,6 +2958,9 @@ protected:
   Predicate<uint32_t> m_iohandler_sync;
   MemoryCache m_memory_cache;
   AllocatedMemoryCache m_allocated_memory_cache;
+  /// Set once memory in a read-only section is written to, after which
+  /// ReadMemoryFromInferior stops reading such sections from object files.
+  bool m_wrote_read_only_section;
   bool m_should_detach; /// Should we detach if the process object goes away
                         /// with an explicit call to Kill or Detach?
   LanguageRuntimeCollection m_language_runtimes;
@@ -2759,10 +2996,28 @@ protected:
   StructuredDataPluginMap m_structured_data_plugin_map;
 
   enum { eCanJITDontKnow = 0, eCanJITYes, eCanJITNo } m_can_jit;
+
+  /// Disassembly of stepped through ranges keyed by their load address range,
+  /// see GetStepRangeDisassembly().
+  std::map<std::pair<lldb::addr_t, lldb::addr_t>, lldb::DisassemblerSP>
+      m_step_range_disassembly;
+  /// The memory ID m_step_range_disassembly was filled in for.
+  uint32_t m_step_range_disassembly_memory_id = 0;
+  std::mutex m_step_range_disassembly_mutex;
   
   std::unique_ptr<UtilityFunction> m_dlopen_utility_func_up;
   llvm::once_flag m_dlopen_utility_func_flag_once;
 
+  /// The thread of the frame variable prefetch, see
+  /// StartFrameVariablePrefetch().
+  std::thread m_frame_variable_prefetch_thread;
+  std::mutex m_frame_variable_prefetch_mutex;
+  std::atomic<bool> m_cancel_frame_variable_prefetch{false};
+
+  static void PrefetchFrameVariables(lldb::ProcessWP process_wp,
+                                     lldb::StackFrameSP frame_sp,
+                                     uint32_t stop_id);
+
   size_t RemoveBreakpointOpcodesFromBuffer(lldb::addr_t addr, size_t size,
                                            uint8_t *buf) const;
 
@@ -2863,6 +3118,19 @@ private:
 
   void ControlPrivateStateThread(uint32_t signal);
 
+  bool ShouldReportBreakpointSiteErrors();
+
+  void BeginBreakpointSiteBatch();
+
+  void EndBreakpointSiteBatch();
+
+  bool DeferBreakpointSiteEnable(const lldb::BreakpointSiteSP &bp_site_sp);
+
+  bool DeferBreakpointSiteDisable(const lldb::BreakpointSiteSP &bp_site_sp);
+
+  bool CancelPendingBreakpointSiteEnable(
+      const lldb::BreakpointSiteSP &bp_site_sp);
+
   DISALLOW_COPY_AND_ASSIGN(Process);
 };
 
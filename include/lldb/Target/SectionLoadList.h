@@ -10,8 +10,11 @@
 #ifndef liblldb_SectionLoadList_h_
 #define liblldb_SectionLoadList_h_
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include "llvm/ADT/DenseMap.h"
 #include "lldb/Core/Section.h"
@@ -22,7 +25,9 @@ namespace lldb_private {
 class SectionLoadList {
 public:
   // Constructors and Destructors
-  SectionLoadList() : m_addr_to_sect(), m_sect_to_addr(), m_mutex() {}
+  SectionLoadList()
+      : m_addr_to_sect(), m_sect_to_addr(), m_mutex(), m_snapshot(),
+        m_snapshot_stale(true) {}
 
   SectionLoadList(const SectionLoadList &rhs);
 
@@ -66,6 +71,25 @@ protected:
   addr_to_sect_collection m_addr_to_sect;
   sect_to_addr_collection m_sect_to_addr;
   mutable std::recursive_mutex m_mutex;
+
+  /// A flat copy of m_addr_to_sect for ResolveLoadAddress, which is called
+  /// far more often than sections are loaded. The load addresses are kept
+  /// apart from the sections so a search only touches the addresses.
+  struct Snapshot {
+    std::vector<lldb::addr_t> load_addrs;
+    std::vector<lldb::SectionSP> sections;
+  };
+  typedef std::shared_ptr<const Snapshot> SnapshotSP;
+
+  /// Return the snapshot of the current load list, rebuilding it first if
+  /// the list changed since it was made.
+  SnapshotSP GetSnapshot() const;
+
+  /// Only accessed with std::atomic_load and std::atomic_store. Rebuilt
+  /// lazily, as loading a module changes the list once per section.
+  mutable SnapshotSP m_snapshot;
+  /// Set under m_mutex whenever m_addr_to_sect changes.
+  mutable std::atomic<bool> m_snapshot_stale;
 };
 
 } // namespace lldb_private
@@ -9,6 +9,7 @@
 #ifndef liblldb_StackFrame_h_
 #define liblldb_StackFrame_h_
 
+#include <map>
 #include <memory>
 #include <mutex>
 
@@ -503,6 +504,10 @@ protected:
   bool HasCachedData() const;
 
 private:
+  /// Whether \a variable is in GetVariableList(true), found from its block
+  /// where possible so the list doesn't have to be made.
+  bool IsFrameVariable(Variable &variable);
+
   // For StackFrame only
   lldb::ThreadWP m_thread_wp;
   uint32_t m_frame_index;
@@ -521,9 +526,10 @@ private:
   Kind m_stack_frame_kind;
   bool m_behaves_like_zeroth_frame;
   lldb::VariableListSP m_variable_list_sp;
-  ValueObjectList m_variable_list_value_objects; // Value objects for each
-                                                 // variable in
-                                                 // m_variable_list_sp
+  /// The value objects made for the variables of this frame. These don't
+  /// need m_variable_list_sp, so that looking at the variables in scope
+  /// doesn't parse those of every block of the function.
+  std::map<const Variable *, lldb::ValueObjectSP> m_variable_list_value_objects;
   lldb::RecognizedStackFrameSP m_recognized_frame_sp;
   StreamString m_disassembly;
   std::recursive_mutex m_mutex;
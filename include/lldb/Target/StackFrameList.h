@@ -94,6 +94,11 @@ protected:
 
   void GetFramesUpTo(uint32_t end_idx);
 
+  /// Take over all the frames of the previous stop, with their symbol
+  /// contexts and variables, instead of unwinding. Only valid if the
+  /// thread's stack hasn't changed since.
+  void AdoptPreviousFrames();
+
   void GetOnlyConcreteFramesUpTo(uint32_t end_idx, Unwind *unwinder);
 
   void SynthesizeTailCallFrames(StackFrame &next_frame);
@@ -31,6 +31,10 @@
 #include "llvm/Support/Casting.h"
 
 namespace swift {
+namespace Demangle {
+class Context;
+}
+
 namespace remote {
 class MemoryReader;
 class RemoteAddress;
@@ -145,6 +149,14 @@ public:
                                                    ConstString &basename,
                                                    bool &is_method);
 
+    /// Like the above, but demangles into \a demangle_ctx, whose memory is
+    /// kept for the next name. Use this to extract the base names of many
+    /// symbols in a row.
+    static bool
+    ExtractFunctionBasenameFromMangled(ConstString mangled,
+                                       ConstString &basename, bool &is_method,
+                                       swift::Demangle::Context &demangle_ctx);
+
   protected:
     void Parse();
 
@@ -363,6 +375,11 @@ public:
 
   ConstString GetErrorBackstopName();
 
+  /// Return the internal breakpoint on GetErrorBackstopName() in the
+  /// standard library, creating it disabled the first time. Function calls
+  /// enable it while they run, so it isn't resolved again for each call.
+  lldb::BreakpointSP GetErrorBackstopBreakpoint();
+
   ConstString GetStandardLibraryName();
 
   ConstString GetStandardLibraryBaseName();
@@ -375,6 +392,14 @@ public:
 
   bool IsABIStable();
 
+  /// Read the type metadata, and the nominal type descriptors they point to,
+  /// of many values at once, so that resolving their dynamic types later
+  /// doesn't need a round trip per pointer. Each address in \a
+  /// metadata_locations holds a pointer to type metadata, e.g. the address
+  /// of a class instance or the metadata field of an opaque existential.
+  /// The memory is kept until the process stops again.
+  void PrefetchMetadata(llvm::ArrayRef<lldb::addr_t> metadata_locations);
+
 protected:
   // Classes that inherit from SwiftLanguageRuntime can see and modify these
   SwiftLanguageRuntime(Process *process);
@@ -447,6 +472,21 @@ protected:
                  MetadataPromiseSP>
       m_promises_map;
 
+  /// The instance types resolved from class metadata, keyed like
+  /// m_promises_map. They are cleared when the process stops again and when
+  /// new images are loaded.
+  llvm::DenseMap<std::pair<swift::ASTContext *, lldb::addr_t>,
+                 swift::TypeBase *>
+      m_metadata_type_cache;
+  uint32_t m_metadata_type_cache_stop_id = UINT32_MAX;
+
+  /// The type infos computed by the reflection context, keyed by the
+  /// ConstString of the canonical mangled type name. Failed lookups are
+  /// cached as nullptr, since each miss scans the field descriptors of every
+  /// registered image. Cleared when new images are registered.
+  llvm::DenseMap<const char *, const swift::reflection::TypeInfo *>
+      m_type_info_cache;
+
   llvm::DenseMap<swift::ASTContext *,
                  std::unique_ptr<swift::remoteAST::RemoteASTContext>>
       m_remote_ast_contexts;
@@ -460,6 +500,8 @@ protected:
 
   CompilerType m_box_metadata_type;
 
+  lldb::BreakpointSP m_error_backstop_bp_sp;
+
   /// These members are used to track and toggle the state of the "dynamic
   /// exclusivity enforcement flag" in the swift runtime. This flag is set to
   /// true when an LLDB expression starts running, and reset to its original
@@ -9,9 +9,11 @@
 #ifndef liblldb_Target_h_
 #define liblldb_Target_h_
 
+#include <chrono>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -26,6 +28,7 @@
 #include "lldb/Core/ModuleList.h"
 #include "lldb/Core/UserSettingsController.h"
 #include "lldb/Expression/Expression.h"
+#include "lldb/Expression/ExpressionStatistics.h"
 #include "lldb/Host/ProcessLaunchInfo.h"
 #include "lldb/Interpreter/OptionValueBoolean.h"
 #include "lldb/Interpreter/OptionValueEnumeration.h"
@@ -98,6 +101,8 @@ public:
 
   void SetPreloadSymbols(bool b);
 
+  bool GetPreloadSymbolsInBackground() const;
+
   bool GetDisableASLR() const;
 
   void SetDisableASLR(bool b);
@@ -147,6 +152,16 @@ public:
 
   bool GetSwiftCreateModuleContextsInParallel() const;
 
+  bool GetSwiftCreateModuleContextsOnLoad() const;
+
+  bool GetBatchChildSummaries() const;
+
+  uint64_t GetModuleLoadBatchWindow() const;
+
+  bool GetSwiftLazyAutoImport() const;
+
+  bool GetSwiftCacheExpressions() const;
+
   bool GetEnableAutoImportClangModules() const;
 
   bool GetUseAllCompilerFlags() const;
@@ -161,6 +176,8 @@ public:
 
   bool GetEnableSyntheticValue() const;
 
+  uint32_t GetMaxExpressionResults() const;
+
   uint32_t GetMaxZeroPaddingInFloatFormat() const;
 
   uint32_t GetMaximumNumberOfChildrenToDisplay() const;
@@ -205,6 +222,8 @@ public:
 
   void SetUserSpecifiedTrapHandlerNames(const Args &args);
 
+  bool GetFramePointerUnwind() const;
+
   bool GetNonStopModeEnabled() const;
 
   void SetNonStopModeEnabled(bool b);
@@ -257,6 +276,12 @@ private:
   // Member variables.
   ProcessLaunchInfo m_launch_info;
   std::unique_ptr<TargetExperimentalProperties> m_experimental_properties_up;
+
+  // Settings read for every value that gets formatted.
+  CachedPropertyValue<lldb::DynamicValueType> m_prefer_dynamic_value;
+  CachedPropertyValue<bool> m_enable_synthetic_value;
+  CachedPropertyValue<uint32_t> m_max_children_count;
+  CachedPropertyValue<uint32_t> m_max_summary_length;
 };
 
 class EvaluateExpressionOptions {
@@ -424,6 +449,14 @@ public:
 
   bool GetPreparePlaygroundStubFunctions() const { return m_prepare_playground_stub_functions; }
 
+  /// Collect the time each phase of the evaluation takes in \a stats_sp,
+  /// which is shared by the copies of these options.
+  void SetStatistics(std::shared_ptr<ExpressionStatistics> stats_sp) {
+    m_stats_sp = std::move(stats_sp);
+  }
+
+  ExpressionStatistics *GetStatistics() const { return m_stats_sp.get(); }
+
 private:
   ExecutionPolicy m_execution_policy = default_execution_policy;
   lldb::LanguageType m_language = lldb::eLanguageTypeUnknown;
@@ -460,6 +493,7 @@ private:
   mutable std::string m_pound_line_file;
   mutable uint32_t m_pound_line_line;
   bool m_prepare_playground_stub_functions = true;
+  std::shared_ptr<ExpressionStatistics> m_stats_sp;
 };
 
 // Target
@@ -843,6 +877,10 @@ public:
 
   void ModulesDidLoad(ModuleList &module_list);
 
+  /// Finish handling the modules ModulesDidLoad() has put off handling
+  /// because of the module-load-batch-window setting.
+  void FlushPendingModuleLoads();
+
   void ModulesDidUnload(ModuleList &module_list, bool delete_locations);
 
   void SymbolsDidLoad(ModuleList &module_list);
@@ -1433,6 +1471,16 @@ protected:
   /// Guards the scratch typesystem from being re-initialized.
   SharedMutex m_scratch_typesystem_lock;
 
+  /// The modules loaded within the module load batch window that haven't
+  /// been handled by NotifyModulesLoaded() yet, and when the first of them
+  /// was loaded.
+  std::mutex m_pending_loaded_modules_mutex;
+  ModuleList m_pending_loaded_modules;
+  std::chrono::steady_clock::time_point m_pending_loaded_modules_time;
+
+  /// The part of ModulesDidLoad() that can wait for more modules to load.
+  void NotifyModulesLoaded(ModuleList &module_list);
+
   static void ImageSearchPathsChanged(const PathMappingList &path_list,
                                       void *baton);
 
@@ -1454,8 +1502,27 @@ public:
     m_stats_storage[key] += 1;
   }
 
+  void AddToStats(lldb_private::StatisticKind key, uint32_t value) {
+    if (!GetCollectingStats())
+      return;
+    lldbassert(key < lldb_private::StatisticKind::StatisticMax &&
+               "invalid statistics!");
+    m_stats_storage[key] += value;
+  }
+
   std::vector<uint32_t> GetStatistics() { return m_stats_storage; }
 
+  /// Report the counters above along with the time spent parsing and
+  /// indexing the debug info of each module, the memory cache hit rate, the
+  /// packets exchanged with the debug server, the totals of the timer
+  /// categories and the memory held by each module, as used by
+  /// "statistics dump --json" and SBTarget::GetStatistics().
+  StructuredData::DictionarySP ReportStatistics();
+
+  /// The memory held by the scratch type systems of this target and the
+  /// memory cache of its process, in bytes. The modules report their own.
+  StructuredData::DictionarySP ReportMemoryUsage();
+
 private:
   /// Construct with optional file and arch.
   ///
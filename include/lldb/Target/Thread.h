@@ -52,6 +52,11 @@ public:
   bool GetStepOutAvoidsNoDebug() const;
 
   uint64_t GetMaxBacktraceDepth() const;
+
+private:
+  // Settings read every time a thread plan steps.
+  CachedPropertyValue<bool> m_step_in_avoids_no_debug;
+  CachedPropertyValue<bool> m_step_out_avoids_no_debug;
 };
 
 typedef std::shared_ptr<ThreadProperties> ThreadPropertiesSP;
@@ -1221,6 +1226,11 @@ protected:
 
   lldb::StackFrameListSP GetStackFrameList();
 
+  /// Returns true if the thread stayed suspended since m_prev_frames_sp was
+  /// fetched and its PC, SP and frame 0 CFA are still the same, so the
+  /// previous frames can be used without unwinding again.
+  bool PreviousFramesAreCurrent();
+
   void SetTemporaryResumeState(lldb::StateType new_state) {
     m_temporary_resume_state = new_state;
   }
@@ -1257,6 +1267,10 @@ protected:
                                            ///populated after a thread stops.
   lldb::StackFrameListSP m_prev_frames_sp; ///< The previous stack frames from
                                            ///the last time this thread stopped.
+  /// The PC and SP when m_prev_frames_sp was fetched, if the thread then
+  /// stayed suspended, otherwise LLDB_INVALID_ADDRESS.
+  lldb::addr_t m_prev_frames_pc;
+  lldb::addr_t m_prev_frames_stack_pointer;
   int m_resume_signal; ///< The signal that should be used when continuing this
                        ///thread.
   lldb::StateType m_resume_state; ///< This state is used to force a thread to
@@ -152,6 +152,7 @@ protected:
       m_expression_language; // Set from the incoming ExpressionOptions.
   lldb::BreakpointSP m_error_backstop_bp_sp;
   bool m_hit_error_backstop;
+  bool m_should_disable_error_backstop_bp;
 
 private:
   CompilerType m_return_type;
@@ -0,0 +1,124 @@
+//===-- AgentExpression.h ---------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_AgentExpression_h_
+#define liblldb_AgentExpression_h_
+
+#include "lldb/lldb-enumerations.h"
+#include "lldb/lldb-types.h"
+#include "llvm/ADT/ArrayRef.h"
+
+#include <vector>
+
+namespace lldb_private {
+
+/// \class AgentExpression AgentExpression.h "lldb/Utility/AgentExpression.h"
+/// A program in the GDB agent expression bytecode.
+///
+/// A remote stub evaluates these at a breakpoint to decide whether the
+/// debugger needs to hear about the hit at all. Only the integer subset
+/// needed for simple conditions is supported. Opcodes keep their GDB values
+/// and operands are big-endian, so the ";X" conditions of a Z packet mean the
+/// same thing to any stub that understands them.
+class AgentExpression {
+public:
+  enum Opcode : uint8_t {
+    eOpAdd = 0x02,
+    eOpSub = 0x03,
+    eOpMul = 0x04,
+    eOpLogNot = 0x0e,
+    eOpBitAnd = 0x0f,
+    eOpBitOr = 0x10,
+    eOpBitXor = 0x11,
+    eOpBitNot = 0x12,
+    eOpEqual = 0x13,
+    eOpLessSigned = 0x14,
+    eOpLessUnsigned = 0x15,
+    eOpExt = 0x16,
+    eOpRef8 = 0x17,
+    eOpRef16 = 0x18,
+    eOpRef32 = 0x19,
+    eOpRef64 = 0x1a,
+    eOpIfGoto = 0x20,
+    eOpGoto = 0x21,
+    eOpConst8 = 0x22,
+    eOpConst16 = 0x23,
+    eOpConst32 = 0x24,
+    eOpConst64 = 0x25,
+    eOpReg = 0x26,
+    eOpEnd = 0x27,
+    eOpDup = 0x28,
+    eOpPop = 0x29,
+    eOpZeroExt = 0x2a,
+    eOpSwap = 0x2b,
+  };
+
+  /// Gives an expression access to the thread it is evaluated for.
+  class Context {
+  public:
+    virtual ~Context() = default;
+
+    /// Read the register the remote protocol numbers \a regnum.
+    virtual bool ReadRegister(uint32_t regnum, uint64_t &value) = 0;
+
+    /// Read \a size bytes of the inferior's memory, as the program would
+    /// see them (i.e. without any breakpoint traps).
+    virtual bool ReadMemory(lldb::addr_t addr, void *buf, size_t size) = 0;
+  };
+
+  AgentExpression() = default;
+
+  explicit AgentExpression(llvm::ArrayRef<uint8_t> bytes)
+      : m_bytes(bytes.begin(), bytes.end()) {}
+
+  void AppendOpcode(Opcode opcode) { m_bytes.push_back(opcode); }
+
+  /// Push \a value, using the shortest const opcode that holds it.
+  void AppendConstant(uint64_t value);
+
+  /// Push the value of the register numbered \a regnum.
+  void AppendRegister(uint16_t regnum);
+
+  /// Replace the address on top of the stack with the \a byte_size bytes it
+  /// points to. Returns false if \a byte_size is not 1, 2, 4 or 8.
+  bool AppendReference(unsigned byte_size);
+
+  /// Sign or zero extend the low \a bits bits of the top of the stack.
+  void AppendExtend(uint8_t bits, bool is_signed);
+
+  llvm::ArrayRef<uint8_t> GetBytes() const { return m_bytes; }
+
+  bool IsEmpty() const { return m_bytes.empty(); }
+
+  bool operator==(const AgentExpression &rhs) const {
+    return m_bytes == rhs.m_bytes;
+  }
+
+  /// Run the expression.
+  ///
+  /// \param[in] byte_order
+  ///     The byte order of the inferior, used for memory references.
+  ///
+  /// \param[out] result
+  ///     The value on top of the stack when the expression ended.
+  ///
+  /// \return
+  ///     False if the expression is malformed, runs too long, or reads a
+  ///     register or memory that isn't available.
+  bool Evaluate(Context &context, lldb::ByteOrder byte_order,
+                uint64_t &result) const;
+
+private:
+  void AppendOperand(uint64_t value, unsigned byte_size);
+
+  std::vector<uint8_t> m_bytes;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_AgentExpression_h_
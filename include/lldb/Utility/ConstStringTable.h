@@ -0,0 +1,47 @@
+//===-- ConstStringTable.h --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_ConstStringTable_h_
+#define liblldb_ConstStringTable_h_
+
+#include "lldb/Utility/ConstString.h"
+#include "lldb/lldb-types.h"
+#include "llvm/ADT/DenseMap.h"
+
+#include <vector>
+
+namespace lldb_private {
+
+class DataExtractor;
+class Stream;
+
+/// \class ConstStringTable ConstStringTable.h "lldb/Utility/ConstStringTable.h"
+/// The strings referenced by serialized data, such as the on-disk index
+/// caches. Each distinct string is stored once and referred to by its index.
+class ConstStringTable {
+public:
+  uint32_t Add(ConstString str);
+
+  ConstString Get(uint32_t idx) const {
+    return idx < m_strings.size() ? m_strings[idx] : ConstString();
+  }
+
+  size_t GetSize() const { return m_strings.size(); }
+
+  void Encode(Stream &s) const;
+
+  bool Decode(const DataExtractor &data, lldb::offset_t *offset_ptr);
+
+private:
+  llvm::DenseMap<const char *, uint32_t> m_ids;
+  std::vector<ConstString> m_strings;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_ConstStringTable_h_
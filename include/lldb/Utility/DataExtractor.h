@@ -793,7 +793,14 @@ public:
   ///
   /// \return
   ///     The extracted signed integer value.
-  int64_t GetSLEB128(lldb::offset_t *offset_ptr) const;
+  int64_t GetSLEB128(lldb::offset_t *offset_ptr) const {
+    // Most values fit in a single byte, so decode those inline.
+    if (*offset_ptr < GetByteSize() && m_start[*offset_ptr] < 0x80) {
+      const uint8_t byte = m_start[(*offset_ptr)++];
+      return (byte & 0x40) ? int64_t(byte) - 0x80 : byte;
+    }
+    return GetSLEB128Slow(offset_ptr);
+  }
 
   /// Extract a unsigned LEB128 value from \a *offset_ptr.
   ///
@@ -811,7 +818,11 @@ public:
   ///
   /// \return
   ///     The extracted unsigned integer value.
-  uint64_t GetULEB128(lldb::offset_t *offset_ptr) const;
+  uint64_t GetULEB128(lldb::offset_t *offset_ptr) const {
+    if (*offset_ptr < GetByteSize() && m_start[*offset_ptr] < 0x80)
+      return m_start[(*offset_ptr)++];
+    return GetULEB128Slow(offset_ptr);
+  }
 
   lldb::DataBufferSP &GetSharedDataBuffer() { return m_data_sp; }
 
@@ -955,7 +966,13 @@ public:
   ///
   /// \return
   ///     The number of bytes consumed during the extraction.
-  uint32_t Skip_LEB128(lldb::offset_t *offset_ptr) const;
+  uint32_t Skip_LEB128(lldb::offset_t *offset_ptr) const {
+    if (*offset_ptr < GetByteSize() && m_start[*offset_ptr] < 0x80) {
+      ++*offset_ptr;
+      return 0;
+    }
+    return Skip_LEB128Slow(offset_ptr);
+  }
 
   /// Test the validity of \a offset.
   ///
@@ -996,6 +1013,14 @@ public:
   }
 
 protected:
+  /// The out of line parts of the LEB128 accessors, for values that take
+  /// more than one byte.
+  /// @{
+  int64_t GetSLEB128Slow(lldb::offset_t *offset_ptr) const;
+  uint64_t GetULEB128Slow(lldb::offset_t *offset_ptr) const;
+  uint32_t Skip_LEB128Slow(lldb::offset_t *offset_ptr) const;
+  /// @}
+
   // Member variables
   const uint8_t *m_start; ///< A pointer to the first byte of data.
   const uint8_t
@@ -0,0 +1,34 @@
+//===-- HexCodec.h ----------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_UTILITY_HEXCODEC_H
+#define LLDB_UTILITY_HEXCODEC_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace lldb_private {
+
+/// Write \a src as lowercase hex digits, two per byte, to \a dst, which must
+/// have room for 2 * src.size() characters. Uses SSE2 or NEON when they are
+/// available.
+void EncodeHexBytes(llvm::ArrayRef<uint8_t> src, char *dst);
+
+/// Decode the pairs of hex digits at the start of \a src into \a dst,
+/// stopping at the first pair that isn't valid or when \a dst is full.
+///
+/// \return
+///     The number of bytes decoded.
+size_t DecodeHexBytes(llvm::StringRef src, llvm::MutableArrayRef<uint8_t> dst);
+
+} // namespace lldb_private
+
+#endif // LLDB_UTILITY_HEXCODEC_H
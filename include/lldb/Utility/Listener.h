@@ -14,6 +14,7 @@
 #include "lldb/lldb-defines.h"
 #include "lldb/lldb-forward.h"
 
+#include <atomic>
 #include <condition_variable>
 #include <list>
 #include <map>
@@ -121,6 +122,10 @@ private:
                         uint32_t num_sources, uint32_t event_type_mask,
                         lldb::EventSP &event_sp, bool remove);
 
+  // Move the events AddEvent queued up to m_events. Must be called with
+  // m_events_mutex held.
+  void MovePendingEvents();
+
   bool GetEventInternal(const Timeout<std::micro> &timeout,
                         Broadcaster *broadcaster, // nullptr for any broadcaster
                         const ConstString *sources, // nullptr for any event
@@ -133,6 +138,16 @@ private:
   event_collection m_events;
   std::mutex m_events_mutex; // Protects m_broadcasters and m_events
   std::condition_variable m_events_condition;
+  // Events are added to this lock-free stack, so broadcasters never wait for
+  // m_events_mutex unless the listener is waiting for an event and has to be
+  // woken up. Whoever holds the mutex next moves them over to m_events.
+  struct PendingEvent {
+    lldb::EventSP event_sp;
+    PendingEvent *next;
+  };
+  std::atomic<PendingEvent *> m_pending_events{nullptr};
+  // The number of threads waiting on m_events_condition.
+  std::atomic<uint32_t> m_num_waiters{0};
   broadcaster_manager_collection m_broadcaster_managers;
 
   void BroadcasterWillDestruct(Broadcaster *);
@@ -41,6 +41,8 @@ class raw_ostream;
 #define LLDB_LOG_OPTION_BACKTRACE (1U << 7)
 #define LLDB_LOG_OPTION_APPEND (1U << 8)
 #define LLDB_LOG_OPTION_PREPEND_FILE_FUNCTION (1U << 9)
+#define LLDB_LOG_OPTION_ASYNC (1U << 10)
+#define LLDB_LOG_OPTION_CIRCULAR (1U << 11)
 
 // Logging Functions
 namespace lldb_private {
@@ -0,0 +1,91 @@
+//===-- LogStreams.h --------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_UTILITY_LOGSTREAMS_H
+#define LLDB_UTILITY_LOGSTREAMS_H
+
+#include "llvm/Support/raw_ostream.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lldb_private {
+
+/// A log stream that hands the messages written to it to a background
+/// thread, which writes them to another stream. The threads that log only
+/// wait for a copy into memory, never for the output.
+///
+/// At most \a buffer_size bytes wait to be written. By default messages that
+/// don't fit are dropped, and a note saying how many bytes were lost takes
+/// their place in the output. With \a drop_when_full false, the thread
+/// writing a message that doesn't fit waits for the buffer to drain instead.
+class AsyncLogStream : public llvm::raw_ostream {
+public:
+  AsyncLogStream(std::shared_ptr<llvm::raw_ostream> stream_sp,
+                 size_t buffer_size, bool drop_when_full = true);
+
+  /// Writes out the messages still waiting before returning.
+  ~AsyncLogStream() override;
+
+  /// Wait until everything written so far has been written out.
+  void Drain();
+
+private:
+  void write_impl(const char *ptr, size_t size) override;
+  uint64_t current_pos() const override { return m_pos; }
+
+  void WriteMessages();
+
+  std::shared_ptr<llvm::raw_ostream> m_stream_sp;
+  const size_t m_buffer_size;
+  const bool m_drop_when_full;
+  uint64_t m_pos = 0;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  /// Signaled when the background thread takes the pending messages and
+  /// when it is done writing them.
+  std::condition_variable m_written_cond;
+  std::string m_pending;
+  size_t m_dropped = 0;
+  bool m_writing = false;
+  bool m_stopping = false;
+  std::thread m_thread;
+};
+
+/// A log stream that keeps only the last \a buffer_size bytes written to it,
+/// in memory, until Dump() writes them out. Logging to it costs a copy, so
+/// it can stay on in case something goes wrong.
+class CircularLogStream : public llvm::raw_ostream {
+public:
+  explicit CircularLogStream(size_t buffer_size);
+
+  /// Write the messages in the buffer to \a stream, oldest first, skipping
+  /// the remains of a message that was partly overwritten.
+  void Dump(llvm::raw_ostream &stream);
+
+private:
+  void write_impl(const char *ptr, size_t size) override;
+  uint64_t current_pos() const override { return m_pos; }
+
+  std::mutex m_mutex;
+  std::vector<char> m_buffer;
+  /// Where the next byte goes, which is the oldest byte once the buffer has
+  /// wrapped around.
+  size_t m_next = 0;
+  bool m_wrapped = false;
+  uint64_t m_pos = 0;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_UTILITY_LOGSTREAMS_H
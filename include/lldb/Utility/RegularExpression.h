@@ -64,6 +64,16 @@ public:
   ///     current regular expression
   llvm::StringRef GetText() const;
 
+  /// Get a literal string that every match of this expression starts with.
+  ///
+  /// Lookups over many names can skip a name that doesn't start with this
+  /// prefix without running the regular expression on it.
+  ///
+  /// \return
+  ///     The prefix, which is empty unless the expression is anchored at the
+  ///     start and begins with literal characters.
+  llvm::StringRef GetLiteralPrefix() const;
+
   /// Test if this object contains a valid regular expression.
   ///
   /// \return
@@ -87,10 +97,19 @@ public:
   }
 
 private:
+  /// Work out whether the expression is a plain string, optionally anchored,
+  /// which Execute() can match without running the regular expression.
+  void ComputeLiteral();
+
   /// A copy of the original regular expression text.
   std::string m_regex_text;
   /// The compiled regular expression.
   mutable llvm::Regex m_regex;
+  /// True if the expression has no special characters besides a leading '^'
+  /// and a trailing '$'.
+  bool m_is_literal = false;
+  bool m_anchor_start = false;
+  bool m_anchor_end = false;
 };
 
 } // namespace lldb_private
@@ -59,31 +59,26 @@ public:
 
   // Constructors and Destructors
   Scalar();
-  Scalar(int v) : m_type(e_sint), m_float(static_cast<float>(0)) {
-    m_integer = llvm::APInt(sizeof(int) * 8, v, true);
-  }
-  Scalar(unsigned int v) : m_type(e_uint), m_float(static_cast<float>(0)) {
-    m_integer = llvm::APInt(sizeof(int) * 8, v);
-  }
-  Scalar(long v) : m_type(e_slong), m_float(static_cast<float>(0)) {
-    m_integer = llvm::APInt(sizeof(long) * 8, v, true);
-  }
-  Scalar(unsigned long v) : m_type(e_ulong), m_float(static_cast<float>(0)) {
-    m_integer = llvm::APInt(sizeof(long) * 8, v);
-  }
-  Scalar(long long v) : m_type(e_slonglong), m_float(static_cast<float>(0)) {
-    m_integer = llvm::APInt(sizeof(long long) * 8, v, true);
-  }
+  Scalar(int v)
+      : m_type(e_sint), m_integer(sizeof(int) * 8, v, true),
+        m_float(ZeroFloat()) {}
+  Scalar(unsigned int v)
+      : m_type(e_uint), m_integer(sizeof(int) * 8, v), m_float(ZeroFloat()) {}
+  Scalar(long v)
+      : m_type(e_slong), m_integer(sizeof(long) * 8, v, true),
+        m_float(ZeroFloat()) {}
+  Scalar(unsigned long v)
+      : m_type(e_ulong), m_integer(sizeof(long) * 8, v), m_float(ZeroFloat()) {}
+  Scalar(long long v)
+      : m_type(e_slonglong), m_integer(sizeof(long long) * 8, v, true),
+        m_float(ZeroFloat()) {}
   Scalar(unsigned long long v)
-      : m_type(e_ulonglong), m_float(static_cast<float>(0)) {
-    m_integer = llvm::APInt(sizeof(long long) * 8, v);
-  }
-  Scalar(float v) : m_type(e_float), m_float(v) { m_float = llvm::APFloat(v); }
-  Scalar(double v) : m_type(e_double), m_float(v) {
-    m_float = llvm::APFloat(v);
-  }
+      : m_type(e_ulonglong), m_integer(sizeof(long long) * 8, v),
+        m_float(ZeroFloat()) {}
+  Scalar(float v) : m_type(e_float), m_float(v) {}
+  Scalar(double v) : m_type(e_double), m_float(v) {}
   Scalar(long double v, bool ieee_quad)
-      : m_type(e_long_double), m_float(static_cast<float>(0)),
+      : m_type(e_long_double), m_float(ZeroFloat()),
         m_ieee_quad(ieee_quad) {
     if (ieee_quad)
       m_float =
@@ -96,7 +91,7 @@ public:
                         llvm::APInt(BITWIDTH_INT128, NUM_OF_WORDS_INT128,
                                     (reinterpret_cast<type128 *>(&v))->x));
   }
-  Scalar(llvm::APInt v) : m_type(), m_float(static_cast<float>(0)) {
+  Scalar(llvm::APInt v) : m_type(), m_float(ZeroFloat()) {
     m_integer = llvm::APInt(v);
     switch (m_integer.getBitWidth()) {
     case 8:
@@ -297,6 +292,13 @@ protected:
   llvm::APFloat m_float;
   bool m_ieee_quad = false;
 
+  // The value of m_float while the scalar isn't a float. Building it from
+  // the semantics is much cheaper than converting a host float, and integer
+  // scalars are created all the time.
+  static llvm::APFloat ZeroFloat() {
+    return llvm::APFloat(llvm::APFloat::IEEEsingle());
+  }
+
 private:
   friend const Scalar operator+(const Scalar &lhs, const Scalar &rhs);
   friend const Scalar operator-(const Scalar &lhs, const Scalar &rhs);
@@ -13,6 +13,7 @@
 #include "lldb/Utility/SharingPtr.h"
 
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Support/Allocator.h"
 
 #include <mutex>
 
@@ -46,7 +47,12 @@ public:
                                                        end = m_objects.end();
          pos != end; ++pos) {
       T *object = *pos;
-      delete object;
+      // Objects constructed in the arena are only destroyed here; their
+      // storage is released all at once with m_allocator.
+      if (m_arena_objects.count(dynamic_cast<void *>(object)))
+        object->~T();
+      else
+        delete object;
     }
 
     // Decrement refcount should have been called on this ClusterManager, and
@@ -60,6 +66,16 @@ public:
     m_objects.insert(new_object);
   }
 
+  /// Return storage for an object of type \a U that lives as long as the
+  /// cluster. The object must be constructed in place, register itself with
+  /// ManageObject, and is destroyed together with the cluster.
+  template <typename U> void *Allocate() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    void *storage = m_allocator.Allocate(sizeof(U), alignof(U));
+    m_arena_objects.insert(storage);
+    return storage;
+  }
+
   typename lldb_private::SharingPtr<T> GetSharedPointer(T *desired_object) {
     {
       std::lock_guard<std::mutex> guard(m_mutex);
@@ -86,6 +102,10 @@ private:
   friend class imp::shared_ptr_refcount<ClusterManager>;
 
   llvm::SmallPtrSet<T *, 16> m_objects;
+  /// The children of a large value all die together, so they are
+  /// bump-allocated instead of going through the heap one by one.
+  llvm::BumpPtrAllocator m_allocator;
+  llvm::SmallPtrSet<void *, 16> m_arena_objects;
   int m_external_ref;
   std::mutex m_mutex;
 };
@@ -12,6 +12,7 @@
 #include "lldb/Utility/Flags.h"
 #include "lldb/lldb-defines.h"
 #include "lldb/lldb-enumerations.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/raw_ostream.h"
@@ -482,6 +483,8 @@ protected:
 
   void _PutHex8(uint8_t uvalue, bool add_prefix);
 
+  void _PutBytesAsRawHex8(llvm::ArrayRef<uint8_t> bytes);
+
   /// Output character bytes to the stream.
   ///
   /// Appends \a src_len characters from the buffer \a src to the stream.
@@ -30,6 +30,14 @@ public:
     m_index = 0;
   }
 
+  // Takes over the storage of str instead of copying it.
+  void Reset(std::string &&str) {
+    m_packet = std::move(str);
+    m_index = 0;
+  }
+
+  void Reset(const char *cstr) { Reset(llvm::StringRef(cstr)); }
+
   // Returns true if the file position is still valid for the data contained in
   // this string extractor object.
   bool IsGood() const { return m_index != UINT64_MAX; }
@@ -109,6 +117,13 @@ protected:
     return false;
   }
 
+  /// Decode the pairs of hex digits at the head of the StringExtractor, up to
+  /// dest.size() bytes, stopping at anything else (including spaces).
+  ///
+  /// \return
+  ///     The number of bytes decoded.
+  size_t DecodeHexPairs(llvm::MutableArrayRef<uint8_t> dest);
+
   /// The string in which to extract data.
   std::string m_packet;
 
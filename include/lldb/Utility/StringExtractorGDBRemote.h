@@ -73,6 +73,7 @@ public:
     eServerPacketType_qFileLoadAddress,
     eServerPacketType_QEnvironment,
     eServerPacketType_QEnableErrorStrings,
+    eServerPacketType_QEnableCompression,
     eServerPacketType_QLaunchArch,
     eServerPacketType_QSetDisableASLR,
     eServerPacketType_QSetDetachOnError,
@@ -96,15 +97,22 @@ public:
     eServerPacketType_vFile_symlink,
     eServerPacketType_vFile_unlink,
     // debug server packages
+    eServerPacketType_QClearTracepoint,
+    eServerPacketType_QDeleteSnapshot,
     eServerPacketType_QEnvironmentHexEncoded,
     eServerPacketType_QListThreadsInStopReply,
+    eServerPacketType_QNonStop,
     eServerPacketType_QPassSignals,
     eServerPacketType_QRestoreRegisterState,
+    eServerPacketType_QRestoreSnapshot,
     eServerPacketType_QSaveRegisterState,
+    eServerPacketType_QSaveSnapshot,
     eServerPacketType_QSetLogging,
     eServerPacketType_QSetMaxPacketSize,
     eServerPacketType_QSetMaxPayloadSize,
     eServerPacketType_QSetEnableAsyncProfiling,
+    eServerPacketType_QSetExpeditedStackMemory,
+    eServerPacketType_QSetTracepoint,
     eServerPacketType_QSyncThreadState,
     eServerPacketType_QThreadSuffixSupported,
 
@@ -119,6 +127,7 @@ public:
     eServerPacketType_qProcessInfo,
     eServerPacketType_qRcmd,
     eServerPacketType_qRegisterInfo,
+    eServerPacketType_qSearchMemory,
     eServerPacketType_qShlibInfoAddr,
     eServerPacketType_qStepPacketSupported,
     eServerPacketType_qSupported,
@@ -139,6 +148,7 @@ public:
     eServerPacketType_vAttachName,
     eServerPacketType_vCont,
     eServerPacketType_vCont_actions, // vCont?
+    eServerPacketType_vStopped,
 
     eServerPacketType_stop_reason, // '?'
 
@@ -152,6 +162,7 @@ public:
     eServerPacketType_k,
     eServerPacketType_m,
     eServerPacketType_M,
+    eServerPacketType_MultiMemRead,
     eServerPacketType_p,
     eServerPacketType_P,
     eServerPacketType_s,
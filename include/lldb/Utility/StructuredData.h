@@ -541,7 +541,7 @@ public:
     void *m_object;
   };
 
-  static ObjectSP ParseJSON(std::string json_text);
+  static ObjectSP ParseJSON(llvm::StringRef json_text);
 
   static ObjectSP ParseJSONFromFile(const FileSpec &file, Status &error);
 };
@@ -13,12 +13,21 @@
 #include "llvm/Support/Chrono.h"
 #include <atomic>
 #include <stdint.h>
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+}
 
 namespace lldb_private {
 class Stream;
 
 /// \class Timer Timer.h "lldb/Utility/Timer.h"
 /// A timer class that simplifies common timing metrics.
+///
+/// Each thread accumulates the times of the categories on its own, without
+/// locks or shared cache lines, and the times of all the threads are merged
+/// when they are asked for.
 
 class Timer {
 public:
@@ -29,9 +38,8 @@ public:
   private:
     friend class Timer;
     const char *m_name;
-    std::atomic<uint64_t> m_nanos;
-    std::atomic<uint64_t> m_nanos_total;
-    std::atomic<uint64_t> m_count;
+    /// Where the times of this category are kept in each thread.
+    uint32_t m_index;
     std::atomic<Category *> m_next;
 
     DISALLOW_COPY_AND_ASSIGN(Category);
@@ -50,10 +58,28 @@ public:
 
   static void SetQuiet(bool value);
 
+  struct CategoryStats {
+    const char *name;
+    uint64_t nanos;
+    uint64_t nanos_total;
+    uint64_t count;
+  };
+
+  /// The times of the categories that have been timed, slowest first.
+  static std::vector<CategoryStats> GetCategoryStats();
+
   static void DumpCategoryTimes(Stream *s);
 
   static void ResetCategoryTimes();
 
+  /// Start or stop recording an event for every timer that completes, for
+  /// DumpTraceEvents(). Starting a recording discards the previous one.
+  static void SetRecordTraceEvents(bool record);
+
+  /// Write the recorded events in the Chrome trace event format, which
+  /// chrome://tracing and other trace viewers display as a flame chart.
+  static void DumpTraceEvents(llvm::raw_ostream &os);
+
 protected:
   using TimePoint = std::chrono::steady_clock::time_point;
   void ChildDuration(TimePoint::duration dur) { m_child_duration += dur; }
@@ -69,6 +95,43 @@ private:
   DISALLOW_COPY_AND_ASSIGN(Timer);
 };
 
+/// A duration that several threads can add to, for statistics about a
+/// particular object, where a Timer::Category would lump all of the objects
+/// together.
+class StatsDuration {
+public:
+  void operator+=(std::chrono::nanoseconds duration) {
+    m_nanos.fetch_add(duration.count(), std::memory_order_relaxed);
+  }
+
+  /// The duration in seconds.
+  double get() const {
+    return m_nanos.load(std::memory_order_relaxed) / 1000000000.;
+  }
+
+private:
+  std::atomic<uint64_t> m_nanos{0};
+};
+
+/// Adds the time between its construction and its destruction to a
+/// StatsDuration.
+class ElapsedTime {
+public:
+  explicit ElapsedTime(StatsDuration &duration)
+      : m_duration(duration), m_start(std::chrono::steady_clock::now()) {}
+
+  ~ElapsedTime() {
+    m_duration += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - m_start);
+  }
+
+private:
+  StatsDuration &m_duration;
+  std::chrono::steady_clock::time_point m_start;
+
+  DISALLOW_COPY_AND_ASSIGN(ElapsedTime);
+};
+
 } // namespace lldb_private
 
 #endif // liblldb_Timer_h_
@@ -68,6 +68,7 @@ class CompileUnit;
 class Connection;
 class ConnectionFileDescriptor;
 class ConstString;
+class ConstStringTable;
 class CXXSyntheticChildren;
 class DWARFCallFrameInfo;
 class DWARFDataExtractor;
@@ -236,7 +236,10 @@ enum StatisticKind {
   ExpressionFailure = 1,
   FrameVarSuccess = 2,
   FrameVarFailure = 3,
-  StatisticMax = 4
+  SwiftTypeInfoLookups = 4,
+  SwiftTypeInfoCacheHits = 5,
+  SwiftTypeInfoMicroseconds = 6,
+  StatisticMax = 7
 };
 
 
@@ -250,6 +253,12 @@ inline std::string GetStatDescription(lldb_private::StatisticKind K) {
      return "Number of frame var successes";
    case StatisticKind::FrameVarFailure:
      return "Number of frame var failures";
+   case StatisticKind::SwiftTypeInfoLookups:
+     return "Number of Swift type info lookups";
+   case StatisticKind::SwiftTypeInfoCacheHits:
+     return "Number of Swift type info cache hits";
+   case StatisticKind::SwiftTypeInfoMicroseconds:
+     return "Microseconds spent in Swift type info lookups";
    case StatisticKind::StatisticMax:
      return "";
    }
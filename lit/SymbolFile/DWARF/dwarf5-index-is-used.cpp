@@ -1,4 +1,5 @@
-// Test that we use the DWARF v5 name indexes.
+// Test that we use the DWARF v5 name indexes, and that we don't index any
+// units manually when they cover the whole module.
 
 // REQUIRES: lld
 
@@ -6,6 +7,7 @@
 // RUN: ld.lld %t.o -o %t
 // RUN: lldb-test symbols %t | FileCheck %s
 
+// CHECK-NOT: Manual DWARF index
 // CHECK: Name Index
 // CHECK: String: 0x{{.*}} "_start"
 // CHECK: Tag: DW_TAG_subprogram
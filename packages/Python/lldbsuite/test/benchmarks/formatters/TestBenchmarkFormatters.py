@@ -0,0 +1,25 @@
+"""
+Benchmark the data formatters of the libc++ containers and deep structs.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestBenchmarkFormatters(FormatterBenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @benchmarks_test
+    @add_test_categories(["libc++"])
+    def test_formatters(self):
+        """Benchmark printing, child enumeration and summaries (libc++)"""
+        self.run_to_break_here("main.cpp")
+        self.benchmark_variables(["vector", "map", "unordered_map", "nested",
+                                  "deep"])
@@ -0,0 +1,59 @@
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct Leaf {
+  int id;
+  double weight;
+  const char *label;
+};
+
+struct Level3 {
+  Leaf leaves[4];
+  Leaf *first;
+};
+
+struct Level2 {
+  Level3 inner[4];
+  std::string name;
+};
+
+struct Level1 {
+  Level2 inner[4];
+  std::vector<int> ids;
+};
+
+struct Deep {
+  Level1 inner[4];
+};
+
+int main() {
+  std::vector<int> vector;
+  std::map<int, std::string> map;
+  std::unordered_map<std::string, int> unordered_map;
+  std::vector<std::vector<int>> nested;
+  for (int i = 0; i < 2000; ++i) {
+    vector.push_back(i);
+    map[i] = std::to_string(i);
+    unordered_map[std::to_string(i)] = i;
+    if (i % 20 == 0)
+      nested.push_back(std::vector<int>(20, i));
+  }
+
+  static Deep deep;
+  for (Level1 &l1 : deep.inner) {
+    l1.ids.assign(10, 1);
+    for (Level2 &l2 : l1.inner) {
+      l2.name = "level two";
+      for (Level3 &l3 : l2.inner) {
+        for (Leaf &leaf : l3.leaves)
+          leaf = {1, 2.0, "leaf"};
+        l3.first = &l3.leaves[0];
+      }
+    }
+  }
+
+  return vector.size() + map.size() + unordered_map.size() + nested.size() +
+         deep.inner[0].ids.size(); // break here
+}
@@ -0,0 +1,86 @@
+"""
+Benchmark many targets in one debugger, each stopping and backtracing on its
+own thread, to find contention on the state the targets share.
+"""
+
+from __future__ import print_function
+
+import threading
+
+import lldb
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestMultiTargetThroughput(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    NUM_CYCLES = 50
+
+    def attach(self, exe):
+        """Spawn a copy of the inferior and attach a new target to it, with a
+        breakpoint in break_here."""
+        popen = self.spawnSubprocess(exe)
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target.IsValid())
+        error = lldb.SBError()
+        listener = lldb.SBListener("multitarget.attach.listener")
+        process = target.AttachToProcessWithID(listener, popen.pid, error)
+        self.assertTrue(error.Success() and process.IsValid(),
+                        "attach failed: %s" % error.GetCString())
+        bkpt = target.BreakpointCreateByName("break_here")
+        self.assertTrue(bkpt.GetNumLocations() > 0)
+        return process
+
+    def stop_and_backtrace(self, process, errors):
+        """Continue to the breakpoint and walk the whole stack, NUM_CYCLES
+        times."""
+        try:
+            for cycle in range(self.NUM_CYCLES):
+                process.Continue()
+                if process.GetState() != lldb.eStateStopped:
+                    errors.append("process %d didn't stop" %
+                                  process.GetProcessID())
+                    return
+                for thread in process:
+                    for frame in thread:
+                        frame.GetFunctionName()
+                        frame.GetLineEntry()
+        except Exception as e:
+            errors.append(str(e))
+
+    def run_targets(self, num_targets):
+        exe = self.getBuildArtifact("a.out")
+        processes = [self.attach(exe) for i in range(num_targets)]
+        errors = []
+        threads = [threading.Thread(target=self.stop_and_backtrace,
+                                    args=(process, errors))
+                   for process in processes]
+        stopwatch = Stopwatch()
+        with stopwatch:
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+        for process in processes:
+            process.Kill()
+        self.assertEqual(errors, [])
+
+        elapsed = stopwatch.avg()
+        cycles = num_targets * self.NUM_CYCLES
+        print("%3d targets: %5d stop and backtrace cycles in %8.3f s, "
+              "%8.1f cycles/s" % (num_targets, cycles, elapsed,
+                                  cycles / elapsed))
+
+    @benchmarks_test
+    @skipIfWindows
+    def test_multi_target_throughput(self):
+        """Benchmark stop and backtrace cycles of 1 to 16 targets at once"""
+        self.build()
+        self.addTearDownHook(self.cleanupSubprocesses)
+        self.dbg.SetAsync(False)
+        for num_targets in (1, 4, 16):
+            self.run_targets(num_targets)
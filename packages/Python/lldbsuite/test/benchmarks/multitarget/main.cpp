@@ -0,0 +1,23 @@
+#include <chrono>
+#include <thread>
+
+static volatile int g_count;
+
+// The benchmark stops here and walks the stack.
+void break_here(int depth) { g_count = depth; }
+
+void recurse(int depth) {
+  if (depth == 0)
+    break_here(depth);
+  else
+    recurse(depth - 1);
+  g_count += 1;
+}
+
+int main(int argc, char const *argv[]) {
+  while (true) {
+    recurse(32);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return 0;
+}
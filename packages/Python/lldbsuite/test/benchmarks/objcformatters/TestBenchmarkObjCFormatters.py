@@ -0,0 +1,25 @@
+"""
+Benchmark the data formatters of the Foundation collections.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestBenchmarkObjCFormatters(FormatterBenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @benchmarks_test
+    @skipUnlessDarwin
+    def test_formatters(self):
+        """Benchmark printing, child enumeration and summaries (Foundation)"""
+        self.run_to_break_here("main.m")
+        self.benchmark_variables(["dictionary", "immutable_dictionary",
+                                  "array"])
@@ -0,0 +1,14 @@
+#import <Foundation/Foundation.h>
+
+int main() {
+  NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+  NSMutableArray *array = [NSMutableArray array];
+  for (int i = 0; i < 2000; ++i) {
+    NSString *key = [NSString stringWithFormat:@"key %d", i];
+    dictionary[key] = @(i);
+    [array addObject:key];
+  }
+  NSDictionary *immutable_dictionary = [dictionary copy];
+  return dictionary.count + array.count +
+         immutable_dictionary.count; // break here
+}
@@ -0,0 +1,23 @@
+"""
+Benchmark the data formatters of the Swift collections.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.lldbbench import *
+import lldbsuite.test.decorators as decorators
+from lldbsuite.test.lldbtest import *
+import lldbsuite.test.lldbutil as lldbutil
+
+
+class TestBenchmarkSwiftFormatters(FormatterBenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @decorators.benchmarks_test
+    def test_formatters(self):
+        """Benchmark printing, child enumeration and summaries (Swift)"""
+        self.run_to_break_here("main.swift")
+        self.benchmark_variables(["array", "dictionary", "points"])
@@ -0,0 +1,18 @@
+struct Point {
+  var x: Int
+  var y: Int
+}
+
+func main() -> Int {
+  var array = [Int]()
+  var dictionary = [String: Int]()
+  var points = [Point]()
+  for i in 0..<2000 {
+    array.append(i)
+    dictionary["key \(i)"] = i
+    points.append(Point(x: i, y: -i))
+  }
+  return array.count + dictionary.count + points.count // break here
+}
+
+print(main())
@@ -51,3 +51,41 @@ class PersistentVariablesTestCase(TestBase):
 
         self.expect("expression (long)$4",
                     startstr="(long) $6 = -2")
+
+    def test_result_variable_limit(self):
+        """Test that the results used least recently are removed past the limit."""
+        self.build()
+
+        self.runCmd("file " + self.getBuildArtifact("a.out"), CURRENT_EXECUTABLE_SET)
+
+        self.runCmd("breakpoint set --source-pattern-regexp break")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        self.runCmd("settings set target.max-expression-results 2")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.max-expression-results"))
+
+        self.runCmd("expression int $i = i")
+
+        self.expect("expression (int)1",
+                    startstr="(int) $0 = 1")
+
+        self.expect("expression (int)2",
+                    startstr="(int) $1 = 2")
+
+        # Using $0 makes $1 the result used least recently.
+        self.expect("expression $0",
+                    startstr="(int) $0 = 1")
+
+        self.expect("expression (int)3",
+                    startstr="(int) $2 = 3")
+
+        self.expect("expression $0",
+                    startstr="(int) $0 = 1")
+
+        self.expect("expression $1", error=True)
+
+        # Named persistent variables are never removed.
+        self.expect("expression $i",
+                    startstr="(int) $i = 5")
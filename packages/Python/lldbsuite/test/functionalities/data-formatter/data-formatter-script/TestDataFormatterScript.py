@@ -44,6 +44,9 @@ class ScriptDataFormatterTestCase(TestBase):
         def cleanup():
             self.runCmd('type format clear', check=False)
             self.runCmd('type summary clear', check=False)
+            self.runCmd(
+                'settings clear target.experimental.batch-child-summaries',
+                check=False)
 
         # Execute the cleanup function during test case tear down.
         self.addTearDownHook(cleanup)
@@ -70,6 +73,14 @@ class ScriptDataFormatterTestCase(TestBase):
                     substrs=['Hello from Python, 10 times!',
                              'Hello from Python, 4 times!'])
 
+        # Batching the children doesn't change the output.
+        self.runCmd(
+            "settings set target.experimental.batch-child-summaries true")
+        self.expect("frame variable three",
+                    substrs=['Hello from Python, 10 times!',
+                             'Hello from Python, 4 times!'])
+        self.runCmd("settings clear target.experimental.batch-child-summaries")
+
         self.runCmd("n")  # skip ahead to make values change
 
         self.expect("frame variable two",
@@ -35,5 +35,9 @@ int main (int argc, char const *argv[])
      //% self.assertTrue(self.frame().FindVariable('constcharstar').GetSummary() == '"Hello\t\tWorld\nI am here\t\tto say hello\n"')
     //% self.assertTrue(self.frame().FindVariable('longstring').GetSummary().endswith('"...'))
     //% self.assertTrue(self.frame().FindVariable('longconstcharstar').GetSummary().endswith('"...'))
+    //% self.addTearDownHook(lambda x: x.runCmd("settings clear target.max-string-summary-length"))
+    //% self.runCmd("settings set target.max-string-summary-length 4096")
+    //% self.assertTrue(self.frame().FindVariable('longconstcharstar').GetSummary().endswith('for science, or something"'))
+    //% self.assertEqual(len(self.frame().FindVariable('longconstcharstar').GetSummary()), 2 + 3 * 722)
 }
 
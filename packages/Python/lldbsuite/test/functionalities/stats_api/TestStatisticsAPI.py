@@ -29,9 +29,39 @@ class TestStatsAPI(TestBase):
         stats = target.GetStatistics()
         stream = lldb.SBStream()
         res = stats.GetAsJSON(stream)
-        stats_json = sorted(json.loads(stream.GetData()))
-        self.assertEqual(len(stats_json), 4)
+        stats = json.loads(stream.GetData())
+        stats_json = sorted(stats)
+        # The seven counters, plus the module, timer and memory reports. The
+        # memory cache and packet reports need a process.
+        self.assertEqual(len(stats_json), 10)
         self.assertTrue("Number of expr evaluation failures" in stats_json)
         self.assertTrue("Number of expr evaluation successes" in stats_json)
         self.assertTrue("Number of frame var failures" in stats_json)
         self.assertTrue("Number of frame var successes" in stats_json)
+        self.assertTrue("Number of Swift type info lookups" in stats_json)
+        self.assertTrue("Number of Swift type info cache hits" in stats_json)
+        self.assertTrue(
+            "Microseconds spent in Swift type info lookups" in stats_json)
+        self.assertTrue("timers" in stats_json)
+        self.assertTrue("stringPool" in stats["memory"])
+        modules = stats["modules"]
+        self.assertEqual(len(modules), target.GetNumModules())
+        for module in modules:
+            self.assertTrue("path" in module)
+            self.assertTrue("symtabParseTime" in module)
+            self.assertTrue("total" in module["memory"])
+
+    def test_memory_usage(self):
+        self.build()
+        exe = self.getBuildArtifact("a.out")
+        target = self.dbg.CreateTarget(exe)
+
+        stream = lldb.SBStream()
+        self.dbg.GetMemoryUsage().GetAsJSON(stream)
+        usage = json.loads(stream.GetData())
+        self.assertTrue(usage["stringPool"] > 0)
+        self.assertEqual(len(usage["modules"]), target.GetNumModules())
+        self.assertEqual(len(usage["targets"]), 1)
+        self.assertTrue(usage["total"] >= usage["stringPool"])
+
+        self.expect("memory-pressure")
@@ -26,6 +26,17 @@ class BacktraceAllTestCase(TestBase):
     # TODO: Change the test to don't depend on std::future<T>
     def test(self):
         """Test breakpoint handling after a thread join."""
+        self.do_backtrace_all()
+
+    @skipIfTargetAndroid(archs=["arm"])
+    def test_parallel_unwind(self):
+        """Test backtracing all threads while unwinding them concurrently."""
+        self.runCmd("settings set target.process.parallel-unwind true")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.process.parallel-unwind"))
+        self.do_backtrace_all()
+
+    def do_backtrace_all(self):
         self.build(dictionary=self.getBuildFlags())
 
         exe = self.getBuildArtifact("a.out")
@@ -0,0 +1,44 @@
+"""
+Test that we can backtrace by following the frame pointer chain in a
+program built with frame pointers.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class FramePointerUnwind(TestBase):
+    mydir = TestBase.compute_mydir(__file__)
+
+    def do_backtrace(self, frame_pointer_unwind):
+        self.build()
+        self.runCmd("settings set target.frame-pointer-unwind %s" %
+                    ("true" if frame_pointer_unwind else "false"))
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.frame-pointer-unwind"))
+
+        target, process, thread, _ = lldbutil.run_to_source_breakpoint(
+            self, "// Set breakpoint here", lldb.SBFileSpec("main.c"))
+
+        if self.TraceOn():
+            print("Backtrace once we're stopped:")
+            for f in thread.frames:
+                print("  %d %s" % (f.GetFrameID(), f.GetFunctionName()))
+
+        names = [f.GetFunctionName() for f in thread.frames]
+        self.assertEqual(names[:4], ["func_c", "func_b", "func_a", "main"])
+
+    @skipIf(archs=no_match(['x86_64', 'i386', 'arm64', 'aarch64']))
+    def test_regular_unwind(self):
+        """Test the backtrace with the regular unwinder"""
+        self.do_backtrace(False)
+
+    @skipIf(archs=no_match(['x86_64', 'i386', 'arm64', 'aarch64']))
+    def test_frame_pointer_unwind(self):
+        """Test the backtrace with target.frame-pointer-unwind"""
+        self.do_backtrace(True)
@@ -0,0 +1,13 @@
+static int func_c(int) __attribute__((noinline));
+static int func_b(int) __attribute__((noinline));
+static int func_a(int) __attribute__((noinline));
+
+static int func_c(int i) {
+  return i + 1; // Set breakpoint here
+}
+
+static int func_b(int i) { return func_c(i * 2) + 1; }
+
+static int func_a(int i) { return func_b(i + 3) + 1; }
+
+int main(int argc, char const *argv[]) { return func_a(argc); }
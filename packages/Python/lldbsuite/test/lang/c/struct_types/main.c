@@ -42,5 +42,10 @@ int main (int argc, char const *argv[])
 
     int sum = sum_things(tts); //% self.expect("expression -- &pt == (struct point_tag*)0", substrs = ['false'])
                                //% self.expect("expression -- sum_things(tts)", substrs = ['9'])
+                               //% rect = self.frame().EvaluateExpression("rect")
+                               //% top_right = rect.GetChildMemberWithName("top_right")
+                               //% self.assertEqual(top_right.GetChildMemberWithName("x").GetValueAsSigned(), 3)
+                               //% self.assertEqual(top_right.GetChildMemberWithName("y").GetValueAsSigned(), 4)
+                               //% self.expect("expression -- rect", substrs = ["bottom_left = (x = 1, y = 2", "top_right = (x = 3, y = 4"])
     return 0;
 }
@@ -0,0 +1,26 @@
+// Make sure array elements, and their dynamic types, are read correctly when
+// they are read in batches.
+
+class Base {}
+class Derived : Base {}
+class Other : Base {}
+protocol P {}
+struct S : P { var a = 1, b = 2, c = 3, d = 4 }
+extension Int : P {}
+
+func main() -> Int {
+  let classes: [Base] = [Derived(), Other(), Derived()]
+  let existentials: [Any] = [1, "two", S(), Derived()]
+  let protocols: [P] = [S(), 5]
+  let doubles = (0..<3000).map { Double($0) / 2 }
+  return 0 //%self.expect('frame variable -d run -- classes', substrs=['Derived', 'Other'])
+           //%self.expect('frame variable -d run -- existentials', substrs=['Int', 'String', 'S', 'Derived'])
+           //%self.expect('frame variable -d run -- protocols', substrs=['S', 'Int'])
+           //%self.expect('frame variable doubles[1]', substrs=['0.5'])
+           //%self.expect('frame variable doubles[2999]', substrs=['1499.5'])
+           //%self.expect('frame variable doubles[1025]', substrs=['512.5'])
+           //%self.assertEqual(self.frame().FindVariable('doubles').GetChildrenInRange(2990, 20).GetSize(), 10)
+           //%self.assertEqual(self.frame().FindVariable('doubles').GetChildrenInRange(2990, 20).GetValueAtIndex(9).GetValue(), '1499.5')
+}
+
+let _ = main()
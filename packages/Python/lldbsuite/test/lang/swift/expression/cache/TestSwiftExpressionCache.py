@@ -0,0 +1,45 @@
+# TestSwiftExpressionCache.py
+#
+# This source file is part of the Swift.org open source project
+#
+# Copyright (c) 2014 - 2019 Apple Inc. and the Swift project authors
+# Licensed under Apache License v2.0 with Runtime Library Exception
+#
+# See https://swift.org/LICENSE.txt for license information
+# See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+#
+# ------------------------------------------------------------------------------
+"""
+Test that cached Swift expressions see new values and generic bindings
+"""
+import lldb
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test.decorators import *
+import lldbsuite.test.lldbutil as lldbutil
+
+
+class TestSwiftExpressionCache(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @swiftTest
+    def test_expression_cache(self):
+        """Test evaluating the same expressions at repeated stops"""
+        self.build()
+        self.runCmd(
+            "settings set target.experimental.swift-cache-expressions true")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.experimental.swift-cache-expressions"))
+        target, process, thread, _ = lldbutil.run_to_source_breakpoint(
+            self, 'Set breakpoint here', lldb.SBFileSpec('main.swift'))
+
+        for i in range(3):
+            for value in [str(i), '"s%d"' % i]:
+                frame = thread.GetFrameAtIndex(0)
+                doubled = frame.EvaluateExpression("i * 2")
+                self.assertTrue(doubled.GetError().Success())
+                self.assertEqual(doubled.GetValueAsSigned(), i * 2)
+                self.expect("expr -- value", substrs=[value])
+                process.Continue()
+
+        self.assertEqual(process.GetState(), lldb.eStateExited)
@@ -0,0 +1,20 @@
+// main.swift
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2019 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+// -----------------------------------------------------------------------------
+
+func describe<T>(_ value: T, _ i: Int) {
+  print(value, i) // Set breakpoint here
+}
+
+for i in 0..<3 {
+  describe(i, i)
+  describe("s\(i)", i)
+}
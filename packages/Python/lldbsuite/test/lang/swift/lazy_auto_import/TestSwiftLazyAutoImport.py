@@ -0,0 +1,43 @@
+# TestSwiftLazyAutoImport.py
+#
+# This source file is part of the Swift.org open source project
+#
+# Copyright (c) 2014 - 2019 Apple Inc. and the Swift project authors
+# Licensed under Apache License v2.0 with Runtime Library Exception
+#
+# See https://swift.org/LICENSE.txt for license information
+# See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+#
+# ------------------------------------------------------------------------------
+"""
+Test that expressions evaluate with target.experimental.swift-lazy-auto-import
+"""
+import lldb
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test.decorators import *
+import lldbsuite.test.lldbutil as lldbutil
+
+
+class TestSwiftLazyAutoImport(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @swiftTest
+    @skipUnlessDarwin
+    def test_lazy_auto_import(self):
+        """Test expressions that need no module, a deferred module found by
+           name lookup, and an extension from a deferred module"""
+        self.build()
+        self.runCmd(
+            "settings set target.experimental.swift-lazy-auto-import true")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.experimental.swift-lazy-auto-import"))
+        lldbutil.run_to_source_breakpoint(
+            self, 'Set breakpoint here', lldb.SBFileSpec('main.swift'))
+
+        self.expect("expr array.count", substrs=["3"])
+        self.expect("expr NSString(string: string).length", substrs=["3"])
+        # Member lookups don't trigger the deferred imports, this is only
+        # found after falling back to importing everything.
+        self.expect("expr string.components(separatedBy: \",\").count",
+                    substrs=["2"])
@@ -0,0 +1,40 @@
+# TestSwiftModuleContextsOnLoad.py
+#
+# This source file is part of the Swift.org open source project
+#
+# Copyright (c) 2014 - 2019 Apple Inc. and the Swift project authors
+# Licensed under Apache License v2.0 with Runtime Library Exception
+#
+# See https://swift.org/LICENSE.txt for license information
+# See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+#
+# ------------------------------------------------------------------------------
+"""
+Test target.experimental.swift-create-module-contexts-on-load
+"""
+import lldb
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test.decorators import *
+import lldbsuite.test.lldbutil as lldbutil
+
+
+class TestSwiftModuleContextsOnLoad(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @swiftTest
+    def test_module_contexts_on_load(self):
+        """Test that variables are shown when the module contexts are
+           created in the background"""
+        self.build()
+        self.runCmd("settings set "
+                    "target.experimental.swift-create-module-contexts-on-load "
+                    "true")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear "
+            "target.experimental.swift-create-module-contexts-on-load"))
+        lldbutil.run_to_source_breakpoint(
+            self, 'Set breakpoint here', lldb.SBFileSpec('main.swift'))
+
+        self.expect("frame variable point", substrs=["x = 1", "y = 2"])
+        self.expect("expr point.x + point.y", substrs=["3"])
@@ -0,0 +1,11 @@
+struct Point {
+  var x = 1
+  var y = 2
+}
+
+func main() {
+  let point = Point()
+  print(point) // Set breakpoint here
+}
+
+main()
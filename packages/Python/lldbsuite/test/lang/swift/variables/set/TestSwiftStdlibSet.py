@@ -42,6 +42,14 @@ class TestSwiftStdlibSet(TestBase):
                 ' = 1',
                 ' = 4'])
 
+        # A set whose elements are read in several batches.
+        big = self.frame().FindVariable("big")
+        big.SetPreferSyntheticValue(True)
+        self.assertEqual(big.GetNumChildren(), 5000)
+        values = set(big.GetChildAtIndex(i).GetValueAsUnsigned()
+                     for i in range(big.GetNumChildren()))
+        self.assertEqual(values, set(range(5000)))
+
 
 if __name__ == '__main__':
     import atexit
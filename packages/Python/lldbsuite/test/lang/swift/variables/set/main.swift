@@ -16,6 +16,7 @@ func main() {
   set.insert(3)
   set.insert(4)
   set.insert(5)
+  let big = Set(0..<5000)
   print("break here")
 }
 
@@ -1,6 +1,7 @@
 from __future__ import absolute_import
 
 # System modules
+import json
 import time
 #import numpy
 from lldbsuite.test.lldbtest import *
@@ -8,7 +9,9 @@ from lldbsuite.test.lldbtest import *
 # Third-party modules
 
 # LLDB modules
+import lldb
 from .lldbtest import *
+from . import lldbutil
 
 
 class Stopwatch(object):
@@ -118,3 +121,82 @@ class BenchBase(TestBase):
         super(BenchBase, self).tearDown()
         # TestBase.tearDown(self)
         del self.stopwatch
+
+
+class FormatterBenchBase(BenchBase):
+    """
+    Base class for benchmarks of the data formatters. Each variable is timed
+    printing (ValueObjectPrinter), enumerating its children through
+    SBValue.GetChildAtIndex, and looking up and computing its summary. The
+    memory reads those issue, through the process memory cache and as read
+    packets to the remote stub, are counted for the first lap, which starts
+    with fresh value objects.
+    """
+
+    def run_to_break_here(self, source_file):
+        self.build()
+        (self.bench_target, process, thread, bkpt) = \
+            lldbutil.run_to_source_breakpoint(
+                self, "break here", lldb.SBFileSpec(source_file))
+        self.bench_frame = thread.GetFrameAtIndex(0)
+
+    def fresh_value(self, name):
+        """Return a new value object for the variable \a name, so no
+        children or summaries are cached yet."""
+        var = self.bench_frame.FindVariable(name)
+        self.assertTrue(var.IsValid(), "no variable named " + name)
+        return self.bench_target.CreateValueFromAddress(
+            name, var.GetAddress(), var.GetType())
+
+    def memory_read_counts(self):
+        stream = lldb.SBStream()
+        self.bench_target.GetStatistics().GetAsJSON(stream)
+        stats = json.loads(stream.GetData())
+        cache = stats.get("memoryCache", {})
+        packets = stats.get("packets", {})
+        reads = cache.get("hits", 0) + cache.get("misses", 0)
+        read_packets = sum(packets.get(kind, {}).get("count", 0)
+                           for kind in ("m", "x"))
+        return (reads, read_packets)
+
+    def print_value(self, value):
+        stream = lldb.SBStream()
+        value.GetDescription(stream)
+        return stream.GetSize()
+
+    def enumerate_children(self, value, depth=3, limit=100000):
+        count = 0
+        pending = [(value, 0)]
+        while pending and count < limit:
+            (parent, level) = pending.pop()
+            if level == depth:
+                continue
+            for i in range(parent.GetNumChildren()):
+                child = parent.GetChildAtIndex(i)
+                child.GetValue()
+                count += 1
+                pending.append((child, level + 1))
+        return count
+
+    def compute_summary(self, value):
+        value.GetTypeSummary()
+        return len(value.GetSummary() or "")
+
+    def benchmark_variables(self, names, laps=5):
+        kinds = [("print", self.print_value),
+                 ("children", self.enumerate_children),
+                 ("summary", self.compute_summary)]
+        for name in names:
+            for (kind, measure) in kinds:
+                stopwatch = Stopwatch()
+                reads = None
+                for lap in range(laps):
+                    value = self.fresh_value(name)
+                    before = self.memory_read_counts()
+                    with stopwatch:
+                        measure(value)
+                    if reads is None:
+                        after = self.memory_read_counts()
+                        reads = (after[0] - before[0], after[1] - before[1])
+                print("%-16s %-8s %s, memory reads: %d, read packets: %d" %
+                      (name, kind, stopwatch, reads[0], reads[1]))
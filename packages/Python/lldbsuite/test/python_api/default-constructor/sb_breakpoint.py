@@ -30,6 +30,7 @@ def fuzz_obj(obj):
     obj.GetQueueName()
     obj.SetScriptCallbackFunction(None)
     obj.SetScriptCallbackBody(None)
+    obj.SetRegisteredCallback(None)
     obj.GetNumResolvedLocations()
     obj.GetNumLocations()
     obj.GetDescription(lldb.SBStream())
@@ -31,6 +31,7 @@ def fuzz_obj(obj):
     obj.SetCommandLineCommands(commands)
     obj.GetCommandLineCommands(commands)
     obj.SetScriptCallbackBody("Insert Python Code here")
+    obj.SetRegisteredCallback("ACallback")
     obj.GetAllowList()
     obj.SetAllowList(False)
     obj.GetAllowDelete()
@@ -161,6 +161,40 @@ class FrameAPITestCase(TestBase):
 
         frame.EvaluateExpression(None)
 
+    @add_test_categories(['pyapi'])
+    def test_get_values_for_variable_paths(self):
+        """Exercise SBFrame.GetValuesForVariablePaths() API."""
+        self.build()
+        exe = self.getBuildArtifact("a.out")
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByName('c', 'a.out')
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        thread = lldbutil.get_stopped_thread(
+            process, lldb.eStopReasonBreakpoint)
+        self.assertIsNotNone(thread)
+        frame = thread.GetFrameAtIndex(0)
+
+        paths = lldb.SBStringList()
+        for path in ['val', 'ch', 'not_a_variable', 'my_val']:
+            paths.AppendString(path)
+        values = frame.GetValuesForVariablePaths(paths)
+        self.assertEqual(values.GetSize(), paths.GetSize())
+        for i in [0, 1, 3]:
+            expected = frame.GetValueForVariablePath(paths.GetStringAtIndex(i))
+            self.assertTrue(values.GetValueAtIndex(i).GetError().Success())
+            self.assertEqual(values.GetValueAtIndex(i).GetValue(),
+                             expected.GetValue())
+        self.assertEqual(values.GetValueAtIndex(0).GetValueAsSigned(), 3)
+        # A path that doesn't evaluate keeps its place in the list.
+        self.assertTrue(values.GetValueAtIndex(2).GetError().Fail())
+
     @add_test_categories(['pyapi'])
     def test_frame_api_IsEqual(self):
         """Exercise SBFrame API IsEqual."""
@@ -0,0 +1,54 @@
+"""
+Test SBFrame.GetIntegerArgumentValues() and SBFrame.GetIntegerReturnValue().
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class IntegerArgumentsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @add_test_categories(['pyapi'])
+    @skipIf(archs=no_match(['x86_64']))
+    def test_integer_arguments(self):
+        """Read the arguments at the entry of a function and its return value."""
+        self.build()
+        exe = self.getBuildArtifact("a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        # Stop at the first instruction, before the prologue moves the stack
+        # pointer.
+        functions = target.FindFunctions("traced")
+        self.assertEqual(functions.GetSize(), 1)
+        entry = functions[0].GetSymbol().GetStartAddress()
+        breakpoint = target.BreakpointCreateBySBAddress(entry)
+        self.assertTrue(breakpoint.GetNumLocations() == 1, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        threads = lldbutil.get_threads_stopped_at_breakpoint(
+            process, breakpoint)
+        self.assertEqual(len(threads), 1)
+        thread = threads[0]
+
+        # The last two are passed on the stack.
+        error = lldb.SBError()
+        data = thread.GetFrameAtIndex(0).GetIntegerArgumentValues(8, error)
+        self.assertTrue(error.Success(), error.GetCString())
+        self.assertEqual(data.GetByteSize(), 64)
+        self.assertEqual(data.sint64s, [1, 2, 3, 4, -5, 6, 7,
+                                        0x1122334455667788])
+
+        thread.StepOut()
+        value = thread.GetFrameAtIndex(0).GetIntegerReturnValue(error)
+        self.assertTrue(error.Success(), error.GetCString())
+        self.assertEqual(value, 0x1122334455667788 + 18)
@@ -0,0 +1,9 @@
+long traced(long a, long b, long c, long d, long e, long f, long g,
+            long h) {
+  return a + b + c + d + e + f + g + h;
+}
+
+int main(int argc, char const *argv[]) {
+  long sum = traced(1, 2, 3, 4, -5, 6, 7, 0x1122334455667788);
+  return sum == 0;
+}
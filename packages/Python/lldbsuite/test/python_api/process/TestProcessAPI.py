@@ -121,6 +121,52 @@ class ProcessAPITestCase(TestBase):
             self.fail(
                 "Result from SBProcess.ReadUnsignedFromMemory() does not match our expected output")
 
+    @add_test_categories(['pyapi'])
+    def test_read_memory_ranges(self):
+        """Test Python SBProcess.ReadMemoryRanges() API."""
+        self.build()
+        exe = self.getBuildArtifact("a.out")
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByLocation("main.cpp", self.line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        # Launch the process, and do not stop at the entry point.
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+
+        thread = get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(
+            thread.IsValid(),
+            "There should be a thread stopped due to breakpoint")
+        frame = thread.GetFrameAtIndex(0)
+
+        my_char = frame.FindValue("my_char", lldb.eValueTypeVariableGlobal)
+        my_cstring = frame.FindValue(
+            "my_cstring", lldb.eValueTypeVariableGlobal)
+        my_uint32 = frame.FindValue("my_uint32", lldb.eValueTypeVariableGlobal)
+
+        error = lldb.SBError()
+        data = process.ReadMemoryRanges(
+            [my_char.AddressOf().GetValueAsUnsigned(), 1,
+             my_cstring.AddressOf().GetValueAsUnsigned(), 4,
+             my_uint32.AddressOf().GetValueAsUnsigned(), 4], error)
+        self.assertTrue(error.Success(), error.GetCString())
+        self.assertEqual(data.GetByteSize(), 9)
+        self.assertEqual(data.GetUnsignedInt8(error, 0), ord('x'))
+        self.assertEqual(data.GetString(error, 1)[:4], 'lldb')
+        self.assertEqual(data.GetUnsignedInt32(error, 5), 12345)
+
+        # A range that cannot be read fails the whole request, but the other
+        # ranges are still read.
+        data = process.ReadMemoryRanges(
+            [my_char.AddressOf().GetValueAsUnsigned(), 1, 0, 4], error)
+        self.assertTrue(error.Fail())
+        self.assertEqual(data.GetByteSize(), 5)
+        self.assertEqual(data.GetUnsignedInt8(lldb.SBError(), 0), ord('x'))
+
     @add_test_categories(['pyapi'])
     def test_write_memory(self):
         """Test Python SBProcess.WriteMemory() API."""
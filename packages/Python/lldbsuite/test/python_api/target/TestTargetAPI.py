@@ -73,6 +73,46 @@ class TargetAPITestCase(TestBase):
         self.build()
         self.resolve_symbol_context_with_address()
 
+    @add_test_categories(['pyapi'])
+    def test_symbolicate_addresses(self):
+        """Exercise SBTarget.SymbolicateAddresses() API."""
+        self.build()
+        exe = self.getBuildArtifact("a.out")
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line1)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        load_addrs = []
+        for name in ['c', 'main', 'a', 'b']:
+            sc_list = target.FindFunctions(name, lldb.eFunctionNameTypeFull)
+            self.assertEqual(sc_list.GetSize(), 1)
+            start = sc_list[0].GetFunction().GetStartAddress()
+            load_addrs.append(start.GetLoadAddress(target) + 1)
+        # An address that doesn't resolve still gets an entry.
+        load_addrs.append(0)
+
+        sc_list = target.SymbolicateAddresses(
+            load_addrs, lldb.eSymbolContextEverything)
+        self.assertEqual(sc_list.GetSize(), len(load_addrs))
+        for i, load_addr in enumerate(load_addrs[:-1]):
+            expected = target.ResolveSymbolContextForAddress(
+                target.ResolveLoadAddress(load_addr),
+                lldb.eSymbolContextEverything)
+            self.assertEqual(sc_list[i].GetFunction().GetName(),
+                             expected.GetFunction().GetName())
+            self.assertEqual(sc_list[i].GetLineEntry().GetLine(),
+                             expected.GetLineEntry().GetLine())
+        self.assertEqual(
+            [sc.GetFunction().GetName() for sc in sc_list][:-1],
+            ['c', 'main', 'a', 'b'])
+        self.assertFalse(sc_list[len(load_addrs) - 1].GetModule())
+
     @add_test_categories(['pyapi'])
     def test_get_platform(self):
         d = {'EXE': 'b.out'}
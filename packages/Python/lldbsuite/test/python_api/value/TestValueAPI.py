@@ -75,6 +75,13 @@ class ValueAPITestCase(TestBase):
         first_day = days_of_week.child[1]
         self.assertEqual(first_day.GetSummary(), '"Monday"', VALID_VARIABLE)
 
+        # Fetch a window of children, which is clamped to the last child.
+        window = days_of_week.GetChildrenInRange(5, 10)
+        self.assertEqual(window.GetSize(), 2, VALID_VARIABLE)
+        self.assertEqual(window.GetValueAtIndex(0).GetSummary(), '"Friday"')
+        self.assertEqual(window.GetValueAtIndex(1).GetSummary(), '"Saturday"')
+        self.assertEqual(days_of_week.GetChildrenInRange(7, 1).GetSize(), 0)
+
         # Get global variable 'weekdays'.
         list = target.FindGlobalVariables('weekdays', 1)
         weekdays = list.GetValueAtIndex(0)
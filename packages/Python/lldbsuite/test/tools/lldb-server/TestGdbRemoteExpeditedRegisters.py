@@ -1,7 +1,10 @@
 from __future__ import print_function
 
 
+import re
+
 import gdbremote_testcase
+import lldbgdbserverutils
 from lldbsuite.test.decorators import *
 from lldbsuite.test.lldbtest import *
 from lldbsuite.test import lldbutil
@@ -13,7 +16,7 @@ class TestGdbRemoteExpeditedRegisters(
     mydir = TestBase.compute_mydir(__file__)
     @skipIfDarwinEmbedded # <rdar://problem/34539270> lldb-server tests not updated to work on ios etc yet
 
-    def gather_expedited_registers(self):
+    def gather_stop_key_vals_text(self):
         # Setup the stub and set the gdb remote command stream.
         procs = self.prep_debug_monitor_and_inferior(inferior_args=["sleep:2"])
         self.test_sequence.add_log_lines([
@@ -31,10 +34,13 @@ class TestGdbRemoteExpeditedRegisters(
         context = self.expect_gdbremote_sequence()
         self.assertIsNotNone(context)
 
-        # Pull out expedited registers.
         key_vals_text = context.get("key_vals_text")
         self.assertIsNotNone(key_vals_text)
+        return key_vals_text
 
+    def gather_expedited_registers(self):
+        # Pull out expedited registers.
+        key_vals_text = self.gather_stop_key_vals_text()
         expedited_registers = self.extract_registers_from_stop_notification(
             key_vals_text)
         self.assertIsNotNone(expedited_registers)
@@ -160,3 +166,30 @@ class TestGdbRemoteExpeditedRegisters(
         self.build()
         self.set_inferior_startup_launch()
         self.stop_notification_contains_sp_register()
+
+    def stop_notification_contains_stack_memory(self):
+        key_vals_text = self.gather_stop_key_vals_text()
+        expedited_registers = self.extract_registers_from_stop_notification(
+            key_vals_text)
+
+        reg_infos = self.gather_register_infos()
+        sp_info = self.find_generic_register_with_name(reg_infos, "sp")
+        self.assertIsNotNone(sp_info)
+        sp_index = sp_info["lldb_register_index"]
+        self.assertTrue(sp_index in expedited_registers)
+        sp = lldbgdbserverutils.unpack_register_hex_unsigned(
+            self.get_target_byte_order(), expedited_registers[sp_index])
+
+        # The memory at the stack pointer should have been expedited.
+        blocks = re.findall(r"memory:0x([0-9a-fA-F]+)=([0-9a-fA-F]+);",
+                            key_vals_text)
+        self.assertTrue(len(blocks) > 0)
+        self.assertTrue(any(int(addr, 16) <= sp < int(addr, 16) + len(data) // 2
+                            for (addr, data) in blocks))
+
+    @llgs_test
+    def test_stop_notification_contains_stack_memory_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        self.stop_notification_contains_stack_memory()
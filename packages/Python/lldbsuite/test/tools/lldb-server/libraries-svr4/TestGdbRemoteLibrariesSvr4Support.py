@@ -30,7 +30,7 @@ class TestGdbRemoteLibrariesSvr4Support(gdbremote_testcase.GdbRemoteTestCaseBase
         features = self.parse_qSupported_response(context)
         return self.FEATURE_NAME in features and features[self.FEATURE_NAME] == "+"
 
-    def get_libraries_svr4_data(self):
+    def get_libraries_svr4_data(self, annex=""):
         # Start up llgs and inferior, and check for libraries-svr4 support.
         if not self.has_libraries_svr4_support():
             self.skipTest("libraries-svr4 not supported")
@@ -39,7 +39,8 @@ class TestGdbRemoteLibrariesSvr4Support(gdbremote_testcase.GdbRemoteTestCaseBase
         self.reset_test_sequence()
         self.test_sequence.add_log_lines(
             [
-                "read packet: $qXfer:libraries-svr4:read::0,ffff:#00",
+                "read packet: $qXfer:libraries-svr4:read:{}:0,ffff:#00".format(
+                    annex),
                 {
                     "direction": "send",
                     "regex": re.compile(
@@ -62,8 +63,8 @@ class TestGdbRemoteLibrariesSvr4Support(gdbremote_testcase.GdbRemoteTestCaseBase
         self.assertIsNotNone(content_raw)
         return content_raw
 
-    def get_libraries_svr4_xml(self):
-        libraries_svr4 = self.get_libraries_svr4_data()
+    def get_libraries_svr4_xml(self, annex=""):
+        libraries_svr4 = self.get_libraries_svr4_data(annex)
         xml_root = None
         try:
             xml_root = ET.fromstring(libraries_svr4)
@@ -105,6 +106,25 @@ class TestGdbRemoteLibrariesSvr4Support(gdbremote_testcase.GdbRemoteTestCaseBase
         for lib in self.get_expected_libs():
             self.assertIn(self.getBuildDir() + "/" + lib, libraries_svr4_names)
 
+    def libraries_svr4_delta(self):
+        xml_root = self.get_libraries_svr4_xml()
+        generation = xml_root.attrib.get("generation")
+        self.assertIsNotNone(generation)
+        self.assertIsNone(xml_root.attrib.get("base-generation"))
+
+        # Nothing was loaded or unloaded since, so the delta is empty.
+        xml_root = self.get_libraries_svr4_xml(
+            "generation={:x}".format(int(generation, 16)))
+        self.assertEqual(xml_root.attrib.get("generation"), generation)
+        self.assertEqual(xml_root.attrib.get("base-generation"), generation)
+        self.assertEqual(len(list(xml_root)), 0)
+
+        # A generation we never sent gets the full list again.
+        xml_root = self.get_libraries_svr4_xml(
+            "generation={:x}".format(int(generation, 16) + 1))
+        self.assertIsNone(xml_root.attrib.get("base-generation"))
+        self.assertTrue(len(list(xml_root)) > 0)
+
     @llgs_test
     @skipUnlessPlatform(["linux", "android", "netbsd"])
     def test_supports_libraries_svr4(self):
@@ -128,3 +148,9 @@ class TestGdbRemoteLibrariesSvr4Support(gdbremote_testcase.GdbRemoteTestCaseBase
     def test_libraries_svr4_libs_present(self):
         self.setup_test()
         self.libraries_svr4_libs_present()
+
+    @llgs_test
+    @skipUnlessPlatform(["linux", "android", "netbsd"])
+    def test_libraries_svr4_delta(self):
+        self.setup_test()
+        self.libraries_svr4_delta()
@@ -109,7 +109,10 @@ class TestVSCode_variables(lldbvscode_testcase.VSCodeTestCaseBase):
                 'children': {
                     'x': {'equals': {'type': 'int', 'value': '11'}},
                     'y': {'equals': {'type': 'int', 'value': '22'}},
-                    'buffer': {'children': buffer_children}
+                    'buffer': {
+                        'equals': {'indexedVariables': 32},
+                        'children': buffer_children
+                    }
                 }
             }
         }
@@ -222,3 +225,49 @@ class TestVSCode_variables(lldbvscode_testcase.VSCodeTestCaseBase):
         value = response['body']['variables'][0]['value']
         self.assertTrue(value == '111',
                         'verify pt.x got set to 111 (111 != %s)' % (value))
+
+    @skipIfWindows
+    @skipIfDarwin # Skip this test for now until we can figure out why tings aren't working on build bots
+    @no_debug_info_test
+    def test_prefetch_frame_variables(self):
+        '''
+            Tests that the variables of the stopped frame are right when they
+            are resolved in the background as the process stops.
+        '''
+        program = self.getBuildArtifact("a.out")
+        self.build_and_launch(program, initCommands=[
+            'settings set target.process.prefetch-frame-variables true'])
+        source = 'main.cpp'
+        breakpoint_ids = self.set_source_breakpoints(
+            source, [line_number(source, '// breakpoint 1')])
+        self.continue_to_breakpoints(breakpoint_ids)
+        verify_locals = {
+            'argc': {
+                'equals': {'type': 'int', 'value': '1'}
+            },
+            'argv': {
+                'equals': {'type': 'const char **'},
+                'startswith': {'value': '0x'},
+                'hasVariablesReference': True
+            },
+            'pt': {
+                'equals': {'type': 'PointType'},
+                'hasVariablesReference': True,
+                'children': {
+                    'x': {'equals': {'type': 'int', 'value': '11'}},
+                    'y': {'equals': {'type': 'int', 'value': '22'}},
+                    'buffer': {
+                        'equals': {'indexedVariables': 32},
+                        'children': make_buffer_verify_dict(0, 32)
+                    }
+                }
+            }
+        }
+        self.verify_variables(verify_locals,
+                              self.vscode.get_local_variables())
+
+        # Values changed after the prefetch must show up.
+        self.set_local('argc', 123)
+        argc = self.get_local_as_int('argc')
+        self.assertTrue(argc == 123,
+                        'verify argc was set to 123 (123 != %i)' % (argc))
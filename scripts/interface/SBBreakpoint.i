@@ -174,6 +174,13 @@ public:
     const char *
     GetQueueName () const;
 
+    %feature("docstring", "
+    Call the native callback a plugin registered with
+    SBBreakpoint::RegisterCallback under the given name when the breakpoint
+    is hit.") SetRegisteredCallback;
+    SBError
+    SetRegisteredCallback (const char *callback_name);
+
     %feature("docstring", "
     Set the name of the script function to be called when the breakpoint is hit.") SetScriptCallbackFunction;
     void
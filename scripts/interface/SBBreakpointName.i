@@ -84,6 +84,8 @@ public:
 
   const char *GetQueueName() const;
 
+  SBError SetRegisteredCallback(const char *callback_name);
+
   void SetScriptCallbackFunction(const char *callback_function_name);
 
   void SetCommandLineCommands(SBStringList &commands);
@@ -85,6 +85,12 @@ public:
     bool
     GetDescription (lldb::SBStream &description);
 
+    %feature("docstring", "
+    Pass the output of commands to the callable while they run, a bounded
+    amount at a time, instead of keeping it for GetOutput().") SetImmediateOutputCallback;
+    void
+    SetImmediateOutputCallback (lldb::LogOutputCallback log_callback, void *baton);
+
 
     // wrapping here so that lldb takes ownership of the
     // new FILE* created inside of the swig interface
@@ -243,6 +243,12 @@ public:
     uint32_t
     GetNumTargets ();
 
+    %feature("docstring",
+    "Report the memory held by the string pool, by each module of the targets
+    of this debugger and by the targets themselves, in bytes.") GetMemoryUsage;
+    lldb::SBStructuredData
+    GetMemoryUsage ();
+
     lldb::SBTarget
     GetSelectedTarget ();
 
@@ -152,6 +152,17 @@ public:
     void
     SetAllowJIT(bool allow);
 
+    %feature("docstring", "Sets whether to collect the time each phase of evaluating expressions with these options takes.") SetCollectStatistics;
+    void
+    SetCollectStatistics(bool collect);
+
+    bool
+    GetCollectStatistics() const;
+
+    %feature("docstring", "Gets the time in seconds each phase of evaluating expressions with these options took, summed over the expressions evaluated since statistics were turned on.") GetStatistics;
+    lldb::SBStructuredData
+    GetStatistics() const;
+
 protected:
 
     SBExpressionOptions (lldb_private::EvaluateExpressionOptions &expression_options);
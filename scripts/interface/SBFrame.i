@@ -246,6 +246,21 @@ public:
     lldb::SBValue
     FindRegister (const char *name);
 
+    %feature("docstring", "
+    Read the first count arguments of the function this frame is stopped at
+    the entry of, taking each to be an integer or a pointer. Nothing is
+    looked up in the debug info, so this is meant for breakpoint callbacks
+    that trace many calls. Returns an lldb.SBData with one 64 bit value per
+    argument, or no data if the ABI doesn't support this.") GetIntegerArgumentValues;
+    lldb::SBData
+    GetIntegerArgumentValues (uint32_t count, lldb::SBError &error);
+
+    %feature("docstring", "
+    Read the value an integer or pointer returning function returned, with
+    this frame stopped right after the return.") GetIntegerReturnValue;
+    uint64_t
+    GetIntegerReturnValue (lldb::SBError &error);
+
     %feature("docstring", "
     Get a lldb.SBValue for a variable path.
 
@@ -273,6 +288,26 @@ public:
     lldb::SBValue
     GetValueForVariablePath (const char *var_path, lldb::DynamicValueType use_dynamic);
 
+    %feature("docstring", "
+    Get the values of a list of variable expression paths at once, as
+    GetValueForVariablePath() would for each of them. The locks are taken
+    once for the whole list, and the value and summary of each result are
+    computed before returning. The result has one value per path, in the
+    same order; a path that can't be evaluated gets a value whose GetError()
+    says why. Example:
+
+    paths = lldb.SBStringList()
+    for path in ['val', 'ch', 'my_val']:
+        paths.AppendString(path)
+    for value in frame.GetValuesForVariablePaths(paths):
+        print(value.GetValue())") GetValuesForVariablePaths;
+    lldb::SBValueList
+    GetValuesForVariablePaths (const lldb::SBStringList &var_paths);
+
+    lldb::SBValueList
+    GetValuesForVariablePaths (const lldb::SBStringList &var_paths,
+                               lldb::DynamicValueType use_dynamic);
+
     %feature("docstring", "
     Find variables, register sets, registers, or persistent variables using
     the frame as the scope.
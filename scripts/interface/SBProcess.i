@@ -308,6 +308,23 @@ public:
     lldb::addr_t
     ReadPointerFromMemory (addr_t addr, lldb::SBError &error);
 
+    %feature("autodoc", "
+    Reads several ranges of memory with as few requests to the target as
+    possible. The ranges are given as a flat list of start address and byte
+    size pairs. Returns an SBData with the memory of all ranges one after
+    another. Example:
+
+    # Read 8 bytes at 0x1000 and 4 bytes at 0x2000
+    error = lldb.SBError()
+    data = process.ReadMemoryRanges([0x1000, 8, 0x2000, 4], error)
+    if error.Success():
+        print('first: 0x%x' % data.GetUnsignedInt64(error, 0))
+    else
+        print('error: ', error)") ReadMemoryRanges;
+
+    lldb::SBData
+    ReadMemoryRanges (uint64_t* array, size_t array_len, lldb::SBError &error);
+
 
     // Events
     static lldb::StateType
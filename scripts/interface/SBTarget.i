@@ -538,6 +538,19 @@ public:
     ResolveSymbolContextForAddress (const SBAddress& addr,
                                     uint32_t resolve_scope);
 
+    %feature("autodoc", "
+    Resolve the symbol contexts of a list of load addresses at once. The
+    result has one symbol context per address, in the same order; addresses
+    that don't resolve get an empty symbol context. Example:
+
+    sc_list = target.SymbolicateAddresses([pc0, pc1, pc2],
+                                          lldb.eSymbolContextEverything)
+    for sc in sc_list:
+        print(sc.GetFunction().GetName())") SymbolicateAddresses;
+    lldb::SBSymbolContextList
+    SymbolicateAddresses (uint64_t* array, size_t array_len,
+                          uint32_t resolve_scope);
+
      %feature("docstring", "
     Read target memory. If a target process is running then memory
     is read from here. Otherwise the memory is read from the object
@@ -15,6 +15,9 @@ public:
                       size_t size, size_t offset,
                       lldb::tid_t thread_id);
 
+  size_t SaveTraceData(SBError &error, const char *path,
+                       lldb::tid_t thread_id);
+
   size_t GetMetaData(SBError &error, void *buf,
                      size_t size, size_t offset,
                      lldb::tid_t thread_id);
@@ -589,6 +589,45 @@ void SBBreakpoint ::SetCallback(SBBreakpointHitCallback callback, void *baton) {
   }
 }
 
+bool SBBreakpoint::RegisterCallback(const char *callback_name,
+                                    SBBreakpointHitCallback callback,
+                                    void *baton) {
+  LLDB_RECORD_DUMMY(bool, SBBreakpoint, RegisterCallback,
+                    (const char *, lldb::SBBreakpointHitCallback, void *),
+                    callback_name, callback, baton);
+
+  if (!callback_name || !callback_name[0])
+    return false;
+  SBBreakpointCallbackBaton::RegisterCallback(callback_name, callback, baton);
+  return true;
+}
+
+SBError SBBreakpoint::SetRegisteredCallback(const char *callback_name) {
+  LLDB_RECORD_METHOD(lldb::SBError, SBBreakpoint, SetRegisteredCallback,
+                     (const char *), callback_name);
+
+  SBError sb_error;
+  BreakpointSP bkpt_sp = GetSP();
+  if (!bkpt_sp) {
+    sb_error.SetErrorString("invalid breakpoint");
+    return LLDB_RECORD_RESULT(sb_error);
+  }
+
+  BatonSP baton_sp = SBBreakpointCallbackBaton::FindRegisteredCallback(
+      llvm::StringRef::withNullAsEmpty(callback_name));
+  if (!baton_sp) {
+    sb_error.SetErrorStringWithFormat("no callback is registered as '%s'",
+                                      callback_name ? callback_name : "");
+    return LLDB_RECORD_RESULT(sb_error);
+  }
+
+  std::lock_guard<std::recursive_mutex> guard(
+      bkpt_sp->GetTarget().GetAPIMutex());
+  bkpt_sp->SetCallback(SBBreakpointCallbackBaton::PrivateBreakpointHitCallback,
+                       baton_sp, false);
+  return LLDB_RECORD_RESULT(sb_error);
+}
+
 void SBBreakpoint::SetScriptCallbackFunction(
     const char *callback_function_name) {
   LLDB_RECORD_METHOD(void, SBBreakpoint, SetScriptCallbackFunction,
@@ -990,6 +1029,8 @@ void RegisterMethods<SBBreakpoint>(Registry &R) {
                        (lldb::SBStream &, bool));
   LLDB_REGISTER_METHOD(lldb::SBError, SBBreakpoint, AddLocation,
                        (lldb::SBAddress &));
+  LLDB_REGISTER_METHOD(lldb::SBError, SBBreakpoint, SetRegisteredCallback,
+                       (const char *));
   LLDB_REGISTER_METHOD(void, SBBreakpoint, SetScriptCallbackFunction,
                        (const char *));
   LLDB_REGISTER_METHOD(lldb::SBError, SBBreakpoint, SetScriptCallbackBody,
@@ -564,6 +564,33 @@ void SBBreakpointName::SetCallback(SBBreakpointHitCallback callback,
   UpdateName(*bp_name);
 }
 
+SBError SBBreakpointName::SetRegisteredCallback(const char *callback_name) {
+  LLDB_RECORD_METHOD(lldb::SBError, SBBreakpointName, SetRegisteredCallback,
+                     (const char *), callback_name);
+
+  SBError sb_error;
+  BreakpointName *bp_name = GetBreakpointName();
+  if (!bp_name) {
+    sb_error.SetErrorString("invalid breakpoint name");
+    return LLDB_RECORD_RESULT(sb_error);
+  }
+
+  BatonSP baton_sp = SBBreakpointCallbackBaton::FindRegisteredCallback(
+      llvm::StringRef::withNullAsEmpty(callback_name));
+  if (!baton_sp) {
+    sb_error.SetErrorStringWithFormat("no callback is registered as '%s'",
+                                      callback_name ? callback_name : "");
+    return LLDB_RECORD_RESULT(sb_error);
+  }
+
+  std::lock_guard<std::recursive_mutex> guard(
+        m_impl_up->GetTarget()->GetAPIMutex());
+  bp_name->GetOptions().SetCallback(
+      SBBreakpointCallbackBaton::PrivateBreakpointHitCallback, baton_sp, false);
+  UpdateName(*bp_name);
+  return LLDB_RECORD_RESULT(sb_error);
+}
+
 void SBBreakpointName::SetScriptCallbackFunction(
     const char *callback_function_name) {
   LLDB_RECORD_METHOD(void, SBBreakpointName, SetScriptCallbackFunction,
@@ -730,6 +757,8 @@ void RegisterMethods<SBBreakpointName>(Registry &R) {
                        (const char *));
   LLDB_REGISTER_METHOD(lldb::SBError, SBBreakpointName, SetScriptCallbackBody,
                        (const char *));
+  LLDB_REGISTER_METHOD(lldb::SBError, SBBreakpointName, SetRegisteredCallback,
+                       (const char *));
   LLDB_REGISTER_METHOD_CONST(bool, SBBreakpointName, GetAllowList, ());
   LLDB_REGISTER_METHOD(void, SBBreakpointName, SetAllowList, (bool));
   LLDB_REGISTER_METHOD(bool, SBBreakpointName, GetAllowDelete, ());
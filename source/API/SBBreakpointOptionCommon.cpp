@@ -34,6 +34,9 @@
 #include "SBBreakpointOptionCommon.h"
 
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringMap.h"
+
+#include <mutex>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -78,3 +81,30 @@ SBBreakpointCallbackBaton::SBBreakpointCallbackBaton(SBBreakpointHitCallback
 }
 
 SBBreakpointCallbackBaton::~SBBreakpointCallbackBaton() = default;
+
+// Registered callbacks are shared by all the debuggers, like the plugins
+// that register them.
+static std::mutex &GetRegisteredCallbacksMutex() {
+  static std::mutex g_mutex;
+  return g_mutex;
+}
+
+static llvm::StringMap<BatonSP> &GetRegisteredCallbacks() {
+  static llvm::StringMap<BatonSP> g_callbacks;
+  return g_callbacks;
+}
+
+void SBBreakpointCallbackBaton::RegisterCallback(
+    llvm::StringRef name, SBBreakpointHitCallback callback, void *baton) {
+  std::lock_guard<std::mutex> guard(GetRegisteredCallbacksMutex());
+  if (callback)
+    GetRegisteredCallbacks()[name] =
+        std::make_shared<SBBreakpointCallbackBaton>(callback, baton);
+  else
+    GetRegisteredCallbacks().erase(name);
+}
+
+BatonSP SBBreakpointCallbackBaton::FindRegisteredCallback(llvm::StringRef name) {
+  std::lock_guard<std::mutex> guard(GetRegisteredCallbacksMutex());
+  return GetRegisteredCallbacks().lookup(name);
+}
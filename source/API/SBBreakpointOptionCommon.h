@@ -11,6 +11,7 @@
 
 #include "lldb/API/SBDefines.h"
 #include "lldb/Utility/Baton.h"
+#include "llvm/ADT/StringRef.h"
 
 namespace lldb
 {
@@ -30,6 +31,15 @@ public:
                                            lldb_private::StoppointCallbackContext *ctx,
                                            lldb::user_id_t break_id,
                                            lldb::user_id_t break_loc_id);
+
+  /// Make \a callback available to breakpoints by \a name. A null
+  /// \a callback removes the name.
+  static void RegisterCallback(llvm::StringRef name,
+                               SBBreakpointHitCallback callback, void *baton);
+
+  /// The baton for the callback registered as \a name, or null if there is
+  /// none.
+  static lldb::BatonSP FindRegisteredCallback(llvm::StringRef name);
 };
 
 } // namespace lldb
@@ -282,6 +282,8 @@ lldb::ReturnStatus SBCommandInterpreter::HandleCommand(
     m_opaque_ptr->HandleCommand(command_line,
                                 add_to_history ? eLazyBoolYes : eLazyBoolNo,
                                 result.ref(), ctx_ptr);
+    if (StreamSP stream_sp = result.ref().GetImmediateOutputStream())
+      stream_sp->Flush();
   } else {
     result->AppendError(
         "SBCommandInterpreter or the command line is not valid");
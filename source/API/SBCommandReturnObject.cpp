@@ -18,6 +18,39 @@
 using namespace lldb;
 using namespace lldb_private;
 
+namespace {
+// Passes what is written to it on to a callback, in pieces of at most
+// kBufferSize bytes plus the last write.
+class CallbackStream : public Stream {
+public:
+  CallbackStream(LogOutputCallback callback, void *baton)
+      : m_callback(callback), m_baton(baton) {}
+
+  ~CallbackStream() override { Flush(); }
+
+  void Flush() override {
+    if (m_buffer.empty())
+      return;
+    m_callback(m_buffer.c_str(), m_baton);
+    m_buffer.clear();
+  }
+
+private:
+  static const size_t kBufferSize = 64 * 1024;
+
+  size_t WriteImpl(const void *s, size_t length) override {
+    m_buffer.append(static_cast<const char *>(s), length);
+    if (m_buffer.size() >= kBufferSize)
+      Flush();
+    return length;
+  }
+
+  LogOutputCallback m_callback;
+  void *m_baton;
+  std::string m_buffer;
+};
+} // namespace
+
 SBCommandReturnObject::SBCommandReturnObject()
     : m_opaque_up(new CommandReturnObject()) {
   LLDB_RECORD_CONSTRUCTOR_NO_ARGS(SBCommandReturnObject);
@@ -258,6 +291,23 @@ void SBCommandReturnObject::SetImmediateErrorFile(FILE *fh,
     m_opaque_up->SetImmediateErrorFile(fh, transfer_ownership);
 }
 
+void SBCommandReturnObject::SetImmediateOutputCallback(
+    lldb::LogOutputCallback callback, void *baton) {
+  LLDB_RECORD_DUMMY(void, SBCommandReturnObject, SetImmediateOutputCallback,
+                    (lldb::LogOutputCallback, void *), callback, baton);
+
+  if (!m_opaque_up)
+    return;
+  if (callback) {
+    m_opaque_up->SetImmediateOutputStream(
+        std::make_shared<CallbackStream>(callback, baton));
+    m_opaque_up->SetImmediateOnly(true);
+  } else {
+    m_opaque_up->SetImmediateOutputStream(StreamSP());
+    m_opaque_up->SetImmediateOnly(false);
+  }
+}
+
 void SBCommandReturnObject::PutCString(const char *string, int len) {
   LLDB_RECORD_METHOD(void, SBCommandReturnObject, PutCString,
                      (const char *, int), string, len);
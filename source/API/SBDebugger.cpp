@@ -812,8 +812,11 @@ bool SBDebugger::DeleteTarget(lldb::SBTarget &target) {
       result = m_opaque_sp->GetTargetList().DeleteTarget(target_sp);
       target_sp->Destroy();
       target.Clear();
-      const bool mandatory = true;
-      ModuleList::RemoveOrphanSharedModules(mandatory);
+      if (!ModuleList::GetGlobalModuleListProperties()
+               .GetKeepOrphanedModules()) {
+        const bool mandatory = true;
+        ModuleList::RemoveOrphanSharedModules(mandatory);
+      }
     }
   }
 
@@ -901,6 +904,16 @@ uint32_t SBDebugger::GetNumTargets() {
   return 0;
 }
 
+SBStructuredData SBDebugger::GetMemoryUsage() {
+  LLDB_RECORD_METHOD_NO_ARGS(lldb::SBStructuredData, SBDebugger,
+                             GetMemoryUsage);
+
+  SBStructuredData data;
+  if (m_opaque_sp)
+    data.m_impl_up->SetObjectSP(m_opaque_sp->ReportMemoryUsage());
+  return LLDB_RECORD_RESULT(data);
+}
+
 SBTarget SBDebugger::GetSelectedTarget() {
   LLDB_RECORD_METHOD_NO_ARGS(lldb::SBTarget, SBDebugger, GetSelectedTarget);
 
@@ -1652,6 +1665,8 @@ void RegisterMethods<SBDebugger>(Registry &R) {
   LLDB_REGISTER_METHOD(lldb::SBTarget, SBDebugger, FindTargetWithFileAndArch,
                        (const char *, const char *));
   LLDB_REGISTER_METHOD(uint32_t, SBDebugger, GetNumTargets, ());
+  LLDB_REGISTER_METHOD(lldb::SBStructuredData, SBDebugger, GetMemoryUsage,
+                       ());
   LLDB_REGISTER_METHOD(lldb::SBTarget, SBDebugger, GetSelectedTarget, ());
   LLDB_REGISTER_METHOD(void, SBDebugger, SetSelectedTarget,
                        (lldb::SBTarget &));
@@ -11,6 +11,8 @@
 #include "SBReproducerPrivate.h"
 #include "Utils.h"
 #include "lldb/API/SBStream.h"
+#include "lldb/API/SBStructuredData.h"
+#include "lldb/Core/StructuredDataImpl.h"
 #include "lldb/Target/Target.h"
 
 using namespace lldb;
@@ -285,6 +287,33 @@ void SBExpressionOptions::SetAllowJIT(bool allow) {
                                         : eExecutionPolicyNever);
 }
 
+void SBExpressionOptions::SetCollectStatistics(bool collect) {
+  LLDB_RECORD_METHOD(void, SBExpressionOptions, SetCollectStatistics, (bool),
+                     collect);
+
+  if (collect == GetCollectStatistics())
+    return;
+  m_opaque_up->SetStatistics(
+      collect ? std::make_shared<ExpressionStatistics>() : nullptr);
+}
+
+bool SBExpressionOptions::GetCollectStatistics() const {
+  LLDB_RECORD_METHOD_CONST_NO_ARGS(bool, SBExpressionOptions,
+                                   GetCollectStatistics);
+
+  return m_opaque_up->GetStatistics() != nullptr;
+}
+
+SBStructuredData SBExpressionOptions::GetStatistics() const {
+  LLDB_RECORD_METHOD_CONST_NO_ARGS(lldb::SBStructuredData, SBExpressionOptions,
+                                   GetStatistics);
+
+  SBStructuredData data;
+  if (ExpressionStatistics *stats = m_opaque_up->GetStatistics())
+    data.m_impl_up->SetObjectSP(stats->GetAsStructuredData());
+  return LLDB_RECORD_RESULT(data);
+}
+
 EvaluateExpressionOptions *SBExpressionOptions::get() const {
   return m_opaque_up.get();
 }
@@ -351,6 +380,12 @@ void RegisterMethods<SBExpressionOptions>(Registry &R) {
   LLDB_REGISTER_METHOD(void, SBExpressionOptions, SetTopLevel, (bool));
   LLDB_REGISTER_METHOD(bool, SBExpressionOptions, GetAllowJIT, ());
   LLDB_REGISTER_METHOD(void, SBExpressionOptions, SetAllowJIT, (bool));
+  LLDB_REGISTER_METHOD(void, SBExpressionOptions, SetCollectStatistics,
+                       (bool));
+  LLDB_REGISTER_METHOD_CONST(bool, SBExpressionOptions, GetCollectStatistics,
+                             ());
+  LLDB_REGISTER_METHOD_CONST(lldb::SBStructuredData, SBExpressionOptions,
+                             GetStatistics, ());
 }
 
 }
@@ -17,18 +17,23 @@
 #include "SBReproducerPrivate.h"
 #include "Utils.h"
 #include "lldb/Core/Address.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/StreamFile.h"
+#include "lldb/Core/ValueObjectConstResult.h"
 #include "lldb/Core/ValueObjectRegister.h"
 #include "lldb/Core/ValueObjectVariable.h"
+#include "lldb/DataFormatters/TypeSummary.h"
 #include "lldb/Expression/ExpressionVariable.h"
 #include "lldb/Expression/UserExpression.h"
 #include "lldb/Host/Host.h"
+#include "lldb/Interpreter/ScriptInterpreter.h"
 #include "lldb/Symbol/Block.h"
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Symbol/Variable.h"
 #include "lldb/Symbol/VariableList.h"
+#include "lldb/Target/ABI.h"
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/LanguageRuntime.h"
 #include "lldb/Target/Process.h"
@@ -39,12 +44,16 @@
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Utility/ConstString.h"
+#include "lldb/Utility/Endian.h"
 #include "lldb/Utility/Stream.h"
 
 #include "lldb/API/SBAddress.h"
+#include "lldb/API/SBData.h"
 #include "lldb/API/SBDebugger.h"
+#include "lldb/API/SBError.h"
 #include "lldb/API/SBExpressionOptions.h"
 #include "lldb/API/SBStream.h"
+#include "lldb/API/SBStringList.h"
 #include "lldb/API/SBSymbolContext.h"
 #include "lldb/API/SBThread.h"
 #include "lldb/API/SBValue.h"
@@ -497,6 +506,106 @@ lldb::SBValue SBFrame::GetValueForVariablePath(const char *var_path,
   return LLDB_RECORD_RESULT(sb_value);
 }
 
+lldb::SBValueList
+SBFrame::GetValuesForVariablePaths(const SBStringList &var_paths) {
+  LLDB_RECORD_METHOD(lldb::SBValueList, SBFrame, GetValuesForVariablePaths,
+                     (const lldb::SBStringList &), var_paths);
+
+  SBValueList value_list;
+  std::unique_lock<std::recursive_mutex> lock;
+  ExecutionContext exe_ctx(m_opaque_sp.get(), lock);
+
+  StackFrame *frame = exe_ctx.GetFramePtr();
+  Target *target = exe_ctx.GetTargetPtr();
+  if (frame && target) {
+    lldb::DynamicValueType use_dynamic = target->GetPreferDynamicValue();
+    value_list = GetValuesForVariablePaths(var_paths, use_dynamic);
+  }
+  return LLDB_RECORD_RESULT(value_list);
+}
+
+lldb::SBValueList
+SBFrame::GetValuesForVariablePaths(const SBStringList &var_paths,
+                                   DynamicValueType use_dynamic) {
+  LLDB_RECORD_METHOD(lldb::SBValueList, SBFrame, GetValuesForVariablePaths,
+                     (const lldb::SBStringList &, lldb::DynamicValueType),
+                     var_paths, use_dynamic);
+
+  SBValueList value_list;
+  std::unique_lock<std::recursive_mutex> lock;
+  ExecutionContext exe_ctx(m_opaque_sp.get(), lock);
+
+  Target *target = exe_ctx.GetTargetPtr();
+  Process *process = exe_ctx.GetProcessPtr();
+  if (!target || !process)
+    return LLDB_RECORD_RESULT(value_list);
+  Process::StopLocker stop_locker;
+  if (!stop_locker.TryLock(&process->GetRunLock()))
+    return LLDB_RECORD_RESULT(value_list);
+  StackFrame *frame = exe_ctx.GetFramePtr();
+  if (!frame)
+    return LLDB_RECORD_RESULT(value_list);
+
+  const bool use_synthetic =
+      target->TargetProperties::GetEnableSyntheticValue();
+  std::vector<ValueObjectSP> values;
+  for (uint32_t i = 0; i < var_paths.GetSize(); ++i) {
+    const char *var_path = var_paths.GetStringAtIndex(i);
+    VariableSP var_sp;
+    Status error;
+    ValueObjectSP value_sp;
+    if (var_path && var_path[0])
+      value_sp = frame->GetValueForVariableExpressionPath(
+          var_path, eNoDynamicValues,
+          StackFrame::eExpressionPathOptionCheckPtrVsMember |
+              StackFrame::eExpressionPathOptionsAllowDirectIVarAccess,
+          var_sp, error);
+    else
+      error.SetErrorString("empty variable path");
+    if (!value_sp) {
+      if (error.Success())
+        error.SetErrorStringWithFormat("no variable named '%s' found",
+                                       var_path);
+      value_sp = ValueObjectConstResult::Create(frame, error);
+    }
+
+    SBValue sb_value;
+    sb_value.SetSP(value_sp, use_dynamic, use_synthetic);
+    value_list.Append(sb_value);
+
+    // Find the value the SBValue shows, so that its value and summary can
+    // be computed now, while we hold the locks.
+    if (use_dynamic != eNoDynamicValues)
+      if (ValueObjectSP dynamic_sp = value_sp->GetDynamicValue(use_dynamic))
+        value_sp = dynamic_sp;
+    if (use_synthetic)
+      if (ValueObjectSP synthetic_sp = value_sp->GetSyntheticValue())
+        value_sp = synthetic_sp;
+    values.push_back(value_sp);
+  }
+
+  // Take the script interpreter lock once for all the values, rather than
+  // once for each of their summaries. The values themselves are computed one
+  // after the other: neither the value objects nor the type systems are
+  // safe to use from several threads.
+  std::unique_ptr<ScriptInterpreterLocker> script_lock;
+  bool has_script_summary =
+      llvm::any_of(values, [](const ValueObjectSP &value_sp) {
+        TypeSummaryImplSP summary_sp = value_sp->GetSummaryFormat();
+        return summary_sp &&
+               summary_sp->GetKind() == TypeSummaryImpl::Kind::eScript;
+      });
+  if (has_script_summary)
+    if (ScriptInterpreter *interpreter =
+            target->GetDebugger().GetScriptInterpreter(false))
+      script_lock = interpreter->AcquireInterpreterLock();
+  for (const ValueObjectSP &value_sp : values) {
+    value_sp->GetValueAsCString();
+    value_sp->GetSummaryAsCString();
+  }
+  return LLDB_RECORD_RESULT(value_list);
+}
+
 SBValue SBFrame::FindVariable(const char *name) {
   LLDB_RECORD_METHOD(lldb::SBValue, SBFrame, FindVariable, (const char *),
                      name);
@@ -976,6 +1085,86 @@ SBValue SBFrame::FindRegister(const char *name) {
   return LLDB_RECORD_RESULT(result);
 }
 
+/// Get the register context of the frame in \a exe_ctx and the ABI of its
+/// process, or set \a error.
+static RegisterContextSP GetRegisterContextAndABI(ExecutionContext &exe_ctx,
+                                                  ABISP &abi_sp,
+                                                  Status &error) {
+  Process *process = exe_ctx.GetProcessPtr();
+  StackFrame *frame = exe_ctx.GetFramePtr();
+  if (!process || !frame) {
+    error.SetErrorString("invalid frame");
+    return RegisterContextSP();
+  }
+  abi_sp = process->GetABI();
+  if (!abi_sp) {
+    error.SetErrorString("no ABI for the process");
+    return RegisterContextSP();
+  }
+  RegisterContextSP reg_ctx_sp = frame->GetRegisterContext();
+  if (!reg_ctx_sp)
+    error.SetErrorString("no register context for the frame");
+  return reg_ctx_sp;
+}
+
+SBData SBFrame::GetIntegerArgumentValues(uint32_t count, SBError &error) {
+  LLDB_RECORD_METHOD(lldb::SBData, SBFrame, GetIntegerArgumentValues,
+                     (uint32_t, lldb::SBError &), count, error);
+
+  SBData data;
+  std::unique_lock<std::recursive_mutex> lock;
+  ExecutionContext exe_ctx(m_opaque_sp.get(), lock);
+
+  Process *process = exe_ctx.GetProcessPtr();
+  Process::StopLocker stop_locker;
+  if (process && !stop_locker.TryLock(&process->GetRunLock())) {
+    error.SetErrorString("process is running");
+    return LLDB_RECORD_RESULT(data);
+  }
+
+  ABISP abi_sp;
+  RegisterContextSP reg_ctx_sp =
+      GetRegisterContextAndABI(exe_ctx, abi_sp, error.ref());
+  if (!reg_ctx_sp)
+    return LLDB_RECORD_RESULT(data);
+
+  std::vector<uint64_t> args(count);
+  if (!abi_sp->GetIntegerArgumentValues(*reg_ctx_sp, args)) {
+    error.SetErrorString("couldn't read the arguments");
+    return LLDB_RECORD_RESULT(data);
+  }
+  data = SBData::CreateDataFromUInt64Array(endian::InlHostByteOrder(),
+                                           process->GetAddressByteSize(),
+                                           args.data(), args.size());
+  return LLDB_RECORD_RESULT(data);
+}
+
+uint64_t SBFrame::GetIntegerReturnValue(SBError &error) {
+  LLDB_RECORD_METHOD(uint64_t, SBFrame, GetIntegerReturnValue,
+                     (lldb::SBError &), error);
+
+  std::unique_lock<std::recursive_mutex> lock;
+  ExecutionContext exe_ctx(m_opaque_sp.get(), lock);
+
+  Process *process = exe_ctx.GetProcessPtr();
+  Process::StopLocker stop_locker;
+  if (process && !stop_locker.TryLock(&process->GetRunLock())) {
+    error.SetErrorString("process is running");
+    return 0;
+  }
+
+  ABISP abi_sp;
+  RegisterContextSP reg_ctx_sp =
+      GetRegisterContextAndABI(exe_ctx, abi_sp, error.ref());
+  if (!reg_ctx_sp)
+    return 0;
+
+  uint64_t value = 0;
+  if (!abi_sp->GetIntegerReturnValue(*reg_ctx_sp, value))
+    error.SetErrorString("couldn't read the return value");
+  return value;
+}
+
 bool SBFrame::GetDescription(SBStream &description) {
   LLDB_RECORD_METHOD(bool, SBFrame, GetDescription, (lldb::SBStream &),
                      description);
@@ -1351,6 +1540,10 @@ void RegisterMethods<SBFrame>(Registry &R) {
                        (const char *));
   LLDB_REGISTER_METHOD(lldb::SBValue, SBFrame, GetValueForVariablePath,
                        (const char *, lldb::DynamicValueType));
+  LLDB_REGISTER_METHOD(lldb::SBValueList, SBFrame, GetValuesForVariablePaths,
+                       (const lldb::SBStringList &));
+  LLDB_REGISTER_METHOD(lldb::SBValueList, SBFrame, GetValuesForVariablePaths,
+                       (const lldb::SBStringList &, lldb::DynamicValueType));
   LLDB_REGISTER_METHOD(lldb::SBValue, SBFrame, FindVariable, (const char *));
   LLDB_REGISTER_METHOD(lldb::SBValue, SBFrame, FindVariable,
                        (const char *, lldb::DynamicValueType));
@@ -1374,6 +1567,10 @@ void RegisterMethods<SBFrame>(Registry &R) {
                        (const lldb::SBVariablesOptions &));
   LLDB_REGISTER_METHOD(lldb::SBValueList, SBFrame, GetRegisters, ());
   LLDB_REGISTER_METHOD(lldb::SBValue, SBFrame, FindRegister, (const char *));
+  LLDB_REGISTER_METHOD(lldb::SBData, SBFrame, GetIntegerArgumentValues,
+                       (uint32_t, lldb::SBError &));
+  LLDB_REGISTER_METHOD(uint64_t, SBFrame, GetIntegerReturnValue,
+                       (lldb::SBError &));
   LLDB_REGISTER_METHOD(bool, SBFrame, GetDescription, (lldb::SBStream &));
   LLDB_REGISTER_METHOD(lldb::SBValue, SBFrame, EvaluateExpression,
                        (const char *));
@@ -25,6 +25,8 @@
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Utility/Args.h"
+#include "lldb/Utility/DataBufferHeap.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/ProcessInfo.h"
 #include "lldb/Utility/State.h"
 #include "lldb/Utility/Stream.h"
@@ -32,6 +34,7 @@
 
 #include "lldb/API/SBBroadcaster.h"
 #include "lldb/API/SBCommandReturnObject.h"
+#include "lldb/API/SBData.h"
 #include "lldb/API/SBDebugger.h"
 #include "lldb/API/SBEvent.h"
 #include "lldb/API/SBFileSpec.h"
@@ -949,6 +952,53 @@ lldb::addr_t SBProcess::ReadPointerFromMemory(addr_t addr,
   return ptr;
 }
 
+lldb::SBData SBProcess::ReadMemoryRanges(uint64_t *array, size_t array_len,
+                                         lldb::SBError &sb_error) {
+  LLDB_RECORD_METHOD(lldb::SBData, SBProcess, ReadMemoryRanges,
+                     (uint64_t *, size_t, lldb::SBError &), array, array_len,
+                     sb_error);
+
+  lldb::SBData sb_data;
+  if (!array || array_len % 2 != 0) {
+    sb_error.SetErrorString("expected pairs of address and size");
+    return LLDB_RECORD_RESULT(sb_data);
+  }
+
+  std::vector<Process::MemoryRange> ranges;
+  size_t total_size = 0;
+  for (size_t i = 0; i < array_len; i += 2) {
+    ranges.emplace_back(array[i], array[i + 1]);
+    total_size += array[i + 1];
+  }
+
+  ProcessSP process_sp(GetSP());
+  if (process_sp) {
+    Process::StopLocker stop_locker;
+    if (stop_locker.TryLock(&process_sp->GetRunLock())) {
+      std::lock_guard<std::recursive_mutex> guard(
+          process_sp->GetTarget().GetAPIMutex());
+      DataBufferSP buffer_sp(new DataBufferHeap(total_size, 0));
+      std::vector<size_t> bytes_read =
+          process_sp->ReadMemoryRanges(ranges, buffer_sp->GetBytes());
+      for (size_t i = 0; i < ranges.size(); ++i) {
+        if (bytes_read[i] != ranges[i].GetByteSize()) {
+          sb_error.SetErrorStringWithFormat(
+              "memory read failed for 0x%" PRIx64, ranges[i].GetRangeBase());
+          break;
+        }
+      }
+      sb_data.SetOpaque(std::make_shared<DataExtractor>(
+          buffer_sp, process_sp->GetByteOrder(),
+          process_sp->GetAddressByteSize()));
+    } else {
+      sb_error.SetErrorString("process is running");
+    }
+  } else {
+    sb_error.SetErrorString("SBProcess is invalid");
+  }
+  return LLDB_RECORD_RESULT(sb_data);
+}
+
 size_t SBProcess::WriteMemory(addr_t addr, const void *src, size_t src_len,
                               SBError &sb_error) {
   LLDB_RECORD_DUMMY(size_t, SBProcess, WriteMemory,
@@ -1373,6 +1423,8 @@ void RegisterMethods<SBProcess>(Registry &R) {
                        (lldb::addr_t, uint32_t, lldb::SBError &));
   LLDB_REGISTER_METHOD(lldb::addr_t, SBProcess, ReadPointerFromMemory,
                        (lldb::addr_t, lldb::SBError &));
+  LLDB_REGISTER_METHOD(lldb::SBData, SBProcess, ReadMemoryRanges,
+                       (uint64_t *, size_t, lldb::SBError &));
   LLDB_REGISTER_METHOD(bool, SBProcess, GetDescription, (lldb::SBStream &));
   LLDB_REGISTER_METHOD_CONST(uint32_t, SBProcess,
                              GetNumSupportedHardwareWatchpoints,
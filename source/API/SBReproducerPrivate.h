@@ -14,6 +14,7 @@
 
 #include "lldb/Utility/FileSpec.h"
 #include "lldb/Utility/Log.h"
+#include "lldb/Utility/LogStreams.h"
 #include "lldb/Utility/Reproducer.h"
 #include "lldb/Utility/ReproducerInstrumentation.h"
 
@@ -37,20 +38,30 @@ public:
     static const char *file;
   };
 
+  /// The serializer flushes after every call it records. The stream buffers
+  /// the calls in memory and a background thread writes them to the file,
+  /// so recording never waits for the disk unless the buffer fills up.
   SBProvider(const FileSpec &directory)
       : Provider(directory),
-        m_stream(directory.CopyByAppendingPathComponent("sbapi.bin").GetPath(),
-                 m_ec, llvm::sys::fs::OpenFlags::OF_None),
-        m_serializer(m_stream) {}
+        m_stream(std::make_shared<llvm::raw_fd_ostream>(
+                     directory.CopyByAppendingPathComponent("sbapi.bin")
+                         .GetPath(),
+                     m_ec, llvm::sys::fs::OpenFlags::OF_None),
+                 /*buffer_size=*/1 << 20, /*drop_when_full=*/false),
+        m_serializer(m_stream) {
+    m_stream.SetBuffered();
+  }
 
   Serializer &GetSerializer() { return m_serializer; }
   Registry &GetRegistry() { return m_registry; }
 
+  void Keep() override { m_stream.Drain(); }
+
   static char ID;
 
 private:
   std::error_code m_ec;
-  llvm::raw_fd_ostream m_stream;
+  AsyncLogStream m_stream;
   Serializer m_serializer;
   SBRegistry m_registry;
 };
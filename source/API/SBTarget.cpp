@@ -221,16 +221,7 @@ SBStructuredData SBTarget::GetStatistics() {
   if (!target_sp)
     return LLDB_RECORD_RESULT(data);
 
-  auto stats_up = std::make_unique<StructuredData::Dictionary>();
-  int i = 0;
-  for (auto &Entry : target_sp->GetStatistics()) {
-    std::string Desc = lldb_private::GetStatDescription(
-        static_cast<lldb_private::StatisticKind>(i));
-    stats_up->AddIntegerItem(Desc, Entry);
-    i += 1;
-  }
-
-  data.m_impl_up->SetObjectSP(std::move(stats_up));
+  data.m_impl_up->SetObjectSP(target_sp->ReportStatistics());
   return LLDB_RECORD_RESULT(data);
 }
 
@@ -679,6 +670,32 @@ SBTarget::ResolveSymbolContextForAddress(const SBAddress &addr,
   return LLDB_RECORD_RESULT(sc);
 }
 
+lldb::SBSymbolContextList SBTarget::SymbolicateAddresses(
+    uint64_t *array, size_t array_len, uint32_t resolve_scope) {
+  LLDB_RECORD_METHOD(lldb::SBSymbolContextList, SBTarget,
+                     SymbolicateAddresses, (uint64_t *, size_t, uint32_t),
+                     array, array_len, resolve_scope);
+
+  lldb::SBSymbolContextList sb_sc_list;
+  TargetSP target_sp(GetSP());
+  if (!target_sp || !array)
+    return LLDB_RECORD_RESULT(sb_sc_list);
+
+  std::lock_guard<std::recursive_mutex> guard(target_sp->GetAPIMutex());
+  std::vector<Address> addrs(array_len);
+  for (size_t i = 0; i < array_len; ++i) {
+    if (!target_sp->ResolveLoadAddress(array[i], addrs[i]))
+      addrs[i].SetRawAddress(array[i]);
+  }
+
+  std::vector<SymbolContext> sc_list;
+  target_sp->GetImages().ResolveSymbolContextsForAddresses(
+      addrs, static_cast<SymbolContextItem>(resolve_scope), sc_list);
+  for (const SymbolContext &sc : sc_list)
+    sb_sc_list->Append(sc);
+  return LLDB_RECORD_RESULT(sb_sc_list);
+}
+
 size_t SBTarget::ReadMemory(const SBAddress addr, void *buf, size_t size,
                             lldb::SBError &error) {
   LLDB_RECORD_DUMMY(size_t, SBTarget, ReadMemory,
@@ -2512,6 +2529,8 @@ void RegisterMethods<SBTarget>(Registry &R) {
   LLDB_REGISTER_METHOD(lldb::SBSymbolContext, SBTarget,
                        ResolveSymbolContextForAddress,
                        (const lldb::SBAddress &, uint32_t));
+  LLDB_REGISTER_METHOD(lldb::SBSymbolContextList, SBTarget,
+                       SymbolicateAddresses, (uint64_t *, size_t, uint32_t));
   LLDB_REGISTER_METHOD(lldb::SBBreakpoint, SBTarget,
                        BreakpointCreateByLocation, (const char *, uint32_t));
   LLDB_REGISTER_METHOD(lldb::SBBreakpoint, SBTarget,
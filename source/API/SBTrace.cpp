@@ -7,12 +7,15 @@
 //===----------------------------------------------------------------------===//
 
 #include "SBReproducerPrivate.h"
+#include "lldb/Host/File.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Target/Process.h"
 
 #include "lldb/API/SBTrace.h"
 #include "lldb/API/SBTraceOptions.h"
 
 #include <memory>
+#include <vector>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -43,6 +46,57 @@ size_t SBTrace::GetTraceData(SBError &error, void *buf, size_t size,
   return buffer.size();
 }
 
+size_t SBTrace::SaveTraceData(SBError &error, const char *path,
+                              lldb::tid_t thread_id) {
+  LLDB_RECORD_METHOD(size_t, SBTrace, SaveTraceData,
+                     (lldb::SBError &, const char *, lldb::tid_t), error, path,
+                     thread_id);
+
+  ProcessSP process_sp(GetSP());
+  error.Clear();
+
+  if (!process_sp) {
+    error.SetErrorString("invalid process");
+    return 0;
+  }
+  if (!path) {
+    error.SetErrorString("invalid path");
+    return 0;
+  }
+
+  File file;
+  FileSpec file_spec(path);
+  FileSystem::Instance().Resolve(file_spec);
+  Status status = FileSystem::Instance().Open(
+      file, file_spec,
+      File::eOpenOptionWrite | File::eOpenOptionCanCreate |
+          File::eOpenOptionTruncate);
+  if (status.Fail()) {
+    error.SetError(status);
+    return 0;
+  }
+
+  // The buffer is reused for every piece, so only this much of the trace is
+  // ever held in memory.
+  std::vector<uint8_t> chunk(1024 * 1024);
+  size_t offset = 0;
+  while (true) {
+    llvm::MutableArrayRef<uint8_t> buffer(chunk);
+    status = process_sp->GetData(GetTraceUID(), thread_id, buffer, offset);
+    if (status.Fail() || buffer.empty())
+      break;
+    size_t num_bytes = buffer.size();
+    status = file.Write(buffer.data(), num_bytes);
+    if (status.Fail())
+      break;
+    offset += num_bytes;
+    if (buffer.size() < chunk.size())
+      break;
+  }
+  error.SetError(status);
+  return offset;
+}
+
 size_t SBTrace::GetMetaData(SBError &error, void *buf, size_t size,
                             size_t offset, lldb::tid_t thread_id) {
   LLDB_RECORD_DUMMY(size_t, SBTrace, GetMetaData,
@@ -133,6 +187,8 @@ namespace repro {
 
 template <>
 void RegisterMethods<SBTrace>(Registry &R) {
+  LLDB_REGISTER_METHOD(size_t, SBTrace, SaveTraceData,
+                       (lldb::SBError &, const char *, lldb::tid_t));
   LLDB_REGISTER_METHOD(void, SBTrace, StopTrace,
                        (lldb::SBError &, lldb::tid_t));
   LLDB_REGISTER_METHOD(void, SBTrace, GetTraceConfig,
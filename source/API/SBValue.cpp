@@ -45,6 +45,7 @@
 #include "lldb/API/SBProcess.h"
 #include "lldb/API/SBTarget.h"
 #include "lldb/API/SBThread.h"
+#include "lldb/API/SBValueList.h"
 
 #include <memory>
 
@@ -729,6 +730,33 @@ SBValue SBValue::GetChildAtIndex(uint32_t idx,
   return LLDB_RECORD_RESULT(sb_value);
 }
 
+SBValueList SBValue::GetChildrenInRange(uint32_t start, uint32_t count) {
+  LLDB_RECORD_METHOD(lldb::SBValueList, SBValue, GetChildrenInRange,
+                     (uint32_t, uint32_t), start, count);
+
+  SBValueList children;
+  lldb::DynamicValueType use_dynamic = eNoDynamicValues;
+  TargetSP target_sp;
+  if (m_opaque_sp)
+    target_sp = m_opaque_sp->GetTargetSP();
+  if (target_sp)
+    use_dynamic = target_sp->GetPreferDynamicValue();
+
+  ValueLocker locker;
+  lldb::ValueObjectSP value_sp(GetSP(locker));
+  if (value_sp) {
+    const bool can_create = true;
+    for (lldb::ValueObjectSP child_sp :
+         value_sp->GetChildrenInRange(start, count, can_create)) {
+      SBValue sb_value;
+      sb_value.SetSP(child_sp, use_dynamic, GetPreferSyntheticValue());
+      children.Append(sb_value);
+    }
+  }
+
+  return LLDB_RECORD_RESULT(children);
+}
+
 uint32_t SBValue::GetIndexOfChildWithName(const char *name) {
   LLDB_RECORD_METHOD(uint32_t, SBValue, GetIndexOfChildWithName, (const char *),
                      name);
@@ -1614,6 +1642,8 @@ void RegisterMethods<SBValue>(Registry &R) {
   LLDB_REGISTER_METHOD(lldb::SBValue, SBValue, GetChildAtIndex, (uint32_t));
   LLDB_REGISTER_METHOD(lldb::SBValue, SBValue, GetChildAtIndex,
                        (uint32_t, lldb::DynamicValueType, bool));
+  LLDB_REGISTER_METHOD(lldb::SBValueList, SBValue, GetChildrenInRange,
+                       (uint32_t, uint32_t));
   LLDB_REGISTER_METHOD(uint32_t, SBValue, GetIndexOfChildWithName,
                        (const char *));
   LLDB_REGISTER_METHOD(lldb::SBValue, SBValue, GetChildMemberWithName,
@@ -15,6 +15,7 @@
 #endif
 
 #include "lldb/Core/Debugger.h"
+#include "lldb/Core/PluginManager.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Initialization/SystemInitializerCommon.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
@@ -139,6 +140,15 @@ SystemInitializerFull::SystemInitializerFull() {}
 
 SystemInitializerFull::~SystemInitializerFull() {}
 
+static void InitializeLLVMTargets() {
+  llvm::InitializeAllTargetInfos();
+  llvm::InitializeAllTargets();
+  llvm::InitializeAllAsmPrinters();
+  llvm::InitializeAllTargetMCs();
+  llvm::InitializeAllAsmParsers();
+  llvm::InitializeAllDisassemblers();
+}
+
 static void SwiftInitialize() {
 #if defined(__APPLE__) || defined(__linux__) || defined(_WIN32)
   SwiftLanguage::Initialize();
@@ -190,11 +200,9 @@ llvm::Error SystemInitializerFull::Initialize() {
   PlatformDarwinKernel::Initialize();
 #endif
 
-  // Initialize LLVM and Clang
-  llvm::InitializeAllTargets();
-  llvm::InitializeAllAsmPrinters();
-  llvm::InitializeAllTargetMCs();
-  llvm::InitializeAllDisassemblers();
+  // Initialize LLVM and Clang. The LLVM targets are only registered once
+  // something needs them.
+  PluginManager::SetLLVMTargetsCallback(InitializeLLVMTargets);
 
   ClangASTContext::Initialize();
   SwiftASTContext::Initialize();
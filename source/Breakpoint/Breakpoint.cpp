@@ -6,6 +6,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Support/Casting.h"
 
 #include "lldb/Breakpoint/Breakpoint.h"
@@ -24,6 +25,7 @@
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/ThreadSpec.h"
 #include "lldb/Utility/Log.h"
@@ -290,10 +292,13 @@ void Breakpoint::SetEnabled(bool enable) {
     return;
 
   m_options_up->SetEnabled(enable);
-  if (enable)
-    m_locations.ResolveAllBreakpointSites();
-  else
-    m_locations.ClearAllBreakpointSites();
+  {
+    Process::BreakpointSiteBatch batch(GetTarget().GetProcessSP());
+    if (enable)
+      m_locations.ResolveAllBreakpointSites();
+    else
+      m_locations.ClearAllBreakpointSites();
+  }
 
   SendBreakpointChangedEvent(enable ? eBreakpointEventTypeEnabled
                                     : eBreakpointEventTypeDisabled);
@@ -306,6 +311,7 @@ void Breakpoint::SetIgnoreCount(uint32_t n) {
     return;
 
   m_options_up->SetIgnoreCount(n);
+  UpdateSiteConditions();
   SendBreakpointChangedEvent(eBreakpointEventTypeIgnoreChanged);
 }
 
@@ -411,9 +417,16 @@ const char *Breakpoint::GetQueueName() const {
 
 void Breakpoint::SetCondition(const char *condition) {
   m_options_up->SetCondition(condition);
+  UpdateSiteConditions();
   SendBreakpointChangedEvent(eBreakpointEventTypeConditionChanged);
 }
 
+void Breakpoint::UpdateSiteConditions() {
+  const size_t num_locations = m_locations.GetSize();
+  for (size_t i = 0; i < num_locations; ++i)
+    m_locations.GetByIndex(i)->UpdateSiteConditions();
+}
+
 const char *Breakpoint::GetConditionText() const {
   return m_options_up->GetConditionText();
 }
@@ -451,8 +464,10 @@ const BreakpointOptions *Breakpoint::GetOptions() const {
 }
 
 void Breakpoint::ResolveBreakpoint() {
-  if (m_resolver_sp)
+  if (m_resolver_sp) {
+    Process::BreakpointSiteBatch batch(GetTarget().GetProcessSP());
     m_resolver_sp->ResolveBreakpoint(*m_filter_sp);
+  }
 }
 
 void Breakpoint::ResolveBreakpointInModules(
@@ -467,6 +482,7 @@ void Breakpoint::ResolveBreakpointInModules(
 void Breakpoint::ResolveBreakpointInModules(ModuleList &module_list,
                                             bool send_event) {
   if (m_resolver_sp) {
+    Process::BreakpointSiteBatch batch(GetTarget().GetProcessSP());
     // If this is not an internal breakpoint, set up to record the new
     // locations, then dispatch an event with the new locations.
     if (!IsInternal() && send_event) {
@@ -488,6 +504,7 @@ void Breakpoint::ResolveBreakpointInModules(ModuleList &module_list,
 }
 
 void Breakpoint::ClearAllBreakpointSites() {
+  Process::BreakpointSiteBatch batch(GetTarget().GetProcessSP());
   m_locations.ClearAllBreakpointSites();
 }
 
@@ -502,27 +519,28 @@ void Breakpoint::ModulesChanged(ModuleList &module_list, bool load,
             module_list.GetSize(), load, delete_locations);
 
   std::lock_guard<std::recursive_mutex> guard(module_list.GetMutex());
+  Process::BreakpointSiteBatch batch(GetTarget().GetProcessSP());
   if (load) {
     // The logic for handling new modules is:
-    // 1) If the filter rejects this module, then skip it. 2) Run through the
-    // current location list and if there are any locations
-    //    for that module, we mark the module as "seen" and we don't try to
-    //    re-resolve
-    //    breakpoint locations for that module.
+    // 1) If the filter rejects this module, then skip it.
+    // 2) Run through the current location list and if there are any
+    //    locations for that module, we mark the module as "seen" and we don't
+    //    try to re-resolve breakpoint locations for that module.
     //    However, we do add breakpoint sites to these locations if needed.
     // 3) If we don't see this module in our breakpoint location list, call
-    // ResolveInModules.
-
-    ModuleList new_modules; // We'll stuff the "unseen" modules in this list,
-                            // and then resolve
-    // them after the locations pass.  Have to do it this way because resolving
-    // breakpoints will add new locations potentially.
+    //    ResolveInModules.
+    //
+    // The location list is walked once for all the modules, not once per
+    // module, so loading many libraries into a process with breakpoints that
+    // have many locations doesn't take quadratic time.
 
-    for (ModuleSP module_sp : module_list.ModulesNoLocking()) {
-      bool seen = false;
-      if (!m_filter_sp->ModulePasses(module_sp))
-        continue;
+    llvm::SmallPtrSet<Module *, 8> passing_modules;
+    for (ModuleSP module_sp : module_list.ModulesNoLocking())
+      if (m_filter_sp->ModulePasses(module_sp))
+        passing_modules.insert(module_sp.get());
 
+    llvm::SmallPtrSet<Module *, 8> seen_modules;
+    if (!passing_modules.empty()) {
       BreakpointLocationCollection locations_with_no_section;
       for (BreakpointLocationSP break_loc_sp :
            m_locations.BreakpointLocations()) {
@@ -535,36 +553,46 @@ void Breakpoint::ModulesChanged(ModuleList &module_list, bool load,
           locations_with_no_section.Add(break_loc_sp);
           continue;
         }
-          
+
         if (!break_loc_sp->IsEnabled())
           continue;
-        
-        SectionSP section_sp(section_addr.GetSection());
-        
+
         // If we don't have a Section, that means this location is a raw
         // address that we haven't resolved to a section yet.  So we'll have to
         // look in all the new modules to resolve this location. Otherwise, if
-        // it was set in this module, re-resolve it here.
-        if (section_sp && section_sp->GetModule() == module_sp) {
-          if (!seen)
-            seen = true;
-
-          if (!break_loc_sp->ResolveBreakpointSite()) {
-            LLDB_LOGF(log,
-                      "Warning: could not set breakpoint site for "
-                      "breakpoint location %d of breakpoint %d.\n",
-                      break_loc_sp->GetID(), GetID());
-          }
+        // it was set in one of the new modules, re-resolve it here.
+        SectionSP section_sp(section_addr.GetSection());
+        if (!section_sp)
+          continue;
+        ModuleSP loc_module_sp(section_sp->GetModule());
+        if (!passing_modules.count(loc_module_sp.get()))
+          continue;
+
+        seen_modules.insert(loc_module_sp.get());
+
+        if (!break_loc_sp->ResolveBreakpointSite()) {
+          LLDB_LOGF(log,
+                    "Warning: could not set breakpoint site for "
+                    "breakpoint location %d of breakpoint %d.\n",
+                    break_loc_sp->GetID(), GetID());
         }
       }
-      
+
       size_t num_to_delete = locations_with_no_section.GetSize();
-      
+
       for (size_t i = 0; i < num_to_delete; i++)
         m_locations.RemoveLocation(locations_with_no_section.GetByIndex(i));
+    }
 
-      if (!seen)
-        new_modules.AppendIfNeeded(module_sp);
+    // We'll stuff the "unseen" modules in this list, and then resolve them
+    // after the locations pass.  Have to do it this way because resolving
+    // breakpoints will add new locations potentially. Adding each module to
+    // seen_modules as it is appended also skips duplicates in module_list.
+    ModuleList new_modules;
+    for (ModuleSP module_sp : module_list.ModulesNoLocking()) {
+      if (passing_modules.count(module_sp.get()) &&
+          seen_modules.insert(module_sp.get()).second)
+        new_modules.Append(module_sp);
     }
 
     if (new_modules.GetSize() > 0) {
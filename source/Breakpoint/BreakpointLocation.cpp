@@ -218,9 +218,18 @@ void BreakpointLocation::ClearCallback() {
 
 void BreakpointLocation::SetCondition(const char *condition) {
   GetLocationOptions()->SetCondition(condition);
+  UpdateSiteConditions();
   SendBreakpointLocationChangedEvent(eBreakpointEventTypeConditionChanged);
 }
 
+void BreakpointLocation::UpdateSiteConditions() {
+  if (!m_bp_site_sp)
+    return;
+  ProcessSP process_sp = m_owner.GetTarget().GetProcessSP();
+  if (process_sp && process_sp->IsAlive())
+    process_sp->BreakpointSiteConditionsChanged(m_bp_site_sp.get());
+}
+
 const char *BreakpointLocation::GetConditionText(size_t *hash) const {
   return GetOptionsSpecifyingKind(BreakpointOptions::eCondition)
       ->GetConditionText(hash);
@@ -264,8 +273,12 @@ bool BreakpointLocation::ConditionSaysStop(ExecutionContext &exe_ctx,
       return true;
     }
 
+    // Only the truth value of the result is used, so don't keep it in the
+    // inferior. With eExecutionPolicyOnlyWhenNeeded, conditions that
+    // IRInterpreter can handle are evaluated in the debugger, with no call
+    // into the inferior.
     if (!m_user_expression_sp->Parse(diagnostics, exe_ctx,
-                                     eExecutionPolicyOnlyWhenNeeded, true,
+                                     eExecutionPolicyOnlyWhenNeeded, false,
                                      false)) {
       error.SetErrorStringWithFormat(
           "Couldn't parse conditional expression:\n%s",
@@ -340,6 +353,7 @@ uint32_t BreakpointLocation::GetIgnoreCount() {
 
 void BreakpointLocation::SetIgnoreCount(uint32_t n) {
   GetLocationOptions()->SetIgnoreCount(n);
+  UpdateSiteConditions();
   SendBreakpointLocationChangedEvent(eBreakpointEventTypeIgnoreChanged);
 }
 
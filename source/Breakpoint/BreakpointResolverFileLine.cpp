@@ -228,15 +228,32 @@ BreakpointResolverFileLine::SearchCallback(SearchFilter &filter,
   if (is_relative)
     search_file_spec.GetDirectory().Clear();
 
-  const size_t num_comp_units = context.module_sp->GetNumCompileUnits();
-  for (size_t i = 0; i < num_comp_units; i++) {
-    CompUnitSP cu_sp(context.module_sp->GetCompileUnitAtIndex(i));
+  auto resolve_in_comp_unit = [&](size_t cu_idx) {
+    CompUnitSP cu_sp(context.module_sp->GetCompileUnitAtIndex(cu_idx));
     if (cu_sp) {
       if (filter.CompUnitPasses(*cu_sp))
         cu_sp->ResolveSymbolContext(search_file_spec, m_line_number, m_inlines,
                                     m_exact_match, eSymbolContextEverything,
                                     sc_list);
     }
+  };
+
+  // When looking for inlined code, every compile unit whose support files
+  // mention the file has to be searched. Let the module's index of file
+  // basenames pick those out instead of matching the support files of every
+  // compile unit for each breakpoint. Otherwise only the compile unit's own
+  // file is compared, which is cheap enough to do for all of them.
+  if (m_inlines && search_file_spec.GetFilename() &&
+      search_file_spec.IsCaseSensitive()) {
+    std::vector<uint32_t> cu_indexes;
+    context.module_sp->FindCompileUnitsUsingFile(
+        search_file_spec.GetFilename(), cu_indexes);
+    for (uint32_t cu_idx : cu_indexes)
+      resolve_in_comp_unit(cu_idx);
+  } else {
+    const size_t num_comp_units = context.module_sp->GetNumCompileUnits();
+    for (size_t i = 0; i < num_comp_units; i++)
+      resolve_in_comp_unit(i);
   }
 
   FilterContexts(sc_list, is_relative);
@@ -22,6 +22,7 @@
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Interpreter/OptionValueProperties.h"
 #include "lldb/Symbol/CompileUnit.h"
+#include "lldb/Symbol/Symtab.h"
 #include "lldb/Symbol/Variable.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/Args.h"
@@ -413,32 +414,13 @@ void CommandCompletions::SourceFileCompleter::DoCompletion(
 
 // SymbolCompleter
 
-static bool regex_chars(const char comp) {
-  return (comp == '[' || comp == ']' || comp == '(' || comp == ')' ||
-          comp == '{' || comp == '}' || comp == '+' || comp == '.' ||
-          comp == '*' || comp == '|' || comp == '^' || comp == '$' ||
-          comp == '\\' || comp == '?');
-}
+// Completing a short prefix in a large program could otherwise produce more
+// names than anyone would read, and take as long to gather.
+static const size_t g_max_symbol_completions = 1000;
 
 CommandCompletions::SymbolCompleter::SymbolCompleter(
     CommandInterpreter &interpreter, CompletionRequest &request)
-    : CommandCompletions::Completer(interpreter, request) {
-  std::string regex_str;
-  if (!m_request.GetCursorArgumentPrefix().empty()) {
-    regex_str.append("^");
-    regex_str.append(m_request.GetCursorArgumentPrefix());
-  } else {
-    // Match anything since the completion string is empty
-    regex_str.append(".");
-  }
-  std::string::iterator pos =
-      find_if(regex_str.begin() + 1, regex_str.end(), regex_chars);
-  while (pos < regex_str.end()) {
-    pos = regex_str.insert(pos, '\\');
-    pos = find_if(pos + 2, regex_str.end(), regex_chars);
-  }
-  m_regex = RegularExpression(regex_str);
-}
+    : CommandCompletions::Completer(interpreter, request) {}
 
 lldb::SearchDepth CommandCompletions::SymbolCompleter::GetDepth() {
   return lldb::eSearchDepthModule;
@@ -448,26 +430,17 @@ Searcher::CallbackReturn CommandCompletions::SymbolCompleter::SearchCallback(
     SearchFilter &filter, SymbolContext &context, Address *addr,
     bool complete) {
   if (context.module_sp) {
-    SymbolContextList sc_list;
-    const bool include_symbols = true;
-    const bool include_inlines = true;
-    const bool append = true;
-    context.module_sp->FindFunctions(m_regex, include_symbols, include_inlines,
-                                     append, sc_list);
-
-    SymbolContext sc;
-    // Now add the functions & symbols to the list - only add if unique:
-    for (uint32_t i = 0; i < sc_list.GetSize(); i++) {
-      if (sc_list.GetContextAtIndex(i, sc)) {
-        ConstString func_name = sc.GetFunctionName(Mangled::ePreferDemangled);
-        // Ensure that the function name matches the regex. This is more than a
-        // sanity check. It is possible that the demangled function name does
-        // not start with the prefix, for example when it's in an anonymous
-        // namespace.
-        if (!func_name.IsEmpty() && m_regex.Execute(func_name.GetStringRef()))
-          m_match_set.insert(func_name);
-      }
+    // Look the names up in the symbol table's sorted function names, rather
+    // than resolving every matching function in the debug info.
+    if (Symtab *symtab = context.module_sp->GetSymtab()) {
+      std::vector<ConstString> names;
+      symtab->FindFunctionNamesWithPrefix(
+          m_request.GetCursorArgumentPrefix(),
+          g_max_symbol_completions - m_match_set.size(), names);
+      m_match_set.insert(names.begin(), names.end());
     }
+    if (m_match_set.size() >= g_max_symbol_completions)
+      return Searcher::eCallbackReturnStop;
   }
   return Searcher::eCallbackReturnContinue;
 }
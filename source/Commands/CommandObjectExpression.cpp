@@ -156,6 +156,10 @@ Status CommandObjectExpression::CommandOptions::SetOptionValue(
     top_level = true;
     break;
 
+  case 'M':
+    show_statistics = true;
+    break;
+
   case 'X': {
     bool success;
     bool tmp_value = OptionArgParser::ToBoolean(option_arg, true, &success);
@@ -196,6 +200,7 @@ void CommandObjectExpression::CommandOptions::OptionParsingStarting(
   auto_apply_fixits = eLazyBoolCalculate;
   top_level = false;
   allow_jit = true;
+  show_statistics = false;
 }
 
 llvm::ArrayRef<OptionDefinition>
@@ -428,6 +433,12 @@ bool CommandObjectExpression::EvaluateExpression(llvm::StringRef expr,
   else
     options.SetTimeout(llvm::None);
 
+  std::shared_ptr<ExpressionStatistics> stats_sp;
+  if (m_command_options.show_statistics) {
+    stats_sp = std::make_shared<ExpressionStatistics>();
+    options.SetStatistics(stats_sp);
+  }
+
   ExpressionResults success = target->EvaluateExpression(
       expr, frame, result_valobj_sp, options, &m_fixed_expression);
 
@@ -500,6 +511,9 @@ bool CommandObjectExpression::EvaluateExpression(llvm::StringRef expr,
     }
   }
 
+  if (stats_sp && output_stream)
+    stats_sp->Dump(*output_stream);
+
   return true;
 }
 
@@ -41,6 +41,7 @@ public:
     bool show_types;
     bool show_summary;
     bool debug;
+    bool show_statistics;
     uint32_t timeout;
     bool try_all_threads;
     lldb::LanguageType language;
@@ -23,6 +23,7 @@
 #include "lldb/Interpreter/OptionGroupValueObjectDisplay.h"
 #include "lldb/Interpreter/OptionGroupVariable.h"
 #include "lldb/Interpreter/Options.h"
+#include "lldb/Symbol/Block.h"
 #include "lldb/Symbol/CompilerType.h"
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/ObjectFile.h"
@@ -43,6 +44,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -391,6 +393,42 @@ protected:
 };
 
 #pragma mark CommandObjectFrameVariable
+
+// The variables of the blocks containing the frame's pc, outermost block
+// first like in StackFrame::GetVariableList(). The blocks the pc isn't in
+// don't get their variables parsed.
+static VariableListSP GetBlockVariablesInScope(StackFrame &frame,
+                                               bool get_file_globals) {
+  Block *frame_block = frame.GetFrameBlock();
+  if (!frame_block && !get_file_globals)
+    return VariableListSP();
+
+  std::vector<Block *> blocks;
+  Block *block = frame.GetSymbolContext(eSymbolContextBlock).block;
+  for (; frame_block && block; block = block->GetParent()) {
+    blocks.push_back(block);
+    if (block == frame_block)
+      break;
+  }
+
+  VariableListSP variables_sp = std::make_shared<VariableList>();
+  for (auto pos = blocks.rbegin(), end = blocks.rend(); pos != end; ++pos) {
+    VariableListSP block_variables_sp = (*pos)->GetBlockVariableList(true);
+    if (block_variables_sp)
+      variables_sp->AddVariables(block_variables_sp.get());
+  }
+
+  if (get_file_globals) {
+    const SymbolContext &sc = frame.GetSymbolContext(eSymbolContextCompUnit);
+    if (sc.comp_unit) {
+      VariableListSP globals_sp = sc.comp_unit->GetVariableList(true);
+      if (globals_sp)
+        variables_sp->AddVariables(globals_sp.get());
+    }
+  }
+  return variables_sp;
+}
+
 // List images with associated information
 class CommandObjectFrameVariable : public CommandObjectParsed {
 public:
@@ -490,8 +528,17 @@ protected:
     // might clear the StackFrameList for the thread.  So hold onto a shared
     // pointer to the frame so it stays alive.
 
-    VariableList *variable_list =
-        frame->GetVariableList(m_option_variable.show_globals);
+    // Without arguments only the variables in scope are shown, so only
+    // their blocks need to be parsed.
+    VariableListSP in_scope_variables_sp;
+    VariableList *variable_list = nullptr;
+    if (command.empty()) {
+      in_scope_variables_sp =
+          GetBlockVariablesInScope(*frame, m_option_variable.show_globals);
+      variable_list = in_scope_variables_sp.get();
+    } else {
+      variable_list = frame->GetVariableList(m_option_variable.show_globals);
+    }
 
     VariableSP var_sp;
     ValueObjectSP valobj_sp;
@@ -28,12 +28,18 @@
 #include "lldb/Utility/Stream.h"
 #include "lldb/Utility/Timer.h"
 
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
 using namespace lldb;
 using namespace lldb_private;
 
 #define LLDB_OPTIONS_log
 #include "CommandOptions.inc"
 
+#define LLDB_OPTIONS_log_dump
+#include "CommandOptions.inc"
+
 class CommandObjectLogEnable : public CommandObjectParsed {
 public:
   // Constructors and Destructors
@@ -112,6 +118,17 @@ public:
       case 'F':
         log_options |= LLDB_LOG_OPTION_PREPEND_FILE_FUNCTION;
         break;
+      case 'A':
+        log_options |= LLDB_LOG_OPTION_ASYNC;
+        break;
+      case 'c':
+        log_options |= LLDB_LOG_OPTION_CIRCULAR;
+        break;
+      case 'b':
+        if (option_arg.getAsInteger(0, buffer_size))
+          error.SetErrorStringWithFormat("invalid buffer size '%s'",
+                                         option_arg.str().c_str());
+        break;
       default:
         llvm_unreachable("Unimplemented option");
       }
@@ -122,6 +139,7 @@ public:
     void OptionParsingStarting(ExecutionContext *execution_context) override {
       log_file.Clear();
       log_options = 0;
+      buffer_size = 0;
     }
 
     llvm::ArrayRef<OptionDefinition> GetDefinitions() override {
@@ -132,6 +150,7 @@ public:
 
     FileSpec log_file;
     uint32_t log_options;
+    size_t buffer_size = 0;
   };
 
 protected:
@@ -157,7 +176,8 @@ protected:
     llvm::raw_string_ostream error_stream(error);
     bool success =
         GetDebugger().EnableLog(channel, args.GetArgumentArrayRef(), log_file,
-                                m_options.log_options, error_stream);
+                                m_options.log_options, error_stream,
+                                m_options.buffer_size);
     result.GetErrorStream() << error_stream.str();
 
     if (success)
@@ -229,6 +249,110 @@ protected:
   }
 };
 
+class CommandObjectLogDump : public CommandObjectParsed {
+public:
+  // Constructors and Destructors
+  CommandObjectLogDump(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "log dump",
+                            "Write what the circular log of a log channel "
+                            "holds.",
+                            nullptr),
+        m_options() {
+    CommandArgumentEntry arg;
+    CommandArgumentData channel_arg;
+
+    // Define the first (and only) variant of this arg.
+    channel_arg.arg_type = eArgTypeLogChannel;
+    channel_arg.arg_repetition = eArgRepeatPlain;
+
+    // There is only one variant this argument could be; put it into the
+    // argument entry.
+    arg.push_back(channel_arg);
+
+    // Push the data for the first argument into the m_arguments vector.
+    m_arguments.push_back(arg);
+  }
+
+  ~CommandObjectLogDump() override = default;
+
+  Options *GetOptions() override { return &m_options; }
+
+  class CommandOptions : public Options {
+  public:
+    CommandOptions() : Options(), log_file() {}
+
+    ~CommandOptions() override = default;
+
+    Status SetOptionValue(uint32_t option_idx, llvm::StringRef option_arg,
+                          ExecutionContext *execution_context) override {
+      Status error;
+      const int short_option = m_getopt_table[option_idx].val;
+
+      switch (short_option) {
+      case 'f':
+        log_file.SetFile(option_arg, FileSpec::Style::native);
+        FileSystem::Instance().Resolve(log_file);
+        break;
+      default:
+        llvm_unreachable("Unimplemented option");
+      }
+
+      return error;
+    }
+
+    void OptionParsingStarting(ExecutionContext *execution_context) override {
+      log_file.Clear();
+    }
+
+    llvm::ArrayRef<OptionDefinition> GetDefinitions() override {
+      return llvm::makeArrayRef(g_log_dump_options);
+    }
+
+    FileSpec log_file;
+  };
+
+protected:
+  bool DoExecute(Args &args, CommandReturnObject &result) override {
+    if (args.GetArgumentCount() != 1) {
+      result.AppendErrorWithFormat("%s takes a log channel.\n",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    std::string error;
+    llvm::raw_string_ostream error_stream(error);
+    bool success;
+    if (m_options.log_file) {
+      std::error_code ec;
+      llvm::raw_fd_ostream file_stream(m_options.log_file.GetPath(), ec,
+                                       llvm::sys::fs::OF_Text);
+      if (ec) {
+        result.AppendErrorWithFormatv("Could not open {0}: {1}.",
+                                      m_options.log_file.GetPath(),
+                                      ec.message());
+        result.SetStatus(eReturnStatusFailed);
+        return false;
+      }
+      success = GetDebugger().DumpLog(args[0].ref, file_stream, error_stream);
+    } else {
+      std::string output;
+      llvm::raw_string_ostream output_stream(output);
+      success = GetDebugger().DumpLog(args[0].ref, output_stream, error_stream);
+      result.GetOutputStream() << output_stream.str();
+    }
+    result.GetErrorStream() << error_stream.str();
+
+    if (success)
+      result.SetStatus(eReturnStatusSuccessFinishResult);
+    else
+      result.SetStatus(eReturnStatusFailed);
+    return result.Succeeded();
+  }
+
+  CommandOptions m_options;
+};
+
 class CommandObjectLogList : public CommandObjectParsed {
 public:
   // Constructors and Destructors
@@ -282,7 +406,8 @@ public:
                             "Enable, disable, dump, and reset LLDB internal "
                             "performance timers.",
                             "log timers < enable <depth> | disable | dump | "
-                            "increment <bool> | reset >") {}
+                            "increment <bool> | reset | trace <bool> | "
+                            "dump-trace <file> >") {}
 
   ~CommandObjectLogTimer() override = default;
 
@@ -328,6 +453,24 @@ protected:
           result.SetStatus(eReturnStatusSuccessFinishNoResult);
         } else
           result.AppendError("Could not convert increment value to boolean.");
+      } else if (sub_command.equals_lower("trace")) {
+        bool success;
+        bool record = OptionArgParser::ToBoolean(param, false, &success);
+        if (success) {
+          Timer::SetRecordTraceEvents(record);
+          result.SetStatus(eReturnStatusSuccessFinishNoResult);
+        } else
+          result.AppendError("Could not convert trace value to boolean.");
+      } else if (sub_command.equals_lower("dump-trace")) {
+        std::error_code ec;
+        llvm::raw_fd_ostream os(param, ec, llvm::sys::fs::OF_Text);
+        if (ec) {
+          result.AppendErrorWithFormatv("Could not open {0}: {1}.", param,
+                                        ec.message());
+        } else {
+          Timer::DumpTraceEvents(os);
+          result.SetStatus(eReturnStatusSuccessFinishNoResult);
+        }
       }
     }
 
@@ -349,6 +492,8 @@ CommandObjectLog::CommandObjectLog(CommandInterpreter &interpreter)
                  CommandObjectSP(new CommandObjectLogDisable(interpreter)));
   LoadSubCommand("list",
                  CommandObjectSP(new CommandObjectLogList(interpreter)));
+  LoadSubCommand("dump",
+                 CommandObjectSP(new CommandObjectLogDump(interpreter)));
   LoadSubCommand("timers",
                  CommandObjectSP(new CommandObjectLogTimer(interpreter)));
 }
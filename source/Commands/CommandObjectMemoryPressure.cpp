@@ -0,0 +1,42 @@
+//===-- CommandObjectMemoryPressure.cpp -------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "CommandObjectMemoryPressure.h"
+
+#include "lldb/Core/Debugger.h"
+#include "lldb/Interpreter/CommandInterpreter.h"
+#include "lldb/Interpreter/CommandReturnObject.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+// CommandObjectMemoryPressure
+
+CommandObjectMemoryPressure::CommandObjectMemoryPressure(
+    CommandInterpreter &interpreter)
+    : CommandObjectParsed(
+          interpreter, "memory-pressure",
+          "Free the caches of the debugger that are filled again when "
+          "needed: the memory read from processes, cached disassembly, "
+          "debug info files read ahead and the data formatter caches.",
+          "memory-pressure") {}
+
+CommandObjectMemoryPressure::~CommandObjectMemoryPressure() {}
+
+bool CommandObjectMemoryPressure::DoExecute(Args &args,
+                                            CommandReturnObject &result) {
+  if (args.GetArgumentCount() != 0) {
+    result.AppendError("the memory-pressure command takes no arguments.");
+    result.SetStatus(eReturnStatusFailed);
+    return false;
+  }
+
+  GetDebugger().ReleaseCaches();
+  result.SetStatus(eReturnStatusSuccessFinishNoResult);
+  return true;
+}
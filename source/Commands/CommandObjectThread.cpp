@@ -139,6 +139,9 @@ public:
       }
     }
 
+    if (tids.size() > 1)
+      WillHandleThreads(tids);
+
     if (m_unique_stacks) {
       // Iterate over threads, finding unique stack buckets.
       std::set<UniqueStack> unique_stacks;
@@ -196,6 +199,11 @@ protected:
 
   virtual bool HandleOneThread(lldb::tid_t, CommandReturnObject &result) = 0;
 
+  // Override this to prepare for handling several threads at once. It is
+  // called before the first HandleOneThread when there is more than one
+  // thread to handle.
+  virtual void WillHandleThreads(llvm::ArrayRef<lldb::tid_t> tids) {}
+
   bool BucketThread(lldb::tid_t tid, std::set<UniqueStack> &unique_stacks,
                     CommandReturnObject &result) {
     // Grab the corresponding thread for the given thread id.
@@ -347,6 +355,22 @@ protected:
     }
   }
 
+  void WillHandleThreads(llvm::ArrayRef<lldb::tid_t> tids) override {
+    Process *process = m_exe_ctx.GetProcessPtr();
+    std::vector<ThreadSP> threads;
+    for (lldb::tid_t tid : tids) {
+      if (ThreadSP thread_sp = process->GetThreadList().FindThreadByID(tid))
+        threads.push_back(thread_sp);
+    }
+
+    // Grouping the threads by unique stacks looks at all of their frames.
+    uint32_t num_frames = UINT32_MAX;
+    if (!m_unique_stacks && m_options.m_count != UINT32_MAX &&
+        m_options.m_start < UINT32_MAX - m_options.m_count)
+      num_frames = m_options.m_start + m_options.m_count;
+    process->PrefetchStackFrames(threads, num_frames);
+  }
+
   bool HandleOneThread(lldb::tid_t tid, CommandReturnObject &result) override {
     ThreadSP thread_sp =
         m_exe_ctx.GetProcessPtr()->GetThreadList().FindThreadByID(tid);
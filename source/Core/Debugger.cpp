@@ -10,6 +10,7 @@
 
 #include <map>
 #include <mutex>
+#include <set>
 
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/DynamicLibrary.h"
@@ -20,6 +21,7 @@
 #include "lldb/Breakpoint/Breakpoint.h"
 #include "lldb/Core/FormatEntity.h"
 #include "lldb/Core/Mangled.h"
+#include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleList.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/StreamAsynchronousIO.h"
@@ -54,6 +56,7 @@
 #include "lldb/Utility/Event.h"
 #include "lldb/Utility/Listener.h"
 #include "lldb/Utility/Log.h"
+#include "lldb/Utility/LogStreams.h"
 #include "lldb/Utility/Reproducer.h"
 #include "lldb/Utility/State.h"
 #include "lldb/Utility/Stream.h"
@@ -816,6 +819,72 @@ void Debugger::Clear() {
   });
 }
 
+StructuredData::DictionarySP Debugger::ReportMemoryUsage() {
+  auto usage_sp = std::make_shared<StructuredData::Dictionary>();
+  const uint64_t string_pool = ConstString::StaticMemorySize();
+  usage_sp->AddIntegerItem("stringPool", string_pool);
+  uint64_t total = string_pool;
+
+  // Targets can share modules, only report them once.
+  std::set<Module *> seen_modules;
+  auto modules_sp = std::make_shared<StructuredData::Array>();
+  auto targets_sp = std::make_shared<StructuredData::Array>();
+  for (int i = 0, num_targets = m_target_list.GetNumTargets(); i < num_targets;
+       ++i) {
+    TargetSP target_sp = m_target_list.GetTargetAtIndex(i);
+    if (!target_sp)
+      continue;
+    StructuredData::DictionarySP target_usage_sp =
+        target_sp->ReportMemoryUsage();
+    uint64_t target_total = 0;
+    target_usage_sp->GetValueForKeyAsInteger("total", target_total);
+    total += target_total;
+    targets_sp->AddItem(target_usage_sp);
+
+    const ModuleList &images = target_sp->GetImages();
+    std::lock_guard<std::recursive_mutex> guard(images.GetMutex());
+    for (size_t idx = 0, count = images.GetSize(); idx < count; ++idx) {
+      ModuleSP module_sp = images.GetModuleAtIndexUnlocked(idx);
+      if (!module_sp || !seen_modules.insert(module_sp.get()).second)
+        continue;
+      StructuredData::DictionarySP module_usage_sp =
+          module_sp->ReportMemoryUsage();
+      uint64_t module_total = 0;
+      module_usage_sp->GetValueForKeyAsInteger("total", module_total);
+      total += module_total;
+      module_usage_sp->AddStringItem("path",
+                                     module_sp->GetFileSpec().GetPath());
+      modules_sp->AddItem(module_usage_sp);
+    }
+  }
+  usage_sp->AddItem("modules", modules_sp);
+  usage_sp->AddItem("targets", targets_sp);
+  usage_sp->AddIntegerItem("total", total);
+  return usage_sp;
+}
+
+void Debugger::ReleaseCaches() {
+  std::set<Module *> seen_modules;
+  for (int i = 0, num_targets = m_target_list.GetNumTargets(); i < num_targets;
+       ++i) {
+    TargetSP target_sp = m_target_list.GetTargetAtIndex(i);
+    if (!target_sp)
+      continue;
+    if (ProcessSP process_sp = target_sp->GetProcessSP())
+      process_sp->ReleaseCaches();
+
+    const ModuleList &images = target_sp->GetImages();
+    std::lock_guard<std::recursive_mutex> guard(images.GetMutex());
+    for (size_t idx = 0, count = images.GetSize(); idx < count; ++idx) {
+      ModuleSP module_sp = images.GetModuleAtIndexUnlocked(idx);
+      if (module_sp && seen_modules.insert(module_sp.get()).second)
+        module_sp->ReleaseCaches();
+    }
+  }
+  // Formatters are looked up again, and cached again, on the next use.
+  DataVisualization::ForceUpdate();
+}
+
 bool Debugger::GetCloseInputOnEOF() const {
   //    return m_input_comm.GetCloseOnEOF();
   return false;
@@ -1237,12 +1306,23 @@ void Debugger::SetLoggingCallback(lldb::LogOutputCallback log_callback,
 bool Debugger::EnableLog(llvm::StringRef channel,
                          llvm::ArrayRef<const char *> categories,
                          llvm::StringRef log_file, uint32_t log_options,
-                         llvm::raw_ostream &error_stream) {
+                         llvm::raw_ostream &error_stream, size_t buffer_size) {
   const bool should_close = true;
   const bool unbuffered = true;
+  if (buffer_size == 0)
+    buffer_size = 1024 * 1024;
 
   std::shared_ptr<llvm::raw_ostream> log_stream_sp;
-  if (m_log_callback_stream_sp) {
+  if (log_options & LLDB_LOG_OPTION_CIRCULAR) {
+    if (!log_file.empty()) {
+      error_stream << "A circular log is kept in memory, use 'log dump' to "
+                      "write it to a file.";
+      return false;
+    }
+    auto circular_sp = std::make_shared<CircularLogStream>(buffer_size);
+    m_circular_log_streams[channel] = circular_sp;
+    log_stream_sp = circular_sp;
+  } else if (m_log_callback_stream_sp) {
     log_stream_sp = m_log_callback_stream_sp;
     // For now when using the callback mode you always get thread & timestamp.
     log_options |=
@@ -1271,14 +1351,34 @@ bool Debugger::EnableLog(llvm::StringRef channel,
   }
   assert(log_stream_sp);
 
-  if (log_options == 0)
-    log_options =
+  if (log_options & LLDB_LOG_OPTION_ASYNC)
+    log_stream_sp =
+        std::make_shared<AsyncLogStream>(log_stream_sp, buffer_size);
+
+  if ((log_options & ~(LLDB_LOG_OPTION_ASYNC | LLDB_LOG_OPTION_CIRCULAR)) == 0)
+    log_options |=
         LLDB_LOG_OPTION_PREPEND_THREAD_NAME | LLDB_LOG_OPTION_THREADSAFE;
 
   return Log::EnableLogChannel(log_stream_sp, log_options, channel, categories,
                                error_stream);
 }
 
+bool Debugger::DumpLog(llvm::StringRef channel,
+                       llvm::raw_ostream &output_stream,
+                       llvm::raw_ostream &error_stream) {
+  std::shared_ptr<CircularLogStream> circular_sp;
+  auto pos = m_circular_log_streams.find(channel);
+  if (pos != m_circular_log_streams.end())
+    circular_sp = pos->second.lock();
+  if (!circular_sp) {
+    error_stream << "No circular log is enabled for channel '" << channel
+                 << "'.";
+    return false;
+  }
+  circular_sp->Dump(output_stream);
+  return true;
+}
+
 ScriptInterpreter *Debugger::GetScriptInterpreter(bool can_create) {
   std::lock_guard<std::recursive_mutex> locker(m_script_interpreter_mutex);
 
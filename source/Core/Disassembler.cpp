@@ -17,6 +17,7 @@
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/SourceManager.h"
 #include "lldb/Host/FileSystem.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Interpreter/OptionValue.h"
 #include "lldb/Interpreter/OptionValueArray.h"
 #include "lldb/Interpreter/OptionValueDictionary.h"
@@ -26,6 +27,7 @@
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/Symtab.h"
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/StackFrame.h"
@@ -1159,6 +1161,98 @@ InstructionList::GetIndexOfInstructionAtLoadAddress(lldb::addr_t load_addr,
   return GetIndexOfInstructionAtAddress(address);
 }
 
+// Ranges smaller than this are decoded on the calling thread, as are the
+// pieces that larger ranges are split into.
+static const addr_t g_min_parallel_piece_size = 64 * 1024;
+
+// Split \a range into pieces of at least \a min_size bytes that start at
+// the symbols of its module, so that no instruction straddles two pieces.
+// Returns a single piece if the range isn't in a module with a symbol table.
+static std::vector<AddressRange> SplitAtSymbols(const AddressRange &range,
+                                                addr_t min_size) {
+  std::vector<AddressRange> pieces;
+  const Address &base = range.GetBaseAddress();
+  lldb::ModuleSP module_sp = base.GetModule();
+  lldb::SectionSP section_sp = base.GetSection();
+  Symtab *symtab = module_sp ? module_sp->GetSymtab() : nullptr;
+  if (!symtab || !section_sp) {
+    pieces.push_back(range);
+    return pieces;
+  }
+
+  const addr_t start = base.GetFileAddress();
+  const addr_t end = start + range.GetByteSize();
+  addr_t piece_start = start;
+  while (end - piece_start >= 2 * min_size) {
+    // Split at the symbol after the minimum size, or after the symbol that
+    // contains that address if it started before this piece.
+    const addr_t split_addr = piece_start + min_size;
+    addr_t split = LLDB_INVALID_ADDRESS;
+    if (Symbol *symbol = symtab->FindSymbolContainingFileAddress(split_addr)) {
+      split = symbol->GetFileAddress();
+      if (split <= piece_start)
+        split += symbol->GetByteSize();
+    }
+    if (split == LLDB_INVALID_ADDRESS || split <= piece_start || split >= end)
+      break;
+    pieces.emplace_back(section_sp, base.GetOffset() + (piece_start - start),
+                        split - piece_start);
+    piece_start = split;
+  }
+  pieces.emplace_back(section_sp, base.GetOffset() + (piece_start - start),
+                      end - piece_start);
+  return pieces;
+}
+
+size_t Disassembler::ParseInstructionsInParallel(
+    const ExecutionContext &exe_ctx, const std::vector<AddressRange> &pieces,
+    bool prefer_file_cache) {
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "Disassembler::ParseInstructionsInParallel");
+
+  // The LLVM disassemblers aren't thread safe, so every piece gets its own.
+  std::vector<lldb::DisassemblerSP> disassemblers(pieces.size());
+  const char *plugin_name = GetPluginName().GetCString();
+  for (lldb::DisassemblerSP &disasm_sp : disassemblers) {
+    disasm_sp = FindPlugin(m_arch, m_flavor.c_str(), plugin_name);
+    if (!disasm_sp)
+      return 0;
+  }
+
+  // Computing the operands and comments symbolicates the addresses the
+  // instructions refer to, which is the expensive part, so do it in the
+  // tasks too.
+  TaskMapOverInt(0, pieces.size(), [&](size_t i) {
+    Disassembler &disasm = *disassemblers[i];
+    disasm.ParseInstructions(&exe_ctx, pieces[i], nullptr, prefer_file_cache);
+    const InstructionList &list = disasm.GetInstructionList();
+    for (size_t j = 0, e = list.GetSize(); j < e; ++j)
+      list.GetInstructionAtIndex(j)->GetMnemonic(&exe_ctx);
+  });
+
+  m_instruction_list.Clear();
+  m_piece_disassemblers.clear();
+  for (lldb::DisassemblerSP &disasm_sp : disassemblers) {
+    const InstructionList &list = disasm_sp->GetInstructionList();
+    const size_t count = list.GetSize();
+    for (size_t j = 0; j < count; ++j) {
+      lldb::InstructionSP inst_sp = list.GetInstructionAtIndex(j);
+      m_instruction_list.Append(inst_sp);
+    }
+    // Stop at the first piece that couldn't be read, like a serial decode
+    // stops at the end of the readable bytes.
+    if (count == 0)
+      break;
+    m_piece_disassemblers.push_back(disasm_sp);
+  }
+
+  size_t bytes = 0;
+  for (size_t i = 0, e = m_instruction_list.GetSize(); i < e; ++i)
+    bytes += m_instruction_list.GetInstructionAtIndex(i)->GetOpcode()
+                 .GetByteSize();
+  return bytes;
+}
+
 size_t Disassembler::ParseInstructions(const ExecutionContext *exe_ctx,
                                        const AddressRange &range,
                                        Stream *error_strm_ptr,
@@ -1170,6 +1264,16 @@ size_t Disassembler::ParseInstructions(const ExecutionContext *exe_ctx,
         !range.GetBaseAddress().IsValid())
       return 0;
 
+    if (byte_size >= 2 * g_min_parallel_piece_size) {
+      std::vector<AddressRange> pieces =
+          SplitAtSymbols(range, g_min_parallel_piece_size);
+      if (pieces.size() > 1) {
+        if (size_t bytes = ParseInstructionsInParallel(*exe_ctx, pieces,
+                                                       prefer_file_cache))
+          return bytes;
+      }
+    }
+
     auto data_sp = std::make_shared<DataBufferHeap>(byte_size, '\0');
 
     Status error;
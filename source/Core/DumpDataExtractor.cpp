@@ -32,6 +32,7 @@
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SmallVector.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <string>
@@ -129,6 +130,99 @@ static lldb::offset_t DumpAPInt(Stream *s, const DataExtractor &data,
   return offset;
 }
 
+/// Whether DumpLinesFast can dump these items. It handles the formats of
+/// "memory read" that large dumps use, as long as all of the items are in
+/// the data.
+static bool CanDumpLinesFast(const DataExtractor &DE, offset_t start_offset,
+                             lldb::Format item_format, size_t item_byte_size,
+                             size_t item_count, size_t num_per_line,
+                             uint32_t item_bit_size, uint32_t item_bit_offset) {
+  if (item_bit_size != 0 || item_bit_offset != 0 || num_per_line == 0 ||
+      num_per_line > 4096)
+    return false;
+  switch (item_format) {
+  case eFormatBytes:
+  case eFormatBytesWithASCII:
+    if (item_byte_size != 1)
+      return false;
+    break;
+  case eFormatHex:
+  case eFormatHexUppercase:
+    if (item_byte_size != 1 && item_byte_size != 2 && item_byte_size != 4 &&
+        item_byte_size != 8)
+      return false;
+    break;
+  default:
+    return false;
+  }
+  return item_count <= DE.BytesLeft(start_offset) / item_byte_size;
+}
+
+/// Dump the items the way the loop in DumpDataExtractor does, formatting a
+/// line at a time with lookup tables instead of a Printf per item, and
+/// writing the lines to the stream in large blocks.
+static lldb::offset_t DumpLinesFast(const DataExtractor &DE, Stream *s,
+                                    offset_t start_offset,
+                                    lldb::Format item_format,
+                                    size_t item_byte_size, size_t item_count,
+                                    size_t num_per_line, uint64_t base_addr) {
+  static const char g_hex_digits[] = "0123456789abcdef";
+  static const char g_hex_digits_upper[] = "0123456789ABCDEF";
+  const size_t buffer_size = 64 * 1024;
+
+  const bool with_ascii = item_format == eFormatBytesWithASCII;
+  const bool bytes = with_ascii || item_format == eFormatBytes;
+  const char *digits =
+      item_format == eFormatHexUppercase ? g_hex_digits_upper : g_hex_digits;
+  const uint8_t *data = DE.GetDataStart();
+
+  std::string buffer;
+  buffer.reserve(buffer_size + num_per_line * (item_byte_size * 2 + 6) + 64);
+  offset_t offset = start_offset;
+  for (size_t count = 0; count < item_count; count += num_per_line) {
+    if (count > 0)
+      buffer.push_back('\n');
+    if (base_addr != LLDB_INVALID_ADDRESS) {
+      char addr[32];
+      int len = snprintf(addr, sizeof(addr), "0x%8.8" PRIx64 ": ",
+                         (uint64_t)(base_addr + (offset - start_offset) /
+                                                    DE.getTargetByteSize()));
+      buffer.append(addr, len);
+    }
+
+    const size_t line_count = std::min(num_per_line, item_count - count);
+    const offset_t line_start_offset = offset;
+    for (size_t i = 0; i < line_count; ++i) {
+      if (i > 0)
+        buffer.push_back(' ');
+      if (bytes) {
+        const uint8_t byte = data[offset++];
+        buffer.push_back(g_hex_digits[byte >> 4]);
+        buffer.push_back(g_hex_digits[byte & 0xf]);
+        continue;
+      }
+      const uint64_t value = DE.GetMaxU64(&offset, item_byte_size);
+      buffer.push_back('0');
+      buffer.push_back('x');
+      for (int shift = item_byte_size * 8 - 4; shift >= 0; shift -= 4)
+        buffer.push_back(digits[(value >> shift) & 0xf]);
+    }
+
+    if (with_ascii) {
+      buffer.append((num_per_line - line_count) * 3 + 2, ' ');
+      for (offset_t i = line_start_offset; i < offset; ++i)
+        buffer.push_back(isprint(data[i]) ? data[i] : NON_PRINTABLE_CHAR);
+    }
+
+    if (buffer.size() >= buffer_size) {
+      s->Write(buffer.data(), buffer.size());
+      buffer.clear();
+    }
+  }
+  s->Write(buffer.data(), buffer.size());
+  return offset;
+}
+
 lldb::offset_t lldb_private::DumpDataExtractor(
     const DataExtractor &DE, Stream *s, offset_t start_offset,
     lldb::Format item_format, size_t item_byte_size, size_t item_count,
@@ -191,6 +285,12 @@ lldb::offset_t lldb_private::DumpDataExtractor(
       item_byte_size > 8)
     item_format = eFormatHex;
 
+  if (CanDumpLinesFast(DE, start_offset, item_format, item_byte_size,
+                       item_count, num_per_line, item_bit_size,
+                       item_bit_offset))
+    return DumpLinesFast(DE, s, start_offset, item_format, item_byte_size,
+                         item_count, num_per_line, base_addr);
+
   lldb::offset_t line_start_offset = start_offset;
   for (uint32_t count = 0; DE.ValidOffset(offset) && count < item_count;
        ++count) {
@@ -15,6 +15,7 @@
 #include "lldb/Core/Section.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Target/MemoryRegionInfo.h"
+#include "lldb/Target/Platform.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/ConstString.h"
@@ -106,6 +107,27 @@ ModuleSP DynamicLoader::GetTargetExecutable() {
   return executable;
 }
 
+void DynamicLoader::PreloadModules(llvm::ArrayRef<ModuleSpec> module_specs) {
+  Target &target = m_process->GetTarget();
+  PlatformSP platform_sp = target.GetPlatform();
+  const bool is_host = platform_sp && platform_sp->IsHost();
+  std::vector<ModuleSpec> to_fetch;
+  std::vector<ModuleSpec> to_preload;
+  for (const ModuleSpec &module_spec : module_specs) {
+    if (target.GetImages().FindFirstModule(module_spec))
+      continue;
+    to_fetch.push_back(module_spec);
+    // Without a UUID, a remote platform may resolve the path to a different
+    // file than the local one.
+    if (is_host || module_spec.GetUUID().IsValid())
+      to_preload.push_back(module_spec);
+  }
+  // Remote modules have to be downloaded into the module cache first.
+  if (platform_sp && !is_host)
+    platform_sp->PrefetchSharedModules(m_process, to_fetch);
+  ModuleList::PreloadSharedModules(to_preload);
+}
+
 void DynamicLoader::UpdateLoadedSections(ModuleSP module, addr_t link_map_addr,
                                          addr_t base_addr,
                                          bool base_addr_is_offset) {
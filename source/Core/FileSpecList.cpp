@@ -66,7 +66,16 @@ size_t FileSpecList::FindFileIndex(size_t start_idx, const FileSpec &file_spec,
   // argument is empty
   bool compare_filename_only = file_spec.GetDirectory().IsEmpty();
 
+  // Directories and filenames are interned, so when neither side ignores case
+  // a pointer comparison of the filenames rejects most entries without
+  // looking at their strings.
+  const ConstString filename = file_spec.GetFilename();
+  const bool case_sensitive = file_spec.IsCaseSensitive();
+
   for (size_t idx = start_idx; idx < num_files; ++idx) {
+    if (case_sensitive && m_files[idx].IsCaseSensitive() &&
+        m_files[idx].GetFilename() != filename)
+      continue;
     if (compare_filename_only) {
       if (ConstString::Equals(
               m_files[idx].GetFilename(), file_spec.GetFilename(),
@@ -153,9 +153,23 @@ get_demangled_name_without_arguments(ConstString mangled,
 // DenseMapInfo for pointers
 static ThreadSafeDenseMap<const char *, ConstString> *
 GetDisplayDemangledNamesCache() {
-  ThreadSafeDenseMap<const char *, ConstString> *g_cache;
-  std::once_flag g_flag;
-  std::call_once(g_flag, [&g_cache]() -> void {
+  static ThreadSafeDenseMap<const char *, ConstString> *g_cache;
+  static std::once_flag g_flag;
+  std::call_once(g_flag, []() -> void {
+    g_cache = new ThreadSafeDenseMap<const char *, ConstString>();
+  });
+  return g_cache;
+}
+
+// Swift names demangled without a symbol context. These can't be stored as
+// the mangled name's counterpart, as demangling with a symbol context may
+// give a different result, but they only depend on the mangled name, so they
+// are shared by all modules.
+static ThreadSafeDenseMap<const char *, ConstString> *
+GetSwiftDemangledNamesCache() {
+  static ThreadSafeDenseMap<const char *, ConstString> *g_cache;
+  static std::once_flag g_flag;
+  std::call_once(g_flag, []() -> void {
     g_cache = new ThreadSafeDenseMap<const char *, ConstString>();
   });
   return g_cache;
@@ -335,11 +349,15 @@ bool Mangled::DemangleWithRichManglingInfo(
     // We want the rich mangling info here, so we don't care whether or not
     // there is a demangled string in the pool already.
     if (context.FromItaniumName(m_mangled)) {
-      // If we got an info, we have a name. Copy to string pool and connect the
-      // counterparts to accelerate later access in GetDemangledName().
-      context.ParseFullName();
-      m_demangled.SetStringWithMangledCounterpart(context.GetBufferRef(),
-                                                  m_mangled);
+      // If we got an info, we have a name. Unless another module has the same
+      // symbol, copy it to the string pool and connect the counterparts to
+      // accelerate later access in GetDemangledName(). The partial demangler
+      // only has to produce the base name and context otherwise.
+      if (!m_mangled.GetMangledCounterpart(m_demangled)) {
+        context.ParseFullName();
+        m_demangled.SetStringWithMangledCounterpart(context.GetBufferRef(),
+                                                    m_mangled);
+      }
       return true;
     } else {
       m_demangled.SetCString("");
@@ -416,14 +434,21 @@ ConstString Mangled::GetDemangledName(lldb::LanguageType language,
     } else if (mangling_scheme == eManglingSchemeNone &&
                !m_mangled.GetMangledCounterpart(m_demangled) &&
                SwiftLanguageRuntime::IsSwiftMangledName(mangled_name)) {
+      ConstString cached;
+      if (!sc && GetSwiftDemangledNamesCache()->Lookup(mangled_name, cached))
+        return cached;
       Log *log = lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_DEMANGLE);
       if (log)
         log->Printf("demangle swift: %s", mangled_name);
       std::string demangled(SwiftLanguageRuntime::DemangleSymbolAsString(
           mangled_name, false, sc));
       // Don't cache the demangled name the function isn't available yet.
-      if (!sc || !sc->function)
-        return ConstString(demangled);
+      if (!sc || !sc->function) {
+        ConstString result(demangled);
+        if (!sc)
+          GetSwiftDemangledNamesCache()->Insert(mangled_name, result);
+        return result;
+      }
       if (!demangled.empty()) {
         m_demangled.SetStringWithMangledCounterpart(demangled,
 						    m_mangled);
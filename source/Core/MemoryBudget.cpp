@@ -0,0 +1,77 @@
+//===-- MemoryBudget.cpp ----------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/MemoryBudget.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Utility/Log.h"
+#include "lldb/Utility/Logging.h"
+
+#include "llvm/ADT/STLExtras.h"
+
+#include <algorithm>
+
+using namespace lldb_private;
+
+void EvictableCache::MarkUsed() {
+  m_last_use = ++MemoryBudget::Instance().m_use_clock;
+}
+
+void EvictableCache::MarkResident(size_t size) {
+  m_resident_size = size;
+  MarkUsed();
+  MemoryBudget::Instance().Enforce(this);
+}
+
+MemoryBudget &MemoryBudget::Instance() {
+  // Leaked so that module destructors running at exit can still remove their
+  // caches.
+  static MemoryBudget *g_memory_budget = new MemoryBudget();
+  return *g_memory_budget;
+}
+
+void MemoryBudget::Add(EvictableCache &cache) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_caches.push_back(&cache);
+}
+
+void MemoryBudget::Remove(EvictableCache &cache) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  llvm::erase_if(m_caches, [&](EvictableCache *c) { return c == &cache; });
+}
+
+void MemoryBudget::Enforce(EvictableCache *keep) {
+  const uint64_t budget =
+      ModuleList::GetGlobalModuleListProperties().GetMemoryBudget();
+  if (budget == 0)
+    return;
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  uint64_t total = 0;
+  for (EvictableCache *cache : m_caches)
+    total += cache->m_resident_size;
+  if (total <= budget)
+    return;
+
+  std::vector<EvictableCache *> lru(m_caches);
+  std::sort(lru.begin(), lru.end(),
+            [](EvictableCache *lhs, EvictableCache *rhs) {
+              return lhs->m_last_use < rhs->m_last_use;
+            });
+  Log *log = lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_MODULES);
+  for (EvictableCache *cache : lru) {
+    if (total <= budget)
+      break;
+    const size_t size = cache->m_resident_size;
+    if (cache == keep || size == 0 || !cache->TryEvict())
+      continue;
+    cache->m_resident_size = 0;
+    total -= size;
+    LLDB_LOG(log, "evicted {0} bytes of symbol data, {1} bytes remain", size,
+             total);
+  }
+}
@@ -11,6 +11,7 @@
 #include "lldb/Core/AddressRange.h"
 #include "lldb/Core/AddressResolverFileLine.h"
 #include "lldb/Core/Debugger.h"
+#include "lldb/Core/Disassembler.h"
 #include "lldb/Core/FileSpecList.h"
 #include "lldb/Core/Mangled.h"
 #include "lldb/Core/ModuleSpec.h"
@@ -126,6 +127,12 @@ Module *Module::GetAllocatedModuleAtIndex(size_t idx) {
   return nullptr;
 }
 
+static std::atomic<uint32_t> g_symbol_file_generation(0);
+
+uint32_t Module::GetSymbolFileGeneration() {
+  return g_symbol_file_generation.load();
+}
+
 Module::Module(const ModuleSpec &module_spec)
     : m_object_offset(0), m_file_has_changed(false),
       m_first_file_changed_log(false) {
@@ -425,6 +432,132 @@ CompUnitSP Module::GetCompileUnitAtIndex(size_t index) {
   return cu_sp;
 }
 
+void Module::FindCompileUnitsUsingFile(ConstString basename,
+                                       std::vector<uint32_t> &cu_indexes) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  if (!m_file_basename_index) {
+    static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+    Timer scoped_timer(func_cat,
+                       "Module::FindCompileUnitsUsingFile (module = %p)",
+                       static_cast<void *>(this));
+    m_file_basename_index.emplace();
+    auto add_file = [this](const FileSpec &file, uint32_t cu_idx) {
+      if (const char *name = file.GetFilename().GetCString()) {
+        std::vector<uint32_t> &cus = (*m_file_basename_index)[name];
+        if (cus.empty() || cus.back() != cu_idx)
+          cus.push_back(cu_idx);
+      }
+    };
+    const size_t num_comp_units = GetNumCompileUnits();
+    for (size_t cu_idx = 0; cu_idx < num_comp_units; ++cu_idx) {
+      CompUnitSP cu_sp = GetCompileUnitAtIndex(cu_idx);
+      if (!cu_sp)
+        continue;
+      add_file(*cu_sp, cu_idx);
+      const FileSpecList &support_files = cu_sp->GetSupportFiles();
+      for (size_t i = 0, e = support_files.GetSize(); i < e; ++i)
+        add_file(support_files.GetFileSpecAtIndex(i), cu_idx);
+    }
+  }
+
+  auto pos = m_file_basename_index->find(basename.GetCString());
+  if (pos != m_file_basename_index->end())
+    cu_indexes.insert(cu_indexes.end(), pos->second.begin(),
+                      pos->second.end());
+}
+
+lldb::DisassemblerSP Module::GetCachedDisassembly(
+    const ArchSpec &arch, const char *plugin_name, const char *flavor,
+    const ExecutionContext &exe_ctx, const AddressRange &range) {
+  const Address &base_addr = range.GetBaseAddress();
+  const addr_t byte_size = range.GetByteSize();
+  SectionSP section_sp(base_addr.GetSection());
+  if (!section_sp || byte_size == 0 || section_sp->GetModule().get() != this)
+    return lldb::DisassemblerSP();
+
+  // Only cache what Target::ReadMemory would read from the file: the bytes of
+  // encrypted sections and of object files read out of the inferior's memory
+  // can change underneath us.
+  ObjectFile *objfile = GetObjectFile();
+  if (!objfile || objfile->IsInMemory() || section_sp->IsEncrypted() ||
+      base_addr.GetOffset() + byte_size > section_sp->GetFileSize())
+    return lldb::DisassemblerSP();
+
+  std::string config = arch.GetTriple().getTriple();
+  config += ';';
+  if (plugin_name)
+    config += plugin_name;
+  config += ';';
+  if (flavor)
+    config += flavor;
+  auto key = std::make_tuple(base_addr.GetFileAddress(), byte_size,
+                             std::move(config));
+
+  {
+    std::lock_guard<std::mutex> guard(m_disassembly_cache_mutex);
+    auto pos = m_disassembly_cache.find(key);
+    if (pos != m_disassembly_cache.end())
+      return pos->second;
+  }
+
+  // Decode without holding the lock, the symbolizer may need to look up
+  // other addresses in this module while it works.
+  const bool prefer_file_cache = true;
+  lldb::DisassemblerSP disasm_sp = Disassembler::DisassembleRange(
+      arch, plugin_name, flavor, exe_ctx, range, prefer_file_cache);
+  if (!disasm_sp)
+    return disasm_sp;
+
+  std::lock_guard<std::mutex> guard(m_disassembly_cache_mutex);
+  // Keep long sessions that stop in many different functions from growing
+  // the cache without bound.
+  const size_t max_cached_ranges = 1024;
+  if (m_disassembly_cache.size() >= max_cached_ranges)
+    m_disassembly_cache.clear();
+  return m_disassembly_cache.emplace(std::move(key), disasm_sp).first->second;
+}
+
+StructuredData::DictionarySP Module::ReportMemoryUsage() {
+  auto usage_sp = std::make_shared<StructuredData::Dictionary>();
+  uint64_t total = 0;
+  auto add_usage = [&](llvm::StringRef key, uint64_t bytes) {
+    usage_sp->AddIntegerItem(key, bytes);
+    total += bytes;
+  };
+
+  ObjectFile *obj_file = m_did_load_objfile.load() ? m_objfile_sp.get()
+                                                   : nullptr;
+  if (obj_file && obj_file->HasParsedSymtab())
+    add_usage("symtab", obj_file->GetSymtab()->MemorySize());
+  if (SymbolFile *sym_file = GetSymbolFile(false)) {
+    add_usage("debugInfo", sym_file->GetDebugInfoMemoryUsage());
+    add_usage("debugInfoIndex", sym_file->GetDebugInfoIndexMemoryUsage());
+  }
+
+  std::map<std::string, uint64_t> type_systems;
+  ForEachTypeSystem([&](TypeSystem *type_system) {
+    type_systems[type_system->GetKindName()] += type_system->GetMemoryUsage();
+    return true;
+  });
+  auto type_systems_sp = std::make_shared<StructuredData::Dictionary>();
+  for (const auto &entry : type_systems) {
+    type_systems_sp->AddIntegerItem(entry.first, entry.second);
+    total += entry.second;
+  }
+  usage_sp->AddItem("typeSystems", type_systems_sp);
+  usage_sp->AddIntegerItem("total", total);
+  return usage_sp;
+}
+
+void Module::ReleaseCaches() {
+  {
+    std::lock_guard<std::mutex> guard(m_disassembly_cache_mutex);
+    m_disassembly_cache.clear();
+  }
+  if (SymbolFile *sym_file = GetSymbolFile(false))
+    sym_file->ReleaseCaches();
+}
+
 bool Module::ResolveFileAddress(lldb::addr_t vm_addr, Address &so_addr) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
   static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
@@ -1083,6 +1216,19 @@ SymbolFile *Module::GetSymbolFile(bool can_create, Stream *feedback_strm) {
 }
 
 Symtab *Module::GetSymtab() {
+  // Symbol queries are made against every loaded module, but most modules
+  // never need their debug info. If the object file's symbol table doesn't
+  // depend on it, don't locate and parse separate debug info files just to
+  // answer them. SymbolFile::GetSymtab() hands out this same table later.
+  if (!m_did_load_symfile.load() && !m_symfile_spec) {
+    ObjectFile *obj_file = GetObjectFile();
+    if (obj_file && obj_file->HasCompleteSymtab()) {
+      if (obj_file->HasParsedSymtab())
+        return obj_file->GetSymtab();
+      ElapsedTime elapsed(m_symtab_parse_time);
+      return obj_file->GetSymtab();
+    }
+  }
   if (SymbolFile *symbols = GetSymbolFile())
     return symbols->GetSymtab();
   return nullptr;
@@ -1488,7 +1634,9 @@ void Module::SetSymbolFileFileSpec(const FileSpec &file) {
   }
   m_symfile_spec = file;
   m_symfile_up.reset();
+  m_file_basename_index.reset();
   m_did_load_symfile = false;
+  ++g_symbol_file_generation;
 }
 
 bool Module::IsExecutable() {
@@ -11,6 +11,7 @@
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Host/FileSystem.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Interpreter/OptionValueFileSpec.h"
 #include "lldb/Interpreter/OptionValueProperties.h"
 #include "lldb/Interpreter/Property.h"
@@ -31,6 +32,8 @@
 #endif
 
 #include "clang/Driver/Driver.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Threading.h"
@@ -114,6 +117,18 @@ bool ModuleListProperties::SetEnableExternalLookup(bool new_value) {
       nullptr, ePropertyEnableExternalLookup, new_value);
 }
 
+bool ModuleListProperties::GetKeepOrphanedModules() const {
+  const uint32_t idx = ePropertyKeepOrphanedModules;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_modulelist_properties[idx].default_uint_value != 0);
+}
+
+uint64_t ModuleListProperties::GetMemoryBudget() const {
+  const uint32_t idx = ePropertyMemoryBudget;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_modulelist_properties[idx].default_uint_value);
+}
+
 FileSpec ModuleListProperties::GetClangModulesCachePath() const {
   return m_collection_sp
       ->GetPropertyAtIndexAsOptionValueFileSpec(nullptr, false,
@@ -121,6 +136,20 @@ FileSpec ModuleListProperties::GetClangModulesCachePath() const {
       ->GetCurrentValue();
 }
 
+FileSpec ModuleListProperties::GetSymtabCachePath() const {
+  return m_collection_sp
+      ->GetPropertyAtIndexAsOptionValueFileSpec(nullptr, false,
+                                                ePropertySymtabCachePath)
+      ->GetCurrentValue();
+}
+
+FileSpec ModuleListProperties::GetSwiftModuleValidationCachePath() const {
+  return m_collection_sp
+      ->GetPropertyAtIndexAsOptionValueFileSpec(
+          nullptr, false, ePropertySwiftModuleValidationCachePath)
+      ->GetCurrentValue();
+}
+
 bool ModuleListProperties::GetUseDWARFImporter() const {
   const uint32_t idx = ePropertyUseDWARFImporter;
   return m_collection_sp->GetPropertyAtIndexAsBoolean(
@@ -152,6 +181,7 @@ ModuleList::ModuleList(const ModuleList &rhs)
   std::lock_guard<std::recursive_mutex> lhs_guard(m_modules_mutex);
   std::lock_guard<std::recursive_mutex> rhs_guard(rhs.m_modules_mutex);
   m_modules = rhs.m_modules;
+  UpdateSnapshot();
 }
 
 ModuleList::ModuleList(ModuleList::Notifier *notifier)
@@ -165,16 +195,38 @@ const ModuleList &ModuleList::operator=(const ModuleList &rhs) {
     std::lock_guard<std::recursive_mutex> rhs_guard(rhs.m_modules_mutex,
                                                     std::adopt_lock);
     m_modules = rhs.m_modules;
+    UpdateSnapshot();
   }
   return *this;
 }
 
 ModuleList::~ModuleList() = default;
 
+ModuleList::CollectionSnapshot ModuleList::GetSnapshot() const {
+  CollectionSnapshot snapshot = std::atomic_load(&m_snapshot);
+  if (!snapshot) {
+    static const CollectionSnapshot g_empty_snapshot =
+        std::make_shared<const collection>();
+    return g_empty_snapshot;
+  }
+  return snapshot;
+}
+
+void ModuleList::UpdateSnapshot() {
+  // Lists are usually modified far less often than they are searched, so
+  // copying the whole collection here is cheaper than coordinating the
+  // readers.
+  CollectionSnapshot snapshot;
+  if (!m_modules.empty())
+    snapshot = std::make_shared<const collection>(m_modules);
+  std::atomic_store(&m_snapshot, snapshot);
+}
+
 void ModuleList::AppendImpl(const ModuleSP &module_sp, bool use_notifier) {
   if (module_sp) {
     std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
     m_modules.push_back(module_sp);
+    UpdateSnapshot();
     if (use_notifier && m_notifier)
       m_notifier->NotifyModuleAdded(*this, module_sp);
   }
@@ -224,13 +276,13 @@ bool ModuleList::AppendIfNeeded(const ModuleSP &module_sp, bool notify) {
 }
 
 void ModuleList::Append(const ModuleList &module_list) {
-  for (auto pos : module_list.m_modules)
+  for (auto pos : *module_list.GetSnapshot())
     Append(pos);
 }
 
 bool ModuleList::AppendIfNeeded(const ModuleList &module_list) {
   bool any_in = false;
-  for (auto pos : module_list.m_modules) {
+  for (auto pos : *module_list.GetSnapshot()) {
     if (AppendIfNeeded(pos))
       any_in = true;
   }
@@ -244,6 +296,7 @@ bool ModuleList::RemoveImpl(const ModuleSP &module_sp, bool use_notifier) {
     for (pos = m_modules.begin(); pos != end; ++pos) {
       if (pos->get() == module_sp.get()) {
         m_modules.erase(pos);
+        UpdateSnapshot();
         if (use_notifier && m_notifier)
           m_notifier->NotifyModuleRemoved(*this, module_sp);
         return true;
@@ -258,8 +311,12 @@ ModuleList::RemoveImpl(ModuleList::collection::iterator pos,
                        bool use_notifier) {
   ModuleSP module_sp(*pos);
   collection::iterator retval = m_modules.erase(pos);
-  if (use_notifier && m_notifier)
+  // Callers that remove several modules publish the snapshot once they are
+  // done, unless the notifier needs to see the change right away.
+  if (use_notifier && m_notifier) {
+    UpdateSnapshot();
     m_notifier->NotifyModuleRemoved(*this, module_sp);
+  }
   return retval;
 }
 
@@ -285,6 +342,7 @@ bool ModuleList::RemoveIfOrphaned(const Module *module_ptr) {
       if (pos->get() == module_ptr) {
         if (pos->unique()) {
           pos = RemoveImpl(pos);
+          UpdateSnapshot();
           return true;
         } else
           return false;
@@ -314,14 +372,17 @@ size_t ModuleList::RemoveOrphans(bool mandatory) {
       ++pos;
     }
   }
+  if (remove_count > 0)
+    UpdateSnapshot();
   return remove_count;
 }
 
 size_t ModuleList::Remove(ModuleList &module_list) {
   std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
   size_t num_removed = 0;
-  collection::iterator pos, end = module_list.m_modules.end();
-  for (pos = module_list.m_modules.begin(); pos != end; ++pos) {
+  CollectionSnapshot modules = module_list.GetSnapshot();
+  collection::const_iterator pos, end = modules->end();
+  for (pos = modules->begin(); pos != end; ++pos) {
     if (Remove(*pos, false /* notify */))
       ++num_removed;
   }
@@ -339,11 +400,14 @@ void ModuleList::ClearImpl(bool use_notifier) {
   if (use_notifier && m_notifier)
     m_notifier->NotifyWillClearList(*this);
   m_modules.clear();
+  UpdateSnapshot();
 }
 
 Module *ModuleList::GetModulePointerAtIndex(size_t idx) const {
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  return GetModulePointerAtIndexUnlocked(idx);
+  CollectionSnapshot modules = GetSnapshot();
+  if (idx < modules->size())
+    return (*modules)[idx].get();
+  return nullptr;
 }
 
 Module *ModuleList::GetModulePointerAtIndexUnlocked(size_t idx) const {
@@ -353,8 +417,10 @@ Module *ModuleList::GetModulePointerAtIndexUnlocked(size_t idx) const {
 }
 
 ModuleSP ModuleList::GetModuleAtIndex(size_t idx) const {
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  return GetModuleAtIndexUnlocked(idx);
+  CollectionSnapshot modules = GetSnapshot();
+  if (idx < modules->size())
+    return (*modules)[idx];
+  return ModuleSP();
 }
 
 ModuleSP ModuleList::GetModuleAtIndexUnlocked(size_t idx) const {
@@ -377,9 +443,9 @@ size_t ModuleList::FindFunctions(ConstString name,
   if (name_type_mask & eFunctionNameTypeAuto) {
     Module::LookupInfo lookup_info(name, name_type_mask, eLanguageTypeUnknown);
 
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos) {
+    CollectionSnapshot modules = GetSnapshot();
+    collection::const_iterator pos, end = modules->end();
+    for (pos = modules->begin(); pos != end; ++pos) {
       (*pos)->FindFunctions(lookup_info.GetLookupName(), nullptr,
                             lookup_info.GetNameTypeMask(), include_symbols,
                             include_inlines, true, sc_list);
@@ -390,9 +456,9 @@ size_t ModuleList::FindFunctions(ConstString name,
     if (old_size < new_size)
       lookup_info.Prune(sc_list, old_size);
   } else {
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos) {
+    CollectionSnapshot modules = GetSnapshot();
+    collection::const_iterator pos, end = modules->end();
+    for (pos = modules->begin(); pos != end; ++pos) {
       (*pos)->FindFunctions(name, nullptr, name_type_mask, include_symbols,
                             include_inlines, true, sc_list);
     }
@@ -408,9 +474,9 @@ size_t ModuleList::FindFunctionSymbols(ConstString name,
   if (name_type_mask & eFunctionNameTypeAuto) {
     Module::LookupInfo lookup_info(name, name_type_mask, eLanguageTypeUnknown);
 
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos) {
+    CollectionSnapshot modules = GetSnapshot();
+    collection::const_iterator pos, end = modules->end();
+    for (pos = modules->begin(); pos != end; ++pos) {
       (*pos)->FindFunctionSymbols(lookup_info.GetLookupName(),
                                   lookup_info.GetNameTypeMask(), sc_list);
     }
@@ -420,9 +486,9 @@ size_t ModuleList::FindFunctionSymbols(ConstString name,
     if (old_size < new_size)
       lookup_info.Prune(sc_list, old_size);
   } else {
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos) {
+    CollectionSnapshot modules = GetSnapshot();
+    collection::const_iterator pos, end = modules->end();
+    for (pos = modules->begin(); pos != end; ++pos) {
       (*pos)->FindFunctionSymbols(name, name_type_mask, sc_list);
     }
   }
@@ -435,10 +501,10 @@ size_t ModuleList::FindFunctions(const RegularExpression &name,
                                  bool append, SymbolContextList &sc_list) {
   const size_t initial_size = sc_list.GetSize();
 
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
+  CollectionSnapshot modules = GetSnapshot();
+  collection::const_iterator pos, end = modules->end();
   collection dylinker_modules;
-  for (pos = m_modules.begin(); pos != end; ++pos) {
+  for (pos = modules->begin(); pos != end; ++pos) {
     if (!(*pos)->GetIsDynamicLinkEditor())
       (*pos)->FindFunctions(name, include_symbols, include_inlines, append,
                             sc_list);
@@ -461,9 +527,9 @@ size_t ModuleList::FindCompileUnits(const FileSpec &path, bool append,
   if (!append)
     sc_list.Clear();
 
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
+  CollectionSnapshot modules = GetSnapshot();
+  collection::const_iterator pos, end = modules->end();
+  for (pos = modules->begin(); pos != end; ++pos) {
     (*pos)->FindCompileUnits(path, true, sc_list);
   }
 
@@ -474,9 +540,9 @@ size_t ModuleList::FindGlobalVariables(ConstString name,
                                        size_t max_matches,
                                        VariableList &variable_list) const {
   size_t initial_size = variable_list.GetSize();
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
+  CollectionSnapshot modules = GetSnapshot();
+  collection::const_iterator pos, end = modules->end();
+  for (pos = modules->begin(); pos != end; ++pos) {
     (*pos)->FindGlobalVariables(name, nullptr, max_matches, variable_list);
   }
   return variable_list.GetSize() - initial_size;
@@ -486,9 +552,9 @@ size_t ModuleList::FindGlobalVariables(const RegularExpression &regex,
                                        size_t max_matches,
                                        VariableList &variable_list) const {
   size_t initial_size = variable_list.GetSize();
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
+  CollectionSnapshot modules = GetSnapshot();
+  collection::const_iterator pos, end = modules->end();
+  for (pos = modules->begin(); pos != end; ++pos) {
     (*pos)->FindGlobalVariables(regex, max_matches, variable_list);
   }
   return variable_list.GetSize() - initial_size;
@@ -528,14 +594,14 @@ size_t ModuleList::FindSymbolsWithNameAndType(ConstString name,
                                               SymbolType symbol_type,
                                               SymbolContextList &sc_list,
                                               bool append) const {
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
+  CollectionSnapshot modules = GetSnapshot();
   if (!append)
     sc_list.Clear();
   size_t initial_size = sc_list.GetSize();
 
-  collection::const_iterator pos, end = m_modules.end();
+  collection::const_iterator pos, end = modules->end();
   collection dylinker_modules;
-  for (pos = m_modules.begin(); pos != end; ++pos) {
+  for (pos = modules->begin(); pos != end; ++pos) {
     if (!(*pos)->GetIsDynamicLinkEditor())
       (*pos)->FindSymbolsWithNameAndType(name, symbol_type, sc_list);
     else
@@ -558,14 +624,14 @@ size_t ModuleList::FindSymbolsWithNameAndType(ConstString name,
 size_t ModuleList::FindSymbolsMatchingRegExAndType(
     const RegularExpression &regex, lldb::SymbolType symbol_type,
     SymbolContextList &sc_list, bool append) const {
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
+  CollectionSnapshot modules = GetSnapshot();
   if (!append)
     sc_list.Clear();
   size_t initial_size = sc_list.GetSize();
 
-  collection::const_iterator pos, end = m_modules.end();
+  collection::const_iterator pos, end = modules->end();
   collection dylinker_modules;
-  for (pos = m_modules.begin(); pos != end; ++pos) {
+  for (pos = modules->begin(); pos != end; ++pos) {
     if (!(*pos)->GetIsDynamicLinkEditor())
       (*pos)->FindSymbolsMatchingRegExAndType(regex, symbol_type, sc_list);
     else
@@ -586,9 +652,9 @@ size_t ModuleList::FindModules(const ModuleSpec &module_spec,
                                ModuleList &matching_module_list) const {
   size_t existing_matches = matching_module_list.GetSize();
 
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
+  CollectionSnapshot modules = GetSnapshot();
+  collection::const_iterator pos, end = modules->end();
+  for (pos = modules->begin(); pos != end; ++pos) {
     ModuleSP module_sp(*pos);
     if (module_sp->MatchesModuleSpec(module_spec))
       matching_module_list.Append(module_sp);
@@ -598,17 +664,13 @@ size_t ModuleList::FindModules(const ModuleSpec &module_spec,
 
 ModuleSP ModuleList::FindModule(const Module *module_ptr) const {
   ModuleSP module_sp;
+  CollectionSnapshot modules = GetSnapshot();
+  collection::const_iterator pos, end = modules->end();
 
-  // Scope for "locker"
-  {
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-
-    for (pos = m_modules.begin(); pos != end; ++pos) {
-      if ((*pos).get() == module_ptr) {
-        module_sp = (*pos);
-        break;
-      }
+  for (pos = modules->begin(); pos != end; ++pos) {
+    if ((*pos).get() == module_ptr) {
+      module_sp = (*pos);
+      break;
     }
   }
   return module_sp;
@@ -618,10 +680,10 @@ ModuleSP ModuleList::FindModule(const UUID &uuid) const {
   ModuleSP module_sp;
 
   if (uuid.IsValid()) {
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
+    CollectionSnapshot modules = GetSnapshot();
+    collection::const_iterator pos, end = modules->end();
 
-    for (pos = m_modules.begin(); pos != end; ++pos) {
+    for (pos = modules->begin(); pos != end; ++pos) {
       if ((*pos)->GetUUID() == uuid) {
         module_sp = (*pos);
         break;
@@ -636,12 +698,33 @@ ModuleList::FindTypes(Module *search_first, ConstString name,
                       bool name_is_fully_qualified, size_t max_matches,
                       llvm::DenseSet<SymbolFile *> &searched_symbol_files,
                       TypeList &types) const {
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
+  CollectionSnapshot modules = GetSnapshot();
+
+  // Expression evaluation looks up the same names many times, and most of
+  // them aren't types in any module, so remember the names that weren't
+  // found. A lookup that skips some symbol files finds a subset of the types
+  // a full lookup would, so it can use the names but can't add to them.
+  const uint32_t symbol_file_generation = Module::GetSymbolFileGeneration();
+  const std::pair<const char *, bool> missing_key(name.GetCString(),
+                                                  name_is_fully_qualified);
+  const bool can_record_missing =
+      max_matches > 0 && searched_symbol_files.empty();
+  {
+    std::lock_guard<std::mutex> guard(m_missing_types_mutex);
+    if (m_missing_types.snapshot.lock() != modules ||
+        m_missing_types.symbol_file_generation != symbol_file_generation) {
+      m_missing_types.snapshot = modules;
+      m_missing_types.symbol_file_generation = symbol_file_generation;
+      m_missing_types.names.clear();
+    } else if (m_missing_types.names.count(missing_key)) {
+      return 0;
+    }
+  }
 
   size_t total_matches = 0;
-  collection::const_iterator pos, end = m_modules.end();
+  collection::const_iterator pos, end = modules->end();
   if (search_first) {
-    for (pos = m_modules.begin(); pos != end; ++pos) {
+    for (pos = modules->begin(); pos != end; ++pos) {
       if (search_first == pos->get()) {
         total_matches +=
             search_first->FindTypes(name, name_is_fully_qualified, max_matches,
@@ -654,7 +737,7 @@ ModuleList::FindTypes(Module *search_first, ConstString name,
   }
 
   if (total_matches < max_matches) {
-    for (pos = m_modules.begin(); pos != end; ++pos) {
+    for (pos = modules->begin(); pos != end; ++pos) {
       // Search the module if the module is not equal to the one in the symbol
       // context "sc". If "sc" contains a empty module shared pointer, then the
       // comparison will always be true (valid_module_ptr != nullptr).
@@ -668,14 +751,21 @@ ModuleList::FindTypes(Module *search_first, ConstString name,
     }
   }
 
+  if (total_matches == 0 && can_record_missing) {
+    std::lock_guard<std::mutex> guard(m_missing_types_mutex);
+    if (m_missing_types.snapshot.lock() == modules &&
+        m_missing_types.symbol_file_generation == symbol_file_generation)
+      m_missing_types.names.insert(missing_key);
+  }
+
   return total_matches;
 }
 
 bool ModuleList::FindSourceFile(const FileSpec &orig_spec,
                                 FileSpec &new_spec) const {
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
+  CollectionSnapshot modules = GetSnapshot();
+  collection::const_iterator pos, end = modules->end();
+  for (pos = modules->begin(); pos != end; ++pos) {
     if ((*pos)->FindSourceFile(orig_spec, new_spec))
       return true;
   }
@@ -687,9 +777,9 @@ void ModuleList::FindAddressesForLine(const lldb::TargetSP target_sp,
                                       Function *function,
                                       std::vector<Address> &output_local,
                                       std::vector<Address> &output_extern) {
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
+  CollectionSnapshot modules = GetSnapshot();
+  collection::const_iterator pos, end = modules->end();
+  for (pos = modules->begin(); pos != end; ++pos) {
     (*pos)->FindAddressesForLine(target_sp, file, line, function, output_local,
                                  output_extern);
   }
@@ -697,9 +787,9 @@ void ModuleList::FindAddressesForLine(const lldb::TargetSP target_sp,
 
 ModuleSP ModuleList::FindFirstModule(const ModuleSpec &module_spec) const {
   ModuleSP module_sp;
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
+  CollectionSnapshot modules = GetSnapshot();
+  collection::const_iterator pos, end = modules->end();
+  for (pos = modules->begin(); pos != end; ++pos) {
     ModuleSP module_sp(*pos);
     if (module_sp->MatchesModuleSpec(module_spec))
       return module_sp;
@@ -707,32 +797,25 @@ ModuleSP ModuleList::FindFirstModule(const ModuleSpec &module_spec) const {
   return module_sp;
 }
 
-size_t ModuleList::GetSize() const {
-  size_t size = 0;
-  {
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    size = m_modules.size();
-  }
-  return size;
-}
+size_t ModuleList::GetSize() const { return GetSnapshot()->size(); }
 
 void ModuleList::Dump(Stream *s) const {
   //  s.Printf("%.*p: ", (int)sizeof(void*) * 2, this);
   //  s.Indent();
   //  s << "ModuleList\n";
 
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
+  CollectionSnapshot modules = GetSnapshot();
+  collection::const_iterator pos, end = modules->end();
+  for (pos = modules->begin(); pos != end; ++pos) {
     (*pos)->Dump(s);
   }
 }
 
 void ModuleList::LogUUIDAndPaths(Log *log, const char *prefix_cstr) {
   if (log != nullptr) {
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    collection::const_iterator pos, begin = m_modules.begin(),
-                                    end = m_modules.end();
+    CollectionSnapshot modules = GetSnapshot();
+    collection::const_iterator pos, begin = modules->begin(),
+                                    end = modules->end();
     for (pos = begin; pos != end; ++pos) {
       Module *module = pos->get();
       const FileSpec &module_file_spec = module->GetFileSpec();
@@ -747,9 +830,9 @@ void ModuleList::LogUUIDAndPaths(Log *log, const char *prefix_cstr) {
 
 bool ModuleList::ResolveFileAddress(lldb::addr_t vm_addr,
                                     Address &so_addr) const {
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
+  CollectionSnapshot modules = GetSnapshot();
+  collection::const_iterator pos, end = modules->end();
+  for (pos = modules->begin(); pos != end; ++pos) {
     if ((*pos)->ResolveFileAddress(vm_addr, so_addr))
       return true;
   }
@@ -768,9 +851,9 @@ ModuleList::ResolveSymbolContextForAddress(const Address &so_addr,
     resolved_flags =
         module_sp->ResolveSymbolContextForAddress(so_addr, resolve_scope, sc);
   } else {
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos) {
+    CollectionSnapshot modules = GetSnapshot();
+    collection::const_iterator pos, end = modules->end();
+    for (pos = modules->begin(); pos != end; ++pos) {
       resolved_flags =
           (*pos)->ResolveSymbolContextForAddress(so_addr, resolve_scope, sc);
       if (resolved_flags != 0)
@@ -781,6 +864,48 @@ ModuleList::ResolveSymbolContextForAddress(const Address &so_addr,
   return resolved_flags;
 }
 
+size_t ModuleList::ResolveSymbolContextsForAddresses(
+    llvm::ArrayRef<Address> so_addrs, SymbolContextItem resolve_scope,
+    std::vector<SymbolContext> &sc_list) const {
+  sc_list.assign(so_addrs.size(), SymbolContext());
+  std::vector<uint32_t> resolved(so_addrs.size(), 0);
+
+  // Sort the addresses by module, then section and offset, so each module is
+  // walked once and in address order.
+  std::vector<size_t> order;
+  order.reserve(so_addrs.size());
+  std::vector<ModuleSP> modules(so_addrs.size());
+  for (size_t i = 0; i < so_addrs.size(); ++i) {
+    modules[i] = so_addrs[i].GetModule();
+    if (modules[i])
+      order.push_back(i);
+  }
+  std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    if (modules[lhs] != modules[rhs])
+      return modules[lhs].get() < modules[rhs].get();
+    return so_addrs[lhs].GetFileAddress() < so_addrs[rhs].GetFileAddress();
+  });
+
+  std::vector<size_t> group_starts;
+  for (size_t i = 0; i < order.size(); ++i)
+    if (i == 0 || modules[order[i]] != modules[order[i - 1]])
+      group_starts.push_back(i);
+  group_starts.push_back(order.size());
+
+  // Module lookups take the module's mutex, so different modules can be
+  // resolved concurrently while addresses within a module stay serialized.
+  TaskMapOverInt(0, group_starts.size() - 1, [&](size_t group) {
+    for (size_t i = group_starts[group]; i < group_starts[group + 1]; ++i) {
+      const size_t idx = order[i];
+      resolved[idx] = modules[idx]->ResolveSymbolContextForAddress(
+          so_addrs[idx], resolve_scope, sc_list[idx]);
+    }
+  });
+
+  return std::count_if(resolved.begin(), resolved.end(),
+                       [](uint32_t flags) { return flags != 0; });
+}
+
 uint32_t ModuleList::ResolveSymbolContextForFilePath(
     const char *file_path, uint32_t line, bool check_inlines,
     SymbolContextItem resolve_scope, SymbolContextList &sc_list) const {
@@ -792,9 +917,9 @@ uint32_t ModuleList::ResolveSymbolContextForFilePath(
 uint32_t ModuleList::ResolveSymbolContextsForFileSpec(
     const FileSpec &file_spec, uint32_t line, bool check_inlines,
     SymbolContextItem resolve_scope, SymbolContextList &sc_list) const {
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
+  CollectionSnapshot modules = GetSnapshot();
+  collection::const_iterator pos, end = modules->end();
+  for (pos = modules->begin(); pos != end; ++pos) {
     (*pos)->ResolveSymbolContextsForFileSpec(file_spec, line, check_inlines,
                                              resolve_scope, sc_list);
   }
@@ -804,10 +929,10 @@ uint32_t ModuleList::ResolveSymbolContextsForFileSpec(
 
 size_t ModuleList::GetIndexForModule(const Module *module) const {
   if (module) {
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
+    CollectionSnapshot modules = GetSnapshot();
     collection::const_iterator pos;
-    collection::const_iterator begin = m_modules.begin();
-    collection::const_iterator end = m_modules.end();
+    collection::const_iterator begin = modules->begin();
+    collection::const_iterator end = modules->end();
     for (pos = begin; pos != end; ++pos) {
       if ((*pos).get() == module)
         return std::distance(begin, pos);
@@ -861,14 +986,58 @@ size_t ModuleList::RemoveOrphanSharedModules(bool mandatory) {
   return GetSharedModuleList().RemoveOrphans(mandatory);
 }
 
+namespace {
+/// Serializes GetSharedModule for modules with the same file name or UUID.
+///
+/// Creating a module reads and parses its object file, which takes a while.
+/// Holding the lock of the shared module list for that long made targets
+/// loading different modules wait for each other. The lock is now only held
+/// for the lookups and the insertion, and this lock makes sure two threads
+/// getting the same module still create it only once.
+///
+/// A thread getting a module while it creates another one, e.g. from a
+/// plugin, goes on without taking a second lock, so two of these locks are
+/// never held in different orders. At worst such a module is created twice,
+/// and the second copy replaces the first in the shared module list.
+class SharedModuleCreationLock {
+public:
+  explicit SharedModuleCreationLock(const ModuleSpec &module_spec) {
+    if (t_held)
+      return;
+    m_lock = std::unique_lock<std::mutex>(GetMutex(module_spec));
+    t_held = true;
+  }
+
+  ~SharedModuleCreationLock() {
+    if (m_lock.owns_lock())
+      t_held = false;
+  }
+
+private:
+  static std::mutex &GetMutex(const ModuleSpec &module_spec) {
+    static std::mutex g_mutexes[64];
+    size_t hash = 0;
+    if (ConstString name = module_spec.GetFileSpec().GetFilename())
+      hash = llvm::hash_value(name.GetCString());
+    else if (const UUID *uuid = module_spec.GetUUIDPtr())
+      hash = llvm::hash_value(uuid->GetBytes());
+    return g_mutexes[hash % llvm::array_lengthof(g_mutexes)];
+  }
+
+  static thread_local bool t_held;
+  std::unique_lock<std::mutex> m_lock;
+};
+
+thread_local bool SharedModuleCreationLock::t_held = false;
+} // namespace
+
 Status ModuleList::GetSharedModule(const ModuleSpec &module_spec,
                                    ModuleSP &module_sp,
                                    const FileSpecList *module_search_paths_ptr,
                                    ModuleSP *old_module_sp_ptr,
                                    bool *did_create_ptr, bool always_create) {
   ModuleList &shared_module_list = GetSharedModuleList();
-  std::lock_guard<std::recursive_mutex> guard(
-      shared_module_list.m_modules_mutex);
+  SharedModuleCreationLock creation_lock(module_spec);
   char path[PATH_MAX];
 
   Status error;
@@ -884,9 +1053,8 @@ Status ModuleList::GetSharedModule(const ModuleSpec &module_spec,
   const FileSpec &module_file_spec = module_spec.GetFileSpec();
   const ArchSpec &arch = module_spec.GetArchitecture();
 
-  // Make sure no one else can try and get or create a module while this
-  // function is actively working on it by doing an extra lock on the global
-  // mutex list.
+  // The creation lock makes sure no one else can try and get or create this
+  // module while this function is actively working on it.
   if (!always_create) {
     ModuleList matching_module_list;
     const size_t num_matching_modules =
@@ -1105,6 +1273,48 @@ Status ModuleList::GetSharedModule(const ModuleSpec &module_spec,
   return error;
 }
 
+void ModuleList::PreloadSharedModules(llvm::ArrayRef<ModuleSpec> module_specs) {
+  ModuleList &shared_module_list = GetSharedModuleList();
+  std::vector<const ModuleSpec *> to_create;
+  {
+    std::lock_guard<std::recursive_mutex> guard(
+        shared_module_list.m_modules_mutex);
+    for (const ModuleSpec &module_spec : module_specs) {
+      ModuleList matching_module_list;
+      if (shared_module_list.FindModules(module_spec, matching_module_list) ==
+              0 &&
+          FileSystem::Instance().Exists(module_spec.GetFileSpec()))
+        to_create.push_back(&module_spec);
+    }
+  }
+
+  // Creating the modules doesn't hold the shared module list's mutex, unlike
+  // GetSharedModule, so the object files are read in parallel.
+  std::vector<ModuleSP> created(to_create.size());
+  TaskMapOverInt(0, to_create.size(), [&](size_t i) {
+    const ModuleSpec &module_spec = *to_create[i];
+    auto module_sp = std::make_shared<Module>(module_spec);
+    ObjectFile *objfile = module_sp->GetObjectFile();
+    if (!objfile || objfile->GetType() == ObjectFile::eTypeStubLibrary)
+      return;
+    const UUID *uuid_ptr = module_spec.GetUUIDPtr();
+    if (uuid_ptr && *uuid_ptr != module_sp->GetUUID())
+      return;
+    module_sp->GetSectionList();
+    created[i] = std::move(module_sp);
+  });
+
+  std::lock_guard<std::recursive_mutex> guard(
+      shared_module_list.m_modules_mutex);
+  for (size_t i = 0; i < created.size(); ++i) {
+    ModuleList matching_module_list;
+    if (created[i] &&
+        shared_module_list.FindModules(*to_create[i], matching_module_list) ==
+            0)
+      shared_module_list.ReplaceEquivalent(created[i]);
+  }
+}
+
 bool ModuleList::RemoveSharedModule(lldb::ModuleSP &module_sp) {
   return GetSharedModuleList().Remove(module_sp);
 }
@@ -1119,8 +1329,8 @@ bool ModuleList::LoadScriptingResourcesInTarget(Target *target,
                                                 bool continue_on_error) {
   if (!target)
     return false;
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  for (auto module : m_modules) {
+  CollectionSnapshot modules = GetSnapshot();
+  for (auto module : *modules) {
     Status error;
     if (module) {
       if (!module->LoadScriptingResourceInTarget(target, error,
@@ -1145,8 +1355,8 @@ bool ModuleList::LoadScriptingResourcesInTarget(Target *target,
 
 void ModuleList::ForEach(
     std::function<bool(const ModuleSP &module_sp)> const &callback) const {
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  for (const auto &module : m_modules) {
+  CollectionSnapshot modules = GetSnapshot();
+  for (const auto &module : *modules) {
     // If the callback returns false, then stop iterating and break out
     if (!callback(module))
       break;
@@ -1154,7 +1364,11 @@ void ModuleList::ForEach(
 }
 
 void ModuleList::ClearModuleDependentCaches() {
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  for (const auto &module : m_modules)
+  {
+    std::lock_guard<std::mutex> guard(m_missing_types_mutex);
+    m_missing_types.names.clear();
+  }
+  CollectionSnapshot modules = GetSnapshot();
+  for (const auto &module : *modules)
     module->ClearModuleDependentCaches();
 }
@@ -181,6 +181,20 @@ void PluginManager::Initialize() {
 #endif
 }
 
+static void (*g_llvm_targets_callback)() = nullptr;
+
+void PluginManager::SetLLVMTargetsCallback(void (*callback)()) {
+  g_llvm_targets_callback = callback;
+}
+
+void PluginManager::InitializeLLVMTargets() {
+  static std::once_flag g_once_flag;
+  std::call_once(g_once_flag, []() {
+    if (g_llvm_targets_callback)
+      g_llvm_targets_callback();
+  });
+}
+
 void PluginManager::Terminate() {
   std::lock_guard<std::recursive_mutex> guard(GetPluginMapMutex());
   PluginTerminateMap &plugin_map = GetPluginMap();
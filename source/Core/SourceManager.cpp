@@ -31,11 +31,14 @@
 
 #include "llvm/ADT/Twine.h"
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
 namespace lldb_private {
 class ExecutionContext;
@@ -49,6 +52,32 @@ using namespace lldb_private;
 
 static inline bool is_newline_char(char ch) { return ch == '\n' || ch == '\r'; }
 
+// Source files are shared by the File objects of all debuggers in the
+// process, as long as one of them holds on to the contents, so a host with
+// many debuggers reads each version of a file only once.
+static DataBufferSP GetSourceFileData(const FileSpec &file_spec,
+                                      llvm::sys::TimePoint<> mod_time) {
+  typedef std::pair<llvm::sys::TimePoint<>, std::weak_ptr<DataBuffer>>
+      CachedData;
+  static std::mutex g_mutex;
+  static std::map<FileSpec, CachedData> g_data;
+
+  {
+    std::lock_guard<std::mutex> guard(g_mutex);
+    auto pos = g_data.find(file_spec);
+    if (pos != g_data.end() && pos->second.first == mod_time)
+      if (DataBufferSP data_sp = pos->second.second.lock())
+        return data_sp;
+  }
+
+  DataBufferSP data_sp = FileSystem::Instance().CreateDataBuffer(file_spec);
+  if (data_sp) {
+    std::lock_guard<std::mutex> guard(g_mutex);
+    g_data[file_spec] = CachedData(mod_time, data_sp);
+  }
+  return data_sp;
+}
+
 // SourceManager constructor
 SourceManager::SourceManager(const TargetSP &target_sp)
     : m_last_file_sp(), m_last_line(0), m_last_count(0), m_default_set(false),
@@ -472,7 +501,7 @@ void SourceManager::File::CommonInitializer(const FileSpec &file_spec,
   }
 
   if (m_mod_time != llvm::sys::TimePoint<>())
-    m_data_sp = FileSystem::Instance().CreateDataBuffer(m_file_spec);
+    m_data_sp = GetSourceFileData(m_file_spec, m_mod_time);
 }
 
 uint32_t SourceManager::File::GetLineOffset(uint32_t line) {
@@ -550,7 +579,7 @@ void SourceManager::File::UpdateIfNeeded() {
   if (curr_mod_time != llvm::sys::TimePoint<>() &&
       m_mod_time != curr_mod_time) {
     m_mod_time = curr_mod_time;
-    m_data_sp = FileSystem::Instance().CreateDataBuffer(m_file_spec);
+    m_data_sp = GetSourceFileData(m_file_spec, m_mod_time);
     m_offsets.clear();
   }
 }
@@ -668,18 +697,26 @@ bool SourceManager::File::CalculateLineOffsets(uint32_t line) {
         // Push a 1 at index zero to indicate the file has been completely
         // indexed.
         m_offsets.push_back(UINT32_MAX);
-        const char *s;
-        for (s = start; s < end; ++s) {
-          char curr_ch = *s;
-          if (is_newline_char(curr_ch)) {
-            if (s + 1 < end) {
-              char next_ch = s[1];
-              if (is_newline_char(next_ch)) {
-                if (curr_ch != next_ch)
-                  ++s;
+        if (!::memchr(start, '\r', end - start)) {
+          // Most files only use '\n', which memchr finds a lot faster than
+          // the loop below.
+          for (const char *s = start;
+               (s = static_cast<const char *>(::memchr(s, '\n', end - s)));)
+            m_offsets.push_back(++s - start);
+        } else {
+          const char *s;
+          for (s = start; s < end; ++s) {
+            char curr_ch = *s;
+            if (is_newline_char(curr_ch)) {
+              if (s + 1 < end) {
+                char next_ch = s[1];
+                if (is_newline_char(next_ch)) {
+                  if (curr_ch != next_ch)
+                    ++s;
+                }
               }
+              m_offsets.push_back(s + 1 - start);
             }
-            m_offsets.push_back(s + 1 - start);
           }
         }
         if (!m_offsets.empty()) {
@@ -716,7 +753,7 @@ bool SourceManager::File::GetLine(uint32_t line_no, std::string &buffer) {
 }
 
 void SourceManager::SourceFileCache::AddSourceFile(const FileSP &file_sp) {
-  FileSpec file_spec;
+  FileSpec file_spec = file_sp->GetFileSpec();
   FileCache::iterator pos = m_file_cache.find(file_spec);
   if (pos == m_file_cache.end())
     m_file_cache[file_spec] = file_sp;
@@ -523,6 +523,22 @@ Status Value::GetValueAsData(ExecutionContext *exe_ctx, DataExtractor &data,
   if (byte_size == 0)
     return error;
 
+  // Processes backed by a mapped file, like core files, can hand out their
+  // memory directly instead of having it copied into a new buffer.
+  if (address_type == eAddressTypeLoad && !file_so_addr.IsValid() && exe_ctx) {
+    if (Process *process = exe_ctx->GetProcessPtr()) {
+      DataExtractor view;
+      if (process->GetMemoryView(address, byte_size, view)) {
+        const lldb::ByteOrder byte_order = data.GetByteOrder();
+        const uint32_t addr_size = data.GetAddressByteSize();
+        data.SetData(view, 0, byte_size);
+        data.SetByteOrder(byte_order);
+        data.SetAddressByteSize(addr_size);
+        return error;
+      }
+    }
+  }
+
   // Make sure we have enough room within "data", and if we don't make
   // something large enough that does
   if (!data.ValidOffsetForDataOfSize(0, byte_size)) {
@@ -521,6 +521,28 @@ ValueObjectSP ValueObject::GetChildAtIndex(size_t idx, bool can_create) {
   return child_sp;
 }
 
+std::vector<lldb::ValueObjectSP>
+ValueObject::GetChildrenInRange(size_t start, size_t count, bool can_create) {
+  std::vector<lldb::ValueObjectSP> children;
+  size_t max = start + count;
+  if (max < start || max > UINT32_MAX)
+    max = UINT32_MAX;
+  size_t num_children = GetNumChildren(max);
+  if (start >= num_children)
+    return children;
+  count = num_children - start;
+  if (can_create)
+    PrefetchChildren(start, count);
+  children.reserve(count);
+  for (size_t idx = start; idx < num_children; ++idx) {
+    lldb::ValueObjectSP child_sp = GetChildAtIndex(idx, can_create);
+    if (!child_sp)
+      break;
+    children.push_back(child_sp);
+  }
+  return children;
+}
+
 lldb::ValueObjectSP
 ValueObject::GetChildAtIndexPath(llvm::ArrayRef<size_t> idxs,
                                  size_t *index_of_error) {
@@ -702,11 +724,12 @@ ValueObject *ValueObject::CreateChildAtIndex(size_t idx,
     if (!child_name_str.empty())
       child_name.SetCString(child_name_str.c_str());
 
-    valobj = new ValueObjectChild(
-        *this, child_compiler_type, child_name, child_byte_size,
-        child_byte_offset, child_bitfield_bit_size, child_bitfield_bit_offset,
-        child_is_base_class, child_is_deref_of_parent, eAddressTypeInvalid,
-        language_flags);
+    valobj = new (m_manager->Allocate<ValueObjectChild>())
+        ValueObjectChild(*this, child_compiler_type, child_name,
+                         child_byte_size, child_byte_offset,
+                         child_bitfield_bit_size, child_bitfield_bit_offset,
+                         child_is_base_class, child_is_deref_of_parent,
+                         eAddressTypeInvalid, language_flags);
   }
 
   return valobj;
@@ -1848,10 +1871,11 @@ ValueObjectSP ValueObject::GetSyntheticBitFieldChild(uint32_t from, uint32_t to,
             GetByteSize() * 8 - bit_field_size - bit_field_offset;
       // We haven't made a synthetic array member for INDEX yet, so lets make
       // one and cache it for any future reference.
-      ValueObjectChild *synthetic_child = new ValueObjectChild(
-          *this, GetCompilerType(), index_const_str, GetByteSize(), 0,
-          bit_field_size, bit_field_offset, false, false, eAddressTypeInvalid,
-          0);
+      ValueObjectChild *synthetic_child =
+          new (m_manager->Allocate<ValueObjectChild>()) ValueObjectChild(
+              *this, GetCompilerType(), index_const_str, GetByteSize(), 0,
+              bit_field_size, bit_field_offset, false, false,
+              eAddressTypeInvalid, 0);
 
       // Cache the value if we got one back...
       if (synthetic_child) {
@@ -1893,7 +1917,8 @@ ValueObjectSP ValueObject::GetSyntheticChildAtOffset(
   if (!size)
     return {};
   ValueObjectChild *synthetic_child =
-      new ValueObjectChild(*this, type, name_const_str, *size, offset, 0, 0,
+      new (m_manager->Allocate<ValueObjectChild>())
+          ValueObjectChild(*this, type, name_const_str, *size, offset, 0, 0,
                            false, false, eAddressTypeInvalid, 0);
   if (synthetic_child) {
     AddSyntheticChild(name_const_str, synthetic_child);
@@ -1935,7 +1960,8 @@ ValueObjectSP ValueObject::GetSyntheticBase(uint32_t offset,
   if (!size)
     return {};
   ValueObjectChild *synthetic_child =
-      new ValueObjectChild(*this, type, name_const_str, *size, offset, 0, 0,
+      new (m_manager->Allocate<ValueObjectChild>())
+          ValueObjectChild(*this, type, name_const_str, *size, offset, 0, 0,
                            is_base_class, false, eAddressTypeInvalid, 0);
   if (synthetic_child) {
     AddSyntheticChild(name_const_str, synthetic_child);
@@ -2903,11 +2929,12 @@ ValueObjectSP ValueObject::Dereference(Status &error) {
       if (!child_name_str.empty())
         child_name.SetCString(child_name_str.c_str());
 
-      m_deref_valobj = new ValueObjectChild(
-          *this, child_compiler_type, child_name, child_byte_size,
-          child_byte_offset, child_bitfield_bit_size, child_bitfield_bit_offset,
-          child_is_base_class, child_is_deref_of_parent, eAddressTypeInvalid,
-          language_flags);
+      m_deref_valobj = new (m_manager->Allocate<ValueObjectChild>())
+          ValueObjectChild(*this, child_compiler_type, child_name,
+                           child_byte_size, child_byte_offset,
+                           child_bitfield_bit_size, child_bitfield_bit_offset,
+                           child_is_base_class, child_is_deref_of_parent,
+                           eAddressTypeInvalid, language_flags);
     }
   } else if (HasSyntheticValue()) {
     m_deref_valobj =
@@ -27,6 +27,32 @@
 
 using namespace lldb_private;
 
+/// If \a parent_data already holds the bytes at the address in
+/// \a child_value, point \a data into the parent's buffer instead of reading
+/// them again.
+static bool SliceParentData(const Value &parent_value,
+                            const DataExtractor &parent_data,
+                            const Value &child_value, uint64_t byte_size,
+                            DataExtractor &data) {
+  if (byte_size == 0)
+    return false;
+  if (parent_value.GetValueType() != child_value.GetValueType())
+    return false;
+  if (parent_data.GetByteSize() == 0)
+    return false;
+  const lldb::addr_t parent_addr =
+      parent_value.GetScalar().ULongLong(LLDB_INVALID_ADDRESS);
+  const lldb::addr_t child_addr =
+      child_value.GetScalar().ULongLong(LLDB_INVALID_ADDRESS);
+  if (parent_addr == LLDB_INVALID_ADDRESS ||
+      child_addr == LLDB_INVALID_ADDRESS || child_addr < parent_addr)
+    return false;
+  const lldb::offset_t offset = child_addr - parent_addr;
+  if (offset + byte_size > parent_data.GetByteSize())
+    return false;
+  return data.SetData(parent_data, offset, byte_size) == byte_size;
+}
+
 ValueObjectChild::ValueObjectChild(
     ValueObject &parent, const CompilerType &compiler_type,
     ConstString name, uint64_t byte_size, int32_t byte_offset,
@@ -129,6 +155,9 @@ bool ValueObjectChild::UpdateValue() {
       const bool is_instance_ptr_base =
           ((m_is_base_class) &&
            (parent_type_flags.AnySet(lldb::eTypeInstanceIsPointer)));
+      // Whether this child lies inside the parent's own storage, so the
+      // parent's bytes (if it has any) can be shared rather than re-read.
+      bool is_in_parent_storage = false;
 
       if (parent->GetCompilerType().ShouldTreatScalarValueAsAddress()) {
         lldb::addr_t addr = parent->GetPointerValue();
@@ -205,6 +234,7 @@ bool ValueObjectChild::UpdateValue() {
             // Set this object's scalar value to the address of its value by
             // adding its byte offset to the parent address
             m_value.GetScalar() += GetByteOffset();
+            is_in_parent_storage = true;
 
             // If a bitfield doesn't fit into the child_byte_size'd
             // window at child_byte_offset, move the window forward
@@ -254,11 +284,21 @@ bool ValueObjectChild::UpdateValue() {
         const bool thread_and_frame_only_if_stopped = true;
         ExecutionContext exe_ctx(
             GetExecutionContextRef().Lock(thread_and_frame_only_if_stopped));
-        if (GetCompilerType().GetTypeInfo() & lldb::eTypeHasValue) {
+        // Sharing is free, so aggregates take a slice too: that is what
+        // lets their own children skip the read when expanding deep structs.
+        if (is_in_parent_storage &&
+            SliceParentData(parent->GetValue(), parent->GetDataExtractor(),
+                            m_value,
+                            m_value.GetValueByteSize(nullptr, &exe_ctx),
+                            m_data)) {
+          m_error.Clear();
+        } else if (GetCompilerType().GetTypeInfo() & lldb::eTypeHasValue) {
           Value &value = is_instance_ptr_base ? m_parent->GetValue() : m_value;
           m_error =
               value.GetValueAsData(&exe_ctx, m_data, GetModule().get());
         } else {
+          // Drop any slice taken on an earlier update.
+          m_data.SetData(lldb::DataBufferSP());
           m_error.Clear(); // No value so nothing to read...
         }
       }
@@ -90,7 +90,9 @@ ValueObject *ValueObjectConstResultImpl::CreateChildAtIndex(
     if (!child_name_str.empty())
       child_name.SetCString(child_name_str.c_str());
 
-    valobj = new ValueObjectConstResultChild(
+    void *storage =
+        m_impl_backend->GetManager()->Allocate<ValueObjectConstResultChild>();
+    valobj = new (storage) ValueObjectConstResultChild(
         *m_impl_backend, child_compiler_type, child_name, child_byte_size,
         child_byte_offset, child_bitfield_bit_size, child_bitfield_bit_offset,
         child_is_base_class, child_is_deref_of_parent,
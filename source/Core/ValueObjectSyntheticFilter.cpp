@@ -220,6 +220,19 @@ bool ValueObjectSynthetic::UpdateValue() {
   return true;
 }
 
+void ValueObjectSynthetic::PrefetchChildren(size_t start, size_t count) {
+  UpdateValueIfNeeded();
+  if (!m_synth_filter_up)
+    return;
+  // Skip the front end if the window is already cached, as when the same
+  // page of children is displayed again.
+  ValueObject *valobj;
+  if (m_children_byindex.GetValueForKey(start, valobj) &&
+      m_children_byindex.GetValueForKey(start + count - 1, valobj))
+    return;
+  m_synth_filter_up->PrefetchChildren(start, count);
+}
+
 lldb::ValueObjectSP ValueObjectSynthetic::GetChildAtIndex(size_t idx,
                                                           bool can_create) {
   Log *log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_DATAFORMATTERS);
@@ -12,6 +12,8 @@
 
 #include "lldb/DataFormatters/FormatCache.h"
 
+#include "llvm/ADT/Hashing.h"
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -101,27 +103,40 @@ void FormatCache::Entry::SetValidator(lldb::TypeValidatorImplSP validator_sp) {
 }
 
 FormatCache::FormatCache()
-    : m_map(), m_mutex()
-#ifdef LLDB_CONFIGURATION_DEBUG
-      ,
-      m_cache_hits(0), m_cache_misses(0)
-#endif
-{
-}
-
-FormatCache::Entry &FormatCache::GetEntry(ConstString type) {
-  auto i = m_map.find(type), e = m_map.end();
-  if (i != e)
-    return i->second;
-  m_map[type] = FormatCache::Entry();
-  return m_map[type];
+    : m_generation(0), m_cache_hits(0), m_cache_misses(0) {}
+
+FormatCache::Shard &FormatCache::GetShard(ConstString type) {
+  // ConstStrings are uniqued, so their address identifies the type name.
+  size_t hash = llvm::hash_value(type.GetCString());
+  return m_shards[hash % g_num_shards];
+}
+
+bool FormatCache::GetEntry(ConstString type, Entry &entry) {
+  Shard &shard = GetShard(type);
+  llvm::sys::ScopedReader lock(shard.m_mutex);
+  if (shard.m_generation != m_generation)
+    return false;
+  auto i = shard.m_map.find(type);
+  if (i == shard.m_map.end())
+    return false;
+  entry = i->second;
+  return true;
+}
+
+FormatCache::Entry &FormatCache::GetEntryForUpdate(Shard &shard,
+                                                   ConstString type) {
+  uint32_t generation = m_generation;
+  if (shard.m_generation != generation) {
+    shard.m_map.clear();
+    shard.m_generation = generation;
+  }
+  return shard.m_map[type];
 }
 
 bool FormatCache::GetFormat(ConstString type,
                             lldb::TypeFormatImplSP &format_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  auto entry = GetEntry(type);
-  if (entry.IsFormatCached()) {
+  Entry entry;
+  if (GetEntry(type, entry) && entry.IsFormatCached()) {
 #ifdef LLDB_CONFIGURATION_DEBUG
     m_cache_hits++;
 #endif
@@ -137,9 +152,8 @@ bool FormatCache::GetFormat(ConstString type,
 
 bool FormatCache::GetSummary(ConstString type,
                              lldb::TypeSummaryImplSP &summary_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  auto entry = GetEntry(type);
-  if (entry.IsSummaryCached()) {
+  Entry entry;
+  if (GetEntry(type, entry) && entry.IsSummaryCached()) {
 #ifdef LLDB_CONFIGURATION_DEBUG
     m_cache_hits++;
 #endif
@@ -155,9 +169,8 @@ bool FormatCache::GetSummary(ConstString type,
 
 bool FormatCache::GetSynthetic(ConstString type,
                                lldb::SyntheticChildrenSP &synthetic_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  auto entry = GetEntry(type);
-  if (entry.IsSyntheticCached()) {
+  Entry entry;
+  if (GetEntry(type, entry) && entry.IsSyntheticCached()) {
 #ifdef LLDB_CONFIGURATION_DEBUG
     m_cache_hits++;
 #endif
@@ -173,9 +186,8 @@ bool FormatCache::GetSynthetic(ConstString type,
 
 bool FormatCache::GetValidator(ConstString type,
                                lldb::TypeValidatorImplSP &validator_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  auto entry = GetEntry(type);
-  if (entry.IsValidatorCached()) {
+  Entry entry;
+  if (GetEntry(type, entry) && entry.IsValidatorCached()) {
 #ifdef LLDB_CONFIGURATION_DEBUG
     m_cache_hits++;
 #endif
@@ -191,29 +203,30 @@ bool FormatCache::GetValidator(ConstString type,
 
 void FormatCache::SetFormat(ConstString type,
                             lldb::TypeFormatImplSP &format_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  GetEntry(type).SetFormat(format_sp);
+  Shard &shard = GetShard(type);
+  llvm::sys::ScopedWriter lock(shard.m_mutex);
+  GetEntryForUpdate(shard, type).SetFormat(format_sp);
 }
 
 void FormatCache::SetSummary(ConstString type,
                              lldb::TypeSummaryImplSP &summary_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  GetEntry(type).SetSummary(summary_sp);
+  Shard &shard = GetShard(type);
+  llvm::sys::ScopedWriter lock(shard.m_mutex);
+  GetEntryForUpdate(shard, type).SetSummary(summary_sp);
 }
 
 void FormatCache::SetSynthetic(ConstString type,
                                lldb::SyntheticChildrenSP &synthetic_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  GetEntry(type).SetSynthetic(synthetic_sp);
+  Shard &shard = GetShard(type);
+  llvm::sys::ScopedWriter lock(shard.m_mutex);
+  GetEntryForUpdate(shard, type).SetSynthetic(synthetic_sp);
 }
 
 void FormatCache::SetValidator(ConstString type,
                                lldb::TypeValidatorImplSP &validator_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  GetEntry(type).SetValidator(validator_sp);
+  Shard &shard = GetShard(type);
+  llvm::sys::ScopedWriter lock(shard.m_mutex);
+  GetEntryForUpdate(shard, type).SetValidator(validator_sp);
 }
 
-void FormatCache::Clear() {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  m_map.clear();
-}
+void FormatCache::Clear() { ++m_generation; }
@@ -27,7 +27,7 @@ FormattersMatchData::FormattersMatchData(ValueObject &valobj,
   m_candidate_languages = FormatManager::GetCandidateLanguages(valobj);
 }
 
-FormattersMatchVector FormattersMatchData::GetMatchesVector() {
+const FormattersMatchVector &FormattersMatchData::GetMatchesVector() {
   if (!m_formatters_match_vector.second) {
     m_formatters_match_vector.second = true;
     m_formatters_match_vector.first =
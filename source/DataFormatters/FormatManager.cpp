@@ -17,6 +17,7 @@
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/Language.h"
 #include "lldb/Utility/Log.h"
+#include "lldb/Utility/Timer.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -639,6 +640,8 @@ FormatManager::GetHardcodedFormat(FormattersMatchData &match_data) {
 lldb::TypeFormatImplSP
 FormatManager::GetFormat(ValueObject &valobj,
                          lldb::DynamicValueType use_dynamic) {
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, LLVM_PRETTY_FUNCTION);
   FormattersMatchData match_data(valobj, use_dynamic);
 
   TypeFormatImplSP retval;
@@ -714,6 +717,8 @@ FormatManager::GetHardcodedSummaryFormat(FormattersMatchData &match_data) {
 lldb::TypeSummaryImplSP
 FormatManager::GetSummaryFormat(ValueObject &valobj,
                                 lldb::DynamicValueType use_dynamic) {
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, LLVM_PRETTY_FUNCTION);
   FormattersMatchData match_data(valobj, use_dynamic);
 
   TypeSummaryImplSP retval;
@@ -788,6 +793,8 @@ FormatManager::GetHardcodedSyntheticChildren(FormattersMatchData &match_data) {
 lldb::SyntheticChildrenSP
 FormatManager::GetSyntheticChildren(ValueObject &valobj,
                                     lldb::DynamicValueType use_dynamic) {
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, LLVM_PRETTY_FUNCTION);
   FormattersMatchData match_data(valobj, use_dynamic);
 
   SyntheticChildrenSP retval;
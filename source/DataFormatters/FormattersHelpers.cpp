@@ -12,6 +12,7 @@
 
 #include "lldb/DataFormatters/FormattersHelpers.h"
 
+#include "lldb/Target/Process.h"
 #include "lldb/Target/StackFrame.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
@@ -143,3 +144,32 @@ lldb_private::formatters::GetArrayAddressOrPointerValue(ValueObject &valobj) {
 
   return data_addr;
 }
+
+void ArrayElementPrefetcher::Reset(lldb::addr_t start, size_t count,
+                                   uint64_t element_size) {
+  m_start = start;
+  m_count = count;
+  m_element_size = element_size;
+  m_first = m_end = 0;
+}
+
+void ArrayElementPrefetcher::Prefetch(Process &process, size_t idx) {
+  if (m_start == LLDB_INVALID_ADDRESS || m_element_size == 0 ||
+      idx >= m_count || process.GetDisableMemoryCache())
+    return;
+  if (m_stop_id == process.GetStopID() && idx >= m_first && idx < m_end)
+    return;
+
+  // The memory cache only serves reads that lie within a single earlier
+  // read, so read whole elements.
+  const uint64_t max_read_size = 1024 * 1024;
+  const size_t count = std::min<uint64_t>(
+      m_count - idx, std::max<uint64_t>(1, max_read_size / m_element_size));
+  std::vector<uint8_t> buffer(count * m_element_size);
+  Status error;
+  const size_t bytes_read = process.ReadMemory(
+      m_start + idx * m_element_size, buffer.data(), buffer.size(), error);
+  m_stop_id = process.GetStopID();
+  m_first = idx;
+  m_end = idx + bytes_read / m_element_size;
+}
@@ -21,6 +21,7 @@
 #include <ctype.h>
 #include <locale>
 #include <memory>
+#include <string.h>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -473,7 +474,7 @@ bool StringPrinter::ReadStringAndDumpToStream<
   // since we tend to accept partial data (and even partially malformed data)
   // we might end up with no NULL terminator before the end_ptr hence we need
   // to take a slower route and ensure we stay within boundaries
-  for (uint8_t *data = buffer_sp->GetBytes(); *data && (data < data_end);) {
+  for (uint8_t *data = buffer_sp->GetBytes(); (data < data_end) && *data;) {
     if (escape_non_printables) {
       uint8_t *next_data = nullptr;
       auto printable = escaping_callback(data, data_end, next_data);
@@ -486,12 +487,14 @@ bool StringPrinter::ReadStringAndDumpToStream<
         printable_size = 1;
         next_data = data + 1;
       }
-      for (unsigned c = 0; c < printable_size; c++)
-        options.GetStream()->Printf("%c", *(printable_bytes + c));
+      options.GetStream()->Write(printable_bytes, printable_size);
       data = (uint8_t *)next_data;
     } else {
-      options.GetStream()->Printf("%c", *data);
-      data++;
+      // Without escaping, everything up to the terminator is printed as is.
+      const void *nul = ::memchr(data, 0, data_end - data);
+      uint8_t *end = nul ? (uint8_t *)nul : data_end;
+      options.GetStream()->Write(data, end - data);
+      data = end;
     }
   }
 
@@ -567,9 +570,7 @@ static bool ReadUTFBufferAndDumpToStream(
     process_sp->ReadStringFromMemory(options.GetLocation(), buffer,
                                      bufferSPSize, error, type_width);
   else
-    process_sp->ReadMemoryFromInferior(options.GetLocation(),
-                                       (char *)buffer_sp->GetBytes(),
-                                       bufferSPSize, error);
+    process_sp->ReadMemory(options.GetLocation(), buffer, bufferSPSize, error);
 
   if (error.Fail()) {
     options.GetStream()->Printf("unable to read data");
@@ -11,6 +11,7 @@
 #include "lldb/Core/ValueObject.h"
 #include "lldb/DataFormatters/DataVisualization.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
+#include "lldb/Interpreter/ScriptInterpreter.h"
 #include "lldb/Target/Language.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/Stream.h"
@@ -691,14 +692,43 @@ void ValueObjectPrinter::PrintChildren(
   if (num_children) {
     bool any_children_printed = false;
 
-    for (size_t idx = 0; idx < num_children; ++idx) {
-      if (ValueObjectSP child_sp = GenerateChild(synth_m_valobj, idx)) {
-        if (!any_children_printed) {
-          PrintChildrenPreamble();
-          any_children_printed = true;
-        }
-        PrintChild(child_sp, curr_ptr_depth);
+    auto print_child = [&](ValueObjectSP child_sp) {
+      if (!any_children_printed) {
+        PrintChildrenPreamble();
+        any_children_printed = true;
       }
+      PrintChild(child_sp, curr_ptr_depth);
+    };
+
+    TargetSP target_sp = m_valobj->GetTargetSP();
+    size_t idx = 0;
+    if (!m_options.m_pointer_as_array && target_sp &&
+        target_sp->GetBatchChildSummaries()) {
+      std::vector<ValueObjectSP> children =
+          synth_m_valobj->GetChildrenInRange(0, num_children, true);
+      // Take the script interpreter lock once for all the children, rather
+      // than once for each of their summaries.
+      std::unique_ptr<ScriptInterpreterLocker> script_lock;
+      bool has_script_summary =
+          llvm::any_of(children, [](const ValueObjectSP &child_sp) {
+            TypeSummaryImplSP summary_sp = child_sp->GetSummaryFormat();
+            return summary_sp &&
+                   summary_sp->GetKind() == TypeSummaryImpl::Kind::eScript;
+          });
+      if (has_script_summary)
+        if (ScriptInterpreter *interpreter =
+                target_sp->GetDebugger().GetScriptInterpreter(false))
+          script_lock = interpreter->AcquireInterpreterLock();
+      for (ValueObjectSP &child_sp : children)
+        print_child(child_sp);
+      // The range stops at the first child that can't be generated; skip it
+      // and print the remaining ones one at a time.
+      idx = children.size() + 1;
+    }
+
+    for (; idx < num_children; ++idx) {
+      if (ValueObjectSP child_sp = GenerateChild(synth_m_valobj, idx))
+        print_child(child_sp);
     }
 
     if (any_children_printed)
@@ -580,6 +580,50 @@ static bool ReadRegisterValueAsScalar(RegisterContext *reg_ctx,
   return false;
 }
 
+/// Evaluate \a opcodes without setting up the stack machine if they are a
+/// single DW_OP_fbreg, DW_OP_bregN or DW_OP_bregx, which is how most variables
+/// that live on the stack are described. Returns llvm::None for any other
+/// expression, and when the general evaluator should report the error.
+static llvm::Optional<bool>
+EvaluateRegisterRelative(ExecutionContext *exe_ctx, RegisterContext *reg_ctx,
+                         const DataExtractor &opcodes,
+                         const lldb::RegisterKind reg_kind, Value &result,
+                         Status *error_ptr) {
+  lldb::offset_t offset = 0;
+  const uint8_t op = opcodes.GetU8(&offset);
+  uint32_t reg_num = LLDB_INVALID_REGNUM;
+  if (op >= DW_OP_breg0 && op <= DW_OP_breg31)
+    reg_num = op - DW_OP_breg0;
+  else if (op == DW_OP_bregx)
+    reg_num = opcodes.GetULEB128(&offset);
+  else if (op != DW_OP_fbreg)
+    return llvm::None;
+  const int64_t op_offset = opcodes.GetSLEB128(&offset);
+  if (offset != opcodes.GetByteSize())
+    return llvm::None;
+
+  Value tmp;
+  if (op == DW_OP_fbreg) {
+    StackFrame *frame = exe_ctx ? exe_ctx->GetFramePtr() : nullptr;
+    if (!frame)
+      return llvm::None;
+    Scalar value;
+    if (!frame->GetFrameBaseValue(value, error_ptr))
+      return false;
+    value += op_offset;
+    tmp = Value(value);
+  } else {
+    if (!ReadRegisterValueAsScalar(reg_ctx, reg_kind, reg_num, error_ptr,
+                                   tmp))
+      return false;
+    tmp.ResolveValue(exe_ctx) += (uint64_t)op_offset;
+    tmp.ClearContext();
+  }
+  tmp.SetValueType(Value::eValueTypeLoadAddress);
+  result = tmp;
+  return true;
+}
+
 static offset_t GetOpcodeDataSize(const DataExtractor &data,
                                   const lldb::offset_t data_offset,
                                   const uint8_t op) {
@@ -1018,7 +1062,7 @@ bool DWARFExpression::LocationListContainsAddress(
 
 bool DWARFExpression::GetLocation(addr_t base_addr, addr_t pc,
                                   lldb::offset_t &offset,
-                                  lldb::offset_t &length) {
+                                  lldb::offset_t &length) const {
   offset = 0;
   if (!IsLocationList()) {
     length = m_data.GetByteSize();
@@ -1163,7 +1207,6 @@ bool DWARFExpression::Evaluate(
           "no location, value may have been optimized out");
     return false;
   }
-  std::vector<Value> stack;
 
   Process *process = nullptr;
   StackFrame *frame = nullptr;
@@ -1175,6 +1218,17 @@ bool DWARFExpression::Evaluate(
   if (reg_ctx == nullptr && frame)
     reg_ctx = frame->GetRegisterContext().get();
 
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
+
+  // The verbose log shows the stack after every operation, so only take the
+  // shortcut without it.
+  if (!log || !log->GetVerbose()) {
+    if (llvm::Optional<bool> success = EvaluateRegisterRelative(
+            exe_ctx, reg_ctx, opcodes, reg_kind, result, error_ptr))
+      return *success;
+  }
+
+  std::vector<Value> stack;
   if (initial_value_ptr)
     stack.push_back(*initial_value_ptr);
 
@@ -1186,8 +1240,6 @@ bool DWARFExpression::Evaluate(
   uint64_t op_piece_offset = 0;
   Value pieces; // Used for DW_OP_piece
 
-  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
-
   while (opcodes.ValidOffset(offset)) {
     const lldb::offset_t op_offset = offset;
     const uint8_t op = opcodes.GetU8(&offset);
@@ -2708,6 +2760,386 @@ bool DWARFExpression::Evaluate(
   return true; // Return true on success
 }
 
+bool DWARFExpression::CompileToAgentExpression(
+    Target *target, addr_t loclist_base_file_addr, addr_t pc_file_addr,
+    const DWARFExpression *frame_base, uint32_t byte_size,
+    llvm::function_ref<bool(lldb::RegisterKind, uint32_t, uint32_t &)>
+        map_register,
+    llvm::function_ref<bool(AgentExpression &)> push_cfa,
+    AgentExpression &expr) const {
+  if (byte_size == 0 || byte_size > sizeof(uint64_t))
+    return false;
+
+  AgentLocationKind kind;
+  uint32_t remote_regnum;
+  if (!CompileLocationToAgentExpression(target, loclist_base_file_addr,
+                                        pc_file_addr, frame_base, map_register,
+                                        push_cfa, expr, kind, remote_regnum))
+    return false;
+
+  switch (kind) {
+  case eAgentLocationMemory:
+    // References are zero extended already.
+    return expr.AppendReference(byte_size);
+  case eAgentLocationRegister:
+    expr.AppendRegister(remote_regnum);
+    break;
+  case eAgentLocationValue:
+    break;
+  }
+  if (byte_size < sizeof(uint64_t))
+    expr.AppendExtend(byte_size * 8, false);
+  return true;
+}
+
+bool DWARFExpression::CompileLocationToAgentExpression(
+    Target *target, addr_t loclist_base_file_addr, addr_t pc_file_addr,
+    const DWARFExpression *frame_base,
+    llvm::function_ref<bool(lldb::RegisterKind, uint32_t, uint32_t &)>
+        map_register,
+    llvm::function_ref<bool(AgentExpression &)> push_cfa,
+    AgentExpression &expr, AgentLocationKind &kind,
+    uint32_t &remote_regnum) const {
+  lldb::offset_t offset = 0;
+  lldb::offset_t length = 0;
+  if (!GetLocation(loclist_base_file_addr, pc_file_addr, offset, length) ||
+      length == 0)
+    return false;
+  const DataExtractor opcodes(m_data, offset, length);
+  ModuleSP module_sp = m_module_wp.lock();
+
+  auto append_register = [&](uint32_t reg_num) {
+    uint32_t remote;
+    if (!map_register(m_reg_kind, reg_num, remote) || remote > UINT16_MAX)
+      return false;
+    expr.AppendRegister(remote);
+    return true;
+  };
+
+  // Track the depth of the DWARF stack so that malformed expressions are
+  // rejected here instead of in the stub.
+  size_t depth = 0;
+  kind = eAgentLocationMemory;
+  offset = 0;
+  while (opcodes.ValidOffset(offset)) {
+    const uint8_t op = opcodes.GetU8(&offset);
+    switch (op) {
+    case DW_OP_addr:
+    case DW_OP_addrx:
+    case DW_OP_GNU_addr_index: {
+      addr_t file_addr;
+      if (op == DW_OP_addr)
+        file_addr = opcodes.GetAddress(&offset);
+      else if (m_dwarf_cu)
+        file_addr = ReadAddressFromDebugAddrSection(m_dwarf_cu,
+                                                    opcodes.GetULEB128(&offset));
+      else
+        return false;
+      Address so_addr;
+      if (!target || !module_sp ||
+          !module_sp->ResolveFileAddress(file_addr, so_addr))
+        return false;
+      const addr_t load_addr = so_addr.GetLoadAddress(target);
+      if (load_addr == LLDB_INVALID_ADDRESS)
+        return false;
+      expr.AppendConstant(load_addr);
+      ++depth;
+      break;
+    }
+
+    case DW_OP_const1u:
+      expr.AppendConstant(opcodes.GetU8(&offset));
+      ++depth;
+      break;
+    case DW_OP_const1s:
+      expr.AppendConstant((int8_t)opcodes.GetU8(&offset));
+      ++depth;
+      break;
+    case DW_OP_const2u:
+      expr.AppendConstant(opcodes.GetU16(&offset));
+      ++depth;
+      break;
+    case DW_OP_const2s:
+      expr.AppendConstant((int16_t)opcodes.GetU16(&offset));
+      ++depth;
+      break;
+    case DW_OP_const4u:
+      expr.AppendConstant(opcodes.GetU32(&offset));
+      ++depth;
+      break;
+    case DW_OP_const4s:
+      expr.AppendConstant((int32_t)opcodes.GetU32(&offset));
+      ++depth;
+      break;
+    case DW_OP_const8u:
+    case DW_OP_const8s:
+      expr.AppendConstant(opcodes.GetU64(&offset));
+      ++depth;
+      break;
+    case DW_OP_constu:
+      expr.AppendConstant(opcodes.GetULEB128(&offset));
+      ++depth;
+      break;
+    case DW_OP_consts:
+      expr.AppendConstant(opcodes.GetSLEB128(&offset));
+      ++depth;
+      break;
+
+    case DW_OP_lit0:
+    case DW_OP_lit1:
+    case DW_OP_lit2:
+    case DW_OP_lit3:
+    case DW_OP_lit4:
+    case DW_OP_lit5:
+    case DW_OP_lit6:
+    case DW_OP_lit7:
+    case DW_OP_lit8:
+    case DW_OP_lit9:
+    case DW_OP_lit10:
+    case DW_OP_lit11:
+    case DW_OP_lit12:
+    case DW_OP_lit13:
+    case DW_OP_lit14:
+    case DW_OP_lit15:
+    case DW_OP_lit16:
+    case DW_OP_lit17:
+    case DW_OP_lit18:
+    case DW_OP_lit19:
+    case DW_OP_lit20:
+    case DW_OP_lit21:
+    case DW_OP_lit22:
+    case DW_OP_lit23:
+    case DW_OP_lit24:
+    case DW_OP_lit25:
+    case DW_OP_lit26:
+    case DW_OP_lit27:
+    case DW_OP_lit28:
+    case DW_OP_lit29:
+    case DW_OP_lit30:
+    case DW_OP_lit31:
+      expr.AppendConstant(op - DW_OP_lit0);
+      ++depth;
+      break;
+
+    case DW_OP_reg0:
+    case DW_OP_reg1:
+    case DW_OP_reg2:
+    case DW_OP_reg3:
+    case DW_OP_reg4:
+    case DW_OP_reg5:
+    case DW_OP_reg6:
+    case DW_OP_reg7:
+    case DW_OP_reg8:
+    case DW_OP_reg9:
+    case DW_OP_reg10:
+    case DW_OP_reg11:
+    case DW_OP_reg12:
+    case DW_OP_reg13:
+    case DW_OP_reg14:
+    case DW_OP_reg15:
+    case DW_OP_reg16:
+    case DW_OP_reg17:
+    case DW_OP_reg18:
+    case DW_OP_reg19:
+    case DW_OP_reg20:
+    case DW_OP_reg21:
+    case DW_OP_reg22:
+    case DW_OP_reg23:
+    case DW_OP_reg24:
+    case DW_OP_reg25:
+    case DW_OP_reg26:
+    case DW_OP_reg27:
+    case DW_OP_reg28:
+    case DW_OP_reg29:
+    case DW_OP_reg30:
+    case DW_OP_reg31:
+    case DW_OP_regx: {
+      // A register location has to be the whole expression.
+      const uint32_t reg_num =
+          op == DW_OP_regx ? opcodes.GetULEB128(&offset) : op - DW_OP_reg0;
+      if (depth != 0 || opcodes.ValidOffset(offset))
+        return false;
+      if (!map_register(m_reg_kind, reg_num, remote_regnum) ||
+          remote_regnum > UINT16_MAX)
+        return false;
+      kind = eAgentLocationRegister;
+      return true;
+    }
+
+    case DW_OP_breg0:
+    case DW_OP_breg1:
+    case DW_OP_breg2:
+    case DW_OP_breg3:
+    case DW_OP_breg4:
+    case DW_OP_breg5:
+    case DW_OP_breg6:
+    case DW_OP_breg7:
+    case DW_OP_breg8:
+    case DW_OP_breg9:
+    case DW_OP_breg10:
+    case DW_OP_breg11:
+    case DW_OP_breg12:
+    case DW_OP_breg13:
+    case DW_OP_breg14:
+    case DW_OP_breg15:
+    case DW_OP_breg16:
+    case DW_OP_breg17:
+    case DW_OP_breg18:
+    case DW_OP_breg19:
+    case DW_OP_breg20:
+    case DW_OP_breg21:
+    case DW_OP_breg22:
+    case DW_OP_breg23:
+    case DW_OP_breg24:
+    case DW_OP_breg25:
+    case DW_OP_breg26:
+    case DW_OP_breg27:
+    case DW_OP_breg28:
+    case DW_OP_breg29:
+    case DW_OP_breg30:
+    case DW_OP_breg31:
+    case DW_OP_bregx: {
+      const uint32_t reg_num =
+          op == DW_OP_bregx ? opcodes.GetULEB128(&offset) : op - DW_OP_breg0;
+      const int64_t reg_offset = opcodes.GetSLEB128(&offset);
+      if (!append_register(reg_num))
+        return false;
+      if (reg_offset != 0) {
+        expr.AppendConstant(reg_offset);
+        expr.AppendOpcode(AgentExpression::eOpAdd);
+      }
+      ++depth;
+      break;
+    }
+
+    case DW_OP_fbreg: {
+      const int64_t fbreg_offset = opcodes.GetSLEB128(&offset);
+      if (!frame_base)
+        return false;
+      // The frame base is the value of a register location, or the address
+      // of a memory one.
+      AgentLocationKind fb_kind;
+      uint32_t fb_regnum;
+      if (!frame_base->CompileLocationToAgentExpression(
+              target, loclist_base_file_addr, pc_file_addr, nullptr,
+              map_register, push_cfa, expr, fb_kind, fb_regnum))
+        return false;
+      if (fb_kind == eAgentLocationRegister)
+        expr.AppendRegister(fb_regnum);
+      if (fbreg_offset != 0) {
+        expr.AppendConstant(fbreg_offset);
+        expr.AppendOpcode(AgentExpression::eOpAdd);
+      }
+      ++depth;
+      break;
+    }
+
+    case DW_OP_call_frame_cfa:
+      if (!push_cfa(expr))
+        return false;
+      ++depth;
+      break;
+
+    case DW_OP_plus_uconst: {
+      if (depth < 1)
+        return false;
+      const uint64_t uconst = opcodes.GetULEB128(&offset);
+      if (uconst != 0) {
+        expr.AppendConstant(uconst);
+        expr.AppendOpcode(AgentExpression::eOpAdd);
+      }
+      break;
+    }
+
+    case DW_OP_deref:
+    case DW_OP_deref_size: {
+      const unsigned size = op == DW_OP_deref ? opcodes.GetAddressByteSize()
+                                              : opcodes.GetU8(&offset);
+      if (depth < 1 || !expr.AppendReference(size))
+        return false;
+      break;
+    }
+
+    case DW_OP_dup:
+      if (depth < 1)
+        return false;
+      expr.AppendOpcode(AgentExpression::eOpDup);
+      ++depth;
+      break;
+    case DW_OP_drop:
+      if (depth < 1)
+        return false;
+      expr.AppendOpcode(AgentExpression::eOpPop);
+      --depth;
+      break;
+    case DW_OP_swap:
+      if (depth < 2)
+        return false;
+      expr.AppendOpcode(AgentExpression::eOpSwap);
+      break;
+
+    case DW_OP_not:
+      if (depth < 1)
+        return false;
+      expr.AppendOpcode(AgentExpression::eOpBitNot);
+      break;
+    case DW_OP_neg:
+      if (depth < 1)
+        return false;
+      expr.AppendConstant(0);
+      expr.AppendOpcode(AgentExpression::eOpSwap);
+      expr.AppendOpcode(AgentExpression::eOpSub);
+      break;
+
+    case DW_OP_plus:
+    case DW_OP_minus:
+    case DW_OP_mul:
+    case DW_OP_and:
+    case DW_OP_or:
+    case DW_OP_xor:
+      if (depth < 2)
+        return false;
+      switch (op) {
+      case DW_OP_plus:
+        expr.AppendOpcode(AgentExpression::eOpAdd);
+        break;
+      case DW_OP_minus:
+        expr.AppendOpcode(AgentExpression::eOpSub);
+        break;
+      case DW_OP_mul:
+        expr.AppendOpcode(AgentExpression::eOpMul);
+        break;
+      case DW_OP_and:
+        expr.AppendOpcode(AgentExpression::eOpBitAnd);
+        break;
+      case DW_OP_or:
+        expr.AppendOpcode(AgentExpression::eOpBitOr);
+        break;
+      case DW_OP_xor:
+        expr.AppendOpcode(AgentExpression::eOpBitXor);
+        break;
+      }
+      --depth;
+      break;
+
+    case DW_OP_nop:
+      break;
+
+    case DW_OP_stack_value:
+      if (depth < 1 || opcodes.ValidOffset(offset))
+        return false;
+      kind = eAgentLocationValue;
+      return true;
+
+    default:
+      // Pieces, implicit values, thread local storage, calls and the
+      // vendor extensions need more than the bytecode has to offer.
+      return false;
+    }
+  }
+  return depth >= 1;
+}
+
 bool DWARFExpression::AddressRangeForLocationListEntry(
     const DWARFUnit *dwarf_cu, const DataExtractor &debug_loc_data,
     lldb::offset_t *offset_ptr, lldb::addr_t &low_pc, lldb::addr_t &high_pc) {
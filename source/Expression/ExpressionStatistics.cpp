@@ -0,0 +1,54 @@
+//===-- ExpressionStatistics.cpp --------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Expression/ExpressionStatistics.h"
+#include "lldb/Utility/Stream.h"
+
+using namespace lldb_private;
+
+const char *ExpressionStatistics::GetPhaseName(Phase phase) {
+  switch (phase) {
+  case eParse:
+    return "parse";
+  case eSema:
+    return "sema";
+  case eSIL:
+    return "sil";
+  case eIRGen:
+    return "irgen";
+  case eJIT:
+    return "jit";
+  case eMaterialize:
+    return "materialize";
+  case eRun:
+    return "run";
+  case eDematerialize:
+    return "dematerialize";
+  case eTotal:
+    return "total";
+  case kNumPhases:
+    break;
+  }
+  llvm_unreachable("invalid expression phase");
+}
+
+void ExpressionStatistics::Dump(Stream &s) const {
+  for (int i = 0; i < kNumPhases; ++i) {
+    Phase phase = static_cast<Phase>(i);
+    s.Printf("%-14s %10.3f ms\n", GetPhaseName(phase), Get(phase) * 1000.);
+  }
+}
+
+StructuredData::DictionarySP ExpressionStatistics::GetAsStructuredData() const {
+  auto dict_sp = std::make_shared<StructuredData::Dictionary>();
+  for (int i = 0; i < kNumPhases; ++i) {
+    Phase phase = static_cast<Phase>(i);
+    dict_sp->AddFloatItem(GetPhaseName(phase), Get(phase));
+  }
+  return dict_sp;
+}
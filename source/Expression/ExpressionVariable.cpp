@@ -11,6 +11,9 @@
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/Log.h"
 
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringExtras.h"
+
 using namespace lldb_private;
 
 ExpressionVariable::~ExpressionVariable() {}
@@ -30,6 +33,100 @@ uint8_t *ExpressionVariable::GetValueBytes() {
 
 PersistentExpressionState::~PersistentExpressionState() {}
 
+size_t
+PersistentExpressionState::AddVariable(const lldb::ExpressionVariableSP &var_sp) {
+  ExpressionVariableList::AddVariable(var_sp);
+  DidAddVariable(var_sp);
+  // Evicting moves the variables after the evicted ones.
+  return GetSize() - 1;
+}
+
+lldb::ExpressionVariableSP
+PersistentExpressionState::AddNewlyConstructedVariable(ExpressionVariable *var) {
+  lldb::ExpressionVariableSP var_sp =
+      ExpressionVariableList::AddNewlyConstructedVariable(var);
+  DidAddVariable(var_sp);
+  return var_sp;
+}
+
+lldb::ExpressionVariableSP
+PersistentExpressionState::GetVariable(ConstString name) {
+  auto pos = m_variables_by_name.find(name.GetCString());
+  if (pos == m_variables_by_name.end())
+    return nullptr;
+  auto result_pos = m_result_positions.find(pos->second.get());
+  if (result_pos != m_result_positions.end())
+    m_results.splice(m_results.begin(), m_results, result_pos->second);
+  return pos->second;
+}
+
+lldb::ExpressionVariableSP
+PersistentExpressionState::GetVariable(llvm::StringRef name) {
+  if (name.empty())
+    return nullptr;
+  return GetVariable(ConstString(name));
+}
+
+void PersistentExpressionState::RemoveVariable(
+    lldb::ExpressionVariableSP var_sp) {
+  ExpressionVariableList::RemoveVariable(var_sp);
+  if (!var_sp)
+    return;
+
+  auto result_pos = m_result_positions.find(var_sp.get());
+  if (result_pos != m_result_positions.end()) {
+    m_results.erase(result_pos->second);
+    m_result_positions.erase(result_pos);
+  }
+
+  // Another variable with the same name may be found now.
+  ConstString name = var_sp->GetName();
+  auto pos = m_variables_by_name.find(name.GetCString());
+  if (pos == m_variables_by_name.end() || pos->second != var_sp)
+    return;
+  m_variables_by_name.erase(pos);
+  if (lldb::ExpressionVariableSP other_sp =
+          ExpressionVariableList::GetVariable(name))
+    m_variables_by_name[name.GetCString()] = other_sp;
+}
+
+void PersistentExpressionState::Clear() {
+  ExpressionVariableList::Clear();
+  m_variables_by_name.clear();
+  m_results.clear();
+  m_result_positions.clear();
+}
+
+bool PersistentExpressionState::IsResultVariableName(ConstString name) const {
+  for (bool is_error : {false, true}) {
+    llvm::StringRef number = name.GetStringRef();
+    if (number.consume_front(GetPersistentVariablePrefix(is_error)) &&
+        !number.empty() && llvm::all_of(number, llvm::isDigit))
+      return true;
+  }
+  return false;
+}
+
+void PersistentExpressionState::DidAddVariable(
+    const lldb::ExpressionVariableSP &var_sp) {
+  if (!var_sp)
+    return;
+  ConstString name = var_sp->GetName();
+  m_variables_by_name.try_emplace(name.GetCString(), var_sp);
+  if (!IsResultVariableName(name))
+    return;
+
+  m_results.push_front(var_sp);
+  m_result_positions[var_sp.get()] = m_results.begin();
+  while (m_max_results && m_results.size() > m_max_results) {
+    lldb::ExpressionVariableSP evicted_sp = m_results.back();
+    m_results.pop_back();
+    m_result_positions.erase(evicted_sp.get());
+    EvictResultVariable(evicted_sp);
+    ++m_num_evicted;
+  }
+}
+
 void PersistentExpressionState::RegisterSymbol(ConstString name,
                                                lldb::addr_t addr) {
   m_symbol_map[name.GetCString()] = addr;
@@ -89,5 +186,7 @@ ConstString PersistentExpressionState::GetNextPersistentVariableName(
     llvm::raw_svector_ostream os(name);
     os << Prefix << target.GetNextPersistentVariableIndex();
   }
+  // A new result variable is about to be added, pick up the current limit.
+  m_max_results = target.GetMaxExpressionResults();
   return ConstString(name);
 }
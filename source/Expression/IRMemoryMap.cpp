@@ -510,6 +510,14 @@ bool IRMemoryMap::GetAllocSize(lldb::addr_t address, size_t &size) {
   return true;
 }
 
+IRMemoryMap::AllocationPolicy
+IRMemoryMap::GetAllocationPolicy(lldb::addr_t address) {
+  AllocationMap::iterator iter = FindAllocation(address, 1);
+  if (iter == m_allocations.end())
+    return eAllocationPolicyInvalid;
+  return iter->second.m_policy;
+}
+
 void IRMemoryMap::WriteMemory(lldb::addr_t process_address,
                               const uint8_t *bytes, size_t size,
                               Status &error) {
@@ -113,9 +113,14 @@ LLVMUserExpression::DoExecute(DiagnosticManager &diagnostic_manager,
       function_stack_bottom = m_stack_frame_bottom;
       function_stack_top = m_stack_frame_top;
 
-      IRInterpreter::Interpret(*module, *function, args, *m_execution_unit_sp,
-                               interpreter_error, function_stack_bottom,
-                               function_stack_top, exe_ctx);
+      {
+        ExpressionPhaseTimer timer(options.GetStatistics(),
+                                   ExpressionStatistics::eRun);
+        IRInterpreter::Interpret(*module, *function, args,
+                                 *m_execution_unit_sp, interpreter_error,
+                                 function_stack_bottom, function_stack_top,
+                                 exe_ctx);
+      }
 
       if (!interpreter_error.Success()) {
         diagnostic_manager.Printf(eDiagnosticSeverityError,
@@ -168,9 +173,12 @@ LLVMUserExpression::DoExecute(DiagnosticManager &diagnostic_manager,
       if (exe_ctx.GetProcessPtr())
         exe_ctx.GetProcessPtr()->SetRunningUserExpression(true);
 
+      ExpressionPhaseTimer run_timer(options.GetStatistics(),
+                                     ExpressionStatistics::eRun);
       lldb::ExpressionResults execution_result =
           exe_ctx.GetProcessRef().RunThreadPlan(exe_ctx, call_plan_sp, options,
                                                 diagnostic_manager);
+      run_timer.Stop();
 
       if (exe_ctx.GetProcessPtr())
         exe_ctx.GetProcessPtr()->SetRunningUserExpression(false);
@@ -284,6 +292,8 @@ bool LLVMUserExpression::FinalizeJITExecution(
 
   LLDB_LOGF(log, "-- [UserExpression::FinalizeJITExecution] Dematerializing "
                  "after execution --");
+  ExpressionPhaseTimer timer(m_options.GetStatistics(),
+                             ExpressionStatistics::eDematerialize);
 
   if (!m_dematerializer_sp) {
     diagnostic_manager.Printf(eDiagnosticSeverityError,
@@ -318,6 +328,8 @@ bool LLVMUserExpression::FinalizeJITExecution(
 bool LLVMUserExpression::PrepareToExecuteJITExpression(
     DiagnosticManager &diagnostic_manager, ExecutionContext &exe_ctx,
     lldb::addr_t &struct_address) {
+  ExpressionPhaseTimer timer(m_options.GetStatistics(),
+                             ExpressionStatistics::eMaterialize);
   lldb::TargetSP target;
   lldb::ProcessSP process;
   lldb::StackFrameSP frame;
@@ -46,6 +46,18 @@ uint32_t Materializer::AddStructMember(Entity &entity) {
   return ret;
 }
 
+// An interpreted expression reaches memory only through the map, and its
+// argument struct lives in the host. Temporaries hanging off such a struct
+// can stay in the host as well, so evaluating it (a breakpoint condition,
+// say) writes nothing into the inferior.
+static IRMemoryMap::AllocationPolicy
+GetTemporaryAllocationPolicy(IRMemoryMap &map, lldb::addr_t process_address) {
+  if (map.GetAllocationPolicy(process_address) ==
+      IRMemoryMap::eAllocationPolicyHostOnly)
+    return IRMemoryMap::eAllocationPolicyHostOnly;
+  return IRMemoryMap::eAllocationPolicyMirror;
+}
+
 class EntityPersistentVariable : public Materializer::Entity {
 public:
   EntityPersistentVariable(lldb::ExpressionVariableSP &persistent_variable_sp,
@@ -584,7 +596,8 @@ public:
         m_temporary_allocation = map.Malloc(
             data.GetByteSize(), byte_align,
             lldb::ePermissionsReadable | lldb::ePermissionsWritable,
-            IRMemoryMap::eAllocationPolicyMirror, zero_memory, alloc_error);
+            GetTemporaryAllocationPolicy(map, process_address), zero_memory,
+            alloc_error);
 
         m_temporary_allocation_size = data.GetByteSize();
 
@@ -863,7 +876,8 @@ public:
       m_temporary_allocation = map.Malloc(
           *byte_size, byte_align,
           lldb::ePermissionsReadable | lldb::ePermissionsWritable,
-          IRMemoryMap::eAllocationPolicyMirror, zero_memory, alloc_error);
+          GetTemporaryAllocationPolicy(map, process_address), zero_memory,
+          alloc_error);
       m_temporary_allocation_size = *byte_size;
 
       if (!alloc_error.Success()) {
@@ -305,6 +305,7 @@ void REPL::IOHandlerInputComplete(IOHandler &io_handler, std::string &code) {
         return;
       }
       const size_t var_count_before = persistent_state->GetSize();
+      const size_t evicted_before = persistent_state->GetNumEvictedVariables();
 
       const char *expr_prefix = nullptr;
       lldb::ValueObjectSP result_valobj_sp;
@@ -336,8 +337,12 @@ void REPL::IOHandlerInputComplete(IOHandler &io_handler, std::string &code) {
         }
 
         if (debugger.GetPrintDecls()) {
-          for (size_t vi = var_count_before, ve = persistent_state->GetSize();
-               vi != ve; ++vi) {
+          // Result variables that were evicted came before the new ones.
+          const size_t first_new_var =
+              var_count_before -
+              (persistent_state->GetNumEvictedVariables() - evicted_before);
+          for (size_t vi = first_new_var, ve = persistent_state->GetSize();
+               vi < ve; ++vi) {
             lldb::ExpressionVariableSP persistent_var_sp =
                 persistent_state->GetVariableAtIndex(vi);
             lldb::ValueObjectSP valobj_sp = persistent_var_sp->GetValueObject();
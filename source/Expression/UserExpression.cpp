@@ -19,6 +19,7 @@
 
 #include "lldb/Core/Module.h"
 #include "lldb/Core/StreamFile.h"
+#include "lldb/Core/SwiftASTContextReader.h"
 #include "lldb/Core/ValueObjectConstResult.h"
 #include "lldb/Expression/DiagnosticManager.h"
 #include "lldb/Expression/ExpressionVariable.h"
@@ -146,6 +147,8 @@ lldb::ExpressionResults UserExpression::Evaluate(
     ValueObject *ctx_obj) {
   Log *log(lldb_private::GetLogIfAnyCategoriesSet(LIBLLDB_LOG_EXPRESSIONS |
                                                   LIBLLDB_LOG_STEP));
+  ExpressionPhaseTimer total_timer(options.GetStatistics(),
+                                   ExpressionStatistics::eTotal);
 
   if (ctx_obj) {
     static unsigned const ctx_type_mask =
@@ -229,20 +232,46 @@ lldb::ExpressionResults UserExpression::Evaluate(
       language = frame->GetLanguage();
   }
 
-  lldb::UserExpressionSP user_expression_sp(
-      target->GetUserExpressionForLanguage(exe_ctx, expr, full_prefix, language,
-                                           desired_type, options, ctx_obj,
-                                           error));
-  if (error.Fail()) {
-    if (log)
-      LLDB_LOGF(log, "== [UserExpression::Evaluate] Getting expression: %s ==",
-                error.AsCString());
-    return lldb::eExpressionSetupError;
+  // Look for an expression that was already compiled for this context. The
+  // scratch context lock is only held for a cache hit, since a parse may need
+  // to replace the scratch context.
+  PersistentExpressionState *cache_state = nullptr;
+  llvm::Optional<SwiftASTContextLock> cache_lock;
+  std::string cache_key;
+  lldb::UserExpressionSP user_expression_sp;
+  if (language == lldb::eLanguageTypeSwift && !ctx_obj &&
+      target->GetSwiftCacheExpressions()) {
+    if (ExecutionContextScope *exe_scope =
+            exe_ctx.GetBestExecutionContextScope()) {
+      cache_lock.emplace(&exe_ctx);
+      cache_state = target->GetSwiftPersistentExpressionState(*exe_scope);
+    }
+    if (cache_state)
+      cache_key = cache_state->GetUserExpressionCacheKey(exe_ctx, expr,
+                                                         full_prefix, options);
+    if (!cache_key.empty())
+      user_expression_sp = cache_state->GetCachedUserExpression(cache_key);
+    if (!user_expression_sp)
+      cache_lock.reset();
+  }
+  const bool cache_hit = static_cast<bool>(user_expression_sp);
+
+  if (!cache_hit) {
+    user_expression_sp.reset(target->GetUserExpressionForLanguage(
+        exe_ctx, expr, full_prefix, language, desired_type, options, ctx_obj,
+        error));
+    if (error.Fail()) {
+      if (log)
+        LLDB_LOGF(log,
+                  "== [UserExpression::Evaluate] Getting expression: %s ==",
+                  error.AsCString());
+      return lldb::eExpressionSetupError;
+    }
   }
 
   if (log)
-    LLDB_LOGF(log, "== [UserExpression::Evaluate] Parsing expression %s ==",
-              expr.str().c_str());
+    LLDB_LOGF(log, "== [UserExpression::Evaluate] %s expression %s ==",
+              cache_hit ? "Reusing cached" : "Parsing", expr.str().c_str());
 
   const bool keep_expression_in_memory = true;
   const bool generate_debug_info = options.GetGenerateDebugInfo();
@@ -257,6 +286,7 @@ lldb::ExpressionResults UserExpression::Evaluate(
   DiagnosticManager diagnostic_manager;
 
   bool parse_success =
+      cache_hit ||
       user_expression_sp->Parse(diagnostic_manager, exe_ctx, execution_policy,
                                 keep_expression_in_memory, generate_debug_info);
 
@@ -387,6 +417,25 @@ lldb::ExpressionResults UserExpression::Evaluate(
     }
   }
 
+  // Parsing an expression can change the persistent state, for example by
+  // declaring a persistent variable. Running such an expression again
+  // wouldn't repeat that, but it also changes the key, so it isn't cached.
+  // The scratch context, which owns the cache, may also have been replaced
+  // while parsing.
+  if (!cache_hit && !cache_key.empty() &&
+      execution_results == lldb::eExpressionCompleted &&
+      llvm::StringRef(user_expression_sp->GetUserText()) == expr) {
+    SwiftASTContextLock lock(&exe_ctx);
+    PersistentExpressionState *state = nullptr;
+    if (ExecutionContextScope *exe_scope =
+            exe_ctx.GetBestExecutionContextScope())
+      state = target->GetSwiftPersistentExpressionState(*exe_scope);
+    if (state == cache_state &&
+        state->GetUserExpressionCacheKey(exe_ctx, expr, full_prefix,
+                                         options) == cache_key)
+      state->CacheUserExpression(cache_key, user_expression_sp);
+  }
+
   if (options.InvokeCancelCallback(lldb::eExpressionEvaluationComplete)) {
     error.SetExpressionError(
         lldb::eExpressionInterrupted,
@@ -19,12 +19,16 @@
 #include <vector>
 
 // Multiplexing is implemented using kqueue on systems that support it (BSD
-// variants including OSX). On linux we use ppoll, while android uses pselect
-// (ppoll is present but not implemented properly). On windows we use WSApoll
-// (which does not support signals).
+// variants including OSX). On linux we use epoll with a signalfd, falling back
+// to ppoll, while android uses pselect (ppoll is present but not implemented
+// properly). On windows we use WSApoll (which does not support signals).
 
 #if HAVE_SYS_EVENT_H
 #include <sys/event.h>
+#elif MAINLOOP_USE_EPOLL
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
 #elif defined(_WIN32)
 #include <winsock2.h>
 #elif defined(__ANDROID__)
@@ -84,6 +88,10 @@ private:
   struct kevent out_events[4];
   int num_events = -1;
 
+#elif MAINLOOP_USE_EPOLL
+  struct epoll_event out_events[16];
+  int num_events = -1;
+
 #else
 #ifdef __ANDROID__
   fd_set read_fd_set;
@@ -137,6 +145,58 @@ void MainLoop::RunImpl::ProcessEvents() {
     }
   }
 }
+#elif MAINLOOP_USE_EPOLL
+MainLoop::RunImpl::RunImpl(MainLoop &loop) : loop(loop) {}
+
+Status MainLoop::RunImpl::Poll() {
+  num_events = epoll_wait(loop.m_epoll, out_events,
+                          llvm::array_lengthof(out_events), -1);
+
+  if (num_events < 0) {
+    if (errno == EINTR) {
+      // in case of EINTR, let the main loop run one iteration
+      // we need to zero num_events to avoid assertions failing
+      num_events = 0;
+    } else
+      return Status(errno, eErrorTypePOSIX);
+  }
+  return Status();
+}
+
+void MainLoop::RunImpl::ProcessEvents() {
+  assert(num_events >= 0);
+  for (int i = 0; i < num_events; ++i) {
+    if (loop.m_terminate_request)
+      return;
+    int fd = out_events[i].data.fd;
+    if (fd != loop.m_signal_fd) {
+      loop.ProcessReadObject(fd);
+      continue;
+    }
+
+    // Drain the signalfd. Several instances of the same signal are coalesced,
+    // as they would be by the ppoll implementation.
+    struct signalfd_siginfo info;
+    while (read(loop.m_signal_fd, &info, sizeof(info)) == sizeof(info)) {
+      assert(info.ssi_signo < NSIG);
+      g_signal_flags[info.ssi_signo] = 1;
+    }
+  }
+
+  // Signals may also have been delivered to the handler on a thread which does
+  // not block them, so check the flags for all monitored signals.
+  std::vector<int> signals;
+  for (const auto &entry : loop.m_signals)
+    if (g_signal_flags[entry.first] != 0)
+      signals.push_back(entry.first);
+
+  for (const auto &signal : signals) {
+    if (loop.m_terminate_request)
+      return;
+    g_signal_flags[signal] = 0;
+    loop.ProcessSignal(signal);
+  }
+}
 #else
 MainLoop::RunImpl::RunImpl(MainLoop &loop) : loop(loop) {
 #ifndef __ANDROID__
@@ -258,16 +318,50 @@ MainLoop::MainLoop() {
 #if HAVE_SYS_EVENT_H
   m_kqueue = kqueue();
   assert(m_kqueue >= 0);
+#elif MAINLOOP_USE_EPOLL
+  m_epoll = epoll_create1(EPOLL_CLOEXEC);
+  assert(m_epoll >= 0);
 #endif
 }
 MainLoop::~MainLoop() {
 #if HAVE_SYS_EVENT_H
   close(m_kqueue);
+#elif MAINLOOP_USE_EPOLL
+  if (m_signal_fd >= 0)
+    close(m_signal_fd);
+  close(m_epoll);
 #endif
   assert(m_read_fds.size() == 0);
   assert(m_signals.size() == 0);
 }
 
+#if MAINLOOP_USE_EPOLL
+void MainLoop::UpdateSignalFD() {
+  sigset_t set;
+  sigemptyset(&set);
+  for (const auto &sig : m_signals)
+    sigaddset(&set, sig.first);
+
+  if (m_signal_fd >= 0) {
+    // Replacing the mask of an existing signalfd keeps its epoll
+    // registration.
+    int ret = signalfd(m_signal_fd, &set, 0);
+    (void)ret;
+    assert(ret == m_signal_fd && "signalfd failed");
+    return;
+  }
+
+  m_signal_fd = signalfd(-1, &set, SFD_NONBLOCK | SFD_CLOEXEC);
+  assert(m_signal_fd >= 0 && "signalfd failed");
+  struct epoll_event ev = {};
+  ev.events = EPOLLIN;
+  ev.data.fd = m_signal_fd;
+  int ret = epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_signal_fd, &ev);
+  (void)ret;
+  assert(ret == 0 && "epoll_ctl failed");
+}
+#endif
+
 MainLoop::ReadHandleUP MainLoop::RegisterReadObject(const IOObjectSP &object_sp,
                                                     const Callback &callback,
                                                     Status &error) {
@@ -290,6 +384,17 @@ MainLoop::ReadHandleUP MainLoop::RegisterReadObject(const IOObjectSP &object_sp,
     return nullptr;
   }
 
+#if MAINLOOP_USE_EPOLL
+  struct epoll_event ev = {};
+  ev.events = EPOLLIN;
+  ev.data.fd = object_sp->GetWaitableHandle();
+  if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, ev.data.fd, &ev) == -1) {
+    error.SetError(errno, eErrorTypePOSIX);
+    m_read_fds.erase(ev.data.fd);
+    return nullptr;
+  }
+#endif
+
   return CreateReadHandle(object_sp);
 }
 
@@ -332,13 +437,17 @@ MainLoop::RegisterSignal(int signo, const Callback &callback, Status &error) {
 
   // If we're using kqueue, the signal needs to be unblocked in order to
   // receive it. If using pselect/ppoll, we need to block it, and later unblock
-  // it as a part of the system call.
+  // it as a part of the system call. With signalfd it stays blocked.
   ret = pthread_sigmask(HAVE_SYS_EVENT_H ? SIG_UNBLOCK : SIG_BLOCK,
                         &new_action.sa_mask, &old_set);
   assert(ret == 0 && "pthread_sigmask failed");
   info.was_blocked = sigismember(&old_set, signo);
   m_signals.insert({signo, info});
 
+#if MAINLOOP_USE_EPOLL
+  UpdateSignalFD();
+#endif
+
   return SignalHandleUP(new SignalHandle(*this, signo));
 #endif
 }
@@ -347,6 +456,11 @@ void MainLoop::UnregisterReadObject(IOObject::WaitableHandle handle) {
   bool erased = m_read_fds.erase(handle);
   UNUSED_IF_ASSERT_DISABLED(erased);
   assert(erased);
+#if MAINLOOP_USE_EPOLL
+  // This fails harmlessly if the descriptor was already closed, which removes
+  // it from the epoll set anyway.
+  epoll_ctl(m_epoll, EPOLL_CTL_DEL, handle, nullptr);
+#endif
 }
 
 void MainLoop::UnregisterSignal(int signo) {
@@ -374,6 +488,9 @@ void MainLoop::UnregisterSignal(int signo) {
 #endif
 
   m_signals.erase(it);
+#if MAINLOOP_USE_EPOLL
+  UpdateSignalFD();
+#endif
 #endif
 }
 
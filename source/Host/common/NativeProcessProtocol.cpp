@@ -13,6 +13,7 @@
 #include "lldb/Host/common/NativeThreadProtocol.h"
 #include "lldb/Utility/LLDBAssert.h"
 #include "lldb/Utility/Log.h"
+#include "lldb/Utility/RegisterValue.h"
 #include "lldb/Utility/State.h"
 #include "lldb/lldb-enumerations.h"
 
@@ -356,6 +357,15 @@ void NativeProcessProtocol::NotifyDidExec() {
   }
 }
 
+void NativeProcessProtocol::NotifyThreadStopped(NativeThreadProtocol &thread) {
+  Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_PROCESS));
+  LLDB_LOG(log, "pid {0} tid {1} stopped", GetID(), thread.GetID());
+
+  std::lock_guard<std::recursive_mutex> guard(m_delegates_mutex);
+  for (auto native_delegate : m_delegates)
+    native_delegate->ThreadStopped(this, thread);
+}
+
 Status NativeProcessProtocol::SetSoftwareBreakpoint(lldb::addr_t addr,
                                                     uint32_t size_hint) {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
@@ -438,6 +448,156 @@ Status NativeProcessProtocol::RemoveSoftwareBreakpoint(lldb::addr_t addr) {
   return Status();
 }
 
+Status NativeProcessProtocol::SetSoftwareBreakpointConditions(
+    lldb::addr_t addr, std::vector<AgentExpression> conditions) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  LLDB_LOG(log, "addr = {0:x}, {1} condition(s)", addr, conditions.size());
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end())
+    return Status("Breakpoint not found.");
+  it->second.conditions = std::move(conditions);
+  return Status();
+}
+
+namespace {
+class BreakpointConditionContext : public AgentExpression::Context {
+public:
+  BreakpointConditionContext(NativeProcessProtocol &process,
+                             NativeThreadProtocol &thread)
+      : m_process(process), m_reg_ctx(thread.GetRegisterContext()) {}
+
+  bool ReadRegister(uint32_t regnum, uint64_t &value) override {
+    const RegisterInfo *reg_info = m_reg_ctx.GetRegisterInfoAtIndex(regnum);
+    if (!reg_info)
+      return false;
+    RegisterValue reg_value;
+    if (m_reg_ctx.ReadRegister(reg_info, reg_value).Fail())
+      return false;
+    bool success = false;
+    value = reg_value.GetAsUInt64(0, &success);
+    return success;
+  }
+
+  bool ReadMemory(lldb::addr_t addr, void *buf, size_t size) override {
+    size_t bytes_read = 0;
+    return m_process.ReadMemoryWithoutTrap(addr, buf, size, bytes_read)
+               .Success() &&
+           bytes_read == size;
+  }
+
+private:
+  NativeProcessProtocol &m_process;
+  NativeRegisterContext &m_reg_ctx;
+};
+} // namespace
+
+bool NativeProcessProtocol::SoftwareBreakpointConditionsSayStop(
+    NativeThreadProtocol &thread, lldb::addr_t addr) {
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end() || it->second.conditions.empty())
+    return true;
+
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  BreakpointConditionContext context(*this, thread);
+  const ByteOrder byte_order = GetArchitecture().GetByteOrder();
+  for (const AgentExpression &condition : it->second.conditions) {
+    uint64_t result = 0;
+    if (!condition.Evaluate(context, byte_order, result)) {
+      // Let the client evaluate it instead.
+      LLDB_LOG(log, "tid {0}: failed to evaluate condition at {1:x}",
+               thread.GetID(), addr);
+      return true;
+    }
+    if (result != 0)
+      return true;
+  }
+  LLDB_LOG(log, "tid {0}: conditions at {1:x} are false", thread.GetID(),
+           addr);
+  return false;
+}
+
+Status
+NativeProcessProtocol::SetSoftwareTracepoint(lldb::addr_t addr,
+                                             std::vector<uint32_t> registers) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  LLDB_LOG(log, "addr = {0:x}, {1} register(s)", addr, registers.size());
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end() || !it->second.is_tracepoint) {
+    Status error = SetSoftwareBreakpoint(addr, 0);
+    if (error.Fail())
+      return error;
+    it = m_software_breakpoints.find(addr);
+  }
+  it->second.is_tracepoint = true;
+  it->second.trace_registers = std::move(registers);
+  return Status();
+}
+
+Status NativeProcessProtocol::RemoveSoftwareTracepoint(lldb::addr_t addr) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  LLDB_LOG(log, "addr = {0:x}", addr);
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end() || !it->second.is_tracepoint)
+    return Status("Tracepoint not found.");
+  it->second.is_tracepoint = false;
+  it->second.trace_registers.clear();
+  return RemoveSoftwareBreakpoint(addr);
+}
+
+bool NativeProcessProtocol::RecordTracepointHit(NativeThreadProtocol &thread,
+                                                lldb::addr_t addr) {
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end() || !it->second.is_tracepoint)
+    return false;
+
+  const auto now = std::chrono::steady_clock::now();
+  TracepointHit hit;
+  hit.tid = thread.GetID();
+  hit.pc = addr;
+  hit.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      now.time_since_epoch())
+                      .count();
+  BreakpointConditionContext context(*this, thread);
+  for (uint32_t regnum : it->second.trace_registers) {
+    uint64_t value = 0;
+    if (!context.ReadRegister(regnum, value))
+      value = 0;
+    hit.registers.push_back(value);
+  }
+
+  if (m_tracepoint_hits.size() >= k_max_tracepoint_hits) {
+    m_tracepoint_hits.pop_front();
+    ++m_num_dropped_tracepoint_hits;
+  }
+  m_tracepoint_hits.push_back(std::move(hit));
+
+  // Hand the hits over in batches, which keeps the cost per hit low while
+  // still showing them soon after they happen.
+  const size_t batch_size = 256;
+  if (m_tracepoint_hits.size() >= batch_size ||
+      now - m_last_tracepoint_hits_notification >=
+          std::chrono::milliseconds(100)) {
+    m_last_tracepoint_hits_notification = now;
+    std::lock_guard<std::recursive_mutex> guard(m_delegates_mutex);
+    for (auto native_delegate : m_delegates)
+      native_delegate->TracepointHitsRecorded(this);
+  }
+
+  // The tracepoint's reference is the only one.
+  return it->second.ref_count == 1;
+}
+
+std::vector<NativeProcessProtocol::TracepointHit>
+NativeProcessProtocol::TakeTracepointHits(size_t &num_dropped) {
+  std::vector<TracepointHit> hits(
+      std::make_move_iterator(m_tracepoint_hits.begin()),
+      std::make_move_iterator(m_tracepoint_hits.end()));
+  m_tracepoint_hits.clear();
+  num_dropped = m_num_dropped_tracepoint_hits;
+  m_num_dropped_tracepoint_hits = 0;
+  return hits;
+}
+
 llvm::Expected<NativeProcessProtocol::SoftwareBreakpoint>
 NativeProcessProtocol::EnableSoftwareBreakpoint(lldb::addr_t addr,
                                                 uint32_t size_hint) {
@@ -641,8 +801,36 @@ Status NativeProcessProtocol::ReadMemoryWithoutTrap(lldb::addr_t addr,
   if (error.Fail())
     return error;
 
-  auto data =
-      llvm::makeMutableArrayRef(static_cast<uint8_t *>(buf), bytes_read);
+  RemoveTrapsFromBuffer(
+      addr, llvm::makeMutableArrayRef(static_cast<uint8_t *>(buf), bytes_read));
+  return Status();
+}
+
+void NativeProcessProtocol::ReadMemoryRanges(
+    llvm::MutableArrayRef<MemoryReadRange> ranges) {
+  for (MemoryReadRange &range : ranges) {
+    range.bytes_read = 0;
+    if (range.size == 0)
+      continue;
+    if (ReadMemory(range.addr, range.buf, range.size, range.bytes_read).Fail())
+      range.bytes_read = 0;
+  }
+}
+
+void NativeProcessProtocol::ReadMemoryRangesWithoutTrap(
+    llvm::MutableArrayRef<MemoryReadRange> ranges) {
+  ReadMemoryRanges(ranges);
+  if (m_software_breakpoints.empty())
+    return;
+  for (const MemoryReadRange &range : ranges)
+    RemoveTrapsFromBuffer(
+        range.addr, llvm::makeMutableArrayRef(static_cast<uint8_t *>(range.buf),
+                                              range.bytes_read));
+}
+
+void NativeProcessProtocol::RemoveTrapsFromBuffer(
+    lldb::addr_t addr, llvm::MutableArrayRef<uint8_t> data) {
+  const size_t bytes_read = data.size();
   for (const auto &pair : m_software_breakpoints) {
     lldb::addr_t bp_addr = pair.first;
     auto saved_opcodes = makeArrayRef(pair.second.saved_opcodes);
@@ -659,7 +847,6 @@ Status NativeProcessProtocol::ReadMemoryWithoutTrap(lldb::addr_t addr,
                 std::min(saved_opcodes.size(), bp_data.size()),
                 bp_data.begin());
   }
-  return Status();
 }
 
 llvm::Expected<llvm::StringRef>
@@ -10,43 +10,88 @@
 #include "lldb/Host/ThreadLauncher.h"
 #include "lldb/Utility/Log.h"
 
+#include <atomic>
 #include <cstdint>
-#include <queue>
+#include <deque>
 #include <thread>
+#include <vector>
 
 namespace lldb_private {
 
 namespace {
+// The tasks are kept in one work queue per worker thread plus one shared
+// queue for tasks added by threads that are not part of the pool. A worker
+// runs the most recently added task of its own queue first, so nested tasks
+// are handled depth first and their data is still hot in the cache, and it
+// only takes tasks from the shared queue or steals the oldest task of another
+// worker when its own queue is empty. This way threads adding many small
+// tasks from inside the pool don't contend on a single lock. Low priority
+// tasks are kept in a separate queue that workers only look at once there is
+// nothing else to do.
 class TaskPoolImpl {
 public:
   static TaskPoolImpl &GetInstance();
 
-  void AddTask(std::function<void()> &&task_fn);
+  void AddTask(std::function<void()> &&task_fn, bool low_priority);
+
+  // Run one pending task on the calling thread. Returns false if there was no
+  // task to run. Low priority tasks are only run by the workers.
+  bool RunPendingTask();
 
 private:
+  struct WorkQueue {
+    // Index of this queue in m_worker_queues and m_queue_in_use.
+    size_t index = 0;
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
   TaskPoolImpl();
 
-  static lldb::thread_result_t WorkerPtr(void *pool);
+  static lldb::thread_result_t WorkerPtr(void *queue);
+
+  void Worker(WorkQueue &queue);
+
+  bool PopTask(WorkQueue *local_queue, bool allow_low_priority,
+               std::function<void()> &task_fn);
+
+  static bool PopFront(WorkQueue &queue, std::function<void()> &task_fn);
+
+  static bool PopBack(WorkQueue &queue, std::function<void()> &task_fn);
 
-  static void Worker(TaskPoolImpl *pool);
+  WorkQueue m_shared_queue;
+  WorkQueue m_low_priority_queue;
+  // One queue for every worker thread there can be.
+  std::vector<std::unique_ptr<WorkQueue>> m_worker_queues;
+  // Number of tasks in all of the queues.
+  std::atomic<size_t> m_pending_count;
 
-  std::queue<std::function<void()>> m_tasks;
-  std::mutex m_tasks_mutex;
+  // Protects m_thread_count and m_queue_in_use.
+  std::mutex m_threads_mutex;
   uint32_t m_thread_count;
+  std::vector<bool> m_queue_in_use;
 };
 
 } // end of anonymous namespace
 
+// The work queue of the current thread if it is a worker of the pool.
+static thread_local void *g_worker_queue = nullptr;
+
 TaskPoolImpl &TaskPoolImpl::GetInstance() {
-  static TaskPoolImpl g_task_pool_impl;
-  return g_task_pool_impl;
+  // Intentionally leaked: detached workers may still be exiting when static
+  // destructors run.
+  static TaskPoolImpl *g_task_pool_impl = new TaskPoolImpl();
+  return *g_task_pool_impl;
 }
 
-void TaskPool::AddTaskImpl(std::function<void()> &&task_fn) {
-  TaskPoolImpl::GetInstance().AddTask(std::move(task_fn));
+void TaskPool::AddTaskImpl(std::function<void()> &&task_fn,
+                           bool low_priority) {
+  TaskPoolImpl::GetInstance().AddTask(std::move(task_fn), low_priority);
 }
 
-TaskPoolImpl::TaskPoolImpl() : m_thread_count(0) {}
+bool TaskPool::RunPendingTask() {
+  return TaskPoolImpl::GetInstance().RunPendingTask();
+}
 
 unsigned GetHardwareConcurrencyHint() {
   // std::thread::hardware_concurrency may return 0 if the value is not well
@@ -56,22 +101,51 @@ unsigned GetHardwareConcurrencyHint() {
   return g_hardware_concurrency;
 }
 
-void TaskPoolImpl::AddTask(std::function<void()> &&task_fn) {
+TaskPoolImpl::TaskPoolImpl()
+    : m_pending_count(0), m_thread_count(0),
+      m_queue_in_use(GetHardwareConcurrencyHint(), false) {
+  for (unsigned i = 0; i < GetHardwareConcurrencyHint(); ++i) {
+    m_worker_queues.push_back(std::make_unique<WorkQueue>());
+    m_worker_queues.back()->index = i;
+  }
+}
+
+void TaskPoolImpl::AddTask(std::function<void()> &&task_fn,
+                           bool low_priority) {
   const size_t min_stack_size = 8 * 1024 * 1024;
 
-  std::unique_lock<std::mutex> lock(m_tasks_mutex);
-  m_tasks.emplace(std::move(task_fn));
+  WorkQueue &queue = low_priority ? m_low_priority_queue
+                     : g_worker_queue
+                         ? *static_cast<WorkQueue *>(g_worker_queue)
+                         : m_shared_queue;
+  {
+    std::lock_guard<std::mutex> guard(queue.mutex);
+    queue.tasks.emplace_back(std::move(task_fn));
+  }
+  // This has to be incremented before checking the thread count, see
+  // Worker().
+  ++m_pending_count;
+
+  std::unique_lock<std::mutex> lock(m_threads_mutex);
   if (m_thread_count < GetHardwareConcurrencyHint()) {
+    auto free_pos = std::find(m_queue_in_use.begin(), m_queue_in_use.end(),
+                              false);
+    assert(free_pos != m_queue_in_use.end());
+    *free_pos = true;
     m_thread_count++;
-    // Note that this detach call needs to happen with the m_tasks_mutex held.
-    // This prevents the thread from exiting prematurely and triggering a linux
-    // libc bug (https://sourceware.org/bugzilla/show_bug.cgi?id=19951).
+    WorkQueue *worker_queue =
+        m_worker_queues[free_pos - m_queue_in_use.begin()].get();
+    // Note that this detach call needs to happen with the m_threads_mutex
+    // held. This prevents the thread from exiting prematurely and triggering
+    // a linux libc bug (https://sourceware.org/bugzilla/show_bug.cgi?id=19951).
     llvm::Expected<HostThread> host_thread =
         lldb_private::ThreadLauncher::LaunchThread(
-            "task-pool.worker", WorkerPtr, this, min_stack_size);
+            "task-pool.worker", WorkerPtr, worker_queue, min_stack_size);
     if (host_thread) {
       host_thread->Release();
     } else {
+      *free_pos = false;
+      m_thread_count--;
       LLDB_LOG(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_HOST),
                "failed to launch host thread: {}",
                llvm::toString(host_thread.takeError()));
@@ -79,24 +153,82 @@ void TaskPoolImpl::AddTask(std::function<void()> &&task_fn) {
   }
 }
 
-lldb::thread_result_t TaskPoolImpl::WorkerPtr(void *pool) {
-  Worker((TaskPoolImpl *)pool);
+bool TaskPoolImpl::PopFront(WorkQueue &queue, std::function<void()> &task_fn) {
+  std::lock_guard<std::mutex> guard(queue.mutex);
+  if (queue.tasks.empty())
+    return false;
+  task_fn = std::move(queue.tasks.front());
+  queue.tasks.pop_front();
+  return true;
+}
+
+bool TaskPoolImpl::PopBack(WorkQueue &queue, std::function<void()> &task_fn) {
+  std::lock_guard<std::mutex> guard(queue.mutex);
+  if (queue.tasks.empty())
+    return false;
+  task_fn = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool TaskPoolImpl::PopTask(WorkQueue *local_queue, bool allow_low_priority,
+                           std::function<void()> &task_fn) {
+  if (m_pending_count == 0)
+    return false;
+
+  bool found = (local_queue && PopBack(*local_queue, task_fn)) ||
+               PopFront(m_shared_queue, task_fn);
+  if (!found) {
+    // Start looking at a different queue on every thread so the thieves don't
+    // all go after the same victim.
+    const size_t num_queues = m_worker_queues.size();
+    const size_t start =
+        std::hash<std::thread::id>()(std::this_thread::get_id());
+    for (size_t i = 0; i < num_queues && !found; ++i) {
+      WorkQueue &victim = *m_worker_queues[(start + i) % num_queues];
+      if (&victim != local_queue)
+        found = PopFront(victim, task_fn);
+    }
+  }
+  if (!found && allow_low_priority)
+    found = PopFront(m_low_priority_queue, task_fn);
+  if (found)
+    --m_pending_count;
+  return found;
+}
+
+bool TaskPoolImpl::RunPendingTask() {
+  std::function<void()> f;
+  if (!PopTask(static_cast<WorkQueue *>(g_worker_queue),
+               /*allow_low_priority=*/false, f))
+    return false;
+  f();
+  return true;
+}
+
+lldb::thread_result_t TaskPoolImpl::WorkerPtr(void *queue) {
+  g_worker_queue = queue;
+  GetInstance().Worker(*static_cast<WorkQueue *>(queue));
   return {};
 }
 
-void TaskPoolImpl::Worker(TaskPoolImpl *pool) {
+void TaskPoolImpl::Worker(WorkQueue &queue) {
   while (true) {
-    std::unique_lock<std::mutex> lock(pool->m_tasks_mutex);
-    if (pool->m_tasks.empty()) {
-      pool->m_thread_count--;
-      break;
+    std::function<void()> f;
+    if (PopTask(&queue, /*allow_low_priority=*/true, f)) {
+      f();
+      continue;
     }
 
-    std::function<void()> f = std::move(pool->m_tasks.front());
-    pool->m_tasks.pop();
-    lock.unlock();
-
-    f();
+    // Exit once there is nothing left to do. AddTask increments the pending
+    // count before checking the thread count, so either we see the new task
+    // here or AddTask sees that a thread is missing and launches a new one.
+    std::lock_guard<std::mutex> guard(m_threads_mutex);
+    if (m_pending_count != 0)
+      continue;
+    m_queue_in_use[queue.index] = false;
+    m_thread_count--;
+    break;
   }
 }
 
@@ -114,13 +246,15 @@ void TaskMapOverInt(size_t begin, size_t end,
     }
   };
 
+  // The calling thread takes part in the work, so only num_workers - 1 tasks
+  // are needed.
   std::vector<std::future<void>> futures;
   futures.reserve(num_workers);
-  for (size_t i = 0; i < num_workers; i++)
+  for (size_t i = 1; i < num_workers; i++)
     futures.push_back(TaskPool::AddTask(wrapper));
-  for (size_t i = 0; i < num_workers; i++)
-    futures[i].wait();
+  wrapper();
+  for (std::future<void> &future : futures)
+    TaskPool::Wait(future);
 }
 
 } // namespace lldb_private
-
@@ -0,0 +1,305 @@
+//===-- ConnectionSharedMemory.cpp ------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Host/linux/ConnectionSharedMemory.h"
+#include "lldb/Utility/IOObject.h"
+#include "lldb/Utility/Log.h"
+#include "lldb/Utility/Status.h"
+#include "lldb/Utility/Timeout.h"
+#include "llvm/Support/Errno.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+
+#include <poll.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace lldb;
+using namespace lldb_private;
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2,
+              "the rings need atomics that work across processes");
+
+namespace {
+const uint32_t kMagic = 0x6c6c6462; // "lldb"
+
+// Must be a power of two.
+const uint32_t kRingSize = 256 * 1024;
+} // namespace
+
+struct ConnectionSharedMemory::Ring {
+  // The number of bytes ever written to and read from the ring, modulo 2^32.
+  // Only the writer changes head, and only the reader tail. They live on
+  // their own cache lines so the two ends don't fight over them.
+  alignas(64) std::atomic<uint32_t> head;
+  alignas(64) std::atomic<uint32_t> tail;
+  // Set by the reader when it found the ring empty and is about to wait on
+  // the doorbell. The writer rings it when it clears this.
+  alignas(64) std::atomic<uint32_t> reader_waiting;
+};
+
+struct ConnectionSharedMemory::Header {
+  uint32_t magic;
+  uint32_t ring_size;
+  // The creator writes to the first ring and reads from the second one.
+  Ring rings[2];
+  // Followed by the data of the rings, ring_size bytes each.
+};
+
+Status ConnectionSharedMemory::CreateSharedMemory(int &shm_fd) {
+  shm_fd = -1;
+#if defined(SYS_memfd_create)
+  // The descriptor is meant to be inherited, so no MFD_CLOEXEC.
+  int fd = ::syscall(SYS_memfd_create, "lldb-gdb-remote", 0);
+  if (fd == -1)
+    return Status(errno, eErrorTypePOSIX);
+
+  const size_t size = sizeof(Header) + 2 * kRingSize;
+  if (::ftruncate(fd, size) == -1) {
+    Status error(errno, eErrorTypePOSIX);
+    ::close(fd);
+    return error;
+  }
+  void *mapping =
+      ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) {
+    Status error(errno, eErrorTypePOSIX);
+    ::close(fd);
+    return error;
+  }
+  Header *header = new (mapping) Header();
+  header->ring_size = kRingSize;
+  header->magic = kMagic;
+  ::munmap(mapping, size);
+
+  shm_fd = fd;
+  return Status();
+#else
+  return Status("memfd_create is not available");
+#endif
+}
+
+ConnectionSharedMemory::ConnectionSharedMemory(
+    std::unique_ptr<Connection> doorbell, int shm_fd, bool creator)
+    : m_doorbell(std::move(doorbell)) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_CONNECTION));
+
+  struct stat st;
+  void *mapping = MAP_FAILED;
+  if (::fstat(shm_fd, &st) == 0 &&
+      static_cast<size_t>(st.st_size) >= sizeof(Header))
+    mapping = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     shm_fd, 0);
+  // The mapping keeps the memory alive.
+  ::close(shm_fd);
+  if (mapping == MAP_FAILED) {
+    LLDB_LOG(log, "failed to map the shared memory: {0}",
+             llvm::sys::StrError());
+    return;
+  }
+
+  Header *header = static_cast<Header *>(mapping);
+  const uint32_t ring_size = header->ring_size;
+  if (header->magic != kMagic || ring_size == 0 ||
+      (ring_size & (ring_size - 1)) != 0 ||
+      sizeof(Header) + 2 * size_t(ring_size) !=
+          static_cast<size_t>(st.st_size)) {
+    LLDB_LOG(log, "shared memory of {0} bytes is not set up for a connection",
+             st.st_size);
+    ::munmap(mapping, st.st_size);
+    return;
+  }
+
+  m_header = header;
+  m_mapping_size = st.st_size;
+  uint8_t *data = reinterpret_cast<uint8_t *>(header + 1);
+  const size_t write_index = creator ? 0 : 1;
+  const size_t read_index = 1 - write_index;
+  m_write_ring = &header->rings[write_index];
+  m_write_data = data + write_index * ring_size;
+  m_read_ring = &header->rings[read_index];
+  m_read_data = data + read_index * ring_size;
+}
+
+ConnectionSharedMemory::~ConnectionSharedMemory() { Disconnect(nullptr); }
+
+bool ConnectionSharedMemory::IsConnected() const {
+  return m_header && m_doorbell && m_doorbell->IsConnected();
+}
+
+ConnectionStatus ConnectionSharedMemory::Connect(llvm::StringRef url,
+                                                 Status *error_ptr) {
+  if (error_ptr)
+    error_ptr->SetErrorString(
+        "shared memory connections are set up when they are created");
+  return eConnectionStatusError;
+}
+
+ConnectionStatus ConnectionSharedMemory::Disconnect(Status *error_ptr) {
+  // Wake up a reader blocked on the doorbell first, so it lets go of the
+  // mutex.
+  ConnectionStatus status = eConnectionStatusSuccess;
+  if (m_doorbell && m_doorbell->IsConnected())
+    status = m_doorbell->Disconnect(error_ptr);
+
+  std::lock(m_read_mutex, m_write_mutex);
+  std::lock_guard<std::mutex> read_guard(m_read_mutex, std::adopt_lock);
+  std::lock_guard<std::mutex> write_guard(m_write_mutex, std::adopt_lock);
+  if (m_header) {
+    ::munmap(m_header, m_mapping_size);
+    m_header = nullptr;
+  }
+  return status;
+}
+
+size_t ConnectionSharedMemory::ReadFromRing(void *dst, size_t dst_len) {
+  const uint32_t size = m_header->ring_size;
+  const uint32_t tail = m_read_ring->tail.load(std::memory_order_relaxed);
+  const uint32_t head = m_read_ring->head.load();
+  const size_t count =
+      std::min<size_t>({dst_len, uint32_t(head - tail), size});
+  if (count == 0)
+    return 0;
+
+  const uint32_t offset = tail & (size - 1);
+  const size_t first = std::min<size_t>(count, size - offset);
+  ::memcpy(dst, m_read_data + offset, first);
+  ::memcpy(static_cast<uint8_t *>(dst) + first, m_read_data, count - first);
+  m_read_ring->tail.store(tail + count, std::memory_order_release);
+  return count;
+}
+
+size_t ConnectionSharedMemory::WriteToRing(const void *src, size_t src_len) {
+  const uint32_t size = m_header->ring_size;
+  const uint32_t head = m_write_ring->head.load(std::memory_order_relaxed);
+  const uint32_t tail = m_write_ring->tail.load(std::memory_order_acquire);
+  const uint32_t used = std::min<uint32_t>(head - tail, size);
+  const size_t count = std::min<size_t>(src_len, size - used);
+  if (count == 0)
+    return 0;
+
+  const uint32_t offset = head & (size - 1);
+  const size_t first = std::min<size_t>(count, size - offset);
+  ::memcpy(m_write_data + offset, src, first);
+  ::memcpy(m_write_data, static_cast<const uint8_t *>(src) + first,
+           count - first);
+  // Sequentially consistent, so that either the reader sees the new head
+  // after it asked for the doorbell, or we see that it asked.
+  m_write_ring->head.store(head + count);
+  return count;
+}
+
+bool ConnectionSharedMemory::PeerHungUp() {
+  IOObjectSP read_sp = m_doorbell->GetReadObject();
+  if (!read_sp)
+    return true;
+  // Doubles as the wait for the reader to make room, without taking doorbell
+  // bytes away from our own reads.
+  struct pollfd fd = {read_sp->GetWaitableHandle(), POLLRDHUP, 0};
+  if (::poll(&fd, 1, 1) <= 0)
+    return false;
+  return fd.revents & (POLLRDHUP | POLLHUP | POLLERR | POLLNVAL);
+}
+
+size_t ConnectionSharedMemory::Read(void *dst, size_t dst_len,
+                                    const Timeout<std::micro> &timeout,
+                                    ConnectionStatus &status,
+                                    Status *error_ptr) {
+  std::lock_guard<std::mutex> guard(m_read_mutex);
+  if (!m_header) {
+    if (error_ptr)
+      error_ptr->SetErrorString("not connected");
+    status = eConnectionStatusNoConnection;
+    return 0;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  llvm::Optional<Clock::time_point> deadline;
+  if (timeout)
+    deadline = Clock::now() + *timeout;
+
+  while (true) {
+    size_t bytes_read = ReadFromRing(dst, dst_len);
+    if (bytes_read == 0) {
+      // Ask for the doorbell, then look again in case the data came in
+      // before the writer could see that.
+      m_read_ring->reader_waiting.store(1);
+      bytes_read = ReadFromRing(dst, dst_len);
+    }
+    if (bytes_read > 0) {
+      if (error_ptr)
+        error_ptr->Clear();
+      status = eConnectionStatusSuccess;
+      return bytes_read;
+    }
+
+    Timeout<std::micro> remaining(llvm::None);
+    if (deadline)
+      remaining = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::max(*deadline - Clock::now(), Clock::duration::zero()));
+    char bell[64];
+    m_doorbell->Read(bell, sizeof(bell), remaining, status, error_ptr);
+    if (status != eConnectionStatusSuccess)
+      return 0;
+  }
+}
+
+size_t ConnectionSharedMemory::Write(const void *src, size_t src_len,
+                                     ConnectionStatus &status,
+                                     Status *error_ptr) {
+  std::lock_guard<std::mutex> guard(m_write_mutex);
+  if (!m_header) {
+    if (error_ptr)
+      error_ptr->SetErrorString("not connected");
+    status = eConnectionStatusNoConnection;
+    return 0;
+  }
+
+  const uint8_t *bytes = static_cast<const uint8_t *>(src);
+  size_t bytes_written = 0;
+  while (bytes_written < src_len) {
+    const size_t count =
+        WriteToRing(bytes + bytes_written, src_len - bytes_written);
+    bytes_written += count;
+    if (count > 0 && m_write_ring->reader_waiting.exchange(0)) {
+      const char bell = '!';
+      m_doorbell->Write(&bell, sizeof(bell), status, error_ptr);
+      if (status != eConnectionStatusSuccess)
+        return bytes_written;
+    }
+    if (count == 0 && PeerHungUp()) {
+      if (error_ptr)
+        error_ptr->SetErrorString("the other end hung up");
+      status = eConnectionStatusLostConnection;
+      return bytes_written;
+    }
+  }
+
+  if (error_ptr)
+    error_ptr->Clear();
+  status = eConnectionStatusSuccess;
+  return bytes_written;
+}
+
+std::string ConnectionSharedMemory::GetURI() {
+  return m_doorbell ? m_doorbell->GetURI() : std::string();
+}
+
+bool ConnectionSharedMemory::InterruptRead() {
+  return m_doorbell && m_doorbell->InterruptRead();
+}
+
+IOObjectSP ConnectionSharedMemory::GetReadObject() {
+  return m_doorbell ? m_doorbell->GetReadObject() : IOObjectSP();
+}
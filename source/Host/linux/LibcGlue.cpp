@@ -28,3 +28,19 @@ ssize_t process_vm_readv(::pid_t pid, const struct iovec *local_iov,
 #endif
 }
 #endif
+
+#if !HAVE_PROCESS_VM_WRITEV
+// If the syscall wrapper is not available, provide one.
+ssize_t process_vm_writev(::pid_t pid, const struct iovec *local_iov,
+                          unsigned long liovcnt, const struct iovec *remote_iov,
+                          unsigned long riovcnt, unsigned long flags) {
+#if HAVE_NR_PROCESS_VM_WRITEV
+  // If we have the syscall number, we can issue the syscall ourselves.
+  return syscall(__NR_process_vm_writev, pid, local_iov, liovcnt, remote_iov,
+                 riovcnt, flags);
+#else // If not, let's pretend the syscall is not present.
+  errno = ENOSYS;
+  return -1;
+#endif
+}
+#endif
@@ -26,6 +26,7 @@
 #include "Commands/CommandObjectLanguage.h"
 #include "Commands/CommandObjectLog.h"
 #include "Commands/CommandObjectMemory.h"
+#include "Commands/CommandObjectMemoryPressure.h"
 #include "Commands/CommandObjectPlatform.h"
 #include "Commands/CommandObjectPlugin.h"
 #include "Commands/CommandObjectProcess.h"
@@ -462,6 +463,8 @@ void CommandInterpreter::LoadCommandDictionary() {
   m_command_dict["help"] = CommandObjectSP(new CommandObjectHelp(*this));
   m_command_dict["log"] = CommandObjectSP(new CommandObjectLog(*this));
   m_command_dict["memory"] = CommandObjectSP(new CommandObjectMemory(*this));
+  m_command_dict["memory-pressure"] =
+      CommandObjectSP(new CommandObjectMemoryPressure(*this));
   m_command_dict["platform"] =
       CommandObjectSP(new CommandObjectPlatform(*this));
   m_command_dict["plugin"] = CommandObjectSP(new CommandObjectPlugin(*this));
@@ -960,6 +963,7 @@ bool CommandInterpreter::AddCommand(llvm::StringRef name,
   if (name.empty())
     return false;
 
+  m_command_object_cache.clear();
   std::string name_sstr(name);
   auto name_iter = m_command_dict.find(name_sstr);
   if (name_iter != m_command_dict.end()) {
@@ -996,6 +1000,7 @@ bool CommandInterpreter::AddUserCommand(llvm::StringRef name,
     }
 
     m_user_dict[name] = cmd_sp;
+    m_command_object_cache.clear();
     return true;
   }
   return false;
@@ -1048,6 +1053,34 @@ CommandObject *
 CommandInterpreter::GetCommandObject(llvm::StringRef cmd_str,
                                      StringList *matches,
                                      StringList *descriptions) const {
+  // Resolving an abbreviation means searching all the dictionaries, so
+  // remember what each name resolved to. Only names that resolve to a single
+  // command are cached, a failed lookup needs to list the candidates anyway.
+  auto pos = m_command_object_cache.find(cmd_str);
+  if (pos != m_command_object_cache.end()) {
+    CommandObject *command_obj = pos->second.first;
+    if (matches)
+      matches->AppendString(pos->second.second);
+    if (descriptions)
+      descriptions->AppendString(command_obj->GetHelp());
+    return command_obj;
+  }
+
+  StringList local_matches;
+  CommandObject *command_obj =
+      FindCommandObject(cmd_str, &local_matches, descriptions);
+  if (matches)
+    matches->AppendList(local_matches);
+  if (command_obj && local_matches.GetSize() == 1)
+    m_command_object_cache[cmd_str] =
+        std::make_pair(command_obj, local_matches.GetStringAtIndex(0));
+  return command_obj;
+}
+
+CommandObject *
+CommandInterpreter::FindCommandObject(llvm::StringRef cmd_str,
+                                      StringList *matches,
+                                      StringList *descriptions) const {
   CommandObject *command_obj =
       GetCommandSP(cmd_str, false, true, matches, descriptions).get();
 
@@ -1134,6 +1167,7 @@ CommandInterpreter::AddAlias(llvm::StringRef alias_name,
 
   if (command_alias_up && command_alias_up->IsValid()) {
     m_alias_dict[alias_name] = CommandObjectSP(command_alias_up.get());
+    m_command_object_cache.clear();
     return command_alias_up.release();
   }
 
@@ -1144,6 +1178,7 @@ bool CommandInterpreter::RemoveAlias(llvm::StringRef alias_name) {
   auto pos = m_alias_dict.find(alias_name);
   if (pos != m_alias_dict.end()) {
     m_alias_dict.erase(pos);
+    m_command_object_cache.clear();
     return true;
   }
   return false;
@@ -1155,6 +1190,7 @@ bool CommandInterpreter::RemoveCommand(llvm::StringRef cmd) {
     if (pos->second->IsRemovable()) {
       // Only regular expression objects or python commands are removable
       m_command_dict.erase(pos);
+      m_command_object_cache.clear();
       return true;
     }
   }
@@ -1164,6 +1200,7 @@ bool CommandInterpreter::RemoveUser(llvm::StringRef alias_name) {
   CommandObject::CommandMap::iterator pos = m_user_dict.find(alias_name);
   if (pos != m_user_dict.end()) {
     m_user_dict.erase(pos);
+    m_command_object_cache.clear();
     return true;
   }
   return false;
@@ -2173,6 +2210,9 @@ void CommandInterpreter::HandleCommands(const StringList &commands,
     m_debugger.SetAsyncExecution(false);
   }
 
+  // One return object serves all the commands, so its streams keep their
+  // buffers from one command to the next.
+  CommandReturnObject tmp_result;
   for (size_t idx = 0; idx < num_lines && !WasInterrupted(); idx++) {
     const char *cmd = commands.GetStringAtIndex(idx);
     if (cmd[0] == '\0')
@@ -2184,7 +2224,11 @@ void CommandInterpreter::HandleCommands(const StringList &commands,
                                      m_debugger.GetPrompt().str().c_str(), cmd);
     }
 
-    CommandReturnObject tmp_result;
+    // A command may have pointed the result at its own streams.
+    tmp_result.Clear();
+    tmp_result.SetImmediateOutputStream(StreamSP());
+    tmp_result.SetImmediateErrorStream(StreamSP());
+    tmp_result.SetAbnormalStopWasExpected(false);
     // If override_context is not NULL, pass no_context_switching = true for
     // HandleCommand() since we updated our context already.
 
@@ -11,9 +11,17 @@
 #include "lldb/Interpreter/OptionValues.h"
 #include "lldb/Utility/StringList.h"
 
+#include <atomic>
+
 using namespace lldb;
 using namespace lldb_private;
 
+static std::atomic<uint32_t> g_change_generation(1);
+
+uint32_t OptionValue::GetChangeGeneration() { return g_change_generation; }
+
+void OptionValue::BumpChangeGeneration() { ++g_change_generation; }
+
 // Get this value as a uint64_t value if it is encoded as a boolean, uint64_t
 // or int64_t. Other types will cause "fail_value" to be returned
 uint64_t OptionValue::GetUInt64Value(uint64_t fail_value, bool *success_ptr) {
@@ -281,6 +289,7 @@ bool OptionValue::SetBooleanValue(bool new_value) {
   OptionValueBoolean *option_value = GetAsBoolean();
   if (option_value) {
     option_value->SetCurrentValue(new_value);
+    BumpChangeGeneration();
     return true;
   }
   return false;
@@ -297,6 +306,7 @@ char OptionValue::SetCharValue(char new_value) {
   OptionValueChar *option_value = GetAsChar();
   if (option_value) {
     option_value->SetCurrentValue(new_value);
+    BumpChangeGeneration();
     return true;
   }
   return false;
@@ -313,6 +323,7 @@ bool OptionValue::SetEnumerationValue(int64_t value) {
   OptionValueEnumeration *option_value = GetAsEnumeration();
   if (option_value) {
     option_value->SetCurrentValue(value);
+    BumpChangeGeneration();
     return true;
   }
   return false;
@@ -329,6 +340,7 @@ bool OptionValue::SetFileSpecValue(const FileSpec &file_spec) {
   OptionValueFileSpec *option_value = GetAsFileSpec();
   if (option_value) {
     option_value->SetCurrentValue(file_spec, false);
+    BumpChangeGeneration();
     return true;
   }
   return false;
@@ -352,6 +364,7 @@ bool OptionValue::SetFormatValue(lldb::Format new_value) {
   OptionValueFormat *option_value = GetAsFormat();
   if (option_value) {
     option_value->SetCurrentValue(new_value);
+    BumpChangeGeneration();
     return true;
   }
   return false;
@@ -369,6 +382,7 @@ bool OptionValue::SetLanguageValue(lldb::LanguageType new_language) {
   OptionValueLanguage *option_value = GetAsLanguage();
   if (option_value) {
     option_value->SetCurrentValue(new_language);
+    BumpChangeGeneration();
     return true;
   }
   return false;
@@ -399,6 +413,7 @@ bool OptionValue::SetSInt64Value(int64_t new_value) {
   OptionValueSInt64 *option_value = GetAsSInt64();
   if (option_value) {
     option_value->SetCurrentValue(new_value);
+    BumpChangeGeneration();
     return true;
   }
   return false;
@@ -415,6 +430,7 @@ bool OptionValue::SetStringValue(llvm::StringRef new_value) {
   OptionValueString *option_value = GetAsString();
   if (option_value) {
     option_value->SetCurrentValue(new_value);
+    BumpChangeGeneration();
     return true;
   }
   return false;
@@ -431,6 +447,7 @@ bool OptionValue::SetUInt64Value(uint64_t new_value) {
   OptionValueUInt64 *option_value = GetAsUInt64();
   if (option_value) {
     option_value->SetCurrentValue(new_value);
+    BumpChangeGeneration();
     return true;
   }
   return false;
@@ -447,6 +464,7 @@ bool OptionValue::SetUUIDValue(const UUID &uuid) {
   OptionValueUUID *option_value = GetAsUUID();
   if (option_value) {
     option_value->SetCurrentValue(uuid);
+    BumpChangeGeneration();
     return true;
   }
   return false;
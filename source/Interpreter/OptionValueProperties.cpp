@@ -521,6 +521,7 @@ bool OptionValueProperties::Clear() {
   const size_t num_properties = m_properties.size();
   for (size_t i = 0; i < num_properties; ++i)
     m_properties[i].GetValue()->Clear();
+  BumpChangeGeneration();
   return true;
 }
 
@@ -435,6 +435,51 @@ bool ABISysV_x86_64::GetArgumentValues(Thread &thread,
   return true;
 }
 
+bool ABISysV_x86_64::GetIntegerArgumentValues(
+    RegisterContext &reg_ctx, llvm::MutableArrayRef<uint64_t> args) const {
+  const size_t num_register_args = std::min<size_t>(args.size(), 6);
+  for (size_t i = 0; i < num_register_args; ++i) {
+    const RegisterInfo *reg_info = reg_ctx.GetRegisterInfo(
+        eRegisterKindGeneric, LLDB_REGNUM_GENERIC_ARG1 + i);
+    RegisterValue reg_value;
+    if (!reg_info || !reg_ctx.ReadRegister(reg_info, reg_value))
+      return false;
+    args[i] = reg_value.GetAsUInt64();
+  }
+  if (args.size() == num_register_args)
+    return true;
+
+  // The rest are in 8 byte slots above the return address, read them all at
+  // once.
+  ProcessSP process_sp = reg_ctx.CalculateProcess();
+  addr_t sp = reg_ctx.GetSP(0);
+  if (!process_sp || !sp)
+    return false;
+  llvm::MutableArrayRef<uint64_t> stack_args =
+      args.drop_front(num_register_args);
+  const size_t byte_size = stack_args.size() * 8;
+  std::vector<uint8_t> bytes(byte_size);
+  Status error;
+  if (process_sp->ReadMemory(sp + 8, bytes.data(), byte_size, error) !=
+      byte_size)
+    return false;
+  DataExtractor data(bytes.data(), byte_size, process_sp->GetByteOrder(), 8);
+  lldb::offset_t offset = 0;
+  for (uint64_t &arg : stack_args)
+    arg = data.GetU64(&offset);
+  return true;
+}
+
+bool ABISysV_x86_64::GetIntegerReturnValue(RegisterContext &reg_ctx,
+                                           uint64_t &value) const {
+  const RegisterInfo *reg_info = reg_ctx.GetRegisterInfoByName("rax", 0);
+  RegisterValue reg_value;
+  if (!reg_info || !reg_ctx.ReadRegister(reg_info, reg_value))
+    return false;
+  value = reg_value.GetAsUInt64();
+  return true;
+}
+
 Status ABISysV_x86_64::SetReturnValueObject(lldb::StackFrameSP &frame_sp,
                                             lldb::ValueObjectSP &new_value_sp) {
   Status error;
@@ -26,6 +26,13 @@ public:
   bool GetArgumentValues(lldb_private::Thread &thread,
                          lldb_private::ValueList &values) const override;
 
+  bool GetIntegerArgumentValues(
+      lldb_private::RegisterContext &reg_ctx,
+      llvm::MutableArrayRef<uint64_t> args) const override;
+
+  bool GetIntegerReturnValue(lldb_private::RegisterContext &reg_ctx,
+                             uint64_t &value) const override;
+
   lldb_private::Status
   SetReturnValueObject(lldb::StackFrameSP &frame_sp,
                        lldb::ValueObjectSP &new_value) override;
@@ -23,7 +23,6 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/TargetRegistry.h"
-#include "llvm/Support/TargetSelect.h"
 
 #include "lldb/Core/Address.h"
 #include "lldb/Core/Module.h"
@@ -1235,6 +1234,7 @@ DisassemblerLLVMC::~DisassemblerLLVMC() = default;
 Disassembler *DisassemblerLLVMC::CreateInstance(const ArchSpec &arch,
                                                 const char *flavor) {
   if (arch.GetTriple().getArch() != llvm::Triple::UnknownArch) {
+    PluginManager::InitializeLLVMTargets();
     std::unique_ptr<DisassemblerLLVMC> disasm_up(
         new DisassemblerLLVMC(arch, flavor));
 
@@ -1294,11 +1294,6 @@ void DisassemblerLLVMC::Initialize() {
                                 "Disassembler that uses LLVM MC to disassemble "
                                 "i386, x86_64, ARM, and ARM64.",
                                 CreateInstance);
-
-  llvm::InitializeAllTargetInfos();
-  llvm::InitializeAllTargetMCs();
-  llvm::InitializeAllAsmParsers();
-  llvm::InitializeAllDisassemblers();
 }
 
 void DisassemblerLLVMC::Terminate() {
@@ -91,6 +91,22 @@ void DynamicLoaderDarwin::Clear(bool clear_process) {
   m_dyld.Clear(false);
 }
 
+ModuleSpec
+DynamicLoaderDarwin::GetModuleSpecForImageInfo(ImageInfo &image_info) {
+  ModuleSpec module_spec(image_info.file_spec);
+  module_spec.GetUUID() = image_info.uuid;
+
+  // macCatalyst support: Request matching os/environment.
+  auto &target_triple = m_process->GetTarget().GetArchitecture().GetTriple();
+  if (target_triple.getOS() == llvm::Triple::IOS &&
+      target_triple.getEnvironment() == llvm::Triple::MacABI) {
+    // Request the macCatalyst variant of frameworks that have both
+    // a PLATFORM_MACOS and a PLATFORM_MACCATALYST load command.
+    module_spec.GetArchitecture() = ArchSpec(target_triple);
+  }
+  return module_spec;
+}
+
 ModuleSP DynamicLoaderDarwin::FindTargetModuleForImageInfo(
     ImageInfo &image_info, bool can_create, bool *did_create_ptr) {
   if (did_create_ptr)
@@ -98,19 +114,7 @@ ModuleSP DynamicLoaderDarwin::FindTargetModuleForImageInfo(
 
   Target &target = m_process->GetTarget();
   const ModuleList &target_images = target.GetImages();
-  ModuleSpec module_spec(image_info.file_spec);
-  module_spec.GetUUID() = image_info.uuid;
-
-  // macCatalyst support: Request matching os/environment.
-  {
-    auto &target_triple = target.GetArchitecture().GetTriple();
-    if (target_triple.getOS() == llvm::Triple::IOS &&
-        target_triple.getEnvironment() == llvm::Triple::MacABI) {
-      // Request the macCatalyst variant of frameworks that have both
-      // a PLATFORM_MACOS and a PLATFORM_MACCATALYST load command.
-      module_spec.GetArchitecture() = ArchSpec(target_triple);
-    }
-  }
+  ModuleSpec module_spec = GetModuleSpecForImageInfo(image_info);
 
   ModuleSP module_sp(target_images.FindFirstModule(module_spec));
 
@@ -608,6 +612,11 @@ bool DynamicLoaderDarwin::AddModulesUsingImageInfos(
   Target &target = m_process->GetTarget();
   ModuleList &target_images = target.GetImages();
 
+  std::vector<ModuleSpec> module_specs;
+  for (ImageInfo &image_info : image_infos)
+    module_specs.push_back(GetModuleSpecForImageInfo(image_info));
+  PreloadModules(module_specs);
+
   for (uint32_t idx = 0; idx < image_infos.size(); ++idx) {
     if (log) {
       LLDB_LOGF(log, "Adding new image at address=0x%16.16" PRIx64 ".",
@@ -176,6 +176,8 @@ protected:
 
   bool UnloadModuleSections(lldb_private::Module *module, ImageInfo &info);
 
+  lldb_private::ModuleSpec GetModuleSpecForImageInfo(ImageInfo &image_info);
+
   lldb::ModuleSP FindTargetModuleForImageInfo(ImageInfo &image_info,
                                               bool can_create,
                                               bool *did_create_ptr);
@@ -229,6 +229,12 @@ bool DYLDRendezvous::UpdateSOEntriesFromRemote() {
     return false;
   }
 
+  // If the remote stub numbers its lists and sent us only what changed since
+  // the list we last saw, there is no need to compare the whole lists.
+  if (action != eTakeSnapshot &&
+      module_list->IsDeltaFrom(m_loaded_modules.m_generation))
+    return UpdateSOEntriesFromDelta(*module_list);
+
   switch (action) {
   case eTakeSnapshot:
     m_soentries.clear();
@@ -365,6 +371,40 @@ bool DYLDRendezvous::RemoveSOEntriesFromRemote(
   return true;
 }
 
+bool DYLDRendezvous::UpdateSOEntriesFromDelta(
+    const LoadedModuleInfoList &module_list) {
+  for (auto const &modInfo : module_list.m_removed) {
+    SOEntry entry;
+    if (!FillSOEntryFromModuleInfo(modInfo, entry))
+      return false;
+
+    // Only remove shared libraries and not the executable.
+    if (!SOEntryIsMainExecutable(entry)) {
+      auto pos = std::find(m_soentries.begin(), m_soentries.end(), entry);
+      if (pos == m_soentries.end())
+        return false;
+
+      m_soentries.erase(pos);
+      m_removed_soentries.push_back(entry);
+    }
+  }
+
+  for (auto const &modInfo : module_list.m_added) {
+    SOEntry entry;
+    if (!FillSOEntryFromModuleInfo(modInfo, entry))
+      return false;
+
+    // Only add shared libraries and not the executable.
+    if (!SOEntryIsMainExecutable(entry)) {
+      m_soentries.push_back(entry);
+      m_added_soentries.push_back(entry);
+    }
+  }
+
+  m_loaded_modules = module_list;
+  return true;
+}
+
 bool DYLDRendezvous::AddSOEntries() {
   SOEntry entry;
   iterator pos;
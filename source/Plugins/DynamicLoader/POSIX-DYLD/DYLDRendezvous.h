@@ -237,6 +237,10 @@ protected:
 
   bool RemoveSOEntriesFromRemote(const LoadedModuleInfoList &module_list);
 
+  /// Applies the added and removed modules of a list that is a delta from
+  /// m_loaded_modules.
+  bool UpdateSOEntriesFromDelta(const LoadedModuleInfoList &module_list);
+
   bool AddSOEntries();
 
   bool RemoveSOEntries();
@@ -574,6 +574,12 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   m_process->PrefetchModuleSpecs(
       module_names, m_process->GetTarget().GetArchitecture().GetTriple());
 
+  std::vector<ModuleSpec> module_specs;
+  for (const FileSpec &module_name : module_names)
+    module_specs.emplace_back(module_name,
+                              m_process->GetTarget().GetArchitecture());
+  PreloadModules(module_specs);
+
   for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I) {
     ModuleSP module_sp =
         LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
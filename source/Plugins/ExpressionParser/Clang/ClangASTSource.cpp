@@ -300,6 +300,13 @@ void ClangASTSource::CompleteType(TagDecl *tag_decl) {
     return;
   }
 
+  // Remember where the type originally came from; CompleteTagDeclWithOrigin
+  // below replaces the origin with the definition it finds.
+  Decl *original_decl = nullptr;
+  m_ast_importer_sp->ResolveDeclOrigin(tag_decl, &original_decl, nullptr);
+  const TagDecl *original_tag_decl =
+      llvm::dyn_cast_or_null<TagDecl>(original_decl);
+
   if (!m_ast_importer_sp->CompleteTagDecl(tag_decl)) {
     // We couldn't complete the type.  Maybe there's a definition somewhere
     // else that can be completed.
@@ -360,8 +367,11 @@ void ClangASTSource::CompleteType(TagDecl *tag_decl) {
               const_cast<TagDecl *>(tag_type->getDecl());
 
           if (m_ast_importer_sp->CompleteTagDeclWithOrigin(tag_decl,
-                                                           candidate_tag_decl))
+                                                           candidate_tag_decl)) {
+            m_ast_importer_sp->RememberCompleteDefinition(original_tag_decl,
+                                                          candidate_tag_decl);
             found = true;
+          }
         }
       }
     } else {
@@ -404,8 +414,11 @@ void ClangASTSource::CompleteType(TagDecl *tag_decl) {
           continue;
 
         if (m_ast_importer_sp->CompleteTagDeclWithOrigin(tag_decl,
-                                                         candidate_tag_decl))
+                                                         candidate_tag_decl)) {
+          m_ast_importer_sp->RememberCompleteDefinition(original_tag_decl,
+                                                        candidate_tag_decl);
           found = true;
+        }
       }
     }
   }
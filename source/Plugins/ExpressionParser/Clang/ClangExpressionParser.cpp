@@ -305,8 +305,24 @@ ClangExpressionParser::ClangExpressionParser(
     opts.IncludeModuleFiles = true;
   }
 
-  // Make sure clang uses the same VFS as LLDB.
-  m_compiler->createFileManager(FileSystem::Instance().GetVirtualFileSystem());
+  // Parts of the compiler setup that don't depend on the expression are kept
+  // with the target's persistent state and shared between parsers.
+  auto *clang_persistent_vars =
+      llvm::cast_or_null<ClangPersistentVariables>(
+          target_sp->GetPersistentExpressionStateForLanguage(
+              lldb::eLanguageTypeC));
+  auto *clang_expr = dyn_cast<ClangUserExpression>(&m_expr);
+  const bool imports_cxx_modules =
+      clang_expr && clang_expr->DidImportCxxModules();
+
+  // Make sure clang uses the same VFS as LLDB. Reuse the target's file
+  // manager so that its cached lookups survive from one expression to the
+  // next, unless we are going to (re)build modules that would invalidate it.
+  if (clang_persistent_vars && !imports_cxx_modules)
+    m_compiler->setFileManager(&clang_persistent_vars->GetFileManager());
+  else
+    m_compiler->createFileManager(
+        FileSystem::Instance().GetVirtualFileSystem());
 
   lldb::LanguageType frame_lang =
       expr.Language(); // defaults to lldb::eLanguageTypeUnknown
@@ -403,8 +419,14 @@ ClangExpressionParser::ClangExpressionParser(
 
   // 4. Create and install the target on the compiler.
   m_compiler->createDiagnostics();
-  auto target_info = TargetInfo::CreateTargetInfo(
-      m_compiler->getDiagnostics(), m_compiler->getInvocation().TargetOpts);
+  TargetInfo *target_info =
+      clang_persistent_vars
+          ? clang_persistent_vars->GetTargetInfo(
+                m_compiler->getDiagnostics(),
+                m_compiler->getInvocation().TargetOpts)
+          : TargetInfo::CreateTargetInfo(
+                m_compiler->getDiagnostics(),
+                m_compiler->getInvocation().TargetOpts);
   if (log) {
     LLDB_LOGF(log, "Using SIMD alignment: %d",
               target_info->getSimdDefaultAlign());
@@ -486,8 +508,7 @@ ClangExpressionParser::ClangExpressionParser(
   // long time parsing and importing debug information.
   lang_opts.SpellChecking = false;
 
-  auto *clang_expr = dyn_cast<ClangUserExpression>(&m_expr);
-  if (clang_expr && clang_expr->DidImportCxxModules()) {
+  if (imports_cxx_modules) {
     LLDB_LOG(log, "Adding lang options for importing C++ modules");
 
     lang_opts.Modules = true;
@@ -562,17 +583,12 @@ ClangExpressionParser::ClangExpressionParser(
   m_compiler->getDiagnostics().setClient(new ClangDiagnosticManagerAdapter);
 
   // 7. Set up the source management objects inside the compiler
-  m_compiler->createFileManager();
   if (!m_compiler->hasSourceManager())
     m_compiler->createSourceManager(m_compiler->getFileManager());
   m_compiler->createPreprocessor(TU_Complete);
 
-  if (ClangModulesDeclVendor *decl_vendor =
-          target_sp->GetClangModulesDeclVendor()) {
-    ClangPersistentVariables *clang_persistent_vars =
-        llvm::cast<ClangPersistentVariables>(
-            target_sp->GetPersistentExpressionStateForLanguage(
-                lldb::eLanguageTypeC));
+  ClangModulesDeclVendor *decl_vendor = target_sp->GetClangModulesDeclVendor();
+  if (decl_vendor && clang_persistent_vars) {
     std::unique_ptr<PPCallbacks> pp_callbacks(
         new LLDBPreprocessorCallbacks(*decl_vendor, *clang_persistent_vars));
     m_pp_callbacks =
@@ -10,6 +10,7 @@
 #include "lldb/Expression/IRExecutionUnit.h"
 
 #include "lldb/Core/Value.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Symbol/ClangASTContext.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/DataExtractor.h"
@@ -22,7 +23,11 @@
 #include "swift/AST/Decl.h"
 #include "swift/AST/Pattern.h"
 #include "clang/AST/Decl.h"
+#include "clang/Basic/FileManager.h"
+#include "clang/Basic/TargetInfo.h"
+#include "clang/Basic/TargetOptions.h"
 
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringMap.h"
 
 using namespace lldb;
@@ -31,6 +36,8 @@ using namespace lldb_private;
 ClangPersistentVariables::ClangPersistentVariables()
     : lldb_private::PersistentExpressionState(LLVMCastKind::eKindClang) {}
 
+ClangPersistentVariables::~ClangPersistentVariables() = default;
+
 ExpressionVariableSP ClangPersistentVariables::CreatePersistentVariable(
     const lldb::ValueObjectSP &valobj_sp) {
   return AddNewlyConstructedVariable(new ClangExpressionVariable(valobj_sp));
@@ -121,3 +128,27 @@ ClangPersistentVariables::GetPersistentDecl(ConstString name) {
   else
     return i->second;
 }
+
+clang::FileManager &ClangPersistentVariables::GetFileManager() {
+  if (!m_file_manager)
+    m_file_manager = new clang::FileManager(
+        clang::FileSystemOptions(),
+        FileSystem::Instance().GetVirtualFileSystem());
+  return *m_file_manager;
+}
+
+clang::TargetInfo *ClangPersistentVariables::GetTargetInfo(
+    clang::DiagnosticsEngine &diags,
+    const std::shared_ptr<clang::TargetOptions> &opts) {
+  // These are all the options the expression parser sets or a language
+  // runtime overrides. The target is adjusted to the language options of each
+  // expression, but TargetInfo::adjust only looks at language options that
+  // the expression parser never changes, so sharing the target is safe.
+  std::string key = opts->Triple + ";" + opts->CPU + ";" + opts->ABI + ";" +
+                    opts->FPMath + ";" + llvm::join(opts->Features, ",");
+  if (!m_target_info || key != m_target_info_key) {
+    m_target_info = clang::TargetInfo::CreateTargetInfo(diags, opts);
+    m_target_info_key = m_target_info ? key : std::string();
+  }
+  return m_target_info.get();
+}
@@ -17,12 +17,20 @@
 #include "lldb/Expression/ExpressionVariable.h"
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/StringRef.h"
 
 #include <set>
 #include <string>
 #include <unordered_map>
 
+namespace clang {
+class DiagnosticsEngine;
+class FileManager;
+class TargetInfo;
+class TargetOptions;
+} // namespace clang
+
 namespace lldb_private {
 
 /// \class ClangPersistentVariables ClangPersistentVariables.h
@@ -39,7 +47,7 @@ public:
   //----------------------------------------------------------------------
   ClangPersistentVariables();
 
-  ~ClangPersistentVariables() override = default;
+  ~ClangPersistentVariables() override;
 
   // llvm casting support
   static bool classof(const PersistentExpressionState *pv) {
@@ -91,6 +99,17 @@ public:
     return m_hand_loaded_clang_modules;
   }
 
+  /// Returns the file manager shared by the expressions parsed for this
+  /// target, so header and module map lookups are only stat'ed once instead
+  /// of once per expression.
+  clang::FileManager &GetFileManager();
+
+  /// Returns a clang::TargetInfo for \a opts, reusing the one created for
+  /// the previous expression when the target options haven't changed.
+  clang::TargetInfo *
+  GetTargetInfo(clang::DiagnosticsEngine &diags,
+                const std::shared_ptr<clang::TargetOptions> &opts);
+
 private:
   // The counter used by GetNextPersistentVariableName
   uint32_t m_next_persistent_variable_id = 0;
@@ -123,6 +142,13 @@ private:
       m_hand_loaded_clang_modules; ///< These are Clang modules we hand-loaded;
                                    ///these are the highest-
                                    ///< priority source for macros.
+
+  llvm::IntrusiveRefCntPtr<clang::FileManager>
+      m_file_manager; ///< Shared by all expression parsers for the target.
+
+  std::string m_target_info_key; ///< The options m_target_info was made for.
+  llvm::IntrusiveRefCntPtr<clang::TargetInfo>
+      m_target_info; ///< Shared by all expression parsers for the target.
 };
 
 } // namespace lldb_private
@@ -54,6 +54,7 @@
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/StreamString.h"
+#include "lldb/Utility/Timer.h"
 
 #include "clang/AST/DeclCXX.h"
 #include "clang/AST/DeclObjC.h"
@@ -522,6 +523,8 @@ bool ClangUserExpression::Parse(DiagnosticManager &diagnostic_manager,
                                 lldb_private::ExecutionPolicy execution_policy,
                                 bool keep_result_in_memory,
                                 bool generate_debug_info) {
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, LLVM_PRETTY_FUNCTION);
   Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
 
   if (!PrepareForParsing(diagnostic_manager, exe_ctx, /*for_completion*/ false))
@@ -574,7 +577,13 @@ bool ClangUserExpression::Parse(DiagnosticManager &diagnostic_manager,
   ClangExpressionParser parser(exe_scope, *this, generate_debug_info,
                                m_include_directories);
 
-  unsigned num_errors = parser.Parse(diagnostic_manager);
+  unsigned num_errors;
+  {
+    // Clang's Sema and IRGen run inside Parse(), so this is all parse time.
+    ExpressionPhaseTimer timer(m_options.GetStatistics(),
+                               ExpressionStatistics::eParse);
+    num_errors = parser.Parse(diagnostic_manager);
+  }
 
   // Check here for FixItHints.  If there are any try to apply the fixits and
   // set the fixed text in m_fixed_text before returning an error.
@@ -600,6 +609,8 @@ bool ClangUserExpression::Parse(DiagnosticManager &diagnostic_manager,
   //
 
   {
+    ExpressionPhaseTimer timer(m_options.GetStatistics(),
+                               ExpressionStatistics::eJIT);
     Status jit_error = parser.PrepareForExecution(
         m_jit_start_addr, m_jit_end_addr, m_execution_unit_sp, exe_ctx,
         m_can_interpret, execution_policy);
@@ -223,7 +223,68 @@ public:
     return m_staged_decls;
   }
 
+  /// Take the modules that auto-import deferred. They are loaded one at a
+  /// time when a name can't be found otherwise.
+  void SetDeferredImports(std::vector<SourceModule> deferred_imports,
+                          SwiftASTContext &swift_ast_context,
+                          lldb::StackFrameWP stack_frame_wp) {
+    m_deferred_imports = std::move(deferred_imports);
+    m_swift_ast_context = &swift_ast_context;
+    m_stack_frame_wp = stack_frame_wp;
+  }
+
+  /// Returns true if auto-import deferred any modules, whether or not they
+  /// were loaded later.
+  bool HasDeferredImports() const {
+    return !m_deferred_imports.empty();
+  }
+
 protected:
+  /// Look up \a name in the deferred modules loaded so far, and load more of
+  /// them until \a name is found or none are left.
+  void LookupInDeferredImports(swift::DeclBaseName name,
+                               std::vector<swift::ValueDecl *> &results) {
+    // Also search the modules that are re-exported, so that, e.g., finding
+    // NSString works by deferring the Foundation overlay.
+    auto lookup = [&](swift::ModuleDecl *module) {
+      llvm::SmallVector<swift::ValueDecl *, 4> decls;
+      module->forAllVisibleModules(
+          {}, [&](swift::ModuleDecl::ImportedModule import) {
+            import.second->lookupValue(name, swift::NLKind::UnqualifiedLookup,
+                                       decls);
+            return true;
+          });
+      results.insert(results.end(), decls.begin(), decls.end());
+    };
+
+    for (swift::ModuleDecl *module : m_loaded_deferred_imports)
+      lookup(module);
+
+    while (results.empty() &&
+           m_next_deferred_import < m_deferred_imports.size()) {
+      const SourceModule &module_info =
+          m_deferred_imports[m_next_deferred_import++];
+      Status error;
+      swift::ModuleDecl *module = SwiftASTContext::LoadDeferredImport(
+          *m_swift_ast_context, module_info, m_stack_frame_wp, error);
+      if (!module) {
+        if (m_log)
+          m_log->Printf("[LLDBNameLookup::LookupInDeferredImports] Couldn't "
+                        "import module %s: %s",
+                        module_info.path.front().AsCString(),
+                        error.AsCString());
+        continue;
+      }
+      if (m_log)
+        m_log->Printf("[LLDBNameLookup::LookupInDeferredImports] Imported "
+                      "module %s while searching for %s",
+                      module_info.path.front().AsCString(),
+                      name.getIdentifier().str().str().c_str());
+      m_loaded_deferred_imports.push_back(module);
+      lookup(module);
+    }
+  }
+
   Log *m_log;
   swift::SourceFile &m_source_file;
   SwiftExpressionParser::SILVariableMap &m_variable_map;
@@ -233,6 +294,12 @@ protected:
   // Subclasses stage globalized decls in this map. They get copied
   // over to the SwiftPersistentVariable store if the parse succeeds.
   SwiftPersistentExpressionState::SwiftDeclMap m_staged_decls;
+
+  std::vector<SourceModule> m_deferred_imports;
+  size_t m_next_deferred_import = 0;
+  std::vector<swift::ModuleDecl *> m_loaded_deferred_imports;
+  SwiftASTContext *m_swift_ast_context = nullptr;
+  lldb::StackFrameWP m_stack_frame_wp;
 };
 
 /// A name lookup class for debugger expr mode.
@@ -388,6 +455,10 @@ public:
       }
     }
 
+    // Finally, try the modules whose import was deferred.
+    if (results.empty() && RV.empty())
+      LookupInDeferredImports(Name, results);
+
     for (size_t idx = 0; idx < results.size(); idx++) {
       swift::ValueDecl *value_decl = results[idx];
       // No import required.
@@ -1173,7 +1244,9 @@ struct ParsedExpression {
 } // namespace
 
 /// Attempt to parse an expression and import all the Swift modules
-/// the expression and its context depend on.
+/// the expression and its context depend on. If \a lazy_import is true,
+/// the modules imported by the compile unit are only imported when name
+/// lookup needs them.
 static llvm::Expected<ParsedExpression>
 ParseAndImport(SwiftASTContext *swift_ast_context, Expression &expr,
                SwiftExpressionParser::SILVariableMap &variable_map,
@@ -1182,7 +1255,7 @@ ParseAndImport(SwiftASTContext *swift_ast_context, Expression &expr,
                lldb::StackFrameWP &stack_frame_wp, SymbolContext &sc,
                ExecutionContextScope &exe_scope,
                const EvaluateExpressionOptions &options, bool repl,
-               bool playground) {
+               bool playground, bool lazy_import) {
 
   auto should_disable_objc_runtime = [&]() {
     lldb::StackFrameSP this_frame_sp(stack_frame_wp.lock());
@@ -1298,11 +1371,15 @@ ParseAndImport(SwiftASTContext *swift_ast_context, Expression &expr,
   }
 
   Status auto_import_error;
-  if (!SwiftASTContext::PerformAutoImport(*swift_ast_context, sc,
-                                          stack_frame_wp, source_file,
-                                          auto_import_error))
+  std::vector<SourceModule> deferred_imports;
+  if (!SwiftASTContext::PerformAutoImport(
+          *swift_ast_context, sc, stack_frame_wp, source_file,
+          auto_import_error, lazy_import ? &deferred_imports : nullptr))
     return make_error<ModuleImportError>(llvm::Twine("in auto-import:\n") +
                                          auto_import_error.AsCString());
+  if (!deferred_imports.empty())
+    external_lookup->SetDeferredImports(std::move(deferred_imports),
+                                        *swift_ast_context, stack_frame_wp);
 
   // Swift Modules that rely on shared libraries (not frameworks)
   // don't record the link information in the swiftmodule file, so we
@@ -1420,15 +1497,9 @@ unsigned SwiftExpressionParser::Parse(DiagnosticManager &diagnostic_manager,
   if (!m_exe_scope)
     return false;
 
-  // Parse the expression an import all nececssary swift modules.
-  auto parsed_expr =
-      ParseAndImport(m_swift_ast_context->get(), m_expr, variable_map,
-                     buffer_id, diagnostic_manager, *this, m_stack_frame_wp,
-                     m_sc, *m_exe_scope, m_options, repl, playground);
-
-  if (!parsed_expr) {
+  auto HandleParseError = [&](llvm::Error error) -> unsigned {
     bool retry = false;
-    handleAllErrors(parsed_expr.takeError(),
+    handleAllErrors(std::move(error),
                     [&](const ModuleImportError &MIE) {
                       if (swift_ast_ctx->GetClangImporter())
                         // Already on backup power.
@@ -1461,14 +1532,58 @@ unsigned SwiftExpressionParser::Parse(DiagnosticManager &diagnostic_manager,
     // mismatches.
     m_sc.target_sp->SetUseScratchTypesystemPerModule(true);
     return 2;
-  }
+  };
+
+  const bool lazy_import = !repl && !playground && m_sc.target_sp &&
+                           m_sc.target_sp->GetSwiftLazyAutoImport();
+
+  ExpressionStatistics *stats = m_options.GetStatistics();
+
+  // Parse the expression an import all nececssary swift modules.
+  ExpressionPhaseTimer parse_timer(stats, ExpressionStatistics::eParse);
+  auto parsed_expr =
+      ParseAndImport(m_swift_ast_context->get(), m_expr, variable_map,
+                     buffer_id, diagnostic_manager, *this, m_stack_frame_wp,
+                     m_sc, *m_exe_scope, m_options, repl, playground,
+                     lazy_import);
+  parse_timer.Stop();
+
+  if (!parsed_expr)
+    return HandleParseError(parsed_expr.takeError());
 
   // Not persistent because we're building source files one at a time.
-  swift::TopLevelContext top_level_context;
+  swift::TopLevelContext top_level_context, eager_top_level_context;
   swift::OptionSet<swift::TypeCheckingFlags> type_checking_options;
 
-  swift::performTypeChecking(parsed_expr->source_file, top_level_context,
-                             type_checking_options);
+  {
+    ExpressionPhaseTimer timer(stats, ExpressionStatistics::eSema);
+    swift::performTypeChecking(parsed_expr->source_file, top_level_context,
+                               type_checking_options);
+  }
+
+  if (swift_ast_ctx->HasErrors() &&
+      parsed_expr->external_lookup.HasDeferredImports()) {
+    // Member lookups and extensions don't go through the debugger
+    // client, so the expression may have needed a module that was never
+    // imported. Parse it again with all modules imported up front.
+    if (log)
+      log->Printf("Type checking with deferred imports failed, parsing the "
+                  "expression again with all modules imported.");
+    variable_map.clear();
+    ExpressionPhaseTimer parse_timer(stats, ExpressionStatistics::eParse);
+    parsed_expr =
+        ParseAndImport(m_swift_ast_context->get(), m_expr, variable_map,
+                       buffer_id, diagnostic_manager, *this, m_stack_frame_wp,
+                       m_sc, *m_exe_scope, m_options, repl, playground,
+                       /*lazy_import=*/false);
+    parse_timer.Stop();
+    if (!parsed_expr)
+      return HandleParseError(parsed_expr.takeError());
+
+    ExpressionPhaseTimer timer(stats, ExpressionStatistics::eSema);
+    swift::performTypeChecking(parsed_expr->source_file,
+                               eager_top_level_context, type_checking_options);
+  }
 
   if (swift_ast_ctx->HasErrors()) {
     DiagnoseSwiftASTContextError();
@@ -1641,9 +1756,11 @@ unsigned SwiftExpressionParser::Parse(DiagnosticManager &diagnostic_manager,
       new swift::Lowering::TypeConverter(
           *parsed_expr->source_file.getParentModule()));
 
+  ExpressionPhaseTimer sil_timer(stats, ExpressionStatistics::eSIL);
   std::unique_ptr<swift::SILModule> sil_module(swift::performSILGeneration(
       parsed_expr->source_file, *sil_types,
       swift_ast_ctx->GetSILOptions()));
+  sil_timer.Stop();
 
   if (log) {
     std::string s;
@@ -1672,7 +1789,10 @@ unsigned SwiftExpressionParser::Parse(DiagnosticManager &diagnostic_manager,
     log->PutCString(s.c_str());
   }
 
-  runSILDiagnosticPasses(*sil_module);
+  {
+    ExpressionPhaseTimer timer(stats, ExpressionStatistics::eSIL);
+    runSILDiagnosticPasses(*sil_module);
+  }
 
   if (log) {
     std::string s;
@@ -1694,6 +1814,7 @@ unsigned SwiftExpressionParser::Parse(DiagnosticManager &diagnostic_manager,
     std::lock_guard<std::recursive_mutex> global_context_locker(
         IRExecutionUnit::GetLLVMGlobalContextMutex());
 
+    ExpressionPhaseTimer timer(stats, ExpressionStatistics::eIRGen);
     m_module = swift::performIRGeneration(
         swift_ast_ctx->GetIRGenOptions(), &parsed_expr->module,
         std::move(sil_module), "lldb_module",
@@ -12,12 +12,19 @@
 
 #include "SwiftPersistentExpressionState.h"
 #include "SwiftExpressionVariable.h"
+#include "SwiftUserExpression.h"
 #include "lldb/Expression/IRExecutionUnit.h"
 
 #include "lldb/Core/Value.h"
 
+#include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/SwiftASTContext.h" // Needed for llvm::isa<SwiftASTContext>(...)
 #include "lldb/Symbol/TypeSystem.h"
+#include "lldb/Symbol/Variable.h"
+#include "lldb/Symbol/VariableList.h"
+#include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/StackFrame.h"
 
 #include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Log.h"
@@ -85,6 +92,12 @@ void SwiftPersistentExpressionState::RemovePersistentVariable(
   }
 }
 
+void SwiftPersistentExpressionState::EvictResultVariable(
+    lldb::ExpressionVariableSP variable) {
+  RemoveVariable(variable);
+  m_swift_persistent_decls.RemoveDecls(variable->GetName());
+}
+
 llvm::Optional<CompilerType>
 SwiftPersistentExpressionState::GetCompilerTypeFromPersistentDecl(
     ConstString type_name) {
@@ -204,19 +217,29 @@ void SwiftPersistentExpressionState::SwiftDeclMap::CopyDeclsTo(
     target_map.AddDecl(elem.second, true, ConstString());
 }
 
+void SwiftPersistentExpressionState::SwiftDeclMap::RemoveDecls(
+    ConstString name) {
+  m_swift_decls.erase(name.GetStringRef().str());
+}
+
 void SwiftPersistentExpressionState::RegisterSwiftPersistentDecl(
     swift::ValueDecl *value_decl) {
   m_swift_persistent_decls.AddDecl(value_decl, true, ConstString());
+  ++m_generation;
 }
 
 void SwiftPersistentExpressionState::RegisterSwiftPersistentDeclAlias(
     swift::ValueDecl *value_decl, ConstString name) {
   m_swift_persistent_decls.AddDecl(value_decl, true, name);
+  ++m_generation;
 }
 
 void SwiftPersistentExpressionState::CopyInSwiftPersistentDecls(
     SwiftPersistentExpressionState::SwiftDeclMap &target_map) {
+  if (target_map.empty())
+    return;
   target_map.CopyDeclsTo(m_swift_persistent_decls);
+  ++m_generation;
 }
 
 bool SwiftPersistentExpressionState::GetSwiftPersistentDecls(
@@ -226,3 +249,69 @@ bool SwiftPersistentExpressionState::GetSwiftPersistentDecls(
   return m_swift_persistent_decls.FindMatchingDecls(name, excluding_equivalents,
                                                     matches);
 }
+
+std::string SwiftPersistentExpressionState::GetUserExpressionCacheKey(
+    ExecutionContext &exe_ctx, llvm::StringRef expr, llvm::StringRef prefix,
+    const EvaluateExpressionOptions &options) {
+  if (options.GetREPLEnabled() || options.GetPlaygroundTransformEnabled() ||
+      options.GetGenerateDebugInfo())
+    return {};
+
+  Process *process = exe_ctx.GetProcessPtr();
+  StackFrame *frame = exe_ctx.GetFramePtr();
+  if (!process || !frame)
+    return {};
+  const SymbolContext &sc =
+      frame->GetSymbolContext(eSymbolContextFunction | eSymbolContextBlock);
+  if (!sc.function)
+    return {};
+
+  StreamString key;
+  key.Printf("%u;%u;%p;%p;%d;%d;%d;", process->GetUniqueID(), m_generation,
+             static_cast<void *>(sc.function), static_cast<void *>(sc.block),
+             options.GetExecutionPolicy(), options.DoesCoerceToId(),
+             options.GetUseDynamic());
+  key.Printf("%zu:", expr.size());
+  key.PutCString(expr);
+  key.Printf("%zu:", prefix.size());
+  key.PutCString(prefix);
+
+  // The expression is compiled against the types of the local variables,
+  // which for generic functions depend on the caller.
+  if (VariableListSP variables = frame->GetInScopeVariableList(false)) {
+    for (size_t idx = 0; idx < variables->GetSize(); ++idx) {
+      VariableSP var_sp = variables->GetVariableAtIndex(idx);
+      ValueObjectSP valobj_sp = frame->GetValueObjectForFrameVariable(
+          var_sp, lldb::eDynamicDontRunTarget);
+      if (!valobj_sp)
+        continue;
+      key.Printf(";%s:%s", var_sp->GetName().AsCString(""),
+                 valobj_sp->GetTypeName().AsCString(""));
+    }
+  }
+  return key.GetString();
+}
+
+lldb::UserExpressionSP
+SwiftPersistentExpressionState::GetCachedUserExpression(llvm::StringRef key) {
+  auto it = m_user_expression_cache.find(key);
+  if (it == m_user_expression_cache.end())
+    return {};
+  return it->second;
+}
+
+void SwiftPersistentExpressionState::CacheUserExpression(
+    llvm::StringRef key, lldb::UserExpressionSP user_expression_sp) {
+  // Every entry keeps its JIT'ed code alive, so bound the size of the cache
+  // rather than tracking which entries are still useful.
+  const size_t max_cached_expressions = 256;
+  if (m_user_expression_cache.size() >= max_cached_expressions)
+    m_user_expression_cache.clear();
+
+  // Don't keep the scratch context locked for as long as the expression is
+  // cached, see SwiftASTContextReader.
+  if (auto *swift_expr =
+          llvm::dyn_cast<SwiftUserExpression>(user_expression_sp.get()))
+    swift_expr->ReleaseParser();
+  m_user_expression_cache[key] = std::move(user_expression_sp);
+}
@@ -18,6 +18,7 @@
 #include "lldb/Expression/ExpressionVariable.h"
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 
 #include <set>
@@ -53,7 +54,10 @@ public:
         std::vector<swift::ValueDecl *> &matches);
 
     void CopyDeclsTo(SwiftDeclMap &target_map);
+    /// Remove all of the decls called \a name.
+    void RemoveDecls(ConstString name);
     static bool DeclsAreEquivalent(swift::Decl *lhs, swift::Decl *rhs);
+    bool empty() const { return m_swift_decls.empty(); }
 
   private:
     typedef std::unordered_multimap<std::string, swift::ValueDecl *>
@@ -91,6 +95,10 @@ public:
 
   void RemovePersistentVariable(lldb::ExpressionVariableSP variable) override;
 
+  /// Also forget the decl of the evicted result, so that expressions can't
+  /// refer to a variable that is gone.
+  void EvictResultVariable(lldb::ExpressionVariableSP variable) override;
+
   llvm::Optional<CompilerType>
   GetCompilerTypeFromPersistentDecl(ConstString type_name) override;
 
@@ -112,11 +120,29 @@ public:
   // This just adds this module to the list of hand-loaded modules, it doesn't
   // actually load it.
   void AddHandLoadedModule(ConstString module_name) {
-    m_hand_loaded_modules.insert(module_name);
+    if (m_hand_loaded_modules.insert(module_name).second)
+      ++m_generation;
   }
 
   /// This returns the list of hand-loaded modules.
-  HandLoadedModuleSet GetHandLoadedModules() { return m_hand_loaded_modules; }
+  const HandLoadedModuleSet &GetHandLoadedModules() {
+    return m_hand_loaded_modules;
+  }
+
+  /// The key covers the process, the function and block of the frame, the
+  /// dynamic types of the variables in scope, and the persistent decls and
+  /// hand-loaded modules expressions can refer to. Expressions evaluated in
+  /// the REPL or a playground, and expressions with debug info, are not
+  /// cached.
+  std::string
+  GetUserExpressionCacheKey(ExecutionContext &exe_ctx, llvm::StringRef expr,
+                            llvm::StringRef prefix,
+                            const EvaluateExpressionOptions &options) override;
+
+  lldb::UserExpressionSP GetCachedUserExpression(llvm::StringRef key) override;
+
+  void CacheUserExpression(llvm::StringRef key,
+                           lldb::UserExpressionSP user_expression_sp) override;
 
 private:
   uint32_t m_next_persistent_variable_id; ///< The counter used by
@@ -131,6 +157,13 @@ private:
   HandLoadedModuleSet m_hand_loaded_modules; ///< These are the names of modules
                                              /// that we have loaded by
   ///< hand into the Contexts we make for parsing.
+
+  /// Incremented whenever a change to the persistent decls or the
+  /// hand-loaded modules may change how an expression compiles.
+  uint32_t m_generation = 0;
+
+  /// The expressions cached by CacheUserExpression.
+  llvm::StringMap<lldb::UserExpressionSP> m_user_expression_cache;
 };
 } // namespace lldb_private
 
@@ -203,21 +203,12 @@ public:
       return;
     }
 
-    swift::Demangle::Context demangle_ctx;
-    llvm::StringRef result_name = SwiftASTManipulator::GetResultName();
-
-    for (const IRExecutionUnit::JittedGlobalVariable &variable :
-         execution_unit->GetJittedGlobalVariables()) {
-      swift::Demangle::NodePointer node_pointer =
-          demangle_ctx.demangleSymbolAsNode(variable.m_name.GetStringRef());
-
-      llvm::StringRef variable_name = GetNameOfDemangledVariable(node_pointer);
-      if (variable_name == result_name) {
-        MakeREPLResult(*execution_unit, err, &variable);
-        return;
-      }
-
-      demangle_ctx.clear();
+    if (const IRExecutionUnit::JittedGlobalVariable *variable =
+            llvm::cast<SwiftREPLMaterializer>(m_parent)
+                ->FindJittedGlobalVariable(
+                    SwiftASTManipulator::GetResultName())) {
+      MakeREPLResult(*execution_unit, err, variable);
+      return;
     }
 
     llvm::Optional<uint64_t> size =
@@ -311,6 +302,34 @@ private:
   Materializer::PersistentVariableDelegate *m_delegate;
 };
 
+const IRExecutionUnit::JittedGlobalVariable *
+SwiftREPLMaterializer::FindJittedGlobalVariable(llvm::StringRef name) {
+  if (!m_execution_unit)
+    return nullptr;
+
+  if (!m_indexed_jitted_globals) {
+    m_indexed_jitted_globals = true;
+    swift::Demangle::Context demangle_ctx;
+    for (const IRExecutionUnit::JittedGlobalVariable &variable :
+         m_execution_unit->GetJittedGlobalVariables()) {
+      // e.g.
+      // kind=Global
+      //   kind=Variable
+      //     kind=Module, text="lldb_expr_0"
+      //     kind=Identifier, text="a"
+      swift::Demangle::NodePointer node_pointer =
+          demangle_ctx.demangleSymbolAsNode(variable.m_name.GetStringRef());
+      llvm::StringRef variable_name = GetNameOfDemangledVariable(node_pointer);
+      // Like the linear search this replaces, the first match wins.
+      if (!variable_name.empty())
+        m_jitted_globals.insert({variable_name, &variable});
+      demangle_ctx.clear();
+    }
+  }
+
+  return m_jitted_globals.lookup(name);
+}
+
 uint32_t SwiftREPLMaterializer::AddREPLResultVariable(
     const CompilerType &type, swift::ValueDecl *decl,
     PersistentVariableDelegate *delegate, Status &err) {
@@ -355,82 +374,61 @@ public:
       return;
     }
 
-    swift::Demangle::Context demangle_ctx;
-
-    for (const IRExecutionUnit::JittedGlobalVariable &variable :
-         execution_unit->GetJittedGlobalVariables()) {
-      // e.g.
-      // kind=Global
-      //   kind=Variable
-      //     kind=Module, text="lldb_expr_0"
-      //     kind=Identifier, text="a"
-
-      swift::Demangle::NodePointer node_pointer =
-          demangle_ctx.demangleSymbolAsNode(variable.m_name.GetStringRef());
-
-      llvm::StringRef last_component = GetNameOfDemangledVariable(node_pointer);
-
-      if (last_component.empty())
-        continue;
+    const IRExecutionUnit::JittedGlobalVariable *variable =
+        m_parent->FindJittedGlobalVariable(
+            m_persistent_variable_sp->GetName().GetStringRef());
+    if (!variable) {
+      err.SetErrorToGenericError();
+      err.SetErrorStringWithFormat(
+          "Couldn't dematerialize %s: corresponding symbol wasn't found",
+          m_persistent_variable_sp->GetName().GetCString());
+      return;
+    }
 
-      if (m_persistent_variable_sp->GetName().GetStringRef().equals(
-              last_component)) {
-        ExecutionContextScope *exe_scope =
-            execution_unit->GetBestExecutionContextScope();
+    ExecutionContextScope *exe_scope =
+        execution_unit->GetBestExecutionContextScope();
 
-        if (!exe_scope) {
-          err.SetErrorString("Couldn't dematerialize a persistent variable: "
-                             "invalid execution context scope");
-          return;
-        }
+    if (!exe_scope) {
+      err.SetErrorString("Couldn't dematerialize a persistent variable: "
+                         "invalid execution context scope");
+      return;
+    }
 
-        CompilerType compiler_type =
-            m_persistent_variable_sp->GetCompilerType();
+    CompilerType compiler_type = m_persistent_variable_sp->GetCompilerType();
 
-        m_persistent_variable_sp->m_live_sp = ValueObjectConstResult::Create(
-            exe_scope, compiler_type, m_persistent_variable_sp->GetName(),
-            variable.m_remote_addr, eAddressTypeLoad,
-            execution_unit->GetAddressByteSize());
+    m_persistent_variable_sp->m_live_sp = ValueObjectConstResult::Create(
+        exe_scope, compiler_type, m_persistent_variable_sp->GetName(),
+        variable->m_remote_addr, eAddressTypeLoad,
+        execution_unit->GetAddressByteSize());
 
-        // Read the contents of the spare memory area
+    // Read the contents of the spare memory area
 
-        m_persistent_variable_sp->ValueUpdated();
+    m_persistent_variable_sp->ValueUpdated();
 
-        Status read_error;
-        lldb::addr_t var_addr = variable.m_remote_addr;
+    Status read_error;
+    lldb::addr_t var_addr = variable->m_remote_addr;
 
-        // Handle resilient globals in fixed-size buffers.
-        if (Flags(m_persistent_variable_sp->m_flags)
+    // Handle resilient globals in fixed-size buffers.
+    if (Flags(m_persistent_variable_sp->m_flags)
             .Test(ExpressionVariable::EVIsSwiftFixedBuffer))
-          var_addr =
-              FixupResilientGlobal(var_addr, compiler_type, *execution_unit,
-                                   exe_scope->CalculateProcess(), read_error);
-
-        // FIXME: This may not work if the value is not bitwise-takable.
-        execution_unit->ReadMemory(
-            m_persistent_variable_sp->GetValueBytes(), var_addr,
-            m_persistent_variable_sp->GetByteSize(), read_error);
-
-        if (!read_error.Success()) {
-          err.SetErrorStringWithFormat(
-              "couldn't read the contents of %s from memory: %s",
-              m_persistent_variable_sp->GetName().GetCString(),
-              read_error.AsCString());
-          return;
-        }
-
-        m_persistent_variable_sp->m_flags &=
-            ~ExpressionVariable::EVNeedsFreezeDry;
-
-        return;
-      }
-      demangle_ctx.clear();
+      var_addr = FixupResilientGlobal(var_addr, compiler_type, *execution_unit,
+                                      exe_scope->CalculateProcess(), read_error);
+
+    // FIXME: This may not work if the value is not bitwise-takable.
+    execution_unit->ReadMemory(m_persistent_variable_sp->GetValueBytes(),
+                               var_addr, m_persistent_variable_sp->GetByteSize(),
+                               read_error);
+
+    if (!read_error.Success()) {
+      err.SetErrorStringWithFormat(
+          "couldn't read the contents of %s from memory: %s",
+          m_persistent_variable_sp->GetName().GetCString(),
+          read_error.AsCString());
+      return;
     }
 
-    err.SetErrorToGenericError();
-    err.SetErrorStringWithFormat(
-        "Couldn't dematerialize %s: corresponding symbol wasn't found",
-        m_persistent_variable_sp->GetName().GetCString());
+    m_persistent_variable_sp->m_flags &=
+        ~ExpressionVariable::EVNeedsFreezeDry;
   }
 
   void DumpToLog(IRMemoryMap &map, lldb::addr_t process_address, Log *log) {
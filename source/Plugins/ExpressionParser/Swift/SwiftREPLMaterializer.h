@@ -13,8 +13,11 @@
 #ifndef liblldb_SwiftREPLMaterializer_h
 #define liblldb_SwiftREPLMaterializer_h
 
+#include "lldb/Expression/IRExecutionUnit.h"
 #include "lldb/Expression/Materializer.h"
 
+#include "llvm/ADT/StringMap.h"
+
 namespace lldb_private {
 
 class SwiftREPLMaterializer : public Materializer {
@@ -33,10 +36,18 @@ public:
 
   void RegisterExecutionUnit(IRExecutionUnit *execution_unit) {
     m_execution_unit = execution_unit;
+    m_jitted_globals.clear();
+    m_indexed_jitted_globals = false;
   }
 
   IRExecutionUnit *GetExecutionUnit() { return m_execution_unit; }
 
+  /// Return the global variable for the Swift variable \a name in the
+  /// registered execution unit, or null. The names of the globals are
+  /// demangled once, instead of once for every entity that looks one up.
+  const IRExecutionUnit::JittedGlobalVariable *
+  FindJittedGlobalVariable(llvm::StringRef name);
+
   //------------------------------------------------------------------
   // llvm casting support
   //------------------------------------------------------------------
@@ -45,7 +56,11 @@ public:
   }
 
 private:
-  IRExecutionUnit *m_execution_unit;
+  IRExecutionUnit *m_execution_unit = nullptr;
+  /// The globals of m_execution_unit by the name of their variable.
+  llvm::StringMap<const IRExecutionUnit::JittedGlobalVariable *>
+      m_jitted_globals;
+  bool m_indexed_jitted_globals = false;
 };
 }
 
@@ -32,6 +32,7 @@
 #include "lldb/Target/SwiftLanguageRuntime.h"
 #include "lldb/Utility/LLDBAssert.h"
 #include "lldb/Utility/Log.h"
+#include "lldb/Utility/Timer.h"
 
 #include "swift/AST/Type.h"
 #include "swift/AST/Types.h"
@@ -279,6 +280,8 @@ bool SwiftUserExpression::Parse(DiagnosticManager &diagnostic_manager,
                                 lldb_private::ExecutionPolicy execution_policy,
                                 bool keep_result_in_memory,
                                 bool generate_debug_info) {
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, LLVM_PRETTY_FUNCTION);
   Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
 
   Status err;
@@ -407,9 +410,14 @@ bool SwiftUserExpression::Parse(DiagnosticManager &diagnostic_manager,
 
   // Prepare the output of the parser for execution, evaluating it
   // statically if possible.
-  Status jit_error = m_parser->PrepareForExecution(
-      m_jit_start_addr, m_jit_end_addr, m_execution_unit_sp, exe_ctx,
-      m_can_interpret, execution_policy);
+  Status jit_error;
+  {
+    ExpressionPhaseTimer timer(m_options.GetStatistics(),
+                               ExpressionStatistics::eJIT);
+    jit_error = m_parser->PrepareForExecution(
+        m_jit_start_addr, m_jit_end_addr, m_execution_unit_sp, exe_ctx,
+        m_can_interpret, execution_policy);
+  }
 
   if (m_execution_unit_sp) {
     if (m_options.GetREPLEnabled()) {
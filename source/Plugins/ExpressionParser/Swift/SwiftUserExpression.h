@@ -133,6 +133,10 @@ public:
   void WillStartExecuting() override;
   void DidFinishExecuting() override;
 
+  /// Destroy the parser, which holds a reader lock on the scratch
+  /// context. A parsed expression can still be executed afterwards.
+  void ReleaseParser() { m_parser.reset(); }
+
 private:
   //------------------------------------------------------------------
   /// Populate m_in_cplusplus_method and m_in_objectivec_method based on the
@@ -8,7 +8,9 @@
 
 #include "EmulateInstructionARM64.h"
 
+#include <array>
 #include <stdlib.h>
+#include <vector>
 
 #include "lldb/Core/Address.h"
 #include "lldb/Core/PluginManager.h"
@@ -384,7 +386,24 @@ EmulateInstructionARM64::GetOpcodeForInstruction(const uint32_t opcode) {
   };
   static const size_t k_num_arm_opcodes = llvm::array_lengthof(g_opcodes);
 
-  for (size_t i = 0; i < k_num_arm_opcodes; ++i) {
+  // Every mask above covers bits 26-30 of the instruction, so only the
+  // entries that agree with it on those bits can match. Bucket the entries by
+  // these bits once, keeping them in table order so the first match still
+  // wins.
+  static const uint32_t k_dispatch_mask = 0x7c000000;
+  static const uint32_t k_dispatch_shift = 26;
+  static const std::array<std::vector<uint8_t>, 32> g_dispatch = [] {
+    std::array<std::vector<uint8_t>, 32> dispatch;
+    static_assert(k_num_arm_opcodes <= UINT8_MAX, "opcode index overflow");
+    for (size_t i = 0; i < k_num_arm_opcodes; ++i) {
+      assert((g_opcodes[i].mask & k_dispatch_mask) == k_dispatch_mask);
+      dispatch[(g_opcodes[i].value & k_dispatch_mask) >> k_dispatch_shift]
+          .push_back(i);
+    }
+    return dispatch;
+  }();
+
+  for (uint8_t i : g_dispatch[(opcode & k_dispatch_mask) >> k_dispatch_shift]) {
     if ((g_opcodes[i].mask & opcode) == g_opcodes[i].value)
       return &g_opcodes[i];
   }
@@ -60,6 +60,7 @@ EmulateInstructionMIPS::EmulateInstructionMIPS(
     const lldb_private::ArchSpec &arch)
     : EmulateInstruction(arch) {
   /* Create instance of llvm::MCDisassembler */
+  PluginManager::InitializeLLVMTargets();
   std::string Status;
   llvm::Triple triple = arch.GetTriple();
   const llvm::Target *target =
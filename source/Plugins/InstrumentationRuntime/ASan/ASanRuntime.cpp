@@ -14,14 +14,13 @@
 #include "lldb/Core/PluginInterface.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/StreamFile.h"
-#include "lldb/Core/ValueObject.h"
-#include "lldb/Expression/UserExpression.h"
 #include "lldb/Interpreter/CommandReturnObject.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Target/InstrumentationRuntimeStopInfo.h"
 #include "lldb/Target/StopInfo.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
 
@@ -71,7 +70,10 @@ bool AddressSanitizerRuntime::CheckIfRuntimeIsValid(
   return symbol != nullptr;
 }
 
-const char *address_sanitizer_retrieve_report_data_prefix = R"(
+const char *address_sanitizer_retrieve_report_data_function_name =
+    "__lldb_asan_retrieve_report_data";
+
+const char *address_sanitizer_retrieve_report_data_function = R"(
 extern "C"
 {
 int __asan_report_present();
@@ -81,31 +83,22 @@ void *__asan_get_report_sp();
 void *__asan_get_report_address();
 const char *__asan_get_report_description();
 int __asan_get_report_access_type();
-size_t __asan_get_report_access_size();
+__SIZE_TYPE__ __asan_get_report_access_size();
 }
-)";
 
-const char *address_sanitizer_retrieve_report_data_command = R"(
-struct {
-    int present;
-    int access_type;
-    void *pc;
-    void *bp;
-    void *sp;
-    void *address;
-    size_t access_size;
-    const char *description;
-} t;
-
-t.present = __asan_report_present();
-t.access_type = __asan_get_report_access_type();
-t.pc = __asan_get_report_pc();
-t.bp = __asan_get_report_bp();
-t.sp = __asan_get_report_sp();
-t.address = __asan_get_report_address();
-t.access_size = __asan_get_report_access_size();
-t.description = __asan_get_report_description();
-t
+typedef unsigned long long slot_t;
+
+extern "C" void *__lldb_asan_retrieve_report_data(slot_t *out) {
+    out[0] = __asan_report_present();
+    out[1] = __asan_get_report_access_type();
+    out[2] = (slot_t)(unsigned long)__asan_get_report_pc();
+    out[3] = (slot_t)(unsigned long)__asan_get_report_bp();
+    out[4] = (slot_t)(unsigned long)__asan_get_report_sp();
+    out[5] = (slot_t)(unsigned long)__asan_get_report_address();
+    out[6] = __asan_get_report_access_size();
+    out[7] = (slot_t)(unsigned long)__asan_get_report_description();
+    return out;
+}
 )";
 
 StructuredData::ObjectSP AddressSanitizerRuntime::RetrieveReportData() {
@@ -120,54 +113,33 @@ StructuredData::ObjectSP AddressSanitizerRuntime::RetrieveReportData() {
   if (!frame_sp)
     return StructuredData::ObjectSP();
 
-  EvaluateExpressionOptions options;
-  options.SetUnwindOnError(true);
-  options.SetTryAllThreads(true);
-  options.SetStopOthers(true);
-  options.SetIgnoreBreakpoints(true);
-  options.SetTimeout(process_sp->GetUtilityExpressionTimeout());
-  options.SetPrefix(address_sanitizer_retrieve_report_data_prefix);
-  options.SetAutoApplyFixIts(false);
-  options.SetLanguage(eLanguageTypeObjC_plus_plus);
-
-  ValueObjectSP return_value_sp;
   ExecutionContext exe_ctx;
-  Status eval_error;
   frame_sp->CalculateExecutionContext(exe_ctx);
-  ExpressionResults result = UserExpression::Evaluate(
-      exe_ctx, options, address_sanitizer_retrieve_report_data_command, "",
-      return_value_sp, eval_error);
-  if (result != eExpressionCompleted) {
+  llvm::Expected<DataExtractor> data = CallReportFunction(
+      exe_ctx, address_sanitizer_retrieve_report_data_function,
+      address_sanitizer_retrieve_report_data_function_name, 8);
+  if (!data) {
     process_sp->GetTarget().GetDebugger().GetAsyncOutputStream()->Printf(
         "Warning: Cannot evaluate AddressSanitizer expression:\n%s\n",
-        eval_error.AsCString());
+        llvm::toString(data.takeError()).c_str());
     return StructuredData::ObjectSP();
   }
 
-  int present = return_value_sp->GetValueForExpressionPath(".present")
-                    ->GetValueAsUnsigned(0);
+  offset_t offset = 0;
+  int present = data->GetU64(&offset);
   if (present != 1)
     return StructuredData::ObjectSP();
 
-  addr_t pc =
-      return_value_sp->GetValueForExpressionPath(".pc")->GetValueAsUnsigned(0);
+  addr_t access_type = data->GetU64(&offset);
+  addr_t pc = data->GetU64(&offset);
   /* commented out because rdar://problem/18533301
-  addr_t bp =
-  return_value_sp->GetValueForExpressionPath(".bp")->GetValueAsUnsigned(0);
-  addr_t sp =
-  return_value_sp->GetValueForExpressionPath(".sp")->GetValueAsUnsigned(0);
+  addr_t bp = data->GetU64(&offset);
+  addr_t sp = data->GetU64(&offset);
   */
-  addr_t address = return_value_sp->GetValueForExpressionPath(".address")
-                       ->GetValueAsUnsigned(0);
-  addr_t access_type =
-      return_value_sp->GetValueForExpressionPath(".access_type")
-          ->GetValueAsUnsigned(0);
-  addr_t access_size =
-      return_value_sp->GetValueForExpressionPath(".access_size")
-          ->GetValueAsUnsigned(0);
-  addr_t description_ptr =
-      return_value_sp->GetValueForExpressionPath(".description")
-          ->GetValueAsUnsigned(0);
+  offset += 2 * sizeof(uint64_t);
+  addr_t address = data->GetU64(&offset);
+  addr_t access_size = data->GetU64(&offset);
+  addr_t description_ptr = data->GetU64(&offset);
   std::string description;
   Status error;
   process_sp->ReadCStringFromMemory(description_ptr, description, error);
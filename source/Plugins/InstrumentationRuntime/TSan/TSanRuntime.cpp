@@ -15,8 +15,6 @@
 #include "lldb/Core/PluginInterface.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/StreamFile.h"
-#include "lldb/Core/ValueObject.h"
-#include "lldb/Expression/UserExpression.h"
 #include "lldb/Interpreter/CommandReturnObject.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/SymbolContext.h"
@@ -27,6 +25,7 @@
 #include "lldb/Target/StopInfo.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
 
@@ -60,7 +59,13 @@ lldb::InstrumentationRuntimeType ThreadSanitizerRuntime::GetTypeStatic() {
 
 ThreadSanitizerRuntime::~ThreadSanitizerRuntime() { Deactivate(); }
 
-const char *thread_sanitizer_retrieve_report_data_prefix = R"(
+const char *thread_sanitizer_retrieve_report_data_function_name =
+    "__lldb_tsan_retrieve_report_data";
+
+// Copies the current report into 64-bit slots, in the order
+// RetrieveReportData() reads them back. Threads come first, so the thread IDs
+// in the rest of the report can be renumbered as they are read.
+const char *thread_sanitizer_retrieve_report_data_function = R"(
 extern "C"
 {
     void *__tsan_get_current_report();
@@ -84,216 +89,195 @@ extern "C"
                                  int *running, const char **name, int *parent_tid,
                                  void **trace, unsigned long trace_size);
     int __tsan_get_report_unique_tid(void *report, unsigned long idx, int *tid);
-  
+
     // TODO: dlsym won't work on Windows.
     void *dlsym(void* handle, const char* symbol);
-    int (*ptr__tsan_get_report_loc_object_type)(void *report, unsigned long idx, const char **object_type);
-    int (*ptr__tsan_get_report_tag)(void *report, unsigned long *tag);
 }
 
 const int REPORT_TRACE_SIZE = 128;
 const int REPORT_ARRAY_SIZE = 4;
 
-struct data {
-    void *report;
-    const char *description;
-    int report_count;
-    unsigned long tag;
-    
-    void *sleep_trace[REPORT_TRACE_SIZE];
-    
-    int stack_count;
-    struct {
-        int idx;
-        void *trace[REPORT_TRACE_SIZE];
-    } stacks[REPORT_ARRAY_SIZE];
-    
-    int mop_count;
-    struct {
-        int idx;
-        int tid;
-        int size;
-        int write;
-        int atomic;
-        void *addr;
-        void *trace[REPORT_TRACE_SIZE];
-    } mops[REPORT_ARRAY_SIZE];
-    
-    int loc_count;
-    struct {
-        int idx;
-        const char *type;
-        void *addr;
-        unsigned long start;
-        unsigned long size;
-        int tid;
-        int fd;
-        int suppressable;
-        void *trace[REPORT_TRACE_SIZE];
-        const char *object_type;
-    } locs[REPORT_ARRAY_SIZE];
-    
-    int mutex_count;
-    struct {
-        int idx;
-        unsigned long mutex_id;
-        void *addr;
-        int destroyed;
-        void *trace[REPORT_TRACE_SIZE];
-    } mutexes[REPORT_ARRAY_SIZE];
-    
-    int thread_count;
-    struct {
-        int idx;
-        int tid;
-        unsigned long os_id;
-        int running;
-        const char *name;
-        int parent_tid;
-        void *trace[REPORT_TRACE_SIZE];
-    } threads[REPORT_ARRAY_SIZE];
-    
-    int unique_tid_count;
-    struct {
-        int idx;
-        int tid;
-    } unique_tids[REPORT_ARRAY_SIZE];
-};
-)";
-
-const char *thread_sanitizer_retrieve_report_data_command = R"(
-data t = {0};
-
-ptr__tsan_get_report_loc_object_type = (typeof(ptr__tsan_get_report_loc_object_type))(void *)dlsym((void*)-2 /*RTLD_DEFAULT*/, "__tsan_get_report_loc_object_type");
-ptr__tsan_get_report_tag = (typeof(ptr__tsan_get_report_tag))(void *)dlsym((void*)-2 /*RTLD_DEFAULT*/, "__tsan_get_report_tag");
-
-t.report = __tsan_get_current_report();
-__tsan_get_report_data(t.report, &t.description, &t.report_count, &t.stack_count, &t.mop_count, &t.loc_count, &t.mutex_count, &t.thread_count, &t.unique_tid_count, t.sleep_trace, REPORT_TRACE_SIZE);
-
-if (ptr__tsan_get_report_tag)
-    ptr__tsan_get_report_tag(t.report, &t.tag);
+typedef unsigned long long slot_t;
+
+static slot_t *put_trace(slot_t *out, void **trace) {
+    for (int i = 0; i < REPORT_TRACE_SIZE; i++)
+        *out++ = (slot_t)(unsigned long)trace[i];
+    return out;
+}
+
+static int clamp_count(int count) {
+    return count > REPORT_ARRAY_SIZE ? REPORT_ARRAY_SIZE : count;
+}
+
+extern "C" void *__lldb_tsan_retrieve_report_data(slot_t *out) {
+    int (*get_report_loc_object_type)(void *report, unsigned long idx, const char **object_type) =
+        (int (*)(void *, unsigned long, const char **))dlsym((void*)-2 /*RTLD_DEFAULT*/, "__tsan_get_report_loc_object_type");
+    int (*get_report_tag)(void *report, unsigned long *tag) =
+        (int (*)(void *, unsigned long *))dlsym((void*)-2 /*RTLD_DEFAULT*/, "__tsan_get_report_tag");
+
+    void *report = __tsan_get_current_report();
+    const char *description = 0;
+    int report_count = 0, stack_count = 0, mop_count = 0, loc_count = 0;
+    int mutex_count = 0, thread_count = 0, unique_tid_count = 0;
+    unsigned long tag = 0;
+    void *trace[REPORT_TRACE_SIZE] = {0};
+    __tsan_get_report_data(report, &description, &report_count, &stack_count, &mop_count, &loc_count, &mutex_count, &thread_count, &unique_tid_count, trace, REPORT_TRACE_SIZE);
+    if (get_report_tag)
+        get_report_tag(report, &tag);
+
+    stack_count = clamp_count(stack_count);
+    mop_count = clamp_count(mop_count);
+    loc_count = clamp_count(loc_count);
+    mutex_count = clamp_count(mutex_count);
+    thread_count = clamp_count(thread_count);
+    unique_tid_count = clamp_count(unique_tid_count);
+
+    *out++ = (slot_t)(unsigned long)description;
+    *out++ = report_count;
+    *out++ = tag;
+    *out++ = stack_count;
+    *out++ = mop_count;
+    *out++ = loc_count;
+    *out++ = mutex_count;
+    *out++ = thread_count;
+    *out++ = unique_tid_count;
+    out = put_trace(out, trace);
+
+    for (int i = 0; i < thread_count; i++) {
+        int tid = 0, running = 0, parent_tid = 0;
+        unsigned long os_id = 0;
+        const char *name = 0;
+        void *trace[REPORT_TRACE_SIZE] = {0};
+        __tsan_get_report_thread(report, i, &tid, &os_id, &running, &name, &parent_tid, trace, REPORT_TRACE_SIZE);
+        *out++ = tid;
+        *out++ = os_id;
+        *out++ = running;
+        *out++ = (slot_t)(unsigned long)name;
+        *out++ = parent_tid;
+        out = put_trace(out, trace);
+    }
 
-if (t.stack_count > REPORT_ARRAY_SIZE) t.stack_count = REPORT_ARRAY_SIZE;
-for (int i = 0; i < t.stack_count; i++) {
-    t.stacks[i].idx = i;
-    __tsan_get_report_stack(t.report, i, t.stacks[i].trace, REPORT_TRACE_SIZE);
-}
+    for (int i = 0; i < stack_count; i++) {
+        void *trace[REPORT_TRACE_SIZE] = {0};
+        __tsan_get_report_stack(report, i, trace, REPORT_TRACE_SIZE);
+        out = put_trace(out, trace);
+    }
 
-if (t.mop_count > REPORT_ARRAY_SIZE) t.mop_count = REPORT_ARRAY_SIZE;
-for (int i = 0; i < t.mop_count; i++) {
-    t.mops[i].idx = i;
-    __tsan_get_report_mop(t.report, i, &t.mops[i].tid, &t.mops[i].addr, &t.mops[i].size, &t.mops[i].write, &t.mops[i].atomic, t.mops[i].trace, REPORT_TRACE_SIZE);
-}
+    for (int i = 0; i < mop_count; i++) {
+        int tid = 0, size = 0, write = 0, atomic = 0;
+        void *addr = 0;
+        void *trace[REPORT_TRACE_SIZE] = {0};
+        __tsan_get_report_mop(report, i, &tid, &addr, &size, &write, &atomic, trace, REPORT_TRACE_SIZE);
+        *out++ = tid;
+        *out++ = (slot_t)(unsigned long)addr;
+        *out++ = size;
+        *out++ = write;
+        *out++ = atomic;
+        out = put_trace(out, trace);
+    }
 
-if (t.loc_count > REPORT_ARRAY_SIZE) t.loc_count = REPORT_ARRAY_SIZE;
-for (int i = 0; i < t.loc_count; i++) {
-    t.locs[i].idx = i;
-    __tsan_get_report_loc(t.report, i, &t.locs[i].type, &t.locs[i].addr, &t.locs[i].start, &t.locs[i].size, &t.locs[i].tid, &t.locs[i].fd, &t.locs[i].suppressable, t.locs[i].trace, REPORT_TRACE_SIZE);
-    if (ptr__tsan_get_report_loc_object_type)
-        ptr__tsan_get_report_loc_object_type(t.report, i, &t.locs[i].object_type);
-}
+    for (int i = 0; i < loc_count; i++) {
+        const char *type = 0, *object_type = 0;
+        void *addr = 0;
+        unsigned long start = 0, size = 0;
+        int tid = 0, fd = 0, suppressable = 0;
+        void *trace[REPORT_TRACE_SIZE] = {0};
+        __tsan_get_report_loc(report, i, &type, &addr, &start, &size, &tid, &fd, &suppressable, trace, REPORT_TRACE_SIZE);
+        if (get_report_loc_object_type)
+            get_report_loc_object_type(report, i, &object_type);
+        *out++ = (slot_t)(unsigned long)type;
+        *out++ = (slot_t)(unsigned long)addr;
+        *out++ = start;
+        *out++ = size;
+        *out++ = tid;
+        *out++ = fd;
+        *out++ = suppressable;
+        *out++ = (slot_t)(unsigned long)object_type;
+        out = put_trace(out, trace);
+    }
 
-if (t.mutex_count > REPORT_ARRAY_SIZE) t.mutex_count = REPORT_ARRAY_SIZE;
-for (int i = 0; i < t.mutex_count; i++) {
-    t.mutexes[i].idx = i;
-    __tsan_get_report_mutex(t.report, i, &t.mutexes[i].mutex_id, &t.mutexes[i].addr, &t.mutexes[i].destroyed, t.mutexes[i].trace, REPORT_TRACE_SIZE);
-}
+    for (int i = 0; i < mutex_count; i++) {
+        unsigned long mutex_id = 0;
+        void *addr = 0;
+        int destroyed = 0;
+        void *trace[REPORT_TRACE_SIZE] = {0};
+        __tsan_get_report_mutex(report, i, &mutex_id, &addr, &destroyed, trace, REPORT_TRACE_SIZE);
+        *out++ = mutex_id;
+        *out++ = (slot_t)(unsigned long)addr;
+        *out++ = destroyed;
+        out = put_trace(out, trace);
+    }
 
-if (t.thread_count > REPORT_ARRAY_SIZE) t.thread_count = REPORT_ARRAY_SIZE;
-for (int i = 0; i < t.thread_count; i++) {
-    t.threads[i].idx = i;
-    __tsan_get_report_thread(t.report, i, &t.threads[i].tid, &t.threads[i].os_id, &t.threads[i].running, &t.threads[i].name, &t.threads[i].parent_tid, t.threads[i].trace, REPORT_TRACE_SIZE);
-}
+    for (int i = 0; i < unique_tid_count; i++) {
+        int tid = 0;
+        __tsan_get_report_unique_tid(report, i, &tid);
+        *out++ = tid;
+    }
 
-if (t.unique_tid_count > REPORT_ARRAY_SIZE) t.unique_tid_count = REPORT_ARRAY_SIZE;
-for (int i = 0; i < t.unique_tid_count; i++) {
-    t.unique_tids[i].idx = i;
-    __tsan_get_report_unique_tid(t.report, i, &t.unique_tids[i].tid);
+    return out;
 }
-
-t;
 )";
 
-static StructuredData::Array *
-CreateStackTrace(ValueObjectSP o,
-                 const std::string &trace_item_name = ".trace") {
-  StructuredData::Array *trace = new StructuredData::Array();
-  ValueObjectSP trace_value_object =
-      o->GetValueForExpressionPath(trace_item_name.c_str());
-  size_t count = trace_value_object->GetNumChildren();
-  for (size_t j = 0; j < count; j++) {
-    addr_t trace_addr =
-        trace_value_object->GetChildAtIndex(j, true)->GetValueAsUnsigned(0);
-    if (trace_addr == 0)
-      break;
-    trace->AddItem(
-        StructuredData::ObjectSP(new StructuredData::Integer(trace_addr)));
+static const size_t kReportTraceSize = 128;
+static const size_t kReportArraySize = 4;
+
+/// The most slots the report function fills in: the header, then the threads,
+/// stacks, mops, locs, mutexes and unique thread IDs.
+static const size_t kReportSlots =
+    9 + kReportTraceSize +
+    kReportArraySize * ((5 + kReportTraceSize) + kReportTraceSize +
+                        (5 + kReportTraceSize) + (8 + kReportTraceSize) +
+                        (3 + kReportTraceSize) + 1);
+
+namespace {
+/// Reads the values the report function wrote back in order.
+class ReportReader {
+public:
+  ReportReader(const DataExtractor &data, ProcessSP process_sp)
+      : m_data(data), m_process_sp(std::move(process_sp)) {}
+
+  uint64_t Next() { return m_data.GetU64(&m_offset); }
+
+  std::string NextString() {
+    addr_t ptr = Next();
+    std::string str;
+    Status error;
+    m_process_sp->ReadCStringFromMemory(ptr, str, error);
+    return str;
   }
-  return trace;
-}
 
-static StructuredData::Array *ConvertToStructuredArray(
-    ValueObjectSP return_value_sp, const std::string &items_name,
-    const std::string &count_name,
-    std::function<void(ValueObjectSP o, StructuredData::Dictionary *dict)> const
-        &callback) {
-  StructuredData::Array *array = new StructuredData::Array();
-  unsigned int count =
-      return_value_sp->GetValueForExpressionPath(count_name.c_str())
-          ->GetValueAsUnsigned(0);
-  ValueObjectSP objects =
-      return_value_sp->GetValueForExpressionPath(items_name.c_str());
-  for (unsigned int i = 0; i < count; i++) {
-    ValueObjectSP o = objects->GetChildAtIndex(i, true);
-    StructuredData::Dictionary *dict = new StructuredData::Dictionary();
-
-    callback(o, dict);
-
-    array->AddItem(StructuredData::ObjectSP(dict));
+  StructuredData::ObjectSP NextTrace() {
+    auto trace = std::make_shared<StructuredData::Array>();
+    bool done = false;
+    for (size_t i = 0; i < kReportTraceSize; i++) {
+      addr_t trace_addr = Next();
+      // Keep reading to the end, so the next value is in the right place.
+      if (trace_addr == 0)
+        done = true;
+      if (!done)
+        trace->AddItem(std::make_shared<StructuredData::Integer>(trace_addr));
+    }
+    return trace;
   }
-  return array;
-}
 
-static std::string RetrieveString(ValueObjectSP return_value_sp,
-                                  ProcessSP process_sp,
-                                  const std::string &expression_path) {
-  addr_t ptr =
-      return_value_sp->GetValueForExpressionPath(expression_path.c_str())
-          ->GetValueAsUnsigned(0);
-  std::string str;
-  Status error;
-  process_sp->ReadCStringFromMemory(ptr, str, error);
-  return str;
-}
+private:
+  DataExtractor m_data;
+  ProcessSP m_process_sp;
+  offset_t m_offset = 0;
+};
+} // namespace
 
-static void
-GetRenumberedThreadIds(ProcessSP process_sp, ValueObjectSP data,
-                       std::map<uint64_t, user_id_t> &thread_id_map) {
-  ConvertToStructuredArray(
-      data, ".threads", ".thread_count",
-      [process_sp, &thread_id_map](ValueObjectSP o,
-                                   StructuredData::Dictionary *dict) {
-        uint64_t thread_id =
-            o->GetValueForExpressionPath(".tid")->GetValueAsUnsigned(0);
-        uint64_t thread_os_id =
-            o->GetValueForExpressionPath(".os_id")->GetValueAsUnsigned(0);
-        user_id_t lldb_user_id = 0;
-
-        bool can_update = true;
-        ThreadSP lldb_thread = process_sp->GetThreadList().FindThreadByID(
-            thread_os_id, can_update);
-        if (lldb_thread) {
-          lldb_user_id = lldb_thread->GetIndexID();
-        } else {
-          // This isn't a live thread anymore.  Ask process to assign a new
-          // Index ID (or return an old one if we've already seen this
-          // thread_os_id). It will also make sure that no new threads are
-          // assigned this Index ID.
-          lldb_user_id = process_sp->AssignIndexIDToThread(thread_os_id);
-        }
-
-        thread_id_map[thread_id] = lldb_user_id;
-      });
+static user_id_t RenumberThread(ProcessSP process_sp, uint64_t thread_os_id) {
+  bool can_update = true;
+  ThreadSP lldb_thread =
+      process_sp->GetThreadList().FindThreadByID(thread_os_id, can_update);
+  if (lldb_thread)
+    return lldb_thread->GetIndexID();
+
+  // This isn't a live thread anymore.  Ask process to assign a new Index ID
+  // (or return an old one if we've already seen this thread_os_id). It will
+  // also make sure that no new threads are assigned this Index ID.
+  return process_sp->AssignIndexIDToThread(thread_os_id);
 }
 
 static user_id_t Renumber(uint64_t id,
@@ -317,179 +301,122 @@ ThreadSanitizerRuntime::RetrieveReportData(ExecutionContextRef exe_ctx_ref) {
   if (!frame_sp)
     return StructuredData::ObjectSP();
 
-  EvaluateExpressionOptions options;
-  options.SetUnwindOnError(true);
-  options.SetTryAllThreads(true);
-  options.SetStopOthers(true);
-  options.SetIgnoreBreakpoints(true);
-  options.SetTimeout(process_sp->GetUtilityExpressionTimeout());
-  options.SetPrefix(thread_sanitizer_retrieve_report_data_prefix);
-  options.SetAutoApplyFixIts(false);
-  options.SetLanguage(eLanguageTypeObjC_plus_plus);
-
-  ValueObjectSP main_value;
   ExecutionContext exe_ctx;
-  Status eval_error;
   frame_sp->CalculateExecutionContext(exe_ctx);
-  ExpressionResults result = UserExpression::Evaluate(
-      exe_ctx, options, thread_sanitizer_retrieve_report_data_command, "",
-      main_value, eval_error);
-  if (result != eExpressionCompleted) {
+  llvm::Expected<DataExtractor> data = CallReportFunction(
+      exe_ctx, thread_sanitizer_retrieve_report_data_function,
+      thread_sanitizer_retrieve_report_data_function_name, kReportSlots);
+  if (!data) {
     process_sp->GetTarget().GetDebugger().GetAsyncOutputStream()->Printf(
         "Warning: Cannot evaluate ThreadSanitizer expression:\n%s\n",
-        eval_error.AsCString());
+        llvm::toString(data.takeError()).c_str());
     return StructuredData::ObjectSP();
   }
-
-  std::map<uint64_t, user_id_t> thread_id_map;
-  GetRenumberedThreadIds(process_sp, main_value, thread_id_map);
+  ReportReader reader(*data, process_sp);
 
   StructuredData::Dictionary *dict = new StructuredData::Dictionary();
   dict->AddStringItem("instrumentation_class", "ThreadSanitizer");
-  dict->AddStringItem("issue_type",
-                      RetrieveString(main_value, process_sp, ".description"));
-  dict->AddIntegerItem("report_count",
-                       main_value->GetValueForExpressionPath(".report_count")
-                           ->GetValueAsUnsigned(0));
-  dict->AddItem("sleep_trace", StructuredData::ObjectSP(CreateStackTrace(
-                                   main_value, ".sleep_trace")));
-  dict->AddIntegerItem(
-      "tag",
-      main_value->GetValueForExpressionPath(".tag")->GetValueAsUnsigned(0));
-
-  StructuredData::Array *stacks = ConvertToStructuredArray(
-      main_value, ".stacks", ".stack_count",
-      [thread_sp](ValueObjectSP o, StructuredData::Dictionary *dict) {
-        dict->AddIntegerItem(
-            "index",
-            o->GetValueForExpressionPath(".idx")->GetValueAsUnsigned(0));
-        dict->AddItem("trace", StructuredData::ObjectSP(CreateStackTrace(o)));
-        // "stacks" happen on the current thread
-        dict->AddIntegerItem("thread_id", thread_sp->GetIndexID());
-      });
-  dict->AddItem("stacks", StructuredData::ObjectSP(stacks));
-
-  StructuredData::Array *mops = ConvertToStructuredArray(
-      main_value, ".mops", ".mop_count",
-      [&thread_id_map](ValueObjectSP o, StructuredData::Dictionary *dict) {
-        dict->AddIntegerItem(
-            "index",
-            o->GetValueForExpressionPath(".idx")->GetValueAsUnsigned(0));
-        dict->AddIntegerItem(
-            "thread_id",
-            Renumber(
-                o->GetValueForExpressionPath(".tid")->GetValueAsUnsigned(0),
-                thread_id_map));
-        dict->AddIntegerItem(
-            "size",
-            o->GetValueForExpressionPath(".size")->GetValueAsUnsigned(0));
-        dict->AddBooleanItem(
-            "is_write",
-            o->GetValueForExpressionPath(".write")->GetValueAsUnsigned(0));
-        dict->AddBooleanItem(
-            "is_atomic",
-            o->GetValueForExpressionPath(".atomic")->GetValueAsUnsigned(0));
-        dict->AddIntegerItem(
-            "address",
-            o->GetValueForExpressionPath(".addr")->GetValueAsUnsigned(0));
-        dict->AddItem("trace", StructuredData::ObjectSP(CreateStackTrace(o)));
-      });
-  dict->AddItem("mops", StructuredData::ObjectSP(mops));
-
-  StructuredData::Array *locs = ConvertToStructuredArray(
-      main_value, ".locs", ".loc_count",
-      [process_sp, &thread_id_map](ValueObjectSP o,
-                                   StructuredData::Dictionary *dict) {
-        dict->AddIntegerItem(
-            "index",
-            o->GetValueForExpressionPath(".idx")->GetValueAsUnsigned(0));
-        dict->AddStringItem("type", RetrieveString(o, process_sp, ".type"));
-        dict->AddIntegerItem(
-            "address",
-            o->GetValueForExpressionPath(".addr")->GetValueAsUnsigned(0));
-        dict->AddIntegerItem(
-            "start",
-            o->GetValueForExpressionPath(".start")->GetValueAsUnsigned(0));
-        dict->AddIntegerItem(
-            "size",
-            o->GetValueForExpressionPath(".size")->GetValueAsUnsigned(0));
-        dict->AddIntegerItem(
-            "thread_id",
-            Renumber(
-                o->GetValueForExpressionPath(".tid")->GetValueAsUnsigned(0),
-                thread_id_map));
-        dict->AddIntegerItem(
-            "file_descriptor",
-            o->GetValueForExpressionPath(".fd")->GetValueAsUnsigned(0));
-        dict->AddIntegerItem("suppressable",
-                             o->GetValueForExpressionPath(".suppressable")
-                                 ->GetValueAsUnsigned(0));
-        dict->AddItem("trace", StructuredData::ObjectSP(CreateStackTrace(o)));
-        dict->AddStringItem("object_type",
-                            RetrieveString(o, process_sp, ".object_type"));
-      });
-  dict->AddItem("locs", StructuredData::ObjectSP(locs));
-
-  StructuredData::Array *mutexes = ConvertToStructuredArray(
-      main_value, ".mutexes", ".mutex_count",
-      [](ValueObjectSP o, StructuredData::Dictionary *dict) {
-        dict->AddIntegerItem(
-            "index",
-            o->GetValueForExpressionPath(".idx")->GetValueAsUnsigned(0));
-        dict->AddIntegerItem(
-            "mutex_id",
-            o->GetValueForExpressionPath(".mutex_id")->GetValueAsUnsigned(0));
-        dict->AddIntegerItem(
-            "address",
-            o->GetValueForExpressionPath(".addr")->GetValueAsUnsigned(0));
-        dict->AddIntegerItem(
-            "destroyed",
-            o->GetValueForExpressionPath(".destroyed")->GetValueAsUnsigned(0));
-        dict->AddItem("trace", StructuredData::ObjectSP(CreateStackTrace(o)));
-      });
-  dict->AddItem("mutexes", StructuredData::ObjectSP(mutexes));
-
-  StructuredData::Array *threads = ConvertToStructuredArray(
-      main_value, ".threads", ".thread_count",
-      [process_sp, &thread_id_map](ValueObjectSP o,
-                                   StructuredData::Dictionary *dict) {
-        dict->AddIntegerItem(
-            "index",
-            o->GetValueForExpressionPath(".idx")->GetValueAsUnsigned(0));
-        dict->AddIntegerItem(
-            "thread_id",
-            Renumber(
-                o->GetValueForExpressionPath(".tid")->GetValueAsUnsigned(0),
-                thread_id_map));
-        dict->AddIntegerItem(
-            "thread_os_id",
-            o->GetValueForExpressionPath(".os_id")->GetValueAsUnsigned(0));
-        dict->AddIntegerItem(
-            "running",
-            o->GetValueForExpressionPath(".running")->GetValueAsUnsigned(0));
-        dict->AddStringItem("name", RetrieveString(o, process_sp, ".name"));
-        dict->AddIntegerItem(
-            "parent_thread_id",
-            Renumber(o->GetValueForExpressionPath(".parent_tid")
-                         ->GetValueAsUnsigned(0),
-                     thread_id_map));
-        dict->AddItem("trace", StructuredData::ObjectSP(CreateStackTrace(o)));
-      });
-  dict->AddItem("threads", StructuredData::ObjectSP(threads));
-
-  StructuredData::Array *unique_tids = ConvertToStructuredArray(
-      main_value, ".unique_tids", ".unique_tid_count",
-      [&thread_id_map](ValueObjectSP o, StructuredData::Dictionary *dict) {
-        dict->AddIntegerItem(
-            "index",
-            o->GetValueForExpressionPath(".idx")->GetValueAsUnsigned(0));
-        dict->AddIntegerItem(
-            "tid",
-            Renumber(
-                o->GetValueForExpressionPath(".tid")->GetValueAsUnsigned(0),
-                thread_id_map));
-      });
-  dict->AddItem("unique_tids", StructuredData::ObjectSP(unique_tids));
+  dict->AddStringItem("issue_type", reader.NextString());
+  dict->AddIntegerItem("report_count", reader.Next());
+  dict->AddIntegerItem("tag", reader.Next());
+  const uint64_t stack_count = reader.Next();
+  const uint64_t mop_count = reader.Next();
+  const uint64_t loc_count = reader.Next();
+  const uint64_t mutex_count = reader.Next();
+  const uint64_t thread_count = reader.Next();
+  const uint64_t unique_tid_count = reader.Next();
+  dict->AddItem("sleep_trace", reader.NextTrace());
+
+  // Read the threads first, so the other thread IDs can be renumbered.
+  std::map<uint64_t, user_id_t> thread_id_map;
+  std::vector<std::pair<uint64_t, uint64_t>> thread_tids;
+  std::vector<std::shared_ptr<StructuredData::Dictionary>> thread_dicts;
+  for (uint64_t i = 0; i < thread_count; i++) {
+    auto thread = std::make_shared<StructuredData::Dictionary>();
+    thread->AddIntegerItem("index", i);
+    const uint64_t tid = reader.Next();
+    const uint64_t os_id = reader.Next();
+    thread_id_map[tid] = RenumberThread(process_sp, os_id);
+    thread->AddIntegerItem("thread_os_id", os_id);
+    thread->AddIntegerItem("running", reader.Next());
+    thread->AddStringItem("name", reader.NextString());
+    thread_tids.emplace_back(tid, reader.Next());
+    thread->AddItem("trace", reader.NextTrace());
+    thread_dicts.push_back(thread);
+  }
+  // A parent can come after its children.
+  auto threads = std::make_shared<StructuredData::Array>();
+  for (size_t i = 0; i < thread_dicts.size(); i++) {
+    thread_dicts[i]->AddIntegerItem(
+        "thread_id", Renumber(thread_tids[i].first, thread_id_map));
+    thread_dicts[i]->AddIntegerItem(
+        "parent_thread_id", Renumber(thread_tids[i].second, thread_id_map));
+    threads->AddItem(thread_dicts[i]);
+  }
+  dict->AddItem("threads", threads);
+
+  auto stacks = std::make_shared<StructuredData::Array>();
+  for (uint64_t i = 0; i < stack_count; i++) {
+    auto stack = std::make_shared<StructuredData::Dictionary>();
+    stack->AddIntegerItem("index", i);
+    stack->AddItem("trace", reader.NextTrace());
+    // "stacks" happen on the current thread
+    stack->AddIntegerItem("thread_id", thread_sp->GetIndexID());
+    stacks->AddItem(stack);
+  }
+  dict->AddItem("stacks", stacks);
+
+  auto mops = std::make_shared<StructuredData::Array>();
+  for (uint64_t i = 0; i < mop_count; i++) {
+    auto mop = std::make_shared<StructuredData::Dictionary>();
+    mop->AddIntegerItem("index", i);
+    mop->AddIntegerItem("thread_id", Renumber(reader.Next(), thread_id_map));
+    mop->AddIntegerItem("address", reader.Next());
+    mop->AddIntegerItem("size", reader.Next());
+    mop->AddBooleanItem("is_write", reader.Next());
+    mop->AddBooleanItem("is_atomic", reader.Next());
+    mop->AddItem("trace", reader.NextTrace());
+    mops->AddItem(mop);
+  }
+  dict->AddItem("mops", mops);
+
+  auto locs = std::make_shared<StructuredData::Array>();
+  for (uint64_t i = 0; i < loc_count; i++) {
+    auto loc = std::make_shared<StructuredData::Dictionary>();
+    loc->AddIntegerItem("index", i);
+    loc->AddStringItem("type", reader.NextString());
+    loc->AddIntegerItem("address", reader.Next());
+    loc->AddIntegerItem("start", reader.Next());
+    loc->AddIntegerItem("size", reader.Next());
+    loc->AddIntegerItem("thread_id", Renumber(reader.Next(), thread_id_map));
+    loc->AddIntegerItem("file_descriptor", reader.Next());
+    loc->AddIntegerItem("suppressable", reader.Next());
+    loc->AddStringItem("object_type", reader.NextString());
+    loc->AddItem("trace", reader.NextTrace());
+    locs->AddItem(loc);
+  }
+  dict->AddItem("locs", locs);
+
+  auto mutexes = std::make_shared<StructuredData::Array>();
+  for (uint64_t i = 0; i < mutex_count; i++) {
+    auto mutex = std::make_shared<StructuredData::Dictionary>();
+    mutex->AddIntegerItem("index", i);
+    mutex->AddIntegerItem("mutex_id", reader.Next());
+    mutex->AddIntegerItem("address", reader.Next());
+    mutex->AddIntegerItem("destroyed", reader.Next());
+    mutex->AddItem("trace", reader.NextTrace());
+    mutexes->AddItem(mutex);
+  }
+  dict->AddItem("mutexes", mutexes);
+
+  auto unique_tids = std::make_shared<StructuredData::Array>();
+  for (uint64_t i = 0; i < unique_tid_count; i++) {
+    auto unique_tid = std::make_shared<StructuredData::Dictionary>();
+    unique_tid->AddIntegerItem("index", i);
+    unique_tid->AddIntegerItem("tid", Renumber(reader.Next(), thread_id_map));
+    unique_tids->AddItem(unique_tid);
+  }
+  dict->AddItem("unique_tids", unique_tids);
 
   return StructuredData::ObjectSP(dict);
 }
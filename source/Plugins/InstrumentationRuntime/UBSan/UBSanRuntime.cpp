@@ -15,8 +15,6 @@
 #include "lldb/Core/PluginInterface.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/StreamFile.h"
-#include "lldb/Core/ValueObject.h"
-#include "lldb/Expression/UserExpression.h"
 #include "lldb/Interpreter/CommandReturnObject.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/SymbolContext.h"
@@ -27,6 +25,7 @@
 #include "lldb/Target/StopInfo.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
 #include <ctype.h>
@@ -68,7 +67,10 @@ UndefinedBehaviorSanitizerRuntime::GetTypeStatic() {
   return eInstrumentationRuntimeTypeUndefinedBehaviorSanitizer;
 }
 
-static const char *ub_sanitizer_retrieve_report_data_prefix = R"(
+static const char *ub_sanitizer_retrieve_report_data_function_name =
+    "__lldb_ubsan_retrieve_report_data";
+
+static const char *ub_sanitizer_retrieve_report_data_function = R"(
 extern "C" {
 void
 __ubsan_get_current_report_data(const char **OutIssueKind,
@@ -76,34 +78,27 @@ __ubsan_get_current_report_data(const char **OutIssueKind,
     unsigned *OutCol, char **OutMemoryAddr);
 }
 
-struct data {
-  const char *issue_kind;
-  const char *message;
-  const char *filename;
-  unsigned line;
-  unsigned col;
-  char *memory_addr;
-};
-)";
-
-static const char *ub_sanitizer_retrieve_report_data_command = R"(
-data t;
-__ubsan_get_current_report_data(&t.issue_kind, &t.message, &t.filename, &t.line,
-                                &t.col, &t.memory_addr);
-t;
-)";
-
-static addr_t RetrieveUnsigned(ValueObjectSP return_value_sp,
-                               ProcessSP process_sp,
-                               const std::string &expression_path) {
-  return return_value_sp->GetValueForExpressionPath(expression_path.c_str())
-      ->GetValueAsUnsigned(0);
+typedef unsigned long long slot_t;
+
+extern "C" void *__lldb_ubsan_retrieve_report_data(slot_t *out) {
+  const char *issue_kind = 0, *message = 0, *filename = 0;
+  unsigned line = 0, col = 0;
+  char *memory_addr = 0;
+  __ubsan_get_current_report_data(&issue_kind, &message, &filename, &line,
+                                  &col, &memory_addr);
+  out[0] = (slot_t)(unsigned long)issue_kind;
+  out[1] = (slot_t)(unsigned long)message;
+  out[2] = (slot_t)(unsigned long)filename;
+  out[3] = line;
+  out[4] = col;
+  out[5] = (slot_t)(unsigned long)memory_addr;
+  return out;
 }
+)";
 
-static std::string RetrieveString(ValueObjectSP return_value_sp,
-                                  ProcessSP process_sp,
-                                  const std::string &expression_path) {
-  addr_t ptr = RetrieveUnsigned(return_value_sp, process_sp, expression_path);
+static std::string RetrieveString(const DataExtractor &data, offset_t *offset,
+                                  ProcessSP process_sp) {
+  addr_t ptr = data.GetU64(offset);
   std::string str;
   Status error;
   process_sp->ReadCStringFromMemory(ptr, str, error);
@@ -126,27 +121,15 @@ StructuredData::ObjectSP UndefinedBehaviorSanitizerRuntime::RetrieveReportData(
 
   StreamFileSP Stream(target.GetDebugger().GetOutputFile());
 
-  EvaluateExpressionOptions options;
-  options.SetUnwindOnError(true);
-  options.SetTryAllThreads(true);
-  options.SetStopOthers(true);
-  options.SetIgnoreBreakpoints(true);
-  options.SetTimeout(process_sp->GetUtilityExpressionTimeout());
-  options.SetPrefix(ub_sanitizer_retrieve_report_data_prefix);
-  options.SetAutoApplyFixIts(false);
-  options.SetLanguage(eLanguageTypeObjC_plus_plus);
-
-  ValueObjectSP main_value;
   ExecutionContext exe_ctx;
-  Status eval_error;
   frame_sp->CalculateExecutionContext(exe_ctx);
-  ExpressionResults result = UserExpression::Evaluate(
-      exe_ctx, options, ub_sanitizer_retrieve_report_data_command, "",
-      main_value, eval_error);
-  if (result != eExpressionCompleted) {
+  llvm::Expected<DataExtractor> data = CallReportFunction(
+      exe_ctx, ub_sanitizer_retrieve_report_data_function,
+      ub_sanitizer_retrieve_report_data_function_name, 6);
+  if (!data) {
     target.GetDebugger().GetAsyncOutputStream()->Printf(
         "Warning: Cannot evaluate UndefinedBehaviorSanitizer expression:\n%s\n",
-        eval_error.AsCString());
+        llvm::toString(data.takeError()).c_str());
     return StructuredData::ObjectSP();
   }
 
@@ -163,13 +146,13 @@ StructuredData::ObjectSP UndefinedBehaviorSanitizerRuntime::RetrieveReportData(
     trace->AddItem(StructuredData::ObjectSP(new StructuredData::Integer(PC)));
   }
 
-  std::string IssueKind = RetrieveString(main_value, process_sp, ".issue_kind");
-  std::string ErrMessage = RetrieveString(main_value, process_sp, ".message");
-  std::string Filename = RetrieveString(main_value, process_sp, ".filename");
-  unsigned Line = RetrieveUnsigned(main_value, process_sp, ".line");
-  unsigned Col = RetrieveUnsigned(main_value, process_sp, ".col");
-  uintptr_t MemoryAddr =
-      RetrieveUnsigned(main_value, process_sp, ".memory_addr");
+  offset_t offset = 0;
+  std::string IssueKind = RetrieveString(*data, &offset, process_sp);
+  std::string ErrMessage = RetrieveString(*data, &offset, process_sp);
+  std::string Filename = RetrieveString(*data, &offset, process_sp);
+  unsigned Line = data->GetU64(&offset);
+  unsigned Col = data->GetU64(&offset);
+  uintptr_t MemoryAddr = data->GetU64(&offset);
 
   auto *d = new StructuredData::Dictionary();
   auto dict_sp = StructuredData::ObjectSP(d);
@@ -304,19 +304,27 @@ bool JITLoaderGDB::ReadJITDescriptorImpl(bool all_entries) {
     jit_relevant_entry = (addr_t)jit_desc.first_entry;
   }
 
+  // Tell the target about all the new objects at once; a walk over all the
+  // entries can find thousands of them, and each notification makes it
+  // re-resolve breakpoints.
+  ModuleList loaded_modules;
+
   while (jit_relevant_entry != 0) {
     jit_code_entry<ptr_t> jit_entry;
     if (!ReadJITEntry(jit_relevant_entry, m_process, &jit_entry)) {
       LLDB_LOGF(log, "JITLoaderGDB::%s failed to read JIT entry at 0x%" PRIx64,
                 __FUNCTION__, jit_relevant_entry);
-      return false;
+      break;
     }
 
     const addr_t &symbolfile_addr = (addr_t)jit_entry.symfile_addr;
     const size_t &symbolfile_size = (size_t)jit_entry.symfile_size;
     ModuleSP module_sp;
 
-    if (jit_action == JIT_REGISTER_FN) {
+    if (jit_action == JIT_REGISTER_FN &&
+        m_jit_objects.count(symbolfile_addr)) {
+      // Already registered, e.g. by an earlier walk over all the entries.
+    } else if (jit_action == JIT_REGISTER_FN) {
       LLDB_LOGF(log,
                 "JITLoaderGDB::%s registering JIT entry at 0x%" PRIx64
                 " (%" PRIu64 " bytes)",
@@ -332,9 +340,8 @@ bool JITLoaderGDB::ReadJITDescriptorImpl(bool all_entries) {
         // We will get it wrong, if we deduce it from the header.
         module_sp->GetObjectFile()->SetType(ObjectFile::eTypeJIT);
 
-        // load the symbol table right away
-        module_sp->GetObjectFile()->GetSymtab();
-
+        // The symbol table is parsed when a lookup first needs it; the
+        // module holds its own copy of the object's bytes.
         m_jit_objects.insert(std::make_pair(symbolfile_addr, module_sp));
         if (auto image_object_file =
                 llvm::dyn_cast<ObjectFileMachO>(module_sp->GetObjectFile())) {
@@ -353,10 +360,7 @@ bool JITLoaderGDB::ReadJITDescriptorImpl(bool all_entries) {
         }
 
         module_list.AppendIfNeeded(module_sp);
-
-        ModuleList module_list;
-        module_list.Append(module_sp);
-        target.ModulesDidLoad(module_list);
+        loaded_modules.Append(module_sp);
       } else {
         LLDB_LOGF(log,
                   "JITLoaderGDB::%s failed to load module for "
@@ -398,6 +402,9 @@ bool JITLoaderGDB::ReadJITDescriptorImpl(bool all_entries) {
       jit_relevant_entry = 0;
   }
 
+  if (!loaded_modules.IsEmpty())
+    target.ModulesDidLoad(loaded_modules);
+
   return false; // Continue Running.
 }
 
@@ -12,6 +12,7 @@
 #include "lldb/Core/ValueObjectConstResult.h"
 #include "lldb/DataFormatters/FormattersHelpers.h"
 #include "lldb/Symbol/ClangASTContext.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/DataBufferHeap.h"
 #include "lldb/Utility/Endian.h"
@@ -191,12 +192,28 @@ private:
 
   void GetValueOffset(const lldb::ValueObjectSP &node);
 
+  /// Find the addresses of all nodes in order by reading the tree directly.
+  bool ReadNodes();
+
+  /// Read the values of the nodes from \a idx on with one request.
+  bool ReadBatch(size_t idx);
+
+  lldb::ValueObjectSP GetChildFromNodes(size_t idx);
+
+  lldb::ValueObjectSP CreateChild(size_t idx, const DataExtractor &data);
+
   ValueObject *m_tree;
   ValueObject *m_root_node;
   CompilerType m_element_type;
   uint32_t m_skip_size;
   size_t m_count;
   std::map<size_t, MapIterator> m_iterators;
+  bool m_nodes_read;
+  std::vector<lldb::addr_t> m_nodes;
+  uint64_t m_element_size;
+  std::vector<uint8_t> m_batch_buffer;
+  size_t m_batch_first_index;
+  size_t m_batch_count;
 };
 } // namespace formatters
 } // namespace lldb_private
@@ -205,7 +222,9 @@ lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::
     LibcxxStdMapSyntheticFrontEnd(lldb::ValueObjectSP valobj_sp)
     : SyntheticChildrenFrontEnd(*valobj_sp), m_tree(nullptr),
       m_root_node(nullptr), m_element_type(), m_skip_size(UINT32_MAX),
-      m_count(UINT32_MAX), m_iterators() {
+      m_count(UINT32_MAX), m_iterators(), m_nodes_read(false), m_nodes(),
+      m_element_size(0), m_batch_buffer(), m_batch_first_index(0),
+      m_batch_count(0) {
   if (valobj_sp)
     Update();
 }
@@ -329,8 +348,6 @@ void lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetValueOffset(
 lldb::ValueObjectSP
 lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetChildAtIndex(
     size_t idx) {
-  static ConstString g___cc("__cc");
-  static ConstString g___nc("__nc");
   static ConstString g___value_("__value_");
 
   if (idx >= CalculateNumChildren())
@@ -338,6 +355,15 @@ lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetChildAtIndex(
   if (m_tree == nullptr || m_root_node == nullptr)
     return lldb::ValueObjectSP();
 
+  // Item 0 tells where the value is in a node, the others can then be read
+  // without following the tree one pointer at a time.
+  if (idx > 0 && m_skip_size == UINT32_MAX)
+    GetChildAtIndex(0);
+  if (idx > 0 && m_skip_size != UINT32_MAX && m_tree != nullptr &&
+      GetDataType())
+    if (ValueObjectSP child_sp = GetChildFromNodes(idx))
+      return child_sp;
+
   MapIterator iterator(m_root_node, CalculateNumChildren());
 
   const bool need_to_skip = (idx > 0);
@@ -406,6 +432,16 @@ lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetChildAtIndex(
     m_tree = nullptr;
     return lldb::ValueObjectSP();
   }
+  m_iterators[idx] = iterator;
+  return CreateChild(idx, data);
+}
+
+lldb::ValueObjectSP
+lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::CreateChild(
+    size_t idx, const DataExtractor &data) {
+  static ConstString g___cc("__cc");
+  static ConstString g___nc("__nc");
+
   StreamString name;
   name.Printf("[%" PRIu64 "]", (uint64_t)idx);
   auto potential_child_sp = CreateValueObjectFromData(
@@ -429,16 +465,154 @@ lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetChildAtIndex(
     }
     }
   }
-  m_iterators[idx] = iterator;
   return potential_child_sp;
 }
 
+bool lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::ReadNodes() {
+  static ConstString g___pair1_("__pair1_");
+
+  // The end node is the first member of __pair1_, its left child is the
+  // root of the tree.
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  ValueObjectSP end_node_sp = m_tree->GetChildMemberWithName(g___pair1_, true);
+  if (!process_sp || !end_node_sp)
+    return false;
+  AddressType address_type;
+  lldb::addr_t end_node = end_node_sp->GetAddressOf(true, &address_type);
+  if (end_node == LLDB_INVALID_ADDRESS || address_type != eAddressTypeLoad)
+    return false;
+  Status error;
+  lldb::addr_t root = process_sp->ReadPointerFromMemory(end_node, error);
+  if (error.Fail())
+    return false;
+
+  // Read the children of all nodes of a level of the tree with one request
+  // instead of following one pointer at a time.
+  struct Node {
+    lldb::addr_t address;
+    size_t left;
+    size_t right;
+  };
+  const size_t no_node = SIZE_MAX;
+  const size_t count = CalculateNumChildren();
+  const uint32_t ptr_size = process_sp->GetAddressByteSize();
+  std::vector<Node> nodes;
+  if (root != 0)
+    nodes.push_back({root, no_node, no_node});
+  std::vector<Process::MemoryRange> ranges;
+  std::vector<uint8_t> buffer;
+  for (size_t level_begin = 0; level_begin < nodes.size();) {
+    const size_t level_end = nodes.size();
+    ranges.clear();
+    for (size_t i = level_begin; i < level_end; ++i)
+      ranges.emplace_back(nodes[i].address, 2 * ptr_size);
+    buffer.resize(ranges.size() * 2 * ptr_size);
+    std::vector<size_t> bytes_read =
+        process_sp->ReadMemoryRanges(ranges, buffer.data());
+    DataExtractor data(buffer.data(), buffer.size(),
+                       process_sp->GetByteOrder(), ptr_size);
+    lldb::offset_t offset = 0;
+    for (size_t i = level_begin; i < level_end; ++i) {
+      if (bytes_read[i - level_begin] != 2 * ptr_size)
+        return false;
+      const lldb::addr_t children[] = {data.GetAddress(&offset),
+                                       data.GetAddress(&offset)};
+      for (size_t side = 0; side < 2; ++side) {
+        if (children[side] == 0)
+          continue;
+        // More nodes than the map holds means the tree is garbage, or has a
+        // cycle.
+        if (nodes.size() == count)
+          return false;
+        (side == 0 ? nodes[i].left : nodes[i].right) = nodes.size();
+        nodes.push_back({children[side], no_node, no_node});
+      }
+    }
+    level_begin = level_end;
+  }
+  if (nodes.size() != count)
+    return false;
+
+  m_nodes.reserve(count);
+  std::vector<size_t> parents;
+  size_t node = nodes.empty() ? no_node : 0;
+  while (node != no_node || !parents.empty()) {
+    for (; node != no_node; node = nodes[node].left)
+      parents.push_back(node);
+    node = parents.back();
+    parents.pop_back();
+    m_nodes.push_back(nodes[node].address);
+    node = nodes[node].right;
+  }
+  return true;
+}
+
+bool lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::ReadBatch(
+    size_t idx) {
+  const size_t max_batch_count = 1024;
+  const size_t max_batch_size = 1024 * 1024;
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  if (!process_sp)
+    return false;
+
+  size_t end = idx + 1;
+  while (end < m_nodes.size() && end - idx < max_batch_count &&
+         (end - idx + 1) * m_element_size <= max_batch_size)
+    ++end;
+  std::vector<Process::MemoryRange> ranges;
+  for (size_t i = idx; i < end; ++i)
+    ranges.emplace_back(m_nodes[i] + m_skip_size, m_element_size);
+  m_batch_buffer.resize(ranges.size() * m_element_size);
+  std::vector<size_t> bytes_read =
+      process_sp->ReadMemoryRanges(ranges, m_batch_buffer.data());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    if (bytes_read[i] != ranges[i].GetByteSize()) {
+      m_batch_count = 0;
+      return false;
+    }
+  }
+  m_batch_first_index = idx;
+  m_batch_count = end - idx;
+  return true;
+}
+
+lldb::ValueObjectSP
+lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetChildFromNodes(
+    size_t idx) {
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  if (!process_sp)
+    return lldb::ValueObjectSP();
+  if (!m_nodes_read) {
+    m_nodes_read = true;
+    llvm::Optional<uint64_t> size =
+        m_element_type.GetByteSize(process_sp.get());
+    m_element_size = size.getValueOr(0);
+    if (m_element_size == 0 || !ReadNodes())
+      m_nodes.clear();
+  }
+  if (idx >= m_nodes.size())
+    return lldb::ValueObjectSP();
+  if (idx < m_batch_first_index || idx >= m_batch_first_index + m_batch_count)
+    if (!ReadBatch(idx))
+      return lldb::ValueObjectSP();
+
+  DataBufferSP buffer_sp(new DataBufferHeap(
+      m_batch_buffer.data() + (idx - m_batch_first_index) * m_element_size,
+      m_element_size));
+  DataExtractor data(buffer_sp, process_sp->GetByteOrder(),
+                     process_sp->GetAddressByteSize());
+  return CreateChild(idx, data);
+}
+
 bool lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::Update() {
   static ConstString g___tree_("__tree_");
   static ConstString g___begin_node_("__begin_node_");
   m_count = UINT32_MAX;
   m_tree = m_root_node = nullptr;
   m_iterators.clear();
+  m_nodes_read = false;
+  m_nodes.clear();
+  m_batch_count = 0;
   m_tree = m_backend.GetChildMemberWithName(g___tree_, true).get();
   if (!m_tree)
     return false;
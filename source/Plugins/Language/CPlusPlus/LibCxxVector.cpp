@@ -10,6 +10,7 @@
 
 #include "lldb/Core/ValueObject.h"
 #include "lldb/DataFormatters/FormattersHelpers.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Utility/ConstString.h"
 
 using namespace lldb;
@@ -39,6 +40,7 @@ private:
   ValueObject *m_finish;
   CompilerType m_element_type;
   uint32_t m_element_size;
+  ArrayElementPrefetcher m_prefetcher;
 };
 
 class LibcxxVectorBoolSyntheticFrontEnd : public SyntheticChildrenFrontEnd {
@@ -107,6 +109,8 @@ lldb_private::formatters::LibcxxStdVectorSyntheticFrontEnd::GetChildAtIndex(
   if (!m_start || !m_finish)
     return lldb::ValueObjectSP();
 
+  if (ProcessSP process_sp = m_backend.GetProcessSP())
+    m_prefetcher.Prefetch(*process_sp, idx);
   uint64_t offset = idx * m_element_size;
   offset = offset + m_start->GetValueAsUnsigned(0);
   StreamString name;
@@ -118,6 +122,7 @@ lldb_private::formatters::LibcxxStdVectorSyntheticFrontEnd::GetChildAtIndex(
 
 bool lldb_private::formatters::LibcxxStdVectorSyntheticFrontEnd::Update() {
   m_start = m_finish = nullptr;
+  m_prefetcher.Reset(LLDB_INVALID_ADDRESS, 0, 0);
   ValueObjectSP data_type_finder_sp(
       m_backend.GetChildMemberWithName(ConstString("__end_cap_"), true));
   if (!data_type_finder_sp)
@@ -153,6 +158,9 @@ bool lldb_private::formatters::LibcxxStdVectorSyntheticFrontEnd::Update() {
           m_backend.GetChildMemberWithName(ConstString("__begin_"), true).get();
       m_finish =
           m_backend.GetChildMemberWithName(ConstString("__end_"), true).get();
+      if (m_start && m_finish)
+        m_prefetcher.Reset(m_start->GetValueAsUnsigned(0),
+                           CalculateNumChildren(), m_element_size);
     }
   }
   return false;
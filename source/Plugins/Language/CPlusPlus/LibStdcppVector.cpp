@@ -0,0 +1,270 @@
+//===-- LibStdcppVector.cpp -------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "LibStdcpp.h"
+
+#include "lldb/Core/ValueObject.h"
+#include "lldb/DataFormatters/FormattersHelpers.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Utility/ConstString.h"
+#include "lldb/Utility/DataBufferHeap.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::formatters;
+
+// These replace the StdVectorSynthProvider in gnu_libstdcpp.py, which had to
+// cross into Python for every element of every vector.
+
+namespace {
+
+class LibStdcppVectorSyntheticFrontEnd : public SyntheticChildrenFrontEnd {
+public:
+  LibStdcppVectorSyntheticFrontEnd(lldb::ValueObjectSP valobj_sp);
+
+  size_t CalculateNumChildren() override;
+
+  lldb::ValueObjectSP GetChildAtIndex(size_t idx) override;
+
+  bool Update() override;
+
+  bool MightHaveChildren() override { return true; }
+
+  size_t GetIndexOfChildWithName(ConstString name) override;
+
+private:
+  lldb::addr_t m_start = 0;
+  size_t m_count = 0;
+  CompilerType m_element_type;
+  uint64_t m_element_size = 0;
+  ArrayElementPrefetcher m_prefetcher;
+};
+
+/*(std::vector<bool>) v = {
+  std::_Bvector_base<std::allocator<bool> > = {
+    _M_impl = {
+      _M_start = { _M_p = 0x..., _M_offset = 0 }
+      _M_finish = { _M_p = 0x..., _M_offset = 3 }
+      _M_end_of_storage = 0x...
+    }
+  }
+}*/
+
+class LibStdcppVectorBoolSyntheticFrontEnd : public SyntheticChildrenFrontEnd {
+public:
+  LibStdcppVectorBoolSyntheticFrontEnd(lldb::ValueObjectSP valobj_sp);
+
+  size_t CalculateNumChildren() override { return m_count; }
+
+  lldb::ValueObjectSP GetChildAtIndex(size_t idx) override;
+
+  bool Update() override;
+
+  bool MightHaveChildren() override { return true; }
+
+  size_t GetIndexOfChildWithName(ConstString name) override;
+
+private:
+  CompilerType m_bool_type;
+  ExecutionContextRef m_exe_ctx_ref;
+  lldb::addr_t m_start = 0;
+  uint64_t m_word_size = 0;
+  size_t m_count = 0;
+  std::map<size_t, lldb::ValueObjectSP> m_children;
+};
+
+} // namespace
+
+LibStdcppVectorSyntheticFrontEnd::LibStdcppVectorSyntheticFrontEnd(
+    lldb::ValueObjectSP valobj_sp)
+    : SyntheticChildrenFrontEnd(*valobj_sp) {
+  if (valobj_sp)
+    Update();
+}
+
+size_t LibStdcppVectorSyntheticFrontEnd::CalculateNumChildren() {
+  return m_count;
+}
+
+lldb::ValueObjectSP
+LibStdcppVectorSyntheticFrontEnd::GetChildAtIndex(size_t idx) {
+  if (idx >= m_count)
+    return lldb::ValueObjectSP();
+
+  if (ProcessSP process_sp = m_backend.GetProcessSP())
+    m_prefetcher.Prefetch(*process_sp, idx);
+  StreamString name;
+  name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+  return CreateValueObjectFromAddress(
+      name.GetString(), m_start + idx * m_element_size,
+      m_backend.GetExecutionContextRef(), m_element_type);
+}
+
+bool LibStdcppVectorSyntheticFrontEnd::Update() {
+  m_start = 0;
+  m_count = 0;
+  m_prefetcher.Reset(LLDB_INVALID_ADDRESS, 0, 0);
+
+  ValueObjectSP impl_sp(
+      m_backend.GetChildMemberWithName(ConstString("_M_impl"), true));
+  if (!impl_sp)
+    return false;
+  ValueObjectSP start_sp(
+      impl_sp->GetChildMemberWithName(ConstString("_M_start"), true));
+  ValueObjectSP finish_sp(
+      impl_sp->GetChildMemberWithName(ConstString("_M_finish"), true));
+  ValueObjectSP end_sp(
+      impl_sp->GetChildMemberWithName(ConstString("_M_end_of_storage"), true));
+  if (!start_sp || !finish_sp || !end_sp)
+    return false;
+
+  m_element_type = start_sp->GetCompilerType().GetPointeeType();
+  llvm::Optional<uint64_t> size = m_element_type.GetByteSize(nullptr);
+  if (!size || *size == 0)
+    return false;
+  m_element_size = *size;
+
+  // Before a vector has been constructed, it contains garbage, so make sure
+  // the pointers are consistent before trusting them.
+  lldb::addr_t start = start_sp->GetValueAsUnsigned(0);
+  lldb::addr_t finish = finish_sp->GetValueAsUnsigned(0);
+  lldb::addr_t end = end_sp->GetValueAsUnsigned(0);
+  if (start == 0 || finish == 0 || end == 0)
+    return false;
+  if (start >= finish || finish > end)
+    return false;
+  if ((finish - start) % m_element_size)
+    return false;
+
+  m_start = start;
+  m_count = (finish - start) / m_element_size;
+  m_prefetcher.Reset(m_start, m_count, m_element_size);
+  return false;
+}
+
+size_t
+LibStdcppVectorSyntheticFrontEnd::GetIndexOfChildWithName(ConstString name) {
+  return ExtractIndexFromString(name.GetCString());
+}
+
+LibStdcppVectorBoolSyntheticFrontEnd::LibStdcppVectorBoolSyntheticFrontEnd(
+    lldb::ValueObjectSP valobj_sp)
+    : SyntheticChildrenFrontEnd(*valobj_sp) {
+  if (valobj_sp) {
+    m_bool_type =
+        valobj_sp->GetCompilerType().GetBasicTypeFromAST(lldb::eBasicTypeBool);
+    Update();
+  }
+}
+
+lldb::ValueObjectSP
+LibStdcppVectorBoolSyntheticFrontEnd::GetChildAtIndex(size_t idx) {
+  auto iter = m_children.find(idx);
+  if (iter != m_children.end())
+    return iter->second;
+  if (idx >= m_count || !m_bool_type)
+    return {};
+  ProcessSP process_sp(m_exe_ctx_ref.GetProcessSP());
+  if (!process_sp)
+    return {};
+
+  // The bits are stored in words of m_word_size bytes, starting with the
+  // least significant bit of the first word.
+  const uint64_t word_bits = 8 * m_word_size;
+  lldb::addr_t word_location = m_start + (idx / word_bits) * m_word_size;
+  uint8_t word_bytes[sizeof(uint64_t)];
+  Status err;
+  if (process_sp->ReadMemory(word_location, word_bytes, m_word_size, err) !=
+          m_word_size ||
+      err.Fail())
+    return {};
+  DataExtractor word_data(word_bytes, m_word_size, process_sp->GetByteOrder(),
+                          process_sp->GetAddressByteSize());
+  lldb::offset_t offset = 0;
+  uint64_t word = word_data.GetMaxU64(&offset, m_word_size);
+  bool bit_set = (word >> (idx % word_bits)) & 1;
+
+  llvm::Optional<uint64_t> size = m_bool_type.GetByteSize(nullptr);
+  if (!size)
+    return {};
+  DataBufferSP buffer_sp(new DataBufferHeap(*size, 0));
+  // regardless of endianness, anything non-zero is true
+  if (bit_set)
+    *(buffer_sp->GetBytes()) = 1;
+  StreamString name;
+  name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+  ValueObjectSP retval_sp(CreateValueObjectFromData(
+      name.GetString(),
+      DataExtractor(buffer_sp, process_sp->GetByteOrder(),
+                    process_sp->GetAddressByteSize()),
+      m_exe_ctx_ref, m_bool_type));
+  if (retval_sp)
+    m_children[idx] = retval_sp;
+  return retval_sp;
+}
+
+bool LibStdcppVectorBoolSyntheticFrontEnd::Update() {
+  m_children.clear();
+  m_count = 0;
+  m_exe_ctx_ref = m_backend.GetExecutionContextRef();
+
+  ValueObjectSP impl_sp(
+      m_backend.GetChildMemberWithName(ConstString("_M_impl"), true));
+  if (!impl_sp)
+    return false;
+  ValueObjectSP start_sp(
+      impl_sp->GetChildMemberWithName(ConstString("_M_start"), true));
+  ValueObjectSP finish_sp(
+      impl_sp->GetChildMemberWithName(ConstString("_M_finish"), true));
+  if (!start_sp || !finish_sp)
+    return false;
+  ValueObjectSP start_p_sp(
+      start_sp->GetChildMemberWithName(ConstString("_M_p"), true));
+  ValueObjectSP finish_p_sp(
+      finish_sp->GetChildMemberWithName(ConstString("_M_p"), true));
+  ValueObjectSP offset_sp(
+      finish_sp->GetChildMemberWithName(ConstString("_M_offset"), true));
+  if (!start_p_sp || !finish_p_sp || !offset_sp)
+    return false;
+
+  llvm::Optional<uint64_t> word_size =
+      start_p_sp->GetCompilerType().GetPointeeType().GetByteSize(nullptr);
+  if (!word_size || *word_size == 0 || *word_size > sizeof(uint64_t))
+    return false;
+  m_word_size = *word_size;
+
+  lldb::addr_t start = start_p_sp->GetValueAsUnsigned(0);
+  lldb::addr_t finish = finish_p_sp->GetValueAsUnsigned(0);
+  if (start == 0 || finish < start)
+    return false;
+  m_start = start;
+  m_count = (finish - start) * 8 + offset_sp->GetValueAsUnsigned(0);
+  return false;
+}
+
+size_t LibStdcppVectorBoolSyntheticFrontEnd::GetIndexOfChildWithName(
+    ConstString name) {
+  uint32_t idx = ExtractIndexFromString(name.GetCString());
+  if (idx < UINT32_MAX && idx >= CalculateNumChildren())
+    return UINT32_MAX;
+  return idx;
+}
+
+SyntheticChildrenFrontEnd *
+lldb_private::formatters::LibStdcppVectorSyntheticFrontEndCreator(
+    CXXSyntheticChildren *, lldb::ValueObjectSP valobj_sp) {
+  if (!valobj_sp)
+    return nullptr;
+  CompilerType type = valobj_sp->GetCompilerType();
+  if (!type.IsValid() || type.GetNumTemplateArguments() == 0)
+    return nullptr;
+  CompilerType arg_type = type.GetTypeTemplateArgument(0);
+  if (arg_type.GetTypeName() == "bool")
+    return new LibStdcppVectorBoolSyntheticFrontEnd(valobj_sp);
+  return new LibStdcppVectorSyntheticFrontEnd(valobj_sp);
+}
@@ -40,29 +40,105 @@ lldb_private::CompilerType SwiftArrayNativeBufferHandler::GetElementType() {
 }
 
 ValueObjectSP SwiftArrayNativeBufferHandler::GetElementAtIndex(size_t idx) {
-  if (idx >= m_size)
+  if (idx >= m_size || m_element_stride == 0)
     return ValueObjectSP();
 
-  lldb::addr_t child_location = m_first_elem_ptr + idx * m_element_stride;
-
   ProcessSP process_sp(m_exe_ctx_ref.GetProcessSP());
   if (!process_sp)
     return ValueObjectSP();
 
-  DataBufferSP buffer(new DataBufferHeap(m_element_size, 0));
-  Status error;
-  if (process_sp->ReadMemory(child_location, buffer->GetBytes(), m_element_size,
-                             error) != m_element_size ||
-      error.Fail())
-    return ValueObjectSP();
-  DataExtractor data(buffer, process_sp->GetByteOrder(),
-                     process_sp->GetAddressByteSize());
+  if (idx < m_elements_start || idx >= m_elements_start + m_elements_count)
+    if (!ReadElements(*process_sp, idx))
+      return ValueObjectSP();
+
+  // All the children in the batch share the same buffer.
+  DataExtractor data(m_elements, (idx - m_elements_start) * m_element_stride,
+                     m_element_size);
   StreamString name;
   name.Printf("[%zu]", idx);
   return ValueObject::CreateValueObjectFromData(name.GetData(), data,
                                                 m_exe_ctx_ref, m_elem_type);
 }
 
+void SwiftArrayNativeBufferHandler::PrefetchElements(size_t start,
+                                                     size_t count) {
+  if (start >= m_size || count == 0 || m_element_stride == 0)
+    return;
+  if (start >= m_elements_start &&
+      start + count <= m_elements_start + m_elements_count)
+    return;
+  if (ProcessSP process_sp = m_exe_ctx_ref.GetProcessSP())
+    ReadElements(*process_sp, start, count);
+}
+
+bool SwiftArrayNativeBufferHandler::ReadElements(Process &process, size_t idx,
+                                                 size_t count) {
+  // Read a batch of elements at once instead of one element at a time.
+  const size_t max_batch_size = 1024 * 1024;
+  count = std::min<size_t>(m_size - idx, count);
+  count = std::max<size_t>(
+      1, std::min<size_t>(count, max_batch_size / m_element_stride));
+  // The last element doesn't need its trailing padding.
+  size_t length = (count - 1) * m_element_stride + m_element_size;
+
+  DataBufferSP buffer(new DataBufferHeap(length, 0));
+  Status error;
+  if (process.ReadMemory(m_first_elem_ptr + idx * m_element_stride,
+                         buffer->GetBytes(), length, error) != length ||
+      error.Fail()) {
+    m_elements.Clear();
+    m_elements_count = 0;
+    return false;
+  }
+  m_elements = DataExtractor(buffer, process.GetByteOrder(),
+                             process.GetAddressByteSize());
+  m_elements_start = idx;
+  m_elements_count = count;
+  PrefetchMetadata(process, count);
+  return true;
+}
+
+void SwiftArrayNativeBufferHandler::PrefetchMetadata(Process &process,
+                                                     size_t count) {
+  // Resolving the dynamic type of each element chases several pointers, so
+  // read those for the whole batch up front. Trivial value types don't
+  // reference any metadata.
+  SwiftLanguageRuntime *runtime = SwiftLanguageRuntime::Get(process);
+  if (!runtime)
+    return;
+
+  const size_t ptr_size = process.GetAddressByteSize();
+  bool is_class = Flags(m_elem_type.GetTypeInfo())
+                      .AllSet(eTypeIsClass | eTypeInstanceIsPointer);
+  size_t metadata_offset = 0;
+  SwiftASTContext::ProtocolInfo protocol_info;
+  if (!is_class &&
+      SwiftASTContext::GetProtocolTypeInfo(m_elem_type, protocol_info)) {
+    if (protocol_info.m_is_class_only)
+      is_class = true;
+    else if (protocol_info.m_num_payload_words)
+      metadata_offset = protocol_info.m_num_payload_words * ptr_size;
+  }
+  if (!is_class && !metadata_offset)
+    return;
+
+  std::vector<lldb::addr_t> metadata_locations;
+  for (size_t i = 0; i < count; ++i) {
+    if (!is_class) {
+      metadata_locations.push_back(m_first_elem_ptr +
+                                   (m_elements_start + i) * m_element_stride +
+                                   metadata_offset);
+      continue;
+    }
+    // The metadata pointer is the isa of the referenced object.
+    lldb::offset_t offset = i * m_element_stride;
+    lldb::addr_t object = m_elements.GetAddress(&offset);
+    if (object)
+      metadata_locations.push_back(object);
+  }
+  runtime->PrefetchMetadata(metadata_locations);
+}
+
 SwiftArrayNativeBufferHandler::SwiftArrayNativeBufferHandler(
     ValueObject &valobj, lldb::addr_t native_ptr, CompilerType elem_type)
     : m_metadata_ptr(LLDB_INVALID_ADDRESS),
@@ -485,6 +561,12 @@ lldb_private::formatters::swift::ArraySyntheticFrontEnd::GetChildAtIndex(
   return child_sp;
 }
 
+void lldb_private::formatters::swift::ArraySyntheticFrontEnd::PrefetchChildren(
+    size_t start, size_t count) {
+  if (m_array_buffer)
+    m_array_buffer->PrefetchElements(start, count);
+}
+
 bool lldb_private::formatters::swift::ArraySyntheticFrontEnd::Update() {
   m_array_buffer = SwiftArrayBufferHandler::CreateBufferHandler(m_backend);
   return false;
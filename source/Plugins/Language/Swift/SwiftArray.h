@@ -21,6 +21,7 @@
 #include "lldb/DataFormatters/TypeSynthetic.h"
 #include "lldb/Symbol/CompilerType.h"
 #include "lldb/Target/Target.h"
+#include "lldb/Utility/DataExtractor.h"
 
 namespace lldb_private {
 namespace formatters {
@@ -40,6 +41,10 @@ public:
 
   virtual lldb::ValueObjectSP GetElementAtIndex(size_t) = 0;
 
+  /// A hint that the elements in [start, start + count) are about to be
+  /// requested.
+  virtual void PrefetchElements(size_t start, size_t count) {}
+
   static std::unique_ptr<SwiftArrayBufferHandler>
   CreateBufferHandler(ValueObject &valobj);
 
@@ -86,6 +91,8 @@ public:
 
   virtual lldb::ValueObjectSP GetElementAtIndex(size_t);
 
+  virtual void PrefetchElements(size_t start, size_t count);
+
   virtual bool IsValid();
 
   virtual ~SwiftArrayNativeBufferHandler() {}
@@ -96,6 +103,15 @@ protected:
   friend class SwiftArrayBufferHandler;
 
 private:
+  /// Read the batch of up to \a count elements starting at \a idx into
+  /// m_elements.
+  bool ReadElements(lldb_private::Process &process, size_t idx,
+                    size_t count = 1024);
+
+  /// Prefetch the dynamic type metadata of the \a count elements in
+  /// m_elements, if the elements reference any.
+  void PrefetchMetadata(lldb_private::Process &process, size_t count);
+
   lldb::addr_t m_metadata_ptr;
   uint64_t m_reserved_word;
   lldb::addr_t m_size;
@@ -105,6 +121,10 @@ private:
   size_t m_element_size;
   size_t m_element_stride;
   lldb_private::ExecutionContextRef m_exe_ctx_ref;
+  /// The contents of a batch of elements, starting at m_elements_start.
+  lldb_private::DataExtractor m_elements;
+  size_t m_elements_start = 0;
+  size_t m_elements_count = 0;
 };
 
 class SwiftArrayBridgedBufferHandler : public SwiftArrayBufferHandler {
@@ -196,6 +216,8 @@ public:
 
   virtual lldb::ValueObjectSP GetChildAtIndex(size_t idx);
 
+  virtual void PrefetchChildren(size_t start, size_t count);
+
   virtual bool Update();
 
   virtual bool MightHaveChildren();
@@ -28,6 +28,7 @@
 #include "swift/Remote/RemoteAddress.h"
 #include "swift/RemoteAST/RemoteAST.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MathExtras.h"
 
 #include <algorithm>
 
@@ -101,33 +102,25 @@ protected:
       : LLDB_INVALID_ADDRESS;
   }
 
-  // these are sharp tools that assume that the Bucket contains valid
-  // data and the destination buffer has enough room to store the data
-  // to - use with caution
-  bool GetDataForKeyInBucket(Bucket b, void *data_ptr) {
-    if (!data_ptr)
-      return false;
-
-    lldb::addr_t addr = GetLocationOfKeyInBucket(b);
-    Status error;
-    m_process->ReadMemory(addr, data_ptr, m_key_stride, error);
-    if (error.Fail())
-      return false;
+  // Read the keys and values of a batch of occupied buckets, starting with
+  // the one of element idx.
+  bool ReadBatch(size_t idx);
 
-    return true;
+  // these are sharp tools that assume that the Bucket is in the current
+  // batch and the destination buffer has enough room to store the data
+  // to - use with caution
+  void GetDataForKeyInBucket(Bucket b, uint8_t *data_ptr) {
+    memcpy(data_ptr,
+           m_batch_buffer.data() + (b - m_batch_first_bucket) * m_key_stride,
+           m_key_stride);
   }
 
-  bool GetDataForValueInBucket(Bucket b, void *data_ptr) {
-    if (!data_ptr || !m_value_stride)
-      return false;
-
-    lldb::addr_t addr = GetLocationOfValueInBucket(b);
-    Status error;
-    m_process->ReadMemory(addr, data_ptr, m_value_stride, error);
-    if (error.Fail())
-      return false;
-
-    return true;
+  void GetDataForValueInBucket(Bucket b, uint8_t *data_ptr) {
+    const size_t keys_size = m_batch_bucket_count * m_key_stride;
+    memcpy(data_ptr,
+           m_batch_buffer.data() + keys_size +
+               (b - m_batch_first_bucket) * m_value_stride,
+           m_value_stride);
   }
 
 private:
@@ -146,6 +139,12 @@ private:
   // Cached mapping from index to occupied bucket.
   std::vector<Bucket> m_occupiedBuckets;
   bool m_failedToGetBuckets;
+  // The keys, followed by the values, of the buckets in the current batch.
+  std::vector<uint8_t> m_batch_buffer;
+  size_t m_batch_first_index = 0;
+  size_t m_batch_count = 0;
+  Bucket m_batch_first_bucket = 0;
+  size_t m_batch_bucket_count = 0;
 };
 
 class CocoaHashedStorageHandler: public HashedStorageHandler {
@@ -560,29 +559,31 @@ NativeHashedStorageHandler::UpdateBuckets() {
     return false;
   if (!m_occupiedBuckets.empty())
     return true;
-  // Scan bitmap for occupied buckets.
+  // Read the whole bitmap at once and scan it for occupied buckets.
   m_occupiedBuckets.reserve(m_count);
   size_t bucketCount = GetBucketCount();
   size_t wordWidth = GetWordWidth();
   size_t wordCount = GetWordCount();
+  DataBufferSP bitmap_sp(new DataBufferHeap(wordCount * m_ptr_size, 0));
+  Status error;
+  if (m_process->ReadMemory(m_metadata_ptr, bitmap_sp->GetBytes(),
+                            bitmap_sp->GetByteSize(),
+                            error) != bitmap_sp->GetByteSize() ||
+      error.Fail())
+    return FailBuckets();
+  DataExtractor bitmap(bitmap_sp, m_process->GetByteOrder(), m_ptr_size);
+  lldb::offset_t offset = 0;
   for (size_t wordIndex = 0; wordIndex < wordCount; wordIndex++) {
-    Status error;
-    auto word = GetMetadataWord(wordIndex, error);
-    if (error.Fail()) {
-      return FailBuckets();
-    }
-    if (wordCount == 1) {
+    uint64_t word = bitmap.GetMaxU64(&offset, m_ptr_size);
+    if (wordCount == 1 && bucketCount < 64) {
       // Mask off out-of-bounds bits from first partial word.
       word &= (1ULL << bucketCount) - 1;
     }
-    for (size_t bit = 0; bit < wordWidth; bit++) {
-      if ((word & (1ULL << bit)) != 0) {
-        if (m_occupiedBuckets.size() == m_count) {
-          return FailBuckets();
-        }
-        m_occupiedBuckets.push_back(wordIndex * wordWidth + bit);
-      }
-    }
+    if (m_occupiedBuckets.size() + llvm::countPopulation(word) > m_count)
+      return FailBuckets();
+    for (; word; word &= word - 1)
+      m_occupiedBuckets.push_back(wordIndex * wordWidth +
+                                  llvm::countTrailingZeros(word));
   }
   if (m_occupiedBuckets.size() != m_count) {
     return FailBuckets();
@@ -590,6 +591,42 @@ NativeHashedStorageHandler::UpdateBuckets() {
   return true;
 }
 
+bool NativeHashedStorageHandler::ReadBatch(size_t idx) {
+  // Read the keys and values of up to max_batch_count elements, which are in
+  // consecutive buckets of the keys and values arrays, with one request.
+  const size_t max_batch_count = 1024;
+  const size_t max_batch_size = 1024 * 1024;
+  const size_t bucket_size = m_key_stride + m_value_stride;
+  Bucket first_bucket = m_occupiedBuckets[idx];
+  size_t end = idx + 1;
+  while (end < m_occupiedBuckets.size() && end - idx < max_batch_count &&
+         (m_occupiedBuckets[end] - first_bucket + 1) * bucket_size <=
+             max_batch_size)
+    ++end;
+  size_t bucket_count = m_occupiedBuckets[end - 1] - first_bucket + 1;
+
+  std::vector<Process::MemoryRange> ranges;
+  ranges.emplace_back(GetLocationOfKeyInBucket(first_bucket),
+                      bucket_count * m_key_stride);
+  if (m_value_stride)
+    ranges.emplace_back(GetLocationOfValueInBucket(first_bucket),
+                        bucket_count * m_value_stride);
+  m_batch_buffer.resize(bucket_count * bucket_size);
+  std::vector<size_t> bytes_read =
+      m_process->ReadMemoryRanges(ranges, m_batch_buffer.data());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    if (bytes_read[i] != ranges[i].GetByteSize()) {
+      m_batch_count = 0;
+      return false;
+    }
+  }
+  m_batch_first_index = idx;
+  m_batch_count = end - idx;
+  m_batch_first_bucket = first_bucket;
+  m_batch_bucket_count = bucket_count;
+  return true;
+}
+
 ValueObjectSP
 NativeHashedStorageHandler::GetElementAtIndex(size_t idx) {
   if (!UpdateBuckets())
@@ -598,17 +635,17 @@ NativeHashedStorageHandler::GetElementAtIndex(size_t idx) {
     return nullptr;
   if (idx >= m_occupiedBuckets.size())
     return nullptr;
+  if (idx < m_batch_first_index ||
+      idx >= m_batch_first_index + m_batch_count)
+    if (!ReadBatch(idx))
+      return nullptr;
   Bucket bucket = m_occupiedBuckets[idx];
   DataBufferSP full_buffer_sp(
     new DataBufferHeap(m_key_stride_padded + m_value_stride, 0));
   uint8_t *key_buffer_ptr = full_buffer_sp->GetBytes();
-  uint8_t *value_buffer_ptr =
-    m_value_stride ? (key_buffer_ptr + m_key_stride_padded) : nullptr;
-  if (!GetDataForKeyInBucket(bucket, key_buffer_ptr))
-    return nullptr;
-  if (value_buffer_ptr != nullptr &&
-      !GetDataForValueInBucket(bucket, value_buffer_ptr))
-    return nullptr;
+  GetDataForKeyInBucket(bucket, key_buffer_ptr);
+  if (m_value_stride)
+    GetDataForValueInBucket(bucket, key_buffer_ptr + m_key_stride_padded);
   DataExtractor full_data;
   full_data.SetData(full_buffer_sp);
   StreamString name;
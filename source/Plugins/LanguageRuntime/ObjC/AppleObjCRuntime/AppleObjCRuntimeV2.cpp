@@ -109,30 +109,42 @@ struct ClassInfo
     uint32_t hash;
 } __attribute__((__packed__));
 
+// known_isas_ptr holds the isa we last saw in each bucket. When incremental
+// is set, only the buckets whose isa changed since the previous call are
+// reported, so classes registered lazily don't cost a dump of the whole table.
 uint32_t
 __lldb_apple_objc_v2_get_dynamic_class_info (void *gdb_objc_realized_classes_ptr,
                                              void *class_infos_ptr,
                                              uint32_t class_infos_byte_size,
+                                             void *known_isas_ptr,
+                                             uint32_t incremental,
                                              uint32_t should_log)
 {
     DEBUG_PRINTF ("gdb_objc_realized_classes_ptr = %p\n", gdb_objc_realized_classes_ptr);
     DEBUG_PRINTF ("class_infos_ptr = %p\n", class_infos_ptr);
     DEBUG_PRINTF ("class_infos_byte_size = %u\n", class_infos_byte_size);
+    DEBUG_PRINTF ("known_isas_ptr = %p, incremental = %u\n", known_isas_ptr, incremental);
     const NXMapTable *grc = (const NXMapTable *)gdb_objc_realized_classes_ptr;
     if (grc)
     {
-        const unsigned num_classes = grc->num_classes;
+        uint32_t idx = 0;
         if (class_infos_ptr)
         {
             const size_t max_class_infos = class_infos_byte_size/sizeof(ClassInfo);
             ClassInfo *class_infos = (ClassInfo *)class_infos_ptr;
             BucketInfo *buckets = (BucketInfo *)grc->buckets;
-            
-            uint32_t idx = 0;
+            Class *known_isas = (Class *)known_isas_ptr;
+
             for (unsigned i=0; i<=grc->num_buckets_minus_one; ++i)
             {
                 if (buckets[i].name_ptr != NX_MAPNOTAKEY)
                 {
+                    if (known_isas)
+                    {
+                        if (incremental && known_isas[i] == buckets[i].isa)
+                            continue;
+                        known_isas[i] = buckets[i].isa;
+                    }
                     if (idx < max_class_infos)
                     {
                         const char *s = buckets[i].name_ptr;
@@ -144,6 +156,8 @@ __lldb_apple_objc_v2_get_dynamic_class_info (void *gdb_objc_realized_classes_ptr
                     }
                     ++idx;
                 }
+                else if (known_isas)
+                    known_isas[i] = NULL;
             }
             if (idx < max_class_infos)
             {
@@ -151,7 +165,8 @@ __lldb_apple_objc_v2_get_dynamic_class_info (void *gdb_objc_realized_classes_ptr
                 class_infos[idx].hash = 0;
             }
         }
-        return num_classes;
+        DEBUG_PRINTF ("%u of %u classes reported\n", idx, grc->num_classes);
+        return idx;
     }
     return 0;
 }
@@ -425,7 +440,11 @@ AppleObjCRuntimeV2::AppleObjCRuntimeV2(Process *process,
       m_tagged_pointer_vendor_up(
           TaggedPointerVendorV2::CreateInstance(*this, objc_module_sp)),
       m_encoding_to_type_sp(), m_noclasses_warning_emitted(false),
-      m_CFBoolean_values() {
+      m_CFBoolean_values(), m_class_infos_addr(LLDB_INVALID_ADDRESS),
+      m_class_infos_byte_size(0), m_known_isas_addr(LLDB_INVALID_ADDRESS),
+      m_known_isas_num_buckets(0),
+      m_known_isas_buckets_ptr(LLDB_INVALID_ADDRESS), m_dynamic_type_cache(),
+      m_dynamic_type_cache_stop_id(UINT32_MAX) {
   static const ConstString g_gdb_object_getClass("gdb_object_getClass");
   m_has_object_getClass =
       (objc_module_sp->FindFirstSymbolWithNameAndType(
@@ -456,6 +475,18 @@ bool AppleObjCRuntimeV2::GetDynamicTypeAndAddress(
 
   // Make sure we can have a dynamic value before starting...
   if (CouldHaveDynamicValue(in_value, allow_swift)) {
+    // Objects of the same class share an isa, so an array of them only needs
+    // to go through the class descriptor and type lookup once per stop.
+    const ObjCISA cache_key = GetDynamicTypeCacheKey(in_value);
+    if (cache_key) {
+      auto pos = m_dynamic_type_cache.find(cache_key);
+      if (pos != m_dynamic_type_cache.end()) {
+        address.SetRawAddress(in_value.GetPointerValue());
+        class_type_or_name = pos->second;
+        return true;
+      }
+    }
+
     // First job, pull out the address at 0 offset from the object  That will
     // be the ISA pointer.
     ClassDescriptorSP objc_class_sp(GetNonKVOClassDescriptor(in_value));
@@ -490,10 +521,39 @@ bool AppleObjCRuntimeV2::GetDynamicTypeAndAddress(
         }
       }
     }
+    if (cache_key && !class_type_or_name.IsEmpty())
+      m_dynamic_type_cache[cache_key] = class_type_or_name;
   }
   return !class_type_or_name.IsEmpty();
 }
 
+ObjCLanguageRuntime::ObjCISA
+AppleObjCRuntimeV2::GetDynamicTypeCacheKey(ValueObject &in_value) {
+  // Base class values resolve through their parent, and tagged pointers
+  // carry their class in the pointer itself.
+  if (in_value.IsBaseClass())
+    return 0;
+  const addr_t object_ptr = in_value.GetPointerValue();
+  if (object_ptr == 0 || object_ptr == LLDB_INVALID_ADDRESS ||
+      IsTaggedPointer(object_ptr))
+    return 0;
+
+  const uint32_t stop_id = m_process->GetStopID();
+  if (stop_id != m_dynamic_type_cache_stop_id) {
+    m_dynamic_type_cache.clear();
+    m_dynamic_type_cache_stop_id = stop_id;
+  }
+
+  // The isa is the one read we can't avoid, but it comes out of the memory
+  // cache. Strip the non-pointer bits: they hold the retain count and other
+  // per-object state.
+  Status error;
+  ObjCISA isa = m_process->ReadPointerFromMemory(object_ptr, error);
+  if (error.Fail() || isa == LLDB_INVALID_ADDRESS)
+    return 0;
+  return GetPointerISA(isa);
+}
+
 bool AppleObjCRuntimeV2::GetDynamicTypeAndAddress(
     ValueObject &in_value, DynamicValueType use_dynamic,
     TypeAndOrName &class_type_or_name, Address &address,
@@ -1378,6 +1438,14 @@ AppleObjCRuntimeV2::UpdateISAToDescriptorMapDynamic(
     arguments.PushValue(value);
     arguments.PushValue(value);
 
+    value.SetValueType(Value::eValueTypeScalar);
+    value.SetCompilerType(clang_uint32_t_type);
+    arguments.PushValue(value);
+
+    value.SetValueType(Value::eValueTypeScalar);
+    value.SetCompilerType(clang_void_pointer_type);
+    arguments.PushValue(value);
+
     value.SetValueType(Value::eValueTypeScalar);
     value.SetCompilerType(clang_uint32_t_type);
     arguments.PushValue(value);
@@ -1407,32 +1475,62 @@ AppleObjCRuntimeV2::UpdateISAToDescriptorMapDynamic(
 
   diagnostics.Clear();
 
+  std::lock_guard<std::mutex> guard(m_get_class_info_args_mutex);
+
+  // The ClassInfo array and the per-bucket isa snapshot live in the inferior
+  // across calls. The array only ever grows; the snapshot is tied to the
+  // bucket array it describes, and a new one means a full dump.
   const uint32_t class_info_byte_size = addr_size + 4;
   const uint32_t class_infos_byte_size = num_classes * class_info_byte_size;
-  lldb::addr_t class_infos_addr = process->AllocateMemory(
-      class_infos_byte_size, ePermissionsReadable | ePermissionsWritable, err);
-
-  if (class_infos_addr == LLDB_INVALID_ADDRESS) {
-    LLDB_LOGF(log,
-              "unable to allocate %" PRIu32
-              " bytes in process for shared cache read",
-              class_infos_byte_size);
-    return DescriptorMapUpdateResult::Fail();
+  if (class_infos_byte_size > m_class_infos_byte_size) {
+    if (m_class_infos_addr != LLDB_INVALID_ADDRESS)
+      process->DeallocateMemory(m_class_infos_addr);
+    const uint32_t new_byte_size =
+        std::max(class_infos_byte_size, 2 * m_class_infos_byte_size);
+    m_class_infos_byte_size = 0;
+    m_class_infos_addr = process->AllocateMemory(
+        new_byte_size, ePermissionsReadable | ePermissionsWritable, err);
+    if (m_class_infos_addr == LLDB_INVALID_ADDRESS) {
+      LLDB_LOGF(log,
+                "unable to allocate %" PRIu32
+                " bytes in process for shared cache read",
+                new_byte_size);
+      return DescriptorMapUpdateResult::Fail();
+    }
+    m_class_infos_byte_size = new_byte_size;
   }
 
-  std::lock_guard<std::mutex> guard(m_get_class_info_args_mutex);
+  // GetBucketCount() really returns num_buckets_minus_one.
+  const uint32_t num_buckets = hash_table.GetBucketCount() + 1;
+  const lldb::addr_t buckets_ptr = hash_table.GetBucketDataPointer();
+  bool incremental = m_known_isas_addr != LLDB_INVALID_ADDRESS &&
+                     m_known_isas_num_buckets == num_buckets &&
+                     m_known_isas_buckets_ptr == buckets_ptr;
+  if (!incremental) {
+    if (m_known_isas_addr != LLDB_INVALID_ADDRESS)
+      process->DeallocateMemory(m_known_isas_addr);
+    m_known_isas_addr = process->AllocateMemory(
+        num_buckets * addr_size, ePermissionsReadable | ePermissionsWritable,
+        err);
+    // Without a snapshot we can still do a full dump.
+    m_known_isas_num_buckets = num_buckets;
+    m_known_isas_buckets_ptr = buckets_ptr;
+  }
 
   // Fill in our function argument values
   arguments.GetValueAtIndex(0)->GetScalar() = hash_table.GetTableLoadAddress();
-  arguments.GetValueAtIndex(1)->GetScalar() = class_infos_addr;
-  arguments.GetValueAtIndex(2)->GetScalar() = class_infos_byte_size;
-  
+  arguments.GetValueAtIndex(1)->GetScalar() = m_class_infos_addr;
+  arguments.GetValueAtIndex(2)->GetScalar() = m_class_infos_byte_size;
+  arguments.GetValueAtIndex(3)->GetScalar() =
+      m_known_isas_addr == LLDB_INVALID_ADDRESS ? 0 : m_known_isas_addr;
+  arguments.GetValueAtIndex(4)->GetScalar() = incremental ? 1 : 0;
+
   // Only dump the runtime classes from the expression evaluation if the log is
   // verbose:
   Log *type_log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_TYPES);
   bool dump_log = type_log && type_log->GetVerbose();
   
-  arguments.GetValueAtIndex(3)->GetScalar() = dump_log ? 1 : 0;
+  arguments.GetValueAtIndex(5)->GetScalar() = dump_log ? 1 : 0;
 
   bool success = false;
 
@@ -1464,12 +1562,15 @@ AppleObjCRuntimeV2::UpdateISAToDescriptorMapDynamic(
 
     if (results == eExpressionCompleted) {
       // The result is the number of ClassInfo structures that were filled in
-      num_class_infos = return_value.GetScalar().ULong();
-      LLDB_LOGF(log, "Discovered %u ObjC classes\n", num_class_infos);
+      num_class_infos = std::min<uint32_t>(
+          return_value.GetScalar().ULong(),
+          m_class_infos_byte_size / class_info_byte_size);
+      LLDB_LOGF(log, "Discovered %u %sObjC classes\n", num_class_infos,
+                incremental ? "new " : "");
       if (num_class_infos > 0) {
         // Read the ClassInfo structures
         DataBufferHeap buffer(num_class_infos * class_info_byte_size, 0);
-        if (process->ReadMemory(class_infos_addr, buffer.GetBytes(),
+        if (process->ReadMemory(m_class_infos_addr, buffer.GetBytes(),
                                 buffer.GetByteSize(),
                                 err) == buffer.GetByteSize()) {
           DataExtractor class_infos_data(buffer.GetBytes(),
@@ -1492,8 +1593,10 @@ AppleObjCRuntimeV2::UpdateISAToDescriptorMapDynamic(
     }
   }
 
-  // Deallocate the memory we allocated for the ClassInfo array
-  process->DeallocateMemory(class_infos_addr);
+  // If the function didn't run to completion the snapshot may be ahead of
+  // what we parsed, so start over with a full dump next time.
+  if (!success)
+    m_known_isas_buckets_ptr = LLDB_INVALID_ADDRESS;
 
   return DescriptorMapUpdateResult(success, num_class_infos);
 }
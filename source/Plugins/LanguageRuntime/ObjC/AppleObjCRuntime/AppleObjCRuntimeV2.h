@@ -14,8 +14,11 @@
 #include <mutex>
 
 #include "AppleObjCRuntime.h"
+#include "lldb/Symbol/Type.h"
 #include "lldb/lldb-private.h"
 
+#include "llvm/ADT/DenseMap.h"
+
 #include "Plugins/LanguageRuntime/ObjC/ObjCLanguageRuntime.h"
 
 class RemoteNXMapTable;
@@ -320,6 +323,11 @@ private:
 
   bool GetCFBooleanValuesIfNeeded();
 
+  /// Return the class pointer of the object \a in_value points to, or 0 if
+  /// its dynamic type can't be cached by isa. Clears the dynamic type cache
+  /// when the process has stopped since it was filled.
+  ObjCISA GetDynamicTypeCacheKey(ValueObject &in_value);
+
   friend class ClassDescriptorV2;
   friend class SwiftLanguageRuntime;
 
@@ -342,6 +350,17 @@ private:
   EncodingToTypeSP m_encoding_to_type_sp;
   bool m_noclasses_warning_emitted;
   llvm::Optional<std::pair<lldb::addr_t, lldb::addr_t>> m_CFBoolean_values;
+  /// Inferior buffers reused by UpdateISAToDescriptorMapDynamic: the
+  /// ClassInfo array, and the isa last seen in each bucket of the realized
+  /// classes table at m_known_isas_buckets_ptr.
+  lldb::addr_t m_class_infos_addr;
+  uint32_t m_class_infos_byte_size;
+  lldb::addr_t m_known_isas_addr;
+  uint32_t m_known_isas_num_buckets;
+  lldb::addr_t m_known_isas_buckets_ptr;
+  /// The dynamic types resolved during the current stop, keyed by isa.
+  llvm::DenseMap<ObjCISA, TypeAndOrName> m_dynamic_type_cache;
+  uint32_t m_dynamic_type_cache_stop_id;
 };
 
 } // namespace lldb_private
@@ -20,6 +20,7 @@
 
 #include "clang/Basic/TargetOptions.h"
 
+#include "lldb/Core/PluginManager.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/Log.h"
@@ -82,6 +83,7 @@ bool RenderScriptRuntimeModulePass::runOnModule(llvm::Module &module) {
   Log *log(
       GetLogIfAllCategoriesSet(LIBLLDB_LOG_LANGUAGE | LIBLLDB_LOG_EXPRESSIONS));
 
+  PluginManager::InitializeLLVMTargets();
   std::string err;
   llvm::StringRef real_triple =
       m_process_ptr->GetTarget().GetArchitecture().GetTriple().getTriple();
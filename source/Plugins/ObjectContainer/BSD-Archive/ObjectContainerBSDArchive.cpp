@@ -37,6 +37,8 @@ typedef struct ar_hdr {
 
 #include "llvm/Support/MemoryBuffer.h"
 
+#include <algorithm>
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -55,12 +57,23 @@ void ObjectContainerBSDArchive::Object::Clear() {
   file_size = 0;
 }
 
+// Parse the decimal or octal number in a space padded header field the way
+// strtoul would, without copying the field.
+static uint64_t ParseHeaderNumber(llvm::StringRef field, unsigned radix) {
+  field = field.ltrim();
+  field = field.take_while([radix](char c) {
+    return c >= '0' && c < char('0' + std::min(radix, 10u));
+  });
+  uint64_t value = 0;
+  if (field.getAsInteger(radix, value))
+    return 0;
+  return value;
+}
+
 lldb::offset_t
 ObjectContainerBSDArchive::Object::Extract(const DataExtractor &data,
                                            lldb::offset_t offset) {
   size_t ar_name_len = 0;
-  std::string str;
-  char *err;
 
   // File header
   //
@@ -85,46 +98,42 @@ ObjectContainerBSDArchive::Object::Extract(const DataExtractor &data,
   if (!data.ValidOffsetForDataOfSize(offset, 60))
     return LLDB_INVALID_OFFSET;
 
-  str.assign((const char *)data.GetData(&offset, 16), 16);
-  if (str.find("#1/") == 0) {
+  // The header is parsed in place, archives with many members are read for
+  // every debug map object file that refers to them.
+  auto get_field = [&](size_t length) {
+    return llvm::StringRef((const char *)data.GetData(&offset, length),
+                           length);
+  };
+  // Names end at the first NUL, if any.
+  auto set_name = [this](llvm::StringRef name) {
+    ar_name.SetString(name.take_until([](char c) { return c == '\0'; }));
+  };
+
+  llvm::StringRef name = get_field(16);
+  if (name.startswith("#1/")) {
     // If the name is longer than 16 bytes, or contains an embedded space then
     // it will use this format where the length of the name is here and the
     // name characters are after this header.
-    ar_name_len = strtoul(str.c_str() + 3, &err, 10);
+    ar_name_len = ParseHeaderNumber(name.drop_front(3), 10);
   } else {
     // Strip off any trailing spaces.
-    const size_t last_pos = str.find_last_not_of(' ');
-    if (last_pos != std::string::npos) {
-      if (last_pos + 1 < 16)
-        str.erase(last_pos + 1);
-    }
-    ar_name.SetCString(str.c_str());
+    llvm::StringRef trimmed = name.rtrim(' ');
+    set_name(trimmed.empty() ? name : trimmed);
   }
 
-  str.assign((const char *)data.GetData(&offset, 12), 12);
-  modification_time = strtoul(str.c_str(), &err, 10);
-
-  str.assign((const char *)data.GetData(&offset, 6), 6);
-  uid = strtoul(str.c_str(), &err, 10);
-
-  str.assign((const char *)data.GetData(&offset, 6), 6);
-  gid = strtoul(str.c_str(), &err, 10);
-
-  str.assign((const char *)data.GetData(&offset, 8), 8);
-  mode = strtoul(str.c_str(), &err, 8);
+  modification_time = ParseHeaderNumber(get_field(12), 10);
+  uid = ParseHeaderNumber(get_field(6), 10);
+  gid = ParseHeaderNumber(get_field(6), 10);
+  mode = ParseHeaderNumber(get_field(8), 8);
+  size = ParseHeaderNumber(get_field(10), 10);
 
-  str.assign((const char *)data.GetData(&offset, 10), 10);
-  size = strtoul(str.c_str(), &err, 10);
-
-  str.assign((const char *)data.GetData(&offset, 2), 2);
-  if (str == ARFMAG) {
+  if (get_field(2) == ARFMAG) {
     if (ar_name_len > 0) {
       const void *ar_name_ptr = data.GetData(&offset, ar_name_len);
       // Make sure there was enough data for the string value and bail if not
       if (ar_name_ptr == nullptr)
         return LLDB_INVALID_OFFSET;
-      str.assign((const char *)ar_name_ptr, ar_name_len);
-      ar_name.SetCString(str.c_str());
+      set_name(llvm::StringRef((const char *)ar_name_ptr, ar_name_len));
     }
     file_offset = offset;
     file_size = size - ar_name_len;
@@ -144,25 +153,26 @@ ObjectContainerBSDArchive::Archive::~Archive() {}
 
 size_t ObjectContainerBSDArchive::Archive::ParseObjects() {
   DataExtractor &data = m_data;
-  std::string str;
   lldb::offset_t offset = 0;
-  str.assign((const char *)data.GetData(&offset, SARMAG), SARMAG);
-  if (str == ARMAG) {
+  const char *magic = (const char *)data.GetData(&offset, SARMAG);
+  if (magic && llvm::StringRef(magic, SARMAG) == ARMAG) {
     Object obj;
     do {
       offset = obj.Extract(data, offset);
       if (offset == LLDB_INVALID_OFFSET)
         break;
-      size_t obj_idx = m_objects.size();
+      const uint32_t obj_idx = m_objects.size();
       m_objects.push_back(obj);
-      // Insert all of the C strings out of order for now...
-      m_object_name_to_index_map.Append(obj.ar_name, obj_idx);
+      // Debug maps look members up by name and modification time, once for
+      // every object file they refer to. The first member wins if several
+      // share a name.
+      const char *name = obj.ar_name.GetCString();
+      m_object_index_by_name.try_emplace(name, obj_idx);
+      m_object_index_by_name_and_time.try_emplace(
+          std::make_pair(name, uint64_t(obj.modification_time)), obj_idx);
       offset += obj.file_size;
       obj.Clear();
     } while (data.ValidOffset(offset));
-
-    // Now sort all of the object name pointers
-    m_object_name_to_index_map.Sort();
   }
   return m_objects.size();
 }
@@ -170,27 +180,19 @@ size_t ObjectContainerBSDArchive::Archive::ParseObjects() {
 ObjectContainerBSDArchive::Object *
 ObjectContainerBSDArchive::Archive::FindObject(
     ConstString object_name, const llvm::sys::TimePoint<> &object_mod_time) {
-  const ObjectNameToIndexMap::Entry *match =
-      m_object_name_to_index_map.FindFirstValueForName(object_name);
-  if (!match)
-    return nullptr;
-  if (object_mod_time == llvm::sys::TimePoint<>())
-    return &m_objects[match->value];
-
-  const uint64_t object_modification_date = llvm::sys::toTimeT(object_mod_time);
-  if (m_objects[match->value].modification_time == object_modification_date)
-    return &m_objects[match->value];
-
-  const ObjectNameToIndexMap::Entry *next_match =
-      m_object_name_to_index_map.FindNextValueForName(match);
-  while (next_match) {
-    if (m_objects[next_match->value].modification_time ==
-        object_modification_date)
-      return &m_objects[next_match->value];
-    next_match = m_object_name_to_index_map.FindNextValueForName(next_match);
+  if (object_mod_time == llvm::sys::TimePoint<>()) {
+    auto pos = m_object_index_by_name.find(object_name.GetCString());
+    if (pos == m_object_index_by_name.end())
+      return nullptr;
+    return &m_objects[pos->second];
   }
 
-  return nullptr;
+  const uint64_t object_modification_date = llvm::sys::toTimeT(object_mod_time);
+  auto pos = m_object_index_by_name_and_time.find(
+      std::make_pair(object_name.GetCString(), object_modification_date));
+  if (pos == m_object_index_by_name_and_time.end())
+    return nullptr;
+  return &m_objects[pos->second];
 }
 
 ObjectContainerBSDArchive::Archive::shared_ptr
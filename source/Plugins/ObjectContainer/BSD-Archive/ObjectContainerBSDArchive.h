@@ -9,12 +9,12 @@
 #ifndef liblldb_ObjectContainerBSDArchive_h_
 #define liblldb_ObjectContainerBSDArchive_h_
 
-#include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/Symbol/ObjectContainer.h"
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/FileSpec.h"
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/Chrono.h"
 
 #include <map>
@@ -157,13 +157,16 @@ protected:
     lldb_private::DataExtractor &GetData() { return m_data; }
 
   protected:
-    typedef lldb_private::UniqueCStringMap<uint32_t> ObjectNameToIndexMap;
     // Member Variables
     lldb_private::ArchSpec m_arch;
     llvm::sys::TimePoint<> m_modification_time;
     lldb::offset_t m_file_offset;
     std::vector<Object> m_objects;
-    ObjectNameToIndexMap m_object_name_to_index_map;
+    /// Index of the first member with each name in m_objects.
+    llvm::DenseMap<const char *, uint32_t> m_object_index_by_name;
+    /// Index of the first member with each name and modification time.
+    llvm::DenseMap<std::pair<const char *, uint64_t>, uint32_t>
+        m_object_index_by_name_and_time;
     lldb_private::DataExtractor m_data; ///< The data for this object container
                                         ///so we don't lose data if the .a files
                                         ///gets modified
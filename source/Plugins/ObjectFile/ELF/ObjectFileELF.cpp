@@ -18,6 +18,7 @@
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Host/FileSystem.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/DWARFCallFrameInfo.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Target/SectionLoadList.h"
@@ -37,6 +38,7 @@
 #include "llvm/Object/Decompressor.h"
 #include "llvm/Support/ARMBuildAttributes.h"
 #include "llvm/Support/JamCRC.h"
+#include "llvm/Support/LockFileManager.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/MipsABIFlags.h"
@@ -1766,6 +1768,9 @@ void ObjectFileELF::CreateSections(SectionList &unified_section_list) {
   if (m_sections_up)
     return;
 
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "ObjectFileELF::CreateSections (file = %s)",
+                     m_file.GetPath().c_str());
   m_sections_up = std::make_unique<SectionList>();
   VMAddressProvider regular_provider(GetType(), "PT_LOAD");
   VMAddressProvider tls_provider(GetType(), "PT_TLS");
@@ -2668,6 +2673,21 @@ Symtab *ObjectFileELF::GetSymtab() {
           section_list->FindSectionByType(eSectionTypeELFDynamicSymbols, true)
               .get();
     }
+    // Parsing the symbols of ARM and MIPS binaries also records the address
+    // classes of their code, which a cached symbol table doesn't restore.
+    const ArchSpec arch = GetArchitecture();
+    const bool use_symtab_cache =
+        symtab && arch.GetMachine() != llvm::Triple::arm &&
+        arch.GetMachine() != llvm::Triple::aarch64 && !arch.IsMIPS();
+    std::unique_ptr<llvm::LockFileManager> cache_lock;
+    if (use_symtab_cache) {
+      auto symtab_up = std::make_unique<Symtab>(symtab->GetObjectFile());
+      if (symtab_up->LoadFromCacheOrLock(cache_lock)) {
+        m_symtab_up = std::move(symtab_up);
+        return m_symtab_up.get();
+      }
+    }
+
     if (symtab) {
       m_symtab_up.reset(new Symtab(symtab->GetObjectFile()));
       symbol_id += ParseSymbolTable(m_symtab_up.get(), symbol_id, symtab);
@@ -2715,6 +2735,8 @@ Symtab *ObjectFileELF::GetSymtab() {
       m_symtab_up.reset(new Symtab(this));
 
     m_symtab_up->CalculateSymbolSizes();
+    if (use_symtab_cache)
+      m_symtab_up->SaveToCache();
   }
 
   return m_symtab_up.get();
@@ -2819,6 +2841,16 @@ bool ObjectFileELF::IsStripped() {
   return false;
 }
 
+bool ObjectFileELF::HasCompleteSymtab() {
+  // Separate debug info files only contribute a .symtab, which a file that
+  // wasn't stripped already has. The symbols synthesized from .dynamic and
+  // .eh_frame always come from this file.
+  ParseSectionHeaders();
+  return llvm::any_of(m_section_headers, [](const ELFSectionHeaderInfo &H) {
+    return H.sh_type == SHT_SYMTAB;
+  });
+}
+
 //===----------------------------------------------------------------------===//
 // Dump
 //
@@ -3219,35 +3251,104 @@ size_t ObjectFileELF::ReadSectionData(Section *section,
                          section->Get(), section->GetName().GetStringRef()))
     return result;
 
-  auto Decompressor = llvm::object::Decompressor::create(
-      section->GetName().GetStringRef(),
-      {reinterpret_cast<const char *>(section_data.GetDataStart()),
-       size_t(section_data.GetByteSize())},
-      GetByteOrder() == eByteOrderLittle, GetAddressByteSize() == 8);
-  if (!Decompressor) {
-    GetModule()->ReportWarning(
-        "Unable to initialize decompressor for section '%s': %s",
-        section->GetName().GetCString(),
-        llvm::toString(Decompressor.takeError()).c_str());
+  DataBufferSP buffer_sp = GetDecompressedSectionData(section);
+  if (!buffer_sp) {
     section_data.Clear();
     return 0;
   }
 
+  section_data.SetData(buffer_sp);
+  return buffer_sp->GetByteSize();
+}
+
+llvm::Expected<DataBufferSP>
+ObjectFileELF::DecompressSectionData(Section *section) {
+  DataExtractor compressed_data;
+  if (ObjectFile::ReadSectionData(section, compressed_data) == 0)
+    return llvm::make_error<llvm::StringError>(
+        "unable to read section data", llvm::inconvertibleErrorCode());
+
+  auto Decompressor = llvm::object::Decompressor::create(
+      section->GetName().GetStringRef(),
+      {reinterpret_cast<const char *>(compressed_data.GetDataStart()),
+       size_t(compressed_data.GetByteSize())},
+      GetByteOrder() == eByteOrderLittle, GetAddressByteSize() == 8);
+  if (!Decompressor)
+    return llvm::make_error<llvm::StringError>(
+        "Unable to initialize decompressor: " +
+            llvm::toString(Decompressor.takeError()),
+        llvm::inconvertibleErrorCode());
+
   auto buffer_sp =
       std::make_shared<DataBufferHeap>(Decompressor->getDecompressedSize(), 0);
   if (auto error = Decompressor->decompress(
           {reinterpret_cast<char *>(buffer_sp->GetBytes()),
-           size_t(buffer_sp->GetByteSize())})) {
-    GetModule()->ReportWarning(
-        "Decompression of section '%s' failed: %s",
-        section->GetName().GetCString(),
-        llvm::toString(std::move(error)).c_str());
-    section_data.Clear();
-    return 0;
+           size_t(buffer_sp->GetByteSize())}))
+    return llvm::make_error<llvm::StringError>(
+        "Decompression failed: " + llvm::toString(std::move(error)),
+        llvm::inconvertibleErrorCode());
+  return buffer_sp;
+}
+
+DataBufferSP ObjectFileELF::GetDecompressedSectionData(Section *section) {
+  // Collect the sections before taking our lock, GetSectionList() locks the
+  // module.
+  std::vector<Section *> compressed_sections;
+  if (!m_did_decompress_sections) {
+    if (SectionList *section_list = GetSectionList()) {
+      for (const SectionSP &section_sp : *section_list) {
+        if (section_sp->GetObjectFile() == this &&
+            llvm::object::Decompressor::isCompressedELFSection(
+                section_sp->Get(), section_sp->GetName().GetStringRef()))
+          compressed_sections.push_back(section_sp.get());
+      }
+    }
   }
 
-  section_data.SetData(buffer_sp);
-  return buffer_sp->GetByteSize();
+  std::lock_guard<std::mutex> guard(m_decompressed_sections_mutex);
+  if (!m_did_decompress_sections) {
+    m_did_decompress_sections = true;
+    // The debug info reader is about to ask for all of these one after the
+    // other, and inflating them dominates loading -gz debug info. Inflate
+    // them all at once, in parallel.
+    static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+    Timer scoped_timer(func_cat,
+                       "ObjectFileELF::GetDecompressedSectionData (%zu sections)",
+                       compressed_sections.size());
+    std::vector<DataBufferSP> buffers(compressed_sections.size());
+    std::vector<std::string> errors(compressed_sections.size());
+    TaskMapOverInt(0, compressed_sections.size(), [&](size_t i) {
+      llvm::Expected<DataBufferSP> buffer_or_err =
+          DecompressSectionData(compressed_sections[i]);
+      if (buffer_or_err)
+        buffers[i] = std::move(*buffer_or_err);
+      else
+        errors[i] = llvm::toString(buffer_or_err.takeError());
+    });
+    for (size_t i = 0; i < compressed_sections.size(); ++i) {
+      if (buffers[i])
+        m_decompressed_sections[compressed_sections[i]] = buffers[i];
+      else
+        GetModule()->ReportWarning(
+            "Unable to decompress section '%s': %s",
+            compressed_sections[i]->GetName().GetCString(), errors[i].c_str());
+    }
+  }
+
+  auto pos = m_decompressed_sections.find(section);
+  if (pos != m_decompressed_sections.end())
+    return pos->second;
+
+  // A section that wasn't in our section list, decompress it on its own.
+  llvm::Expected<DataBufferSP> buffer_or_err = DecompressSectionData(section);
+  if (!buffer_or_err) {
+    GetModule()->ReportWarning(
+        "Unable to decompress section '%s': %s", section->GetName().GetCString(),
+        llvm::toString(buffer_or_err.takeError()).c_str());
+    return DataBufferSP();
+  }
+  m_decompressed_sections[section] = *buffer_or_err;
+  return *buffer_or_err;
 }
 
 llvm::ArrayRef<ELFProgramHeader> ObjectFileELF::ProgramHeaders() {
@@ -11,6 +11,8 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 #include "lldb/Symbol/ObjectFile.h"
@@ -18,6 +20,8 @@
 #include "lldb/Utility/FileSpec.h"
 #include "lldb/Utility/UUID.h"
 #include "lldb/lldb-private.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/Error.h"
 
 #include "ELFHeader.h"
 
@@ -114,6 +118,8 @@ public:
 
   bool IsStripped() override;
 
+  bool HasCompleteSymtab() override;
+
   void CreateSections(lldb_private::SectionList &unified_section_list) override;
 
   void Dump(lldb_private::Stream *s) override;
@@ -221,6 +227,13 @@ private:
   /// The address class for each symbol in the elf file
   FileAddressToAddressClassMap m_address_class_map;
 
+  /// Inflated contents of the SHF_COMPRESSED sections, see
+  /// GetDecompressedSectionData().
+  llvm::DenseMap<const lldb_private::Section *, lldb::DataBufferSP>
+      m_decompressed_sections;
+  std::atomic<bool> m_did_decompress_sections{false};
+  std::mutex m_decompressed_sections_mutex;
+
   /// Returns the index of the given section header.
   size_t SectionIndex(const SectionHeaderCollIter &I);
 
@@ -249,6 +262,14 @@ private:
 
   lldb::SectionType GetSectionType(const ELFSectionHeaderInfo &H) const;
 
+  /// Returns the inflated contents of the compressed \a section. The first
+  /// call decompresses all compressed sections of this file in parallel and
+  /// keeps the results, so each section is only inflated once.
+  lldb::DataBufferSP GetDecompressedSectionData(lldb_private::Section *section);
+
+  llvm::Expected<lldb::DataBufferSP>
+  DecompressSectionData(lldb_private::Section *section);
+
   static void ParseARMAttributes(lldb_private::DataExtractor &data,
                                  uint64_t length,
                                  lldb_private::ArchSpec &arch_spec);
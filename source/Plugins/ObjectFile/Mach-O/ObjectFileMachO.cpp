@@ -44,6 +44,8 @@
 
 #include "lldb/Host/SafeMachO.h"
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/Support/MemoryBuffer.h"
 
 #include "ObjectFileMachO.h"
@@ -61,6 +63,7 @@
 #endif
 
 #include <memory>
+#include <unordered_set>
 
 #define THUMB_ADDRESS_BIT_MASK 0xfffffffffffffffeull
 using namespace lldb;
@@ -1984,10 +1987,13 @@ static LazyBool CalculateNameIsSwift(std::vector<llvm::StringRef> &nameSlices) {
   return eLazyBoolCalculate;
 }
 
+// Addresses can be any 64-bit value, including the DenseMap sentinel keys.
+typedef std::unordered_set<lldb::addr_t> AddressSet;
+
 static bool ParseTrieEntries(DataExtractor &data, lldb::offset_t offset,
                              const bool is_arm, const LazyBool symbol_is_swift,
                              std::vector<llvm::StringRef> &nameSlices,
-                             std::set<lldb::addr_t> &resolver_addresses,
+                             AddressSet &resolver_addresses,
                              std::vector<TrieEntryWithOffset> &output) {
   if (!data.ValidOffset(offset))
     return true;
@@ -2615,8 +2621,8 @@ size_t ObjectFileMachO::ParseSymtab() {
   std::vector<uint32_t> N_BRAC_indexes;
   std::vector<uint32_t> N_COMM_indexes;
   typedef std::multimap<uint64_t, uint32_t> ValueToSymbolIndexMap;
-  typedef std::map<uint32_t, uint32_t> NListIndexToSymbolIndexMap;
-  typedef std::map<const char *, uint32_t> ConstNameToSymbolIndexMap;
+  typedef llvm::DenseMap<uint32_t, uint32_t> NListIndexToSymbolIndexMap;
+  typedef llvm::DenseMap<const char *, uint32_t> ConstNameToSymbolIndexMap;
   ValueToSymbolIndexMap N_FUN_addr_to_sym_idx;
   ValueToSymbolIndexMap N_STSYM_addr_to_sym_idx;
   ConstNameToSymbolIndexMap N_GSYM_name_to_sym_idx;
@@ -2633,8 +2639,8 @@ size_t ObjectFileMachO::ParseSymtab() {
   uint32_t unmapped_local_symbols_found = 0;
 
   std::vector<TrieEntryWithOffset> trie_entries;
-  std::set<lldb::addr_t> resolver_addresses;
-  std::set<lldb::addr_t> symbol_file_addresses;
+  AddressSet resolver_addresses;
+  AddressSet symbol_file_addresses;
 
   if (dyld_trie_data.GetByteSize() > 0) {
     std::vector<llvm::StringRef> nameSlices;
@@ -2655,7 +2661,8 @@ size_t ObjectFileMachO::ParseSymtab() {
     }
   }
 
-  typedef std::set<ConstString> IndirectSymbols;
+  // Keyed by the ConstString pool pointer.
+  typedef llvm::DenseSet<const char *> IndirectSymbols;
   IndirectSymbols indirect_symbol_names;
 
 #if defined(__APPLE__) &&                                                      \
@@ -2827,8 +2834,9 @@ size_t ObjectFileMachO::ParseSymtab() {
 
             offset = 0;
 
-            typedef std::map<ConstString, uint16_t> UndefinedNameToDescMap;
-            typedef std::map<uint32_t, ConstString> SymbolIndexToName;
+            typedef llvm::DenseMap<const char *, uint16_t>
+                UndefinedNameToDescMap;
+            typedef llvm::DenseMap<uint32_t, ConstString> SymbolIndexToName;
             UndefinedNameToDescMap undefined_name_to_desc;
             SymbolIndexToName reexport_shlib_needs_fixup;
 
@@ -3317,8 +3325,10 @@ size_t ObjectFileMachO::ParseSymtab() {
                           sym[sym_idx].SetReExportedSymbolName(reexport_name);
                           set_value = false;
                           reexport_shlib_needs_fixup[sym_idx] = reexport_name;
-                          indirect_symbol_names.insert(ConstString(
-                              symbol_name + ((symbol_name[0] == '_') ? 1 : 0)));
+                          indirect_symbol_names.insert(
+                              ConstString(symbol_name +
+                                          ((symbol_name[0] == '_') ? 1 : 0))
+                                  .GetCString());
                         } else
                           type = eSymbolTypeUndefined;
                       } break;
@@ -3327,7 +3337,8 @@ size_t ObjectFileMachO::ParseSymtab() {
                         if (symbol_name && symbol_name[0]) {
                           ConstString undefined_name(
                               symbol_name + ((symbol_name[0] == '_') ? 1 : 0));
-                          undefined_name_to_desc[undefined_name] = nlist.n_desc;
+                          undefined_name_to_desc[undefined_name.GetCString()] =
+                              nlist.n_desc;
                         }
                       // Fall through
                       case N_PBUD:
@@ -3774,7 +3785,8 @@ size_t ObjectFileMachO::ParseSymtab() {
             }
 
             for (const auto &pos : reexport_shlib_needs_fixup) {
-              const auto undef_pos = undefined_name_to_desc.find(pos.second);
+              const auto undef_pos =
+                  undefined_name_to_desc.find(pos.second.GetCString());
               if (undef_pos != undefined_name_to_desc.end()) {
                 const uint8_t dylib_ordinal =
                     llvm::MachO::GET_LIBRARY_ORDINAL(undef_pos->second);
@@ -3802,6 +3814,7 @@ size_t ObjectFileMachO::ParseSymtab() {
           symtab->Resize(symtab_load_command.nsyms + m_dysymtab.nindirectsyms);
       num_syms = symtab->GetNumSymbols();
     }
+    symbol_file_addresses.reserve(symtab_load_command.nsyms);
 
     if (unmapped_local_symbols_found) {
       assert(m_dysymtab.ilocalsym == 0);
@@ -3811,8 +3824,8 @@ size_t ObjectFileMachO::ParseSymtab() {
       nlist_idx = 0;
     }
 
-    typedef std::map<ConstString, uint16_t> UndefinedNameToDescMap;
-    typedef std::map<uint32_t, ConstString> SymbolIndexToName;
+    typedef llvm::DenseMap<const char *, uint16_t> UndefinedNameToDescMap;
+    typedef llvm::DenseMap<uint32_t, ConstString> SymbolIndexToName;
     UndefinedNameToDescMap undefined_name_to_desc;
     SymbolIndexToName reexport_shlib_needs_fixup;
 
@@ -4234,7 +4247,8 @@ size_t ObjectFileMachO::ParseSymtab() {
             set_value = false;
             reexport_shlib_needs_fixup[sym_idx] = reexport_name;
             indirect_symbol_names.insert(
-                ConstString(symbol_name + ((symbol_name[0] == '_') ? 1 : 0)));
+                ConstString(symbol_name + ((symbol_name[0] == '_') ? 1 : 0))
+                    .GetCString());
           } else
             type = eSymbolTypeUndefined;
         } break;
@@ -4243,7 +4257,8 @@ size_t ObjectFileMachO::ParseSymtab() {
           if (symbol_name && symbol_name[0]) {
             ConstString undefined_name(symbol_name +
                                        ((symbol_name[0] == '_') ? 1 : 0));
-            undefined_name_to_desc[undefined_name] = nlist.n_desc;
+            undefined_name_to_desc[undefined_name.GetCString()] =
+                nlist.n_desc;
           }
           LLVM_FALLTHROUGH;
 
@@ -4647,7 +4662,8 @@ size_t ObjectFileMachO::ParseSymtab() {
     }
 
     for (const auto &pos : reexport_shlib_needs_fixup) {
-      const auto undef_pos = undefined_name_to_desc.find(pos.second);
+      const auto undef_pos =
+          undefined_name_to_desc.find(pos.second.GetCString());
       if (undef_pos != undefined_name_to_desc.end()) {
         const uint8_t dylib_ordinal =
             llvm::MachO::GET_LIBRARY_ORDINAL(undef_pos->second);
@@ -4883,7 +4899,7 @@ size_t ObjectFileMachO::ParseSymtab() {
       if (e.entry.import_name) {
         // Only add indirect symbols from the Trie entries if we didn't have
         // a N_INDR nlist entry for this already
-        if (indirect_symbol_names.find(e.entry.name) ==
+        if (indirect_symbol_names.find(e.entry.name.GetCString()) ==
             indirect_symbol_names.end()) {
           // Make a synthetic symbol to describe re-exported symbol.
           if (sym_idx >= num_syms)
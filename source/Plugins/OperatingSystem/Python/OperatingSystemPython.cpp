@@ -193,13 +193,14 @@ bool OperatingSystemPython::UpdateThreadList(ThreadList &old_thread_list,
       LLDB_LOGF(log, "threads_list = %s", strm.GetData());
     }
 
+    const ThreadIDMap old_threads = MapThreadsByID(old_thread_list);
     const uint32_t num_threads = threads_list->GetSize();
     for (uint32_t i = 0; i < num_threads; ++i) {
       StructuredData::ObjectSP thread_dict_obj =
           threads_list->GetItemAtIndex(i);
       if (auto thread_dict = thread_dict_obj->GetAsDictionary()) {
         ThreadSP thread_sp(CreateThreadFromThreadInfo(
-            *thread_dict, core_thread_list, old_thread_list, core_used_map,
+            *thread_dict, core_thread_list, old_threads, core_used_map,
             nullptr));
         if (thread_sp)
           new_thread_list.AddThread(thread_sp);
@@ -222,9 +223,21 @@ bool OperatingSystemPython::UpdateThreadList(ThreadList &old_thread_list,
   return new_thread_list.GetSize(false) > 0;
 }
 
+OperatingSystemPython::ThreadIDMap
+OperatingSystemPython::MapThreadsByID(ThreadList &thread_list) {
+  ThreadIDMap threads;
+  const uint32_t num_threads = thread_list.GetSize(false);
+  threads.reserve(num_threads);
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    ThreadSP thread_sp = thread_list.GetThreadAtIndex(i, false);
+    threads.emplace(thread_sp->GetID(), thread_sp);
+  }
+  return threads;
+}
+
 ThreadSP OperatingSystemPython::CreateThreadFromThreadInfo(
     StructuredData::Dictionary &thread_dict, ThreadList &core_thread_list,
-    ThreadList &old_thread_list, std::vector<bool> &core_used_map,
+    const ThreadIDMap &old_threads, std::vector<bool> &core_used_map,
     bool *did_create_ptr) {
   ThreadSP thread_sp;
   tid_t tid = LLDB_INVALID_THREAD_ID;
@@ -243,7 +256,9 @@ ThreadSP OperatingSystemPython::CreateThreadFromThreadInfo(
   thread_dict.GetValueForKeyAsString("queue", queue);
 
   // See if a thread already exists for "tid"
-  thread_sp = old_thread_list.FindThreadByID(tid, false);
+  auto old_pos = old_threads.find(tid);
+  if (old_pos != old_threads.end())
+    thread_sp = old_pos->second;
   if (thread_sp) {
     // A thread already does exist for "tid", make sure it was an operating
     // system
@@ -407,7 +422,8 @@ lldb::ThreadSP OperatingSystemPython::CreateThread(lldb::tid_t tid,
       bool did_create = false;
       ThreadSP thread_sp(
           CreateThreadFromThreadInfo(*thread_info_dict, core_threads,
-                                     thread_list, core_used_map, &did_create));
+                                     MapThreadsByID(thread_list),
+                                     core_used_map, &did_create));
       if (did_create)
         thread_list.AddThread(thread_sp);
       return thread_sp;
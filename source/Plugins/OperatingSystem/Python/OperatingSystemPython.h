@@ -14,6 +14,8 @@
 #include "lldb/Target/OperatingSystem.h"
 #include "lldb/Utility/StructuredData.h"
 
+#include <unordered_map>
+
 class DynamicRegisterInfo;
 
 namespace lldb_private {
@@ -66,11 +68,18 @@ protected:
     return m_python_object_sp && m_python_object_sp->IsValid();
   }
 
+  // Plug-ins can describe tens of thousands of threads, so the existing
+  // threads are looked up by ID in a map instead of searching the old thread
+  // list for each one.
+  typedef std::unordered_map<lldb::tid_t, lldb::ThreadSP> ThreadIDMap;
+
+  static ThreadIDMap MapThreadsByID(lldb_private::ThreadList &thread_list);
+
   lldb::ThreadSP CreateThreadFromThreadInfo(
       lldb_private::StructuredData::Dictionary &thread_dict,
       lldb_private::ThreadList &core_thread_list,
-      lldb_private::ThreadList &old_thread_list,
-      std::vector<bool> &core_used_map, bool *did_create_ptr);
+      const ThreadIDMap &old_threads, std::vector<bool> &core_used_map,
+      bool *did_create_ptr);
 
   DynamicRegisterInfo *GetDynamicRegisterInfo();
 
@@ -194,6 +194,7 @@ Status PlatformAndroid::GetFile(const FileSpec &source,
     source_spec = GetRemoteWorkingDirectory().CopyByAppendingPathComponent(
         source_spec.GetCString(false));
 
+  std::lock_guard<std::mutex> guard(m_adb_sync_svc_mutex);
   Status error;
   auto sync_service = GetSyncService(error);
   if (error.Fail())
@@ -238,6 +239,7 @@ Status PlatformAndroid::PutFile(const FileSpec &source,
         destination_spec.GetCString(false));
 
   // TODO: Set correct uid and gid on remote file.
+  std::lock_guard<std::mutex> guard(m_adb_sync_svc_mutex);
   Status error;
   auto sync_service = GetSyncService(error);
   if (error.Fail())
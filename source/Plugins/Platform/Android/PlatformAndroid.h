@@ -10,6 +10,7 @@
 #define liblldb_PlatformAndroid_h_
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "Plugins/Platform/Linux/PlatformLinux.h"
@@ -73,6 +74,10 @@ protected:
 private:
   AdbClient::SyncService *GetSyncService(Status &error);
 
+  /// The sync service is a single connection, transfers through it can't
+  /// overlap, e.g. when Platform::PrefetchSharedModules downloads modules in
+  /// parallel.
+  std::mutex m_adb_sync_svc_mutex;
   std::unique_ptr<AdbClient::SyncService> m_adb_sync_svc;
   std::string m_device_id;
   uint32_t m_sdk_version;
@@ -76,10 +76,14 @@ FileSpecList PlatformDarwin::LocateExecutableScriptingResources(
         ObjectFile *objfile = symfile->GetObjectFile();
         if (objfile) {
           FileSpec symfile_spec(objfile->GetFileSpec());
+          // Checking the names below starts the script interpreter, so first
+          // make sure the dSYM has any scripts at all.
           if (symfile_spec &&
               strcasestr(symfile_spec.GetPath().c_str(),
                          ".dSYM/Contents/Resources/DWARF") != nullptr &&
-              FileSystem::Instance().Exists(symfile_spec)) {
+              FileSystem::Instance().Exists(symfile_spec) &&
+              FileSystem::Instance().IsDirectory(
+                  symfile_spec.GetDirectory().GetStringRef() + "/../Python")) {
             while (module_spec.GetFilename()) {
               std::string module_basename(
                   module_spec.GetFilename().GetCString());
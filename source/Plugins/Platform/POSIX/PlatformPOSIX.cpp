@@ -342,6 +342,10 @@ lldb_private::Status PlatformPOSIX::GetFile(
       // If we are here, rsync has failed - let's try the slow way before
       // giving up
     }
+    // The remote platform may know a faster way to transfer the file than
+    // reading it block by block.
+    if (m_remote_platform_sp->GetFile(source, destination).Success())
+      return Status();
     // open src and dst
     // read/write, read/write, read/write, ...
     // close src
@@ -371,7 +375,8 @@ lldb_private::Status PlatformPOSIX::GetFile(
     }
 
     if (error.Success()) {
-      lldb::DataBufferSP buffer_sp(new DataBufferHeap(1024, 0));
+      // Every read is a round trip to the remote side, so read large blocks.
+      lldb::DataBufferSP buffer_sp(new DataBufferHeap(128 * 1024, 0));
       uint64_t offset = 0;
       error.Clear();
       while (error.Success()) {
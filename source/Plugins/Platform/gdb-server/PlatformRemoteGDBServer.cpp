@@ -17,6 +17,7 @@
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Host/ConnectionFileDescriptor.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/HostInfo.h"
 #include "lldb/Host/PosixApi.h"
@@ -655,6 +656,59 @@ uint64_t PlatformRemoteGDBServer::WriteFile(lldb::user_id_t fd, uint64_t offset,
   return m_gdb_client.WriteFile(fd, offset, src, src_len, error);
 }
 
+Status PlatformRemoteGDBServer::GetFile(const FileSpec &source,
+                                        const FileSpec &destination) {
+  // Asking for the packet size sends qSupported, which turns on the
+  // compression of the replies if the platform offers one.
+  m_gdb_client.GetRemoteMaxPacketSize();
+
+  Status error;
+  lldb::user_id_t fd_src = m_gdb_client.OpenFile(
+      source, File::eOpenOptionRead, lldb::eFilePermissionsFileDefault, error);
+  if (fd_src == UINT64_MAX) {
+    if (error.Success())
+      error.SetErrorString("unable to open source file");
+    return error;
+  }
+
+  uint32_t permissions = 0;
+  m_gdb_client.GetFilePermissions(source, permissions);
+  if (permissions == 0)
+    permissions = lldb::eFilePermissionsFileDefault;
+
+  File dst_file;
+  error = FileSystem::Instance().Open(dst_file, destination,
+                                      File::eOpenOptionCanCreate |
+                                          File::eOpenOptionWrite |
+                                          File::eOpenOptionTruncate,
+                                      permissions);
+  if (error.Success()) {
+    // Large reads keep the number of packets down, and the client keeps
+    // several of them in flight at once.
+    const uint64_t chunk_size = 1024 * 1024;
+    error = m_gdb_client.ReadFileInChunks(
+        fd_src, chunk_size, [&dst_file](llvm::StringRef data) {
+          size_t bytes_written = data.size();
+          Status write_error = dst_file.Write(data.data(), bytes_written);
+          if (write_error.Success() && bytes_written != data.size())
+            write_error.SetErrorString("unable to write to destination file");
+          return write_error;
+        });
+  }
+
+  // Ignore the close error of src.
+  Status close_error;
+  m_gdb_client.CloseFile(fd_src, close_error);
+
+  Log *log = GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PLATFORM);
+  LLDB_LOGF(log,
+            "PlatformRemoteGDBServer::GetFile(source='%s', "
+            "destination='%s') error = %u (%s)",
+            source.GetCString(), destination.GetCString(), error.GetError(),
+            error.AsCString());
+  return error;
+}
+
 Status PlatformRemoteGDBServer::PutFile(const FileSpec &source,
                                         const FileSpec &destination,
                                         uint32_t uid, uint32_t gid) {
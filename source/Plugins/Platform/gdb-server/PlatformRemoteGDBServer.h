@@ -126,6 +126,8 @@ public:
 
   lldb::user_id_t GetFileSize(const FileSpec &file_spec) override;
 
+  Status GetFile(const FileSpec &source, const FileSpec &destination) override;
+
   Status PutFile(const FileSpec &source, const FileSpec &destination,
                  uint32_t uid = UINT32_MAX, uint32_t gid = UINT32_MAX) override;
 
@@ -13,6 +13,7 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <fstream>
 #include <mutex>
 #include <sstream>
@@ -40,6 +41,7 @@
 #include "lldb/Utility/StringExtractor.h"
 #include "llvm/Support/Errno.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/Threading.h"
 
 #include "NativeThreadLinux.h"
@@ -48,6 +50,7 @@
 #include "Procfs.h"
 
 #include <linux/unistd.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/syscall.h>
 #include <sys/types.h>
@@ -313,6 +316,11 @@ NativeProcessLinux::NativeProcessLinux(::pid_t pid, int terminal_fd,
   SigchldHandler();
 }
 
+NativeProcessLinux::~NativeProcessLinux() {
+  // Snapshots would run once we are gone.
+  KillSnapshots();
+}
+
 llvm::Expected<std::vector<::pid_t>> NativeProcessLinux::Attach(::pid_t pid) {
   Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
 
@@ -377,8 +385,9 @@ llvm::Expected<std::vector<::pid_t>> NativeProcessLinux::Attach(::pid_t pid) {
   return std::move(tids);
 }
 
-Status NativeProcessLinux::SetDefaultPtraceOpts(lldb::pid_t pid) {
-  long ptrace_opts = 0;
+Status NativeProcessLinux::SetDefaultPtraceOpts(lldb::pid_t pid,
+                                                long extra_opts) {
+  long ptrace_opts = extra_opts;
 
   // Have the child raise an event on exit.  This is used to keep the child in
   // limbo until it is destroyed.
@@ -594,13 +603,23 @@ void NativeProcessLinux::MonitorSIGTRAP(const siginfo_t &info,
 
     // Exec clears any pending notifications.
     m_pending_notification_tid = LLDB_INVALID_THREAD_ID;
+    m_threads_pending_stop.clear();
+
+    // The pages watched and the system call page went with the old image.
+    m_page_watchpoints.clear();
+    m_watched_pages.clear();
+    m_threads_stepping_over_page_access.clear();
+    m_syscall_page = LLDB_INVALID_ADDRESS;
 
     // Remove all but the main thread here.  Linux fork creates a new process
     // which only copies the main thread.
     LLDB_LOG(log, "exec received, stop tracking all but main thread");
 
     llvm::erase_if(m_threads, [&](std::unique_ptr<NativeThreadProtocol> &t) {
-      return t->GetID() != GetID();
+      if (t->GetID() == GetID())
+        return false;
+      m_threads_by_tid.erase(t->GetID());
+      return true;
     });
     assert(m_threads.size() == 1);
     auto *main_thread = static_cast<NativeThreadLinux *>(m_threads[0].get());
@@ -735,6 +754,15 @@ void NativeProcessLinux::MonitorTrace(NativeThreadLinux &thread) {
   Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
   LLDB_LOG(log, "received trace event, pid = {0}", thread.GetID());
 
+  if (m_threads_stepping_over_breakpoint.count(thread.GetID())) {
+    FinishBreakpointStepOver(thread);
+    return;
+  }
+  if (m_threads_stepping_over_page_access.count(thread.GetID())) {
+    FinishPageAccessStepOver(thread);
+    return;
+  }
+
   // This thread is currently stopped.
   thread.SetStoppedByTrace();
 
@@ -746,17 +774,207 @@ void NativeProcessLinux::MonitorBreakpoint(NativeThreadLinux &thread) {
       GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_BREAKPOINTS));
   LLDB_LOG(log, "received breakpoint event, pid = {0}", thread.GetID());
 
+  // A thread the client is stepping has to stop after the step, so its hits
+  // are always reported.
+  const bool was_stepping = thread.GetState() == eStateStepping;
+
   // Mark the thread as stopped at breakpoint.
   thread.SetStoppedByBreakpoint();
   FixupBreakpointPCAsNeeded(thread);
 
-  if (m_threads_stepping_with_breakpoint.find(thread.GetID()) !=
-      m_threads_stepping_with_breakpoint.end())
+  auto step_pos = m_threads_stepping_with_breakpoint.find(thread.GetID());
+  if (step_pos != m_threads_stepping_with_breakpoint.end() &&
+      m_threads_stepping_over_breakpoint.count(thread.GetID())) {
+    // Software single-stepping got the thread past a breakpoint.
+    Status error = RemoveBreakpoint(step_pos->second);
+    if (error.Fail())
+      LLDB_LOG(log, "pid = {0} remove stepping breakpoint: {1}",
+               thread.GetID(), error);
+    m_threads_stepping_with_breakpoint.erase(step_pos);
+    FinishBreakpointStepOver(thread);
+    return;
+  }
+
+  if (step_pos != m_threads_stepping_with_breakpoint.end())
     thread.SetStoppedByTrace();
+  else if (!was_stepping && StepOverConditionalBreakpoint(thread))
+    return;
+
+  StopRunningThreads(thread.GetID());
+}
+
+bool NativeProcessLinux::StepOverConditionalBreakpoint(
+    NativeThreadLinux &thread) {
+  const lldb::addr_t pc = thread.GetRegisterContext().GetPC();
+  auto it = m_software_breakpoints.find(pc);
+  if (it == m_software_breakpoints.end())
+    return false;
+
+  // Tracepoints record every hit, also the ones that get reported.
+  const bool trace_only = RecordTracepointHit(thread, pc);
+
+  // Stepping over the breakpoint takes the trap out of memory for a moment.
+  // That is only safe when no stop is pending and the step can be done
+  // without planting more breakpoints. Other threads running through the
+  // breakpoint while its trap is out will miss it.
+  if (m_pending_notification_tid != LLDB_INVALID_THREAD_ID ||
+      !SupportHardwareSingleStepping()) {
+    if (!trace_only)
+      return false;
+    // The process is stopping anyway. The thread steps over the trap when
+    // it is resumed.
+    thread.SetStoppedWithNoReason();
+    SignalIfAllThreadsStopped();
+    return true;
+  }
+
+  if (!trace_only && SoftwareBreakpointConditionsSayStop(thread, pc))
+    return false;
+
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  const auto &saved = it->second.saved_opcodes;
+  size_t bytes_written = 0;
+  Status error = WriteMemory(pc, saved.data(), saved.size(), bytes_written);
+  if (error.Fail() || bytes_written != saved.size()) {
+    LLDB_LOG(log, "failed to restore opcodes at {0:x}: {1}", pc, error);
+    return false;
+  }
+
+  m_threads_stepping_over_breakpoint[thread.GetID()] = {pc, false};
+  error = ResumeThread(thread, eStateStepping, LLDB_INVALID_SIGNAL_NUMBER);
+  if (error.Fail()) {
+    LLDB_LOG(log, "failed to step thread {0}: {1}", thread.GetID(), error);
+    ReinsertSteppedOverBreakpoint(thread.GetID());
+    thread.SetStoppedByBreakpoint();
+    return false;
+  }
+  return true;
+}
+
+bool NativeProcessLinux::StepOverBreakpointOnResume(
+    NativeThreadLinux &thread, const ResumeAction &action) {
+  const lldb::addr_t pc = thread.GetRegisterContext().GetPC();
+  auto it = m_software_breakpoints.find(pc);
+  if (it == m_software_breakpoints.end())
+    return false;
+
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  const auto &saved = it->second.saved_opcodes;
+  size_t bytes_written = 0;
+  Status error = WriteMemory(pc, saved.data(), saved.size(), bytes_written);
+  if (error.Fail() || bytes_written != saved.size()) {
+    LLDB_LOG(log, "failed to restore opcodes at {0:x}: {1}", pc, error);
+    return false;
+  }
+  m_threads_stepping_over_breakpoint[thread.GetID()] = {pc, true};
 
+  // A thread the client steps has its stepping breakpoint set up already.
+  if (!SupportHardwareSingleStepping() && action.state != eStateStepping)
+    error = SetupSoftwareSingleStepping(thread);
+  if (error.Success())
+    error = ResumeThread(thread, eStateStepping, action.signal);
+  if (error.Fail()) {
+    LLDB_LOG(log, "failed to step thread {0} over {1:x}: {2}", thread.GetID(),
+             pc, error);
+    ReinsertSteppedOverBreakpoint(thread.GetID());
+    return false;
+  }
+
+  m_deferred_resumes.push_back({action, true});
+  return true;
+}
+
+void NativeProcessLinux::ReinsertSteppedOverBreakpoint(lldb::tid_t tid) {
+  auto stepping = m_threads_stepping_over_breakpoint.find(tid);
+  if (stepping == m_threads_stepping_over_breakpoint.end())
+    return;
+  const lldb::addr_t addr = stepping->second.addr;
+  m_threads_stepping_over_breakpoint.erase(stepping);
+
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end())
+    return;
+  const auto &trap = it->second.breakpoint_opcodes;
+  size_t bytes_written = 0;
+  Status error = WriteMemory(addr, trap.data(), trap.size(), bytes_written);
+  if (error.Fail() || bytes_written != trap.size()) {
+    Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+    LLDB_LOG(log, "failed to reinsert breakpoint at {0:x}: {1}", addr, error);
+  }
+}
+
+void NativeProcessLinux::FinishBreakpointStepOver(NativeThreadLinux &thread) {
+  Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
+  const bool on_resume =
+      m_threads_stepping_over_breakpoint[thread.GetID()].on_resume;
+  ReinsertSteppedOverBreakpoint(thread.GetID());
+
+  if (m_pending_notification_tid != LLDB_INVALID_THREAD_ID) {
+    // Someone else stopped while we were stepping, and is waiting for us.
+    thread.SetStoppedWithNoReason();
+    SignalIfAllThreadsStopped();
+    return;
+  }
+
+  if (on_resume) {
+    // The thread goes on as the client asked, together with the threads that
+    // were held back for it.
+    thread.SetStoppedWithNoReason();
+    ResumeDeferredThreads();
+    return;
+  }
+
+  // The thread is past a breakpoint whose condition was false.
+  Status error =
+      ResumeThread(thread, eStateRunning, LLDB_INVALID_SIGNAL_NUMBER);
+  if (error.Success())
+    return;
+  LLDB_LOG(log, "failed to resume thread {0}: {1}", thread.GetID(), error);
+  thread.SetStoppedByTrace();
   StopRunningThreads(thread.GetID());
 }
 
+void NativeProcessLinux::ResumeDeferredThreads() {
+  for (const auto &stepping : m_threads_stepping_over_breakpoint) {
+    if (stepping.second.on_resume)
+      return; // Some threads are still stepping over breakpoints.
+  }
+
+  std::vector<DeferredResume> deferred;
+  deferred.swap(m_deferred_resumes);
+
+  // A thread the client asked to step made its step getting past the
+  // breakpoint, and one asked to run with a signal got the signal then.
+  std::vector<lldb::tid_t> stepped_tids;
+  for (const DeferredResume &resume : deferred) {
+    NativeThreadLinux *thread = GetThreadByID(resume.action.tid);
+    if (!thread)
+      continue;
+    if (resume.stepped_over && resume.action.state == eStateStepping) {
+      thread->SetStoppedByTrace();
+      stepped_tids.push_back(thread->GetID());
+      continue;
+    }
+    Status error = ResumeThread(*thread, resume.action.state,
+                                resume.stepped_over ? LLDB_INVALID_SIGNAL_NUMBER
+                                                    : resume.action.signal);
+    if (error.Fail()) {
+      Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_THREAD));
+      LLDB_LOG(log, "failed to resume thread {0}: {1}", thread->GetID(),
+               error);
+    }
+  }
+
+  if (stepped_tids.empty())
+    return;
+  if (!m_non_stop) {
+    StopRunningThreads(stepped_tids.front());
+    return;
+  }
+  for (lldb::tid_t tid : stepped_tids)
+    StopRunningThreads(tid);
+}
+
 void NativeProcessLinux::MonitorWatchpoint(NativeThreadLinux &thread,
                                            uint32_t wp_index) {
   Log *log(
@@ -817,7 +1035,12 @@ void NativeProcessLinux::MonitorSignal(const siginfo_t &info,
       // etc...). However, in the case of an asynchronous Interrupt(), this
       // *is* the real stop reason, so we leave the signal intact if this is
       // the thread that was chosen as the triggering thread.
-      if (m_pending_notification_tid != LLDB_INVALID_THREAD_ID) {
+      if (m_non_stop) {
+        // In non-stop mode only a stop request for this very thread sends
+        // it a SIGSTOP, and its stop is reported on its own.
+        thread.SetStoppedWithNoReason();
+        ReportThreadStop(thread);
+      } else if (m_pending_notification_tid != LLDB_INVALID_THREAD_ID) {
         if (m_pending_notification_tid == thread.GetID())
           thread.SetStoppedBySignal(SIGSTOP, &info);
         else
@@ -845,6 +1068,12 @@ void NativeProcessLinux::MonitorSignal(const siginfo_t &info,
     return;
   }
 
+  // Accesses to pages protected for page watchpoints that didn't hit one
+  // aren't stops.
+  if (signo == SIGSEGV && info.si_code == SEGV_ACCERR &&
+      StepOverPageAccess(thread, reinterpret_cast<lldb::addr_t>(info.si_addr)))
+    return;
+
   // Check if debugger should stop at this signal or just ignore it and resume
   // the inferior.
   if (m_signals_to_ignore.find(signo) != m_signals_to_ignore.end()) {
@@ -1053,6 +1282,24 @@ Status NativeProcessLinux::Resume(const ResumeActionList &resume_actions) {
     }
   }
 
+  // Threads resumed from one of our software breakpoints are stepped past it
+  // first, so the client does not have to. In all-stop mode everything else
+  // waits for them, as nothing would stop the other threads from running
+  // through the breakpoint while its trap is out.
+  bool stepping_over_breakpoint = false;
+  if (m_pending_notification_tid == LLDB_INVALID_THREAD_ID) {
+    for (const auto &thread : m_threads) {
+      const ResumeAction *const action =
+          resume_actions.GetActionForThread(thread->GetID(), true);
+      if (action == nullptr || StateIsRunningState(thread->GetState()) ||
+          (action->state != eStateRunning && action->state != eStateStepping))
+        continue;
+      if (StepOverBreakpointOnResume(static_cast<NativeThreadLinux &>(*thread),
+                                     *action))
+        stepping_over_breakpoint = true;
+    }
+  }
+
   for (const auto &thread : m_threads) {
     assert(thread && "thread list should not contain NULL threads");
 
@@ -1065,6 +1312,18 @@ Status NativeProcessLinux::Resume(const ResumeActionList &resume_actions) {
       continue;
     }
 
+    // In non-stop mode threads that are still running are left alone, and
+    // only they can be asked to stop.
+    if (m_non_stop && StateIsRunningState(thread->GetState()) !=
+                          (action->state == eStateStopped))
+      continue;
+
+    if (stepping_over_breakpoint && !m_non_stop) {
+      if (!m_threads_stepping_over_breakpoint.count(thread->GetID()))
+        m_deferred_resumes.push_back({*action, false});
+      continue;
+    }
+
     LLDB_LOG(log, "processing resume action state {0} for pid {1} tid {2}",
              action->state, GetID(), thread->GetID());
 
@@ -1078,8 +1337,14 @@ Status NativeProcessLinux::Resume(const ResumeActionList &resume_actions) {
       break;
     }
 
-    case eStateSuspended:
     case eStateStopped:
+      if (m_non_stop) {
+        static_cast<NativeThreadLinux &>(*thread).RequestStop();
+        break;
+      }
+      llvm_unreachable("Unexpected state");
+
+    case eStateSuspended:
       llvm_unreachable("Unexpected state");
 
     default:
@@ -1112,6 +1377,14 @@ Status NativeProcessLinux::Detach() {
   if (GetID() == LLDB_INVALID_PROCESS_ID)
     return error;
 
+  KillSnapshots();
+
+  // Give the pages page watchpoints took access from their protection back.
+  if (NativeThreadLinux *thread = GetStoppedThread()) {
+    for (const auto &watched : m_watched_pages)
+      ProtectPage(*thread, watched.first, watched.second.original_prot);
+  }
+
   for (const auto &thread : m_threads) {
     Status e = Detach(thread->GetID());
     if (e.Fail())
@@ -1209,6 +1482,8 @@ Status NativeProcessLinux::Kill() {
     break;
   }
 
+  KillSnapshots();
+
   if (kill(GetID(), SIGKILL) != 0) {
     error.SetErrorToErrno();
     return error;
@@ -1345,6 +1620,7 @@ void NativeProcessLinux::DoStopIDBumped(uint32_t newBumpId) {
   LLDB_LOG(log, "clearing {0} entries from memory region cache",
            m_mem_region_cache.size());
   m_mem_region_cache.clear();
+  m_vm_writev_failed_pages.clear();
 }
 
 Status NativeProcessLinux::AllocateMemory(size_t size, uint32_t permissions,
@@ -1408,6 +1684,604 @@ Status NativeProcessLinux::RemoveBreakpoint(lldb::addr_t addr, bool hardware) {
     return NativeProcessProtocol::RemoveBreakpoint(addr);
 }
 
+Status NativeProcessLinux::SetTracepoint(lldb::addr_t addr,
+                                         std::vector<uint32_t> registers) {
+  if (!SupportHardwareSingleStepping())
+    return Status("tracepoints need hardware single stepping");
+  return SetSoftwareTracepoint(addr, std::move(registers));
+}
+
+Status NativeProcessLinux::RemoveTracepoint(lldb::addr_t addr) {
+  return RemoveSoftwareTracepoint(addr);
+}
+
+Status NativeProcessLinux::SetWatchpoint(lldb::addr_t addr, size_t size,
+                                         uint32_t watch_flags, bool hardware) {
+  if (m_page_watchpoints.count(addr)) {
+    Status error = RemovePageWatchpoint(addr);
+    if (error.Fail())
+      return error;
+  }
+
+  Status error =
+      NativeProcessProtocol::SetWatchpoint(addr, size, watch_flags, hardware);
+  if (error.Success() || !SupportsPageWatchpoints())
+    return error;
+
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_WATCHPOINTS));
+  LLDB_LOG(log, "watching {0:x} with page protection: {1}", addr, error);
+  return SetPageWatchpoint(addr, size, watch_flags);
+}
+
+Status NativeProcessLinux::RemoveWatchpoint(lldb::addr_t addr) {
+  if (m_page_watchpoints.count(addr))
+    return RemovePageWatchpoint(addr);
+  return NativeProcessProtocol::RemoveWatchpoint(addr);
+}
+
+bool NativeProcessLinux::SupportsPageWatchpoints() const {
+#if defined(__x86_64__)
+  return m_arch.GetMachine() == llvm::Triple::x86_64;
+#else
+  return false;
+#endif
+}
+
+Status NativeProcessLinux::SetPageWatchpoint(lldb::addr_t addr, size_t size,
+                                             uint32_t watch_flags) {
+  if (size == 0)
+    return Status("cannot watch zero bytes");
+  NativeThreadLinux *thread = GetStoppedThread();
+  if (!thread)
+    return Status("page watchpoints need a stopped thread");
+  Status error = SetupSyscallPage(*thread);
+  if (error.Fail())
+    return error;
+
+  m_page_watchpoints[addr] = {addr, size, watch_flags};
+  error = UpdateWatchedPages(*thread, addr, size);
+  if (error.Fail()) {
+    m_page_watchpoints.erase(addr);
+    UpdateWatchedPages(*thread, addr, size);
+  }
+  return error;
+}
+
+Status NativeProcessLinux::RemovePageWatchpoint(lldb::addr_t addr) {
+  auto pos = m_page_watchpoints.find(addr);
+  if (pos == m_page_watchpoints.end())
+    return Status();
+  NativeThreadLinux *thread = GetStoppedThread();
+  if (!thread)
+    return Status("page watchpoints need a stopped thread");
+  const PageWatchpoint wp = pos->second;
+  m_page_watchpoints.erase(pos);
+  return UpdateWatchedPages(*thread, wp.addr, wp.size);
+}
+
+Status NativeProcessLinux::UpdateWatchedPages(NativeThreadLinux &thread,
+                                              lldb::addr_t addr, size_t size) {
+  const lldb::addr_t page_size = llvm::sys::Process::getPageSizeEstimate();
+  for (lldb::addr_t page = addr & ~(page_size - 1); page < addr + size;
+       page += page_size) {
+    auto pos = m_watched_pages.find(page);
+    if (pos == m_watched_pages.end()) {
+      MemoryRegionInfo region;
+      Status error = GetMemoryRegionInfo(page, region);
+      if (error.Fail())
+        return error;
+      if (region.GetMapped() != MemoryRegionInfo::eYes)
+        return Status("no memory is mapped at 0x%" PRIx64, page);
+      int prot = PROT_NONE;
+      if (region.GetReadable() == MemoryRegionInfo::eYes)
+        prot |= PROT_READ;
+      if (region.GetWritable() == MemoryRegionInfo::eYes)
+        prot |= PROT_WRITE;
+      if (region.GetExecutable() == MemoryRegionInfo::eYes)
+        prot |= PROT_EXEC;
+      pos = m_watched_pages.insert({page, {prot, prot, {}}}).first;
+    }
+
+    WatchedPage &watched = pos->second;
+    watched.watch_prot = watched.original_prot;
+    watched.watchpoints.clear();
+    for (const auto &entry : m_page_watchpoints) {
+      const PageWatchpoint &wp = entry.second;
+      if (wp.addr >= page + page_size || wp.addr + wp.size <= page)
+        continue;
+      // x86 faults on reads from pages that aren't readable, so read
+      // watchpoints take all data access away.
+      watched.watch_prot &=
+          (wp.watch_flags & 2) ? ~(PROT_READ | PROT_WRITE) : ~PROT_WRITE;
+      watched.watchpoints.push_back(wp.addr);
+    }
+
+    const bool unwatched = watched.watchpoints.empty();
+    Status error = ProtectPage(
+        thread, page, unwatched ? watched.original_prot : watched.watch_prot);
+    if (unwatched)
+      m_watched_pages.erase(pos);
+    if (error.Fail())
+      return error;
+  }
+  return Status();
+}
+
+Status NativeProcessLinux::ProtectPage(NativeThreadLinux &thread,
+                                       lldb::addr_t page, int prot) {
+  const uint64_t page_size = llvm::sys::Process::getPageSizeEstimate();
+  llvm::Expected<uint64_t> result = InferiorSyscall(
+      thread, m_syscall_page, SYS_mprotect, {page, page_size, uint64_t(prot)});
+  if (!result)
+    return Status(result.takeError());
+  // The region cache has the protection the pages had before.
+  m_mem_region_cache.clear();
+  if (int64_t(*result) < 0)
+    return Status(-int64_t(*result), eErrorTypePOSIX);
+  return Status();
+}
+
+Status NativeProcessLinux::SetupSyscallPage(NativeThreadLinux &thread) {
+  if (m_syscall_page != LLDB_INVALID_ADDRESS)
+    return Status();
+#if defined(__x86_64__)
+  // The mmap call runs from the thread's pc, which is only safe while no
+  // other thread can run through it.
+  for (const auto &other : m_threads) {
+    if (StateIsRunningState(other->GetState()))
+      return Status("the system call page is set up while the process is "
+                    "stopped");
+  }
+
+  static const uint8_t g_syscall_opcode[] = {0x0f, 0x05};
+  const lldb::addr_t pc = thread.GetRegisterContext().GetPC();
+  uint8_t saved_opcode[sizeof(g_syscall_opcode)];
+  size_t bytes_read = 0;
+  Status error = ReadMemory(pc, saved_opcode, sizeof(saved_opcode), bytes_read);
+  if (error.Fail())
+    return error;
+  if (bytes_read != sizeof(saved_opcode))
+    return Status("failed to read the code at 0x%" PRIx64, pc);
+
+  size_t bytes_written = 0;
+  error = WriteMemory(pc, g_syscall_opcode, sizeof(g_syscall_opcode),
+                      bytes_written);
+  if (error.Fail())
+    return error;
+  const uint64_t page_size = llvm::sys::Process::getPageSizeEstimate();
+  llvm::Expected<uint64_t> page =
+      InferiorSyscall(thread, pc, SYS_mmap,
+                      {0, page_size, PROT_READ | PROT_EXEC,
+                       MAP_PRIVATE | MAP_ANONYMOUS, uint64_t(-1), 0});
+  WriteMemory(pc, saved_opcode, sizeof(saved_opcode), bytes_written);
+  if (!page)
+    return Status(page.takeError());
+  if (int64_t(*page) < 0)
+    return Status(-int64_t(*page), eErrorTypePOSIX);
+
+  error = WriteMemory(*page, g_syscall_opcode, sizeof(g_syscall_opcode),
+                      bytes_written);
+  if (error.Fail())
+    return error;
+  m_syscall_page = *page;
+  return Status();
+#else
+  return Status("cannot run system calls in the inferior");
+#endif
+}
+
+llvm::Expected<uint64_t>
+NativeProcessLinux::InferiorSyscall(NativeThreadLinux &thread, lldb::addr_t pc,
+                                    long number,
+                                    llvm::ArrayRef<uint64_t> args) {
+  llvm::Expected<uint64_t> result =
+      InferiorSyscall(GetID(), thread.GetID(), pc, number, args);
+  thread.GetRegisterContext().InvalidateAllRegisters();
+  return result;
+}
+
+llvm::Expected<uint64_t>
+NativeProcessLinux::InferiorSyscall(::pid_t pid, ::pid_t tid, lldb::addr_t pc,
+                                    long number,
+                                    llvm::ArrayRef<uint64_t> args) {
+#if defined(__x86_64__)
+  struct user_regs_struct saved_regs;
+  Status error = PtraceWrapper(PTRACE_GETREGS, tid, nullptr, &saved_regs,
+                               sizeof(saved_regs));
+  if (error.Fail())
+    return error.ToError();
+
+  struct user_regs_struct regs = saved_regs;
+  regs.rip = pc;
+  regs.rax = number;
+  // Don't let the kernel restart a system call the thread is stopped in.
+  regs.orig_rax = -1;
+  unsigned long long *arg_regs[] = {&regs.rdi, &regs.rsi, &regs.rdx,
+                                    &regs.r10, &regs.r8,  &regs.r9};
+  assert(args.size() <= llvm::array_lengthof(arg_regs));
+  for (size_t i = 0; i < args.size(); ++i)
+    *arg_regs[i] = args[i];
+  error = PtraceWrapper(PTRACE_SETREGS, tid, nullptr, &regs, sizeof(regs));
+
+  // Step over the system call. Signals that stop the thread first are sent
+  // again once its registers are back.
+  int pending_signo = 0;
+  while (error.Success()) {
+    error = PtraceWrapper(PTRACE_SINGLESTEP, tid);
+    if (error.Fail())
+      break;
+    int status;
+    ::pid_t wait_pid =
+        llvm::sys::RetryAfterSignal(-1, ::waitpid, tid, &status, __WALL);
+    if (wait_pid == -1) {
+      error.SetErrorToErrno();
+      break;
+    }
+    if (!WIFSTOPPED(status))
+      return Status("thread %d exited in a system call", tid).ToError();
+    if (WSTOPSIG(status) == SIGTRAP) {
+      // The stops of ptrace events, like the one of a fork, come before the
+      // system call returns.
+      if (status >> 16)
+        continue;
+      error = PtraceWrapper(PTRACE_GETREGS, tid, nullptr, &regs, sizeof(regs));
+      break;
+    }
+    pending_signo = WSTOPSIG(status);
+  }
+
+  Status restore_error = PtraceWrapper(PTRACE_SETREGS, tid, nullptr,
+                                       &saved_regs, sizeof(saved_regs));
+  if (pending_signo)
+    ::syscall(SYS_tgkill, pid, tid, pending_signo);
+  if (error.Fail())
+    return error.ToError();
+  if (restore_error.Fail())
+    return restore_error.ToError();
+  return regs.rax;
+#else
+  return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                 "cannot run system calls in the inferior");
+#endif
+}
+
+bool NativeProcessLinux::StepOverPageAccess(NativeThreadLinux &thread,
+                                            lldb::addr_t fault_addr) {
+  const lldb::addr_t page =
+      fault_addr & ~(lldb::addr_t(llvm::sys::Process::getPageSizeEstimate()) -
+                     1);
+  auto pos = m_watched_pages.find(page);
+  if (pos == m_watched_pages.end())
+    return false;
+  const WatchedPage &watched = pos->second;
+
+  // A fault with the page's own protection is a real one.
+  if (m_threads_stepping_over_page_access.count(thread.GetID())) {
+    ReprotectSteppedOverPage(thread.GetID(), &thread);
+    return false;
+  }
+  if (watched.watch_prot == watched.original_prot)
+    return false;
+
+  SteppingOverPageAccess step;
+  step.page = page;
+  step.fault_addr = fault_addr;
+  step.wp_addr = LLDB_INVALID_ADDRESS;
+  step.was_stepping = thread.GetState() == eStateStepping;
+  for (lldb::addr_t wp_addr : watched.watchpoints) {
+    const PageWatchpoint &wp = m_page_watchpoints[wp_addr];
+    const bool watches_reads = wp.watch_flags & 2;
+    // Only writes fault on readable pages.
+    if (fault_addr >= wp.addr && fault_addr < wp.addr + wp.size &&
+        (watches_reads || (watched.watch_prot & PROT_READ))) {
+      step.wp_addr = wp.addr;
+      step.old_values.clear();
+      break;
+    }
+    if (watches_reads)
+      continue;
+    std::vector<uint8_t> value(wp.size);
+    size_t bytes_read = 0;
+    if (ReadMemory(wp.addr, value.data(), value.size(), bytes_read)
+            .Success() &&
+        bytes_read == value.size())
+      step.old_values.emplace_back(wp.addr, std::move(value));
+  }
+
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_WATCHPOINTS));
+  Status error = ProtectPage(thread, page, watched.original_prot);
+  if (error.Fail()) {
+    LLDB_LOG(log, "failed to unprotect page {0:x}: {1}", page, error);
+    return false;
+  }
+  m_threads_stepping_over_page_access[thread.GetID()] = std::move(step);
+  error = ResumeThread(thread, eStateStepping, LLDB_INVALID_SIGNAL_NUMBER);
+  if (error.Fail()) {
+    LLDB_LOG(log, "failed to step thread {0}: {1}", thread.GetID(), error);
+    ReprotectSteppedOverPage(thread.GetID(), &thread);
+    return false;
+  }
+  return true;
+}
+
+void NativeProcessLinux::ReprotectSteppedOverPage(lldb::tid_t tid,
+                                                  NativeThreadLinux *thread) {
+  auto stepping = m_threads_stepping_over_page_access.find(tid);
+  if (stepping == m_threads_stepping_over_page_access.end())
+    return;
+  const lldb::addr_t page = stepping->second.page;
+  m_threads_stepping_over_page_access.erase(stepping);
+
+  auto pos = m_watched_pages.find(page);
+  if (pos == m_watched_pages.end())
+    return;
+  if (!thread)
+    thread = GetStoppedThread();
+  Status error = thread ? ProtectPage(*thread, page, pos->second.watch_prot)
+                        : Status("no thread is stopped");
+  if (error.Fail()) {
+    Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_WATCHPOINTS));
+    LLDB_LOG(log, "failed to protect page {0:x} again: {1}", page, error);
+  }
+}
+
+void NativeProcessLinux::FinishPageAccessStepOver(NativeThreadLinux &thread) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_WATCHPOINTS));
+  const SteppingOverPageAccess step =
+      m_threads_stepping_over_page_access[thread.GetID()];
+  ReprotectSteppedOverPage(thread.GetID(), &thread);
+
+  lldb::addr_t wp_addr = step.wp_addr;
+  for (const auto &old_value : step.old_values) {
+    if (wp_addr != LLDB_INVALID_ADDRESS)
+      break;
+    std::vector<uint8_t> value(old_value.second.size());
+    size_t bytes_read = 0;
+    if (ReadMemory(old_value.first, value.data(), value.size(), bytes_read)
+            .Success() &&
+        bytes_read == value.size() && value != old_value.second)
+      wp_addr = old_value.first;
+  }
+
+  if (wp_addr != LLDB_INVALID_ADDRESS) {
+    LLDB_LOG(log, "thread {0} hit page watchpoint {1:x} accessing {2:x}",
+             thread.GetID(), wp_addr, step.fault_addr);
+    thread.SetStoppedByPageWatchpoint(wp_addr, step.fault_addr);
+    StopRunningThreads(thread.GetID());
+    return;
+  }
+
+  if (step.was_stepping) {
+    thread.SetStoppedByTrace();
+    StopRunningThreads(thread.GetID());
+    return;
+  }
+
+  if (m_pending_notification_tid != LLDB_INVALID_THREAD_ID) {
+    // Someone else stopped while we were stepping, and is waiting for us.
+    thread.SetStoppedWithNoReason();
+    SignalIfAllThreadsStopped();
+    return;
+  }
+
+  // The access didn't touch a watchpoint.
+  Status error =
+      ResumeThread(thread, eStateRunning, LLDB_INVALID_SIGNAL_NUMBER);
+  if (error.Success())
+    return;
+  LLDB_LOG(log, "failed to resume thread {0}: {1}", thread.GetID(), error);
+  thread.SetStoppedByTrace();
+  StopRunningThreads(thread.GetID());
+}
+
+NativeThreadLinux *NativeProcessLinux::GetStoppedThread() {
+  for (const auto &thread : m_threads) {
+    if (StateIsStoppedState(thread->GetState(), false))
+      return static_cast<NativeThreadLinux *>(thread.get());
+  }
+  return nullptr;
+}
+
+llvm::Expected<lldb::user_id_t> NativeProcessLinux::SaveSnapshot() {
+  Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
+
+  if (!StateIsStoppedState(GetState(), false))
+    return llvm::createStringError(
+        llvm::inconvertibleErrorCode(),
+        "snapshots are taken while the process is stopped");
+  if (!m_page_watchpoints.empty())
+    return llvm::createStringError(
+        llvm::inconvertibleErrorCode(),
+        "snapshots can't be taken while page watchpoints are set");
+
+  // Only the thread that forks is in the snapshot, so make it the one the
+  // user is looking at.
+  NativeThreadLinux *thread = GetThreadByID(GetCurrentThreadID());
+  if (!thread)
+    thread = GetStoppedThread();
+  if (!thread)
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "no thread to take a snapshot from");
+  Status error = SetupSyscallPage(*thread);
+  if (error.Fail())
+    return error.ToError();
+
+  error = WriteSoftwareBreakpointOpcodes(false);
+  if (error.Fail()) {
+    WriteSoftwareBreakpointOpcodes(true);
+    return error.ToError();
+  }
+  llvm::Expected<::pid_t> pid =
+      ForkStopped(GetID(), thread->GetID(), m_syscall_page);
+  thread->GetRegisterContext().InvalidateAllRegisters();
+  error = WriteSoftwareBreakpointOpcodes(true);
+  if (!pid)
+    return pid.takeError();
+  if (error.Fail()) {
+    KillAndReap(*pid, {});
+    return error.ToError();
+  }
+
+  LLDB_LOG(log, "pid {0} saved snapshot {1} of thread {2}", GetID(), *pid,
+           thread->GetID());
+  m_snapshots[*pid] = m_syscall_page;
+  return *pid;
+}
+
+Status NativeProcessLinux::RestoreSnapshot(lldb::user_id_t snapshot_id) {
+  Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
+
+  auto pos = m_snapshots.find(snapshot_id);
+  if (pos == m_snapshots.end())
+    return Status("no snapshot %" PRIu64, snapshot_id);
+  if (!StateIsStoppedState(GetState(), false))
+    return Status("snapshots are restored while the process is stopped");
+  if (!m_page_watchpoints.empty())
+    return Status("snapshots can't be restored while page watchpoints are set");
+
+  // Debug a fork of the snapshot, which keeps the snapshot as it is.
+  const ::pid_t snapshot_pid = pos->first;
+  llvm::Expected<::pid_t> pid =
+      ForkStopped(snapshot_pid, snapshot_pid, pos->second);
+  if (!pid)
+    return Status(pid.takeError());
+
+  std::vector<::pid_t> tids;
+  for (const auto &thread : m_threads)
+    tids.push_back(thread->GetID());
+  KillAndReap(GetID(), tids);
+  LLDB_LOG(log, "pid {0} replaced by pid {1} from snapshot {2}", GetID(), *pid,
+           snapshot_id);
+
+  m_pid = *pid;
+  m_syscall_page = pos->second;
+  m_pending_notification_tid = LLDB_INVALID_THREAD_ID;
+  m_threads_pending_stop.clear();
+  m_threads_stepping_over_breakpoint.clear();
+  m_deferred_resumes.clear();
+  m_threads_stepping_over_page_access.clear();
+  m_threads_by_tid.clear();
+  m_threads.clear();
+  m_mem_region_cache.clear();
+  m_vm_writev_failed_pages.clear();
+  m_processor_trace_monitor.clear();
+  m_pt_proces_trace_id = LLDB_INVALID_UID;
+
+  NativeThreadLinux &thread = AddThread(m_pid);
+  thread.SetStoppedWithNoReason();
+
+  Status error = WriteSoftwareBreakpointOpcodes(true);
+  if (error.Fail())
+    LLDB_LOG(log, "failed to insert breakpoints into pid {0}: {1}", m_pid,
+             error);
+  return Status();
+}
+
+Status NativeProcessLinux::DeleteSnapshot(lldb::user_id_t snapshot_id) {
+  auto pos = m_snapshots.find(snapshot_id);
+  if (pos == m_snapshots.end())
+    return Status("no snapshot %" PRIu64, snapshot_id);
+  KillAndReap(pos->first, {});
+  m_snapshots.erase(pos);
+  return Status();
+}
+
+llvm::Expected<::pid_t>
+NativeProcessLinux::ForkStopped(::pid_t pid, ::pid_t tid,
+                                lldb::addr_t syscall_page) {
+#if defined(__x86_64__)
+  struct user_regs_struct regs;
+  Status error =
+      PtraceWrapper(PTRACE_GETREGS, tid, nullptr, &regs, sizeof(regs));
+  if (error.Fail())
+    return error.ToError();
+
+  // With PTRACE_O_TRACEFORK the kernel attaches us to the child before it
+  // runs.
+  error = SetDefaultPtraceOpts(tid, PTRACE_O_TRACEFORK);
+  if (error.Fail())
+    return error.ToError();
+  llvm::Expected<uint64_t> result =
+      InferiorSyscall(pid, tid, syscall_page, SYS_fork, {});
+  SetDefaultPtraceOpts(tid);
+  if (!result)
+    return result.takeError();
+  if (int64_t(*result) < 0)
+    return Status(-int64_t(*result), eErrorTypePOSIX).ToError();
+  const ::pid_t child = *result;
+
+  // The child starts with a SIGSTOP, past the system call instruction. Give
+  // it the registers the thread had before the call.
+  int status;
+  ::pid_t wait_pid =
+      llvm::sys::RetryAfterSignal(-1, ::waitpid, child, &status, __WALL);
+  if (wait_pid == -1 || !WIFSTOPPED(status))
+    error.SetErrorStringWithFormat("forked process %d didn't stop", child);
+  else
+    error = PtraceWrapper(PTRACE_SETREGS, child, nullptr, &regs, sizeof(regs));
+  if (error.Fail()) {
+    KillAndReap(child, {});
+    return error.ToError();
+  }
+  return child;
+#else
+  return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                 "cannot fork the inferior");
+#endif
+}
+
+Status NativeProcessLinux::WriteSoftwareBreakpointOpcodes(bool traps) {
+  Status error;
+  for (auto &pair : m_software_breakpoints) {
+    SoftwareBreakpoint &bp = pair.second;
+    llvm::ArrayRef<uint8_t> opcodes = bp.saved_opcodes;
+    if (traps) {
+      // A restored snapshot may have other code there than when the
+      // breakpoint was set.
+      size_t bytes_read = 0;
+      Status read_error = ReadMemory(pair.first, bp.saved_opcodes.data(),
+                                     bp.saved_opcodes.size(), bytes_read);
+      if (read_error.Fail() || bytes_read != bp.saved_opcodes.size()) {
+        error.SetErrorStringWithFormat(
+            "failed to read the code at breakpoint 0x%" PRIx64, pair.first);
+        continue;
+      }
+      opcodes = bp.breakpoint_opcodes;
+    }
+    size_t bytes_written = 0;
+    Status write_error =
+        WriteMemory(pair.first, opcodes.data(), opcodes.size(), bytes_written);
+    if (write_error.Fail())
+      error = write_error;
+  }
+  return error;
+}
+
+void NativeProcessLinux::KillAndReap(::pid_t pid,
+                                     llvm::ArrayRef<::pid_t> tids) {
+  ::kill(pid, SIGKILL);
+  // Threads may still stop for PTRACE_EVENT_EXIT. The thread group leader is
+  // only reported once all other threads are gone.
+  auto reap = [](::pid_t tid) {
+    int status;
+    while (llvm::sys::RetryAfterSignal(-1, ::waitpid, tid, &status, __WALL) ==
+               tid &&
+           WIFSTOPPED(status))
+      PtraceWrapper(PTRACE_CONT, tid);
+  };
+  for (::pid_t tid : tids) {
+    if (tid != pid)
+      reap(tid);
+  }
+  reap(pid);
+}
+
+void NativeProcessLinux::KillSnapshots() {
+  for (const auto &snapshot : m_snapshots)
+    KillAndReap(snapshot.first, {});
+  m_snapshots.clear();
+}
+
 llvm::Expected<llvm::ArrayRef<uint8_t>>
 NativeProcessLinux::GetSoftwareBreakpointTrapOpcode(size_t size_hint) {
   // The ARM reference recommends the use of 0xe7fddefe and 0xdefe but the
@@ -1431,6 +2305,13 @@ NativeProcessLinux::GetSoftwareBreakpointTrapOpcode(size_t size_hint) {
   }
 }
 
+bool NativeProcessLinux::CanReadMemoryConcurrently() const {
+  // process_vm_readv works from any thread of the tracer. The ptrace fallback
+  // does not, so a read that process_vm_readv can't complete fails when made
+  // from another thread.
+  return ProcessVmReadvSupported();
+}
+
 Status NativeProcessLinux::ReadMemory(lldb::addr_t addr, void *buf, size_t size,
                                       size_t &bytes_read) {
   if (ProcessVmReadvSupported()) {
@@ -1467,9 +2348,10 @@ Status NativeProcessLinux::ReadMemory(lldb::addr_t addr, void *buf, size_t size,
   Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_MEMORY));
   LLDB_LOG(log, "addr = {0}, buf = {1}, size = {2}", addr, buf, size);
 
+  const lldb::tid_t ptrace_tid = GetPtraceMemoryTID();
   for (bytes_read = 0; bytes_read < size; bytes_read += remainder) {
     Status error = NativeProcessLinux::PtraceWrapper(
-        PTRACE_PEEKDATA, GetID(), (void *)addr, nullptr, 0, &data);
+        PTRACE_PEEKDATA, ptrace_tid, (void *)addr, nullptr, 0, &data);
     if (error.Fail())
       return error;
 
@@ -1486,8 +2368,98 @@ Status NativeProcessLinux::ReadMemory(lldb::addr_t addr, void *buf, size_t size,
   return Status();
 }
 
+void NativeProcessLinux::ReadMemoryRanges(
+    llvm::MutableArrayRef<MemoryReadRange> ranges) {
+  if (!ProcessVmReadvSupported())
+    return NativeProcessProtocol::ReadMemoryRanges(ranges);
+
+  // Read as many ranges as the kernel accepts with a single process_vm_readv
+  // call. It stops at the first range it can't read completely, so that range
+  // gets read on its own (which falls back to ptrace) and we carry on after
+  // it.
+  static constexpr size_t k_max_iovecs = 1024; // UIO_MAXIOV
+  Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
+  const ::pid_t pid = GetID();
+  std::vector<struct iovec> local_iov, remote_iov;
+  size_t next = 0;
+  while (next < ranges.size()) {
+    const size_t count = std::min(ranges.size() - next, k_max_iovecs);
+    local_iov.resize(count);
+    remote_iov.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+      const MemoryReadRange &range = ranges[next + i];
+      local_iov[i].iov_base = range.buf;
+      local_iov[i].iov_len = range.size;
+      remote_iov[i].iov_base = reinterpret_cast<void *>(range.addr);
+      remote_iov[i].iov_len = range.size;
+    }
+
+    const ssize_t result = process_vm_readv(pid, local_iov.data(), count,
+                                            remote_iov.data(), count, 0);
+    LLDB_LOG(log, "using process_vm_readv to read {0} ranges: {1}", count,
+             result < 0 ? llvm::sys::StrError(errno) : "Success");
+    size_t bytes_left = result < 0 ? 0 : result;
+    const size_t end = next + count;
+    for (; next < end && bytes_left >= ranges[next].size; ++next) {
+      ranges[next].bytes_read = ranges[next].size;
+      bytes_left -= ranges[next].size;
+    }
+    if (next == end)
+      continue;
+
+    MemoryReadRange &range = ranges[next++];
+    if (ReadMemory(range.addr, range.buf, range.size, range.bytes_read).Fail())
+      range.bytes_read = 0;
+  }
+}
+
 Status NativeProcessLinux::WriteMemory(lldb::addr_t addr, const void *buf,
                                        size_t size, size_t &bytes_written) {
+  // process_vm_writev honors page protections, so it can't write to code.
+  // Try it first and let ptrace write whatever it couldn't. Pages where it
+  // failed are remembered until the next stop so that inserting many
+  // breakpoints doesn't pay for a failed system call each time.
+  if (size > 0 && ProcessVmReadvSupported()) {
+    const lldb::addr_t page_mask =
+        ~(lldb::addr_t(llvm::sys::Process::getPageSizeEstimate()) - 1);
+    if (!m_vm_writev_failed_pages.count(addr & page_mask)) {
+      struct iovec local_iov, remote_iov;
+      local_iov.iov_base = const_cast<void *>(buf);
+      local_iov.iov_len = size;
+      remote_iov.iov_base = reinterpret_cast<void *>(addr);
+      remote_iov.iov_len = size;
+
+      const ssize_t result =
+          process_vm_writev(GetID(), &local_iov, 1, &remote_iov, 1, 0);
+      const size_t written = result < 0 ? 0 : result;
+
+      Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
+      LLDB_LOG(log,
+               "using process_vm_writev to write {0} bytes to inferior "
+               "address {1:x}: wrote {2}",
+               size, addr, written);
+
+      if (written == size) {
+        bytes_written = size;
+        return Status();
+      }
+      m_vm_writev_failed_pages.insert((addr + written) & page_mask);
+
+      size_t rest_written = 0;
+      Status error = WriteMemoryWithPtrace(
+          addr + written, static_cast<const uint8_t *>(buf) + written,
+          size - written, rest_written);
+      bytes_written = written + rest_written;
+      return error;
+    }
+  }
+
+  return WriteMemoryWithPtrace(addr, buf, size, bytes_written);
+}
+
+Status NativeProcessLinux::WriteMemoryWithPtrace(lldb::addr_t addr,
+                                                 const void *buf, size_t size,
+                                                 size_t &bytes_written) {
   const unsigned char *src = static_cast<const unsigned char *>(buf);
   size_t remainder;
   Status error;
@@ -1495,6 +2467,7 @@ Status NativeProcessLinux::WriteMemory(lldb::addr_t addr, const void *buf,
   Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_MEMORY));
   LLDB_LOG(log, "addr = {0}, buf = {1}, size = {2}", addr, buf, size);
 
+  const lldb::tid_t ptrace_tid = GetPtraceMemoryTID();
   for (bytes_written = 0; bytes_written < size; bytes_written += remainder) {
     remainder = size - bytes_written;
     remainder = remainder > k_ptrace_word_size ? k_ptrace_word_size : remainder;
@@ -1504,7 +2477,7 @@ Status NativeProcessLinux::WriteMemory(lldb::addr_t addr, const void *buf,
       memcpy(&data, src, k_ptrace_word_size);
 
       LLDB_LOG(log, "[{0:x}]:{1:x}", addr, data);
-      error = NativeProcessLinux::PtraceWrapper(PTRACE_POKEDATA, GetID(),
+      error = NativeProcessLinux::PtraceWrapper(PTRACE_POKEDATA, ptrace_tid,
                                                 (void *)addr, (void *)data);
       if (error.Fail())
         return error;
@@ -1518,7 +2491,8 @@ Status NativeProcessLinux::WriteMemory(lldb::addr_t addr, const void *buf,
       memcpy(buff, src, remainder);
 
       size_t bytes_written_rec;
-      error = WriteMemory(addr, buff, k_ptrace_word_size, bytes_written_rec);
+      error = WriteMemoryWithPtrace(addr, buff, k_ptrace_word_size,
+                                    bytes_written_rec);
       if (error.Fail())
         return error;
 
@@ -1568,6 +2542,11 @@ bool NativeProcessLinux::StopTrackingThread(lldb::tid_t thread_id) {
   bool found = false;
   for (auto it = m_threads.begin(); it != m_threads.end(); ++it) {
     if (*it && ((*it)->GetID() == thread_id)) {
+      m_threads_pending_stop.erase(
+          std::remove(m_threads_pending_stop.begin(),
+                      m_threads_pending_stop.end(), it->get()),
+          m_threads_pending_stop.end());
+      m_threads_by_tid.erase(thread_id);
       m_threads.erase(it);
       found = true;
       break;
@@ -1576,7 +2555,13 @@ bool NativeProcessLinux::StopTrackingThread(lldb::tid_t thread_id) {
 
   if (found)
     StopTracingForThread(thread_id);
+  const bool was_stepping_over =
+      m_threads_stepping_over_breakpoint.count(thread_id);
+  ReinsertSteppedOverBreakpoint(thread_id);
+  ReprotectSteppedOverPage(thread_id, nullptr);
   SignalIfAllThreadsStopped();
+  if (was_stepping_over && m_pending_notification_tid == LLDB_INVALID_THREAD_ID)
+    ResumeDeferredThreads();
   return found;
 }
 
@@ -1592,6 +2577,8 @@ NativeThreadLinux &NativeProcessLinux::AddThread(lldb::tid_t thread_id) {
     SetCurrentThreadID(thread_id);
 
   m_threads.push_back(std::make_unique<NativeThreadLinux>(*this, thread_id));
+  auto &thread = static_cast<NativeThreadLinux &>(*m_threads.back());
+  m_threads_by_tid[thread_id] = &thread;
 
   if (m_pt_proces_trace_id != LLDB_INVALID_UID) {
     auto traceMonitor = ProcessorTraceMonitor::Create(
@@ -1607,7 +2594,7 @@ NativeThreadLinux &NativeProcessLinux::AddThread(lldb::tid_t thread_id) {
     }
   }
 
-  return static_cast<NativeThreadLinux &>(*m_threads.back());
+  return thread;
 }
 
 Status NativeProcessLinux::GetLoadedModuleFileSpec(const char *module_path,
@@ -1648,8 +2635,8 @@ Status NativeProcessLinux::GetFileLoadAddress(const llvm::StringRef &file_name,
 }
 
 NativeThreadLinux *NativeProcessLinux::GetThreadByID(lldb::tid_t tid) {
-  return static_cast<NativeThreadLinux *>(
-      NativeProcessProtocol::GetThreadByID(tid));
+  std::lock_guard<std::recursive_mutex> guard(m_threads_mutex);
+  return m_threads_by_tid.lookup(tid);
 }
 
 Status NativeProcessLinux::ResumeThread(NativeThreadLinux &thread,
@@ -1698,13 +2685,23 @@ void NativeProcessLinux::StopRunningThreads(const lldb::tid_t triggering_tid) {
   LLDB_LOG(log, "about to process event: (triggering_tid: {0})",
            triggering_tid);
 
+  if (m_non_stop) {
+    if (NativeThreadLinux *thread = GetThreadByID(triggering_tid))
+      ReportThreadStop(*thread);
+    return;
+  }
+
   m_pending_notification_tid = triggering_tid;
 
   // Request a stop for all the thread stops that need to be stopped and are
   // not already known to be stopped.
+  m_threads_pending_stop.clear();
   for (const auto &thread : m_threads) {
-    if (StateIsRunningState(thread->GetState()))
-      static_cast<NativeThreadLinux *>(thread.get())->RequestStop();
+    if (StateIsRunningState(thread->GetState())) {
+      auto &linux_thread = static_cast<NativeThreadLinux &>(*thread);
+      linux_thread.RequestStop();
+      m_threads_pending_stop.push_back(&linux_thread);
+    }
   }
 
   SignalIfAllThreadsStopped();
@@ -1715,10 +2712,21 @@ void NativeProcessLinux::SignalIfAllThreadsStopped() {
   if (m_pending_notification_tid == LLDB_INVALID_THREAD_ID)
     return; // No pending notification. Nothing to do.
 
+  while (!m_threads_pending_stop.empty() &&
+         !StateIsRunningState(m_threads_pending_stop.back()->GetState()))
+    m_threads_pending_stop.pop_back();
+  if (!m_threads_pending_stop.empty())
+    return; // Some threads are still running. Don't signal yet.
+
+  // A thread dropped from the list may have been resumed since, so look at
+  // all of them once before notifying.
   for (const auto &thread_sp : m_threads) {
     if (StateIsRunningState(thread_sp->GetState()))
-      return; // Some threads are still running. Don't signal yet.
+      m_threads_pending_stop.push_back(
+          static_cast<NativeThreadLinux *>(thread_sp.get()));
   }
+  if (!m_threads_pending_stop.empty())
+    return; // Some threads are still running. Don't signal yet.
 
   // We have a pending notification and all threads have stopped.
   Log *log(
@@ -1734,12 +2742,73 @@ void NativeProcessLinux::SignalIfAllThreadsStopped() {
   }
   m_threads_stepping_with_breakpoint.clear();
 
+  // A thread that was stopped before it got past a breakpoint it was stepping
+  // over is still on it, and gets stepped over it again once it is resumed.
+  // Actions held back for it are dropped, the client sends new ones.
+  while (!m_threads_stepping_over_breakpoint.empty())
+    ReinsertSteppedOverBreakpoint(
+        m_threads_stepping_over_breakpoint.begin()->first);
+  m_deferred_resumes.clear();
+
+  // The same goes for a thread stepping over an access to a watched page.
+  while (!m_threads_stepping_over_page_access.empty()) {
+    const lldb::tid_t tid = m_threads_stepping_over_page_access.begin()->first;
+    ReprotectSteppedOverPage(tid, GetThreadByID(tid));
+  }
+
   // Notify the delegate about the stop
   SetCurrentThreadID(m_pending_notification_tid);
   SetState(StateType::eStateStopped, true);
   m_pending_notification_tid = LLDB_INVALID_THREAD_ID;
 }
 
+void NativeProcessLinux::ReportThreadStop(NativeThreadLinux &thread) {
+  Log *log(
+      GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_BREAKPOINTS));
+  const lldb::tid_t tid = thread.GetID();
+
+  // Same clean up as SignalIfAllThreadsStopped, for this thread only.
+  auto step_pos = m_threads_stepping_with_breakpoint.find(tid);
+  if (step_pos != m_threads_stepping_with_breakpoint.end()) {
+    Status error = RemoveBreakpoint(step_pos->second);
+    if (error.Fail())
+      LLDB_LOG(log, "pid = {0} remove stepping breakpoint: {1}", tid, error);
+    m_threads_stepping_with_breakpoint.erase(step_pos);
+  }
+  ReinsertSteppedOverBreakpoint(tid);
+  m_deferred_resumes.erase(
+      std::remove_if(m_deferred_resumes.begin(), m_deferred_resumes.end(),
+                     [tid](const DeferredResume &resume) {
+                       return resume.action.tid == tid;
+                     }),
+      m_deferred_resumes.end());
+
+  SetCurrentThreadID(tid);
+  NotifyThreadStopped(thread);
+}
+
+lldb::tid_t NativeProcessLinux::GetPtraceMemoryTID() {
+  NativeThreadLinux *main_thread = GetThreadByID(GetID());
+  if (!m_non_stop || !main_thread ||
+      !StateIsRunningState(main_thread->GetState()))
+    return GetID();
+  for (const auto &thread : m_threads) {
+    if (!StateIsRunningState(thread->GetState()))
+      return thread->GetID();
+  }
+  return GetID();
+}
+
+Status NativeProcessLinux::SetNonStopMode(bool non_stop) {
+  Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
+  LLDB_LOG(log, "pid {0} non-stop = {1}", GetID(), non_stop);
+
+  if (m_pending_notification_tid != LLDB_INVALID_THREAD_ID)
+    return Status("cannot change modes while threads are being stopped");
+  m_non_stop = non_stop;
+  return Status();
+}
+
 void NativeProcessLinux::ThreadWasCreated(NativeThreadLinux &thread) {
   Log *const log = ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_THREAD);
   LLDB_LOG(log, "tid: {0}", thread.GetID());
@@ -1749,6 +2818,7 @@ void NativeProcessLinux::ThreadWasCreated(NativeThreadLinux &thread) {
     // We will need to wait for this new thread to stop as well before firing
     // the notification.
     thread.RequestStop();
+    m_threads_pending_stop.push_back(&thread);
   }
 }
 
@@ -19,6 +19,7 @@
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/FileSpec.h"
 #include "lldb/lldb-types.h"
+#include "llvm/ADT/DenseMap.h"
 
 #include "NativeThreadLinux.h"
 #include "Plugins/Process/POSIX/NativeProcessELF.h"
@@ -49,6 +50,8 @@ public:
            MainLoop &mainloop) const override;
   };
 
+  ~NativeProcessLinux() override;
+
   // NativeProcessProtocol Interface
   Status Resume(const ResumeActionList &resume_actions) override;
 
@@ -62,12 +65,16 @@ public:
 
   Status Kill() override;
 
+  Status SetNonStopMode(bool non_stop) override;
+
   Status GetMemoryRegionInfo(lldb::addr_t load_addr,
                              MemoryRegionInfo &range_info) override;
 
   Status ReadMemory(lldb::addr_t addr, void *buf, size_t size,
                     size_t &bytes_read) override;
 
+  void ReadMemoryRanges(llvm::MutableArrayRef<MemoryReadRange> ranges) override;
+
   Status WriteMemory(lldb::addr_t addr, const void *buf, size_t size,
                      size_t &bytes_written) override;
 
@@ -85,6 +92,13 @@ public:
 
   Status RemoveBreakpoint(lldb::addr_t addr, bool hardware = false) override;
 
+  /// Watchpoints that don't get a hardware debug register fall back to page
+  /// watchpoints on x86_64, see SetPageWatchpoint.
+  Status SetWatchpoint(lldb::addr_t addr, size_t size, uint32_t watch_flags,
+                       bool hardware) override;
+
+  Status RemoveWatchpoint(lldb::addr_t addr) override;
+
   void DoStopIDBumped(uint32_t newBumpId) override;
 
   Status GetLoadedModuleFileSpec(const char *module_path,
@@ -116,6 +130,26 @@ public:
 
   Status GetTraceConfig(lldb::user_id_t traceid, TraceOptions &config) override;
 
+  /// Snapshots are copies of the process forked from its current thread,
+  /// which we keep stopped. Only that thread is in the snapshot, and being
+  /// copy-on-write they cost little until one of them writes to memory.
+  /// They need x86_64, and can't be taken or restored while page
+  /// watchpoints are set.
+  llvm::Expected<lldb::user_id_t> SaveSnapshot() override;
+
+  Status RestoreSnapshot(lldb::user_id_t snapshot_id) override;
+
+  Status DeleteSnapshot(lldb::user_id_t snapshot_id) override;
+
+  /// A thread hitting a tracepoint steps over it and goes on, like a false
+  /// breakpoint condition, so tracepoints need hardware single stepping.
+  /// Threads hitting the tracepoint while another one steps over it miss
+  /// it.
+  Status SetTracepoint(lldb::addr_t addr,
+                       std::vector<uint32_t> registers) override;
+
+  Status RemoveTracepoint(lldb::addr_t addr) override;
+
   // Interface used by NativeRegisterContext-derived classes.
   static Status PtraceWrapper(int req, lldb::pid_t pid, void *addr = nullptr,
                               void *data = nullptr, size_t data_size = 0,
@@ -123,6 +157,8 @@ public:
 
   bool SupportHardwareSingleStepping() const;
 
+  bool CanReadMemoryConcurrently() const override;
+
 protected:
   llvm::Expected<llvm::ArrayRef<uint8_t>>
   GetSoftwareBreakpointTrapOpcode(size_t size_hint) override;
@@ -134,12 +170,91 @@ private:
   LazyBool m_supports_mem_region = eLazyBoolCalculate;
   std::vector<std::pair<MemoryRegionInfo, FileSpec>> m_mem_region_cache;
 
+  // Pages process_vm_writev couldn't write to since the last stop, usually
+  // because they are read-only code. Writes there go straight to ptrace.
+  llvm::DenseSet<lldb::addr_t> m_vm_writev_failed_pages;
+
   lldb::tid_t m_pending_notification_tid = LLDB_INVALID_THREAD_ID;
 
+  // In non-stop mode stopping threads are reported on their own, see
+  // NativeProcessProtocol::SetNonStopMode.
+  bool m_non_stop = false;
+
+  // Threads StopRunningThreads is still waiting for. Entries are only dropped
+  // from the back, once they have stopped, so checking for the all-stop after
+  // each waitpid event takes amortized constant time however many threads the
+  // process has.
+  std::vector<NativeThreadLinux *> m_threads_pending_stop;
+
+  // All entries of m_threads by their tid. Every waitpid event looks up its
+  // thread.
+  llvm::DenseMap<lldb::tid_t, NativeThreadLinux *> m_threads_by_tid;
+
   // List of thread ids stepping with a breakpoint with the address of
   // the relevan breakpoint
   std::map<lldb::tid_t, lldb::addr_t> m_threads_stepping_with_breakpoint;
 
+  // Threads single-stepping over one of our software breakpoints, with the
+  // address of the breakpoint whose trap has to go back in once the step is
+  // done. The step is either for a breakpoint whose condition was false, or
+  // for a thread that was resumed while sitting on the breakpoint.
+  struct SteppingOverBreakpoint {
+    lldb::addr_t addr;
+    bool on_resume;
+  };
+  std::map<lldb::tid_t, SteppingOverBreakpoint>
+      m_threads_stepping_over_breakpoint;
+
+  // Resume actions held back until the threads Resume() stepped over a
+  // breakpoint are past it. Those threads have their own action here too.
+  struct DeferredResume {
+    ResumeAction action;
+    bool stepped_over;
+  };
+  std::vector<DeferredResume> m_deferred_resumes;
+
+  // Watchpoints implemented by taking access away from the pages they are
+  // on, by their address.
+  struct PageWatchpoint {
+    lldb::addr_t addr;
+    size_t size;
+    uint32_t watch_flags;
+  };
+  std::map<lldb::addr_t, PageWatchpoint> m_page_watchpoints;
+
+  // Pages with page watchpoints on them, by their address.
+  struct WatchedPage {
+    // The protection the page had before it was watched.
+    int original_prot;
+    // The protection that makes the accesses to the watchpoints fault.
+    int watch_prot;
+    std::vector<lldb::addr_t> watchpoints;
+  };
+  std::map<lldb::addr_t, WatchedPage> m_watched_pages;
+
+  // A page in the inferior holding a system call instruction, so threads can
+  // run mprotect without us patching the code other threads are running.
+  lldb::addr_t m_syscall_page = LLDB_INVALID_ADDRESS;
+
+  // Threads single-stepping an access that faulted on a watched page, which
+  // has its protection back until the step is done.
+  struct SteppingOverPageAccess {
+    lldb::addr_t page;
+    lldb::addr_t fault_addr;
+    // The watchpoint the access hit, if that is known before the step.
+    lldb::addr_t wp_addr;
+    // The values of the write watchpoints on the page the access may have
+    // written to. Those that change during the step were hit.
+    std::vector<std::pair<lldb::addr_t, std::vector<uint8_t>>> old_values;
+    bool was_stepping;
+  };
+  std::map<lldb::tid_t, SteppingOverPageAccess>
+      m_threads_stepping_over_page_access;
+
+  // Snapshots taken with SaveSnapshot by their pid, which is their ID, with
+  // the address of the system call page in them.
+  std::map<lldb::pid_t, lldb::addr_t> m_snapshots;
+
   // Private Instance Methods
   NativeProcessLinux(::pid_t pid, int terminal_fd, NativeDelegate &delegate,
                      const ArchSpec &arch, MainLoop &mainloop,
@@ -148,7 +263,7 @@ private:
   // Returns a list of process threads that we have attached to.
   static llvm::Expected<std::vector<::pid_t>> Attach(::pid_t pid);
 
-  static Status SetDefaultPtraceOpts(const lldb::pid_t);
+  static Status SetDefaultPtraceOpts(const lldb::pid_t, long extra_opts = 0);
 
   void MonitorCallback(lldb::pid_t pid, bool exited, WaitStatus status);
 
@@ -162,9 +277,101 @@ private:
 
   void MonitorWatchpoint(NativeThreadLinux &thread, uint32_t wp_index);
 
+  // If the software breakpoint \a thread stopped at has conditions and they
+  // are all false, step the thread over it without telling anyone and return
+  // true.
+  bool StepOverConditionalBreakpoint(NativeThreadLinux &thread);
+
+  // If \a thread is about to run from one of our software breakpoints, take
+  // the trap out and step it past the breakpoint, queueing \a action until
+  // it is. Returns true if the thread is stepping.
+  bool StepOverBreakpointOnResume(NativeThreadLinux &thread,
+                                  const ResumeAction &action);
+
+  // Put back the trap taken out for \a tid to step it over a breakpoint.
+  void ReinsertSteppedOverBreakpoint(lldb::tid_t tid);
+
+  // Called once \a thread got past the breakpoint it was stepping over.
+  void FinishBreakpointStepOver(NativeThreadLinux &thread);
+
+  // Apply m_deferred_resumes, once no thread is stepping over a breakpoint
+  // for Resume() any more.
+  void ResumeDeferredThreads();
+
   void MonitorSignal(const siginfo_t &info, NativeThreadLinux &thread,
                      bool exited);
 
+  bool SupportsPageWatchpoints() const;
+
+  // Watch \a size bytes at \a addr by taking write access, or all access for
+  // read watchpoints, away from the pages they are on. Accesses that fault
+  // on those pages are stepped over with the protection restored, and the
+  // ones that didn't touch a watchpoint never get to the client.
+  //
+  // Accesses that start before a read watchpoint, accesses by the kernel
+  // (which fail with EFAULT instead of faulting), and accesses other threads
+  // make while a thread steps over one are missed. Writes to a write
+  // watchpoint on a page that also has a read watchpoint are only seen when
+  // they change its value.
+  Status SetPageWatchpoint(lldb::addr_t addr, size_t size,
+                           uint32_t watch_flags);
+
+  Status RemovePageWatchpoint(lldb::addr_t addr);
+
+  // Recompute and apply the protection of the pages \a size bytes at \a addr
+  // are on, after a page watchpoint there was added or removed.
+  Status UpdateWatchedPages(NativeThreadLinux &thread, lldb::addr_t addr,
+                            size_t size);
+
+  Status ProtectPage(NativeThreadLinux &thread, lldb::addr_t page, int prot);
+
+  // Map m_syscall_page, running mmap on \a thread from its pc. Other threads
+  // must not be running.
+  Status SetupSyscallPage(NativeThreadLinux &thread);
+
+  // Run system call \a number with \a args on the stopped \a thread, from
+  // the system call instruction at \a pc, and return what it returned.
+  llvm::Expected<uint64_t> InferiorSyscall(NativeThreadLinux &thread,
+                                           lldb::addr_t pc, long number,
+                                           llvm::ArrayRef<uint64_t> args);
+
+  // The same for thread \a tid of process \a pid, which need not be the
+  // one we debug.
+  static llvm::Expected<uint64_t>
+  InferiorSyscall(::pid_t pid, ::pid_t tid, lldb::addr_t pc, long number,
+                  llvm::ArrayRef<uint64_t> args);
+
+  // Fork thread \a tid of process \a pid with the system call instruction
+  // at \a syscall_page, and return the pid of the child, which is stopped
+  // and traced, with the registers \a tid had.
+  static llvm::Expected<::pid_t> ForkStopped(::pid_t pid, ::pid_t tid,
+                                             lldb::addr_t syscall_page);
+
+  // Write the trap opcodes of our software breakpoints into memory, or the
+  // code they replaced if \a traps is false. Snapshots are taken without
+  // the traps, since the breakpoints may have changed when one is restored.
+  Status WriteSoftwareBreakpointOpcodes(bool traps);
+
+  // SIGKILL \a pid, then wait for its threads \a tids, all of which we
+  // trace, to exit. The SIGCHLD handler doesn't get to see them.
+  static void KillAndReap(::pid_t pid, llvm::ArrayRef<::pid_t> tids);
+
+  void KillSnapshots();
+
+  // If \a fault_addr is on a watched page, give the page its protection back
+  // and step \a thread over the access that faulted. Returns true if the
+  // thread is stepping.
+  bool StepOverPageAccess(NativeThreadLinux &thread, lldb::addr_t fault_addr);
+
+  // Protect the page \a tid stepped an access to again, running mprotect on
+  // \a thread, or on any stopped thread if that is null.
+  void ReprotectSteppedOverPage(lldb::tid_t tid, NativeThreadLinux *thread);
+
+  // Called once \a thread got past the access it was stepping over.
+  void FinishPageAccessStepOver(NativeThreadLinux &thread);
+
+  NativeThreadLinux *GetStoppedThread();
+
   Status SetupSoftwareSingleStepping(NativeThreadLinux &thread);
 
   bool HasThreadNoLock(lldb::tid_t thread_id);
@@ -186,6 +393,9 @@ private:
 
   Status Detach(lldb::tid_t tid);
 
+  Status WriteMemoryWithPtrace(lldb::addr_t addr, const void *buf, size_t size,
+                               size_t &bytes_written);
+
   // This method is requests a stop on all threads which are still running. It
   // sets up a
   // deferred delegate notification, which will fire once threads report as
@@ -196,6 +406,14 @@ private:
   // Notify the delegate if all threads have stopped.
   void SignalIfAllThreadsStopped();
 
+  // Report a thread that stopped in non-stop mode, leaving the others
+  // running.
+  void ReportThreadStop(NativeThreadLinux &thread);
+
+  // The thread to use for ptrace memory accesses. These need a stopped
+  // thread, which in non-stop mode need not be the main one.
+  lldb::tid_t GetPtraceMemoryTID();
+
   // Resume the given thread, optionally passing it the given signal. The type
   // of resume
   // operation (continue, single-step) depends on the state parameter.
@@ -28,6 +28,10 @@ public:
   CreateHostNativeRegisterContextLinux(const ArchSpec &target_arch,
                                        NativeThreadProtocol &native_thread);
 
+  // Drop any register values cached since the thread stopped. This is called
+  // before the thread is resumed.
+  virtual void InvalidateAllRegisters() {}
+
 protected:
   lldb::ByteOrder GetByteOrder() const;
 
@@ -439,7 +439,21 @@ NativeRegisterContextLinux_x86_64::ReadRegister(const RegisterInfo *reg_info,
       full_reg = reg_info->invalidate_regs[0];
     }
 
-    error = ReadRegisterRaw(full_reg, reg_value);
+    const RegisterInfo *full_reg_info = GetRegisterInfoAtIndex(full_reg);
+    if (IsGPR(full_reg) && IsGPRCached(full_reg_info)) {
+      // Serve general purpose registers from one PTRACE_GETREGS per stop
+      // instead of a PTRACE_PEEKUSER per register.
+      error = ReadGPR();
+      if (error.Success()) {
+        uint64_t value = 0;
+        ::memcpy(&value,
+                 reinterpret_cast<uint8_t *>(&m_gpr_x86_64) +
+                     full_reg_info->byte_offset,
+                 full_reg_info->byte_size);
+        reg_value.SetUInt(value, full_reg_info->byte_size);
+      }
+    } else
+      error = ReadRegisterRaw(full_reg, reg_value);
 
     if (error.Success()) {
       // If our read was not aligned (for ah,bh,ch,dh), shift our returned
@@ -576,12 +590,23 @@ Status NativeRegisterContextLinux_x86_64::WriteRegister(
                                                ? reg_info->name
                                                : "<unknown register>");
 
+  const bool is_fpr = IsFPR(reg_index) || IsAVX(reg_index) || IsMPX(reg_index);
+  if (is_fpr) {
+    // Update the current register state rather than whatever was in the
+    // buffer, as the whole set is written back.
+    Status error = ReadFPR();
+    if (error.Fail())
+      return error;
+  }
+
   UpdateXSTATEforWrite(reg_index);
 
-  if (IsGPR(reg_index))
+  if (IsGPR(reg_index)) {
+    m_gpr_is_valid = false;
     return WriteRegisterRaw(reg_index, reg_value);
+  }
 
-  if (IsFPR(reg_index) || IsAVX(reg_index) || IsMPX(reg_index)) {
+  if (is_fpr) {
     if (reg_info->encoding == lldb::eEncodingVector) {
       if (reg_index >= m_reg_info.first_st && reg_index <= m_reg_info.last_st)
         ::memcpy(m_xstate->fxsave.stmm[reg_index - m_reg_info.first_st].bytes,
@@ -743,8 +768,10 @@ Status NativeRegisterContextLinux_x86_64::ReadAllRegisterValues(
   if (reg_info == nullptr)
     reg_info = GetRegisterInfoInterface().GetDynamicRegisterInfo("orig_rax");
 
-  if (reg_info != nullptr)
+  if (reg_info != nullptr) {
+    m_gpr_is_valid = false;
     return DoWriteRegisterValue(reg_info->byte_offset, reg_info->name, value);
+  }
 
   return error;
 }
@@ -775,6 +802,9 @@ Status NativeRegisterContextLinux_x86_64::WriteAllRegisterValues(
                                    __FUNCTION__);
     return error;
   }
+  // The kernel may adjust some of the values we write, so read them back
+  // instead of trusting the buffers.
+  InvalidateAllRegisters();
   ::memcpy(&m_gpr_x86_64, src, GetRegisterInfoInterface().GetGPRSize());
 
   error = WriteGPR();
@@ -877,6 +907,33 @@ bool NativeRegisterContextLinux_x86_64::IsFPR(uint32_t reg_index) const {
           reg_index <= m_reg_info.last_fpr);
 }
 
+bool NativeRegisterContextLinux_x86_64::IsGPRCached(
+    const RegisterInfo *reg_info) const {
+  // PTRACE_GETREGS always fills in the 64-bit user_regs_struct. The i386
+  // register offsets describe the 32-bit layout, so those are still read one
+  // at a time.
+  return reg_info &&
+         GetRegisterInfoInterface().GetTargetArchitecture().GetMachine() ==
+             llvm::Triple::x86_64 &&
+         reg_info->byte_size <= sizeof(uint64_t) &&
+         reg_info->byte_offset + reg_info->byte_size <=
+             GetRegisterInfoInterface().GetGPRSize();
+}
+
+void NativeRegisterContextLinux_x86_64::InvalidateAllRegisters() {
+  m_gpr_is_valid = false;
+  m_fpr_is_valid = false;
+}
+
+Status NativeRegisterContextLinux_x86_64::ReadGPR() {
+  if (m_gpr_is_valid)
+    return Status();
+
+  Status error = NativeRegisterContextLinux::ReadGPR();
+  m_gpr_is_valid = error.Success();
+  return error;
+}
+
 Status NativeRegisterContextLinux_x86_64::WriteFPR() {
   switch (m_xstate_type) {
   case XStateType::FXSAVE:
@@ -954,11 +1011,15 @@ size_t NativeRegisterContextLinux_x86_64::GetFPRSize() {
 Status NativeRegisterContextLinux_x86_64::ReadFPR() {
   Status error;
 
+  if (m_fpr_is_valid)
+    return error;
+
   // Probe XSAVE and if it is not supported fall back to FXSAVE.
   if (m_xstate_type != XStateType::FXSAVE) {
     error = ReadRegisterSet(&m_iovec, sizeof(m_xstate->xsave), NT_X86_XSTATE);
     if (!error.Fail()) {
       m_xstate_type = XStateType::XSAVE;
+      m_fpr_is_valid = true;
       return error;
     }
   }
@@ -967,6 +1028,7 @@ Status NativeRegisterContextLinux_x86_64::ReadFPR() {
       fxsr_regset(GetRegisterInfoInterface().GetTargetArchitecture()));
   if (!error.Fail()) {
     m_xstate_type = XStateType::FXSAVE;
+    m_fpr_is_valid = true;
     return error;
   }
   return Status("Unrecognized FPR type.");
@@ -64,6 +64,8 @@ public:
 
   uint32_t NumSupportedHardwareWatchpoints() override;
 
+  void InvalidateAllRegisters() override;
+
 protected:
   void *GetGPRBuffer() override { return &m_gpr_x86_64; }
 
@@ -71,6 +73,8 @@ protected:
 
   size_t GetFPRSize() override;
 
+  Status ReadGPR() override;
+
   Status ReadFPR() override;
 
   Status WriteFPR() override;
@@ -116,6 +120,10 @@ private:
   RegInfo m_reg_info;
   uint64_t m_gpr_x86_64[k_num_gpr_registers_x86_64];
   uint32_t m_fctrl_offset_in_userarea;
+  // Whether m_gpr_x86_64 and m_xstate hold the values of the current stop.
+  // Writes go straight to the thread, so there is nothing to flush on resume.
+  bool m_gpr_is_valid = false;
+  bool m_fpr_is_valid = false;
 
   // Private member methods.
   bool IsCPUFeatureAvailable(RegSet feature_code) const;
@@ -126,6 +134,8 @@ private:
 
   bool IsFPR(uint32_t reg_index) const;
 
+  bool IsGPRCached(const RegisterInfo *reg_info) const;
+
   bool CopyXSTATEtoYMM(uint32_t reg_index, lldb::ByteOrder byte_order);
 
   bool CopyYMMtoXSTATE(uint32_t reg, lldb::ByteOrder byte_order);
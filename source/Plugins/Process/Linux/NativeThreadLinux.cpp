@@ -241,6 +241,7 @@ Status NativeThreadLinux::Resume(uint32_t signo) {
   if (signo != LLDB_INVALID_SIGNAL_NUMBER)
     data = signo;
 
+  m_reg_context_up->InvalidateAllRegisters();
   return NativeProcessLinux::PtraceWrapper(PTRACE_CONT, GetID(), nullptr,
                                            reinterpret_cast<void *>(data));
 }
@@ -262,6 +263,8 @@ Status NativeThreadLinux::SingleStep(uint32_t signo) {
   if (signo != LLDB_INVALID_SIGNAL_NUMBER)
     data = signo;
 
+  m_reg_context_up->InvalidateAllRegisters();
+
   // If hardware single-stepping is not supported, we just do a continue. The
   // breakpoint on the next instruction has been setup in
   // NativeProcessLinux::Resume.
@@ -371,6 +374,19 @@ void NativeThreadLinux::SetStoppedByWatchpoint(uint32_t wp_index) {
   m_stop_info.details.signal.signo = SIGTRAP;
 }
 
+void NativeThreadLinux::SetStoppedByPageWatchpoint(lldb::addr_t wp_addr,
+                                                   lldb::addr_t hit_addr) {
+  SetStopped();
+
+  // Page watchpoints don't have a hardware index.
+  std::ostringstream ostr;
+  ostr << wp_addr << " " << LLDB_INVALID_INDEX32 << " " << hit_addr;
+  m_stop_description = ostr.str();
+
+  m_stop_info.reason = StopReason::eStopReasonWatchpoint;
+  m_stop_info.details.signal.signo = SIGTRAP;
+}
+
 bool NativeThreadLinux::IsStoppedAtBreakpoint() {
   return GetState() == StateType::eStateStopped &&
          m_stop_info.reason == StopReason::eStopReasonBreakpoint;
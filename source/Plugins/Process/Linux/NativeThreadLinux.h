@@ -75,6 +75,8 @@ private:
 
   void SetStoppedByWatchpoint(uint32_t wp_index);
 
+  void SetStoppedByPageWatchpoint(lldb::addr_t wp_addr, lldb::addr_t hit_addr);
+
   bool IsStoppedAtBreakpoint();
 
   bool IsStoppedAtWatchpoint();
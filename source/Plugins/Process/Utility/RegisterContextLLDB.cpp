@@ -641,6 +641,13 @@ UnwindPlanSP RegisterContextLLDB::GetFastUnwindPlanForFrame() {
   if (IsFrameZero())
     return unwind_plan_sp;
 
+  // Following the frame pointer chain doesn't need a FuncUnwinders at all.
+  unwind_plan_sp = GetFramePointerUnwindPlanForFrame();
+  if (unwind_plan_sp) {
+    m_frame_type = eNormalFrame;
+    return unwind_plan_sp;
+  }
+
   FuncUnwindersSP func_unwinders_sp(
       pc_module_sp->GetUnwindTable().GetFuncUnwindersContainingAddress(
           m_current_pc, m_sym_ctx));
@@ -672,6 +679,77 @@ UnwindPlanSP RegisterContextLLDB::GetFastUnwindPlanForFrame() {
   return unwind_plan_sp;
 }
 
+UnwindPlanSP RegisterContextLLDB::GetFramePointerUnwindPlanForFrame() {
+  UnwindPlanSP unwind_plan_sp;
+  if (IsFrameZero())
+    return unwind_plan_sp;
+
+  // Trap handlers, and the frames they interrupted, don't follow the frame
+  // pointer conventions.
+  if (m_frame_type == eTrapHandlerFrame || m_frame_type == eDebuggerFrame ||
+      GetNextFrame()->m_frame_type == eTrapHandlerFrame ||
+      GetNextFrame()->m_frame_type == eDebuggerFrame)
+    return unwind_plan_sp;
+
+  ExecutionContext exe_ctx(m_thread.shared_from_this());
+  Process *process = exe_ctx.GetProcessPtr();
+  ABI *abi = process ? process->GetABI().get() : nullptr;
+  if (!abi || !process->GetTarget().GetFramePointerUnwind())
+    return unwind_plan_sp;
+
+  auto fp_unwind_plan_sp =
+      std::make_shared<UnwindPlan>(lldb::eRegisterKindGeneric);
+  if (!abi->CreateDefaultUnwindPlan(*fp_unwind_plan_sp))
+    return unwind_plan_sp;
+  UnwindPlan::RowSP row = fp_unwind_plan_sp->GetRowForFunctionOffset(0);
+  if (!row)
+    return unwind_plan_sp;
+
+  // Find where the default plan says the caller's pc was saved; this only
+  // works for plans that save it on the stack.
+  const RegisterKind row_register_kind = fp_unwind_plan_sp->GetRegisterKind();
+  RegisterNumber pc_regnum(m_thread, eRegisterKindGeneric,
+                           LLDB_REGNUM_GENERIC_PC);
+  UnwindPlan::Row::RegisterLocation pc_regloc;
+  if (pc_regnum.GetAsKind(row_register_kind) == LLDB_INVALID_REGNUM ||
+      !row->GetRegisterInfo(pc_regnum.GetAsKind(row_register_kind),
+                            pc_regloc) ||
+      !pc_regloc.IsAtCFAPlusOffset())
+    return unwind_plan_sp;
+
+  addr_t cfa;
+  if (!ReadFrameAddress(row_register_kind, row->GetCFAValue(), cfa) ||
+      cfa == LLDB_INVALID_ADDRESS || cfa == 0 ||
+      !abi->CallFrameAddressIsValid(cfa))
+    return unwind_plan_sp;
+
+  Status error;
+  addr_t return_addr =
+      process->ReadPointerFromMemory(cfa + pc_regloc.GetOffset(), error);
+  if (error.Fail())
+    return unwind_plan_sp;
+
+  // A zero return address terminates the chain; anything else has to be
+  // code in a loaded module or we let the regular UnwindPlans handle this
+  // frame.
+  if (return_addr != 0) {
+    Address return_address;
+    return_addr = abi->FixCodeAddress(return_addr);
+    if (!process->GetTarget().GetSectionLoadList().ResolveLoadAddress(
+            return_addr, return_address))
+      return unwind_plan_sp;
+    SectionSP section_sp = return_address.GetSection();
+    if (!section_sp ||
+        (section_sp->GetPermissions() & ePermissionsExecutable) == 0)
+      return unwind_plan_sp;
+  }
+
+  UnwindLogMsgVerbose("using frame pointer unwind, caller pc 0x%" PRIx64,
+                      return_addr);
+  unwind_plan_sp = fp_unwind_plan_sp;
+  return unwind_plan_sp;
+}
+
 // On entry to this method,
 //
 //   1. m_frame_type should already be set to eTrapHandlerFrame/eDebuggerFrame
@@ -191,6 +191,11 @@ private:
 
   lldb::UnwindPlanSP GetFastUnwindPlanForFrame();
 
+  // If the target asks for frame pointer unwinding, return the architecture
+  // default UnwindPlan when the caller's return address it recovers is in a
+  // loaded executable section; otherwise return an empty plan.
+  lldb::UnwindPlanSP GetFramePointerUnwindPlanForFrame();
+
   lldb::UnwindPlanSP GetFullUnwindPlanForFrame();
 
   void UnwindLogMsg(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
@@ -380,6 +380,30 @@ size_t ProcessElfCore::DoReadMemory(lldb::addr_t addr, void *buf, size_t size,
   return bytes_copied + zero_fill_size;
 }
 
+bool ProcessElfCore::GetMemoryView(lldb::addr_t addr, size_t size,
+                                   DataExtractor &data) {
+  ObjectFile *core_objfile = m_core_module_sp->GetObjectFile();
+  if (core_objfile == nullptr || size == 0)
+    return false;
+
+  const VMRangeToFileOffset::Entry *address_range =
+      m_core_aranges.FindEntryThatContains(addr);
+  if (address_range == nullptr)
+    return false;
+
+  // Bytes past the on-disk part of the segment are zero filled by
+  // DoReadMemory, so only ranges entirely backed by the file can be viewed.
+  const lldb::addr_t offset = addr - address_range->GetRangeBase();
+  const lldb::addr_t file_start = address_range->data.GetRangeBase();
+  const lldb::addr_t file_end = address_range->data.GetRangeEnd();
+  if (file_start + offset + size > file_end)
+    return false;
+
+  // The whole core file is mapped into the object file's data, so this shares
+  // the mapping instead of copying from it.
+  return core_objfile->GetData(file_start + offset, size, data) == size;
+}
+
 void ProcessElfCore::Clear() {
   m_thread_list.Clear();
 
@@ -81,6 +81,8 @@ public:
 
   bool WarnBeforeDetach() const override { return false; }
 
+  bool IsLiveDebugSession() const override { return false; }
+
   // Process Memory
   size_t ReadMemory(lldb::addr_t addr, void *buf, size_t size,
                     lldb_private::Status &error) override;
@@ -88,6 +90,9 @@ public:
   size_t DoReadMemory(lldb::addr_t addr, void *buf, size_t size,
                       lldb_private::Status &error) override;
 
+  bool GetMemoryView(lldb::addr_t addr, size_t size,
+                     lldb_private::DataExtractor &data) override;
+
   lldb_private::Status
   GetMemoryRegionInfo(lldb::addr_t load_addr,
                       lldb_private::MemoryRegionInfo &region_info) override;
@@ -196,6 +196,7 @@ GDBRemoteClientBase::SendPacketAndReceiveResponseWithOutputSupport(
 GDBRemoteCommunication::PacketResult
 GDBRemoteClientBase::SendPacketAndWaitForResponseNoLock(
     llvm::StringRef payload, StringExtractorGDBRemote &response) {
+  const auto start = steady_clock::now();
   PacketResult packet_result = SendPacketNoLock(payload);
   if (packet_result != PacketResult::Success)
     return packet_result;
@@ -207,8 +208,10 @@ GDBRemoteClientBase::SendPacketAndWaitForResponseNoLock(
     if (packet_result != PacketResult::Success)
       return packet_result;
     // Make sure our response is valid for the payload that was sent
-    if (response.ValidateResponse())
+    if (response.ValidateResponse()) {
+      RecordRoundTrip(payload, steady_clock::now() - start);
       return packet_result;
+    }
     // Response says it wasn't valid
     Log *log = ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_PACKETS);
     LLDB_LOGF(
@@ -222,6 +225,126 @@ GDBRemoteClientBase::SendPacketAndWaitForResponseNoLock(
   return packet_result;
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteClientBase::SendPacketsAndWaitForResponses(
+    llvm::ArrayRef<std::string> payloads,
+    std::vector<StringExtractorGDBRemote> &responses, bool send_async) {
+  Lock lock(*this, send_async);
+  if (!lock) {
+    if (Log *log =
+            ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_PROCESS))
+      LLDB_LOGF(log,
+                "GDBRemoteClientBase::%s failed to get mutex, not sending "
+                "%zu packets (send_async=%d)",
+                __FUNCTION__, payloads.size(), send_async);
+    responses.clear();
+    return PacketResult::ErrorSendFailed;
+  }
+
+  return SendPacketsAndWaitForResponsesNoLock(payloads, responses);
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteClientBase::SendPacketsAndWaitForResponsesNoLock(
+    llvm::ArrayRef<std::string> payloads,
+    std::vector<StringExtractorGDBRemote> &responses) {
+  responses.clear();
+  responses.reserve(payloads.size());
+
+  // With acks, every packet has to be acknowledged before the next one can be
+  // sent, so there is nothing to be gained by having more than one in flight.
+  const size_t max_in_flight = GetSendAcks() ? 1 : kMaxPacketsInFlight;
+
+  PacketResult send_result = PacketResult::Success;
+  size_t num_sent = 0;
+  while (responses.size() < payloads.size()) {
+    while (send_result == PacketResult::Success &&
+           num_sent < payloads.size() &&
+           num_sent - responses.size() < max_in_flight) {
+      send_result = SendPacketNoLock(payloads[num_sent]);
+      if (send_result == PacketResult::Success)
+        ++num_sent;
+    }
+
+    // Even if sending failed, collect the responses to the packets that
+    // already went out so that they are not mistaken for responses to later
+    // packets.
+    if (responses.size() == num_sent)
+      return send_result;
+
+    responses.emplace_back();
+    PacketResult packet_result =
+        ReadPacket(responses.back(), GetPacketTimeout(), true);
+    if (packet_result != PacketResult::Success) {
+      responses.pop_back();
+      return packet_result;
+    }
+  }
+  return PacketResult::Success;
+}
+
+static const char *const g_latency_buckets[] = {
+    "<10us", "<100us", "<1ms", "<10ms", "<100ms", "<1s", ">=1s"};
+
+void GDBRemoteClientBase::RecordRoundTrip(llvm::StringRef payload,
+                                          nanoseconds duration) {
+  // Group the packets by name: the queries and the "v" and "j" packets are
+  // named by their leading letters, breakpoint packets by the letter and the
+  // type, and the others by their first character.
+  llvm::StringRef kind;
+  if (!payload.empty()) {
+    switch (payload[0]) {
+    case 'q':
+    case 'Q':
+    case 'v':
+    case 'j':
+      kind = payload.take_while(
+          [](char c) { return llvm::isAlpha(c) || c == '_'; });
+      break;
+    case 'Z':
+    case 'z':
+    case '_':
+      kind = payload.take_front(2);
+      break;
+    default:
+      kind = payload.take_front(1);
+      break;
+    }
+  }
+
+  const size_t num_buckets = llvm::array_lengthof(g_latency_buckets);
+  size_t bucket = 0;
+  for (nanoseconds limit = microseconds(10);
+       bucket + 1 < num_buckets && duration >= limit; limit *= 10)
+    ++bucket;
+
+  std::lock_guard<std::mutex> guard(m_packet_stats_mutex);
+  PacketStats &stats = m_packet_stats[kind];
+  ++stats.count;
+  stats.total_time += duration;
+  ++stats.latency_histogram[bucket];
+}
+
+StructuredData::DictionarySP GDBRemoteClientBase::GetPacketStatistics() {
+  auto packets_sp = std::make_shared<StructuredData::Dictionary>();
+  std::lock_guard<std::mutex> guard(m_packet_stats_mutex);
+  for (const auto &entry : m_packet_stats) {
+    const PacketStats &stats = entry.second;
+    auto histogram_sp = std::make_shared<StructuredData::Dictionary>();
+    for (size_t i = 0; i < stats.latency_histogram.size(); ++i)
+      histogram_sp->AddIntegerItem(g_latency_buckets[i],
+                                   stats.latency_histogram[i]);
+
+    auto kind_sp = std::make_shared<StructuredData::Dictionary>();
+    kind_sp->AddIntegerItem("count", stats.count);
+    kind_sp->AddFloatItem("totalTime",
+                          duration<double>(stats.total_time).count());
+    kind_sp->AddItem("latencyHistogram", histogram_sp);
+    packets_sp->AddItem(entry.first(), kind_sp);
+  }
+  return packets_sp;
+}
+
 bool GDBRemoteClientBase::SendvContPacket(llvm::StringRef payload,
                                           StringExtractorGDBRemote &response) {
   Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_PROCESS));
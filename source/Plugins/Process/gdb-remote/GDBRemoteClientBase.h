@@ -11,6 +11,10 @@
 
 #include "GDBRemoteCommunication.h"
 
+#include "lldb/Utility/StructuredData.h"
+#include "llvm/ADT/StringMap.h"
+
+#include <array>
 #include <condition_variable>
 
 namespace lldb_private {
@@ -50,9 +54,40 @@ public:
       bool send_async,
       llvm::function_ref<void(llvm::StringRef)> output_callback);
 
+  /// Send several independent packets and wait for all of their responses.
+  ///
+  /// Unlike SendPacketAndWaitForResponse, this does not wait for the response
+  /// to one packet before sending the next one, so the round trip latency of
+  /// the connection is paid only once for the whole batch. The packets must
+  /// not depend on each other's results (e.g. "p", "x" or
+  /// "qMemoryRegionInfo" queries). Responses are matched to the packets in
+  /// the order they were sent. At most kMaxPacketsInFlight packets are
+  /// outstanding at any time, so this should only be used for packets whose
+  /// responses are reasonably small. If the connection still uses acks, the
+  /// packets are sent one at a time.
+  ///
+  /// \param[in] payloads
+  ///     The payloads of the packets to send.
+  ///
+  /// \param[out] responses
+  ///     Receives one response per payload, in the same order. If an error
+  ///     occurs, it only holds the responses that were received before it.
+  ///
+  /// \return
+  ///     PacketResult::Success if a response was received for every packet,
+  ///     the first error encountered otherwise.
+  PacketResult SendPacketsAndWaitForResponses(
+      llvm::ArrayRef<std::string> payloads,
+      std::vector<StringExtractorGDBRemote> &responses, bool send_async);
+
   bool SendvContPacket(llvm::StringRef payload,
                        StringExtractorGDBRemote &response);
 
+  /// Get the number of round trips made for each kind of packet, how long
+  /// they took in total and a histogram of their latencies. Packets are
+  /// grouped by their name ("qXfer", "vCont", "Z0", "m", ...).
+  StructuredData::DictionarySP GetPacketStatistics();
+
   class Lock {
   public:
     Lock(GDBRemoteClientBase &comm, bool interrupt);
@@ -78,6 +113,15 @@ protected:
   SendPacketAndWaitForResponseNoLock(llvm::StringRef payload,
                                      StringExtractorGDBRemote &response);
 
+  PacketResult SendPacketsAndWaitForResponsesNoLock(
+      llvm::ArrayRef<std::string> payloads,
+      std::vector<StringExtractorGDBRemote> &responses);
+
+  /// The maximum number of packets SendPacketsAndWaitForResponses keeps
+  /// outstanding. This bounds the amount of response data that can pile up
+  /// in the connection while we are still sending.
+  static const size_t kMaxPacketsInFlight = 16;
+
   virtual void OnRunPacketSent(bool first);
 
 private:
@@ -128,6 +172,20 @@ private:
   bool ShouldStop(const UnixSignals &signals,
                   StringExtractorGDBRemote &response);
 
+  /// Round trip statistics for one kind of packet. The histogram buckets are
+  /// powers of ten, from under 10us to 1s and over.
+  struct PacketStats {
+    uint64_t count = 0;
+    std::chrono::nanoseconds total_time{0};
+    std::array<uint64_t, 7> latency_histogram{};
+  };
+
+  void RecordRoundTrip(llvm::StringRef payload,
+                       std::chrono::nanoseconds duration);
+
+  std::mutex m_packet_stats_mutex;
+  llvm::StringMap<PacketStats> m_packet_stats;
+
   class ContinueLock {
   public:
     enum class LockResult { Success, Cancelled, Failed };
@@ -121,6 +121,12 @@ size_t GDBRemoteCommunication::SendNack() {
 
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunication::SendPacketNoLock(llvm::StringRef payload) {
+  std::string compressed_payload;
+  if (m_send_compression_type != CompressionType::None) {
+    compressed_payload = CompressPayload(payload);
+    payload = compressed_payload;
+  }
+
   StreamString packet(0, 4, eByteOrderBig);
   packet.PutChar('$');
   packet.Write(payload.data(), payload.size());
@@ -131,6 +137,22 @@ GDBRemoteCommunication::SendPacketNoLock(llvm::StringRef payload) {
   return SendRawPacketNoLock(packet_str);
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunication::SendNotificationPacketNoLock(
+    llvm::StringRef notify_type, llvm::StringRef payload) {
+  StreamString body;
+  body << notify_type << ':' << payload;
+
+  StreamString packet(0, 4, eByteOrderBig);
+  packet.PutChar('%');
+  packet.Write(body.GetData(), body.GetSize());
+  packet.PutChar('#');
+  packet.PutHex8(CalculcateChecksum(body.GetString()));
+  std::string packet_str = packet.GetString();
+
+  return SendRawPacketNoLock(packet_str, /*skip_ack=*/true);
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunication::SendRawPacketNoLock(llvm::StringRef packet,
                                             bool skip_ack) {
@@ -430,9 +452,11 @@ bool GDBRemoteCommunication::DecompressPacket() {
   if (m_bytes[1] != 'C' && m_bytes[1] != 'N')
     return true;
 
-  size_t hash_mark_idx = m_bytes.find('#');
-  if (hash_mark_idx == std::string::npos)
+  size_t hash_mark_idx = m_bytes.find('#', m_bytes_search_pos);
+  if (hash_mark_idx == std::string::npos) {
+    m_bytes_search_pos = m_bytes.size();
     return true;
+  }
   if (hash_mark_idx + 2 >= m_bytes.size())
     return true;
 
@@ -474,6 +498,7 @@ bool GDBRemoteCommunication::DecompressPacket() {
       decompressed_bufsize = ::strtoul(bufsize_str.c_str(), nullptr, 10);
       if (errno != 0 || decompressed_bufsize == ULONG_MAX) {
         m_bytes.erase(0, size_of_first_packet);
+        m_bytes_search_pos = 0;
         return false;
       }
     }
@@ -499,6 +524,7 @@ bool GDBRemoteCommunication::DecompressPacket() {
     if (!success) {
       SendNack();
       m_bytes.erase(0, size_of_first_packet);
+      m_bytes_search_pos = 0;
       return false;
     } else {
       SendAck();
@@ -509,6 +535,7 @@ bool GDBRemoteCommunication::DecompressPacket() {
     // This packet was not compressed -- delete the 'N' character at the start
     // and the packet may be processed as-is.
     m_bytes.erase(1, 1);
+    m_bytes_search_pos = 0;
     return true;
   }
 
@@ -534,6 +561,7 @@ bool GDBRemoteCommunication::DecompressPacket() {
     decompressed_buffer = (uint8_t *)malloc(decompressed_bufsize);
     if (decompressed_buffer == nullptr) {
       m_bytes.erase(0, size_of_first_packet);
+      m_bytes_search_pos = 0;
       return false;
     }
   }
@@ -614,6 +642,7 @@ bool GDBRemoteCommunication::DecompressPacket() {
     if (decompressed_buffer)
       free(decompressed_buffer);
     m_bytes.erase(0, size_of_first_packet);
+    m_bytes_search_pos = 0;
     return false;
   }
 
@@ -635,11 +664,62 @@ bool GDBRemoteCommunication::DecompressPacket() {
 
   m_bytes.replace(0, size_of_first_packet, new_packet.data(),
                   new_packet.size());
+  m_bytes_search_pos = 0;
 
   free(decompressed_buffer);
   return true;
 }
 
+std::string GDBRemoteCommunication::CompressPayload(llvm::StringRef payload) {
+#if defined(HAVE_LIBZ)
+  if (m_send_compression_type == CompressionType::ZlibDeflate &&
+      payload.size() >= m_send_compression_minsize) {
+    z_stream stream;
+    memset(&stream, 0, sizeof(z_stream));
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+
+    // Raw DEFLATE, without the zlib header, as DecompressPacket expects.
+    if (deflateInit2(&stream, 5, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) ==
+        Z_OK) {
+      std::vector<uint8_t> compressed(deflateBound(&stream, payload.size()));
+      stream.next_in = (Bytef *)payload.data();
+      stream.avail_in = (uInt)payload.size();
+      stream.next_out = (Bytef *)compressed.data();
+      stream.avail_out = (uInt)compressed.size();
+      int status = deflate(&stream, Z_FINISH);
+      const size_t compressed_size = stream.total_out;
+      deflateEnd(&stream);
+
+      if (status == Z_STREAM_END) {
+        // Escape the characters that have a special meaning in the packet
+        // framing, like the binary data in the reply to the 'x' packet.
+        std::string result = "C" + std::to_string(payload.size()) + ":";
+        result.reserve(result.size() + compressed_size);
+        for (size_t i = 0; i < compressed_size; ++i) {
+          const char c = compressed[i];
+          if (c == '#' || c == '$' || c == '}' || c == '*') {
+            result.push_back('}');
+            result.push_back(c ^ 0x20);
+          } else {
+            result.push_back(c);
+          }
+        }
+        if (result.size() < payload.size())
+          return result;
+      }
+    }
+  }
+#endif
+
+  std::string result;
+  result.reserve(payload.size() + 1);
+  result.push_back('N');
+  result.append(payload.data(), payload.size());
+  return result;
+}
+
 GDBRemoteCommunication::PacketType
 GDBRemoteCommunication::CheckForPacket(const uint8_t *src, size_t src_len,
                                        StringExtractorGDBRemote &packet) {
@@ -656,6 +736,9 @@ GDBRemoteCommunication::CheckForPacket(const uint8_t *src, size_t src_len,
     }
     m_bytes.append((const char *)src, src_len);
   }
+  // Somebody else consumed bytes from m_bytes, start over.
+  if (m_bytes_search_pos > m_bytes.size())
+    m_bytes_search_pos = 0;
 
   bool isNotifyPacket = false;
 
@@ -691,8 +774,11 @@ GDBRemoteCommunication::CheckForPacket(const uint8_t *src, size_t src_len,
     case '$':
       // Look for a standard gdb packet?
       {
-        size_t hash_pos = m_bytes.find('#');
-        if (hash_pos != std::string::npos) {
+        size_t hash_pos = m_bytes.find('#', m_bytes_search_pos);
+        if (hash_pos == std::string::npos) {
+          m_bytes_search_pos = m_bytes.size();
+        } else {
+          m_bytes_search_pos = hash_pos;
           if (hash_pos + 2 < m_bytes.size()) {
             checksum_idx = hash_pos + 1;
             // Skip the dollar sign
@@ -736,6 +822,7 @@ GDBRemoteCommunication::CheckForPacket(const uint8_t *src, size_t src_len,
       LLDB_LOGF(log, "GDBRemoteCommunication::%s tossing %u junk bytes: '%.*s'",
                 __FUNCTION__, idx - 1, idx - 1, m_bytes.c_str());
       m_bytes.erase(0, idx - 1);
+      m_bytes_search_pos = 0;
     } break;
     }
 
@@ -813,32 +900,41 @@ GDBRemoteCommunication::CheckForPacket(const uint8_t *src, size_t src_len,
                           total_length);
 
       // Copy the packet from m_bytes to packet_str expanding the run-length
-      // encoding in the process. Reserve enough byte for the most common case
-      // (no RLE used)
-      std ::string packet_str;
-      packet_str.reserve(m_bytes.length());
-      for (std::string::const_iterator c = m_bytes.begin() + content_start;
-           c != m_bytes.begin() + content_end; ++c) {
-        if (*c == '*') {
+      // encoding in the process. Reserve enough bytes for the most common case
+      // (no RLE used), and copy everything up to the first RLE or escape
+      // character in one go. Most packets have neither.
+      const size_t first_special = std::min(
+          llvm::StringRef(m_bytes)
+              .slice(content_start, content_end)
+              .find_first_of("*}"),
+          content_length);
+      std::string packet_str;
+      packet_str.reserve(content_length);
+      packet_str.append(m_bytes, content_start, first_special);
+      for (size_t i = content_start + first_special; i < content_end; ++i) {
+        const char c = m_bytes[i];
+        if (c == '*') {
           // '*' indicates RLE. Next character will give us the repeat count
           // and previous character is what is to be repeated.
           char char_to_repeat = packet_str.back();
           // Number of time the previous character is repeated
-          int repeat_count = *++c + 3 - ' ';
+          int repeat_count = m_bytes[++i] + 3 - ' ';
           // We have the char_to_repeat and repeat_count. Now push it in the
           // packet.
-          for (int i = 0; i < repeat_count; ++i)
-            packet_str.push_back(char_to_repeat);
-        } else if (*c == 0x7d) {
+          packet_str.append(repeat_count, char_to_repeat);
+        } else if (c == 0x7d) {
           // 0x7d is the escape character.  The next character is to be XOR'd
           // with 0x20.
-          char escapee = *++c ^ 0x20;
+          char escapee = m_bytes[++i] ^ 0x20;
           packet_str.push_back(escapee);
         } else {
-          packet_str.push_back(*c);
+          packet_str.push_back(c);
         }
       }
-      packet = StringExtractorGDBRemote(packet_str);
+      // Hand the decoded string over to the packet instead of copying it
+      // again. Like assigning a new extractor did, this drops the validator.
+      packet = StringExtractorGDBRemote();
+      packet.Reset(std::move(packet_str));
 
       if (m_bytes[0] == '$' || m_bytes[0] == '%') {
         assert(checksum_idx < m_bytes.size());
@@ -871,6 +967,7 @@ GDBRemoteCommunication::CheckForPacket(const uint8_t *src, size_t src_len,
       }
 
       m_bytes.erase(0, total_length);
+      m_bytes_search_pos = 0;
       packet.SetFilePos(0);
 
       if (isNotifyPacket)
@@ -928,7 +1025,8 @@ GDBRemoteCommunication::ListenThread(lldb::thread_arg_t arg) {
 
 Status GDBRemoteCommunication::StartDebugserverProcess(
     const char *url, Platform *platform, ProcessLaunchInfo &launch_info,
-    uint16_t *port, const Args *inferior_args, int pass_comm_fd) {
+    uint16_t *port, const Args *inferior_args, int pass_comm_fd,
+    int pass_shm_fd) {
   Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_PROCESS));
   LLDB_LOGF(log, "GDBRemoteCommunication::%s(url=%s, port=%" PRIu16 ")",
             __FUNCTION__, url ? url : "<empty>", port ? *port : uint16_t(0));
@@ -1016,6 +1114,13 @@ Status GDBRemoteCommunication::StartDebugserverProcess(
       // Send "pass_comm_fd" down to the inferior so it can use it to
       // communicate back with this process
       launch_info.AppendDuplicateFileAction(pass_comm_fd, pass_comm_fd);
+
+      if (pass_shm_fd >= 0) {
+        StreamString shm_fd_arg;
+        shm_fd_arg.Printf("--shm-fd=%i", pass_shm_fd);
+        debugserver_args.AppendArgument(shm_fd_arg.GetString());
+        launch_info.AppendDuplicateFileAction(pass_shm_fd, pass_shm_fd);
+      }
     }
 
     // use native registers, not the GDB registers
@@ -129,8 +129,10 @@ public:
       Platform *platform, // If non nullptr, then check with the platform for
                           // the GDB server binary if it can't be located
       ProcessLaunchInfo &launch_info, uint16_t *port, const Args *inferior_args,
-      int pass_comm_fd); // Communication file descriptor to pass during
-                         // fork/exec to avoid having to connect/accept
+      int pass_comm_fd, // Communication file descriptor to pass during
+                        // fork/exec to avoid having to connect/accept
+      int pass_shm_fd); // Shared memory, from ConnectionSharedMemory, to pass
+                        // along with pass_comm_fd, or -1
 
   void DumpHistory(Stream &strm);
   void SetHistoryStream(llvm::raw_ostream *strm);
@@ -150,10 +152,27 @@ protected:
 
   CompressionType m_compression_type;
 
+  // The compression a debug stub applies to the packets it sends, as
+  // requested by the client with QEnableCompression. Payloads smaller than
+  // m_send_compression_minsize bytes are sent uncompressed.
+  CompressionType m_send_compression_type = CompressionType::None;
+  size_t m_send_compression_minsize = 384;
+
+  // How far into m_bytes the packet at its start has already been searched
+  // for the '#' that ends it, so that a large packet arriving over many reads
+  // isn't rescanned from the beginning every time. Reset whenever bytes are
+  // removed from the front of m_bytes.
+  size_t m_bytes_search_pos = 0;
+
   PacketResult SendPacketNoLock(llvm::StringRef payload);
   PacketResult SendRawPacketNoLock(llvm::StringRef payload,
                                    bool skip_ack = false);
 
+  // Send an asynchronous "%<notify_type>:<payload>" notification, used by
+  // non-stop mode. Notifications are not acknowledged.
+  PacketResult SendNotificationPacketNoLock(llvm::StringRef notify_type,
+                                            llvm::StringRef payload);
+
   PacketResult ReadPacket(StringExtractorGDBRemote &response,
                           Timeout<std::micro> timeout, bool sync_on_timeout);
 
@@ -185,6 +204,12 @@ protected:
   // on m_bytes.  The checksum was for the compressed packet.
   bool DecompressPacket();
 
+  // Turn the payload of a packet into the "N<payload>" or
+  // "C<size>:<compressed payload>" form used once m_send_compression_type is
+  // enabled. Falls back to "N" if the payload is too small or cannot be
+  // compressed.
+  std::string CompressPayload(llvm::StringRef payload);
+
   Status StartListenThread(const char *hostname = "127.0.0.1",
                            uint16_t port = 0);
 
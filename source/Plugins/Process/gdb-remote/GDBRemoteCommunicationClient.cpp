@@ -11,6 +11,7 @@
 #include <math.h>
 #include <sys/stat.h>
 
+#include <map>
 #include <numeric>
 #include <sstream>
 
@@ -68,7 +69,8 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient()
       m_watchpoints_trigger_after_instruction(eLazyBoolCalculate),
       m_attach_or_wait_reply(eLazyBoolCalculate),
       m_prepare_for_reg_writing_reply(eLazyBoolCalculate),
-      m_supports_p(eLazyBoolCalculate), m_supports_x(eLazyBoolCalculate),
+      m_supports_p(eLazyBoolCalculate), m_supports_g(eLazyBoolCalculate),
+      m_supports_x(eLazyBoolCalculate),
       m_avoid_g_packets(eLazyBoolCalculate),
       m_supports_QSaveRegisterState(eLazyBoolCalculate),
       m_supports_qXfer_auxv_read(eLazyBoolCalculate),
@@ -77,10 +79,16 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient()
       m_supports_qXfer_features_read(eLazyBoolCalculate),
       m_supports_qXfer_memory_map_read(eLazyBoolCalculate),
       m_supports_augmented_libraries_svr4_read(eLazyBoolCalculate),
+      m_supports_libraries_svr4_delta(eLazyBoolCalculate),
       m_supports_jThreadExtendedInfo(eLazyBoolCalculate),
       m_supports_jLoadedDynamicLibrariesInfos(eLazyBoolCalculate),
       m_supports_jGetSharedCacheInfo(eLazyBoolCalculate),
       m_supports_QPassSignals(eLazyBoolCalculate),
+      m_supports_MultiMemRead(eLazyBoolCalculate),
+      m_supports_ConditionalBreakpoints(eLazyBoolCalculate),
+      m_supports_BreakpointStepOver(eLazyBoolCalculate),
+      m_supports_jTraceBinary(eLazyBoolCalculate),
+      m_supports_jThreadsInfo_delta(eLazyBoolCalculate),
       m_supports_error_string_reply(eLazyBoolCalculate),
       m_supports_qProcessInfoPID(true), m_supports_qfProcessInfo(true),
       m_supports_qUserName(true), m_supports_qGroupName(true),
@@ -90,6 +98,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient()
       m_supports_QEnvironmentHexEncoded(true), m_supports_qSymbol(true),
       m_qSymbol_requests_done(false), m_supports_qModuleInfo(true),
       m_supports_jThreadsInfo(true), m_supports_jModulesInfo(true),
+      m_supports_qSearchMemory(true),
       m_curr_pid(LLDB_INVALID_PROCESS_ID), m_curr_tid(LLDB_INVALID_THREAD_ID),
       m_curr_tid_run(LLDB_INVALID_THREAD_ID),
       m_num_supported_hardware_watchpoints(0), m_host_arch(), m_process_arch(),
@@ -150,6 +159,41 @@ bool GDBRemoteCommunicationClient::GetQPassSignalsSupported() {
   return m_supports_QPassSignals == eLazyBoolYes;
 }
 
+bool GDBRemoteCommunicationClient::GetMultiMemReadSupported() {
+  if (m_supports_MultiMemRead == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_MultiMemRead == eLazyBoolYes;
+}
+
+bool GDBRemoteCommunicationClient::GetConditionalBreakpointsSupported() {
+  if (m_supports_ConditionalBreakpoints == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_ConditionalBreakpoints == eLazyBoolYes;
+}
+
+bool GDBRemoteCommunicationClient::GetBreakpointStepOverSupported() {
+  if (m_supports_BreakpointStepOver == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_BreakpointStepOver == eLazyBoolYes;
+}
+
+bool GDBRemoteCommunicationClient::GetTraceBinarySupported() {
+  if (m_supports_jTraceBinary == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_jTraceBinary == eLazyBoolYes;
+}
+
+bool GDBRemoteCommunicationClient::GetThreadsInfoDeltaSupported() {
+  if (m_supports_jThreadsInfo_delta == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_jThreadsInfo_delta == eLazyBoolYes;
+}
+
 bool GDBRemoteCommunicationClient::GetAugmentedLibrariesSVR4ReadSupported() {
   if (m_supports_augmented_libraries_svr4_read == eLazyBoolCalculate) {
     GetRemoteQSupported();
@@ -157,6 +201,13 @@ bool GDBRemoteCommunicationClient::GetAugmentedLibrariesSVR4ReadSupported() {
   return m_supports_augmented_libraries_svr4_read == eLazyBoolYes;
 }
 
+bool GDBRemoteCommunicationClient::GetLibrariesSVR4DeltaSupported() {
+  if (m_supports_libraries_svr4_delta == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_libraries_svr4_delta == eLazyBoolYes;
+}
+
 bool GDBRemoteCommunicationClient::GetQXferLibrariesSVR4ReadSupported() {
   if (m_supports_qXfer_libraries_svr4_read == eLazyBoolCalculate) {
     GetRemoteQSupported();
@@ -275,6 +326,7 @@ void GDBRemoteCommunicationClient::ResetDiscoverableSettings(bool did_exec) {
     m_supports_vCont_s = eLazyBoolCalculate;
     m_supports_vCont_S = eLazyBoolCalculate;
     m_supports_p = eLazyBoolCalculate;
+    m_supports_g = eLazyBoolCalculate;
     m_supports_x = eLazyBoolCalculate;
     m_supports_QSaveRegisterState = eLazyBoolCalculate;
     m_qHostInfo_is_valid = eLazyBoolCalculate;
@@ -291,6 +343,13 @@ void GDBRemoteCommunicationClient::ResetDiscoverableSettings(bool did_exec) {
     m_supports_qXfer_features_read = eLazyBoolCalculate;
     m_supports_qXfer_memory_map_read = eLazyBoolCalculate;
     m_supports_augmented_libraries_svr4_read = eLazyBoolCalculate;
+    m_supports_libraries_svr4_delta = eLazyBoolCalculate;
+    m_supports_MultiMemRead = eLazyBoolCalculate;
+    m_supports_ConditionalBreakpoints = eLazyBoolCalculate;
+    m_supports_BreakpointStepOver = eLazyBoolCalculate;
+    m_supports_jTraceBinary = eLazyBoolCalculate;
+    m_supports_jThreadsInfo_delta = eLazyBoolCalculate;
+    m_threads_info_sp.reset();
     m_supports_qProcessInfoPID = true;
     m_supports_qfProcessInfo = true;
     m_supports_qUserName = true;
@@ -319,6 +378,7 @@ void GDBRemoteCommunicationClient::ResetDiscoverableSettings(bool did_exec) {
     m_supported_async_json_packets_is_valid = false;
     m_supported_async_json_packets_sp.reset();
     m_supports_jModulesInfo = true;
+    m_supports_qSearchMemory = true;
   }
 
   // These flags should be reset when we first connect to a GDB server and when
@@ -333,6 +393,7 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
   m_supports_qXfer_libraries_read = eLazyBoolNo;
   m_supports_qXfer_libraries_svr4_read = eLazyBoolNo;
   m_supports_augmented_libraries_svr4_read = eLazyBoolNo;
+  m_supports_libraries_svr4_delta = eLazyBoolNo;
   m_supports_qXfer_features_read = eLazyBoolNo;
   m_supports_qXfer_memory_map_read = eLazyBoolNo;
   m_max_packet_size = UINT64_MAX; // It's supposed to always be there, but if
@@ -365,6 +426,8 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
       m_supports_qXfer_libraries_svr4_read = eLazyBoolYes; // implied
       m_supports_augmented_libraries_svr4_read = eLazyBoolYes;
     }
+    if (::strstr(response_cstr, "libraries-svr4-delta+"))
+      m_supports_libraries_svr4_delta = eLazyBoolYes;
     if (::strstr(response_cstr, "qXfer:libraries:read+"))
       m_supports_qXfer_libraries_read = eLazyBoolYes;
     if (::strstr(response_cstr, "qXfer:features:read+"))
@@ -375,44 +438,41 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
     // Look for a list of compressions in the features list e.g.
     // qXfer:features:read+;PacketSize=20000;qEcho+;SupportedCompressions=zlib-
     // deflate,lzma
-    const char *features_list = ::strstr(response_cstr, "qXfer:features:");
-    if (features_list) {
-      const char *compressions =
-          ::strstr(features_list, "SupportedCompressions=");
-      if (compressions) {
-        std::vector<std::string> supported_compressions;
-        compressions += sizeof("SupportedCompressions=") - 1;
-        const char *end_of_compressions = strchr(compressions, ';');
-        if (end_of_compressions == nullptr) {
-          end_of_compressions = strchr(compressions, '\0');
+    const char *compressions =
+        ::strstr(response_cstr, "SupportedCompressions=");
+    if (compressions && m_compression_allowed) {
+      std::vector<std::string> supported_compressions;
+      compressions += sizeof("SupportedCompressions=") - 1;
+      const char *end_of_compressions = strchr(compressions, ';');
+      if (end_of_compressions == nullptr) {
+        end_of_compressions = strchr(compressions, '\0');
+      }
+      const char *current_compression = compressions;
+      while (current_compression < end_of_compressions) {
+        const char *next_compression_name = strchr(current_compression, ',');
+        const char *end_of_this_word = next_compression_name;
+        if (next_compression_name == nullptr ||
+            end_of_compressions < next_compression_name) {
+          end_of_this_word = end_of_compressions;
         }
-        const char *current_compression = compressions;
-        while (current_compression < end_of_compressions) {
-          const char *next_compression_name = strchr(current_compression, ',');
-          const char *end_of_this_word = next_compression_name;
-          if (next_compression_name == nullptr ||
-              end_of_compressions < next_compression_name) {
-            end_of_this_word = end_of_compressions;
-          }
 
-          if (end_of_this_word) {
-            if (end_of_this_word == current_compression) {
-              current_compression++;
-            } else {
-              std::string this_compression(
-                  current_compression, end_of_this_word - current_compression);
-              supported_compressions.push_back(this_compression);
-              current_compression = end_of_this_word + 1;
-            }
+        if (end_of_this_word) {
+          if (end_of_this_word == current_compression) {
+            current_compression++;
           } else {
-            supported_compressions.push_back(current_compression);
-            current_compression = end_of_compressions;
+            std::string this_compression(
+                current_compression, end_of_this_word - current_compression);
+            supported_compressions.push_back(this_compression);
+            current_compression = end_of_this_word + 1;
           }
+        } else {
+          supported_compressions.push_back(current_compression);
+          current_compression = end_of_compressions;
         }
+      }
 
-        if (supported_compressions.size() > 0) {
-          MaybeEnableCompression(supported_compressions);
-        }
+      if (supported_compressions.size() > 0) {
+        MaybeEnableCompression(supported_compressions);
       }
     }
 
@@ -426,6 +486,31 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
     else
       m_supports_QPassSignals = eLazyBoolNo;
 
+    if (::strstr(response_cstr, "MultiMemRead+"))
+      m_supports_MultiMemRead = eLazyBoolYes;
+    else
+      m_supports_MultiMemRead = eLazyBoolNo;
+
+    if (::strstr(response_cstr, "ConditionalBreakpoints+"))
+      m_supports_ConditionalBreakpoints = eLazyBoolYes;
+    else
+      m_supports_ConditionalBreakpoints = eLazyBoolNo;
+
+    if (::strstr(response_cstr, "BreakpointStepOver+"))
+      m_supports_BreakpointStepOver = eLazyBoolYes;
+    else
+      m_supports_BreakpointStepOver = eLazyBoolNo;
+
+    if (::strstr(response_cstr, "jTraceBinary+"))
+      m_supports_jTraceBinary = eLazyBoolYes;
+    else
+      m_supports_jTraceBinary = eLazyBoolNo;
+
+    if (::strstr(response_cstr, "jThreadsInfo-delta+"))
+      m_supports_jThreadsInfo_delta = eLazyBoolYes;
+    else
+      m_supports_jThreadsInfo_delta = eLazyBoolNo;
+
     const char *packet_size_str = ::strstr(response_cstr, "PacketSize=");
     if (packet_size_str) {
       StringExtractorGDBRemote packet_response(packet_size_str +
@@ -563,20 +648,98 @@ StructuredData::ObjectSP GDBRemoteCommunicationClient::GetThreadsInfo() {
   StructuredData::ObjectSP object_sp;
 
   if (m_supports_jThreadsInfo) {
+    // Name the generation of the thread infos we have, so that only the
+    // threads that changed since are sent in full.
+    const bool delta = GetThreadsInfoDeltaSupported();
+    const bool has_generation = delta && m_threads_info_sp;
+    StreamGDBRemote packet;
+    packet.PutCString("jThreadsInfo");
+    if (delta) {
+      StreamString json;
+      if (has_generation)
+        json.Printf("{\"generation\":%u}", m_threads_info_generation);
+      else
+        json.PutCString("{}");
+      packet.PutChar(':');
+      packet.PutEscapedBytes(json.GetData(), json.GetSize());
+    }
     StringExtractorGDBRemote response;
     response.SetResponseValidatorToJSON();
-    if (SendPacketAndWaitForResponse("jThreadsInfo", response, false) ==
+    if (SendPacketAndWaitForResponse(packet.GetString(), response, false) ==
         PacketResult::Success) {
       if (response.IsUnsupportedResponse()) {
         m_supports_jThreadsInfo = false;
       } else if (!response.Empty()) {
         object_sp = StructuredData::ParseJSON(response.GetStringRef());
+        if (delta)
+          object_sp = ApplyThreadsInfoDelta(object_sp);
       }
     }
+    // A delta we couldn't apply dropped the thread infos we had, ask for all
+    // of them instead.
+    if (has_generation && !object_sp && m_supports_jThreadsInfo)
+      return GetThreadsInfo();
   }
   return object_sp;
 }
 
+StructuredData::ObjectSP GDBRemoteCommunicationClient::ApplyThreadsInfoDelta(
+    const StructuredData::ObjectSP &reply_sp) {
+  StructuredData::Dictionary *reply =
+      reply_sp ? reply_sp->GetAsDictionary() : nullptr;
+  StructuredData::Array *threads = nullptr;
+  uint32_t generation = 0;
+  if (!reply || !reply->GetValueForKeyAsArray("threads", threads) ||
+      !reply->GetValueForKeyAsInteger("generation", generation)) {
+    m_threads_info_sp.reset();
+    return StructuredData::ObjectSP();
+  }
+
+  // Threads that didn't change are sent as {"tid":<tid>,"unchanged":true},
+  // take those from the thread infos the delta is against.
+  uint32_t base_generation = 0;
+  std::map<lldb::tid_t, StructuredData::ObjectSP> prev_threads;
+  if (reply->GetValueForKeyAsInteger("base-generation", base_generation)) {
+    StructuredData::Array *prev_array =
+        m_threads_info_sp ? m_threads_info_sp->GetAsArray() : nullptr;
+    if (!prev_array || base_generation != m_threads_info_generation) {
+      m_threads_info_sp.reset();
+      return StructuredData::ObjectSP();
+    }
+    prev_array->ForEach([&prev_threads](StructuredData::Object *object) {
+      lldb::tid_t tid;
+      if (StructuredData::Dictionary *thread_dict = object->GetAsDictionary())
+        if (thread_dict->GetValueForKeyAsInteger("tid", tid))
+          prev_threads.emplace(tid, thread_dict->shared_from_this());
+      return true;
+    });
+  }
+
+  auto threads_sp = std::make_shared<StructuredData::Array>();
+  for (size_t i = 0; i < threads->GetSize(); ++i) {
+    StructuredData::ObjectSP thread_sp = threads->GetItemAtIndex(i);
+    StructuredData::Dictionary *thread_dict =
+        thread_sp ? thread_sp->GetAsDictionary() : nullptr;
+    bool unchanged = false;
+    if (thread_dict &&
+        thread_dict->GetValueForKeyAsBoolean("unchanged", unchanged) &&
+        unchanged) {
+      lldb::tid_t tid = LLDB_INVALID_THREAD_ID;
+      thread_dict->GetValueForKeyAsInteger("tid", tid);
+      auto pos = prev_threads.find(tid);
+      if (pos == prev_threads.end()) {
+        m_threads_info_sp.reset();
+        return StructuredData::ObjectSP();
+      }
+      thread_sp = pos->second;
+    }
+    threads_sp->AddItem(thread_sp);
+  }
+  m_threads_info_sp = threads_sp;
+  m_threads_info_generation = generation;
+  return threads_sp;
+}
+
 bool GDBRemoteCommunicationClient::GetThreadExtendedInfoSupported() {
   if (m_supports_jThreadExtendedInfo == eLazyBoolCalculate) {
     StringExtractorGDBRemote response;
@@ -606,6 +769,18 @@ void GDBRemoteCommunicationClient::EnableErrorStringInPacket() {
   }
 }
 
+bool GDBRemoteCommunicationClient::SetExpeditedStackMemory(
+    uint64_t stack_size, uint32_t frame_count) {
+  StreamString packet;
+  packet.Printf("QSetExpeditedStackMemory:size:%" PRIx64 ";frames:%x;",
+                stack_size, frame_count);
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse(packet.GetString(), response, false) !=
+      PacketResult::Success)
+    return false;
+  return response.IsOKResponse();
+}
+
 bool GDBRemoteCommunicationClient::GetLoadedDynamicLibrariesInfosSupported() {
   if (m_supports_jLoadedDynamicLibrariesInfos == eLazyBoolCalculate) {
     StringExtractorGDBRemote response;
@@ -2658,7 +2833,8 @@ bool GDBRemoteCommunicationClient::GetThreadStopInfo(
 }
 
 uint8_t GDBRemoteCommunicationClient::SendGDBStoppointTypePacket(
-    GDBStoppointType type, bool insert, addr_t addr, uint32_t length) {
+    GDBStoppointType type, bool insert, addr_t addr, uint32_t length,
+    llvm::ArrayRef<AgentExpression> conditions) {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
   LLDB_LOGF(log, "GDBRemoteCommunicationClient::%s() %s at addr = 0x%" PRIx64,
             __FUNCTION__, insert ? "add" : "remove", addr);
@@ -2667,50 +2843,87 @@ uint8_t GDBRemoteCommunicationClient::SendGDBStoppointTypePacket(
   if (!SupportsGDBStoppointPacket(type))
     return UINT8_MAX;
   // Construct the breakpoint packet
-  char packet[64];
-  const int packet_len =
-      ::snprintf(packet, sizeof(packet), "%c%i,%" PRIx64 ",%x",
-                 insert ? 'Z' : 'z', type, addr, length);
-  // Check we haven't overwritten the end of the packet buffer
-  assert(packet_len + 1 < (int)sizeof(packet));
-  UNUSED_IF_ASSERT_DISABLED(packet_len);
+  StreamString packet;
+  packet.Printf("%c%i,%" PRIx64 ",%x", insert ? 'Z' : 'z', type, addr, length);
+  // Append the conditions as ";X<len>,<bytecode>"
+  for (const AgentExpression &condition : conditions) {
+    llvm::ArrayRef<uint8_t> bytes = condition.GetBytes();
+    packet.Printf(";X%zx,", bytes.size());
+    packet.PutBytesAsRawHex8(bytes.data(), bytes.size());
+  }
   StringExtractorGDBRemote response;
   // Make sure the response is either "OK", "EXX" where XX are two hex digits,
   // or "" (unsupported)
   response.SetResponseValidatorToOKErrorNotSupported();
   // Try to send the breakpoint packet, and check that it was correctly sent
-  if (SendPacketAndWaitForResponse(packet, response, true) ==
-      PacketResult::Success) {
-    // Receive and OK packet when the breakpoint successfully placed
-    if (response.IsOKResponse())
-      return 0;
+  if (SendPacketAndWaitForResponse(packet.GetString(), response, true) ==
+      PacketResult::Success)
+    return HandleGDBStoppointResponse(type, response);
+  // Signal generic failure
+  return UINT8_MAX;
+}
 
-    // Status while setting breakpoint, send back specific error
-    if (response.IsErrorResponse())
-      return response.GetError();
-
-    // Empty packet informs us that breakpoint is not supported
-    if (response.IsUnsupportedResponse()) {
-      // Disable this breakpoint type since it is unsupported
-      switch (type) {
-      case eBreakpointSoftware:
-        m_supports_z0 = false;
-        break;
-      case eBreakpointHardware:
-        m_supports_z1 = false;
-        break;
-      case eWatchpointWrite:
-        m_supports_z2 = false;
-        break;
-      case eWatchpointRead:
-        m_supports_z3 = false;
-        break;
-      case eWatchpointReadWrite:
-        m_supports_z4 = false;
-        break;
-      case eStoppointInvalid:
-        return UINT8_MAX;
-      }
+std::vector<uint8_t> GDBRemoteCommunicationClient::SendGDBStoppointTypePackets(
+    GDBStoppointType type, bool insert,
+    llvm::ArrayRef<std::pair<addr_t, uint32_t>> stoppoints) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  LLDB_LOGF(log, "GDBRemoteCommunicationClient::%s() %s %zu stoppoints",
+            __FUNCTION__, insert ? "add" : "remove", stoppoints.size());
+
+  std::vector<uint8_t> results(stoppoints.size(), UINT8_MAX);
+  // Check if the stub is known not to support this breakpoint type
+  if (!SupportsGDBStoppointPacket(type))
+    return results;
+
+  std::vector<std::string> payloads;
+  payloads.reserve(stoppoints.size());
+  for (const auto &stoppoint : stoppoints) {
+    StreamString packet;
+    packet.Printf("%c%i,%" PRIx64 ",%x", insert ? 'Z' : 'z', type,
+                  stoppoint.first, stoppoint.second);
+    payloads.push_back(packet.GetString().str());
+  }
+
+  // Stoppoints without a response (because the connection failed part way
+  // through) keep the generic failure.
+  std::vector<StringExtractorGDBRemote> responses;
+  SendPacketsAndWaitForResponses(payloads, responses, true);
+  for (size_t i = 0; i < responses.size(); ++i)
+    results[i] = HandleGDBStoppointResponse(type, responses[i]);
+  return results;
+}
+
+uint8_t GDBRemoteCommunicationClient::HandleGDBStoppointResponse(
+    GDBStoppointType type, StringExtractorGDBRemote &response) {
+  // Receive and OK packet when the breakpoint successfully placed
+  if (response.IsOKResponse())
+    return 0;
+
+  // Status while setting breakpoint, send back specific error
+  if (response.IsErrorResponse())
+    return response.GetError();
+
+  // Empty packet informs us that breakpoint is not supported
+  if (response.IsUnsupportedResponse()) {
+    // Disable this breakpoint type since it is unsupported
+    switch (type) {
+    case eBreakpointSoftware:
+      m_supports_z0 = false;
+      break;
+    case eBreakpointHardware:
+      m_supports_z1 = false;
+      break;
+    case eWatchpointWrite:
+      m_supports_z2 = false;
+      break;
+    case eWatchpointRead:
+      m_supports_z3 = false;
+      break;
+    case eWatchpointReadWrite:
+      m_supports_z4 = false;
+      break;
+    case eStoppointInvalid:
+      return UINT8_MAX;
     }
   }
   // Signal generic failure
@@ -3047,6 +3260,56 @@ uint64_t GDBRemoteCommunicationClient::WriteFile(lldb::user_id_t fd,
   return 0;
 }
 
+Status GDBRemoteCommunicationClient::ReadFileInChunks(
+    lldb::user_id_t fd, uint64_t chunk_size,
+    llvm::function_ref<Status(llvm::StringRef)> callback) {
+  uint64_t offset = 0;
+  while (true) {
+    std::vector<std::string> payloads;
+    for (size_t i = 0; i < kMaxPacketsInFlight; ++i)
+      payloads.push_back(llvm::formatv("vFile:pread:{0},{1},{2}", (int)fd,
+                                       chunk_size, offset + i * chunk_size)
+                             .str());
+    std::vector<StringExtractorGDBRemote> responses;
+    if (SendPacketsAndWaitForResponses(payloads, responses, false) !=
+        PacketResult::Success)
+      return Status("failed to send vFile:pread packets");
+
+    for (StringExtractorGDBRemote &response : responses) {
+      if (response.GetChar() != 'F')
+        return Status("invalid vFile:pread response");
+      const int64_t bytes_read = response.GetS64(-1, 10);
+      if (bytes_read < 0) {
+        Status error;
+        error.SetErrorToGenericError();
+        if (response.GetChar() == ',') {
+          int response_errno = response.GetS32(-1, 10);
+          if (response_errno > 0)
+            error.SetError(response_errno, lldb::eErrorTypePOSIX);
+        }
+        return error;
+      }
+      if (bytes_read == 0)
+        return Status();
+
+      std::string buffer;
+      if (response.GetChar() != ';' ||
+          !response.GetEscapedBinaryData(buffer) ||
+          buffer.size() != static_cast<uint64_t>(bytes_read))
+        return Status("invalid vFile:pread response");
+      Status error = callback(buffer);
+      if (error.Fail())
+        return error;
+      offset += bytes_read;
+
+      // The reads after a short one started past where this one ended, so
+      // their data doesn't follow on. Ask again from the new offset.
+      if (static_cast<uint64_t>(bytes_read) < chunk_size)
+        break;
+    }
+  }
+}
+
 Status GDBRemoteCommunicationClient::CreateSymlink(const FileSpec &src,
                                                    const FileSpec &dst) {
   std::string src_path{src.GetPath(false)}, dst_path{dst.GetPath(false)};
@@ -3195,14 +3458,68 @@ DataBufferSP GDBRemoteCommunicationClient::ReadRegister(lldb::tid_t tid,
   return buffer_sp;
 }
 
+std::vector<DataBufferSP>
+GDBRemoteCommunicationClient::ReadRegisters(lldb::tid_t tid,
+                                            llvm::ArrayRef<uint32_t> reg_nums) {
+  std::vector<DataBufferSP> buffers;
+  Lock lock(*this, false);
+  if (!lock) {
+    if (Log *log = ProcessGDBRemoteLog::GetLogIfAnyCategoryIsSet(
+            GDBR_LOG_PROCESS | GDBR_LOG_PACKETS))
+      LLDB_LOGF(log,
+                "GDBRemoteCommunicationClient::%s: Didn't get sequence mutex "
+                "for p packets.",
+                __FUNCTION__);
+    return buffers;
+  }
+
+  const bool thread_suffix_supported = GetThreadSuffixSupported();
+  if (!thread_suffix_supported && !SetCurrentThread(tid))
+    return buffers;
+
+  std::vector<std::string> payloads;
+  payloads.reserve(reg_nums.size());
+  for (uint32_t reg : reg_nums) {
+    StreamString payload;
+    payload.Printf("p%x", reg);
+    if (thread_suffix_supported)
+      payload.Printf(";thread:%4.4" PRIx64 ";", tid);
+    payloads.push_back(payload.GetString().str());
+  }
+
+  std::vector<StringExtractorGDBRemote> responses;
+  if (SendPacketsAndWaitForResponsesNoLock(payloads, responses) !=
+      PacketResult::Success)
+    return buffers;
+
+  buffers.reserve(responses.size());
+  for (StringExtractorGDBRemote &response : responses) {
+    if (!response.IsNormalResponse()) {
+      buffers.push_back(nullptr);
+      continue;
+    }
+    DataBufferSP buffer_sp(
+        new DataBufferHeap(response.GetStringRef().size() / 2, 0));
+    response.GetHexBytes(buffer_sp->GetData(), '\xcc');
+    buffers.push_back(buffer_sp);
+  }
+  return buffers;
+}
+
 DataBufferSP GDBRemoteCommunicationClient::ReadAllRegisters(lldb::tid_t tid) {
   StreamString payload;
   payload.PutChar('g');
   StringExtractorGDBRemote response;
   if (SendThreadSpecificPacketAndWaitForResponse(
-          tid, std::move(payload), response, false) != PacketResult::Success ||
-      !response.IsNormalResponse())
+          tid, std::move(payload), response, false) != PacketResult::Success)
+    return nullptr;
+  if (response.IsUnsupportedResponse()) {
+    m_supports_g = eLazyBoolNo;
     return nullptr;
+  }
+  if (!response.IsNormalResponse())
+    return nullptr;
+  m_supports_g = eLazyBoolYes;
 
   DataBufferSP buffer_sp(
       new DataBufferHeap(response.GetStringRef().size() / 2, 0));
@@ -3474,35 +3791,71 @@ Status GDBRemoteCommunicationClient::SendGetTraceDataPacket(
   Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_PROCESS));
   Status error;
 
-  StructuredData::Dictionary json_packet;
-
-  json_packet.AddIntegerItem("traceid", uid);
-  json_packet.AddIntegerItem("offset", offset);
-  json_packet.AddIntegerItem("buffersize", buffer.size());
-
-  if (thread_id != LLDB_INVALID_THREAD_ID)
-    json_packet.AddIntegerItem("threadid", thread_id);
-
-  StreamString json_string;
-  json_packet.Dump(json_string, false);
+  // Binary replies are read a packet's worth at a time, so that a trace of
+  // hundreds of megabytes doesn't have to come back in one piece. Hex ones
+  // keep asking for everything at once, like stubs without jTraceBinary+
+  // expect.
+  const bool binary = GetTraceBinarySupported();
+  size_t chunk_size = buffer.size();
+  if (binary && GetRemoteMaxPacketSize() < chunk_size)
+    chunk_size = GetRemoteMaxPacketSize();
+
+  const std::string prefix = packet.GetString();
+  size_t filled_size = 0;
+  while (filled_size < buffer.size()) {
+    const size_t request_size =
+        std::min(chunk_size, buffer.size() - filled_size);
+    StructuredData::Dictionary json_packet;
+
+    json_packet.AddIntegerItem("traceid", uid);
+    json_packet.AddIntegerItem("offset", offset + filled_size);
+    json_packet.AddIntegerItem("buffersize", request_size);
+
+    if (thread_id != LLDB_INVALID_THREAD_ID)
+      json_packet.AddIntegerItem("threadid", thread_id);
+    if (binary)
+      json_packet.AddBooleanItem("binary", true);
+
+    StreamString json_string;
+    json_packet.Dump(json_string, false);
+
+    StreamGDBRemote chunk_packet;
+    chunk_packet.PutCString(prefix);
+    chunk_packet.PutEscapedBytes(json_string.GetData(), json_string.GetSize());
+    StringExtractorGDBRemote response;
+    if (SendPacketAndWaitForResponse(chunk_packet.GetString(), response,
+                                     true) !=
+        GDBRemoteCommunication::PacketResult::Success) {
+      LLDB_LOG(log, "failed to send packet");
+      error.SetErrorStringWithFormat("failed to send packet: '%s'",
+                                     chunk_packet.GetData());
+      filled_size = 0;
+      break;
+    }
+    // An empty binary reply just means there is no more data.
+    if (binary && filled_size > 0 && response.Empty())
+      break;
+    if (!response.IsNormalResponse()) {
+      error = response.GetStatus();
+      filled_size = 0;
+      break;
+    }
 
-  packet.PutEscapedBytes(json_string.GetData(), json_string.GetSize());
-  StringExtractorGDBRemote response;
-  if (SendPacketAndWaitForResponse(packet.GetString(), response, true) ==
-      GDBRemoteCommunication::PacketResult::Success) {
-    if (response.IsNormalResponse()) {
-      size_t filled_size = response.GetHexBytesAvail(buffer);
-      buffer = llvm::MutableArrayRef<uint8_t>(buffer.data(), filled_size);
+    llvm::MutableArrayRef<uint8_t> chunk =
+        buffer.slice(filled_size, request_size);
+    size_t chunk_filled;
+    if (binary) {
+      chunk_filled = std::min(response.GetBytesLeft(), request_size);
+      memcpy(chunk.data(), response.GetStringRef().data(), chunk_filled);
     } else {
-      error = response.GetStatus();
-      buffer = buffer.slice(buffer.size());
+      chunk_filled = response.GetHexBytesAvail(chunk);
     }
-  } else {
-    LLDB_LOG(log, "failed to send packet");
-    error.SetErrorStringWithFormat("failed to send packet: '%s'",
-                                   packet.GetData());
-    buffer = buffer.slice(buffer.size());
+    filled_size += chunk_filled;
+    if (chunk_filled < request_size)
+      break; // That's all there is.
   }
+
+  buffer = llvm::MutableArrayRef<uint8_t>(buffer.data(), filled_size);
   return error;
 }
 
@@ -3966,6 +4319,185 @@ Status GDBRemoteCommunicationClient::SendSignalsToIgnore(
   }
 }
 
+Status GDBRemoteCommunicationClient::ReadMemoryRanges(
+    llvm::ArrayRef<Range<lldb::addr_t, size_t>> ranges, uint8_t *buf,
+    std::vector<size_t> &bytes_read) {
+  // Format packet:
+  // MultiMemRead:ranges:<hex_addr1>,<hex_size1>,...,<hex_addrN>,<hex_sizeN>;
+  // The reply lists the number of bytes read for each range followed by the
+  // binary data of all ranges:
+  // <hex_read1>,...,<hex_readN>;<binary data>
+  StreamString packet;
+  packet.PutCString("MultiMemRead:ranges:");
+  for (size_t i = 0; i < ranges.size(); ++i)
+    packet.Format("{0}{1:x-},{2:x-}", i == 0 ? "" : ",",
+                  ranges[i].GetRangeBase(), ranges[i].GetByteSize());
+  packet.PutChar(';');
+
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse(packet.GetString(), response, true) !=
+      PacketResult::Success)
+    return Status("Sending MultiMemRead packet failed");
+  if (response.IsErrorResponse())
+    return response.GetStatus();
+  if (!response.IsNormalResponse())
+    return Status("Unexpected response to MultiMemRead packet");
+
+  bytes_read.clear();
+  size_t total_bytes_read = 0;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    const uint64_t range_bytes_read = response.GetHexMaxU64(false, UINT64_MAX);
+    if (range_bytes_read > ranges[i].GetByteSize() ||
+        response.GetChar() != (i + 1 == ranges.size() ? ';' : ','))
+      return Status("Invalid MultiMemRead response");
+    bytes_read.push_back(range_bytes_read);
+    total_bytes_read += range_bytes_read;
+  }
+
+  // The lower level GDBRemoteCommunication packet receive layer has already
+  // de-quoted any 0x7d character escaping that was present in the packet.
+  if (response.GetBytesLeft() != total_bytes_read)
+    return Status("Invalid MultiMemRead response");
+  const char *data = response.Peek();
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    if (bytes_read[i] > 0)
+      memcpy(buf, data, bytes_read[i]);
+    data += bytes_read[i];
+    buf += ranges[i].GetByteSize();
+  }
+  return Status();
+}
+
+bool GDBRemoteCommunicationClient::SearchMemory(lldb::addr_t addr,
+                                                uint64_t length,
+                                                llvm::ArrayRef<uint8_t> pattern,
+                                                lldb::addr_t &found_addr) {
+  if (!m_supports_qSearchMemory)
+    return false;
+
+  // Format packet:
+  // qSearch:memory:<hex_addr>;<hex_length>;<binary pattern>
+  StreamGDBRemote packet;
+  packet.Format("qSearch:memory:{0:x-};{1:x-};", addr, length);
+  packet.PutEscapedBytes(pattern.data(), pattern.size());
+
+  // Searching a large range of memory can take a while.
+  ScopedTimeout timeout(*this, std::chrono::seconds(30));
+
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse(packet.GetString(), response, false) !=
+      PacketResult::Success)
+    return false;
+  if (response.IsUnsupportedResponse()) {
+    m_supports_qSearchMemory = false;
+    return false;
+  }
+
+  // The reply is "0" if the pattern wasn't found and "1,<hex_addr>" if it
+  // was.
+  switch (response.GetChar()) {
+  case '0':
+    found_addr = LLDB_INVALID_ADDRESS;
+    return response.GetBytesLeft() == 0;
+  case '1':
+    if (response.GetChar() != ',')
+      return false;
+    found_addr = response.GetHexMaxU64(false, LLDB_INVALID_ADDRESS);
+    return found_addr != LLDB_INVALID_ADDRESS &&
+           response.GetBytesLeft() == 0;
+  default:
+    return false;
+  }
+}
+
+Status
+GDBRemoteCommunicationClient::SaveSnapshot(lldb::user_id_t &snapshot_id) {
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse("QSaveSnapshot", response, false) !=
+      PacketResult::Success)
+    return Status("Sending QSaveSnapshot packet failed");
+  if (response.IsUnsupportedResponse())
+    return Status("the remote stub doesn't support snapshots");
+  if (!response.IsNormalResponse())
+    return response.GetStatus();
+
+  snapshot_id = response.GetHexMaxU64(false, LLDB_INVALID_UID);
+  if (snapshot_id == LLDB_INVALID_UID || response.GetBytesLeft() != 0)
+    return Status("invalid QSaveSnapshot reply");
+  return Status();
+}
+
+Status GDBRemoteCommunicationClient::RestoreSnapshot(
+    lldb::user_id_t snapshot_id, lldb::pid_t &pid) {
+  std::string packet =
+      llvm::formatv("QRestoreSnapshot:{0:x-}", snapshot_id).str();
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse(packet, response, false) !=
+      PacketResult::Success)
+    return Status("Sending QRestoreSnapshot packet failed");
+  if (response.IsUnsupportedResponse())
+    return Status("the remote stub doesn't support snapshots");
+  if (!response.IsNormalResponse())
+    return response.GetStatus();
+
+  pid = response.GetHexMaxU64(false, LLDB_INVALID_PROCESS_ID);
+  if (pid == LLDB_INVALID_PROCESS_ID || response.GetBytesLeft() != 0)
+    return Status("invalid QRestoreSnapshot reply");
+
+  // The process and its threads are new.
+  m_curr_pid = pid;
+  m_curr_pid_is_valid = eLazyBoolYes;
+  m_curr_tid = LLDB_INVALID_THREAD_ID;
+  m_curr_tid_run = LLDB_INVALID_THREAD_ID;
+  return Status();
+}
+
+Status
+GDBRemoteCommunicationClient::DeleteSnapshot(lldb::user_id_t snapshot_id) {
+  std::string packet =
+      llvm::formatv("QDeleteSnapshot:{0:x-}", snapshot_id).str();
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse(packet, response, false) !=
+      PacketResult::Success)
+    return Status("Sending QDeleteSnapshot packet failed");
+  if (response.IsUnsupportedResponse())
+    return Status("the remote stub doesn't support snapshots");
+  if (!response.IsOKResponse())
+    return response.GetStatus();
+  return Status();
+}
+
+Status
+GDBRemoteCommunicationClient::SetTracepoint(lldb::addr_t addr,
+                                            llvm::ArrayRef<uint32_t> registers) {
+  StreamString packet;
+  packet.Printf("QSetTracepoint:%" PRIx64, addr);
+  for (size_t i = 0; i < registers.size(); ++i)
+    packet.Printf("%c%" PRIx32, i ? ',' : ';', registers[i]);
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse(packet.GetString(), response, false) !=
+      PacketResult::Success)
+    return Status("Sending QSetTracepoint packet failed");
+  if (response.IsUnsupportedResponse())
+    return Status("the remote stub doesn't support tracepoints");
+  if (!response.IsOKResponse())
+    return response.GetStatus();
+  return Status();
+}
+
+Status GDBRemoteCommunicationClient::ClearTracepoint(lldb::addr_t addr) {
+  std::string packet = llvm::formatv("QClearTracepoint:{0:x-}", addr).str();
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse(packet, response, false) !=
+      PacketResult::Success)
+    return Status("Sending QClearTracepoint packet failed");
+  if (response.IsUnsupportedResponse())
+    return Status("the remote stub doesn't support tracepoints");
+  if (!response.IsOKResponse())
+    return response.GetStatus();
+  return Status();
+}
+
 Status GDBRemoteCommunicationClient::ConfigureRemoteStructuredData(
     ConstString type_name, const StructuredData::ObjectSP &config_sp) {
   Status error;
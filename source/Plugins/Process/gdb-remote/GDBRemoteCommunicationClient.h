@@ -17,7 +17,9 @@
 #include <string>
 #include <vector>
 
+#include "lldb/Utility/AgentExpression.h"
 #include "lldb/Utility/ArchSpec.h"
+#include "lldb/Utility/RangeMap.h"
 #include "lldb/Utility/StreamGDBRemote.h"
 #include "lldb/Utility/StructuredData.h"
 #if defined(_WIN32)
@@ -234,6 +236,10 @@ public:
 
   bool GetpPacketSupported(lldb::tid_t tid);
 
+  /// Returns false once the stub has told us it doesn't implement the "g"
+  /// packet. ReadAllRegisters() records the answer.
+  bool GetgPacketSupported() const { return m_supports_g != eLazyBoolNo; }
+
   bool GetxPacketSupported();
 
   bool GetVAttachOrWaitSupported();
@@ -300,7 +306,22 @@ public:
       GDBStoppointType type, // Type of breakpoint or watchpoint
       bool insert,           // Insert or remove?
       lldb::addr_t addr,     // Address of breakpoint or watchpoint
-      uint32_t length);      // Byte Size of breakpoint or watchpoint
+      uint32_t length,       // Byte Size of breakpoint or watchpoint
+      llvm::ArrayRef<AgentExpression> conditions = {}); // Z0 conditions
+
+  /// Insert or remove several stoppoints of the same type. The packets are
+  /// pipelined instead of waiting for each response before sending the next
+  /// one.
+  ///
+  /// \param[in] stoppoints
+  ///     The address and byte size of each breakpoint or watchpoint.
+  ///
+  /// \return
+  ///     One result per stoppoint, in the same order, with the same meaning
+  ///     as the return value of SendGDBStoppointTypePacket().
+  std::vector<uint8_t> SendGDBStoppointTypePackets(
+      GDBStoppointType type, bool insert,
+      llvm::ArrayRef<std::pair<lldb::addr_t, uint32_t>> stoppoints);
 
   bool SetNonStopMode(const bool enable);
 
@@ -323,6 +344,10 @@ public:
 
   void EnableErrorStringInPacket();
 
+  /// Ask the stub to send \a stack_size bytes at the stack pointer and up to
+  /// \a frame_count frame pointer records with each stop reply.
+  bool SetExpeditedStackMemory(uint64_t stack_size, uint32_t frame_count);
+
   bool GetQXferLibrariesReadSupported();
 
   bool GetQXferLibrariesSVR4ReadSupported();
@@ -333,8 +358,29 @@ public:
 
   bool GetQPassSignalsSupported();
 
+  bool GetMultiMemReadSupported();
+
+  bool GetConditionalBreakpointsSupported();
+
+  // Whether the stub steps threads resumed from one of its software
+  // breakpoints past it by itself.
+  bool GetBreakpointStepOverSupported();
+
+  bool GetTraceBinarySupported();
+
+  // Whether jThreadsInfo can send only the threads that changed since the
+  // reply before.
+  bool GetThreadsInfoDeltaSupported();
+
+  // Whether to ask the remote stub to compress the packets it sends, if it
+  // offers any compression we can handle. Must be set before the qSupported
+  // handshake to have any effect.
+  void SetCompressionAllowed(bool allowed) { m_compression_allowed = allowed; }
+
   bool GetAugmentedLibrariesSVR4ReadSupported();
 
+  bool GetLibrariesSVR4DeltaSupported();
+
   bool GetQXferFeaturesReadSupported();
 
   bool GetQXferMemoryMapReadSupported();
@@ -369,6 +415,14 @@ public:
   uint64_t WriteFile(lldb::user_id_t fd, uint64_t offset, const void *src,
                      uint64_t src_len, Status &error);
 
+  /// Read the file \a fd from its start to its end and pass its contents to
+  /// \a callback, in order, at most \a chunk_size bytes at a time. Several
+  /// vFile:pread requests are kept outstanding, so the transfer isn't bound
+  /// by the round trip time. Stops at the first error \a callback returns.
+  Status
+  ReadFileInChunks(lldb::user_id_t fd, uint64_t chunk_size,
+                   llvm::function_ref<Status(llvm::StringRef)> callback);
+
   Status CreateSymlink(const FileSpec &src, const FileSpec &dst);
 
   Status Unlink(const FileSpec &file_spec);
@@ -395,6 +449,18 @@ public:
       uint32_t
           reg_num); // Must be the eRegisterKindProcessPlugin register number
 
+  /// Read several registers of a thread with pipelined "p" packets.
+  ///
+  /// \param[in] reg_nums
+  ///     The eRegisterKindProcessPlugin numbers of the registers to read.
+  ///
+  /// \return
+  ///     One buffer per register, in the order of \a reg_nums. The buffer of
+  ///     a register that could not be read is null. The result is empty if
+  ///     the packets could not be sent at all.
+  std::vector<lldb::DataBufferSP>
+  ReadRegisters(lldb::tid_t tid, llvm::ArrayRef<uint32_t> reg_nums);
+
   lldb::DataBufferSP ReadAllRegisters(lldb::tid_t tid);
 
   bool
@@ -416,6 +482,10 @@ public:
 
   bool AvoidGPackets(ProcessGDBRemote *process);
 
+  /// Get the stop info, expedited registers and memory of all threads with
+  /// the "jThreadsInfo" packet. If the stub supports it, only the threads
+  /// that changed since the previous call are sent, and the others are
+  /// filled in from the previous reply.
   StructuredData::ObjectSP GetThreadsInfo();
 
   bool GetThreadExtendedInfoSupported();
@@ -440,6 +510,41 @@ public:
   // Sends QPassSignals packet to the server with given signals to ignore.
   Status SendSignalsToIgnore(llvm::ArrayRef<int32_t> signals);
 
+  /// Read all of \a ranges with a single MultiMemRead packet.
+  ///
+  /// The memory of each range is stored in \a buf right after that of the
+  /// previous range, and the number of bytes the server could read for each
+  /// range in \a bytes_read. The whole reply has to fit in one packet.
+  Status ReadMemoryRanges(llvm::ArrayRef<Range<lldb::addr_t, size_t>> ranges,
+                          uint8_t *buf, std::vector<size_t> &bytes_read);
+
+  /// Search the \a length bytes of memory at \a addr for \a pattern with a
+  /// qSearch:memory packet.
+  ///
+  /// \return
+  ///     True if the server did the search, setting \a found_addr to the
+  ///     address of the first match or LLDB_INVALID_ADDRESS.
+  bool SearchMemory(lldb::addr_t addr, uint64_t length,
+                    llvm::ArrayRef<uint8_t> pattern, lldb::addr_t &found_addr);
+
+  /// Have the server save a copy of the stopped process with a
+  /// QSaveSnapshot packet.
+  Status SaveSnapshot(lldb::user_id_t &snapshot_id);
+
+  /// Have the server replace the process with a copy of snapshot
+  /// \a snapshot_id, setting \a pid to the ID of the new process.
+  Status RestoreSnapshot(lldb::user_id_t snapshot_id, lldb::pid_t &pid);
+
+  Status DeleteSnapshot(lldb::user_id_t snapshot_id);
+
+  /// Have the server record the hits of a tracepoint at \a addr, with the
+  /// values of the registers numbered \a registers, with a QSetTracepoint
+  /// packet. The hits arrive as asynchronous JSON packets while the process
+  /// runs.
+  Status SetTracepoint(lldb::addr_t addr, llvm::ArrayRef<uint32_t> registers);
+
+  Status ClearTracepoint(lldb::addr_t addr);
+
   /// Return the feature set supported by the gdb-remote server.
   ///
   /// This method returns the remote side's response to the qSupported
@@ -515,6 +620,7 @@ protected:
   LazyBool m_attach_or_wait_reply;
   LazyBool m_prepare_for_reg_writing_reply;
   LazyBool m_supports_p;
+  LazyBool m_supports_g;
   LazyBool m_supports_x;
   LazyBool m_avoid_g_packets;
   LazyBool m_supports_QSaveRegisterState;
@@ -524,10 +630,16 @@ protected:
   LazyBool m_supports_qXfer_features_read;
   LazyBool m_supports_qXfer_memory_map_read;
   LazyBool m_supports_augmented_libraries_svr4_read;
+  LazyBool m_supports_libraries_svr4_delta;
   LazyBool m_supports_jThreadExtendedInfo;
   LazyBool m_supports_jLoadedDynamicLibrariesInfos;
   LazyBool m_supports_jGetSharedCacheInfo;
   LazyBool m_supports_QPassSignals;
+  LazyBool m_supports_MultiMemRead;
+  LazyBool m_supports_ConditionalBreakpoints;
+  LazyBool m_supports_BreakpointStepOver;
+  LazyBool m_supports_jTraceBinary;
+  LazyBool m_supports_jThreadsInfo_delta;
   LazyBool m_supports_error_string_reply;
 
   bool m_supports_qProcessInfoPID : 1, m_supports_qfProcessInfo : 1,
@@ -537,7 +649,17 @@ protected:
       m_supports_QEnvironment : 1, m_supports_QEnvironmentHexEncoded : 1,
       m_supports_qSymbol : 1, m_qSymbol_requests_done : 1,
       m_supports_qModuleInfo : 1, m_supports_jThreadsInfo : 1,
-      m_supports_jModulesInfo : 1;
+      m_supports_jModulesInfo : 1, m_supports_qSearchMemory : 1;
+
+  // The last complete thread infos and their generation, which the next
+  // jThreadsInfo reply may be a delta against.
+  StructuredData::ObjectSP m_threads_info_sp;
+  uint32_t m_threads_info_generation = 0;
+
+  // Turn a jThreadsInfo reply with a generation into the complete array of
+  // thread infos, and remember it for the next delta.
+  StructuredData::ObjectSP
+  ApplyThreadsInfoDelta(const StructuredData::ObjectSP &reply_sp);
 
   lldb::pid_t m_curr_pid;
   lldb::tid_t m_curr_tid; // Current gdb remote protocol thread index for all
@@ -568,6 +690,8 @@ protected:
   std::vector<MemoryRegionInfo> m_qXfer_memory_map;
   bool m_qXfer_memory_map_loaded;
 
+  bool m_compression_allowed = true;
+
   bool GetCurrentProcessInfo(bool allow_lazy_pid = true);
 
   bool GetGDBServerVersion();
@@ -596,6 +720,9 @@ protected:
                                      MemoryRegionInfo &region);
 
 private:
+  uint8_t HandleGDBStoppointResponse(GDBStoppointType type,
+                                     StringExtractorGDBRemote &response);
+
   DISALLOW_COPY_AND_ASSIGN(GDBRemoteCommunicationClient);
 };
 
@@ -168,6 +168,7 @@ GDBRemoteCommunicationReplayServer::GetPacketAndSendResponse(
     LLDB_LOG(log,
              "GDBRemoteCommunicationReplayServer replied to '{0}' with '{1}'",
              packet.GetStringRef(), entry.packet.data);
+    SimulateLink(packet.GetStringRef().size() + entry.packet.data.size());
     return SendRawPacketNoLock(entry.packet.data);
   }
 
@@ -176,6 +177,15 @@ GDBRemoteCommunicationReplayServer::GetPacketAndSendResponse(
   return packet_result;
 }
 
+void GDBRemoteCommunicationReplayServer::SimulateLink(size_t num_bytes) {
+  std::chrono::microseconds delay = m_link_latency;
+  if (m_link_bytes_per_second)
+    delay += std::chrono::microseconds(num_bytes * 1000000 /
+                                       m_link_bytes_per_second);
+  if (delay.count())
+    std::this_thread::sleep_for(delay);
+}
+
 LLVM_YAML_IS_DOCUMENT_LIST_VECTOR(
     std::vector<
         lldb_private::process_gdb_remote::GDBRemoteCommunicationHistory::Entry>)
@@ -186,6 +196,9 @@ GDBRemoteCommunicationReplayServer::LoadReplayHistory(const FileSpec &path) {
   if (auto err = error_or_file.getError())
     return errorCodeToError(err);
 
+  // A new history may be loaded while the server thread is running, once
+  // the previous one was replayed.
+  std::lock_guard<std::recursive_mutex> guard(m_async_thread_state_mutex);
   yaml::Input yin((*error_or_file)->getBuffer());
   yin >> m_packet_history;
 
@@ -21,6 +21,7 @@
 
 // C Includes
 // C++ Includes
+#include <chrono>
 #include <functional>
 #include <map>
 #include <thread>
@@ -51,6 +52,16 @@ public:
   bool StartAsyncThread();
   void StopAsyncThread();
 
+  /// Simulate a slower link than the local connection: delay every reply by
+  /// \a latency, the round trip time, plus the time it takes to transfer
+  /// the packet and its reply at \a bytes_per_second. A rate of 0 means no
+  /// limit.
+  void SetSimulatedLink(std::chrono::microseconds latency,
+                        uint64_t bytes_per_second) {
+    m_link_latency = latency;
+    m_link_bytes_per_second = bytes_per_second;
+  }
+
 protected:
   enum {
     eBroadcastBitAsyncContinue = (1 << 0),
@@ -61,6 +72,10 @@ protected:
                             bool &done);
   static lldb::thread_result_t AsyncThread(void *arg);
 
+  /// Wait as long as it would take to exchange \a num_bytes over the
+  /// simulated link.
+  void SimulateLink(size_t num_bytes);
+
   /// Replay history with the oldest packet at the end.
   std::vector<GDBRemoteCommunicationHistory::Entry> m_packet_history;
 
@@ -72,6 +87,9 @@ protected:
 
   bool m_skip_acks;
 
+  std::chrono::microseconds m_link_latency{0};
+  uint64_t m_link_bytes_per_second = 0;
+
 private:
   DISALLOW_COPY_AND_ASSIGN(GDBRemoteCommunicationReplayServer);
 };
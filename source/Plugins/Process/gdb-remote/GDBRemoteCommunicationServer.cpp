@@ -29,6 +29,10 @@ GDBRemoteCommunicationServer::GDBRemoteCommunicationServer(
       StringExtractorGDBRemote::eServerPacketType_QEnableErrorStrings,
       [this](StringExtractorGDBRemote packet, Status &error, bool &interrupt,
              bool &quit) { return this->Handle_QErrorStringEnable(packet); });
+  RegisterPacketHandler(
+      StringExtractorGDBRemote::eServerPacketType_QEnableCompression,
+      [this](StringExtractorGDBRemote packet, Status &error, bool &interrupt,
+             bool &quit) { return this->Handle_QEnableCompression(packet); });
 }
 
 GDBRemoteCommunicationServer::~GDBRemoteCommunicationServer() {}
@@ -134,6 +138,36 @@ GDBRemoteCommunicationServer::Handle_QErrorStringEnable(
   return SendOKResponse();
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_QEnableCompression(
+    StringExtractorGDBRemote &packet) {
+  packet.SetFilePos(::strlen("QEnableCompression:"));
+
+  CompressionType type = CompressionType::None;
+  size_t minsize = m_send_compression_minsize;
+  llvm::StringRef key, value;
+  while (packet.GetNameColonValue(key, value)) {
+    if (key == "type") {
+#if defined(HAVE_LIBZ)
+      if (value == "zlib-deflate")
+        type = CompressionType::ZlibDeflate;
+#endif
+    } else if (key == "minsize") {
+      if (value.getAsInteger(10, minsize))
+        return SendIllFormedResponse(packet, "Invalid minsize");
+    }
+  }
+
+  if (type == CompressionType::None)
+    return SendErrorResponse(0x88);
+
+  // The reply to this packet still goes out uncompressed.
+  PacketResult result = SendOKResponse();
+  m_send_compression_type = type;
+  m_send_compression_minsize = minsize;
+  return result;
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServer::SendIllFormedResponse(
     const StringExtractorGDBRemote &failed_packet, const char *message) {
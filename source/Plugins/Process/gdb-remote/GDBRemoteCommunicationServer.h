@@ -60,6 +60,8 @@ protected:
 
   PacketResult Handle_QErrorStringEnable(StringExtractorGDBRemote &packet);
 
+  PacketResult Handle_QEnableCompression(StringExtractorGDBRemote &packet);
+
   PacketResult SendErrorResponse(const Status &error);
 
   PacketResult SendErrorResponse(llvm::Error error);
@@ -821,8 +821,9 @@ GDBRemoteCommunicationServerCommon::Handle_qSupported(
   StreamGDBRemote response;
 
   // Features common to lldb-platform and llgs.
-  uint32_t max_packet_size = 128 * 1024; // 128KBytes is a reasonable max packet
-                                         // size--debugger can always use less
+  // Large enough for a memory read or write to take a while even on a fast
+  // link. Clients that want smaller packets can always use less.
+  uint32_t max_packet_size = 16 * 1024 * 1024;
   response.Printf("PacketSize=%x", max_packet_size);
 
   response.PutCString(";QStartNoAckMode+");
@@ -833,6 +834,20 @@ GDBRemoteCommunicationServerCommon::Handle_qSupported(
   response.PutCString(";QPassSignals+");
   response.PutCString(";qXfer:auxv:read+");
   response.PutCString(";qXfer:libraries-svr4:read+");
+  response.PutCString(";libraries-svr4-delta+");
+  response.PutCString(";jThreadsInfo-delta+");
+  response.PutCString(";MultiMemRead+");
+#endif
+#if defined(__linux__)
+  response.PutCString(";ConditionalBreakpoints+");
+  response.PutCString(";QNonStop+");
+  response.PutCString(";BreakpointStepOver+");
+  response.PutCString(";jTraceBinary+");
+#endif
+#if defined(HAVE_LIBZ)
+  response.Printf(";SupportedCompressions=zlib-deflate"
+                  ";DefaultCompressionMinSize=%zu",
+                  m_send_compression_minsize);
 #endif
 
   return SendPacketNoLock(response.GetString());
@@ -25,12 +25,14 @@
 #include "lldb/Host/Host.h"
 #include "lldb/Host/HostInfo.h"
 #include "lldb/Host/PosixApi.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Host/common/NativeProcessProtocol.h"
 #include "lldb/Host/common/NativeRegisterContext.h"
 #include "lldb/Host/common/NativeThreadProtocol.h"
 #include "lldb/Target/MemoryRegionInfo.h"
 #include "lldb/Utility/Args.h"
 #include "lldb/Utility/DataBuffer.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Endian.h"
 #include "lldb/Utility/JSON.h"
 #include "lldb/Utility/LLDBAssert.h"
@@ -92,6 +94,9 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
       &GDBRemoteCommunicationServerLLGS::Handle_memory_read);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_M,
                                 &GDBRemoteCommunicationServerLLGS::Handle_M);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_MultiMemRead,
+      &GDBRemoteCommunicationServerLLGS::Handle_MultiMemRead);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_p,
                                 &GDBRemoteCommunicationServerLLGS::Handle_p);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_P,
@@ -116,6 +121,9 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_qProcessInfo,
       &GDBRemoteCommunicationServerLLGS::Handle_qProcessInfo);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_qSearchMemory,
+      &GDBRemoteCommunicationServerLLGS::Handle_qSearchMemory);
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_qRegisterInfo,
       &GDBRemoteCommunicationServerLLGS::Handle_qRegisterInfo);
@@ -125,6 +133,21 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_QSaveRegisterState,
       &GDBRemoteCommunicationServerLLGS::Handle_QSaveRegisterState);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_QSaveSnapshot,
+      &GDBRemoteCommunicationServerLLGS::Handle_QSaveSnapshot);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_QRestoreSnapshot,
+      &GDBRemoteCommunicationServerLLGS::Handle_QRestoreSnapshot);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_QDeleteSnapshot,
+      &GDBRemoteCommunicationServerLLGS::Handle_QDeleteSnapshot);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_QSetTracepoint,
+      &GDBRemoteCommunicationServerLLGS::Handle_QSetTracepoint);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_QClearTracepoint,
+      &GDBRemoteCommunicationServerLLGS::Handle_QClearTracepoint);
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_QSetDisableASLR,
       &GDBRemoteCommunicationServerLLGS::Handle_QSetDisableASLR);
@@ -151,6 +174,12 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_stop_reason,
       &GDBRemoteCommunicationServerLLGS::Handle_stop_reason); // ?
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_QNonStop,
+      &GDBRemoteCommunicationServerLLGS::Handle_QNonStop);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_vStopped,
+      &GDBRemoteCommunicationServerLLGS::Handle_vStopped);
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_vAttach,
       &GDBRemoteCommunicationServerLLGS::Handle_vAttach);
@@ -170,6 +199,9 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_QPassSignals,
       &GDBRemoteCommunicationServerLLGS::Handle_QPassSignals);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_QSetExpeditedStackMemory,
+      &GDBRemoteCommunicationServerLLGS::Handle_QSetExpeditedStackMemory);
 
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_jTraceStart,
@@ -235,6 +267,11 @@ Status GDBRemoteCommunicationServerLLGS::LaunchProcess() {
     if (!process_or)
       return Status(process_or.takeError());
     m_debugged_process_up = std::move(*process_or);
+    if (m_non_stop) {
+      Status error = m_debugged_process_up->SetNonStopMode(true);
+      if (error.Fail())
+        return error;
+    }
   }
 
   // Handle mirroring of inferior stdout/stderr over the gdb-remote protocol as
@@ -304,6 +341,11 @@ Status GDBRemoteCommunicationServerLLGS::AttachToProcess(lldb::pid_t pid) {
     return status;
   }
   m_debugged_process_up = std::move(*process_or);
+  if (m_non_stop) {
+    Status error = m_debugged_process_up->SetNonStopMode(true);
+    if (error.Fail())
+      return error;
+  }
 
   // Setup stdout/stderr mapping from inferior.
   auto terminal_fd = m_debugged_process_up->GetTerminalFileDescriptor();
@@ -468,6 +510,111 @@ static JSONObject::SP GetRegistersAsJSON(NativeThreadProtocol &thread) {
   return register_object_sp;
 }
 
+typedef std::map<lldb::addr_t, std::vector<uint8_t>> ExpeditedMemoryMap;
+
+// Collect the memory the client needs to unwind the first frames of a stopped
+// thread with the given stack and frame pointer: stack_size bytes starting at
+// the stack pointer, and the saved frame pointer and return address of up to
+// frame_count frames along the frame pointer chain. Overlapping and adjacent
+// blocks are merged, as the client's memory cache only uses a block for reads
+// that it contains completely. This only reads memory, so it can run off the
+// main thread if the process allows it.
+static ExpeditedMemoryMap
+GetExpeditedStackMemory(NativeProcessProtocol &process, lldb::addr_t sp,
+                        lldb::addr_t fp, size_t stack_size,
+                        uint32_t frame_count) {
+  ExpeditedMemoryMap memory;
+  const uint32_t addr_size = process.GetArchitecture().GetAddressByteSize();
+  const ByteOrder byte_order = process.GetArchitecture().GetByteOrder();
+  if (addr_size == 0)
+    return memory;
+
+  auto read_block = [&](lldb::addr_t addr, size_t size) -> bool {
+    std::vector<uint8_t> bytes(size);
+    size_t bytes_read = 0;
+    Status error =
+        process.ReadMemoryWithoutTrap(addr, bytes.data(), size, bytes_read);
+    if (bytes_read == 0)
+      return false;
+    bytes.resize(bytes_read);
+    memory[addr] = std::move(bytes);
+    return error.Success();
+  };
+
+  // Returns the block that contains [addr, addr + size), if any.
+  auto find_block = [&](lldb::addr_t addr, size_t size) {
+    auto pos = memory.upper_bound(addr);
+    if (pos == memory.begin())
+      return memory.end();
+    --pos;
+    if (pos->first + pos->second.size() < addr + size)
+      return memory.end();
+    return pos;
+  };
+
+  if (sp != 0 && stack_size > 0)
+    read_block(sp, stack_size);
+
+  const size_t frame_record_size = 2 * addr_size;
+  for (uint32_t i = 0; i < frame_count && fp != 0; ++i) {
+    auto block = find_block(fp, frame_record_size);
+    if (block == memory.end()) {
+      if (!read_block(fp, frame_record_size))
+        break;
+      block = find_block(fp, frame_record_size);
+      if (block == memory.end())
+        break;
+    }
+
+    // Dereference the frame pointer to get to the previous frame pointer.
+    DataExtractor data(block->second.data(), block->second.size(), byte_order,
+                       addr_size);
+    lldb::offset_t offset = fp - block->first;
+    const lldb::addr_t caller_fp = data.GetAddress(&offset);
+
+    // The stack grows down, so the caller's frame must be above ours. This
+    // also stops us from looping on a corrupt chain.
+    if (caller_fp <= fp)
+      break;
+    fp = caller_fp;
+  }
+
+  // Merge blocks that overlap or touch.
+  for (auto pos = memory.begin(); pos != memory.end();) {
+    auto next = std::next(pos);
+    if (next == memory.end())
+      break;
+    const lldb::addr_t end = pos->first + pos->second.size();
+    if (next->first > end) {
+      pos = next;
+      continue;
+    }
+    const lldb::addr_t next_end = next->first + next->second.size();
+    if (next_end > end)
+      pos->second.insert(pos->second.end(),
+                         next->second.end() - (next_end - end),
+                         next->second.end());
+    memory.erase(next);
+  }
+
+  return memory;
+}
+
+static JSONArray::SP
+GetExpeditedMemoryAsJSON(const ExpeditedMemoryMap &memory) {
+  JSONArray::SP memory_array_sp = std::make_shared<JSONArray>();
+  for (const auto &block : memory) {
+    JSONObject::SP block_sp = std::make_shared<JSONObject>();
+    block_sp->SetObject("address", std::make_shared<JSONNumber>(block.first));
+    StreamString bytes;
+    bytes.PutBytesAsRawHex8(block.second.data(), block.second.size());
+    block_sp->SetObject("bytes",
+                        std::make_shared<JSONString>(bytes.GetString()));
+    memory_array_sp->AppendObject(block_sp);
+  }
+  return memory_array_sp;
+}
+
 static const char *GetStopReasonString(StopReason stop_reason) {
   switch (stop_reason) {
   case eStopReasonTrace:
@@ -493,11 +640,22 @@ static const char *GetStopReasonString(StopReason stop_reason) {
 }
 
 static JSONArray::SP GetJSONThreadsInfo(NativeProcessProtocol &process,
-                                        bool abridged) {
+                                        bool abridged, size_t stack_size,
+                                        uint32_t frame_count) {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_THREAD));
 
   JSONArray::SP threads_array_sp = std::make_shared<JSONArray>();
 
+  // Anything that needs ptrace happens in the loop below, on this thread.
+  // Collecting the expedited memory only needs the stack and frame pointers,
+  // so it is done afterwards and in parallel when the process allows it.
+  struct ExpeditedStack {
+    JSONObject::SP thread_obj_sp;
+    lldb::addr_t sp;
+    lldb::addr_t fp;
+  };
+  std::vector<ExpeditedStack> stacks;
+
   // Ensure we can get info on the given thread.
   uint32_t thread_idx = 0;
   for (NativeThreadProtocol *thread;
@@ -562,7 +720,27 @@ static JSONArray::SP GetJSONThreadsInfo(NativeProcessProtocol &process,
       thread_obj_sp->SetObject("medata", medata_array_sp);
     }
 
-    // TODO: Expedite interesting regions of inferior memory
+    // Expedite the stack memory needed to unwind the first frames, so that
+    // the client does not have to read it after the stop.
+    if (!abridged) {
+      NativeRegisterContext &reg_ctx = thread->GetRegisterContext();
+      stacks.push_back({thread_obj_sp, reg_ctx.GetSP(0), reg_ctx.GetFP(0)});
+    }
+  }
+
+  auto expedite_stack = [&](size_t idx) {
+    const ExpeditedStack &stack = stacks[idx];
+    ExpeditedMemoryMap memory = GetExpeditedStackMemory(
+        process, stack.sp, stack.fp, stack_size, frame_count);
+    if (!memory.empty())
+      stack.thread_obj_sp->SetObject("memory",
+                                     GetExpeditedMemoryAsJSON(memory));
+  };
+  if (process.CanReadMemoryConcurrently())
+    TaskMapOverInt(0, stacks.size(), expedite_stack);
+  else {
+    for (size_t idx = 0; idx < stacks.size(); ++idx)
+      expedite_stack(idx);
   }
 
   return threads_array_sp;
@@ -570,7 +748,7 @@ static JSONArray::SP GetJSONThreadsInfo(NativeProcessProtocol &process,
 
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::SendStopReplyPacketForThread(
-    lldb::tid_t tid) {
+    lldb::tid_t tid, bool as_notification) {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_THREAD));
 
   // Ensure we have a debugged process.
@@ -659,8 +837,9 @@ GDBRemoteCommunicationServerLLGS::SendStopReplyPacketForThread(
     // thread otherwise this packet has all the info it needs.
     if (thread_index > 0) {
       const bool threads_with_valid_stop_info_only = true;
-      JSONArray::SP threads_info_sp = GetJSONThreadsInfo(
-          *m_debugged_process_up, threads_with_valid_stop_info_only);
+      JSONArray::SP threads_info_sp =
+          GetJSONThreadsInfo(*m_debugged_process_up,
+                             threads_with_valid_stop_info_only, 0, 0);
       if (threads_info_sp) {
         response.PutCString("jstopinfo:");
         StreamString unescaped_response;
@@ -779,6 +958,18 @@ GDBRemoteCommunicationServerLLGS::SendStopReplyPacketForThread(
     }
   }
 
+  // Expedite the stack memory needed to unwind the first frames, so that the
+  // client does not have to read it after the stop.
+  for (const auto &block : GetExpeditedStackMemory(
+           *m_debugged_process_up, reg_ctx.GetSP(0), reg_ctx.GetFP(0),
+           m_expedited_stack_size, m_expedited_frame_count)) {
+    response.Printf("memory:0x%" PRIx64 "=", block.first);
+    response.PutBytesAsRawHex8(block.second.data(), block.second.size());
+    response.PutChar(';');
+  }
+
+  if (as_notification)
+    return SendNotificationPacketNoLock("Stop", response.GetString());
   return SendPacketNoLock(response.GetString());
 }
 
@@ -855,12 +1046,15 @@ void GDBRemoteCommunicationServerLLGS::ProcessStateChanged(
     // Then stop the forwarding, so that any late output (see llvm.org/pr25652)
     // does not interfere with our protocol.
     StopSTDIOForwarding();
+    // The client gets the hits before the stop, like the output.
+    SendTracepointHits();
     HandleInferiorState_Stopped(process);
     break;
 
   case StateType::eStateExited:
     // Same as above
     SendProcessOutput();
+    SendTracepointHits();
     StopSTDIOForwarding();
     HandleInferiorState_Exited(process);
     break;
@@ -883,6 +1077,70 @@ void GDBRemoteCommunicationServerLLGS::DidExec(NativeProcessProtocol *process) {
   ClearProcessSpecificData();
 }
 
+void GDBRemoteCommunicationServerLLGS::ThreadStopped(
+    NativeProcessProtocol *process, NativeThreadProtocol &thread) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_THREAD));
+  LLDB_LOG(log, "pid {0} tid {1} stopped", process->GetID(),
+           thread.GetID());
+
+  // In all-stop mode the stop is reported through ProcessStateChanged once
+  // every thread has stopped.
+  if (!m_non_stop)
+    return;
+
+  // Flush pending inferior output before the stop, as in all-stop mode.
+  SendProcessOutput();
+
+  // Only the first queued stop is announced. The client drains the rest of
+  // the queue with vStopped.
+  const bool notify = m_stop_notification_queue.empty();
+  m_stop_notification_queue.push_back(thread.GetID());
+  if (notify)
+    SendStopReplyPacketForThread(thread.GetID(), /*as_notification=*/true);
+}
+
+void GDBRemoteCommunicationServerLLGS::TracepointHitsRecorded(
+    NativeProcessProtocol *process) {
+  SendTracepointHits();
+}
+
+void GDBRemoteCommunicationServerLLGS::SendTracepointHits() {
+  // Asynchronous packets can only be sent while the client waits for a stop
+  // in all-stop mode. In non-stop mode the hits stay in the process, which
+  // drops the oldest ones once it has too many.
+  if (!m_debugged_process_up || m_non_stop)
+    return;
+  size_t num_dropped = 0;
+  std::vector<NativeProcessProtocol::TracepointHit> hits =
+      m_debugged_process_up->TakeTracepointHits(num_dropped);
+  if (hits.empty() && num_dropped == 0)
+    return;
+
+  // There can be many hits, so write the JSON directly instead of building
+  // JSONObjects.
+  StreamString json;
+  json.Printf("JSON-async:{\"type\":\"tracepoint-hits\",\"dropped\":%zu,"
+              "\"hits\":[",
+              num_dropped);
+  for (size_t i = 0; i < hits.size(); ++i) {
+    const NativeProcessProtocol::TracepointHit &hit = hits[i];
+    json.Printf("%s[%" PRIu64 ",%" PRIu64 ",%" PRIu64, i ? "," : "", hit.tid,
+                hit.pc, hit.timestamp);
+    for (uint64_t value : hit.registers)
+      json.Printf(",%" PRIu64, value);
+    json.PutChar(']');
+  }
+  json.PutCString("]}");
+
+  StreamGDBRemote escaped_response;
+  escaped_response.PutEscapedBytes(json.GetData(), json.GetSize());
+  PacketResult result = SendPacketNoLock(escaped_response.GetString());
+  if (result != PacketResult::Success) {
+    Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+    LLDB_LOG(log, "failed to send {0} tracepoint hits", hits.size());
+  }
+}
+
 void GDBRemoteCommunicationServerLLGS::DataAvailableCallback() {
   Log *log(GetLogIfAnyCategoriesSet(GDBR_LOG_COMM));
 
@@ -1224,6 +1482,11 @@ GDBRemoteCommunicationServerLLGS::Handle_jTraceRead(
 
   json_dict->GetValueForKeyAsInteger("threadid", tid);
 
+  // Clients that know jTraceBinary+ ask for the data itself, escaped like in
+  // a binary memory read, instead of twice as much hex.
+  bool binary = false;
+  json_dict->GetValueForKeyAsBoolean("binary", binary);
+
   // Allocate the response buffer.
   std::unique_ptr<uint8_t[]> buffer (new (std::nothrow) uint8_t[byte_count]);
   if (!buffer)
@@ -1241,6 +1504,11 @@ GDBRemoteCommunicationServerLLGS::Handle_jTraceRead(
   if (error.Fail())
     return SendErrorResponse(error);
 
+  if (binary) {
+    response.PutEscapedBytes(buf.data(), buf.size());
+    return SendPacketNoLock(response.GetString());
+  }
+
   for (auto i : buf)
     response.PutHex8(i);
 
@@ -1472,6 +1740,8 @@ GDBRemoteCommunicationServerLLGS::Handle_vCont_actions(
     StringExtractorGDBRemote &packet) {
   StreamString response;
   response.Printf("vCont;c;C;s;S");
+  if (m_non_stop)
+    response.Printf(";t");
 
   return SendPacketNoLock(response.GetString());
 }
@@ -1548,6 +1818,14 @@ GDBRemoteCommunicationServerLLGS::Handle_vCont(
       thread_action.state = eStateStepping;
       break;
 
+    case 't':
+      // Stop, only meaningful in non-stop mode.
+      if (!m_non_stop)
+        return SendIllFormedResponse(
+            packet, "vCont t action requires non-stop mode");
+      thread_action.state = eStateStopped;
+      break;
+
     default:
       return SendIllFormedResponse(packet, "Unsupported vCont action");
       break;
@@ -1575,7 +1853,10 @@ GDBRemoteCommunicationServerLLGS::Handle_vCont(
   }
 
   LLDB_LOG(log, "continued process {0}", m_debugged_process_up->GetID());
-  // No response required from vCont.
+  // In non-stop mode vCont is acknowledged right away and stops are reported
+  // asynchronously. In all-stop mode the stop reply is the response.
+  if (m_non_stop)
+    return SendOKResponse();
   return PacketResult::Success;
 }
 
@@ -1604,9 +1885,77 @@ GDBRemoteCommunicationServerLLGS::Handle_stop_reason(
   if (!m_debugged_process_up)
     return SendErrorResponse(02);
 
+  if (m_non_stop && StateIsStoppedState(m_debugged_process_up->GetState(),
+                                        /*must_exist=*/true)) {
+    // Report every stopped thread: the first in the reply, the rest through
+    // the vStopped sequence.
+    m_stop_notification_queue.clear();
+    for (uint32_t i = 0;; ++i) {
+      NativeThreadProtocol *thread =
+          m_debugged_process_up->GetThreadAtIndex(i);
+      if (!thread)
+        break;
+      if (StateIsStoppedState(thread->GetState(), /*must_exist=*/true))
+        m_stop_notification_queue.push_back(thread->GetID());
+    }
+    if (m_stop_notification_queue.empty())
+      return SendOKResponse();
+    SetCurrentThreadID(m_stop_notification_queue.front());
+    return SendStopReplyPacketForThread(m_stop_notification_queue.front());
+  }
+
   return SendStopReasonForState(m_debugged_process_up->GetState());
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_QNonStop(
+    StringExtractorGDBRemote &packet) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
+
+  packet.SetFilePos(::strlen("QNonStop:"));
+  const uint32_t value = packet.GetU32(UINT32_MAX);
+  if (value > 1 || packet.GetBytesLeft())
+    return SendIllFormedResponse(packet, "QNonStop expects 0 or 1");
+
+  const bool non_stop = value == 1;
+  if (m_debugged_process_up) {
+    Status error = m_debugged_process_up->SetNonStopMode(non_stop);
+    if (error.Fail()) {
+      LLDB_LOG(log, "failed to set non-stop mode for pid {0}: {1}",
+               m_debugged_process_up->GetID(), error);
+      return SendErrorResponse(error);
+    }
+  }
+
+  m_non_stop = non_stop;
+  m_stop_notification_queue.clear();
+  return SendOKResponse();
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_vStopped(
+    StringExtractorGDBRemote &packet) {
+  if (!m_non_stop)
+    return SendUnimplementedResponse(packet.GetStringRef().data());
+
+  // The client has consumed the stop at the front of the queue. Report the
+  // next one, or OK once the queue is drained.
+  if (!m_stop_notification_queue.empty())
+    m_stop_notification_queue.pop_front();
+
+  while (!m_stop_notification_queue.empty()) {
+    const lldb::tid_t tid = m_stop_notification_queue.front();
+    // Skip threads that have exited or been resumed since they were queued.
+    NativeThreadProtocol *thread =
+        m_debugged_process_up ? m_debugged_process_up->GetThreadByID(tid)
+                              : nullptr;
+    if (thread && StateIsStoppedState(thread->GetState(), /*must_exist=*/true))
+      return SendStopReplyPacketForThread(tid);
+    m_stop_notification_queue.pop_front();
+  }
+  return SendOKResponse();
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::SendStopReasonForState(
     lldb::StateType process_state) {
@@ -2320,7 +2669,7 @@ GDBRemoteCommunicationServerLLGS::Handle_memory_read(
   packet.SetFilePos(0);
   char kind = packet.GetChar('?');
   if (kind == 'x')
-    response.PutEscapedBytes(buf.data(), byte_count);
+    response.PutEscapedBytes(buf.data(), bytes_read);
   else {
     assert(kind == 'm');
     for (size_t i = 0; i < bytes_read; ++i)
@@ -2330,6 +2679,83 @@ GDBRemoteCommunicationServerLLGS::Handle_memory_read(
   return SendPacketNoLock(response.GetString());
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_MultiMemRead(
+    StringExtractorGDBRemote &packet) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
+
+  if (!m_debugged_process_up ||
+      (m_debugged_process_up->GetID() == LLDB_INVALID_PROCESS_ID)) {
+    LLDB_LOGF(
+        log,
+        "GDBRemoteCommunicationServerLLGS::%s failed, no process available",
+        __FUNCTION__);
+    return SendErrorResponse(0x15);
+  }
+
+  // MultiMemRead:ranges:<hex_addr1>,<hex_size1>,...,<hex_addrN>,<hex_sizeN>;
+  packet.SetFilePos(strlen("MultiMemRead:"));
+  if (!packet.ConsumeFront("ranges:"))
+    return SendIllFormedResponse(packet, "Ranges missing in MultiMemRead");
+
+  std::vector<std::pair<lldb::addr_t, uint64_t>> ranges;
+  uint64_t total_size = 0;
+  while (packet.GetBytesLeft() > 0 && packet.PeekChar() != ';') {
+    if (!ranges.empty() && packet.GetChar() != ',')
+      return SendIllFormedResponse(packet,
+                                   "Comma sep missing in MultiMemRead");
+    const lldb::addr_t addr = packet.GetHexMaxU64(false, LLDB_INVALID_ADDRESS);
+    if (addr == LLDB_INVALID_ADDRESS || packet.GetChar() != ',')
+      return SendIllFormedResponse(packet, "Invalid range in MultiMemRead");
+    const uint64_t size = packet.GetHexMaxU64(false, UINT64_MAX);
+    if (size == UINT64_MAX)
+      return SendIllFormedResponse(packet, "Invalid range in MultiMemRead");
+    ranges.emplace_back(addr, size);
+    total_size += size;
+  }
+  if (ranges.empty() || packet.GetChar() != ';')
+    return SendIllFormedResponse(packet, "Ranges missing in MultiMemRead");
+
+  // The whole reply has to fit into a single packet, it's up to the client
+  // to split its requests accordingly.
+  if (total_size > 128 * 1024)
+    return SendErrorResponse(0x78);
+
+  // Reply with the number of bytes read from each range, followed by the
+  // binary data of all ranges: <hex_read1>,...,<hex_readN>;<binary data>
+  // Read every range straight into its slot of one buffer, letting the
+  // process read all of them with as few system calls as it can.
+  std::string data(total_size, '\0');
+  std::vector<MemoryReadRange> reads;
+  reads.reserve(ranges.size());
+  size_t offset = 0;
+  for (const auto &range : ranges) {
+    reads.push_back({range.first, &data[0] + offset, size_t(range.second), 0});
+    offset += range.second;
+  }
+  m_debugged_process_up->ReadMemoryRangesWithoutTrap(reads);
+
+  StreamGDBRemote response;
+  std::string read_data;
+  read_data.reserve(total_size);
+  for (size_t i = 0; i < reads.size(); ++i) {
+    if (reads[i].bytes_read < reads[i].size)
+      LLDB_LOGF(log,
+                "GDBRemoteCommunicationServerLLGS::%s pid %" PRIu64
+                " mem 0x%" PRIx64 ": read %" PRIu64 " of %" PRIu64 " bytes",
+                __FUNCTION__, m_debugged_process_up->GetID(), reads[i].addr,
+                uint64_t(reads[i].bytes_read), uint64_t(reads[i].size));
+    response.Printf("%s%" PRIx64, i == 0 ? "" : ",",
+                    uint64_t(reads[i].bytes_read));
+    read_data.append(static_cast<const char *>(reads[i].buf),
+                     reads[i].bytes_read);
+  }
+  response.PutChar(';');
+  response.PutEscapedBytes(read_data.data(), read_data.size());
+
+  return SendPacketNoLock(response.GetString());
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_M(StringExtractorGDBRemote &packet) {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
@@ -2513,6 +2939,80 @@ GDBRemoteCommunicationServerLLGS::Handle_qMemoryRegionInfo(
   return SendPacketNoLock(response.GetString());
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_qSearchMemory(
+    StringExtractorGDBRemote &packet) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
+
+  // Ensure we have a process.
+  if (!m_debugged_process_up ||
+      (m_debugged_process_up->GetID() == LLDB_INVALID_PROCESS_ID)) {
+    LLDB_LOGF(
+        log,
+        "GDBRemoteCommunicationServerLLGS::%s failed, no process available",
+        __FUNCTION__);
+    return SendErrorResponse(0x15);
+  }
+
+  // qSearch:memory:<hex_addr>;<hex_length>;<binary pattern>
+  packet.SetFilePos(strlen("qSearch:memory:"));
+  const lldb::addr_t addr = packet.GetHexMaxU64(false, LLDB_INVALID_ADDRESS);
+  if (addr == LLDB_INVALID_ADDRESS || packet.GetChar() != ';')
+    return SendIllFormedResponse(packet, "Invalid address in qSearch:memory");
+  const uint64_t length = packet.GetHexMaxU64(false, UINT64_MAX);
+  if (length == UINT64_MAX || packet.GetChar() != ';')
+    return SendIllFormedResponse(packet, "Invalid length in qSearch:memory");
+  std::string pattern;
+  if (packet.GetEscapedBinaryData(pattern) == 0)
+    return SendIllFormedResponse(packet, "Missing pattern in qSearch:memory");
+
+  // Read the memory in large chunks and search each of them, keeping the end
+  // of the previous chunk around for matches that straddle two chunks.
+  // Regions that can't be read are skipped.
+  const size_t chunk_size = std::max<size_t>(1024 * 1024, pattern.size());
+  const lldb::addr_t end = addr + std::min(length, UINT64_MAX - addr);
+  std::string data;
+  lldb::addr_t data_addr = addr;
+  lldb::addr_t read_addr = addr;
+  while (read_addr < end) {
+    const size_t size = std::min<uint64_t>(chunk_size, end - read_addr);
+    const size_t kept = data.size();
+    data.resize(kept + size);
+    size_t bytes_read = 0;
+    m_debugged_process_up->ReadMemoryWithoutTrap(read_addr, &data[kept], size,
+                                                 bytes_read);
+    data.resize(kept + bytes_read);
+
+    const size_t pos = llvm::StringRef(data).find(pattern);
+    if (pos != llvm::StringRef::npos) {
+      StreamGDBRemote response;
+      response.Printf("1,%" PRIx64, data_addr + pos);
+      return SendPacketNoLock(response.GetString());
+    }
+
+    if (bytes_read == size) {
+      const size_t keep = std::min(data.size(), pattern.size() - 1);
+      data.erase(0, data.size() - keep);
+      read_addr += size;
+      data_addr = read_addr - keep;
+      continue;
+    }
+
+    const lldb::addr_t unreadable_addr = read_addr + bytes_read;
+    MemoryRegionInfo region_info;
+    if (m_debugged_process_up->GetMemoryRegionInfo(unreadable_addr,
+                                                   region_info)
+            .Fail() ||
+        region_info.GetRange().GetRangeEnd() <= unreadable_addr)
+      break;
+    data.clear();
+    read_addr = region_info.GetRange().GetRangeEnd();
+    data_addr = read_addr;
+  }
+
+  return SendPacketNoLock("0");
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_Z(StringExtractorGDBRemote &packet) {
   // Ensure we have a process.
@@ -2584,10 +3084,34 @@ GDBRemoteCommunicationServerLLGS::Handle_Z(StringExtractorGDBRemote &packet) {
     return SendIllFormedResponse(
         packet, "Malformed Z packet, failed to parse size argument");
 
+  // Parse out the optional ";X<len>,<bytecode>" breakpoint conditions.
+  std::vector<AgentExpression> conditions;
+  while (packet.GetBytesLeft() > 0 && packet.PeekChar() == ';') {
+    packet.GetChar();
+    if (packet.GetChar() != 'X')
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, unsupported condition list");
+    const uint32_t length = packet.GetHexMaxU32(false, 0);
+    if (length == 0 || packet.GetChar() != ',')
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, failed to parse condition length");
+    std::vector<uint8_t> bytes(length);
+    if (packet.GetHexBytes(bytes, 0) != length)
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, failed to parse condition");
+    conditions.emplace_back(bytes);
+  }
+  if (!conditions.empty() && (!want_breakpoint || want_hardware))
+    return SendIllFormedResponse(
+        packet, "Conditions are only supported for software breakpoints");
+
   if (want_breakpoint) {
     // Try to set the breakpoint.
-    const Status error =
+    Status error =
         m_debugged_process_up->SetBreakpoint(addr, size, want_hardware);
+    if (error.Success() && !conditions.empty())
+      error = m_debugged_process_up->SetSoftwareBreakpointConditions(
+          addr, std::move(conditions));
     if (error.Success())
       return SendOKResponse();
     Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
@@ -2745,6 +3269,36 @@ GDBRemoteCommunicationServerLLGS::Handle_s(StringExtractorGDBRemote &packet) {
   return PacketResult::Success;
 }
 
+// Compare two snapshots of the libraries-svr4 list. A library that stayed at
+// the same link_map address but changed in any other way is reported as
+// removed and added again.
+static void DiffSVR4Libraries(const std::vector<SVR4LibraryInfo> &old_list,
+                              const std::vector<SVR4LibraryInfo> &new_list,
+                              std::vector<const SVR4LibraryInfo *> &added,
+                              std::vector<lldb::addr_t> &removed) {
+  std::unordered_map<lldb::addr_t, const SVR4LibraryInfo *> old_libraries;
+  for (const SVR4LibraryInfo &library : old_list)
+    old_libraries[library.link_map] = &library;
+
+  for (const SVR4LibraryInfo &library : new_list) {
+    auto pos = old_libraries.find(library.link_map);
+    if (pos != old_libraries.end() && pos->second->name == library.name &&
+        pos->second->base_addr == library.base_addr &&
+        pos->second->ld_addr == library.ld_addr) {
+      // Unchanged, so it is neither added nor removed.
+      old_libraries.erase(pos);
+      continue;
+    }
+    added.push_back(&library);
+  }
+
+  // Whatever is left in the old map is gone. Walk the old list so that the
+  // result comes out in link map order.
+  for (const SVR4LibraryInfo &library : old_list)
+    if (old_libraries.count(library.link_map))
+      removed.push_back(library.link_map);
+}
+
 llvm::Expected<std::unique_ptr<llvm::MemoryBuffer>>
 GDBRemoteCommunicationServerLLGS::ReadXferObject(llvm::StringRef object,
                                                  llvm::StringRef annex) {
@@ -2768,14 +3322,44 @@ GDBRemoteCommunicationServerLLGS::ReadXferObject(llvm::StringRef object,
     if (!library_list)
       return library_list.takeError();
 
+    // The annex may name the generation of the list the client already has,
+    // in which case we only need to send what changed since then.
+    bool has_base_generation = false;
+    uint32_t base_generation = 0;
+    if (annex.consume_front("generation="))
+      has_base_generation = !annex.getAsInteger(16, base_generation);
+
+    std::vector<const SVR4LibraryInfo *> added;
+    std::vector<lldb::addr_t> removed;
+    DiffSVR4Libraries(m_svr4_libraries, *library_list, added, removed);
+    const uint32_t prev_generation = m_svr4_generation;
+    if (!added.empty() || !removed.empty())
+      ++m_svr4_generation;
+    const bool send_delta =
+        has_base_generation && base_generation == prev_generation;
+    m_svr4_libraries = std::move(*library_list);
+
     StreamString response;
-    response.Printf("<library-list-svr4 version=\"1.0\">");
-    for (auto const &library : *library_list) {
+    response.Printf("<library-list-svr4 version=\"1.0\" generation=\"0x%x\"",
+                    m_svr4_generation);
+    if (send_delta)
+      response.Printf(" base-generation=\"0x%x\"", prev_generation);
+    response.PutChar('>');
+    auto put_library = [&response](const SVR4LibraryInfo &library) {
       response.Printf("<library name=\"%s\" ",
                       XMLEncodeAttributeValue(library.name.c_str()).c_str());
       response.Printf("lm=\"0x%" PRIx64 "\" ", library.link_map);
       response.Printf("l_addr=\"0x%" PRIx64 "\" ", library.base_addr);
       response.Printf("l_ld=\"0x%" PRIx64 "\" />", library.ld_addr);
+    };
+    if (send_delta) {
+      for (const SVR4LibraryInfo *library : added)
+        put_library(*library);
+      for (lldb::addr_t link_map : removed)
+        response.Printf("<removed lm=\"0x%" PRIx64 "\" />", link_map);
+    } else {
+      for (auto const &library : m_svr4_libraries)
+        put_library(library);
     }
     response.Printf("</library-list-svr4>");
     return MemoryBuffer::getMemBufferCopy(response.GetString(), __FUNCTION__);
@@ -2967,6 +3551,139 @@ GDBRemoteCommunicationServerLLGS::Handle_QRestoreRegisterState(
   return SendOKResponse();
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_QSaveSnapshot(
+    StringExtractorGDBRemote &packet) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
+
+  // Ensure we have a process.
+  if (!m_debugged_process_up ||
+      (m_debugged_process_up->GetID() == LLDB_INVALID_PROCESS_ID)) {
+    LLDB_LOGF(
+        log,
+        "GDBRemoteCommunicationServerLLGS::%s failed, no process available",
+        __FUNCTION__);
+    return SendErrorResponse(0x15);
+  }
+
+  llvm::Expected<lldb::user_id_t> snapshot_id =
+      m_debugged_process_up->SaveSnapshot();
+  if (!snapshot_id)
+    return SendErrorResponse(snapshot_id.takeError());
+
+  StreamGDBRemote response;
+  response.Printf("%" PRIx64, *snapshot_id);
+  return SendPacketNoLock(response.GetString());
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_QRestoreSnapshot(
+    StringExtractorGDBRemote &packet) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
+
+  // Ensure we have a process.
+  if (!m_debugged_process_up ||
+      (m_debugged_process_up->GetID() == LLDB_INVALID_PROCESS_ID)) {
+    LLDB_LOGF(
+        log,
+        "GDBRemoteCommunicationServerLLGS::%s failed, no process available",
+        __FUNCTION__);
+    return SendErrorResponse(0x15);
+  }
+
+  packet.SetFilePos(strlen("QRestoreSnapshot:"));
+  const lldb::user_id_t snapshot_id =
+      packet.GetHexMaxU64(false, LLDB_INVALID_UID);
+  if (snapshot_id == LLDB_INVALID_UID || packet.GetBytesLeft() != 0)
+    return SendIllFormedResponse(packet, "Invalid QRestoreSnapshot packet");
+
+  Status error = m_debugged_process_up->RestoreSnapshot(snapshot_id);
+  if (error.Fail())
+    return SendErrorResponse(error);
+
+  // The threads the client selected are gone.
+  m_current_tid = LLDB_INVALID_THREAD_ID;
+  m_continue_tid = LLDB_INVALID_THREAD_ID;
+
+  StreamGDBRemote response;
+  response.Printf("%" PRIx64, m_debugged_process_up->GetID());
+  return SendPacketNoLock(response.GetString());
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_QDeleteSnapshot(
+    StringExtractorGDBRemote &packet) {
+  if (!m_debugged_process_up ||
+      (m_debugged_process_up->GetID() == LLDB_INVALID_PROCESS_ID))
+    return SendErrorResponse(0x15);
+
+  packet.SetFilePos(strlen("QDeleteSnapshot:"));
+  const lldb::user_id_t snapshot_id =
+      packet.GetHexMaxU64(false, LLDB_INVALID_UID);
+  if (snapshot_id == LLDB_INVALID_UID || packet.GetBytesLeft() != 0)
+    return SendIllFormedResponse(packet, "Invalid QDeleteSnapshot packet");
+
+  Status error = m_debugged_process_up->DeleteSnapshot(snapshot_id);
+  if (error.Fail())
+    return SendErrorResponse(error);
+  return SendOKResponse();
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_QSetTracepoint(
+    StringExtractorGDBRemote &packet) {
+  if (!m_debugged_process_up ||
+      (m_debugged_process_up->GetID() == LLDB_INVALID_PROCESS_ID))
+    return SendErrorResponse(0x15);
+
+  packet.SetFilePos(strlen("QSetTracepoint:"));
+  const lldb::addr_t addr = packet.GetHexMaxU64(false, LLDB_INVALID_ADDRESS);
+  if (addr == LLDB_INVALID_ADDRESS)
+    return SendIllFormedResponse(packet, "Invalid QSetTracepoint packet");
+
+  // The registers to record follow as a comma separated list.
+  std::vector<uint32_t> registers;
+  if (packet.GetBytesLeft()) {
+    if (packet.GetChar() != ';')
+      return SendIllFormedResponse(packet, "Invalid QSetTracepoint packet");
+    while (true) {
+      const uint32_t regnum = packet.GetHexMaxU32(false, LLDB_INVALID_REGNUM);
+      if (regnum == LLDB_INVALID_REGNUM)
+        return SendIllFormedResponse(packet,
+                                     "Invalid QSetTracepoint register");
+      registers.push_back(regnum);
+      if (!packet.GetBytesLeft())
+        break;
+      if (packet.GetChar() != ',')
+        return SendIllFormedResponse(packet, "Invalid QSetTracepoint packet");
+    }
+  }
+
+  Status error =
+      m_debugged_process_up->SetTracepoint(addr, std::move(registers));
+  if (error.Fail())
+    return SendErrorResponse(error);
+  return SendOKResponse();
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_QClearTracepoint(
+    StringExtractorGDBRemote &packet) {
+  if (!m_debugged_process_up ||
+      (m_debugged_process_up->GetID() == LLDB_INVALID_PROCESS_ID))
+    return SendErrorResponse(0x15);
+
+  packet.SetFilePos(strlen("QClearTracepoint:"));
+  const lldb::addr_t addr = packet.GetHexMaxU64(false, LLDB_INVALID_ADDRESS);
+  if (addr == LLDB_INVALID_ADDRESS || packet.GetBytesLeft() != 0)
+    return SendIllFormedResponse(packet, "Invalid QClearTracepoint packet");
+
+  Status error = m_debugged_process_up->RemoveTracepoint(addr);
+  if (error.Fail())
+    return SendErrorResponse(error);
+  return SendOKResponse();
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_vAttach(
     StringExtractorGDBRemote &packet) {
@@ -3068,7 +3785,7 @@ GDBRemoteCommunicationServerLLGS::Handle_qThreadStopInfo(
 
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_jThreadsInfo(
-    StringExtractorGDBRemote &) {
+    StringExtractorGDBRemote &packet) {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_THREAD));
 
   // Ensure we have a debugged process.
@@ -3077,17 +3794,77 @@ GDBRemoteCommunicationServerLLGS::Handle_jThreadsInfo(
     return SendErrorResponse(50);
   LLDB_LOG(log, "preparing packet for pid {0}", m_debugged_process_up->GetID());
 
+  // A client that understands deltas passes the generation of the thread
+  // infos it already has, if it has any, and gets an object back instead of
+  // the bare array.
+  bool with_generation = false;
+  bool has_base_generation = false;
+  uint32_t base_generation = 0;
+  if (packet.ConsumeFront("jThreadsInfo:")) {
+    auto json_object = StructuredData::ParseJSON(packet.Peek());
+    if (!json_object ||
+        json_object->GetType() != lldb::eStructuredDataTypeDictionary)
+      return SendIllFormedResponse(packet, "jThreadsInfo: Ill formed packet ");
+    with_generation = true;
+    has_base_generation =
+        json_object->GetAsDictionary()->GetValueForKeyAsInteger(
+            "generation", base_generation);
+  }
+
   StreamString response;
   const bool threads_with_valid_stop_info_only = false;
   JSONArray::SP threads_array_sp = GetJSONThreadsInfo(
-      *m_debugged_process_up, threads_with_valid_stop_info_only);
+      *m_debugged_process_up, threads_with_valid_stop_info_only,
+      m_expedited_stack_size, m_expedited_frame_count);
   if (!threads_array_sp) {
     LLDB_LOG(log, "failed to prepare a packet for pid {0}",
              m_debugged_process_up->GetID());
     return SendErrorResponse(52);
   }
 
-  threads_array_sp->Write(response);
+  if (!with_generation) {
+    threads_array_sp->Write(response);
+  } else {
+    std::vector<lldb::tid_t> tids;
+    std::map<lldb::tid_t, std::string> threads_info;
+    for (size_t i = 0; i < threads_array_sp->GetNumElements(); ++i) {
+      auto *thread_obj =
+          llvm::cast<JSONObject>(threads_array_sp->GetObject(i).get());
+      const lldb::tid_t tid =
+          llvm::cast<JSONNumber>(thread_obj->GetObject("tid").get())
+              ->GetAsUnsigned();
+      StreamString thread_info;
+      thread_obj->Write(thread_info);
+      tids.push_back(tid);
+      threads_info[tid] = thread_info.GetString();
+    }
+
+    const uint32_t prev_generation = m_threads_info_generation;
+    if (threads_info != m_threads_info)
+      ++m_threads_info_generation;
+    const bool send_delta =
+        has_base_generation && base_generation == prev_generation;
+
+    response.Printf("{\"generation\":%u", m_threads_info_generation);
+    if (send_delta)
+      response.Printf(",\"base-generation\":%u", prev_generation);
+    response.PutCString(",\"threads\":[");
+    for (size_t i = 0; i < tids.size(); ++i) {
+      if (i > 0)
+        response.PutChar(',');
+      const std::string &thread_info = threads_info[tids[i]];
+      auto prev_pos = m_threads_info.find(tids[i]);
+      if (send_delta && prev_pos != m_threads_info.end() &&
+          prev_pos->second == thread_info)
+        response.Printf("{\"tid\":%" PRIu64 ",\"unchanged\":true}",
+                        tids[i]);
+      else
+        response.PutCString(thread_info);
+    }
+    response.PutCString("]}");
+    m_threads_info = std::move(threads_info);
+  }
+
   StreamGDBRemote escaped_response;
   escaped_response.PutEscapedBytes(response.GetData(), response.GetSize());
   return SendPacketNoLock(escaped_response.GetString());
@@ -3181,6 +3958,34 @@ GDBRemoteCommunicationServerLLGS::Handle_QPassSignals(
   return SendOKResponse();
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_QSetExpeditedStackMemory(
+    StringExtractorGDBRemote &packet) {
+  packet.SetFilePos(strlen("QSetExpeditedStackMemory:"));
+
+  uint64_t stack_size = m_expedited_stack_size;
+  uint64_t frame_count = m_expedited_frame_count;
+  llvm::StringRef key, value;
+  while (packet.GetNameColonValue(key, value)) {
+    if (key == "size") {
+      if (value.getAsInteger(16, stack_size))
+        return SendIllFormedResponse(packet, "Invalid size");
+    } else if (key == "frames") {
+      if (value.getAsInteger(16, frame_count) || frame_count > UINT32_MAX)
+        return SendIllFormedResponse(packet, "Invalid frame count");
+    }
+  }
+
+  // Keep the stop reply packets within reason.
+  const uint64_t max_stack_size = 16 * 1024;
+  if (stack_size > max_stack_size)
+    return SendErrorResponse(0x5a);
+
+  m_expedited_stack_size = stack_size;
+  m_expedited_frame_count = frame_count;
+  return SendOKResponse();
+}
+
 void GDBRemoteCommunicationServerLLGS::MaybeCloseInferiorTerminalConnection() {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
 
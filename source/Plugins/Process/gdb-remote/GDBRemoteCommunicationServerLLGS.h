@@ -9,6 +9,8 @@
 #ifndef liblldb_GDBRemoteCommunicationServerLLGS_h_
 #define liblldb_GDBRemoteCommunicationServerLLGS_h_
 
+#include <deque>
+#include <map>
 #include <mutex>
 #include <unordered_map>
 
@@ -67,6 +69,11 @@ public:
 
   void DidExec(NativeProcessProtocol *process) override;
 
+  void ThreadStopped(NativeProcessProtocol *process,
+                     NativeThreadProtocol &thread) override;
+
+  void TracepointHitsRecorded(NativeProcessProtocol *process) override;
+
   Status InitializeConnection(std::unique_ptr<Connection> &&connection);
 
 protected:
@@ -88,11 +95,35 @@ protected:
   uint32_t m_next_saved_registers_id = 1;
   bool m_handshake_completed = false;
 
+  // How much memory to expedite from the stack of each stopped thread in the
+  // stop reply and jThreadsInfo: this many bytes starting at the stack
+  // pointer, and this many links of the frame pointer chain.
+  size_t m_expedited_stack_size = 256;
+  uint32_t m_expedited_frame_count = 8;
+
+  // The libraries-svr4 list we last sent and its generation. A client that
+  // asks for a delta against this generation only gets the changes.
+  std::vector<SVR4LibraryInfo> m_svr4_libraries;
+  uint32_t m_svr4_generation = 0;
+
+  // The serialized info of each thread we last sent in a jThreadsInfo reply
+  // with a generation, and that generation. A client that names it only
+  // gets the threads whose info changed since.
+  std::map<lldb::tid_t, std::string> m_threads_info;
+  uint32_t m_threads_info_generation = 0;
+
+  // Non-stop mode, as negotiated with QNonStop. Stopped threads that have
+  // not yet been acknowledged by the client with vStopped; a %Stop
+  // notification is only sent when this goes from empty to non-empty.
+  bool m_non_stop = false;
+  std::deque<lldb::tid_t> m_stop_notification_queue;
+
   PacketResult SendONotification(const char *buffer, uint32_t len);
 
   PacketResult SendWResponse(NativeProcessProtocol *process);
 
-  PacketResult SendStopReplyPacketForThread(lldb::tid_t tid);
+  PacketResult SendStopReplyPacketForThread(lldb::tid_t tid,
+                                            bool as_notification = false);
 
   PacketResult SendStopReasonForState(lldb::StateType process_state);
 
@@ -118,6 +149,10 @@ protected:
 
   PacketResult Handle_stop_reason(StringExtractorGDBRemote &packet);
 
+  PacketResult Handle_QNonStop(StringExtractorGDBRemote &packet);
+
+  PacketResult Handle_vStopped(StringExtractorGDBRemote &packet);
+
   PacketResult Handle_qRegisterInfo(StringExtractorGDBRemote &packet);
 
   PacketResult Handle_qfThreadInfo(StringExtractorGDBRemote &packet);
@@ -139,11 +174,15 @@ protected:
 
   PacketResult Handle_M(StringExtractorGDBRemote &packet);
 
+  PacketResult Handle_MultiMemRead(StringExtractorGDBRemote &packet);
+
   PacketResult
   Handle_qMemoryRegionInfoSupported(StringExtractorGDBRemote &packet);
 
   PacketResult Handle_qMemoryRegionInfo(StringExtractorGDBRemote &packet);
 
+  PacketResult Handle_qSearchMemory(StringExtractorGDBRemote &packet);
+
   PacketResult Handle_Z(StringExtractorGDBRemote &packet);
 
   PacketResult Handle_z(StringExtractorGDBRemote &packet);
@@ -164,6 +203,16 @@ protected:
 
   PacketResult Handle_QRestoreRegisterState(StringExtractorGDBRemote &packet);
 
+  PacketResult Handle_QSaveSnapshot(StringExtractorGDBRemote &packet);
+
+  PacketResult Handle_QRestoreSnapshot(StringExtractorGDBRemote &packet);
+
+  PacketResult Handle_QDeleteSnapshot(StringExtractorGDBRemote &packet);
+
+  PacketResult Handle_QSetTracepoint(StringExtractorGDBRemote &packet);
+
+  PacketResult Handle_QClearTracepoint(StringExtractorGDBRemote &packet);
+
   PacketResult Handle_vAttach(StringExtractorGDBRemote &packet);
 
   PacketResult Handle_D(StringExtractorGDBRemote &packet);
@@ -178,6 +227,9 @@ protected:
 
   PacketResult Handle_QPassSignals(StringExtractorGDBRemote &packet);
 
+  PacketResult
+  Handle_QSetExpeditedStackMemory(StringExtractorGDBRemote &packet);
+
   PacketResult Handle_g(StringExtractorGDBRemote &packet);
 
   void SetCurrentThreadID(lldb::tid_t tid);
@@ -217,6 +269,10 @@ private:
 
   void SendProcessOutput();
 
+  /// Send the tracepoint hits the process recorded as an asynchronous JSON
+  /// packet.
+  void SendTracepointHits();
+
   void StartSTDIOForwarding();
 
   void StopSTDIOForwarding();
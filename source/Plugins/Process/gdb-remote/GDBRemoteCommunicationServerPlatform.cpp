@@ -10,6 +10,7 @@
 
 #include <errno.h>
 
+#include <algorithm>
 #include <chrono>
 #include <csignal>
 #include <cstring>
@@ -85,7 +86,13 @@ GDBRemoteCommunicationServerPlatform::GDBRemoteCommunicationServerPlatform(
 }
 
 // Destructor
-GDBRemoteCommunicationServerPlatform::~GDBRemoteCommunicationServerPlatform() {}
+GDBRemoteCommunicationServerPlatform::~GDBRemoteCommunicationServerPlatform() {
+  // Pooled gdbservers that were never handed out would otherwise wait for a
+  // connection forever.
+  std::lock_guard<std::recursive_mutex> guard(m_spawned_pids_mutex);
+  for (const PooledGDBServer &server : m_gdbserver_pool)
+    Host::Kill(server.pid, SIGTERM);
+}
 
 Status GDBRemoteCommunicationServerPlatform::LaunchGDBServer(
     const lldb_private::Args &args, std::string hostname, lldb::pid_t &pid,
@@ -140,7 +147,8 @@ Status GDBRemoteCommunicationServerPlatform::LaunchGDBServer(
   }
 
   Status error = StartDebugserverProcess(
-      url.str().c_str(), nullptr, debugserver_launch_info, port_ptr, &args, -1);
+      url.str().c_str(), nullptr, debugserver_launch_info, port_ptr, &args, -1,
+      -1);
 
   pid = debugserver_launch_info.GetProcessID();
   if (pid != LLDB_INVALID_PROCESS_ID) {
@@ -180,8 +188,13 @@ GDBRemoteCommunicationServerPlatform::Handle_qLaunchGDBServer(
 
   lldb::pid_t debugserver_pid = LLDB_INVALID_PROCESS_ID;
   std::string socket_name;
-  Status error =
-      LaunchGDBServer(Args(), hostname, debugserver_pid, port, socket_name);
+  Status error;
+  // A pooled gdbserver can only be used when the client did not ask for a
+  // specific port.
+  if (port != UINT16_MAX ||
+      !TakePooledGDBServer(debugserver_pid, port, socket_name))
+    error =
+        LaunchGDBServer(Args(), hostname, debugserver_pid, port, socket_name);
   if (error.Fail()) {
     LLDB_LOGF(log,
               "GDBRemoteCommunicationServerPlatform::%s() debugserver "
@@ -209,9 +222,55 @@ GDBRemoteCommunicationServerPlatform::Handle_qLaunchGDBServer(
     if (debugserver_pid != LLDB_INVALID_PROCESS_ID)
       Host::Kill(debugserver_pid, SIGINT);
   }
+
+  // Replace the gdbserver we may have taken from the pool now that the client
+  // has its answer.
+  FillGDBServerPool();
   return packet_result;
 }
 
+void GDBRemoteCommunicationServerPlatform::FillGDBServerPool() {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PLATFORM));
+
+  while (true) {
+    {
+      std::lock_guard<std::recursive_mutex> guard(m_spawned_pids_mutex);
+      if (m_gdbserver_pool.size() >= m_gdbserver_pool_size)
+        return;
+    }
+
+    PooledGDBServer server;
+    server.pid = LLDB_INVALID_PROCESS_ID;
+    server.port = UINT16_MAX;
+    Status error = LaunchGDBServer(Args(), "", server.pid, server.port,
+                                   server.socket_name);
+    if (error.Fail()) {
+      // Most likely we ran out of ports. Leave them to explicit requests.
+      LLDB_LOG(log, "failed to launch pooled gdbserver: {0}", error);
+      return;
+    }
+
+    LLDB_LOG(log, "launched pooled gdbserver pid {0} port {1}", server.pid,
+             server.port);
+    std::lock_guard<std::recursive_mutex> guard(m_spawned_pids_mutex);
+    m_gdbserver_pool.push_back(std::move(server));
+  }
+}
+
+bool GDBRemoteCommunicationServerPlatform::TakePooledGDBServer(
+    lldb::pid_t &pid, uint16_t &port, std::string &socket_name) {
+  std::lock_guard<std::recursive_mutex> guard(m_spawned_pids_mutex);
+  if (m_gdbserver_pool.empty())
+    return false;
+
+  PooledGDBServer &server = m_gdbserver_pool.front();
+  pid = server.pid;
+  port = server.port;
+  socket_name = std::move(server.socket_name);
+  m_gdbserver_pool.pop_front();
+  return true;
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerPlatform::Handle_qQueryGDBServer(
     StringExtractorGDBRemote &packet) {
@@ -419,6 +478,12 @@ bool GDBRemoteCommunicationServerPlatform::DebugserverProcessReaped(
   std::lock_guard<std::recursive_mutex> guard(m_spawned_pids_mutex);
   FreePortForProcess(pid);
   m_spawned_pids.erase(pid);
+  m_gdbserver_pool.erase(
+      std::remove_if(m_gdbserver_pool.begin(), m_gdbserver_pool.end(),
+                     [pid](const PooledGDBServer &server) {
+                       return server.pid == pid;
+                     }),
+      m_gdbserver_pool.end());
   return true;
 }
 
@@ -9,6 +9,7 @@
 #ifndef liblldb_GDBRemoteCommunicationServerPlatform_h_
 #define liblldb_GDBRemoteCommunicationServerPlatform_h_
 
+#include <deque>
 #include <map>
 #include <mutex>
 #include <set>
@@ -61,6 +62,15 @@ public:
   void SetPendingGdbServer(lldb::pid_t pid, uint16_t port,
                            const std::string &socket_name);
 
+  // Keep this many gdbserver processes launched ahead of time. Each one has
+  // already initialized and is waiting for a connection, so handing it out
+  // for a qLaunchGDBServer does not pay for the process startup.
+  void SetGDBServerPoolSize(size_t size) { m_gdbserver_pool_size = size; }
+
+  // Launch gdbservers until the pool is full. This needs the connection to
+  // the client to be established.
+  void FillGDBServerPool();
+
 protected:
   const Socket::SocketProtocol m_socket_protocol;
   const std::string m_socket_scheme;
@@ -75,6 +85,16 @@ protected:
     std::string socket_name;
   } m_pending_gdb_server;
 
+  struct PooledGDBServer {
+    lldb::pid_t pid;
+    uint16_t port;
+    std::string socket_name;
+  };
+  // Guarded by m_spawned_pids_mutex, as entries are dropped when the process
+  // is reaped.
+  std::deque<PooledGDBServer> m_gdbserver_pool;
+  size_t m_gdbserver_pool_size = 0;
+
   PacketResult Handle_qLaunchGDBServer(StringExtractorGDBRemote &packet);
 
   PacketResult Handle_qQueryGDBServer(StringExtractorGDBRemote &packet);
@@ -96,6 +116,9 @@ private:
 
   bool DebugserverProcessReaped(lldb::pid_t pid);
 
+  bool TakePooledGDBServer(lldb::pid_t &pid, uint16_t &port,
+                           std::string &socket_name);
+
   static const FileSpec &GetDomainSocketDir();
 
   static FileSpec GetDomainSocketPath(const char *prefix);
@@ -33,7 +33,8 @@ GDBRemoteRegisterContext::GDBRemoteRegisterContext(
     ThreadGDBRemote &thread, uint32_t concrete_frame_idx,
     GDBRemoteDynamicRegisterInfo &reg_info, bool read_all_at_once)
     : RegisterContext(thread, concrete_frame_idx), m_reg_info(reg_info),
-      m_reg_valid(), m_reg_data(), m_read_all_at_once(read_all_at_once) {
+      m_reg_valid(), m_reg_data(), m_read_all_at_once(read_all_at_once),
+      m_sent_read_all(false) {
   // Resize our vector of bools to contain one bool for every register. We will
   // use these boolean values to know when a register value is valid in
   // m_reg_data.
@@ -51,6 +52,7 @@ GDBRemoteRegisterContext::~GDBRemoteRegisterContext() {}
 
 void GDBRemoteRegisterContext::InvalidateAllRegisters() {
   SetAllRegisterValid(false);
+  m_sent_read_all = false;
 }
 
 void GDBRemoteRegisterContext::SetAllRegisterValid(bool b) {
@@ -163,6 +165,41 @@ bool GDBRemoteRegisterContext::PrivateSetRegisterValue(uint32_t reg,
   return false;
 }
 
+// Helper function for GDBRemoteRegisterContext::ReadRegisterBytes().
+bool GDBRemoteRegisterContext::ReadAllRegistersAtOnce(
+    GDBRemoteCommunicationClient &gdb_comm) {
+  DataBufferSP buffer_sp = gdb_comm.ReadAllRegisters(m_thread.GetProtocolID());
+  if (!buffer_sp)
+    return false;
+
+  const size_t size =
+      std::min<size_t>(buffer_sp->GetByteSize(), m_reg_data.GetByteSize());
+  memcpy(const_cast<uint8_t *>(m_reg_data.GetDataStart()),
+         buffer_sp->GetBytes(), size);
+  if (size >= m_reg_data.GetByteSize()) {
+    SetAllRegisterValid(true);
+    return true;
+  }
+
+  // Some stubs only send the general purpose registers in reply to "g".
+  // Keep every register that was covered and let the rest be read
+  // individually.
+  Log *log(ProcessGDBRemoteLog::GetLogIfAnyCategoryIsSet(GDBR_LOG_THREAD |
+                                                        GDBR_LOG_PACKETS));
+  LLDB_LOGF(log,
+            "GDBRemoteRegisterContext::ReadAllRegistersAtOnce expected %" PRIu64
+            " bytes of registers but only got %" PRIu64 " bytes.",
+            (uint64_t)m_reg_data.GetByteSize(), (uint64_t)size);
+  const RegisterInfo *reg_info;
+  for (uint32_t i = 0; (reg_info = GetRegisterInfoAtIndex(i)) != nullptr;
+       i++) {
+    if (!reg_info->value_regs &&
+        reg_info->byte_offset + reg_info->byte_size <= size)
+      SetRegisterIsValid(reg_info, true);
+  }
+  return true;
+}
+
 // Helper function for GDBRemoteRegisterContext::ReadRegisterBytes().
 bool GDBRemoteRegisterContext::GetPrimordialRegister(
     const RegisterInfo *reg_info, GDBRemoteCommunicationClient &gdb_comm) {
@@ -194,30 +231,20 @@ bool GDBRemoteRegisterContext::ReadRegisterBytes(const RegisterInfo *reg_info,
   const uint32_t reg = reg_info->kinds[eRegisterKindLLDB];
 
   if (!GetRegisterIsValid(reg)) {
-    if (m_read_all_at_once) {
-      if (DataBufferSP buffer_sp =
-              gdb_comm.ReadAllRegisters(m_thread.GetProtocolID())) {
-        memcpy(const_cast<uint8_t *>(m_reg_data.GetDataStart()),
-               buffer_sp->GetBytes(),
-               std::min(buffer_sp->GetByteSize(), m_reg_data.GetByteSize()));
-        if (buffer_sp->GetByteSize() >= m_reg_data.GetByteSize()) {
-          SetAllRegisterValid(true);
-          return true;
-        } else {
-          Log *log(ProcessGDBRemoteLog::GetLogIfAnyCategoryIsSet(GDBR_LOG_THREAD |
-                                                                GDBR_LOG_PACKETS));
-          LLDB_LOGF(
-              log,
-              "error: GDBRemoteRegisterContext::ReadRegisterBytes tried "
-              "to read the "
-              "entire register context at once, expected at least %" PRId64
-              " bytes "
-              "but only got %" PRId64 " bytes.",
-              m_reg_data.GetByteSize(), buffer_sp->GetByteSize());
-        }
-      }
-      return false;
+    // Fetching the whole register context with one "g" packet is much
+    // cheaper than a "p" packet for each register the unwinder asks for, so
+    // do that once per stop whenever the stub supports it.
+    if (m_read_all_at_once ||
+        (!m_sent_read_all && gdb_comm.GetgPacketSupported() &&
+         !gdb_comm.AvoidGPackets((ProcessGDBRemote *)process))) {
+      m_sent_read_all = true;
+      ReadAllRegistersAtOnce(gdb_comm);
+      if (m_read_all_at_once && !GetRegisterIsValid(reg))
+        return false;
     }
+  }
+
+  if (!GetRegisterIsValid(reg)) {
     if (reg_info->value_regs) {
       // Process this composite register request by delegating to the
       // constituent primordial registers.
@@ -475,18 +502,35 @@ bool GDBRemoteRegisterContext::ReadAllRegisterValues(
         (data_sp = gdb_comm.ReadAllRegisters(m_thread.GetProtocolID())))
       return true;
 
-    // We're going to read each register
-    // individually and store them as binary data in a buffer.
-    const RegisterInfo *reg_info;
+    // We're going to read each register individually and store them as
+    // binary data in a buffer. The registers don't depend on each other, so
+    // request all of the ones we don't have yet in one pipelined batch.
+    InvalidateIfNeeded(false);
 
+    const RegisterInfo *reg_info;
+    std::vector<uint32_t> lldb_regs;
+    std::vector<uint32_t> remote_regs;
     for (uint32_t i = 0; (reg_info = GetRegisterInfoAtIndex(i)) != nullptr;
          i++) {
       if (reg_info
               ->value_regs) // skip registers that are slices of real registers
         continue;
-      ReadRegisterBytes(reg_info, m_reg_data);
-      // ReadRegisterBytes saves the contents of the register in to the
-      // m_reg_data buffer
+      const uint32_t lldb_reg = reg_info->kinds[eRegisterKindLLDB];
+      if (GetRegisterIsValid(lldb_reg))
+        continue;
+      lldb_regs.push_back(lldb_reg);
+      remote_regs.push_back(reg_info->kinds[eRegisterKindProcessPlugin]);
+    }
+
+    std::vector<DataBufferSP> buffers =
+        gdb_comm.ReadRegisters(m_thread.GetProtocolID(), remote_regs);
+    // PrivateSetRegisterValue saves the contents of the register in to the
+    // m_reg_data buffer
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      if (buffers[i])
+        PrivateSetRegisterValue(
+            lldb_regs[i], llvm::ArrayRef<uint8_t>(buffers[i]->GetBytes(),
+                                                  buffers[i]->GetByteSize()));
     }
     data_sp = std::make_shared<DataBufferHeap>(
         m_reg_data.GetDataStart(), m_reg_info.GetRegisterDataByteSize());
@@ -114,11 +114,15 @@ protected:
   std::vector<bool> m_reg_valid;
   DataExtractor m_reg_data;
   bool m_read_all_at_once;
+  bool m_sent_read_all; // True once a "g" packet was sent for the registers
+                        // currently cached
 
 private:
   // Helper function for ReadRegisterBytes().
   bool GetPrimordialRegister(const RegisterInfo *reg_info,
                              GDBRemoteCommunicationClient &gdb_comm);
+  // Helper function for ReadRegisterBytes().
+  bool ReadAllRegistersAtOnce(GDBRemoteCommunicationClient &gdb_comm);
   // Helper function for WriteRegisterBytes().
   bool SetPrimordialRegister(const RegisterInfo *reg_info,
                              GDBRemoteCommunicationClient &gdb_comm);
@@ -25,8 +25,11 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <sstream>
 
+#include "lldb/Breakpoint/BreakpointLocation.h"
+#include "lldb/Breakpoint/BreakpointSite.h"
 #include "lldb/Breakpoint/Watchpoint.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
@@ -49,12 +52,22 @@
 #include "lldb/Interpreter/CommandReturnObject.h"
 #include "lldb/Interpreter/OptionArgParser.h"
 #include "lldb/Interpreter/OptionGroupBoolean.h"
+#include "lldb/Interpreter/OptionGroupString.h"
 #include "lldb/Interpreter/OptionGroupUInt64.h"
 #include "lldb/Interpreter/OptionValueProperties.h"
 #include "lldb/Interpreter/Options.h"
 #include "lldb/Interpreter/Property.h"
+#include "lldb/Symbol/Block.h"
+#include "lldb/Symbol/CompileUnit.h"
+#include "lldb/Symbol/FuncUnwinders.h"
+#include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/LocateSymbolFile.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/Symbol.h"
+#include "lldb/Symbol/UnwindPlan.h"
+#include "lldb/Symbol/UnwindTable.h"
+#include "lldb/Symbol/Variable.h"
+#include "lldb/Symbol/VariableList.h"
 #include "lldb/Target/ABI.h"
 #include "lldb/Target/DynamicLoader.h"
 #include "lldb/Target/MemoryRegionInfo.h"
@@ -81,7 +94,12 @@
 #include "lldb/Host/Host.h"
 #include "lldb/Utility/StringExtractorGDBRemote.h"
 
+#if defined(__linux__)
+#include "lldb/Host/linux/ConnectionSharedMemory.h"
+#endif
+
 #include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -153,6 +171,32 @@ public:
         nullptr, idx,
         g_processgdbremote_properties[idx].default_uint_value != 0);
   }
+
+  bool GetUseCompression() const {
+    const uint32_t idx = ePropertyUseCompression;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(
+        nullptr, idx,
+        g_processgdbremote_properties[idx].default_uint_value != 0);
+  }
+
+  uint64_t GetExpeditedStackSize() const {
+    const uint32_t idx = ePropertyExpeditedStackSize;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64(
+        nullptr, idx, g_processgdbremote_properties[idx].default_uint_value);
+  }
+
+  uint64_t GetExpeditedFrameCount() const {
+    const uint32_t idx = ePropertyExpeditedFrameCount;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64(
+        nullptr, idx, g_processgdbremote_properties[idx].default_uint_value);
+  }
+
+  bool GetUseSharedMemory() const {
+    const uint32_t idx = ePropertyUseSharedMemory;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(
+        nullptr, idx,
+        g_processgdbremote_properties[idx].default_uint_value != 0);
+  }
 };
 
 typedef std::shared_ptr<PluginProperties> ProcessKDPPropertiesSP;
@@ -298,12 +342,15 @@ ProcessGDBRemote::ProcessGDBRemote(lldb::TargetSP target_sp,
       m_async_thread_state_mutex(), m_thread_ids(), m_thread_pcs(),
       m_jstopinfo_sp(), m_jthreadsinfo_sp(), m_continue_c_tids(),
       m_continue_C_tids(), m_continue_s_tids(), m_continue_S_tids(),
-      m_max_memory_size(0), m_remote_stub_max_memory_size(0),
-      m_addr_to_mmap_size(), m_thread_create_bp_sp(),
+      m_resume_held_suspended_threads(false), m_max_memory_size(0), m_remote_stub_max_memory_size(0),
+      m_memory_read_chunk_size(0), m_user_specified_max_memory_size(false),
+      m_addr_to_mmap_size(), m_memory_regions(), m_memory_regions_stop_id(0),
+      m_memory_regions_resume_id(0), m_thread_create_bp_sp(),
       m_waiting_for_attach(false), m_destroy_tried_resuming(false),
       m_command_sp(), m_breakpoint_pc_offset(0),
       m_initial_tid(LLDB_INVALID_THREAD_ID), m_replay_mode(false),
-      m_allow_flash_writes(false), m_erased_flash_ranges() {
+      m_allow_flash_writes(false), m_erased_flash_ranges(),
+      m_svr4_module_list() {
   m_async_broadcaster.SetEventName(eBroadcastBitAsyncThreadShouldExit,
                                    "async thread should exit");
   m_async_broadcaster.SetEventName(eBroadcastBitAsyncContinue,
@@ -347,6 +394,9 @@ ProcessGDBRemote::ProcessGDBRemote(lldb::TargetSP target_sp,
       GetGlobalPluginProperties()->GetPacketTimeout();
   if (timeout_seconds > 0)
     m_gdb_comm.SetPacketTimeout(std::chrono::seconds(timeout_seconds));
+
+  m_gdb_comm.SetCompressionAllowed(
+      GetGlobalPluginProperties()->GetUseCompression());
 }
 
 // Destructor
@@ -1071,6 +1121,24 @@ Status ProcessGDBRemote::ConnectToDebugserver(llvm::StringRef connect_url) {
   m_gdb_comm.GetVAttachOrWaitSupported();
   m_gdb_comm.EnableErrorStringInPacket();
 
+  // Library list deltas are relative to what this stub sent us.
+  m_svr4_module_list.clear();
+
+  // Only tell the stub about the expedited stack memory window when it
+  // differs from the protocol default, so older stubs never see the packet.
+  const uint64_t expedited_stack_size =
+      GetGlobalPluginProperties()->GetExpeditedStackSize();
+  const uint64_t expedited_frame_count =
+      GetGlobalPluginProperties()->GetExpeditedFrameCount();
+  if (expedited_stack_size !=
+          g_processgdbremote_properties[ePropertyExpeditedStackSize]
+              .default_uint_value ||
+      expedited_frame_count !=
+          g_processgdbremote_properties[ePropertyExpeditedFrameCount]
+              .default_uint_value)
+    m_gdb_comm.SetExpeditedStackMemory(expedited_stack_size,
+                                       expedited_frame_count);
+
   // Ask the remote server for the default thread id
   if (GetTarget().GetNonStopModeEnabled())
     m_gdb_comm.GetDefaultThreadId(m_initial_tid);
@@ -1318,8 +1386,11 @@ Status ProcessGDBRemote::WillResume() {
   m_continue_C_tids.clear();
   m_continue_s_tids.clear();
   m_continue_S_tids.clear();
+  m_resume_held_suspended_threads = false;
   m_jstopinfo_sp.reset();
   m_jthreadsinfo_sp.reset();
+  m_jstopinfo_by_tid.clear();
+  m_jthreadsinfo_by_tid.clear();
   return Status();
 }
 
@@ -1510,6 +1581,13 @@ Status ProcessGDBRemote::DoResume() {
     if (continue_packet_error) {
       error.SetErrorString("can't make continue packet for this resume");
     } else {
+      // Only a vCont packet is guaranteed to leave the threads it doesn't
+      // mention stopped. A "c" or "s" after "Hc" may run every thread, so
+      // in that case no thread gets to keep its cached registers.
+      m_resume_held_suspended_threads =
+          continue_packet.GetString().startswith("vCont;") &&
+          !GetTarget().GetNonStopModeEnabled();
+
       EventSP event_sp;
       if (!m_async_thread.IsJoinable()) {
         error.SetErrorString("Trying to resume but the async thread is dead.");
@@ -1739,35 +1817,42 @@ void ProcessGDBRemote::SetThreadPc(const ThreadSP &thread_sp, uint64_t index) {
   }
 }
 
+void ProcessGDBRemote::IndexThreadInfos(
+    const StructuredData::ObjectSP &thread_infos_sp,
+    ThreadInfoMap &thread_infos) {
+  // Threads look up their stop info one at a time, so index the thread
+  // dictionaries once instead of searching the array for each thread.
+  thread_infos.clear();
+  if (!thread_infos_sp)
+    return;
+  StructuredData::Array *thread_infos_array = thread_infos_sp->GetAsArray();
+  if (!thread_infos_array)
+    return;
+  thread_infos_array->ForEach(
+      [&thread_infos](StructuredData::Object *object) -> bool {
+        StructuredData::Dictionary *thread_dict = object->GetAsDictionary();
+        lldb::tid_t tid;
+        if (thread_dict && thread_dict->GetValueForKeyAsInteger<lldb::tid_t>(
+                               "tid", tid, LLDB_INVALID_THREAD_ID))
+          thread_infos.emplace(tid, thread_dict);
+        return true; // Keep iterating through all thread_info objects
+      });
+}
+
 bool ProcessGDBRemote::GetThreadStopInfoFromJSON(
-    ThreadGDBRemote *thread, const StructuredData::ObjectSP &thread_infos_sp) {
+    ThreadGDBRemote *thread, const ThreadInfoMap &thread_infos) {
   // See if we got thread stop infos for all threads via the "jThreadsInfo"
   // packet
-  if (thread_infos_sp) {
-    StructuredData::Array *thread_infos = thread_infos_sp->GetAsArray();
-    if (thread_infos) {
-      lldb::tid_t tid;
-      const size_t n = thread_infos->GetSize();
-      for (size_t i = 0; i < n; ++i) {
-        StructuredData::Dictionary *thread_dict =
-            thread_infos->GetItemAtIndex(i)->GetAsDictionary();
-        if (thread_dict) {
-          if (thread_dict->GetValueForKeyAsInteger<lldb::tid_t>(
-                  "tid", tid, LLDB_INVALID_THREAD_ID)) {
-            if (tid == thread->GetID())
-              return (bool)SetThreadStopInfo(thread_dict);
-          }
-        }
-      }
-    }
-  }
-  return false;
+  auto pos = thread_infos.find(thread->GetID());
+  if (pos == thread_infos.end())
+    return false;
+  return (bool)SetThreadStopInfo(pos->second);
 }
 
 bool ProcessGDBRemote::CalculateThreadStopInfo(ThreadGDBRemote *thread) {
   // See if we got thread stop infos for all threads via the "jThreadsInfo"
   // packet
-  if (GetThreadStopInfoFromJSON(thread, m_jthreadsinfo_sp))
+  if (GetThreadStopInfoFromJSON(thread, m_jthreadsinfo_by_tid))
     return true;
 
   // See if we got thread stop info for any threads valid stop info reasons
@@ -1776,8 +1861,8 @@ bool ProcessGDBRemote::CalculateThreadStopInfo(ThreadGDBRemote *thread) {
     // If we have "jstopinfo" then we have stop descriptions for all threads
     // that have stop reasons, and if there is no entry for a thread, then it
     // has no stop reason.
-    thread->GetRegisterContext()->InvalidateIfNeeded(true);
-    if (!GetThreadStopInfoFromJSON(thread, m_jstopinfo_sp)) {
+    thread->InvalidateRegistersIfNeeded(true);
+    if (!GetThreadStopInfoFromJSON(thread, m_jstopinfo_by_tid)) {
       thread->SetStopInfo(StopInfoSP());
     }
     return true;
@@ -2284,6 +2369,7 @@ StateType ProcessGDBRemote::SetThreadStopInfo(StringExtractor &stop_packet) {
         // This JSON contains thread IDs and thread stop info for all threads.
         // It doesn't contain expedited registers, memory or queue info.
         m_jstopinfo_sp = StructuredData::ParseJSON(json);
+        IndexThreadInfos(m_jstopinfo_sp, m_jstopinfo_by_tid);
       } else if (key.compare("hexname") == 0) {
         StringExtractor name_extractor(value);
         std::string name;
@@ -2738,6 +2824,7 @@ void ProcessGDBRemote::WillPublicStop() {
   // memory will help stack backtracing be much faster. Expediting registers
   // will make sure we don't have to read the thread registers for GPRs.
   m_jthreadsinfo_sp = m_gdb_comm.GetThreadsInfo();
+  IndexThreadInfos(m_jthreadsinfo_sp, m_jthreadsinfo_by_tid);
 
   if (m_jthreadsinfo_sp) {
     // Now set the stop info for each thread and also expedite any registers
@@ -2762,7 +2849,7 @@ size_t ProcessGDBRemote::DoReadMemory(addr_t addr, void *buf, size_t size,
   bool binary_memory_read = m_gdb_comm.GetxPacketSupported();
   // M and m packets take 2 bytes for 1 byte of memory
   size_t max_memory_size =
-      binary_memory_read ? m_max_memory_size : m_max_memory_size / 2;
+      binary_memory_read ? m_memory_read_chunk_size : m_max_memory_size / 2;
   if (size > max_memory_size) {
     // Keep memory read sizes down to a sane limit. This function will be
     // called multiple times in order to complete the task by
@@ -2778,6 +2865,7 @@ size_t ProcessGDBRemote::DoReadMemory(addr_t addr, void *buf, size_t size,
   assert(packet_len + 1 < (int)sizeof(packet));
   UNUSED_IF_ASSERT_DISABLED(packet_len);
   StringExtractorGDBRemote response;
+  const auto start = std::chrono::steady_clock::now();
   if (m_gdb_comm.SendPacketAndWaitForResponse(packet, response, true) ==
       GDBRemoteCommunication::PacketResult::Success) {
     if (response.IsNormalResponse()) {
@@ -2794,6 +2882,10 @@ size_t ProcessGDBRemote::DoReadMemory(addr_t addr, void *buf, size_t size,
           data_received_size = size;
         }
         memcpy(buf, response.GetStringRef().data(), data_received_size);
+        // Only full-sized reads say anything about the throughput, smaller
+        // ones are mostly round trip.
+        if (size == max_memory_size && data_received_size == size)
+          AdjustMemoryReadChunkSize(std::chrono::steady_clock::now() - start);
         return data_received_size;
       } else {
         return response.GetHexBytes(
@@ -2814,6 +2906,103 @@ size_t ProcessGDBRemote::DoReadMemory(addr_t addr, void *buf, size_t size,
   return 0;
 }
 
+std::vector<size_t>
+ProcessGDBRemote::DoReadMemoryRanges(llvm::ArrayRef<MemoryRange> ranges,
+                                     uint8_t *buf) {
+  if (!m_gdb_comm.GetMultiMemReadSupported())
+    return Process::DoReadMemoryRanges(ranges, buf);
+
+  Log *log(ProcessGDBRemoteLog::GetLogIfAnyCategoryIsSet(GDBR_LOG_MEMORY));
+  GetMaxMemorySize();
+  // Besides its data, each range takes up to 34 bytes for its address and
+  // sizes in the request and the reply.
+  const size_t range_overhead = 34;
+
+  std::vector<size_t> bytes_read;
+  bytes_read.reserve(ranges.size());
+  while (!ranges.empty()) {
+    // Send as many ranges as fit into a single packet.
+    size_t num_ranges = 0;
+    size_t packet_size = 0;
+    for (; num_ranges < ranges.size(); ++num_ranges) {
+      const size_t range_size =
+          ranges[num_ranges].GetByteSize() + range_overhead;
+      if (packet_size + range_size > m_max_memory_size)
+        break;
+      packet_size += range_size;
+    }
+
+    // A range that is too large for a packet by itself is read in pieces
+    // like any other large read.
+    if (num_ranges == 0) {
+      bytes_read.push_back(
+          Process::DoReadMemoryRanges(ranges.take_front(), buf).front());
+      buf += ranges.front().GetByteSize();
+      ranges = ranges.drop_front();
+      continue;
+    }
+
+    llvm::ArrayRef<MemoryRange> packet_ranges = ranges.take_front(num_ranges);
+    std::vector<size_t> packet_bytes_read;
+    Status error =
+        m_gdb_comm.ReadMemoryRanges(packet_ranges, buf, packet_bytes_read);
+    if (error.Fail()) {
+      LLDB_LOG(log, "reading {0} ranges failed, reading them one by one: {1}",
+               num_ranges, error);
+      packet_bytes_read = Process::DoReadMemoryRanges(packet_ranges, buf);
+    }
+    bytes_read.insert(bytes_read.end(), packet_bytes_read.begin(),
+                      packet_bytes_read.end());
+    for (const MemoryRange &range : packet_ranges)
+      buf += range.GetByteSize();
+    ranges = ranges.drop_front(num_ranges);
+  }
+  return bytes_read;
+}
+
+bool ProcessGDBRemote::DoFindInMemory(lldb::addr_t low, lldb::addr_t high,
+                                      llvm::ArrayRef<uint8_t> pattern,
+                                      lldb::addr_t &found_addr) {
+  // Search large ranges in pieces that overlap by the size of the pattern, so
+  // no single packet runs into the timeout.
+  const uint64_t piece_size = 1ULL << 30;
+  for (lldb::addr_t addr = low; addr < high; addr += piece_size) {
+    const uint64_t length =
+        std::min<uint64_t>(high - addr, piece_size + pattern.size() - 1);
+    if (length < pattern.size())
+      break;
+    if (!m_gdb_comm.SearchMemory(addr, length, pattern, found_addr))
+      return false;
+    if (found_addr != LLDB_INVALID_ADDRESS || length == high - addr)
+      return true;
+  }
+  found_addr = LLDB_INVALID_ADDRESS;
+  return true;
+}
+
+Status ProcessGDBRemote::RestoreSnapshot(lldb::user_id_t snapshot_id) {
+  lldb::pid_t pid = LLDB_INVALID_PROCESS_ID;
+  Status error = m_gdb_comm.RestoreSnapshot(snapshot_id, pid);
+  if (error.Fail())
+    return error;
+  SetID(pid);
+
+  // The threads, the memory and the memory allocated since the snapshot was
+  // taken are all gone, so start over with a new stop.
+  m_thread_list_real.Clear();
+  m_thread_list.Clear();
+  m_memory_cache.Clear();
+  m_allocated_memory_cache.Clear();
+  m_addr_to_mmap_size.clear();
+  m_mod_id.BumpStopID();
+
+  StringExtractorGDBRemote response;
+  if (m_gdb_comm.GetStopReply(response))
+    SetLastStopPacket(response);
+  RefreshStateAfterStop();
+  return error;
+}
+
 Status ProcessGDBRemote::WriteObjectFile(
     std::vector<ObjectFile::LoadableData> entries) {
   Status error;
@@ -3022,6 +3211,7 @@ lldb::addr_t ProcessGDBRemote::DoAllocateMemory(size_t size,
   Log *log(
       GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_EXPRESSIONS));
   addr_t allocated_addr = LLDB_INVALID_ADDRESS;
+  ClearMemoryRegionCache();
 
   if (m_gdb_comm.SupportsAllocDeallocMemory() != eLazyBoolNo) {
     allocated_addr = m_gdb_comm.AllocateMemory(size, permissions);
@@ -3064,11 +3254,42 @@ lldb::addr_t ProcessGDBRemote::DoAllocateMemory(size_t size,
 
 Status ProcessGDBRemote::GetMemoryRegionInfo(addr_t load_addr,
                                              MemoryRegionInfo &region_info) {
+  // "memory region", stack walking and memory searches ask about many
+  // addresses in the same few regions, and each qMemoryRegionInfo is a round
+  // trip to the stub. The map only changes while the process runs, or when
+  // memory is allocated in it.
+  const ProcessModID mod_id = GetModID();
+  {
+    std::lock_guard<std::mutex> guard(m_memory_regions_mutex);
+    if (m_memory_regions_stop_id != mod_id.GetStopID() ||
+        m_memory_regions_resume_id != mod_id.GetResumeID()) {
+      m_memory_regions.clear();
+      m_memory_regions_stop_id = mod_id.GetStopID();
+      m_memory_regions_resume_id = mod_id.GetResumeID();
+    }
+    auto pos = m_memory_regions.upper_bound(load_addr);
+    if (pos != m_memory_regions.begin() &&
+        (--pos)->second.GetRange().Contains(load_addr)) {
+      region_info = pos->second;
+      return Status();
+    }
+  }
 
   Status error(m_gdb_comm.GetMemoryRegionInfo(load_addr, region_info));
+  if (error.Success() && region_info.GetRange().Contains(load_addr)) {
+    std::lock_guard<std::mutex> guard(m_memory_regions_mutex);
+    if (m_memory_regions_stop_id == mod_id.GetStopID() &&
+        m_memory_regions_resume_id == mod_id.GetResumeID())
+      m_memory_regions[region_info.GetRange().GetRangeBase()] = region_info;
+  }
   return error;
 }
 
+void ProcessGDBRemote::ClearMemoryRegionCache() {
+  std::lock_guard<std::mutex> guard(m_memory_regions_mutex);
+  m_memory_regions.clear();
+}
+
 Status ProcessGDBRemote::GetWatchpointSupportInfo(uint32_t &num) {
 
   Status error(m_gdb_comm.GetWatchpointSupportInfo(num));
@@ -3083,6 +3304,7 @@ Status ProcessGDBRemote::GetWatchpointSupportInfo(uint32_t &num, bool &after) {
 
 Status ProcessGDBRemote::DoDeallocateMemory(lldb::addr_t addr) {
   Status error;
+  ClearMemoryRegionCache();
   LazyBool supported = m_gdb_comm.SupportsAllocDeallocMemory();
 
   switch (supported) {
@@ -3128,6 +3350,263 @@ size_t ProcessGDBRemote::PutSTDIN(const char *src, size_t src_len,
   return 0;
 }
 
+// Compile the condition of \a bp_loc into bytecode the stub can evaluate.
+// Only a variable compared with an integer literal, or a variable on its
+// own, is handled; anything else stays with the client.
+static bool CompileBreakpointCondition(
+    BreakpointLocation &bp_loc, Target &target,
+    llvm::function_ref<bool(RegisterKind, uint32_t, uint32_t &)> map_register,
+    AgentExpression &expr) {
+  llvm::StringRef text(bp_loc.GetConditionText());
+
+  auto take_operand = [&text]() {
+    text = text.ltrim();
+    size_t len = text.startswith("-") ? 1 : 0;
+    while (len < text.size() && (isalnum(text[len]) || text[len] == '_'))
+      ++len;
+    llvm::StringRef operand = text.take_front(len);
+    text = text.drop_front(len).ltrim();
+    return operand;
+  };
+  auto is_identifier = [](llvm::StringRef operand) {
+    return !operand.empty() && (isalpha(operand[0]) || operand[0] == '_');
+  };
+
+  llvm::StringRef lhs = take_operand();
+  llvm::StringRef op;
+  llvm::StringRef rhs;
+  if (!text.empty()) {
+    for (llvm::StringRef candidate : {"==", "!=", "<=", ">=", "<", ">"}) {
+      if (text.startswith(candidate)) {
+        op = candidate;
+        break;
+      }
+    }
+    if (op.empty())
+      return false;
+    text = text.drop_front(op.size());
+    rhs = take_operand();
+    if (!text.empty())
+      return false;
+    // Put the variable on the left.
+    if (!is_identifier(lhs)) {
+      std::swap(lhs, rhs);
+      op = llvm::StringSwitch<llvm::StringRef>(op)
+               .Case("<", ">")
+               .Case(">", "<")
+               .Case("<=", ">=")
+               .Case(">=", "<=")
+               .Default(op);
+    }
+  }
+  if (!is_identifier(lhs) || is_identifier(rhs))
+    return false;
+
+  // Find the variable in the scope of the location.
+  Address addr = bp_loc.GetAddress();
+  SymbolContext sc;
+  addr.CalculateSymbolContext(&sc, eSymbolContextModule |
+                                       eSymbolContextCompUnit |
+                                       eSymbolContextFunction |
+                                       eSymbolContextBlock);
+  if (!sc.module_sp || !sc.function)
+    return false;
+  ConstString name(lhs);
+  VariableSP var_sp;
+  for (Block *block = sc.block; block && !var_sp; block = block->GetParent()) {
+    if (VariableListSP variables = block->GetBlockVariableList(true))
+      var_sp = variables->FindVariable(name);
+  }
+  if (!var_sp && sc.comp_unit) {
+    if (VariableListSP globals = sc.comp_unit->GetVariableList(true))
+      var_sp = globals->FindVariable(name);
+  }
+  if (!var_sp || var_sp->GetLocationIsConstantValueData() ||
+      !var_sp->LocationIsValidForAddress(addr))
+    return false;
+
+  Type *type = var_sp->GetType();
+  if (!type)
+    return false;
+  CompilerType compiler_type = type->GetForwardCompilerType();
+  bool is_signed = false;
+  if (!compiler_type.IsIntegerOrEnumerationType(is_signed) &&
+      !compiler_type.IsPointerType())
+    return false;
+  llvm::Optional<uint64_t> byte_size = type->GetByteSize();
+  if (!byte_size || *byte_size == 0 || *byte_size > sizeof(uint64_t))
+    return false;
+  const unsigned bits = *byte_size * 8;
+
+  // The literal is converted to the type of the variable, as C would.
+  uint64_t literal = 0;
+  if (!rhs.empty()) {
+    rhs = rhs.rtrim("uUlL");
+    int64_t signed_literal;
+    if (rhs.startswith("-")) {
+      if (rhs.getAsInteger(0, signed_literal))
+        return false;
+      literal = signed_literal;
+    } else if (rhs.getAsInteger(0, literal)) {
+      return false;
+    }
+    if (bits < 64) {
+      literal &= (1ULL << bits) - 1;
+      if (is_signed && (literal & (1ULL << (bits - 1))))
+        literal |= ~((1ULL << bits) - 1);
+    }
+  }
+
+  // Canonical frame addresses come from the eh_frame or debug_frame row at
+  // the location, if that is a register plus an offset.
+  auto push_cfa = [&](AgentExpression &cfa_expr) {
+    SymbolContext unwind_sc(sc);
+    FuncUnwindersSP func_unwinders =
+        sc.module_sp->GetUnwindTable().GetFuncUnwindersContainingAddress(
+            addr, unwind_sc);
+    if (!func_unwinders)
+      return false;
+    UnwindPlanSP plan_sp = func_unwinders->GetEHFrameUnwindPlan(target);
+    if (!plan_sp)
+      plan_sp = func_unwinders->GetDebugFrameUnwindPlan(target);
+    if (!plan_sp || !plan_sp->PlanValidAtAddress(addr))
+      return false;
+    UnwindPlan::RowSP row_sp = plan_sp->GetRowForFunctionOffset(
+        addr.GetFileAddress() -
+        sc.function->GetAddressRange().GetBaseAddress().GetFileAddress());
+    if (!row_sp || row_sp->GetCFAValue().GetValueType() !=
+                       UnwindPlan::Row::FAValue::isRegisterPlusOffset)
+      return false;
+    uint32_t remote_regnum;
+    if (!map_register(plan_sp->GetRegisterKind(),
+                      row_sp->GetCFAValue().GetRegisterNumber(),
+                      remote_regnum) ||
+        remote_regnum > UINT16_MAX)
+      return false;
+    cfa_expr.AppendRegister(remote_regnum);
+    cfa_expr.AppendConstant(int64_t(row_sp->GetCFAValue().GetOffset()));
+    cfa_expr.AppendOpcode(AgentExpression::eOpAdd);
+    return true;
+  };
+
+  if (!var_sp->LocationExpression().CompileToAgentExpression(
+          &target,
+          sc.function->GetAddressRange().GetBaseAddress().GetFileAddress(),
+          addr.GetFileAddress(), &sc.function->GetFrameBaseExpression(),
+          *byte_size, map_register, push_cfa, expr))
+    return false;
+  if (is_signed && bits < 64)
+    expr.AppendExtend(bits, true);
+
+  if (op.empty()) {
+    // A variable on its own is true when it isn't zero.
+  } else {
+    expr.AppendConstant(literal);
+    const AgentExpression::Opcode less = is_signed
+                                             ? AgentExpression::eOpLessSigned
+                                             : AgentExpression::eOpLessUnsigned;
+    // Everything is built from ==, < and logical not.
+    if (op == "==" || op == "!=") {
+      expr.AppendOpcode(AgentExpression::eOpEqual);
+    } else {
+      if (op == ">" || op == "<=")
+        expr.AppendOpcode(AgentExpression::eOpSwap);
+      expr.AppendOpcode(less);
+    }
+    if (op == "!=" || op == "<=" || op == ">=")
+      expr.AppendOpcode(AgentExpression::eOpLogNot);
+  }
+  expr.AppendOpcode(AgentExpression::eOpEnd);
+  return true;
+}
+
+std::vector<AgentExpression>
+ProcessGDBRemote::GetBreakpointSiteConditions(BreakpointSite *bp_site) {
+  std::vector<AgentExpression> conditions;
+  if (!m_gdb_comm.GetConditionalBreakpointsSupported())
+    return conditions;
+
+  auto map_register = [this](RegisterKind kind, uint32_t regnum,
+                             uint32_t &remote_regnum) {
+    const RegisterInfo *reg_info = m_register_info.GetRegisterInfoAtIndex(
+        m_register_info.ConvertRegisterKindToRegisterNumber(kind, regnum));
+    if (!reg_info ||
+        reg_info->kinds[eRegisterKindProcessPlugin] == LLDB_INVALID_REGNUM)
+      return false;
+    remote_regnum = reg_info->kinds[eRegisterKindProcessPlugin];
+    return true;
+  };
+
+  // The stub stops when any of the conditions is true, so a single owner
+  // that can't be described makes the site unconditional. Owners that need
+  // to see every hit, to count it down or to run a precondition, can't be
+  // described either.
+  const size_t num_owners = bp_site->GetNumberOfOwners();
+  for (size_t i = 0; i < num_owners; ++i) {
+    BreakpointLocationSP bp_loc_sp = bp_site->GetOwnerAtIndex(i);
+    if (!bp_loc_sp || !bp_loc_sp->IsEnabled())
+      continue;
+    Breakpoint &bp = bp_loc_sp->GetBreakpoint();
+    AgentExpression condition;
+    if (!bp_loc_sp->GetConditionText() || bp_loc_sp->GetIgnoreCount() != 0 ||
+        bp.GetIgnoreCount() != 0 || bp.GetPrecondition() ||
+        !CompileBreakpointCondition(*bp_loc_sp, GetTarget(), map_register,
+                                    condition))
+      return {};
+    conditions.push_back(std::move(condition));
+  }
+  return conditions;
+}
+
+void ProcessGDBRemote::BreakpointSiteConditionsChanged(BreakpointSite *bp_site) {
+  if (!bp_site->IsEnabled() ||
+      bp_site->GetType() != BreakpointSite::eExternal ||
+      bp_site->IsHardware() || !m_gdb_comm.GetConditionalBreakpointsSupported())
+    return;
+
+  std::vector<AgentExpression> conditions =
+      GetBreakpointSiteConditions(bp_site);
+  auto pos = m_breakpoint_site_conditions.find(bp_site->GetID());
+  if (pos == m_breakpoint_site_conditions.end() ? conditions.empty()
+                                                : pos->second == conditions)
+    return;
+
+  // The stub takes the conditions with the breakpoint, so take it out and
+  // put it back in.
+  Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_BREAKPOINTS));
+  const addr_t addr = bp_site->GetLoadAddress();
+  const size_t bp_op_size = GetSoftwareBreakpointTrapOpcode(bp_site);
+  LLDB_LOGF(log,
+            "ProcessGDBRemote::%s (site_id = %d) addr = 0x%" PRIx64
+            ", %zu condition(s)",
+            __FUNCTION__, bp_site->GetID(), addr, conditions.size());
+  if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, false, addr,
+                                            bp_op_size) != 0)
+    return;
+  if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, true, addr,
+                                            bp_op_size, conditions) != 0) {
+    // Every hit is better than none.
+    conditions.clear();
+    if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, true, addr,
+                                              bp_op_size) != 0) {
+      LLDB_LOGF(log, "ProcessGDBRemote::%s failed to reinsert 0x%" PRIx64,
+                __FUNCTION__, addr);
+      bp_site->SetEnabled(false);
+    }
+  }
+  if (conditions.empty())
+    m_breakpoint_site_conditions.erase(bp_site->GetID());
+  else
+    m_breakpoint_site_conditions[bp_site->GetID()] = std::move(conditions);
+}
+
+bool ProcessGDBRemote::StepsOverBreakpointSiteOnResume(
+    BreakpointSite *bp_site) {
+  // Only breakpoints the stub inserted with a Z0 packet are its own.
+  return bp_site->GetType() == BreakpointSite::eExternal &&
+         !bp_site->IsHardware() && m_gdb_comm.GetBreakpointStepOverSupported();
+}
+
 Status ProcessGDBRemote::EnableBreakpointSite(BreakpointSite *bp_site) {
   Status error;
   assert(bp_site != nullptr);
@@ -3169,12 +3648,24 @@ Status ProcessGDBRemote::EnableBreakpointSite(BreakpointSite *bp_site) {
   if (m_gdb_comm.SupportsGDBStoppointPacket(eBreakpointSoftware) &&
       (!bp_site->HardwareRequired())) {
     // Try to send off a software breakpoint packet ($Z0)
+    std::vector<AgentExpression> conditions =
+        GetBreakpointSiteConditions(bp_site);
     uint8_t error_no = m_gdb_comm.SendGDBStoppointTypePacket(
-        eBreakpointSoftware, true, addr, bp_op_size);
+        eBreakpointSoftware, true, addr, bp_op_size, conditions);
+    if (error_no != 0 && !conditions.empty()) {
+      // Maybe the stub couldn't take the conditions, try without them.
+      conditions.clear();
+      error_no = m_gdb_comm.SendGDBStoppointTypePacket(
+          eBreakpointSoftware, true, addr, bp_op_size);
+    }
     if (error_no == 0) {
       // The breakpoint was placed successfully
       bp_site->SetEnabled(true);
       bp_site->SetType(BreakpointSite::eExternal);
+      if (conditions.empty())
+        m_breakpoint_site_conditions.erase(site_id);
+      else
+        m_breakpoint_site_conditions[site_id] = std::move(conditions);
       return error;
     }
 
@@ -3263,6 +3754,8 @@ Status ProcessGDBRemote::DisableBreakpointSite(BreakpointSite *bp_site) {
             ") addr = 0x%8.8" PRIx64,
             site_id, (uint64_t)addr);
 
+  m_breakpoint_site_conditions.erase(site_id);
+
   if (bp_site->IsEnabled()) {
     const size_t bp_op_size = GetSoftwareBreakpointTrapOpcode(bp_site);
 
@@ -3305,6 +3798,103 @@ Status ProcessGDBRemote::DisableBreakpointSite(BreakpointSite *bp_site) {
   return error;
 }
 
+std::vector<Status> ProcessGDBRemote::EnableBreakpointSites(
+    llvm::ArrayRef<BreakpointSite *> bp_sites) {
+  std::vector<Status> errors(bp_sites.size());
+  std::vector<bool> handled(bp_sites.size(), false);
+
+  // Software breakpoints placed by the stub are sent together. Everything
+  // else, including the sites the stub rejects because it turns out not to
+  // support $Z0, goes through EnableBreakpointSite() and its fallbacks.
+  std::vector<size_t> batched;
+  std::vector<std::pair<addr_t, uint32_t>> stoppoints;
+  if (m_gdb_comm.SupportsGDBStoppointPacket(eBreakpointSoftware)) {
+    for (size_t i = 0; i < bp_sites.size(); ++i) {
+      BreakpointSite *bp_site = bp_sites[i];
+      // Sites with conditions for the stub go one at a time.
+      if (bp_site->IsEnabled() || bp_site->HardwareRequired() ||
+          !GetBreakpointSiteConditions(bp_site).empty())
+        continue;
+      batched.push_back(i);
+      stoppoints.emplace_back(bp_site->GetLoadAddress(),
+                              GetSoftwareBreakpointTrapOpcode(bp_site));
+    }
+  }
+
+  if (stoppoints.size() > 1) {
+    Log *log(
+        ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_BREAKPOINTS));
+    LLDB_LOGF(log, "ProcessGDBRemote::%s sending %zu software breakpoints",
+              __FUNCTION__, stoppoints.size());
+
+    std::vector<uint8_t> error_nos = m_gdb_comm.SendGDBStoppointTypePackets(
+        eBreakpointSoftware, true, stoppoints);
+    for (size_t j = 0; j < error_nos.size(); ++j) {
+      const size_t i = batched[j];
+      if (error_nos[j] == 0) {
+        bp_sites[i]->SetEnabled(true);
+        bp_sites[i]->SetType(BreakpointSite::eExternal);
+      } else if (m_gdb_comm.SupportsGDBStoppointPacket(eBreakpointSoftware)) {
+        if (error_nos[j] != UINT8_MAX)
+          errors[i].SetErrorStringWithFormat(
+              "error: %d sending the breakpoint request", error_nos[j]);
+        else
+          errors[i].SetErrorString("error sending the breakpoint request");
+      } else {
+        continue;
+      }
+      handled[i] = true;
+    }
+  }
+
+  for (size_t i = 0; i < bp_sites.size(); ++i) {
+    if (!handled[i])
+      errors[i] = EnableBreakpointSite(bp_sites[i]);
+  }
+  return errors;
+}
+
+std::vector<Status> ProcessGDBRemote::DisableBreakpointSites(
+    llvm::ArrayRef<BreakpointSite *> bp_sites) {
+  std::vector<Status> errors(bp_sites.size());
+  std::vector<bool> handled(bp_sites.size(), false);
+
+  // Only software breakpoints the stub placed are removed together, the
+  // other kinds take the regular path.
+  std::vector<size_t> batched;
+  std::vector<std::pair<addr_t, uint32_t>> stoppoints;
+  for (size_t i = 0; i < bp_sites.size(); ++i) {
+    BreakpointSite *bp_site = bp_sites[i];
+    if (!bp_site->IsEnabled() ||
+        bp_site->GetType() != BreakpointSite::eExternal ||
+        bp_site->IsHardware())
+      continue;
+    batched.push_back(i);
+    stoppoints.emplace_back(bp_site->GetLoadAddress(),
+                            GetSoftwareBreakpointTrapOpcode(bp_site));
+  }
+
+  if (stoppoints.size() > 1) {
+    std::vector<uint8_t> error_nos = m_gdb_comm.SendGDBStoppointTypePackets(
+        eBreakpointSoftware, false, stoppoints);
+    for (size_t j = 0; j < error_nos.size(); ++j) {
+      const size_t i = batched[j];
+      m_breakpoint_site_conditions.erase(bp_sites[i]->GetID());
+      if (error_nos[j] == 0)
+        bp_sites[i]->SetEnabled(false);
+      else
+        errors[i].SetErrorToGenericError();
+      handled[i] = true;
+    }
+  }
+
+  for (size_t i = 0; i < bp_sites.size(); ++i) {
+    if (!handled[i])
+      errors[i] = DisableBreakpointSite(bp_sites[i]);
+  }
+  return errors;
+}
+
 // Pre-requisite: wp != NULL.
 static GDBStoppointType GetGDBStoppointType(Watchpoint *wp) {
   assert(wp);
@@ -3527,9 +4117,27 @@ Status ProcessGDBRemote::LaunchAndConnectToDebugserver(
     communication_fd = gdb_socket;
 #endif
 
+    // Packets to a local lldb-server can go through shared memory, with the
+    // socket only used to wake up the other end.
+    int shm_fd = -1;
+#if defined(USE_SOCKETPAIR_FOR_LOCAL_CONNECTION) && defined(__linux__)
+    if (GetGlobalPluginProperties()->GetUseSharedMemory()) {
+      Status shm_error = ConnectionSharedMemory::CreateSharedMemory(shm_fd);
+      if (shm_error.Fail()) {
+        Log *log(
+            ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_PROCESS));
+        LLDB_LOG(log, "not using shared memory: {0}", shm_error);
+      }
+    }
+#endif
+    CleanUp cleanup_shm([shm_fd] {
+      if (shm_fd != -1)
+        close(shm_fd);
+    });
+
     error = m_gdb_comm.StartDebugserverProcess(
         nullptr, GetTarget().GetPlatform().get(), debugserver_launch_info,
-        nullptr, nullptr, communication_fd);
+        nullptr, nullptr, communication_fd, shm_fd);
 
     if (error.Success())
       m_debugserver_pid = debugserver_launch_info.GetProcessID();
@@ -3541,7 +4149,16 @@ Status ProcessGDBRemote::LaunchAndConnectToDebugserver(
       // Our process spawned correctly, we can now set our connection to use
       // our end of the socket pair
       cleanup_our.disable();
-      m_gdb_comm.SetConnection(new ConnectionFileDescriptor(our_socket, true));
+      std::unique_ptr<Connection> connection_up(
+          new ConnectionFileDescriptor(our_socket, true));
+#if defined(__linux__)
+      if (shm_fd != -1) {
+        cleanup_shm.disable();
+        connection_up.reset(new ConnectionSharedMemory(
+            std::move(connection_up), shm_fd, true));
+      }
+#endif
+      m_gdb_comm.SetConnection(connection_up.release());
 #endif
       StartAsyncThread();
     }
@@ -3555,6 +4172,10 @@ Status ProcessGDBRemote::LaunchAndConnectToDebugserver(
     }
 
     if (m_gdb_comm.IsConnected()) {
+      // Compressing packets only costs time on a connection to a debugserver
+      // running on this host.
+      m_gdb_comm.SetCompressionAllowed(false);
+
       // Finish the connection process by doing the handshake without
       // connecting (send NULL URL)
       error = ConnectToDebugserver("");
@@ -4198,6 +4819,10 @@ StructuredData::ObjectSP ProcessGDBRemote::GetSharedCacheInfo() {
   return object_sp;
 }
 
+StructuredData::DictionarySP ProcessGDBRemote::GetPacketStatistics() {
+  return m_gdb_comm.GetPacketStatistics();
+}
+
 Status ProcessGDBRemote::ConfigureStructuredData(
     ConstString type_name, const StructuredData::ObjectSP &config_sp) {
   return m_gdb_comm.ConfigureRemoteStructuredData(type_name, config_sp);
@@ -4247,6 +4872,35 @@ void ProcessGDBRemote::GetMaxMemorySize() {
     } else {
       m_max_memory_size = conservative_default;
     }
+    m_memory_read_chunk_size = m_max_memory_size;
+  }
+}
+
+// Binary memory reads start out at m_max_memory_size and are made larger, up
+// to what the stub says it can handle, while full-sized reads come back
+// quickly. One read should take about target_time: long enough for the per
+// packet overhead not to matter, and short enough that a slow link stays far
+// from the packet timeout and an interrupt doesn't wait long.
+void ProcessGDBRemote::AdjustMemoryReadChunkSize(
+    std::chrono::steady_clock::duration elapsed) {
+  if (m_user_specified_max_memory_size || m_remote_stub_max_memory_size <= 70)
+    return;
+
+  const auto target_time = std::chrono::milliseconds(50);
+  // The same allowance for the packet overhead as in GetMaxMemorySize().
+  const uint64_t largest = m_remote_stub_max_memory_size - (32 + 32 + 6);
+  const uint64_t old_size = m_memory_read_chunk_size;
+  if (elapsed < target_time / 2)
+    m_memory_read_chunk_size = std::min(largest, old_size * 2);
+  else if (elapsed > target_time * 2)
+    m_memory_read_chunk_size = std::max(m_max_memory_size, old_size / 2);
+
+  if (m_memory_read_chunk_size != old_size) {
+    Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_MEMORY));
+    LLDB_LOG(log, "read of {0} bytes took {1}, reading {2} bytes at a time",
+             old_size,
+             std::chrono::duration_cast<std::chrono::microseconds>(elapsed),
+             m_memory_read_chunk_size);
   }
 }
 
@@ -4268,6 +4922,8 @@ void ProcessGDBRemote::SetUserSpecifiedMaxMemoryTransferSize(
       m_max_memory_size =
           user_specified_max; // user's packet size is probably fine
     }
+    m_memory_read_chunk_size = m_max_memory_size;
+    m_user_specified_max_memory_size = true;
   }
 }
 
@@ -4681,11 +5337,17 @@ llvm::Expected<LoadedModuleInfoList> ProcessGDBRemote::GetLoadedModuleList() {
 
   // check that we have extended feature read support
   if (can_use_svr4 && comm.GetQXferLibrariesSVR4ReadSupported()) {
-    // request the loaded library list
+    // request the loaded library list. If we already have a list the stub
+    // numbered, only ask for what changed since then.
     std::string raw;
     lldb_private::Status lldberr;
+    std::string annex;
+    const uint32_t cached_generation = m_svr4_module_list.m_generation;
+    if (cached_generation != LLDB_INVALID_INDEX32 &&
+        comm.GetLibrariesSVR4DeltaSupported())
+      annex = llvm::formatv("generation={0:x-}", cached_generation).str();
 
-    if (!comm.ReadExtFeature(ConstString("libraries-svr4"), ConstString(""),
+    if (!comm.ReadExtFeature(ConstString("libraries-svr4"), ConstString(annex),
                              raw, lldberr))
       return llvm::createStringError(llvm::inconvertibleErrorCode(),
                                      "Error in libraries-svr4 packet");
@@ -4711,6 +5373,16 @@ llvm::Expected<LoadedModuleInfoList> ProcessGDBRemote::GetLoadedModuleList() {
           StringConvert::ToUInt64(main_lm.data(), LLDB_INVALID_ADDRESS, 0);
     }
 
+    llvm::StringRef generation = root_element.GetAttributeValue("generation");
+    if (!generation.empty())
+      list.m_generation = StringConvert::ToUInt32(
+          generation.data(), LLDB_INVALID_INDEX32, 0);
+    llvm::StringRef base_generation =
+        root_element.GetAttributeValue("base-generation");
+    if (!base_generation.empty())
+      list.m_base_generation = StringConvert::ToUInt32(
+          base_generation.data(), LLDB_INVALID_INDEX32, 0);
+
     root_element.ForEachChildElementWithName(
         "library", [log, &list](const XMLNode &library) -> bool {
 
@@ -4766,6 +5438,46 @@ llvm::Expected<LoadedModuleInfoList> ProcessGDBRemote::GetLoadedModuleList() {
                        // node
         });
 
+    if (list.m_base_generation != LLDB_INVALID_INDEX32) {
+      // This is a delta: the "library" elements were added and the "removed"
+      // elements name the link maps that went away since cached_generation.
+      if (!list.IsDeltaFrom(cached_generation)) {
+        m_svr4_module_list.clear();
+        return llvm::createStringError(
+            llvm::inconvertibleErrorCode(),
+            "libraries-svr4 delta doesn't match the cached list");
+      }
+
+      std::set<lldb::addr_t> removed_link_maps;
+      root_element.ForEachChildElementWithName(
+          "removed", [&removed_link_maps](const XMLNode &removed) -> bool {
+            llvm::StringRef lm = removed.GetAttributeValue("lm");
+            removed_link_maps.insert(StringConvert::ToUInt64(
+                lm.data(), LLDB_INVALID_ADDRESS, 0));
+            return true;
+          });
+
+      list.m_added = std::move(list.m_list);
+      list.m_list.clear();
+      list.m_link_map = m_svr4_module_list.m_link_map;
+      for (const auto &module : m_svr4_module_list.m_list) {
+        lldb::addr_t lm = LLDB_INVALID_ADDRESS;
+        if (module.get_link_map(lm) && removed_link_maps.count(lm))
+          list.m_removed.push_back(module);
+        else
+          list.m_list.push_back(module);
+      }
+      list.m_list.insert(list.m_list.end(), list.m_added.begin(),
+                         list.m_added.end());
+      LLDB_LOGF(log, "applied delta of %" PRIu64 " added and %" PRIu64
+                " removed modules",
+                (uint64_t)list.m_added.size(), (uint64_t)list.m_removed.size());
+    }
+
+    m_svr4_module_list.m_list = list.m_list;
+    m_svr4_module_list.m_link_map = list.m_link_map;
+    m_svr4_module_list.m_generation = list.m_generation;
+
     if (log)
       LLDB_LOGF(log, "found %" PRId32 " modules in total",
                 (int)list.m_list.size());
@@ -5145,8 +5857,97 @@ ParseStructuredDataPacket(llvm::StringRef packet) {
 
 void ProcessGDBRemote::HandleAsyncStructuredDataPacket(llvm::StringRef data) {
   auto structured_data_sp = ParseStructuredDataPacket(data);
-  if (structured_data_sp)
-    RouteAsyncStructuredData(structured_data_sp);
+  if (!structured_data_sp)
+    return;
+
+  // Tracepoint hits are for us, not for a StructuredDataPlugin.
+  StructuredData::Dictionary *dict = structured_data_sp->GetAsDictionary();
+  llvm::StringRef type;
+  if (dict && dict->GetValueForKeyAsString("type", type) &&
+      type == "tracepoint-hits") {
+    AddTracepointHits(*dict);
+    return;
+  }
+  RouteAsyncStructuredData(structured_data_sp);
+}
+
+void ProcessGDBRemote::AddTracepointHits(StructuredData::Dictionary &hits_dict) {
+  // Keep the memory used by the hits bounded, dropping the newest ones.
+  const size_t max_hits = 1 << 22;
+
+  StructuredData::Array *hits = nullptr;
+  uint64_t num_dropped = 0;
+  hits_dict.GetValueForKeyAsInteger("dropped", num_dropped);
+  std::lock_guard<std::mutex> guard(m_tracepoints_mutex);
+  m_num_dropped_tracepoint_hits += num_dropped;
+  if (!hits_dict.GetValueForKeyAsArray("hits", hits))
+    return;
+  for (size_t i = 0; i < hits->GetSize(); ++i) {
+    StructuredData::Array *fields = nullptr;
+    if (!hits->GetItemAtIndexAsArray(i, fields) || fields->GetSize() < 3)
+      continue;
+    if (m_tracepoint_hits.size() >= max_hits) {
+      ++m_num_dropped_tracepoint_hits;
+      continue;
+    }
+    TracepointHit hit = {LLDB_INVALID_THREAD_ID, LLDB_INVALID_ADDRESS, 0, {}};
+    fields->GetItemAtIndexAsInteger(0, hit.tid);
+    fields->GetItemAtIndexAsInteger(1, hit.pc);
+    fields->GetItemAtIndexAsInteger(2, hit.timestamp);
+    for (size_t j = 3; j < fields->GetSize(); ++j) {
+      uint64_t value = 0;
+      fields->GetItemAtIndexAsInteger(j, value);
+      hit.registers.push_back(value);
+    }
+    m_tracepoint_hits.push_back(std::move(hit));
+  }
+}
+
+Status ProcessGDBRemote::SetTracepoint(
+    lldb::addr_t addr, llvm::ArrayRef<const RegisterInfo *> registers) {
+  std::vector<uint32_t> regnums;
+  std::vector<std::string> names;
+  for (const RegisterInfo *reg_info : registers) {
+    regnums.push_back(reg_info->kinds[eRegisterKindProcessPlugin]);
+    names.push_back(reg_info->name);
+  }
+  Status error = m_gdb_comm.SetTracepoint(addr, regnums);
+  if (error.Fail())
+    return error;
+  std::lock_guard<std::mutex> guard(m_tracepoints_mutex);
+  m_tracepoint_registers[addr] = std::move(names);
+  return error;
+}
+
+Status ProcessGDBRemote::ClearTracepoint(lldb::addr_t addr) {
+  Status error = m_gdb_comm.ClearTracepoint(addr);
+  if (error.Fail())
+    return error;
+  std::lock_guard<std::mutex> guard(m_tracepoints_mutex);
+  m_tracepoint_registers.erase(addr);
+  return error;
+}
+
+std::vector<std::string>
+ProcessGDBRemote::GetTracepointRegisterNames(lldb::addr_t addr) {
+  std::lock_guard<std::mutex> guard(m_tracepoints_mutex);
+  auto pos = m_tracepoint_registers.find(addr);
+  if (pos == m_tracepoint_registers.end())
+    return {};
+  return pos->second;
+}
+
+std::vector<ProcessGDBRemote::TracepointHit>
+ProcessGDBRemote::GetTracepointHits(size_t &num_dropped) {
+  std::lock_guard<std::mutex> guard(m_tracepoints_mutex);
+  num_dropped = m_num_dropped_tracepoint_hits;
+  return m_tracepoint_hits;
+}
+
+void ProcessGDBRemote::ClearTracepointHits() {
+  std::lock_guard<std::mutex> guard(m_tracepoints_mutex);
+  m_tracepoint_hits.clear();
+  m_num_dropped_tracepoint_hits = 0;
 }
 
 class CommandObjectProcessGDBRemoteSpeedTest : public CommandObjectParsed {
@@ -5393,6 +6194,390 @@ public:
   }
 };
 
+class CommandObjectProcessGDBRemoteSnapshotSave : public CommandObjectParsed {
+public:
+  CommandObjectProcessGDBRemoteSnapshotSave(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "process plugin snapshot save",
+                            "Save a copy of the stopped process in the remote "
+                            "stub and print its ID. Only the selected thread "
+                            "is in the copy.",
+                            nullptr,
+                            eCommandRequiresProcess |
+                                eCommandProcessMustBeLaunched |
+                                eCommandProcessMustBePaused) {}
+
+  ~CommandObjectProcessGDBRemoteSnapshotSave() override {}
+
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    if (command.GetArgumentCount() != 0) {
+      result.AppendErrorWithFormat("'%s' takes no arguments",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    ProcessGDBRemote *process =
+        (ProcessGDBRemote *)m_interpreter.GetExecutionContext().GetProcessPtr();
+    lldb::user_id_t snapshot_id = LLDB_INVALID_UID;
+    Status error = process->GetGDBRemote().SaveSnapshot(snapshot_id);
+    if (error.Fail()) {
+      result.AppendError(error.AsCString());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+    result.AppendMessageWithFormat("Saved snapshot %" PRIu64 ".\n",
+                                   snapshot_id);
+    result.SetStatus(eReturnStatusSuccessFinishResult);
+    return true;
+  }
+};
+
+class CommandObjectProcessGDBRemoteSnapshotRestore
+    : public CommandObjectParsed {
+public:
+  CommandObjectProcessGDBRemoteSnapshotRestore(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "process plugin snapshot restore",
+                            "Replace the stopped process with a copy of a "
+                            "snapshot. The snapshot is kept, so it can be "
+                            "restored again.",
+                            "process plugin snapshot restore <snapshot-id>",
+                            eCommandRequiresProcess |
+                                eCommandProcessMustBeLaunched |
+                                eCommandProcessMustBePaused) {}
+
+  ~CommandObjectProcessGDBRemoteSnapshotRestore() override {}
+
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    lldb::user_id_t snapshot_id;
+    if (command.GetArgumentCount() != 1 ||
+        llvm::StringRef(command.GetArgumentAtIndex(0))
+            .getAsInteger(0, snapshot_id)) {
+      result.AppendErrorWithFormat("'%s' takes a snapshot ID argument",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    ProcessGDBRemote *process =
+        (ProcessGDBRemote *)m_interpreter.GetExecutionContext().GetProcessPtr();
+    Status error = process->RestoreSnapshot(snapshot_id);
+    if (error.Fail()) {
+      result.AppendError(error.AsCString());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+    result.AppendMessageWithFormat("Process %" PRIu64
+                                   " restored from snapshot %" PRIu64 ".\n",
+                                   process->GetID(), snapshot_id);
+    result.SetStatus(eReturnStatusSuccessFinishResult);
+    return true;
+  }
+};
+
+class CommandObjectProcessGDBRemoteSnapshotDelete
+    : public CommandObjectParsed {
+public:
+  CommandObjectProcessGDBRemoteSnapshotDelete(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "process plugin snapshot delete",
+                            "Delete a snapshot of the process.",
+                            "process plugin snapshot delete <snapshot-id>",
+                            eCommandRequiresProcess |
+                                eCommandProcessMustBeLaunched) {}
+
+  ~CommandObjectProcessGDBRemoteSnapshotDelete() override {}
+
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    lldb::user_id_t snapshot_id;
+    if (command.GetArgumentCount() != 1 ||
+        llvm::StringRef(command.GetArgumentAtIndex(0))
+            .getAsInteger(0, snapshot_id)) {
+      result.AppendErrorWithFormat("'%s' takes a snapshot ID argument",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    ProcessGDBRemote *process =
+        (ProcessGDBRemote *)m_interpreter.GetExecutionContext().GetProcessPtr();
+    Status error = process->GetGDBRemote().DeleteSnapshot(snapshot_id);
+    if (error.Fail()) {
+      result.AppendError(error.AsCString());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+    result.SetStatus(eReturnStatusSuccessFinishNoResult);
+    return true;
+  }
+};
+
+class CommandObjectProcessGDBRemoteSnapshot : public CommandObjectMultiword {
+public:
+  CommandObjectProcessGDBRemoteSnapshot(CommandInterpreter &interpreter)
+      : CommandObjectMultiword(
+            interpreter, "process plugin snapshot",
+            "Commands that save copies of the process to go back to later, "
+            "for trying things out with the copies.",
+            "process plugin snapshot <subcommand> [<subcommand-options>]") {
+    LoadSubCommand(
+        "save",
+        CommandObjectSP(
+            new CommandObjectProcessGDBRemoteSnapshotSave(interpreter)));
+    LoadSubCommand(
+        "restore",
+        CommandObjectSP(
+            new CommandObjectProcessGDBRemoteSnapshotRestore(interpreter)));
+    LoadSubCommand(
+        "delete",
+        CommandObjectSP(
+            new CommandObjectProcessGDBRemoteSnapshotDelete(interpreter)));
+  }
+
+  ~CommandObjectProcessGDBRemoteSnapshot() override {}
+};
+
+/// The load addresses of the entry points of the functions named \a name.
+static std::vector<lldb::addr_t> FindFunctionEntryAddresses(Target &target,
+                                                            ConstString name) {
+  SymbolContextList sc_list;
+  target.GetImages().FindFunctions(name, eFunctionNameTypeAuto,
+                                   /*include_symbols=*/true,
+                                   /*include_inlines=*/false,
+                                   /*append=*/true, sc_list);
+  std::vector<lldb::addr_t> addrs;
+  for (uint32_t i = 0; i < sc_list.GetSize(); ++i) {
+    SymbolContext sc;
+    sc_list.GetContextAtIndex(i, sc);
+    Address entry;
+    if (sc.function)
+      entry = sc.function->GetAddressRange().GetBaseAddress();
+    else if (sc.symbol)
+      entry = sc.symbol->GetAddress();
+    else
+      continue;
+    const lldb::addr_t load_addr = entry.GetLoadAddress(&target);
+    if (load_addr != LLDB_INVALID_ADDRESS &&
+        !llvm::is_contained(addrs, load_addr))
+      addrs.push_back(load_addr);
+  }
+  return addrs;
+}
+
+class CommandObjectProcessGDBRemoteTraceFunction : public CommandObjectParsed {
+public:
+  CommandObjectProcessGDBRemoteTraceFunction(CommandInterpreter &interpreter)
+      : CommandObjectParsed(
+            interpreter, "process plugin trace function",
+            "Record every call of a function in the remote stub, which "
+            "resumes the calling thread right away instead of stopping the "
+            "process. Use \"process plugin trace dump\" to see the calls.",
+            "process plugin trace function [-r <register>[,<register>...]] "
+            "<function-name>",
+            eCommandRequiresProcess | eCommandProcessMustBeLaunched |
+                eCommandProcessMustBePaused),
+        m_option_group(),
+        m_registers(LLDB_OPT_SET_1, false, "registers", 'r', 0,
+                    eArgTypeRegisterName,
+                    "A comma separated list of the registers to record at "
+                    "each call, e.g. the ones holding the arguments.",
+                    nullptr) {
+    m_option_group.Append(&m_registers, LLDB_OPT_SET_ALL, LLDB_OPT_SET_1);
+    m_option_group.Finalize();
+  }
+
+  ~CommandObjectProcessGDBRemoteTraceFunction() override {}
+
+  Options *GetOptions() override { return &m_option_group; }
+
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    if (command.GetArgumentCount() != 1) {
+      result.AppendErrorWithFormat("'%s' takes a function name argument",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    ExecutionContext exe_ctx = m_interpreter.GetExecutionContext();
+    ProcessGDBRemote *process = (ProcessGDBRemote *)exe_ctx.GetProcessPtr();
+    RegisterContext *reg_ctx = exe_ctx.GetRegisterContext();
+    std::vector<const RegisterInfo *> registers;
+    llvm::SmallVector<llvm::StringRef, 8> names;
+    m_registers.GetOptionValue().GetCurrentValueAsRef().split(names, ',', -1,
+                                                              false);
+    for (llvm::StringRef name : names) {
+      const RegisterInfo *reg_info =
+          reg_ctx ? reg_ctx->GetRegisterInfoByName(name.trim()) : nullptr;
+      if (!reg_info) {
+        result.AppendErrorWithFormat("unknown register '%s'",
+                                     name.str().c_str());
+        result.SetStatus(eReturnStatusFailed);
+        return false;
+      }
+      registers.push_back(reg_info);
+    }
+
+    ConstString function_name(command.GetArgumentAtIndex(0));
+    std::vector<lldb::addr_t> addrs =
+        FindFunctionEntryAddresses(process->GetTarget(), function_name);
+    if (addrs.empty()) {
+      result.AppendErrorWithFormat("no function named '%s' is loaded",
+                                   function_name.GetCString());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+    for (lldb::addr_t addr : addrs) {
+      Status error = process->SetTracepoint(addr, registers);
+      if (error.Fail()) {
+        result.AppendErrorWithFormat("tracing 0x%" PRIx64 " failed: %s", addr,
+                                     error.AsCString());
+        result.SetStatus(eReturnStatusFailed);
+        return false;
+      }
+    }
+    result.AppendMessageWithFormat("Tracing %zu location(s) of '%s'.\n",
+                                   addrs.size(), function_name.GetCString());
+    result.SetStatus(eReturnStatusSuccessFinishResult);
+    return true;
+  }
+
+protected:
+  OptionGroupOptions m_option_group;
+  OptionGroupString m_registers;
+};
+
+class CommandObjectProcessGDBRemoteTraceRemove : public CommandObjectParsed {
+public:
+  CommandObjectProcessGDBRemoteTraceRemove(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "process plugin trace remove",
+                            "Stop recording the calls of a function. The "
+                            "calls recorded so far are kept.",
+                            "process plugin trace remove <function-name>",
+                            eCommandRequiresProcess |
+                                eCommandProcessMustBeLaunched |
+                                eCommandProcessMustBePaused) {}
+
+  ~CommandObjectProcessGDBRemoteTraceRemove() override {}
+
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    if (command.GetArgumentCount() != 1) {
+      result.AppendErrorWithFormat("'%s' takes a function name argument",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    ProcessGDBRemote *process =
+        (ProcessGDBRemote *)m_interpreter.GetExecutionContext().GetProcessPtr();
+    ConstString function_name(command.GetArgumentAtIndex(0));
+    for (lldb::addr_t addr :
+         FindFunctionEntryAddresses(process->GetTarget(), function_name)) {
+      Status error = process->ClearTracepoint(addr);
+      if (error.Fail()) {
+        result.AppendErrorWithFormat("removing the tracepoint at 0x%" PRIx64
+                                     " failed: %s",
+                                     addr, error.AsCString());
+        result.SetStatus(eReturnStatusFailed);
+        return false;
+      }
+    }
+    result.SetStatus(eReturnStatusSuccessFinishNoResult);
+    return true;
+  }
+};
+
+class CommandObjectProcessGDBRemoteTraceDump : public CommandObjectParsed {
+public:
+  CommandObjectProcessGDBRemoteTraceDump(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "process plugin trace dump",
+                            "Print the traced calls received so far, with "
+                            "their time in microseconds since the first one.",
+                            nullptr, eCommandRequiresProcess) {}
+
+  ~CommandObjectProcessGDBRemoteTraceDump() override {}
+
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    if (command.GetArgumentCount() != 0) {
+      result.AppendErrorWithFormat("'%s' takes no arguments",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    ProcessGDBRemote *process =
+        (ProcessGDBRemote *)m_interpreter.GetExecutionContext().GetProcessPtr();
+    Target &target = process->GetTarget();
+    size_t num_dropped = 0;
+    std::vector<ProcessGDBRemote::TracepointHit> hits =
+        process->GetTracepointHits(num_dropped);
+    Stream &strm = result.GetOutputStream();
+    for (const ProcessGDBRemote::TracepointHit &hit : hits) {
+      strm.Printf("%14.3f tid 0x%" PRIx64 " ",
+                  (hit.timestamp - hits.front().timestamp) / 1000.0, hit.tid);
+      Address addr;
+      if (target.ResolveLoadAddress(hit.pc, addr))
+        addr.Dump(&strm, process, Address::DumpStyleResolvedDescription,
+                  Address::DumpStyleLoadAddress);
+      else
+        strm.Printf("0x%" PRIx64, hit.pc);
+      std::vector<std::string> names =
+          process->GetTracepointRegisterNames(hit.pc);
+      for (size_t i = 0; i < hit.registers.size(); ++i)
+        strm.Printf(" %s=0x%" PRIx64,
+                    i < names.size() ? names[i].c_str() : "?",
+                    hit.registers[i]);
+      strm.EOL();
+    }
+    if (num_dropped)
+      strm.Printf("%zu calls were dropped.\n", num_dropped);
+    result.SetStatus(eReturnStatusSuccessFinishResult);
+    return true;
+  }
+};
+
+class CommandObjectProcessGDBRemoteTraceClear : public CommandObjectParsed {
+public:
+  CommandObjectProcessGDBRemoteTraceClear(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "process plugin trace clear",
+                            "Forget the traced calls received so far.",
+                            nullptr, eCommandRequiresProcess) {}
+
+  ~CommandObjectProcessGDBRemoteTraceClear() override {}
+
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    ProcessGDBRemote *process =
+        (ProcessGDBRemote *)m_interpreter.GetExecutionContext().GetProcessPtr();
+    process->ClearTracepointHits();
+    result.SetStatus(eReturnStatusSuccessFinishNoResult);
+    return true;
+  }
+};
+
+class CommandObjectProcessGDBRemoteTrace : public CommandObjectMultiword {
+public:
+  CommandObjectProcessGDBRemoteTrace(CommandInterpreter &interpreter)
+      : CommandObjectMultiword(
+            interpreter, "process plugin trace",
+            "Commands that record function calls in the remote stub without "
+            "stopping the process, which is much faster than breakpoints "
+            "with commands that continue.",
+            "process plugin trace <subcommand> [<subcommand-options>]") {
+    LoadSubCommand(
+        "function",
+        CommandObjectSP(
+            new CommandObjectProcessGDBRemoteTraceFunction(interpreter)));
+    LoadSubCommand("remove",
+                   CommandObjectSP(new CommandObjectProcessGDBRemoteTraceRemove(
+                       interpreter)));
+    LoadSubCommand("dump",
+                   CommandObjectSP(
+                       new CommandObjectProcessGDBRemoteTraceDump(interpreter)));
+    LoadSubCommand("clear",
+                   CommandObjectSP(new CommandObjectProcessGDBRemoteTraceClear(
+                       interpreter)));
+  }
+
+  ~CommandObjectProcessGDBRemoteTrace() override {}
+};
+
 class CommandObjectProcessGDBRemotePacket : public CommandObjectMultiword {
 private:
 public:
@@ -5433,6 +6618,12 @@ public:
     LoadSubCommand(
         "packet",
         CommandObjectSP(new CommandObjectProcessGDBRemotePacket(interpreter)));
+    LoadSubCommand("snapshot",
+                   CommandObjectSP(
+                       new CommandObjectProcessGDBRemoteSnapshot(interpreter)));
+    LoadSubCommand(
+        "trace",
+        CommandObjectSP(new CommandObjectProcessGDBRemoteTrace(interpreter)));
   }
 
   ~CommandObjectMultiwordProcessGDBRemote() override {}
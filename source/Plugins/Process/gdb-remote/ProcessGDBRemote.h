@@ -10,6 +10,7 @@
 #define liblldb_ProcessGDBRemote_h_
 
 #include <atomic>
+#include <chrono>
 #include <map>
 #include <mutex>
 #include <string>
@@ -19,6 +20,7 @@
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/ThreadSafeValue.h"
 #include "lldb/Host/HostThread.h"
+#include "lldb/Target/MemoryRegionInfo.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Utility/ArchSpec.h"
@@ -133,6 +135,13 @@ public:
   size_t DoReadMemory(lldb::addr_t addr, void *buf, size_t size,
                       Status &error) override;
 
+  std::vector<size_t> DoReadMemoryRanges(llvm::ArrayRef<MemoryRange> ranges,
+                                         uint8_t *buf) override;
+
+  bool DoFindInMemory(lldb::addr_t low, lldb::addr_t high,
+                      llvm::ArrayRef<uint8_t> pattern,
+                      lldb::addr_t &found_addr) override;
+
   Status
   WriteObjectFile(std::vector<ObjectFile::LoadableData> entries) override;
 
@@ -155,6 +164,16 @@ public:
 
   Status DisableBreakpointSite(BreakpointSite *bp_site) override;
 
+  std::vector<Status>
+  EnableBreakpointSites(llvm::ArrayRef<BreakpointSite *> bp_sites) override;
+
+  std::vector<Status>
+  DisableBreakpointSites(llvm::ArrayRef<BreakpointSite *> bp_sites) override;
+
+  void BreakpointSiteConditionsChanged(BreakpointSite *bp_site) override;
+
+  bool StepsOverBreakpointSiteOnResume(BreakpointSite *bp_site) override;
+
   // Process Watchpoints
   Status EnableWatchpoint(Watchpoint *wp, bool notify = true) override;
 
@@ -228,9 +247,39 @@ public:
 
   StructuredData::ObjectSP GetSharedCacheInfo() override;
 
+  StructuredData::DictionarySP GetPacketStatistics() override;
+
   std::string HarmonizeThreadIdsForProfileData(
       StringExtractorGDBRemote &inputStringExtractor);
 
+  /// Have the remote stub replace the stopped process with a copy of a
+  /// snapshot it saved, and forget what we knew about the old process.
+  Status RestoreSnapshot(lldb::user_id_t snapshot_id);
+
+  struct TracepointHit {
+    lldb::tid_t tid;
+    lldb::addr_t pc;
+    /// Nanoseconds on the stub's steady clock.
+    uint64_t timestamp;
+    std::vector<uint64_t> registers;
+  };
+
+  /// Have the remote stub record the hits of \a addr, with the values of
+  /// \a registers, without stopping the process.
+  Status SetTracepoint(lldb::addr_t addr,
+                       llvm::ArrayRef<const RegisterInfo *> registers);
+
+  Status ClearTracepoint(lldb::addr_t addr);
+
+  /// The names of the registers the tracepoint at \a addr records.
+  std::vector<std::string> GetTracepointRegisterNames(lldb::addr_t addr);
+
+  /// The tracepoint hits received so far, oldest first. \a num_dropped is
+  /// set to how many hits were lost on the way.
+  std::vector<TracepointHit> GetTracepointHits(size_t &num_dropped);
+
+  void ClearTracepointHits();
+
 protected:
   friend class ThreadGDBRemote;
   friend class GDBRemoteCommunicationClient;
@@ -260,6 +309,7 @@ protected:
   typedef std::vector<std::pair<lldb::tid_t, int>> tid_sig_collection;
   typedef std::map<lldb::addr_t, lldb::addr_t> MMapMap;
   typedef std::map<uint32_t, std::string> ExpeditedRegisterMap;
+  typedef std::map<lldb::tid_t, StructuredData::Dictionary *> ThreadInfoMap;
   tid_collection m_thread_ids; // Thread IDs for all threads. This list gets
                                // updated after stopping
   std::vector<lldb::addr_t> m_thread_pcs;     // PC values for all the threads.
@@ -269,15 +319,37 @@ protected:
                                               // registers and memory for all
                                               // threads if "jThreadsInfo"
                                               // packet is supported
+  ThreadInfoMap m_jstopinfo_by_tid;    // m_jstopinfo_sp by thread ID
+  ThreadInfoMap m_jthreadsinfo_by_tid; // m_jthreadsinfo_sp by thread ID
   tid_collection m_continue_c_tids;           // 'c' for continue
   tid_sig_collection m_continue_C_tids;       // 'C' for continue with signal
   tid_collection m_continue_s_tids;           // 's' for step
   tid_sig_collection m_continue_S_tids;       // 'S' for step with signal
+  bool m_resume_held_suspended_threads; // True if the last resume packet
+                                        // kept the threads it didn't name
+                                        // stopped
   uint64_t m_max_memory_size; // The maximum number of bytes to read/write when
                               // reading and writing memory
   uint64_t m_remote_stub_max_memory_size; // The maximum memory size the remote
                                           // gdb stub can handle
+  uint64_t m_memory_read_chunk_size; // The number of bytes to ask for in one
+                                     // binary memory read, see
+                                     // AdjustMemoryReadChunkSize()
+  bool m_user_specified_max_memory_size;
   MMapMap m_addr_to_mmap_size;
+  // The memory regions the stub described since the process last stopped,
+  // by start address. The regions tile the address space, so most queries
+  // from the same stop fall in one of them. See GetMemoryRegionInfo().
+  std::map<lldb::addr_t, MemoryRegionInfo> m_memory_regions;
+  uint32_t m_memory_regions_stop_id;
+  uint32_t m_memory_regions_resume_id;
+  std::mutex m_memory_regions_mutex;
+  // The hits the stub streamed in asynchronous JSON packets, and the
+  // registers each tracepoint records by its address.
+  std::mutex m_tracepoints_mutex;
+  std::vector<TracepointHit> m_tracepoint_hits;
+  size_t m_num_dropped_tracepoint_hits = 0;
+  std::map<lldb::addr_t, std::vector<std::string>> m_tracepoint_registers;
   lldb::BreakpointSP m_thread_create_bp_sp;
   bool m_waiting_for_attach;
   bool m_destroy_tried_resuming;
@@ -290,6 +362,12 @@ protected:
   using FlashRangeVector = lldb_private::RangeVector<lldb::addr_t, size_t>;
   using FlashRange = FlashRangeVector::Entry;
   FlashRangeVector m_erased_flash_ranges;
+  // The conditions the stub has for each software breakpoint site that has
+  // any.
+  std::map<lldb::break_id_t, std::vector<AgentExpression>>
+      m_breakpoint_site_conditions;
+  LoadedModuleInfoList m_svr4_module_list; // The last libraries-svr4 list the
+                                           // stub sent, used to apply deltas
 
   // Accessors
   bool IsRunning(lldb::StateType state) {
@@ -331,6 +409,15 @@ protected:
 
   void GetMaxMemorySize();
 
+  // Grow or shrink m_memory_read_chunk_size after a binary memory read of that
+  // size took \a elapsed.
+  void AdjustMemoryReadChunkSize(std::chrono::steady_clock::duration elapsed);
+
+  // The conditions to hand the stub with \a bp_site, empty if every hit has
+  // to be reported.
+  std::vector<AgentExpression>
+  GetBreakpointSiteConditions(BreakpointSite *bp_site);
+
   bool CalculateThreadStopInfo(ThreadGDBRemote *thread);
 
   size_t UpdateThreadPCsFromStopReplyThreadsValue(std::string &value);
@@ -352,9 +439,11 @@ protected:
 
   lldb::StateType SetThreadStopInfo(StringExtractor &stop_packet);
 
-  bool
-  GetThreadStopInfoFromJSON(ThreadGDBRemote *thread,
-                            const StructuredData::ObjectSP &thread_infos_sp);
+  static void IndexThreadInfos(const StructuredData::ObjectSP &thread_infos_sp,
+                               ThreadInfoMap &thread_infos);
+
+  bool GetThreadStopInfoFromJSON(ThreadGDBRemote *thread,
+                                 const ThreadInfoMap &thread_infos);
 
   lldb::ThreadSP SetThreadStopInfo(StructuredData::Dictionary *thread_dict);
 
@@ -405,6 +494,9 @@ protected:
 
   bool HasErased(FlashRange range);
 
+  // Forget the memory regions cached by GetMemoryRegionInfo().
+  void ClearMemoryRegionCache();
+
 private:
   // For ProcessGDBRemote only
   std::string m_partial_profile_data;
@@ -422,6 +514,8 @@ private:
   void HandleStopReply() override;
   void HandleAsyncStructuredDataPacket(llvm::StringRef data) override;
 
+  void AddTracepointHits(StructuredData::Dictionary &hits_dict);
+
   void SetThreadPc(const lldb::ThreadSP &thread_sp, uint64_t index);
   using ModuleCacheKey = std::pair<std::string, std::string>;
   // KeyInfo for the cached module spec DenseMap.
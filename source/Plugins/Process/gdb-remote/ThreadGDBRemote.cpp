@@ -38,7 +38,8 @@ ThreadGDBRemote::ThreadGDBRemote(Process &process, lldb::tid_t tid)
       m_thread_dispatch_qaddr(LLDB_INVALID_ADDRESS),
       m_dispatch_queue_t(LLDB_INVALID_ADDRESS), m_queue_kind(eQueueKindUnknown),
       m_queue_serial_number(LLDB_INVALID_QUEUE_ID),
-      m_associated_with_libdispatch_queue(eLazyBoolCalculate) {
+      m_associated_with_libdispatch_queue(eLazyBoolCalculate),
+      m_held_register_stop_id(UINT32_MAX) {
   Log *log(GetLogIfAnyCategoriesSet(GDBR_LOG_THREAD));
   LLDB_LOG(log, "this = {0}, pid = {1}, tid = {2}", this, process.GetID(),
            GetID());
@@ -232,6 +233,8 @@ void ThreadGDBRemote::WillResume(StateType resume_state) {
   LLDB_LOGF(log, "Resuming thread: %4.4" PRIx64 " with state: %s.", tid,
             StateAsCString(resume_state));
 
+  m_held_register_stop_id = UINT32_MAX;
+
   ProcessSP process_sp(GetProcess());
   if (process_sp) {
     ProcessGDBRemote *gdb_process =
@@ -239,7 +242,12 @@ void ThreadGDBRemote::WillResume(StateType resume_state) {
     switch (resume_state) {
     case eStateSuspended:
     case eStateStopped:
-      // Don't append anything for threads that should stay stopped.
+      // Don't append anything for threads that should stay stopped. Remember
+      // which stop our registers are valid for so that, if the thread really
+      // doesn't run, the next stop can keep using them.
+      if (m_reg_context_sp &&
+          m_reg_context_sp->GetStopID() == process_sp->GetStopID())
+        m_held_register_stop_id = process_sp->GetStopID();
       break;
 
     case eStateRunning:
@@ -271,8 +279,28 @@ void ThreadGDBRemote::RefreshStateAfterStop() {
   // it needs to invalidate which registers are valid by putting hooks in the
   // register read and register supply functions where they check the process
   // stop ID and do the right thing.
+  //
+  // A thread that was kept suspended across the resume didn't execute, so
+  // whatever registers we had cached for it are still correct. Move them
+  // forward to the current stop instead of fetching them again.
+  const uint32_t held_stop_id = m_held_register_stop_id;
+  m_held_register_stop_id = UINT32_MAX;
+  ProcessSP process_sp(GetProcess());
+  if (process_sp && held_stop_id != UINT32_MAX && m_reg_context_sp &&
+      m_reg_context_sp->GetStopID() == held_stop_id &&
+      static_cast<ProcessGDBRemote *>(process_sp.get())
+          ->m_resume_held_suspended_threads) {
+    m_reg_context_sp->SetStopID(process_sp->GetStopID());
+    return;
+  }
+
   const bool force = false;
-  GetRegisterContext()->InvalidateIfNeeded(force);
+  InvalidateRegistersIfNeeded(force);
+}
+
+void ThreadGDBRemote::InvalidateRegistersIfNeeded(bool force) {
+  if (m_reg_context_sp)
+    m_reg_context_sp->InvalidateIfNeeded(force);
 }
 
 bool ThreadGDBRemote::ThreadIDIsValid(lldb::tid_t thread) {
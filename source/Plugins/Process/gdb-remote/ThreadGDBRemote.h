@@ -100,11 +100,20 @@ protected:
   uint64_t
       m_queue_serial_number; // Queue info from stop reply/stop info for thread
   lldb_private::LazyBool m_associated_with_libdispatch_queue;
+  uint32_t m_held_register_stop_id; // The stop ID our cached registers were
+                                    // valid for when we were resumed as
+                                    // suspended, or UINT32_MAX if we ran
 
   bool PrivateSetRegisterValue(uint32_t reg, llvm::ArrayRef<uint8_t> data);
 
   bool PrivateSetRegisterValue(uint32_t reg, uint64_t regval);
 
+  // Invalidate the registers cached for an earlier stop. A thread that
+  // hasn't made a register context yet has nothing cached, and making one
+  // for each idle thread at every stop would be wasted work, so none is
+  // made here.
+  void InvalidateRegistersIfNeeded(bool force);
+
   bool CachedQueueInfoIsValid() const {
     return m_queue_kind != lldb::eQueueKindUnknown;
   }
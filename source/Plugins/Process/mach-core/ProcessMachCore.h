@@ -62,6 +62,8 @@ public:
 
   bool WarnBeforeDetach() const override;
 
+  bool IsLiveDebugSession() const override { return false; }
+
   // Process Memory
   size_t ReadMemory(lldb::addr_t addr, void *buf, size_t size,
                     lldb_private::Status &error) override;
@@ -323,9 +323,8 @@ const MinidumpExceptionStream *MinidumpParser::GetExceptionStream() {
   return MinidumpExceptionStream::Parse(data);
 }
 
-llvm::Optional<minidump::Range>
-MinidumpParser::FindMemoryRange(lldb::addr_t addr) {
-  llvm::ArrayRef<uint8_t> data64 = GetStream(StreamType::Memory64List);
+void MinidumpParser::BuildMemoryRanges() {
+  m_parsed_memory_ranges = true;
   Log *log = GetLogIfAnyCategoriesSet(LIBLLDB_LOG_MODULES);
 
   auto ExpectedMemory = GetMinidumpFile().getMemoryList();
@@ -335,21 +334,16 @@ MinidumpParser::FindMemoryRange(lldb::addr_t addr) {
   } else {
     for (const auto &memory_desc : *ExpectedMemory) {
       const LocationDescriptor &loc_desc = memory_desc.Memory;
-      const lldb::addr_t range_start = memory_desc.StartOfMemoryRange;
-      const size_t range_size = loc_desc.DataSize;
-
-      if (loc_desc.RVA + loc_desc.DataSize > GetData().size())
-        return llvm::None;
-
-      if (range_start <= addr && addr < range_start + range_size) {
-        auto ExpectedSlice = GetMinidumpFile().getRawData(loc_desc);
-        if (!ExpectedSlice) {
-          LLDB_LOG_ERROR(log, ExpectedSlice.takeError(),
-                         "Failed to get memory slice: {0}");
-          return llvm::None;
-        }
-        return minidump::Range(range_start, *ExpectedSlice);
+      if (loc_desc.DataSize == 0)
+        continue;
+      auto ExpectedSlice = GetMinidumpFile().getRawData(loc_desc);
+      if (!ExpectedSlice) {
+        LLDB_LOG_ERROR(log, ExpectedSlice.takeError(),
+                       "Failed to get memory slice: {0}");
+        continue;
       }
+      m_memory_ranges.emplace_back(memory_desc.StartOfMemoryRange,
+                                   *ExpectedSlice);
     }
   }
 
@@ -357,40 +351,56 @@ MinidumpParser::FindMemoryRange(lldb::addr_t addr) {
   // (full-memory Minidumps).  We can't exactly use the same loop as above,
   // because the Minidump uses slightly different data structures to describe
   // those
-
+  llvm::ArrayRef<uint8_t> data64 = GetStream(StreamType::Memory64List);
   if (!data64.empty()) {
     llvm::ArrayRef<MinidumpMemoryDescriptor64> memory64_list;
     uint64_t base_rva;
     std::tie(memory64_list, base_rva) =
         MinidumpMemoryDescriptor64::ParseMemory64List(data64);
 
-    if (memory64_list.empty())
-      return llvm::None;
-
     for (const auto &memory_desc64 : memory64_list) {
-      const lldb::addr_t range_start = memory_desc64.start_of_memory_range;
       const size_t range_size = memory_desc64.data_size;
-
+      // The data of all ranges is laid out back to back, once one of them is
+      // cut off so are all the ones after it.
       if (base_rva + range_size > GetData().size())
-        return llvm::None;
-
-      if (range_start <= addr && addr < range_start + range_size) {
-        return minidump::Range(range_start,
-                               GetData().slice(base_rva, range_size));
-      }
+        break;
+      if (range_size > 0)
+        m_memory_ranges.emplace_back(memory_desc64.start_of_memory_range,
+                                     GetData().slice(base_rva, range_size));
       base_rva += range_size;
     }
   }
 
+  // Sort stably so that the memory list still wins over the Memory64List for
+  // the same start address.
+  std::stable_sort(m_memory_ranges.begin(), m_memory_ranges.end(),
+                   [](const Range &lhs, const Range &rhs) {
+                     return lhs.start < rhs.start;
+                   });
+}
+
+llvm::Optional<minidump::Range>
+MinidumpParser::FindMemoryRange(lldb::addr_t addr) {
+  // Minidumps can have hundreds of thousands of memory ranges, index them
+  // once so every read doesn't have to scan them all.
+  if (!m_parsed_memory_ranges)
+    BuildMemoryRanges();
+
+  auto pos = std::upper_bound(
+      m_memory_ranges.begin(), m_memory_ranges.end(), addr,
+      [](lldb::addr_t addr, const Range &range) { return addr < range.start; });
+  // Ranges don't overlap in practice, so only the last range starting at or
+  // before addr can contain it.
+  if (pos == m_memory_ranges.begin())
+    return llvm::None;
+  --pos;
+  if (addr - pos->start < pos->range_ref.size())
+    return *pos;
   return llvm::None;
 }
 
 llvm::ArrayRef<uint8_t> MinidumpParser::GetMemory(lldb::addr_t addr,
                                                   size_t size) {
-  // I don't have a sense of how frequently this is called or how many memory
-  // ranges a Minidump typically has, so I'm not sure if searching for the
-  // appropriate range linearly each time is stupid.  Perhaps we should build
-  // an index for faster lookups.
   llvm::Optional<minidump::Range> range = FindMemoryRange(addr);
   if (!range)
     return {};
@@ -28,6 +28,7 @@
 // C++ includes
 #include <cstring>
 #include <unordered_map>
+#include <vector>
 
 namespace lldb_private {
 
@@ -102,12 +103,17 @@ private:
 
   MemoryRegionInfo FindMemoryRegion(lldb::addr_t load_addr) const;
 
+  void BuildMemoryRanges();
+
 private:
   lldb::DataBufferSP m_data_sp;
   std::unique_ptr<llvm::object::MinidumpFile> m_file;
   ArchSpec m_arch;
   MemoryRegionInfos m_regions;
   bool m_parsed_regions = false;
+  std::vector<Range> m_memory_ranges; ///< Memory ranges sorted by start
+                                      /// address, see FindMemoryRange()
+  bool m_parsed_memory_ranges = false;
 };
 
 } // end namespace minidump
@@ -68,6 +68,8 @@ public:
 
   bool WarnBeforeDetach() const override;
 
+  bool IsLiveDebugSession() const override { return false; }
+
   size_t ReadMemory(lldb::addr_t addr, void *buf, size_t size,
                     Status &error) override;
 
@@ -189,6 +189,10 @@ LLDBSWIGPython_GetDynamicSetting(void *module, const char *setting,
 
 static bool g_initialized = false;
 
+// The ID of the debugger lldb.debugger was last set to. All the interpreters
+// share the lldb module, and only change it with the GIL held.
+static user_id_t g_globals_debugger_id = LLDB_INVALID_UID;
+
 namespace {
 
 // Initializing Python is not a straightforward process.  We cannot control
@@ -473,14 +477,11 @@ ScriptInterpreterPythonImpl::ScriptInterpreterPythonImpl(Debugger &debugger)
                     m_dictionary_name.c_str());
   PyRun_SimpleString(run_string.GetData());
 
-  // WARNING: temporary code that loads Cocoa formatters - this should be done
-  // on a per-platform basis rather than loading the whole set and letting the
-  // individual formatter classes exploit APIs to check whether they can/cannot
-  // do their task
+  // The lldb.formatters modules are imported by ImportFormatterModule when a
+  // formatter first needs them.
   run_string.Clear();
-  run_string.Printf(
-      "run_one_line (%s, 'import lldb.formatters, lldb.formatters.cpp, pydoc')",
-      m_dictionary_name.c_str());
+  run_string.Printf("run_one_line (%s, 'import pydoc')",
+                    m_dictionary_name.c_str());
   PyRun_SimpleString(run_string.GetData());
   run_string.Clear();
 
@@ -495,6 +496,7 @@ ScriptInterpreterPythonImpl::ScriptInterpreterPythonImpl(Debugger &debugger)
                     "; pydoc.pager = pydoc.plainpager')",
                     m_dictionary_name.c_str(), m_debugger.GetID());
   PyRun_SimpleString(run_string.GetData());
+  g_globals_debugger_id = LLDB_INVALID_UID;
 }
 
 ScriptInterpreterPythonImpl::~ScriptInterpreterPythonImpl() {
@@ -700,9 +702,11 @@ bool ScriptInterpreterPythonImpl::EnterSession(uint16_t on_entry_flags,
     run_string.PutCString("; lldb.thread = lldb.process.GetSelectedThread ()");
     run_string.PutCString("; lldb.frame = lldb.thread.GetSelectedFrame ()");
     run_string.PutCString("')");
-  } else {
+  } else if (g_globals_debugger_id != m_debugger.GetID()) {
     // If we aren't initing the globals, we should still always set the
-    // debugger (since that is always unique.)
+    // debugger (since that is always unique.) Compiling and running that
+    // costs more than many callbacks, like breakpoint callbacks that log and
+    // continue, so skip it when the debugger is already the right one.
     run_string.Printf("run_one_line (%s, 'lldb.debugger_unique_id = %" PRIu64,
                       m_dictionary_name.c_str(), m_debugger.GetID());
     run_string.Printf(
@@ -711,8 +715,11 @@ bool ScriptInterpreterPythonImpl::EnterSession(uint16_t on_entry_flags,
     run_string.PutCString("')");
   }
 
-  PyRun_SimpleString(run_string.GetData());
-  run_string.Clear();
+  if (!run_string.Empty()) {
+    PyRun_SimpleString(run_string.GetData());
+    run_string.Clear();
+    g_globals_debugger_id = m_debugger.GetID();
+  }
 
   PythonDictionary &sys_module_dict = GetSysModuleDictionary();
   if (sys_module_dict.IsValid()) {
@@ -2046,6 +2053,18 @@ StructuredData::DictionarySP ScriptInterpreterPythonImpl::GetDynamicSettings(
   return py_dict.CreateStructuredDictionary();
 }
 
+void ScriptInterpreterPythonImpl::ImportFormatterModule(llvm::StringRef name) {
+  if (!name.startswith("lldb.formatters."))
+    return;
+  llvm::StringRef module = name.rsplit('.').first;
+  if (!m_imported_formatter_modules.insert(module).second)
+    return;
+  StreamString run_string;
+  run_string.Printf("run_one_line (%s, 'import %s')", m_dictionary_name.c_str(),
+                    module.str().c_str());
+  PyRun_SimpleString(run_string.GetData());
+}
+
 StructuredData::ObjectSP
 ScriptInterpreterPythonImpl::CreateSyntheticScriptedProvider(
     const char *class_name, lldb::ValueObjectSP valobj) {
@@ -2074,6 +2093,7 @@ ScriptInterpreterPythonImpl::CreateSyntheticScriptedProvider(
   {
     Locker py_lock(this,
                    Locker::AcquireLock | Locker::InitSession | Locker::NoSTDIN);
+    python_interpreter->ImportFormatterModule(class_name);
     ret_val = LLDBSwigPythonCreateSyntheticProvider(
         class_name, python_interpreter->m_dictionary_name.c_str(), valobj);
   }
@@ -2191,6 +2211,7 @@ bool ScriptInterpreterPythonImpl::GetScriptedSummary(
     {
       Locker py_lock(this, Locker::AcquireLock | Locker::InitSession |
                                Locker::NoSTDIN);
+      ImportFormatterModule(python_function_name);
       {
         TypeSummaryOptionsSP options_sp(new TypeSummaryOptions(options));
 
@@ -2219,9 +2240,11 @@ void ScriptInterpreterPythonImpl::Clear() {
 
   // This may be called as part of Py_Finalize.  In that case the modules are
   // destroyed in random order and we can't guarantee that we can access these.
-  if (Py_IsInitialized())
+  if (Py_IsInitialized()) {
     PyRun_SimpleString("lldb.debugger = None; lldb.target = None; lldb.process "
                        "= None; lldb.thread = None; lldb.frame = None");
+    g_globals_debugger_id = LLDB_INVALID_UID;
+  }
 }
 
 bool ScriptInterpreterPythonImpl::BreakpointCallbackFunction(
@@ -22,6 +22,7 @@
 
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 
 namespace lldb_private {
 class IOHandlerPythonInterpreter;
@@ -371,6 +372,11 @@ public:
 
   bool GetEmbeddedInterpreterModuleObjects();
 
+  /// The lldb.formatters modules are only imported once a formatter needs
+  /// them. Import the module defining \a name, a dotted function or class
+  /// name, if it is one of them. The caller must hold the lock.
+  void ImportFormatterModule(llvm::StringRef name);
+
   bool SetStdHandle(File &file, const char *py_name, PythonFile &save_file,
                     const char *mode);
 
@@ -383,6 +389,7 @@ public:
   PythonObject m_run_one_line_function;
   PythonObject m_run_one_line_str_global;
   std::string m_dictionary_name;
+  llvm::StringSet<> m_imported_formatter_modules;
   ActiveIOHandler m_active_io_handler;
   bool m_session_is_active;
   bool m_pty_slave_is_open;
@@ -10,6 +10,7 @@
 #include "Plugins/ObjectFile/Breakpad/BreakpadRecords.h"
 #include "Plugins/ObjectFile/Breakpad/ObjectFileBreakpad.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Host/FileSystem.h"
@@ -20,7 +21,12 @@
 #include "lldb/Symbol/TypeMap.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/StreamString.h"
+#include "lldb/Utility/Timer.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/DJB.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/raw_ostream.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -480,17 +486,33 @@ bool SymbolFileBreakpad::ParseUnwindRow(llvm::StringRef unwind_rules,
 UnwindPlanSP
 SymbolFileBreakpad::GetUnwindPlan(const Address &address,
                                   const RegisterInfoResolver &resolver) {
+  std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
   ParseUnwindData();
-  const UnwindMap::Entry *entry =
-      m_unwind_data->FindEntryThatContains(address.GetFileAddress());
-  if (!entry)
+  uint32_t idx =
+      m_unwind_data->FindEntryIndexThatContains(address.GetFileAddress());
+  if (idx == UINT32_MAX)
     return nullptr;
 
   addr_t base = GetBaseFileAddress();
   if (base == LLDB_INVALID_ADDRESS)
     return nullptr;
 
-  LineIterator It(*m_objfile_sp, Record::StackCFI, entry->data),
+  auto pos = m_unwind_plans.find(idx);
+  if (pos != m_unwind_plans.end())
+    return pos->second;
+
+  // Failures are remembered too, the records will not parse any better the
+  // next time.
+  UnwindPlanSP &plan_sp = m_unwind_plans[idx];
+  plan_sp = ParseUnwindPlan(m_unwind_data->GetEntryRef(idx).data, base,
+                            resolver);
+  return plan_sp;
+}
+
+UnwindPlanSP
+SymbolFileBreakpad::ParseUnwindPlan(Bookmark bookmark, addr_t base,
+                                    const RegisterInfoResolver &resolver) {
+  LineIterator It(*m_objfile_sp, Record::StackCFI, bookmark),
       End(*m_objfile_sp);
   llvm::Optional<StackCFIRecord> init_record = StackCFIRecord::parse(*It);
   assert(init_record.hasValue());
@@ -557,16 +579,13 @@ void SymbolFileBreakpad::ParseFileRecords() {
 }
 
 void SymbolFileBreakpad::ParseCUData() {
-  if (m_cu_data)
-    return;
+  if (!m_cu_data)
+    ParseAddressRanges();
+}
 
+void SymbolFileBreakpad::ParseCUDataFromRecords(addr_t base) {
   m_cu_data.emplace();
   Log *log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_SYMBOLS);
-  addr_t base = GetBaseFileAddress();
-  if (base == LLDB_INVALID_ADDRESS) {
-    LLDB_LOG(log, "SymbolFile parsing failed: Unable to fetch the base address "
-                  "of object file.");
-  }
 
   // We shall create one compile unit for each FUNC record. So, count the number
   // of FUNC records, and store them in m_cu_data, together with their ranges.
@@ -631,16 +650,13 @@ void SymbolFileBreakpad::ParseLineTableAndSupportFiles(CompileUnit &cu,
 }
 
 void SymbolFileBreakpad::ParseUnwindData() {
-  if (m_unwind_data)
-    return;
+  if (!m_unwind_data)
+    ParseAddressRanges();
+}
 
+void SymbolFileBreakpad::ParseUnwindDataFromRecords(addr_t base) {
   m_unwind_data.emplace();
   Log *log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_SYMBOLS);
-  addr_t base = GetBaseFileAddress();
-  if (base == LLDB_INVALID_ADDRESS) {
-    LLDB_LOG(log, "SymbolFile parsing failed: Unable to fetch the base address "
-                  "of object file.");
-  }
 
   for (LineIterator It(*m_objfile_sp, Record::StackCFI), End(*m_objfile_sp);
        It != End; ++It) {
@@ -653,3 +669,155 @@ void SymbolFileBreakpad::ParseUnwindData() {
   }
   m_unwind_data->Sort();
 }
+
+void SymbolFileBreakpad::ParseAddressRanges() {
+  Log *log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_SYMBOLS);
+  addr_t base = GetBaseFileAddress();
+  if (base == LLDB_INVALID_ADDRESS) {
+    LLDB_LOG(log, "SymbolFile parsing failed: Unable to fetch the base address "
+                  "of object file.");
+  } else if (LoadFromCache(base)) {
+    return;
+  }
+
+  ParseCUDataFromRecords(base);
+  ParseUnwindDataFromRecords(base);
+  if (base != LLDB_INVALID_ADDRESS)
+    SaveToCache(base);
+}
+
+// Bump this whenever the layout of the cache file changes.
+static const uint32_t g_breakpad_cache_version = 1;
+static const uint32_t g_breakpad_cache_magic = 0x4c42504b; // 'LBPK'
+
+FileSpec SymbolFileBreakpad::GetCacheFile() {
+  FileSpec cache_dir =
+      ModuleList::GetGlobalModuleListProperties().GetSymtabCachePath();
+  if (!cache_dir)
+    return FileSpec();
+
+  UUID uuid = m_objfile_sp->GetUUID();
+  if (!uuid.IsValid())
+    return FileSpec();
+
+  // Several symbol files may describe the same module.
+  std::string name =
+      llvm::formatv("{0}-{1:x-8}.breakpad", uuid.GetAsString(""),
+                    llvm::djbHash(m_objfile_sp->GetFileSpec().GetPath()))
+          .str();
+  cache_dir.AppendPathComponent(name);
+  return cache_dir;
+}
+
+bool SymbolFileBreakpad::LoadFromCache(addr_t base) {
+  FileSpec cache_file = GetCacheFile();
+  if (!cache_file || !FileSystem::Instance().Exists(cache_file))
+    return false;
+
+  DataBufferSP buffer_sp = FileSystem::Instance().CreateDataBuffer(cache_file);
+  if (!buffer_sp)
+    return false;
+  DataExtractor data(buffer_sp, eByteOrderLittle, 8);
+
+  // Bookmarks are offsets into the text of the symbol file, which has to be
+  // the same one as when the cache was written.
+  const FileSpec &sym_file = m_objfile_sp->GetFileSpec();
+  lldb::offset_t offset = 0;
+  if (!data.ValidOffsetForDataOfSize(offset, 32) ||
+      data.GetU32(&offset) != g_breakpad_cache_magic ||
+      data.GetU32(&offset) != g_breakpad_cache_version ||
+      data.GetU64(&offset) !=
+          uint64_t(llvm::sys::toTimeT(
+              FileSystem::Instance().GetModificationTime(sym_file))) ||
+      data.GetU64(&offset) != FileSystem::Instance().GetByteSize(sym_file) ||
+      data.GetU64(&offset) != base)
+    return false;
+
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "%s", LLVM_PRETTY_FUNCTION);
+
+  // Each entry is a range base and size, and a bookmark.
+  const lldb::offset_t entry_size = 8 + 8 + 4 + 8;
+  auto decode = [&](auto &map, auto make_data) {
+    if (!data.ValidOffsetForDataOfSize(offset, 4))
+      return false;
+    const uint32_t count = data.GetU32(&offset);
+    if (!data.ValidOffsetForDataOfSize(offset, count * entry_size))
+      return false;
+    map.emplace();
+    for (uint32_t i = 0; i < count; ++i) {
+      addr_t range_base = data.GetU64(&offset);
+      addr_t range_size = data.GetU64(&offset);
+      Bookmark bookmark;
+      bookmark.section = data.GetU32(&offset);
+      bookmark.offset = data.GetU64(&offset);
+      map->Append({range_base, range_size, make_data(bookmark)});
+    }
+    // The tables were sorted when they were written.
+    return true;
+  };
+  if (!decode(m_cu_data, [](Bookmark b) { return CompUnitData(b); }) ||
+      !decode(m_unwind_data, [](Bookmark b) { return b; })) {
+    Log *log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_SYMBOLS);
+    LLDB_LOG(log, "ignoring corrupt breakpad cache file {0}", cache_file);
+    m_cu_data.reset();
+    m_unwind_data.reset();
+    return false;
+  }
+  return true;
+}
+
+void SymbolFileBreakpad::SaveToCache(addr_t base) {
+  FileSpec cache_file = GetCacheFile();
+  if (!cache_file)
+    return;
+
+  Log *log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_SYMBOLS);
+  const FileSpec &sym_file = m_objfile_sp->GetFileSpec();
+  StreamString strm(Stream::eBinary, 8, eByteOrderLittle);
+  strm.PutHex32(g_breakpad_cache_magic);
+  strm.PutHex32(g_breakpad_cache_version);
+  strm.PutHex64(llvm::sys::toTimeT(
+      FileSystem::Instance().GetModificationTime(sym_file)));
+  strm.PutHex64(FileSystem::Instance().GetByteSize(sym_file));
+  strm.PutHex64(base);
+  auto encode = [&](const auto &map, auto get_bookmark) {
+    strm.PutHex32(map->GetSize());
+    for (size_t i = 0, size = map->GetSize(); i < size; ++i) {
+      const auto &entry = map->GetEntryRef(i);
+      Bookmark bookmark = get_bookmark(entry.data);
+      strm.PutHex64(entry.GetRangeBase());
+      strm.PutHex64(entry.GetByteSize());
+      strm.PutHex32(bookmark.section);
+      strm.PutHex64(bookmark.offset);
+    }
+  };
+  encode(m_cu_data, [](const CompUnitData &d) { return d.bookmark; });
+  encode(m_unwind_data, [](const Bookmark &b) { return b; });
+
+  // Write to a temporary file first and rename it into place, so concurrent
+  // debugger instances never observe a partially written file.
+  std::string cache_dir = cache_file.GetDirectory().GetStringRef().str();
+  if (std::error_code ec = llvm::sys::fs::create_directories(cache_dir)) {
+    LLDB_LOG(log, "failed to create breakpad cache directory {0}: {1}",
+             cache_dir, ec.message());
+    return;
+  }
+  int fd;
+  llvm::SmallString<128> tmp_path;
+  if (std::error_code ec = llvm::sys::fs::createUniqueFile(
+          cache_file.GetPath() + "-%%%%%%", fd, tmp_path)) {
+    LLDB_LOG(log, "failed to create breakpad cache file: {0}", ec.message());
+    return;
+  }
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os << strm.GetString();
+  }
+  if (std::error_code ec =
+          llvm::sys::fs::rename(tmp_path, cache_file.GetPath())) {
+    LLDB_LOG(log, "failed to write breakpad cache file {0}: {1}", cache_file,
+             ec.message());
+    llvm::sys::fs::remove(tmp_path);
+  }
+}
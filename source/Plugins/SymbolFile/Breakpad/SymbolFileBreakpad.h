@@ -204,6 +204,18 @@ private:
   void ParseCUData();
   void ParseLineTableAndSupportFiles(CompileUnit &cu, CompUnitData &data);
   void ParseUnwindData();
+
+  // Fill in m_cu_data and m_unwind_data. Scanning the FUNC and STACK CFI
+  // records of a large symbol file is slow, so the resulting tables are
+  // cached in the symbol table cache directory when it is set.
+  void ParseAddressRanges();
+  void ParseCUDataFromRecords(lldb::addr_t base);
+  void ParseUnwindDataFromRecords(lldb::addr_t base);
+  FileSpec GetCacheFile();
+  bool LoadFromCache(lldb::addr_t base);
+  void SaveToCache(lldb::addr_t base);
+  lldb::UnwindPlanSP ParseUnwindPlan(Bookmark bookmark, lldb::addr_t base,
+                                     const RegisterInfoResolver &resolver);
   bool ParseUnwindRow(llvm::StringRef unwind_rules,
                       const RegisterInfoResolver &resolver,
                       UnwindPlan::Row &row);
@@ -215,6 +227,9 @@ private:
 
   using UnwindMap = RangeDataVector<lldb::addr_t, lldb::addr_t, Bookmark>;
   llvm::Optional<UnwindMap> m_unwind_data;
+  // Unwind plans built so far, by their index in m_unwind_data. All threads
+  // of a module share its architecture, and so the register resolver.
+  llvm::DenseMap<uint32_t, lldb::UnwindPlanSP> m_unwind_plans;
   llvm::BumpPtrAllocator m_allocator;
 };
 
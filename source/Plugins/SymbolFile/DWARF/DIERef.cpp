@@ -7,6 +7,8 @@
 //===----------------------------------------------------------------------===//
 
 #include "DIERef.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/Stream.h"
 #include "llvm/Support/Format.h"
 
 void llvm::format_provider<DIERef>::format(const DIERef &ref, raw_ostream &OS,
@@ -16,3 +18,24 @@ void llvm::format_provider<DIERef>::format(const DIERef &ref, raw_ostream &OS,
   OS << (ref.section() == DIERef::DebugInfo ? "INFO" : "TYPE");
   OS << "/" << format_hex_no_prefix(ref.die_offset(), 8);
 }
+
+void DIERef::Encode(lldb_private::Stream &s) const {
+  const uint32_t dwo_word = uint32_t(m_dwo_num) |
+                            (uint32_t(m_dwo_num_valid) << 30) |
+                            (uint32_t(m_section) << 31);
+  s.PutHex32(dwo_word);
+  s.PutHex32(m_die_offset);
+}
+
+llvm::Optional<DIERef> DIERef::Decode(const lldb_private::DataExtractor &data,
+                                      lldb::offset_t *offset_ptr) {
+  if (!data.ValidOffsetForDataOfSize(*offset_ptr, 8))
+    return llvm::None;
+  const uint32_t dwo_word = data.GetU32(offset_ptr);
+  const dw_offset_t die_offset = data.GetU32(offset_ptr);
+  llvm::Optional<uint32_t> dwo_num;
+  if (dwo_word & (1u << 30))
+    dwo_num = dwo_word & ((1u << 30) - 1);
+  Section section = (dwo_word & (1u << 31)) ? DebugTypes : DebugInfo;
+  return DIERef(dwo_num, section, die_offset);
+}
@@ -10,11 +10,17 @@
 #define SymbolFileDWARF_DIERef_h_
 
 #include "lldb/Core/dwarf.h"
+#include "lldb/lldb-types.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/Support/FormatProviders.h"
 #include <cassert>
 #include <vector>
 
+namespace lldb_private {
+class DataExtractor;
+class Stream;
+} // namespace lldb_private
+
 /// Identifies a DWARF debug info entry within a given Module. It contains three
 /// "coordinates":
 /// - dwo_num: identifies the dwo file in the Module. If this field is not set,
@@ -44,6 +50,13 @@ public:
 
   dw_offset_t die_offset() const { return m_die_offset; }
 
+  /// Write this DIERef to the binary stream \a s using a fixed 8 byte layout.
+  void Encode(lldb_private::Stream &s) const;
+
+  /// Read a DIERef written by Encode() from \a data at \a *offset_ptr.
+  static llvm::Optional<DIERef> Decode(const lldb_private::DataExtractor &data,
+                                       lldb::offset_t *offset_ptr);
+
 private:
   uint32_t m_dwo_num : 30;
   uint32_t m_dwo_num_valid : 1;
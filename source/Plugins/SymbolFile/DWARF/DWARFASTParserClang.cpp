@@ -40,7 +40,9 @@
 #include "clang/AST/DeclCXX.h"
 #include "clang/AST/DeclObjC.h"
 #include "clang/AST/DeclTemplate.h"
+#include "llvm/ADT/StringSet.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <vector>
@@ -1332,7 +1334,12 @@ TypeSP DWARFASTParserClang::ParseTypeFromDWARF(const SymbolContext &sc,
               CompilerType class_opaque_type =
                   class_type->GetForwardCompilerType();
               if (ClangASTContext::IsCXXClassType(class_opaque_type)) {
-                if (class_opaque_type.IsBeingDefined() || alternate_defn) {
+                // Methods that were deferred when the class was completed
+                // are added when they are first needed.
+                const bool is_deferred_method =
+                    m_deferred_method_dies.erase(die.GetDIE()) != 0;
+                if (class_opaque_type.IsBeingDefined() || alternate_defn ||
+                    is_deferred_method) {
                   if (!is_static && !die.HasChildren()) {
                     // We have a C++ member function with no children (this
                     // pointer!) and clang will get mad if we try and make
@@ -1947,6 +1954,7 @@ bool DWARFASTParserClang::CompleteTypeFromDWARF(const DWARFDIE &die,
   case DW_TAG_union_type:
   case DW_TAG_class_type: {
     ClangASTImporter::LayoutInfo layout_info;
+    std::vector<DWARFDIE> deferred_method_dies;
 
     {
       if (die.HasChildren()) {
@@ -1983,6 +1991,11 @@ bool DWARFASTParserClang::CompleteTypeFromDWARF(const DWARFDIE &die,
                           delayed_properties, default_accessibility, is_a_class,
                           layout_info);
 
+        if (class_language != eLanguageTypeObjC &&
+            SymbolFileDWARF::GetLazyMethodCompletion() &&
+            m_ast.GetAsCXXRecordDecl(clang_type.GetOpaqueQualType()))
+          DeferMethods(die, member_function_dies, deferred_method_dies);
+
         // Now parse any methods if there were any...
         for (const DWARFDIE &die : member_function_dies)
           dwarf->ResolveType(die);
@@ -2084,6 +2097,17 @@ bool DWARFASTParserClang::CompleteTypeFromDWARF(const DWARFDIE &die,
     ClangASTContext::BuildIndirectFields(clang_type);
     ClangASTContext::CompleteTagDeclarationDefinition(clang_type);
 
+    if (!deferred_method_dies.empty()) {
+      // Have clang ask for the deferred methods when it looks up a name in
+      // the class.
+      clang::CXXRecordDecl *record_decl =
+          m_ast.GetAsCXXRecordDecl(clang_type.GetOpaqueQualType());
+      for (const DWARFDIE &method_die : deferred_method_dies)
+        m_deferred_method_dies.insert(method_die.GetDIE());
+      m_deferred_methods[record_decl] = std::move(deferred_method_dies);
+      record_decl->setHasExternalVisibleStorage(true);
+    }
+
     if (!layout_info.field_offsets.empty() ||
         !layout_info.base_offsets.empty() ||
         !layout_info.vbase_offsets.empty()) {
@@ -2186,6 +2210,111 @@ bool DWARFASTParserClang::CompleteTypeFromDWARF(const DWARFDIE &die,
   return false;
 }
 
+// Deferring a method leaves it out of its class until it is looked up by
+// name. Methods that change how clang treats the class itself are never
+// deferred: constructors, destructors and operators decide which special
+// members the class has and whether it is trivial, and virtual methods make
+// it dynamic. Methods with template parameters aren't added to the class as
+// methods, so they are left alone too.
+static bool CanDeferMethod(const DWARFDIE &die, llvm::StringRef class_name) {
+  llvm::StringRef name(die.GetName());
+  if (name.empty() || name.startswith("~") || name.startswith("operator") ||
+      name == class_name)
+    return false;
+  if (die.GetAttributeValueAsUnsigned(DW_AT_virtuality, DW_VIRTUALITY_none) !=
+          DW_VIRTUALITY_none ||
+      die.GetAttributeValueAsUnsigned(DW_AT_artificial, 0))
+    return false;
+  for (DWARFDIE child = die.GetFirstChild(); child;
+       child = child.GetSibling()) {
+    switch (child.Tag()) {
+    case DW_TAG_template_type_parameter:
+    case DW_TAG_template_value_parameter:
+    case DW_TAG_GNU_template_parameter_pack:
+      return false;
+    default:
+      break;
+    }
+  }
+  return true;
+}
+
+void DWARFASTParserClang::DeferMethods(
+    const DWARFDIE &class_die, std::vector<DWARFDIE> &member_function_dies,
+    std::vector<DWARFDIE> &deferred_method_dies) {
+  // Constructors are named after the class without its template arguments.
+  llvm::StringRef class_name =
+      llvm::StringRef(class_die.GetName()).split('<').first;
+
+  // A lookup only asks for deferred methods if the class has no decl with
+  // that name, so overloads of a method that can't be deferred stay with it.
+  std::vector<bool> can_defer;
+  llvm::StringSet<> eager_names;
+  for (const DWARFDIE &method_die : member_function_dies) {
+    can_defer.push_back(CanDeferMethod(method_die, class_name));
+    if (!can_defer.back())
+      eager_names.insert(llvm::StringRef(method_die.GetName()));
+  }
+
+  std::vector<DWARFDIE> eager_method_dies;
+  for (size_t i = 0; i < member_function_dies.size(); ++i) {
+    const DWARFDIE &method_die = member_function_dies[i];
+    if (can_defer[i] &&
+        !eager_names.count(llvm::StringRef(method_die.GetName())))
+      deferred_method_dies.push_back(method_die);
+    else
+      eager_method_dies.push_back(method_die);
+  }
+  member_function_dies.swap(eager_method_dies);
+}
+
+void DWARFASTParserClang::CompleteDeferredMethods(
+    const clang::CXXRecordDecl *record_decl, clang::DeclarationName name,
+    llvm::SmallVectorImpl<clang::NamedDecl *> *results) {
+  auto pos = m_deferred_methods.find(record_decl);
+  if (pos == m_deferred_methods.end())
+    return;
+
+  SymbolFileDWARF *dwarf = pos->second.front().GetDWARF();
+  std::lock_guard<std::recursive_mutex> guard(
+      dwarf->GetObjectFile()->GetModule()->GetMutex());
+  pos = m_deferred_methods.find(record_decl);
+  if (pos == m_deferred_methods.end())
+    return;
+
+  // Take the methods out of the map first, since parsing them can complete
+  // and defer the methods of other classes.
+  std::vector<DWARFDIE> method_dies;
+  std::vector<DWARFDIE> &deferred = pos->second;
+  if (name.isEmpty()) {
+    method_dies.swap(deferred);
+  } else {
+    if (!name.isIdentifier())
+      return;
+    llvm::StringRef name_str = name.getAsIdentifierInfo()->getName();
+    auto matches_begin = std::stable_partition(
+        deferred.begin(), deferred.end(), [&](const DWARFDIE &method_die) {
+          return name_str != llvm::StringRef(method_die.GetName());
+        });
+    method_dies.assign(matches_begin, deferred.end());
+    deferred.erase(matches_begin, deferred.end());
+  }
+  if (deferred.empty()) {
+    m_deferred_methods.erase(pos);
+    const_cast<clang::CXXRecordDecl *>(record_decl)
+        ->setHasExternalVisibleStorage(false);
+  }
+
+  for (const DWARFDIE &method_die : method_dies) {
+    dwarf->ResolveType(method_die);
+    if (!results)
+      continue;
+    if (auto *method_decl = llvm::dyn_cast_or_null<clang::CXXMethodDecl>(
+            GetCachedClangDeclContextForDIE(method_die)))
+      results->push_back(method_decl);
+  }
+}
+
 std::vector<DWARFDIE> DWARFASTParserClang::GetDIEForDeclContext(
     lldb_private::CompilerDeclContext decl_context) {
   std::vector<DWARFDIE> result;
@@ -3625,7 +3754,10 @@ bool DWARFASTParserClang::CopyUniqueClassMethodTypes(
   // We need to complete the class type so we can get all of the method types
   // parsed so we can then unique those types to their equivalent counterparts
   // in "dst_cu" and "dst_class_die"
-  class_type->GetFullCompilerType();
+  CompilerType class_compiler_type = class_type->GetFullCompilerType();
+  CompleteDeferredMethods(
+      m_ast.GetAsCXXRecordDecl(class_compiler_type.GetOpaqueQualType()),
+      clang::DeclarationName(), nullptr);
 
   DWARFDIE src_die;
   DWARFDIE dst_die;
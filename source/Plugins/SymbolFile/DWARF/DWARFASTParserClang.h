@@ -11,6 +11,7 @@
 
 #include "clang/AST/CharUnits.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 
@@ -62,6 +63,14 @@ public:
 
   lldb_private::ClangASTImporter &GetClangASTImporter();
 
+  /// Add the methods of \a record_decl called \a name, or all of them if
+  /// \a name is empty, that were left out when the class was completed. The
+  /// methods that are added are appended to \a results if it isn't null.
+  void
+  CompleteDeferredMethods(const clang::CXXRecordDecl *record_decl,
+                          clang::DeclarationName name,
+                          llvm::SmallVectorImpl<clang::NamedDecl *> *results);
+
 protected:
   class DelayedAddObjCClassProperty;
   typedef std::vector<DelayedAddObjCClassProperty> DelayedPropertyList;
@@ -112,6 +121,12 @@ protected:
   clang::DeclContext *GetClangDeclContextContainingDIE(const DWARFDIE &die,
                                                        DWARFDIE *decl_ctx_die);
 
+  /// Move the methods in \a member_function_dies that the class described by
+  /// \a class_die can be completed without to \a deferred_method_dies.
+  void DeferMethods(const DWARFDIE &class_die,
+                    std::vector<DWARFDIE> &member_function_dies,
+                    std::vector<DWARFDIE> &deferred_method_dies);
+
   bool CopyUniqueClassMethodTypes(const DWARFDIE &src_class_die,
                                   const DWARFDIE &dst_class_die,
                                   lldb_private::Type *class_type,
@@ -139,12 +154,19 @@ protected:
   typedef llvm::DenseMap<const DWARFDebugInfoEntry *, clang::Decl *>
       DIEToDeclMap;
   typedef llvm::DenseMap<const clang::Decl *, DIEPointerSet> DeclToDIEMap;
+  typedef llvm::DenseMap<const clang::CXXRecordDecl *, std::vector<DWARFDIE>>
+      RecordDeclToDeferredMethodsMap;
 
   lldb_private::ClangASTContext &m_ast;
   DIEToDeclMap m_die_to_decl;
   DeclToDIEMap m_decl_to_die;
   DIEToDeclContextMap m_die_to_decl_ctx;
   DeclContextToDIEMap m_decl_ctx_to_die;
+  // Methods left out of complete classes until they are looked up, and the
+  // same DIEs as a set, which ParseTypeFromDWARF may add to their class
+  // after it is complete.
+  RecordDeclToDeferredMethodsMap m_deferred_methods;
+  llvm::DenseSet<const DWARFDebugInfoEntry *> m_deferred_method_dies;
   std::unique_ptr<lldb_private::ClangASTImporter> m_clang_ast_importer_up;
 };
 
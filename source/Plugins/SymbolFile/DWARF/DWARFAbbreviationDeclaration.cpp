@@ -14,6 +14,7 @@
 #include "llvm/Object/Error.h"
 
 #include "DWARFFormValue.h"
+#include "DWARFUnit.h"
 
 using namespace lldb_private;
 
@@ -47,8 +48,10 @@ DWARFAbbreviationDeclaration::extract(const DWARFDataExtractor &data,
     // This is the last attribute for this abbrev decl, but there may still be
     // more abbrev decls, so return MoreItems to indicate to the caller that
     // they should call this function again.
-    if (!attr && !form)
+    if (!attr && !form) {
+      ComputeAttributeLayout();
       return DWARFEnumState::MoreItems;
+    }
 
     if (!attr || !form)
       return llvm::make_error<llvm::object::GenericBinaryError>(
@@ -67,6 +70,110 @@ DWARFAbbreviationDeclaration::extract(const DWARFDataExtractor &data,
       "entry");
 }
 
+void DWARFAbbreviationDeclaration::ComputeAttributeLayout() {
+  m_skip_runs.clear();
+  m_attribute_offsets.clear();
+  m_index_attributes.clear();
+  m_has_address = false;
+  m_has_location_or_const_value = false;
+  SkipRun run;
+  for (uint32_t idx = 0; idx < m_attributes.size(); ++idx) {
+    switch (m_attributes[idx].get_attr()) {
+    case DW_AT_name:
+    case DW_AT_linkage_name:
+    case DW_AT_MIPS_linkage_name:
+    case DW_AT_declaration:
+    case DW_AT_specification:
+    case DW_AT_abstract_origin:
+      m_index_attributes.push_back(idx);
+      break;
+    case DW_AT_low_pc:
+    case DW_AT_high_pc:
+    case DW_AT_ranges:
+    case DW_AT_entry_pc:
+      m_has_address = true;
+      break;
+    case DW_AT_location:
+    case DW_AT_const_value:
+      m_has_location_or_const_value = true;
+      break;
+    default:
+      break;
+    }
+
+    AttributeOffset attr_offset;
+    attr_offset.run = m_skip_runs.size();
+    attr_offset.num_bytes = run.num_bytes;
+    attr_offset.num_addrs = run.num_addrs;
+    attr_offset.num_ref_addrs = run.num_ref_addrs;
+    m_attribute_offsets.push_back(attr_offset);
+
+    const dw_form_t form = m_attributes[idx].get_form();
+    switch (form) {
+    case DW_FORM_addr:
+      ++run.num_addrs;
+      continue;
+    case DW_FORM_ref_addr:
+      ++run.num_ref_addrs;
+      continue;
+    case DW_FORM_implicit_const:
+      continue;
+    case DW_FORM_addrx1:
+    case DW_FORM_strx1:
+      run.num_bytes += 1;
+      continue;
+    case DW_FORM_addrx2:
+    case DW_FORM_strx2:
+      run.num_bytes += 2;
+      continue;
+    case DW_FORM_addrx3:
+    case DW_FORM_strx3:
+      run.num_bytes += 3;
+      continue;
+    case DW_FORM_addrx4:
+    case DW_FORM_strx4:
+      run.num_bytes += 4;
+      continue;
+    default:
+      break;
+    }
+    if (llvm::Optional<uint8_t> size =
+            DWARFFormValue::GetFixedSize(form, nullptr)) {
+      run.num_bytes += *size;
+      continue;
+    }
+    run.variable_form = form;
+    m_skip_runs.push_back(run);
+    run = SkipRun();
+  }
+  if (run.num_bytes || run.num_addrs || run.num_ref_addrs)
+    m_skip_runs.push_back(run);
+}
+
+bool DWARFAbbreviationDeclaration::SkipToAttribute(
+    uint32_t idx, const DWARFDataExtractor &data, lldb::offset_t *offset_ptr,
+    const DWARFUnit *cu) const {
+  if (idx >= m_attribute_offsets.size())
+    return false;
+  const uint8_t addr_size = cu->GetAddressByteSize();
+  const uint8_t ref_addr_size = cu->GetVersion() <= 2 ? addr_size : 4;
+  const AttributeOffset &attr_offset = m_attribute_offsets[idx];
+  lldb::offset_t offset = *offset_ptr;
+  // Every run before the one the attribute is in ends with a variable size
+  // attribute.
+  for (uint32_t i = 0; i < attr_offset.run; ++i) {
+    const SkipRun &run = m_skip_runs[i];
+    offset += run.num_bytes + run.num_addrs * addr_size +
+              run.num_ref_addrs * ref_addr_size;
+    if (!DWARFFormValue::SkipValue(run.variable_form, data, &offset, cu))
+      return false;
+  }
+  offset += attr_offset.num_bytes + attr_offset.num_addrs * addr_size +
+            attr_offset.num_ref_addrs * ref_addr_size;
+  *offset_ptr = offset;
+  return true;
+}
+
 bool DWARFAbbreviationDeclaration::IsValid() {
   return m_code != 0 && m_tag != 0;
 }
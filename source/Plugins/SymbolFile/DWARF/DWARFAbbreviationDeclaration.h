@@ -17,6 +17,32 @@
 class DWARFAbbreviationDeclaration {
 public:
   enum { InvalidCode = 0 };
+
+  /// DIEs are skipped over a run of attributes at a time. Each run covers
+  /// attributes whose sizes follow from their forms and the unit alone, then
+  /// at most one attribute whose size must be read from the data.
+  struct SkipRun {
+    /// The size of the attributes whose size only depends on their form.
+    uint32_t num_bytes = 0;
+    /// The number of DW_FORM_addr attributes.
+    uint16_t num_addrs = 0;
+    /// The number of DW_FORM_ref_addr attributes.
+    uint16_t num_ref_addrs = 0;
+    /// The form of the attribute ending the run, or 0 if the run ends the
+    /// DIE.
+    dw_form_t variable_form = 0;
+  };
+
+  /// Where an attribute starts relative to the first attribute of a DIE:
+  /// after the first \a run skip runs, and then the fixed size attributes of
+  /// the next run that come before it.
+  struct AttributeOffset {
+    uint32_t run = 0;
+    uint32_t num_bytes = 0;
+    uint16_t num_addrs = 0;
+    uint16_t num_ref_addrs = 0;
+  };
+
   DWARFAbbreviationDeclaration();
 
   // For hand crafting an abbreviation declaration
@@ -41,6 +67,29 @@ public:
   }
   uint32_t FindAttributeIndex(dw_attr_t attr) const;
 
+  llvm::ArrayRef<SkipRun> GetSkipRuns() const { return m_skip_runs; }
+
+  /// Advance \a offset_ptr from the first attribute of a DIE using this
+  /// abbreviation to the attribute at \a idx, skipping only the variable size
+  /// attributes one at a time. Returns false if the data is malformed.
+  bool SkipToAttribute(uint32_t idx,
+                       const lldb_private::DWARFDataExtractor &data,
+                       lldb::offset_t *offset_ptr, const DWARFUnit *cu) const;
+
+  /// The indexes of the attributes the manual index decodes in every DIE, in
+  /// order: the names, DW_AT_declaration, and the DW_AT_specification and
+  /// DW_AT_abstract_origin references to the DIEs that may carry the names.
+  llvm::ArrayRef<uint32_t> GetIndexAttributeIndexes() const {
+    return m_index_attributes;
+  }
+  /// Whether the DIEs have a DW_AT_low_pc, DW_AT_high_pc, DW_AT_ranges or
+  /// DW_AT_entry_pc.
+  bool HasAddressAttributes() const { return m_has_address; }
+  /// Whether the DIEs have a DW_AT_location or DW_AT_const_value.
+  bool HasLocationOrConstValue() const {
+    return m_has_location_or_const_value;
+  }
+
   /// Extract one abbreviation declaration and all of its associated attributes.
   /// Possible return values:
   ///   DWARFEnumState::Complete - the extraction completed successfully.  This
@@ -60,6 +109,13 @@ protected:
   dw_tag_t m_tag;
   uint8_t m_has_children;
   DWARFAttribute::collection m_attributes;
+  std::vector<SkipRun> m_skip_runs;
+  std::vector<AttributeOffset> m_attribute_offsets;
+  std::vector<uint32_t> m_index_attributes;
+  bool m_has_address = false;
+  bool m_has_location_or_const_value = false;
+
+  void ComputeAttributeLayout();
 };
 
 #endif // liblldb_DWARFAbbreviationDeclaration_h_
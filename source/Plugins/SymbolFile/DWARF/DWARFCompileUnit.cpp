@@ -25,44 +25,53 @@ void DWARFCompileUnit::Dump(Stream *s) const {
             GetAddressByteSize(), GetNextUnitOffset());
 }
 
+bool DWARFCompileUnit::BuildAddressRangeTableFromUnitDIE(
+    DWARFDebugAranges *debug_aranges) {
+  // Get the compile unit DIE only and check if it has a DW_AT_ranges or a
+  // DW_AT_low_pc/DW_AT_high_pc pair.
+  const DWARFDebugInfoEntry *die = GetUnitDIEPtrOnly();
+  if (!die)
+    return false;
+
+  DWARFRangeList ranges;
+  const size_t num_ranges =
+      die->GetAttributeAddressRanges(this, ranges, /*check_hi_lo_pc=*/true);
+  if (num_ranges == 0)
+    return false;
+
+  // This compile unit has address ranges, assume they are correct if they
+  // are present since clang no longer makes .debug_aranges by default and it
+  // emits DW_AT_ranges for DW_TAG_compile_units. GCC also does this with
+  // recent GCC builds.
+  const dw_offset_t cu_offset = GetOffset();
+  for (size_t i = 0; i < num_ranges; ++i) {
+    const DWARFRangeList::Entry &range = ranges.GetEntryRef(i);
+    debug_aranges->AppendRange(cu_offset, range.GetRangeBase(),
+                               range.GetRangeEnd());
+  }
+  return true;
+}
+
 void DWARFCompileUnit::BuildAddressRangeTable(
     DWARFDebugAranges *debug_aranges) {
   // This function is usually called if there in no .debug_aranges section in
   // order to produce a compile unit level set of address ranges that is
   // accurate.
 
-  size_t num_debug_aranges = debug_aranges->GetNumRanges();
-
-  // First get the compile unit DIE only and check if it has a DW_AT_ranges
-  const DWARFDebugInfoEntry *die = GetUnitDIEPtrOnly();
+  if (BuildAddressRangeTableFromUnitDIE(debug_aranges))
+    return; // We got all of our ranges from the unit DIE
 
+  size_t num_debug_aranges = debug_aranges->GetNumRanges();
   const dw_offset_t cu_offset = GetOffset();
-  if (die) {
-    DWARFRangeList ranges;
-    const size_t num_ranges =
-        die->GetAttributeAddressRanges(this, ranges, false);
-    if (num_ranges > 0) {
-      // This compile unit has DW_AT_ranges, assume this is correct if it is
-      // present since clang no longer makes .debug_aranges by default and it
-      // emits DW_AT_ranges for DW_TAG_compile_units. GCC also does this with
-      // recent GCC builds.
-      for (size_t i = 0; i < num_ranges; ++i) {
-        const DWARFRangeList::Entry &range = ranges.GetEntryRef(i);
-        debug_aranges->AppendRange(cu_offset, range.GetRangeBase(),
-                                   range.GetRangeEnd());
-      }
 
-      return; // We got all of our ranges from the DW_AT_ranges attribute
-    }
-  }
-  // We don't have a DW_AT_ranges attribute, so we need to parse the DWARF
+  // The unit DIE has no address ranges, so we need to parse the DWARF
 
   // If the DIEs weren't parsed, then we don't want all dies for all compile
   // units to stay loaded when they weren't needed. So we can end up parsing
   // the DWARF and then throwing them all away to keep memory usage down.
   ScopedExtractDIEs clear_dies(ExtractDIEsScoped());
 
-  die = DIEPtr();
+  const DWARFDebugInfoEntry *die = DIEPtr();
   if (die)
     die->BuildAddressRangeTable(this, debug_aranges);
 
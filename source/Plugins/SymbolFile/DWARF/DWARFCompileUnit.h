@@ -15,6 +15,8 @@
 class DWARFCompileUnit : public DWARFUnit {
 public:
   void BuildAddressRangeTable(DWARFDebugAranges *debug_aranges) override;
+  bool BuildAddressRangeTableFromUnitDIE(
+      DWARFDebugAranges *debug_aranges) override;
 
   void Dump(lldb_private::Stream *s) const override;
 
@@ -9,7 +9,9 @@
 #include "DWARFDebugAranges.h"
 #include "DWARFDebugArangeSet.h"
 #include "DWARFUnit.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Log.h"
+#include "lldb/Utility/Stream.h"
 #include "lldb/Utility/Timer.h"
 
 using namespace lldb;
@@ -39,7 +41,7 @@ DWARFDebugAranges::extract(const DWARFDataExtractor &debug_aranges_data) {
   Range range;
   while (debug_aranges_data.ValidOffset(offset)) {
     llvm::Error error = set.extract(debug_aranges_data, &offset);
-    if (!error)
+    if (error)
       return error;
 
     const uint32_t num_descriptors = set.NumDescriptors();
@@ -71,6 +73,35 @@ void DWARFDebugAranges::Dump(Log *log) const {
   }
 }
 
+void DWARFDebugAranges::Encode(Stream &s) const {
+  const size_t num_entries = m_aranges.GetSize();
+  s.PutHex32(num_entries);
+  for (size_t i = 0; i < num_entries; ++i) {
+    const RangeToDIE::Entry *entry = m_aranges.GetEntryAtIndex(i);
+    s.PutHex64(entry->GetRangeBase());
+    s.PutHex32(entry->GetByteSize());
+    s.PutHex32(entry->data);
+  }
+}
+
+bool DWARFDebugAranges::Decode(const DataExtractor &data,
+                               lldb::offset_t *offset_ptr) {
+  Clear();
+  if (!data.ValidOffsetForDataOfSize(*offset_ptr, 4))
+    return false;
+  const uint32_t num_entries = data.GetU32(offset_ptr);
+  if (!data.ValidOffsetForDataOfSize(*offset_ptr, num_entries * 16ull))
+    return false;
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    const dw_addr_t base = data.GetU64(offset_ptr);
+    const uint32_t size = data.GetU32(offset_ptr);
+    const dw_offset_t cu_offset = data.GetU32(offset_ptr);
+    m_aranges.Append(RangeToDIE::Entry(base, size, cu_offset));
+  }
+  m_aranges.Sort();
+  return true;
+}
+
 void DWARFDebugAranges::AppendRange(dw_offset_t offset, dw_addr_t low_pc,
                                     dw_addr_t high_pc) {
   if (high_pc > low_pc)
@@ -36,6 +36,14 @@ public:
 
   void Dump(lldb_private::Log *log) const;
 
+  /// Write the ranges to the binary stream \a s.
+  void Encode(lldb_private::Stream &s) const;
+
+  /// Replace the ranges with the ones written by Encode(). The result is
+  /// sorted and can be searched right away.
+  bool Decode(const lldb_private::DataExtractor &data,
+              lldb::offset_t *offset_ptr);
+
   dw_offset_t FindAddress(dw_addr_t address) const;
 
   bool IsEmpty() const { return m_aranges.IsEmpty(); }
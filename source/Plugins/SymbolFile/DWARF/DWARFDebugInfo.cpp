@@ -11,11 +11,17 @@
 #include <algorithm>
 #include <set>
 
+#include "lldb/Core/Module.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Host/PosixApi.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Utility/DataBufferLLVM.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
+#include "lldb/Utility/StreamString.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/Chrono.h"
 
 #include "DWARFCompileUnit.h"
 #include "DWARFContext.h"
@@ -24,6 +30,7 @@
 #include "DWARFDebugInfoEntry.h"
 #include "DWARFFormValue.h"
 #include "DWARFTypeUnit.h"
+#include "LogChannelDWARF.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -35,14 +42,36 @@ DWARFDebugInfo::DWARFDebugInfo(SymbolFileDWARF &dwarf,
     : m_dwarf(dwarf), m_context(context), m_units(), m_cu_aranges_up() {}
 
 llvm::Expected<DWARFDebugAranges &> DWARFDebugInfo::GetCompileUnitAranges() {
+  if (llvm::Error error = BuildCompileUnitAranges())
+    return std::move(error);
+  BuildDeferredCompileUnitAranges();
+  return *m_cu_aranges_up;
+}
+
+llvm::Expected<dw_offset_t>
+DWARFDebugInfo::FindCompileUnitOffset(dw_addr_t address) {
+  if (llvm::Error error = BuildCompileUnitAranges())
+    return std::move(error);
+  dw_offset_t cu_offset = m_cu_aranges_up->FindAddress(address);
+  if (cu_offset == DW_INVALID_OFFSET && !m_units_without_aranges.empty()) {
+    BuildDeferredCompileUnitAranges();
+    cu_offset = m_cu_aranges_up->FindAddress(address);
+  }
+  return cu_offset;
+}
+
+llvm::Error DWARFDebugInfo::BuildCompileUnitAranges() {
   if (m_cu_aranges_up)
-    return *m_cu_aranges_up;
+    return llvm::Error::success();
 
   m_cu_aranges_up = std::make_unique<DWARFDebugAranges>();
+  if (LoadCompileUnitArangesFromCache())
+    return llvm::Error::success();
+
   const DWARFDataExtractor &debug_aranges_data =
       m_context.getOrLoadArangesData();
   if (llvm::Error error = m_cu_aranges_up->extract(debug_aranges_data))
-    return std::move(error);
+    return error;
 
   // Make a list of all CUs represented by the arange data in the file.
   std::set<dw_offset_t> cus_with_data;
@@ -53,19 +82,111 @@ llvm::Expected<DWARFDebugAranges &> DWARFDebugInfo::GetCompileUnitAranges() {
   }
 
   // Manually build arange data for everything that wasn't in the
-  // .debug_aranges table.
+  // .debug_aranges table. Only the unit DIEs are parsed here, units that
+  // need all of their DIEs looked at are deferred until an address lookup
+  // fails.
   const size_t num_units = GetNumUnits();
   for (size_t idx = 0; idx < num_units; ++idx) {
     DWARFUnit *cu = GetUnitAtIndex(idx);
 
     dw_offset_t offset = cu->GetOffset();
-    if (cus_with_data.find(offset) == cus_with_data.end())
-      cu->BuildAddressRangeTable(m_cu_aranges_up.get());
+    if (cus_with_data.find(offset) == cus_with_data.end() &&
+        !cu->BuildAddressRangeTableFromUnitDIE(m_cu_aranges_up.get()))
+      m_units_without_aranges.push_back(offset);
   }
 
   const bool minimize = true;
   m_cu_aranges_up->Sort(minimize);
-  return *m_cu_aranges_up;
+  SaveCompileUnitArangesToCache();
+  return llvm::Error::success();
+}
+
+void DWARFDebugInfo::BuildDeferredCompileUnitAranges() {
+  if (m_units_without_aranges.empty())
+    return;
+
+  for (dw_offset_t offset : m_units_without_aranges)
+    if (DWARFUnit *cu = GetUnitAtOffset(DIERef::Section::DebugInfo, offset))
+      cu->BuildAddressRangeTable(m_cu_aranges_up.get());
+  m_units_without_aranges.clear();
+
+  const bool minimize = true;
+  m_cu_aranges_up->Sort(minimize);
+  SaveCompileUnitArangesToCache();
+}
+
+// Bump this whenever the layout of the cache file changes.
+static const uint32_t g_aranges_cache_version = 1;
+static const uint32_t g_aranges_cache_magic = 0x4c445741; // 'LDWA'
+
+FileSpec DWARFDebugInfo::GetArangesCacheFile() {
+  // The units of a .dwo file are looked up through the skeleton units of the
+  // main file, so only the main file has a table worth caching.
+  if (m_dwarf.GetBaseCompileUnit())
+    return FileSpec();
+  ModuleSP module_sp = m_dwarf.GetObjectFile()->GetModule();
+  if (!module_sp)
+    return FileSpec();
+  return SymbolFileDWARF::GetIndexCacheFile(*module_sp, ".dwarf-aranges");
+}
+
+bool DWARFDebugInfo::LoadCompileUnitArangesFromCache() {
+  FileSpec cache_file = GetArangesCacheFile();
+  if (!cache_file || !FileSystem::Instance().Exists(cache_file))
+    return false;
+
+  DataBufferSP buffer_sp = FileSystem::Instance().CreateDataBuffer(cache_file);
+  if (!buffer_sp)
+    return false;
+  DataExtractor data(buffer_sp, eByteOrderLittle, 8);
+
+  ModuleSP module_sp = m_dwarf.GetObjectFile()->GetModule();
+  lldb::offset_t offset = 0;
+  if (!data.ValidOffsetForDataOfSize(offset, 24) ||
+      data.GetU32(&offset) != g_aranges_cache_magic ||
+      data.GetU32(&offset) != g_aranges_cache_version ||
+      data.GetU64(&offset) !=
+          uint64_t(llvm::sys::toTimeT(module_sp->GetModificationTime())) ||
+      data.GetU64(&offset) != uint64_t(llvm::sys::toTimeT(
+                                  module_sp->GetObjectModificationTime())))
+    return false;
+
+  std::vector<dw_offset_t> units_without_aranges;
+  bool success = m_cu_aranges_up->Decode(data, &offset) &&
+                 data.ValidOffsetForDataOfSize(offset, 4);
+  if (success) {
+    const uint32_t num_units = data.GetU32(&offset);
+    success = data.ValidOffsetForDataOfSize(offset, num_units * 4ull);
+    for (uint32_t i = 0; success && i < num_units; ++i)
+      units_without_aranges.push_back(data.GetU32(&offset));
+  }
+  if (!success) {
+    Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO);
+    LLDB_LOG(log, "ignoring corrupt DWARF aranges cache file {0}",
+             cache_file);
+    m_cu_aranges_up->Clear();
+    return false;
+  }
+  m_units_without_aranges = std::move(units_without_aranges);
+  return true;
+}
+
+void DWARFDebugInfo::SaveCompileUnitArangesToCache() {
+  FileSpec cache_file = GetArangesCacheFile();
+  if (!cache_file)
+    return;
+
+  ModuleSP module_sp = m_dwarf.GetObjectFile()->GetModule();
+  StreamString data(Stream::eBinary, 8, eByteOrderLittle);
+  data.PutHex32(g_aranges_cache_magic);
+  data.PutHex32(g_aranges_cache_version);
+  data.PutHex64(llvm::sys::toTimeT(module_sp->GetModificationTime()));
+  data.PutHex64(llvm::sys::toTimeT(module_sp->GetObjectModificationTime()));
+  m_cu_aranges_up->Encode(data);
+  data.PutHex32(m_units_without_aranges.size());
+  for (dw_offset_t offset : m_units_without_aranges)
+    data.PutHex32(offset);
+  SymbolFileDWARF::WriteIndexCacheFile(cache_file, data.GetString());
 }
 
 void DWARFDebugInfo::ParseUnitsFor(DIERef::Section section) {
@@ -96,12 +217,12 @@ void DWARFDebugInfo::ParseUnitsFor(DIERef::Section section) {
 }
 
 void DWARFDebugInfo::ParseUnitHeadersIfNeeded() {
-  if (!m_units.empty())
-    return;
-
-  ParseUnitsFor(DIERef::Section::DebugInfo);
-  ParseUnitsFor(DIERef::Section::DebugTypes);
-  llvm::sort(m_type_hash_to_unit_index, llvm::less_first());
+  // Type lookups look up DIEs without holding the module mutex.
+  llvm::call_once(m_units_once, [this] {
+    ParseUnitsFor(DIERef::Section::DebugInfo);
+    ParseUnitsFor(DIERef::Section::DebugTypes);
+    llvm::sort(m_type_hash_to_unit_index, llvm::less_first());
+  });
 }
 
 size_t DWARFDebugInfo::GetNumUnits() {
@@ -19,6 +19,7 @@
 #include "lldb/Core/STLUtils.h"
 #include "lldb/lldb-private.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/Threading.h"
 
 namespace lldb_private {
 class DWARFContext;
@@ -60,16 +61,28 @@ public:
         (1 << 2) // Show all parent DIEs when dumping single DIEs
   };
 
+  /// Get the address ranges of all compile units. This scans the DIEs of
+  /// every unit whose ranges are neither in .debug_aranges nor on its unit
+  /// DIE.
   llvm::Expected<DWARFDebugAranges &> GetCompileUnitAranges();
 
+  /// Find the offset of the compile unit containing \a address, or
+  /// DW_INVALID_OFFSET if there is none. The DIEs of units whose unit DIE
+  /// doesn't describe their ranges are only scanned once an address isn't
+  /// found in any of the other units.
+  llvm::Expected<dw_offset_t> FindCompileUnitOffset(dw_addr_t address);
+
 protected:
   typedef std::vector<DWARFUnitSP> UnitColl;
 
   SymbolFileDWARF &m_dwarf;
   lldb_private::DWARFContext &m_context;
   UnitColl m_units;
+  llvm::once_flag m_units_once;
   std::unique_ptr<DWARFDebugAranges>
       m_cu_aranges_up; // A quick address to compile unit table
+  /// Offsets of the units whose ranges are not in m_cu_aranges_up yet.
+  std::vector<dw_offset_t> m_units_without_aranges;
 
   std::vector<std::pair<uint64_t, uint32_t>> m_type_hash_to_unit_index;
 
@@ -82,6 +95,17 @@ private:
 
   uint32_t FindUnitIndex(DIERef::Section section, dw_offset_t offset);
 
+  /// Build m_cu_aranges_up from .debug_aranges and the unit DIEs of the
+  /// units that aren't in it, or load it from the index cache.
+  llvm::Error BuildCompileUnitAranges();
+
+  /// Add the ranges of the units in m_units_without_aranges.
+  void BuildDeferredCompileUnitAranges();
+
+  lldb_private::FileSpec GetArangesCacheFile();
+  bool LoadCompileUnitArangesFromCache();
+  void SaveCompileUnitArangesToCache();
+
   DISALLOW_COPY_AND_ASSIGN(DWARFDebugInfo);
 };
 
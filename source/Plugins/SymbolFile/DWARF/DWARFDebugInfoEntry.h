@@ -182,4 +182,8 @@ protected:
                   // the compile unit abbrev table
 };
 
+// Units can have millions of DIEs, keep them small.
+static_assert(sizeof(DWARFDebugInfoEntry) == 16,
+              "DWARFDebugInfoEntry should be 16 bytes");
+
 #endif // SymbolFileDWARF_DWARFDebugInfoEntry_h_
@@ -12,6 +12,7 @@
 #include "Plugins/SymbolFile/DWARF/DIERef.h"
 #include "Plugins/SymbolFile/DWARF/DWARFDIE.h"
 #include "Plugins/SymbolFile/DWARF/DWARFFormValue.h"
+#include "lldb/Utility/Timer.h"
 
 class DWARFDeclContext;
 class DWARFDIE;
@@ -49,8 +50,16 @@ public:
   virtual void ReportInvalidDIERef(const DIERef &ref, llvm::StringRef name) = 0;
   virtual void Dump(Stream &s) = 0;
 
+  /// The memory held by the index, in bytes. Indexes that read the
+  /// accelerator tables of the file hold little of their own.
+  virtual size_t GetMemoryUsage() { return 0; }
+
+  /// The time spent building the index.
+  StatsDuration &GetIndexTime() { return m_index_time; }
+
 protected:
   Module &m_module;
+  StatsDuration m_index_time;
 
   /// Helper function implementing common logic for processing function dies. If
   /// the function given by "ref" matches search criteria given by
@@ -15,6 +15,10 @@
 class DWARFTypeUnit : public DWARFUnit {
 public:
   void BuildAddressRangeTable(DWARFDebugAranges *debug_aranges) override {}
+  bool BuildAddressRangeTableFromUnitDIE(
+      DWARFDebugAranges *debug_aranges) override {
+    return true;
+  }
 
   void Dump(lldb_private::Stream *s) const override;
 
@@ -140,6 +140,11 @@ DWARFUnit::ScopedExtractDIEs &DWARFUnit::ScopedExtractDIEs::operator=(
   return *this;
 }
 
+size_t DWARFUnit::GetDIEArrayByteSize() const {
+  llvm::sys::ScopedReader lock(m_die_array_mutex);
+  return m_die_array.capacity() * sizeof(DWARFDebugInfoEntry);
+}
+
 // Parses a compile unit and indexes its DIEs, m_die_array_mutex must be
 // held R/W and m_die_array must be empty.
 void DWARFUnit::ExtractDIEsRWLocked() {
@@ -402,6 +407,11 @@ size_t DWARFUnit::GetDebugInfoSize() const {
   return GetLengthByteSize() + GetLength() - GetHeaderByteSize();
 }
 
+size_t DWARFUnit::GetDIEMemoryUsage() const {
+  llvm::sys::ScopedReader lock(m_die_array_mutex);
+  return m_die_array.capacity() * sizeof(DWARFDebugInfoEntry);
+}
+
 const DWARFAbbreviationDeclarationSet *DWARFUnit::GetAbbreviations() const {
   return m_abbrevs;
 }
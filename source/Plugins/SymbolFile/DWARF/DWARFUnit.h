@@ -94,6 +94,9 @@ public:
   };
   ScopedExtractDIEs ExtractDIEsScoped();
 
+  /// The number of bytes the extracted DIEs of this unit take up.
+  size_t GetDIEArrayByteSize() const;
+
   DWARFDIE LookupAddress(const dw_addr_t address);
   size_t AppendDIEsWithTag(const dw_tag_t tag, std::vector<DWARFDIE> &dies,
                            uint32_t depth = UINT32_MAX) const;
@@ -135,6 +138,8 @@ public:
   dw_offset_t GetNextUnitOffset() const { return m_header.GetNextUnitOffset(); }
   // Size of the CU data (without initial length and without header).
   size_t GetDebugInfoSize() const;
+  // Memory held by the DIEs extracted from this unit, in bytes.
+  size_t GetDIEMemoryUsage() const;
   // Size of the CU data incl. header but without initial length.
   uint32_t GetLength() const { return m_header.GetLength(); }
   uint16_t GetVersion() const { return m_header.GetVersion(); }
@@ -150,6 +155,11 @@ public:
   void SetRangesBase(dw_addr_t ranges_base);
   void SetStrOffsetsBase(dw_offset_t str_offsets_base);
   virtual void BuildAddressRangeTable(DWARFDebugAranges *debug_aranges) = 0;
+  /// Add the address ranges described by the unit DIE alone to \a
+  /// debug_aranges. Returns false if the unit DIE has no address ranges, in
+  /// which case only BuildAddressRangeTable can find them.
+  virtual bool
+  BuildAddressRangeTableFromUnitDIE(DWARFDebugAranges *debug_aranges) = 0;
 
   lldb::ByteOrder GetByteOrder() const;
 
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "Plugins/SymbolFile/DWARF/DebugNamesDWARFIndex.h"
+#include "Plugins/Language/ObjC/ObjCLanguage.h"
 #include "Plugins/SymbolFile/DWARF/DWARFDebugInfo.h"
 #include "Plugins/SymbolFile/DWARF/DWARFDeclContext.h"
 #include "Plugins/SymbolFile/DWARF/SymbolFileDWARFDwo.h"
@@ -29,8 +30,30 @@ DebugNamesDWARFIndex::Create(Module &module, DWARFDataExtractor debug_names,
   if (llvm::Error E = index_up->extract())
     return std::move(E);
 
+  // Only the units the name indexes do not cover need to be indexed manually.
+  // If there are none, skip creating the fallback index altogether so that a
+  // complete .debug_names section is trusted as is.
+  llvm::DenseSet<dw_offset_t> units = GetUnits(*index_up);
+  size_t num_missing_units = 0;
+  for (size_t U = 0; U < debug_info->GetNumUnits(); ++U) {
+    DWARFUnit *unit = debug_info->GetUnitAtIndex(U);
+    if (unit && units.count(unit->GetOffset()) == 0)
+      ++num_missing_units;
+  }
+
+  std::unique_ptr<ManualDWARFIndex> fallback_up;
+  if (num_missing_units) {
+    LLDB_LOG(LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO),
+             "{0} of {1} units are not covered by .debug_names, indexing them "
+             "manually",
+             num_missing_units, debug_info->GetNumUnits());
+    fallback_up = std::make_unique<ManualDWARFIndex>(module, debug_info,
+                                                     std::move(units));
+  }
+
   return std::unique_ptr<DebugNamesDWARFIndex>(new DebugNamesDWARFIndex(
-      module, std::move(index_up), debug_names, debug_str, *debug_info));
+      module, std::move(index_up), debug_names, debug_str, *debug_info,
+      std::move(fallback_up)));
 }
 
 llvm::DenseSet<dw_offset_t>
@@ -85,7 +108,8 @@ void DebugNamesDWARFIndex::MaybeLogLookupError(llvm::Error error,
 
 void DebugNamesDWARFIndex::GetGlobalVariables(ConstString basename,
                                               DIEArray &offsets) {
-  m_fallback.GetGlobalVariables(basename, offsets);
+  if (m_fallback_up)
+    m_fallback_up->GetGlobalVariables(basename, offsets);
 
   for (const DebugNames::Entry &entry :
        m_debug_names_up->equal_range(basename.GetStringRef())) {
@@ -98,7 +122,8 @@ void DebugNamesDWARFIndex::GetGlobalVariables(ConstString basename,
 
 void DebugNamesDWARFIndex::GetGlobalVariables(const RegularExpression &regex,
                                               DIEArray &offsets) {
-  m_fallback.GetGlobalVariables(regex, offsets);
+  if (m_fallback_up)
+    m_fallback_up->GetGlobalVariables(regex, offsets);
 
   for (const DebugNames::NameIndex &ni: *m_debug_names_up) {
     for (DebugNames::NameTableEntry nte: ni) {
@@ -120,7 +145,8 @@ void DebugNamesDWARFIndex::GetGlobalVariables(const RegularExpression &regex,
 
 void DebugNamesDWARFIndex::GetGlobalVariables(const DWARFUnit &cu,
                                               DIEArray &offsets) {
-  m_fallback.GetGlobalVariables(cu, offsets);
+  if (m_fallback_up)
+    m_fallback_up->GetGlobalVariables(cu, offsets);
 
   uint64_t cu_offset = cu.GetOffset();
   for (const DebugNames::NameIndex &ni: *m_debug_names_up) {
@@ -140,10 +166,67 @@ void DebugNamesDWARFIndex::GetGlobalVariables(const DWARFUnit &cu,
   }
 }
 
+void DebugNamesDWARFIndex::IndexObjCMethods() {
+  for (const DebugNames::NameIndex &ni: *m_debug_names_up) {
+    for (DebugNames::NameTableEntry nte: ni) {
+      const char *name = nte.getString();
+      if (!ObjCLanguage::IsPossibleObjCMethodName(name))
+        continue;
+      ObjCLanguage::MethodName objc_method(name, true);
+      if (!objc_method.IsValid(true))
+        continue;
+
+      ConstString class_name_with_category(
+          objc_method.GetClassNameWithCategory());
+      ConstString class_name_no_category(objc_method.GetClassName());
+      ConstString objc_fullname_no_category_name(
+          objc_method.GetFullNameWithoutCategory(true));
+
+      uint64_t entry_offset = nte.getEntryOffset();
+      llvm::Expected<DebugNames::Entry> entry_or = ni.getEntry(&entry_offset);
+      for (; entry_or; entry_or = ni.getEntry(&entry_offset)) {
+        Tag tag = entry_or->tag();
+        if (tag != DW_TAG_subprogram && tag != DW_TAG_inlined_subroutine)
+          continue;
+
+        llvm::Optional<DIERef> ref = ToDIERef(*entry_or);
+        if (!ref)
+          continue;
+
+        if (class_name_with_category)
+          m_objc_class_selectors.Insert(class_name_with_category, *ref);
+        if (class_name_no_category &&
+            class_name_no_category != class_name_with_category)
+          m_objc_class_selectors.Insert(class_name_no_category, *ref);
+        // The name index already has the full name including the category.
+        if (objc_fullname_no_category_name &&
+            objc_fullname_no_category_name.GetStringRef() != name)
+          m_objc_fullnames_no_category.Insert(objc_fullname_no_category_name,
+                                              *ref);
+      }
+      MaybeLogLookupError(entry_or.takeError(), ni, nte.getString());
+    }
+  }
+
+  m_objc_class_selectors.Finalize();
+  m_objc_fullnames_no_category.Finalize();
+}
+
+void DebugNamesDWARFIndex::GetObjCMethods(ConstString class_name,
+                                          DIEArray &offsets) {
+  if (m_fallback_up)
+    m_fallback_up->GetObjCMethods(class_name, offsets);
+
+  llvm::call_once(m_objc_once, [this] { IndexObjCMethods(); });
+  m_objc_class_selectors.Find(class_name, offsets);
+}
+
 void DebugNamesDWARFIndex::GetCompleteObjCClass(ConstString class_name,
                                                 bool must_be_implementation,
                                                 DIEArray &offsets) {
-  m_fallback.GetCompleteObjCClass(class_name, must_be_implementation, offsets);
+  if (m_fallback_up)
+    m_fallback_up->GetCompleteObjCClass(class_name, must_be_implementation,
+                                        offsets);
 
   // Keep a list of incomplete types as fallback for when we don't find the
   // complete type.
@@ -184,7 +267,8 @@ void DebugNamesDWARFIndex::GetCompleteObjCClass(ConstString class_name,
 }
 
 void DebugNamesDWARFIndex::GetTypes(ConstString name, DIEArray &offsets) {
-  m_fallback.GetTypes(name, offsets);
+  if (m_fallback_up)
+    m_fallback_up->GetTypes(name, offsets);
 
   for (const DebugNames::Entry &entry :
        m_debug_names_up->equal_range(name.GetStringRef())) {
@@ -195,7 +279,8 @@ void DebugNamesDWARFIndex::GetTypes(ConstString name, DIEArray &offsets) {
 
 void DebugNamesDWARFIndex::GetTypes(const DWARFDeclContext &context,
                                     DIEArray &offsets) {
-  m_fallback.GetTypes(context, offsets);
+  if (m_fallback_up)
+    m_fallback_up->GetTypes(context, offsets);
 
   for (const DebugNames::Entry &entry :
        m_debug_names_up->equal_range(context[0].name)) {
@@ -205,7 +290,8 @@ void DebugNamesDWARFIndex::GetTypes(const DWARFDeclContext &context,
 }
 
 void DebugNamesDWARFIndex::GetNamespaces(ConstString name, DIEArray &offsets) {
-  m_fallback.GetNamespaces(name, offsets);
+  if (m_fallback_up)
+    m_fallback_up->GetNamespaces(name, offsets);
 
   for (const DebugNames::Entry &entry :
        m_debug_names_up->equal_range(name.GetStringRef())) {
@@ -220,7 +306,9 @@ void DebugNamesDWARFIndex::GetFunctions(
     std::vector<DWARFDIE> &dies) {
 
   std::vector<DWARFDIE> v;
-  m_fallback.GetFunctions(name, dwarf, parent_decl_ctx, name_type_mask, v);
+  if (m_fallback_up)
+    m_fallback_up->GetFunctions(name, dwarf, parent_decl_ctx, name_type_mask,
+                                v);
 
   for (const DebugNames::Entry &entry :
        m_debug_names_up->equal_range(name.GetStringRef())) {
@@ -233,6 +321,15 @@ void DebugNamesDWARFIndex::GetFunctions(
                          name_type_mask, v);
   }
 
+  if (name_type_mask & eFunctionNameTypeFull) {
+    llvm::call_once(m_objc_once, [this] { IndexObjCMethods(); });
+    DIEArray offsets;
+    m_objc_fullnames_no_category.Find(name, offsets);
+    for (const DIERef &ref : offsets)
+      ProcessFunctionDIE(name.GetStringRef(), ref, dwarf, parent_decl_ctx,
+                         name_type_mask, v);
+  }
+
   std::set<DWARFDebugInfoEntry *> seen;
   for (DWARFDIE die : v)
     if (seen.insert(die.GetDIE()).second)
@@ -241,7 +338,8 @@ void DebugNamesDWARFIndex::GetFunctions(
 
 void DebugNamesDWARFIndex::GetFunctions(const RegularExpression &regex,
                                         DIEArray &offsets) {
-  m_fallback.GetFunctions(regex, offsets);
+  if (m_fallback_up)
+    m_fallback_up->GetFunctions(regex, offsets);
 
   for (const DebugNames::NameIndex &ni: *m_debug_names_up) {
     for (DebugNames::NameTableEntry nte: ni) {
@@ -263,7 +361,8 @@ void DebugNamesDWARFIndex::GetFunctions(const RegularExpression &regex,
 }
 
 void DebugNamesDWARFIndex::Dump(Stream &s) {
-  m_fallback.Dump(s);
+  if (m_fallback_up)
+    m_fallback_up->Dump(s);
 
   std::string data;
   llvm::raw_string_ostream os(data);
@@ -12,8 +12,10 @@
 #include "Plugins/SymbolFile/DWARF/DWARFIndex.h"
 #include "Plugins/SymbolFile/DWARF/LogChannelDWARF.h"
 #include "Plugins/SymbolFile/DWARF/ManualDWARFIndex.h"
+#include "Plugins/SymbolFile/DWARF/NameToDIE.h"
 #include "lldb/Utility/ConstString.h"
 #include "llvm/DebugInfo/DWARF/DWARFAcceleratorTable.h"
+#include "llvm/Support/Threading.h"
 
 namespace lldb_private {
 class DebugNamesDWARFIndex : public DWARFIndex {
@@ -22,13 +24,16 @@ public:
   Create(Module &module, DWARFDataExtractor debug_names,
          DWARFDataExtractor debug_str, DWARFDebugInfo *debug_info);
 
-  void Preload() override { m_fallback.Preload(); }
+  void Preload() override {
+    if (m_fallback_up)
+      m_fallback_up->Preload();
+  }
 
   void GetGlobalVariables(ConstString basename, DIEArray &offsets) override;
   void GetGlobalVariables(const RegularExpression &regex,
                           DIEArray &offsets) override;
   void GetGlobalVariables(const DWARFUnit &cu, DIEArray &offsets) override;
-  void GetObjCMethods(ConstString class_name, DIEArray &offsets) override {}
+  void GetObjCMethods(ConstString class_name, DIEArray &offsets) override;
   void GetCompleteObjCClass(ConstString class_name, bool must_be_implementation,
                             DIEArray &offsets) override;
   void GetTypes(ConstString name, DIEArray &offsets) override;
@@ -49,11 +54,12 @@ private:
                        std::unique_ptr<llvm::DWARFDebugNames> debug_names_up,
                        DWARFDataExtractor debug_names_data,
                        DWARFDataExtractor debug_str_data,
-                       DWARFDebugInfo &debug_info)
+                       DWARFDebugInfo &debug_info,
+                       std::unique_ptr<ManualDWARFIndex> fallback_up)
       : DWARFIndex(module), m_debug_info(debug_info),
         m_debug_names_data(debug_names_data), m_debug_str_data(debug_str_data),
         m_debug_names_up(std::move(debug_names_up)),
-        m_fallback(module, &debug_info, GetUnits(*m_debug_names_up)) {}
+        m_fallback_up(std::move(fallback_up)) {}
 
   DWARFDebugInfo &m_debug_info;
 
@@ -64,7 +70,18 @@ private:
 
   using DebugNames = llvm::DWARFDebugNames;
   std::unique_ptr<DebugNames> m_debug_names_up;
-  ManualDWARFIndex m_fallback;
+  /// Index of the units not covered by any name index, or null if the name
+  /// indexes cover every unit of the module.
+  std::unique_ptr<ManualDWARFIndex> m_fallback_up;
+
+  /// .debug_names lists Objective-C methods only by their full name and
+  /// selector. These add the class names (with and without category) and the
+  /// full names without category that ManualDWARFIndex provides. They are
+  /// built from the name table the first time they are needed.
+  llvm::once_flag m_objc_once;
+  NameToDIE m_objc_class_selectors;
+  NameToDIE m_objc_fullnames_no_category;
+  void IndexObjCMethods();
 
   llvm::Optional<DIERef> ToDIERef(const DebugNames::Entry &entry);
   void Append(const DebugNames::Entry &entry, DIEArray &offsets);
@@ -10,32 +10,117 @@
 #include "Plugins/Language/ObjC/ObjCLanguage.h"
 #include "Plugins/SymbolFile/DWARF/DWARFDebugInfo.h"
 #include "Plugins/SymbolFile/DWARF/DWARFDeclContext.h"
+#include "Plugins/SymbolFile/DWARF/DWARFTypeUnit.h"
 #include "Plugins/SymbolFile/DWARF/LogChannelDWARF.h"
 #include "Plugins/SymbolFile/DWARF/SymbolFileDWARFDwo.h"
+#include "Plugins/SymbolFile/DWARF/SymbolFileDWARF.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Utility/DataBufferLLVM.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Stream.h"
+#include "lldb/Utility/StreamString.h"
 #include "lldb/Utility/Timer.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/LockFileManager.h"
+
+#include <atomic>
 
 using namespace lldb_private;
 using namespace lldb;
 
-void ManualDWARFIndex::Index() {
+ManualDWARFIndex::~ManualDWARFIndex() {
+  MemoryBudget::Instance().Remove(*this);
+}
+
+std::shared_lock<std::shared_timed_mutex> ManualDWARFIndex::Index() {
+  llvm::call_once(m_index_once, [this] {
+    BuildIndex();
+    if (m_cached_on_disk)
+      MemoryBudget::Instance().Add(*this);
+    MarkResident(ComputeMemoryUsage());
+  });
+
+  std::shared_lock<std::shared_timed_mutex> lock(m_set_mutex);
+  while (m_evicted) {
+    lock.unlock();
+    Reload();
+    lock.lock();
+  }
+  MarkUsed();
+  return lock;
+}
+
+void ManualDWARFIndex::Reload() {
+  size_t size;
+  {
+    std::lock_guard<std::shared_timed_mutex> guard(m_set_mutex);
+    if (!m_evicted)
+      return;
+    if (!LoadFromCache()) {
+      // The cache file was removed or replaced, index the debug info again.
+      m_debug_info = m_indexed_debug_info;
+      BuildIndex();
+    }
+    m_evicted = false;
+    size = ComputeMemoryUsage();
+  }
+  MarkResident(size);
+}
+
+bool ManualDWARFIndex::TryEvict() {
+  // Whoever holds the lock is using the maps or reloading them.
+  std::unique_lock<std::shared_timed_mutex> lock(m_set_mutex,
+                                                 std::try_to_lock);
+  if (!lock.owns_lock() || m_evicted || !m_cached_on_disk)
+    return false;
+  m_set.ForEach([](NameToDIE &map) { map.Clear(); });
+  m_evicted = true;
+  return true;
+}
+
+size_t ManualDWARFIndex::ComputeMemoryUsage() {
+  size_t usage = 0;
+  m_set.ForEach([&](NameToDIE &map) { usage += map.MemorySize(); });
+  return usage;
+}
+
+void ManualDWARFIndex::BuildIndex() {
   if (!m_debug_info)
     return;
 
   DWARFDebugInfo &debug_info = *m_debug_info;
+  m_indexed_debug_info = m_debug_info;
   m_debug_info = nullptr;
 
   static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
   Timer scoped_timer(func_cat, "%p", static_cast<void *>(&debug_info));
+  ElapsedTime elapsed(m_index_time);
+
+  std::unique_ptr<llvm::LockFileManager> cache_lock;
+  m_cached_on_disk = LoadFromCacheOrLock(cache_lock);
+  if (m_cached_on_disk)
+    return;
+
+  // With -fdebug-types-section the same type unit is emitted into every
+  // object file that uses the type. Index each type signature only once, the
+  // DIEs of the other copies are only extracted if a DW_FORM_ref_sig8 in
+  // their own file refers to them.
+  llvm::DenseSet<uint64_t> type_signatures;
+  auto is_duplicate_type_unit = [&](DWARFUnit &unit) {
+    auto *type_unit = llvm::dyn_cast<DWARFTypeUnit>(&unit);
+    return type_unit &&
+           !type_signatures.insert(type_unit->GetTypeHash()).second;
+  };
 
   std::vector<DWARFUnit *> units_to_index;
   units_to_index.reserve(debug_info.GetNumUnits());
   for (size_t U = 0; U < debug_info.GetNumUnits(); ++U) {
     DWARFUnit *unit = debug_info.GetUnitAtIndex(U);
-    if (unit && m_units_to_avoid.count(unit->GetOffset()) == 0)
+    if (unit && m_units_to_avoid.count(unit->GetOffset()) == 0 &&
+        !is_duplicate_type_unit(*unit))
       units_to_index.push_back(unit);
   }
   if (units_to_index.empty())
@@ -43,37 +128,61 @@ void ManualDWARFIndex::Index() {
 
   std::vector<IndexSet> sets(units_to_index.size());
 
+  // Parsing the unit DIE is what locates the .dwo/.dwp file of a skeleton
+  // unit, and creating that symbol file goes through ObjectFile and Module
+  // APIs that take the module lock. This thread may already hold that lock
+  // (e.g. when called from SymbolFileDWARF::PreloadSymbols), so a worker
+  // thread trying to acquire it would deadlock while we wait for it. Do this
+  // cheap part up front on the current thread; after it only the DWARF unit
+  // data and per-unit mutexes are touched. Reading the .dwo files needs no
+  // locks, so that is done in parallel first.
+  units_to_index.front()->GetSymbolFileDWARF().PrefetchDwoFiles(
+      units_to_index);
+  llvm::DenseSet<const DWARFUnit *> duplicate_type_units;
+  for (DWARFUnit *unit : units_to_index) {
+    unit->ExtractUnitDIEIfNeeded();
+    if (SymbolFileDWARFDwo *dwo_symbol_file = unit->GetDwoSymbolFile()) {
+      if (DWARFDebugInfo *dwo_info = dwo_symbol_file->DebugInfo()) {
+        for (size_t i = 0; i < dwo_info->GetNumUnits(); ++i) {
+          DWARFUnit *dwo_unit = dwo_info->GetUnitAtIndex(i);
+          if (is_duplicate_type_unit(*dwo_unit))
+            duplicate_type_units.insert(dwo_unit);
+          else
+            dwo_unit->ExtractUnitDIEIfNeeded();
+        }
+      }
+    }
+  }
+
   // Keep memory down by clearing DIEs for any units if indexing
-  // caused us to load the unit's DIEs.
+  // caused us to load the unit's DIEs. The DIEs are kept alive until every
+  // unit has been indexed in case a DIE in one unit refers to another one
+  // and the index accesses those DIEs, as long as they fit in the memory
+  // limit. Past it, each unit's DIEs are cleared as soon as it is indexed
+  // and extracted again if another unit refers to them.
   std::vector<llvm::Optional<DWARFUnit::ScopedExtractDIEs>> clear_cu_dies(
       units_to_index.size());
-  auto parser_fn = [&](size_t cu_idx) {
-    IndexUnit(*units_to_index[cu_idx], sets[cu_idx]);
-  };
-
-  auto extract_fn = [&units_to_index, &clear_cu_dies](size_t cu_idx) {
-    clear_cu_dies[cu_idx] = units_to_index[cu_idx]->ExtractDIEsScoped();
+  const uint64_t die_memory_limit = SymbolFileDWARF::GetIndexDIEMemoryLimit();
+  std::atomic<uint64_t> die_memory_kept(0);
+
+  // Extract and index each DWARF unit on the same worker thread, so the DIEs
+  // are still hot in the cache when IndexUnit walks them.
+  auto extract_and_index_fn = [&](size_t cu_idx) {
+    DWARFUnit &unit = *units_to_index[cu_idx];
+    DWARFUnit::ScopedExtractDIEs dies = unit.ExtractDIEsScoped();
+    IndexUnit(unit, duplicate_type_units, sets[cu_idx]);
+    if (!dies.m_clear_dies || die_memory_limit == 0) {
+      clear_cu_dies[cu_idx] = std::move(dies);
+      return;
+    }
+    const uint64_t size = unit.GetDIEArrayByteSize();
+    if (die_memory_kept.fetch_add(size) + size <= die_memory_limit)
+      clear_cu_dies[cu_idx] = std::move(dies);
+    else
+      die_memory_kept -= size;
   };
 
-  // Create a task runner that extracts dies for each DWARF unit in a
-  // separate thread
-  // First figure out which units didn't have their DIEs already
-  // parsed and remember this.  If no DIEs were parsed prior to this index
-  // function call, we are going to want to clear the CU dies after we are
-  // done indexing to make sure we don't pull in all DWARF dies, but we need
-  // to wait until all compile units have been indexed in case a DIE in one
-  // compile unit refers to another and the indexes accesses those DIEs.
-  //----------------------------------------------------------------------
-  for (int i=0; i<units_to_index.size(); ++i) {
-     extract_fn(i);
-  }
-  // This call can deadlock because we are sometimes holding the module lock.
-  //TaskMapOverInt(0, units_to_index.size(), extract_fn);
-
-  // Now create a task runner that can index each DWARF unit in a
-  // separate thread so we can index quickly.
-
-  TaskMapOverInt(0, units_to_index.size(), parser_fn);
+  TaskMapOverInt(0, units_to_index.size(), extract_and_index_fn);
 
   auto finalize_fn = [this, &sets](NameToDIE(IndexSet::*index)) {
     NameToDIE &result = m_set.*index;
@@ -90,9 +199,125 @@ void ManualDWARFIndex::Index() {
                      [&]() { finalize_fn(&IndexSet::globals); },
                      [&]() { finalize_fn(&IndexSet::types); },
                      [&]() { finalize_fn(&IndexSet::namespaces); });
+
+  m_cached_on_disk = SaveToCache();
 }
 
-void ManualDWARFIndex::IndexUnit(DWARFUnit &unit, IndexSet &set) {
+// Bump this whenever the layout of the cache file or the contents of the
+// index change.
+static const uint32_t g_index_cache_version = 3;
+static const uint32_t g_index_cache_magic = 0x4c44574d; // 'LDWM'
+
+FileSpec ManualDWARFIndex::GetCacheFile() {
+  // We cannot tell whether a partial index is still valid, so only complete
+  // indexes are cached.
+  if (!m_units_to_avoid.empty())
+    return FileSpec();
+
+  return SymbolFileDWARF::GetIndexCacheFile(m_module, ".dwarf-index");
+}
+
+bool ManualDWARFIndex::LoadFromCache() {
+  FileSpec cache_file = GetCacheFile();
+  if (!cache_file || !FileSystem::Instance().Exists(cache_file))
+    return false;
+
+  Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO);
+
+  DataBufferSP buffer_sp = FileSystem::Instance().CreateDataBuffer(cache_file);
+  if (!buffer_sp)
+    return false;
+  DataExtractor data(buffer_sp, eByteOrderLittle, 8);
+
+  lldb::offset_t offset = 0;
+  if (!data.ValidOffsetForDataOfSize(offset, 24) ||
+      data.GetU32(&offset) != g_index_cache_magic ||
+      data.GetU32(&offset) != g_index_cache_version ||
+      data.GetU64(&offset) !=
+          uint64_t(llvm::sys::toTimeT(m_module.GetModificationTime())) ||
+      data.GetU64(&offset) !=
+          uint64_t(llvm::sys::toTimeT(m_module.GetObjectModificationTime())))
+    return false;
+
+  ConstStringTable strtab;
+  bool success = strtab.Decode(data, &offset);
+  m_set.ForEach([&](NameToDIE &map) {
+    success = success && map.Decode(data, &offset, strtab);
+  });
+  if (!success) {
+    LLDB_LOG(log, "ignoring corrupt DWARF index cache file {0}", cache_file);
+    m_set.ForEach([](NameToDIE &map) { map.Clear(); });
+    return false;
+  }
+
+  LLDB_LOG(log, "loaded DWARF index for {0} from {1}",
+           m_module.GetFileSpec(), cache_file);
+  return true;
+}
+
+// Debuggers on the same machine often load the same modules at the same
+// time. Let one of them build the cached data while the others wait for it,
+// rather than all of them building it. Returns true if another debugger
+// finished building it, so loading the cache should be tried again.
+// Otherwise, \a cache_lock may receive a lock that the caller holds until
+// it has saved its own result.
+static bool
+WaitForCacheOrLock(const FileSpec &cache_file,
+                   std::unique_ptr<llvm::LockFileManager> &cache_lock) {
+  // The lock file is created next to the cache file.
+  if (llvm::sys::fs::create_directories(
+          cache_file.GetDirectory().GetStringRef()))
+    return false;
+  auto lock = std::make_unique<llvm::LockFileManager>(cache_file.GetPath());
+  switch (lock->getState()) {
+  case llvm::LockFileManager::LFS_Owned:
+    cache_lock = std::move(lock);
+    return false;
+  case llvm::LockFileManager::LFS_Shared:
+    // If the other debugger goes away or takes too long, build it ourselves.
+    return lock->waitForUnlock() == llvm::LockFileManager::Res_Success;
+  case llvm::LockFileManager::LFS_Error:
+    return false;
+  }
+  return false;
+}
+
+bool ManualDWARFIndex::LoadFromCacheOrLock(
+    std::unique_ptr<llvm::LockFileManager> &cache_lock) {
+  if (LoadFromCache())
+    return true;
+  FileSpec cache_file = GetCacheFile();
+  return cache_file && WaitForCacheOrLock(cache_file, cache_lock) &&
+         LoadFromCache();
+}
+
+bool ManualDWARFIndex::SaveToCache() {
+  FileSpec cache_file = GetCacheFile();
+  if (!cache_file)
+    return false;
+
+  // The string table is written in front of the name maps, but is only
+  // complete once all of the maps have been encoded.
+  ConstStringTable strtab;
+  StreamString maps(Stream::eBinary, 8, eByteOrderLittle);
+  m_set.ForEach([&](NameToDIE &map) { map.Encode(maps, strtab); });
+
+  StreamString header(Stream::eBinary, 8, eByteOrderLittle);
+  header.PutHex32(g_index_cache_magic);
+  header.PutHex32(g_index_cache_version);
+  header.PutHex64(llvm::sys::toTimeT(m_module.GetModificationTime()));
+  header.PutHex64(llvm::sys::toTimeT(m_module.GetObjectModificationTime()));
+  strtab.Encode(header);
+
+  std::string contents = header.GetString().str();
+  contents += maps.GetString();
+  return SymbolFileDWARF::WriteIndexCacheFile(cache_file, contents);
+}
+
+void ManualDWARFIndex::IndexUnit(
+    DWARFUnit &unit,
+    const llvm::DenseSet<const DWARFUnit *> &duplicate_type_units,
+    IndexSet &set) {
   assert(
       !unit.GetSymbolFileDWARF().GetBaseCompileUnit() &&
       "DWARFUnit associated with .dwo or .dwp should not be indexed directly");
@@ -111,8 +336,76 @@ void ManualDWARFIndex::IndexUnit(DWARFUnit &unit, IndexSet &set) {
 
   if (SymbolFileDWARFDwo *dwo_symbol_file = unit.GetDwoSymbolFile()) {
     DWARFDebugInfo &dwo_info = *dwo_symbol_file->DebugInfo();
-    for (size_t i = 0; i < dwo_info.GetNumUnits(); ++i)
-      IndexUnitImpl(*dwo_info.GetUnitAtIndex(i), cu_language, set);
+    for (size_t i = 0; i < dwo_info.GetNumUnits(); ++i) {
+      DWARFUnit *dwo_unit = dwo_info.GetUnitAtIndex(i);
+      if (!duplicate_type_units.count(dwo_unit))
+        IndexUnitImpl(*dwo_unit, cu_language, set);
+    }
+  }
+}
+
+namespace {
+/// The attributes of a DIE that decide which of the indexes it goes into.
+struct IndexAttributes {
+  const char *name = nullptr;
+  const char *mangled_cstr = nullptr;
+  bool is_declaration = false;
+  bool has_address = false;
+  bool has_location_or_const_value = false;
+};
+} // namespace
+
+/// Collect the attributes of \a die the index needs, including those of the
+/// DIEs it refers to with DW_AT_specification or DW_AT_abstract_origin, with
+/// the same precedence as DWARFDebugInfoEntry::GetAttributes(). Only the
+/// attributes the abbreviation lists for the index are decoded, the others
+/// are skipped over or only looked up in the abbreviation.
+static void GetIndexAttributes(DWARFUnit &unit, const DWARFDebugInfoEntry &die,
+                               uint32_t depth, IndexAttributes &attributes) {
+  const DWARFAbbreviationDeclaration *abbrevDecl =
+      die.GetAbbreviationDeclarationPtr(&unit);
+  if (!abbrevDecl)
+    return;
+  if (abbrevDecl->HasAddressAttributes())
+    attributes.has_address = true;
+  if (abbrevDecl->HasLocationOrConstValue())
+    attributes.has_location_or_const_value = true;
+
+  const DWARFDataExtractor &data = unit.GetData();
+  for (uint32_t idx : abbrevDecl->GetIndexAttributeIndexes()) {
+    DWARFFormValue form_value(&unit);
+    dw_attr_t attr;
+    abbrevDecl->GetAttrAndFormValueByIndex(idx, attr, form_value);
+    // The declaration only counts for the DIE itself, not the ones it
+    // refers to.
+    if (attr == DW_AT_declaration && depth > 0)
+      continue;
+    lldb::offset_t offset = die.GetFirstAttributeOffset();
+    if (!abbrevDecl->SkipToAttribute(idx, data, &offset, &unit) ||
+        !form_value.ExtractValue(data, &offset))
+      continue;
+
+    switch (attr) {
+    case DW_AT_name:
+      attributes.name = form_value.AsCString();
+      break;
+
+    case DW_AT_declaration:
+      attributes.is_declaration = form_value.Unsigned() != 0;
+      break;
+
+    case DW_AT_MIPS_linkage_name:
+    case DW_AT_linkage_name:
+      attributes.mangled_cstr = form_value.AsCString();
+      break;
+
+    case DW_AT_specification:
+    case DW_AT_abstract_origin:
+      if (DWARFDIE ref_die = form_value.Reference())
+        GetIndexAttributes(*ref_die.GetCU(), *ref_die.GetDIE(), depth + 1,
+                           attributes);
+      break;
+    }
   }
 }
 
@@ -144,105 +437,40 @@ void ManualDWARFIndex::IndexUnitImpl(DWARFUnit &unit,
       continue;
     }
 
-    DWARFAttributes attributes;
-    const char *name = nullptr;
-    const char *mangled_cstr = nullptr;
-    bool is_declaration = false;
-    // bool is_artificial = false;
-    bool has_address = false;
-    bool has_location_or_const_value = false;
+    IndexAttributes attributes;
+    GetIndexAttributes(unit, die, 0, attributes);
+    const char *name = attributes.name;
+    const char *mangled_cstr = attributes.mangled_cstr;
+    const bool is_declaration = attributes.is_declaration;
+    const bool has_address = attributes.has_address;
+    const bool has_location_or_const_value =
+        attributes.has_location_or_const_value;
     bool is_global_or_static_variable = false;
 
-    DWARFFormValue specification_die_form;
-    const size_t num_attributes = die.GetAttributes(&unit, attributes);
-    if (num_attributes > 0) {
-      for (uint32_t i = 0; i < num_attributes; ++i) {
-        dw_attr_t attr = attributes.AttributeAtIndex(i);
-        DWARFFormValue form_value;
-        switch (attr) {
-        case DW_AT_name:
-          if (attributes.ExtractFormValueAtIndex(i, form_value))
-            name = form_value.AsCString();
-          break;
-
-        case DW_AT_declaration:
-          if (attributes.ExtractFormValueAtIndex(i, form_value))
-            is_declaration = form_value.Unsigned() != 0;
-          break;
-
-        //                case DW_AT_artificial:
-        //                    if (attributes.ExtractFormValueAtIndex(i,
-        //                    form_value))
-        //                        is_artificial = form_value.Unsigned() != 0;
-        //                    break;
-
-        case DW_AT_MIPS_linkage_name:
-        case DW_AT_linkage_name:
-          if (attributes.ExtractFormValueAtIndex(i, form_value))
-            mangled_cstr = form_value.AsCString();
-          break;
-
-        case DW_AT_low_pc:
-        case DW_AT_high_pc:
-        case DW_AT_ranges:
-          has_address = true;
-          break;
-
-        case DW_AT_entry_pc:
-          has_address = true;
+    if (tag == DW_TAG_variable && has_location_or_const_value) {
+      const DWARFDebugInfoEntry *parent_die = die.GetParent();
+      while (parent_die != nullptr) {
+        switch (parent_die->Tag()) {
+        case DW_TAG_subprogram:
+        case DW_TAG_lexical_block:
+        case DW_TAG_inlined_subroutine:
+          // Even if this is a function level static, we don't add it. We
+          // could theoretically add these if we wanted to by introspecting
+          // into the DW_AT_location and seeing if the location describes a
+          // hard coded address, but we don't want the performance penalty of
+          // that right now.
+          is_global_or_static_variable = false;
+          parent_die = nullptr; // Terminate the while loop.
           break;
 
-        case DW_AT_location:
-        case DW_AT_const_value:
-          has_location_or_const_value = true;
-          if (tag == DW_TAG_variable) {
-            const DWARFDebugInfoEntry *parent_die = die.GetParent();
-            while (parent_die != nullptr) {
-              switch (parent_die->Tag()) {
-              case DW_TAG_subprogram:
-              case DW_TAG_lexical_block:
-              case DW_TAG_inlined_subroutine:
-                // Even if this is a function level static, we don't add it. We
-                // could theoretically add these if we wanted to by
-                // introspecting into the DW_AT_location and seeing if the
-                // location describes a hard coded address, but we don't want
-                // the performance penalty of that right now.
-                is_global_or_static_variable = false;
-                // if (attributes.ExtractFormValueAtIndex(dwarf, i,
-                //                                        form_value)) {
-                //   // If we have valid block data, then we have location
-                //   // expression bytesthat are fixed (not a location list).
-                //   const uint8_t *block_data = form_value.BlockData();
-                //   if (block_data) {
-                //     uint32_t block_length = form_value.Unsigned();
-                //     if (block_length == 1 +
-                //     attributes.UnitAtIndex(i)->GetAddressByteSize()) {
-                //       if (block_data[0] == DW_OP_addr)
-                //         add_die = true;
-                //     }
-                //   }
-                // }
-                parent_die = nullptr; // Terminate the while loop.
-                break;
-
-              case DW_TAG_compile_unit:
-              case DW_TAG_partial_unit:
-                is_global_or_static_variable = true;
-                parent_die = nullptr; // Terminate the while loop.
-                break;
-
-              default:
-                parent_die =
-                    parent_die->GetParent(); // Keep going in the while loop.
-                break;
-              }
-            }
-          }
+        case DW_TAG_compile_unit:
+        case DW_TAG_partial_unit:
+          is_global_or_static_variable = true;
+          parent_die = nullptr; // Terminate the while loop.
           break;
 
-        case DW_AT_specification:
-          if (attributes.ExtractFormValueAtIndex(i, form_value))
-            specification_die_form = form_value;
+        default:
+          parent_die = parent_die->GetParent(); // Keep going in the while loop.
           break;
         }
       }
@@ -353,48 +581,48 @@ void ManualDWARFIndex::IndexUnitImpl(DWARFUnit &unit,
 }
 
 void ManualDWARFIndex::GetGlobalVariables(ConstString basename, DIEArray &offsets) {
-  Index();
+  auto lock = Index();
   m_set.globals.Find(basename, offsets);
 }
 
 void ManualDWARFIndex::GetGlobalVariables(const RegularExpression &regex,
                                           DIEArray &offsets) {
-  Index();
+  auto lock = Index();
   m_set.globals.Find(regex, offsets);
 }
 
 void ManualDWARFIndex::GetGlobalVariables(const DWARFUnit &unit,
                                           DIEArray &offsets) {
-  Index();
+  auto lock = Index();
   m_set.globals.FindAllEntriesForUnit(unit, offsets);
 }
 
 void ManualDWARFIndex::GetObjCMethods(ConstString class_name,
                                       DIEArray &offsets) {
-  Index();
+  auto lock = Index();
   m_set.objc_class_selectors.Find(class_name, offsets);
 }
 
 void ManualDWARFIndex::GetCompleteObjCClass(ConstString class_name,
                                             bool must_be_implementation,
                                             DIEArray &offsets) {
-  Index();
+  auto lock = Index();
   m_set.types.Find(class_name, offsets);
 }
 
 void ManualDWARFIndex::GetTypes(ConstString name, DIEArray &offsets) {
-  Index();
+  auto lock = Index();
   m_set.types.Find(name, offsets);
 }
 
 void ManualDWARFIndex::GetTypes(const DWARFDeclContext &context,
                                 DIEArray &offsets) {
-  Index();
+  auto lock = Index();
   m_set.types.Find(ConstString(context[0].name), offsets);
 }
 
 void ManualDWARFIndex::GetNamespaces(ConstString name, DIEArray &offsets) {
-  Index();
+  auto lock = Index();
   m_set.namespaces.Find(name, offsets);
 }
 
@@ -402,63 +630,53 @@ void ManualDWARFIndex::GetFunctions(ConstString name, SymbolFileDWARF &dwarf,
                                     const CompilerDeclContext &parent_decl_ctx,
                                     uint32_t name_type_mask,
                                     std::vector<DWARFDIE> &dies) {
-  Index();
-
-  if (name_type_mask & eFunctionNameTypeFull) {
-    DIEArray offsets;
-    m_set.function_basenames.Find(name, offsets);
-    m_set.function_methods.Find(name, offsets);
-    m_set.function_fullnames.Find(name, offsets);
-    for (const DIERef &die_ref: offsets) {
-      DWARFDIE die = dwarf.GetDIE(die_ref);
-      if (!die)
-        continue;
-      if (SymbolFileDWARF::DIEInDeclContext(&parent_decl_ctx, die))
-        dies.push_back(die);
+  // Look up the offsets first, resolving the DIEs may parse debug info and
+  // shouldn't keep the maps from being evicted.
+  DIEArray in_context, anywhere;
+  {
+    auto lock = Index();
+    if (name_type_mask & eFunctionNameTypeFull) {
+      m_set.function_basenames.Find(name, in_context);
+      m_set.function_methods.Find(name, in_context);
+      m_set.function_fullnames.Find(name, in_context);
     }
-  }
-  if (name_type_mask & eFunctionNameTypeBase) {
-    DIEArray offsets;
-    m_set.function_basenames.Find(name, offsets);
-    for (const DIERef &die_ref: offsets) {
-      DWARFDIE die = dwarf.GetDIE(die_ref);
-      if (!die)
-        continue;
-      if (SymbolFileDWARF::DIEInDeclContext(&parent_decl_ctx, die))
-        dies.push_back(die);
-    }
-    offsets.clear();
+    if (name_type_mask & eFunctionNameTypeBase)
+      m_set.function_basenames.Find(name, in_context);
+    if (name_type_mask & eFunctionNameTypeMethod && !parent_decl_ctx.IsValid())
+      m_set.function_methods.Find(name, anywhere);
+    if (name_type_mask & eFunctionNameTypeSelector &&
+        !parent_decl_ctx.IsValid())
+      m_set.function_selectors.Find(name, anywhere);
   }
 
-  if (name_type_mask & eFunctionNameTypeMethod && !parent_decl_ctx.IsValid()) {
-    DIEArray offsets;
-    m_set.function_methods.Find(name, offsets);
-    for (const DIERef &die_ref: offsets) {
-      if (DWARFDIE die = dwarf.GetDIE(die_ref))
-        dies.push_back(die);
-    }
+  for (const DIERef &die_ref: in_context) {
+    DWARFDIE die = dwarf.GetDIE(die_ref);
+    if (!die)
+      continue;
+    if (SymbolFileDWARF::DIEInDeclContext(&parent_decl_ctx, die))
+      dies.push_back(die);
   }
-
-  if (name_type_mask & eFunctionNameTypeSelector &&
-      !parent_decl_ctx.IsValid()) {
-    DIEArray offsets;
-    m_set.function_selectors.Find(name, offsets);
-    for (const DIERef &die_ref: offsets) {
-      if (DWARFDIE die = dwarf.GetDIE(die_ref))
-        dies.push_back(die);
-    }
+  for (const DIERef &die_ref: anywhere) {
+    if (DWARFDIE die = dwarf.GetDIE(die_ref))
+      dies.push_back(die);
   }
 }
 
 void ManualDWARFIndex::GetFunctions(const RegularExpression &regex,
                                     DIEArray &offsets) {
-  Index();
+  auto lock = Index();
 
   m_set.function_basenames.Find(regex, offsets);
   m_set.function_fullnames.Find(regex, offsets);
 }
 
+size_t ManualDWARFIndex::GetMemoryUsage() {
+  // Don't build or reload the index just to say how big it is.
+  return GetResidentSize();
+}
+
 void ManualDWARFIndex::Dump(Stream &s) {
+  std::shared_lock<std::shared_timed_mutex> lock(m_set_mutex);
   s.Format("Manual DWARF index for ({0}) '{1:F}':",
            m_module.GetArchitecture().GetArchitectureName(),
            m_module.GetObjectFile()->GetFileSpec());
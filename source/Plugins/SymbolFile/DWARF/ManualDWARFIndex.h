@@ -11,18 +11,31 @@
 
 #include "Plugins/SymbolFile/DWARF/DWARFIndex.h"
 #include "Plugins/SymbolFile/DWARF/NameToDIE.h"
+#include "lldb/Core/MemoryBudget.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/Threading.h"
+#include <memory>
+#include <shared_mutex>
+
+namespace llvm {
+class LockFileManager;
+} // namespace llvm
 
 class DWARFDebugInfo;
 
 namespace lldb_private {
-class ManualDWARFIndex : public DWARFIndex {
+/// Once built, the index is subject to the symbols.memory-budget setting if
+/// it is also in the on-disk cache: it may then be evicted, and is loaded
+/// from the cache file again the next time it is used.
+class ManualDWARFIndex : public DWARFIndex, public EvictableCache {
 public:
   ManualDWARFIndex(Module &module, DWARFDebugInfo *debug_info,
                    llvm::DenseSet<dw_offset_t> units_to_avoid = {})
       : DWARFIndex(module), m_debug_info(debug_info),
         m_units_to_avoid(std::move(units_to_avoid)) {}
 
+  ~ManualDWARFIndex() override;
+
   void Preload() override { Index(); }
 
   void GetGlobalVariables(ConstString basename, DIEArray &offsets) override;
@@ -44,6 +57,8 @@ public:
   void ReportInvalidDIERef(const DIERef &ref, llvm::StringRef name) override {}
   void Dump(Stream &s) override;
 
+  size_t GetMemoryUsage() override;
+
 private:
   struct IndexSet {
     NameToDIE function_basenames;
@@ -54,16 +69,64 @@ private:
     NameToDIE globals;
     NameToDIE types;
     NameToDIE namespaces;
+
+    /// Call \a fn on each of the maps above, always in the same order.
+    template <typename Fn> void ForEach(Fn fn) {
+      fn(function_basenames);
+      fn(function_fullnames);
+      fn(function_methods);
+      fn(function_selectors);
+      fn(objc_class_selectors);
+      fn(globals);
+      fn(types);
+      fn(namespaces);
+    }
   };
-  void Index();
-  void IndexUnit(DWARFUnit &unit, IndexSet &set);
+  /// Build the index, or load it again if it was evicted, and return a lock
+  /// that keeps it from being evicted while the maps are looked at.
+  std::shared_lock<std::shared_timed_mutex> Index();
+  void BuildIndex();
+  /// Load or build the maps again after they were evicted.
+  void Reload();
+  bool TryEvict() override;
+  size_t ComputeMemoryUsage();
+  /// Index \a unit and its .dwo units, except the type units in
+  /// \a duplicate_type_units.
+  void IndexUnit(DWARFUnit &unit,
+                 const llvm::DenseSet<const DWARFUnit *> &duplicate_type_units,
+                 IndexSet &set);
 
   static void IndexUnitImpl(DWARFUnit &unit,
                             const lldb::LanguageType cu_language,
                             IndexSet &set);
 
+  /// Return the file the index of this module is cached in, or an invalid
+  /// FileSpec if it should not be cached.
+  lldb_private::FileSpec GetCacheFile();
+  bool LoadFromCache();
+  /// Like LoadFromCache(), but waits for another debugger on this machine
+  /// that is indexing this module right now. \a cache_lock may receive a
+  /// lock to hold until SaveToCache() was called.
+  bool LoadFromCacheOrLock(std::unique_ptr<llvm::LockFileManager> &cache_lock);
+  /// Returns true if the index was written to the cache file.
+  bool SaveToCache();
+
   /// Non-null value means we haven't built the index yet.
   DWARFDebugInfo *m_debug_info;
+  /// Type lookups query the index without holding the module mutex, so
+  /// several threads may ask for it to be built at once.
+  llvm::once_flag m_index_once;
+  /// The debug info the index was built from, in case it has to be built
+  /// again because the cache file went away after it was evicted.
+  DWARFDebugInfo *m_indexed_debug_info = nullptr;
+  /// Held shared while the maps are looked at, and exclusively while they
+  /// are evicted or reloaded.
+  std::shared_timed_mutex m_set_mutex;
+  /// Set while the maps are evicted and must be reloaded before use.
+  bool m_evicted = false;
+  /// Set if the maps can be loaded from the cache file, only then are they
+  /// cheap enough to evict.
+  bool m_cached_on_disk = false;
   /// Which dwarf units should we skip while building the index.
   llvm::DenseSet<dw_offset_t> m_units_to_avoid;
 
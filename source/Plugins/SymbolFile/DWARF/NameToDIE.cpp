@@ -8,8 +8,10 @@
 
 #include "NameToDIE.h"
 #include "DWARFUnit.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Utility/ConstString.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
 #include "lldb/Utility/StreamString.h"
@@ -19,28 +21,94 @@ using namespace lldb_private;
 
 void NameToDIE::Finalize() {
   m_map.Sort();
+
+  m_names.clear();
+  m_values.clear();
+  const uint32_t size = m_map.GetSize();
+  m_values.reserve(size);
+  for (uint32_t i = 0; i < size; ++i) {
+    ConstString name = m_map.GetCStringAtIndexUnchecked(i);
+    if (m_names.empty() || m_names.back().name != name)
+      m_names.push_back({name, uint32_t(m_values.size()), 0});
+    ++m_names.back().count;
+    m_values.push_back(m_map.GetValueAtIndexUnchecked(i));
+  }
+  m_names.shrink_to_fit();
+
+  // Release the memory of the unsorted entries.
+  m_map.Clear();
+  m_map.SizeToFit();
+}
+
+void NameToDIE::Clear() {
+  // Free the memory too, the maps of an evicted index are cleared.
+  m_map.Clear();
   m_map.SizeToFit();
+  std::vector<NameEntry>().swap(m_names);
+  std::vector<DIERef>().swap(m_values);
+}
+
+size_t NameToDIE::MemorySize() const {
+  return m_map.MemorySize() + m_names.capacity() * sizeof(NameEntry) +
+         m_values.capacity() * sizeof(DIERef);
 }
 
 void NameToDIE::Insert(ConstString name, const DIERef &die_ref) {
+  assert(m_names.empty() && "inserting into a finalized NameToDIE");
   m_map.Append(name, die_ref);
 }
 
 size_t NameToDIE::Find(ConstString name, DIEArray &info_array) const {
-  return m_map.GetValues(name, info_array);
+  auto pos = llvm::lower_bound(
+      m_names, name, [](const NameEntry &entry, ConstString name) {
+        return uintptr_t(entry.name.GetCString()) <
+               uintptr_t(name.GetCString());
+      });
+  if (pos == m_names.end() || pos->name != name)
+    return 0;
+  llvm::ArrayRef<DIERef> values = GetValues(*pos);
+  info_array.insert(info_array.end(), values.begin(), values.end());
+  return values.size();
 }
 
 size_t NameToDIE::Find(const RegularExpression &regex,
                        DIEArray &info_array) const {
-  return m_map.GetValues(regex, info_array);
+  const size_t initial_size = info_array.size();
+  const llvm::StringRef prefix = regex.GetLiteralPrefix();
+
+  // Matching a regular expression against every name of a large module is
+  // slow, so split the names into shards that are matched in parallel.
+  // Names that don't start with the expression's literal prefix can't match
+  // and are rejected without running the expression.
+  const size_t shard_size = 16384;
+  const size_t num_shards = (m_names.size() + shard_size - 1) / shard_size;
+  std::vector<std::vector<uint32_t>> shard_matches(num_shards);
+  auto match_shard = [&](size_t shard) {
+    const size_t end = std::min(m_names.size(), (shard + 1) * shard_size);
+    for (size_t i = shard * shard_size; i < end; ++i) {
+      llvm::StringRef name = m_names[i].name.GetStringRef();
+      if (name.startswith(prefix) && regex.Execute(name))
+        shard_matches[shard].push_back(i);
+    }
+  };
+  if (num_shards > 1)
+    TaskMapOverInt(0, num_shards, match_shard);
+  else if (num_shards == 1)
+    match_shard(0);
+
+  for (const std::vector<uint32_t> &matches : shard_matches) {
+    for (uint32_t i : matches) {
+      llvm::ArrayRef<DIERef> values = GetValues(m_names[i]);
+      info_array.insert(info_array.end(), values.begin(), values.end());
+    }
+  }
+  return info_array.size() - initial_size;
 }
 
 size_t NameToDIE::FindAllEntriesForUnit(const DWARFUnit &unit,
                                         DIEArray &info_array) const {
   const size_t initial_size = info_array.size();
-  const uint32_t size = m_map.GetSize();
-  for (uint32_t i = 0; i < size; ++i) {
-    const DIERef &die_ref = m_map.GetValueAtIndexUnchecked(i);
+  for (const DIERef &die_ref : m_values) {
     if (unit.GetSymbolFileDWARF().GetDwoNum() == die_ref.dwo_num() &&
         unit.GetDebugSection() == die_ref.section() &&
         unit.GetOffset() <= die_ref.die_offset() &&
@@ -51,28 +119,68 @@ size_t NameToDIE::FindAllEntriesForUnit(const DWARFUnit &unit,
 }
 
 void NameToDIE::Dump(Stream *s) {
-  const uint32_t size = m_map.GetSize();
-  for (uint32_t i = 0; i < size; ++i) {
-    s->Format("{0} \"{1}\"\n", m_map.GetValueAtIndexUnchecked(i),
-              m_map.GetCStringAtIndexUnchecked(i));
+  for (const NameEntry &entry : m_names) {
+    for (const DIERef &die_ref : GetValues(entry))
+      s->Format("{0} \"{1}\"\n", die_ref, entry.name);
   }
 }
 
 void NameToDIE::ForEach(
     std::function<bool(ConstString name, const DIERef &die_ref)> const
         &callback) const {
-  const uint32_t size = m_map.GetSize();
-  for (uint32_t i = 0; i < size; ++i) {
-    if (!callback(m_map.GetCStringAtIndexUnchecked(i),
-                  m_map.GetValueAtIndexUnchecked(i)))
-      break;
+  for (const NameEntry &entry : m_names) {
+    for (const DIERef &die_ref : GetValues(entry)) {
+      if (!callback(entry.name, die_ref))
+        return;
+    }
   }
 }
 
 void NameToDIE::Append(const NameToDIE &other) {
+  assert(m_names.empty() && "appending to a finalized NameToDIE");
   const uint32_t size = other.m_map.GetSize();
   for (uint32_t i = 0; i < size; ++i) {
     m_map.Append(other.m_map.GetCStringAtIndexUnchecked(i),
                  other.m_map.GetValueAtIndexUnchecked(i));
   }
+  for (const NameEntry &entry : other.m_names) {
+    for (const DIERef &die_ref : other.GetValues(entry))
+      m_map.Append(entry.name, die_ref);
+  }
+}
+
+void NameToDIE::Encode(Stream &s, ConstStringTable &strtab) const {
+  s.PutHex32(m_names.size());
+  for (const NameEntry &entry : m_names) {
+    s.PutHex32(strtab.Add(entry.name));
+    s.PutHex32(entry.count);
+    for (const DIERef &die_ref : GetValues(entry))
+      die_ref.Encode(s);
+  }
+}
+
+bool NameToDIE::Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
+                       const ConstStringTable &strtab) {
+  Clear();
+  if (!data.ValidOffsetForDataOfSize(*offset_ptr, 4))
+    return false;
+  const uint32_t num_names = data.GetU32(offset_ptr);
+  for (uint32_t i = 0; i < num_names; ++i) {
+    if (!data.ValidOffsetForDataOfSize(*offset_ptr, 8))
+      return false;
+    ConstString name = strtab.Get(data.GetU32(offset_ptr));
+    const uint32_t count = data.GetU32(offset_ptr);
+    if (!name)
+      return false;
+    for (uint32_t j = 0; j < count; ++j) {
+      llvm::Optional<DIERef> die_ref = DIERef::Decode(data, offset_ptr);
+      if (!die_ref)
+        return false;
+      m_map.Append(name, *die_ref);
+    }
+  }
+  // The names are sorted by their string pool address, which differs
+  // between sessions, so the map has to be sorted again.
+  Finalize();
+  return true;
 }
@@ -14,10 +14,17 @@
 #include "DIERef.h"
 #include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/Core/dwarf.h"
+#include "lldb/Utility/ConstStringTable.h"
 #include "lldb/lldb-defines.h"
+#include "llvm/ADT/ArrayRef.h"
 
 class DWARFUnit;
 
+namespace lldb_private {
+class DataExtractor;
+class Stream;
+} // namespace lldb_private
+
 class NameToDIE {
 public:
   NameToDIE() : m_map() {}
@@ -26,12 +33,21 @@ public:
 
   void Dump(lldb_private::Stream *s);
 
+  /// Add \a die_ref under \a name. Entries can only be added before the map
+  /// is finalized.
   void Insert(lldb_private::ConstString name, const DIERef &die_ref);
 
   void Append(const NameToDIE &other);
 
+  /// Sort the entries and move them into the compact lookup tables. All of
+  /// the lookup functions below require the map to be finalized.
   void Finalize();
 
+  void Clear();
+
+  /// The memory held by this map, not counting the names.
+  size_t MemorySize() const;
+
   size_t Find(lldb_private::ConstString name,
               DIEArray &info_array) const;
 
@@ -46,8 +62,37 @@ public:
                              const DIERef &die_ref)> const
               &callback) const;
 
+  /// Write the contents of this map to the binary stream \a s. Names are
+  /// added to \a strtab, which has to be encoded separately.
+  void Encode(lldb_private::Stream &s,
+              lldb_private::ConstStringTable &strtab) const;
+
+  /// Replace the contents of this map with the data written by Encode().
+  /// The resulting map is finalized.
+  bool Decode(const lldb_private::DataExtractor &data,
+              lldb::offset_t *offset_ptr,
+              const lldb_private::ConstStringTable &strtab);
+
 protected:
+  struct NameEntry {
+    lldb_private::ConstString name;
+    /// The DIERefs of this name are m_values[first, first + count).
+    uint32_t first;
+    uint32_t count;
+  };
+
+  llvm::ArrayRef<DIERef> GetValues(const NameEntry &entry) const {
+    return llvm::makeArrayRef(m_values).slice(entry.first, entry.count);
+  }
+
+  /// The entries added so far, only used until the map is finalized.
   lldb_private::UniqueCStringMap<DIERef> m_map;
+  /// One entry for every distinct name, sorted by the address of the name in
+  /// the string pool, so a lookup binary searches a dense array which only
+  /// contains each name once.
+  std::vector<NameEntry> m_names;
+  /// The DIERefs of all names, grouped by name.
+  DIEArray m_values;
 };
 
 #endif // SymbolFileDWARF_NameToDIE_h_
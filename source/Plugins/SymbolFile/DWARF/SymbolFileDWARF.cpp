@@ -29,6 +29,7 @@
 
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Host/Host.h"
+#include "lldb/Host/TaskPool.h"
 
 #include "lldb/Interpreter/OptionValueFileSpecList.h"
 #include "lldb/Interpreter/OptionValueProperties.h"
@@ -72,7 +73,9 @@
 #include "SymbolFileDWARFDwp.h"
 
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
+#include "llvm/Support/DJB.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FormatVariadic.h"
 
 #include <algorithm>
 #include <map>
@@ -144,6 +147,22 @@ public:
     return m_collection_sp->GetPropertyAtIndexAsBoolean(
         nullptr, ePropertyIgnoreIndexes, false);
   }
+
+  FileSpec GetIndexCachePath() const {
+    return m_collection_sp->GetPropertyAtIndexAsFileSpec(
+        nullptr, ePropertyIndexCachePath);
+  }
+
+  uint64_t GetIndexDIEMemoryLimit() const {
+    const uint32_t idx = ePropertyIndexDIEMemoryLimit;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64(
+        nullptr, idx, g_symbolfiledwarf_properties[idx].default_uint_value);
+  }
+
+  bool GetLazyMethodCompletion() const {
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(
+        nullptr, ePropertyLazyMethods, false);
+  }
 };
 
 typedef std::shared_ptr<PluginProperties> SymbolFileDWARFPropertiesSP;
@@ -218,6 +237,70 @@ FileSpecList SymbolFileDWARF::GetSymlinkPaths() {
   return GetGlobalPluginProperties()->GetSymLinkPaths();
 }
 
+FileSpec SymbolFileDWARF::GetIndexCachePath() {
+  return GetGlobalPluginProperties()->GetIndexCachePath();
+}
+
+uint64_t SymbolFileDWARF::GetIndexDIEMemoryLimit() {
+  return GetGlobalPluginProperties()->GetIndexDIEMemoryLimit();
+}
+
+bool SymbolFileDWARF::GetLazyMethodCompletion() {
+  return GetGlobalPluginProperties()->GetLazyMethodCompletion();
+}
+
+FileSpec SymbolFileDWARF::GetIndexCacheFile(Module &module,
+                                            llvm::StringRef extension) {
+  FileSpec cache_dir = GetIndexCachePath();
+  if (!cache_dir)
+    return FileSpec();
+
+  const UUID &uuid = module.GetUUID();
+  if (!uuid.IsValid())
+    return FileSpec();
+
+  std::string name = uuid.GetAsString("");
+  // Several objects of the same archive may share a UUID.
+  if (ConstString object_name = module.GetObjectName())
+    name += llvm::formatv("-{0:x-8}", llvm::djbHash(object_name.GetStringRef()))
+                .str();
+  name += extension;
+  cache_dir.AppendPathComponent(name);
+  return cache_dir;
+}
+
+bool SymbolFileDWARF::WriteIndexCacheFile(const FileSpec &cache_file,
+                                          llvm::StringRef contents) {
+  Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO);
+
+  std::string cache_dir = cache_file.GetDirectory().GetStringRef().str();
+  if (std::error_code ec = llvm::sys::fs::create_directories(cache_dir)) {
+    LLDB_LOG(log, "failed to create DWARF index cache directory {0}: {1}",
+             cache_dir, ec.message());
+    return false;
+  }
+  int fd;
+  llvm::SmallString<128> tmp_path;
+  if (std::error_code ec = llvm::sys::fs::createUniqueFile(
+          cache_file.GetPath() + "-%%%%%%", fd, tmp_path)) {
+    LLDB_LOG(log, "failed to create DWARF index cache file: {0}",
+             ec.message());
+    return false;
+  }
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os << contents;
+  }
+  if (std::error_code ec =
+          llvm::sys::fs::rename(tmp_path, cache_file.GetPath())) {
+    LLDB_LOG(log, "failed to write DWARF index cache file {0}: {1}",
+             cache_file, ec.message());
+    llvm::sys::fs::remove(tmp_path);
+    return false;
+  }
+  return true;
+}
+
 static inline bool IsSwiftLanguage(LanguageType language) {
   return language == eLanguageTypePLI || language == eLanguageTypeSwift ||
          ((uint32_t)language == (uint32_t)llvm::dwarf::DW_LANG_Swift);
@@ -605,23 +688,23 @@ const DWARFDataExtractor &SymbolFileDWARF::get_debug_loclists_data() {
 }
 
 DWARFDebugAbbrev *SymbolFileDWARF::DebugAbbrev() {
-  if (m_abbr)
-    return m_abbr.get();
-
-  const DWARFDataExtractor &debug_abbrev_data = m_context.getOrLoadAbbrevData();
-  if (debug_abbrev_data.GetByteSize() == 0)
-    return nullptr;
+  llvm::call_once(m_abbr_once, [this] {
+    const DWARFDataExtractor &debug_abbrev_data =
+        m_context.getOrLoadAbbrevData();
+    if (debug_abbrev_data.GetByteSize() == 0)
+      return;
 
-  auto abbr = std::make_unique<DWARFDebugAbbrev>();
-  llvm::Error error = abbr->parse(debug_abbrev_data);
-  if (error) {
-    Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO);
-    LLDB_LOG_ERROR(log, std::move(error),
-                   "Unable to read .debug_abbrev section: {0}");
-    return nullptr;
-  }
+    auto abbr = std::make_unique<DWARFDebugAbbrev>();
+    llvm::Error error = abbr->parse(debug_abbrev_data);
+    if (error) {
+      Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO);
+      LLDB_LOG_ERROR(log, std::move(error),
+                     "Unable to read .debug_abbrev section: {0}");
+      return;
+    }
 
-  m_abbr = std::move(abbr);
+    m_abbr = std::move(abbr);
+  });
   return m_abbr.get();
 }
 
@@ -630,13 +713,13 @@ const DWARFDebugAbbrev *SymbolFileDWARF::DebugAbbrev() const {
 }
 
 DWARFDebugInfo *SymbolFileDWARF::DebugInfo() {
-  if (m_info == nullptr) {
+  llvm::call_once(m_info_once, [this] {
     static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
     Timer scoped_timer(func_cat, "%s this = %p", LLVM_PRETTY_FUNCTION,
                        static_cast<void *>(this));
     if (m_context.getOrLoadDebugInfoData().GetByteSize() > 0)
       m_info = std::make_unique<DWARFDebugInfo>(*this, m_context);
-  }
+  });
   return m_info.get();
 }
 
@@ -1442,8 +1525,10 @@ bool SymbolFileDWARF::CompleteType(CompilerType &compiler_type) {
           type->GetName().AsCString());
     assert(compiler_type);
     DWARFASTParser *dwarf_ast = dwarf_die.GetDWARFParser();
-    if (dwarf_ast)
+    if (dwarf_ast) {
+      ++m_num_types_completed;
       return dwarf_ast->CompleteTypeFromDWARF(dwarf_die, type, compiler_type);
+    }
   }
   return false;
 }
@@ -1532,6 +1617,28 @@ SymbolFileDWARF::GetDIE(const DIERef &die_ref) {
     return DWARFDIE();
 }
 
+static FileSpec GetDwoFileSpec(DWARFCompileUnit &dwarf_cu,
+                               const DWARFDebugInfoEntry &cu_die) {
+  const char *dwo_name =
+      cu_die.GetAttributeValueAsString(&dwarf_cu, DW_AT_GNU_dwo_name, nullptr);
+  if (!dwo_name)
+    return FileSpec();
+
+  FileSpec dwo_file(dwo_name);
+  FileSystem::Instance().Resolve(dwo_file);
+  if (dwo_file.IsRelative()) {
+    const char *comp_dir =
+        cu_die.GetAttributeValueAsString(&dwarf_cu, DW_AT_comp_dir, nullptr);
+    if (!comp_dir)
+      return FileSpec();
+
+    dwo_file.SetFile(comp_dir, FileSpec::Style::native);
+    FileSystem::Instance().Resolve(dwo_file);
+    dwo_file.AppendPathComponent(dwo_name);
+  }
+  return dwo_file;
+}
+
 std::unique_ptr<SymbolFileDWARFDwo>
 SymbolFileDWARF::GetDwoSymbolFileForCompileUnit(
     DWARFUnit &unit, const DWARFDebugInfoEntry &cu_die) {
@@ -1561,25 +1668,21 @@ SymbolFileDWARF::GetDwoSymbolFileForCompileUnit(
       return dwo_symfile;
   }
 
-  FileSpec dwo_file(dwo_name);
-  FileSystem::Instance().Resolve(dwo_file);
-  if (dwo_file.IsRelative()) {
-    const char *comp_dir =
-        cu_die.GetAttributeValueAsString(dwarf_cu, DW_AT_comp_dir, nullptr);
-    if (!comp_dir)
-      return nullptr;
-
-    dwo_file.SetFile(comp_dir, FileSpec::Style::native);
-    FileSystem::Instance().Resolve(dwo_file);
-    dwo_file.AppendPathComponent(dwo_name);
-  }
-
-  if (!FileSystem::Instance().Exists(dwo_file))
+  FileSpec dwo_file = GetDwoFileSpec(*dwarf_cu, cu_die);
+  if (!dwo_file || !FileSystem::Instance().Exists(dwo_file))
     return nullptr;
 
   const lldb::offset_t file_offset = 0;
   DataBufferSP dwo_file_data_sp;
   lldb::offset_t dwo_file_data_offset = 0;
+  {
+    std::lock_guard<std::mutex> guard(m_prefetched_dwo_data_mutex);
+    auto pos = m_prefetched_dwo_data.find(dwo_file.GetPath());
+    if (pos != m_prefetched_dwo_data.end()) {
+      dwo_file_data_sp = std::move(pos->second);
+      m_prefetched_dwo_data.erase(pos);
+    }
+  }
   ObjectFileSP dwo_obj_file = ObjectFile::FindPlugin(
       GetObjectFile()->GetModule(), &dwo_file, file_offset,
       FileSystem::Instance().GetByteSize(dwo_file), dwo_file_data_sp,
@@ -1590,6 +1693,52 @@ SymbolFileDWARF::GetDwoSymbolFileForCompileUnit(
   return std::make_unique<SymbolFileDWARFDwo>(dwo_obj_file, *dwarf_cu);
 }
 
+void SymbolFileDWARF::PrefetchDwoFiles(llvm::ArrayRef<DWARFUnit *> units) {
+  // A .dwp file holds the units of all .dwo files, and is opened only once.
+  if (GetDebugMapSymfile() || GetDwpSymbolFile())
+    return;
+
+  // Only the unit DIE is needed to find the .dwo file, parse it on the side
+  // so the .dwo file isn't opened yet.
+  std::vector<std::string> dwo_paths;
+  for (DWARFUnit *unit : units) {
+    DWARFCompileUnit *dwarf_cu = llvm::dyn_cast<DWARFCompileUnit>(unit);
+    if (!dwarf_cu || dwarf_cu->GetDwoSymbolFile())
+      continue;
+    DWARFDebugInfoEntry cu_die;
+    lldb::offset_t offset = dwarf_cu->GetFirstDIEOffset();
+    if (offset >= dwarf_cu->GetNextUnitOffset() ||
+        !cu_die.Extract(dwarf_cu->GetData(), dwarf_cu, &offset))
+      continue;
+    FileSpec dwo_file = GetDwoFileSpec(*dwarf_cu, cu_die);
+    if (dwo_file)
+      dwo_paths.push_back(dwo_file.GetPath());
+  }
+  if (dwo_paths.empty())
+    return;
+
+  std::vector<DataBufferSP> dwo_data(dwo_paths.size());
+  TaskMapOverInt(0, dwo_paths.size(), [&](size_t i) {
+    DataBufferSP data_sp = FileSystem::Instance().CreateDataBuffer(dwo_paths[i]);
+    if (!data_sp)
+      return;
+    // The file may be mapped rather than read, touch every page so it is
+    // read here and not when the symbol file parses it.
+    const uint8_t *bytes = data_sp->GetBytes();
+    const size_t size = data_sp->GetByteSize();
+    uint8_t sum = 0;
+    for (size_t offset = 0; offset < size; offset += 4096)
+      sum += *static_cast<const volatile uint8_t *>(bytes + offset);
+    (void)sum;
+    dwo_data[i] = std::move(data_sp);
+  });
+
+  std::lock_guard<std::mutex> guard(m_prefetched_dwo_data_mutex);
+  for (size_t i = 0; i < dwo_paths.size(); ++i)
+    if (dwo_data[i])
+      m_prefetched_dwo_data[dwo_paths[i]] = std::move(dwo_data[i]);
+}
+
 void SymbolFileDWARF::UpdateExternalModuleListIfNeeded() {
   if (m_fetched_external_modules)
     return;
@@ -1731,17 +1880,17 @@ uint32_t SymbolFileDWARF::ResolveSymbolContext(const Address &so_addr,
 
     DWARFDebugInfo *debug_info = DebugInfo();
     if (debug_info) {
-      llvm::Expected<DWARFDebugAranges &> aranges =
-          debug_info->GetCompileUnitAranges();
-      if (!aranges) {
+      llvm::Expected<dw_offset_t> cu_offset_or_err =
+          debug_info->FindCompileUnitOffset(file_vm_addr);
+      if (!cu_offset_or_err) {
         Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO);
-        LLDB_LOG_ERROR(log, aranges.takeError(),
+        LLDB_LOG_ERROR(log, cu_offset_or_err.takeError(),
                        "SymbolFileDWARF::ResolveSymbolContext failed to get cu "
                        "aranges.  {0}");
         return 0;
       }
 
-      const dw_offset_t cu_offset = aranges->FindAddress(file_vm_addr);
+      const dw_offset_t cu_offset = *cu_offset_or_err;
       if (cu_offset == DW_INVALID_OFFSET) {
         // Global variables are not in the compile unit address ranges. The
         // only way to currently find global variables is to iterate over the
@@ -2385,7 +2534,6 @@ uint32_t SymbolFileDWARF::FindTypes(
     uint32_t max_matches,
     llvm::DenseSet<lldb_private::SymbolFile *> &searched_symbol_files,
     TypeMap &types) {
-  std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
   // If we aren't appending the results to this list, then clear the list
   if (!append)
     types.Clear();
@@ -2400,6 +2548,23 @@ uint32_t SymbolFileDWARF::FindTypes(
   if (info == nullptr)
     return 0;
 
+  // Searching the index and extracting the DIEs it points to doesn't touch
+  // the type system, so it is done before taking the module mutex. This lets
+  // lookups on other threads build the index or parse the DIEs of other units
+  // in the meantime.
+  DIEArray die_offsets;
+  m_index->GetTypes(name, die_offsets);
+  std::vector<DWARFDIE> dies;
+  dies.reserve(die_offsets.size());
+  for (const DIERef &die_ref : die_offsets) {
+    if (DWARFDIE die = GetDIE(die_ref))
+      dies.push_back(die);
+    else
+      m_index->ReportInvalidDIERef(die_ref, name.GetStringRef());
+  }
+
+  std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
+
   Log *log(LogChannelDWARF::GetLogIfAll(DWARF_LOG_LOOKUPS));
 
   if (log) {
@@ -2421,30 +2586,21 @@ uint32_t SymbolFileDWARF::FindTypes(
   if (!DeclContextMatchesThisSymbolFile(parent_decl_ctx))
     return 0;
 
-  DIEArray die_offsets;
-  m_index->GetTypes(name, die_offsets);
   const size_t num_die_matches = die_offsets.size();
 
   if (num_die_matches) {
     const uint32_t initial_types_size = types.GetSize();
-    for (size_t i = 0; i < num_die_matches; ++i) {
-      const DIERef &die_ref = die_offsets[i];
-      DWARFDIE die = GetDIE(die_ref);
+    for (const DWARFDIE &die : dies) {
+      if (!DIEInDeclContext(parent_decl_ctx, die))
+        continue; // The containing decl contexts don't match
 
-      if (die) {
-        if (!DIEInDeclContext(parent_decl_ctx, die))
-          continue; // The containing decl contexts don't match
-
-        Type *matching_type = ResolveType(die, true, true);
-        if (matching_type) {
-          // We found a type pointer, now find the shared pointer form our type
-          // list
-          types.InsertUnique(matching_type->shared_from_this());
-          if (types.GetSize() >= max_matches)
-            break;
-        }
-      } else {
-        m_index->ReportInvalidDIERef(die_ref, name.GetStringRef());
+      Type *matching_type = ResolveType(die, true, true);
+      if (matching_type) {
+        // We found a type pointer, now find the shared pointer form our type
+        // list
+        types.InsertUnique(matching_type->shared_from_this());
+        if (types.GetSize() >= max_matches)
+          break;
       }
     }
     const uint32_t num_matches = types.GetSize() - initial_types_size;
@@ -2494,7 +2650,6 @@ uint32_t SymbolFileDWARF::FindTypes(
 size_t SymbolFileDWARF::FindTypes(llvm::ArrayRef<CompilerContext> pattern,
                                   LanguageSet languages, bool append,
                                   TypeMap &types) {
-  std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
   if (!append)
     types.Clear();
 
@@ -2506,33 +2661,35 @@ size_t SymbolFileDWARF::FindTypes(llvm::ArrayRef<CompilerContext> pattern,
   if (!name)
     return 0;
 
+  // Matching the DWARF decl contexts doesn't touch the type system, so only
+  // resolving the matching types needs the module mutex.
   DIEArray die_offsets;
   m_index->GetTypes(name, die_offsets);
-  const size_t num_die_matches = die_offsets.size();
-
-  size_t num_matches = 0;
-  for (size_t i = 0; i < num_die_matches; ++i) {
-    const DIERef &die_ref = die_offsets[i];
+  std::vector<DWARFDIE> dies;
+  for (const DIERef &die_ref : die_offsets) {
     DWARFDIE die = GetDIE(die_ref);
+    if (!die) {
+      m_index->ReportInvalidDIERef(die_ref, name.GetStringRef());
+      continue;
+    }
+    llvm::SmallVector<CompilerContext, 4> die_context;
+    die.GetDeclContext(die_context);
+    if (contextMatches(die_context, pattern))
+      dies.push_back(die);
+  }
 
-    if (die) {
-      if (!languages[die.GetCU()->GetLanguageType()])
-        continue;
-
-      llvm::SmallVector<CompilerContext, 4> die_context;
-      die.GetDeclContext(die_context);
-      if (!contextMatches(die_context, pattern))
-        continue;
+  std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
+  size_t num_matches = 0;
+  for (const DWARFDIE &die : dies) {
+    if (!languages[die.GetCU()->GetLanguageType()])
+      continue;
 
-      Type *matching_type = ResolveType(die, true, true);
-      if (matching_type) {
-        // We found a type pointer, now find the shared pointer form our type
-        // list
-        types.InsertUnique(matching_type->shared_from_this());
-        ++num_matches;
-      }
-    } else {
-      m_index->ReportInvalidDIERef(die_ref, name.GetStringRef());
+    Type *matching_type = ResolveType(die, true, true);
+    if (matching_type) {
+      // We found a type pointer, now find the shared pointer form our type
+      // list
+      types.InsertUnique(matching_type->shared_from_this());
+      ++num_matches;
     }
   }
 
@@ -3263,6 +3420,26 @@ size_t SymbolFileDWARF::ParseVariablesForContext(const SymbolContext &sc) {
 
       const dw_addr_t func_lo_pc = function_die.GetAttributeValueAsAddress(
           DW_AT_low_pc, LLDB_INVALID_ADDRESS);
+      if (func_lo_pc != LLDB_INVALID_ADDRESS && sc.block) {
+        // Only parse the variables of this block, its child blocks are
+        // parsed when their variables are asked for.
+        size_t num_variables = 0;
+        DWARFDIE block_die = GetDIE(sc.block->GetID());
+        for (DWARFDIE child = block_die.GetFirstChild(); child;
+             child = child.GetSibling()) {
+          switch (child.Tag()) {
+          case DW_TAG_subprogram:
+          case DW_TAG_inlined_subroutine:
+          case DW_TAG_lexical_block:
+            break;
+          default:
+            num_variables += ParseVariables(sc, child, func_lo_pc, false, true);
+            break;
+          }
+        }
+        sc.block->SetDidParseVariables(true, false);
+        return num_variables;
+      }
       if (func_lo_pc != LLDB_INVALID_ADDRESS) {
         const size_t num_variables = ParseVariables(
             sc, function_die.GetFirstChild(), func_lo_pc, true, true);
@@ -3931,6 +4108,88 @@ void SymbolFileDWARF::Dump(lldb_private::Stream &s) {
   m_index->Dump(s);
 }
 
+static uint64_t GetDWARFSectionsSize(const SectionList &section_list) {
+  uint64_t size = 0;
+  for (size_t idx = 0, num = section_list.GetSize(); idx < num; ++idx) {
+    SectionSP section_sp = section_list.GetSectionAtIndex(idx);
+    if (!section_sp)
+      continue;
+    size += GetDWARFSectionsSize(section_sp->GetChildren());
+    switch (section_sp->GetType()) {
+    case eSectionTypeDWARFDebugAbbrev:
+    case eSectionTypeDWARFDebugAddr:
+    case eSectionTypeDWARFDebugAranges:
+    case eSectionTypeDWARFDebugCuIndex:
+    case eSectionTypeDWARFDebugFrame:
+    case eSectionTypeDWARFDebugInfo:
+    case eSectionTypeDWARFDebugLine:
+    case eSectionTypeDWARFDebugLoc:
+    case eSectionTypeDWARFDebugMacInfo:
+    case eSectionTypeDWARFDebugMacro:
+    case eSectionTypeDWARFDebugPubNames:
+    case eSectionTypeDWARFDebugPubTypes:
+    case eSectionTypeDWARFDebugRanges:
+    case eSectionTypeDWARFDebugStr:
+    case eSectionTypeDWARFDebugStrOffsets:
+    case eSectionTypeDWARFAppleNames:
+    case eSectionTypeDWARFAppleTypes:
+    case eSectionTypeDWARFAppleNamespaces:
+    case eSectionTypeDWARFAppleObjC:
+    case eSectionTypeDWARFDebugTypes:
+    case eSectionTypeDWARFDebugNames:
+    case eSectionTypeDWARFDebugLineStr:
+    case eSectionTypeDWARFDebugRngLists:
+    case eSectionTypeDWARFDebugLocLists:
+    case eSectionTypeDWARFDebugAbbrevDwo:
+    case eSectionTypeDWARFDebugInfoDwo:
+    case eSectionTypeDWARFDebugStrDwo:
+    case eSectionTypeDWARFDebugStrOffsetsDwo:
+    case eSectionTypeDWARFDebugTypesDwo:
+      size += section_sp->GetFileSize();
+      break;
+    default:
+      break;
+    }
+  }
+  return size;
+}
+
+uint64_t SymbolFileDWARF::GetDebugInfoSize() {
+  SectionList *section_list = m_objfile_sp->GetSectionList();
+  return section_list ? GetDWARFSectionsSize(*section_list) : 0;
+}
+
+double SymbolFileDWARF::GetDebugInfoIndexTime() {
+  return m_index ? m_index->GetIndexTime().get() : 0;
+}
+
+uint64_t SymbolFileDWARF::GetDebugInfoMemoryUsage() {
+  std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
+  uint64_t usage = m_die_to_type.getMemorySize() +
+                   m_die_to_variable_sp.getMemorySize() +
+                   m_forward_decl_die_to_clang_type.getMemorySize();
+  if (DWARFDebugInfo *info = DebugInfo()) {
+    for (size_t idx = 0, num = info->GetNumUnits(); idx < num; ++idx) {
+      DWARFUnit *unit = info->GetUnitAtIndex(idx);
+      usage += unit->GetDIEMemoryUsage();
+      // The .dwo files keep their types and variables in our maps.
+      if (SymbolFileDWARFDwo *dwo_symbol_file = unit->GetDwoSymbolFile())
+        usage += dwo_symbol_file->GetDebugInfoMemoryUsage();
+    }
+  }
+  return usage;
+}
+
+uint64_t SymbolFileDWARF::GetDebugInfoIndexMemoryUsage() {
+  return m_index ? m_index->GetMemoryUsage() : 0;
+}
+
+void SymbolFileDWARF::ReleaseCaches() {
+  // .dwo files that were read ahead are simply read again when needed.
+  std::lock_guard<std::mutex> guard(m_prefetched_dwo_data_mutex);
+  m_prefetched_dwo_data.clear();
+}
+
 void SymbolFileDWARF::DumpClangAST(Stream &s) {
   auto ts_or_err = GetTypeSystemForLanguage(eLanguageTypeC_plus_plus);
   if (!ts_or_err)
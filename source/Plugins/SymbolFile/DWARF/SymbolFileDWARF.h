@@ -9,6 +9,7 @@
 #ifndef SymbolFileDWARF_SymbolFileDWARF_h_
 #define SymbolFileDWARF_SymbolFileDWARF_h_
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <mutex>
@@ -16,7 +17,9 @@
 #include <unordered_map>
 #include <vector>
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Threading.h"
 
 #include "lldb/Core/UniqueCStringMap.h"
@@ -84,6 +87,28 @@ public:
 
   static lldb_private::FileSpecList GetSymlinkPaths();
 
+  static lldb_private::FileSpec GetIndexCachePath();
+
+  /// The number of bytes of DIEs manual indexing may keep extracted until
+  /// every unit is indexed, or 0 for no limit.
+  static uint64_t GetIndexDIEMemoryLimit();
+
+  /// Whether C++ classes are completed without their ordinary methods, which
+  /// are then created when they are looked up.
+  static bool GetLazyMethodCompletion();
+
+  /// Get the file in the index cache directory holding the data of \a module
+  /// that has the given \a extension. Returns an empty FileSpec if the cache
+  /// is disabled or \a module has no UUID to identify it.
+  static lldb_private::FileSpec
+  GetIndexCacheFile(lldb_private::Module &module, llvm::StringRef extension);
+
+  /// Replace \a cache_file with \a contents. A temporary file is renamed
+  /// into place, so concurrent debugger instances never observe a partially
+  /// written file. Returns false if the file couldn't be written.
+  static bool WriteIndexCacheFile(const lldb_private::FileSpec &cache_file,
+                                  llvm::StringRef contents);
+
   // Constructors and Destructors
 
   SymbolFileDWARF(lldb::ObjectFileSP objfile_sp,
@@ -287,6 +312,11 @@ public:
   GetDwoSymbolFileForCompileUnit(DWARFUnit &dwarf_cu,
                                  const DWARFDebugInfoEntry &cu_die);
 
+  /// Read the .dwo files of \a units into memory in parallel, so that
+  /// GetDwoSymbolFileForCompileUnit, which opens them one at a time, doesn't
+  /// wait for the disk.
+  void PrefetchDwoFiles(llvm::ArrayRef<DWARFUnit *> units);
+
   // For regular SymbolFileDWARF instances the method returns nullptr,
   // for the instances of the subclass SymbolFileDWARFDwo
   // the method returns a pointer to the base compile unit.
@@ -305,6 +335,18 @@ public:
 
   void DumpClangAST(lldb_private::Stream &s) override;
 
+  uint64_t GetDebugInfoSize() override;
+
+  double GetDebugInfoIndexTime() override;
+
+  uint64_t GetNumTypesCompleted() override { return m_num_types_completed; }
+
+  uint64_t GetDebugInfoMemoryUsage() override;
+
+  uint64_t GetDebugInfoIndexMemoryUsage() override;
+
+  void ReleaseCaches() override;
+
   lldb_private::DWARFContext &GetDWARFContext() { return m_context; }
 
   lldb_private::FileSpec GetFile(DWARFUnit &unit, size_t file_idx);
@@ -475,15 +517,24 @@ protected:
   llvm::once_flag m_dwp_symfile_once_flag;
   std::unique_ptr<SymbolFileDWARFDwp> m_dwp_symfile;
 
+  std::mutex m_prefetched_dwo_data_mutex;
+  /// The contents of the .dwo files read by PrefetchDwoFiles, by path, until
+  /// they are opened.
+  llvm::StringMap<lldb::DataBufferSP> m_prefetched_dwo_data;
+
   lldb_private::DWARFContext m_context;
 
   DWARFDataSegment m_data_debug_loc;
   DWARFDataSegment m_data_debug_loclists;
 
   // The unique pointer items below are generated on demand if and when someone
-  // accesses them through a non const version of this class.
+  // accesses them through a non const version of this class. The debug info
+  // and abbreviations are guarded by once flags, as type lookups reach them
+  // without holding the module mutex.
   std::unique_ptr<DWARFDebugAbbrev> m_abbr;
+  llvm::once_flag m_abbr_once;
   std::unique_ptr<DWARFDebugInfo> m_info;
+  llvm::once_flag m_info_once;
   std::unique_ptr<GlobalVariableMap> m_global_aranges_up;
   std::unique_ptr<lldb_private::ClangASTImporter> m_clang_ast_importer_up;
 
@@ -493,6 +544,7 @@ protected:
 
   ExternalTypeModuleMap m_external_type_modules;
   std::unique_ptr<lldb_private::DWARFIndex> m_index;
+  std::atomic<uint64_t> m_num_types_completed{0};
   bool m_fetched_external_modules : 1;
   lldb_private::LazyBool m_supports_DW_AT_APPLE_objc_complete_type;
 
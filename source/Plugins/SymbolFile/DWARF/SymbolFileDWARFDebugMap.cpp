@@ -14,6 +14,7 @@
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Host/FileSystem.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Utility/DataBufferLLVM.h"
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/Utility/RegularExpression.h"
@@ -32,6 +33,7 @@
 #include "lldb/Symbol/VariableList.h"
 #include "llvm/Support/ScopedPrinter.h"
 
+#include "DWARFIndex.h"
 #include "LogChannelDWARF.h"
 #include "SymbolFileDWARF.h"
 
@@ -541,6 +543,40 @@ SymbolFileDWARF *SymbolFileDWARFDebugMap::GetSymbolFileByCompUnitInfo(
   return nullptr;
 }
 
+void SymbolFileDWARFDebugMap::PreloadOSOSymbolFiles() {
+  if (m_flags.test(kHavePreloadedOSOs))
+    return;
+  m_flags.set(kHavePreloadedOSOs);
+
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat,
+                     "SymbolFileDWARFDebugMap::PreloadOSOSymbolFiles");
+
+  // Creating the OSO modules and symbol files updates m_oso_map and takes
+  // module locks, so do that on the current thread. The callers hold the
+  // debug map module lock, which is also the lock of every OSO symbol file,
+  // so the workers must not go through the locking SymbolFile APIs.
+  std::vector<DWARFIndex *> indexes;
+  for (uint32_t oso_idx = 0, num_oso_idxs = m_compile_unit_infos.size();
+       oso_idx < num_oso_idxs; ++oso_idx) {
+    SymbolFileDWARF *oso_dwarf = GetSymbolFileByOSOIndex(oso_idx);
+    if (!oso_dwarf || !oso_dwarf->m_index)
+      continue;
+    // The index cache is keyed by the UUID, which is computed lazily under
+    // the OSO module lock.
+    oso_dwarf->GetObjectFile()->GetModule()->GetUUID();
+    indexes.push_back(oso_dwarf->m_index.get());
+  }
+
+  TaskMapOverInt(0, indexes.size(),
+                 [&indexes](size_t idx) { indexes[idx]->Preload(); });
+}
+
+void SymbolFileDWARFDebugMap::PreloadSymbols() {
+  std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
+  PreloadOSOSymbolFiles();
+}
+
 uint32_t SymbolFileDWARFDebugMap::CalculateAbilities() {
   // In order to get the abilities of this plug-in, we look at the list of
   // N_OSO entries (object files) from the symbol table and make sure that
@@ -851,6 +887,7 @@ uint32_t SymbolFileDWARFDebugMap::FindGlobalVariables(
 
   uint32_t total_matches = 0;
 
+  PreloadOSOSymbolFiles();
   ForEachSymbolFile([&](SymbolFileDWARF *oso_dwarf) -> bool {
     const uint32_t oso_matches = oso_dwarf->FindGlobalVariables(
         name, parent_decl_ctx, max_matches, variables);
@@ -886,6 +923,7 @@ SymbolFileDWARFDebugMap::FindGlobalVariables(const RegularExpression &regex,
   const uint32_t original_size = variables.GetSize();
 
   uint32_t total_matches = 0;
+  PreloadOSOSymbolFiles();
   ForEachSymbolFile([&](SymbolFileDWARF *oso_dwarf) -> bool {
     const uint32_t oso_matches =
         oso_dwarf->FindGlobalVariables(regex, max_matches, variables);
@@ -1021,6 +1059,7 @@ uint32_t SymbolFileDWARFDebugMap::FindFunctions(
   else
     sc_list.Clear();
 
+  PreloadOSOSymbolFiles();
   ForEachSymbolFile([&](SymbolFileDWARF *oso_dwarf) -> bool {
     uint32_t sc_idx = sc_list.GetSize();
     if (oso_dwarf->FindFunctions(name, parent_decl_ctx, name_type_mask,
@@ -1050,6 +1089,7 @@ uint32_t SymbolFileDWARFDebugMap::FindFunctions(const RegularExpression &regex,
   else
     sc_list.Clear();
 
+  PreloadOSOSymbolFiles();
   ForEachSymbolFile([&](SymbolFileDWARF *oso_dwarf) -> bool {
     uint32_t sc_idx = sc_list.GetSize();
 
@@ -1216,11 +1256,13 @@ size_t
 SymbolFileDWARFDebugMap::FindTypes(llvm::ArrayRef<CompilerContext> context,
                                    LanguageSet languages, bool append,
                                    TypeMap &types) {
+  std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
   if (!append)
     types.Clear();
 
   const uint32_t initial_types_size = types.GetSize();
 
+  PreloadOSOSymbolFiles();
   ForEachSymbolFile([&](SymbolFileDWARF *oso_dwarf) -> bool {
     oso_dwarf->FindTypes(context, languages, true, types);
     return false;
@@ -1264,6 +1306,63 @@ void SymbolFileDWARFDebugMap::DumpClangAST(Stream &s) {
   });
 }
 
+void SymbolFileDWARFDebugMap::ForEachOpenSymbolFile(
+    llvm::function_ref<void(SymbolFileDWARF &)> closure) {
+  std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
+  for (const CompileUnitInfo &cu_info : m_compile_unit_infos) {
+    if (!cu_info.oso_sp || !cu_info.oso_sp->module_sp)
+      continue;
+    if (SymbolFileDWARF *oso_dwarf = GetSymbolFileAsSymbolFileDWARF(
+            cu_info.oso_sp->module_sp->GetSymbolFile(false)))
+      closure(*oso_dwarf);
+  }
+}
+
+uint64_t SymbolFileDWARFDebugMap::GetDebugInfoSize() {
+  uint64_t size = 0;
+  ForEachOpenSymbolFile([&](SymbolFileDWARF &oso_dwarf) {
+    size += oso_dwarf.GetDebugInfoSize();
+  });
+  return size;
+}
+
+double SymbolFileDWARFDebugMap::GetDebugInfoIndexTime() {
+  double time = 0;
+  ForEachOpenSymbolFile([&](SymbolFileDWARF &oso_dwarf) {
+    time += oso_dwarf.GetDebugInfoIndexTime();
+  });
+  return time;
+}
+
+uint64_t SymbolFileDWARFDebugMap::GetNumTypesCompleted() {
+  uint64_t count = 0;
+  ForEachOpenSymbolFile([&](SymbolFileDWARF &oso_dwarf) {
+    count += oso_dwarf.GetNumTypesCompleted();
+  });
+  return count;
+}
+
+uint64_t SymbolFileDWARFDebugMap::GetDebugInfoMemoryUsage() {
+  uint64_t usage = 0;
+  ForEachOpenSymbolFile([&](SymbolFileDWARF &oso_dwarf) {
+    usage += oso_dwarf.GetDebugInfoMemoryUsage();
+  });
+  return usage;
+}
+
+uint64_t SymbolFileDWARFDebugMap::GetDebugInfoIndexMemoryUsage() {
+  uint64_t usage = 0;
+  ForEachOpenSymbolFile([&](SymbolFileDWARF &oso_dwarf) {
+    usage += oso_dwarf.GetDebugInfoIndexMemoryUsage();
+  });
+  return usage;
+}
+
+void SymbolFileDWARFDebugMap::ReleaseCaches() {
+  ForEachOpenSymbolFile(
+      [](SymbolFileDWARF &oso_dwarf) { oso_dwarf.ReleaseCaches(); });
+}
+
 // PluginInterface protocol
 lldb_private::ConstString SymbolFileDWARFDebugMap::GetPluginName() {
   return GetPluginNameStatic();
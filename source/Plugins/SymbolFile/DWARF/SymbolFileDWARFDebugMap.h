@@ -126,15 +126,29 @@ public:
   std::vector<lldb::DataBufferSP>
   GetASTData(lldb::LanguageType language) override;
 
+  void PreloadSymbols() override;
+
   void DumpClangAST(lldb_private::Stream &s) override;
 
+  uint64_t GetDebugInfoSize() override;
+
+  double GetDebugInfoIndexTime() override;
+
+  uint64_t GetNumTypesCompleted() override;
+
+  uint64_t GetDebugInfoMemoryUsage() override;
+
+  uint64_t GetDebugInfoIndexMemoryUsage() override;
+
+  void ReleaseCaches() override;
+
   // PluginInterface protocol
   lldb_private::ConstString GetPluginName() override;
 
   uint32_t GetPluginVersion() override;
 
 protected:
-  enum { kHaveInitializedOSOs = (1 << 0), kNumFlags };
+  enum { kHaveInitializedOSOs = (1 << 0), kHavePreloadedOSOs, kNumFlags };
 
   friend class DebugMapModule;
   friend class DWARFASTParserClang;
@@ -215,6 +229,16 @@ protected:
 
   SymbolFileDWARF *GetSymbolFileByOSOIndex(uint32_t oso_idx);
 
+  // Open every OSO object file and build the DWARF index of all of them
+  // concurrently. Global lookups call this before visiting each OSO so they
+  // don't open and index the object files one at a time.
+  void PreloadOSOSymbolFiles();
+
+  // Visit the symbol files of the OSOs that have been opened, without opening
+  // the others.
+  void
+  ForEachOpenSymbolFile(llvm::function_ref<void(SymbolFileDWARF &)> closure);
+
   // If closure returns "false", iteration continues.  If it returns
   // "true", iteration terminates.
   void ForEachSymbolFile(std::function<bool(SymbolFileDWARF *)> closure) {
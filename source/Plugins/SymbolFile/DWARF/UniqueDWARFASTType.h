@@ -80,14 +80,15 @@ public:
 
   void Insert(lldb_private::ConstString name,
               const UniqueDWARFASTType &entry) {
-    m_collection[name.GetCString()].Append(entry);
+    m_collection[MakeKey(name, entry.m_die, entry.m_declaration)].Append(
+        entry);
   }
 
   bool Find(lldb_private::ConstString name, const DWARFDIE &die,
             const lldb_private::Declaration &decl, const int32_t byte_size,
             UniqueDWARFASTType &entry) const {
-    const char *unique_name_cstr = name.GetCString();
-    collection::const_iterator pos = m_collection.find(unique_name_cstr);
+    collection::const_iterator pos =
+        m_collection.find(MakeKey(name, die, decl));
     if (pos != m_collection.end()) {
       return pos->second.Find(die, decl, byte_size, entry);
     }
@@ -95,8 +96,18 @@ public:
   }
 
 protected:
-  // A unique name string should be used
-  typedef llvm::DenseMap<const char *, UniqueDWARFASTTypeList> collection;
+  // Types can only be the same if their names, tags and declaration lines
+  // are, so keying by all three keeps the lists Find() searches short when
+  // many compile units declare different types with the same name. A unique
+  // name string should be used.
+  typedef std::pair<const char *, std::pair<uint32_t, uint32_t>> Key;
+  typedef llvm::DenseMap<Key, UniqueDWARFASTTypeList> collection;
+
+  static Key MakeKey(lldb_private::ConstString name, const DWARFDIE &die,
+                     const lldb_private::Declaration &decl) {
+    return Key(name.GetCString(), std::make_pair(die.Tag(), decl.GetLine()));
+  }
+
   collection m_collection;
 };
 
@@ -112,38 +112,60 @@ CompilandIndexItem::CompilandIndexItem(
     : m_id(id), m_debug_stream(std::move(debug_stream)),
       m_module_descriptor(std::move(descriptor)) {}
 
+static bool HasDebugStream(const PDBFile &pdb, uint16_t stream) {
+  return stream != kInvalidStreamIndex && stream < pdb.getNumStreams();
+}
+
 CompilandIndexItem &CompileUnitIndex::GetOrCreateCompiland(uint16_t modi) {
-  auto result = m_comp_units.try_emplace(modi, nullptr);
-  if (!result.second)
-    return *result.first->second;
+  if (CompilandIndexItem *cci = GetCompiland(modi))
+    return *cci;
 
-  // Find the module list and load its debug information stream and cache it
-  // since we need to use it for almost all interesting operations.
   const DbiModuleList &modules = m_index.dbi().modules();
-  llvm::pdb::DbiModuleDescriptor descriptor = modules.getModuleDescriptor(modi);
-  uint16_t stream = descriptor.getModuleStreamIndex();
-  std::unique_ptr<llvm::msf::MappedBlockStream> stream_data =
-      m_index.pdb().createIndexedStream(stream);
-
-
-  std::unique_ptr<CompilandIndexItem>& cci = result.first->second;
+  return AddCompiland(LoadCompiland(modi, modules.getModuleDescriptor(modi)));
+}
 
-  if (!stream_data) {
+std::unique_ptr<CompilandIndexItem>
+CompileUnitIndex::LoadCompiland(
+    uint16_t modi, llvm::pdb::DbiModuleDescriptor descriptor) const {
+  // Load the module's debug information stream and cache it since we need to
+  // use it for almost all interesting operations.  The stream isn't created
+  // through the PDBFile, whose allocator is shared by all streams.
+  const PDBFile &pdb = m_index.pdb();
+  uint16_t stream = descriptor.getModuleStreamIndex();
+  if (!HasDebugStream(pdb, stream)) {
     llvm::pdb::ModuleDebugStreamRef debug_stream(descriptor, nullptr);
-    cci = std::make_unique<CompilandIndexItem>(PdbCompilandId{ modi }, debug_stream, std::move(descriptor));
-    return *cci;
+    return std::make_unique<CompilandIndexItem>(
+        PdbCompilandId{modi}, debug_stream, std::move(descriptor));
   }
 
-  llvm::pdb::ModuleDebugStreamRef debug_stream(descriptor,
-                                               std::move(stream_data));
+  auto allocator = std::make_unique<llvm::BumpPtrAllocator>();
+  llvm::pdb::ModuleDebugStreamRef debug_stream(
+      descriptor,
+      llvm::msf::MappedBlockStream::createIndexedStream(
+          pdb.getMsfLayout(), pdb.getMsfBuffer(), stream, *allocator));
 
   cantFail(debug_stream.reload());
 
-  cci = std::make_unique<CompilandIndexItem>(
+  auto cci = std::make_unique<CompilandIndexItem>(
       PdbCompilandId{modi}, std::move(debug_stream), std::move(descriptor));
+  cci->m_allocator = std::move(allocator);
+  return cci;
+}
+
+CompilandIndexItem &
+CompileUnitIndex::AddCompiland(std::unique_ptr<CompilandIndexItem> item) {
+  uint16_t modi = item->m_id.modi;
+  std::unique_ptr<CompilandIndexItem> &cci = m_comp_units[modi];
+  lldbassert(!cci && "Compile unit is already indexed!");
+  cci = std::move(item);
+
+  if (!HasDebugStream(m_index.pdb(),
+                      cci->m_module_descriptor.getModuleStreamIndex()))
+    return *cci;
+
   ParseExtendedInfo(m_index, *cci);
 
-  cci->m_strings.initialize(debug_stream.getSubsectionsArray());
+  cci->m_strings.initialize(cci->m_debug_stream.getSubsectionsArray());
   PDBStringTable &strings = cantFail(m_index.pdb().getStringTable());
   cci->m_strings.setStrings(strings.getStringTable());
 
@@ -157,6 +179,7 @@ CompilandIndexItem &CompileUnitIndex::GetOrCreateCompiland(uint16_t modi) {
   std::string s = main_file.str();
   llvm::sys::path::native(main_file);
 
+  const DbiModuleList &modules = m_index.dbi().modules();
   uint32_t file_count = modules.getSourceFileCount(modi);
   cci->m_file_list.reserve(file_count);
   bool found_main_file = false;
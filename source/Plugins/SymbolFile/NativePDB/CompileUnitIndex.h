@@ -19,6 +19,7 @@
 #include "llvm/DebugInfo/PDB/Native/DbiModuleDescriptor.h"
 #include "llvm/DebugInfo/PDB/Native/ModuleDebugStream.h"
 #include "llvm/DebugInfo/PDB/PDBTypes.h"
+#include "llvm/Support/Allocator.h"
 
 #include "PdbSymUid.h"
 
@@ -42,6 +43,10 @@ struct CompilandIndexItem {
   // index of this compile unit.
   PdbCompilandId m_id;
 
+  // Backs the records of the debug stream that span several MSF blocks.  Each
+  // compile unit has its own, so their streams can be read concurrently.
+  std::unique_ptr<llvm::BumpPtrAllocator> m_allocator;
+
   // debug stream.
   llvm::pdb::ModuleDebugStreamRef m_debug_stream;
 
@@ -82,6 +87,16 @@ public:
 
   CompilandIndexItem &GetOrCreateCompiland(uint16_t modi);
 
+  /// Load the debug stream of compile unit |modi|, described by |descriptor|,
+  /// without adding it to the index.  This only reads the compile unit's own
+  /// stream, so it may run for several compile units at once.
+  std::unique_ptr<CompilandIndexItem>
+  LoadCompiland(uint16_t modi, llvm::pdb::DbiModuleDescriptor descriptor) const;
+
+  /// Parse the rest of the information about a compile unit loaded by
+  /// LoadCompiland() and add it to the index.
+  CompilandIndexItem &AddCompiland(std::unique_ptr<CompilandIndexItem> cci);
+
   const CompilandIndexItem *GetCompiland(uint16_t modi) const;
 
   CompilandIndexItem *GetCompiland(uint16_t modi);
@@ -20,6 +20,7 @@
 #include "llvm/Object/COFF.h"
 #include "llvm/Support/Error.h"
 
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Utility/LLDBAssert.h"
 #include "lldb/lldb-defines.h"
 
@@ -53,6 +54,10 @@ PdbIndex::create(std::unique_ptr<llvm::pdb::PDBFile> file) {
 
   result->m_tpi->buildHashMap();
 
+  for (const llvm::object::coff_section &cs :
+       result->m_dbi->getSectionHeaders())
+    result->m_section_rvas.push_back(cs.VirtualAddress);
+
   result->m_file = std::move(file);
 
   return std::move(result);
@@ -63,7 +68,7 @@ lldb::addr_t PdbIndex::MakeVirtualAddress(uint16_t segment,
   // Segment indices are 1-based.
   lldbassert(segment > 0);
 
-  uint32_t max_section = dbi().getSectionHeaders().size();
+  uint32_t max_section = m_section_rvas.size();
   lldbassert(segment <= max_section + 1);
 
   // If this is an absolute symbol, it's indicated by the magic section index
@@ -71,8 +76,8 @@ lldb::addr_t PdbIndex::MakeVirtualAddress(uint16_t segment,
   if (segment == max_section + 1)
     return LLDB_INVALID_ADDRESS;
 
-  const llvm::object::coff_section &cs = dbi().getSectionHeaders()[segment - 1];
-  return m_load_address + static_cast<lldb::addr_t>(cs.VirtualAddress) +
+  return m_load_address +
+         static_cast<lldb::addr_t>(m_section_rvas[segment - 1]) +
          static_cast<lldb::addr_t>(offset);
 }
 
@@ -118,6 +123,30 @@ void PdbIndex::ParseSectionContribs() {
   dbi().visitSectionContributions(v);
 }
 
+void PdbIndex::IndexCompilands() {
+  // The module descriptors live in the DBI stream, which can only be read
+  // from one thread at a time.
+  const DbiModuleList &modules = dbi().modules();
+  const uint32_t count = modules.getModuleCount();
+  std::vector<DbiModuleDescriptor> descriptors;
+  descriptors.reserve(count);
+  for (uint32_t modi = 0; modi < count; ++modi)
+    descriptors.push_back(modules.getModuleDescriptor(modi));
+
+  std::vector<std::unique_ptr<CompilandIndexItem>> items(count);
+  TaskMapOverInt(0, count, [&](size_t modi) {
+    if (m_cus.GetCompiland(modi))
+      return;
+    items[modi] = m_cus.LoadCompiland(modi, std::move(descriptors[modi]));
+    BuildAddrToSymbolMap(*items[modi]);
+  });
+
+  // Parsing the rest goes through the shared IPI stream and string table.
+  for (std::unique_ptr<CompilandIndexItem> &item : items)
+    if (item)
+      m_cus.AddCompiland(std::move(item));
+}
+
 void PdbIndex::BuildAddrToSymbolMap(CompilandIndexItem &cci) {
   lldbassert(cci.m_symbols_by_va.empty() &&
              "Addr to symbol map is already built!");
@@ -20,6 +20,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace llvm {
 namespace pdb {
@@ -102,6 +103,10 @@ class PdbIndex {
   /// Maps virtual address to module index
   llvm::IntervalMap<lldb::addr_t, uint16_t> m_va_to_modi;
 
+  /// The relative virtual address of each section, copied out of the DBI
+  /// stream so that addresses can be computed from several threads at once.
+  std::vector<uint32_t> m_section_rvas;
+
   /// The address at which the program has been loaded into memory.
   lldb::addr_t m_load_address = 0;
 
@@ -117,6 +122,10 @@ public:
   lldb::addr_t GetLoadAddress() const { return m_load_address; }
   void ParseSectionContribs();
 
+  /// Load every compile unit and build its address to symbol map up front.
+  /// The module streams are read concurrently.
+  void IndexCompilands();
+
   llvm::pdb::PDBFile &pdb() { return *m_file; }
   const llvm::pdb::PDBFile &pdb() const { return *m_file; }
 
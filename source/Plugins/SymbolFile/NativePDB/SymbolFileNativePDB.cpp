@@ -337,6 +337,11 @@ void SymbolFileNativePDB::InitializeObject() {
   }
 }
 
+void SymbolFileNativePDB::PreloadSymbols() {
+  std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
+  m_index->IndexCompilands();
+}
+
 uint32_t SymbolFileNativePDB::CalculateNumCompileUnits() {
   const DbiModuleList &modules = m_index->dbi().modules();
   uint32_t count = modules.getModuleCount();
@@ -66,6 +66,8 @@ public:
 
   void InitializeObject() override;
 
+  void PreloadSymbols() override;
+
   // Compile Unit function calls
 
   void
@@ -13,6 +13,7 @@
 #include "lldb/Core/DumpDataExtractor.h"
 #include "lldb/Core/DumpRegisterValue.h"
 #include "lldb/Core/FormatEntity.h"
+#include "lldb/Core/Module.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/Process.h"
@@ -35,6 +36,16 @@ bool UnwindAssemblyInstEmulation::GetNonCallSiteUnwindPlanFromAssembly(
   std::vector<uint8_t> function_text(range.GetByteSize());
   ProcessSP process_sp(thread.GetProcess());
   if (process_sp) {
+    // Functions in files on disk are shared with the stepping plans through
+    // the module's instruction cache, so they are only decoded once.
+    if (ModuleSP module_sp = range.GetBaseAddress().GetModule()) {
+      ExecutionContext exe_ctx(process_sp);
+      if (DisassemblerSP disasm_sp = module_sp->GetCachedDisassembly(
+              m_arch, nullptr, nullptr, exe_ctx, range))
+        return GetNonCallSiteUnwindPlanFromDisassembly(range, disasm_sp,
+                                                       unwind_plan);
+    }
+
     Status error;
     const bool prefer_file_cache = true;
     if (process_sp->GetTarget().ReadMemory(
@@ -53,6 +64,17 @@ bool UnwindAssemblyInstEmulation::GetNonCallSiteUnwindPlanFromAssembly(
   if (opcode_data == nullptr || opcode_size == 0)
     return false;
 
+  const bool prefer_file_cache = true;
+  DisassemblerSP disasm_sp(Disassembler::DisassembleBytes(
+      m_arch, nullptr, nullptr, range.GetBaseAddress(), opcode_data,
+      opcode_size, 99999, prefer_file_cache));
+  return GetNonCallSiteUnwindPlanFromDisassembly(range, disasm_sp,
+                                                 unwind_plan);
+}
+
+bool UnwindAssemblyInstEmulation::GetNonCallSiteUnwindPlanFromDisassembly(
+    AddressRange &range, const DisassemblerSP &disasm_sp,
+    UnwindPlan &unwind_plan) {
   if (range.GetByteSize() > 0 && range.GetBaseAddress().IsValid() &&
       m_inst_emulator_up.get()) {
 
@@ -65,11 +87,6 @@ bool UnwindAssemblyInstEmulation::GetNonCallSiteUnwindPlanFromAssembly(
     if (unwind_plan.GetRowCount() == 0)
       return false;
 
-    const bool prefer_file_cache = true;
-    DisassemblerSP disasm_sp(Disassembler::DisassembleBytes(
-        m_arch, nullptr, nullptr, range.GetBaseAddress(), opcode_data,
-        opcode_size, 99999, prefer_file_cache));
-
     Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_UNWIND));
 
     if (disasm_sp) {
@@ -76,6 +76,10 @@ private:
     }
   }
 
+  bool GetNonCallSiteUnwindPlanFromDisassembly(
+      lldb_private::AddressRange &func, const lldb::DisassemblerSP &disasm_sp,
+      lldb_private::UnwindPlan &unwind_plan);
+
   static size_t
   ReadMemory(lldb_private::EmulateInstruction *instruction, void *baton,
              const lldb_private::EmulateInstruction::Context &context,
@@ -663,6 +663,13 @@ void ClangASTContext::Finalize() {
   m_scratch_ast_source_up.reset();
 }
 
+size_t ClangASTContext::GetMemoryUsage() {
+  if (!m_ast_up)
+    return 0;
+  return m_ast_up->getASTAllocatedMemory() +
+         m_ast_up->getSideTableAllocatedMemory();
+}
+
 void ClangASTContext::Clear() {
   m_ast_up.reset();
   m_language_options_up.reset();
@@ -756,7 +763,8 @@ ASTContext *ClangASTContext::getASTContext() {
     llvm::IntrusiveRefCntPtr<clang::ExternalASTSource> ast_source_up(
         new ClangExternalASTSourceCallbacks(
             ClangASTContext::CompleteTagDecl,
-            ClangASTContext::CompleteObjCInterfaceDecl, nullptr,
+            ClangASTContext::CompleteObjCInterfaceDecl,
+            ClangASTContext::FindExternalVisibleDeclsByName,
             ClangASTContext::LayoutRecordType, this));
     SetExternalSource(ast_source_up);
   }
@@ -4617,9 +4625,11 @@ ClangASTContext::GetNumMemberFunctions(lldb::opaque_compiler_type_t type) {
         assert(record_decl);
         const clang::CXXRecordDecl *cxx_record_decl =
             llvm::dyn_cast<clang::CXXRecordDecl>(record_decl);
-        if (cxx_record_decl)
+        if (cxx_record_decl) {
+          CompleteDeferredMethods(cxx_record_decl);
           num_functions = std::distance(cxx_record_decl->method_begin(),
                                         cxx_record_decl->method_end());
+        }
       }
       break;
 
@@ -4707,6 +4717,7 @@ ClangASTContext::GetMemberFunctionAtIndex(lldb::opaque_compiler_type_t type,
         const clang::CXXRecordDecl *cxx_record_decl =
             llvm::dyn_cast<clang::CXXRecordDecl>(record_decl);
         if (cxx_record_decl) {
+          CompleteDeferredMethods(cxx_record_decl);
           auto method_iter = cxx_record_decl->method_begin();
           auto method_end = cxx_record_decl->method_end();
           if (idx <
@@ -9816,9 +9827,11 @@ void ClangASTContext::DumpTypeDescription(lldb::opaque_compiler_type_t type,
       const clang::CXXRecordDecl *cxx_record_decl =
           llvm::dyn_cast<clang::CXXRecordDecl>(record_decl);
 
-      if (cxx_record_decl)
+      if (cxx_record_decl) {
+        CompleteDeferredMethods(cxx_record_decl);
         cxx_record_decl->print(llvm_ostrm, getASTContext()->getPrintingPolicy(),
                                s->GetIndentLevel());
+      }
       else
         record_decl->print(llvm_ostrm, getASTContext()->getPrintingPolicy(),
                            s->GetIndentLevel());
@@ -9953,6 +9966,30 @@ void ClangASTContext::CompleteObjCInterfaceDecl(
   }
 }
 
+void ClangASTContext::FindExternalVisibleDeclsByName(
+    void *baton, const clang::DeclContext *decl_ctx,
+    clang::DeclarationName name,
+    llvm::SmallVectorImpl<clang::NamedDecl *> *results) {
+  ClangASTContext *ast = (ClangASTContext *)baton;
+  const clang::CXXRecordDecl *record_decl =
+      llvm::dyn_cast<clang::CXXRecordDecl>(decl_ctx);
+  if (record_decl && name && ast->m_dwarf_ast_parser_up)
+    ast->m_dwarf_ast_parser_up->CompleteDeferredMethods(record_decl, name,
+                                                        results);
+}
+
+void ClangASTContext::CompleteDeferredMethods(
+    const clang::CXXRecordDecl *record_decl) {
+  // Only classes with deferred methods have external visible storage once
+  // they are complete.
+  if (!record_decl || !record_decl->hasExternalVisibleStorage())
+    return;
+  ClangASTContext *ast = GetASTContext(&record_decl->getASTContext());
+  if (ast && ast->m_dwarf_ast_parser_up)
+    ast->m_dwarf_ast_parser_up->CompleteDeferredMethods(
+        record_decl, clang::DeclarationName(), nullptr);
+}
+
 DWARFASTParser *ClangASTContext::GetDWARFParser() {
   if (!m_dwarf_ast_parser_up)
     m_dwarf_ast_parser_up.reset(new DWARFASTParserClang(*this));
@@ -566,8 +566,15 @@ bool ClangASTImporter::CompleteTagDecl(clang::TagDecl *decl) {
   if (!decl_origin.Valid())
     return false;
 
-  if (!ClangASTContext::GetCompleteDecl(decl_origin.ctx, decl_origin.decl))
+  if (!ClangASTContext::GetCompleteDecl(decl_origin.ctx, decl_origin.decl)) {
+    // The origin is only a forward declaration.  If an earlier expression
+    // found the definition in another module, complete from that one.
+    auto pos = m_complete_definitions.find(
+        llvm::dyn_cast_or_null<clang::TagDecl>(decl_origin.decl));
+    if (pos != m_complete_definitions.end())
+      return CompleteTagDeclWithOrigin(decl, pos->second);
     return false;
+  }
 
   ImporterDelegateSP delegate_sp(
       GetDelegate(&decl->getASTContext(), decl_origin.ctx));
@@ -604,6 +611,12 @@ bool ClangASTImporter::CompleteTagDeclWithOrigin(clang::TagDecl *decl,
   return true;
 }
 
+void ClangASTImporter::RememberCompleteDefinition(
+    const clang::TagDecl *forward_decl, clang::TagDecl *definition) {
+  if (forward_decl && definition && forward_decl != definition)
+    m_complete_definitions[forward_decl] = definition;
+}
+
 bool ClangASTImporter::CompleteObjCInterfaceDecl(
     clang::ObjCInterfaceDecl *interface_decl) {
   ClangASTMetrics::RegisterDeclCompletion();
@@ -841,6 +854,15 @@ void ClangASTImporter::ForgetSource(clang::ASTContext *dst_ast,
 
   md->m_delegates.erase(src_ast);
 
+  for (CompleteDefinitionMap::iterator iter = m_complete_definitions.begin();
+       iter != m_complete_definitions.end();) {
+    if (&iter->first->getASTContext() == src_ast ||
+        &iter->second->getASTContext() == src_ast)
+      m_complete_definitions.erase(iter++);
+    else
+      ++iter;
+  }
+
   for (OriginMap::iterator iter = md->m_origins.begin();
        iter != md->m_origins.end();) {
     if (iter->second.ctx == src_ast)
@@ -941,6 +963,11 @@ void ClangASTImporter::ASTImporterDelegate::ImportDefinitionTo(
       to_cxx_record->startDefinition();
   */
 
+  // The copy can't look up methods the origin left to be created on demand,
+  // so create them before copying the members.
+  ClangASTContext::CompleteDeferredMethods(
+      llvm::dyn_cast<clang::CXXRecordDecl>(from));
+
   Log *log = lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS);
 
   if (llvm::Error err = ImportDefinition(from)) {
@@ -228,6 +228,27 @@ bool CompactUnwindInfo::GetUnwindPlan(Target &target, Address addr,
   return false;
 }
 
+void CompactUnwindInfo::GetUnwindPlans(Target &target,
+                                       llvm::ArrayRef<Address> addrs,
+                                       std::vector<UnwindPlanSP> &unwind_plans) {
+  unwind_plans.clear();
+  unwind_plans.resize(addrs.size());
+
+  std::vector<size_t> order(addrs.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    return addrs[lhs].GetFileAddress() < addrs[rhs].GetFileAddress();
+  });
+
+  for (size_t i : order) {
+    auto unwind_plan_sp =
+        std::make_shared<UnwindPlan>(lldb::eRegisterKindGeneric);
+    if (GetUnwindPlan(target, addrs[i], *unwind_plan_sp))
+      unwind_plans[i] = unwind_plan_sp;
+  }
+}
+
 bool CompactUnwindInfo::IsValid(const ProcessSP &process_sp) {
   if (m_section_sp.get() == nullptr)
     return false;
@@ -407,84 +428,119 @@ uint32_t CompactUnwindInfo::GetLSDAForFunctionOffset(uint32_t lsda_offset,
   return 0;
 }
 
-lldb::offset_t CompactUnwindInfo::BinarySearchRegularSecondPage(
-    uint32_t entry_page_offset, uint32_t entry_count, uint32_t function_offset,
-    uint32_t *entry_func_start_offset, uint32_t *entry_func_end_offset) {
-  // typedef uint32_t compact_unwind_encoding_t;
-  // struct unwind_info_regular_second_level_entry {
-  //     uint32_t                    functionOffset;
-  //     compact_unwind_encoding_t    encoding;
+CompactUnwindInfo::SecondLevelPageSP
+CompactUnwindInfo::GetSecondLevelPage(const UnwindIndex &index) {
+  std::lock_guard<std::mutex> guard(m_page_cache_mutex);
+  for (auto pos = m_page_cache.begin(), end = m_page_cache.end(); pos != end;
+       ++pos) {
+    if (pos->first == index.second_level) {
+      // Move the page to the front so the least recently used one is evicted
+      // first.
+      std::rotate(m_page_cache.begin(), pos, pos + 1);
+      return m_page_cache.front().second;
+    }
+  }
 
-  offset_t first_entry = entry_page_offset;
+  auto page_sp = std::make_shared<SecondLevelPage>();
+  offset_t second_page_offset = index.second_level;
+  offset_t offset = second_page_offset;
+  // UNWIND_SECOND_LEVEL_REGULAR or UNWIND_SECOND_LEVEL_COMPRESSED
+  page_sp->kind = m_unwindinfo_data.GetU32(&offset);
 
-  uint32_t low = 0;
-  uint32_t high = entry_count;
-  uint32_t last = high - 1;
-  while (low < high) {
-    uint32_t mid = (low + high) / 2;
-    offset_t offset = first_entry + (mid * 8);
-    uint32_t mid_func_offset =
-        m_unwindinfo_data.GetU32(&offset); // functionOffset
-    uint32_t next_func_offset = 0;
-    if (mid < last) {
-      offset = first_entry + ((mid + 1) * 8);
-      next_func_offset = m_unwindinfo_data.GetU32(&offset); // functionOffset
-    }
-    if (mid_func_offset <= function_offset) {
-      if (mid == last || (next_func_offset > function_offset)) {
-        if (entry_func_start_offset)
-          *entry_func_start_offset = mid_func_offset;
-        if (mid != last && entry_func_end_offset)
-          *entry_func_end_offset = next_func_offset;
-        return first_entry + (mid * 8);
-      } else {
-        low = mid + 1;
+  if (page_sp->kind == UNWIND_SECOND_LEVEL_REGULAR) {
+    // struct unwind_info_regular_second_level_page_header {
+    //     uint32_t    kind;    // UNWIND_SECOND_LEVEL_REGULAR
+    //     uint16_t    entryPageOffset;
+    //     uint16_t    entryCount;
+
+    // typedef uint32_t compact_unwind_encoding_t;
+    // struct unwind_info_regular_second_level_entry {
+    //     uint32_t                    functionOffset;
+    //     compact_unwind_encoding_t    encoding;
+
+    uint16_t entry_page_offset =
+        m_unwindinfo_data.GetU16(&offset);                    // entryPageOffset
+    uint16_t entry_count = m_unwindinfo_data.GetU16(&offset); // entryCount
+
+    offset = second_page_offset + entry_page_offset;
+    if (m_unwindinfo_data.ValidOffsetForDataOfSize(offset, entry_count * 8)) {
+      page_sp->function_offsets.reserve(entry_count);
+      page_sp->encodings.reserve(entry_count);
+      for (uint32_t i = 0; i < entry_count; ++i) {
+        page_sp->function_offsets.push_back(
+            m_unwindinfo_data.GetU32(&offset)); // functionOffset
+        page_sp->encodings.push_back(
+            m_unwindinfo_data.GetU32(&offset)); // encoding
       }
-    } else {
-      high = mid;
     }
-  }
-  return LLDB_INVALID_OFFSET;
-}
+  } else if (page_sp->kind == UNWIND_SECOND_LEVEL_COMPRESSED) {
+    // struct unwind_info_compressed_second_level_page_header {
+    //     uint32_t    kind;    // UNWIND_SECOND_LEVEL_COMPRESSED
+    //     uint16_t    entryPageOffset;         // offset from this 2nd lvl page
+    //     idx to array of entries
+    //                                          // (an entry has a function
+    //                                          offset and index into the
+    //                                          encodings)
+    //                                          // NB function offset from the
+    //                                          entry in the compressed page
+    //                                          // must be added to the index's
+    //                                          functionOffset value.
+    //     uint16_t    entryCount;
+    //     uint16_t    encodingsPageOffset;     // offset from this 2nd lvl page
+    //     idx to array of encodings
+    //     uint16_t    encodingsCount;
 
-uint32_t CompactUnwindInfo::BinarySearchCompressedSecondPage(
-    uint32_t entry_page_offset, uint32_t entry_count,
-    uint32_t function_offset_to_find, uint32_t function_offset_base,
-    uint32_t *entry_func_start_offset, uint32_t *entry_func_end_offset) {
-  offset_t first_entry = entry_page_offset;
+    uint16_t entry_page_offset =
+        m_unwindinfo_data.GetU16(&offset);                    // entryPageOffset
+    uint16_t entry_count = m_unwindinfo_data.GetU16(&offset); // entryCount
+    uint16_t encodings_page_offset =
+        m_unwindinfo_data.GetU16(&offset); // encodingsPageOffset
+    uint16_t encodings_count =
+        m_unwindinfo_data.GetU16(&offset); // encodingsCount
 
-  uint32_t low = 0;
-  uint32_t high = entry_count;
-  uint32_t last = high - 1;
-  while (low < high) {
-    uint32_t mid = (low + high) / 2;
-    offset_t offset = first_entry + (mid * 4);
-    uint32_t entry = m_unwindinfo_data.GetU32(&offset); // entry
-    uint32_t mid_func_offset = UNWIND_INFO_COMPRESSED_ENTRY_FUNC_OFFSET(entry);
-    mid_func_offset += function_offset_base;
-    uint32_t next_func_offset = 0;
-    if (mid < last) {
-      offset = first_entry + ((mid + 1) * 4);
-      uint32_t next_entry = m_unwindinfo_data.GetU32(&offset); // entry
-      next_func_offset = UNWIND_INFO_COMPRESSED_ENTRY_FUNC_OFFSET(next_entry);
-      next_func_offset += function_offset_base;
-    }
-    if (mid_func_offset <= function_offset_to_find) {
-      if (mid == last || (next_func_offset > function_offset_to_find)) {
-        if (entry_func_start_offset)
-          *entry_func_start_offset = mid_func_offset;
-        if (mid != last && entry_func_end_offset)
-          *entry_func_end_offset = next_func_offset;
-        return UNWIND_INFO_COMPRESSED_ENTRY_ENCODING_INDEX(entry);
-      } else {
-        low = mid + 1;
+    offset = second_page_offset + entry_page_offset;
+    if (m_unwindinfo_data.ValidOffsetForDataOfSize(offset, entry_count * 4)) {
+      page_sp->function_offsets.reserve(entry_count);
+      page_sp->encodings.reserve(entry_count);
+      for (uint32_t i = 0; i < entry_count; ++i) {
+        uint32_t entry = m_unwindinfo_data.GetU32(&offset); // entry
+        page_sp->function_offsets.push_back(
+            UNWIND_INFO_COMPRESSED_ENTRY_FUNC_OFFSET(entry) +
+            index.function_offset);
+
+        // An encoding index past both arrays is left as a zero encoding,
+        // which means there is no compact unwind for the function.
+        uint32_t encoding_index =
+            UNWIND_INFO_COMPRESSED_ENTRY_ENCODING_INDEX(entry);
+        uint32_t encoding = 0;
+        if (encoding_index < m_unwind_header.common_encodings_array_count) {
+          offset_t encoding_offset =
+              m_unwind_header.common_encodings_array_offset +
+              (encoding_index * sizeof(uint32_t));
+          encoding = m_unwindinfo_data.GetU32(
+              &encoding_offset); // encoding entry from the commonEncodingsArray
+        } else if (encoding_index < encodings_count +
+                                        m_unwind_header
+                                            .common_encodings_array_count) {
+          uint32_t page_specific_entry_index =
+              encoding_index - m_unwind_header.common_encodings_array_count;
+          offset_t encoding_offset =
+              second_page_offset + encodings_page_offset +
+              (page_specific_entry_index * sizeof(uint32_t));
+          encoding = m_unwindinfo_data.GetU32(
+              &encoding_offset); // encoding entry from the page-specific
+                                 // encoding array
+        }
+        page_sp->encodings.push_back(encoding);
       }
-    } else {
-      high = mid;
     }
   }
 
-  return UINT32_MAX;
+  if (m_page_cache.size() >= kSecondLevelPageCacheSize)
+    m_page_cache.pop_back();
+  m_page_cache.insert(m_page_cache.begin(),
+                      std::make_pair(index.second_level, page_sp));
+  return page_sp;
 }
 
 bool CompactUnwindInfo::GetCompactUnwindInfoForFunction(
@@ -536,156 +592,62 @@ bool CompactUnwindInfo::GetCompactUnwindInfoForFunction(
     unwind_info.valid_range_offset_end = next_it->function_offset;
   }
 
-  offset_t second_page_offset = it->second_level;
   offset_t lsda_array_start = it->lsda_array_start;
   offset_t lsda_array_count = (it->lsda_array_end - it->lsda_array_start) / 8;
 
-  offset_t offset = second_page_offset;
-  uint32_t kind = m_unwindinfo_data.GetU32(
-      &offset); // UNWIND_SECOND_LEVEL_REGULAR or UNWIND_SECOND_LEVEL_COMPRESSED
-
-  if (kind == UNWIND_SECOND_LEVEL_REGULAR) {
-    // struct unwind_info_regular_second_level_page_header {
-    //     uint32_t    kind;    // UNWIND_SECOND_LEVEL_REGULAR
-    //     uint16_t    entryPageOffset;
-    //     uint16_t    entryCount;
-
-    // typedef uint32_t compact_unwind_encoding_t;
-    // struct unwind_info_regular_second_level_entry {
-    //     uint32_t                    functionOffset;
-    //     compact_unwind_encoding_t    encoding;
-
-    uint16_t entry_page_offset =
-        m_unwindinfo_data.GetU16(&offset);                    // entryPageOffset
-    uint16_t entry_count = m_unwindinfo_data.GetU16(&offset); // entryCount
-
-    offset_t entry_offset = BinarySearchRegularSecondPage(
-        second_page_offset + entry_page_offset, entry_count, function_offset,
-        &unwind_info.valid_range_offset_start,
-        &unwind_info.valid_range_offset_end);
-    if (entry_offset == LLDB_INVALID_OFFSET) {
-      return false;
-    }
-    entry_offset += 4; // skip over functionOffset
-    unwind_info.encoding = m_unwindinfo_data.GetU32(&entry_offset); // encoding
-    if (unwind_info.encoding & UNWIND_HAS_LSDA) {
-      SectionList *sl = m_objfile.GetSectionList();
-      if (sl) {
-        uint32_t lsda_offset = GetLSDAForFunctionOffset(
-            lsda_array_start, lsda_array_count, function_offset);
-        addr_t objfile_base_address =
-            m_objfile.GetBaseAddress().GetFileAddress();
-        unwind_info.lsda_address.ResolveAddressUsingFileSections(
-            objfile_base_address + lsda_offset, sl);
-      }
-    }
-    if (unwind_info.encoding & UNWIND_PERSONALITY_MASK) {
-      uint32_t personality_index =
-          EXTRACT_BITS(unwind_info.encoding, UNWIND_PERSONALITY_MASK);
-
-      if (personality_index > 0) {
-        personality_index--;
-        if (personality_index < m_unwind_header.personality_array_count) {
-          offset_t offset = m_unwind_header.personality_array_offset;
-          offset += 4 * personality_index;
-          SectionList *sl = m_objfile.GetSectionList();
-          if (sl) {
-            uint32_t personality_offset = m_unwindinfo_data.GetU32(&offset);
-            addr_t objfile_base_address =
-                m_objfile.GetBaseAddress().GetFileAddress();
-            unwind_info.personality_ptr_address.ResolveAddressUsingFileSections(
-                objfile_base_address + personality_offset, sl);
-          }
-        }
-      }
-    }
-    return true;
-  } else if (kind == UNWIND_SECOND_LEVEL_COMPRESSED) {
-    // struct unwind_info_compressed_second_level_page_header {
-    //     uint32_t    kind;    // UNWIND_SECOND_LEVEL_COMPRESSED
-    //     uint16_t    entryPageOffset;         // offset from this 2nd lvl page
-    //     idx to array of entries
-    //                                          // (an entry has a function
-    //                                          offset and index into the
-    //                                          encodings)
-    //                                          // NB function offset from the
-    //                                          entry in the compressed page
-    //                                          // must be added to the index's
-    //                                          functionOffset value.
-    //     uint16_t    entryCount;
-    //     uint16_t    encodingsPageOffset;     // offset from this 2nd lvl page
-    //     idx to array of encodings
-    //     uint16_t    encodingsCount;
-
-    uint16_t entry_page_offset =
-        m_unwindinfo_data.GetU16(&offset);                    // entryPageOffset
-    uint16_t entry_count = m_unwindinfo_data.GetU16(&offset); // entryCount
-    uint16_t encodings_page_offset =
-        m_unwindinfo_data.GetU16(&offset); // encodingsPageOffset
-    uint16_t encodings_count =
-        m_unwindinfo_data.GetU16(&offset); // encodingsCount
+  SecondLevelPageSP page_sp = GetSecondLevelPage(*it);
+  if (page_sp->kind != UNWIND_SECOND_LEVEL_REGULAR &&
+      page_sp->kind != UNWIND_SECOND_LEVEL_COMPRESSED)
+    return false;
 
-    uint32_t encoding_index = BinarySearchCompressedSecondPage(
-        second_page_offset + entry_page_offset, entry_count, function_offset,
-        it->function_offset, &unwind_info.valid_range_offset_start,
-        &unwind_info.valid_range_offset_end);
-    if (encoding_index == UINT32_MAX ||
-        encoding_index >=
-            encodings_count + m_unwind_header.common_encodings_array_count) {
-      return false;
-    }
-    uint32_t encoding = 0;
-    if (encoding_index < m_unwind_header.common_encodings_array_count) {
-      offset = m_unwind_header.common_encodings_array_offset +
-               (encoding_index * sizeof(uint32_t));
-      encoding = m_unwindinfo_data.GetU32(
-          &offset); // encoding entry from the commonEncodingsArray
-    } else {
-      uint32_t page_specific_entry_index =
-          encoding_index - m_unwind_header.common_encodings_array_count;
-      offset = second_page_offset + encodings_page_offset +
-               (page_specific_entry_index * sizeof(uint32_t));
-      encoding = m_unwindinfo_data.GetU32(
-          &offset); // encoding entry from the page-specific encoding array
-    }
-    if (encoding == 0)
-      return false;
+  // Find the last function starting at or before function_offset.
+  const std::vector<uint32_t> &function_offsets = page_sp->function_offsets;
+  auto pos = std::upper_bound(function_offsets.begin(), function_offsets.end(),
+                              function_offset);
+  if (pos == function_offsets.begin())
+    return false;
+  const size_t entry_idx = std::distance(function_offsets.begin(), pos) - 1;
+  unwind_info.valid_range_offset_start = function_offsets[entry_idx];
+  if (pos != function_offsets.end())
+    unwind_info.valid_range_offset_end = *pos;
+
+  unwind_info.encoding = page_sp->encodings[entry_idx];
+  if (page_sp->kind == UNWIND_SECOND_LEVEL_COMPRESSED &&
+      unwind_info.encoding == 0)
+    return false;
 
-    unwind_info.encoding = encoding;
-    if (unwind_info.encoding & UNWIND_HAS_LSDA) {
-      SectionList *sl = m_objfile.GetSectionList();
-      if (sl) {
-        uint32_t lsda_offset = GetLSDAForFunctionOffset(
-            lsda_array_start, lsda_array_count, function_offset);
-        addr_t objfile_base_address =
-            m_objfile.GetBaseAddress().GetFileAddress();
-        unwind_info.lsda_address.ResolveAddressUsingFileSections(
-            objfile_base_address + lsda_offset, sl);
-      }
+  if (unwind_info.encoding & UNWIND_HAS_LSDA) {
+    SectionList *sl = m_objfile.GetSectionList();
+    if (sl) {
+      uint32_t lsda_offset = GetLSDAForFunctionOffset(
+          lsda_array_start, lsda_array_count, function_offset);
+      addr_t objfile_base_address =
+          m_objfile.GetBaseAddress().GetFileAddress();
+      unwind_info.lsda_address.ResolveAddressUsingFileSections(
+          objfile_base_address + lsda_offset, sl);
     }
-    if (unwind_info.encoding & UNWIND_PERSONALITY_MASK) {
-      uint32_t personality_index =
-          EXTRACT_BITS(unwind_info.encoding, UNWIND_PERSONALITY_MASK);
-
-      if (personality_index > 0) {
-        personality_index--;
-        if (personality_index < m_unwind_header.personality_array_count) {
-          offset_t offset = m_unwind_header.personality_array_offset;
-          offset += 4 * personality_index;
-          SectionList *sl = m_objfile.GetSectionList();
-          if (sl) {
-            uint32_t personality_offset = m_unwindinfo_data.GetU32(&offset);
-            addr_t objfile_base_address =
-                m_objfile.GetBaseAddress().GetFileAddress();
-            unwind_info.personality_ptr_address.ResolveAddressUsingFileSections(
-                objfile_base_address + personality_offset, sl);
-          }
+  }
+  if (unwind_info.encoding & UNWIND_PERSONALITY_MASK) {
+    uint32_t personality_index =
+        EXTRACT_BITS(unwind_info.encoding, UNWIND_PERSONALITY_MASK);
+
+    if (personality_index > 0) {
+      personality_index--;
+      if (personality_index < m_unwind_header.personality_array_count) {
+        offset_t offset = m_unwind_header.personality_array_offset;
+        offset += 4 * personality_index;
+        SectionList *sl = m_objfile.GetSectionList();
+        if (sl) {
+          uint32_t personality_offset = m_unwindinfo_data.GetU32(&offset);
+          addr_t objfile_base_address =
+              m_objfile.GetBaseAddress().GetFileAddress();
+          unwind_info.personality_ptr_address.ResolveAddressUsingFileSections(
+              objfile_base_address + personality_offset, sl);
         }
       }
     }
-    return true;
   }
-  return false;
+  return true;
 }
 
 enum x86_64_eh_regnum {
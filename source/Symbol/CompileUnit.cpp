@@ -151,8 +151,12 @@ LineTable *CompileUnit::GetLineTable() {
 void CompileUnit::SetLineTable(LineTable *line_table) {
   if (line_table == nullptr)
     m_flags.Clear(flagsParsedLineTable);
-  else
+  else {
     m_flags.Set(flagsParsedLineTable);
+    // The symbol file is done building the line table, and it will likely
+    // stay around for as long as the module does.
+    line_table->Compact();
+  }
   m_line_table_up.reset(line_table);
 }
 
@@ -143,9 +143,40 @@ GetGNUEHPointer(const DataExtractor &DE, offset_t *offset_ptr,
   return baseAddress + addressValue;
 }
 
+// Returns the size of one value of a .eh_frame_hdr binary search table
+// encoded with \a enc, or zero if the encoding doesn't have a fixed size (the
+// table can't be searched without one).
+static uint8_t GetLookupTableValueSize(uint8_t enc, uint32_t addr_size) {
+  switch (enc & 0x70) {
+  case DW_EH_PE_absptr:
+  case DW_EH_PE_pcrel:
+  case DW_EH_PE_datarel:
+    break;
+  default:
+    return 0;
+  }
+  switch (enc & DW_EH_PE_MASK_ENCODING) {
+  case DW_EH_PE_absptr:
+    return addr_size;
+  case DW_EH_PE_udata2:
+  case DW_EH_PE_sdata2:
+    return 2;
+  case DW_EH_PE_udata4:
+  case DW_EH_PE_sdata4:
+    return 4;
+  case DW_EH_PE_udata8:
+  case DW_EH_PE_sdata8:
+    return 8;
+  default:
+    return 0;
+  }
+}
+
 DWARFCallFrameInfo::DWARFCallFrameInfo(ObjectFile &objfile,
-                                       SectionSP &section_sp, Type type)
-    : m_objfile(objfile), m_section_sp(section_sp), m_type(type) {}
+                                       SectionSP &section_sp, Type type,
+                                       SectionSP eh_frame_hdr_sp)
+    : m_objfile(objfile), m_section_sp(section_sp),
+      m_eh_frame_hdr_sp(std::move(eh_frame_hdr_sp)), m_type(type) {}
 
 bool DWARFCallFrameInfo::GetUnwindPlan(const Address &addr,
                                        UnwindPlan &unwind_plan) {
@@ -180,6 +211,17 @@ bool DWARFCallFrameInfo::GetAddressRange(Address addr, AddressRange &range) {
 
   if (m_section_sp.get() == nullptr || m_section_sp->IsEncrypted())
     return false;
+
+  if (HasLookupTable()) {
+    llvm::Optional<FDEEntryMap::Entry> fde_entry =
+        GetFirstFDEEntryInRangeFromLookupTable(AddressRange(addr, 1));
+    if (!fde_entry)
+      return false;
+    range = AddressRange(fde_entry->base, fde_entry->size,
+                         m_objfile.GetSectionList());
+    return true;
+  }
+
   GetFDEIndex();
   FDEEntryMap::Entry *fde_entry =
       m_fde_index.FindEntryThatContains(addr.GetFileAddress());
@@ -196,6 +238,9 @@ DWARFCallFrameInfo::GetFirstFDEEntryInRange(const AddressRange &range) {
   if (!m_section_sp || m_section_sp->IsEncrypted())
     return llvm::None;
 
+  if (HasLookupTable())
+    return GetFirstFDEEntryInRangeFromLookupTable(range);
+
   GetFDEIndex();
 
   addr_t start_file_addr = range.GetBaseAddress().GetFileAddress();
@@ -226,8 +271,171 @@ void DWARFCallFrameInfo::GetFunctionAddressAndSizeVector(
   }
 }
 
+bool DWARFCallFrameInfo::HasLookupTable() {
+  GetLookupTable();
+  return m_lookup_table_count > 0;
+}
+
+void DWARFCallFrameInfo::GetLookupTable() {
+  if (m_lookup_table_initialized)
+    return;
+
+  std::lock_guard<std::mutex> guard(m_lookup_table_mutex);
+
+  if (m_lookup_table_initialized) // if two threads hit the locker
+    return;
+
+  if (m_type == EH && m_eh_frame_hdr_sp && !m_eh_frame_hdr_sp->IsEncrypted() &&
+      m_section_sp && !m_section_sp->IsEncrypted()) {
+    // The section data is shared with the object file's (usually memory
+    // mapped) contents, so the table is searched in place.
+    DataExtractor data;
+    m_objfile.ReadSectionData(m_eh_frame_hdr_sp.get(), data);
+    const lldb::addr_t hdr_addr = m_eh_frame_hdr_sp->GetFileAddress();
+    lldb::offset_t offset = 0;
+    if (data.ValidOffsetForDataOfSize(offset, 4)) {
+      const uint8_t version = data.GetU8(&offset);
+      const uint8_t eh_frame_ptr_enc = data.GetU8(&offset);
+      const uint8_t fde_count_enc = data.GetU8(&offset);
+      const uint8_t table_enc = data.GetU8(&offset);
+      const uint8_t value_size =
+          GetLookupTableValueSize(table_enc, data.GetAddressByteSize());
+      if (version == 1 && eh_frame_ptr_enc != DW_EH_PE_omit &&
+          fde_count_enc != DW_EH_PE_omit && value_size != 0) {
+        const lldb::addr_t eh_frame_addr =
+            GetGNUEHPointer(data, &offset, eh_frame_ptr_enc, hdr_addr,
+                            LLDB_INVALID_ADDRESS, hdr_addr);
+        const uint64_t fde_count =
+            GetGNUEHPointer(data, &offset, fde_count_enc, hdr_addr,
+                            LLDB_INVALID_ADDRESS, hdr_addr);
+        const uint32_t entry_size = 2 * value_size;
+        if (eh_frame_addr == m_section_sp->GetFileAddress() &&
+            fde_count <= data.GetByteSize() / entry_size &&
+            data.ValidOffsetForDataOfSize(offset, fde_count * entry_size)) {
+          m_eh_frame_hdr_data = data;
+          m_lookup_table_offset = offset;
+          m_lookup_table_encoding = table_enc;
+          m_lookup_table_entry_size = entry_size;
+          m_lookup_table_count = fde_count;
+        }
+      }
+    }
+  }
+  m_lookup_table_initialized = true;
+}
+
+bool DWARFCallFrameInfo::GetLookupTableEntry(uint32_t idx,
+                                             lldb::addr_t &initial_location,
+                                             dw_offset_t &fde_offset) {
+  if (idx >= m_lookup_table_count)
+    return false;
+  const lldb::addr_t hdr_addr = m_eh_frame_hdr_sp->GetFileAddress();
+  lldb::offset_t offset =
+      m_lookup_table_offset + idx * m_lookup_table_entry_size;
+  initial_location =
+      GetGNUEHPointer(m_eh_frame_hdr_data, &offset, m_lookup_table_encoding,
+                      hdr_addr, LLDB_INVALID_ADDRESS, hdr_addr);
+  const lldb::addr_t fde_addr =
+      GetGNUEHPointer(m_eh_frame_hdr_data, &offset, m_lookup_table_encoding,
+                      hdr_addr, LLDB_INVALID_ADDRESS, hdr_addr);
+  const lldb::addr_t eh_frame_addr = m_section_sp->GetFileAddress();
+  if (fde_addr < eh_frame_addr ||
+      fde_addr - eh_frame_addr >= m_section_sp->GetByteSize())
+    return false;
+  fde_offset = fde_addr - eh_frame_addr;
+  return true;
+}
+
+llvm::Optional<DWARFCallFrameInfo::FDEEntryMap::Entry>
+DWARFCallFrameInfo::GetFirstFDEEntryInRangeFromLookupTable(
+    const AddressRange &range) {
+  const addr_t start_file_addr = range.GetBaseAddress().GetFileAddress();
+
+  // Find the first entry that starts after start_file_addr.  The table is
+  // sorted by initial location.
+  uint32_t lo = 0;
+  uint32_t hi = m_lookup_table_count;
+  while (lo < hi) {
+    const uint32_t mid = lo + (hi - lo) / 2;
+    lldb::addr_t initial_location;
+    dw_offset_t fde_offset;
+    if (!GetLookupTableEntry(mid, initial_location, fde_offset))
+      return llvm::None;
+    if (initial_location <= start_file_addr)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  // The entry before that one may contain start_file_addr; otherwise that one
+  // may still intersect the range.
+  const FDEEntryMap::Range search_range(start_file_addr, range.GetByteSize());
+  for (uint32_t idx = lo > 0 ? lo - 1 : 0;
+       idx <= lo && idx < m_lookup_table_count; ++idx) {
+    lldb::addr_t initial_location;
+    dw_offset_t fde_offset;
+    if (!GetLookupTableEntry(idx, initial_location, fde_offset))
+      return llvm::None;
+    llvm::Optional<FDEEntryMap::Entry> fde = ParseFDEEntry(fde_offset);
+    if (fde && fde->DoesIntersect(search_range))
+      return fde;
+  }
+  return llvm::None;
+}
+
+llvm::Optional<DWARFCallFrameInfo::FDEEntryMap::Entry>
+DWARFCallFrameInfo::ParseFDEEntry(dw_offset_t fde_offset) {
+  if (!m_cfi_data_initialized)
+    GetCFIData();
+
+  lldb::offset_t offset = fde_offset;
+  if (!m_cfi_data.ValidOffsetForDataOfSize(offset, 8))
+    return llvm::None;
+
+  dw_offset_t cie_id, cie_offset;
+  uint32_t len = m_cfi_data.GetU32(&offset);
+  if (len == UINT32_MAX) {
+    len = m_cfi_data.GetU64(&offset);
+    cie_id = m_cfi_data.GetU64(&offset);
+    cie_offset = fde_offset + 12 - cie_id;
+  } else {
+    cie_id = m_cfi_data.GetU32(&offset);
+    cie_offset = fde_offset + 4 - cie_id;
+  }
+
+  // Only eh_frame has a lookup table, so this must be a real FDE.
+  if (len == 0 || cie_id == 0 || cie_id == UINT32_MAX ||
+      cie_offset > m_cfi_data.GetByteSize())
+    return llvm::None;
+
+  const CIE *cie = GetCIE(cie_offset);
+  if (!cie)
+    return llvm::None;
+
+  const lldb::addr_t pc_rel_addr = m_section_sp->GetFileAddress();
+  lldb::addr_t addr =
+      GetGNUEHPointer(m_cfi_data, &offset, cie->ptr_encoding, pc_rel_addr,
+                      LLDB_INVALID_ADDRESS, LLDB_INVALID_ADDRESS);
+  if (ShouldClearAddressZerothBit())
+    addr &= ~1ull;
+  lldb::addr_t length = GetGNUEHPointer(
+      m_cfi_data, &offset, cie->ptr_encoding & DW_EH_PE_MASK_ENCODING,
+      pc_rel_addr, LLDB_INVALID_ADDRESS, LLDB_INVALID_ADDRESS);
+  return FDEEntryMap::Entry(addr, length, fde_offset);
+}
+
+bool DWARFCallFrameInfo::ShouldClearAddressZerothBit() {
+  if (ArchSpec arch = m_objfile.GetArchitecture()) {
+    if (arch.GetTriple().getArch() == llvm::Triple::arm ||
+        arch.GetTriple().getArch() == llvm::Triple::thumb)
+      return true;
+  }
+  return false;
+}
+
 const DWARFCallFrameInfo::CIE *
 DWARFCallFrameInfo::GetCIE(dw_offset_t cie_offset) {
+  std::lock_guard<std::mutex> guard(m_cie_map_mutex);
   cie_map_t::iterator pos = m_cie_map.find(cie_offset);
 
   if (pos != m_cie_map.end()) {
@@ -237,6 +445,16 @@ DWARFCallFrameInfo::GetCIE(dw_offset_t cie_offset) {
 
     return pos->second.get();
   }
+
+  // FDEs found through the lookup table refer to CIEs the index scan has
+  // never seen.  ParseCIE leaves the version unset if the entry at
+  // cie_offset isn't a CIE.
+  if (HasLookupTable()) {
+    CIESP cie_sp = ParseCIE(cie_offset);
+    if (!cie_sp || cie_sp->version == static_cast<uint8_t>(-1))
+      return nullptr;
+    return (m_cie_map[cie_offset] = std::move(cie_sp)).get();
+  }
   return nullptr;
 }
 
@@ -395,7 +613,12 @@ DWARFCallFrameInfo::ParseCIE(const dw_offset_t cie_offset) {
 }
 
 void DWARFCallFrameInfo::GetCFIData() {
-  if (!m_cfi_data_initialized) {
+  if (m_cfi_data_initialized)
+    return;
+
+  std::lock_guard<std::mutex> guard(m_cfi_data_mutex);
+
+  if (!m_cfi_data_initialized) { // if two threads hit the locker
     Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_UNWIND));
     if (log)
       m_objfile.GetModule()->LogMessage(log, "Reading EH frame info");
@@ -423,12 +646,7 @@ void DWARFCallFrameInfo::GetFDEIndex() {
   Timer scoped_timer(func_cat, "%s - %s", LLVM_PRETTY_FUNCTION,
                      m_objfile.GetFileSpec().GetFilename().AsCString(""));
 
-  bool clear_address_zeroth_bit = false;
-  if (ArchSpec arch = m_objfile.GetArchitecture()) {
-    if (arch.GetTriple().getArch() == llvm::Triple::arm ||
-        arch.GetTriple().getArch() == llvm::Triple::thumb)
-      clear_address_zeroth_bit = true;
-  }
+  const bool clear_address_zeroth_bit = ShouldClearAddressZerothBit();
 
   lldb::offset_t offset = 0;
   if (!m_cfi_data_initialized)
@@ -474,7 +692,10 @@ void DWARFCallFrameInfo::GetFDEIndex() {
         return;
       }
 
-      m_cie_map[current_entry] = std::move(cie_sp);
+      {
+        std::lock_guard<std::mutex> cie_guard(m_cie_map_mutex);
+        m_cie_map[current_entry] = std::move(cie_sp);
+      }
       offset = next_entry;
       continue;
     }
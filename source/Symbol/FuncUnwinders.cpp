@@ -48,7 +48,7 @@ FuncUnwinders::FuncUnwinders(UnwindTable &unwind_table, AddressRange range)
       m_tried_unwind_plan_symbol_file(false), m_tried_unwind_fast(false),
       m_tried_unwind_arch_default(false),
       m_tried_unwind_arch_default_at_func_entry(false),
-      m_first_non_prologue_insn() {}
+      m_tried_unwind_plan_non_call_site(false), m_first_non_prologue_insn() {}
 
 /// destructor
 
@@ -325,6 +325,18 @@ LazyBool FuncUnwinders::CompareUnwindPlansForIdenticalInitialPCLocation(
 
 UnwindPlanSP FuncUnwinders::GetUnwindPlanAtNonCallSite(Target &target,
                                                        Thread &thread) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  if (m_unwind_plan_non_call_site_sp || m_tried_unwind_plan_non_call_site)
+    return m_unwind_plan_non_call_site_sp;
+
+  m_tried_unwind_plan_non_call_site = true;
+  m_unwind_plan_non_call_site_sp =
+      ComputeUnwindPlanAtNonCallSite(target, thread);
+  return m_unwind_plan_non_call_site_sp;
+}
+
+UnwindPlanSP FuncUnwinders::ComputeUnwindPlanAtNonCallSite(Target &target,
+                                                           Thread &thread) {
   UnwindPlanSP eh_frame_sp = GetEHFrameUnwindPlan(target);
   if (!eh_frame_sp)
     eh_frame_sp = GetDebugFrameUnwindPlan(target);
@@ -12,6 +12,7 @@
 #include "lldb/Core/Section.h"
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Utility/Stream.h"
+#include "llvm/Support/LEB128.h"
 #include <algorithm>
 
 using namespace lldb;
@@ -34,6 +35,7 @@ void LineTable::InsertLineEntry(lldb::addr_t file_addr, uint32_t line,
               is_start_of_basic_block, is_prologue_end, is_epilogue_begin,
               is_terminal_entry);
 
+  Expand();
   entry_collection::iterator begin_pos = m_entries.begin();
   entry_collection::iterator end_pos = m_entries.end();
   LineTable::Entry::LessThanBinaryPredicate less_than_bp(this);
@@ -98,6 +100,7 @@ void LineTable::InsertSequence(LineSequence *sequence) {
   if (seq->m_entries.empty())
     return;
   Entry &entry = seq->m_entries.front();
+  Expand();
 
   // If the first entry address in this sequence is greater than or equal to
   // the address of the last item in our entry collection, just append.
@@ -156,10 +159,189 @@ operator()(const LineTable::Entry &a, const LineTable::Entry &b) const {
 #undef LT_COMPARE
 }
 
-uint32_t LineTable::GetSize() const { return m_entries.size(); }
+// Flags stored in the low bits of each encoded entry's address delta.
+enum EncodedEntryFlags {
+  eEncodedStartOfStatement = 1u << 0,
+  eEncodedStartOfBasicBlock = 1u << 1,
+  eEncodedPrologueEnd = 1u << 2,
+  eEncodedEpilogueBegin = 1u << 3,
+  eEncodedTerminalEntry = 1u << 4,
+  eEncodedFlagBits = 5
+};
+
+void LineTable::Compact() {
+  if (IsCompacted() || m_entries.size() <= kEntriesPerBlock)
+    return;
+
+  // Each entry is encoded relative to the previous one in its block as a
+  // ULEB128 address delta with the flags in its low bits, a SLEB128 line
+  // delta, and ULEB128 column and file indexes. Entries are sorted by
+  // address, so the address deltas are never negative.
+  std::vector<EncodedBlock> blocks;
+  std::vector<uint8_t> data;
+  uint8_t buffer[16];
+  auto append_uleb = [&](uint64_t value) {
+    unsigned size = llvm::encodeULEB128(value, buffer);
+    data.insert(data.end(), buffer, buffer + size);
+  };
+  auto append_sleb = [&](int64_t value) {
+    unsigned size = llvm::encodeSLEB128(value, buffer);
+    data.insert(data.end(), buffer, buffer + size);
+  };
+
+  blocks.reserve((m_entries.size() + kEntriesPerBlock - 1) / kEntriesPerBlock);
+  addr_t prev_file_addr = 0;
+  uint32_t prev_line = 0;
+  for (size_t idx = 0; idx < m_entries.size(); ++idx) {
+    const Entry &entry = m_entries[idx];
+    if (idx % kEntriesPerBlock == 0) {
+      EncodedBlock block = {entry.file_addr, entry.line,
+                            static_cast<uint32_t>(data.size())};
+      blocks.push_back(block);
+      prev_file_addr = entry.file_addr;
+      prev_line = entry.line;
+    }
+    const addr_t addr_delta = entry.file_addr - prev_file_addr;
+    if (entry.file_addr < prev_file_addr ||
+        (addr_delta >> (64 - eEncodedFlagBits)) != 0 ||
+        data.size() > UINT32_MAX)
+      return;
+
+    uint64_t flags = 0;
+    if (entry.is_start_of_statement)
+      flags |= eEncodedStartOfStatement;
+    if (entry.is_start_of_basic_block)
+      flags |= eEncodedStartOfBasicBlock;
+    if (entry.is_prologue_end)
+      flags |= eEncodedPrologueEnd;
+    if (entry.is_epilogue_begin)
+      flags |= eEncodedEpilogueBegin;
+    if (entry.is_terminal_entry)
+      flags |= eEncodedTerminalEntry;
+    append_uleb((addr_delta << eEncodedFlagBits) | flags);
+    append_sleb(static_cast<int64_t>(entry.line) -
+                static_cast<int64_t>(prev_line));
+    append_uleb(entry.column);
+    append_uleb(entry.file_idx);
+    prev_file_addr = entry.file_addr;
+    prev_line = entry.line;
+  }
+
+  data.shrink_to_fit();
+  m_encoded_blocks.swap(blocks);
+  m_encoded_entries.swap(data);
+  m_num_encoded_entries = m_entries.size();
+  entry_collection().swap(m_entries);
+}
+
+void LineTable::Expand() {
+  if (!IsCompacted())
+    return;
+
+  entry_collection entries;
+  entries.reserve(m_num_encoded_entries);
+  entry_collection block_entries;
+  for (uint32_t block_idx = 0; block_idx < m_encoded_blocks.size();
+       ++block_idx) {
+    DecodeBlock(block_idx, block_entries);
+    entries.insert(entries.end(), block_entries.begin(), block_entries.end());
+  }
+  m_entries.swap(entries);
+  m_encoded_blocks.clear();
+  m_encoded_entries.clear();
+  m_num_encoded_entries = 0;
+
+  std::lock_guard<std::mutex> guard(m_decoded_block_mutex);
+  m_decoded_block_idx = UINT32_MAX;
+  m_decoded_block.clear();
+}
+
+void LineTable::DecodeBlock(uint32_t block_idx,
+                            entry_collection &entries) const {
+  const EncodedBlock &block = m_encoded_blocks[block_idx];
+  const uint32_t first_idx = block_idx * kEntriesPerBlock;
+  const uint32_t count =
+      std::min(kEntriesPerBlock, m_num_encoded_entries - first_idx);
+  const uint8_t *data = m_encoded_entries.data() + block.data_offset;
+  addr_t file_addr = block.file_addr;
+  int64_t line = block.line;
+  unsigned size = 0;
+
+  entries.clear();
+  entries.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    const uint64_t addr_delta_and_flags = llvm::decodeULEB128(data, &size);
+    data += size;
+    line += llvm::decodeSLEB128(data, &size);
+    data += size;
+    const uint64_t column = llvm::decodeULEB128(data, &size);
+    data += size;
+    const uint64_t file_idx = llvm::decodeULEB128(data, &size);
+    data += size;
+
+    file_addr += addr_delta_and_flags >> eEncodedFlagBits;
+    const uint64_t flags = addr_delta_and_flags;
+    entries.emplace_back(file_addr, line, column, file_idx,
+                         flags & eEncodedStartOfStatement,
+                         flags & eEncodedStartOfBasicBlock,
+                         flags & eEncodedPrologueEnd,
+                         flags & eEncodedEpilogueBegin,
+                         flags & eEncodedTerminalEntry);
+  }
+}
+
+LineTable::Entry LineTable::GetEntry(uint32_t idx) const {
+  if (!IsCompacted())
+    return m_entries[idx];
+
+  const uint32_t block_idx = idx / kEntriesPerBlock;
+  std::lock_guard<std::mutex> guard(m_decoded_block_mutex);
+  if (m_decoded_block_idx != block_idx) {
+    DecodeBlock(block_idx, m_decoded_block);
+    m_decoded_block_idx = block_idx;
+  }
+  return m_decoded_block[idx % kEntriesPerBlock];
+}
+
+uint32_t LineTable::LowerBoundByAddress(addr_t file_addr) const {
+  Entry search_entry;
+  search_entry.file_addr = file_addr;
+  if (!IsCompacted())
+    return std::distance(m_entries.begin(),
+                         std::lower_bound(m_entries.begin(), m_entries.end(),
+                                          search_entry,
+                                          Entry::EntryAddressLessThan));
+
+  // All blocks before the first one that starts at or after the address
+  // start before it, so the lower bound is in the block before that one, or
+  // it's the first entry of that block.
+  auto block_pos = std::lower_bound(
+      m_encoded_blocks.begin(), m_encoded_blocks.end(), file_addr,
+      [](const EncodedBlock &block, addr_t addr) {
+        return block.file_addr < addr;
+      });
+  if (block_pos == m_encoded_blocks.begin())
+    return 0;
+  const uint32_t block_idx =
+      std::distance(m_encoded_blocks.begin(), block_pos) - 1;
+
+  std::lock_guard<std::mutex> guard(m_decoded_block_mutex);
+  if (m_decoded_block_idx != block_idx) {
+    DecodeBlock(block_idx, m_decoded_block);
+    m_decoded_block_idx = block_idx;
+  }
+  auto pos = std::lower_bound(m_decoded_block.begin(), m_decoded_block.end(),
+                              search_entry, Entry::EntryAddressLessThan);
+  return block_idx * kEntriesPerBlock +
+         std::distance(m_decoded_block.begin(), pos);
+}
+
+uint32_t LineTable::GetSize() const {
+  return IsCompacted() ? m_num_encoded_entries : m_entries.size();
+}
 
 bool LineTable::GetLineEntryAtIndex(uint32_t idx, LineEntry &line_entry) {
-  if (idx < m_entries.size()) {
+  if (idx < GetSize()) {
     ConvertEntryAtIndexToLineEntry(idx, line_entry);
     return true;
   }
@@ -176,40 +358,38 @@ bool LineTable::FindLineEntryByAddress(const Address &so_addr,
   bool success = false;
 
   if (so_addr.GetModule().get() == m_comp_unit->GetModule().get()) {
-    Entry search_entry;
-    search_entry.file_addr = so_addr.GetFileAddress();
-    if (search_entry.file_addr != LLDB_INVALID_ADDRESS) {
-      entry_collection::const_iterator begin_pos = m_entries.begin();
-      entry_collection::const_iterator end_pos = m_entries.end();
-      entry_collection::const_iterator pos = lower_bound(
-          begin_pos, end_pos, search_entry, Entry::EntryAddressLessThan);
-      if (pos != end_pos) {
-        if (pos != begin_pos) {
-          if (pos->file_addr != search_entry.file_addr)
-            --pos;
-          else if (pos->file_addr == search_entry.file_addr) {
+    const addr_t file_addr = so_addr.GetFileAddress();
+    if (file_addr != LLDB_INVALID_ADDRESS) {
+      const uint32_t count = GetSize();
+      uint32_t idx = LowerBoundByAddress(file_addr);
+      if (idx != count) {
+        const Entry entry = GetEntry(idx);
+        if (idx != 0) {
+          if (entry.file_addr != file_addr)
+            --idx;
+          else {
             // If this is a termination entry, it shouldn't match since entries
             // with the "is_terminal_entry" member set to true are termination
             // entries that define the range for the previous entry.
-            if (pos->is_terminal_entry) {
+            if (entry.is_terminal_entry) {
               // The matching entry is a terminal entry, so we skip ahead to
               // the next entry to see if there is another entry following this
               // one whose section/offset matches.
-              ++pos;
-              if (pos != end_pos) {
-                if (pos->file_addr != search_entry.file_addr)
-                  pos = end_pos;
+              ++idx;
+              if (idx != count) {
+                if (GetEntry(idx).file_addr != file_addr)
+                  idx = count;
               }
             }
 
-            if (pos != end_pos) {
+            if (idx != count) {
               // While in the same section/offset backup to find the first line
               // entry that matches the address in case there are multiple
-              while (pos != begin_pos) {
-                entry_collection::const_iterator prev_pos = pos - 1;
-                if (prev_pos->file_addr == search_entry.file_addr &&
-                    prev_pos->is_terminal_entry == false)
-                  --pos;
+              while (idx != 0) {
+                const Entry prev_entry = GetEntry(idx - 1);
+                if (prev_entry.file_addr == file_addr &&
+                    prev_entry.is_terminal_entry == false)
+                  --idx;
                 else
                   break;
               }
@@ -221,17 +401,16 @@ bool LineTable::FindLineEntryByAddress(const Address &so_addr,
           // There might be code in the containing objfile before the first
           // line table entry.  Make sure that does not get considered part of
           // the first line table entry.
-          if (pos->file_addr > so_addr.GetFileAddress())
+          if (entry.file_addr > file_addr)
             return false;
         }
 
         // Make sure we have a valid match and that the match isn't a
         // terminating entry for a previous line...
-        if (pos != end_pos && pos->is_terminal_entry == false) {
-          uint32_t match_idx = std::distance(begin_pos, pos);
-          success = ConvertEntryAtIndexToLineEntry(match_idx, line_entry);
+        if (idx != count && GetEntry(idx).is_terminal_entry == false) {
+          success = ConvertEntryAtIndexToLineEntry(idx, line_entry);
           if (index_ptr != nullptr && success)
-            *index_ptr = match_idx;
+            *index_ptr = idx;
         }
       }
     }
@@ -241,10 +420,11 @@ bool LineTable::FindLineEntryByAddress(const Address &so_addr,
 
 bool LineTable::ConvertEntryAtIndexToLineEntry(uint32_t idx,
                                                LineEntry &line_entry) {
-  if (idx >= m_entries.size())
+  const uint32_t count = GetSize();
+  if (idx >= count)
     return false;
 
-  const Entry &entry = m_entries[idx];
+  const Entry entry = GetEntry(idx);
   ModuleSP module_sp(m_comp_unit->GetModule());
   if (!module_sp)
     return false;
@@ -264,8 +444,8 @@ bool LineTable::ConvertEntryAtIndexToLineEntry(uint32_t idx,
   if (entry.is_terminal_entry)
     line_entry.range.GetBaseAddress().Slide(1);
 
-  if (!entry.is_terminal_entry && idx + 1 < m_entries.size())
-    line_entry.range.SetByteSize(m_entries[idx + 1].file_addr -
+  if (!entry.is_terminal_entry && idx + 1 < count)
+    line_entry.range.SetByteSize(GetEntry(idx + 1).file_addr -
                                  entry.file_addr);
   else
     line_entry.range.SetByteSize(0);
@@ -288,18 +468,20 @@ uint32_t LineTable::FindLineEntryIndexByFileIndex(
     uint32_t start_idx, const std::vector<uint32_t> &file_indexes,
     uint32_t line, bool exact, LineEntry *line_entry_ptr) {
 
-  const size_t count = m_entries.size();
+  const size_t count = GetSize();
   std::vector<uint32_t>::const_iterator begin_pos = file_indexes.begin();
   std::vector<uint32_t>::const_iterator end_pos = file_indexes.end();
   size_t best_match = UINT32_MAX;
+  uint32_t best_line = 0;
 
   for (size_t idx = start_idx; idx < count; ++idx) {
+    const Entry entry = GetEntry(idx);
     // Skip line table rows that terminate the previous row (is_terminal_entry
     // is non-zero)
-    if (m_entries[idx].is_terminal_entry)
+    if (entry.is_terminal_entry)
       continue;
 
-    if (find(begin_pos, end_pos, m_entries[idx].file_idx) == end_pos)
+    if (find(begin_pos, end_pos, entry.file_idx) == end_pos)
       continue;
 
     // Exact match always wins.  Otherwise try to find the closest line > the
@@ -308,17 +490,17 @@ uint32_t LineTable::FindLineEntryIndexByFileIndex(
     // after and
     // if they're not in the same function, don't return a match.
 
-    if (m_entries[idx].line < line) {
+    if (entry.line < line) {
       continue;
-    } else if (m_entries[idx].line == line) {
+    } else if (entry.line == line) {
       if (line_entry_ptr)
         ConvertEntryAtIndexToLineEntry(idx, *line_entry_ptr);
       return idx;
     } else if (!exact) {
-      if (best_match == UINT32_MAX)
-        best_match = idx;
-      else if (m_entries[idx].line < m_entries[best_match].line)
+      if (best_match == UINT32_MAX || entry.line < best_line) {
         best_match = idx;
+        best_line = entry.line;
+      }
     }
   }
 
@@ -334,16 +516,18 @@ uint32_t LineTable::FindLineEntryIndexByFileIndex(uint32_t start_idx,
                                                   uint32_t file_idx,
                                                   uint32_t line, bool exact,
                                                   LineEntry *line_entry_ptr) {
-  const size_t count = m_entries.size();
+  const size_t count = GetSize();
   size_t best_match = UINT32_MAX;
+  uint32_t best_line = 0;
 
   for (size_t idx = start_idx; idx < count; ++idx) {
+    const Entry entry = GetEntry(idx);
     // Skip line table rows that terminate the previous row (is_terminal_entry
     // is non-zero)
-    if (m_entries[idx].is_terminal_entry)
+    if (entry.is_terminal_entry)
       continue;
 
-    if (m_entries[idx].file_idx != file_idx)
+    if (entry.file_idx != file_idx)
       continue;
 
     // Exact match always wins.  Otherwise try to find the closest line > the
@@ -352,17 +536,17 @@ uint32_t LineTable::FindLineEntryIndexByFileIndex(uint32_t start_idx,
     // after and
     // if they're not in the same function, don't return a match.
 
-    if (m_entries[idx].line < line) {
+    if (entry.line < line) {
       continue;
-    } else if (m_entries[idx].line == line) {
+    } else if (entry.line == line) {
       if (line_entry_ptr)
         ConvertEntryAtIndexToLineEntry(idx, *line_entry_ptr);
       return idx;
     } else if (!exact) {
-      if (best_match == UINT32_MAX)
-        best_match = idx;
-      else if (m_entries[idx].line < m_entries[best_match].line)
+      if (best_match == UINT32_MAX || entry.line < best_line) {
         best_match = idx;
+        best_line = entry.line;
+      }
     }
   }
 
@@ -381,17 +565,18 @@ size_t LineTable::FineLineEntriesForFileIndex(uint32_t file_idx, bool append,
     sc_list.Clear();
 
   size_t num_added = 0;
-  const size_t count = m_entries.size();
+  const size_t count = GetSize();
   if (count > 0) {
     SymbolContext sc(m_comp_unit);
 
     for (size_t idx = 0; idx < count; ++idx) {
+      const Entry entry = GetEntry(idx);
       // Skip line table rows that terminate the previous row
       // (is_terminal_entry is non-zero)
-      if (m_entries[idx].is_terminal_entry)
+      if (entry.is_terminal_entry)
         continue;
 
-      if (m_entries[idx].file_idx == file_idx) {
+      if (entry.file_idx == file_idx) {
         if (ConvertEntryAtIndexToLineEntry(idx, sc.line_entry)) {
           ++num_added;
           sc_list.Append(sc);
@@ -404,7 +589,7 @@ size_t LineTable::FineLineEntriesForFileIndex(uint32_t file_idx, bool append,
 
 void LineTable::Dump(Stream *s, Target *target, Address::DumpStyle style,
                      Address::DumpStyle fallback_style, bool show_line_ranges) {
-  const size_t count = m_entries.size();
+  const size_t count = GetSize();
   LineEntry line_entry;
   FileSpec prev_file;
   for (size_t idx = 0; idx < count; ++idx) {
@@ -418,7 +603,7 @@ void LineTable::Dump(Stream *s, Target *target, Address::DumpStyle style,
 
 void LineTable::GetDescription(Stream *s, Target *target,
                                DescriptionLevel level) {
-  const size_t count = m_entries.size();
+  const size_t count = GetSize();
   LineEntry line_entry;
   for (size_t idx = 0; idx < count; ++idx) {
     ConvertEntryAtIndexToLineEntry(idx, line_entry);
@@ -433,11 +618,11 @@ size_t LineTable::GetContiguousFileAddressRanges(FileAddressRanges &file_ranges,
     file_ranges.Clear();
   const size_t initial_count = file_ranges.GetSize();
 
-  const size_t count = m_entries.size();
+  const size_t count = GetSize();
   LineEntry line_entry;
   FileAddressRanges::Entry range(LLDB_INVALID_ADDRESS, 0);
   for (size_t idx = 0; idx < count; ++idx) {
-    const Entry &entry = m_entries[idx];
+    const Entry entry = GetEntry(idx);
 
     if (entry.is_terminal_entry) {
       if (range.GetRangeBase() != LLDB_INVALID_ADDRESS) {
@@ -455,7 +640,7 @@ size_t LineTable::GetContiguousFileAddressRanges(FileAddressRanges &file_ranges,
 LineTable *LineTable::LinkLineTable(const FileRangeMap &file_range_map) {
   std::unique_ptr<LineTable> line_table_up(new LineTable(m_comp_unit));
   LineSequenceImpl sequence;
-  const size_t count = m_entries.size();
+  const size_t count = GetSize();
   LineEntry line_entry;
   const FileRangeMap::Entry *file_range_entry = nullptr;
   const FileRangeMap::Entry *prev_file_range_entry = nullptr;
@@ -463,7 +648,7 @@ LineTable *LineTable::LinkLineTable(const FileRangeMap &file_range_map) {
   bool prev_entry_was_linked = false;
   bool range_changed = false;
   for (size_t idx = 0; idx < count; ++idx) {
-    const Entry &entry = m_entries[idx];
+    const Entry entry = GetEntry(idx);
 
     const bool end_sequence = entry.is_terminal_entry;
     const lldb::addr_t lookup_file_addr =
@@ -541,7 +726,7 @@ LineTable *LineTable::LinkLineTable(const FileRangeMap &file_range_map) {
     prev_file_addr = entry.file_addr;
     range_changed = false;
   }
-  if (line_table_up->m_entries.empty())
+  if (line_table_up->GetSize() == 0)
     return nullptr;
   return line_table_up.release();
 }
@@ -41,10 +41,12 @@
 #include "swift/Basic/Platform.h"
 #include "swift/Basic/PrimarySpecificPaths.h"
 #include "swift/Basic/SourceManager.h"
+#include "swift/Basic/Version.h"
 #include "swift/ClangImporter/ClangImporter.h"
 #include "swift/ClangImporter/ClangImporterOptions.h"
 #include "swift/Demangling/Demangle.h"
 #include "swift/Demangling/ManglingMacros.h"
+#include "swift/Demangling/TypeDecoder.h"
 #include "swift/Frontend/Frontend.h"
 #include "swift/Frontend/ModuleInterfaceLoader.h"
 #include "swift/Frontend/PrintingDiagnosticConsumer.h"
@@ -63,6 +65,8 @@
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
@@ -89,6 +93,7 @@
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/DumpDataExtractor.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
@@ -96,6 +101,7 @@
 #include "lldb/Core/ThreadSafeDenseMap.h"
 #include "lldb/Expression/DiagnosticManager.h"
 #include "lldb/Expression/IRExecutionUnit.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/HostInfo.h"
 #include "lldb/Host/StringConvert.h"
@@ -184,6 +190,40 @@ static ThreadSafeSwiftASTMap &GetASTMap() {
   return *g_map_ptr;
 }
 
+namespace {
+/// The demangle tree of a mangled type name. Demangling doesn't depend on
+/// the ASTContext, so these trees are shared by all SwiftASTContexts and
+/// only the type reconstruction from the tree happens once per context.
+struct DemangledTypeName {
+  swift::Demangle::Context context;
+  swift::Demangle::NodePointer node = nullptr;
+};
+} // namespace
+
+typedef std::shared_ptr<DemangledTypeName> DemangledTypeNameSP;
+typedef lldb_private::ThreadSafeDenseMap<const char *, DemangledTypeNameSP>
+    ThreadSafeDemangledTypeNameMap;
+
+static DemangledTypeNameSP GetDemangledTypeName(ConstString mangled_name) {
+  // Leaked intentionally, like the map in GetASTMap().
+  static ThreadSafeDemangledTypeNameMap *g_map_ptr = NULL;
+  static std::once_flag g_once_flag;
+  std::call_once(g_once_flag, []() {
+    // Intentional leak.
+    g_map_ptr = new ThreadSafeDemangledTypeNameMap();
+  });
+
+  DemangledTypeNameSP demangled;
+  if (g_map_ptr->Lookup(mangled_name.GetCString(), demangled))
+    return demangled;
+  // The tree is complete before it is published, and never modified after.
+  demangled = std::make_shared<DemangledTypeName>();
+  demangled->node =
+      demangled->context.demangleSymbolAsNode(mangled_name.GetStringRef());
+  g_map_ptr->Insert(mangled_name.GetCString(), demangled);
+  return demangled;
+}
+
 class SwiftEnumDescriptor;
 
 typedef std::shared_ptr<SwiftEnumDescriptor> SwiftEnumDescriptorSP;
@@ -930,6 +970,10 @@ ConstString SwiftASTContext::GetPluginName() {
 
 uint32_t SwiftASTContext::GetPluginVersion() { return 1; }
 
+size_t SwiftASTContext::GetMemoryUsage() {
+  return m_ast_context_ap ? m_ast_context_ap->getTotalMemory() : 0;
+}
+
 namespace {
 enum SDKType : int {
   MacOSX = 0,
@@ -3544,6 +3588,7 @@ SwiftASTContext::GetCachedModule(const SourceModule &module) {
   if (!module.path.size())
     return nullptr;
 
+  std::lock_guard<std::mutex> guard(m_swift_module_cache_mutex);
   SwiftModuleMap::const_iterator iter =
       m_swift_module_cache.find(module.path.front().GetStringRef());
 
@@ -3581,6 +3626,7 @@ swift::ModuleDecl *SwiftASTContext::CreateModule(const SourceModule &module,
     return nullptr;
   }
 
+  std::lock_guard<std::mutex> guard(m_swift_module_cache_mutex);
   m_swift_module_cache.insert(
       {module.path.front().GetStringRef(), module_decl});
   return module_decl;
@@ -3594,8 +3640,8 @@ void SwiftASTContext::CacheModule(swift::ModuleDecl *module) {
   auto ID = module->getName().get();
   if (!ID || !ID[0])
     return;
-  if (m_swift_module_cache.find(ID) != m_swift_module_cache.end())
-    return;
+  // Doesn't replace a module that is already cached under this name.
+  std::lock_guard<std::mutex> guard(m_swift_module_cache_mutex);
   m_swift_module_cache.insert({ID, module});
 }
 
@@ -3667,6 +3713,7 @@ swift::ModuleDecl *SwiftASTContext::GetModule(const SourceModule &module,
              module.path.front().GetCString(),
              module_decl->getName().str().str().c_str());
 
+  std::lock_guard<std::mutex> guard(m_swift_module_cache_mutex);
   m_swift_module_cache[module.path.front().GetStringRef()] = module_decl;
   return module_decl;
 }
@@ -3680,11 +3727,10 @@ swift::ModuleDecl *SwiftASTContext::GetModule(const FileSpec &module_spec,
   LOG_PRINTF(LIBLLDB_LOG_TYPES, "(\"%s\")", module_spec.GetPath().c_str());
 
   if (module_basename) {
-    SwiftModuleMap::const_iterator iter =
-        m_swift_module_cache.find(module_basename.GetCString());
-
-    if (iter != m_swift_module_cache.end())
-      return iter->second;
+    SourceModule module_info;
+    module_info.path.push_back(module_basename);
+    if (swift::ModuleDecl *module_decl = GetCachedModule(module_info))
+      return module_decl;
 
     if (FileSystem::Instance().Exists(module_spec)) {
       swift::ASTContext *ast = GetASTContext();
@@ -3720,6 +3766,7 @@ swift::ModuleDecl *SwiftASTContext::GetModule(const FileSpec &module_spec,
                    module_spec.GetPath().c_str(),
                    module->getName().str().str().c_str());
 
+        std::lock_guard<std::mutex> guard(m_swift_module_cache_mutex);
         m_swift_module_cache[module_basename.GetCString()] = module;
         return module;
       } else {
@@ -4213,15 +4260,91 @@ void SwiftASTContext::ValidateSectionModules(
     Module &module, const std::vector<std::string> &module_names) {
   VALID_OR_RETURN_VOID();
 
+  if (module_names.empty())
+    return;
+
+  FileSpec cache_dir = ModuleList::GetGlobalModuleListProperties()
+                           .GetSwiftModuleValidationCachePath();
+  FileSpec cache_file;
+  if (cache_dir) {
+    std::string key = GetSectionModulesValidationKey(module, module_names);
+    if (!key.empty()) {
+      cache_file = cache_dir;
+      cache_file.AppendPathComponent(key + ".swift-modules-validated");
+    }
+  }
+
+  if (cache_file && FileSystem::Instance().Exists(cache_file)) {
+    LOG_PRINTF(LIBLLDB_LOG_TYPES,
+               "(\"%s\") skipping validation of %zu Swift modules, they "
+               "loaded without errors before",
+               module.GetFileSpec().GetFilename().AsCString("<anonymous>"),
+               module_names.size());
+    return;
+  }
+
   Status error;
+  bool all_loaded = true;
 
   for (const std::string &module_name : module_names) {
     SourceModule module_info;
     module_info.path.push_back(ConstString(module_name));
-    if (!GetModule(module_info, error))
+    if (!GetModule(module_info, error)) {
       module.ReportWarning("unable to load swift module \"%s\" (%s)",
                            module_name.c_str(), error.AsCString());
+      all_loaded = false;
+    }
   }
+
+  if (!all_loaded || !cache_file || HasErrors())
+    return;
+
+  // Record the modules that were validated, which makes the cache easier to
+  // inspect by hand. Only the existence of the file matters.
+  if (llvm::sys::fs::create_directories(cache_dir.GetPath()))
+    return;
+  std::error_code ec;
+  llvm::raw_fd_ostream os(cache_file.GetPath(), ec, llvm::sys::fs::F_None);
+  if (ec)
+    return;
+  for (const std::string &module_name : module_names)
+    os << module_name << '\n';
+}
+
+std::string SwiftASTContext::GetSectionModulesValidationKey(
+    Module &module, const std::vector<std::string> &module_names) {
+  const UUID &uuid = module.GetUUID();
+  if (!uuid.IsValid())
+    return {};
+
+  llvm::MD5 hash;
+  auto add = [&hash](llvm::StringRef str) {
+    hash.update(str);
+    // Separate the strings so that their concatenation is unambiguous.
+    const uint8_t separator = 0;
+    hash.update(llvm::makeArrayRef(separator));
+  };
+
+  hash.update(uuid.GetBytes());
+  add(std::to_string(llvm::sys::toTimeT(module.GetModificationTime())));
+  add(swift::version::getSwiftFullVersion());
+  add(GetTriple().str());
+  add(GetPlatformSDKPath());
+  add(GetCompilerInvocation().getSDKPath());
+
+  const swift::SearchPathOptions &search_path_opts = GetSearchPathOptions();
+  for (const std::string &path : search_path_opts.ImportSearchPaths)
+    add(path);
+  for (const auto &framework : search_path_opts.FrameworkSearchPaths)
+    add(framework.Path);
+  for (const std::string &arg : GetClangImporterOptions().ExtraArgs)
+    add(arg);
+  for (const std::string &module_name : module_names)
+    add(module_name);
+
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  return result.digest().str();
 }
 
 swift::Identifier SwiftASTContext::GetIdentifier(const llvm::StringRef &name) {
@@ -4328,9 +4451,15 @@ SwiftASTContext::GetTypeFromMangledTypename(ConstString mangled_typename,
   LOG_PRINTF(LIBLLDB_LOG_TYPES, "(\"%s\") -- not cached, searching",
              mangled_cstr);
 
-  found_type = swift::Demangle::getTypeForMangling(
-                   *ast_ctx, mangled_typename.GetStringRef())
-                   .getPointer();
+  // This is what swift::Demangle::getTypeForMangling() does, but with a
+  // demangle tree that is shared with the other contexts.
+  if (DemangledTypeNameSP demangled = GetDemangledTypeName(mangled_typename))
+    if (demangled->node) {
+      swift::Demangle::ASTBuilder builder(*ast_ctx);
+      found_type =
+          swift::Demangle::decodeMangledType(builder, demangled->node)
+              .getPointer();
+    }
 
   if (found_type) {
     found_type =
@@ -4605,7 +4734,14 @@ size_t SwiftASTContext::FindType(const char *name,
 
   if (!append)
     results.clear();
-  auto iter = m_swift_module_cache.begin(), end = m_swift_module_cache.end();
+
+  // Don't hold the lock while looking into the modules.
+  std::vector<swift::ModuleDecl *> modules;
+  {
+    std::lock_guard<std::mutex> guard(m_swift_module_cache_mutex);
+    for (auto &entry : m_swift_module_cache)
+      modules.push_back(entry.second);
+  }
 
   size_t count = 0;
 
@@ -4618,8 +4754,8 @@ size_t SwiftASTContext::FindType(const char *name,
     }
   };
 
-  for (; iter != end; iter++)
-    lookup_func(iter->second);
+  for (swift::ModuleDecl *module : modules)
+    lookup_func(module);
 
   if (m_scratch_module)
     lookup_func(m_scratch_module);
@@ -4746,6 +4882,7 @@ swift::irgen::IRGenModule &SwiftASTContext::GetIRGenModule() {
 
     swift::IRGenOptions &ir_gen_opts = GetIRGenOptions();
 
+    PluginManager::InitializeLLVMTargets();
     std::string error_str;
     llvm::Triple llvm_triple = GetTriple();
     const llvm::Target *llvm_target =
@@ -8418,11 +8555,10 @@ bool SwiftASTContext::PerformUserImport(SwiftASTContext &swift_ast_context,
   return true;
 }
 
-bool SwiftASTContext::PerformAutoImport(SwiftASTContext &swift_ast_context,
-                                        SymbolContext &sc,
-                                        lldb::StackFrameWP &stack_frame_wp,
-                                        swift::SourceFile *source_file,
-                                        Status &error) {
+bool SwiftASTContext::PerformAutoImport(
+    SwiftASTContext &swift_ast_context, SymbolContext &sc,
+    lldb::StackFrameWP &stack_frame_wp, swift::SourceFile *source_file,
+    Status &error, std::vector<SourceModule> *deferred_imports) {
   llvm::SmallVector<swift::SourceFile::ImportedModuleDesc, 2>
       additional_imports;
 
@@ -8445,6 +8581,11 @@ bool SwiftASTContext::PerformAutoImport(SwiftASTContext &swift_ast_context,
               .Default(false))
         continue;
 
+      if (deferred_imports) {
+        deferred_imports->push_back(module);
+        continue;
+      }
+
       if (!LoadOneModule(module, swift_ast_context, stack_frame_wp,
                          additional_imports, error))
         return false;
@@ -8455,3 +8596,16 @@ bool SwiftASTContext::PerformAutoImport(SwiftASTContext &swift_ast_context,
     source_file->addImports(additional_imports);
   return true;
 }
+
+swift::ModuleDecl *
+SwiftASTContext::LoadDeferredImport(SwiftASTContext &swift_ast_context,
+                                    const SourceModule &module,
+                                    lldb::StackFrameWP &stack_frame_wp,
+                                    Status &error) {
+  llvm::SmallVector<swift::SourceFile::ImportedModuleDesc, 1>
+      additional_imports;
+  if (!LoadOneModule(module, swift_ast_context, stack_frame_wp,
+                     additional_imports, error))
+    return nullptr;
+  return additional_imports.front().module.second;
+}
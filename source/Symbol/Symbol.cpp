@@ -17,6 +17,8 @@
 #include "lldb/Symbol/Symtab.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
+#include "lldb/Utility/ConstStringTable.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Stream.h"
 
 using namespace lldb;
@@ -571,3 +573,90 @@ bool Symbol::GetDisassembly(const ExecutionContext &exe_ctx, const char *flavor,
 bool Symbol::ContainsFileAddress(lldb::addr_t file_addr) const {
   return m_addr_range.ContainsFileAddress(file_addr);
 }
+
+// Names are encoded as their index in the string table plus one, so that an
+// empty name and no name at all can be told apart.
+static void EncodeName(Stream &s, ConstStringTable &strtab, ConstString name) {
+  s.PutHex32(name.GetCString() ? strtab.Add(name) + 1 : 0);
+}
+
+static bool DecodeName(const DataExtractor &data, lldb::offset_t *offset_ptr,
+                       const ConstStringTable &strtab, ConstString &name) {
+  const uint32_t idx = data.GetU32(offset_ptr);
+  if (idx == 0) {
+    name.Clear();
+    return true;
+  }
+  name = strtab.Get(idx - 1);
+  return name.GetCString() != nullptr;
+}
+
+bool Symbol::Encode(
+    Stream &s, ConstStringTable &strtab,
+    const llvm::DenseMap<const Section *, uint32_t> &section_ids) const {
+  uint32_t section_id = 0;
+  if (SectionSP section_sp = m_addr_range.GetBaseAddress().GetSection()) {
+    auto pos = section_ids.find(section_sp.get());
+    if (pos == section_ids.end())
+      return false;
+    section_id = pos->second;
+  }
+
+  const uint32_t bits = m_type_data_resolved | m_is_synthetic << 1 |
+                        m_is_debug << 2 | m_is_external << 3 |
+                        m_size_is_sibling << 4 | m_size_is_synthesized << 5 |
+                        m_size_is_valid << 6 |
+                        m_demangled_is_synthesized << 7 |
+                        m_contains_linker_annotations << 8 | m_is_weak << 9 |
+                        m_type << 10;
+  s.PutHex32(m_uid);
+  s.PutHex32(bits);
+  s.PutHex16(m_type_data);
+  // Store the demangled name as well, so it doesn't have to be computed
+  // again after loading.
+  EncodeName(s, strtab, m_mangled.GetMangledName());
+  EncodeName(s, strtab, m_mangled.GetDemangledName(GetLanguage()));
+  s.PutHex32(section_id);
+  s.PutHex64(m_addr_range.GetBaseAddress().GetOffset());
+  s.PutHex64(m_addr_range.GetByteSize());
+  s.PutHex32(m_flags);
+  return true;
+}
+
+bool Symbol::Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
+                    const ConstStringTable &strtab,
+                    llvm::ArrayRef<lldb::SectionSP> sections) {
+  if (!data.ValidOffsetForDataOfSize(*offset_ptr, 42))
+    return false;
+  m_uid = data.GetU32(offset_ptr);
+  const uint32_t bits = data.GetU32(offset_ptr);
+  m_type_data_resolved = bits & 1;
+  m_is_synthetic = (bits >> 1) & 1;
+  m_is_debug = (bits >> 2) & 1;
+  m_is_external = (bits >> 3) & 1;
+  m_size_is_sibling = (bits >> 4) & 1;
+  m_size_is_synthesized = (bits >> 5) & 1;
+  m_size_is_valid = (bits >> 6) & 1;
+  m_demangled_is_synthesized = (bits >> 7) & 1;
+  m_contains_linker_annotations = (bits >> 8) & 1;
+  m_is_weak = (bits >> 9) & 1;
+  m_type = (bits >> 10) & 0x3f;
+  m_type_data = data.GetU16(offset_ptr);
+
+  ConstString mangled, demangled;
+  if (!DecodeName(data, offset_ptr, strtab, mangled) ||
+      !DecodeName(data, offset_ptr, strtab, demangled))
+    return false;
+  m_mangled.SetMangledName(mangled);
+  m_mangled.SetDemangledName(demangled);
+
+  const uint32_t section_id = data.GetU32(offset_ptr);
+  if (section_id > sections.size())
+    return false;
+  SectionSP section_sp = section_id ? sections[section_id - 1] : SectionSP();
+  const addr_t offset = data.GetU64(offset_ptr);
+  const addr_t size = data.GetU64(offset_ptr);
+  m_addr_range = AddressRange(section_sp, offset, size);
+  m_flags = data.GetU32(offset_ptr);
+  return true;
+}
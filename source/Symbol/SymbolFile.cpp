@@ -19,6 +19,7 @@
 #include "lldb/Symbol/VariableList.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/StreamString.h"
+#include "lldb/Utility/Timer.h"
 #include "lldb/lldb-private.h"
 
 #include <future>
@@ -261,8 +262,14 @@ Symtab *SymbolFile::GetSymtab() {
   if (m_symtab)
     return m_symtab;
 
+  ObjectFile *objfile = GetMainObjectFile();
+  ModuleSP module_sp = objfile->GetModule();
+  llvm::Optional<ElapsedTime> elapsed;
+  if (module_sp)
+    elapsed.emplace(module_sp->GetSymtabParseTime());
+
   // Fetch the symtab from the main object file.
-  m_symtab = GetMainObjectFile()->GetSymtab();
+  m_symtab = objfile->GetSymtab();
 
   // Then add our symbols to it.
   if (m_symtab)
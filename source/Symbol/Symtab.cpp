@@ -12,20 +12,35 @@
 #include "Plugins/Language/ObjC/ObjCLanguage.h"
 
 #include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/RichManglingContext.h"
 #include "lldb/Core/STLUtils.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Symbol/Symtab.h"
+#include "lldb/Utility/ConstStringTable.h"
+#include "lldb/Utility/DataBufferLLVM.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/Log.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
+#include "lldb/Utility/StreamString.h"
 #include "lldb/Utility/Timer.h"
 
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/DJB.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/LockFileManager.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include "lldb/Target/SwiftLanguageRuntime.h"
+#include "swift/Demangling/Demangle.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -55,7 +70,9 @@ uint32_t Symtab::AddSymbol(const Symbol &symbol) {
   // when calling this function to avoid performance issues.
   uint32_t symbol_idx = m_symbols.size();
   m_name_to_index.Clear();
+  m_sorted_function_names.clear();
   m_file_addr_to_index.Clear();
+  ClearAddressSearchIndex();
   m_symbols.push_back(symbol);
   m_file_addr_to_index_computed = false;
   m_name_indexes_computed = false;
@@ -67,6 +84,18 @@ size_t Symtab::GetNumSymbols() const {
   return m_symbols.size();
 }
 
+size_t Symtab::MemorySize() const {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  return sizeof(Symtab) + m_symbols.capacity() * sizeof(Symbol) +
+         m_file_addr_to_index.GetSize() * sizeof(FileRangeToIndexMap::Entry) +
+         m_file_addr_eytzinger.capacity() * sizeof(lldb::addr_t) +
+         m_file_addr_eytzinger_rank.capacity() * sizeof(uint32_t) +
+         m_file_addr_max_end.capacity() * sizeof(lldb::addr_t) +
+         m_name_to_index.MemorySize() + m_basename_to_index.MemorySize() +
+         m_method_to_index.MemorySize() + m_selector_to_index.MemorySize() +
+         m_sorted_function_names.capacity() * sizeof(ConstString);
+}
+
 void Symtab::SectionFileAddressesChanged() {
   m_name_to_index.Clear();
   m_file_addr_to_index_computed = false;
@@ -262,114 +291,154 @@ void Symtab::InitNameIndexes() {
     Timer scoped_timer(func_cat, "%s", LLVM_PRETTY_FUNCTION);
     // Create the name index vector to be able to quickly search by name
     const size_t num_symbols = m_symbols.size();
-    m_name_to_index.Reserve(num_symbols);
 
-    // The "const char *" in "class_contexts" and backlog::value_type::second
-    // must come from a ConstString::GetCString()
+    // Demangle and index the symbols in parallel. Every task indexes a
+    // contiguous range of symbols into its own NameIndexSet, and the sets are
+    // merged in symbol order afterwards. Use a few more ranges than there are
+    // threads so that ranges with expensive names don't stall the others.
+    const size_t min_symbols_per_set = 4096;
+    const size_t num_sets = std::max<size_t>(
+        1, std::min<size_t>(4 * GetHardwareConcurrencyHint(),
+                            num_symbols / min_symbols_per_set));
+    const size_t symbols_per_set = (num_symbols + num_sets - 1) / num_sets;
+    std::vector<NameIndexSet> sets(num_sets);
+    TaskMapOverInt(0, num_sets, [&](size_t set_idx) {
+      const uint32_t begin = set_idx * symbols_per_set;
+      const uint32_t end =
+          std::min<size_t>(num_symbols, begin + symbols_per_set);
+      IndexSymbolNames(begin, end, sets[set_idx]);
+    });
+
+    m_name_to_index.Reserve(num_symbols);
     std::set<const char *> class_contexts;
-    std::vector<std::pair<NameToIndexMap::Entry, const char *>> backlog;
-    backlog.reserve(num_symbols / 2);
-
-    // Instantiation of the demangler is expensive, so better use a single one
-    // for all entries during batch processing.
-    RichManglingContext rmc;
-    for (uint32_t value = 0; value < num_symbols; ++value) {
-      Symbol *symbol = &m_symbols[value];
-
-      // Don't let trampolines get into the lookup by name map If we ever need
-      // the trampoline symbols to be searchable by name we can remove this and
-      // then possibly add a new bool to any of the Symtab functions that
-      // lookup symbols by name to indicate if they want trampolines.
-      if (symbol->IsTrampoline())
-        continue;
+    for (NameIndexSet &set : sets) {
+      AppendNameToIndexMap(set.name_to_index, m_name_to_index);
+      AppendNameToIndexMap(set.selector_to_index, m_selector_to_index);
+      AppendNameToIndexMap(set.basename_to_index, m_basename_to_index);
+      AppendNameToIndexMap(set.method_to_index, m_method_to_index);
+      class_contexts.insert(set.class_contexts.begin(),
+                            set.class_contexts.end());
+    }
 
-      // If the symbol's name string matched a Mangled::ManglingScheme, it is
-      // stored in the mangled field.
-      Mangled &mangled = symbol->GetMangled();
-      if (ConstString name = mangled.GetMangledName()) {
-        m_name_to_index.Append(name, value);
-
-        // Now try and figure out the basename and figure out if the
-        // basename is a method, function, etc and put that in the
-        // appropriate table.
-        if (symbol->ContainsLinkerAnnotations()) {
-          // If the symbol has linker annotations, also add the version without
-          // the annotations.
-          ConstString stripped = ConstString(
-              m_objfile->StripLinkerSymbolAnnotations(name.GetStringRef()));
-          m_name_to_index.Append(stripped, value);
-        }
+    // A declaration context may only have been seen in another range, so the
+    // backlogs can only be resolved once all class contexts are known.
+    for (const NameIndexSet &set : sets) {
+      for (const auto &record : set.backlog)
+        RegisterBacklogEntry(record.first, record.second, class_contexts);
+    }
+    sets.clear();
+
+    auto finalize_fn = [](NameToIndexMap &map) {
+      map.Sort();
+      map.SizeToFit();
+    };
+    TaskPool::RunTasks([&]() { finalize_fn(m_name_to_index); },
+                       [&]() { finalize_fn(m_selector_to_index); },
+                       [&]() { finalize_fn(m_basename_to_index); },
+                       [&]() { finalize_fn(m_method_to_index); });
+  }
+}
 
-        const SymbolType type = symbol->GetType();
-        if (type == eSymbolTypeCode || type == eSymbolTypeResolver) {
-          if (mangled.DemangleWithRichManglingInfo(rmc, lldb_skip_name))
-            RegisterMangledNameEntry(value, class_contexts, backlog, rmc);
-	  else if (SwiftLanguageRuntime::IsSwiftMangledName(name.GetCString())) {
-            lldb_private::ConstString basename;
-            bool is_method = false;
-            ConstString mangled_name = mangled.GetMangledName();
-            if (SwiftLanguageRuntime::MethodName::
-                    ExtractFunctionBasenameFromMangled(mangled_name, basename,
-                                                       is_method)) {
-              if (basename && basename != mangled_name) {
-                if (is_method)
-                  m_method_to_index.Append(basename, value);
-                else
-                  m_basename_to_index.Append(basename, value);
-              }
+void Symtab::AppendNameToIndexMap(const NameToIndexMap &source,
+                                  NameToIndexMap &dest) {
+  const size_t size = source.GetSize();
+  for (size_t i = 0; i < size; ++i)
+    dest.Append(source.GetCStringAtIndexUnchecked(i),
+                source.GetValueAtIndexUnchecked(i));
+}
+
+void Symtab::IndexSymbolNames(uint32_t begin, uint32_t end,
+                              NameIndexSet &set) {
+  // The "const char *" in "class_contexts" and backlog::value_type::second
+  // must come from a ConstString::GetCString()
+  set.backlog.reserve((end - begin) / 2);
+
+  // Instantiation of the demangler is expensive, so better use a single one
+  // for all entries during batch processing.
+  RichManglingContext rmc;
+  swift::Demangle::Context swift_demangle_ctx;
+  for (uint32_t value = begin; value < end; ++value) {
+    Symbol *symbol = &m_symbols[value];
+
+    // Don't let trampolines get into the lookup by name map If we ever need
+    // the trampoline symbols to be searchable by name we can remove this and
+    // then possibly add a new bool to any of the Symtab functions that
+    // lookup symbols by name to indicate if they want trampolines.
+    if (symbol->IsTrampoline())
+      continue;
+
+    // If the symbol's name string matched a Mangled::ManglingScheme, it is
+    // stored in the mangled field.
+    Mangled &mangled = symbol->GetMangled();
+    if (ConstString name = mangled.GetMangledName()) {
+      set.name_to_index.Append(name, value);
+
+      // Now try and figure out the basename and figure out if the
+      // basename is a method, function, etc and put that in the
+      // appropriate table.
+      if (symbol->ContainsLinkerAnnotations()) {
+        // If the symbol has linker annotations, also add the version without
+        // the annotations.
+        ConstString stripped = ConstString(
+            m_objfile->StripLinkerSymbolAnnotations(name.GetStringRef()));
+        set.name_to_index.Append(stripped, value);
+      }
+
+      const SymbolType type = symbol->GetType();
+      if (type == eSymbolTypeCode || type == eSymbolTypeResolver) {
+        if (mangled.DemangleWithRichManglingInfo(rmc, lldb_skip_name))
+          RegisterMangledNameEntry(value, set, rmc);
+        else if (SwiftLanguageRuntime::IsSwiftMangledName(name.GetCString())) {
+          lldb_private::ConstString basename;
+          bool is_method = false;
+          ConstString mangled_name = mangled.GetMangledName();
+          if (SwiftLanguageRuntime::MethodName::
+                  ExtractFunctionBasenameFromMangled(mangled_name, basename,
+                                                     is_method,
+                                                     swift_demangle_ctx)) {
+            if (basename && basename != mangled_name) {
+              if (is_method)
+                set.method_to_index.Append(basename, value);
+              else
+                set.basename_to_index.Append(basename, value);
             }
           }
         }
       }
+    }
 
-      // Symbol name strings that didn't match a Mangled::ManglingScheme, are
-      // stored in the demangled field.
-      SymbolContext sc;
-      symbol->CalculateSymbolContext(&sc);
-      sc.module_sp = m_objfile->GetModule();
-      if (ConstString name = mangled.GetDemangledName(symbol->GetLanguage(), &sc)) {
-        m_name_to_index.Append(name, value);
-
-        if (symbol->ContainsLinkerAnnotations()) {
-          // If the symbol has linker annotations, also add the version without
-          // the annotations.
-          name = ConstString(
-              m_objfile->StripLinkerSymbolAnnotations(name.GetStringRef()));
-          m_name_to_index.Append(name, value);
-        }
+    // Symbol name strings that didn't match a Mangled::ManglingScheme, are
+    // stored in the demangled field.
+    SymbolContext sc;
+    symbol->CalculateSymbolContext(&sc);
+    sc.module_sp = m_objfile->GetModule();
+    if (ConstString name = mangled.GetDemangledName(symbol->GetLanguage(), &sc)) {
+      set.name_to_index.Append(name, value);
+
+      if (symbol->ContainsLinkerAnnotations()) {
+        // If the symbol has linker annotations, also add the version without
+        // the annotations.
+        name = ConstString(
+            m_objfile->StripLinkerSymbolAnnotations(name.GetStringRef()));
+        set.name_to_index.Append(name, value);
+      }
 
-        // If the demangled name turns out to be an ObjC name, and is a category
-        // name, add the version without categories to the index too.
-        ObjCLanguage::MethodName objc_method(name.GetStringRef(), true);
-        if (objc_method.IsValid(true)) {
-          m_selector_to_index.Append(objc_method.GetSelector(), value);
+      // If the demangled name turns out to be an ObjC name, and is a category
+      // name, add the version without categories to the index too.
+      ObjCLanguage::MethodName objc_method(name.GetStringRef(), true);
+      if (objc_method.IsValid(true)) {
+        set.selector_to_index.Append(objc_method.GetSelector(), value);
 
-          if (ConstString objc_method_no_category =
-                  objc_method.GetFullNameWithoutCategory(true))
-            m_name_to_index.Append(objc_method_no_category, value);
-        }
+        if (ConstString objc_method_no_category =
+                objc_method.GetFullNameWithoutCategory(true))
+          set.name_to_index.Append(objc_method_no_category, value);
       }
     }
-
-    for (const auto &record : backlog) {
-      RegisterBacklogEntry(record.first, record.second, class_contexts);
-    }
-
-    m_name_to_index.Sort();
-    m_name_to_index.SizeToFit();
-    m_selector_to_index.Sort();
-    m_selector_to_index.SizeToFit();
-    m_basename_to_index.Sort();
-    m_basename_to_index.SizeToFit();
-    m_method_to_index.Sort();
-    m_method_to_index.SizeToFit();
   }
 }
 
-void Symtab::RegisterMangledNameEntry(
-    uint32_t value, std::set<const char *> &class_contexts,
-    std::vector<std::pair<NameToIndexMap::Entry, const char *>> &backlog,
-    RichManglingContext &rmc) {
+void Symtab::RegisterMangledNameEntry(uint32_t value, NameIndexSet &set,
+                                      RichManglingContext &rmc) {
   // Only register functions that have a base name.
   rmc.ParseFunctionBaseName();
   llvm::StringRef base_name = rmc.GetBufferRef();
@@ -385,36 +454,36 @@ void Symtab::RegisterMangledNameEntry(
   // Register functions with no context.
   if (decl_context.empty()) {
     // This has to be a basename
-    m_basename_to_index.Append(entry);
+    set.basename_to_index.Append(entry);
     // If there is no context (no namespaces or class scopes that come before
     // the function name) then this also could be a fullname.
-    m_name_to_index.Append(entry);
+    set.name_to_index.Append(entry);
     return;
   }
 
   // Make sure we have a pool-string pointer and see if we already know the
   // context name.
   const char *decl_context_ccstr = ConstString(decl_context).GetCString();
-  auto it = class_contexts.find(decl_context_ccstr);
+  auto it = set.class_contexts.find(decl_context_ccstr);
 
   // Register constructors and destructors. They are methods and create
   // declaration contexts.
   if (rmc.IsCtorOrDtor()) {
-    m_method_to_index.Append(entry);
-    if (it == class_contexts.end())
-      class_contexts.insert(it, decl_context_ccstr);
+    set.method_to_index.Append(entry);
+    if (it == set.class_contexts.end())
+      set.class_contexts.insert(it, decl_context_ccstr);
     return;
   }
 
   // Register regular methods with a known declaration context.
-  if (it != class_contexts.end()) {
-    m_method_to_index.Append(entry);
+  if (it != set.class_contexts.end()) {
+    set.method_to_index.Append(entry);
     return;
   }
 
   // Regular methods in unknown declaration contexts are put to the backlog. We
   // will revisit them once we processed all remaining symbols.
-  backlog.push_back(std::make_pair(entry, decl_context_ccstr));
+  set.backlog.push_back(std::make_pair(entry, decl_context_ccstr));
 }
 
 void Symtab::RegisterBacklogEntry(
@@ -705,12 +774,13 @@ uint32_t Symtab::AppendSymbolIndexesMatchingRegExAndType(
 
   uint32_t prev_size = indexes.size();
   uint32_t sym_end = m_symbols.size();
+  const llvm::StringRef prefix = regexp.GetLiteralPrefix();
 
   for (uint32_t i = 0; i < sym_end; i++) {
     if (symbol_type == eSymbolTypeAny ||
         m_symbols[i].GetType() == symbol_type) {
-      const char *name = m_symbols[i].GetName().AsCString();
-      if (name) {
+      llvm::StringRef name = m_symbols[i].GetName().GetStringRef();
+      if (!name.empty() && name.startswith(prefix)) {
         if (regexp.Execute(name))
           indexes.push_back(i);
       }
@@ -727,6 +797,7 @@ uint32_t Symtab::AppendSymbolIndexesMatchingRegExAndType(
 
   uint32_t prev_size = indexes.size();
   uint32_t sym_end = m_symbols.size();
+  const llvm::StringRef prefix = regexp.GetLiteralPrefix();
 
   for (uint32_t i = 0; i < sym_end; i++) {
     if (symbol_type == eSymbolTypeAny ||
@@ -734,8 +805,8 @@ uint32_t Symtab::AppendSymbolIndexesMatchingRegExAndType(
       if (!CheckSymbolAtIndex(i, symbol_debug_type, symbol_visibility))
         continue;
 
-      const char *name = m_symbols[i].GetName().AsCString();
-      if (name) {
+      llvm::StringRef name = m_symbols[i].GetName().GetStringRef();
+      if (!name.empty() && name.startswith(prefix)) {
         if (regexp.Execute(name))
           indexes.push_back(i);
       }
@@ -968,6 +1039,7 @@ void Symtab::InitAddressIndexes() {
       // Sort again in case the range size changes the ordering
       m_file_addr_to_index.Sort();
     }
+    InitAddressSearchIndex();
   }
 }
 
@@ -992,20 +1064,134 @@ Symbol *Symtab::FindSymbolAtFileAddress(addr_t file_addr) {
   return nullptr;
 }
 
+// Fill in the Eytzinger layout of the sorted bases by an in-order walk of
+// the implicit tree rooted at node k.
+static void FillEytzinger(const std::vector<addr_t> &bases, size_t &i,
+                          size_t k, std::vector<addr_t> &eytzinger,
+                          std::vector<uint32_t> &rank) {
+  if (k > bases.size())
+    return;
+  FillEytzinger(bases, i, 2 * k, eytzinger, rank);
+  eytzinger[k] = bases[i];
+  rank[k] = i++;
+  FillEytzinger(bases, i, 2 * k + 1, eytzinger, rank);
+}
+
+void Symtab::InitAddressSearchIndex() {
+  // Protected function, no need to lock mutex...
+  ClearAddressSearchIndex();
+  const size_t num_entries = m_file_addr_to_index.GetSize();
+  if (num_entries == 0)
+    return;
+
+  std::vector<addr_t> bases(num_entries);
+  m_file_addr_max_end.resize(num_entries);
+  addr_t max_end = 0;
+  for (size_t i = 0; i < num_entries; ++i) {
+    const FileRangeToIndexMap::Entry &entry =
+        m_file_addr_to_index.GetEntryRef(i);
+    bases[i] = entry.GetRangeBase();
+    max_end = std::max(max_end, entry.GetRangeEnd());
+    m_file_addr_max_end[i] = max_end;
+  }
+
+  m_file_addr_eytzinger.resize(num_entries + 1);
+  m_file_addr_eytzinger_rank.resize(num_entries + 1);
+  size_t i = 0;
+  FillEytzinger(bases, i, 1, m_file_addr_eytzinger,
+                m_file_addr_eytzinger_rank);
+}
+
+void Symtab::ClearAddressSearchIndex() {
+  m_file_addr_eytzinger.clear();
+  m_file_addr_eytzinger_rank.clear();
+  m_file_addr_max_end.clear();
+}
+
+uint32_t
+Symtab::GetNumAddressEntriesStartingAtOrBefore(addr_t file_addr) const {
+  const size_t num_entries = m_file_addr_eytzinger.size();
+  if (num_entries <= 1)
+    return 0;
+
+  // Descend to a leaf, going right whenever the node starts at or before
+  // file_addr. The last node where we went left is the first entry starting
+  // after file_addr; dropping the trailing right turns (and that left turn)
+  // from the path recovers it.
+  size_t k = 1;
+  while (k < num_entries)
+    k = 2 * k + (m_file_addr_eytzinger[k] <= file_addr);
+  k >>= llvm::countTrailingOnes(k) + 1;
+  return k == 0 ? num_entries - 1 : m_file_addr_eytzinger_rank[k];
+}
+
+Symbol *Symtab::FindSymbolContainingFileAddress(addr_t file_addr,
+                                                uint32_t num_entries_before) {
+  // Walk back from the last entry starting at or before file_addr for as
+  // long as an earlier entry could still contain it. For overlapping
+  // symbols, return the first of the consecutive entries containing it.
+  for (uint32_t i = num_entries_before;
+       i > 0 && m_file_addr_max_end[i - 1] > file_addr;) {
+    --i;
+    if (!m_file_addr_to_index.GetEntryRef(i).Contains(file_addr))
+      continue;
+    while (i > 0 && m_file_addr_to_index.GetEntryRef(i - 1).Contains(file_addr))
+      --i;
+    Symbol *symbol = SymbolAtIndex(m_file_addr_to_index.GetEntryRef(i).data);
+    if (symbol->ContainsFileAddress(file_addr))
+      return symbol;
+    return nullptr;
+  }
+  return nullptr;
+}
+
 Symbol *Symtab::FindSymbolContainingFileAddress(addr_t file_addr) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
 
   if (!m_file_addr_to_index_computed)
     InitAddressIndexes();
 
-  const FileRangeToIndexMap::Entry *entry =
-      m_file_addr_to_index.FindEntryThatContains(file_addr);
-  if (entry) {
-    Symbol *symbol = SymbolAtIndex(entry->data);
-    if (symbol->ContainsFileAddress(file_addr))
-      return symbol;
+  return FindSymbolContainingFileAddress(
+      file_addr, GetNumAddressEntriesStartingAtOrBefore(file_addr));
+}
+
+void Symtab::FindSymbolsContainingFileAddresses(
+    llvm::ArrayRef<addr_t> file_addrs, std::vector<Symbol *> &symbols) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+
+  if (!m_file_addr_to_index_computed)
+    InitAddressIndexes();
+
+  symbols.assign(file_addrs.size(), nullptr);
+  const size_t num_entries = m_file_addr_to_index.GetSize();
+  if (num_entries == 0)
+    return;
+
+  // Searching for each address costs about log2(num_entries) steps, merging
+  // the sorted addresses against the index costs num_entries steps in all.
+  if (file_addrs.size() * llvm::Log2_64_Ceil(num_entries + 1) < num_entries) {
+    for (size_t i = 0; i < file_addrs.size(); ++i)
+      symbols[i] = FindSymbolContainingFileAddress(
+          file_addrs[i], GetNumAddressEntriesStartingAtOrBefore(file_addrs[i]));
+    return;
+  }
+
+  std::vector<uint32_t> order(file_addrs.size());
+  for (uint32_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) {
+    return file_addrs[lhs] < file_addrs[rhs];
+  });
+
+  uint32_t num_entries_before = 0;
+  for (uint32_t i : order) {
+    const addr_t file_addr = file_addrs[i];
+    while (num_entries_before < num_entries &&
+           m_file_addr_to_index.GetEntryRef(num_entries_before)
+                   .GetRangeBase() <= file_addr)
+      ++num_entries_before;
+    symbols[i] = FindSymbolContainingFileAddress(file_addr, num_entries_before);
   }
-  return nullptr;
 }
 
 void Symtab::ForEachSymbolContainingFileAddress(
@@ -1015,15 +1201,19 @@ void Symtab::ForEachSymbolContainingFileAddress(
   if (!m_file_addr_to_index_computed)
     InitAddressIndexes();
 
+  // Get all symbols with file_addr, in the order of the index
   std::vector<uint32_t> all_addr_indexes;
+  for (uint32_t i = GetNumAddressEntriesStartingAtOrBefore(file_addr);
+       i > 0 && m_file_addr_max_end[i - 1] > file_addr;) {
+    const FileRangeToIndexMap::Entry &entry =
+        m_file_addr_to_index.GetEntryRef(--i);
+    if (entry.Contains(file_addr))
+      all_addr_indexes.push_back(entry.data);
+  }
+  std::reverse(all_addr_indexes.begin(), all_addr_indexes.end());
 
-  // Get all symbols with file_addr
-  const size_t addr_match_count =
-      m_file_addr_to_index.FindEntryIndexesThatContain(file_addr,
-                                                       all_addr_indexes);
-
-  for (size_t i = 0; i < addr_match_count; ++i) {
-    Symbol *symbol = SymbolAtIndex(all_addr_indexes[i]);
+  for (uint32_t symbol_idx : all_addr_indexes) {
+    Symbol *symbol = SymbolAtIndex(symbol_idx);
     if (symbol->ContainsFileAddress(file_addr)) {
       if (!callback(symbol))
         break;
@@ -1049,6 +1239,45 @@ void Symtab::SymbolIndicesToSymbolContextList(
   }
 }
 
+size_t Symtab::FindFunctionNamesWithPrefix(llvm::StringRef prefix,
+                                           size_t max_matches,
+                                           std::vector<ConstString> &names) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  if (m_sorted_function_names.empty()) {
+    // Demangle the names in parallel before asking for them one by one.
+    if (!m_name_indexes_computed)
+      InitNameIndexes();
+
+    for (const Symbol &symbol : m_symbols) {
+      const SymbolType type = symbol.GetType();
+      if ((type != eSymbolTypeCode && type != eSymbolTypeResolver) ||
+          symbol.IsTrampoline())
+        continue;
+      if (ConstString name = symbol.GetMangled().GetName(
+              symbol.GetLanguage(), Mangled::ePreferDemangled))
+        m_sorted_function_names.push_back(name);
+    }
+    llvm::sort(m_sorted_function_names, [](ConstString lhs, ConstString rhs) {
+      return lhs.GetStringRef() < rhs.GetStringRef();
+    });
+    m_sorted_function_names.erase(std::unique(m_sorted_function_names.begin(),
+                                              m_sorted_function_names.end()),
+                                  m_sorted_function_names.end());
+  }
+
+  auto pos = llvm::lower_bound(m_sorted_function_names, prefix,
+                               [](ConstString name, llvm::StringRef prefix) {
+                                 return name.GetStringRef() < prefix;
+                               });
+  size_t num_matches = 0;
+  for (auto end = m_sorted_function_names.end();
+       pos != end && num_matches < max_matches &&
+       pos->GetStringRef().startswith(prefix);
+       ++pos, ++num_matches)
+    names.push_back(*pos);
+  return num_matches;
+}
+
 size_t Symtab::FindFunctionSymbols(ConstString name,
                                    uint32_t name_type_mask,
                                    SymbolContextList &sc_list) {
@@ -1152,3 +1381,343 @@ const Symbol *Symtab::GetParent(Symbol *child_symbol) const {
   }
   return nullptr;
 }
+
+// Sections are referred to by their position in a depth first walk of the
+// section list of the module, because section IDs are not unique across an
+// object file and its separate symbol file.
+static void CollectSections(const SectionList &section_list,
+                            std::vector<SectionSP> &sections) {
+  const size_t num_sections = section_list.GetSize();
+  for (size_t i = 0; i < num_sections; ++i) {
+    SectionSP section_sp = section_list.GetSectionAtIndex(i);
+    sections.push_back(section_sp);
+    CollectSections(section_sp->GetChildren(), sections);
+  }
+}
+
+static bool CollectModuleSections(ObjectFile &objfile,
+                                  std::vector<SectionSP> &sections) {
+  ModuleSP module_sp = objfile.GetModule();
+  if (!module_sp)
+    return false;
+  SectionList *section_list = module_sp->GetSectionList();
+  if (!section_list)
+    return false;
+  CollectSections(*section_list, sections);
+  return true;
+}
+
+static void EncodeNameToIndexMap(Stream &s, ConstStringTable &strtab,
+                                 const Symtab::NameToIndexMap &map) {
+  const size_t size = map.GetSize();
+  s.PutHex32(size);
+  for (size_t i = 0; i < size; ++i) {
+    s.PutHex32(strtab.Add(map.GetCStringAtIndexUnchecked(i)));
+    s.PutHex32(map.GetValueAtIndexUnchecked(i));
+  }
+}
+
+static bool DecodeNameToIndexMap(const DataExtractor &data,
+                                 lldb::offset_t *offset_ptr,
+                                 const ConstStringTable &strtab,
+                                 size_t num_symbols,
+                                 Symtab::NameToIndexMap &map) {
+  if (!data.ValidOffsetForDataOfSize(*offset_ptr, 4))
+    return false;
+  const uint32_t size = data.GetU32(offset_ptr);
+  if (!data.ValidOffsetForDataOfSize(*offset_ptr, uint64_t(size) * 8))
+    return false;
+  map.Reserve(size);
+  for (uint32_t i = 0; i < size; ++i) {
+    ConstString name = strtab.Get(data.GetU32(offset_ptr));
+    const uint32_t idx = data.GetU32(offset_ptr);
+    if (!name || idx >= num_symbols)
+      return false;
+    map.Append(name, idx);
+  }
+  // The names are sorted by their string pool address, which differs
+  // between sessions, so the map has to be sorted again.
+  map.Sort();
+  return true;
+}
+
+bool Symtab::Encode(Stream &s, ConstStringTable &strtab) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  std::vector<SectionSP> sections;
+  if (!CollectModuleSections(*m_objfile, sections))
+    return false;
+
+  InitAddressIndexes();
+  InitNameIndexes();
+
+  // Sections which the object file plug-in synthesized while parsing the
+  // symbols won't exist when the table is loaded again.
+  llvm::DenseMap<const Section *, uint32_t> section_ids;
+  s.PutHex32(sections.size());
+  for (const SectionSP &section_sp : sections) {
+    if (section_sp->GetType() == eSectionTypeAbsoluteAddress)
+      return false;
+    s.PutHex32(strtab.Add(section_sp->GetName()));
+    const uint32_t section_id = section_ids.size() + 1;
+    section_ids[section_sp.get()] = section_id;
+  }
+
+  s.PutHex32(m_symbols.size());
+  for (const Symbol &symbol : m_symbols) {
+    if (!symbol.Encode(s, strtab, section_ids))
+      return false;
+  }
+
+  const size_t num_entries = m_file_addr_to_index.GetSize();
+  s.PutHex32(num_entries);
+  for (size_t i = 0; i < num_entries; ++i) {
+    const FileRangeToIndexMap::Entry *entry =
+        m_file_addr_to_index.GetEntryAtIndex(i);
+    s.PutHex64(entry->GetRangeBase());
+    s.PutHex64(entry->GetByteSize());
+    s.PutHex32(entry->data);
+  }
+
+  EncodeNameToIndexMap(s, strtab, m_name_to_index);
+  EncodeNameToIndexMap(s, strtab, m_basename_to_index);
+  EncodeNameToIndexMap(s, strtab, m_method_to_index);
+  EncodeNameToIndexMap(s, strtab, m_selector_to_index);
+  return true;
+}
+
+bool Symtab::Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
+                    const ConstStringTable &strtab) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  std::vector<SectionSP> sections;
+  if (!CollectModuleSections(*m_objfile, sections))
+    return false;
+
+  auto decode = [&]() {
+    if (!data.ValidOffsetForDataOfSize(*offset_ptr, 4) ||
+        data.GetU32(offset_ptr) != sections.size() ||
+        !data.ValidOffsetForDataOfSize(*offset_ptr, sections.size() * 4))
+      return false;
+    for (const SectionSP &section_sp : sections) {
+      if (strtab.Get(data.GetU32(offset_ptr)) != section_sp->GetName())
+        return false;
+    }
+
+    if (!data.ValidOffsetForDataOfSize(*offset_ptr, 4))
+      return false;
+    const uint32_t num_symbols = data.GetU32(offset_ptr);
+    m_symbols.resize(num_symbols);
+    for (Symbol &symbol : m_symbols) {
+      if (!symbol.Decode(data, offset_ptr, strtab, sections))
+        return false;
+    }
+
+    if (!data.ValidOffsetForDataOfSize(*offset_ptr, 4))
+      return false;
+    const uint32_t num_entries = data.GetU32(offset_ptr);
+    if (!data.ValidOffsetForDataOfSize(*offset_ptr,
+                                       uint64_t(num_entries) * 20))
+      return false;
+    for (uint32_t i = 0; i < num_entries; ++i) {
+      const addr_t base = data.GetU64(offset_ptr);
+      const addr_t size = data.GetU64(offset_ptr);
+      const uint32_t idx = data.GetU32(offset_ptr);
+      if (idx >= num_symbols)
+        return false;
+      m_file_addr_to_index.Append(FileRangeToIndexMap::Entry(base, size, idx));
+    }
+
+    return DecodeNameToIndexMap(data, offset_ptr, strtab, num_symbols,
+                                m_name_to_index) &&
+           DecodeNameToIndexMap(data, offset_ptr, strtab, num_symbols,
+                                m_basename_to_index) &&
+           DecodeNameToIndexMap(data, offset_ptr, strtab, num_symbols,
+                                m_method_to_index) &&
+           DecodeNameToIndexMap(data, offset_ptr, strtab, num_symbols,
+                                m_selector_to_index);
+  };
+
+  m_symbols.clear();
+  m_file_addr_to_index.Clear();
+  ClearAddressSearchIndex();
+  m_name_to_index.Clear();
+  m_basename_to_index.Clear();
+  m_method_to_index.Clear();
+  m_selector_to_index.Clear();
+  m_sorted_function_names.clear();
+  m_file_addr_to_index_computed = false;
+  m_name_indexes_computed = false;
+  if (!decode()) {
+    m_symbols.clear();
+    m_file_addr_to_index.Clear();
+    ClearAddressSearchIndex();
+    m_name_to_index.Clear();
+    m_basename_to_index.Clear();
+    m_method_to_index.Clear();
+    m_selector_to_index.Clear();
+    return false;
+  }
+  InitAddressSearchIndex();
+  m_file_addr_to_index_computed = true;
+  m_name_indexes_computed = true;
+  return true;
+}
+
+// Bump this whenever the layout of the cache file or the contents of the
+// symbol table change.
+static const uint32_t g_symtab_cache_version = 1;
+static const uint32_t g_symtab_cache_magic = 0x4c53594d; // 'LSYM'
+
+FileSpec Symtab::GetCacheFile() {
+  FileSpec cache_dir =
+      ModuleList::GetGlobalModuleListProperties().GetSymtabCachePath();
+  if (!cache_dir)
+    return FileSpec();
+
+  ModuleSP module_sp = m_objfile->GetModule();
+  if (!module_sp)
+    return FileSpec();
+  const UUID &uuid = module_sp->GetUUID();
+  if (!uuid.IsValid())
+    return FileSpec();
+
+  std::string name = uuid.GetAsString("");
+  // Several objects of the same archive may share a UUID.
+  if (ConstString object_name = module_sp->GetObjectName())
+    name += llvm::formatv("-{0:x-8}", llvm::djbHash(object_name.GetStringRef()))
+                .str();
+  name += ".symtab";
+  cache_dir.AppendPathComponent(name);
+  return cache_dir;
+}
+
+bool Symtab::LoadFromCache() {
+  FileSpec cache_file = GetCacheFile();
+  if (!cache_file || !FileSystem::Instance().Exists(cache_file))
+    return false;
+
+  Log *log = lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_SYMBOLS);
+
+  DataBufferSP buffer_sp = FileSystem::Instance().CreateDataBuffer(cache_file);
+  if (!buffer_sp)
+    return false;
+  DataExtractor data(buffer_sp, eByteOrderLittle, 8);
+
+  // The symbol table may come from a separate symbol file, which has to be
+  // the same one as when the cache was written.
+  ModuleSP module_sp = m_objfile->GetModule();
+  lldb::offset_t offset = 0;
+  const char *objfile_path = nullptr;
+  if (!data.ValidOffsetForDataOfSize(offset, 24) ||
+      data.GetU32(&offset) != g_symtab_cache_magic ||
+      data.GetU32(&offset) != g_symtab_cache_version ||
+      data.GetU64(&offset) !=
+          uint64_t(llvm::sys::toTimeT(module_sp->GetModificationTime())) ||
+      data.GetU64(&offset) != uint64_t(llvm::sys::toTimeT(
+                                  module_sp->GetObjectModificationTime())) ||
+      !(objfile_path = data.GetCStr(&offset)) ||
+      m_objfile->GetFileSpec().GetPath() != objfile_path)
+    return false;
+
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "%s", LLVM_PRETTY_FUNCTION);
+  ConstStringTable strtab;
+  if (!strtab.Decode(data, &offset) || !Decode(data, &offset, strtab)) {
+    LLDB_LOG(log, "ignoring corrupt symbol table cache file {0}", cache_file);
+    return false;
+  }
+
+  LLDB_LOG(log, "loaded symbol table for {0} from {1}",
+           module_sp->GetFileSpec(), cache_file);
+  return true;
+}
+
+// Debuggers on the same machine often load the same modules at the same
+// time. Let one of them build the cached data while the others wait for it,
+// rather than all of them building it. Returns true if another debugger
+// finished building it, so loading the cache should be tried again.
+// Otherwise, \a cache_lock may receive a lock that the caller holds until
+// it has saved its own result.
+static bool
+WaitForCacheOrLock(const FileSpec &cache_file,
+                   std::unique_ptr<llvm::LockFileManager> &cache_lock) {
+  // The lock file is created next to the cache file.
+  if (llvm::sys::fs::create_directories(
+          cache_file.GetDirectory().GetStringRef()))
+    return false;
+  auto lock = std::make_unique<llvm::LockFileManager>(cache_file.GetPath());
+  switch (lock->getState()) {
+  case llvm::LockFileManager::LFS_Owned:
+    cache_lock = std::move(lock);
+    return false;
+  case llvm::LockFileManager::LFS_Shared:
+    // If the other debugger goes away or takes too long, build it ourselves.
+    return lock->waitForUnlock() == llvm::LockFileManager::Res_Success;
+  case llvm::LockFileManager::LFS_Error:
+    return false;
+  }
+  return false;
+}
+
+bool Symtab::LoadFromCacheOrLock(
+    std::unique_ptr<llvm::LockFileManager> &cache_lock) {
+  if (LoadFromCache())
+    return true;
+  FileSpec cache_file = GetCacheFile();
+  return cache_file && WaitForCacheOrLock(cache_file, cache_lock) &&
+         LoadFromCache();
+}
+
+void Symtab::SaveToCache() {
+  FileSpec cache_file = GetCacheFile();
+  if (!cache_file)
+    return;
+
+  Log *log = lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_SYMBOLS);
+
+  // The string table is written in front of the symbols, but is only
+  // complete once all of them have been encoded.
+  ConstStringTable strtab;
+  StreamString body(Stream::eBinary, 8, eByteOrderLittle);
+  if (!Encode(body, strtab)) {
+    LLDB_LOG(log, "symbol table of {0} cannot be cached",
+             m_objfile->GetFileSpec());
+    return;
+  }
+
+  ModuleSP module_sp = m_objfile->GetModule();
+  StreamString header(Stream::eBinary, 8, eByteOrderLittle);
+  header.PutHex32(g_symtab_cache_magic);
+  header.PutHex32(g_symtab_cache_version);
+  header.PutHex64(llvm::sys::toTimeT(module_sp->GetModificationTime()));
+  header.PutHex64(llvm::sys::toTimeT(module_sp->GetObjectModificationTime()));
+  std::string objfile_path = m_objfile->GetFileSpec().GetPath();
+  header.PutRawBytes(objfile_path.c_str(), objfile_path.size() + 1);
+  strtab.Encode(header);
+
+  // Write to a temporary file first and rename it into place, so concurrent
+  // debugger instances never observe a partially written table.
+  std::string cache_dir = cache_file.GetDirectory().GetStringRef().str();
+  if (std::error_code ec = llvm::sys::fs::create_directories(cache_dir)) {
+    LLDB_LOG(log, "failed to create symbol table cache directory {0}: {1}",
+             cache_dir, ec.message());
+    return;
+  }
+  int fd;
+  llvm::SmallString<128> tmp_path;
+  if (std::error_code ec = llvm::sys::fs::createUniqueFile(
+          cache_file.GetPath() + "-%%%%%%", fd, tmp_path)) {
+    LLDB_LOG(log, "failed to create symbol table cache file: {0}",
+             ec.message());
+    return;
+  }
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os << header.GetString() << body.GetString();
+  }
+  if (std::error_code ec =
+          llvm::sys::fs::rename(tmp_path, cache_file.GetPath())) {
+    LLDB_LOG(log, "failed to write symbol table cache file {0}: {1}",
+             cache_file, ec.message());
+    llvm::sys::fs::remove(tmp_path);
+  }
+}
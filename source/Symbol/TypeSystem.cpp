@@ -48,6 +48,20 @@ TypeSystem::TypeSystem(LLVMCastKind kind) : m_kind(kind), m_sym_file(nullptr) {}
 
 TypeSystem::~TypeSystem() {}
 
+const char *TypeSystem::GetKindName() const {
+  switch (m_kind) {
+  case eKindClang:
+    return "clang";
+  case eKindSwift:
+    return "swift";
+  case eKindOCaml:
+    return "ocaml";
+  case kNumKinds:
+    break;
+  }
+  return "unknown";
+}
+
 static lldb::TypeSystemSP CreateInstanceHelper(lldb::LanguageType language,
                                                Module *module, Target *target,
                                                const char *compiler_options) {
@@ -362,13 +362,12 @@ void UnwindPlan::AppendRow(const UnwindPlan::RowSP &row_sp) {
 
 void UnwindPlan::InsertRow(const UnwindPlan::RowSP &row_sp,
                            bool replace_existing) {
-  collection::iterator it = m_row_list.begin();
-  while (it != m_row_list.end()) {
-    RowSP row = *it;
-    if (row->GetOffset() >= row_sp->GetOffset())
-      break;
-    it++;
-  }
+  // The rows are sorted by offset.
+  collection::iterator it = std::lower_bound(
+      m_row_list.begin(), m_row_list.end(), row_sp->GetOffset(),
+      [](const RowSP &row, lldb::offset_t offset) {
+        return row->GetOffset() < offset;
+      });
   if (it == m_row_list.end() || (*it)->GetOffset() != row_sp->GetOffset())
     m_row_list.insert(it, row_sp);
   else if (replace_existing)
@@ -381,13 +380,15 @@ UnwindPlan::RowSP UnwindPlan::GetRowForFunctionOffset(int offset) const {
     if (offset == -1)
       row = m_row_list.back();
     else {
-      collection::const_iterator pos, end = m_row_list.end();
-      for (pos = m_row_list.begin(); pos != end; ++pos) {
-        if ((*pos)->GetOffset() <= static_cast<lldb::offset_t>(offset))
-          row = *pos;
-        else
-          break;
-      }
+      // The rows are sorted by offset, find the last one at or before it.
+      collection::const_iterator pos = std::upper_bound(
+          m_row_list.begin(), m_row_list.end(),
+          static_cast<lldb::offset_t>(offset),
+          [](lldb::offset_t offset, const RowSP &row) {
+            return offset < row->GetOffset();
+          });
+      if (pos != m_row_list.begin())
+        row = *std::prev(pos);
     }
   }
   return row;
@@ -53,8 +53,10 @@ void UnwindTable::Initialize() {
 
   SectionSP sect = sl->FindSectionByType(eSectionTypeEHFrame, true);
   if (sect.get()) {
-    m_eh_frame_up.reset(
-        new DWARFCallFrameInfo(*object_file, sect, DWARFCallFrameInfo::EH));
+    SectionSP eh_frame_hdr =
+        sl->FindSectionByName(ConstString(".eh_frame_hdr"));
+    m_eh_frame_up.reset(new DWARFCallFrameInfo(
+        *object_file, sect, DWARFCallFrameInfo::EH, eh_frame_hdr));
   }
 
   sect = sl->FindSectionByType(eSectionTypeDWARFDebugFrame, true);
@@ -185,6 +185,16 @@ lldb::ValueObjectSP ABI::GetReturnValueObjectImpl(Thread &thread,
   return return_valobj_sp;
 }
 
+bool ABI::GetIntegerArgumentValues(RegisterContext &reg_ctx,
+                                   llvm::MutableArrayRef<uint64_t> args) const {
+  return false;
+}
+
+bool ABI::GetIntegerReturnValue(RegisterContext &reg_ctx,
+                                uint64_t &value) const {
+  return false;
+}
+
 bool ABI::PrepareTrivialCall(Thread &thread, lldb::addr_t sp,
                              lldb::addr_t functionAddress,
                              lldb::addr_t returnAddress, llvm::Type &returntype,
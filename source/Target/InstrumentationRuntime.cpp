@@ -10,13 +10,23 @@
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleList.h"
 #include "lldb/Core/PluginManager.h"
+#include "lldb/Core/Value.h"
+#include "lldb/Expression/DiagnosticManager.h"
+#include "lldb/Expression/FunctionCaller.h"
+#include "lldb/Expression/UtilityFunction.h"
+#include "lldb/Symbol/ClangASTContext.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Utility/CleanUp.h"
+#include "lldb/Utility/DataBufferHeap.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/lldb-private.h"
 
 using namespace lldb;
 using namespace lldb_private;
 
+InstrumentationRuntime::~InstrumentationRuntime() = default;
+
 void InstrumentationRuntime::ModulesDidLoad(
     lldb_private::ModuleList &module_list, lldb_private::Process *process,
     InstrumentationRuntimeCollection &runtimes) {
@@ -73,3 +83,90 @@ InstrumentationRuntime::GetBacktracesFromExtendedStopInfo(
     StructuredData::ObjectSP info) {
   return ThreadCollectionSP(new ThreadCollection());
 }
+
+llvm::Expected<DataExtractor> InstrumentationRuntime::CallReportFunction(
+    ExecutionContext &exe_ctx, const char *code, const char *function_name,
+    size_t num_slots) {
+  ProcessSP process_sp = GetProcessSP();
+  if (!process_sp)
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "no process");
+
+  ClangASTContext *ast = process_sp->GetTarget().GetScratchClangASTContext();
+  if (!ast)
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "no scratch type system");
+  CompilerType void_ptr_type =
+      ast->GetBasicType(eBasicTypeVoid).GetPointerType();
+
+  DiagnosticManager diagnostics;
+  Status error;
+  if (!m_report_function_up) {
+    std::unique_ptr<UtilityFunction> function_up(
+        process_sp->GetTarget().GetUtilityFunctionForLanguage(
+            code, eLanguageTypeObjC_plus_plus, function_name, error));
+    if (!function_up)
+      return error.ToError();
+    if (!function_up->Install(diagnostics, exe_ctx))
+      return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                     "could not install %s: %s",
+                                     function_name,
+                                     diagnostics.GetString().c_str());
+
+    ValueList arguments;
+    Value value;
+    value.SetValueType(Value::eValueTypeScalar);
+    value.SetCompilerType(void_ptr_type);
+    arguments.PushValue(value);
+    function_up->MakeFunctionCaller(void_ptr_type, arguments,
+                                    exe_ctx.GetThreadSP(), error);
+    if (error.Fail())
+      return error.ToError();
+    m_report_function_up = std::move(function_up);
+  }
+  FunctionCaller *caller = m_report_function_up->GetFunctionCaller();
+
+  const size_t size = num_slots * sizeof(uint64_t);
+  addr_t buffer_addr = process_sp->CallocateMemory(
+      size, ePermissionsReadable | ePermissionsWritable, error);
+  if (buffer_addr == LLDB_INVALID_ADDRESS)
+    return error.ToError();
+  CleanUp buffer_cleanup(
+      [process_sp, buffer_addr] { process_sp->DeallocateMemory(buffer_addr); });
+
+  ValueList arguments = caller->GetArgumentValues();
+  arguments.GetValueAtIndex(0)->GetScalar() = buffer_addr;
+  addr_t args_addr = LLDB_INVALID_ADDRESS;
+  if (!caller->WriteFunctionArguments(exe_ctx, args_addr, arguments,
+                                      diagnostics))
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "could not write the arguments: %s",
+                                   diagnostics.GetString().c_str());
+  CleanUp args_cleanup([caller, &exe_ctx, args_addr] {
+    caller->DeallocateFunctionResults(exe_ctx, args_addr);
+  });
+
+  EvaluateExpressionOptions options;
+  options.SetExecutionPolicy(eExecutionPolicyAlways);
+  options.SetUnwindOnError(true);
+  options.SetTryAllThreads(true);
+  options.SetStopOthers(true);
+  options.SetIgnoreBreakpoints(true);
+  options.SetTimeout(process_sp->GetUtilityExpressionTimeout());
+  options.SetIsForUtilityExpr(true);
+
+  Value return_value;
+  return_value.SetCompilerType(void_ptr_type);
+  if (caller->ExecuteFunction(exe_ctx, &args_addr, options, diagnostics,
+                              return_value) != eExpressionCompleted)
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "%s failed: %s", function_name,
+                                   diagnostics.GetString().c_str());
+
+  DataBufferSP data_sp(new DataBufferHeap(size, 0));
+  if (process_sp->ReadMemory(buffer_addr, data_sp->GetBytes(), size, error) !=
+      size)
+    return error.ToError();
+  return DataExtractor(data_sp, process_sp->GetByteOrder(),
+                       process_sp->GetAddressByteSize());
+}
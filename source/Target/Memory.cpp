@@ -13,6 +13,8 @@
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/Utility/State.h"
 
+#include "llvm/ADT/ScopeExit.h"
+
 #include <cinttypes>
 #include <memory>
 
@@ -21,9 +23,14 @@ using namespace lldb_private;
 
 // MemoryCache constructor
 MemoryCache::MemoryCache(Process &process)
-    : m_mutex(), m_L1_cache(), m_L2_cache(), m_invalid_ranges(),
-      m_process(process),
-      m_L2_cache_line_byte_size(process.GetMemoryCacheLineSize()) {}
+    : m_mutex(), m_L1_cache(), m_L2_cache(), m_L2_lru(), m_invalid_ranges(),
+      m_process(process), m_L2_cache_line_byte_size(0),
+      m_L2_max_prefetch_lines(1), m_L2_max_lines(0),
+      m_L2_last_miss_addr(LLDB_INVALID_ADDRESS),
+      m_L2_fill_end_addr(LLDB_INVALID_ADDRESS), m_L2_stride(0),
+      m_L2_prefetch_count(0) {
+  UpdateSettings();
+}
 
 // Destructor
 MemoryCache::~MemoryCache() {}
@@ -32,9 +39,36 @@ void MemoryCache::Clear(bool clear_invalid_ranges) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
   m_L1_cache.clear();
   m_L2_cache.clear();
+  m_L2_lru.clear();
   if (clear_invalid_ranges)
     m_invalid_ranges.Clear();
+  m_L2_last_miss_addr = LLDB_INVALID_ADDRESS;
+  m_L2_fill_end_addr = LLDB_INVALID_ADDRESS;
+  m_L2_stride = 0;
+  m_L2_prefetch_count = 0;
+  UpdateSettings();
+}
+
+size_t MemoryCache::GetMemoryUsage() const {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  size_t usage = 0;
+  for (const auto &entry : m_L1_cache)
+    usage += entry.second->GetByteSize();
+  for (const auto &entry : m_L2_cache)
+    usage += entry.second.data->GetByteSize();
+  return usage;
+}
+
+void MemoryCache::UpdateSettings() {
   m_L2_cache_line_byte_size = m_process.GetMemoryCacheLineSize();
+  m_L2_max_prefetch_lines =
+      std::max<uint64_t>(m_process.GetMemoryCachePrefetchLines(), 1);
+  // Never allow fewer lines than a single fill brings in, or a read could
+  // evict the lines it just fetched before copying them out.
+  m_L2_max_lines = std::max<uint64_t>(
+      m_process.GetMemoryCacheSize() /
+          std::max<uint32_t>(m_L2_cache_line_byte_size, 1),
+      m_L2_max_prefetch_lines + 1);
 }
 
 void MemoryCache::AddL1CacheData(lldb::addr_t addr, const void *src,
@@ -90,9 +124,9 @@ void MemoryCache::Flush(addr_t addr, size_t size) {
     uint32_t cache_idx = 0;
     for (addr_t curr_addr = first_cache_line_addr; cache_idx < num_cache_lines;
          curr_addr += cache_line_byte_size, ++cache_idx) {
-      BlockMap::iterator pos = m_L2_cache.find(curr_addr);
+      L2CacheMap::iterator pos = m_L2_cache.find(curr_addr);
       if (pos != m_L2_cache.end())
-        m_L2_cache.erase(pos);
+        RemoveL2CacheLine(pos);
     }
   }
 }
@@ -144,6 +178,7 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
     if (chunk_range.Contains(read_range)) {
       memcpy(dst, pos->second->GetBytes() + (addr - chunk_range.GetRangeBase()),
              dst_len);
+      ++m_num_hits;
       return dst_len;
     }
   }
@@ -156,6 +191,7 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
   // 4 bytes after the large memory read - so there's little benefit to saving
   // it in the cache.
   if (dst && dst_len > m_L2_cache_line_byte_size) {
+    ++m_num_misses;
     size_t bytes_read =
         m_process.ReadMemoryFromInferior(addr, dst, dst_len, error);
     // Add this non block sized range to the L1 cache if we actually read
@@ -170,6 +206,13 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
     uint8_t *dst_buf = (uint8_t *)dst;
     addr_t curr_addr = addr - (addr % cache_line_byte_size);
     addr_t cache_offset = addr - curr_addr;
+    bool filled = false;
+    auto count_read = llvm::make_scope_exit([&]() {
+      if (filled)
+        ++m_num_misses;
+      else
+        ++m_num_hits;
+    });
 
     while (bytes_left > 0) {
       if (m_invalid_ranges.FindEntryThatContains(curr_addr)) {
@@ -178,16 +221,17 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
         return dst_len - bytes_left;
       }
 
-      BlockMap::const_iterator pos = m_L2_cache.find(curr_addr);
-      BlockMap::const_iterator end = m_L2_cache.end();
+      L2CacheMap::iterator pos = m_L2_cache.find(curr_addr);
+      L2CacheMap::iterator end = m_L2_cache.end();
 
       if (pos != end) {
         size_t curr_read_size = cache_line_byte_size - cache_offset;
         if (curr_read_size > bytes_left)
           curr_read_size = bytes_left;
 
+        m_L2_lru.splice(m_L2_lru.begin(), m_L2_lru, pos->second.lru_pos);
         memcpy(dst_buf + dst_len - bytes_left,
-               pos->second->GetBytes() + cache_offset, curr_read_size);
+               pos->second.data->GetBytes() + cache_offset, curr_read_size);
 
         bytes_left -= curr_read_size;
         curr_addr += curr_read_size + cache_offset;
@@ -201,11 +245,13 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
             if (pos->first != curr_addr)
               break;
 
-            curr_read_size = pos->second->GetByteSize();
+            const DataBufferSP &data_sp = pos->second.data;
+            curr_read_size = data_sp->GetByteSize();
             if (curr_read_size > bytes_left)
               curr_read_size = bytes_left;
 
-            memcpy(dst_buf + dst_len - bytes_left, pos->second->GetBytes(),
+            m_L2_lru.splice(m_L2_lru.begin(), m_L2_lru, pos->second.lru_pos);
+            memcpy(dst_buf + dst_len - bytes_left, data_sp->GetBytes(),
                    curr_read_size);
 
             bytes_left -= curr_read_size;
@@ -214,7 +260,7 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
             // We have a cache page that succeeded to read some bytes but not
             // an entire page. If this happens, we must cap off how much data
             // we are able to read...
-            if (pos->second->GetByteSize() != cache_line_byte_size)
+            if (data_sp->GetByteSize() != cache_line_byte_size)
               return dst_len - bytes_left;
           }
         }
@@ -224,17 +270,9 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
 
       if (bytes_left > 0) {
         assert((curr_addr % cache_line_byte_size) == 0);
-        std::unique_ptr<DataBufferHeap> data_buffer_heap_up(
-            new DataBufferHeap(cache_line_byte_size, 0));
-        size_t process_bytes_read = m_process.ReadMemoryFromInferior(
-            curr_addr, data_buffer_heap_up->GetBytes(),
-            data_buffer_heap_up->GetByteSize(), error);
-        if (process_bytes_read == 0)
+        filled = true;
+        if (!FillL2Cache(curr_addr, bytes_left, error))
           return dst_len - bytes_left;
-
-        if (process_bytes_read != cache_line_byte_size)
-          data_buffer_heap_up->SetByteSize(process_bytes_read);
-        m_L2_cache[curr_addr] = DataBufferSP(data_buffer_heap_up.release());
         // We have read data and put it into the cache, continue through the
         // loop again to get the data out of the cache...
       }
@@ -244,10 +282,102 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
   return dst_len - bytes_left;
 }
 
+bool MemoryCache::FillL2Cache(addr_t line_addr, size_t min_byte_size,
+                              Status &error) {
+  const uint32_t cache_line_byte_size = m_L2_cache_line_byte_size;
+  const addr_t max_prefetch_byte_size =
+      addr_t(m_L2_max_prefetch_lines) * cache_line_byte_size;
+
+  // Formatters walking an array or a list of adjacent nodes miss on lines
+  // that are equally spaced, and each miss costs a round trip to the target.
+  // When a miss continues the current stream, read ahead twice as many
+  // strides as last time. Otherwise start a new stream, whose stride is the
+  // distance from the previous miss, without reading ahead.
+  if (m_L2_fill_end_addr != LLDB_INVALID_ADDRESS &&
+      line_addr >= m_L2_fill_end_addr &&
+      line_addr - m_L2_fill_end_addr < m_L2_stride) {
+    m_L2_prefetch_count = std::min(std::max(m_L2_prefetch_count * 2, 1u),
+                                   m_L2_max_prefetch_lines);
+  } else {
+    m_L2_prefetch_count = 0;
+    if (m_L2_last_miss_addr != LLDB_INVALID_ADDRESS &&
+        line_addr > m_L2_last_miss_addr &&
+        line_addr - m_L2_last_miss_addr <= max_prefetch_byte_size)
+      m_L2_stride = line_addr - m_L2_last_miss_addr;
+    else
+      m_L2_stride = cache_line_byte_size;
+  }
+  m_L2_last_miss_addr = line_addr;
+
+  // Lines the caller needs right away are always read, the rest is only
+  // read ahead up to the first line that is cached or known to be invalid.
+  const addr_t needed_lines =
+      (min_byte_size + cache_line_byte_size - 1) / cache_line_byte_size;
+  const addr_t prefetch_lines =
+      m_L2_prefetch_count * m_L2_stride / cache_line_byte_size + 1;
+  const addr_t max_lines = std::min<addr_t>(
+      std::max(needed_lines, prefetch_lines), m_L2_max_prefetch_lines);
+  addr_t num_lines = 1;
+  for (; num_lines < max_lines; ++num_lines) {
+    const addr_t next_addr = line_addr + num_lines * cache_line_byte_size;
+    if (next_addr < line_addr) // Wrapped around the address space
+      break;
+    if (num_lines >= needed_lines &&
+        (m_L2_cache.count(next_addr) ||
+         m_invalid_ranges.FindEntryThatContains(next_addr)))
+      break;
+  }
+
+  DataBufferHeap buffer(num_lines * cache_line_byte_size, 0);
+  size_t bytes_read = m_process.ReadMemoryFromInferior(
+      line_addr, buffer.GetBytes(), buffer.GetByteSize(), error);
+  if (bytes_read == 0 && num_lines > 1) {
+    // The read ahead may have run into unmapped memory, which fails the whole
+    // read on most targets. Retry with just the line we need.
+    error.Clear();
+    m_L2_prefetch_count = 0;
+    bytes_read = m_process.ReadMemoryFromInferior(
+        line_addr, buffer.GetBytes(), cache_line_byte_size, error);
+  }
+  if (bytes_read == 0)
+    return false;
+
+  addr_t curr_addr = line_addr;
+  for (size_t offset = 0; offset < bytes_read;
+       offset += cache_line_byte_size, curr_addr += cache_line_byte_size) {
+    const size_t line_size =
+        std::min<size_t>(cache_line_byte_size, bytes_read - offset);
+    AddL2CacheLine(curr_addr, std::make_shared<DataBufferHeap>(
+                                  buffer.GetBytes() + offset, line_size));
+  }
+  m_L2_fill_end_addr = curr_addr;
+  return true;
+}
+
+void MemoryCache::AddL2CacheLine(addr_t line_addr, DataBufferSP data_sp) {
+  L2CacheMap::iterator pos = m_L2_cache.find(line_addr);
+  if (pos != m_L2_cache.end()) {
+    pos->second.data = std::move(data_sp);
+    m_L2_lru.splice(m_L2_lru.begin(), m_L2_lru, pos->second.lru_pos);
+  } else {
+    m_L2_lru.push_front(line_addr);
+    m_L2_cache[line_addr] = {std::move(data_sp), m_L2_lru.begin()};
+  }
+
+  // Discard the least recently used lines once we are over the limit.
+  while (m_L2_cache.size() > m_L2_max_lines)
+    RemoveL2CacheLine(m_L2_cache.find(m_L2_lru.back()));
+}
+
+void MemoryCache::RemoveL2CacheLine(L2CacheMap::iterator pos) {
+  m_L2_lru.erase(pos->second.lru_pos);
+  m_L2_cache.erase(pos);
+}
+
 AllocatedBlock::AllocatedBlock(lldb::addr_t addr, uint32_t byte_size,
                                uint32_t permissions, uint32_t chunk_size)
     : m_range(addr, byte_size), m_permissions(permissions),
-      m_chunk_size(chunk_size)
+      m_chunk_size(chunk_size), m_unused_addr(addr)
 {
   // The entire address range is free to start with.
   m_free_blocks.Append(m_range);
@@ -256,7 +386,7 @@ AllocatedBlock::AllocatedBlock(lldb::addr_t addr, uint32_t byte_size,
 
 AllocatedBlock::~AllocatedBlock() {}
 
-lldb::addr_t AllocatedBlock::ReserveBlock(uint32_t size) {
+lldb::addr_t AllocatedBlock::ReserveBlock(uint32_t size, bool *is_zeroed) {
   // We must return something valid for zero bytes.
   if (size == 0)
     size = 1;
@@ -297,6 +427,9 @@ lldb::addr_t AllocatedBlock::ReserveBlock(uint32_t size) {
         free_block.SetRangeBase(reserved_block.GetRangeEnd());
         free_block.SetByteSize(bytes_left);
       }
+      if (is_zeroed)
+        *is_zeroed = addr >= m_unused_addr;
+      m_unused_addr = std::max(m_unused_addr, addr + block_size);
       LLDB_LOGV(log, "({0}) (size = {1} ({1:x})) => {2:x}", this, size, addr);
       return addr;
     }
@@ -365,7 +498,8 @@ AllocatedMemoryCache::AllocatePage(uint32_t byte_size, uint32_t permissions,
 
 lldb::addr_t AllocatedMemoryCache::AllocateMemory(size_t byte_size,
                                                   uint32_t permissions,
-                                                  Status &error) {
+                                                  Status &error,
+                                                  bool *is_zeroed) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
 
   addr_t addr = LLDB_INVALID_ADDRESS;
@@ -374,16 +508,27 @@ lldb::addr_t AllocatedMemoryCache::AllocateMemory(size_t byte_size,
 
   for (PermissionsToBlockMap::iterator pos = range.first; pos != range.second;
        ++pos) {
-    addr = (*pos).second->ReserveBlock(byte_size);
+    addr = (*pos).second->ReserveBlock(byte_size, is_zeroed);
     if (addr != LLDB_INVALID_ADDRESS)
       break;
   }
 
   if (addr == LLDB_INVALID_ADDRESS) {
-    AllocatedBlockSP block_sp(AllocatePage(byte_size, permissions, 16, error));
+    // Every allocation in the process is a function call or a packet round
+    // trip, so grow the pool geometrically: each new block for a given set of
+    // permissions is twice the size of the previous one, up to a limit. This
+    // way a session that evaluates many expressions soon stops allocating.
+    const size_t min_block_size = 4096;
+    const size_t max_block_size = 256 * 1024;
+    const size_t num_blocks = std::distance(range.first, range.second);
+    const size_t block_size =
+        std::min(min_block_size << std::min<size_t>(num_blocks, 8),
+                 max_block_size);
+    AllocatedBlockSP block_sp(AllocatePage(std::max(byte_size, block_size),
+                                           permissions, 16, error));
 
     if (block_sp)
-      addr = block_sp->ReserveBlock(byte_size);
+      addr = block_sp->ReserveBlock(byte_size, is_zeroed);
   }
   Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_PROCESS));
   LLDB_LOGF(log,
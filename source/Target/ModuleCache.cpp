@@ -210,13 +210,16 @@ Status ModuleCache::Put(const FileSpec &root_dir_spec, const char *hostname,
 Status ModuleCache::Get(const FileSpec &root_dir_spec, const char *hostname,
                         const ModuleSpec &module_spec,
                         ModuleSP &cached_module_sp, bool *did_create_ptr) {
-  const auto find_it =
-      m_loaded_modules.find(module_spec.GetUUID().GetAsString());
-  if (find_it != m_loaded_modules.end()) {
-    cached_module_sp = (*find_it).second.lock();
-    if (cached_module_sp)
-      return Status();
-    m_loaded_modules.erase(find_it);
+  {
+    std::lock_guard<std::mutex> guard(m_loaded_modules_mutex);
+    const auto find_it =
+        m_loaded_modules.find(module_spec.GetUUID().GetAsString());
+    if (find_it != m_loaded_modules.end()) {
+      cached_module_sp = (*find_it).second.lock();
+      if (cached_module_sp)
+        return Status();
+      m_loaded_modules.erase(find_it);
+    }
   }
 
   const auto module_spec_dir =
@@ -255,6 +258,7 @@ Status ModuleCache::Get(const FileSpec &root_dir_spec, const char *hostname,
   if (FileSystem::Instance().Exists(symfile_spec))
     cached_module_sp->SetSymbolFileFileSpec(symfile_spec);
 
+  std::lock_guard<std::mutex> guard(m_loaded_modules_mutex);
   m_loaded_modules.insert(
       std::make_pair(module_spec.GetUUID().GetAsString(), cached_module_sp));
 
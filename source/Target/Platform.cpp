@@ -12,6 +12,7 @@
 #include <memory>
 #include <vector>
 
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 
@@ -26,6 +27,7 @@
 #include "lldb/Host/Host.h"
 #include "lldb/Host/HostInfo.h"
 #include "lldb/Host/OptionParser.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Interpreter/OptionValueProperties.h"
 #include "lldb/Interpreter/Property.h"
 #include "lldb/Symbol/ObjectFile.h"
@@ -1588,6 +1590,38 @@ Status Platform::GetRemoteSharedModule(const ModuleSpec &module_spec,
   return error;
 }
 
+void Platform::PrefetchSharedModules(Process *process,
+                                     llvm::ArrayRef<ModuleSpec> module_specs) {
+  if (IsHost() || !GetGlobalPlatformProperties()->GetUseModuleCache() ||
+      !GetGlobalPlatformProperties()->GetModuleCacheDirectory())
+    return;
+
+  // Resolving a spec may update the process' module spec cache, so do that
+  // here. The cache is keyed by UUID, so each module is fetched once.
+  std::vector<ModuleSpec> resolved_module_specs;
+  llvm::StringSet<> uuids;
+  for (const ModuleSpec &module_spec : module_specs) {
+    ModuleSpec resolved_module_spec;
+    if (!(process && process->GetModuleSpec(module_spec.GetFileSpec(),
+                                            module_spec.GetArchitecture(),
+                                            resolved_module_spec)) &&
+        !GetModuleSpec(module_spec.GetFileSpec(), module_spec.GetArchitecture(),
+                       resolved_module_spec))
+      continue;
+    const UUID &uuid = resolved_module_spec.GetUUID();
+    if (!uuid.IsValid() ||
+        (module_spec.GetUUID().IsValid() && module_spec.GetUUID() != uuid))
+      continue;
+    if (uuids.insert(uuid.GetAsString()).second)
+      resolved_module_specs.push_back(resolved_module_spec);
+  }
+
+  TaskMapOverInt(0, resolved_module_specs.size(), [&](size_t i) {
+    ModuleSP module_sp;
+    GetCachedSharedModule(resolved_module_specs[i], module_sp, nullptr);
+  });
+}
+
 bool Platform::GetCachedSharedModule(const ModuleSpec &module_spec,
                                      lldb::ModuleSP &module_sp,
                                      bool *did_create_ptr) {
@@ -1644,7 +1678,8 @@ Status Platform::DownloadModuleSlice(const FileSpec &src_file_spec,
     return error;
   }
 
-  std::vector<char> buffer(1024);
+  // Every read is a round trip to the remote side, so read large blocks.
+  std::vector<char> buffer(std::min<uint64_t>(128 * 1024, src_size));
   auto offset = src_offset;
   uint64_t total_bytes_read = 0;
   while (total_bytes_read < src_size) {
@@ -7,8 +7,10 @@
 //===----------------------------------------------------------------------===//
 
 #include <atomic>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
 
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/Threading.h"
@@ -17,10 +19,13 @@
 #include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Breakpoint/StoppointCallbackContext.h"
 #include "lldb/Core/Debugger.h"
+#include "lldb/Core/Disassembler.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
+#include "lldb/Core/Section.h"
 #include "lldb/Core/StreamFile.h"
+#include "lldb/Core/ValueObject.h"
 #include "lldb/Expression/DiagnosticManager.h"
 #include "lldb/Expression/DynamicCheckerFunctions.h"
 #include "lldb/Expression/UserExpression.h"
@@ -31,13 +36,18 @@
 #include "lldb/Host/HostInfo.h"
 #include "lldb/Host/OptionParser.h"
 #include "lldb/Host/Pipe.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Host/Terminal.h"
 #include "lldb/Host/ThreadLauncher.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Interpreter/OptionArgParser.h"
 #include "lldb/Interpreter/OptionValueProperties.h"
+#include "lldb/Symbol/CompactUnwindInfo.h"
 #include "lldb/Symbol/Function.h"
+#include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/Symbol.h"
+#include "lldb/Symbol/UnwindTable.h"
+#include "lldb/Symbol/VariableList.h"
 #include "lldb/Target/ABI.h"
 #include "lldb/Target/DynamicLoader.h"
 #include "lldb/Target/InstrumentationRuntime.h"
@@ -51,6 +61,8 @@
 #include "lldb/Target/Platform.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/SectionLoadList.h"
+#include "lldb/Target/StackFrame.h"
 #include "lldb/Target/StopInfo.h"
 #include "lldb/Target/StructuredDataPlugin.h"
 #include "lldb/Target/SystemRuntime.h"
@@ -162,6 +174,42 @@ uint64_t ProcessProperties::GetMemoryCacheLineSize() const {
       nullptr, idx, g_process_properties[idx].default_uint_value);
 }
 
+uint64_t ProcessProperties::GetMemoryCachePrefetchLines() const {
+  const uint32_t idx = ePropertyMemCachePrefetchLines;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_process_properties[idx].default_uint_value);
+}
+
+uint64_t ProcessProperties::GetMemoryCacheSize() const {
+  const uint32_t idx = ePropertyMemCacheSize;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_process_properties[idx].default_uint_value);
+}
+
+uint64_t ProcessProperties::GetStackPrefetchSize() const {
+  const uint32_t idx = ePropertyStackPrefetchSize;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_process_properties[idx].default_uint_value);
+}
+
+bool ProcessProperties::GetParallelUnwind() const {
+  const uint32_t idx = ePropertyParallelUnwind;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_process_properties[idx].default_uint_value != 0);
+}
+
+bool ProcessProperties::GetPrefetchFrameVariables() const {
+  const uint32_t idx = ePropertyPrefetchFrameVariables;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_process_properties[idx].default_uint_value != 0);
+}
+
+bool ProcessProperties::GetReadOnlyMemoryFromFiles() const {
+  const uint32_t idx = ePropertyReadOnlyMemoryFromFiles;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_process_properties[idx].default_uint_value != 0);
+}
+
 Args ProcessProperties::GetExtraStartupCommands() const {
   Args args;
   const uint32_t idx = ePropertyExtraStartCommand;
@@ -492,7 +540,7 @@ Process::Process(lldb::TargetSP target_sp, ListenerSP listener_sp,
       m_stdin_forward(false), m_stdout_data(), m_stderr_data(),
       m_profile_data_comm_mutex(), m_profile_data(), m_iohandler_sync(0),
       m_memory_cache(*this), m_allocated_memory_cache(*this),
-      m_should_detach(false), m_next_event_action_up(), m_public_run_lock(),
+      m_wrote_read_only_section(false), m_should_detach(false), m_next_event_action_up(), m_public_run_lock(),
       m_private_run_lock(), m_finalizing(false), m_finalize_called(false),
       m_clear_thread_plans_on_stop(false), m_force_next_event_delivery(false),
       m_destroy_in_process(false), m_destroy_complete(false),
@@ -552,6 +600,7 @@ Process::~Process() {
   Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_OBJECT));
   LLDB_LOGF(log, "%p Process::~Process()", static_cast<void *>(this));
   StopPrivateStateThread();
+  CancelFrameVariablePrefetch();
 
   // ThreadList::Clear() will try to acquire this process's mutex, so
   // explicitly clear the thread list here to ensure that the mutex is not
@@ -569,6 +618,7 @@ const ProcessPropertiesSP &Process::GetGlobalProperties() {
 
 void Process::Finalize() {
   m_finalizing = true;
+  CancelFrameVariablePrefetch();
 
   // Destroy this process if needed
   switch (GetPrivateState()) {
@@ -1714,12 +1764,7 @@ Status Process::EnableBreakpointSiteByID(lldb::user_id_t break_id) {
   return error;
 }
 
-lldb::break_id_t
-Process::CreateBreakpointSite(const BreakpointLocationSP &owner,
-                              bool use_hardware) {
-  addr_t load_addr = LLDB_INVALID_ADDRESS;
-
-  bool show_error = true;
+bool Process::ShouldReportBreakpointSiteErrors() {
   switch (GetState()) {
   case eStateInvalid:
   case eStateUnloaded:
@@ -1728,17 +1773,24 @@ Process::CreateBreakpointSite(const BreakpointLocationSP &owner,
   case eStateLaunching:
   case eStateDetached:
   case eStateExited:
-    show_error = false;
-    break;
+    return false;
 
   case eStateStopped:
   case eStateRunning:
   case eStateStepping:
   case eStateCrashed:
   case eStateSuspended:
-    show_error = IsAlive();
-    break;
+    return IsAlive();
   }
+  return true;
+}
+
+lldb::break_id_t
+Process::CreateBreakpointSite(const BreakpointLocationSP &owner,
+                              bool use_hardware) {
+  addr_t load_addr = LLDB_INVALID_ADDRESS;
+
+  bool show_error = ShouldReportBreakpointSiteErrors();
 
   // Reset the IsIndirect flag here, in case the location changes from pointing
   // to a indirect symbol to a regular symbol.
@@ -1778,11 +1830,19 @@ Process::CreateBreakpointSite(const BreakpointLocationSP &owner,
     if (bp_site_sp) {
       bp_site_sp->AddOwner(owner);
       owner->SetBreakpointSite(bp_site_sp);
+      // The new owner may have to stop where the others don't.
+      BreakpointSiteConditionsChanged(bp_site_sp.get());
       return bp_site_sp->GetID();
     } else {
       bp_site_sp.reset(new BreakpointSite(&m_breakpoint_site_list, owner,
                                           load_addr, use_hardware));
       if (bp_site_sp) {
+        // Inside a batch the site is enabled, or dropped again, when the
+        // batch ends.
+        if (DeferBreakpointSiteEnable(bp_site_sp)) {
+          owner->SetBreakpointSite(bp_site_sp);
+          return m_breakpoint_site_list.Add(bp_site_sp);
+        }
         Status error = EnableBreakpointSite(bp_site_sp.get());
         if (error.Success()) {
           owner->SetBreakpointSite(bp_site_sp);
@@ -1808,14 +1868,150 @@ void Process::RemoveOwnerFromBreakpointSite(lldb::user_id_t owner_id,
                                             lldb::user_id_t owner_loc_id,
                                             BreakpointSiteSP &bp_site_sp) {
   uint32_t num_owners = bp_site_sp->RemoveOwner(owner_id, owner_loc_id);
+  if (num_owners != 0 && IsAlive())
+    BreakpointSiteConditionsChanged(bp_site_sp.get());
   if (num_owners == 0) {
+    // A site that is still waiting to be enabled was never inserted.
+    const bool was_pending = CancelPendingBreakpointSiteEnable(bp_site_sp);
     // Don't try to disable the site if we don't have a live process anymore.
-    if (IsAlive())
+    if (!was_pending && IsAlive() && !DeferBreakpointSiteDisable(bp_site_sp))
       DisableBreakpointSite(bp_site_sp.get());
     m_breakpoint_site_list.RemoveByAddress(bp_site_sp->GetLoadAddress());
   }
 }
 
+std::vector<Status>
+Process::EnableBreakpointSites(llvm::ArrayRef<BreakpointSite *> bp_sites) {
+  std::vector<Status> errors;
+  errors.reserve(bp_sites.size());
+  for (BreakpointSite *bp_site : bp_sites)
+    errors.push_back(EnableBreakpointSite(bp_site));
+  return errors;
+}
+
+std::vector<Status>
+Process::DisableBreakpointSites(llvm::ArrayRef<BreakpointSite *> bp_sites) {
+  std::vector<Status> errors;
+  errors.reserve(bp_sites.size());
+  for (BreakpointSite *bp_site : bp_sites)
+    errors.push_back(DisableBreakpointSite(bp_site));
+  return errors;
+}
+
+Process::BreakpointSiteBatch::BreakpointSiteBatch(
+    const lldb::ProcessSP &process_sp)
+    : m_process_sp(process_sp) {
+  if (m_process_sp)
+    m_process_sp->BeginBreakpointSiteBatch();
+}
+
+Process::BreakpointSiteBatch::~BreakpointSiteBatch() {
+  if (m_process_sp)
+    m_process_sp->EndBreakpointSiteBatch();
+}
+
+void Process::BeginBreakpointSiteBatch() {
+  std::lock_guard<std::mutex> guard(m_pending_bp_sites_mutex);
+  ++m_bp_site_batch_depth;
+}
+
+void Process::EndBreakpointSiteBatch() {
+  std::vector<BreakpointSiteSP> to_enable;
+  std::vector<BreakpointSiteSP> to_disable;
+  {
+    std::lock_guard<std::mutex> guard(m_pending_bp_sites_mutex);
+    assert(m_bp_site_batch_depth > 0);
+    if (--m_bp_site_batch_depth != 0)
+      return;
+    to_enable.swap(m_pending_enable_bp_sites);
+    to_disable.swap(m_pending_disable_bp_sites);
+  }
+
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+
+  // Disable first, a site removed in this batch might have been replaced by
+  // a new one at the same address.
+  if (!to_disable.empty()) {
+    std::vector<BreakpointSite *> bp_sites;
+    for (const BreakpointSiteSP &bp_site_sp : to_disable)
+      bp_sites.push_back(bp_site_sp.get());
+    std::vector<Status> errors = DisableBreakpointSites(bp_sites);
+    for (size_t i = 0; i < errors.size(); ++i) {
+      if (errors[i].Fail())
+        LLDB_LOGF(log,
+                  "Process::%s failed to disable breakpoint site at 0x%" PRIx64
+                  ": %s",
+                  __FUNCTION__, bp_sites[i]->GetLoadAddress(),
+                  errors[i].AsCString("unknown error"));
+    }
+  }
+
+  if (to_enable.empty())
+    return;
+
+  std::vector<BreakpointSite *> bp_sites;
+  for (const BreakpointSiteSP &bp_site_sp : to_enable)
+    bp_sites.push_back(bp_site_sp.get());
+  std::vector<Status> errors = EnableBreakpointSites(bp_sites);
+  const bool show_error = ShouldReportBreakpointSiteErrors();
+  for (size_t i = 0; i < errors.size(); ++i) {
+    if (errors[i].Success())
+      continue;
+
+    BreakpointSiteSP &bp_site_sp = to_enable[i];
+    std::vector<BreakpointLocationSP> owners;
+    for (size_t j = 0, e = bp_site_sp->GetNumberOfOwners(); j != e; ++j)
+      owners.push_back(bp_site_sp->GetOwnerAtIndex(j));
+
+    if ((show_error || bp_site_sp->HardwareRequired()) && !owners.empty()) {
+      // Report error for setting breakpoint...
+      GetTarget().GetDebugger().GetErrorFile()->Printf(
+          "warning: failed to set breakpoint site at 0x%" PRIx64
+          " for breakpoint %i.%i: %s\n",
+          bp_site_sp->GetLoadAddress(), owners[0]->GetBreakpoint().GetID(),
+          owners[0]->GetID(), errors[i].AsCString("unknown error"));
+    }
+
+    // Detaching the last owner also drops the site from the site list.
+    for (BreakpointLocationSP &owner : owners)
+      owner->ClearBreakpointSite();
+  }
+}
+
+bool Process::DeferBreakpointSiteEnable(const BreakpointSiteSP &bp_site_sp) {
+  std::lock_guard<std::mutex> guard(m_pending_bp_sites_mutex);
+  if (m_bp_site_batch_depth == 0)
+    return false;
+  m_pending_enable_bp_sites.push_back(bp_site_sp);
+  return true;
+}
+
+bool Process::DeferBreakpointSiteDisable(const BreakpointSiteSP &bp_site_sp) {
+  // Sites that patched the inferior's memory themselves are restored right
+  // away, once they leave the site list memory reads would no longer hide
+  // their trap opcodes.
+  if (!bp_site_sp->IsEnabled() ||
+      bp_site_sp->GetType() != BreakpointSite::eExternal)
+    return false;
+
+  std::lock_guard<std::mutex> guard(m_pending_bp_sites_mutex);
+  if (m_bp_site_batch_depth == 0)
+    return false;
+  m_pending_disable_bp_sites.push_back(bp_site_sp);
+  return true;
+}
+
+bool Process::CancelPendingBreakpointSiteEnable(
+    const BreakpointSiteSP &bp_site_sp) {
+  std::lock_guard<std::mutex> guard(m_pending_bp_sites_mutex);
+  auto pos = std::find(m_pending_enable_bp_sites.begin(),
+                       m_pending_enable_bp_sites.end(), bp_site_sp);
+  if (pos == m_pending_enable_bp_sites.end())
+    return false;
+  m_pending_enable_bp_sites.erase(pos);
+  return true;
+}
+
 size_t Process::RemoveBreakpointOpcodesFromBuffer(addr_t bp_addr, size_t size,
                                                   uint8_t *buf) const {
   size_t bytes_removed = 0;
@@ -2084,6 +2280,37 @@ size_t Process::ReadCStringFromMemory(addr_t addr, std::string &out_str,
   return out_str.size();
 }
 
+/// Return how many bytes to read next while looking for the end of a string
+/// at \a addr. The first read stops at the end of the cache line, since most
+/// strings are short, and each read after that doubles in size so that long
+/// strings only take a logarithmic number of round trips. \a chunk_size is
+/// the size of the last read, or 0 before the first one.
+static size_t GetStringReadSize(addr_t addr, size_t bytes_left,
+                                size_t cache_line_size, size_t &chunk_size) {
+  const size_t max_chunk_size = 64 * cache_line_size;
+  chunk_size = chunk_size ? std::min(2 * chunk_size, max_chunk_size)
+                          : cache_line_size;
+  return std::min<addr_t>(bytes_left, chunk_size - (addr % cache_line_size));
+}
+
+/// Read up to \a size bytes for a string read. A large read can fail if it
+/// runs into unmapped memory past the end of the string, so retry up to the
+/// end of the current cache line before giving up, shrinking \a size, and
+/// stop growing the reads.
+static size_t ReadStringChunk(Process &process, addr_t addr, char *dst,
+                              addr_t &size, size_t cache_line_size,
+                              size_t &chunk_size, Status &error) {
+  size_t bytes_read = process.ReadMemory(addr, dst, size, error);
+  const size_t cache_line_bytes_left =
+      cache_line_size - (addr % cache_line_size);
+  if (bytes_read == 0 && size > cache_line_bytes_left) {
+    chunk_size = 0;
+    size = cache_line_bytes_left;
+    bytes_read = process.ReadMemory(addr, dst, size, error);
+  }
+  return bytes_read;
+}
+
 size_t Process::ReadStringFromMemory(addr_t addr, char *dst, size_t max_bytes,
                                      Status &error, size_t type_width) {
   size_t total_bytes_read = 0;
@@ -2100,28 +2327,36 @@ size_t Process::ReadStringFromMemory(addr_t addr, char *dst, size_t max_bytes,
 
     addr_t curr_addr = addr;
     const size_t cache_line_size = m_memory_cache.GetMemoryCacheLineSize();
+    size_t chunk_size = 0;
     char *curr_dst = dst;
 
     error.Clear();
     while (bytes_left > 0 && error.Success()) {
-      addr_t cache_line_bytes_left =
-          cache_line_size - (curr_addr % cache_line_size);
-      addr_t bytes_to_read =
-          std::min<addr_t>(bytes_left, cache_line_bytes_left);
-      size_t bytes_read = ReadMemory(curr_addr, curr_dst, bytes_to_read, error);
+      addr_t bytes_to_read = GetStringReadSize(curr_addr, bytes_left,
+                                               cache_line_size, chunk_size);
+      size_t bytes_read = ReadStringChunk(*this, curr_addr, curr_dst,
+                                          bytes_to_read, cache_line_size,
+                                          chunk_size, error);
 
       if (bytes_read == 0)
         break;
 
       // Search for a null terminator of correct size and alignment in
       // bytes_read
-      size_t aligned_start = total_bytes_read - total_bytes_read % type_width;
-      for (size_t i = aligned_start;
-           i + type_width <= total_bytes_read + bytes_read; i += type_width)
-        if (::memcmp(&dst[i], terminator, type_width) == 0) {
+      if (type_width == 1) {
+        if (const void *nul = ::memchr(curr_dst, 0, bytes_read)) {
           error.Clear();
-          return i;
+          return static_cast<const char *>(nul) - dst;
         }
+      } else {
+        size_t aligned_start = total_bytes_read - total_bytes_read % type_width;
+        for (size_t i = aligned_start;
+             i + type_width <= total_bytes_read + bytes_read; i += type_width)
+          if (::memcmp(&dst[i], terminator, type_width) == 0) {
+            error.Clear();
+            return i;
+          }
+      }
 
       total_bytes_read += bytes_read;
       curr_dst += bytes_read;
@@ -2148,22 +2383,25 @@ size_t Process::ReadCStringFromMemory(addr_t addr, char *dst,
     Status error;
     addr_t curr_addr = addr;
     const size_t cache_line_size = m_memory_cache.GetMemoryCacheLineSize();
+    size_t chunk_size = 0;
     size_t bytes_left = dst_max_len - 1;
     char *curr_dst = dst;
 
     while (bytes_left > 0) {
-      addr_t cache_line_bytes_left =
-          cache_line_size - (curr_addr % cache_line_size);
-      addr_t bytes_to_read =
-          std::min<addr_t>(bytes_left, cache_line_bytes_left);
-      size_t bytes_read = ReadMemory(curr_addr, curr_dst, bytes_to_read, error);
+      addr_t bytes_to_read = GetStringReadSize(curr_addr, bytes_left,
+                                               cache_line_size, chunk_size);
+      size_t bytes_read = ReadStringChunk(*this, curr_addr, curr_dst,
+                                          bytes_to_read, cache_line_size,
+                                          chunk_size, error);
 
       if (bytes_read == 0) {
         result_error = error;
         dst[total_cstr_len] = '\0';
         break;
       }
-      const size_t len = strlen(curr_dst);
+      const void *nul = ::memchr(curr_dst, 0, bytes_read);
+      const size_t len =
+          nul ? static_cast<const char *>(nul) - curr_dst : bytes_read;
 
       total_cstr_len += len;
 
@@ -2183,11 +2421,52 @@ size_t Process::ReadCStringFromMemory(addr_t addr, char *dst,
   return total_cstr_len;
 }
 
+// Return the loaded section that contains \a addr if its contents in the
+// process are the bytes of its object file, for as long as it is loaded:
+// it is read-only and was mapped from a file that isn't a relocatable
+// object.
+static SectionSP GetReadOnlyFileSection(Target &target, addr_t addr,
+                                        addr_t &offset) {
+  Address so_addr;
+  if (!target.GetSectionLoadList().ResolveLoadAddress(addr, so_addr))
+    return SectionSP();
+  SectionSP section_sp = so_addr.GetSection();
+  if (!section_sp || section_sp->IsEncrypted() ||
+      section_sp->IsThreadSpecific() ||
+      section_sp->GetPermissions() & ePermissionsWritable ||
+      !(section_sp->GetPermissions() & ePermissionsReadable))
+    return SectionSP();
+  ObjectFile *objfile = section_sp->GetObjectFile();
+  if (!objfile || objfile->IsInMemory() ||
+      objfile->GetType() == ObjectFile::eTypeObjectFile)
+    return SectionSP();
+  offset = so_addr.GetOffset();
+  return section_sp;
+}
+
 size_t Process::ReadMemoryFromInferior(addr_t addr, void *buf, size_t size,
                                        Status &error) {
   if (buf == nullptr || size == 0)
     return 0;
 
+  // Code and constant data can be copied from the object file, which is
+  // usually mapped already, instead of being read from the process, which is
+  // often a round trip to a remote stub. The file has no software
+  // breakpoints in it, so the bytes are what the process would return after
+  // RemoveBreakpointOpcodesFromBuffer.
+  if (!m_wrote_read_only_section && GetReadOnlyMemoryFromFiles()) {
+    addr_t offset = 0;
+    if (SectionSP section_sp = GetReadOnlyFileSection(GetTarget(), addr,
+                                                       offset)) {
+      if (offset + size <= section_sp->GetFileSize() &&
+          section_sp->GetObjectFile()->ReadSectionData(
+              section_sp.get(), offset, buf, size) == size) {
+        error.Clear();
+        return size;
+      }
+    }
+  }
+
   size_t bytes_read = 0;
   uint8_t *bytes = (uint8_t *)buf;
 
@@ -2207,6 +2486,278 @@ size_t Process::ReadMemoryFromInferior(addr_t addr, void *buf, size_t size,
   return bytes_read;
 }
 
+std::vector<size_t>
+Process::ReadMemoryRanges(llvm::ArrayRef<MemoryRange> ranges, uint8_t *buf) {
+  std::vector<size_t> bytes_read = DoReadMemoryRanges(ranges, buf);
+  assert(bytes_read.size() == ranges.size());
+
+  // Replace any software breakpoint opcodes that fall into these ranges back
+  // into "buf" before we return
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    if (bytes_read[i] > 0)
+      RemoveBreakpointOpcodesFromBuffer(ranges[i].GetRangeBase(),
+                                        bytes_read[i], buf);
+    buf += ranges[i].GetByteSize();
+  }
+  return bytes_read;
+}
+
+std::vector<size_t>
+Process::DoReadMemoryRanges(llvm::ArrayRef<MemoryRange> ranges, uint8_t *buf) {
+  std::vector<size_t> bytes_read;
+  bytes_read.reserve(ranges.size());
+  for (const MemoryRange &range : ranges) {
+    const addr_t addr = range.GetRangeBase();
+    const size_t size = range.GetByteSize();
+    size_t range_bytes_read = 0;
+    while (range_bytes_read < size) {
+      Status error;
+      const size_t curr_bytes_read =
+          DoReadMemory(addr + range_bytes_read, buf + range_bytes_read,
+                       size - range_bytes_read, error);
+      if (curr_bytes_read == 0)
+        break;
+      range_bytes_read += curr_bytes_read;
+    }
+    bytes_read.push_back(range_bytes_read);
+    buf += size;
+  }
+  return bytes_read;
+}
+
+lldb::addr_t Process::FindInMemory(lldb::addr_t low, lldb::addr_t high,
+                                   llvm::ArrayRef<uint8_t> pattern) {
+  if (pattern.empty() || high <= low || high - low < pattern.size())
+    return LLDB_INVALID_ADDRESS;
+
+  // Breakpoint opcodes we wrote into memory ourselves would get in the way
+  // of a search done by the target.
+  bool has_software_breakpoints = false;
+  m_breakpoint_site_list.ForEach([&](BreakpointSite *site) {
+    const addr_t addr = site->GetLoadAddress();
+    if (site->GetType() == BreakpointSite::eSoftware && site->IsEnabled() &&
+        addr < high && addr + site->GetTrapOpcodeMaxByteSize() > low)
+      has_software_breakpoints = true;
+  });
+  lldb::addr_t found_addr = LLDB_INVALID_ADDRESS;
+  if (!has_software_breakpoints &&
+      DoFindInMemory(low, high, pattern, found_addr))
+    return found_addr;
+
+  // Read the memory in large chunks and search each of them, keeping the
+  // end of the previous chunk around for matches that straddle two chunks.
+  // StringRef::find uses the Boyer-Moore-Horspool algorithm.
+  const size_t chunk_size = std::max<size_t>(1024 * 1024, pattern.size());
+  const llvm::StringRef pattern_str(
+      reinterpret_cast<const char *>(pattern.data()), pattern.size());
+  std::string data;
+  addr_t data_addr = low;
+  addr_t addr = low;
+  while (addr < high) {
+    const size_t size = std::min<addr_t>(chunk_size, high - addr);
+    const size_t kept = data.size();
+    data.resize(kept + size);
+    Status error;
+    const size_t bytes_read = ReadMemory(addr, &data[kept], size, error);
+    data.resize(kept + bytes_read);
+
+    const size_t pos = llvm::StringRef(data).find(pattern_str);
+    if (pos != llvm::StringRef::npos)
+      return data_addr + pos;
+
+    if (bytes_read == size) {
+      const size_t keep = std::min(data.size(), pattern.size() - 1);
+      data.erase(0, data.size() - keep);
+      addr += size;
+      data_addr = addr - keep;
+      continue;
+    }
+
+    // Carry on after the memory region we couldn't read.
+    const addr_t unreadable_addr = addr + bytes_read;
+    MemoryRegionInfo region;
+    if (GetMemoryRegionInfo(unreadable_addr, region).Fail() ||
+        region.GetRange().GetRangeEnd() <= unreadable_addr)
+      break;
+    data.clear();
+    addr = region.GetRange().GetRangeEnd();
+    data_addr = addr;
+  }
+  return LLDB_INVALID_ADDRESS;
+}
+
+void Process::PrefetchStackFrames(llvm::ArrayRef<ThreadSP> threads,
+                                  uint32_t num_frames) {
+  if (threads.size() < 2 || num_frames == 0)
+    return;
+
+  // Creating the register contexts reads the stack pointers, which are
+  // usually expedited in the stop reply anyway. Doing it here also keeps the
+  // concurrent unwinds below from racing to create them.
+  std::vector<MemoryRange> ranges;
+  std::map<CompactUnwindInfo *, std::vector<Address>> pcs_by_compact_unwind;
+  const uint64_t prefetch_size = GetStackPrefetchSize();
+  for (const ThreadSP &thread_sp : threads) {
+    RegisterContextSP reg_ctx_sp = thread_sp->GetRegisterContext();
+    if (!reg_ctx_sp)
+      continue;
+    const addr_t sp = reg_ctx_sp->GetSP(LLDB_INVALID_ADDRESS);
+    if (sp != LLDB_INVALID_ADDRESS && prefetch_size > 0)
+      ranges.push_back(MemoryRange(sp, prefetch_size));
+
+    Address pc_addr;
+    const addr_t pc = reg_ctx_sp->GetPC(LLDB_INVALID_ADDRESS);
+    if (pc == LLDB_INVALID_ADDRESS ||
+        !GetTarget().GetSectionLoadList().ResolveLoadAddress(pc, pc_addr))
+      continue;
+    if (ModuleSP module_sp = pc_addr.GetModule())
+      if (CompactUnwindInfo *compact_unwind =
+              module_sp->GetUnwindTable().GetCompactUnwindInfo())
+        pcs_by_compact_unwind[compact_unwind].push_back(pc_addr);
+  }
+
+  // Threads tend to be stopped in the same few functions; look up their
+  // compact unwind info together so each second level page is decoded once.
+  for (auto &compact_unwind_and_pcs : pcs_by_compact_unwind) {
+    std::vector<UnwindPlanSP> unwind_plans;
+    compact_unwind_and_pcs.first->GetUnwindPlans(
+        GetTarget(), compact_unwind_and_pcs.second, unwind_plans);
+  }
+
+  if (!ranges.empty() && !GetDisableMemoryCache()) {
+    std::vector<uint8_t> buffer(ranges.size() * prefetch_size);
+    std::vector<size_t> bytes_read = ReadMemoryRanges(ranges, buffer.data());
+    for (size_t i = 0; i < ranges.size(); ++i) {
+      if (bytes_read[i] > 0)
+        m_memory_cache.AddL1CacheData(ranges[i].GetRangeBase(),
+                                      buffer.data() + i * prefetch_size,
+                                      bytes_read[i]);
+    }
+  }
+
+  // Operating system plug-ins may be written in Python and provide the
+  // register contexts of their threads, leave those threads to the caller.
+  if (!GetParallelUnwind() || m_os_up)
+    return;
+
+  // The unwinders of all threads use these, create them before the threads
+  // race to do so.
+  GetABI();
+  GetDynamicLoader();
+
+  TaskMapOverInt(0, threads.size(), [&](size_t i) {
+    if (num_frames == UINT32_MAX)
+      threads[i]->GetStackFrameCount();
+    else
+      threads[i]->GetStackFrameAtIndex(num_frames - 1);
+  });
+}
+
+void Process::StartFrameVariablePrefetch() {
+  if (!GetPrefetchFrameVariables() ||
+      IsHijackedForEvent(eBroadcastBitStateChanged))
+    return;
+
+  CancelFrameVariablePrefetch();
+  ThreadSP thread_sp = GetThreadList().GetSelectedThread();
+  if (!thread_sp)
+    return;
+  StackFrameSP frame_sp = thread_sp->GetSelectedFrame();
+  if (!frame_sp || frame_sp->IsHistorical())
+    return;
+
+  // This gets its own thread rather than a task pool task, as a thread
+  // waiting for tasks may pick it up and run it in the middle of whatever it
+  // was doing.
+  std::lock_guard<std::mutex> guard(m_frame_variable_prefetch_mutex);
+  m_cancel_frame_variable_prefetch = false;
+  m_frame_variable_prefetch_thread =
+      std::thread(&Process::PrefetchFrameVariables,
+                  ProcessWP(shared_from_this()), frame_sp, GetStopID());
+}
+
+void Process::CancelFrameVariablePrefetch() {
+  std::lock_guard<std::mutex> guard(m_frame_variable_prefetch_mutex);
+  if (!m_frame_variable_prefetch_thread.joinable())
+    return;
+  m_cancel_frame_variable_prefetch = true;
+  // The prefetch must not wait for itself if it ends up here.
+  if (m_frame_variable_prefetch_thread.get_id() == std::this_thread::get_id())
+    m_frame_variable_prefetch_thread.detach();
+  else
+    m_frame_variable_prefetch_thread.join();
+}
+
+void Process::PrefetchFrameVariables(ProcessWP process_wp,
+                                     StackFrameSP frame_sp, uint32_t stop_id) {
+  // Run one step with the API mutex held. Whoever holds it may be about to
+  // resume the process and wait for us, so only try to take it, and give up
+  // once the prefetch is cancelled or the process has moved on.
+  auto run_step = [&](llvm::function_ref<void(Process &)> step) {
+    ProcessSP process_sp = process_wp.lock();
+    if (!process_sp)
+      return false;
+    std::unique_lock<std::recursive_mutex> api_lock(
+        process_sp->GetTarget().GetAPIMutex(), std::defer_lock);
+    while (!api_lock.try_lock()) {
+      if (process_sp->m_cancel_frame_variable_prefetch)
+        return false;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (process_sp->m_cancel_frame_variable_prefetch ||
+        process_sp->GetStopID() != stop_id ||
+        process_sp->GetPrivateState() != eStateStopped)
+      return false;
+    step(*process_sp);
+    return true;
+  };
+
+  // Parse the variables of the frame's function, and read the frame's part of
+  // the stack, where most of them live, in one go.
+  VariableListSP variables_sp;
+  if (!run_step([&](Process &process) {
+        frame_sp->GetVariableList(true);
+        variables_sp = frame_sp->GetInScopeVariableList(false);
+
+        RegisterContextSP reg_ctx_sp = frame_sp->GetRegisterContext();
+        const addr_t sp =
+            reg_ctx_sp ? reg_ctx_sp->GetSP(LLDB_INVALID_ADDRESS)
+                       : LLDB_INVALID_ADDRESS;
+        const addr_t cfa = frame_sp->GetStackID().GetCallFrameAddress();
+        const addr_t max_frame_size = 64 * 1024;
+        if (sp == LLDB_INVALID_ADDRESS || cfa == LLDB_INVALID_ADDRESS ||
+            cfa <= sp || cfa - sp > max_frame_size ||
+            process.GetDisableMemoryCache())
+          return;
+        MemoryRange range(sp, cfa - sp);
+        std::vector<uint8_t> buffer(range.GetByteSize());
+        std::vector<size_t> bytes_read =
+            process.ReadMemoryRanges(range, buffer.data());
+        if (bytes_read[0] > 0)
+          process.m_memory_cache.AddL1CacheData(sp, buffer.data(),
+                                                bytes_read[0]);
+      }) ||
+      !variables_sp)
+    return;
+
+  // Evaluating the location of a variable and reading its value happen when
+  // its value object is updated. Dynamic types are only checked if that
+  // doesn't run code, which would resume the process.
+  for (size_t i = 0; i < variables_sp->GetSize(); ++i) {
+    VariableSP variable_sp = variables_sp->GetVariableAtIndex(i);
+    if (!run_step([&](Process &process) {
+          ValueObjectSP valobj_sp = frame_sp->GetValueObjectForFrameVariable(
+              variable_sp, eNoDynamicValues);
+          if (!valobj_sp || !valobj_sp->UpdateValueIfNeeded(false))
+            return;
+          if (process.GetTarget().GetPreferDynamicValue() ==
+              eDynamicDontRunTarget)
+            valobj_sp->GetDynamicValue(eDynamicDontRunTarget);
+        }))
+      return;
+  }
+}
+
 uint64_t Process::ReadUnsignedIntegerFromMemory(lldb::addr_t vm_addr,
                                                 size_t integer_byte_size,
                                                 uint64_t fail_value,
@@ -2276,6 +2827,14 @@ size_t Process::WriteMemory(addr_t addr, const void *buf, size_t size,
 
   m_mod_id.BumpMemoryID();
 
+  // Once a read-only section has been patched, the object files no longer
+  // describe what is in memory.
+  if (!m_wrote_read_only_section) {
+    addr_t offset = 0;
+    if (GetReadOnlyFileSection(GetTarget(), addr, offset))
+      m_wrote_read_only_section = true;
+  }
+
   // We need to write any data that would go where any current software traps
   // (enabled software breakpoints) any software traps (breakpoints) that we
   // may have placed in our tasks memory.
@@ -2426,14 +2985,74 @@ addr_t Process::AllocateMemory(size_t size, uint32_t permissions,
 
 addr_t Process::CallocateMemory(size_t size, uint32_t permissions,
                                 Status &error) {
+#if defined(USE_ALLOCATE_MEMORY_CACHE)
+  if (GetPrivateState() != eStateStopped) {
+    error.SetErrorToGenericError();
+    return LLDB_INVALID_ADDRESS;
+  }
+
+  // Pages fresh from DoAllocateMemory are zero filled, so only memory that
+  // the cache hands out a second time needs clearing.
+  bool is_zeroed = false;
+  addr_t return_addr = m_allocated_memory_cache.AllocateMemory(
+      size, permissions, error, &is_zeroed);
+  if (error.Success() && !is_zeroed) {
+#else
   addr_t return_addr = AllocateMemory(size, permissions, error);
   if (error.Success()) {
+#endif
     std::string buffer(size, 0);
     WriteMemory(return_addr, buffer.c_str(), size, error);
   }
   return return_addr;
 }
 
+DisassemblerSP Process::GetStepRangeDisassembly(const AddressRange &range) {
+  Target &target = GetTarget();
+  ExecutionContext exe_ctx(this);
+  const char *plugin_name = nullptr;
+  const char *flavor = nullptr;
+
+  // Code that comes from a file on disk is shared through its module, so the
+  // unwinder and other processes of the same binary can reuse it.
+  if (ModuleSP module_sp = range.GetBaseAddress().GetModule()) {
+    if (DisassemblerSP disassembler_sp = module_sp->GetCachedDisassembly(
+            target.GetArchitecture(), plugin_name, flavor, exe_ctx, range))
+      return disassembler_sp;
+  }
+
+  const addr_t load_addr = range.GetBaseAddress().GetLoadAddress(&target);
+  const auto key = std::make_pair(load_addr, range.GetByteSize());
+
+  std::lock_guard<std::mutex> guard(m_step_range_disassembly_mutex);
+  const uint32_t memory_id = m_mod_id.GetMemoryID();
+  if (m_step_range_disassembly_memory_id != memory_id) {
+    m_step_range_disassembly.clear();
+    m_step_range_disassembly_memory_id = memory_id;
+  }
+
+  if (load_addr != LLDB_INVALID_ADDRESS) {
+    auto pos = m_step_range_disassembly.find(key);
+    if (pos != m_step_range_disassembly.end())
+      return pos->second;
+  }
+
+  const bool prefer_file_cache = true;
+  DisassemblerSP disassembler_sp = Disassembler::DisassembleRange(
+      target.GetArchitecture(), plugin_name, flavor, exe_ctx, range,
+      prefer_file_cache);
+
+  if (disassembler_sp && load_addr != LLDB_INVALID_ADDRESS) {
+    // Stepping only ever visits a handful of functions at a time, keep the
+    // cache from growing without bound in long sessions.
+    const size_t max_cached_ranges = 256;
+    if (m_step_range_disassembly.size() >= max_cached_ranges)
+      m_step_range_disassembly.clear();
+    m_step_range_disassembly[key] = disassembler_sp;
+  }
+  return disassembler_sp;
+}
+
 bool Process::CanJIT() {
   if (m_can_jit == eCanJITDontKnow) {
     Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_PROCESS));
@@ -3142,6 +3761,8 @@ Status Process::PrivateResume() {
             m_mod_id.GetStopID(), StateAsCString(m_public_state.GetValue()),
             StateAsCString(m_private_state.GetValue()));
 
+  CancelFrameVariablePrefetch();
+
   // If signals handing status changed we might want to update our signal
   // filters before resuming.
   UpdateAutomaticSignalFiltering();
@@ -3287,6 +3908,7 @@ Status Process::Detach(bool keep_stopped) {
   EventSP exit_event_sp;
   Status error;
   m_destroy_in_process = true;
+  CancelFrameVariablePrefetch();
 
   error = WillDetach();
 
@@ -3354,6 +3976,7 @@ Status Process::Destroy(bool force_kill) {
   }
 
   m_destroy_in_process = true;
+  CancelFrameVariablePrefetch();
 
   Status error(WillDestroy());
   if (error.Success()) {
@@ -3782,6 +4405,8 @@ void Process::HandlePrivateEvent(EventSP &event_sp) {
                   __FUNCTION__, m_iohandler_sync.GetValue());
       }
     } else if (StateIsStoppedState(new_state, false)) {
+      // Whoever gets this event will look at the modules.
+      GetTarget().FlushPendingModuleLoads();
       if (!Process::ProcessEventData::GetRestartedFromEvent(event_sp.get())) {
         // If the lldb_private::Debugger is handling the events, we don't want
         // to pop the process IOHandler here, we want to do it when we receive
@@ -4033,8 +4658,11 @@ void Process::ProcessEventData::DoOnRemoval(Event *event_ptr) {
   // than a plain interrupt (e.g. we had already stopped for a breakpoint when
   // the halt request came through) don't do the StopInfo actions, as they may
   // end up restarting the process.
-  if (m_interrupted)
+  if (m_interrupted) {
+    if (m_state == eStateStopped && !m_restarted)
+      process_sp->StartFrameVariablePrefetch();
     return;
+  }
 
   // If we're stopped and haven't restarted, then do the StopInfo actions here:
   if (m_state == eStateStopped && !m_restarted) {
@@ -4146,6 +4774,8 @@ void Process::ProcessEventData::DoOnRemoval(Event *event_ptr) {
           process_sp->GetTarget().RunStopHooks();
           if (process_sp->GetPrivateState() == eStateRunning)
             SetRestarted(true);
+          else
+            process_sp->StartFrameVariablePrefetch();
       }
     }
   }
@@ -5731,6 +6361,12 @@ addr_t Process::ResolveIndirectFunction(const Address *address, Status &error) {
 }
 
 void Process::ModulesDidLoad(ModuleList &module_list) {
+  {
+    // New code may now live where a cached step range used to be.
+    std::lock_guard<std::mutex> guard(m_step_range_disassembly_mutex);
+    m_step_range_disassembly.clear();
+  }
+
   SystemRuntime *sys_runtime = GetSystemRuntime();
   if (sys_runtime) {
     sys_runtime->ModulesDidLoad(module_list);
@@ -5738,15 +6374,19 @@ void Process::ModulesDidLoad(ModuleList &module_list) {
 
   GetJITLoaders().ModulesDidLoad(module_list);
 
-  // Give runtimes a chance to be created.
-  InstrumentationRuntime::ModulesDidLoad(module_list, this,
-                                         m_instrumentation_runtimes);
-
-  // Tell runtimes about new modules.
-  for (auto pos = m_instrumentation_runtimes.begin();
-       pos != m_instrumentation_runtimes.end(); ++pos) {
-    InstrumentationRuntimeSP runtime = pos->second;
-    runtime->ModulesDidLoad(module_list);
+  // Instrumentation runtimes report issues by stopping at breakpoints, which
+  // a core file never hits. Don't make them scan every module of one.
+  if (IsLiveDebugSession()) {
+    // Give runtimes a chance to be created.
+    InstrumentationRuntime::ModulesDidLoad(module_list, this,
+                                           m_instrumentation_runtimes);
+
+    // Tell runtimes about new modules.
+    for (auto pos = m_instrumentation_runtimes.begin();
+         pos != m_instrumentation_runtimes.end(); ++pos) {
+      InstrumentationRuntimeSP runtime = pos->second;
+      runtime->ModulesDidLoad(module_list);
+    }
   }
 
   // Let any language runtimes we have already created know about the modules
@@ -5903,13 +6543,7 @@ Process::AdvanceAddressToNextBranchInstruction(Address default_stop_addr,
   if (!default_stop_addr.IsValid())
     return retval;
 
-  ExecutionContext exe_ctx(this);
-  const char *plugin_name = nullptr;
-  const char *flavor = nullptr;
-  const bool prefer_file_cache = true;
-  disassembler_sp = Disassembler::DisassembleRange(
-      target.GetArchitecture(), plugin_name, flavor, exe_ctx, range_bounds,
-      prefer_file_cache);
+  disassembler_sp = GetStepRangeDisassembly(range_bounds);
   if (disassembler_sp)
     insn_list = &disassembler_sp->GetInstructionList();
 
@@ -20,7 +20,8 @@ using namespace lldb;
 using namespace lldb_private;
 
 SectionLoadList::SectionLoadList(const SectionLoadList &rhs)
-    : m_addr_to_sect(), m_sect_to_addr(), m_mutex() {
+    : m_addr_to_sect(), m_sect_to_addr(), m_mutex(), m_snapshot(),
+      m_snapshot_stale(true) {
   std::lock_guard<std::recursive_mutex> guard(rhs.m_mutex);
   m_addr_to_sect = rhs.m_addr_to_sect;
   m_sect_to_addr = rhs.m_sect_to_addr;
@@ -32,6 +33,7 @@ void SectionLoadList::operator=(const SectionLoadList &rhs) {
   std::lock_guard<std::recursive_mutex> rhs_guard(rhs.m_mutex, std::adopt_lock);
   m_addr_to_sect = rhs.m_addr_to_sect;
   m_sect_to_addr = rhs.m_sect_to_addr;
+  m_snapshot_stale = true;
 }
 
 bool SectionLoadList::IsEmpty() const {
@@ -43,6 +45,7 @@ void SectionLoadList::Clear() {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
   m_addr_to_sect.clear();
   m_sect_to_addr.clear();
+  m_snapshot_stale = true;
 }
 
 addr_t
@@ -117,6 +120,7 @@ bool SectionLoadList::SetSectionLoadAddress(const lldb::SectionSP &section,
       ats_pos->second = section;
     } else
       m_addr_to_sect[load_addr] = section;
+    m_snapshot_stale = true;
     return true; // Changed
 
   } else {
@@ -162,8 +166,10 @@ size_t SectionLoadList::SetSectionUnloaded(const lldb::SectionSP &section_sp) {
 
       addr_to_sect_collection::iterator ats_pos =
           m_addr_to_sect.find(load_addr);
-      if (ats_pos != m_addr_to_sect.end())
+      if (ats_pos != m_addr_to_sect.end()) {
         m_addr_to_sect.erase(ats_pos);
+        m_snapshot_stale = true;
+      }
     }
   }
   return unload_count;
@@ -200,45 +206,53 @@ bool SectionLoadList::SetSectionUnloaded(const lldb::SectionSP &section_sp,
   if (ats_pos != m_addr_to_sect.end()) {
     erased = true;
     m_addr_to_sect.erase(ats_pos);
+    m_snapshot_stale = true;
   }
 
   return erased;
 }
 
+SectionLoadList::SnapshotSP SectionLoadList::GetSnapshot() const {
+  if (m_snapshot_stale) {
+    std::lock_guard<std::recursive_mutex> guard(m_mutex);
+    if (m_snapshot_stale) {
+      auto snapshot = std::make_shared<Snapshot>();
+      snapshot->load_addrs.reserve(m_addr_to_sect.size());
+      snapshot->sections.reserve(m_addr_to_sect.size());
+      for (const auto &entry : m_addr_to_sect) {
+        snapshot->load_addrs.push_back(entry.first);
+        snapshot->sections.push_back(entry.second);
+      }
+      std::atomic_store(&m_snapshot, SnapshotSP(std::move(snapshot)));
+      m_snapshot_stale = false;
+    }
+  }
+  return std::atomic_load(&m_snapshot);
+}
+
 bool SectionLoadList::ResolveLoadAddress(addr_t load_addr, Address &so_addr,
                                          bool allow_section_end) const {
-  // First find the top level section that this load address exists in
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  if (!m_addr_to_sect.empty()) {
-    addr_to_sect_collection::const_iterator pos =
-        m_addr_to_sect.lower_bound(load_addr);
-    if (pos != m_addr_to_sect.end()) {
-      if (load_addr != pos->first && pos != m_addr_to_sect.begin())
-        --pos;
-      const addr_t pos_load_addr = pos->first;
-      if (load_addr >= pos_load_addr) {
-        addr_t offset = load_addr - pos_load_addr;
-        if (offset < pos->second->GetByteSize() + (allow_section_end ? 1 : 0)) {
-          // We have found the top level section, now we need to find the
-          // deepest child section.
-          return pos->second->ResolveContainedAddress(offset, so_addr,
-                                                      allow_section_end);
-        }
-      }
-    } else {
-      // There are no entries that have an address that is >= load_addr, so we
-      // need to check the last entry on our collection.
-      addr_to_sect_collection::const_reverse_iterator rpos =
-          m_addr_to_sect.rbegin();
-      if (load_addr >= rpos->first) {
-        addr_t offset = load_addr - rpos->first;
-        if (offset <
-            rpos->second->GetByteSize() + (allow_section_end ? 1 : 0)) {
-          // We have found the top level section, now we need to find the
-          // deepest child section.
-          return rpos->second->ResolveContainedAddress(offset, so_addr,
-                                                       allow_section_end);
-        }
+  SnapshotSP snapshot = GetSnapshot();
+  const size_t num_sections = snapshot->load_addrs.size();
+  if (num_sections) {
+    // Find the last top level section that starts at or before load_addr.
+    // Halving the range without branching on the comparison keeps the search
+    // free of mispredictions.
+    const addr_t *first = snapshot->load_addrs.data();
+    for (size_t count = num_sections; count > 1;) {
+      const size_t half = count / 2;
+      first = first[half] <= load_addr ? first + half : first;
+      count -= half;
+    }
+    if (load_addr >= *first) {
+      const SectionSP &section_sp =
+          snapshot->sections[first - snapshot->load_addrs.data()];
+      addr_t offset = load_addr - *first;
+      if (offset < section_sp->GetByteSize() + (allow_section_end ? 1 : 0)) {
+        // We have found the top level section, now we need to find the
+        // deepest child section.
+        return section_sp->ResolveContainedAddress(offset, so_addr,
+                                                   allow_section_end);
       }
     }
   }
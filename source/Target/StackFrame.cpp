@@ -1157,20 +1157,13 @@ StackFrame::GetValueObjectForFrameVariable(const VariableSP &variable_sp,
   if (IsHistorical()) {
     return valobj_sp;
   }
-  VariableList *var_list = GetVariableList(true);
-  if (var_list) {
-    // Make sure the variable is a frame variable
-    const uint32_t var_idx = var_list->FindIndexForVariable(variable_sp.get());
-    const uint32_t num_variables = var_list->GetSize();
-    if (var_idx < num_variables) {
-      valobj_sp = m_variable_list_value_objects.GetValueObjectAtIndex(var_idx);
-      if (!valobj_sp) {
-        if (m_variable_list_value_objects.GetSize() < num_variables)
-          m_variable_list_value_objects.Resize(num_variables);
-        valobj_sp = ValueObjectVariable::Create(this, variable_sp);
-        m_variable_list_value_objects.SetValueObjectAtIndex(var_idx, valobj_sp);
-      }
-    }
+  // Make sure the variable is a frame variable
+  if (variable_sp && IsFrameVariable(*variable_sp)) {
+    ValueObjectSP &cached_valobj_sp =
+        m_variable_list_value_objects[variable_sp.get()];
+    if (!cached_valobj_sp)
+      cached_valobj_sp = ValueObjectVariable::Create(this, variable_sp);
+    valobj_sp = cached_valobj_sp;
   }
   if (use_dynamic != eNoDynamicValues && valobj_sp) {
     ValueObjectSP dynamic_sp = valobj_sp->GetDynamicValue(use_dynamic);
@@ -1180,6 +1173,33 @@ StackFrame::GetValueObjectForFrameVariable(const VariableSP &variable_sp,
   return valobj_sp;
 }
 
+bool StackFrame::IsFrameVariable(Variable &variable) {
+  if (m_variable_list_sp &&
+      m_variable_list_sp->FindIndexForVariable(&variable) != UINT32_MAX)
+    return true;
+
+  SymbolContext variable_sc;
+  variable.CalculateSymbolContext(&variable_sc);
+  if (!variable_sc.block) {
+    // Globals of other compile units are only frame variables once
+    // TrackGlobalVariable added them to the list.
+    if (m_flags.IsClear(eSymbolContextCompUnit))
+      GetSymbolContext(eSymbolContextCompUnit);
+    return variable_sc.comp_unit && variable_sc.comp_unit == m_sc.comp_unit &&
+           GetVariableList(true)->FindIndexForVariable(&variable) !=
+               UINT32_MAX;
+  }
+
+  // The variables of the functions inlined into this frame's block belong to
+  // their own frames.
+  Block *frame_block = GetFrameBlock();
+  Block *block = variable_sc.block;
+  for (; block && block != frame_block; block = block->GetParent())
+    if (block->GetInlinedFunctionInfo())
+      return false;
+  return block && block == frame_block;
+}
+
 ValueObjectSP StackFrame::TrackGlobalVariable(const VariableSP &variable_sp,
                                               DynamicValueType use_dynamic) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
@@ -1858,7 +1878,7 @@ void StackFrame::UpdateCurrentFrameFromPreviousFrame(StackFrame &prev_frame) {
   assert(GetStackID() ==
          prev_frame.GetStackID()); // TODO: remove this after some testing
   m_variable_list_sp = prev_frame.m_variable_list_sp;
-  m_variable_list_value_objects.Swap(prev_frame.m_variable_list_value_objects);
+  m_variable_list_value_objects.swap(prev_frame.m_variable_list_value_objects);
   if (!m_disassembly.GetString().empty()) {
     m_disassembly.Clear();
     m_disassembly.PutCString(prev_frame.m_disassembly.GetString());
@@ -1893,7 +1913,7 @@ void StackFrame::UpdatePreviousFrameFromCurrentFrame(StackFrame &curr_frame) {
 bool StackFrame::HasCachedData() const {
   if (m_variable_list_sp)
     return true;
-  if (m_variable_list_value_objects.GetSize() > 0)
+  if (!m_variable_list_value_objects.empty())
     return true;
   if (!m_disassembly.GetString().empty())
     return true;
@@ -217,6 +217,27 @@ void StackFrameList::SetCurrentInlinedDepth(uint32_t new_depth) {
     m_current_inlined_pc = m_thread.GetRegisterContext()->GetPC();
 }
 
+void StackFrameList::AdoptPreviousFrames() {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  if (!m_prev_frames_sp || !m_frames.empty())
+    return;
+
+  StackFrameListSP prev_frames_sp;
+  prev_frames_sp.swap(m_prev_frames_sp);
+  std::lock_guard<std::recursive_mutex> prev_guard(prev_frames_sp->m_mutex);
+  if (!prev_frames_sp->GetAllFramesFetched())
+    return;
+
+  m_frames = prev_frames_sp->m_frames;
+  m_concrete_frames_fetched = prev_frames_sp->m_concrete_frames_fetched;
+  // The register contexts came from the previous stop's unwind, which the
+  // unwinder has forgotten. They are made again on demand.
+  for (const StackFrameSP &frame_sp : m_frames) {
+    std::lock_guard<std::recursive_mutex> frame_guard(frame_sp->m_mutex);
+    frame_sp->m_reg_context_sp.reset();
+  }
+}
+
 void StackFrameList::GetOnlyConcreteFramesUpTo(uint32_t end_idx,
                                                Unwind *unwinder) {
   assert(m_thread.IsValid() && "Expected valid thread");
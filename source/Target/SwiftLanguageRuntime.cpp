@@ -12,8 +12,11 @@
 
 #include "lldb/Target/SwiftLanguageRuntime.h"
 
+#include <chrono>
+#include <map>
 #include <string.h>
 
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "clang/AST/ASTContext.h"
@@ -76,6 +79,7 @@
 
 #include "lldb/Utility/CleanUp.h"
 #include "lldb/Utility/DataBuffer.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/LLDBAssert.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/StringLexer.h"
@@ -257,6 +261,11 @@ void SwiftLanguageRuntime::SetupABIBit() {
 }
 
 void SwiftLanguageRuntime::ModulesDidLoad(const ModuleList &module_list) {
+  // New images can provide metadata for types that failed to resolve, or
+  // replace types.
+  m_metadata_type_cache.clear();
+  m_type_info_cache.clear();
+
   module_list.ForEach([&](const ModuleSP &module_sp) -> bool {
   auto *obj_file = module_sp->GetObjectFile();
     if (!obj_file)
@@ -722,6 +731,14 @@ static bool ParseGlobal(const swift::Demangle::NodePointer &node,
 
 bool SwiftLanguageRuntime::MethodName::ExtractFunctionBasenameFromMangled(
     ConstString mangled, ConstString &basename, bool &is_method) {
+  swift::Demangle::Context demangle_ctx;
+  return ExtractFunctionBasenameFromMangled(mangled, basename, is_method,
+                                            demangle_ctx);
+}
+
+bool SwiftLanguageRuntime::MethodName::ExtractFunctionBasenameFromMangled(
+    ConstString mangled, ConstString &basename, bool &is_method,
+    swift::Demangle::Context &demangle_ctx) {
   bool success = false;
   swift::Demangle::Node::Kind kind = swift::Demangle::Node::Kind::Global;
   swift::Demangle::Node::Kind parent_kind = swift::Demangle::Node::Kind::Global;
@@ -737,7 +754,6 @@ bool SwiftLanguageRuntime::MethodName::ExtractFunctionBasenameFromMangled(
       // have to demangle the whole name to figure this out anyway.
       // I'm leaving the test here in case we actually need to do this
       // only to functions.
-      swift::Demangle::Context demangle_ctx;
       swift::Demangle::NodePointer node =
           demangle_ctx.demangleSymbolAsNode(mangled_ref);
       StreamString identifier;
@@ -755,6 +771,8 @@ bool SwiftLanguageRuntime::MethodName::ExtractFunctionBasenameFromMangled(
           basename = ConstString(identifier.GetString());
         }
       }
+      // Free the nodes, but keep the memory for the next name.
+      demangle_ctx.clear();
     }
   }
   if (success) {
@@ -1040,6 +1058,9 @@ public:
       }
     }
 
+    if (readPrefetched(address.getAddressData(), dest, size))
+      return true;
+
     Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_TYPES));
 
     if (log)
@@ -1124,12 +1145,69 @@ public:
     m_local_buffer_size = 0;
   }
 
+  /// Read all of \a ranges that weren't prefetched yet with as few requests
+  /// as the process allows, and serve reads inside them from memory until
+  /// the process stops again.
+  void prefetch(llvm::ArrayRef<Process::MemoryRange> ranges) {
+    std::vector<Process::MemoryRange> missing;
+    size_t total_size = 0;
+    for (const Process::MemoryRange &range : ranges) {
+      if (range.GetByteSize() == 0 ||
+          readPrefetched(range.GetRangeBase(), nullptr, range.GetByteSize()))
+        continue;
+      missing.push_back(range);
+      total_size += range.GetByteSize();
+    }
+    if (missing.empty())
+      return;
+
+    std::vector<uint8_t> buffer(total_size);
+    std::vector<size_t> bytes_read =
+        m_process->ReadMemoryRanges(missing, buffer.data());
+    size_t offset = 0;
+    for (size_t i = 0; i < missing.size(); ++i) {
+      if (bytes_read[i])
+        m_prefetched[missing[i].GetRangeBase()].assign(
+            buffer.begin() + offset, buffer.begin() + offset + bytes_read[i]);
+      offset += missing[i].GetByteSize();
+    }
+
+    Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_TYPES));
+    if (log)
+      log->Printf("[MemoryReader] prefetched %zu ranges, %zu bytes",
+                  missing.size(), total_size);
+  }
+
+  /// Copy \a size bytes at \a addr into \a dest if they were prefetched
+  /// since the process last stopped. \a dest may be null to only check.
+  bool readPrefetched(uint64_t addr, uint8_t *dest, uint64_t size) {
+    const uint32_t stop_id = m_process->GetStopID();
+    if (stop_id != m_prefetch_stop_id) {
+      m_prefetched.clear();
+      m_prefetch_stop_id = stop_id;
+      return false;
+    }
+    auto it = m_prefetched.upper_bound(addr);
+    if (it == m_prefetched.begin())
+      return false;
+    --it;
+    if (addr + size > it->first + it->second.size())
+      return false;
+    if (dest)
+      memcpy(dest, it->second.data() + (addr - it->first), size);
+    return true;
+  }
+
 private:
   Process *m_process;
   size_t m_max_read_amount;
 
   uint64_t m_local_buffer = 0;
   uint64_t m_local_buffer_size = 0;
+
+  /// Prefetched memory by start address, valid for m_prefetch_stop_id.
+  std::map<uint64_t, std::vector<uint8_t>> m_prefetched;
+  uint32_t m_prefetch_stop_id = UINT32_MAX;
 };
 
 std::shared_ptr<swift::remote::MemoryReader>
@@ -1150,6 +1228,63 @@ void SwiftLanguageRuntime::PopLocalBuffer() {
   ((LLDBMemoryReader *)GetMemoryReader().get())->popLocalBuffer();
 }
 
+void SwiftLanguageRuntime::PrefetchMetadata(
+    llvm::ArrayRef<lldb::addr_t> metadata_locations) {
+  auto *reader = (LLDBMemoryReader *)GetMemoryReader().get();
+  const size_t ptr_size = m_process->GetAddressByteSize();
+  const lldb::ByteOrder byte_order = m_process->GetByteOrder();
+
+  auto read_pointer = [&](lldb::addr_t addr) -> lldb::addr_t {
+    uint8_t bytes[8];
+    if (ptr_size > sizeof(bytes) || !reader->readPrefetched(addr, bytes, ptr_size))
+      return 0;
+    DataExtractor data(bytes, ptr_size, byte_order, ptr_size);
+    lldb::offset_t offset = 0;
+    return data.GetAddress(&offset);
+  };
+
+  // Each level of pointers is read with a single request.
+  std::vector<Process::MemoryRange> ranges;
+  for (lldb::addr_t location : metadata_locations)
+    ranges.emplace_back(location, ptr_size);
+  reader->prefetch(ranges);
+
+  llvm::DenseSet<lldb::addr_t> seen;
+  std::vector<lldb::addr_t> metadata;
+  for (lldb::addr_t location : metadata_locations) {
+    lldb::addr_t metadata_ptr = read_pointer(location);
+    if (metadata_ptr && seen.insert(metadata_ptr).second)
+      metadata.push_back(metadata_ptr);
+  }
+
+  // The nominal type descriptor of class metadata comes after five pointers
+  // and 24 bytes of sizes and flags. Metadata of other kinds points to its
+  // descriptor right after the kind. Also read the value witness table
+  // pointer in front of the address point.
+  const size_t class_descriptor_offset = 5 * ptr_size + 24;
+  ranges.clear();
+  for (lldb::addr_t metadata_ptr : metadata)
+    ranges.emplace_back(metadata_ptr - ptr_size,
+                        ptr_size + class_descriptor_offset + ptr_size);
+  reader->prefetch(ranges);
+
+  // Kinds beyond the last enumerated kind are isa pointers of classes.
+  const lldb::addr_t last_enumerated_metadata_kind = 0x7ff;
+  const size_t descriptor_size = 48;
+  seen.clear();
+  ranges.clear();
+  for (lldb::addr_t metadata_ptr : metadata) {
+    lldb::addr_t kind = read_pointer(metadata_ptr);
+    lldb::addr_t descriptor =
+        read_pointer(kind > last_enumerated_metadata_kind
+                         ? metadata_ptr + class_descriptor_offset
+                         : metadata_ptr + ptr_size);
+    if (descriptor && seen.insert(descriptor).second)
+      ranges.emplace_back(descriptor, descriptor_size);
+  }
+  reader->prefetch(ranges);
+}
+
 SwiftLanguageRuntime::MetadataPromise::MetadataPromise(
     ValueObject &for_object, SwiftLanguageRuntime &runtime,
     lldb::addr_t location)
@@ -1501,6 +1636,19 @@ bool SwiftLanguageRuntime::GetDynamicTypeAndAddress_Class(
     return false;
   }
 
+  const uint32_t stop_id = m_process->GetStopID();
+  if (stop_id != m_metadata_type_cache_stop_id) {
+    m_metadata_type_cache.clear();
+    m_metadata_type_cache_stop_id = stop_id;
+  }
+  auto cache_key = std::make_pair(scratch_ctx.GetASTContext(),
+                                  metadata_address.getValue().getAddressData());
+  auto cached = m_metadata_type_cache.find(cache_key);
+  if (cached != m_metadata_type_cache.end()) {
+    class_type_or_name.SetCompilerType({&scratch_ctx, cached->second});
+    return true;
+  }
+
   auto instance_type =
       remote_ast.getTypeForRemoteTypeMetadata(metadata_address.getValue(),
                                               /*skipArtificial=*/true);
@@ -1514,6 +1662,7 @@ bool SwiftLanguageRuntime::GetDynamicTypeAndAddress_Class(
   }
 
   // The read lock must have been acquired by the caller.
+  m_metadata_type_cache[cache_key] = instance_type.getValue().getPointer();
   class_type_or_name.SetCompilerType(
       {&scratch_ctx, instance_type.getValue().getPointer()});
   return true;
@@ -2320,15 +2469,30 @@ SwiftLanguageRuntime::GetTypeInfo(CompilerType type) {
   swift::CanType swift_can_type(GetCanonicalSwiftType(type));
   CompilerType can_type(swift_can_type);
   ConstString mangled_name(can_type.GetMangledTypeName());
+  Target &target = m_process->GetTarget();
+  target.IncrementStats(StatisticKind::SwiftTypeInfoLookups);
+  auto cached = m_type_info_cache.find(mangled_name.GetCString());
+  if (cached != m_type_info_cache.end()) {
+    target.IncrementStats(StatisticKind::SwiftTypeInfoCacheHits);
+    return cached->second;
+  }
+
+  auto start = std::chrono::steady_clock::now();
   StringRef mangled_no_prefix =
       swift::Demangle::dropSwiftManglingPrefix(mangled_name.GetStringRef());
   swift::Demangle::Demangler Dem;
   auto demangled = Dem.demangleType(mangled_no_prefix);
-  auto *type_ref = swift::Demangle::decodeMangledType(
-      reflection_ctx->getBuilder(), demangled);
-  if (!type_ref)
-    return nullptr;
-  return reflection_ctx->getBuilder().getTypeConverter().getTypeInfo(type_ref);
+  const swift::reflection::TypeInfo *type_info = nullptr;
+  if (auto *type_ref = swift::Demangle::decodeMangledType(
+          reflection_ctx->getBuilder(), demangled))
+    type_info =
+        reflection_ctx->getBuilder().getTypeConverter().getTypeInfo(type_ref);
+  m_type_info_cache[mangled_name.GetCString()] = type_info;
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  target.AddToStats(StatisticKind::SwiftTypeInfoMicroseconds,
+                    elapsed.count());
+  return type_info;
 }
 
 bool SwiftLanguageRuntime::IsStoredInlineInBuffer(CompilerType type) {
@@ -3354,6 +3518,29 @@ ConstString SwiftLanguageRuntime::GetErrorBackstopName() {
   return ConstString("swift_errorInMain");
 }
 
+lldb::BreakpointSP SwiftLanguageRuntime::GetErrorBackstopBreakpoint() {
+  if (m_error_backstop_bp_sp)
+    return m_error_backstop_bp_sp;
+
+  ConstString backstop_name = GetErrorBackstopName();
+  if (backstop_name.IsEmpty())
+    return lldb::BreakpointSP();
+  FileSpecList stdlib_module_list;
+  stdlib_module_list.Append(FileSpec(GetStandardLibraryName().AsCString()));
+  const LazyBool skip_prologue = eLazyBoolNo;
+  const bool is_internal = true;
+  const bool is_hardware = false;
+  m_error_backstop_bp_sp = m_process->GetTarget().CreateBreakpoint(
+      &stdlib_module_list, nullptr, backstop_name.AsCString(),
+      eFunctionNameTypeFull, eLanguageTypeUnknown, 0, skip_prologue,
+      is_internal, is_hardware);
+  if (m_error_backstop_bp_sp) {
+    m_error_backstop_bp_sp->SetBreakpointKind("Swift error backstop");
+    m_error_backstop_bp_sp->SetEnabled(false);
+  }
+  return m_error_backstop_bp_sp;
+}
+
 ConstString SwiftLanguageRuntime::GetStandardLibraryBaseName() {
   static ConstString g_swiftCore("swiftCore");
   return g_swiftCore;
@@ -32,6 +32,7 @@
 #include "lldb/Expression/UserExpression.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/PosixApi.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Interpreter/CommandReturnObject.h"
 #include "lldb/Interpreter/OptionGroupWatchpoint.h"
@@ -39,11 +40,13 @@
 #include "lldb/Interpreter/Property.h"
 #include "lldb/Symbol/ClangASTContext.h"
 #include "lldb/Symbol/ClangASTImporter.h"
+#include "lldb/Symbol/DWARFCallFrameInfo.h"
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/SymbolFile.h"
 #include "lldb/Symbol/SymbolVendor.h"
+#include "lldb/Symbol/UnwindTable.h"
 #include "lldb/Target/Language.h"
 #include "lldb/Target/LanguageRuntime.h"
 #include "lldb/Target/Process.h"
@@ -62,6 +65,7 @@
 
 #include "llvm/ADT/ScopeExit.h"
 
+#include <map>
 #include <memory>
 #include <mutex>
 
@@ -1625,34 +1629,113 @@ void Target::ModulesDidLoad(ModuleList &module_list) {
       ModuleSP module_sp(module_list.GetModuleAtIndex(idx));
       LoadScriptingResourceForModule(module_sp, this);
     }
-    m_breakpoint_list.UpdateBreakpoints(module_list, true, false);
-    m_internal_breakpoint_list.UpdateBreakpoints(module_list, true, false);
-    if (m_process_sp) {
+    {
+      // Insert the sites of all breakpoints in the new modules together.
+      Process::BreakpointSiteBatch batch(m_process_sp);
+      m_breakpoint_list.UpdateBreakpoints(module_list, true, false);
+      m_internal_breakpoint_list.UpdateBreakpoints(module_list, true, false);
+    }
+    if (m_process_sp)
       m_process_sp->ModulesDidLoad(module_list);
+    module_list.ClearModuleDependentCaches();
+
+    // The rest can wait, so that a burst of notifications, like the ones for
+    // the hundreds of images an app loads at launch, is handled once.
+    const uint64_t window_ms = GetModuleLoadBatchWindow();
+    if (window_ms == 0) {
+      NotifyModulesLoaded(module_list);
+      return;
     }
+    const auto now = std::chrono::steady_clock::now();
+    bool flush;
+    {
+      std::lock_guard<std::mutex> guard(m_pending_loaded_modules_mutex);
+      if (m_pending_loaded_modules.GetSize() == 0)
+        m_pending_loaded_modules_time = now;
+      m_pending_loaded_modules.AppendIfNeeded(module_list);
+      flush = now - m_pending_loaded_modules_time >=
+              std::chrono::milliseconds(window_ms);
+    }
+    if (flush)
+      FlushPendingModuleLoads();
+  }
+}
 
-    // Notify all the ASTContext(s).
-    auto notify_callback = [&](TypeSystem *type_system) {
-      auto *swift_ast_ctx =
-          llvm::dyn_cast_or_null<SwiftASTContext>(type_system);
-      if (!swift_ast_ctx)
-        return true;
-      swift_ast_ctx->ModulesDidLoad(module_list);
-      return true;
-    };
-    m_scratch_type_system_map.ForEach(notify_callback);
-
-    // This is a DenseMap, but we're fine iterating over it because
-    // it doens't matter in which order we notify the ASTContext(s).
-    for (auto &language : m_scratch_typesystem_for_module) {
-      TypeSystemSP type_system = language.second;
-      notify_callback(type_system.get());
+void Target::FlushPendingModuleLoads() {
+  ModuleList module_list;
+  {
+    std::lock_guard<std::mutex> guard(m_pending_loaded_modules_mutex);
+    if (m_pending_loaded_modules.GetSize() == 0)
+      return;
+    module_list.Append(m_pending_loaded_modules);
+    m_pending_loaded_modules.Clear();
+  }
+  if (m_valid)
+    NotifyModulesLoaded(module_list);
+}
+
+void Target::NotifyModulesLoaded(ModuleList &module_list) {
+  const size_t num_images = module_list.GetSize();
+  if (m_process_sp) {
+    // Modules without an .eh_frame_hdr lookup table need their whole
+    // .eh_frame scanned before the first unwind through them.  Do that in
+    // the background now rather than at the first stop.
+    for (size_t idx = 0; idx < num_images; ++idx) {
+      ModuleSP module_sp(module_list.GetModuleAtIndex(idx));
+      if (!module_sp)
+        continue;
+      DWARFCallFrameInfo *eh_frame =
+          module_sp->GetUnwindTable().GetEHFrameInfo();
+      if (!eh_frame || eh_frame->HasLookupTable())
+        continue;
+      TaskPool::AddTask([module_sp]() {
+        if (DWARFCallFrameInfo *eh_frame =
+                module_sp->GetUnwindTable().GetEHFrameInfo())
+          eh_frame->BuildFDEIndex();
+      });
     }
+  }
 
-    module_list.ClearModuleDependentCaches();
-    BroadcastEvent(eBroadcastBitModulesLoaded,
-                   new TargetEventData(this->shared_from_this(), module_list));
+  // Creating a Swift AST context imports all the Swift and Clang modules
+  // its module depends on, which can take seconds. Do that for all of the
+  // new modules at once, rather than one after the other the first time a
+  // backtrace shows variables from each of them.
+  if (GetSwiftCreateModuleContextsOnLoad()) {
+    for (size_t idx = 0; idx < num_images; ++idx) {
+      ModuleWP module_wp(module_list.GetModuleAtIndex(idx));
+      TaskPool::AddLowPriorityTask([module_wp]() {
+        ModuleSP module_sp = module_wp.lock();
+        // Skip images without a serialized Swift AST.
+        if (!module_sp || module_sp->GetASTData(eLanguageTypeSwift).empty())
+          return;
+        auto type_system_or_err =
+            module_sp->GetTypeSystemForLanguage(eLanguageTypeSwift);
+        if (!type_system_or_err)
+          llvm::consumeError(type_system_or_err.takeError());
+      });
+    }
+  }
+
+  // Notify all the ASTContext(s).
+  auto notify_callback = [&](TypeSystem *type_system) {
+    auto *swift_ast_ctx =
+        llvm::dyn_cast_or_null<SwiftASTContext>(type_system);
+    if (!swift_ast_ctx)
+      return true;
+    swift_ast_ctx->ModulesDidLoad(module_list);
+    return true;
+  };
+  m_scratch_type_system_map.ForEach(notify_callback);
+
+  // This is a DenseMap, but we're fine iterating over it because
+  // it doens't matter in which order we notify the ASTContext(s).
+  for (auto &language : m_scratch_typesystem_for_module) {
+    TypeSystemSP type_system = language.second;
+    notify_callback(type_system.get());
   }
+
+  BroadcastEvent(eBroadcastBitModulesLoaded,
+                 new TargetEventData(this->shared_from_this(), module_list));
 }
 
 void Target::SymbolsDidLoad(ModuleList &module_list) {
@@ -2106,9 +2189,19 @@ ModuleSP Target::GetOrCreateModule(const ModuleSpec &module_spec, bool notify,
         }
 
         // Preload symbols outside of any lock, so hopefully we can do this for
-        // each library in parallel.
-        if (GetPreloadSymbols())
-          module_sp->PreloadSymbols();
+        // each library in parallel. In the background, Module::PreloadSymbols
+        // holds the module's mutex, so a query that needs this module before
+        // it is done waits for this module only.
+        if (GetPreloadSymbols()) {
+          if (GetPreloadSymbolsInBackground()) {
+            ModuleWP module_wp(module_sp);
+            TaskPool::AddLowPriorityTask([module_wp]() {
+              if (ModuleSP module_sp = module_wp.lock())
+                module_sp->PreloadSymbols();
+            });
+          } else
+            module_sp->PreloadSymbols();
+        }
 
         if (old_module_sp && m_images.GetIndexForModule(old_module_sp.get()) !=
                                  LLDB_INVALID_INDEX32) {
@@ -2598,6 +2691,9 @@ ExpressionResults Target::EvaluateExpression(
   if (expr.empty())
     return execution_results;
 
+  // The expression may use any of the loaded modules.
+  FlushPendingModuleLoads();
+
   // We shouldn't run stop hooks in expressions.
   bool old_suppress_value = m_suppress_stop_hooks;
   m_suppress_stop_hooks = true;
@@ -2953,6 +3049,93 @@ const TargetPropertiesSP &Target::GetGlobalProperties() {
   return *g_settings_sp_ptr;
 }
 
+StructuredData::DictionarySP Target::ReportStatistics() {
+  auto stats_sp = std::make_shared<StructuredData::Dictionary>();
+  uint32_t i = 0;
+  for (uint32_t stat : m_stats_storage)
+    stats_sp->AddIntegerItem(
+        GetStatDescription(static_cast<StatisticKind>(i++)), stat);
+
+  auto modules_sp = std::make_shared<StructuredData::Array>();
+  const ModuleList &images = GetImages();
+  std::lock_guard<std::recursive_mutex> guard(images.GetMutex());
+  for (size_t idx = 0, count = images.GetSize(); idx < count; ++idx) {
+    ModuleSP module_sp = images.GetModuleAtIndexUnlocked(idx);
+    if (!module_sp)
+      continue;
+    auto module_stats_sp = std::make_shared<StructuredData::Dictionary>();
+    module_stats_sp->AddStringItem("path",
+                                   module_sp->GetFileSpec().GetPath());
+    module_stats_sp->AddFloatItem("symtabParseTime",
+                                  module_sp->GetSymtabParseTime().get());
+    // Don't load the debug info just to say nothing was done with it.
+    if (SymbolFile *sym_file = module_sp->GetSymbolFile(false)) {
+      module_stats_sp->AddFloatItem("debugInfoIndexTime",
+                                    sym_file->GetDebugInfoIndexTime());
+      module_stats_sp->AddIntegerItem("debugInfoSize",
+                                      sym_file->GetDebugInfoSize());
+      module_stats_sp->AddIntegerItem("typesCompleted",
+                                      sym_file->GetNumTypesCompleted());
+    }
+    module_stats_sp->AddItem("memory", module_sp->ReportMemoryUsage());
+    modules_sp->AddItem(module_stats_sp);
+  }
+  stats_sp->AddItem("modules", modules_sp);
+
+  if (m_process_sp) {
+    const MemoryCache &cache = m_process_sp->GetMemoryCache();
+    auto cache_sp = std::make_shared<StructuredData::Dictionary>();
+    cache_sp->AddIntegerItem("hits", cache.GetNumHits());
+    cache_sp->AddIntegerItem("misses", cache.GetNumMisses());
+    cache_sp->AddIntegerItem("bytes", cache.GetMemoryUsage());
+    stats_sp->AddItem("memoryCache", cache_sp);
+
+    if (StructuredData::DictionarySP packets_sp =
+            m_process_sp->GetPacketStatistics())
+      stats_sp->AddItem("packets", packets_sp);
+  }
+
+  auto timers_sp = std::make_shared<StructuredData::Dictionary>();
+  for (const Timer::CategoryStats &category : Timer::GetCategoryStats()) {
+    auto category_sp = std::make_shared<StructuredData::Dictionary>();
+    category_sp->AddFloatItem("time", category.nanos / 1e9);
+    category_sp->AddFloatItem("totalTime", category.nanos_total / 1e9);
+    category_sp->AddIntegerItem("count", category.count);
+    timers_sp->AddItem(category.name, category_sp);
+  }
+  stats_sp->AddItem("timers", timers_sp);
+
+  StructuredData::DictionarySP memory_sp = ReportMemoryUsage();
+  memory_sp->AddIntegerItem("stringPool", ConstString::StaticMemorySize());
+  stats_sp->AddItem("memory", memory_sp);
+  return stats_sp;
+}
+
+StructuredData::DictionarySP Target::ReportMemoryUsage() {
+  auto usage_sp = std::make_shared<StructuredData::Dictionary>();
+  uint64_t total = 0;
+
+  std::map<std::string, uint64_t> type_systems;
+  m_scratch_type_system_map.ForEach([&](TypeSystem *type_system) {
+    type_systems[type_system->GetKindName()] += type_system->GetMemoryUsage();
+    return true;
+  });
+  auto type_systems_sp = std::make_shared<StructuredData::Dictionary>();
+  for (const auto &entry : type_systems) {
+    type_systems_sp->AddIntegerItem(entry.first, entry.second);
+    total += entry.second;
+  }
+  usage_sp->AddItem("scratchTypeSystems", type_systems_sp);
+
+  if (m_process_sp) {
+    const size_t memory_cache = m_process_sp->GetMemoryCache().GetMemoryUsage();
+    usage_sp->AddIntegerItem("memoryCache", memory_cache);
+    total += memory_cache;
+  }
+  usage_sp->AddIntegerItem("total", total);
+  return usage_sp;
+}
+
 Status Target::Install(ProcessLaunchInfo *launch_info) {
   Status error;
   PlatformSP platform_sp(GetPlatform());
@@ -3884,6 +4067,66 @@ bool TargetProperties::GetSwiftCreateModuleContextsInParallel() const {
     return true;
 }
 
+bool TargetProperties::GetSwiftCreateModuleContextsOnLoad() const {
+  const Property *exp_property = m_collection_sp->GetPropertyAtIndex(
+      nullptr, false, ePropertyExperimental);
+  OptionValueProperties *exp_values =
+      exp_property->GetValue()->GetAsProperties();
+  if (exp_values)
+    return exp_values->GetPropertyAtIndexAsBoolean(
+        nullptr, ePropertySwiftCreateModuleContextsOnLoad, false);
+  else
+    return false;
+}
+
+bool TargetProperties::GetBatchChildSummaries() const {
+  const Property *exp_property = m_collection_sp->GetPropertyAtIndex(
+      nullptr, false, ePropertyExperimental);
+  OptionValueProperties *exp_values =
+      exp_property->GetValue()->GetAsProperties();
+  if (exp_values)
+    return exp_values->GetPropertyAtIndexAsBoolean(
+        nullptr, ePropertyBatchChildSummaries, false);
+  else
+    return false;
+}
+
+uint64_t TargetProperties::GetModuleLoadBatchWindow() const {
+  const Property *exp_property = m_collection_sp->GetPropertyAtIndex(
+      nullptr, false, ePropertyExperimental);
+  OptionValueProperties *exp_values =
+      exp_property->GetValue()->GetAsProperties();
+  if (exp_values)
+    return exp_values->GetPropertyAtIndexAsUInt64(
+        nullptr, ePropertyModuleLoadBatchWindow, 0);
+  else
+    return 0;
+}
+
+bool TargetProperties::GetSwiftLazyAutoImport() const {
+  const Property *exp_property = m_collection_sp->GetPropertyAtIndex(
+      nullptr, false, ePropertyExperimental);
+  OptionValueProperties *exp_values =
+      exp_property->GetValue()->GetAsProperties();
+  if (exp_values)
+    return exp_values->GetPropertyAtIndexAsBoolean(
+        nullptr, ePropertySwiftLazyAutoImport, false);
+  else
+    return false;
+}
+
+bool TargetProperties::GetSwiftCacheExpressions() const {
+  const Property *exp_property = m_collection_sp->GetPropertyAtIndex(
+      nullptr, false, ePropertyExperimental);
+  OptionValueProperties *exp_values =
+      exp_property->GetValue()->GetAsProperties();
+  if (exp_values)
+    return exp_values->GetPropertyAtIndexAsBoolean(
+        nullptr, ePropertySwiftCacheExpressions, false);
+  else
+    return false;
+}
+
 ArchSpec TargetProperties::GetDefaultArchitecture() const {
   OptionValueArch *value = m_collection_sp->GetPropertyAtIndexAsOptionValueArch(
       nullptr, ePropertyDefaultArch);
@@ -3906,10 +4149,12 @@ bool TargetProperties::GetMoveToNearestCode() const {
 }
 
 lldb::DynamicValueType TargetProperties::GetPreferDynamicValue() const {
-  const uint32_t idx = ePropertyPreferDynamic;
-  return (lldb::DynamicValueType)
-      m_collection_sp->GetPropertyAtIndexAsEnumeration(
-          nullptr, idx, g_target_properties[idx].default_uint_value);
+  return m_prefer_dynamic_value.Get([this] {
+    const uint32_t idx = ePropertyPreferDynamic;
+    return (lldb::DynamicValueType)
+        m_collection_sp->GetPropertyAtIndexAsEnumeration(
+            nullptr, idx, g_target_properties[idx].default_uint_value);
+  });
 }
 
 bool TargetProperties::SetPreferDynamicValue(lldb::DynamicValueType d) {
@@ -3928,6 +4173,12 @@ void TargetProperties::SetPreloadSymbols(bool b) {
   m_collection_sp->SetPropertyAtIndexAsBoolean(nullptr, idx, b);
 }
 
+bool TargetProperties::GetPreloadSymbolsInBackground() const {
+  const uint32_t idx = ePropertyPreloadSymbolsInBackground;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_target_properties[idx].default_uint_value != 0);
+}
+
 bool TargetProperties::GetDisableASLR() const {
   const uint32_t idx = ePropertyDisableASLR;
   return m_collection_sp->GetPropertyAtIndexAsBoolean(
@@ -4137,9 +4388,17 @@ bool TargetProperties::GetEnableSaveObjects() const {
 }
 
 bool TargetProperties::GetEnableSyntheticValue() const {
-  const uint32_t idx = ePropertyEnableSynthetic;
-  return m_collection_sp->GetPropertyAtIndexAsBoolean(
-      nullptr, idx, g_target_properties[idx].default_uint_value != 0);
+  return m_enable_synthetic_value.Get([this] {
+    const uint32_t idx = ePropertyEnableSynthetic;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(
+        nullptr, idx, g_target_properties[idx].default_uint_value != 0);
+  });
+}
+
+uint32_t TargetProperties::GetMaxExpressionResults() const {
+  const uint32_t idx = ePropertyMaxExpressionResults;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_target_properties[idx].default_uint_value);
 }
 
 uint32_t TargetProperties::GetMaxZeroPaddingInFloatFormat() const {
@@ -4149,15 +4408,19 @@ uint32_t TargetProperties::GetMaxZeroPaddingInFloatFormat() const {
 }
 
 uint32_t TargetProperties::GetMaximumNumberOfChildrenToDisplay() const {
-  const uint32_t idx = ePropertyMaxChildrenCount;
-  return m_collection_sp->GetPropertyAtIndexAsSInt64(
-      nullptr, idx, g_target_properties[idx].default_uint_value);
+  return m_max_children_count.Get([this]() -> uint32_t {
+    const uint32_t idx = ePropertyMaxChildrenCount;
+    return m_collection_sp->GetPropertyAtIndexAsSInt64(
+        nullptr, idx, g_target_properties[idx].default_uint_value);
+  });
 }
 
 uint32_t TargetProperties::GetMaximumSizeOfStringSummary() const {
-  const uint32_t idx = ePropertyMaxSummaryLength;
-  return m_collection_sp->GetPropertyAtIndexAsSInt64(
-      nullptr, idx, g_target_properties[idx].default_uint_value);
+  return m_max_summary_length.Get([this]() -> uint32_t {
+    const uint32_t idx = ePropertyMaxSummaryLength;
+    return m_collection_sp->GetPropertyAtIndexAsSInt64(
+        nullptr, idx, g_target_properties[idx].default_uint_value);
+  });
 }
 
 uint32_t TargetProperties::GetMaximumMemReadSize() const {
@@ -4276,6 +4539,12 @@ bool TargetProperties::GetUserSpecifiedTrapHandlerNames(Args &args) const {
   return m_collection_sp->GetPropertyAtIndexAsArgs(nullptr, idx, args);
 }
 
+bool TargetProperties::GetFramePointerUnwind() const {
+  const uint32_t idx = ePropertyFramePointerUnwind;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_target_properties[idx].default_uint_value != 0);
+}
+
 void TargetProperties::SetUserSpecifiedTrapHandlerNames(const Args &args) {
   const uint32_t idx = ePropertyTrapHandlerNames;
   m_collection_sp->SetPropertyAtIndexFromArgs(nullptr, idx, args);
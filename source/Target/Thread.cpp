@@ -135,15 +135,19 @@ bool ThreadProperties::GetTraceEnabledState() const {
 }
 
 bool ThreadProperties::GetStepInAvoidsNoDebug() const {
-  const uint32_t idx = ePropertyStepInAvoidsNoDebug;
-  return m_collection_sp->GetPropertyAtIndexAsBoolean(
-      nullptr, idx, g_thread_properties[idx].default_uint_value != 0);
+  return m_step_in_avoids_no_debug.Get([this] {
+    const uint32_t idx = ePropertyStepInAvoidsNoDebug;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(
+        nullptr, idx, g_thread_properties[idx].default_uint_value != 0);
+  });
 }
 
 bool ThreadProperties::GetStepOutAvoidsNoDebug() const {
-  const uint32_t idx = ePropertyStepOutAvoidsNoDebug;
-  return m_collection_sp->GetPropertyAtIndexAsBoolean(
-      nullptr, idx, g_thread_properties[idx].default_uint_value != 0);
+  return m_step_out_avoids_no_debug.Get([this] {
+    const uint32_t idx = ePropertyStepOutAvoidsNoDebug;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(
+        nullptr, idx, g_thread_properties[idx].default_uint_value != 0);
+  });
 }
 
 uint64_t ThreadProperties::GetMaxBacktraceDepth() const {
@@ -231,6 +235,8 @@ Thread::Thread(Process &process, lldb::tid_t tid, bool use_invalid_index_id)
       m_reg_context_sp(), m_state(eStateUnloaded), m_state_mutex(),
       m_plan_stack(), m_completed_plan_stack(), m_frame_mutex(),
       m_curr_frames_sp(), m_prev_frames_sp(),
+      m_prev_frames_pc(LLDB_INVALID_ADDRESS),
+      m_prev_frames_stack_pointer(LLDB_INVALID_ADDRESS),
       m_resume_signal(LLDB_INVALID_SIGNAL_NUMBER),
       m_resume_state(eStateRunning), m_temporary_resume_state(eStateRunning),
       m_unwinder_up(), m_destroy_called(false),
@@ -607,7 +613,9 @@ void Thread::SetupForResume() {
       const addr_t thread_pc = reg_ctx_sp->GetPC();
       BreakpointSiteSP bp_site_sp =
           GetProcess()->GetBreakpointSiteList().FindByAddress(thread_pc);
-      if (bp_site_sp) {
+      // The process may step the thread over the breakpoint by itself.
+      if (bp_site_sp &&
+          !GetProcess()->StepsOverBreakpointSiteOnResume(bp_site_sp.get())) {
         // Note, don't assume there's a ThreadPlanStepOverBreakpoint, the
         // target may not require anything special to step over a breakpoint.
 
@@ -696,7 +704,22 @@ bool Thread::ShouldResume(StateType resume_state) {
   }
 
   if (need_to_resume) {
+    // A thread that stays suspended has the same stack at the next stop,
+    // remember where it was so GetStackFrameList can reuse the frames.
+    lldb::addr_t pc = LLDB_INVALID_ADDRESS;
+    lldb::addr_t stack_pointer = LLDB_INVALID_ADDRESS;
+    StackFrameListSP curr_frames_sp = m_curr_frames_sp;
+    if (resume_state == eStateSuspended && curr_frames_sp) {
+      if (RegisterContextSP reg_ctx_sp = GetRegisterContext()) {
+        pc = reg_ctx_sp->GetPC(LLDB_INVALID_ADDRESS);
+        stack_pointer = reg_ctx_sp->GetSP(LLDB_INVALID_ADDRESS);
+      }
+    }
     ClearStackFrames();
+    if (curr_frames_sp && m_prev_frames_sp == curr_frames_sp) {
+      m_prev_frames_pc = pc;
+      m_prev_frames_stack_pointer = stack_pointer;
+    }
     // Let Thread subclasses do any special work they need to prior to resuming
     WillResume(resume_state);
   }
@@ -1621,13 +1644,39 @@ void Thread::CalculateExecutionContext(ExecutionContext &exe_ctx) {
 StackFrameListSP Thread::GetStackFrameList() {
   std::lock_guard<std::recursive_mutex> guard(m_frame_mutex);
 
-  if (!m_curr_frames_sp)
+  if (!m_curr_frames_sp) {
     m_curr_frames_sp =
         std::make_shared<StackFrameList>(*this, m_prev_frames_sp, true);
+    if (PreviousFramesAreCurrent())
+      m_curr_frames_sp->AdoptPreviousFrames();
+  }
 
   return m_curr_frames_sp;
 }
 
+bool Thread::PreviousFramesAreCurrent() {
+  if (!m_prev_frames_sp || m_prev_frames_stack_pointer == LLDB_INVALID_ADDRESS)
+    return false;
+  if (GetTemporaryResumeState() != eStateSuspended)
+    return false;
+
+  RegisterContextSP reg_ctx_sp(GetRegisterContext());
+  if (!reg_ctx_sp ||
+      reg_ctx_sp->GetPC(LLDB_INVALID_ADDRESS) != m_prev_frames_pc ||
+      reg_ctx_sp->GetSP(LLDB_INVALID_ADDRESS) != m_prev_frames_stack_pointer)
+    return false;
+
+  StackFrameSP prev_frame_sp =
+      m_prev_frames_sp->GetFrameWithConcreteFrameIndex(0);
+  Unwind *unwinder = GetUnwinder();
+  lldb::addr_t cfa = LLDB_INVALID_ADDRESS;
+  lldb::addr_t pc = LLDB_INVALID_ADDRESS;
+  bool behaves_like_zeroth_frame = true;
+  return prev_frame_sp && unwinder &&
+         unwinder->GetFrameInfoAtIndex(0, cfa, pc, behaves_like_zeroth_frame) &&
+         cfa == prev_frame_sp->GetStackID().GetCallFrameAddress();
+}
+
 void Thread::ClearStackFrames() {
   std::lock_guard<std::recursive_mutex> guard(m_frame_mutex);
 
@@ -1643,6 +1692,8 @@ void Thread::ClearStackFrames() {
   if (m_curr_frames_sp && m_curr_frames_sp->GetAllFramesFetched())
     m_prev_frames_sp.swap(m_curr_frames_sp);
   m_curr_frames_sp.reset();
+  m_prev_frames_pc = LLDB_INVALID_ADDRESS;
+  m_prev_frames_stack_pointer = LLDB_INVALID_ADDRESS;
 
   m_extended_info.reset();
   m_extended_info_fetched = false;
@@ -109,6 +109,7 @@ ThreadPlanCallFunction::ThreadPlanCallFunction(
       m_should_clear_cxx_exception_bp(false),
       m_stop_address(LLDB_INVALID_ADDRESS),
       m_expression_language(options.GetLanguage()), m_hit_error_backstop(false),
+      m_should_disable_error_backstop_bp(false),
       m_return_type(return_type) {
   lldb::addr_t start_load_addr = LLDB_INVALID_ADDRESS;
   lldb::addr_t function_load_addr = LLDB_INVALID_ADDRESS;
@@ -139,7 +140,9 @@ ThreadPlanCallFunction::ThreadPlanCallFunction(
       m_function_sp(0), m_takedown_done(false),
       m_should_clear_objc_exception_bp(false),
       m_should_clear_cxx_exception_bp(false),
-      m_stop_address(LLDB_INVALID_ADDRESS), m_return_type(CompilerType()) {}
+      m_stop_address(LLDB_INVALID_ADDRESS), m_hit_error_backstop(false),
+      m_should_disable_error_backstop_bp(false),
+      m_return_type(CompilerType()) {}
 
 ThreadPlanCallFunction::~ThreadPlanCallFunction() {
   DoTakedown(PlanSucceeded());
@@ -426,18 +429,11 @@ void ThreadPlanCallFunction::SetBreakpoints() {
       SwiftLanguageRuntime *swift_runtime =
           SwiftLanguageRuntime::Get(*process_sp);
       if (swift_runtime) {
-        ConstString backstop_name = swift_runtime->GetErrorBackstopName();
-        if (!backstop_name.IsEmpty()) {
-          FileSpecList stdlib_module_list;
-          stdlib_module_list.Append(FileSpec(
-              swift_runtime->GetStandardLibraryName().AsCString()));
-          const LazyBool skip_prologue = eLazyBoolNo;
-          const bool is_internal = true;
-          const bool is_hardware = false;
-          m_error_backstop_bp_sp = process_sp->GetTarget().CreateBreakpoint(
-              &stdlib_module_list, NULL, backstop_name.AsCString(),
-              eFunctionNameTypeFull, eLanguageTypeUnknown, 0, skip_prologue,
-              is_internal, is_hardware);
+        m_error_backstop_bp_sp = swift_runtime->GetErrorBackstopBreakpoint();
+        if (m_error_backstop_bp_sp) {
+          m_should_disable_error_backstop_bp =
+              !m_error_backstop_bp_sp->IsEnabled();
+          m_error_backstop_bp_sp->SetEnabled(true);
         }
       }
     }
@@ -451,9 +447,8 @@ void ThreadPlanCallFunction::ClearBreakpoints() {
     if (m_objc_language_runtime && m_should_clear_objc_exception_bp)
       m_objc_language_runtime->ClearExceptionBreakpoints();
   }
-  if (m_error_backstop_bp_sp) {
-    GetTarget().RemoveBreakpointByID(m_error_backstop_bp_sp->GetID());
-  }
+  if (m_error_backstop_bp_sp && m_should_disable_error_backstop_bp)
+    m_error_backstop_bp_sp->SetEnabled(false);
 }
 
 bool ThreadPlanCallFunction::BreakpointsExplainStop() {
@@ -252,14 +252,11 @@ InstructionList *ThreadPlanStepRange::GetInstructionsForAddress(
         return nullptr;
 
       if (!m_instruction_ranges[i]) {
-        // Disassemble the address range given:
-        ExecutionContext exe_ctx(m_thread.GetProcess());
-        const char *plugin_name = nullptr;
-        const char *flavor = nullptr;
-        const bool prefer_file_cache = true;
-        m_instruction_ranges[i] = Disassembler::DisassembleRange(
-            GetTarget().GetArchitecture(), plugin_name, flavor, exe_ctx,
-            m_address_ranges[i], prefer_file_cache);
+        // Disassemble the address range given, or reuse the disassembly from
+        // an earlier step through the same range:
+        m_instruction_ranges[i] =
+            m_thread.GetProcess()->GetStepRangeDisassembly(
+                m_address_ranges[i]);
       }
       if (!m_instruction_ranges[i])
         return nullptr;
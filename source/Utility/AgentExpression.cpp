@@ -0,0 +1,271 @@
+//===-- AgentExpression.cpp -------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/AgentExpression.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+// The stub runs these with the inferior stopped, so keep a bad expression
+// from holding it there for long.
+static const size_t g_max_stack_depth = 64;
+static const size_t g_max_steps = 1024;
+
+void AgentExpression::AppendOperand(uint64_t value, unsigned byte_size) {
+  for (unsigned i = byte_size; i > 0; --i)
+    m_bytes.push_back(static_cast<uint8_t>(value >> (8 * (i - 1))));
+}
+
+void AgentExpression::AppendConstant(uint64_t value) {
+  if (value <= UINT8_MAX) {
+    AppendOpcode(eOpConst8);
+    AppendOperand(value, 1);
+  } else if (value <= UINT16_MAX) {
+    AppendOpcode(eOpConst16);
+    AppendOperand(value, 2);
+  } else if (value <= UINT32_MAX) {
+    AppendOpcode(eOpConst32);
+    AppendOperand(value, 4);
+  } else {
+    AppendOpcode(eOpConst64);
+    AppendOperand(value, 8);
+  }
+}
+
+void AgentExpression::AppendRegister(uint16_t regnum) {
+  AppendOpcode(eOpReg);
+  AppendOperand(regnum, 2);
+}
+
+bool AgentExpression::AppendReference(unsigned byte_size) {
+  switch (byte_size) {
+  case 1:
+    AppendOpcode(eOpRef8);
+    return true;
+  case 2:
+    AppendOpcode(eOpRef16);
+    return true;
+  case 4:
+    AppendOpcode(eOpRef32);
+    return true;
+  case 8:
+    AppendOpcode(eOpRef64);
+    return true;
+  }
+  return false;
+}
+
+void AgentExpression::AppendExtend(uint8_t bits, bool is_signed) {
+  AppendOpcode(is_signed ? eOpExt : eOpZeroExt);
+  m_bytes.push_back(bits);
+}
+
+static uint64_t ExtendValue(uint64_t value, unsigned bits, bool is_signed) {
+  if (bits == 0 || bits >= 64)
+    return value;
+  const uint64_t mask = (1ULL << bits) - 1;
+  value &= mask;
+  if (is_signed && (value & (1ULL << (bits - 1))))
+    value |= ~mask;
+  return value;
+}
+
+bool AgentExpression::Evaluate(Context &context, ByteOrder byte_order,
+                               uint64_t &result) const {
+  std::vector<uint64_t> stack;
+  const size_t size = m_bytes.size();
+  size_t pc = 0;
+
+  auto read_operand = [&](unsigned byte_size, uint64_t &value) {
+    if (pc + byte_size > size)
+      return false;
+    value = 0;
+    for (unsigned i = 0; i < byte_size; ++i)
+      value = (value << 8) | m_bytes[pc++];
+    return true;
+  };
+
+  for (size_t steps = 0; steps < g_max_steps; ++steps) {
+    if (pc >= size)
+      return false;
+    const uint8_t opcode = m_bytes[pc++];
+
+    // Make sure the operands an opcode pops are there before running it.
+    size_t pops = 0;
+    switch (opcode) {
+    case eOpAdd:
+    case eOpSub:
+    case eOpMul:
+    case eOpBitAnd:
+    case eOpBitOr:
+    case eOpBitXor:
+    case eOpEqual:
+    case eOpLessSigned:
+    case eOpLessUnsigned:
+    case eOpSwap:
+      pops = 2;
+      break;
+    case eOpLogNot:
+    case eOpBitNot:
+    case eOpExt:
+    case eOpZeroExt:
+    case eOpRef8:
+    case eOpRef16:
+    case eOpRef32:
+    case eOpRef64:
+    case eOpIfGoto:
+    case eOpEnd:
+    case eOpDup:
+    case eOpPop:
+      pops = 1;
+      break;
+    }
+    if (stack.size() < pops)
+      return false;
+    if (stack.size() >= g_max_stack_depth)
+      return false;
+
+    switch (opcode) {
+    case eOpAdd:
+    case eOpSub:
+    case eOpMul:
+    case eOpBitAnd:
+    case eOpBitOr:
+    case eOpBitXor:
+    case eOpEqual:
+    case eOpLessSigned:
+    case eOpLessUnsigned: {
+      // The operand pushed last is the right hand side.
+      const uint64_t b = stack.back();
+      stack.pop_back();
+      const uint64_t a = stack.back();
+      uint64_t value = 0;
+      switch (opcode) {
+      case eOpAdd:
+        value = a + b;
+        break;
+      case eOpSub:
+        value = a - b;
+        break;
+      case eOpMul:
+        value = a * b;
+        break;
+      case eOpBitAnd:
+        value = a & b;
+        break;
+      case eOpBitOr:
+        value = a | b;
+        break;
+      case eOpBitXor:
+        value = a ^ b;
+        break;
+      case eOpEqual:
+        value = a == b;
+        break;
+      case eOpLessSigned:
+        value = static_cast<int64_t>(a) < static_cast<int64_t>(b);
+        break;
+      case eOpLessUnsigned:
+        value = a < b;
+        break;
+      }
+      stack.back() = value;
+      break;
+    }
+
+    case eOpLogNot:
+      stack.back() = stack.back() == 0;
+      break;
+
+    case eOpBitNot:
+      stack.back() = ~stack.back();
+      break;
+
+    case eOpExt:
+    case eOpZeroExt: {
+      uint64_t bits;
+      if (!read_operand(1, bits))
+        return false;
+      stack.back() = ExtendValue(stack.back(), bits, opcode == eOpExt);
+      break;
+    }
+
+    case eOpRef8:
+    case eOpRef16:
+    case eOpRef32:
+    case eOpRef64: {
+      const size_t byte_size = 1u << (opcode - eOpRef8);
+      uint8_t buf[sizeof(uint64_t)];
+      if (!context.ReadMemory(stack.back(), buf, byte_size))
+        return false;
+      uint64_t value = 0;
+      for (size_t i = 0; i < byte_size; ++i) {
+        const size_t idx = byte_order == eByteOrderBig ? i : byte_size - 1 - i;
+        value = (value << 8) | buf[idx];
+      }
+      stack.back() = value;
+      break;
+    }
+
+    case eOpIfGoto:
+    case eOpGoto: {
+      uint64_t target;
+      if (!read_operand(2, target))
+        return false;
+      bool taken = true;
+      if (opcode == eOpIfGoto) {
+        taken = stack.back() != 0;
+        stack.pop_back();
+      }
+      if (taken)
+        pc = target;
+      break;
+    }
+
+    case eOpConst8:
+    case eOpConst16:
+    case eOpConst32:
+    case eOpConst64: {
+      uint64_t value;
+      if (!read_operand(1u << (opcode - eOpConst8), value))
+        return false;
+      stack.push_back(value);
+      break;
+    }
+
+    case eOpReg: {
+      uint64_t regnum;
+      uint64_t value;
+      if (!read_operand(2, regnum) || !context.ReadRegister(regnum, value))
+        return false;
+      stack.push_back(value);
+      break;
+    }
+
+    case eOpEnd:
+      result = stack.back();
+      return true;
+
+    case eOpDup:
+      stack.push_back(stack.back());
+      break;
+
+    case eOpPop:
+      stack.pop_back();
+      break;
+
+    case eOpSwap:
+      std::swap(stack[stack.size() - 1], stack[stack.size() - 2]);
+      break;
+
+    default:
+      return false;
+    }
+  }
+  return false;
+}
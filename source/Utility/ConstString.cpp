@@ -15,11 +15,13 @@
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/DJB.h"
 #include "llvm/Support/FormatProviders.h"
-#include "llvm/Support/RWMutex.h"
 #include "llvm/Support/Threading.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <utility>
 
 #include <inttypes.h>
@@ -28,11 +30,15 @@
 
 using namespace lldb_private;
 
+// The pool is split into 256 sub-pools selected by the hash of the string.
+// Each sub-pool owns its entries and an open addressing table of pointers to
+// them. Entries are never moved or freed and the table is only modified by a
+// thread holding the sub-pool mutex, so looking up a string that is already
+// in the pool is lock free: readers just probe the table and only take the
+// mutex when they have to insert a string.
 class Pool {
 public:
-  typedef const char *StringPoolValueType;
-  typedef llvm::StringMap<StringPoolValueType, llvm::BumpPtrAllocator>
-      StringPool;
+  typedef std::atomic<const char *> StringPoolValueType;
   typedef llvm::StringMapEntry<StringPoolValueType> StringPoolEntryType;
 
   static StringPoolEntryType &
@@ -50,12 +56,10 @@ public:
     return 0;
   }
 
-  StringPoolValueType GetMangledCounterpart(const char *ccstr) const {
-    if (ccstr != nullptr) {
-      const uint8_t h = hash(llvm::StringRef(ccstr));
-      llvm::sys::SmartScopedReader<false> rlock(m_string_pools[h].m_mutex);
-      return GetStringMapEntryFromKeyData(ccstr).getValue();
-    }
+  const char *GetMangledCounterpart(const char *ccstr) const {
+    if (ccstr != nullptr)
+      return GetStringMapEntryFromKeyData(ccstr).getValue().load(
+          std::memory_order_acquire);
     return nullptr;
   }
 
@@ -72,52 +76,26 @@ public:
   }
 
   const char *GetConstCStringWithStringRef(const llvm::StringRef &string_ref) {
-    if (string_ref.data()) {
-      const uint8_t h = hash(string_ref);
-
-      {
-        llvm::sys::SmartScopedReader<false> rlock(m_string_pools[h].m_mutex);
-        auto it = m_string_pools[h].m_string_map.find(string_ref);
-        if (it != m_string_pools[h].m_string_map.end())
-          return it->getKeyData();
-      }
-
-      llvm::sys::SmartScopedWriter<false> wlock(m_string_pools[h].m_mutex);
-      StringPoolEntryType &entry =
-          *m_string_pools[h]
-               .m_string_map.insert(std::make_pair(string_ref, nullptr))
-               .first;
-      return entry.getKeyData();
-    }
+    if (string_ref.data())
+      return GetOrCreateEntry(string_ref).getKeyData();
     return nullptr;
   }
 
   const char *
   GetConstCStringAndSetMangledCounterPart(llvm::StringRef demangled,
                                           const char *mangled_ccstr) {
-    const char *demangled_ccstr = nullptr;
-
-    {
-      const uint8_t h = hash(demangled);
-      llvm::sys::SmartScopedWriter<false> wlock(m_string_pools[h].m_mutex);
-
-      // Make or update string pool entry with the mangled counterpart
-      StringPool &map = m_string_pools[h].m_string_map;
-      StringPoolEntryType &entry = *map.try_emplace(demangled).first;
-
-      entry.second = mangled_ccstr;
+    // Make or update string pool entry with the mangled counterpart
+    StringPoolEntryType &entry = GetOrCreateEntry(demangled);
+    entry.getValue().store(mangled_ccstr, std::memory_order_release);
 
-      // Extract the const version of the demangled_cstr
-      demangled_ccstr = entry.getKeyData();
-    }
+    // Extract the const version of the demangled_cstr
+    const char *demangled_ccstr = entry.getKeyData();
 
-    {
-      // Now assign the demangled const string as the counterpart of the
-      // mangled const string...
-      const uint8_t h = hash(llvm::StringRef(mangled_ccstr));
-      llvm::sys::SmartScopedWriter<false> wlock(m_string_pools[h].m_mutex);
-      GetStringMapEntryFromKeyData(mangled_ccstr).setValue(demangled_ccstr);
-    }
+    // Now assign the demangled const string as the counterpart of the
+    // mangled const string...
+    GetStringMapEntryFromKeyData(mangled_ccstr)
+        .getValue()
+        .store(demangled_ccstr, std::memory_order_release);
 
     // Return the constant demangled C string
     return demangled_ccstr;
@@ -137,24 +115,115 @@ public:
   size_t MemorySize() const {
     size_t mem_size = sizeof(Pool);
     for (const auto &pool : m_string_pools) {
-      llvm::sys::SmartScopedReader<false> rlock(pool.m_mutex);
-      for (const auto &entry : pool.m_string_map)
-        mem_size += sizeof(StringPoolEntryType) + entry.getKey().size();
+      std::lock_guard<std::mutex> guard(pool.m_mutex);
+      const Table &table = *pool.m_table.load(std::memory_order_relaxed);
+      mem_size += table.GetMemorySize();
+      for (size_t i = 0; i <= table.mask; ++i) {
+        if (StringPoolEntryType *entry =
+                table.slots[i].load(std::memory_order_relaxed))
+          mem_size += sizeof(StringPoolEntryType) + entry->getKey().size();
+      }
     }
     return mem_size;
   }
 
 protected:
-  uint8_t hash(const llvm::StringRef &s) const {
-    uint32_t h = llvm::djbHash(s);
-    return ((h >> 24) ^ (h >> 16) ^ (h >> 8) ^ h) & 0xff;
-  }
+  struct Table {
+    explicit Table(size_t capacity)
+        : mask(capacity - 1),
+          slots(new std::atomic<StringPoolEntryType *>[capacity]),
+          hashes(new uint32_t[capacity]) {
+      for (size_t i = 0; i < capacity; ++i)
+        slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    size_t GetMemorySize() const {
+      return sizeof(Table) +
+             (mask + 1) * (sizeof(slots[0]) + sizeof(hashes[0]));
+    }
+
+    // The capacity is a power of two, so this is capacity - 1.
+    const size_t mask;
+    std::unique_ptr<std::atomic<StringPoolEntryType *>[]> slots;
+    // The full hash of the entry in the slot with the same index. It is
+    // written before the slot is published, so readers can compare hashes
+    // before touching the entry and the table can grow without rehashing.
+    std::unique_ptr<uint32_t[]> hashes;
+  };
 
   struct PoolEntry {
-    mutable llvm::sys::SmartRWMutex<false> m_mutex;
-    StringPool m_string_map;
+    PoolEntry() : m_table(new Table(64)), m_num_entries(0) {}
+
+    // Serializes all modifications of this sub-pool.
+    mutable std::mutex m_mutex;
+    llvm::BumpPtrAllocator m_allocator;
+    std::atomic<Table *> m_table;
+    size_t m_num_entries;
   };
 
+  static uint8_t GetPoolIndex(uint32_t h) {
+    return ((h >> 24) ^ (h >> 16) ^ (h >> 8) ^ h) & 0xff;
+  }
+
+  static StringPoolEntryType *Find(const Table &table, llvm::StringRef s,
+                                   uint32_t h) {
+    for (size_t i = h & table.mask;; i = (i + 1) & table.mask) {
+      StringPoolEntryType *entry =
+          table.slots[i].load(std::memory_order_acquire);
+      // Tables are never more than half full, so this terminates.
+      if (!entry)
+        return nullptr;
+      if (table.hashes[i] == h && entry->getKey() == s)
+        return entry;
+    }
+  }
+
+  // Must be called with the mutex of the sub-pool held.
+  static void Insert(Table &table, StringPoolEntryType *entry, uint32_t h) {
+    size_t i = h & table.mask;
+    while (table.slots[i].load(std::memory_order_relaxed))
+      i = (i + 1) & table.mask;
+    table.hashes[i] = h;
+    table.slots[i].store(entry, std::memory_order_release);
+  }
+
+  StringPoolEntryType &GetOrCreateEntry(llvm::StringRef s) {
+    const uint32_t h = llvm::djbHash(s);
+    PoolEntry &pool = m_string_pools[GetPoolIndex(h)];
+
+    if (StringPoolEntryType *entry =
+            Find(*pool.m_table.load(std::memory_order_acquire), s, h))
+      return *entry;
+
+    std::lock_guard<std::mutex> guard(pool.m_mutex);
+    Table *table = pool.m_table.load(std::memory_order_relaxed);
+    // Someone else may have added the string in the meantime.
+    if (StringPoolEntryType *entry = Find(*table, s, h))
+      return *entry;
+
+    StringPoolEntryType *entry =
+        StringPoolEntryType::Create(s, pool.m_allocator, nullptr);
+
+    if ((pool.m_num_entries + 1) * 2 > table->mask + 1) {
+      Table *new_table = new Table((table->mask + 1) * 2);
+      for (size_t i = 0; i <= table->mask; ++i) {
+        if (StringPoolEntryType *old_entry =
+                table->slots[i].load(std::memory_order_relaxed))
+          Insert(*new_table, old_entry, table->hashes[i]);
+      }
+      Insert(*new_table, entry, h);
+      pool.m_table.store(new_table, std::memory_order_release);
+      // Other threads may still be probing the old table, and there is no
+      // way to tell when they are done. The pool lives until the process
+      // exits anyway, and the old tables of a sub-pool take less memory
+      // than its current one.
+    } else {
+      Insert(*table, entry, h);
+    }
+    ++pool.m_num_entries;
+    return *entry;
+  }
+
   std::array<PoolEntry, 256> m_string_pools;
 };
 
@@ -0,0 +1,47 @@
+//===-- ConstStringTable.cpp ------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/ConstStringTable.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/Stream.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+uint32_t ConstStringTable::Add(ConstString str) {
+  auto insert_result = m_ids.try_emplace(str.GetCString(), m_strings.size());
+  if (insert_result.second)
+    m_strings.push_back(str);
+  return insert_result.first->second;
+}
+
+void ConstStringTable::Encode(Stream &s) const {
+  s.PutHex32(m_strings.size());
+  for (ConstString str : m_strings) {
+    llvm::StringRef ref = str.GetStringRef();
+    s.PutRawBytes(ref.data(), ref.size());
+    s.PutHex8(0);
+  }
+}
+
+bool ConstStringTable::Decode(const DataExtractor &data,
+                              lldb::offset_t *offset_ptr) {
+  m_ids.clear();
+  m_strings.clear();
+  if (!data.ValidOffsetForDataOfSize(*offset_ptr, 4))
+    return false;
+  const uint32_t count = data.GetU32(offset_ptr);
+  m_strings.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    const char *cstr = data.GetCStr(offset_ptr);
+    if (!cstr)
+      return false;
+    m_strings.push_back(ConstString(cstr));
+  }
+  return true;
+}
@@ -874,7 +874,7 @@ const char *DataExtractor::PeekCStr(offset_t offset) const {
 // byte.
 //
 // Returned the extracted integer value.
-uint64_t DataExtractor::GetULEB128(offset_t *offset_ptr) const {
+uint64_t DataExtractor::GetULEB128Slow(offset_t *offset_ptr) const {
   const uint8_t *src = PeekData(*offset_ptr, 1);
   if (src == nullptr)
     return 0;
@@ -907,7 +907,7 @@ uint64_t DataExtractor::GetULEB128(offset_t *offset_ptr) const {
 // byte.
 //
 // Returned the extracted integer value.
-int64_t DataExtractor::GetSLEB128(offset_t *offset_ptr) const {
+int64_t DataExtractor::GetSLEB128Slow(offset_t *offset_ptr) const {
   const uint8_t *src = PeekData(*offset_ptr, 1);
   if (src == nullptr)
     return 0;
@@ -947,7 +947,7 @@ int64_t DataExtractor::GetSLEB128(offset_t *offset_ptr) const {
 // extracted byte.
 //
 // Returns the number of bytes consumed during the extraction.
-uint32_t DataExtractor::Skip_LEB128(offset_t *offset_ptr) const {
+uint32_t DataExtractor::Skip_LEB128Slow(offset_t *offset_ptr) const {
   uint32_t bytes_consumed = 0;
   const uint8_t *src = PeekData(*offset_ptr, 1);
   if (src == nullptr)
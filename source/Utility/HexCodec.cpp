@@ -0,0 +1,178 @@
+//===-- HexCodec.cpp --------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/HexCodec.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define LLDB_HEX_CODEC_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define LLDB_HEX_CODEC_NEON 1
+#endif
+
+using namespace lldb_private;
+
+namespace {
+/// The value of each hex digit, -1 for the other characters.
+struct HexDigitTable {
+  int8_t values[256];
+
+  constexpr HexDigitTable() : values() {
+    for (int ch = 0; ch < 256; ++ch)
+      values[ch] = -1;
+    for (int digit = 0; digit < 10; ++digit)
+      values['0' + digit] = digit;
+    for (int digit = 0; digit < 6; ++digit) {
+      values['a' + digit] = 10 + digit;
+      values['A' + digit] = 10 + digit;
+    }
+  }
+};
+
+constexpr HexDigitTable g_hex_digits;
+const char g_hex_chars[] = "0123456789abcdef";
+
+/// The number of bytes the vector loops handle at a time.
+const size_t kBlockSize = 16;
+} // namespace
+
+#if defined(LLDB_HEX_CODEC_SSE2)
+static void EncodeBlock(const uint8_t *src, char *dst) {
+  const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+  const __m128i nibble_mask = _mm_set1_epi8(0x0f);
+  const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble_mask);
+  const __m128i lo = _mm_and_si128(bytes, nibble_mask);
+
+  // '0' + n for the digits, 'a' - 10 + n for the letters.
+  auto to_ascii = [](__m128i nibbles) {
+    const __m128i letters = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+    return _mm_add_epi8(
+        _mm_add_epi8(nibbles, _mm_set1_epi8('0')),
+        _mm_and_si128(letters, _mm_set1_epi8('a' - '0' - 10)));
+  };
+  const __m128i hi_chars = to_ascii(hi);
+  const __m128i lo_chars = to_ascii(lo);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                   _mm_unpacklo_epi8(hi_chars, lo_chars));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + kBlockSize),
+                   _mm_unpackhi_epi8(hi_chars, lo_chars));
+}
+
+/// Convert 16 characters to their values. Returns false if any of them isn't
+/// a hex digit.
+static bool DecodeNibbles(const char *src, __m128i &nibbles) {
+  const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+  // Characters above 0x7f compare as negative and fail both ranges.
+  const __m128i digits =
+      _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                    _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), chars));
+  const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+  const __m128i letters =
+      _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                    _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+  if (_mm_movemask_epi8(_mm_or_si128(digits, letters)) != 0xffff)
+    return false;
+  nibbles = _mm_or_si128(
+      _mm_and_si128(digits, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+      _mm_and_si128(letters, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+  return true;
+}
+
+static bool DecodeBlock(const char *src, uint8_t *dst) {
+  __m128i first, second;
+  if (!DecodeNibbles(src, first) || !DecodeNibbles(src + kBlockSize, second))
+    return false;
+  // Each 16-bit lane holds a high nibble in its low byte and a low nibble in
+  // its high byte. Combine them into the low byte, then narrow.
+  auto combine = [](__m128i nibbles) {
+    return _mm_or_si128(
+        _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00ff)), 4),
+        _mm_srli_epi16(nibbles, 8));
+  };
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                   _mm_packus_epi16(combine(first), combine(second)));
+  return true;
+}
+#elif defined(LLDB_HEX_CODEC_NEON)
+static uint8x16_t ToAscii(uint8x16_t nibbles) {
+  const uint8x16_t letters = vcgtq_u8(nibbles, vdupq_n_u8(9));
+  return vaddq_u8(vaddq_u8(nibbles, vdupq_n_u8('0')),
+                  vandq_u8(letters, vdupq_n_u8('a' - '0' - 10)));
+}
+
+static void EncodeBlock(const uint8_t *src, char *dst) {
+  const uint8x16_t bytes = vld1q_u8(src);
+  uint8x16x2_t chars;
+  chars.val[0] = ToAscii(vshrq_n_u8(bytes, 4));
+  chars.val[1] = ToAscii(vandq_u8(bytes, vdupq_n_u8(0x0f)));
+  vst2q_u8(reinterpret_cast<uint8_t *>(dst), chars);
+}
+
+/// Convert 16 characters to their values. Returns false if any of them isn't
+/// a hex digit.
+static bool DecodeNibbles(uint8x16_t chars, uint8x16_t &nibbles) {
+  const uint8x16_t digit_values = vsubq_u8(chars, vdupq_n_u8('0'));
+  const uint8x16_t digits = vcltq_u8(digit_values, vdupq_n_u8(10));
+  const uint8x16_t letter_values =
+      vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+  const uint8x16_t letters = vcltq_u8(letter_values, vdupq_n_u8(6));
+  if (vminvq_u8(vorrq_u8(digits, letters)) == 0)
+    return false;
+  nibbles = vbslq_u8(digits, digit_values,
+                     vaddq_u8(letter_values, vdupq_n_u8(10)));
+  return true;
+}
+
+static bool DecodeBlock(const char *src, uint8_t *dst) {
+  // Splits the even (high nibble) and odd (low nibble) characters.
+  const uint8x16x2_t chars = vld2q_u8(reinterpret_cast<const uint8_t *>(src));
+  uint8x16_t hi, lo;
+  if (!DecodeNibbles(chars.val[0], hi) || !DecodeNibbles(chars.val[1], lo))
+    return false;
+  vst1q_u8(dst, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+  return true;
+}
+#endif
+
+void lldb_private::EncodeHexBytes(llvm::ArrayRef<uint8_t> src, char *dst) {
+  size_t i = 0;
+#if defined(LLDB_HEX_CODEC_SSE2) || defined(LLDB_HEX_CODEC_NEON)
+  for (; i + kBlockSize <= src.size(); i += kBlockSize)
+    EncodeBlock(src.data() + i, dst + 2 * i);
+#endif
+  for (; i < src.size(); ++i) {
+    dst[2 * i] = g_hex_chars[src[i] >> 4];
+    dst[2 * i + 1] = g_hex_chars[src[i] & 0x0f];
+  }
+}
+
+size_t lldb_private::DecodeHexBytes(llvm::StringRef src,
+                                    llvm::MutableArrayRef<uint8_t> dst) {
+  const size_t size = std::min(src.size() / 2, dst.size());
+  const char *chars = src.data();
+  size_t i = 0;
+#if defined(LLDB_HEX_CODEC_SSE2) || defined(LLDB_HEX_CODEC_NEON)
+  // A block with an invalid character is left to the loop below, which finds
+  // where exactly to stop.
+  for (; i + kBlockSize <= size; i += kBlockSize) {
+    if (!DecodeBlock(chars + 2 * i, dst.data() + i))
+      break;
+  }
+#endif
+  for (; i < size; ++i) {
+    const int hi = g_hex_digits.values[static_cast<uint8_t>(chars[2 * i])];
+    const int lo = g_hex_digits.values[static_cast<uint8_t>(chars[2 * i + 1])];
+    if (hi < 0 || lo < 0)
+      break;
+    dst[i] = static_cast<uint8_t>((hi << 4) | lo);
+  }
+  return i;
+}
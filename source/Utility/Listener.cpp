@@ -68,6 +68,7 @@ void Listener::Clear() {
   m_broadcasters.clear();
 
   std::lock_guard<std::mutex> events_guard(m_events_mutex);
+  MovePendingEvents();
   m_events.clear();
   size_t num_managers = m_broadcaster_managers.size();
 
@@ -174,6 +175,7 @@ void Listener::BroadcasterWillDestruct(Broadcaster *broadcaster) {
   // Scope for "event_locker"
   {
     std::lock_guard<std::mutex> events_guard(m_events_mutex);
+    MovePendingEvents();
     // Remove all events for this broadcaster object.
     event_collection::iterator pos = m_events.begin();
     while (pos != m_events.end()) {
@@ -206,9 +208,32 @@ void Listener::AddEvent(EventSP &event_sp) {
               static_cast<void *>(this), m_name.c_str(),
               static_cast<void *>(event_sp.get()));
 
-  std::lock_guard<std::mutex> guard(m_events_mutex);
-  m_events.push_back(event_sp);
-  m_events_condition.notify_all();
+  PendingEvent *pending = new PendingEvent{event_sp, nullptr};
+  pending->next = m_pending_events.load(std::memory_order_relaxed);
+  while (!m_pending_events.compare_exchange_weak(pending->next, pending))
+    ;
+
+  // A waiter counts itself before it checks for pending events one last
+  // time, so either it sees this event or we see it waiting. Taking the
+  // mutex makes sure it is actually waiting on the condition before we
+  // notify it.
+  if (m_num_waiters.load() > 0) {
+    { std::lock_guard<std::mutex> guard(m_events_mutex); }
+    m_events_condition.notify_all();
+  }
+}
+
+void Listener::MovePendingEvents() {
+  PendingEvent *pending = m_pending_events.exchange(nullptr);
+  // The stack has the newest event on top, so insert each event in front of
+  // the one that came after it.
+  event_collection::iterator pos = m_events.end();
+  while (pending) {
+    pos = m_events.insert(pos, std::move(pending->event_sp));
+    PendingEvent *next = pending->next;
+    delete pending;
+    pending = next;
+  }
 }
 
 class EventBroadcasterMatches {
@@ -272,6 +297,7 @@ bool Listener::FindNextEventInternal(
   // recursive.
   Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EVENTS));
 
+  MovePendingEvents();
   if (m_events.empty())
     return false;
 
@@ -359,11 +385,19 @@ bool Listener::GetEventInternal(
                               true)) {
       return true;
     } else {
+      // Let AddEvent know it has to wake us up, then look again for events
+      // that came in before it could see that.
+      ++m_num_waiters;
+      if (m_pending_events.load() != nullptr) {
+        --m_num_waiters;
+        continue;
+      }
       std::cv_status result = std::cv_status::no_timeout;
       if (!timeout)
         m_events_condition.wait(lock);
       else
         result = m_events_condition.wait_for(lock, *timeout);
+      --m_num_waiters;
 
       if (result == std::cv_status::timeout) {
         log = lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EVENTS);
@@ -0,0 +1,139 @@
+//===-- LogStreams.cpp ------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/LogStreams.h"
+
+#include "llvm/ADT/StringRef.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace lldb_private;
+
+AsyncLogStream::AsyncLogStream(std::shared_ptr<llvm::raw_ostream> stream_sp,
+                               size_t buffer_size, bool drop_when_full)
+    : llvm::raw_ostream(/*unbuffered=*/true), m_stream_sp(std::move(stream_sp)),
+      m_buffer_size(buffer_size), m_drop_when_full(drop_when_full) {
+  m_pending.reserve(m_buffer_size);
+  m_thread = std::thread(&AsyncLogStream::WriteMessages, this);
+}
+
+AsyncLogStream::~AsyncLogStream() {
+  flush();
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_stopping = true;
+  }
+  m_cond.notify_one();
+  m_thread.join();
+}
+
+void AsyncLogStream::Drain() {
+  flush();
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_written_cond.wait(lock,
+                      [this] { return m_pending.empty() && !m_writing; });
+}
+
+void AsyncLogStream::write_impl(const char *ptr, size_t size) {
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_pos += size;
+    if (m_pending.size() + size > m_buffer_size) {
+      if (m_drop_when_full) {
+        m_dropped += size;
+        return;
+      }
+      // A message larger than the whole buffer goes in once it's empty.
+      m_written_cond.wait(lock, [&] {
+        return m_pending.empty() || m_pending.size() + size <= m_buffer_size;
+      });
+    }
+    m_pending.append(ptr, size);
+  }
+  m_cond.notify_one();
+}
+
+void AsyncLogStream::WriteMessages() {
+  // Swap buffers with the loggers, so both keep their capacity and writing
+  // out doesn't hold the lock.
+  std::string messages;
+  messages.reserve(m_buffer_size);
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cond.wait(lock, [this] {
+      return m_stopping || !m_pending.empty() || m_dropped;
+    });
+    if (m_pending.empty() && !m_dropped)
+      return;
+
+    messages.swap(m_pending);
+    const size_t dropped = m_dropped;
+    m_dropped = 0;
+    m_writing = true;
+    lock.unlock();
+    m_written_cond.notify_all();
+
+    *m_stream_sp << messages;
+    if (dropped)
+      *m_stream_sp << "<" << dropped
+                   << " bytes of log messages were dropped>\n";
+    m_stream_sp->flush();
+    messages.clear();
+
+    lock.lock();
+    m_writing = false;
+    m_written_cond.notify_all();
+  }
+}
+
+CircularLogStream::CircularLogStream(size_t buffer_size)
+    : llvm::raw_ostream(/*unbuffered=*/true), m_buffer(buffer_size) {}
+
+void CircularLogStream::write_impl(const char *ptr, size_t size) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_pos += size;
+  const size_t capacity = m_buffer.size();
+  if (capacity == 0)
+    return;
+  // Only the end of a message larger than the buffer can survive.
+  if (size >= capacity) {
+    ptr += size - capacity;
+    size = capacity;
+  }
+  const size_t first = std::min(size, capacity - m_next);
+  ::memcpy(m_buffer.data() + m_next, ptr, first);
+  ::memcpy(m_buffer.data(), ptr + first, size - first);
+  if (m_next + size >= capacity)
+    m_wrapped = true;
+  m_next = (m_next + size) % capacity;
+}
+
+void CircularLogStream::Dump(llvm::raw_ostream &stream) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (!m_wrapped) {
+    stream << llvm::StringRef(m_buffer.data(), m_next);
+    stream.flush();
+    return;
+  }
+
+  llvm::StringRef older(m_buffer.data() + m_next, m_buffer.size() - m_next);
+  llvm::StringRef newer(m_buffer.data(), m_next);
+  // The oldest message was partly overwritten, start at the next one.
+  size_t newline = older.find('\n');
+  if (newline != llvm::StringRef::npos) {
+    older = older.drop_front(newline + 1);
+  } else {
+    older = llvm::StringRef();
+    newline = newer.find('\n');
+    newer = newline == llvm::StringRef::npos ? llvm::StringRef()
+                                             : newer.drop_front(newline + 1);
+  }
+  stream << older << newer;
+  stream.flush();
+}
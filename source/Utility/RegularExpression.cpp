@@ -8,6 +8,7 @@
 
 #include "lldb/Utility/RegularExpression.h"
 
+#include <algorithm>
 #include <string>
 
 using namespace lldb_private;
@@ -15,17 +16,67 @@ using namespace lldb_private;
 RegularExpression::RegularExpression(llvm::StringRef str)
     : m_regex_text(str),
       // m_regex does not reference str anymore after it is constructed.
-      m_regex(llvm::Regex(str)) {}
+      m_regex(llvm::Regex(str)) {
+  ComputeLiteral();
+}
 
 RegularExpression::RegularExpression(const RegularExpression &rhs)
     : RegularExpression(rhs.GetText()) {}
 
+void RegularExpression::ComputeLiteral() {
+  llvm::StringRef text = m_regex_text;
+  m_anchor_start = text.consume_front("^");
+  m_anchor_end = text.consume_back("$");
+  m_is_literal =
+      text.find_first_of(".[]()*+?{}|\\^$") == llvm::StringRef::npos;
+}
+
 bool RegularExpression::Execute(
     llvm::StringRef str,
     llvm::SmallVectorImpl<llvm::StringRef> *matches) const {
   if (!IsValid())
     return false;
-  return m_regex.match(str, matches);
+  if (!m_is_literal)
+    return m_regex.match(str, matches);
+
+  // A plain string matches where it first occurs, the same as the regular
+  // expression would, without the cost of running the matcher.
+  const llvm::StringRef literal =
+      llvm::StringRef(m_regex_text)
+          .drop_front(m_anchor_start ? 1 : 0)
+          .drop_back(m_anchor_end ? 1 : 0);
+  size_t pos;
+  if (m_anchor_start && m_anchor_end)
+    pos = str == literal ? 0 : llvm::StringRef::npos;
+  else if (m_anchor_start)
+    pos = str.startswith(literal) ? 0 : llvm::StringRef::npos;
+  else if (m_anchor_end)
+    pos = str.endswith(literal) ? str.size() - literal.size()
+                                : llvm::StringRef::npos;
+  else
+    pos = str.find(literal);
+  if (pos == llvm::StringRef::npos)
+    return false;
+  if (matches) {
+    matches->clear();
+    matches->push_back(str.substr(pos, literal.size()));
+  }
+  return true;
+}
+
+llvm::StringRef RegularExpression::GetLiteralPrefix() const {
+  llvm::StringRef text = m_regex_text;
+  // Without an anchor a match can start anywhere, and with an alternation
+  // it can start with either alternative.
+  if (!text.consume_front("^") || text.contains('|'))
+    return llvm::StringRef();
+  size_t length = std::min(text.find_first_of(".[]()*+?{}\\^$"), text.size());
+  // These quantifiers allow zero repetitions, so the character before them
+  // doesn't have to be part of the match.
+  if (length > 0 && length < text.size() &&
+      llvm::StringRef("*?{").contains(text[length]))
+    --length;
+  return text.take_front(length);
 }
 
 bool RegularExpression::IsValid() const { return m_regex.isValid(); }
@@ -37,7 +37,6 @@ static Scalar::Type PromoteToMaxType(
                                      // promoted value of rhs (at most one of
                                      // lhs/rhs will get promoted)
 ) {
-  Scalar result;
   // Initialize the promoted values for both the right and left hand side
   // values to be the objects themselves. If no promotion is needed (both right
   // and left have the same type), then the temp_value will not get used.
@@ -69,7 +68,7 @@ static Scalar::Type PromoteToMaxType(
   return Scalar::e_void;
 }
 
-Scalar::Scalar() : m_type(e_void), m_float(static_cast<float>(0)) {}
+Scalar::Scalar() : m_type(e_void), m_float(ZeroFloat()) {}
 
 bool Scalar::GetData(DataExtractor &data, size_t limit_byte_size) const {
   size_t byte_size = GetByteSize();
@@ -308,7 +307,7 @@ const char *Scalar::GetTypeAsCString() const {
 Scalar &Scalar::operator=(const Scalar &rhs) {
   if (this != &rhs) {
     m_type = rhs.m_type;
-    m_integer = llvm::APInt(rhs.m_integer);
+    m_integer = rhs.m_integer;
     m_float = rhs.m_float;
   }
   return *this;
@@ -9,10 +9,13 @@
 #include "lldb/Utility/Stream.h"
 
 #include "lldb/Utility/Endian.h"
+#include "lldb/Utility/HexCodec.h"
 #include "lldb/Utility/VASPrintf.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/LEB128.h"
 
+#include <algorithm>
 #include <string>
 
 #include <inttypes.h>
@@ -414,28 +417,30 @@ size_t Stream::PutBytesAsRawHex8(const void *s, size_t src_len,
     dst_byte_order = m_byte_order;
 
   const uint8_t *src = static_cast<const uint8_t *>(s);
-  bool binary_is_set = m_flags.Test(eBinary);
-  m_flags.Clear(eBinary);
   if (src_byte_order == dst_byte_order) {
-    for (size_t i = 0; i < src_len; ++i)
-      _PutHex8(src[i], false);
+    _PutBytesAsRawHex8(llvm::makeArrayRef(src, src_len));
   } else {
-    for (size_t i = src_len - 1; i < src_len; --i)
-      _PutHex8(src[i], false);
+    llvm::SmallVector<uint8_t, 64> reversed(src, src + src_len);
+    std::reverse(reversed.begin(), reversed.end());
+    _PutBytesAsRawHex8(reversed);
   }
-  if (binary_is_set)
-    m_flags.Set(eBinary);
 
   return *delta;
 }
 
 size_t Stream::PutStringAsRawHex8(llvm::StringRef s) {
   ByteDelta delta(*this);
-  bool binary_is_set = m_flags.Test(eBinary);
-  m_flags.Clear(eBinary);
-  for (char c : s)
-    _PutHex8(c, false);
-  if (binary_is_set)
-    m_flags.Set(eBinary);
+  _PutBytesAsRawHex8(llvm::arrayRefFromStringRef(s));
   return *delta;
 }
+
+void Stream::_PutBytesAsRawHex8(llvm::ArrayRef<uint8_t> bytes) {
+  // Encode in chunks, so that the stream sees a few large writes.
+  char hex[1024];
+  while (!bytes.empty()) {
+    llvm::ArrayRef<uint8_t> chunk = bytes.take_front(sizeof(hex) / 2);
+    EncodeHexBytes(chunk, hex);
+    Write(hex, 2 * chunk.size());
+    bytes = bytes.drop_front(chunk.size());
+  }
+}
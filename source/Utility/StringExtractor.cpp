@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "lldb/Utility/StringExtractor.h"
+#include "lldb/Utility/HexCodec.h"
 
 #include <tuple>
 
@@ -262,10 +263,27 @@ bool StringExtractor::ConsumeFront(const llvm::StringRef &str) {
   return true;
 }
 
+size_t StringExtractor::DecodeHexPairs(llvm::MutableArrayRef<uint8_t> dest) {
+  if (GetBytesLeft() == 0)
+    return 0;
+  const size_t bytes_decoded = lldb_private::DecodeHexBytes(
+      llvm::StringRef(m_packet).substr(m_index), dest);
+  m_index += 2 * bytes_decoded;
+  return bytes_decoded;
+}
+
 size_t StringExtractor::GetHexBytes(llvm::MutableArrayRef<uint8_t> dest,
                                     uint8_t fail_fill_value) {
   size_t bytes_extracted = 0;
   while (!dest.empty() && GetBytesLeft() > 0) {
+    // Decode the run of hex pairs in bulk, and let GetHexU8 deal with
+    // whatever stopped it.
+    const size_t bytes_decoded = DecodeHexPairs(dest);
+    bytes_extracted += bytes_decoded;
+    dest = dest.drop_front(bytes_decoded);
+    if (dest.empty() || GetBytesLeft() == 0)
+      break;
+
     dest[0] = GetHexU8(fail_fill_value);
     if (!IsGood())
       break;
@@ -286,6 +304,12 @@ size_t StringExtractor::GetHexBytes(llvm::MutableArrayRef<uint8_t> dest,
 size_t StringExtractor::GetHexBytesAvail(llvm::MutableArrayRef<uint8_t> dest) {
   size_t bytes_extracted = 0;
   while (!dest.empty()) {
+    const size_t bytes_decoded = DecodeHexPairs(dest);
+    bytes_extracted += bytes_decoded;
+    dest = dest.drop_front(bytes_decoded);
+    if (dest.empty())
+      break;
+
     int decode = DecodeHexU8();
     if (decode == -1)
       break;
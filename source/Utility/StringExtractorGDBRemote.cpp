@@ -90,6 +90,16 @@ StringExtractorGDBRemote::GetServerPacketType() const {
   case 'Q':
 
     switch (packet_cstr[1]) {
+    case 'C':
+      if (PACKET_STARTS_WITH("QClearTracepoint:"))
+        return eServerPacketType_QClearTracepoint;
+      break;
+
+    case 'D':
+      if (PACKET_STARTS_WITH("QDeleteSnapshot:"))
+        return eServerPacketType_QDeleteSnapshot;
+      break;
+
     case 'E':
       if (PACKET_STARTS_WITH("QEnvironment:"))
         return eServerPacketType_QEnvironment;
@@ -97,6 +107,13 @@ StringExtractorGDBRemote::GetServerPacketType() const {
         return eServerPacketType_QEnvironmentHexEncoded;
       if (PACKET_STARTS_WITH("QEnableErrorStrings"))
         return eServerPacketType_QEnableErrorStrings;
+      if (PACKET_STARTS_WITH("QEnableCompression:"))
+        return eServerPacketType_QEnableCompression;
+      break;
+
+    case 'N':
+      if (PACKET_STARTS_WITH("QNonStop:"))
+        return eServerPacketType_QNonStop;
       break;
 
     case 'P':
@@ -109,6 +126,8 @@ StringExtractorGDBRemote::GetServerPacketType() const {
         return eServerPacketType_QStartNoAckMode;
       if (PACKET_STARTS_WITH("QSaveRegisterState"))
         return eServerPacketType_QSaveRegisterState;
+      if (PACKET_MATCHES("QSaveSnapshot"))
+        return eServerPacketType_QSaveSnapshot;
       if (PACKET_STARTS_WITH("QSetDisableASLR:"))
         return eServerPacketType_QSetDisableASLR;
       if (PACKET_STARTS_WITH("QSetDetachOnError:"))
@@ -129,6 +148,10 @@ StringExtractorGDBRemote::GetServerPacketType() const {
         return eServerPacketType_QSetMaxPayloadSize;
       if (PACKET_STARTS_WITH("QSetEnableAsyncProfiling;"))
         return eServerPacketType_QSetEnableAsyncProfiling;
+      if (PACKET_STARTS_WITH("QSetExpeditedStackMemory:"))
+        return eServerPacketType_QSetExpeditedStackMemory;
+      if (PACKET_STARTS_WITH("QSetTracepoint:"))
+        return eServerPacketType_QSetTracepoint;
       if (PACKET_STARTS_WITH("QSyncThreadState:"))
         return eServerPacketType_QSyncThreadState;
       break;
@@ -143,6 +166,8 @@ StringExtractorGDBRemote::GetServerPacketType() const {
     case 'R':
       if (PACKET_STARTS_WITH("QRestoreRegisterState:"))
         return eServerPacketType_QRestoreRegisterState;
+      if (PACKET_STARTS_WITH("QRestoreSnapshot:"))
+        return eServerPacketType_QRestoreSnapshot;
       break;
 
     case 'T':
@@ -250,6 +275,8 @@ StringExtractorGDBRemote::GetServerPacketType() const {
     case 'S':
       if (PACKET_STARTS_WITH("qSpeedTest:"))
         return eServerPacketType_qSpeedTest;
+      if (PACKET_STARTS_WITH("qSearch:memory:"))
+        return eServerPacketType_qSearchMemory;
       if (PACKET_MATCHES("qShlibInfoAddr"))
         return eServerPacketType_qShlibInfoAddr;
       if (PACKET_MATCHES("qStepPacketSupported"))
@@ -296,7 +323,7 @@ StringExtractorGDBRemote::GetServerPacketType() const {
       return eServerPacketType_jModulesInfo;
     if (PACKET_MATCHES("jSignalsInfo"))
       return eServerPacketType_jSignalsInfo;
-    if (PACKET_MATCHES("jThreadsInfo"))
+    if (PACKET_MATCHES("jThreadsInfo") || PACKET_STARTS_WITH("jThreadsInfo:"))
       return eServerPacketType_jThreadsInfo;
     if (PACKET_STARTS_WITH("jTraceBufferRead:"))
       return eServerPacketType_jTraceBufferRead;
@@ -348,6 +375,8 @@ StringExtractorGDBRemote::GetServerPacketType() const {
         return eServerPacketType_vCont;
       if (PACKET_MATCHES("vCont?"))
         return eServerPacketType_vCont_actions;
+      if (PACKET_MATCHES("vStopped"))
+        return eServerPacketType_vStopped;
     }
     break;
   case '_':
@@ -397,6 +426,8 @@ StringExtractorGDBRemote::GetServerPacketType() const {
     return eServerPacketType_m;
 
   case 'M':
+    if (PACKET_STARTS_WITH("MultiMemRead:"))
+      return eServerPacketType_MultiMemRead;
     return eServerPacketType_M;
 
   case 'p':
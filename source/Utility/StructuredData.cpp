@@ -140,7 +140,8 @@ static StructuredData::ObjectSP ParseJSONValue(JSONParser &json_parser) {
   return StructuredData::ObjectSP();
 }
 
-StructuredData::ObjectSP StructuredData::ParseJSON(std::string json_text) {
+StructuredData::ObjectSP
+StructuredData::ParseJSON(llvm::StringRef json_text) {
   JSONParser json_parser(json_text);
   StructuredData::ObjectSP object_sp = ParseJSONValue(json_parser);
   return object_sp;
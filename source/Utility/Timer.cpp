@@ -8,9 +8,16 @@
 #include "lldb/Utility/Timer.h"
 #include "lldb/Utility/Stream.h"
 
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/raw_ostream.h"
+
 #include <algorithm>
+#include <array>
 #include <map>
 #include <mutex>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -25,6 +32,178 @@ using namespace lldb_private;
 namespace {
 typedef std::vector<Timer *> TimerStack;
 static std::atomic<Timer::Category *> g_categories;
+static std::atomic<uint32_t> g_num_categories;
+static std::atomic<bool> g_record_trace_events;
+
+struct CategoryTimes {
+  std::atomic<uint64_t> nanos{0};
+  std::atomic<uint64_t> nanos_total{0};
+  std::atomic<uint64_t> count{0};
+};
+
+/// The times of the categories, indexed by Category::m_index. It grows in
+/// chunks that never move, so that they can be read while the thread that
+/// owns the table adds to it.
+class TimeTable {
+public:
+  static const size_t kChunkSize = 64;
+  static const size_t kMaxChunks = 1024;
+
+  ~TimeTable() {
+    for (auto &chunk : m_chunks)
+      delete chunk.load(std::memory_order_relaxed);
+  }
+
+  /// Only the owner of the table may call this.
+  CategoryTimes *Get(uint32_t index) {
+    const size_t chunk_index = index / kChunkSize;
+    if (chunk_index >= kMaxChunks)
+      return nullptr;
+    Chunk *chunk = m_chunks[chunk_index].load(std::memory_order_relaxed);
+    if (!chunk) {
+      chunk = new Chunk();
+      m_chunks[chunk_index].store(chunk, std::memory_order_release);
+    }
+    return &(*chunk)[index % kChunkSize];
+  }
+
+  const CategoryTimes *Find(uint32_t index) const {
+    const size_t chunk_index = index / kChunkSize;
+    if (chunk_index >= kMaxChunks)
+      return nullptr;
+    const Chunk *chunk =
+        m_chunks[chunk_index].load(std::memory_order_acquire);
+    return chunk ? &(*chunk)[index % kChunkSize] : nullptr;
+  }
+
+private:
+  typedef std::array<CategoryTimes, kChunkSize> Chunk;
+  std::array<std::atomic<Chunk *>, kMaxChunks> m_chunks{};
+};
+
+/// Only the owner writes to the counters, so a relaxed load and store is
+/// enough and avoids a locked instruction.
+void Add(std::atomic<uint64_t> &counter, uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+struct TraceEvent {
+  const char *name;
+  uint64_t tid;
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::duration duration;
+};
+
+class ThreadTimes;
+
+/// The threads that have timed something, along with the times of the
+/// threads that have exited and the times at the last reset.
+struct Registry {
+  std::mutex mutex;
+  std::set<ThreadTimes *> threads;
+  TimeTable retired;
+  TimeTable baseline;
+  std::vector<TraceEvent> retired_events;
+};
+
+Registry &GetRegistry() {
+  // Leaked, so that threads can still exit during and after the destruction
+  // of the globals.
+  static Registry *g_registry = new Registry();
+  return *g_registry;
+}
+
+class ThreadTimes {
+public:
+  ThreadTimes() : m_tid(llvm::get_threadid()) {
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    registry.threads.insert(this);
+  }
+
+  ~ThreadTimes() {
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    const uint32_t num_categories = g_num_categories;
+    for (uint32_t index = 0; index < num_categories; ++index) {
+      const CategoryTimes *times = m_times.Find(index);
+      CategoryTimes *retired = times ? registry.retired.Get(index) : nullptr;
+      if (!retired)
+        continue;
+      Add(retired->nanos, times->nanos);
+      Add(retired->nanos_total, times->nanos_total);
+      Add(retired->count, times->count);
+    }
+    {
+      std::lock_guard<std::mutex> events_guard(m_events_mutex);
+      registry.retired_events.insert(registry.retired_events.end(),
+                                     m_events.begin(), m_events.end());
+    }
+    registry.threads.erase(this);
+  }
+
+  void AddTimes(uint32_t index, uint64_t nanos, uint64_t nanos_total) {
+    CategoryTimes *times = m_times.Get(index);
+    assert(times && "too many timer categories");
+    if (!times)
+      return;
+    Add(times->nanos, nanos);
+    Add(times->nanos_total, nanos_total);
+    Add(times->count, 1);
+  }
+
+  void AddEvent(const char *name, std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::duration duration) {
+    // Only contended while the events are being dumped.
+    std::lock_guard<std::mutex> guard(m_events_mutex);
+    m_events.push_back({name, m_tid, start, duration});
+  }
+
+  const TimeTable &GetTimes() const { return m_times; }
+
+  /// The registry mutex must be held.
+  void TakeEvents(std::vector<TraceEvent> &events) {
+    std::lock_guard<std::mutex> guard(m_events_mutex);
+    events.insert(events.end(), m_events.begin(), m_events.end());
+  }
+
+  void ClearEvents() {
+    std::lock_guard<std::mutex> guard(m_events_mutex);
+    m_events.clear();
+  }
+
+  TimerStack &GetStack() { return m_stack; }
+
+private:
+  const uint64_t m_tid;
+  TimerStack m_stack;
+  TimeTable m_times;
+  std::mutex m_events_mutex;
+  std::vector<TraceEvent> m_events;
+};
+
+/// The times of the category with \a index across all the threads, since
+/// the last reset. The registry mutex must be held.
+Timer::CategoryStats SumCategoryTimes(Registry &registry, uint32_t index) {
+  Timer::CategoryStats stats{nullptr, 0, 0, 0};
+  auto add = [&](const CategoryTimes *times) {
+    if (!times)
+      return;
+    stats.nanos += times->nanos.load(std::memory_order_relaxed);
+    stats.nanos_total += times->nanos_total.load(std::memory_order_relaxed);
+    stats.count += times->count.load(std::memory_order_relaxed);
+  };
+  add(registry.retired.Find(index));
+  for (const ThreadTimes *thread : registry.threads)
+    add(thread->GetTimes().Find(index));
+  if (const CategoryTimes *baseline = registry.baseline.Find(index)) {
+    stats.nanos -= baseline->nanos;
+    stats.nanos_total -= baseline->nanos_total;
+    stats.count -= baseline->count;
+  }
+  return stats;
+}
 } // end of anonymous namespace
 
 std::atomic<bool> Timer::g_quiet(true);
@@ -34,15 +213,13 @@ static std::mutex &GetFileMutex() {
   return *g_file_mutex_ptr;
 }
 
-static TimerStack &GetTimerStackForCurrentThread() {
-  static thread_local TimerStack g_stack;
-  return g_stack;
+static ThreadTimes &GetTimesForCurrentThread() {
+  static thread_local ThreadTimes g_times;
+  return g_times;
 }
 
-Timer::Category::Category(const char *cat) : m_name(cat) {
-  m_nanos.store(0, std::memory_order_release);
-  m_nanos_total.store(0, std::memory_order_release);
-  m_count.store(0, std::memory_order_release);
+Timer::Category::Category(const char *cat)
+    : m_name(cat), m_index(g_num_categories++) {
   Category *expected = g_categories;
   do {
     m_next = expected;
@@ -53,7 +230,7 @@ void Timer::SetQuiet(bool value) { g_quiet = value; }
 
 Timer::Timer(Timer::Category &category, const char *format, ...)
     : m_category(category), m_total_start(std::chrono::steady_clock::now()) {
-  TimerStack &stack = GetTimerStackForCurrentThread();
+  TimerStack &stack = GetTimesForCurrentThread().GetStack();
 
   stack.push_back(this);
   if (g_quiet && stack.size() <= g_display_depth) {
@@ -79,7 +256,8 @@ Timer::~Timer() {
   auto total_dur = stop_time - m_total_start;
   auto timer_dur = total_dur - m_child_duration;
 
-  TimerStack &stack = GetTimerStackForCurrentThread();
+  ThreadTimes &times = GetTimesForCurrentThread();
+  TimerStack &stack = times.GetStack();
   if (g_quiet && stack.size() <= g_display_depth) {
     std::lock_guard<std::mutex> lock(GetFileMutex());
     ::fprintf(stdout, "%*s%.9f sec (%.9f sec)\n",
@@ -94,9 +272,10 @@ Timer::~Timer() {
     stack.back()->ChildDuration(total_dur);
 
   // Keep total results for each category so we can dump results.
-  m_category.m_nanos += std::chrono::nanoseconds(timer_dur).count();
-  m_category.m_nanos_total += std::chrono::nanoseconds(total_dur).count();
-  m_category.m_count++;
+  times.AddTimes(m_category.m_index, nanoseconds(timer_dur).count(),
+                 nanoseconds(total_dur).count());
+  if (g_record_trace_events.load(std::memory_order_relaxed))
+    times.AddEvent(m_category.m_name, m_total_start, total_dur);
 }
 
 void Timer::SetDisplayDepth(uint32_t depth) { g_display_depth = depth; }
@@ -104,49 +283,100 @@ void Timer::SetDisplayDepth(uint32_t depth) { g_display_depth = depth; }
 /* binary function predicate:
  * - returns whether a person is less than another person
  */
-namespace {
-struct Stats {
-  const char *name;
-  uint64_t nanos;
-  uint64_t nanos_total;
-  uint64_t count;
-};
-} // namespace
-
-static bool CategoryMapIteratorSortCriterion(const Stats &lhs,
-                                             const Stats &rhs) {
+static bool CategoryMapIteratorSortCriterion(const Timer::CategoryStats &lhs,
+                                             const Timer::CategoryStats &rhs) {
   return lhs.nanos > rhs.nanos;
 }
 
 void Timer::ResetCategoryTimes() {
+  // The threads own their times, so remember where they are now instead of
+  // clearing them.
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
   for (Category *i = g_categories; i; i = i->m_next) {
-    i->m_nanos.store(0, std::memory_order_release);
-    i->m_nanos_total.store(0, std::memory_order_release);
-    i->m_count.store(0, std::memory_order_release);
+    CategoryTimes *baseline = registry.baseline.Get(i->m_index);
+    if (!baseline)
+      continue;
+    CategoryStats stats = SumCategoryTimes(registry, i->m_index);
+    Add(baseline->nanos, stats.nanos);
+    Add(baseline->nanos_total, stats.nanos_total);
+    Add(baseline->count, stats.count);
   }
 }
 
-void Timer::DumpCategoryTimes(Stream *s) {
-  std::vector<Stats> sorted;
-  for (Category *i = g_categories; i; i = i->m_next) {
-    uint64_t nanos = i->m_nanos.load(std::memory_order_acquire);
-    if (nanos) {
-      uint64_t nanos_total = i->m_nanos_total.load(std::memory_order_acquire);
-      uint64_t count = i->m_count.load(std::memory_order_acquire);
-      Stats stats{i->m_name, nanos, nanos_total, count};
-      sorted.push_back(stats);
+std::vector<Timer::CategoryStats> Timer::GetCategoryStats() {
+  std::vector<CategoryStats> sorted;
+  {
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    for (Category *i = g_categories; i; i = i->m_next) {
+      CategoryStats stats = SumCategoryTimes(registry, i->m_index);
+      if (stats.nanos) {
+        stats.name = i->m_name;
+        sorted.push_back(stats);
+      }
     }
   }
-  if (sorted.empty())
-    return; // Later code will break without any elements.
-
   // Sort by time
   llvm::sort(sorted.begin(), sorted.end(), CategoryMapIteratorSortCriterion);
+  return sorted;
+}
 
-  for (const auto &stats : sorted)
+void Timer::DumpCategoryTimes(Stream *s) {
+  for (const auto &stats : GetCategoryStats())
     s->Printf("%.9f sec (total: %.3fs; child: %.3fs; count: %" PRIu64
               ") for %s\n",
               stats.nanos / 1000000000., stats.nanos_total / 1000000000.,
               (stats.nanos_total - stats.nanos) / 1000000000., stats.count,
               stats.name);
 }
+
+void Timer::SetRecordTraceEvents(bool record) {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  if (record) {
+    registry.retired_events.clear();
+    for (ThreadTimes *thread : registry.threads)
+      thread->ClearEvents();
+  }
+  g_record_trace_events = record;
+}
+
+void Timer::DumpTraceEvents(llvm::raw_ostream &os) {
+  std::vector<TraceEvent> events;
+  {
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    events = registry.retired_events;
+    for (ThreadTimes *thread : registry.threads)
+      thread->TakeEvents(events);
+  }
+  if (events.empty()) {
+    os << "{\"traceEvents\":[]}\n";
+    return;
+  }
+
+  // Timestamps are in microseconds, from the first event.
+  using namespace std::chrono;
+  auto epoch = std::min_element(events.begin(), events.end(),
+                                [](const TraceEvent &lhs,
+                                   const TraceEvent &rhs) {
+                                  return lhs.start < rhs.start;
+                                })
+                   ->start;
+  const int64_t pid = llvm::sys::Process::getProcessId();
+  llvm::json::Array trace_events;
+  for (const TraceEvent &event : events) {
+    trace_events.push_back(llvm::json::Object{
+        {"name", event.name},
+        {"cat", "lldb"},
+        {"ph", "X"},
+        {"ts", duration<double, std::micro>(event.start - epoch).count()},
+        {"dur", duration<double, std::micro>(event.duration).count()},
+        {"pid", pid},
+        {"tid", int64_t(event.tid)}});
+  }
+  os << llvm::json::Value(
+            llvm::json::Object{{"traceEvents", std::move(trace_events)}})
+     << "\n";
+}
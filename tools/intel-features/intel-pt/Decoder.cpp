@@ -9,8 +9,11 @@
 #include "Decoder.h"
 
 // C/C++ Includes
+#include <algorithm>
 #include <cinttypes>
 #include <cstring>
+#include <iterator>
+#include <thread>
 
 #include "lldb/API/SBModule.h"
 #include "lldb/API/SBProcess.h"
@@ -307,23 +310,53 @@ void Decoder::ReadTraceDataAndImageInfo(lldb::SBProcess &sbprocess,
 void Decoder::DecodeProcessorTrace(lldb::SBProcess &sbprocess, lldb::tid_t tid,
                                    lldb::SBError &sberror,
                                    ThreadTraceInfo &threadTraceInfo) {
-  // Initialize instruction decoder
-  struct pt_insn_decoder *decoder = nullptr;
-  struct pt_config config;
   Buffer &pt_buffer = threadTraceInfo.GetPTBuffer();
   CPUInfo &pt_cpu = threadTraceInfo.GetCPUInfo();
   ReadExecuteSectionInfos &readExecuteSectionInfos =
       threadTraceInfo.GetReadExecuteSectionInfos();
 
-  InitializePTInstDecoder(&decoder, &config, pt_cpu, pt_buffer,
-                          readExecuteSectionInfos, sberror);
-  if (!sberror.Success())
-    return;
+  // Decode each segment of the trace on its own thread with its own
+  // instruction decoder
+  std::vector<uint64_t> offsets = GetTraceSegmentOffsets(
+      pt_cpu, pt_buffer, std::max(1u, std::thread::hardware_concurrency()));
+  const size_t num_segments = offsets.size();
+  offsets.push_back(pt_buffer.size());
+
+  std::vector<Instructions> segment_logs(num_segments);
+  std::vector<lldb::SBError> segment_errors(num_segments);
+  auto decode_segment = [&](size_t i) {
+    struct pt_insn_decoder *decoder = nullptr;
+    struct pt_image *image = nullptr;
+    InitializePTInstDecoder(&decoder, &image, pt_cpu,
+                            pt_buffer.data() + offsets[i],
+                            pt_buffer.data() + offsets[i + 1],
+                            readExecuteSectionInfos, segment_errors[i]);
+    if (!segment_errors[i].Success())
+      return;
+
+    // Start raw trace decoding
+    DecodeTrace(decoder, segment_logs[i], segment_errors[i]);
+    pt_insn_free_decoder(decoder);
+    pt_image_free(image);
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_segments; ++i)
+    threads.emplace_back(decode_segment, i);
+  decode_segment(0);
+  for (std::thread &thread : threads)
+    thread.join();
 
-  // Start raw trace decoding
+  // Stitch the segments' instructions together in trace order
   Instructions &instruction_list = threadTraceInfo.GetInstructionLog();
   instruction_list.clear();
-  DecodeTrace(decoder, instruction_list, sberror);
+  for (size_t i = 0; i < num_segments; ++i) {
+    if (!segment_errors[i].Success())
+      sberror = segment_errors[i];
+    instruction_list.insert(instruction_list.end(),
+                            std::make_move_iterator(segment_logs[i].begin()),
+                            std::make_move_iterator(segment_logs[i].end()));
+  }
 }
 
 // Raw trace decoding requires information of Read & Execute sections of each
@@ -506,19 +539,20 @@ void Decoder::ParseCPUInfo(CPUInfo &pt_cpu, lldb::SBStructuredData &s,
 // initialized with trace buffer and cpu info of the inferior before storing it
 // in trace decoder.
 void Decoder::InitializePTInstDecoder(
-    struct pt_insn_decoder **decoder, struct pt_config *config,
-    const CPUInfo &pt_cpu, Buffer &pt_buffer,
+    struct pt_insn_decoder **decoder, struct pt_image **image,
+    const CPUInfo &pt_cpu, uint8_t *begin, uint8_t *end,
     const ReadExecuteSectionInfos &readExecuteSectionInfos,
     lldb::SBError &sberror) const {
-  if (!decoder || !config) {
+  if (!decoder || !image) {
     sberror.SetErrorStringWithFormat("internal error");
     return;
   }
 
   // Load cpu info of inferior's target in pt_config struct
-  pt_config_init(config);
-  config->cpu = pt_cpu;
-  int errcode = pt_cpu_errata(&(config->errata), &(config->cpu));
+  struct pt_config config;
+  pt_config_init(&config);
+  config.cpu = pt_cpu;
+  int errcode = pt_cpu_errata(&(config.errata), &(config.cpu));
   if (errcode < 0) {
     sberror.SetErrorStringWithFormat("processor trace decoding library: "
                                      "pt_cpu_errata() failed with error: "
@@ -528,11 +562,11 @@ void Decoder::InitializePTInstDecoder(
   }
 
   // Load trace buffer's starting and end address in pt_config struct
-  config->begin = pt_buffer.data();
-  config->end = pt_buffer.data() + pt_buffer.size();
+  config.begin = begin;
+  config.end = end;
 
   // Fill trace decoder with pt_config struct
-  *decoder = pt_insn_alloc_decoder(config);
+  *decoder = pt_insn_alloc_decoder(&config);
   if (*decoder == nullptr) {
     sberror.SetErrorStringWithFormat("processor trace decoding library:  "
                                      "pt_insn_alloc_decoder() returned null "
@@ -540,28 +574,79 @@ void Decoder::InitializePTInstDecoder(
     return;
   }
 
-  // Fill trace decoder's image with inferior's memory image information
-  struct pt_image *image = pt_insn_get_image(*decoder);
-  if (!image) {
+  // Fill trace decoder's image with inferior's memory image information. An
+  // image can't be shared by decoders running on different threads, but the
+  // section cache can, so each module's sections are only mapped once.
+  *image = pt_image_alloc(nullptr);
+  if (!*image) {
     sberror.SetErrorStringWithFormat("processor trace decoding library:  "
-                                     "pt_insn_get_image() returned null "
+                                     "pt_image_alloc() returned null "
                                      "pointer");
     pt_insn_free_decoder(*decoder);
     return;
   }
 
   for (auto &itr : readExecuteSectionInfos) {
-    errcode = pt_image_add_file(image, itr.image_path.c_str(), itr.file_offset,
-                                itr.size, nullptr, itr.load_address);
+    int isid = pt_iscache_add_file(m_image_cache, itr.image_path.c_str(),
+                                   itr.file_offset, itr.size,
+                                   itr.load_address);
+    errcode = isid < 0 ? isid
+                       : pt_image_add_cached(*image, m_image_cache, isid,
+                                             nullptr);
     if (errcode < 0) {
       sberror.SetErrorStringWithFormat("processor trace decoding library:  "
-                                       "pt_image_add_file() failed with error: "
-                                       "\"%s\"",
+                                       "adding image section failed with "
+                                       "error: \"%s\"",
                                        pt_errstr(pt_errcode(errcode)));
       pt_insn_free_decoder(*decoder);
+      pt_image_free(*image);
       return;
     }
   }
+
+  errcode = pt_insn_set_image(*decoder, *image);
+  if (errcode < 0) {
+    sberror.SetErrorStringWithFormat("processor trace decoding library:  "
+                                     "pt_insn_set_image() failed with error: "
+                                     "\"%s\"",
+                                     pt_errstr(pt_errcode(errcode)));
+    pt_insn_free_decoder(*decoder);
+    pt_image_free(*image);
+  }
+}
+
+// The trace can only be decoded from a PSB packet on, so it is split at
+// those. Each segment starts at a PSB packet, except the first which starts
+// at the beginning of the trace, and the segments get about the same number
+// of PSB packets.
+std::vector<uint64_t>
+Decoder::GetTraceSegmentOffsets(const CPUInfo &pt_cpu, Buffer &pt_buffer,
+                                size_t max_segments) const {
+  std::vector<uint64_t> psb_offsets;
+  struct pt_config config;
+  pt_config_init(&config);
+  config.cpu = pt_cpu;
+  config.begin = pt_buffer.data();
+  config.end = pt_buffer.data() + pt_buffer.size();
+  if (max_segments > 1) {
+    if (struct pt_packet_decoder *decoder = pt_pkt_alloc_decoder(&config)) {
+      uint64_t offset;
+      while (pt_pkt_sync_forward(decoder) >= 0 &&
+             pt_pkt_get_sync_offset(decoder, &offset) >= 0)
+        psb_offsets.push_back(offset);
+      pt_pkt_free_decoder(decoder);
+    }
+  }
+
+  std::vector<uint64_t> segment_offsets = {0};
+  const size_t psbs_per_segment =
+      (psb_offsets.size() + max_segments - 1) / max_segments;
+  if (psbs_per_segment == 0)
+    return segment_offsets;
+  for (size_t i = psbs_per_segment; i < psb_offsets.size();
+       i += psbs_per_segment)
+    segment_offsets.push_back(psb_offsets[i]);
+  return segment_offsets;
 }
 
 // Start actual decoding of raw trace
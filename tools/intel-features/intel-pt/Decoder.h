@@ -152,9 +152,10 @@ public:
   Decoder(lldb::SBDebugger &sbdebugger)
       : m_mapProcessUID_mapThreadID_TraceInfo_mutex(),
         m_mapProcessUID_mapThreadID_TraceInfo(),
-        m_debugger_user_id(sbdebugger.GetID()) {}
+        m_debugger_user_id(sbdebugger.GetID()),
+        m_image_cache(pt_iscache_alloc(nullptr)) {}
 
-  ~Decoder() {}
+  ~Decoder() { pt_iscache_free(m_image_cache); }
 
   void StartProcessorTrace(lldb::SBProcess &sbprocess,
                            lldb::SBTraceOptions &sbtraceoptions,
@@ -235,12 +236,17 @@ private:
                             lldb::SBError &sberror);
 
   /// Helper functions of DecodeProcessorTrace() function for:
+  ///  - splitting the trace into at most \a max_segments segments that can
+  ///    be decoded independently, returning their starting offsets
   ///  - initializing raw trace decoder (provided by Intel(R) Processor Trace
-  ///    Decoding library)
+  ///    Decoding library) for the trace between \a begin and \a end
   ///  - start trace decoding
+  std::vector<uint64_t> GetTraceSegmentOffsets(const CPUInfo &pt_cpu,
+                                               Buffer &pt_buffer,
+                                               size_t max_segments) const;
   void InitializePTInstDecoder(
-      struct pt_insn_decoder **decoder, struct pt_config *config,
-      const CPUInfo &pt_cpu, Buffer &pt_buffer,
+      struct pt_insn_decoder **decoder, struct pt_image **image,
+      const CPUInfo &pt_cpu, uint8_t *begin, uint8_t *end,
       const ReadExecuteSectionInfos &readExecuteSectionInfos,
       lldb::SBError &sberror) const;
   void DecodeTrace(struct pt_insn_decoder *decoder,
@@ -303,6 +309,9 @@ private:
                                              // threads
   lldb::user_id_t m_debugger_user_id; // SBDebugger instance which is associated
                                       // to this Decoder instance
+  struct pt_image_section_cache
+      *m_image_cache; // sections of the inferior's modules, mapped once and
+                      // shared by all the trace decoders
 };
 
 } // namespace ptdecoder_private
@@ -37,6 +37,7 @@
 
 #if defined(__linux__)
 #include "Plugins/Process/Linux/NativeProcessLinux.h"
+#include "lldb/Host/linux/ConnectionSharedMemory.h"
 #elif defined(__NetBSD__)
 #include "Plugins/Process/NetBSD/NativeProcessNetBSD.h"
 #elif defined(_WIN32)
@@ -106,6 +107,9 @@ static struct option g_long_options[] = {
     {"setsid", no_argument, nullptr,
      'S'}, // Call setsid() to make llgs run in its own session.
     {"fd", required_argument, nullptr, 'F'},
+    {"shm-fd", required_argument, nullptr,
+     'M'}, // Memory shared with the client that the packets go through, with
+           // --fd used only to wake up the other end.
     {nullptr, 0, nullptr, 0}};
 
 // Watch for signals
@@ -130,6 +134,7 @@ static void display_usage(const char *progname, const char *subcommand) {
                   "[--log-channels log-channel-list] "
                   "[--setsid] "
                   "[--fd file-descriptor]"
+                  "[--shm-fd file-descriptor] "
                   "[--named-pipe named-pipe-path] "
                   "[--native-regs] "
                   "[--attach pid] "
@@ -227,7 +232,7 @@ void ConnectToRemote(MainLoop &mainloop,
                      bool reverse_connect, const char *const host_and_port,
                      const char *const progname, const char *const subcommand,
                      const char *const named_pipe_path, pipe_t unnamed_pipe,
-                     int connection_fd) {
+                     int connection_fd, int shm_fd) {
   Status error;
 
   std::unique_ptr<Connection> connection_up;
@@ -253,6 +258,17 @@ void ConnectToRemote(MainLoop &mainloop,
               connection_url, error.AsCString());
       exit(-1);
     }
+#if defined(__linux__)
+    if (shm_fd != -1) {
+      connection_up.reset(
+          new ConnectionSharedMemory(std::move(connection_up), shm_fd, false));
+      if (!connection_up->IsConnected()) {
+        fprintf(stderr, "error: failed to map the memory shared with the "
+                        "client\n");
+        exit(-1);
+      }
+    }
+#endif
   } else if (host_and_port && host_and_port[0]) {
     // Parse out host and port.
     std::string final_host_and_port;
@@ -380,6 +396,7 @@ int main_gdbserver(int argc, char *argv[]) {
   lldb::pipe_t unnamed_pipe = LLDB_INVALID_PIPE;
   bool reverse_connect = false;
   int connection_fd = -1;
+  int shm_fd = -1;
 
   // ProcessLaunchInfo launch_info;
   ProcessAttachInfo attach_info;
@@ -433,6 +450,10 @@ int main_gdbserver(int argc, char *argv[]) {
       connection_fd = StringConvert::ToUInt32(optarg, -1);
       break;
 
+    case 'M':
+      shm_fd = StringConvert::ToUInt32(optarg, -1);
+      break;
+
 #ifndef _WIN32
     case 'S':
       // Put llgs into a new session. Terminals group processes
@@ -522,7 +543,7 @@ int main_gdbserver(int argc, char *argv[]) {
 
   ConnectToRemote(mainloop, gdb_server, reverse_connect, host_and_port,
                   progname, subcommand, named_pipe_path.c_str(), 
-                  unnamed_pipe, connection_fd);
+                  unnamed_pipe, connection_fd, shm_fd);
 
   if (!gdb_server.IsConnected()) {
     fprintf(stderr, "no connection information provided, unable to run\n");
@@ -57,6 +57,7 @@ static struct option g_long_options[] = {
     {"min-gdbserver-port", required_argument, nullptr, 'm'},
     {"max-gdbserver-port", required_argument, nullptr, 'M'},
     {"socket-file", required_argument, nullptr, 'f'},
+    {"gdbserver-pool-size", required_argument, nullptr, 'n'},
     {"server", no_argument, &g_server, 1},
     {nullptr, 0, nullptr, 0}};
 
@@ -87,8 +88,8 @@ static void signal_handler(int signo) {
 
 static void display_usage(const char *progname, const char *subcommand) {
   fprintf(stderr, "Usage:\n  %s %s [--log-file log-file-name] [--log-channels "
-                  "log-channel-list] [--port-file port-file-path] --server "
-                  "--listen port\n",
+                  "log-channel-list] [--port-file port-file-path] "
+                  "[--gdbserver-pool-size count] --server --listen port\n",
           progname, subcommand);
   exit(0);
 }
@@ -151,6 +152,7 @@ int main_platform(int argc, char *argv[]) {
   int min_gdbserver_port = 0;
   int max_gdbserver_port = 0;
   uint16_t port_offset = 0;
+  size_t gdbserver_pool_size = 0;
 
   FileSpec socket_file;
   bool show_usage = false;
@@ -205,6 +207,14 @@ int main_platform(int argc, char *argv[]) {
       }
     } break;
 
+    case 'n':
+      if (!llvm::to_integer(optarg, gdbserver_pool_size)) {
+        llvm::errs() << "error: invalid gdbserver pool size " << optarg
+                     << "\n";
+        option_error = 6;
+      }
+      break;
+
     case 'P':
     case 'm':
     case 'M': {
@@ -304,6 +314,8 @@ int main_platform(int argc, char *argv[]) {
       platform.SetPortMap(std::move(gdbserver_portmap));
     }
 
+    platform.SetGDBServerPoolSize(gdbserver_pool_size);
+
     const bool children_inherit_accept_socket = true;
     Connection *conn = nullptr;
     error = acceptor_up->Accept(children_inherit_accept_socket, conn);
@@ -353,6 +365,8 @@ int main_platform(int argc, char *argv[]) {
 
       // After we connected, we need to get an initial ack from...
       if (platform.HandshakeWithClient()) {
+        platform.FillGDBServerPool();
+
         bool interrupt = false;
         bool done = false;
         while (!interrupt && !done) {
@@ -140,6 +140,7 @@ llvm::Error SystemInitializerTest::Initialize() {
   llvm::InitializeAllTargets();
   llvm::InitializeAllAsmPrinters();
   llvm::InitializeAllTargetMCs();
+  llvm::InitializeAllAsmParsers();
   llvm::InitializeAllDisassemblers();
 
   ClangASTContext::Initialize();
@@ -23,6 +23,7 @@
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Symbol/LineTable.h"
 #include "lldb/Symbol/SymbolFile.h"
+#include "lldb/Symbol/Symtab.h"
 #include "lldb/Symbol/TypeList.h"
 #include "lldb/Symbol/TypeMap.h"
 #include "lldb/Symbol/VariableList.h"
@@ -37,15 +38,22 @@
 #include "llvm/ADT/IntervalMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/WithColor.h"
+#include <chrono>
 #include <cstdio>
 #include <thread>
 
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
 using namespace lldb;
 using namespace lldb_private;
 using namespace llvm;
@@ -57,12 +65,15 @@ cl::SubCommand ObjectFileSubcommand("object-file",
                                     "Display LLDB object file information");
 cl::SubCommand SymbolsSubcommand("symbols", "Dump symbols for an object file");
 cl::SubCommand IRMemoryMapSubcommand("ir-memory-map", "Test IRMemoryMap");
+cl::SubCommand BenchSubcommand("bench",
+                               "Time symbol loading for an object file");
 
 cl::opt<std::string> Log("log", cl::desc("Path to a log file"), cl::init(""),
                          cl::sub(BreakpointSubcommand),
                          cl::sub(ObjectFileSubcommand),
                          cl::sub(SymbolsSubcommand),
-                         cl::sub(IRMemoryMapSubcommand));
+                         cl::sub(IRMemoryMapSubcommand),
+                         cl::sub(BenchSubcommand));
 
 /// Create a target using the file pointed to by \p Filename, or abort.
 TargetSP createTarget(Debugger &Dbg, const std::string &Filename);
@@ -228,6 +239,41 @@ bool evalFree(StringRef Line, IRMemoryMapTestState &State);
 int evaluateMemoryMapCommands(Debugger &Dbg);
 } // namespace irmemorymap
 
+namespace bench {
+static cl::opt<std::string> InputFile(cl::Positional, cl::desc("<input file>"),
+                                      cl::Required, cl::sub(BenchSubcommand));
+static cl::opt<std::string>
+    SymbolPath("symbol-file",
+               cl::desc("The file from which to fetch symbol information."),
+               cl::value_desc("file"), cl::sub(BenchSubcommand));
+static cl::list<std::string>
+    FindFunctions("find-function",
+                  cl::desc("Time looking up functions with this name."),
+                  cl::value_desc("name"), cl::CommaSeparated,
+                  cl::sub(BenchSubcommand));
+static cl::list<std::string>
+    FindSymbols("find-symbol",
+                cl::desc("Time looking up symbols with this name."),
+                cl::value_desc("name"), cl::CommaSeparated,
+                cl::sub(BenchSubcommand));
+static cl::list<std::string>
+    FindTypes("find-type", cl::desc("Time looking up types with this name."),
+              cl::value_desc("name"), cl::CommaSeparated,
+              cl::sub(BenchSubcommand));
+
+/// Resource usage of the whole process at one point in time.
+struct Sample {
+  std::chrono::steady_clock::time_point Wall;
+  std::chrono::nanoseconds CPU;
+  uint64_t PeakRSS;
+};
+
+static Sample takeSample();
+static json::Object measure(StringRef Name,
+                            llvm::function_ref<size_t()> Action);
+static int runBenchmarks(Debugger &Dbg);
+} // namespace bench
+
 } // namespace opts
 
 std::vector<CompilerContext> parseCompilerContext() {
@@ -1019,6 +1065,116 @@ int opts::irmemorymap::evaluateMemoryMapCommands(Debugger &Dbg) {
   return 0;
 }
 
+opts::bench::Sample opts::bench::takeSample() {
+  Sample Result;
+  Result.Wall = std::chrono::steady_clock::now();
+  sys::TimePoint<> Elapsed;
+  std::chrono::nanoseconds User, System;
+  sys::Process::GetTimeUsage(Elapsed, User, System);
+  Result.CPU = User + System;
+  Result.PeakRSS = 0;
+#if !defined(_WIN32)
+  struct rusage Usage;
+  if (getrusage(RUSAGE_SELF, &Usage) == 0) {
+#if defined(__APPLE__)
+    Result.PeakRSS = Usage.ru_maxrss;
+#else
+    Result.PeakRSS = uint64_t(Usage.ru_maxrss) * 1024;
+#endif
+  }
+#endif
+  return Result;
+}
+
+/// Run \p Action, which returns the number of results it produced, and
+/// describe the resources it used. CPU time covers all threads of the
+/// process, so it includes work done by the task pool.
+json::Object opts::bench::measure(StringRef Name,
+                                  llvm::function_ref<size_t()> Action) {
+  Sample Before = takeSample();
+  size_t Results = Action();
+  Sample After = takeSample();
+  using Seconds = std::chrono::duration<double>;
+  return json::Object{
+      {"name", Name.str()},
+      {"wall-seconds", Seconds(After.Wall - Before.Wall).count()},
+      {"cpu-seconds", Seconds(After.CPU - Before.CPU).count()},
+      {"peak-rss-bytes", int64_t(After.PeakRSS)},
+      {"results", int64_t(Results)}};
+}
+
+int opts::bench::runBenchmarks(Debugger &Dbg) {
+  ModuleSpec Spec{FileSpec(InputFile)};
+  StringRef Symbols = SymbolPath.empty() ? InputFile : SymbolPath;
+  Spec.GetSymbolFileSpec().SetFile(Symbols, FileSpec::Style::native);
+
+  json::Array Phases;
+  auto ModulePtr = std::make_shared<lldb_private::Module>(Spec);
+  SymbolFile *Symfile = nullptr;
+  Phases.push_back(measure("symbol-file-create", [&]() -> size_t {
+    Symfile = ModulePtr->GetSymbolFile();
+    return Symfile != nullptr;
+  }));
+  if (!Symfile) {
+    WithColor::error() << "Module has no symbol vendor.\n";
+    return 1;
+  }
+
+  // Follow the order of Module::PreloadSymbols, with the symbol table split
+  // up into its parts.
+  Symtab *Table = nullptr;
+  Phases.push_back(measure("symtab-parse", [&]() -> size_t {
+    Table = Symfile->GetSymtab();
+    return Table ? Table->GetNumSymbols() : 0;
+  }));
+  if (Table) {
+    // Object file plug-ins may already compute the address index while
+    // parsing, in which case this only measures the lookup of the result.
+    Phases.push_back(measure("symtab-address-index", [&]() -> size_t {
+      Table->CalculateSymbolSizes();
+      return Table->GetNumSymbols();
+    }));
+  }
+  Phases.push_back(measure("symbol-file-index", [&]() -> size_t {
+    Symfile->PreloadSymbols();
+    return Symfile->GetNumCompileUnits();
+  }));
+  if (Table) {
+    Phases.push_back(measure("symtab-name-index", [&]() -> size_t {
+      Table->PreloadSymbols();
+      return Table->GetNumSymbols();
+    }));
+  }
+
+  for (const std::string &Name : FindFunctions) {
+    Phases.push_back(measure("find-function:" + Name, [&]() -> size_t {
+      SymbolContextList List;
+      return ModulePtr->FindFunctions(ConstString(Name), nullptr,
+                                      eFunctionNameTypeAuto, true, true, true,
+                                      List);
+    }));
+  }
+  for (const std::string &Name : FindSymbols) {
+    Phases.push_back(measure("find-symbol:" + Name, [&]() -> size_t {
+      SymbolContextList List;
+      return ModulePtr->FindSymbolsWithNameAndType(ConstString(Name),
+                                                   eSymbolTypeAny, List);
+    }));
+  }
+  for (const std::string &Name : FindTypes) {
+    Phases.push_back(measure("find-type:" + Name, [&]() -> size_t {
+      DenseSet<SymbolFile *> SearchedFiles;
+      TypeList List;
+      return ModulePtr->FindTypes(ConstString(Name), false, UINT32_MAX,
+                                  SearchedFiles, List);
+    }));
+  }
+
+  json::Object Result{{"module", std::string(InputFile)}, {"phases", std::move(Phases)}};
+  outs() << formatv("{0:2}", json::Value(std::move(Result))) << "\n";
+  return 0;
+}
+
 int main(int argc, const char *argv[]) {
   StringRef ToolName = argv[0];
   sys::PrintStackTraceOnErrorSignal(ToolName);
@@ -1055,6 +1211,8 @@ int main(int argc, const char *argv[]) {
     return opts::symbols::dumpSymbols(*Dbg);
   if (opts::IRMemoryMapSubcommand)
     return opts::irmemorymap::evaluateMemoryMapCommands(*Dbg);
+  if (opts::BenchSubcommand)
+    return opts::bench::runBenchmarks(*Dbg);
 
   WithColor::error() << "No command specified.\n";
   return 1;
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <algorithm>
+#include <mutex>
 
 #include "llvm/Support/FormatAdapters.h"
 
@@ -229,7 +230,8 @@ llvm::json::Value CreateScope(const llvm::StringRef name,
   EmplaceSafeString(object, "name", name.str());
   object.try_emplace("variablesReference", variablesReference);
   object.try_emplace("expensive", expensive);
-  object.try_emplace("namedVariables", namedVariables);
+  if (namedVariables >= 0)
+    object.try_emplace("namedVariables", namedVariables);
   return llvm::json::Value(std::move(object));
 }
 
@@ -481,6 +483,9 @@ llvm::json::Value CreateSource(lldb::SBFrame &frame, int64_t &disasm_line) {
   llvm::json::Object object;
   const auto pc = frame.GetPC();
 
+  // Stack traces are built concurrently, so look up and add disassembly
+  // under the lock.
+  std::lock_guard<std::mutex> locker(g_vsc.source_mutex);
   lldb::SBInstructionList insts;
   lldb::SBFunction function = frame.GetFunction();
   lldb::addr_t low_pc = LLDB_INVALID_ADDRESS;
@@ -845,6 +850,12 @@ llvm::json::Value CreateThreadStopped(lldb::SBThread &thread,
 //   },
 //   "required": [ "name", "value", "variablesReference" ]
 // }
+bool HasIndexedChildren(lldb::SBValue &v) {
+  if (!v.MightHaveChildren())
+    return false;
+  return v.GetType().IsArrayType() || v.IsSynthetic();
+}
+
 llvm::json::Value CreateVariable(lldb::SBValue v, int64_t variablesReference,
                                  int64_t varID, bool format_hex) {
   llvm::json::Object object;
@@ -861,6 +872,8 @@ llvm::json::Value CreateVariable(lldb::SBValue v, int64_t variablesReference,
     object.try_emplace("variablesReference", variablesReference);
   else
     object.try_emplace("variablesReference", (int64_t)0);
+  if (variablesReference != 0 && HasIndexedChildren(v))
+    object.try_emplace("indexedVariables", (int64_t)v.GetNumChildren());
   lldb::SBStream evaluateStream;
   v.GetExpressionPath(evaluateStream);
   const char *evaluateName = evaluateStream.GetData();
@@ -239,7 +239,8 @@ CreateExceptionBreakpointFilter(const ExceptionBreakpoint &bp);
 ///     The value to place into the "variablesReference" key
 //
 /// \param[in] namedVariables
-///     The value to place into the "namedVariables" key
+///     The value to place into the "namedVariables" key, or a negative
+///     value if the number of variables isn't known yet
 //
 /// \param[in] expensive
 ///     The value to place into the "expensive" key
@@ -363,9 +364,14 @@ llvm::json::Value CreateThreadStopped(lldb::SBThread &thread, uint32_t stop_id);
 ///   "variablesReference" - Zero if the variable has no children,
 ///          non-zero integer otherwise which can be used to expand
 ///          the variable.
+///   "indexedVariables" - The number of children, for values whose
+///          children are all indexed (see HasIndexedChildren()).
 ///   "evaluateName" - The name of the variable to use in expressions
 ///                    as a string.
 ///
+/// The value and summary of \a v are computed here, so only call this for
+/// the variables that are actually sent.
+///
 /// \param[in] v
 ///     The LLDB value to use when populating out the "Variable"
 ///     object.
@@ -387,6 +393,12 @@ llvm::json::Value CreateThreadStopped(lldb::SBThread &thread, uint32_t stop_id);
 /// \return
 ///     A "Variable" JSON object with that follows the formal JSON
 ///     definition outlined by Microsoft.
+/// Returns true if the children of \a v are all indexed, like the elements
+/// of an array or a container with a synthetic children provider, and the
+/// client should page through them with "start" and "count" rather than
+/// fetching them all.
+bool HasIndexedChildren(lldb::SBValue &v);
+
 llvm::json::Value CreateVariable(lldb::SBValue v, int64_t variablesReference,
                                  int64_t varID, bool format_hex);
 
@@ -0,0 +1,129 @@
+//===-- RequestScheduler.cpp ------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "RequestScheduler.h"
+
+namespace lldb_vscode {
+
+RequestScheduler::~RequestScheduler() { Stop(); }
+
+void RequestScheduler::Start(unsigned num_concurrent) {
+  m_threads.emplace_back(&RequestScheduler::RunOrdered, this);
+  for (unsigned i = 0; i < num_concurrent; ++i)
+    m_threads.emplace_back(&RequestScheduler::RunConcurrent, this);
+}
+
+void RequestScheduler::Schedule(int64_t seq, Kind kind, Callback callback,
+                                Callback cancelled) {
+  {
+    std::lock_guard<std::mutex> locker(m_mutex);
+    Request request{seq, kind, std::move(callback), std::move(cancelled)};
+    switch (kind) {
+    case Kind::Concurrent:
+      m_pending_concurrent.insert(seq);
+      m_concurrent.push_back(std::move(request));
+      break;
+    case Kind::Barrier:
+      m_pending_barriers.insert(seq);
+      m_ordered.push_back(std::move(request));
+      break;
+    case Kind::Ordered:
+      m_ordered.push_back(std::move(request));
+      break;
+    }
+  }
+  m_cond.notify_all();
+}
+
+bool RequestScheduler::Cancel(int64_t seq) {
+  Callback cancelled;
+  {
+    std::lock_guard<std::mutex> locker(m_mutex);
+    for (auto *queue : {&m_ordered, &m_concurrent}) {
+      for (auto pos = queue->begin(), end = queue->end(); pos != end; ++pos) {
+        if (pos->seq != seq)
+          continue;
+        cancelled = std::move(pos->cancelled);
+        m_pending_barriers.erase(seq);
+        m_pending_concurrent.erase(seq);
+        queue->erase(pos);
+        break;
+      }
+    }
+  }
+  if (!cancelled)
+    return false;
+  // Requests waiting on this one may be able to run now.
+  m_cond.notify_all();
+  cancelled();
+  return true;
+}
+
+void RequestScheduler::Stop() {
+  {
+    std::lock_guard<std::mutex> locker(m_mutex);
+    m_stopping = true;
+  }
+  m_cond.notify_all();
+  for (auto &thread : m_threads)
+    thread.join();
+  m_threads.clear();
+}
+
+void RequestScheduler::RunOrdered() {
+  std::unique_lock<std::mutex> locker(m_mutex);
+  while (true) {
+    // A barrier has to wait for the concurrent requests that came in before
+    // it.
+    m_cond.wait(locker, [this] {
+      if (m_ordered.empty())
+        return m_stopping;
+      const Request &request = m_ordered.front();
+      return request.kind != Kind::Barrier || m_pending_concurrent.empty() ||
+             *m_pending_concurrent.begin() > request.seq;
+    });
+    if (m_ordered.empty())
+      return;
+
+    Request request = std::move(m_ordered.front());
+    m_ordered.pop_front();
+    locker.unlock();
+    request.callback();
+    locker.lock();
+    if (request.kind == Kind::Barrier) {
+      m_pending_barriers.erase(request.seq);
+      m_cond.notify_all();
+    }
+  }
+}
+
+void RequestScheduler::RunConcurrent() {
+  std::unique_lock<std::mutex> locker(m_mutex);
+  while (true) {
+    // Concurrent requests are queued in order, so if the first one has to
+    // wait for a barrier, so do all the others.
+    m_cond.wait(locker, [this] {
+      if (m_concurrent.empty())
+        return m_stopping;
+      return m_pending_barriers.empty() ||
+             *m_pending_barriers.begin() > m_concurrent.front().seq;
+    });
+    if (m_concurrent.empty())
+      return;
+
+    Request request = std::move(m_concurrent.front());
+    m_concurrent.pop_front();
+    locker.unlock();
+    request.callback();
+    locker.lock();
+    m_pending_concurrent.erase(request.seq);
+    m_cond.notify_all();
+  }
+}
+
+} // namespace lldb_vscode
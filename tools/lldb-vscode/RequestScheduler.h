@@ -0,0 +1,86 @@
+//===-- RequestScheduler.h --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDBVSCODE_REQUESTSCHEDULER_H_
+#define LLDBVSCODE_REQUESTSCHEDULER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace lldb_vscode {
+
+// Runs requests off the thread that reads them, so a slow request doesn't
+// hold up the ones the IDE sends after it.
+//
+// Requests are one of three kinds:
+//  - Concurrent requests only read state and are run in parallel by a pool
+//    of threads.
+//  - Ordered requests share state with each other and run one at a time, in
+//    the order they were scheduled, but may overlap concurrent requests.
+//  - Barrier requests change the state of the process or the target. They
+//    are ordered too, and also wait for the concurrent requests scheduled
+//    before them, while concurrent requests scheduled after them wait for
+//    them to finish.
+struct RequestScheduler {
+  enum class Kind { Concurrent, Ordered, Barrier };
+
+  typedef std::function<void()> Callback;
+
+  RequestScheduler() = default;
+  ~RequestScheduler();
+  RequestScheduler(const RequestScheduler &rhs) = delete;
+  void operator=(const RequestScheduler &rhs) = delete;
+
+  // Start the threads that run the requests. "num_concurrent" threads run
+  // concurrent requests.
+  void Start(unsigned num_concurrent);
+
+  // Schedule "callback" to run as request "seq". Sequence numbers must
+  // increase from one call to the next. "cancelled" is called instead of
+  // "callback" if the request is cancelled before it starts.
+  void Schedule(int64_t seq, Kind kind, Callback callback, Callback cancelled);
+
+  // Cancel request "seq" if it hasn't started yet. Returns true if it was
+  // cancelled.
+  bool Cancel(int64_t seq);
+
+  // Run all the requests that are scheduled and wait for the threads to
+  // exit.
+  void Stop();
+
+private:
+  struct Request {
+    int64_t seq;
+    Kind kind;
+    Callback callback;
+    Callback cancelled;
+  };
+
+  void RunOrdered();
+  void RunConcurrent();
+
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::deque<Request> m_ordered;
+  std::deque<Request> m_concurrent;
+  // Barrier requests that haven't finished yet.
+  std::set<int64_t> m_pending_barriers;
+  // Concurrent requests that haven't finished yet.
+  std::set<int64_t> m_pending_concurrent;
+  std::vector<std::thread> m_threads;
+  bool m_stopping = false;
+};
+
+} // namespace lldb_vscode
+
+#endif
@@ -31,7 +31,7 @@ VSCode g_vsc;
 
 VSCode::VSCode()
     : launch_info(nullptr), variables(), broadcaster("lldb-vscode"),
-      num_regs(0), num_locals(0), num_globals(0), log(),
+      log(),
       exception_breakpoints(
           {{"cpp_catch", "C++ Catch", lldb::eLanguageTypeC_plus_plus},
            {"cpp_throw", "C++ Throw", lldb::eLanguageTypeC_plus_plus},
@@ -273,13 +273,55 @@ lldb::SBFrame VSCode::GetLLDBFrame(const llvm::json::Object &arguments) {
 
 llvm::json::Value VSCode::CreateTopLevelScopes() {
   llvm::json::Array scopes;
-  scopes.emplace_back(CreateScope("Locals", VARREF_LOCALS, num_locals, false));
-  scopes.emplace_back(
-      CreateScope("Globals", VARREF_GLOBALS, num_globals, false));
-  scopes.emplace_back(CreateScope("Registers", VARREF_REGS, num_regs, false));
+  // The number of variables in each scope isn't known until they are
+  // fetched. Globals and registers are rarely looked at, so let the IDE
+  // know not to fetch them unless asked to.
+  scopes.emplace_back(CreateScope("Locals", VARREF_LOCALS, -1, false));
+  scopes.emplace_back(CreateScope("Globals", VARREF_GLOBALS, -1, true));
+  scopes.emplace_back(CreateScope("Registers", VARREF_REGS, -1, true));
   return llvm::json::Value(std::move(scopes));
 }
 
+lldb::SBValueList &VSCode::GetScopeVariables(int64_t variablesReference) {
+  auto pos = scope_variables.find(variablesReference);
+  if (pos != scope_variables.end())
+    return pos->second;
+
+  lldb::SBValueList &scope = scope_variables[variablesReference];
+  switch (variablesReference) {
+  case VARREF_LOCALS:
+    scope = scopes_frame.GetVariables(true,   // arguments
+                                      true,   // locals
+                                      false,  // statics
+                                      true);  // in_scope_only
+    break;
+  case VARREF_GLOBALS:
+    scope = scopes_frame.GetVariables(false,  // arguments
+                                      false,  // locals
+                                      true,   // statics
+                                      true);  // in_scope_only
+    break;
+  case VARREF_REGS:
+    scope = scopes_frame.GetRegisters();
+    break;
+  default:
+    break;
+  }
+  return scope;
+}
+
+StopCache *VSCode::GetStopCache() {
+  lldb::SBProcess process = target.GetProcess();
+  if (!process.IsValid() || process.GetState() != lldb::eStateStopped)
+    return nullptr;
+  const uint32_t stop_id = process.GetStopID();
+  if (stop_cache.stop_id != stop_id) {
+    stop_cache = StopCache();
+    stop_cache.stop_id = stop_id;
+  }
+  return &stop_cache;
+}
+
 void VSCode::RunLLDBCommands(llvm::StringRef prefix,
                              const std::vector<std::string> &commands) {
   SendOutput(OutputType::Console,
@@ -11,14 +11,17 @@
 
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <set>
 #include <stdio.h>
 #include <thread>
 
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "lldb/API/SBAttachInfo.h"
@@ -45,6 +48,7 @@
 #include "ExceptionBreakpoint.h"
 #include "FunctionBreakpoint.h"
 #include "IOStream.h"
+#include "RequestScheduler.h"
 #include "SourceBreakpoint.h"
 #include "SourceReference.h"
 
@@ -63,6 +67,16 @@ typedef llvm::DenseMap<uint32_t, SourceBreakpoint> SourceBreakpointMap;
 typedef llvm::StringMap<FunctionBreakpoint> FunctionBreakpointMap;
 enum class OutputType { Console, Stdout, Stderr, Telemetry };
 
+// What "threads" and "stackTrace" requests report about a stopped process.
+// Nothing in it changes until the process runs again, so it is built as
+// requests ask for it and thrown away at the next stop.
+struct StopCache {
+  uint32_t stop_id = UINT32_MAX;
+  llvm::Optional<llvm::json::Array> threads;
+  // "StackFrame" objects by thread ID and frame index.
+  std::map<std::pair<lldb::tid_t, uint32_t>, llvm::json::Value> frames;
+};
+
 struct VSCode {
   InputStream input;
   OutputStream output;
@@ -72,16 +86,24 @@ struct VSCode {
   lldb::SBLaunchInfo launch_info;
   lldb::SBValueList variables;
   lldb::SBBroadcaster broadcaster;
-  int64_t num_regs;
-  int64_t num_locals;
-  int64_t num_globals;
+  // The frame of the last "scopes" request. The variables of its scopes are
+  // only fetched once a "variables" request asks for them.
+  lldb::SBFrame scopes_frame;
+  std::map<int64_t, lldb::SBValueList> scope_variables;
+  // Protects stop_cache, which concurrent requests share.
+  std::mutex stop_cache_mutex;
+  StopCache stop_cache;
   std::thread event_thread;
   std::unique_ptr<std::ofstream> log;
+  // Protects addr_to_source_ref and source_map, which concurrent requests
+  // share.
+  std::mutex source_mutex;
   llvm::DenseMap<lldb::addr_t, int64_t> addr_to_source_ref;
   llvm::DenseMap<int64_t, SourceReference> source_map;
   llvm::StringMap<SourceBreakpointMap> source_breakpoints;
   FunctionBreakpointMap function_breakpoints;
   std::vector<ExceptionBreakpoint> exception_breakpoints;
+  RequestScheduler scheduler;
   std::vector<std::string> init_commands;
   std::vector<std::string> pre_run_commands;
   std::vector<std::string> exit_commands;
@@ -125,6 +147,14 @@ struct VSCode {
 
   llvm::json::Value CreateTopLevelScopes();
 
+  // Get the variables in the scope "variablesReference" refers to, for the
+  // frame of the last "scopes" request.
+  lldb::SBValueList &GetScopeVariables(int64_t variablesReference);
+
+  // Get the cache for the current stop of the process, or nullptr if it
+  // isn't stopped. Must be called with stop_cache_mutex held.
+  StopCache *GetStopCache();
+
   void RunLLDBCommands(llvm::StringRef prefix,
                        const std::vector<std::string> &commands);
 
@@ -41,6 +41,7 @@
 #include <thread>
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/Errno.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/raw_ostream.h"
@@ -165,18 +166,20 @@ void SendThreadStoppedEvent() {
       // First make a pass through the threads to see if the focused thread
       // has a stop reason. In case the focus thread doesn't have a stop
       // reason, remember the first thread that has a stop reason so we can
-      // set it as the focus thread if below if needed.
+      // set it as the focus thread if below if needed. The threads with a
+      // reason are kept so that we only ask each thread once.
       lldb::tid_t first_tid_with_reason = LLDB_INVALID_THREAD_ID;
-      uint32_t num_threads_with_reason = 0;
+      std::vector<lldb::SBThread> threads_with_reason;
       for (uint32_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
         lldb::SBThread thread = process.GetThreadAtIndex(thread_idx);
         const lldb::tid_t tid = thread.GetThreadID();
         const bool has_reason = ThreadHasStopReason(thread);
+        g_vsc.thread_ids.insert(tid);
         // If the focus thread doesn't have a stop reason, clear the thread ID
         if (tid == g_vsc.focus_tid && !has_reason)
           g_vsc.focus_tid = LLDB_INVALID_THREAD_ID;
         if (has_reason) {
-          ++num_threads_with_reason;
+          threads_with_reason.push_back(thread);
           if (first_tid_with_reason == LLDB_INVALID_THREAD_ID)
             first_tid_with_reason = tid;
         }
@@ -190,17 +193,12 @@ void SendThreadStoppedEvent() {
 
       // If no threads stopped with a reason, then report the first one so
       // we at least let the UI know we stopped.
-      if (num_threads_with_reason == 0) {
+      if (threads_with_reason.empty()) {
         lldb::SBThread thread = process.GetThreadAtIndex(0);
         g_vsc.SendJSON(CreateThreadStopped(thread, stop_id));
       } else {
-        for (uint32_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
-          lldb::SBThread thread = process.GetThreadAtIndex(thread_idx);
-          g_vsc.thread_ids.insert(thread.GetThreadID());
-          if (ThreadHasStopReason(thread)) {
-            g_vsc.SendJSON(CreateThreadStopped(thread, stop_id));
-          }
-        }
+        for (auto &thread : threads_with_reason)
+          g_vsc.SendJSON(CreateThreadStopped(thread, stop_id));
       }
 
       for (auto tid : old_thread_ids) {
@@ -588,6 +586,51 @@ void request_attach(const llvm::json::Object &request) {
   }
 }
 
+// "CancelRequest": {
+//   "allOf": [ { "$ref": "#/definitions/Request" }, {
+//     "type": "object",
+//     "description": "Cancel request; value of command field is 'cancel'.
+//     The request asks the debug adapter to stop working on a request it
+//     sent earlier. A request that is cancelled returns an error response
+//     with the message 'cancelled'.",
+//     "properties": {
+//       "command": {
+//         "type": "string",
+//         "enum": [ "cancel" ]
+//       },
+//       "arguments": {
+//         "$ref": "#/definitions/CancelArguments"
+//       }
+//     },
+//     "required": [ "command" ]
+//   }]
+// },
+// "CancelArguments": {
+//   "type": "object",
+//   "description": "Arguments for 'cancel' request.",
+//   "properties": {
+//     "requestId": {
+//       "type": "integer",
+//       "description": "The ID (attribute 'seq') of the request to cancel."
+//     }
+//   }
+// },
+// "CancelResponse": {
+//   "allOf": [ { "$ref": "#/definitions/Response" }, {
+//     "type": "object",
+//     "description": "Response to 'cancel' request. This is just an
+//     acknowledgement, so no body field is required."
+//   }]
+// }
+void request_cancel(const llvm::json::Object &request) {
+  llvm::json::Object response;
+  FillResponse(request, response);
+  auto arguments = request.getObject("arguments");
+  // Requests that have already started are left to finish.
+  g_vsc.scheduler.Cancel(GetSigned(arguments, "requestId", -1));
+  g_vsc.SendJSON(llvm::json::Value(std::move(response)));
+}
+
 // "ContinueRequest": {
 //   "allOf": [ { "$ref": "#/definitions/Request" }, {
 //     "type": "object",
@@ -930,9 +973,26 @@ void request_evaluate(const llvm::json::Object &request) {
   const auto expression = GetString(arguments, "expression");
 
   if (!expression.empty() && expression[0] == '`') {
-    auto result = RunLLDBCommands(llvm::StringRef(),
-                                     {expression.substr(1)});
-    EmplaceSafeString(body, "result", result);
+    // Commands like "image dump symtab" can print gigabytes, so once there
+    // is more output than fits in a response, send it to the console as it
+    // comes.
+    const std::string command = expression.substr(1).str();
+    std::string output = "(lldb) " + command + "\n";
+    lldb::SBCommandReturnObject result;
+    result.SetImmediateOutputCallback(
+        [](const char *str, void *baton) {
+          auto &output = *static_cast<std::string *>(baton);
+          output += str;
+          if (output.size() >= 64 * 1024) {
+            g_vsc.SendOutput(OutputType::Console, output);
+            output.clear();
+          }
+        },
+        &output);
+    g_vsc.debugger.GetCommandInterpreter().HandleCommand(
+        command.c_str(), result);
+    output += result.GetError();
+    EmplaceSafeString(body, "result", output);
     body.try_emplace("variablesReference", (int64_t)0);
   } else {
     // Always try to get the answer from the local variables if possible. If
@@ -1134,6 +1194,8 @@ void request_initialize(const llvm::json::Object &request) {
   body.try_emplace("supportsDelayedStackTraceLoading", true);
   // The debug adapter supports the 'loadedSources' request.
   body.try_emplace("supportsLoadedSourcesRequest", false);
+  // The debug adapter supports the 'cancel' request.
+  body.try_emplace("supportsCancelRequest", true);
 
   response.try_emplace("body", std::move(body));
   g_vsc.SendJSON(llvm::json::Value(std::move(response)));
@@ -1434,21 +1496,9 @@ void request_scopes(const llvm::json::Object &request) {
   FillResponse(request, response);
   llvm::json::Object body;
   auto arguments = request.getObject("arguments");
-  lldb::SBFrame frame = g_vsc.GetLLDBFrame(*arguments);
+  g_vsc.scopes_frame = g_vsc.GetLLDBFrame(*arguments);
+  g_vsc.scope_variables.clear();
   g_vsc.variables.Clear();
-  g_vsc.variables.Append(frame.GetVariables(true,   // arguments
-                                            true,   // locals
-                                            false,  // statics
-                                            true)); // in_scope_only
-  g_vsc.num_locals = g_vsc.variables.GetSize();
-  g_vsc.variables.Append(frame.GetVariables(false,  // arguments
-                                            false,  // locals
-                                            true,   // statics
-                                            true)); // in_scope_only
-  g_vsc.num_globals = g_vsc.variables.GetSize() - (g_vsc.num_locals);
-  g_vsc.variables.Append(frame.GetRegisters());
-  g_vsc.num_regs =
-      g_vsc.variables.GetSize() - (g_vsc.num_locals + g_vsc.num_globals);
   body.try_emplace("scopes", g_vsc.CreateTopLevelScopes());
   response.try_emplace("body", std::move(body));
   g_vsc.SendJSON(llvm::json::Value(std::move(response)));
@@ -1920,6 +1970,7 @@ void request_source(const llvm::json::Object &request) {
   auto arguments = request.getObject("arguments");
   auto source = arguments->getObject("source");
   auto sourceReference = GetSigned(source, "sourceReference", -1);
+  std::lock_guard<std::mutex> locker(g_vsc.source_mutex);
   auto pos = g_vsc.source_map.find((lldb::addr_t)sourceReference);
   if (pos != g_vsc.source_map.end()) {
     EmplaceSafeString(body, "content", pos->second.content);
@@ -2010,15 +2061,46 @@ void request_stackTrace(const llvm::json::Object &request) {
   llvm::json::Object body;
 
   if (thread.IsValid()) {
+    const lldb::tid_t tid = thread.GetThreadID();
     const auto startFrame = GetUnsigned(arguments, "startFrame", 0);
     const auto levels = GetUnsigned(arguments, "levels", 0);
-    const auto endFrame = (levels == 0) ? INT64_MAX : (startFrame + levels);
+    auto endFrame = (levels == 0) ? INT64_MAX : (startFrame + levels);
+    // Only the top frame of the threads the user isn't looking at is shown
+    // until they are expanded, so don't unwind them any further yet. A
+    // total past the frames sent tells the IDE to ask for the rest, without
+    // unwinding the whole stack to count them.
+    const bool top_frame_only = startFrame == 0 && levels == 0 &&
+                                g_vsc.focus_tid != LLDB_INVALID_THREAD_ID &&
+                                tid != g_vsc.focus_tid;
+    if (top_frame_only)
+      endFrame = 1;
     for (uint32_t i = startFrame; i < endFrame; ++i) {
+      {
+        std::lock_guard<std::mutex> locker(g_vsc.stop_cache_mutex);
+        StopCache *cache = g_vsc.GetStopCache();
+        if (cache) {
+          auto pos = cache->frames.find(std::make_pair(tid, i));
+          if (pos != cache->frames.end()) {
+            stackFrames.push_back(pos->second);
+            continue;
+          }
+        }
+      }
       auto frame = thread.GetFrameAtIndex(i);
       if (!frame.IsValid())
         break;
-      stackFrames.emplace_back(CreateStackFrame(frame));
+      llvm::json::Value stack_frame = CreateStackFrame(frame);
+      {
+        std::lock_guard<std::mutex> locker(g_vsc.stop_cache_mutex);
+        StopCache *cache = g_vsc.GetStopCache();
+        if (cache)
+          cache->frames.emplace(std::make_pair(tid, i), stack_frame);
+      }
+      stackFrames.emplace_back(std::move(stack_frame));
     }
+    if (top_frame_only && !stackFrames.empty() &&
+        thread.GetFrameAtIndex(1).IsValid())
+      body.try_emplace("totalFrames", (int64_t)stackFrames.size() + 1);
   }
   body.try_emplace("stackFrames", std::move(stackFrames));
   response.try_emplace("body", std::move(body));
@@ -2179,11 +2261,23 @@ void request_threads(const llvm::json::Object &request) {
   llvm::json::Object response;
   FillResponse(request, response);
 
-  const uint32_t num_threads = process.GetNumThreads();
   llvm::json::Array threads;
-  for (uint32_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
-    lldb::SBThread thread = process.GetThreadAtIndex(thread_idx);
-    threads.emplace_back(CreateThread(thread));
+  {
+    std::lock_guard<std::mutex> locker(g_vsc.stop_cache_mutex);
+    StopCache *cache = g_vsc.GetStopCache();
+    if (cache && cache->threads)
+      threads = *cache->threads;
+  }
+  if (threads.empty()) {
+    const uint32_t num_threads = process.GetNumThreads();
+    for (uint32_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+      lldb::SBThread thread = process.GetThreadAtIndex(thread_idx);
+      threads.emplace_back(CreateThread(thread));
+    }
+    std::lock_guard<std::mutex> locker(g_vsc.stop_cache_mutex);
+    StopCache *cache = g_vsc.GetStopCache();
+    if (cache)
+      cache->threads = threads;
   }
   if (threads.size() == 0) {
     response["success"] = llvm::json::Value(false);
@@ -2301,44 +2395,30 @@ void request_setVariable(const llvm::json::Object &request) {
   // only specifies the variable reference of the enclosing scope/variable, and
   // the name of the variable. We could have two shadowed variables with the
   // same name in "Locals" or "Globals". In our case the "id" absolute index
-  // of the variable within the g_vsc.variables list.
+  // of the variable within the g_vsc.variables list, which every variable of
+  // a scope that was sent is added to.
   const auto id_value = GetUnsigned(arguments, "id", UINT64_MAX);
   if (id_value != UINT64_MAX) {
     variable = g_vsc.variables.GetValueAtIndex(id_value);
   } else if (VARREF_IS_SCOPE(variablesReference)) {
     // variablesReference is one of our scopes, not an actual variable it is
     // asking for a variable in locals or globals or registers
-    int64_t start_idx = 0;
-    int64_t end_idx = 0;
-    switch (variablesReference) {
-    case VARREF_LOCALS:
-      start_idx = 0;
-      end_idx = start_idx + g_vsc.num_locals;
-      break;
-    case VARREF_GLOBALS:
-      start_idx = g_vsc.num_locals;
-      end_idx = start_idx + g_vsc.num_globals;
-      break;
-    case VARREF_REGS:
-      start_idx = g_vsc.num_locals + g_vsc.num_globals;
-      end_idx = start_idx + g_vsc.num_regs;
-      break;
-    default:
-      break;
-    }
+    lldb::SBValueList &scope = g_vsc.GetScopeVariables(variablesReference);
 
     // Find the variable by name in the correct scope and hope we don't have
     // multiple variables with the same name. We search backwards because
     // the list of variables has the top most variables first and variables
     // in deeper scopes are last. This means we will catch the deepest
     // variable whose name matches which is probably what the user wants.
-    for (int64_t i = end_idx - 1; i >= start_idx; --i) {
-      auto curr_variable = g_vsc.variables.GetValueAtIndex(i);
+    for (int64_t i = scope.GetSize() - 1; i >= 0; --i) {
+      auto curr_variable = scope.GetValueAtIndex(i);
       llvm::StringRef variable_name(curr_variable.GetName());
       if (variable_name == name) {
         variable = curr_variable;
-        if (curr_variable.MightHaveChildren())
-          newVariablesReference = i;
+        if (curr_variable.MightHaveChildren()) {
+          newVariablesReference = VARIDX_TO_VARREF(g_vsc.variables.GetSize());
+          g_vsc.variables.Append(variable);
+        }
         break;
       }
     }
@@ -2474,43 +2554,39 @@ void request_variables(const llvm::json::Object &request) {
 
   if (VARREF_IS_SCOPE(variablesReference)) {
     // variablesReference is one of our scopes, not an actual variable it is
-    // asking for the list of args, locals or globals.
-    int64_t start_idx = 0;
-    int64_t num_children = 0;
-    switch (variablesReference) {
-    case VARREF_LOCALS:
-      start_idx = start;
-      num_children = g_vsc.num_locals;
-      break;
-    case VARREF_GLOBALS:
-      start_idx = start + g_vsc.num_locals + start;
-      num_children = g_vsc.num_globals;
-      break;
-    case VARREF_REGS:
-      start_idx = start + g_vsc.num_locals + g_vsc.num_globals;
-      num_children = g_vsc.num_regs;
-      break;
-    default:
-      break;
-    }
-    const int64_t end_idx = start_idx + ((count == 0) ? num_children : count);
-    for (auto i = start_idx; i < end_idx; ++i) {
-      lldb::SBValue variable = g_vsc.variables.GetValueAtIndex(i);
+    // asking for the list of args, locals or globals. Only the variables
+    // that are sent get added to g_vsc.variables, and only they get their
+    // values and summaries computed.
+    lldb::SBValueList &scope = g_vsc.GetScopeVariables(variablesReference);
+    const int64_t num_children = scope.GetSize();
+    const int64_t end_idx =
+        (count == 0) ? num_children : std::min(num_children, start + count);
+    for (auto i = start; i < end_idx; ++i) {
+      lldb::SBValue variable = scope.GetValueAtIndex(i);
       if (!variable.IsValid())
         break;
+      const int64_t var_idx = g_vsc.variables.GetSize();
+      g_vsc.variables.Append(variable);
       variables.emplace_back(
-          CreateVariable(variable, VARIDX_TO_VARREF(i), i, hex));
+          CreateVariable(variable, VARIDX_TO_VARREF(var_idx), var_idx, hex));
     }
   } else {
     // We are expanding a variable that has children, so we will return its
     // children.
     const int64_t var_idx = VARREF_TO_VARIDX(variablesReference);
     lldb::SBValue variable = g_vsc.variables.GetValueAtIndex(var_idx);
+    // The children of values with indexed children were all reported in
+    // "indexedVariables", so there are no named ones to send.
+    if (variable.IsValid() && GetString(arguments, "filter") == "named" &&
+        HasIndexedChildren(variable))
+      variable = lldb::SBValue();
     if (variable.IsValid()) {
-      const auto num_children = variable.GetNumChildren();
-      const int64_t end_idx = start + ((count == 0) ? num_children : count);
-      for (auto i = start; i < end_idx; ++i) {
-        lldb::SBValue child = variable.GetChildAtIndex(i);
+      // Only fetch the requested window, so that scrolling through a large
+      // container doesn't enumerate all of its children.
+      const uint32_t window = (count == 0) ? UINT32_MAX : count;
+      lldb::SBValueList children = variable.GetChildrenInRange(start, window);
+      for (uint32_t i = 0; i < children.GetSize(); ++i) {
+        lldb::SBValue child = children.GetValueAtIndex(i);
         if (!child.IsValid())
           break;
         if (child.MightHaveChildren()) {
@@ -2555,6 +2631,7 @@ const std::map<std::string, RequestCallback> &GetRequestHandlers() {
   static std::map<std::string, RequestCallback> g_request_handlers = {
       // VSCode Debug Adaptor requests
       REQUEST_CALLBACK(attach),
+      REQUEST_CALLBACK(cancel),
       REQUEST_CALLBACK(continue),
       REQUEST_CALLBACK(configurationDone),
       REQUEST_CALLBACK(disconnect),
@@ -2581,6 +2658,27 @@ const std::map<std::string, RequestCallback> &GetRequestHandlers() {
 #undef REQUEST_CALLBACK
   return g_request_handlers;
 }
+
+// Requests that only read the state of the process can run alongside
+// anything but the requests that change it. The ones that work with the
+// variables list run in order among themselves, and everything else is a
+// barrier.
+RequestScheduler::Kind GetRequestKind(llvm::StringRef command) {
+  return llvm::StringSwitch<RequestScheduler::Kind>(command)
+      .Cases("exceptionInfo", "source", "stackTrace", "threads",
+             RequestScheduler::Kind::Concurrent)
+      .Cases("evaluate", "scopes", "setVariable", "variables",
+             RequestScheduler::Kind::Ordered)
+      .Default(RequestScheduler::Kind::Barrier);
+}
+
+void SendCancelledResponse(const llvm::json::Object &request) {
+  llvm::json::Object response;
+  FillResponse(request, response);
+  response["success"] = llvm::json::Value(false);
+  EmplaceSafeString(response, "message", "cancelled");
+  g_vsc.SendJSON(llvm::json::Value(std::move(response)));
+}
   
 } // anonymous namespace
 
@@ -2616,6 +2714,8 @@ int main(int argc, char *argv[]) {
         StreamDescriptor::from_file(fileno(stdout), false);
   }
   auto request_handlers = GetRequestHandlers();
+  g_vsc.scheduler.Start(
+      std::min(4u, std::max(1u, std::thread::hardware_concurrency())));
   uint32_t packet_idx = 0;
   while (true) {
     std::string json = g_vsc.ReadJSON();
@@ -2650,7 +2750,21 @@ int main(int argc, char *argv[]) {
       const auto command = GetString(object, "command");
       auto handler_pos = request_handlers.find(command);
       if (handler_pos != request_handlers.end()) {
-        handler_pos->second(*object);
+        // Cancelling has to happen right away, before the request it is
+        // about gets to run.
+        if (command == "cancel") {
+          handler_pos->second(*object);
+        } else {
+          const auto seq = GetSigned(object, "seq", 0);
+          const auto kind = GetRequestKind(command);
+          auto callback = handler_pos->second;
+          auto request =
+              std::make_shared<llvm::json::Value>(std::move(*json_value));
+          g_vsc.scheduler.Schedule(
+              seq, kind,
+              [request, callback] { callback(*request->getAsObject()); },
+              [request] { SendCancelledResponse(*request->getAsObject()); });
+        }
       } else {
         if (g_vsc.log)
           *g_vsc.log << "error: unhandled command \"" << command.data() << std::endl;
@@ -2660,6 +2774,9 @@ int main(int argc, char *argv[]) {
     ++packet_idx;
   }
 
+  // Let the requests that were read finish before tearing anything down.
+  g_vsc.scheduler.Stop();
+
   // We must terminate the debugger in a thread before the C++ destructor
   // chain messes everything up.
   lldb::SBDebugger::Terminate();
@@ -0,0 +1,51 @@
+//===-- DumpDataExtractorTest.cpp -------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/DumpDataExtractor.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/StreamString.h"
+#include "gtest/gtest.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+static std::string Dump(const DataExtractor &data, Format format,
+                        size_t item_byte_size, size_t item_count,
+                        size_t num_per_line, uint64_t base_addr) {
+  StreamString s;
+  DumpDataExtractor(data, &s, 0, format, item_byte_size, item_count,
+                    num_per_line, base_addr, 0, 0);
+  return s.GetString().str();
+}
+
+TEST(DumpDataExtractorTest, BytesWithASCII) {
+  const uint8_t bytes[] = {'A', 'B', 'C', 'D', 1, 2, 3, 4, 5};
+  DataExtractor data(bytes, sizeof(bytes), eByteOrderLittle, 4);
+  EXPECT_EQ("0x00001000: 41 42 43 44  ABCD\n"
+            "0x00001004: 01 02 03 04  ....\n"
+            "0x00001008: 05           .",
+            Dump(data, eFormatBytesWithASCII, 1, sizeof(bytes), 4, 0x1000));
+}
+
+TEST(DumpDataExtractorTest, Hex) {
+  const uint8_t bytes[] = {0x34, 0x12, 0xcd, 0xab};
+  DataExtractor data(bytes, sizeof(bytes), eByteOrderLittle, 4);
+  EXPECT_EQ("0x1234 0xabcd",
+            Dump(data, eFormatHex, 2, 2, 2, LLDB_INVALID_ADDRESS));
+  EXPECT_EQ("0x00000010: 0xABCD1234",
+            Dump(data, eFormatHexUppercase, 4, 1, 1, 0x10));
+}
+
+TEST(DumpDataExtractorTest, PartialItems) {
+  // Items past the end of the data are left to the general path, which
+  // reports them.
+  const uint8_t bytes[] = {0x34, 0x12, 0xcd, 0xab};
+  DataExtractor data(bytes, sizeof(bytes), eByteOrderLittle, 4);
+  std::string dump = Dump(data, eFormatHex, 2, 3, 3, LLDB_INVALID_ADDRESS);
+  EXPECT_EQ(0u, dump.find("0x1234 0xabcd"));
+}
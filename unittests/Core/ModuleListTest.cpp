@@ -0,0 +1,105 @@
+//===-- ModuleListTest.cpp --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/ModuleSpec.h"
+#include "lldb/Host/FileSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+class ModuleListTest : public testing::Test {
+public:
+  void SetUp() override { FileSystem::Initialize(); }
+  void TearDown() override { FileSystem::Terminate(); }
+};
+} // namespace
+
+static std::vector<ModuleSP> CreateModules(size_t count) {
+  std::vector<ModuleSP> modules;
+  for (size_t i = 0; i < count; ++i)
+    modules.push_back(std::make_shared<Module>(
+        ModuleSpec(FileSpec("/does/not/exist/lib" + std::to_string(i)))));
+  return modules;
+}
+
+TEST_F(ModuleListTest, AppendRemove) {
+  std::vector<ModuleSP> modules = CreateModules(3);
+  ModuleList list;
+  EXPECT_EQ(0u, list.GetSize());
+  EXPECT_EQ(nullptr, list.GetModuleAtIndex(0));
+
+  for (const ModuleSP &module_sp : modules)
+    list.Append(module_sp);
+  ASSERT_EQ(3u, list.GetSize());
+  EXPECT_EQ(modules[1], list.GetModuleAtIndex(1));
+  EXPECT_EQ(modules[2], list.FindModule(modules[2].get()));
+  EXPECT_EQ(2u, list.GetIndexForModule(modules[2].get()));
+
+  EXPECT_TRUE(list.Remove(modules[1]));
+  ASSERT_EQ(2u, list.GetSize());
+  EXPECT_EQ(modules[2], list.GetModuleAtIndex(1));
+  EXPECT_EQ(nullptr, list.FindModule(modules[1].get()));
+
+  ModuleList copy(list);
+  list.Clear();
+  EXPECT_EQ(0u, list.GetSize());
+  EXPECT_EQ(2u, copy.GetSize());
+  EXPECT_EQ(modules[0], copy.FindModule(modules[0].get()));
+}
+
+TEST_F(ModuleListTest, LookupsDuringModification) {
+  std::vector<ModuleSP> modules = CreateModules(8);
+  ModuleList list;
+  list.Append(modules[0]);
+
+  // The first module is never removed, so every lookup has to find it while
+  // the others come and go.
+  std::atomic<bool> done(false);
+  std::thread writer([&]() {
+    for (int i = 0; i < 500; ++i) {
+      for (size_t j = 1; j < modules.size(); ++j)
+        list.Append(modules[j]);
+      for (size_t j = 1; j < modules.size(); ++j)
+        list.Remove(modules[j]);
+    }
+    done = true;
+  });
+
+  std::vector<std::thread> readers;
+  std::atomic<size_t> failures(0);
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&]() {
+      while (!done) {
+        if (list.FindModule(modules[0].get()) != modules[0])
+          ++failures;
+        size_t count = 0;
+        list.ForEach([&](const ModuleSP &module_sp) {
+          ++count;
+          return true;
+        });
+        if (count == 0 || count > modules.size())
+          ++failures;
+      }
+    });
+  }
+
+  writer.join();
+  for (std::thread &reader : readers)
+    reader.join();
+  EXPECT_EQ(0u, failures);
+  EXPECT_EQ(1u, list.GetSize());
+}
@@ -14,6 +14,8 @@
 #include "llvm/Testing/Support/Error.h"
 #include "gtest/gtest.h"
 
+#include <cstring>
+
 using namespace lldb_private;
 
 static llvm::Expected<Scalar> Evaluate(llvm::ArrayRef<uint8_t> expr) {
@@ -40,3 +42,99 @@ TEST(DWARFExpression, DW_OP_pick) {
   EXPECT_THAT_EXPECTED(Evaluate({DW_OP_lit1, DW_OP_lit0, DW_OP_pick, 2}),
                        llvm::Failed());
 }
+
+TEST(DWARFExpression, RegisterRelativeWithoutFrame) {
+  // Single register relative operations are evaluated without the stack
+  // machine, and fail the same way when there are no registers to read.
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_breg5, 0x78}), llvm::Failed());
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_bregx, 5, 0x78}), llvm::Failed());
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_fbreg, 0x78}), llvm::Failed());
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_breg5, 0x78, DW_OP_deref}),
+                       llvm::Failed());
+}
+
+namespace {
+class AgentTestContext : public AgentExpression::Context {
+public:
+  bool ReadRegister(uint32_t regnum, uint64_t &value) override {
+    if (regnum != 6)
+      return false;
+    value = 0x1008;
+    return true;
+  }
+
+  bool ReadMemory(lldb::addr_t addr, void *buf, size_t size) override {
+    if (addr < 0x1000 || addr + size > 0x1000 + sizeof(m_memory))
+      return false;
+    memcpy(buf, m_memory + (addr - 0x1000), size);
+    return true;
+  }
+
+  uint8_t m_memory[8] = {0x78, 0x56, 0x34, 0x12, 0xfe, 0xff, 0xff, 0xff};
+};
+} // namespace
+
+static llvm::Optional<uint64_t> CompileAndRun(llvm::ArrayRef<uint8_t> location,
+                                              uint32_t byte_size) {
+  DataExtractor extractor(location.data(), location.size(),
+                          lldb::eByteOrderLittle, /*addr_size*/ 8);
+  DWARFExpression expr(/*module*/ nullptr, extractor, /*dwarf_cu*/ nullptr);
+  // Registers are known to the stub by their DWARF number plus one.
+  auto map_register = [](lldb::RegisterKind, uint32_t regnum,
+                         uint32_t &remote_regnum) {
+    remote_regnum = regnum + 1;
+    return true;
+  };
+  auto push_cfa = [](AgentExpression &cfa) {
+    cfa.AppendConstant(0x1010);
+    return true;
+  };
+  AgentExpression agent;
+  if (!expr.CompileToAgentExpression(
+          /*target*/ nullptr, LLDB_INVALID_ADDRESS, LLDB_INVALID_ADDRESS,
+          /*frame_base*/ nullptr, byte_size, map_register, push_cfa, agent))
+    return llvm::None;
+  agent.AppendOpcode(AgentExpression::eOpEnd);
+
+  AgentTestContext context;
+  uint64_t result;
+  if (!agent.Evaluate(context, lldb::eByteOrderLittle, result))
+    return llvm::None;
+  return result;
+}
+
+TEST(DWARFExpression, CompileToAgentExpression) {
+  // [reg5 - 8] and [reg5 - 4]
+  EXPECT_EQ(llvm::Optional<uint64_t>(0x12345678),
+            CompileAndRun({DW_OP_breg5, 0x78}, 4));
+  EXPECT_EQ(llvm::Optional<uint64_t>(0xfffffffe),
+            CompileAndRun({DW_OP_breg5, 0x7c}, 4));
+  EXPECT_EQ(llvm::Optional<uint64_t>(0x5678),
+            CompileAndRun({DW_OP_bregx, 5, 0x78}, 2));
+  // [cfa - 16 + 4]
+  EXPECT_EQ(llvm::Optional<uint64_t>(0xfffffffe),
+            CompileAndRun({DW_OP_call_frame_cfa, DW_OP_lit16, DW_OP_minus,
+                           DW_OP_plus_uconst, 4},
+                          4));
+  // The low byte of reg5.
+  EXPECT_EQ(llvm::Optional<uint64_t>(0x08), CompileAndRun({DW_OP_reg5}, 1));
+  EXPECT_EQ(llvm::Optional<uint64_t>(0x1008), CompileAndRun({DW_OP_reg5}, 8));
+  EXPECT_EQ(llvm::Optional<uint64_t>(42),
+            CompileAndRun({DW_OP_const1u, 42, DW_OP_stack_value}, 4));
+
+  // A register location has to be the whole expression.
+  EXPECT_EQ(llvm::None, CompileAndRun({DW_OP_reg5, DW_OP_lit0}, 4));
+  // No frame base.
+  EXPECT_EQ(llvm::None, CompileAndRun({DW_OP_fbreg, 0x78}, 4));
+  // No target to resolve addresses.
+  EXPECT_EQ(llvm::None,
+            CompileAndRun({DW_OP_addr, 0, 0x10, 0, 0, 0, 0, 0, 0}, 4));
+  // Pieces aren't supported.
+  EXPECT_EQ(llvm::None,
+            CompileAndRun({DW_OP_reg5, DW_OP_piece, 4, DW_OP_reg6,
+                           DW_OP_piece, 4},
+                          8));
+  // Nothing to dereference.
+  EXPECT_EQ(llvm::None, CompileAndRun({DW_OP_deref}, 4));
+  EXPECT_EQ(llvm::None, CompileAndRun({DW_OP_breg5, 0x78}, 3));
+}
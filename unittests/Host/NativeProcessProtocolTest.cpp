@@ -98,6 +98,31 @@ TEST(NativeProcessProtocolTest, ReadMemoryWithoutTrap) {
                        llvm::HasValue(std::vector<uint8_t>{4, 5}));
 }
 
+TEST(NativeProcessProtocolTest, ReadMemoryRangesWithoutTrap) {
+  NiceMock<MockDelegate> DummyDelegate;
+  MockProcess<NativeProcessProtocol> Process(DummyDelegate,
+                                             ArchSpec("aarch64-pc-linux"));
+  FakeMemory M{{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}};
+  EXPECT_CALL(Process, ReadMemory(_, _))
+      .WillRepeatedly(Invoke(&M, &FakeMemory::Read));
+  EXPECT_CALL(Process, WriteMemory(_, _))
+      .WillRepeatedly(Invoke(&M, &FakeMemory::Write));
+
+  EXPECT_THAT_ERROR(Process.SetBreakpoint(0x4, 0, false).ToError(),
+                    llvm::Succeeded());
+
+  uint8_t first[3], second[4], third[2];
+  MemoryReadRange ranges[] = {{0x1, first, sizeof(first), 0},
+                              {0x3, second, sizeof(second), 0},
+                              {0x20, third, sizeof(third), 0}};
+  Process.ReadMemoryRangesWithoutTrap(ranges);
+  EXPECT_EQ(3u, ranges[0].bytes_read);
+  EXPECT_THAT(first, ElementsAre(1, 2, 3));
+  EXPECT_EQ(4u, ranges[1].bytes_read);
+  EXPECT_THAT(second, ElementsAre(3, 4, 5, 6));
+  EXPECT_EQ(0u, ranges[2].bytes_read);
+}
+
 TEST(NativeProcessProtocolTest, ReadCStringFromMemory) {
   NiceMock<MockDelegate> DummyDelegate;
   MockProcess<NativeProcessProtocol> Process(DummyDelegate,
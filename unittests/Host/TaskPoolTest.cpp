@@ -2,6 +2,8 @@
 
 #include "lldb/Host/TaskPool.h"
 
+#include <atomic>
+
 using namespace lldb_private;
 
 TEST(TaskPoolTest, AddTask) {
@@ -43,3 +45,31 @@ TEST(TaskPoolTest, TaskMap) {
   ASSERT_EQ(data[2], 4);
   ASSERT_EQ(data[3], 9);
 }
+
+TEST(TaskPoolTest, NestedTasks) {
+  // Tasks waiting for their own subtasks must not deadlock, even when there
+  // are more waiting tasks than worker threads.
+  std::atomic<int> count{0};
+  TaskMapOverInt(0, 64, [&count](size_t) {
+    TaskMapOverInt(0, 64, [&count](size_t) {
+      TaskPool::RunTasks([&count]() { ++count; }, [&count]() { ++count; });
+    });
+  });
+
+  ASSERT_EQ(64 * 64 * 2, count);
+}
+
+TEST(TaskPoolTest, LowPriorityTask) {
+  std::atomic<int> count{0};
+  auto low_priority = TaskPool::AddLowPriorityTask([&count]() { ++count; });
+  // Waiting on a low priority task blocks until a worker has run it.
+  TaskPool::Wait(low_priority);
+  ASSERT_EQ(1, count);
+
+  // Low priority tasks can still use the pool for their own work.
+  auto nested = TaskPool::AddLowPriorityTask([&count]() {
+    TaskMapOverInt(0, 16, [&count](size_t) { ++count; });
+  });
+  nested.wait();
+  ASSERT_EQ(17, count);
+}
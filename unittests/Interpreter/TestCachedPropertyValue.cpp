@@ -0,0 +1,58 @@
+//===-- TestCachedPropertyValue.cpp -----------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+#include "lldb/Core/UserSettingsController.h"
+#include "lldb/Interpreter/OptionValueBoolean.h"
+#include "lldb/Interpreter/OptionValueUInt64.h"
+
+using namespace lldb_private;
+
+TEST(CachedPropertyValueTest, ReusesValueUntilSettingChanges) {
+  OptionValueBoolean value(true, true);
+  CachedPropertyValue<bool> cache;
+  int lookups = 0;
+  auto lookup = [&] {
+    ++lookups;
+    return value.GetCurrentValue();
+  };
+
+  EXPECT_TRUE(cache.Get(lookup));
+  EXPECT_TRUE(cache.Get(lookup));
+  EXPECT_EQ(1, lookups);
+
+  // Changing the value through "settings set" notifies.
+  ASSERT_TRUE(value.SetValueFromString(llvm::StringRef("false")).Success());
+  EXPECT_FALSE(cache.Get(lookup));
+  EXPECT_EQ(2, lookups);
+
+  // So does changing it through the generic setters.
+  ASSERT_TRUE(value.SetBooleanValue(true));
+  EXPECT_TRUE(cache.Get(lookup));
+  EXPECT_EQ(3, lookups);
+}
+
+TEST(CachedPropertyValueTest, AnyChangeInvalidates) {
+  OptionValueUInt64 count(256, 256);
+  OptionValueBoolean other(false, false);
+  CachedPropertyValue<uint32_t> cache;
+  int lookups = 0;
+  auto lookup = [&]() -> uint32_t {
+    ++lookups;
+    return count.GetCurrentValue();
+  };
+
+  EXPECT_EQ(256u, cache.Get(lookup));
+  ASSERT_TRUE(other.SetBooleanValue(true));
+  EXPECT_EQ(256u, cache.Get(lookup));
+  EXPECT_EQ(2, lookups);
+
+  ASSERT_TRUE(count.SetUInt64Value(1024));
+  EXPECT_EQ(1024u, cache.Get(lookup));
+  EXPECT_EQ(3, lookups);
+}
@@ -15,7 +15,11 @@
 #include "lldb/Core/Section.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Host/HostInfo.h"
+#include "lldb/Symbol/Symtab.h"
+#include "lldb/Utility/ConstStringTable.h"
 #include "lldb/Utility/DataBufferHeap.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/StreamString.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/FileUtilities.h"
@@ -134,6 +138,100 @@ Symbols:
   EXPECT_EQ(text_sp, start->GetAddress().GetSection());
 }
 
+TEST_F(ObjectFileELFTest, SymtabEncodeDecode) {
+  auto ExpectedFile = TestFile::fromYaml(R"(
+--- !ELF
+FileHeader:
+  Class:           ELFCLASS64
+  Data:            ELFDATA2LSB
+  Type:            ET_EXEC
+  Machine:         EM_X86_64
+  Entry:           0x0000000000400180
+Sections:
+  - Name:            .text
+    Type:            SHT_PROGBITS
+    Flags:           [ SHF_ALLOC, SHF_EXECINSTR ]
+    Address:         0x0000000000400180
+    AddressAlign:    0x0000000000000010
+    Content:         554889E58B042500106000890425041060005DC3
+  - Name:            .data
+    Type:            SHT_PROGBITS
+    Flags:           [ SHF_WRITE, SHF_ALLOC ]
+    Address:         0x0000000000601000
+    AddressAlign:    0x0000000000000004
+    Content:         2F000000
+Symbols:
+  - Name:            Y
+    Type:            STT_OBJECT
+    Section:         .data
+    Value:           0x0000000000601000
+    Size:            0x0000000000000004
+    Binding:         STB_GLOBAL
+  - Name:            _ZN3foo3barEv
+    Type:            STT_FUNC
+    Section:         .text
+    Value:           0x0000000000400180
+    Size:            0x0000000000000014
+    Binding:         STB_GLOBAL
+...
+)");
+  ASSERT_THAT_EXPECTED(ExpectedFile, llvm::Succeeded());
+
+  auto module_sp =
+      std::make_shared<Module>(ModuleSpec(FileSpec(ExpectedFile->name())));
+  ObjectFile *objfile = module_sp->GetObjectFile();
+  ASSERT_NE(nullptr, objfile);
+  Symtab *symtab = objfile->GetSymtab();
+  ASSERT_NE(nullptr, symtab);
+
+  ConstStringTable strtab;
+  StreamString body(Stream::eBinary, 8, eByteOrderLittle);
+  ASSERT_TRUE(symtab->Encode(body, strtab));
+  StreamString encoder(Stream::eBinary, 8, eByteOrderLittle);
+  strtab.Encode(encoder);
+  encoder.Write(body.GetData(), body.GetSize());
+
+  DataExtractor data(encoder.GetData(), encoder.GetSize(), eByteOrderLittle,
+                     8);
+  lldb::offset_t offset = 0;
+  ConstStringTable decoded_strtab;
+  ASSERT_TRUE(decoded_strtab.Decode(data, &offset));
+  Symtab decoded(objfile);
+  ASSERT_TRUE(decoded.Decode(data, &offset, decoded_strtab));
+  EXPECT_EQ(encoder.GetSize(), offset);
+
+  ASSERT_EQ(symtab->GetNumSymbols(), decoded.GetNumSymbols());
+  for (size_t i = 0; i < symtab->GetNumSymbols(); ++i) {
+    const Symbol *symbol = symtab->SymbolAtIndex(i);
+    const Symbol *decoded_symbol = decoded.SymbolAtIndex(i);
+    EXPECT_EQ(symbol->GetID(), decoded_symbol->GetID());
+    EXPECT_EQ(symbol->GetType(), decoded_symbol->GetType());
+    EXPECT_EQ(symbol->GetMangled().GetMangledName(),
+              decoded_symbol->GetMangled().GetMangledName());
+    EXPECT_EQ(symbol->GetName(), decoded_symbol->GetName());
+    EXPECT_EQ(symbol->GetAddress(), decoded_symbol->GetAddress());
+    EXPECT_EQ(symbol->GetByteSize(), decoded_symbol->GetByteSize());
+    EXPECT_EQ(symbol->IsExternal(), decoded_symbol->IsExternal());
+  }
+
+  // The indexes are restored as well, so lookups work without recomputing
+  // them.
+  const Symbol *bar = decoded.FindFirstSymbolWithNameAndType(
+      ConstString("foo::bar()"), eSymbolTypeCode, Symtab::eDebugAny,
+      Symtab::eVisibilityAny);
+  ASSERT_NE(nullptr, bar);
+  EXPECT_EQ(ConstString("_ZN3foo3barEv"), bar->GetMangled().GetMangledName());
+  EXPECT_EQ(bar, decoded.FindSymbolContainingFileAddress(0x400184));
+
+  // Truncated data is rejected.
+  DataExtractor truncated(encoder.GetData(), encoder.GetSize() - 1,
+                          eByteOrderLittle, 8);
+  offset = 0;
+  ASSERT_TRUE(decoded_strtab.Decode(truncated, &offset));
+  EXPECT_FALSE(decoded.Decode(truncated, &offset, decoded_strtab));
+  EXPECT_EQ(0u, decoded.GetNumSymbols());
+}
+
 // Test that GetModuleSpecifications works on an "atypical" object file which
 // has section headers right after the ELF header (instead of the more common
 // layout where the section headers are at the very end of the object file).
@@ -359,3 +359,27 @@ TEST_F(GDBRemoteClientBaseTest, SendPacketAndReceiveResponseWithOutputSupport) {
   ASSERT_EQ("OK", response.GetStringRef());
   ASSERT_EQ("Hello, world", command_output.GetString().str());
 }
+
+TEST_F(GDBRemoteClientBaseTest, SendPacketsAndWaitForResponses) {
+  std::vector<std::string> payloads = {"p0", "p1", "p2"};
+  std::vector<StringExtractorGDBRemote> responses;
+  std::future<PacketResult> result = std::async(std::launch::async, [&] {
+    return client.SendPacketsAndWaitForResponses(payloads, responses, false);
+  });
+
+  // All packets should arrive before the first one is answered.
+  StringExtractorGDBRemote request;
+  for (const std::string &payload : payloads) {
+    ASSERT_EQ(PacketResult::Success, server.GetPacket(request));
+    ASSERT_EQ(payload, request.GetStringRef());
+  }
+  ASSERT_EQ(PacketResult::Success, server.SendPacket("00"));
+  ASSERT_EQ(PacketResult::Success, server.SendPacket("E47"));
+  ASSERT_EQ(PacketResult::Success, server.SendPacket("02"));
+
+  ASSERT_EQ(PacketResult::Success, result.get());
+  ASSERT_EQ(3u, responses.size());
+  EXPECT_EQ("00", responses[0].GetStringRef());
+  EXPECT_EQ("E47", responses[1].GetStringRef());
+  EXPECT_EQ("02", responses[2].GetStringRef());
+}
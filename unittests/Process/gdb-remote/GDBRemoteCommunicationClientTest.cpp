@@ -15,6 +15,7 @@
 #include "lldb/Utility/TraceOptions.h"
 #include "lldb/lldb-enumerations.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/Support/FormatVariadic.h"
 #include "llvm/Testing/Support/Error.h"
 #include "gmock/gmock.h"
 #include <future>
@@ -137,6 +138,114 @@ TEST_F(GDBRemoteCommunicationClientTest, ReadRegister) {
             memcmp(buffer_sp->GetBytes(), all_registers, sizeof all_registers));
 }
 
+TEST_F(GDBRemoteCommunicationClientTest, ReadAllRegistersUnsupported) {
+  const lldb::tid_t tid = 0x47;
+  EXPECT_TRUE(client.GetgPacketSupported());
+
+  std::future<DataBufferSP> read_result = std::async(
+      std::launch::async, [&] { return client.ReadAllRegisters(tid); });
+  Handle_QThreadSuffixSupported(server, true);
+  HandlePacket(server, "g;thread:0047;", "E01");
+  EXPECT_FALSE(bool(read_result.get()));
+  // An error doesn't mean the packet isn't implemented.
+  EXPECT_TRUE(client.GetgPacketSupported());
+
+  read_result = std::async(std::launch::async,
+                           [&] { return client.ReadAllRegisters(tid); });
+  HandlePacket(server, "g;thread:0047;", "");
+  EXPECT_FALSE(bool(read_result.get()));
+  EXPECT_FALSE(client.GetgPacketSupported());
+}
+
+TEST_F(GDBRemoteCommunicationClientTest, ReadRegisters) {
+  const lldb::tid_t tid = 0x47;
+  const uint32_t reg_nums[] = {4, 5, 6};
+  std::future<std::vector<DataBufferSP>> read_result =
+      std::async(std::launch::async,
+                 [&] { return client.ReadRegisters(tid, reg_nums); });
+  Handle_QThreadSuffixSupported(server, true);
+  StringExtractorGDBRemote request;
+  for (const char *expected :
+       {"p4;thread:0047;", "p5;thread:0047;", "p6;thread:0047;"}) {
+    ASSERT_EQ(PacketResult::Success, server.GetPacket(request));
+    ASSERT_EQ(expected, request.GetStringRef());
+  }
+  ASSERT_EQ(PacketResult::Success, server.SendPacket(one_register_hex));
+  ASSERT_EQ(PacketResult::Success, server.SendErrorResponse(0x47));
+  ASSERT_EQ(PacketResult::Success, server.SendPacket(all_registers_hex));
+
+  std::vector<DataBufferSP> buffers = read_result.get();
+  ASSERT_EQ(3u, buffers.size());
+  ASSERT_TRUE(bool(buffers[0]));
+  ASSERT_EQ(0, memcmp(buffers[0]->GetBytes(), one_register,
+                      sizeof one_register));
+  ASSERT_FALSE(bool(buffers[1]));
+  ASSERT_TRUE(bool(buffers[2]));
+  ASSERT_EQ(0, memcmp(buffers[2]->GetBytes(), all_registers,
+                      sizeof all_registers));
+}
+
+TEST_F(GDBRemoteCommunicationClientTest, SetExpeditedStackMemory) {
+  std::future<bool> result = std::async(std::launch::async, [&] {
+    return client.SetExpeditedStackMemory(0x400, 0x10);
+  });
+  HandlePacket(server, "QSetExpeditedStackMemory:size:400;frames:10;", "OK");
+  EXPECT_TRUE(result.get());
+
+  result = std::async(std::launch::async, [&] {
+    return client.SetExpeditedStackMemory(0x100000, 8);
+  });
+  HandlePacket(server, "QSetExpeditedStackMemory:size:100000;frames:8;",
+               "E5a");
+  EXPECT_FALSE(result.get());
+}
+
+TEST_F(GDBRemoteCommunicationClientTest, SendGDBStoppointTypePackets) {
+  const std::pair<lldb::addr_t, uint32_t> stoppoints[] = {
+      {0x1000, 1}, {0x2000, 1}, {0x3000, 4}};
+  std::future<std::vector<uint8_t>> result = std::async(std::launch::async, [&] {
+    return client.SendGDBStoppointTypePackets(eBreakpointSoftware, true,
+                                              stoppoints);
+  });
+  StringExtractorGDBRemote request;
+  for (const char *expected : {"Z0,1000,1", "Z0,2000,1", "Z0,3000,4"}) {
+    ASSERT_EQ(PacketResult::Success, server.GetPacket(request));
+    ASSERT_EQ(expected, request.GetStringRef());
+  }
+  ASSERT_EQ(PacketResult::Success, server.SendOKResponse());
+  ASSERT_EQ(PacketResult::Success, server.SendErrorResponse(0x16));
+  ASSERT_EQ(PacketResult::Success, server.SendOKResponse());
+  EXPECT_EQ((std::vector<uint8_t>{0, 0x16, 0}), result.get());
+  EXPECT_TRUE(client.SupportsGDBStoppointPacket(eBreakpointSoftware));
+
+  result = std::async(std::launch::async, [&] {
+    return client.SendGDBStoppointTypePackets(eBreakpointSoftware, false,
+                                              stoppoints);
+  });
+  for (const char *expected : {"z0,1000,1", "z0,2000,1", "z0,3000,4"})
+    HandlePacket(server, expected, "");
+  EXPECT_EQ((std::vector<uint8_t>{UINT8_MAX, UINT8_MAX, UINT8_MAX}),
+            result.get());
+  EXPECT_FALSE(client.SupportsGDBStoppointPacket(eBreakpointSoftware));
+}
+
+TEST_F(GDBRemoteCommunicationClientTest, SendGDBStoppointTypePacketConditions) {
+  AgentExpression is_one;
+  is_one.AppendRegister(6);
+  is_one.AppendConstant(1);
+  is_one.AppendOpcode(AgentExpression::eOpEqual);
+  is_one.AppendOpcode(AgentExpression::eOpEnd);
+  AgentExpression always({0x22, 0x01, 0x27});
+  const AgentExpression conditions[] = {is_one, always};
+
+  std::future<uint8_t> result = std::async(std::launch::async, [&] {
+    return client.SendGDBStoppointTypePacket(eBreakpointSoftware, true, 0x1000,
+                                             1, conditions);
+  });
+  HandlePacket(server, "Z0,1000,1;X7,26000622011327;X3,220127", "OK");
+  EXPECT_EQ(0, result.get());
+}
+
 TEST_F(GDBRemoteCommunicationClientTest, SaveRestoreRegistersNoSuffix) {
   const lldb::tid_t tid = 0x47;
   uint32_t save_id;
@@ -320,6 +429,138 @@ TEST_F(GDBRemoteCommunicationClientTest, SendSignalsToIgnore) {
   EXPECT_TRUE(result.get().Success());
 }
 
+TEST_F(GDBRemoteCommunicationClientTest, ReadMemoryRanges) {
+  std::vector<Range<lldb::addr_t, size_t>> ranges = {
+      {0x1000, 4}, {0x2000, 2}, {0x3000, 3}};
+  uint8_t buf[9] = {0};
+  std::vector<size_t> bytes_read;
+  std::future<Status> result = std::async(std::launch::async, [&] {
+    return client.ReadMemoryRanges(ranges, buf, bytes_read);
+  });
+
+  HandlePacket(server, "MultiMemRead:ranges:1000,4,2000,2,3000,3;",
+               "4,0,2;ABCDEF");
+  ASSERT_TRUE(result.get().Success());
+  EXPECT_THAT(bytes_read, testing::ElementsAre(4u, 0u, 2u));
+  EXPECT_EQ(0, memcmp(buf, "ABCD", 4));
+  EXPECT_EQ(0, memcmp(buf + 6, "EF", 2));
+
+  // Fewer sizes than ranges.
+  result = std::async(std::launch::async, [&] {
+    return client.ReadMemoryRanges(ranges, buf, bytes_read);
+  });
+  HandlePacket(server, "MultiMemRead:ranges:1000,4,2000,2,3000,3;",
+               "4,0;ABCD");
+  EXPECT_FALSE(result.get().Success());
+
+  // More data than the sizes add up to.
+  result = std::async(std::launch::async, [&] {
+    return client.ReadMemoryRanges(ranges, buf, bytes_read);
+  });
+  HandlePacket(server, "MultiMemRead:ranges:1000,4,2000,2,3000,3;",
+               "4,0,0;ABCDEF");
+  EXPECT_FALSE(result.get().Success());
+
+  result = std::async(std::launch::async, [&] {
+    return client.ReadMemoryRanges(ranges, buf, bytes_read);
+  });
+  HandlePacket(server, "MultiMemRead:ranges:1000,4,2000,2,3000,3;", "E08");
+  EXPECT_FALSE(result.get().Success());
+}
+
+TEST_F(GDBRemoteCommunicationClientTest, SearchMemory) {
+  const uint8_t pattern[] = {'a', 'b', 'c'};
+  lldb::addr_t found_addr = 0;
+  std::future<bool> result = std::async(std::launch::async, [&] {
+    return client.SearchMemory(0x1000, 0x2000, pattern, found_addr);
+  });
+  HandlePacket(server, "qSearch:memory:1000;2000;abc", "1,1a2b");
+  ASSERT_TRUE(result.get());
+  EXPECT_EQ(0x1a2bu, found_addr);
+
+  result = std::async(std::launch::async, [&] {
+    return client.SearchMemory(0x1000, 0x2000, pattern, found_addr);
+  });
+  HandlePacket(server, "qSearch:memory:1000;2000;abc", "0");
+  ASSERT_TRUE(result.get());
+  EXPECT_EQ(LLDB_INVALID_ADDRESS, found_addr);
+
+  result = std::async(std::launch::async, [&] {
+    return client.SearchMemory(0x1000, 0x2000, pattern, found_addr);
+  });
+  HandlePacket(server, "qSearch:memory:1000;2000;abc", "E01");
+  EXPECT_FALSE(result.get());
+
+  // Once the server said it doesn't know the packet, it isn't sent again.
+  result = std::async(std::launch::async, [&] {
+    return client.SearchMemory(0x1000, 0x2000, pattern, found_addr);
+  });
+  HandlePacket(server, "qSearch:memory:1000;2000;abc", "");
+  EXPECT_FALSE(result.get());
+  EXPECT_FALSE(client.SearchMemory(0x1000, 0x2000, pattern, found_addr));
+}
+
+TEST_F(GDBRemoteCommunicationClientTest, Snapshots) {
+  lldb::user_id_t snapshot_id = LLDB_INVALID_UID;
+  std::future<Status> result = std::async(std::launch::async, [&] {
+    return client.SaveSnapshot(snapshot_id);
+  });
+  HandlePacket(server, "QSaveSnapshot", "3039");
+  ASSERT_TRUE(result.get().Success());
+  EXPECT_EQ(0x3039u, snapshot_id);
+
+  lldb::pid_t pid = LLDB_INVALID_PROCESS_ID;
+  result = std::async(std::launch::async, [&] {
+    return client.RestoreSnapshot(0x3039, pid);
+  });
+  HandlePacket(server, "QRestoreSnapshot:3039", "303a");
+  ASSERT_TRUE(result.get().Success());
+  EXPECT_EQ(0x303au, pid);
+  // The client knows the new process without asking.
+  EXPECT_EQ(0x303au, client.GetCurrentProcessID());
+
+  result = std::async(std::launch::async,
+                      [&] { return client.DeleteSnapshot(0x3039); });
+  HandlePacket(server, "QDeleteSnapshot:3039", "OK");
+  EXPECT_TRUE(result.get().Success());
+
+  result = std::async(std::launch::async, [&] {
+    return client.RestoreSnapshot(0x3039, pid);
+  });
+  HandlePacket(server, "QRestoreSnapshot:3039", "E01");
+  EXPECT_FALSE(result.get().Success());
+
+  result = std::async(std::launch::async, [&] {
+    return client.SaveSnapshot(snapshot_id);
+  });
+  HandlePacket(server, "QSaveSnapshot", "");
+  EXPECT_FALSE(result.get().Success());
+}
+
+TEST_F(GDBRemoteCommunicationClientTest, Tracepoints) {
+  std::future<Status> result = std::async(std::launch::async, [&] {
+    const uint32_t registers[] = {5, 0x1a};
+    return client.SetTracepoint(0x1000, registers);
+  });
+  HandlePacket(server, "QSetTracepoint:1000;5,1a", "OK");
+  EXPECT_TRUE(result.get().Success());
+
+  result = std::async(std::launch::async,
+                      [&] { return client.SetTracepoint(0x2000, {}); });
+  HandlePacket(server, "QSetTracepoint:2000", "E01");
+  EXPECT_FALSE(result.get().Success());
+
+  result = std::async(std::launch::async,
+                      [&] { return client.ClearTracepoint(0x1000); });
+  HandlePacket(server, "QClearTracepoint:1000", "OK");
+  EXPECT_TRUE(result.get().Success());
+
+  result = std::async(std::launch::async,
+                      [&] { return client.ClearTracepoint(0x1000); });
+  HandlePacket(server, "QClearTracepoint:1000", "");
+  EXPECT_FALSE(result.get().Success());
+}
+
 TEST_F(GDBRemoteCommunicationClientTest, GetMemoryRegionInfo) {
   const lldb::addr_t addr = 0xa000;
   MemoryRegionInfo region_info;
@@ -434,6 +675,8 @@ TEST_F(GDBRemoteCommunicationClientTest, SendGetDataPacket) {
     return client.SendGetDataPacket(trace_id, thread_id, buffer, offset);
   });
 
+  // A stub without jTraceBinary+ gets asked for hex.
+  HandlePacket(server, testing::StartsWith("qSupported:"), "");
   std::string expected_packet1 =
       R"(jTraceBufferRead:{"buffersize" : 32,"offset" : 0,"threadid" : 35,)";
   std::string expected_packet2 = R"("traceid" : 3})";
@@ -454,6 +697,36 @@ TEST_F(GDBRemoteCommunicationClientTest, SendGetDataPacket) {
   ASSERT_EQ(buffer2.size(), 0u);
 }
 
+TEST_F(GDBRemoteCommunicationClientTest, SendGetDataPacketBinary) {
+  lldb::tid_t thread_id = 0x23;
+  lldb::user_id_t trace_id = 3;
+
+  uint8_t buf[32] = {};
+  llvm::MutableArrayRef<uint8_t> buffer(buf, 32);
+  size_t offset = 0;
+
+  std::future<Status> result = std::async(std::launch::async, [&] {
+    return client.SendGetDataPacket(trace_id, thread_id, buffer, offset);
+  });
+
+  // The buffer is read in packets of at most PacketSize bytes, until a reply
+  // comes back short.
+  HandlePacket(server, testing::StartsWith("qSupported:"),
+               "PacketSize=10;jTraceBinary+");
+  HandlePacket(server,
+               R"(jTraceBufferRead:{"binary" : true,"buffersize" : 16,)"
+               R"("offset" : 0,"threadid" : 35,"traceid" : 3})",
+               "0123456789abcdef");
+  HandlePacket(server,
+               R"(jTraceBufferRead:{"binary" : true,"buffersize" : 16,)"
+               R"("offset" : 16,"threadid" : 35,"traceid" : 3})",
+               "xyz");
+  ASSERT_TRUE(result.get().Success());
+  ASSERT_EQ(buffer.size(), 19u);
+  EXPECT_EQ(llvm::StringRef(reinterpret_cast<char *>(buf), 19),
+            "0123456789abcdefxyz");
+}
+
 TEST_F(GDBRemoteCommunicationClientTest, SendGetMetaDataPacket) {
   lldb::tid_t thread_id = 0x23;
   lldb::user_id_t trace_id = 3;
@@ -466,6 +739,7 @@ TEST_F(GDBRemoteCommunicationClientTest, SendGetMetaDataPacket) {
     return client.SendGetMetaDataPacket(trace_id, thread_id, buffer, offset);
   });
 
+  HandlePacket(server, testing::StartsWith("qSupported:"), "");
   std::string expected_packet1 =
       R"(jTraceMetaRead:{"buffersize" : 32,"offset" : 0,"threadid" : 35,)";
   std::string expected_packet2 = R"("traceid" : 3})";
@@ -554,3 +828,101 @@ TEST_F(GDBRemoteCommunicationClientTest, SendGetTraceConfigPacket) {
       incorrect_custom_params2);
   ASSERT_FALSE(result4.get().Success());
 }
+
+TEST_F(GDBRemoteCommunicationClientTest, GetThreadsInfoDelta) {
+  // '}' is escaped as "}]" in the responses below.
+  std::future<StructuredData::ObjectSP> result =
+      std::async(std::launch::async, [&] { return client.GetThreadsInfo(); });
+  HandlePacket(server, testing::StartsWith("qSupported:"),
+               "jThreadsInfo-delta+");
+  HandlePacket(server, "jThreadsInfo:{}",
+               R"({"generation":1,"threads":[{"tid":1,"reason":"trace"}],)"
+               R"({"tid":2,"name":"worker"}]]}])");
+  StructuredData::ObjectSP threads_sp = result.get();
+  ASSERT_TRUE(threads_sp && threads_sp->GetAsArray());
+  EXPECT_EQ(2u, threads_sp->GetAsArray()->GetSize());
+
+  // Thread 1 changed, thread 2 didn't and thread 3 is new.
+  result =
+      std::async(std::launch::async, [&] { return client.GetThreadsInfo(); });
+  HandlePacket(server, R"(jThreadsInfo:{"generation":1})",
+               R"({"generation":2,"base-generation":1,"threads":)"
+               R"([{"tid":1,"reason":"breakpoint"}],)"
+               R"({"tid":2,"unchanged":true}],{"tid":3}]]}])");
+  threads_sp = result.get();
+  ASSERT_TRUE(threads_sp && threads_sp->GetAsArray());
+  StructuredData::Array *threads = threads_sp->GetAsArray();
+  ASSERT_EQ(3u, threads->GetSize());
+  llvm::StringRef reason, name;
+  uint64_t tid;
+  ASSERT_TRUE(threads->GetItemAtIndex(0)->GetAsDictionary());
+  ASSERT_TRUE(threads->GetItemAtIndex(0)->GetAsDictionary()
+                  ->GetValueForKeyAsString("reason", reason));
+  EXPECT_EQ("breakpoint", reason);
+  ASSERT_TRUE(threads->GetItemAtIndex(1)->GetAsDictionary());
+  ASSERT_TRUE(threads->GetItemAtIndex(1)->GetAsDictionary()
+                  ->GetValueForKeyAsString("name", name));
+  EXPECT_EQ("worker", name);
+  ASSERT_TRUE(threads->GetItemAtIndex(2)->GetAsDictionary());
+  ASSERT_TRUE(threads->GetItemAtIndex(2)->GetAsDictionary()
+                  ->GetValueForKeyAsInteger("tid", tid));
+  EXPECT_EQ(3u, tid);
+
+  // A delta against thread infos we don't have makes us ask for all of them.
+  result =
+      std::async(std::launch::async, [&] { return client.GetThreadsInfo(); });
+  HandlePacket(server, R"(jThreadsInfo:{"generation":2})",
+               R"({"generation":5,"base-generation":4,"threads":)"
+               R"([{"tid":2,"unchanged":true}]]}])");
+  HandlePacket(server, "jThreadsInfo:{}",
+               R"({"generation":5,"threads":[{"tid":2}]]}])");
+  threads_sp = result.get();
+  ASSERT_TRUE(threads_sp && threads_sp->GetAsArray());
+  EXPECT_EQ(1u, threads_sp->GetAsArray()->GetSize());
+}
+
+TEST_F(GDBRemoteCommunicationClientTest, ReadFileInChunks) {
+  const llvm::StringRef contents = "abcdefghij";
+  std::string data;
+  std::future<Status> result = std::async(std::launch::async, [&] {
+    return client.ReadFileInChunks(7, 4, [&](llvm::StringRef chunk) {
+      data += chunk.str();
+      return Status();
+    });
+  });
+
+  // The reads are sent a batch at a time. After the short read at the end of
+  // the file, the client reads again from there and sees the end.
+  StringExtractorGDBRemote request;
+  for (uint64_t start : {0, 10}) {
+    std::vector<uint64_t> offsets;
+    for (uint64_t i = 0; i < 16; ++i) {
+      ASSERT_EQ(PacketResult::Success, server.GetPacket(request));
+      uint64_t offset = start + i * 4;
+      ASSERT_EQ(llvm::formatv("vFile:pread:7,4,{0}", offset).str(),
+                request.GetStringRef());
+      offsets.push_back(offset);
+    }
+    for (uint64_t offset : offsets) {
+      llvm::StringRef chunk = contents.substr(offset, 4);
+      ASSERT_EQ(PacketResult::Success,
+                server.SendPacket(
+                    llvm::formatv("F{0};{1}", chunk.size(), chunk).str()));
+    }
+  }
+  ASSERT_TRUE(result.get().Success());
+  EXPECT_EQ(contents, data);
+
+  result = std::async(std::launch::async, [&] {
+    return client.ReadFileInChunks(7, 4, [](llvm::StringRef chunk) {
+      return Status("unexpected data");
+    });
+  });
+  for (uint64_t i = 0; i < 16; ++i)
+    ASSERT_EQ(PacketResult::Success, server.GetPacket(request));
+  for (uint64_t i = 0; i < 16; ++i)
+    ASSERT_EQ(PacketResult::Success, server.SendPacket("F-1,9"));
+  Status error = result.get();
+  ASSERT_TRUE(error.Fail());
+  EXPECT_EQ(9u, error.GetError());
+}
@@ -6,6 +6,8 @@
 //
 //===----------------------------------------------------------------------===//
 #include "GDBRemoteTestUtils.h"
+#include "lldb/Host/Config.h"
+#include "llvm/Support/FormatVariadic.h"
 #include "llvm/Testing/Support/Error.h"
 
 using namespace lldb_private::process_gdb_remote;
@@ -24,6 +26,14 @@ public:
     return GDBRemoteCommunication::ReadPacket(response, std::chrono::seconds(1),
                                               /*sync_on_timeout*/ false);
   }
+
+  PacketResult SendPacket(llvm::StringRef payload) {
+    return GDBRemoteCommunication::SendPacketNoLock(payload);
+  }
+
+  void SetNoAckMode() { m_send_acks = false; }
+
+  void SetCompressionType(CompressionType type) { m_compression_type = type; }
 };
 
 class GDBRemoteCommunicationTest : public GDBRemoteTest {
@@ -55,6 +65,7 @@ TEST_F(GDBRemoteCommunicationTest, ReadPacket_checksum) {
       {{"$foobar#79"}, {"foobar"}},
       {{"$}}#fa"}, {"]"}},
       {{"$x*%#c7"}, {"xxxxxxxxx"}},
+      {{"$ab}}cd*!#cf"}, {"ab]cddddd"}},
   };
   for (const auto &Test : Tests) {
     SCOPED_TRACE(Test.Packet + " -> " + Test.Payload);
@@ -65,3 +76,49 @@ TEST_F(GDBRemoteCommunicationTest, ReadPacket_checksum) {
     ASSERT_EQ(PacketResult::Success, server.GetAck());
   }
 }
+
+TEST_F(GDBRemoteCommunicationTest, ReadPacket_split) {
+  client.SetNoAckMode();
+
+  // A packet arriving in pieces, followed by another one in the same write.
+  StringExtractorGDBRemote response;
+  ASSERT_TRUE(Write("$foo"));
+  ASSERT_TRUE(Write("bar#79$x*%#c7"));
+  ASSERT_EQ(PacketResult::Success, client.ReadPacket(response));
+  ASSERT_EQ("foobar", response.GetStringRef());
+  ASSERT_EQ(PacketResult::Success, client.ReadPacket(response));
+  ASSERT_EQ("xxxxxxxxx", response.GetStringRef());
+}
+
+#if defined(HAVE_LIBZ)
+TEST_F(GDBRemoteCommunicationTest, CompressedPackets) {
+  client.SetNoAckMode();
+
+  StringExtractorGDBRemote response;
+  Status error;
+  bool interrupt = false, quit = false;
+  ASSERT_EQ(PacketResult::Success,
+            client.SendPacket("QEnableCompression:type:zlib-deflate;"
+                              "minsize:16;"));
+  ASSERT_EQ(PacketResult::Success,
+            server.GetPacketAndSendResponse(std::chrono::seconds(1), error,
+                                            interrupt, quit));
+  ASSERT_EQ(PacketResult::Success, client.ReadPacket(response));
+  ASSERT_EQ("OK", response.GetStringRef());
+  client.SetCompressionType(CompressionType::ZlibDeflate);
+
+  // Packets below the minimum size are sent uncompressed, larger ones are
+  // compressed. Use a payload that does not compress too well, so that the
+  // compressed data contains characters which need to be escaped.
+  std::string large;
+  for (uint32_t i = 0; i < 256; ++i)
+    large += llvm::formatv("{0:x-8}", i * 2654435761u).str();
+  const std::string payloads[] = {"E47", large};
+  for (const std::string &payload : payloads) {
+    SCOPED_TRACE(payload);
+    ASSERT_EQ(PacketResult::Success, server.SendPacket(payload));
+    ASSERT_EQ(PacketResult::Success, client.ReadPacket(response));
+    ASSERT_EQ(payload, response.GetStringRef());
+  }
+}
+#endif
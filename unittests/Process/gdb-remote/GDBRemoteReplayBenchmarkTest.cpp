@@ -0,0 +1,190 @@
+//===-- GDBRemoteReplayBenchmarkTest.cpp ------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Replays recorded gdb-remote sessions against the client over a simulated
+// link and reports how long each phase of a session took.
+//
+// A session is a list of packet histories, one per phase (attach, stop,
+// backtrace, ...), recorded one after the other on the same connection. The
+// first phase starts with the handshake. By default a small session in
+// Inputs is replayed, which keeps the harness itself working. To benchmark
+// real sessions, point LLDB_REPLAY_BENCHMARK_SESSIONS at a directory with
+// one subdirectory per session, holding one .yaml history per phase. The
+// phases are replayed in the order of their file names. The simulated link
+// is set with LLDB_REPLAY_BENCHMARK_LATENCY_US, the round trip time in
+// microseconds, and LLDB_REPLAY_BENCHMARK_BYTES_PER_SECOND.
+
+#include "GDBRemoteTestUtils.h"
+#include "TestingSupport/TestUtilities.h"
+
+#include "Plugins/Process/gdb-remote/GDBRemoteCommunicationClient.h"
+#include "Plugins/Process/gdb-remote/GDBRemoteCommunicationHistory.h"
+#include "Plugins/Process/gdb-remote/GDBRemoteCommunicationReplayServer.h"
+#include "lldb/Utility/FileSpec.h"
+#include "lldb/Utility/StringExtractorGDBRemote.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Testing/Support/Error.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace lldb_private::process_gdb_remote;
+using namespace lldb_private;
+using namespace lldb;
+using namespace llvm;
+
+namespace {
+
+typedef GDBRemoteCommunication::PacketResult PacketResult;
+
+struct Session {
+  std::string name;
+  /// The packet history of each phase, in order.
+  std::vector<std::string> phases;
+};
+
+uint64_t GetEnvironmentValue(const char *name) {
+  const char *value = std::getenv(name);
+  uint64_t result = 0;
+  if (value)
+    StringRef(value).getAsInteger(0, result);
+  return result;
+}
+
+std::vector<Session> GetSessions() {
+  std::vector<Session> sessions;
+  const char *sessions_dir = std::getenv("LLDB_REPLAY_BENCHMARK_SESSIONS");
+  if (!sessions_dir) {
+    Session session;
+    session.name = "replay-session";
+    for (const char *phase : {"1-attach", "2-stop", "3-backtrace",
+                              "4-variables"})
+      session.phases.push_back(
+          GetInputFilePath(formatv("replay-session-{0}.yaml", phase)));
+    sessions.push_back(std::move(session));
+    return sessions;
+  }
+
+  std::error_code ec;
+  for (sys::fs::directory_iterator dir(sessions_dir, ec), end;
+       !ec && dir != end; dir.increment(ec)) {
+    if (dir->type() != sys::fs::file_type::directory_file)
+      continue;
+    Session session;
+    session.name = sys::path::filename(dir->path()).str();
+    for (sys::fs::directory_iterator file(dir->path(), ec), file_end;
+         !ec && file != file_end; file.increment(ec)) {
+      if (sys::path::extension(file->path()) == ".yaml")
+        session.phases.push_back(file->path());
+    }
+    llvm::sort(session.phases);
+    if (!session.phases.empty())
+      sessions.push_back(std::move(session));
+  }
+  llvm::sort(sessions, [](const Session &lhs, const Session &rhs) {
+    return lhs.name < rhs.name;
+  });
+  return sessions;
+}
+
+/// Return the payloads of the packets the client sent in the history at
+/// \a path, in order.
+Expected<std::vector<std::string>> GetClientPackets(StringRef path) {
+  auto buffer_or_error = MemoryBuffer::getFile(path);
+  if (!buffer_or_error)
+    return errorCodeToError(buffer_or_error.getError());
+  std::vector<GDBRemoteCommunicationHistory::Entry> history;
+  yaml::Input yin((*buffer_or_error)->getBuffer());
+  yin >> history;
+  if (yin.error())
+    return errorCodeToError(yin.error());
+
+  std::vector<std::string> packets;
+  for (const GDBRemoteCommunicationHistory::Entry &entry : history) {
+    if (entry.type != GDBRemoteCommunicationHistory::ePacketTypeSend)
+      continue;
+    // Acks and interrupts get no reply. The replay server answers stops
+    // with the packet that resumed the process.
+    StringRef packet = entry.packet.data;
+    if (!packet.consume_front("$"))
+      continue;
+    packets.push_back(packet.rsplit('#').first.str());
+  }
+  return std::move(packets);
+}
+
+} // end anonymous namespace
+
+class GDBRemoteReplayBenchmarkTest : public GDBRemoteTest {};
+
+TEST_F(GDBRemoteReplayBenchmarkTest, ReplaySessions) {
+  const std::chrono::microseconds latency(
+      GetEnvironmentValue("LLDB_REPLAY_BENCHMARK_LATENCY_US"));
+  const uint64_t bytes_per_second =
+      GetEnvironmentValue("LLDB_REPLAY_BENCHMARK_BYTES_PER_SECOND");
+
+  std::vector<Session> sessions = GetSessions();
+  ASSERT_FALSE(sessions.empty());
+
+  for (const Session &session : sessions) {
+    SCOPED_TRACE(session.name);
+    GDBRemoteCommunicationClient client;
+    GDBRemoteCommunicationReplayServer server;
+    server.SetSimulatedLink(latency, bytes_per_second);
+    ASSERT_THAT_ERROR(GDBRemoteCommunication::ConnectLocally(client, server),
+                      Succeeded());
+
+    bool started = false;
+    for (const std::string &phase : session.phases) {
+      SCOPED_TRACE(phase);
+      Expected<std::vector<std::string>> packets = GetClientPackets(phase);
+      ASSERT_THAT_EXPECTED(packets, Succeeded());
+      ASSERT_THAT_ERROR(server.LoadReplayHistory(FileSpec(phase)),
+                        Succeeded());
+
+      auto start = std::chrono::steady_clock::now();
+      size_t bytes = 0;
+      ArrayRef<std::string> to_send = *packets;
+      if (!started) {
+        // The client does the handshake itself, which sends the first
+        // packet.
+        ASSERT_TRUE(server.StartAsyncThread());
+        Status error;
+        ASSERT_TRUE(client.HandshakeWithServer(&error)) << error.AsCString();
+        ASSERT_FALSE(to_send.empty());
+        ASSERT_EQ("QStartNoAckMode", to_send.front());
+        to_send = to_send.drop_front();
+        started = true;
+      }
+      for (const std::string &packet : to_send) {
+        StringExtractorGDBRemote response;
+        ASSERT_EQ(PacketResult::Success,
+                  client.SendPacketAndWaitForResponse(packet, response,
+                                                      false))
+            << packet;
+        bytes += packet.size() + response.GetStringRef().size();
+      }
+      auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start);
+
+      llvm::outs() << formatv("{0,-24} {1,-24} {2,6} packets {3,10} bytes "
+                              "{4,10} us\n",
+                              session.name, sys::path::stem(phase),
+                              packets->size(), bytes, elapsed.count());
+    }
+    server.StopAsyncThread();
+  }
+}
@@ -290,6 +290,33 @@ Streams:
   EXPECT_EQ(llvm::None, parser->FindMemoryRange(0x7ffceb34a000 + 5));
 }
 
+TEST_F(MinidumpParserTest, FindMemoryRangeAdjacentRanges) {
+  ASSERT_THAT_ERROR(SetUpFromYaml(R"(
+--- !minidump
+Streams:
+  - Type:            MemoryList
+    Memory Ranges:
+      - Start of Memory Range: 0x0000000000002004
+        Content:         0506
+      - Start of Memory Range: 0x0000000000002000
+        Content:         01020304
+      - Start of Memory Range: 0x0000000000001000
+        Content:         AA
+...
+)"),
+                    llvm::Succeeded());
+  EXPECT_EQ(llvm::None, parser->FindMemoryRange(0xfff));
+  EXPECT_EQ((minidump::Range{0x1000, llvm::ArrayRef<uint8_t>{0xaa}}),
+            parser->FindMemoryRange(0x1000));
+  EXPECT_EQ(llvm::None, parser->FindMemoryRange(0x1001));
+  EXPECT_EQ(
+      (minidump::Range{0x2000, llvm::ArrayRef<uint8_t>{0x01, 0x02, 0x03, 0x04}}),
+      parser->FindMemoryRange(0x2003));
+  EXPECT_EQ((minidump::Range{0x2004, llvm::ArrayRef<uint8_t>{0x05, 0x06}}),
+            parser->FindMemoryRange(0x2004));
+  EXPECT_EQ(llvm::None, parser->FindMemoryRange(0x2006));
+}
+
 TEST_F(MinidumpParserTest, GetMemory) {
   ASSERT_THAT_ERROR(SetUpFromYaml(R"(
 --- !minidump
@@ -0,0 +1,147 @@
+//===-- LineTableTest.cpp ---------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/ObjectFile/ELF/ObjectFileELF.h"
+#include "Plugins/SymbolFile/Symtab/SymbolFileSymtab.h"
+#include "TestingSupport/TestUtilities.h"
+
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleSpec.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Symbol/CompileUnit.h"
+#include "lldb/Symbol/LineTable.h"
+#include "llvm/Testing/Support/Error.h"
+
+using namespace lldb_private;
+using namespace lldb;
+
+class LineTableTest : public testing::Test {
+public:
+  void SetUp() override {
+    FileSystem::Initialize();
+    HostInfo::Initialize();
+    ObjectFileELF::Initialize();
+    SymbolFileSymtab::Initialize();
+  }
+
+  void TearDown() override {
+    SymbolFileSymtab::Terminate();
+    ObjectFileELF::Terminate();
+    HostInfo::Terminate();
+    FileSystem::Terminate();
+  }
+};
+
+// Append a sequence of \a count rows starting at \a file_addr, and return the
+// address of its terminal entry.
+static addr_t AddSequence(LineTable &table, addr_t file_addr, uint32_t count,
+                          uint32_t first_line) {
+  std::unique_ptr<LineSequence> sequence(table.CreateLineSequenceContainer());
+  for (uint32_t i = 0; i < count; ++i) {
+    table.AppendLineEntryToSequence(sequence.get(), file_addr,
+                                    first_line + (i * 7) % 13, i % 5, i % 2,
+                                    i % 3 == 0, false, i == 1, false, false);
+    file_addr += 1 + i % 9;
+  }
+  table.AppendLineEntryToSequence(sequence.get(), file_addr, first_line, 0, 0,
+                                  false, false, false, false, true);
+  table.InsertSequence(sequence.get());
+  return file_addr;
+}
+
+static void FillLineTable(LineTable &table) {
+  // The second sequence starts where the first one ends, and the third one is
+  // inserted out of order.
+  addr_t end = AddSequence(table, 0x1000, 150, 10);
+  AddSequence(table, 0x1800, 20, 1000);
+  AddSequence(table, end, 200, 100000);
+}
+
+TEST_F(LineTableTest, Compact) {
+  auto ExpectedFile = TestFile::fromYaml(R"(
+--- !ELF
+FileHeader:
+  Class:           ELFCLASS64
+  Data:            ELFDATA2LSB
+  Type:            ET_DYN
+  Machine:         EM_X86_64
+Sections:
+  - Name:            .text
+    Type:            SHT_PROGBITS
+    Flags:           [ SHF_ALLOC, SHF_EXECINSTR ]
+    Address:         0x0000000000001000
+    AddressAlign:    0x0000000000000010
+    Size:            0x0000000000001000
+...
+)");
+  ASSERT_THAT_EXPECTED(ExpectedFile, llvm::Succeeded());
+
+  auto module_sp =
+      std::make_shared<Module>(ModuleSpec(FileSpec(ExpectedFile->name())));
+  auto comp_unit_sp = std::make_shared<CompileUnit>(
+      module_sp, nullptr, "a.c", 0, eLanguageTypeC, eLazyBoolNo);
+
+  LineTable expected(comp_unit_sp.get());
+  LineTable compacted(comp_unit_sp.get());
+  FillLineTable(expected);
+  FillLineTable(compacted);
+  compacted.Compact();
+  ASSERT_EQ(expected.GetSize(), compacted.GetSize());
+
+  auto ExpectSameLineEntry = [](const LineEntry &lhs, const LineEntry &rhs) {
+    EXPECT_EQ(lhs.range.GetBaseAddress().GetFileAddress(),
+              rhs.range.GetBaseAddress().GetFileAddress());
+    EXPECT_EQ(lhs.range.GetByteSize(), rhs.range.GetByteSize());
+    EXPECT_EQ(lhs.line, rhs.line);
+    EXPECT_EQ(lhs.column, rhs.column);
+    EXPECT_EQ(lhs.is_start_of_statement, rhs.is_start_of_statement);
+    EXPECT_EQ(lhs.is_start_of_basic_block, rhs.is_start_of_basic_block);
+    EXPECT_EQ(lhs.is_prologue_end, rhs.is_prologue_end);
+    EXPECT_EQ(lhs.is_terminal_entry, rhs.is_terminal_entry);
+  };
+
+  for (uint32_t idx = 0; idx < expected.GetSize(); ++idx) {
+    LineEntry expected_entry, compacted_entry;
+    ASSERT_TRUE(expected.GetLineEntryAtIndex(idx, expected_entry));
+    ASSERT_TRUE(compacted.GetLineEntryAtIndex(idx, compacted_entry));
+    ExpectSameLineEntry(expected_entry, compacted_entry);
+  }
+
+  for (addr_t file_addr = 0x1000; file_addr < 0x2000; ++file_addr) {
+    Address so_addr;
+    ASSERT_TRUE(module_sp->ResolveFileAddress(file_addr, so_addr));
+    LineEntry expected_entry, compacted_entry;
+    uint32_t expected_idx, compacted_idx;
+    const bool found =
+        expected.FindLineEntryByAddress(so_addr, expected_entry, &expected_idx);
+    ASSERT_EQ(found, compacted.FindLineEntryByAddress(so_addr, compacted_entry,
+                                                      &compacted_idx))
+        << "address " << file_addr;
+    EXPECT_EQ(expected_idx, compacted_idx) << "address " << file_addr;
+    if (found)
+      ExpectSameLineEntry(expected_entry, compacted_entry);
+  }
+
+  EXPECT_EQ(expected.FindLineEntryIndexByFileIndex(0, 3, 100005, false, nullptr),
+            compacted.FindLineEntryIndexByFileIndex(0, 3, 100005, false,
+                                                    nullptr));
+
+  // Inserting into a compacted table expands it again.
+  AddSequence(expected, 0x1c00, 10, 7);
+  AddSequence(compacted, 0x1c00, 10, 7);
+  ASSERT_EQ(expected.GetSize(), compacted.GetSize());
+  LineEntry expected_entry, compacted_entry;
+  ASSERT_TRUE(
+      expected.GetLineEntryAtIndex(expected.GetSize() - 1, expected_entry));
+  ASSERT_TRUE(
+      compacted.GetLineEntryAtIndex(compacted.GetSize() - 1, compacted_entry));
+  ExpectSameLineEntry(expected_entry, compacted_entry);
+}
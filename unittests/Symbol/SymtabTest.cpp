@@ -0,0 +1,121 @@
+//===-- SymtabTest.cpp ------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/ObjectFile/ELF/ObjectFileELF.h"
+#include "Plugins/SymbolFile/Symtab/SymbolFileSymtab.h"
+#include "TestingSupport/TestUtilities.h"
+
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleSpec.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/Symtab.h"
+#include "llvm/Testing/Support/Error.h"
+
+using namespace lldb_private;
+using namespace lldb;
+
+class SymtabTest : public testing::Test {
+public:
+  void SetUp() override {
+    FileSystem::Initialize();
+    HostInfo::Initialize();
+    ObjectFileELF::Initialize();
+    SymbolFileSymtab::Initialize();
+  }
+
+  void TearDown() override {
+    SymbolFileSymtab::Terminate();
+    ObjectFileELF::Terminate();
+    HostInfo::Terminate();
+    FileSystem::Terminate();
+  }
+};
+
+static llvm::StringRef GetName(Symbol *symbol) {
+  return symbol ? symbol->GetName().GetStringRef() : llvm::StringRef();
+}
+
+TEST_F(SymtabTest, FindSymbolsContainingFileAddresses) {
+  auto ExpectedFile = TestFile::fromYaml(R"(
+--- !ELF
+FileHeader:
+  Class:           ELFCLASS64
+  Data:            ELFDATA2LSB
+  Type:            ET_DYN
+  Machine:         EM_X86_64
+Sections:
+  - Name:            .text
+    Type:            SHT_PROGBITS
+    Flags:           [ SHF_ALLOC, SHF_EXECINSTR ]
+    Address:         0x0000000000001000
+    AddressAlign:    0x0000000000000010
+    Size:            0x0000000000000100
+Symbols:
+  - Name:            outer
+    Type:            STT_FUNC
+    Section:         .text
+    Value:           0x0000000000001000
+    Size:            0x0000000000000080
+    Binding:         STB_GLOBAL
+  - Name:            inner
+    Type:            STT_FUNC
+    Section:         .text
+    Value:           0x0000000000001010
+    Size:            0x0000000000000010
+    Binding:         STB_GLOBAL
+  - Name:            after
+    Type:            STT_FUNC
+    Section:         .text
+    Value:           0x0000000000001090
+    Size:            0x0000000000000010
+    Binding:         STB_GLOBAL
+...
+)");
+  ASSERT_THAT_EXPECTED(ExpectedFile, llvm::Succeeded());
+
+  auto module_sp =
+      std::make_shared<Module>(ModuleSpec(FileSpec(ExpectedFile->name())));
+  Symtab *symtab = module_sp->GetObjectFile()->GetSymtab();
+  ASSERT_NE(nullptr, symtab);
+
+  EXPECT_EQ("", GetName(symtab->FindSymbolContainingFileAddress(0xfff)));
+  EXPECT_EQ("outer", GetName(symtab->FindSymbolContainingFileAddress(0x1000)));
+  EXPECT_EQ("outer", GetName(symtab->FindSymbolContainingFileAddress(0x1018)));
+  // Past the end of inner, but still inside outer, which starts earlier.
+  EXPECT_EQ("outer", GetName(symtab->FindSymbolContainingFileAddress(0x1040)));
+  EXPECT_EQ("", GetName(symtab->FindSymbolContainingFileAddress(0x1080)));
+  EXPECT_EQ("after", GetName(symtab->FindSymbolContainingFileAddress(0x109f)));
+  EXPECT_EQ("", GetName(symtab->FindSymbolContainingFileAddress(0x10a0)));
+
+  std::vector<std::string> containing;
+  symtab->ForEachSymbolContainingFileAddress(0x1018, [&](Symbol *symbol) {
+    containing.push_back(GetName(symbol));
+    return true;
+  });
+  EXPECT_EQ((std::vector<std::string>{"outer", "inner"}), containing);
+
+  // Enough queries for them to be merged against the index.
+  std::vector<addr_t> file_addrs = {0x10a0, 0x1040, 0x1000, 0xfff,
+                                    0x109f, 0x1018, 0x1080, 0x1040};
+  std::vector<Symbol *> symbols;
+  symtab->FindSymbolsContainingFileAddresses(file_addrs, symbols);
+  ASSERT_EQ(file_addrs.size(), symbols.size());
+  for (size_t i = 0; i < file_addrs.size(); ++i)
+    EXPECT_EQ(symtab->FindSymbolContainingFileAddress(file_addrs[i]),
+              symbols[i])
+        << "address " << file_addrs[i];
+
+  // And few enough for them to be searched one by one.
+  symtab->FindSymbolsContainingFileAddresses({0x1018}, symbols);
+  ASSERT_EQ(1u, symbols.size());
+  EXPECT_EQ("outer", GetName(symbols[0]));
+}
@@ -48,7 +48,8 @@ public:
   }
 
 protected:
-  void TestBasic(DWARFCallFrameInfo::Type type, llvm::StringRef symbol);
+  void TestBasic(DWARFCallFrameInfo::Type type, llvm::StringRef symbol,
+                 bool use_eh_frame_hdr = false);
 };
 
 namespace lldb_private {
@@ -86,7 +87,8 @@ static UnwindPlan::Row GetExpectedRow2() {
 }
 
 void DWARFCallFrameInfoTest::TestBasic(DWARFCallFrameInfo::Type type,
-                                       llvm::StringRef symbol) {
+                                       llvm::StringRef symbol,
+                                       bool use_eh_frame_hdr) {
   auto ExpectedFile = TestFile::fromYaml(R"(
 --- !ELF
 FileHeader:
@@ -159,6 +161,17 @@ Sections:
 #  DW_CFA_nop
 #  DW_CFA_nop
 #  DW_CFA_nop
+  - Name:            .eh_frame_hdr
+    Type:            SHT_PROGBITS
+    Flags:           [ SHF_ALLOC ]
+    Address:         0x00000000000002C8
+    AddressAlign:    0x0000000000000004
+    Content:         011B033BC4FFFFFF0100000098FFFFFFE0FFFFFF
+#  Version:               1
+#  eh_frame_ptr_enc:      1b (pcrel sdata4), eh_frame_ptr = 0x290
+#  fde_count_enc:         03 (udata4), fde_count = 1
+#  table_enc:             3b (datarel sdata4)
+#  initial_loc = 0x260, fde = 0x2a8 (.eh_frame+0x18)
   - Name:            .debug_frame
     Type:            SHT_PROGBITS
     AddressAlign:    0x0000000000000008
@@ -242,7 +255,15 @@ Symbols:
                                             false);
   ASSERT_NE(nullptr, section_sp);
 
-  DWARFCallFrameInfo cfi(*module_sp->GetObjectFile(), section_sp, type);
+  SectionSP eh_frame_hdr_sp;
+  if (use_eh_frame_hdr) {
+    eh_frame_hdr_sp = list->FindSectionByName(ConstString(".eh_frame_hdr"));
+    ASSERT_NE(nullptr, eh_frame_hdr_sp);
+  }
+
+  DWARFCallFrameInfo cfi(*module_sp->GetObjectFile(), section_sp, type,
+                         eh_frame_hdr_sp);
+  EXPECT_EQ(use_eh_frame_hdr, cfi.HasLookupTable());
 
   const Symbol *sym = module_sp->FindFirstSymbolWithNameAndType(
       ConstString(symbol), eSymbolTypeAny);
@@ -254,6 +275,12 @@ Symbols:
   EXPECT_EQ(GetExpectedRow0(), *plan.GetRowAtIndex(0));
   EXPECT_EQ(GetExpectedRow1(), *plan.GetRowAtIndex(1));
   EXPECT_EQ(GetExpectedRow2(), *plan.GetRowAtIndex(2));
+
+  AddressRange range;
+  ASSERT_TRUE(cfi.GetAddressRange(sym->GetAddress(), range));
+  EXPECT_EQ(sym->GetAddress().GetFileAddress(),
+            range.GetBaseAddress().GetFileAddress());
+  EXPECT_EQ(0xcu, range.GetByteSize());
 }
 
 TEST_F(DWARFCallFrameInfoTest, Basic_dwarf3) {
@@ -267,3 +294,7 @@ TEST_F(DWARFCallFrameInfoTest, Basic_dwarf4) {
 TEST_F(DWARFCallFrameInfoTest, Basic_eh) {
   TestBasic(DWARFCallFrameInfo::EH, "eh_frame");
 }
+
+TEST_F(DWARFCallFrameInfoTest, Basic_eh_frame_hdr) {
+  TestBasic(DWARFCallFrameInfo::EH, "eh_frame", /*use_eh_frame_hdr=*/true);
+}
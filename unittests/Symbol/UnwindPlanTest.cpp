@@ -0,0 +1,46 @@
+//===-- UnwindPlanTest.cpp --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Symbol/UnwindPlan.h"
+#include "gtest/gtest.h"
+
+using namespace lldb_private;
+using namespace lldb;
+
+static UnwindPlan::RowSP make_row(lldb::offset_t offset, int32_t cfa_offset) {
+  UnwindPlan::RowSP row_sp = std::make_shared<UnwindPlan::Row>();
+  row_sp->SetOffset(offset);
+  row_sp->GetCFAValue().SetIsRegisterPlusOffset(0, cfa_offset);
+  return row_sp;
+}
+
+TEST(UnwindPlanTest, GetRowForFunctionOffset) {
+  UnwindPlan plan(eRegisterKindGeneric);
+  EXPECT_EQ(nullptr, plan.GetRowForFunctionOffset(0));
+
+  // Insert out of order, InsertRow keeps the rows sorted.
+  plan.AppendRow(make_row(0, 8));
+  plan.AppendRow(make_row(4, 16));
+  plan.InsertRow(make_row(1, 12));
+  plan.InsertRow(make_row(4, 24), /*replace_existing=*/false);
+  ASSERT_EQ(3, plan.GetRowCount());
+
+  EXPECT_EQ(8, plan.GetRowForFunctionOffset(0)->GetCFAValue().GetOffset());
+  EXPECT_EQ(12, plan.GetRowForFunctionOffset(1)->GetCFAValue().GetOffset());
+  EXPECT_EQ(12, plan.GetRowForFunctionOffset(3)->GetCFAValue().GetOffset());
+  EXPECT_EQ(16, plan.GetRowForFunctionOffset(4)->GetCFAValue().GetOffset());
+  EXPECT_EQ(16, plan.GetRowForFunctionOffset(100)->GetCFAValue().GetOffset());
+  EXPECT_EQ(16, plan.GetRowForFunctionOffset(-1)->GetCFAValue().GetOffset());
+
+  plan.InsertRow(make_row(4, 24), /*replace_existing=*/true);
+  EXPECT_EQ(24, plan.GetRowForFunctionOffset(4)->GetCFAValue().GetOffset());
+
+  UnwindPlan late_start(eRegisterKindGeneric);
+  late_start.AppendRow(make_row(2, 8));
+  EXPECT_EQ(nullptr, late_start.GetRowForFunctionOffset(1));
+}
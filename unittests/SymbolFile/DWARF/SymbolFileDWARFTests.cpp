@@ -18,6 +18,8 @@
 #include "Plugins/SymbolFile/DWARF/DWARFAbbreviationDeclaration.h"
 #include "Plugins/SymbolFile/DWARF/DWARFDataExtractor.h"
 #include "Plugins/SymbolFile/DWARF/DWARFDebugAbbrev.h"
+#include "Plugins/SymbolFile/DWARF/DWARFDebugAranges.h"
+#include "Plugins/SymbolFile/DWARF/NameToDIE.h"
 #include "Plugins/SymbolFile/DWARF/SymbolFileDWARF.h"
 #include "Plugins/SymbolFile/PDB/SymbolFilePDB.h"
 #include "TestingSupport/TestUtilities.h"
@@ -127,6 +129,121 @@ TEST_F(SymbolFileDWARFTests, TestAbbrevOrder1Start1) {
   EXPECT_EQ(abbrev2->NumAttributes(), 1u);
 }
 
+TEST_F(SymbolFileDWARFTests, TestAbbrevSkipRuns) {
+  // Test that the attributes of an abbreviation are grouped into runs of
+  // fixed size attributes ended by a variable size one.
+  const auto byte_order = eByteOrderLittle;
+  const uint8_t addr_size = 4;
+  StreamString encoder(Stream::eBinary, addr_size, byte_order);
+  encoder.PutULEB128(1); // Abbrev code 1
+  encoder.PutULEB128(DW_TAG_subprogram);
+  encoder.PutHex8(DW_CHILDREN_no);
+  encoder.PutULEB128(DW_AT_name);
+  encoder.PutULEB128(DW_FORM_strp);
+  encoder.PutULEB128(DW_AT_low_pc);
+  encoder.PutULEB128(DW_FORM_addr);
+  encoder.PutULEB128(DW_AT_high_pc);
+  encoder.PutULEB128(DW_FORM_data4);
+  encoder.PutULEB128(DW_AT_frame_base);
+  encoder.PutULEB128(DW_FORM_exprloc);
+  encoder.PutULEB128(DW_AT_specification);
+  encoder.PutULEB128(DW_FORM_ref_addr);
+  encoder.PutULEB128(DW_AT_external);
+  encoder.PutULEB128(DW_FORM_flag_present);
+  encoder.PutULEB128(0);
+  encoder.PutULEB128(0);
+
+  encoder.PutULEB128(2); // Abbrev code 2
+  encoder.PutULEB128(DW_TAG_variable);
+  encoder.PutHex8(DW_CHILDREN_no);
+  encoder.PutULEB128(DW_AT_name);
+  encoder.PutULEB128(DW_FORM_string);
+  encoder.PutULEB128(0);
+  encoder.PutULEB128(0);
+
+  encoder.PutULEB128(0); // Abbrev code 0 (termination)
+
+  DWARFDataExtractor data;
+  data.SetData(encoder.GetData(), encoder.GetSize(), byte_order);
+  DWARFAbbreviationDeclarationSet abbrev_set;
+  lldb::offset_t data_offset = 0;
+  llvm::Error error = abbrev_set.extract(data, &data_offset);
+  EXPECT_FALSE(bool(error));
+
+  auto runs1 = abbrev_set.GetAbbreviationDeclaration(1)->GetSkipRuns();
+  ASSERT_EQ(2u, runs1.size());
+  EXPECT_EQ(8u, runs1[0].num_bytes);
+  EXPECT_EQ(1u, runs1[0].num_addrs);
+  EXPECT_EQ(0u, runs1[0].num_ref_addrs);
+  EXPECT_EQ(DW_FORM_exprloc, runs1[0].variable_form);
+  EXPECT_EQ(0u, runs1[1].num_bytes);
+  EXPECT_EQ(0u, runs1[1].num_addrs);
+  EXPECT_EQ(1u, runs1[1].num_ref_addrs);
+  EXPECT_EQ(0u, runs1[1].variable_form);
+
+  auto runs2 = abbrev_set.GetAbbreviationDeclaration(2)->GetSkipRuns();
+  ASSERT_EQ(1u, runs2.size());
+  EXPECT_EQ(0u, runs2[0].num_bytes);
+  EXPECT_EQ(DW_FORM_string, runs2[0].variable_form);
+}
+
+TEST_F(SymbolFileDWARFTests, TestAbbrevIndexAttributes) {
+  // Test that an abbreviation knows which of its attributes the index needs.
+  const auto byte_order = eByteOrderLittle;
+  const uint8_t addr_size = 4;
+  StreamString encoder(Stream::eBinary, addr_size, byte_order);
+  encoder.PutULEB128(1); // Abbrev code 1
+  encoder.PutULEB128(DW_TAG_subprogram);
+  encoder.PutHex8(DW_CHILDREN_no);
+  encoder.PutULEB128(DW_AT_specification);
+  encoder.PutULEB128(DW_FORM_ref4);
+  encoder.PutULEB128(DW_AT_low_pc);
+  encoder.PutULEB128(DW_FORM_addr);
+  encoder.PutULEB128(DW_AT_frame_base);
+  encoder.PutULEB128(DW_FORM_exprloc);
+  encoder.PutULEB128(DW_AT_linkage_name);
+  encoder.PutULEB128(DW_FORM_strp);
+  encoder.PutULEB128(0);
+  encoder.PutULEB128(0);
+
+  encoder.PutULEB128(2); // Abbrev code 2
+  encoder.PutULEB128(DW_TAG_variable);
+  encoder.PutHex8(DW_CHILDREN_no);
+  encoder.PutULEB128(DW_AT_type);
+  encoder.PutULEB128(DW_FORM_ref4);
+  encoder.PutULEB128(DW_AT_name);
+  encoder.PutULEB128(DW_FORM_string);
+  encoder.PutULEB128(DW_AT_declaration);
+  encoder.PutULEB128(DW_FORM_flag_present);
+  encoder.PutULEB128(DW_AT_location);
+  encoder.PutULEB128(DW_FORM_exprloc);
+  encoder.PutULEB128(0);
+  encoder.PutULEB128(0);
+
+  encoder.PutULEB128(0); // Abbrev code 0 (termination)
+
+  DWARFDataExtractor data;
+  data.SetData(encoder.GetData(), encoder.GetSize(), byte_order);
+  DWARFAbbreviationDeclarationSet abbrev_set;
+  lldb::offset_t data_offset = 0;
+  llvm::Error error = abbrev_set.extract(data, &data_offset);
+  EXPECT_FALSE(bool(error));
+
+  const DWARFAbbreviationDeclaration *abbrev1 =
+      abbrev_set.GetAbbreviationDeclaration(1);
+  EXPECT_EQ((std::vector<uint32_t>{0, 3}),
+            abbrev1->GetIndexAttributeIndexes().vec());
+  EXPECT_TRUE(abbrev1->HasAddressAttributes());
+  EXPECT_FALSE(abbrev1->HasLocationOrConstValue());
+
+  const DWARFAbbreviationDeclaration *abbrev2 =
+      abbrev_set.GetAbbreviationDeclaration(2);
+  EXPECT_EQ((std::vector<uint32_t>{1, 2}),
+            abbrev2->GetIndexAttributeIndexes().vec());
+  EXPECT_FALSE(abbrev2->HasAddressAttributes());
+  EXPECT_TRUE(abbrev2->HasLocationOrConstValue());
+}
+
 TEST_F(SymbolFileDWARFTests, TestAbbrevOrder1Start5) {
   // Test that if we have a .debug_abbrev that contains ordered abbreviation
   // codes that start at 5, that we get O(1) access.
@@ -326,3 +443,86 @@ TEST_F(SymbolFileDWARFTests, TestAbbrevMissingTerminator) {
   EXPECT_EQ("abbreviation declaration attribute list not terminated with a "
             "null entry", llvm::toString(std::move(error)));
 }
+
+TEST_F(SymbolFileDWARFTests, TestNameToDIEEncodeDecode) {
+  NameToDIE functions;
+  functions.Insert(ConstString("main"),
+                   DIERef(llvm::None, DIERef::DebugInfo, 0x10));
+  functions.Insert(ConstString("foo"), DIERef(7, DIERef::DebugInfo, 0x20));
+  functions.Insert(ConstString("main"),
+                   DIERef(llvm::None, DIERef::DebugTypes, 0x30));
+  functions.Finalize();
+  NameToDIE types;
+  types.Insert(ConstString("foo"),
+               DIERef(llvm::None, DIERef::DebugInfo, 0x40));
+  types.Finalize();
+
+  // Encode both maps with a shared string table, which comes first.
+  ConstStringTable strtab;
+  StreamString maps(Stream::eBinary, 8, eByteOrderLittle);
+  functions.Encode(maps, strtab);
+  types.Encode(maps, strtab);
+  EXPECT_EQ(2u, strtab.GetSize());
+  StreamString encoder(Stream::eBinary, 8, eByteOrderLittle);
+  strtab.Encode(encoder);
+  encoder.Write(maps.GetData(), maps.GetSize());
+
+  DataExtractor data(encoder.GetData(), encoder.GetSize(), eByteOrderLittle,
+                     8);
+  lldb::offset_t offset = 0;
+  ConstStringTable decoded_strtab;
+  ASSERT_TRUE(decoded_strtab.Decode(data, &offset));
+  NameToDIE decoded_functions, decoded_types;
+  ASSERT_TRUE(decoded_functions.Decode(data, &offset, decoded_strtab));
+  ASSERT_TRUE(decoded_types.Decode(data, &offset, decoded_strtab));
+  EXPECT_EQ(encoder.GetSize(), offset);
+
+  DIEArray dies;
+  EXPECT_EQ(2u, decoded_functions.Find(ConstString("main"), dies));
+  dies.clear();
+  ASSERT_EQ(1u, decoded_functions.Find(ConstString("foo"), dies));
+  EXPECT_EQ(llvm::Optional<uint32_t>(7), dies[0].dwo_num());
+  EXPECT_EQ(0x20u, dies[0].die_offset());
+  dies.clear();
+  ASSERT_EQ(1u, decoded_types.Find(ConstString("foo"), dies));
+  EXPECT_EQ(llvm::None, dies[0].dwo_num());
+  EXPECT_EQ(DIERef::DebugInfo, dies[0].section());
+  EXPECT_EQ(0x40u, dies[0].die_offset());
+
+  // A truncated buffer must be rejected.
+  DataExtractor truncated(encoder.GetData(), encoder.GetSize() - 1,
+                          eByteOrderLittle, 8);
+  offset = 0;
+  ASSERT_TRUE(decoded_strtab.Decode(truncated, &offset));
+  EXPECT_TRUE(decoded_functions.Decode(truncated, &offset, decoded_strtab));
+  EXPECT_FALSE(decoded_types.Decode(truncated, &offset, decoded_strtab));
+}
+
+TEST_F(SymbolFileDWARFTests, TestDebugArangesEncodeDecode) {
+  DWARFDebugAranges aranges;
+  aranges.AppendRange(0x100, 0x2000, 0x2100);
+  aranges.AppendRange(0x0, 0x1000, 0x1080);
+  aranges.AppendRange(0x100, 0x2100, 0x2200);
+  aranges.Sort(/*minimize=*/true);
+  ASSERT_EQ(2u, aranges.GetNumRanges());
+
+  StreamString encoder(Stream::eBinary, 8, eByteOrderLittle);
+  aranges.Encode(encoder);
+  DataExtractor data(encoder.GetData(), encoder.GetSize(), eByteOrderLittle,
+                     8);
+  lldb::offset_t offset = 0;
+  DWARFDebugAranges decoded;
+  ASSERT_TRUE(decoded.Decode(data, &offset));
+  EXPECT_EQ(encoder.GetSize(), offset);
+  ASSERT_EQ(2u, decoded.GetNumRanges());
+  EXPECT_EQ(0x0u, decoded.FindAddress(0x1000));
+  EXPECT_EQ(DW_INVALID_OFFSET, decoded.FindAddress(0x1080));
+  EXPECT_EQ(0x100u, decoded.FindAddress(0x21ff));
+  EXPECT_EQ(DW_INVALID_OFFSET, decoded.FindAddress(0x2200));
+
+  // A truncated buffer must be rejected.
+  DataExtractor truncated(encoder.GetData(), encoder.GetSize() - 1,
+                          eByteOrderLittle, 8);
+  offset = 0;
+  EXPECT_FALSE(decoded.Decode(truncated, &offset));
+}
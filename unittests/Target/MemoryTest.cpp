@@ -0,0 +1,191 @@
+//===-- MemoryTest.cpp ------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Target/Memory.h"
+#include "Plugins/Platform/Linux/PlatformLinux.h"
+#include "lldb/Core/Debugger.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Target/Platform.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Utility/ArchSpec.h"
+#include "lldb/Utility/Reproducer.h"
+#include "gtest/gtest.h"
+
+using namespace lldb_private;
+using namespace lldb_private::repro;
+using namespace lldb;
+
+namespace {
+class MemoryTest : public ::testing::Test {
+public:
+  void SetUp() override {
+    llvm::cantFail(Reproducer::Initialize(ReproducerMode::Off, llvm::None));
+    FileSystem::Initialize();
+    HostInfo::Initialize();
+    platform_linux::PlatformLinux::Initialize();
+  }
+  void TearDown() override {
+    platform_linux::PlatformLinux::Terminate();
+    HostInfo::Terminate();
+    FileSystem::Terminate();
+    Reproducer::Terminate();
+  }
+};
+
+// A process with readable memory in [0x10000, 0x110000) where every byte holds
+// the low eight bits of its address. It counts the reads that reach it.
+class DummyProcess : public Process {
+public:
+  using Process::Process;
+
+  static const addr_t g_begin = 0x10000;
+  static const addr_t g_end = 0x110000;
+
+  virtual bool CanDebug(lldb::TargetSP target, bool plugin_specified_by_name) {
+    return true;
+  }
+  virtual Status DoDestroy() { return {}; }
+  virtual void RefreshStateAfterStop() {}
+  virtual size_t DoReadMemory(lldb::addr_t vm_addr, void *buf, size_t size,
+                              Status &error) {
+    ++num_reads;
+    if (vm_addr < g_begin || vm_addr + size > g_end) {
+      error.SetErrorString("unmapped");
+      return 0;
+    }
+    for (size_t i = 0; i < size; ++i)
+      static_cast<uint8_t *>(buf)[i] = uint8_t(vm_addr + i);
+    return size;
+  }
+  virtual bool UpdateThreadList(ThreadList &old_thread_list,
+                                ThreadList &new_thread_list) {
+    return false;
+  }
+  virtual ConstString GetPluginName() { return ConstString("Dummy"); }
+  virtual uint32_t GetPluginVersion() { return 0; }
+
+  size_t num_reads = 0;
+};
+
+struct Fixture {
+  DebuggerSP debugger_sp;
+  TargetSP target_sp;
+  std::shared_ptr<DummyProcess> process_sp;
+
+  Fixture() {
+    ArchSpec arch("x86_64-pc-linux");
+    Platform::SetHostPlatform(
+        platform_linux::PlatformLinux::CreateInstance(true, &arch));
+    debugger_sp = Debugger::CreateInstance();
+    PlatformSP platform_sp;
+    debugger_sp->GetTargetList().CreateTarget(
+        *debugger_sp, "", arch, eLoadDependentsNo, platform_sp, target_sp);
+    process_sp = std::make_shared<DummyProcess>(
+        target_sp, Listener::MakeListener("dummy"));
+  }
+
+  ~Fixture() { Debugger::Destroy(debugger_sp); }
+};
+} // namespace
+
+TEST_F(MemoryTest, SequentialReadsArePrefetched) {
+  Fixture f;
+  ASSERT_TRUE(f.process_sp);
+  MemoryCache cache(*f.process_sp);
+  const uint32_t line_size = cache.GetMemoryCacheLineSize();
+  const size_t num_lines = 64;
+
+  for (addr_t addr = DummyProcess::g_begin;
+       addr < DummyProcess::g_begin + num_lines * line_size; addr += 8) {
+    uint8_t buf[8];
+    Status error;
+    ASSERT_EQ(sizeof(buf), cache.Read(addr, buf, sizeof(buf), error));
+    EXPECT_EQ(uint8_t(addr), buf[0]);
+    EXPECT_EQ(uint8_t(addr + 7), buf[7]);
+  }
+  // Reads of 1, 2, 3, 5 and 9 lines, then of the default maximum of 16 lines,
+  // instead of one read per line.
+  EXPECT_LT(f.process_sp->num_reads, num_lines / 4);
+}
+
+TEST_F(MemoryTest, StridedReadsArePrefetched) {
+  Fixture f;
+  ASSERT_TRUE(f.process_sp);
+  MemoryCache cache(*f.process_sp);
+  const uint32_t line_size = cache.GetMemoryCacheLineSize();
+  const size_t num_elements = 64;
+
+  for (size_t i = 0; i < num_elements; ++i) {
+    addr_t addr = DummyProcess::g_begin + i * 3 * line_size;
+    uint8_t byte;
+    Status error;
+    ASSERT_EQ(1u, cache.Read(addr, &byte, 1, error));
+    EXPECT_EQ(uint8_t(addr), byte);
+  }
+  EXPECT_LT(f.process_sp->num_reads, num_elements / 2);
+}
+
+TEST_F(MemoryTest, PrefetchStopsAtUnmappedMemory) {
+  Fixture f;
+  ASSERT_TRUE(f.process_sp);
+  MemoryCache cache(*f.process_sp);
+  const uint32_t line_size = cache.GetMemoryCacheLineSize();
+
+  // Walk up to the very end of the readable memory. The read ahead fails
+  // there, but the lines that exist must still be returned.
+  for (addr_t addr = DummyProcess::g_end - 32 * line_size;
+       addr < DummyProcess::g_end; addr += line_size) {
+    uint8_t byte;
+    Status error;
+    ASSERT_EQ(1u, cache.Read(addr, &byte, 1, error));
+    EXPECT_TRUE(error.Success());
+    EXPECT_EQ(uint8_t(addr), byte);
+  }
+
+  uint8_t byte;
+  Status error;
+  EXPECT_EQ(0u, cache.Read(DummyProcess::g_end, &byte, 1, error));
+  EXPECT_TRUE(error.Fail());
+}
+
+TEST_F(MemoryTest, LeastRecentlyUsedLinesAreDiscarded) {
+  Fixture f;
+  ASSERT_TRUE(f.process_sp);
+  ASSERT_TRUE(f.process_sp
+                  ->SetPropertyValue(nullptr, eVarSetOperationAssign,
+                                     "memory-cache-size", "65536")
+                  .Success());
+  MemoryCache cache(*f.process_sp);
+  const uint32_t line_size = cache.GetMemoryCacheLineSize();
+  const size_t max_lines = f.process_sp->GetMemoryCacheSize() / line_size;
+  ASSERT_LE((max_lines + 1) * line_size,
+            DummyProcess::g_end - DummyProcess::g_begin);
+
+  // Read backwards so that nothing is prefetched, touching the first line
+  // again half way through so it stays in the cache.
+  const addr_t first = DummyProcess::g_begin + max_lines * line_size;
+  const addr_t last = DummyProcess::g_begin;
+  uint8_t byte;
+  Status error;
+  for (addr_t addr = first; addr > last; addr -= line_size) {
+    ASSERT_EQ(1u, cache.Read(addr, &byte, 1, error));
+    if (addr == first - max_lines / 2 * line_size)
+      ASSERT_EQ(1u, cache.Read(first, &byte, 1, error));
+  }
+  ASSERT_EQ(1u, cache.Read(last, &byte, 1, error));
+
+  // The second line read was the least recently used one and is gone, the
+  // first one is still cached.
+  size_t num_reads = f.process_sp->num_reads;
+  ASSERT_EQ(1u, cache.Read(first, &byte, 1, error));
+  EXPECT_EQ(num_reads, f.process_sp->num_reads);
+  ASSERT_EQ(1u, cache.Read(first - line_size, &byte, 1, error));
+  EXPECT_EQ(num_reads + 1, f.process_sp->num_reads);
+}
@@ -25,6 +25,8 @@ public:
   MOCK_METHOD2(ProcessStateChanged,
                void(NativeProcessProtocol *Process, StateType State));
   MOCK_METHOD1(DidExec, void(NativeProcessProtocol *Process));
+  MOCK_METHOD2(ThreadStopped, void(NativeProcessProtocol *Process,
+                                   NativeThreadProtocol &Thread));
 };
 
 // NB: This class doesn't use the override keyword to avoid
@@ -0,0 +1,136 @@
+//===-- AgentExpressionTest.cpp ---------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/AgentExpression.h"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <map>
+
+using namespace lldb_private;
+
+namespace {
+class TestContext : public AgentExpression::Context {
+public:
+  bool ReadRegister(uint32_t regnum, uint64_t &value) override {
+    auto pos = m_registers.find(regnum);
+    if (pos == m_registers.end())
+      return false;
+    value = pos->second;
+    return true;
+  }
+
+  bool ReadMemory(lldb::addr_t addr, void *buf, size_t size) override {
+    if (addr < m_memory_base || addr + size > m_memory_base + sizeof(m_memory))
+      return false;
+    memcpy(buf, m_memory + (addr - m_memory_base), size);
+    return true;
+  }
+
+  std::map<uint32_t, uint64_t> m_registers;
+  lldb::addr_t m_memory_base = 0x1000;
+  uint8_t m_memory[16] = {0x78, 0x56, 0x34, 0x12, 0xfe, 0xff, 0xff, 0xff};
+};
+
+uint64_t Evaluate(const AgentExpression &expr, TestContext &context) {
+  uint64_t result = 0xdeadbeef;
+  EXPECT_TRUE(expr.Evaluate(context, lldb::eByteOrderLittle, result));
+  return result;
+}
+} // namespace
+
+TEST(AgentExpressionTest, Constants) {
+  AgentExpression expr;
+  expr.AppendConstant(0x12);
+  expr.AppendConstant(0x1234);
+  expr.AppendConstant(0x12345678);
+  expr.AppendConstant(0x123456789aULL);
+  expr.AppendOpcode(AgentExpression::eOpEnd);
+  EXPECT_EQ((std::vector<uint8_t>{0x22, 0x12, 0x23, 0x12, 0x34, 0x24, 0x12,
+                                  0x34, 0x56, 0x78, 0x25, 0x00, 0x00, 0x00,
+                                  0x12, 0x34, 0x56, 0x78, 0x9a, 0x27}),
+            expr.GetBytes().vec());
+
+  TestContext context;
+  EXPECT_EQ(0x123456789aULL, Evaluate(expr, context));
+}
+
+TEST(AgentExpressionTest, Comparisons) {
+  TestContext context;
+  auto compare = [&](uint64_t a, uint64_t b, AgentExpression::Opcode op) {
+    AgentExpression expr;
+    expr.AppendConstant(a);
+    expr.AppendConstant(b);
+    expr.AppendOpcode(op);
+    expr.AppendOpcode(AgentExpression::eOpEnd);
+    return Evaluate(expr, context);
+  };
+  EXPECT_EQ(1u, compare(3, 3, AgentExpression::eOpEqual));
+  EXPECT_EQ(0u, compare(3, 4, AgentExpression::eOpEqual));
+  EXPECT_EQ(1u, compare(3, 4, AgentExpression::eOpLessUnsigned));
+  EXPECT_EQ(0u, compare(4, 3, AgentExpression::eOpLessUnsigned));
+  EXPECT_EQ(0u, compare(-1, 0, AgentExpression::eOpLessUnsigned));
+  EXPECT_EQ(1u, compare(-1, 0, AgentExpression::eOpLessSigned));
+}
+
+TEST(AgentExpressionTest, RegistersAndMemory) {
+  TestContext context;
+  context.m_registers[6] = 0x1000;
+
+  AgentExpression load;
+  load.AppendRegister(6);
+  load.AppendConstant(4);
+  load.AppendOpcode(AgentExpression::eOpAdd);
+  ASSERT_TRUE(load.AppendReference(4));
+  load.AppendExtend(32, true);
+  load.AppendOpcode(AgentExpression::eOpEnd);
+  EXPECT_EQ(uint64_t(-2), Evaluate(load, context));
+
+  AgentExpression word;
+  word.AppendRegister(6);
+  ASSERT_TRUE(word.AppendReference(2));
+  word.AppendOpcode(AgentExpression::eOpEnd);
+  EXPECT_EQ(0x5678u, Evaluate(word, context));
+
+  EXPECT_FALSE(word.AppendReference(3));
+}
+
+TEST(AgentExpressionTest, Branches) {
+  TestContext context;
+  // 1 if_goto L; const 7; end; L: const 9; end
+  AgentExpression expr(
+      {0x22, 0x01, 0x20, 0x00, 0x08, 0x22, 0x07, 0x27, 0x22, 0x09, 0x27});
+  EXPECT_EQ(9u, Evaluate(expr, context));
+}
+
+TEST(AgentExpressionTest, Errors) {
+  TestContext context;
+  uint64_t result;
+
+  // Nothing to pop.
+  EXPECT_FALSE(AgentExpression({0x02, 0x27})
+                   .Evaluate(context, lldb::eByteOrderLittle, result));
+  // Truncated operand.
+  EXPECT_FALSE(AgentExpression({0x23, 0x01})
+                   .Evaluate(context, lldb::eByteOrderLittle, result));
+  // Unknown register.
+  EXPECT_FALSE(AgentExpression({0x26, 0x00, 0x01, 0x27})
+                   .Evaluate(context, lldb::eByteOrderLittle, result));
+  // Unreadable memory.
+  EXPECT_FALSE(AgentExpression({0x22, 0x00, 0x19, 0x27})
+                   .Evaluate(context, lldb::eByteOrderLittle, result));
+  // Unsupported opcode.
+  EXPECT_FALSE(AgentExpression({0x22, 0x00, 0x01, 0x27})
+                   .Evaluate(context, lldb::eByteOrderLittle, result));
+  // Runs off the end.
+  EXPECT_FALSE(AgentExpression({0x22, 0x00})
+                   .Evaluate(context, lldb::eByteOrderLittle, result));
+  // Loops forever.
+  EXPECT_FALSE(AgentExpression({0x21, 0x00, 0x00})
+                   .Evaluate(context, lldb::eByteOrderLittle, result));
+}
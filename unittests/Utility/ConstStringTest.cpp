@@ -10,6 +10,9 @@
 #include "llvm/Support/FormatVariadic.h"
 #include "gtest/gtest.h"
 
+#include <thread>
+#include <vector>
+
 using namespace lldb_private;
 
 TEST(ConstStringTest, format_provider) {
@@ -137,3 +140,25 @@ TEST(ConstStringTest, CompareStringRef) {
   EXPECT_TRUE(null == static_cast<const char *>(nullptr));
   EXPECT_TRUE(null != "bar");
 }
+
+TEST(ConstStringTest, ConcurrentInsertAndLookup) {
+  // Every thread interns the same strings, so lookups race with insertions
+  // and with the growth of the pool's tables.
+  const size_t num_strings = 10000;
+  std::vector<std::vector<const char *>> results(4);
+  std::vector<std::thread> threads;
+  for (auto &result : results) {
+    threads.emplace_back([&result, num_strings]() {
+      for (size_t i = 0; i < num_strings; ++i)
+        result.push_back(
+            ConstString(llvm::formatv("concurrent{0}", i).str()).GetCString());
+    });
+  }
+  for (std::thread &thread : threads)
+    thread.join();
+
+  for (const auto &result : results)
+    EXPECT_EQ(results[0], result);
+  for (size_t i = 0; i < num_strings; ++i)
+    EXPECT_EQ(llvm::formatv("concurrent{0}", i).str(), results[0][i]);
+}
@@ -165,3 +165,35 @@ TEST(DataExtractorTest, GetMaxU64_unchecked) {
   EXPECT_EQ(0x0102030405060708U, BE.GetMaxU64_unchecked(&offset, 8));
   EXPECT_EQ(8U, offset);
 }
+
+TEST(DataExtractorTest, GetLEB128) {
+  // 2, -2, 624485 (three bytes), -123456 (three bytes), and a truncated value.
+  uint8_t buffer[] = {0x02, 0x7e, 0xe5, 0x8e, 0x26, 0xc0, 0xbb, 0x78, 0x80};
+  DataExtractor data(buffer, sizeof(buffer), lldb::eByteOrderLittle,
+                     sizeof(void *));
+
+  lldb::offset_t offset = 0;
+  EXPECT_EQ(2U, data.GetULEB128(&offset));
+  EXPECT_EQ(1U, offset);
+  EXPECT_EQ(-2, data.GetSLEB128(&offset));
+  EXPECT_EQ(2U, offset);
+  EXPECT_EQ(624485U, data.GetULEB128(&offset));
+  EXPECT_EQ(5U, offset);
+  EXPECT_EQ(-123456, data.GetSLEB128(&offset));
+  EXPECT_EQ(8U, offset);
+  // A value cut short by the end of the data stops there.
+  EXPECT_EQ(0U, data.GetULEB128(&offset));
+  EXPECT_EQ(9U, offset);
+  // Nothing is read past the end.
+  EXPECT_EQ(0U, data.GetULEB128(&offset));
+  EXPECT_EQ(0, data.GetSLEB128(&offset));
+  EXPECT_EQ(0U, data.Skip_LEB128(&offset));
+  EXPECT_EQ(9U, offset);
+
+  offset = 0;
+  EXPECT_EQ(0U, data.Skip_LEB128(&offset));
+  EXPECT_EQ(1U, offset);
+  offset = 2;
+  EXPECT_EQ(2U, data.Skip_LEB128(&offset));
+  EXPECT_EQ(5U, offset);
+}
@@ -0,0 +1,84 @@
+//===-- HexCodecTest.cpp ----------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/HexCodec.h"
+#include "llvm/ADT/StringExtras.h"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+using namespace lldb_private;
+
+static std::string Encode(llvm::ArrayRef<uint8_t> bytes) {
+  std::string hex(2 * bytes.size(), '\0');
+  EncodeHexBytes(bytes, &hex[0]);
+  return hex;
+}
+
+static std::vector<uint8_t> AllBytes(size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (size_t i = 0; i < size; ++i)
+    bytes[i] = static_cast<uint8_t>(i * 7 + 3);
+  return bytes;
+}
+
+TEST(HexCodecTest, Encode) {
+  EXPECT_EQ("", Encode({}));
+  EXPECT_EQ("00ff7fa5", Encode({0x00, 0xff, 0x7f, 0xa5}));
+
+  // Sizes around the ones the vector loops handle at a time.
+  for (size_t size : {1, 15, 16, 17, 31, 32, 33, 256, 1000}) {
+    std::vector<uint8_t> bytes = AllBytes(size);
+    EXPECT_EQ(llvm::toHex(bytes, /*LowerCase=*/true), Encode(bytes))
+        << "size " << size;
+  }
+}
+
+TEST(HexCodecTest, Decode) {
+  for (size_t size : {0, 1, 15, 16, 17, 31, 32, 33, 256, 1000}) {
+    std::vector<uint8_t> bytes = AllBytes(size);
+    for (bool lower_case : {true, false}) {
+      std::string hex = llvm::toHex(bytes, lower_case);
+      std::vector<uint8_t> decoded(size);
+      EXPECT_EQ(size, DecodeHexBytes(hex, decoded)) << "size " << size;
+      EXPECT_EQ(bytes, decoded) << "size " << size;
+    }
+  }
+}
+
+TEST(HexCodecTest, DecodeStopsAtDestination) {
+  std::string hex = llvm::toHex(AllBytes(64));
+  std::vector<uint8_t> decoded(20);
+  EXPECT_EQ(20U, DecodeHexBytes(hex, decoded));
+  EXPECT_EQ(std::vector<uint8_t>(AllBytes(20)), decoded);
+}
+
+TEST(HexCodecTest, DecodeStopsAtOddDigit) {
+  std::vector<uint8_t> decoded(8);
+  EXPECT_EQ(1U, DecodeHexBytes("abc", decoded));
+  EXPECT_EQ(0xab, decoded[0]);
+}
+
+TEST(HexCodecTest, DecodeStopsAtInvalidPair) {
+  const std::vector<uint8_t> bytes = AllBytes(48);
+  const std::string hex = llvm::toHex(bytes);
+  // Characters next to the ranges of valid digits, and ones that only differ
+  // from them in the high bit.
+  for (char invalid : {'/', ':', '@', 'G', '`', 'g', ' ', '\xb0', '\xe1'}) {
+    for (size_t pos = 0; pos < hex.size(); ++pos) {
+      std::string corrupt = hex;
+      corrupt[pos] = invalid;
+      std::vector<uint8_t> decoded(bytes.size());
+      ASSERT_EQ(pos / 2, DecodeHexBytes(corrupt, decoded))
+          << "invalid character " << int(invalid) << " at " << pos;
+      EXPECT_TRUE(std::equal(bytes.begin(), bytes.begin() + pos / 2,
+                             decoded.begin()));
+    }
+  }
+}
@@ -9,9 +9,11 @@
 #include "gtest/gtest.h"
 
 #include "lldb/Utility/Broadcaster.h"
+#include "lldb/Utility/Event.h"
 #include "lldb/Utility/Listener.h"
 #include <future>
 #include <thread>
+#include <vector>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -111,3 +113,51 @@ TEST(ListenerTest, GetEventWait) {
       &broadcaster, event_mask, event_sp, llvm::None));
   async_broadcast.get();
 }
+
+TEST(ListenerTest, GetEventManyBroadcasters) {
+  const uint32_t event_mask = 1;
+  const uint32_t num_broadcasters = 4;
+  const uint32_t num_events = 1000;
+
+  ListenerSP listener_sp = Listener::MakeListener("test-listener");
+  std::vector<std::unique_ptr<Broadcaster>> broadcasters;
+  for (uint32_t i = 0; i < num_broadcasters; ++i) {
+    broadcasters.push_back(
+        std::make_unique<Broadcaster>(nullptr, "test-broadcaster"));
+    ASSERT_EQ(event_mask, listener_sp->StartListeningForEvents(
+                              broadcasters.back().get(), event_mask));
+  }
+
+  // Broadcast from all of them at once, while the listener waits.
+  std::vector<std::future<void>> async_broadcasts;
+  for (auto &broadcaster_up : broadcasters) {
+    Broadcaster *broadcaster = broadcaster_up.get();
+    async_broadcasts.push_back(std::async(std::launch::async, [=] {
+      for (uint32_t i = 0; i < num_events; ++i)
+        broadcaster->BroadcastEvent(
+            event_mask, new EventDataBytes(&i, sizeof(i)));
+    }));
+  }
+
+  // Every event arrives, and the events of each broadcaster arrive in the
+  // order they were sent.
+  std::vector<uint32_t> next_index(num_broadcasters, 0);
+  for (uint32_t i = 0; i < num_broadcasters * num_events; ++i) {
+    EventSP event_sp;
+    ASSERT_TRUE(listener_sp->GetEvent(event_sp, llvm::None));
+    uint32_t b = 0;
+    while (!event_sp->BroadcasterIs(broadcasters[b].get()))
+      ++b;
+    const EventDataBytes *data = EventDataBytes::GetEventDataFromEvent(
+        event_sp.get());
+    ASSERT_NE(nullptr, data);
+    uint32_t index;
+    memcpy(&index, data->GetBytes(), sizeof(index));
+    EXPECT_EQ(next_index[b]++, index);
+  }
+
+  for (auto &async_broadcast : async_broadcasts)
+    async_broadcast.get();
+  EventSP event_sp;
+  EXPECT_FALSE(listener_sp->GetEvent(event_sp, std::chrono::seconds(0)));
+}
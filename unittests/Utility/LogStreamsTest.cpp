@@ -0,0 +1,74 @@
+//===-- LogStreamsTest.cpp --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/LogStreams.h"
+
+using namespace lldb_private;
+
+TEST(LogStreamsTest, Async) {
+  std::string output;
+  {
+    auto stream_sp = std::make_shared<llvm::raw_string_ostream>(output);
+    AsyncLogStream async(stream_sp, 1024);
+    async << "first\n";
+    async << "second\n";
+  }
+  EXPECT_EQ("first\nsecond\n", output);
+}
+
+TEST(LogStreamsTest, AsyncDropsWhenFull) {
+  std::string output;
+  {
+    auto stream_sp = std::make_shared<llvm::raw_string_ostream>(output);
+    AsyncLogStream async(stream_sp, 4);
+    async << "too long\n";
+  }
+  EXPECT_EQ("<9 bytes of log messages were dropped>\n", output);
+}
+
+TEST(LogStreamsTest, AsyncWaitsWhenFull) {
+  std::string output;
+  auto stream_sp = std::make_shared<llvm::raw_string_ostream>(output);
+  AsyncLogStream async(stream_sp, 4, /*drop_when_full=*/false);
+  async << "too long\n";
+  async << "a\n" << "b\n" << "c\n";
+  async.Drain();
+  EXPECT_EQ("too long\na\nb\nc\n", output);
+
+  async.SetBuffered();
+  async << "buffered\n";
+  async.Drain();
+  EXPECT_EQ("too long\na\nb\nc\nbuffered\n", output);
+}
+
+TEST(LogStreamsTest, Circular) {
+  CircularLogStream circular(16);
+  std::string output;
+  llvm::raw_string_ostream stream(output);
+
+  circular.Dump(stream);
+  EXPECT_EQ("", stream.str());
+
+  circular << "one\n" << "two\n";
+  circular.Dump(stream);
+  EXPECT_EQ("one\ntwo\n", stream.str());
+
+  // "one" gets partly overwritten, so it is left out.
+  output.clear();
+  circular << "three\n" << "four\n";
+  circular.Dump(stream);
+  EXPECT_EQ("two\nthree\nfour\n", stream.str());
+
+  // Only the end of a message larger than the buffer is kept.
+  output.clear();
+  circular << "0123456789abcdefghij\n" << "end\n";
+  circular.Dump(stream);
+  EXPECT_EQ("end\n", stream.str());
+}
@@ -63,3 +63,30 @@ TEST(RegularExpression, Match) {
   EXPECT_EQ("a", matches[1].str());
   EXPECT_EQ("513", matches[2].str());
 }
+
+TEST(RegularExpression, LiteralPrefix) {
+  EXPECT_EQ("MyNs::Foo", RegularExpression("^MyNs::Foo.*").GetLiteralPrefix());
+  EXPECT_EQ("abc", RegularExpression("^abc").GetLiteralPrefix());
+  EXPECT_EQ("ab", RegularExpression("^abc*").GetLiteralPrefix());
+  EXPECT_EQ("ab", RegularExpression("^abc?d").GetLiteralPrefix());
+  EXPECT_EQ("abc", RegularExpression("^abc+").GetLiteralPrefix());
+  EXPECT_EQ("a", RegularExpression("^a\\.b").GetLiteralPrefix());
+  EXPECT_EQ("", RegularExpression("abc").GetLiteralPrefix());
+  EXPECT_EQ("", RegularExpression("^abc|^def").GetLiteralPrefix());
+  EXPECT_EQ("", RegularExpression("^[ab]c").GetLiteralPrefix());
+}
+
+TEST(RegularExpression, Literal) {
+  SmallVector<StringRef, 1> matches;
+  EXPECT_TRUE(RegularExpression("::").Execute("std::vector", &matches));
+  ASSERT_EQ(1u, matches.size());
+  EXPECT_EQ("::", matches[0]);
+  EXPECT_TRUE(RegularExpression("^std::").Execute("std::vector"));
+  EXPECT_FALSE(RegularExpression("^std::").Execute("mystd::vector"));
+  EXPECT_TRUE(RegularExpression("vector$").Execute("std::vector"));
+  EXPECT_FALSE(RegularExpression("vector$").Execute("std::vector2"));
+  EXPECT_TRUE(RegularExpression("^main$").Execute("main"));
+  EXPECT_FALSE(RegularExpression("^main$").Execute("main2"));
+  EXPECT_TRUE(RegularExpression("^").Execute("anything"));
+  EXPECT_FALSE(RegularExpression("^a\\.b$").Execute("axb"));
+}
@@ -0,0 +1,62 @@
+//===-- SharedClusterTest.cpp -----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/SharedCluster.h"
+
+using namespace lldb_private;
+
+namespace {
+class DestructionCounter {
+public:
+  DestructionCounter(ClusterManager<DestructionCounter> &manager,
+                     int &destroyed)
+      : m_destroyed(destroyed) {
+    manager.ManageObject(this);
+  }
+
+  virtual ~DestructionCounter() { ++m_destroyed; }
+
+private:
+  int &m_destroyed;
+};
+
+class BigDestructionCounter : public DestructionCounter {
+public:
+  using DestructionCounter::DestructionCounter;
+
+  ~BigDestructionCounter() override { m_payload[0] = 0; }
+
+private:
+  uint64_t m_payload[64];
+};
+} // namespace
+
+TEST(SharedClusterTest, DestroysArenaAndHeapObjects) {
+  int destroyed = 0;
+  auto *manager = new ClusterManager<DestructionCounter>();
+  auto *root = new DestructionCounter(*manager, destroyed);
+  for (int i = 0; i < 1000; ++i) {
+    if (i % 2)
+      new (manager->Allocate<DestructionCounter>())
+          DestructionCounter(*manager, destroyed);
+    else
+      new (manager->Allocate<BigDestructionCounter>())
+          BigDestructionCounter(*manager, destroyed);
+  }
+
+  SharingPtr<DestructionCounter> root_sp = manager->GetSharedPointer(root);
+  SharingPtr<DestructionCounter> other_sp = root_sp;
+  root_sp.reset();
+  EXPECT_EQ(0, destroyed);
+
+  // Dropping the last reference destroys the whole cluster.
+  other_sp.reset();
+  EXPECT_EQ(1001, destroyed);
+}
@@ -8,6 +8,8 @@
 
 #include "lldb/Utility/StreamString.h"
 #include "lldb/Utility/Timer.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
 #include <thread>
 
@@ -106,3 +108,62 @@ TEST(TimerTest, CategoryTimesStats) {
   EXPECT_NEAR(child1, seconds2, 0.002);
   EXPECT_EQ(2, count2);
 }
+
+TEST(TimerTest, CategoryTimesThreads) {
+  Timer::ResetCategoryTimes();
+  static Timer::Category tcat("CAT1");
+  auto work = [] {
+    for (int i = 0; i < 10; ++i)
+      Timer t(tcat, ".");
+  };
+  std::thread thread1(work);
+  std::thread thread2(work);
+  // Times of threads that are still running are merged too.
+  work();
+  thread1.join();
+  thread2.join();
+
+  StreamString ss;
+  Timer::DumpCategoryTimes(&ss);
+  int count;
+  ASSERT_EQ(1, sscanf(ss.GetData(),
+                      "%*f sec (total: %*fs; child: %*fs; count: %d) for CAT1",
+                      &count))
+      << "String: " << ss.GetData();
+  EXPECT_EQ(30, count);
+
+  Timer::ResetCategoryTimes();
+  ss.Clear();
+  Timer::DumpCategoryTimes(&ss);
+  EXPECT_EQ(ss.GetString().count("CAT1"), 0U);
+}
+
+TEST(TimerTest, TraceEvents) {
+  Timer::SetRecordTraceEvents(true);
+  {
+    static Timer::Category tcat1("CAT1");
+    Timer t1(tcat1, ".");
+    static Timer::Category tcat2("CAT2");
+    Timer t2(tcat2, ".");
+  }
+  Timer::SetRecordTraceEvents(false);
+
+  std::string trace;
+  llvm::raw_string_ostream os(trace);
+  Timer::DumpTraceEvents(os);
+  os.flush();
+  llvm::Expected<llvm::json::Value> value = llvm::json::parse(trace);
+  ASSERT_TRUE(bool(value)) << llvm::toString(value.takeError());
+  const llvm::json::Array *events =
+      value->getAsObject()->getArray("traceEvents");
+  ASSERT_TRUE(events);
+  ASSERT_EQ(2U, events->size());
+  // Events are recorded as the timers finish, innermost first.
+  const llvm::json::Object *inner = (*events)[0].getAsObject();
+  const llvm::json::Object *outer = (*events)[1].getAsObject();
+  EXPECT_EQ(llvm::Optional<llvm::StringRef>("CAT2"), inner->getString("name"));
+  EXPECT_EQ(llvm::Optional<llvm::StringRef>("CAT1"), outer->getString("name"));
+  EXPECT_EQ(llvm::Optional<llvm::StringRef>("X"), outer->getString("ph"));
+  EXPECT_LE(*outer->getNumber("ts"), *inner->getNumber("ts"));
+  EXPECT_LE(*inner->getNumber("dur"), *outer->getNumber("dur"));
+}